@@ -39,6 +39,11 @@ struct SimplicialComplexForAlpha {
    * simplicial complex with the given 'filtration' value. */
   void insert_simplex_and_subfaces(std::vector<Vertex_handle> const & vertex_range, Filtration_value filtration);
 
+  /** \brief Optional. If available, inserts a range of simplices and all their subfaces, with the filtration value
+   * `filtration(i)` for the i-th simplex, with the same result as successive `insert_simplex_and_subfaces`. */
+  template <class SimplexRange, class FiltrationFunction>
+  void insert_batch(SimplexRange const & simplices, FiltrationFunction&& filtration);
+
   /** Browses the simplicial complex to make the filtration non-decreasing. */
   void make_filtration_non_decreasing();
 
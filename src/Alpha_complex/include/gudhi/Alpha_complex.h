@@ -6,6 +6,8 @@
  *
  *    Modification(s):
  *      - 2019/08 Vincent Rouvreau: Fix issue #10 for CGAL and Eigen3
+ *      - 2023/10 David Loiseaux: Cooperative cancellation of create_complex
+ *      - 2023/11 David Loiseaux: Incremental insertion and removal of points
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -13,7 +15,9 @@
 #define ALPHA_COMPLEX_H_
 
 #include <gudhi/Alpha_complex/Alpha_kernel_d.h>
+#include <gudhi/Alpha_complex_options.h>
 #include <gudhi/Debug_utils.h>
+#include <gudhi/Cancellation.h>
 // to construct Alpha_complex from a OFF file of points
 #include <gudhi/Points_off_io.h>
 
@@ -35,6 +39,8 @@
 #include <boost/range/size.hpp>
 #include <boost/range/combine.hpp>
 #include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/irange.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include <iostream>
 #include <vector>
@@ -44,7 +50,13 @@
 #include <utility>  // std::pair
 #include <stdexcept>
 #include <numeric>  // for std::iota
-#include <algorithm>  // for std::sort
+#include <algorithm>  // for std::sort, std::includes, std::set_difference
+#include <iterator>  // for std::back_inserter, std::next
+#include <type_traits>  // for std::void_t
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
 
 // Make compilation fail - required for external projects - https://github.com/GUDHI/gudhi-devel/issues/10
 #if CGAL_VERSION_NR < 1041101000
@@ -62,6 +74,47 @@ namespace alpha_complex {
 template<typename D> struct Is_Epeck_D { static const bool value = false; };
 template<typename D> struct Is_Epeck_D<CGAL::Epeck_d<D>> { static const bool value = true; };
 
+/** \brief Sizes of the caches of `Alpha_complex::create_complex`, see `Alpha_complex::cache_statistics`.
+ *
+ * \ingroup alpha_complex
+ */
+struct Alpha_complex_cache_statistics {
+  /** \brief Largest number of circumspheres (center and squared radius) of the faces of one dimension. */
+  std::size_t max_cached_spheres = 0;
+  /** \brief Largest number of squared radii kept for the simplices of one dimension, while the circumspheres of their
+   * faces are computed. */
+  std::size_t max_cached_squared_radii = 0;
+};
+
+// Cell i of a batch of Alpha_complex::insert_full_cells_by_batches, given by the offsets of the vertices.
+template<typename Vertex_handle>
+struct Batch_cell {
+  boost::iterator_range<typename std::vector<Vertex_handle>::const_iterator> operator()(std::size_t i) const {
+    return boost::make_iterator_range(vertices->begin() + (*offsets)[i], vertices->begin() + (*offsets)[i + 1]);
+  }
+  const std::vector<Vertex_handle>* vertices;
+  const std::vector<std::size_t>* offsets;
+};
+
+// Range of the cells of a batch, as given to insert_batch.
+template<typename Vertex_handle>
+using Batch_cells = decltype(boost::adaptors::transform(std::declval<boost::integer_range<std::size_t>>(),
+                                                        std::declval<Batch_cell<Vertex_handle>>()));
+
+// Filtration values of the cells of a batch, NaN as they are computed afterwards.
+template<typename Filtration_value>
+struct Nan_filtration {
+  Filtration_value operator()(std::size_t) const { return std::numeric_limits<Filtration_value>::quiet_NaN(); }
+};
+
+// Whether the simplicial complex has an insert_batch method, as Simplex_tree, with exactly the arguments of
+// Alpha_complex::insert_full_cells_by_batches.
+template<typename SimplicialComplex, typename = void> struct Has_insert_batch : std::false_type {};
+template<typename SimplicialComplex>
+struct Has_insert_batch<SimplicialComplex, std::void_t<decltype(std::declval<SimplicialComplex&>().insert_batch(
+    std::declval<const Batch_cells<typename SimplicialComplex::Vertex_handle>&>(),
+    std::declval<Nan_filtration<typename SimplicialComplex::Filtration_value>>()))>> : std::true_type {};
+
 /**
  * \class Alpha_complex Alpha_complex.h gudhi/Alpha_complex.h
  * \brief Alpha complex data structure.
@@ -152,8 +205,13 @@ class Alpha_complex {
   */
   std::vector<Internal_vertex_handle> vertices_;
 
-  /** \brief Cache for geometric constructions: circumcenter and squared radius of a simplex.*/
-  std::vector<Sphere> cache_, old_cache_;
+  /** \brief Cache for geometric constructions: circumcenter and squared radius of the faces of the current dimension.*/
+  std::vector<Sphere> cache_;
+  /** \brief Squared radii of the simplices of the current dimension, which were faces in the previous one.
+   * Their circumcenters are not needed anymore.*/
+  std::vector<FT> old_squared_radii_;
+  /** \brief Sizes of the caches during the last create_complex.*/
+  Alpha_complex_cache_statistics cache_statistics_;
 
  public:
   /** \brief Alpha_complex constructor from an OFF file name.
@@ -336,7 +394,7 @@ class Alpha_complex {
   auto radius(SimplicialComplexForAlpha& cplx, typename SimplicialComplexForAlpha::Simplex_handle s) {
     auto k = cplx.key(s);
     if(k!=cplx.null_key())
-      return kernel_.get_squared_radius(old_cache_[k]);
+      return old_squared_radii_[k];
     // Using a transform_range is slower, currently.
     thread_local std::vector<Point_d> v;
     v.clear();
@@ -361,8 +419,14 @@ class Alpha_complex {
    * @param[in] default_filtration_value Set this value to `true` if filtration values are not needed to be computed
    * (will be set to `NaN`).
    * Default value is `false` (which means compute the filtration values).
+   * @param[in] parallelism With `concurrency::PARALLEL`, the circumradii and the Gabriel tests of each dimension are
+   * computed in parallel with \ref tbb, and the filtration values are the same as with `concurrency::SEQUENTIAL` (the
+   * default). Ignored without TBB, and with `CGAL::Epeck_d` before CGAL 5.5, whose lazy numbers are not thread-safe.
    *
    * @return true if creation succeeds, false otherwise.
+   *
+   * The computation of the filtration values checks the `Cancellation_flag` of the `Cancellation_scope` of the
+   * calling thread, if any, and throws `Cancelled` if it is raised. The complex must then be discarded.
    * 
    * @pre Delaunay triangulation must be already constructed with dimension strictly greater than 0.
    * @pre The simplicial complex must be empty (no vertices)
@@ -374,7 +438,8 @@ class Alpha_complex {
   bool create_complex(SimplicialComplexForAlpha& complex,
                       Filtration_value max_alpha_square = std::numeric_limits<Filtration_value>::infinity(),
                       bool exact = false,
-                      bool default_filtration_value = false) {
+                      bool default_filtration_value = false,
+                      concurrency parallelism = concurrency::SEQUENTIAL) {
     // Filtration_value must be capable to represent the special value "Not-A-Number"
     static_assert(std::numeric_limits<Filtration_value>::has_quiet_NaN);
     // To support more general types for Filtration_value
@@ -410,38 +475,51 @@ class Alpha_complex {
         complex.insert_simplex_and_subfaces(one_vertex, std::numeric_limits<Filtration_value>::quiet_NaN());
       }
 
-      for (auto cit = triangulation_->finite_full_cells_begin();
-           cit != triangulation_->finite_full_cells_end();
-           ++cit) {
-        Vector_vertex vertexVector;
+      if constexpr (Has_insert_batch<SimplicialComplexForAlpha>::value) {
+        insert_full_cells_by_batches(complex);
+      } else {
+        for (auto cit = triangulation_->finite_full_cells_begin();
+             cit != triangulation_->finite_full_cells_end();
+             ++cit) {
+          Vector_vertex vertexVector;
 #ifdef DEBUG_TRACES
-        std::clog << "SimplicialComplex insertion ";
+          std::clog << "SimplicialComplex insertion ";
 #endif  // DEBUG_TRACES
-        for (auto vit = cit->vertices_begin(); vit != cit->vertices_end(); ++vit) {
-          if (*vit != nullptr) {
+          for (auto vit = cit->vertices_begin(); vit != cit->vertices_end(); ++vit) {
+            if (*vit != nullptr) {
 #ifdef DEBUG_TRACES
-            std::clog << " " << (*vit)->data();
+              std::clog << " " << (*vit)->data();
 #endif  // DEBUG_TRACES
-            // Vector of vertex construction for simplex_tree structure
-            vertexVector.push_back((*vit)->data());
+              // Vector of vertex construction for simplex_tree structure
+              vertexVector.push_back((*vit)->data());
+            }
           }
-        }
 #ifdef DEBUG_TRACES
-        std::clog << std::endl;
+          std::clog << std::endl;
 #endif  // DEBUG_TRACES
-        // Insert each simplex and its subfaces in the simplex tree - filtration is NaN
-        complex.insert_simplex_and_subfaces(vertexVector, std::numeric_limits<Filtration_value>::quiet_NaN());
+          // Insert each simplex and its subfaces in the simplex tree - filtration is NaN
+          complex.insert_simplex_and_subfaces(vertexVector, std::numeric_limits<Filtration_value>::quiet_NaN());
+        }
       }
     }
     // --------------------------------------------------------------------------------------------
 
     if (!default_filtration_value) {
+      const Cancellation_flag* cancellation = current_cancellation_flag();
+      cache_statistics_ = Alpha_complex_cache_statistics();
       CGAL::NT_converter<FT, Filtration_value> cgal_converter;
       // --------------------------------------------------------------------------------------------
+#ifdef GUDHI_USE_TBB
+      if (parallelism == concurrency::PARALLEL && !(Is_Epeck_D<Kernel>::value && CGAL_VERSION_NR < 1050500000))
+        parallel_alpha_filtration(complex, exact);
+      else
+#endif
       // ### For i : d -> 0
       for (int decr_dim = triangulation_->maximal_dimension(); decr_dim >= 0; decr_dim--) {
+        std::size_t num_visited = 0;
         // ### Foreach Sigma of dim i
         for (Simplex_handle f_simplex : complex.skeleton_simplex_range(decr_dim)) {
+          if ((num_visited++ & 1023) == 0) check_cancellation(cancellation);
           int f_simplex_dim = complex.dimension(f_simplex);
           if (decr_dim == f_simplex_dim) {
             // ### If filt(Sigma) is NaN : filt(Sigma) = alpha(Sigma)
@@ -465,8 +543,7 @@ class Alpha_complex {
               propagate_alpha_filtration(complex, f_simplex);
           }
         }
-        old_cache_ = std::move(cache_);
-        cache_.clear();
+        keep_only_squared_radii();
       }
       // --------------------------------------------------------------------------------------------
   
@@ -482,7 +559,408 @@ class Alpha_complex {
     return true;
   }
 
+ public:
+  /** \brief Largest numbers of circumspheres and of squared radii cached at the same time by the last
+   * `create_complex`, to estimate the memory it needs on top of the simplicial complex.
+   */
+  const Alpha_complex_cache_statistics& cache_statistics() const { return cache_statistics_; }
+
+  /** \brief Inserts a point in the Delaunay triangulation, and updates a simplex tree created by `create_complex`
+   * accordingly.
+   *
+   * Only the simplices whose vertices are all in the star of the new vertex are removed, inserted or get a new
+   * filtration value, so that the cost of an insertion is proportional to the size of the modified region of the
+   * triangulation and its neighborhood, instead of the whole complex.
+   *
+   * \tparam SimplexTree must be a `Simplex_tree`.
+   *
+   * @param[in] point Point to insert.
+   * @param[in] complex Simplex tree created by `create_complex` from this alpha complex, with the default
+   * `max_alpha_square` and `default_filtration_value`, and only modified by `insert_point` and `remove_point` since.
+   * @param[in] exact Exact filtration values computation, as in `create_complex`.
+   * @return The vertex of the point, which is the number of points given to this alpha complex so far. If the point
+   * is a duplicate of an existing one, it is not inserted in the triangulation nor in the complex, and
+   * `get_point` throws on the returned vertex, as for the duplicate points of the constructors.
+   *
+   * When the dimension of the triangulation changes, e.g. for the first points, the complex is built again from
+   * scratch. This method is not available for weighted alpha complexes, whose insertions may hide other points.
+   */
+  template <typename SimplexTree>
+  std::size_t insert_point(const Point_d& point, SimplexTree& complex, bool exact = false) {
+    static_assert(!Weighted, "insert_point is not available for weighted versions of Alpha_complex");
+    if (triangulation_ == nullptr) triangulation_ = std::make_unique<Triangulation>(kernel_.get_dimension(point));
+
+    const std::size_t vertex = vertex_handle_to_iterator_.size();
+    const std::size_t old_num_vertices = triangulation_->number_of_vertices();
+    const int old_dimension = triangulation_->current_dimension();
+    typename Triangulation::Vertex_handle pos = triangulation_->insert(point);
+    vertex_handle_to_iterator_.emplace_back();
+    // A duplicate point returns the existing vertex
+    if (triangulation_->number_of_vertices() == old_num_vertices) return vertex;  // ----- >>
+
+    pos->data() = vertex;
+    vertex_handle_to_iterator_.back() = pos;
+    // vertex is the largest index, vertices_ stays sorted
+    vertices_.push_back(vertex);
+    if (triangulation_->current_dimension() != old_dimension) {
+      rebuild_complex(complex, exact);
+    } else {
+      std::vector<Internal_vertex_handle> affected = star_vertices(pos);
+      update_complex(complex, affected, affected, exact);
+    }
+    return vertex;
+  }
+
+  /** \brief Removes the point of a vertex from the Delaunay triangulation, and updates a simplex tree created by
+   * `create_complex` accordingly, with a cost proportional to the size of the modified region as `insert_point`.
+   *
+   * \tparam SimplexTree must be a `Simplex_tree`.
+   *
+   * @param[in] vertex Vertex of the point to remove.
+   * @param[in] complex Simplex tree created by `create_complex`, as for `insert_point`.
+   * @param[in] exact Exact filtration values computation, as in `create_complex`.
+   * @exception std::out_of_range In case vertex is not found, as for `get_point`.
+   *
+   * The vertices of the other points do not change. This method is not available for weighted alpha complexes,
+   * whose removals may reveal hidden points.
+   */
+  template <typename SimplexTree>
+  void remove_point(std::size_t vertex, SimplexTree& complex, bool exact = false) {
+    static_assert(!Weighted, "remove_point is not available for weighted versions of Alpha_complex");
+    auto it = vertex_handle_to_iterator_.at(vertex);
+    if (it == nullptr) throw std::out_of_range("This vertex is missing, maybe hidden by a duplicate or another heavier point.");
+
+    // The new full cells fill the star of the removed vertex, their vertices are its neighbors
+    std::vector<Internal_vertex_handle> neighbors = star_vertices(it);
+    neighbors.erase(std::lower_bound(neighbors.begin(), neighbors.end(), static_cast<Internal_vertex_handle>(vertex)));
+    const int old_dimension = triangulation_->current_dimension();
+    triangulation_->remove(it);
+    vertex_handle_to_iterator_[vertex] = CGAL_vertex_iterator();
+    vertices_.erase(std::lower_bound(vertices_.begin(), vertices_.end(), static_cast<Internal_vertex_handle>(vertex)));
+    if (triangulation_->current_dimension() != old_dimension) {
+      rebuild_complex(complex, exact);
+    } else {
+      // The simplices of the removed vertex are looked for as well, to be removed
+      std::vector<Internal_vertex_handle> removed = neighbors;
+      removed.insert(std::lower_bound(removed.begin(), removed.end(), static_cast<Internal_vertex_handle>(vertex)),
+                     static_cast<Internal_vertex_handle>(vertex));
+      update_complex(complex, neighbors, removed, exact);
+    }
+  }
+
  private:
+  template <typename SimplexTree>
+  void rebuild_complex(SimplexTree& complex, bool exact) {
+    using Filtration_value = typename SimplexTree::Filtration_value;
+    complex.clear();
+    if (triangulation_->current_dimension() >= 1)
+      create_complex(complex, std::numeric_limits<Filtration_value>::infinity(), exact);
+    else
+      for (auto vertex : vertices_) complex.insert_simplex_and_subfaces(std::vector<Internal_vertex_handle>{vertex}, 0);
+  }
+
+  // Sorted vertices of the finite vertices of the full cells incident to v, v included
+  std::vector<Internal_vertex_handle> star_vertices(typename Triangulation::Vertex_handle v) const {
+    std::vector<typename Triangulation::Full_cell_handle> cells;
+    triangulation_->incident_full_cells(v, std::back_inserter(cells));
+    std::vector<Internal_vertex_handle> vertices;
+    for (auto cell : cells)
+      for (auto vit = cell->vertices_begin(); vit != cell->vertices_end(); ++vit)
+        if (*vit != nullptr && !triangulation_->is_infinite(*vit)) vertices.push_back((*vit)->data());
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+    return vertices;
+  }
+
+  /* Updates complex after a change of the triangulation which only modified the full cells whose finite vertices are
+   * all in affected (sorted). The simplices whose vertices are all in affected are the only ones which may have
+   * appeared, disappeared, or changed cofaces. The ones which disappeared, with all their cofaces, have their vertices
+   * in old_affected, which also contains the removed vertex, if any. */
+  template <typename SimplexTree>
+  void update_complex(SimplexTree& complex, const std::vector<Internal_vertex_handle>& affected,
+                      const std::vector<Internal_vertex_handle>& old_affected, bool exact) {
+    using Vertex_handle = typename SimplexTree::Vertex_handle;
+    using Simplex_handle = typename SimplexTree::Simplex_handle;
+    using Filtration_value = typename SimplexTree::Filtration_value;
+    // To support more general types for Filtration_value
+    using std::isnan;
+
+    // Sorted vertices of the finite full cells incident to the affected vertices, which contain all the cofaces of
+    // the affected simplices, and the indices of the cells of each affected vertex
+    std::vector<std::vector<Vertex_handle>> cells;
+    for (auto vertex : affected) {
+      std::vector<typename Triangulation::Full_cell_handle> incident;
+      triangulation_->incident_full_cells(vertex_handle_to_iterator_[vertex], std::back_inserter(incident));
+      for (auto cell : incident) {
+        if (triangulation_->is_infinite(cell)) continue;
+        std::vector<Vertex_handle> cell_vertices;
+        for (auto vit = cell->vertices_begin(); vit != cell->vertices_end(); ++vit)
+          if (*vit != nullptr) cell_vertices.push_back((*vit)->data());
+        std::sort(cell_vertices.begin(), cell_vertices.end());
+        cells.push_back(std::move(cell_vertices));
+      }
+    }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    std::map<Vertex_handle, std::vector<std::size_t>> cells_of_vertex;
+    for (std::size_t i = 0; i < cells.size(); ++i)
+      for (auto vertex : cells[i])
+        if (std::binary_search(affected.begin(), affected.end(), vertex)) cells_of_vertex[vertex].push_back(i);
+    auto is_in = [](const std::vector<Internal_vertex_handle>& vertices) {
+      return [&vertices](Vertex_handle vertex) { return std::binary_search(vertices.begin(), vertices.end(), vertex); };
+    };
+    auto is_face = [&](const std::vector<Vertex_handle>& simplex) {
+      auto found = cells_of_vertex.find(simplex.front());
+      if (found == cells_of_vertex.end()) return false;
+      for (std::size_t i : found->second)
+        if (std::includes(cells[i].begin(), cells[i].end(), simplex.begin(), simplex.end())) return true;
+      return false;
+    };
+
+    // Removes the simplices which are not in the triangulation anymore
+    for (auto vertex : old_affected) {
+      std::vector<Vertex_handle> simplex{static_cast<Vertex_handle>(vertex)};
+      Simplex_handle sh = complex.find(simplex);
+      if (sh != complex.null_simplex()) remove_missing_simplices(complex, sh, simplex, is_in(old_affected), is_face);
+    }
+    // Inserts the new full cells, with NaN values as create_complex
+    for (auto const& cell : cells)
+      if (std::all_of(cell.begin(), cell.end(), is_in(affected)))
+        complex.insert_simplex_and_subfaces(cell, std::numeric_limits<Filtration_value>::quiet_NaN());
+
+    // The affected simplices by dimension, with their sorted vertices
+    std::vector<std::vector<std::pair<Simplex_handle, std::vector<Vertex_handle>>>> simplices;
+    for (auto vertex : affected) {
+      std::vector<Vertex_handle> simplex{static_cast<Vertex_handle>(vertex)};
+      Simplex_handle sh = complex.find(simplex);
+      if (sh != complex.null_simplex()) collect_simplices(complex, sh, simplex, is_in(affected), simplices);
+    }
+    for (auto const& dim_simplices : simplices)
+      for (auto const& simplex : dim_simplices)
+        complex.assign_filtration(simplex.first, std::numeric_limits<Filtration_value>::quiet_NaN());
+
+    // Same values as create_complex, from the highest dimension: the value of a simplex is the smallest value of its
+    // cofaces if one of them is not Gabriel, its squared radius otherwise
+    CGAL::NT_converter<FT, Filtration_value> cgal_converter;
+    std::vector<Point_d> points;
+    std::vector<Vertex_handle> coface;
+    for (int dim = static_cast<int>(simplices.size()) - 1; dim >= 0; --dim) {
+      for (auto const& [sh, simplex] : simplices[dim]) {
+        // Unweighted points all have value 0
+        if (dim == 0) {
+          complex.assign_filtration(sh, 0);
+          continue;
+        }
+        points.clear();
+        for (auto vertex : simplex) points.push_back(get_point_(vertex));
+        Sphere sphere = kernel_.get_sphere(points.cbegin(), points.cend());
+        Filtration_value min_coface = std::numeric_limits<Filtration_value>::infinity();
+        bool is_gabriel = true;
+        std::vector<Vertex_handle> opposite_vertices;
+        for (std::size_t i : cells_of_vertex[simplex.front()]) {
+          if (!std::includes(cells[i].begin(), cells[i].end(), simplex.begin(), simplex.end())) continue;
+          std::set_difference(cells[i].begin(), cells[i].end(), simplex.begin(), simplex.end(),
+                              std::back_inserter(opposite_vertices));
+        }
+        std::sort(opposite_vertices.begin(), opposite_vertices.end());
+        opposite_vertices.erase(std::unique(opposite_vertices.begin(), opposite_vertices.end()),
+                                opposite_vertices.end());
+        for (auto opposite_vertex : opposite_vertices) {
+          coface = simplex;
+          coface.insert(std::lower_bound(coface.begin(), coface.end(), opposite_vertex), opposite_vertex);
+          min_coface = fmin(min_coface, complex.filtration(complex.find(coface)));
+          if (is_gabriel && !kernel_.is_gabriel(sphere, get_point_(opposite_vertex))) is_gabriel = false;
+        }
+        if (is_gabriel) {
+          auto const& sqrad = kernel_.get_squared_radius(sphere);
+#if CGAL_VERSION_NR >= 1050000000
+          if (exact) CGAL::exact(sqrad);
+#endif
+          complex.assign_filtration(sh, cgal_converter(sqrad));
+        } else {
+          complex.assign_filtration(sh, min_coface);
+        }
+      }
+    }
+    if (!exact) {
+      // Local version of make_filtration_non_decreasing, from the lowest dimension
+      for (auto const& dim_simplices : simplices)
+        for (auto const& simplex : dim_simplices)
+          for (auto boundary : complex.boundary_simplex_range(simplex.first))
+            if (complex.filtration(boundary) > complex.filtration(simplex.first))
+              complex.assign_filtration(simplex.first, complex.filtration(boundary));
+    }
+    complex.clear_filtration();
+  }
+
+  /* Removes the simplices of the subtree of sh whose vertices are all in the affected set and which are not faces of
+   * the triangulation anymore. Their cofaces are removed first, from the last child, so that the erasure does not move
+   * the children left to visit. */
+  template <typename SimplexTree, typename Is_affected, typename Is_face>
+  void remove_missing_simplices(SimplexTree& complex, typename SimplexTree::Simplex_handle sh,
+                                std::vector<typename SimplexTree::Vertex_handle>& simplex,
+                                const Is_affected& is_affected, const Is_face& is_face) {
+    if (complex.has_children(sh)) {
+      auto* children = sh->second.children();
+      for (std::size_t i = children->members().size(); i-- > 0;) {
+        auto child = std::next(children->members().begin(), i);
+        if (!is_affected(child->first)) continue;
+        simplex.push_back(child->first);
+        remove_missing_simplices(complex, child, simplex, is_affected, is_face);
+        simplex.pop_back();
+      }
+    }
+    // A vertex stays as long as it is in the triangulation, even without any coface
+    if (!(simplex.size() == 1 && vertex_handle_to_iterator_[simplex.front()] != nullptr) && !is_face(simplex)) {
+      GUDHI_CHECK(!complex.has_children(sh),
+                  std::logic_error("Alpha_complex::remove_missing_simplices - coface of a removed simplex left"));
+      complex.remove_maximal_simplex(sh);
+    }
+  }
+
+  // Appends the simplices of the subtree of sh whose vertices are all affected to simplices, by dimension
+  template <typename SimplexTree, typename Is_affected>
+  void collect_simplices(SimplexTree& complex, typename SimplexTree::Simplex_handle sh,
+                         std::vector<typename SimplexTree::Vertex_handle>& simplex, const Is_affected& is_affected,
+                         std::vector<std::vector<std::pair<typename SimplexTree::Simplex_handle,
+                                                           std::vector<typename SimplexTree::Vertex_handle>>>>&
+                             simplices) {
+    if (simplices.size() < simplex.size()) simplices.resize(simplex.size());
+    simplices[simplex.size() - 1].emplace_back(sh, simplex);
+    if (!complex.has_children(sh)) return;
+    for (auto child = sh->second.children()->members().begin(); child != sh->second.children()->members().end();
+         ++child) {
+      if (!is_affected(child->first)) continue;
+      simplex.push_back(child->first);
+      collect_simplices(complex, child, simplex, is_affected, simplices);
+      simplex.pop_back();
+    }
+  }
+
+  /* The circumspheres of the faces are only needed for the Gabriel tests of their cofaces. Once these tests are done,
+   * only the squared radii are kept, for radius() in the next dimension, and the circumcenters are freed. */
+  void keep_only_squared_radii() {
+    cache_statistics_.max_cached_spheres = (std::max)(cache_statistics_.max_cached_spheres, cache_.size());
+    cache_statistics_.max_cached_squared_radii =
+        (std::max)(cache_statistics_.max_cached_squared_radii, old_squared_radii_.size());
+    old_squared_radii_.clear();
+    old_squared_radii_.reserve(cache_.size());
+    for (auto const& sphere : cache_) old_squared_radii_.push_back(kernel_.get_squared_radius(sphere));
+    std::vector<Sphere>().swap(cache_);
+  }
+
+  /* Inserts the finite full cells with insert_batch, which sorts all their faces and fills the tree in one pass.
+   * The batches are limited to about 2^24 faces, so that this sort does not need much more memory than the tree. */
+  template <typename SimplicialComplexForAlpha>
+  void insert_full_cells_by_batches(SimplicialComplexForAlpha& complex) {
+    using Vertex_handle = typename SimplicialComplexForAlpha::Vertex_handle;
+    using Filtration_value = typename SimplicialComplexForAlpha::Filtration_value;
+
+    // Vertices of the cells of the current batch, one after the other.
+    std::vector<Vertex_handle> vertices;
+    std::vector<std::size_t> offsets(1, 0);
+    std::size_t num_faces = 0;
+    auto insert_batch = [&]() {
+      const Batch_cells<Vertex_handle> cells = boost::adaptors::transform(
+          boost::irange<std::size_t>(0, offsets.size() - 1), Batch_cell<Vertex_handle>{&vertices, &offsets});
+      complex.insert_batch(cells, Nan_filtration<Filtration_value>());
+      vertices.clear();
+      offsets.resize(1);
+      num_faces = 0;
+    };
+    for (auto cit = triangulation_->finite_full_cells_begin(); cit != triangulation_->finite_full_cells_end(); ++cit) {
+      for (auto vit = cit->vertices_begin(); vit != cit->vertices_end(); ++vit) {
+        if (*vit != nullptr) vertices.push_back((*vit)->data());
+      }
+      offsets.push_back(vertices.size());
+      num_faces += (std::size_t(1) << (offsets.back() - offsets[offsets.size() - 2])) - 1;
+      if (num_faces >= (std::size_t(1) << 24)) insert_batch();
+    }
+    if (offsets.size() > 1) insert_batch();
+  }
+
+#ifdef GUDHI_USE_TBB
+  /* Same filtration values as the sequential loop of create_complex. For each dimension, from the highest one, the
+   * radii of the simplices whose value is still NaN and the circumspheres of their faces are computed in parallel, as
+   * well as all the Gabriel tests. The values are then propagated to the faces in the same order as the sequential
+   * version, which only reads the results of the tests. */
+  template <typename SimplicialComplexForAlpha>
+  void parallel_alpha_filtration(SimplicialComplexForAlpha& complex, bool exact) {
+    using Filtration_value = typename SimplicialComplexForAlpha::Filtration_value;
+    using Simplex_handle = typename SimplicialComplexForAlpha::Simplex_handle;
+    // To support more general types for Filtration_value
+    using std::isnan;
+
+    CGAL::NT_converter<FT, Filtration_value> cgal_converter;
+    auto simplices_of_dimension = [&complex](int dim) {
+      std::vector<Simplex_handle> simplices;
+      for (Simplex_handle sh : complex.skeleton_simplex_range(dim))
+        if (complex.dimension(sh) == dim) simplices.push_back(sh);
+      return simplices;
+    };
+    std::vector<Simplex_handle> simplices = simplices_of_dimension(triangulation_->maximal_dimension());
+    std::vector<Simplex_handle> boundaries;
+    std::vector<char> gabriel;
+    for (int dim = triangulation_->maximal_dimension(); dim >= 0; dim--) {
+      check_cancellation(current_cancellation_flag());
+      // Only the task of a simplex writes its filtration value, and radius() only reads old_squared_radii_
+      tbb::parallel_for(std::size_t(0), simplices.size(), [&](std::size_t i) {
+        Simplex_handle sh = simplices[i];
+        if (!isnan(complex.filtration(sh))) return;
+        Filtration_value alpha_complex_filtration = 0.0;
+        // No need to compute squared_radius on a non-weighted single point - alpha is 0.0
+        if (Weighted || dim > 0) {
+          auto const& sqrad = radius(complex, sh);
+#if CGAL_VERSION_NR >= 1050000000
+          if(exact) CGAL::exact(sqrad);
+#endif
+          alpha_complex_filtration = cgal_converter(sqrad);
+        }
+        complex.assign_filtration(sh, alpha_complex_filtration);
+      });
+      if (dim == 0) break;
+      std::vector<Simplex_handle> faces = simplices_of_dimension(dim - 1);
+      // No need to propagate further, unweighted points all have value 0
+      if (dim > !Weighted) {
+        // All the faces are NaN at this point, the sequential version computes their circumsphere on their first visit
+        cache_.resize(faces.size());
+        tbb::parallel_for(std::size_t(0), faces.size(), [&](std::size_t i) {
+          complex.assign_key(faces[i], i);
+          thread_local std::vector<Point_d> v;
+          v.clear();
+          for (auto vertex : complex.simplex_vertex_range(faces[i]))
+            v.push_back(get_point_(vertex));
+          cache_[i] = kernel_.get_sphere(v.cbegin(), v.cend());
+        });
+        // A simplex of dimension dim has dim+1 facets
+        boundaries.resize(simplices.size() * (dim + 1));
+        gabriel.resize(simplices.size() * (dim + 1));
+        tbb::parallel_for(std::size_t(0), simplices.size(), [&](std::size_t i) {
+          std::size_t j = i * (dim + 1);
+          for (auto face_opposite_vertex : complex.boundary_opposite_vertex_simplex_range(simplices[i])) {
+            boundaries[j] = face_opposite_vertex.first;
+            gabriel[j] = kernel_.is_gabriel(cache_[complex.key(face_opposite_vertex.first)],
+                                            get_point_(face_opposite_vertex.second));
+            ++j;
+          }
+        });
+        for (std::size_t j = 0; j < boundaries.size(); ++j) {
+          Filtration_value simplex_filtration = complex.filtration(simplices[j / (dim + 1)]);
+          Simplex_handle f_boundary = boundaries[j];
+          // ### If filt(Tau) is not NaN : filt(Tau) = fmin(filt(Tau), filt(Sigma))
+          if (!isnan(complex.filtration(f_boundary)))
+            complex.assign_filtration(f_boundary, fmin(complex.filtration(f_boundary), simplex_filtration));
+          // ### Else if Tau is not Gabriel of Sigma : filt(Tau) = filt(Sigma)
+          else if (!gabriel[j])
+            complex.assign_filtration(f_boundary, simplex_filtration);
+        }
+      }
+      simplices = std::move(faces);
+      keep_only_squared_radii();
+    }
+  }
+#endif  // GUDHI_USE_TBB
+
   template <typename SimplicialComplexForAlpha, typename Simplex_handle>
   void propagate_alpha_filtration(SimplicialComplexForAlpha& complex, Simplex_handle f_simplex) {
     // From SimplicialComplexForAlpha type required to assign filtration values.
@@ -47,6 +47,7 @@
 #include <memory>       // for std::unique_ptr
 #include <type_traits>  // for std::conditional and std::enable_if
 #include <limits>  // for numeric_limits<>
+#include <iterator>  // for std::iterator_traits
 
 // Make compilation fail - required for external projects - https://github.com/GUDHI/gudhi-devel/issues/10
 #if CGAL_VERSION_NR < 1041101000
@@ -57,28 +58,60 @@ namespace Gudhi {
 
 namespace alpha_complex {
 
-// Value_from_iterator returns the filtration value from an iterator on alpha shapes values
+// Value_from_iterator returns the filtration value from an iterator on alpha shapes values, and counts the values
+// whose interval approximation was not precise enough, so that their exact value had to be computed
 //
 // FAST                         SAFE                         EXACT
 // CGAL::to_double(*iterator)   CGAL::to_double(*iterator)   CGAL::to_double(iterator->exact())
+//                              (exact if the approximation  (unless the approximation is a single double, which is
+//                              is not precise enough)       then the exact value)
 
 template <complexity Complexity>
 struct Value_from_iterator {
   template <typename Iterator>
-  static double perform(Iterator it) {
+  static double perform(Iterator it, std::size_t&) {
     // Default behaviour
     return CGAL::to_double(*it);
   }
 };
 
+template <>
+struct Value_from_iterator<complexity::SAFE> {
+  template <typename Iterator>
+  static double perform(Iterator it, std::size_t& exact_evaluations) {
+    using FT = typename std::iterator_traits<Iterator>::value_type;
+    // Same test as CGAL::to_double on a lazy number, which computes the exact value when it fails
+    if (!CGAL::has_smaller_relative_precision(it->approx(), FT::get_relative_precision_of_to_double()))
+      ++exact_evaluations;
+    return CGAL::to_double(*it);
+  }
+};
+
 template <>
 struct Value_from_iterator<complexity::EXACT> {
   template <typename Iterator>
-  static double perform(Iterator it) {
+  static double perform(Iterator it, std::size_t& exact_evaluations) {
+    // Lattice inputs often give values that are exactly represented by a double, and their interval is a single point
+    const auto& approx = it->approx();
+    if (approx.inf() == approx.sup()) return approx.inf();
+    ++exact_evaluations;
     return CGAL::to_double(it->exact());
   }
 };
 
+/**
+ * \brief Number of filtration values computed by the last `Alpha_complex_3d::create_complex`, and how many of them
+ * needed an exact evaluation because their interval approximation was not precise enough.
+ *
+ * \ingroup alpha_complex
+ */
+struct Alpha_complex_3d_statistics {
+  /** \brief Number of filtration values converted to `double`. */
+  std::size_t num_filtration_values = 0;
+  /** \brief Number of these values for which the exact number type was used. Always 0 with `complexity::FAST`. */
+  std::size_t num_exact_evaluations = 0;
+};
+
 /**
  * \class Alpha_complex_3d
  * \brief Alpha complex data structure for 3d specific case.
@@ -463,6 +496,7 @@ Weighted_alpha_complex_3d::Weighted_point_3 wp0(Weighted_alpha_complex_3d::Bare_
       return false;  // ----- >>
     }
 
+    statistics_ = Alpha_complex_3d_statistics();
     using Alpha_value_iterator = typename std::vector<FT>::const_iterator;
     Alpha_value_iterator alpha_value_iterator = alpha_values.begin();
     for (auto object_iterator : objects) {
@@ -534,7 +568,9 @@ Weighted_alpha_complex_3d::Weighted_point_3 wp0(Weighted_alpha_complex_3d::Bare_
         }
       }
       // Construction of the simplex_tree
-      Filtration_value filtr = Value_from_iterator<Complexity>::perform(alpha_value_iterator);
+      Filtration_value filtr = Value_from_iterator<Complexity>::perform(alpha_value_iterator,
+                                                                        statistics_.num_exact_evaluations);
+      ++statistics_.num_filtration_values;
 
 #ifdef DEBUG_TRACES
       std::clog << "filtration = " << filtr << std::endl;
@@ -561,6 +597,11 @@ Weighted_alpha_complex_3d::Weighted_point_3 wp0(Weighted_alpha_complex_3d::Bare_
     return true;
   }
 
+  /** \brief Returns how many filtration values the last `create_complex` computed, and how many of them needed the
+   * exact number type, which is much slower than the interval approximation.
+   */
+  const Alpha_complex_3d_statistics& statistics() const { return statistics_; }
+
   /** \brief get_point returns the point corresponding to the vertex given as parameter.
    *
    * @param[in] vertex Vertex handle of the point to retrieve.
@@ -587,6 +628,8 @@ Weighted_alpha_complex_3d::Weighted_point_3 wp0(Weighted_alpha_complex_3d::Bare_
   std::unordered_map<Alpha_vertex_handle, std::size_t> map_cgal_simplex_tree;
   // Vector type to switch from simplex tree vertex handle to CGAL vertex iterator.
   std::vector<Alpha_vertex_handle> cgal_vertex_iterator_vector;
+  // Counters of the last create_complex.
+  Alpha_complex_3d_statistics statistics_;
 };
 
 }  // namespace alpha_complex
@@ -26,6 +26,16 @@ enum class complexity : char {
   EXACT = 'e',  ///< Exact version.
 };
 
+/**
+ * \brief Whether Alpha_complex::create_complex computes the filtration values with one thread or in parallel.
+ *
+ * \ingroup alpha_complex
+ */
+enum class concurrency : char {
+  SEQUENTIAL = 's',  ///< One thread.
+  PARALLEL = 'p',    ///< Parallel version, with \ref tbb.
+};
+
 }  // namespace alpha_complex
 
 }  // namespace Gudhi
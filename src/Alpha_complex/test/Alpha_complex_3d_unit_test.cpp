@@ -86,6 +86,10 @@ BOOST_AUTO_TEST_CASE(Alpha_complex_3d_from_points) {
 
   Gudhi::Simplex_tree<> exact_stree;
   exact_alpha_complex.create_complex(exact_stree);
+  // One filtration value per simplex, and the fast version never needs the exact number type
+  BOOST_CHECK(exact_alpha_complex.statistics().num_filtration_values == exact_stree.num_simplices());
+  BOOST_CHECK(exact_alpha_complex.statistics().num_exact_evaluations <= exact_stree.num_simplices());
+  BOOST_CHECK(alpha_complex.statistics().num_exact_evaluations == 0);
 
   for (std::size_t index = 0; index < exact_points.size(); index++) {
     bool found = false;
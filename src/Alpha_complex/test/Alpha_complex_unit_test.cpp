@@ -16,19 +16,26 @@
 #include <CGAL/Epick_d.h>
 #include <CGAL/Epeck_d.h>
 
+#include <algorithm>  // for std::sort, std::min
 #include <stdexcept> // std::out_of_range
 #include <string>
 #include <vector>
+#include <utility>  // for std::pair
 
 #include <gudhi/Alpha_complex.h>
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/Unitary_tests_utils.h>
+#include <gudhi/random_point_generators.h>
 
 // Use static dimension_tag for the user not to be able to set dimension
 typedef CGAL::Epeck_d< CGAL::Dimension_tag<4> > Kernel_4;
 typedef Kernel_4::Point_d Point_4;
 typedef std::vector<Point_4> Vector_4_Points;
 
+// The Simplex_tree is filled with insert_batch
+static_assert(Gudhi::alpha_complex::Has_insert_batch<Gudhi::Simplex_tree<>>::value);
+static_assert(Gudhi::alpha_complex::Has_insert_batch<Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_persistence>>::value);
+
 bool is_point_in_list(Vector_4_Points points_list, Point_4 point) {
   for (auto& point_in_list : points_list) {
     if (point_in_list == point) {
@@ -223,3 +230,66 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(Alpha_complex_with_duplicated_points, TestedKernel
     } catch (...) {}
   BOOST_CHECK(found == simplex_tree.num_vertices());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(Alpha_complex_parallel_filtration, TestedKernel, list_of_kernel_2_variants) {
+  using Point = typename TestedKernel::Point_d;
+  std::vector<Point> points = Gudhi::generate_points_on_sphere_d<TestedKernel>(200, 2, 1.);
+  // Some points inside the circle, for non Gabriel edges
+  for (double x = -0.5; x < 0.6; x += 0.25) points.push_back(Point(x, 0.1 * x));
+  Gudhi::alpha_complex::Alpha_complex<TestedKernel> alpha_complex_from_points(points);
+
+  Gudhi::Simplex_tree<> sequential, parallel;
+  BOOST_CHECK(alpha_complex_from_points.create_complex(sequential));
+  BOOST_CHECK(alpha_complex_from_points.create_complex(parallel, std::numeric_limits<double>::infinity(), false, false,
+                                                       Gudhi::alpha_complex::concurrency::PARALLEL));
+  std::clog << "sequential.num_simplices()=" << sequential.num_simplices() << std::endl;
+  BOOST_CHECK(sequential == parallel);
+  // In 2d, only the circumspheres of the edges are computed, and their squared radii are kept for one dimension
+  std::size_t num_edges = 0;
+  for (auto sh : sequential.skeleton_simplex_range(1))
+    if (sequential.dimension(sh) == 1) ++num_edges;
+  BOOST_CHECK(alpha_complex_from_points.cache_statistics().max_cached_spheres == num_edges);
+  BOOST_CHECK(alpha_complex_from_points.cache_statistics().max_cached_squared_radii == num_edges);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(Alpha_complex_insert_and_remove_points, TestedKernel, list_of_kernel_2_variants) {
+  using Point = typename TestedKernel::Point_d;
+  std::vector<Point> points = Gudhi::generate_points_in_ball_d<TestedKernel>(60, 2, 1.);
+  Gudhi::alpha_complex::Alpha_complex<TestedKernel> incremental(std::vector<Point>(points.begin(), points.begin() + 40));
+  Gudhi::Simplex_tree<> stree;
+  BOOST_CHECK(incremental.create_complex(stree));
+  for (std::size_t i = 40; i < points.size(); ++i) BOOST_CHECK(incremental.insert_point(points[i], stree) == i);
+  // A duplicate gets a vertex, without point
+  BOOST_CHECK(incremental.insert_point(points[1], stree) == points.size());
+  BOOST_CHECK_THROW(incremental.get_point(points.size()), std::out_of_range);
+  // Removes every third point
+  std::vector<Point> remaining;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    if (i % 3 == 0)
+      incremental.remove_point(i, stree);
+    else
+      remaining.push_back(points[i]);
+  }
+  BOOST_CHECK_THROW(incremental.get_point(0), std::out_of_range);
+  BOOST_CHECK_THROW(incremental.remove_point(0, stree), std::out_of_range);
+  BOOST_CHECK(incremental.num_vertices() == remaining.size());
+
+  // Same complex as from scratch, up to the numbering of the vertices
+  Gudhi::alpha_complex::Alpha_complex<TestedKernel> from_scratch(remaining);
+  Gudhi::Simplex_tree<> expected;
+  BOOST_CHECK(from_scratch.create_complex(expected));
+  auto dimensions_and_values = [](Gudhi::Simplex_tree<>& complex) {
+    std::vector<std::pair<int, double>> simplices;
+    for (auto sh : complex.complex_simplex_range())
+      simplices.emplace_back(complex.dimension(sh), complex.filtration(sh));
+    std::sort(simplices.begin(), simplices.end());
+    return simplices;
+  };
+  auto simplices = dimensions_and_values(stree);
+  auto expected_simplices = dimensions_and_values(expected);
+  BOOST_CHECK(simplices.size() == expected_simplices.size());
+  for (std::size_t i = 0; i < std::min(simplices.size(), expected_simplices.size()); ++i) {
+    BOOST_CHECK(simplices[i].first == expected_simplices[i].first);
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(simplices[i].second, expected_simplices[i].second, 1e-10);
+  }
+}
@@ -5,68 +5,228 @@
  *    Copyright (C) 2022 Inria
  *
  *    Modification(s):
- *      - YYYY/MM Author: Description of the modification
+ *      - 2023/10 David Loiseaux: Suite covering the low dimensional persistence engines and the input types
  */
 
+// Benchmark of the cubical complexes and of their persistence, for random images of 8 bits integers (uint8, with
+// many ties) and of floats, on squares of side 256 to 8192 and cubes of side 64 to 512:
+// - compute_persistence_of_function_on_line (_persistence_on_a_line in Python), on the pixels of the squares,
+// - persistence_on_rectangle_from_top_cells (_persistence_on_rectangle_from_top_cells in Python), on doubles as the
+//   Python binding does, and on the input type itself,
+// - persistence_on_cuboid_from_top_cells (_persistence_on_cuboid_from_top_cells in Python),
+// - the construction of a generic Bitmap_cubical_complex, from top cells and from vertices, and its persistence,
+// - the same with periodic boundary conditions in all directions.
+// The generic complexes store all the cells, so they are only built up to max_generic_values values, and their
+// persistence is only computed up to max_generic_persistence_values values.
+// The timings are printed as a JSON array, on the standard output or in the file given as first argument. The largest
+// sides of the squares and of the cubes can be reduced for a quick run, e.g.
+//   bitmap_cubical_complex_benchmark cubical_benchmark.json 1024 128
+
 #include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Persistence_on_a_line.h>
+#include <gudhi/Persistence_on_rectangle.h>
+#include <gudhi/Persistence_on_cuboid.h>
 #include <gudhi/Clock.h>
 
 #include <vector>
+#include <cstdint>
 #include <cstdlib>
-#include <cmath>
 #include <random>
 #include <algorithm>
+#include <functional>  // for std::multiplies
+#include <numeric>  // for std::accumulate
+#include <limits>
+#include <type_traits>  // for std::is_integral_v
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using Bitmap_cubical_complex_base = Gudhi::cubical_complex::Bitmap_cubical_complex_base<double>;
+using Bitmap_cubical_complex = Gudhi::cubical_complex::Bitmap_cubical_complex<Bitmap_cubical_complex_base>;
+using Periodic_cubical_complex_base =
+    Gudhi::cubical_complex::Bitmap_cubical_complex_periodic_boundary_conditions_base<double>;
+using Periodic_cubical_complex = Gudhi::cubical_complex::Bitmap_cubical_complex<Periodic_cubical_complex_base>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+
+const std::size_t max_generic_values = std::size_t(1) << 22;
+const std::size_t max_generic_persistence_values = std::size_t(1) << 20;
+
+std::mt19937 gen(42);
 
-std::random_device rd;
-std::mt19937 gen(rd());
+struct Benchmark_result {
+  std::string name;
+  std::string dtype;
+  std::vector<unsigned> sizes;
+  std::size_t num_intervals;
+  double seconds;
+};
 
-double get_random()
-{
-    std::uniform_real_distribution<double> dist(0., 1.);
-    return dist(gen);
+std::vector<Benchmark_result> results;
+
+std::size_t num_values(const std::vector<unsigned>& sizes) {
+  return std::accumulate(sizes.begin(), sizes.end(), std::size_t(1), std::multiplies<std::size_t>());
 }
 
-int main() {
+std::string shape(const std::vector<unsigned>& sizes) {
+  std::ostringstream out;
+  for (std::size_t i = 0; i < sizes.size(); i++) out << (i ? "x" : "") << sizes[i];
+  return out.str();
+}
 
-  typedef Gudhi::cubical_complex::Bitmap_cubical_complex_base<double> Bitmap_cubical_complex_base;
-  typedef Gudhi::cubical_complex::Bitmap_cubical_complex<Bitmap_cubical_complex_base> Bitmap_cubical_complex;
+// Times f, which returns the number of persistence intervals it computed (0 for a construction)
+template <class F>
+void run(const std::string& name, const std::string& dtype, const std::vector<unsigned>& sizes, F&& f) {
+  Gudhi::Clock clock(name + " " + dtype + " " + shape(sizes));
+  const std::size_t num_intervals = f();
+  clock.end();
+  std::clog << "... " << clock;
+  results.push_back({name, dtype, sizes, num_intervals, clock.num_seconds()});
+}
 
-  std::vector<unsigned> sizes_1d (1, 3000000);
-  std::vector<double> data_1d(sizes_1d[0]);
-  std::generate(data_1d.begin(), data_1d.end(), get_random);
+template <class T>
+std::vector<T> random_values(std::size_t n) {
+  std::vector<T> values(n);
+  if constexpr (std::is_integral_v<T>) {
+    std::uniform_int_distribution<int> dist(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+    for (auto& x : values) x = static_cast<T>(dist(gen));
+  } else {
+    std::uniform_real_distribution<T> dist(0, 1);
+    for (auto& x : values) x = dist(gen);
+  }
+  return values;
+}
 
-  std::vector<unsigned> sizes_5d_top_cells(5, 10);
-  std::vector<unsigned> sizes_5d_vertices(5, 11);
-  const unsigned multiplier_top_cells = round(pow(10., 5.));
-  const unsigned multiplier_vertices = round(pow(11., 5.));
-  std::vector<double> data_5d_top_cells(multiplier_top_cells), data_5d_vertices(multiplier_vertices);
-  std::generate(data_5d_top_cells.begin(), data_5d_top_cells.end(), get_random);
-  std::generate(data_5d_vertices.begin(), data_5d_vertices.end(), get_random);
+template <class Complex>
+std::size_t persistence(Complex& cpx) {
+  cpx.initialize_filtration();
+  Gudhi::persistent_cohomology::Persistent_cohomology<Complex, Field_Zp> pcoh(cpx);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  return pcoh.get_persistent_pairs().size();
+}
+
+// Generic complexes, which take the values in Fortran order, but the transposition does not matter for random data
+void benchmark_generic(const std::string& dtype, const std::vector<unsigned>& sizes, const std::vector<double>& data) {
+  const std::size_t n = num_values(sizes);
+  if (n > max_generic_values) return;
+  run("bitmap_from_top_cells", dtype, sizes, [&] {
+    Bitmap_cubical_complex cpx(sizes, data, true);
+    return std::size_t(0);
+  });
+  run("bitmap_from_vertices", dtype, sizes, [&] {
+    Bitmap_cubical_complex cpx(sizes, data, false);
+    return std::size_t(0);
+  });
+  const std::vector<bool> periodic(sizes.size(), true);
+  run("periodic_from_top_cells", dtype, sizes, [&] {
+    Periodic_cubical_complex cpx(sizes, data, periodic, true);
+    return std::size_t(0);
+  });
+  if (n > max_generic_persistence_values) return;
+  run("bitmap_persistence", dtype, sizes, [&] {
+    Bitmap_cubical_complex cpx(sizes, data, true);
+    return persistence(cpx);
+  });
+  run("periodic_persistence", dtype, sizes, [&] {
+    Periodic_cubical_complex cpx(sizes, data, periodic, true);
+    return persistence(cpx);
+  });
+}
 
-  Gudhi::Clock cub_1d_from_top_cells_creation_clock("Cubical complex creation from 3 000 000 top cells in 1D");
-  cub_1d_from_top_cells_creation_clock.begin();
-  Bitmap_cubical_complex complex_from_top_cells_1d(sizes_1d, data_1d, true);
-  std::clog << cub_1d_from_top_cells_creation_clock << std::endl;
+template <class T>
+void benchmark_2d(const std::string& dtype, unsigned side) {
+  const std::vector<unsigned> sizes{side, side};
+  const auto input = random_values<T>(num_values(sizes));
+  // The Python bindings convert the images to doubles
+  const std::vector<double> data(input.begin(), input.end());
 
-  Gudhi::Clock cub_1d_from_vertices_creation_clock("Cubical complex creation from 3 000 000 vertices in 1D");
-  cub_1d_from_vertices_creation_clock.begin();
-  Bitmap_cubical_complex complex_from_vertices_1d(sizes_1d, data_1d, false);
-  std::clog << cub_1d_from_vertices_creation_clock << std::endl;
+  run("persistence_on_a_line", dtype, {side * side}, [&] {
+    std::size_t num_intervals = 0;
+    Gudhi::persistent_cohomology::compute_persistence_of_function_on_line(data, [&](double b, double d) {
+      if (b < d) num_intervals++;
+    });
+    return num_intervals;
+  });
+  run("persistence_on_rectangle", dtype, sizes, [&] {
+    std::size_t num_intervals = 1;
+    auto out = [&](double b, double d) { if (b < d) num_intervals++; };
+    Gudhi::cubical_complex::persistence_on_rectangle_from_top_cells(data.data(), side, side, out, out);
+    return num_intervals;
+  });
+  run("persistence_on_rectangle_native", dtype, sizes, [&] {
+    std::size_t num_intervals = 1;
+    auto out = [&](T b, T d) { if (b < d) num_intervals++; };
+    Gudhi::cubical_complex::persistence_on_rectangle_from_top_cells(input.data(), side, side, out, out);
+    return num_intervals;
+  });
+  benchmark_generic(dtype, sizes, data);
+}
+
+template <class T>
+void benchmark_3d(const std::string& dtype, unsigned side) {
+  const std::vector<unsigned> sizes{side, side, side};
+  const auto input = random_values<T>(num_values(sizes));
+  const std::vector<double> data(input.begin(), input.end());
+
+  run("persistence_on_cuboid", dtype, sizes, [&] {
+    std::size_t num_intervals = 1;
+    auto out = [&](double b, double d) { if (b < d) num_intervals++; };
+    // Same choice of the index type as the Python bindings
+    if (3 * num_values({side + 1, side + 1, side + 1}) <= std::numeric_limits<std::uint32_t>::max()) {
+      const std::uint32_t n = side;
+      Gudhi::cubical_complex::persistence_on_cuboid_from_top_cells(data.data(), n, n, n, out, out, out);
+    } else {
+      const std::size_t n = side;
+      Gudhi::cubical_complex::persistence_on_cuboid_from_top_cells(data.data(), n, n, n, out, out, out);
+    }
+    return num_intervals;
+  });
+  benchmark_generic(dtype, sizes, data);
+}
 
-  Gudhi::Clock cub_5d_from_top_cells_creation_clock("Cubical complex creation from 100 000 top cells in 5D");
-  cub_5d_from_top_cells_creation_clock.begin();
-  Bitmap_cubical_complex complex_from_top_cells_5d(sizes_5d_top_cells, data_5d_top_cells, true);
-  std::clog << cub_5d_from_top_cells_creation_clock << std::endl;
+int main(int argc, char* argv[]) {
+  const unsigned max_side_2d = argc > 2 ? std::atoi(argv[2]) : 8192;
+  const unsigned max_side_3d = argc > 3 ? std::atoi(argv[3]) : 512;
 
-  Gudhi::Clock cub_5d_from_vertices1_creation_clock("Cubical complex creation from 100 000 vertices in 5D");
-  cub_5d_from_vertices1_creation_clock.begin();
-  Bitmap_cubical_complex complex_from_vertices1_5d(sizes_5d_top_cells, data_5d_top_cells, false);
-  std::clog << cub_5d_from_vertices1_creation_clock << std::endl;
+  // Generic complexes in 1D and 5D, where there is no specialized engine
+  for (const std::vector<unsigned>& sizes : {std::vector<unsigned>{3000000}, std::vector<unsigned>(5, 10)}) {
+    const auto data = random_values<double>(num_values(sizes));
+    run("bitmap_from_top_cells", "float", sizes, [&] {
+      Bitmap_cubical_complex cpx(sizes, data, true);
+      return std::size_t(0);
+    });
+    run("bitmap_from_vertices", "float", sizes, [&] {
+      Bitmap_cubical_complex cpx(sizes, data, false);
+      return std::size_t(0);
+    });
+  }
 
-  Gudhi::Clock cub_5d_from_vertices2_creation_clock("Cubical complex creation from 161 051 vertices (equivalent to 100 000 top cells) in 5D");
-  cub_5d_from_vertices2_creation_clock.begin();
-  Bitmap_cubical_complex complex_from_vertices2_5d(sizes_5d_vertices, data_5d_vertices, false);
-  std::clog << cub_5d_from_vertices2_creation_clock << std::endl;
+  for (unsigned side = 256; side <= max_side_2d; side *= 2) {
+    benchmark_2d<std::uint8_t>("uint8", side);
+    benchmark_2d<float>("float", side);
+  }
+  for (unsigned side = 64; side <= max_side_3d; side *= 2) {
+    benchmark_3d<std::uint8_t>("uint8", side);
+    benchmark_3d<float>("float", side);
+  }
 
+  std::ostringstream json;
+  json << "[\n";
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const auto& result = results[i];
+    json << "  {\"name\": \"" << result.name << "\", \"dtype\": \"" << result.dtype << "\", \"shape\": \""
+         << shape(result.sizes) << "\", \"num_values\": " << num_values(result.sizes)
+         << ", \"num_intervals\": " << result.num_intervals << ", \"seconds\": " << result.seconds << "}"
+         << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  json << "]\n";
+  if (argc > 1) {
+    std::ofstream file(argv[1]);
+    file << json.str();
+  } else {
+    std::cout << json.str();
+  }
   return 0;
 }
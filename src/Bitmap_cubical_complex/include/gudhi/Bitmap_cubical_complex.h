@@ -25,7 +25,10 @@
 #include <vector>
 #include <numeric>  // for iota
 #include <cstddef>
+#include <cstdint>
+#include <cmath>
 #include <stdexcept>
+#include <type_traits>
 
 namespace Gudhi {
 
@@ -62,7 +65,6 @@ class Bitmap_cubical_complex : public T {
   // Perseus style
   // TODO(PD) H5 files?
   // TODO(PD) binary files with little endians / big endians ?
-  // TODO(PD) constructor from a vector of elements of a type T. ?
 
   /**
    * @param[in] perseus_style_file The name of a \ref FileFormatsPerseus "Perseus-style file".
@@ -86,6 +88,19 @@ class Bitmap_cubical_complex : public T {
       : T(dimensions, cells, input_top_cells), key_associated_to_simplex(num_simplices()) {
   }
 
+  /**
+   * @param[in] dimensions The shape that should be used to interpret `cells` (in Fortran order).
+   * @param[in] cells Random access range of values convertible to `Filtration_value`, for instance the buffer of an 8
+   * or 16 bits image, which is read directly instead of being converted to a `std::vector<Filtration_value>` first.
+   * @param[in] input_top_cells If `true`, `cells` represents top-dimensional cells. If `false`, it represents vertices.
+   **/
+  template <class CellRange>
+  Bitmap_cubical_complex(const std::vector<unsigned>& dimensions,
+                         const CellRange& cells,
+                         bool input_top_cells = true)
+      : T(dimensions, cells, input_top_cells), key_associated_to_simplex(num_simplices()) {
+  }
+
   /**
    * @param[in] dimensions The shape that should be used to interpret `cells` (in Fortran order).
    * @param[in] cells The filtration values of the top-dimensional cells if `input_top_cells` is `true`,
@@ -202,6 +217,8 @@ class Bitmap_cubical_complex : public T {
   /**
    * Precompute a sorted list of the cells for filtration_simplex_range() and simplex().
    * It is automatically called by filtration_simplex_range() if needed, but NOT by simplex().
+   * When the filtration values are integers with less than 2^16 distinct levels (typically 8 or 16 bits images), or
+   * were put in bins with put_data_to_bins(), the cells are sorted in linear time with a counting sort.
    **/
   void initialize_filtration();
 
@@ -210,10 +227,11 @@ class Bitmap_cubical_complex : public T {
   //*********************************************//
 
   /**
-   * Boundary_simplex_range class provides ranges for boundary iterators.
+   * Boundary_simplex_range class provides ranges for boundary iterators. It is the Boundary_range of the
+   * underlying bitmap, which does not allocate memory.
    **/
-  typedef typename std::vector<Simplex_handle>::iterator Boundary_simplex_iterator;
-  typedef typename std::vector<Simplex_handle> Boundary_simplex_range;
+  typedef typename T::Boundary_iterator Boundary_simplex_iterator;
+  typedef typename T::Boundary_range Boundary_simplex_range;
 
   /**
    * Range of all the cells in filtration order.
@@ -230,7 +248,7 @@ class Bitmap_cubical_complex : public T {
    * boundary_simplex_range creates an object of a Boundary_simplex_range class
    * that provides ranges for the Boundary_simplex_iterator.
    **/
-  Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) { return this->get_boundary_of_a_cell(sh); }
+  Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) { return this->boundary_range(sh); }
 
   /**
    * Range of all the cells in filtration order.
@@ -263,15 +281,58 @@ class Bitmap_cubical_complex : public T {
    * Returns the extremities of edge `e`
    **/
   std::pair<Simplex_handle, Simplex_handle> endpoints(Simplex_handle e) {
-    std::vector<std::size_t> bdry = this->get_boundary_of_a_cell(e);
+    // The boundary range does not allocate, unlike get_boundary_of_a_cell, and this is called for each edge by the
+    // persistence computation
+    if (this->get_dimension_of_a_cell(e) != 1)
+      throw(
+          "Error in endpoints in Bitmap_cubical_complex class. The cell is not an edge.");
+    auto it = this->boundary_range(e).begin();
+    Simplex_handle u = *it;
+    Simplex_handle v = *++it;
 #ifdef DEBUG_TRACES
     std::clog << "std::pair<Simplex_handle, Simplex_handle> endpoints( Simplex_handle e )\n";
-    std::clog << "bdry.size() : " << bdry.size() << "\n";
 #endif
-    if (bdry.size() != 2)
-      throw(
-          "Error in endpoints in Bitmap_cubical_complex class. The cell is not an edge.");
-    return std::make_pair(bdry[0], bdry[1]);
+    return std::make_pair(u, v);
+  }
+
+  /**
+   * Same as the function of the underlying bitmap, using its coboundary range, which does not allocate memory.
+   * \pre The filtration values are assigned as per `impose_lower_star_filtration()`.
+   **/
+  std::size_t get_top_dimensional_coface_of_a_cell(std::size_t splx) {
+    while (this->get_dimension_of_a_cell(splx) != this->dimension()) {
+      std::size_t next = splx;
+      for (auto v : this->coboundary_range(splx)) {
+        if (this->get_cell_data(v) == this->get_cell_data(splx)) {
+          next = v;
+          break;
+        }
+      }
+      GUDHI_CHECK(next != splx, std::logic_error("The filtration is not a lower star filtration of the top cells"));
+      if (next == splx) break;
+      splx = next;
+    }
+    return splx;
+  }
+
+  /**
+   * Same as the function of the underlying bitmap, using its boundary range, which does not allocate memory.
+   * \pre The filtration values are assigned as per `impose_lower_star_filtration_from_vertices()`.
+   **/
+  std::size_t get_vertex_of_a_cell(std::size_t splx) {
+    while (this->get_dimension_of_a_cell(splx) != 0) {
+      std::size_t next = splx;
+      for (auto v : this->boundary_range(splx)) {
+        if (this->get_cell_data(v) == this->get_cell_data(splx)) {
+          next = v;
+          break;
+        }
+      }
+      GUDHI_CHECK(next != splx, std::logic_error("The filtration is not a lower star filtration of the vertices"));
+      if (next == splx) break;
+      splx = next;
+    }
+    return splx;
   }
 
   class Skeleton_simplex_range;
@@ -395,6 +456,9 @@ class Bitmap_cubical_complex : public T {
  protected:
   std::vector<std::size_t> key_associated_to_simplex;
   std::vector<std::size_t> sorted_cells;
+
+ private:
+  bool sort_cells_by_levels();
 };  // Bitmap_cubical_complex
 
 template <typename T>
@@ -403,6 +467,7 @@ void Bitmap_cubical_complex<T>::initialize_filtration() {
   std::clog << "void Bitmap_cubical_complex<T>::initialize_elements_ordered_according_to_filtration() \n";
 #endif
   this->sorted_cells.resize(this->data.size());
+  if (sort_cells_by_levels()) return;
   std::iota(std::begin(sorted_cells), std::end(sorted_cells), 0);
 #ifdef GUDHI_USE_TBB
   tbb::parallel_sort(sorted_cells.begin(), sorted_cells.end(),
@@ -412,6 +477,51 @@ void Bitmap_cubical_complex<T>::initialize_filtration() {
 #endif
 }
 
+// Counting sort of the cells by (level, dimension, position), where the filtration values are origin + width * level
+// (+infinity being the last level). This is the order of is_before_in_filtration. Returns false, without sorting,
+// if the values are not on such a grid with few levels.
+template <typename T>
+bool Bitmap_cubical_complex<T>::sort_cells_by_levels() {
+  typedef typename T::filtration_type Filtration_value;
+  if constexpr (!std::is_arithmetic<Filtration_value>::value) {
+    return false;
+  } else {
+    const std::size_t max_levels = std::size_t(1) << 16;
+    Filtration_value origin = this->bins_origin;
+    Filtration_value width = this->bins_width;
+    if (!(width > 0)) {
+      // Integral values, as from an 8 or 16 bits image
+      origin = std::numeric_limits<Filtration_value>::max();
+      for (auto f : this->data)
+        if (f < origin) origin = f;
+      width = 1;
+    }
+    if (this->data.empty() || !(std::abs(origin) < std::numeric_limits<Filtration_value>::max())) return false;
+
+    const std::size_t dim_plus_one = this->dimension() + 1;
+    std::vector<std::uint32_t> bucket(this->data.size());
+    std::size_t num_levels = 0;
+    for (std::size_t i = 0; i != this->data.size(); ++i) {
+      Filtration_value f = this->data[i];
+      std::size_t level = max_levels;
+      if (f != std::numeric_limits<Filtration_value>::infinity()) {
+        Filtration_value k = std::round((f - origin) / width);
+        if (!(k >= 0 && k < max_levels) || origin + width * k != f) return false;
+        level = static_cast<std::size_t>(k);
+      }
+      num_levels = std::max(num_levels, level + 1);
+      bucket[i] = level * dim_plus_one + this->get_dimension_of_a_cell(i);
+    }
+
+    // Stable, so the cells in the same bucket stay sorted by position
+    std::vector<std::size_t> offsets(num_levels * dim_plus_one + 1, 0);
+    for (auto b : bucket) ++offsets[b + 1];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for (std::size_t i = 0; i != bucket.size(); ++i) this->sorted_cells[offsets[bucket[i]]++] = i;
+    return true;
+  }
+}
+
 template <typename T>
 class is_before_in_filtration {
  public:
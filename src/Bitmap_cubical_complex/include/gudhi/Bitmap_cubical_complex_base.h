@@ -12,9 +12,12 @@
 #define BITMAP_CUBICAL_COMPLEX_BASE_H_
 
 #include <gudhi/Debug_utils.h>
+#include <gudhi/Profiler_instrumentation.h>
+#include <gudhi/text_parsing.h>
 
 #include <boost/config.hpp>
 #include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
 #include <boost/range/iterator_range.hpp>
 
 #include <iostream>
@@ -29,6 +32,7 @@
 #include <cstddef>
 #include <numeric>
 #include <functional>
+#include <cmath>
 
 namespace Gudhi {
 
@@ -81,6 +85,12 @@ class Bitmap_cubical_complex_base {
    * with vector of filtration values of vertices or top dimensional cells depending on the input_top_cells flag.
    **/
   Bitmap_cubical_complex_base(const std::vector<unsigned>& dimensions, const std::vector<T>& cells, bool input_top_cells = true);
+  /**
+   * Same as the previous constructor, for any random access range of values convertible to T, for instance the
+   * buffer of an 8 or 16 bits image, without converting it to a std::vector<T> first.
+   **/
+  template <class CellRange>
+  Bitmap_cubical_complex_base(const std::vector<unsigned>& dimensions, const CellRange& cells, bool input_top_cells = true);
 
   /**
    * Destructor of the Bitmap_cubical_complex_base class.
@@ -238,6 +248,7 @@ class Bitmap_cubical_complex_base {
    * persistence gets worst. When dealing with this type of data, one may want to put different values on cells to
    * some number of bins. The function put_data_to_bins( std::size_t number_of_bins ) is designed for that purpose.
    * The parameter of the function is the number of bins (distinct values) we want to have in the cubical complex.
+   * Bitmap_cubical_complex::initialize_filtration then sorts the cells with a counting sort on the bins.
    **/
   void put_data_to_bins(std::size_t number_of_bins);
 
@@ -284,29 +295,167 @@ class Bitmap_cubical_complex_base {
   /** Returns a range over all cells. */
   All_cells_range all_cells_range() const { return All_cells_range(all_cells_iterator_begin(), all_cells_iterator_end()); }
 
+  /**
+   * @brief Iterator through the boundary of a cell, in the same order as get_boundary_of_a_cell, so that the
+   * incidence coefficients of the boundary elements are alternating.
+   * @details The boundary elements are computed on the fly from the position of the cell and the multipliers of the
+   * bitmap, no memory is allocated.
+   **/
+  class Boundary_iterator : public boost::iterator_facade<Boundary_iterator, std::size_t const,
+                                                          boost::forward_traversal_tag, std::size_t> {
+   public:
+    Boundary_iterator() : multipliers_(nullptr), cell_(0), rest_(0), dir_(0), step_(0), odd_(false), second_(false) {}
+    Boundary_iterator(const std::vector<unsigned>& multipliers, std::size_t cell)
+        : multipliers_(&multipliers), cell_(cell), rest_(cell), dir_(multipliers.size()), step_(0), odd_(false),
+          second_(false) {
+      find_next_direction();
+    }
+
+   private:
+    friend class boost::iterator_core_access;
+
+    // Looks for the next direction in which the cell has an extent, step_ == 0 if there is none.
+    void find_next_direction() {
+      while (dir_ > 0) {
+        --dir_;
+        std::size_t position = rest_;
+        // No division by multipliers[0]=1
+        if (dir_ > 0) {
+          position = rest_ / (*multipliers_)[dir_];
+          rest_ = rest_ % (*multipliers_)[dir_];
+        }
+        if (position % 2 == 1) {
+          step_ = (*multipliers_)[dir_];
+          return;
+        }
+      }
+      step_ = 0;
+    }
+
+    void increment() {
+      if (!second_) {
+        second_ = true;
+        return;
+      }
+      second_ = false;
+      odd_ = !odd_;
+      find_next_direction();
+    }
+
+    bool equal(Boundary_iterator const& other) const {
+      return step_ == other.step_ && dir_ == other.dir_ && second_ == other.second_;
+    }
+
+    std::size_t dereference() const { return (odd_ != second_) ? cell_ + step_ : cell_ - step_; }
+
+    const std::vector<unsigned>* multipliers_;
+    std::size_t cell_;
+    std::size_t rest_;
+    std::size_t dir_;
+    std::size_t step_;
+    bool odd_;
+    bool second_;
+  };
+
   /**
    * Boundary_range class provides ranges for boundary iterators.
    **/
-  typedef typename std::vector<std::size_t>::const_iterator Boundary_iterator;
-  typedef typename std::vector<std::size_t> Boundary_range;
+  typedef boost::iterator_range<Boundary_iterator> Boundary_range;
 
   /**
-   * boundary_simplex_range creates an object of a Boundary_simplex_range class
-   * that provides ranges for the Boundary_simplex_iterator.
+   * boundary_range creates an object of a Boundary_range class
+   * that provides ranges for the Boundary_iterator. Unlike get_boundary_of_a_cell, it does not allocate.
    **/
-  Boundary_range boundary_range(std::size_t sh) { return this->get_boundary_of_a_cell(sh); }
+  Boundary_range boundary_range(std::size_t sh) const {
+    return Boundary_range(Boundary_iterator(this->multipliers, sh), Boundary_iterator());
+  }
+
+  /**
+   * @brief Iterator through the coboundary of a cell, in the same order as get_coboundary_of_a_cell.
+   * @details The coboundary elements are computed on the fly from the position of the cell, no memory is allocated.
+   **/
+  class Coboundary_iterator : public boost::iterator_facade<Coboundary_iterator, std::size_t const,
+                                                            boost::forward_traversal_tag, std::size_t> {
+   public:
+    Coboundary_iterator() : bitmap_(nullptr), cell_(0), rest_(0), dir_(0), step_(0), position_(0), side_(2) {}
+    Coboundary_iterator(const Bitmap_cubical_complex_base& bitmap, std::size_t cell)
+        : bitmap_(&bitmap), cell_(cell), rest_(cell), dir_(bitmap.multipliers.size()), step_(0), position_(0),
+          side_(2) {
+      if (find_next_direction()) find_next_cell();
+    }
+
+   private:
+    friend class boost::iterator_core_access;
+
+    // Looks for the next direction in which the cell has no extent.
+    bool find_next_direction() {
+      while (dir_ > 0) {
+        --dir_;
+        position_ = rest_;
+        // No division by multipliers[0]=1
+        if (dir_ > 0) {
+          position_ = rest_ / bitmap_->multipliers[dir_];
+          rest_ = rest_ % bitmap_->multipliers[dir_];
+        }
+        if (position_ % 2 == 0) {
+          step_ = bitmap_->multipliers[dir_];
+          side_ = 0;
+          return true;
+        }
+      }
+      step_ = 0;
+      side_ = 2;
+      return false;
+    }
+
+    // Skips the cofaces that would be outside of the bitmap.
+    void find_next_cell() {
+      while (true) {
+        if (side_ == 0 && cell_ > step_ && position_ != 0) return;
+        if (cell_ + step_ < bitmap_->data.size() && position_ != 2 * bitmap_->sizes[dir_]) {
+          side_ = 1;
+          return;
+        }
+        if (!find_next_direction()) return;
+      }
+    }
+
+    void increment() {
+      if (side_ == 0) {
+        side_ = 1;
+      } else if (!find_next_direction()) {
+        return;
+      }
+      find_next_cell();
+    }
+
+    bool equal(Coboundary_iterator const& other) const {
+      return step_ == other.step_ && dir_ == other.dir_ && side_ == other.side_;
+    }
+
+    std::size_t dereference() const { return (side_ == 0) ? cell_ - step_ : cell_ + step_; }
+
+    const Bitmap_cubical_complex_base* bitmap_;
+    std::size_t cell_;
+    std::size_t rest_;
+    std::size_t dir_;
+    std::size_t step_;
+    std::size_t position_;
+    int side_;
+  };
 
   /**
-   * Coboundary_range class provides ranges for boundary iterators.
+   * Coboundary_range class provides ranges for coboundary iterators.
    **/
-  typedef typename std::vector<std::size_t>::const_iterator Coboundary_iterator;
-  typedef typename std::vector<std::size_t> Coboundary_range;
+  typedef boost::iterator_range<Coboundary_iterator> Coboundary_range;
 
   /**
-   * boundary_simplex_range creates an object of a Boundary_simplex_range class
-   * that provides ranges for the Boundary_simplex_iterator.
+   * coboundary_range creates an object of a Coboundary_range class
+   * that provides ranges for the Coboundary_iterator. Unlike get_coboundary_of_a_cell, it does not allocate.
    **/
-  Coboundary_range coboundary_range(std::size_t sh) { return this->get_coboundary_of_a_cell(sh); }
+  Coboundary_range coboundary_range(std::size_t sh) const {
+    return Coboundary_range(Coboundary_iterator(*this, sh), Coboundary_iterator());
+  }
 
   /**
    * @brief Iterator through top dimensional cells of the complex. The cells appear in order they are stored
@@ -557,6 +706,10 @@ class Bitmap_cubical_complex_base {
   std::vector<unsigned> sizes;
   std::vector<unsigned> multipliers;
   std::vector<T> data;
+  // Filtration values put in bins by put_data_to_bins are bins_origin + bins_width * k for integers k. A width of
+  // 0 means that put_data_to_bins was not called.
+  T bins_origin = 0;
+  T bins_width = 0;
 
   template <class F> void for_each_vertex_rec(F&&f, std::size_t base, int dim);
   void propagate_from_vertices_rec(int special_dim, int current_dim, std::size_t base);
@@ -573,6 +726,7 @@ class Bitmap_cubical_complex_base {
       this->data = std::vector<T>(multiplier, std::numeric_limits<T>::infinity());
     else
       this->data = std::vector<T>(multiplier, -std::numeric_limits<T>::infinity());
+    GUDHI_PROFILE_COUNT("Bitmap_cubical_complex cells added", multiplier);
   }
 
   std::size_t compute_position_in_bitmap(const std::vector<unsigned>& counter) {
@@ -597,10 +751,12 @@ class Bitmap_cubical_complex_base {
     return counter;
   }
   void read_perseus_style_file(const char* perseus_style_file);
+  template <class CellRange>
   void setup_bitmap_based_on_top_dimensional_cells_list(const std::vector<unsigned>& sizes_in_following_directions,
-                                                        const std::vector<T>& top_dimensional_cells);
+                                                        const CellRange& top_dimensional_cells);
+  template <class CellRange>
   void setup_bitmap_based_on_vertices(const std::vector<unsigned>& sizes_in_following_directions,
-                                      const std::vector<T>& vertices);
+                                      const CellRange& vertices);
   Bitmap_cubical_complex_base(const char* perseus_style_file, const std::vector<bool>& directions);
   Bitmap_cubical_complex_base(const std::vector<unsigned>& sizes, const std::vector<bool>& directions);
   Bitmap_cubical_complex_base(const std::vector<unsigned>& dimensions, const std::vector<T>& cells,
@@ -612,34 +768,42 @@ void Bitmap_cubical_complex_base<T>::put_data_to_bins(std::size_t number_of_bins
 
   std::pair<T, T> min_max = this->min_max_filtration();
   T dx = (min_max.second - min_max.first) / (T)number_of_bins;
+  if (!(dx > 0)) return;
 
   // now put the data into the appropriate bins:
   for (std::size_t i = 0; i != this->data.size(); ++i) {
 #ifdef DEBUG_TRACES
     std::clog << "Before binning : " << this->data[i] << std::endl;
 #endif
-    this->data[i] = min_max.first + dx * (this->data[i] - min_max.first) / number_of_bins;
+    // The maximum goes to the last bin, not to a new one.
+    T bin = std::min(std::floor((this->data[i] - min_max.first) / dx), (T)(number_of_bins - 1));
+    this->data[i] = min_max.first + dx * bin;
 #ifdef DEBUG_TRACES
     std::clog << "After binning : " << this->data[i] << std::endl;
 #endif
   }
+  this->bins_origin = min_max.first;
+  this->bins_width = dx;
 }
 
 template <typename T>
 void Bitmap_cubical_complex_base<T>::put_data_to_bins(T diameter_of_bin) {
   std::pair<T, T> min_max = this->min_max_filtration();
+  if (!(diameter_of_bin > 0)) return;
 
-  std::size_t number_of_bins = (min_max.second - min_max.first) / diameter_of_bin;
   // now put the data into the appropriate bins:
   for (std::size_t i = 0; i != this->data.size(); ++i) {
 #ifdef DEBUG_TRACES
     std::clog << "Before binning : " << this->data[i] << std::endl;
 #endif
-    this->data[i] = min_max.first + diameter_of_bin * (this->data[i] - min_max.first) / number_of_bins;
+    T bin = std::floor((this->data[i] - min_max.first) / diameter_of_bin);
+    this->data[i] = min_max.first + diameter_of_bin * bin;
 #ifdef DEBUG_TRACES
     std::clog << "After binning : " << this->data[i] << std::endl;
 #endif
   }
+  this->bins_origin = min_max.first;
+  this->bins_width = diameter_of_bin;
 }
 
 template <typename T>
@@ -658,8 +822,9 @@ Bitmap_cubical_complex_base<T>::Bitmap_cubical_complex_base(const std::vector<un
 }
 
 template <typename T>
+template <class CellRange>
 void Bitmap_cubical_complex_base<T>::setup_bitmap_based_on_top_dimensional_cells_list(
-    const std::vector<unsigned>& sizes_in_following_directions, const std::vector<T>& top_dimensional_cells) {
+    const std::vector<unsigned>& sizes_in_following_directions, const CellRange& top_dimensional_cells) {
   this->set_up_containers(sizes_in_following_directions, true);
   std::size_t number_of_top_dimensional_elements = std::accumulate(std::begin(sizes_in_following_directions),
                                                    std::end(sizes_in_following_directions), std::size_t(1),
@@ -679,15 +844,16 @@ void Bitmap_cubical_complex_base<T>::setup_bitmap_based_on_top_dimensional_cells
   std::size_t index = 0;
   for (auto it = this->top_dimensional_cells_iterator_begin();
        it != this->top_dimensional_cells_iterator_end(); ++it) {
-    this->get_cell_data(*it) = top_dimensional_cells[index];
+    this->get_cell_data(*it) = static_cast<T>(top_dimensional_cells[index]);
     ++index;
   }
   this->impose_lower_star_filtration();
 }
 
 template <typename T>
+template <class CellRange>
 void Bitmap_cubical_complex_base<T>::setup_bitmap_based_on_vertices(const std::vector<unsigned>& sizes_in_following_directions,
-                                                                    const std::vector<T>& vertices) {
+                                                                    const CellRange& vertices) {
   std::vector<unsigned> top_cells_sizes;
   std::transform (sizes_in_following_directions.begin(), sizes_in_following_directions.end(), std::back_inserter(top_cells_sizes),
                [](int i){ return i-1;});
@@ -707,7 +873,7 @@ void Bitmap_cubical_complex_base<T>::setup_bitmap_based_on_vertices(const std::v
         "sizes_in_following_directions vector is different from the size of vertices vector.");
   }
 
-  for_each_vertex([this, &vertices, index=(std::size_t)0] (auto cell) mutable { get_cell_data(cell) = vertices[index++]; });
+  for_each_vertex([this, &vertices, index=(std::size_t)0] (auto cell) mutable { get_cell_data(cell) = static_cast<T>(vertices[index++]); });
   this->impose_lower_star_filtration_from_vertices();
 }
 
@@ -747,12 +913,36 @@ Bitmap_cubical_complex_base<T>::Bitmap_cubical_complex_base(const std::vector<un
   }
 }
 
+template <typename T>
+template <class CellRange>
+Bitmap_cubical_complex_base<T>::Bitmap_cubical_complex_base(const std::vector<unsigned>& sizes_in_following_directions,
+                                                            const CellRange& cells, bool input_top_cells) {
+  if (input_top_cells) {
+    this->setup_bitmap_based_on_top_dimensional_cells_list(sizes_in_following_directions, cells);
+  } else {
+    this->setup_bitmap_based_on_vertices(sizes_in_following_directions, cells);
+  }
+}
+
 template <typename T>
 void Bitmap_cubical_complex_base<T>::read_perseus_style_file(const char* perseus_style_file) {
-  std::ifstream inFiltration(perseus_style_file);
-  if(!inFiltration) throw std::ios_base::failure(std::string("Could not open the file ") + perseus_style_file);
-  unsigned dimensionOfData;
-  inFiltration >> dimensionOfData;
+  namespace tp = Gudhi::text_parsing;
+  std::string buffer;
+  if (!tp::read_file(perseus_style_file, buffer))
+    throw std::ios_base::failure(std::string("Could not open the file ") + perseus_style_file);
+  const char* p = buffer.c_str();
+  const char* const buffer_end = p + buffer.size();
+  // The header values can be on one or several lines
+  auto read_size = [&p, buffer_end]() {
+    while (p != buffer_end && tp::is_space(*p)) ++p;
+    unsigned value = 0;
+    const char* next = tp::parse_number(p, buffer_end, value);
+    if (next == p) throw std::ios_base::failure("Bad Perseus file format. The header is incorrect");
+    p = next;
+    return value;
+  };
+
+  unsigned dimensionOfData = read_size();
 
 #ifdef DEBUG_TRACES
   std::clog << "dimensionOfData : " << dimensionOfData << std::endl;
@@ -763,8 +953,7 @@ void Bitmap_cubical_complex_base<T>::read_perseus_style_file(const char* perseus
   // all dimensions multiplied
   std::size_t dimensions = 1;
   for (std::size_t i = 0; i != dimensionOfData; ++i) {
-    unsigned size_in_this_dimension;
-    inFiltration >> size_in_this_dimension;
+    unsigned size_in_this_dimension = read_size();
     sizes.push_back(size_in_this_dimension);
     dimensions *= size_in_this_dimension;
 #ifdef DEBUG_TRACES
@@ -775,15 +964,15 @@ void Bitmap_cubical_complex_base<T>::read_perseus_style_file(const char* perseus
 
   Bitmap_cubical_complex_base<T>::Top_dimensional_cells_iterator it = this->top_dimensional_cells_iterator_begin();
 
-  T filtrationLevel = 0.;
   std::size_t filtration_counter = 0;
-  while (!inFiltration.eof()) {
-    std::string line;
-    getline(inFiltration, line);
-    if (line.length() != 0) {
-      int n = sscanf(line.c_str(), "%lf", &filtrationLevel);
-      if (n != 1) {
-        std::string perseus_error("Bad Perseus file format. This line is incorrect : " + line);
+  // One value at the beginning of each non-blank line, the rest of the line is ignored.
+  while (p < buffer_end) {
+    const char* line_end = tp::line_end(p, buffer_end);
+    const char* q = tp::skip_blanks(p, line_end);
+    if (q != line_end) {
+      double filtrationLevel;
+      if (tp::parse_number(q, line_end, filtrationLevel) == q) {
+        std::string perseus_error("Bad Perseus file format. This line is incorrect : " + std::string(p, line_end));
         throw std::ios_base::failure(perseus_error.c_str());
       }
 
@@ -792,10 +981,13 @@ void Bitmap_cubical_complex_base<T>::read_perseus_style_file(const char* perseus
                 << " and dimension: " << this->get_dimension_of_a_cell(it.compute_index_in_bitmap())
                 << " get the value : " << filtrationLevel << std::endl;
 #endif
-      this->get_cell_data(*it) = filtrationLevel;
-      ++it;
+      if (filtration_counter < dimensions) {
+        this->get_cell_data(*it) = filtrationLevel;
+        ++it;
+      }
       ++filtration_counter;
     }
+    p = line_end + 1;
   }
 
   if (filtration_counter != dimensions) {
@@ -804,7 +996,6 @@ void Bitmap_cubical_complex_base<T>::read_perseus_style_file(const char* perseus
     throw std::ios_base::failure(perseus_error);
   }
 
-  inFiltration.close();
   this->impose_lower_star_filtration();
 }
 
@@ -886,27 +1077,26 @@ std::vector<std::size_t> Bitmap_cubical_complex_base<T>::get_boundary_of_a_cell(
 
 template <typename T>
 std::vector<std::size_t> Bitmap_cubical_complex_base<T>::get_coboundary_of_a_cell(std::size_t cell) const {
-  std::vector<unsigned> counter = this->compute_counter_for_given_cell(cell);
   std::vector<std::size_t> coboundary_elements;
   std::size_t cell1 = cell;
   for (std::size_t i = this->multipliers.size(); i > 1; --i) {
-    // It is a bit sad to recompute those divisions when we just did them in compute_counter_for_given_cell.
-    unsigned position = cell1 / this->multipliers[i - 1];
+    // The position is the counter of the cell in this direction, as in compute_counter_for_given_cell.
+    std::size_t position = cell1 / this->multipliers[i - 1];
     cell1 = cell1 % this->multipliers[i - 1];
     if (position % 2 == 0) {
-      if ((cell > this->multipliers[i - 1]) && (counter[i - 1] != 0)) {
+      if ((cell > this->multipliers[i - 1]) && (position != 0)) {
         coboundary_elements.push_back(cell - this->multipliers[i - 1]);
       }
-      if ((cell + this->multipliers[i - 1] < this->data.size()) && (counter[i - 1] != 2 * this->sizes[i - 1])) {
+      if ((cell + this->multipliers[i - 1] < this->data.size()) && (position != 2 * this->sizes[i - 1])) {
         coboundary_elements.push_back(cell + this->multipliers[i - 1]);
       }
     }
   }
   if (cell1 % 2 == 0) {
-    if ((cell > 1) && (counter[0] != 0)) {
+    if ((cell > 1) && (cell1 != 0)) {
       coboundary_elements.push_back(cell - 1);
     }
-    if ((cell + 1 < this->data.size()) && (counter[0] != 2 * this->sizes[0])) {
+    if ((cell + 1 < this->data.size()) && (cell1 != 2 * this->sizes[0])) {
       coboundary_elements.push_back(cell + 1);
     }
   }
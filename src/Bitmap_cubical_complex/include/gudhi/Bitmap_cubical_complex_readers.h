@@ -0,0 +1,238 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef BITMAP_CUBICAL_COMPLEX_READERS_H_
+#define BITMAP_CUBICAL_COMPLEX_READERS_H_
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>  // for std::memcpy
+#include <utility>  // for std::forward
+
+namespace Gudhi {
+
+namespace cubical_complex {
+
+namespace detail {
+
+template <class Value>
+void byteswap_values(std::vector<Value>& values) {
+  for (auto& v : values) {
+    unsigned char bytes[sizeof(Value)];
+    std::memcpy(bytes, &v, sizeof(Value));
+    std::reverse(bytes, bytes + sizeof(Value));
+    std::memcpy(&v, bytes, sizeof(Value));
+  }
+}
+
+inline bool is_little_endian() {
+  const std::uint16_t one = 1;
+  unsigned char first_byte;
+  std::memcpy(&first_byte, &one, 1);
+  return first_byte == 1;
+}
+
+// Reads num_values values in one block, from the current position of the stream.
+template <class Value>
+std::vector<Value> read_values(std::ifstream& in, std::size_t num_values, bool little_endian, const char* filename) {
+  std::vector<Value> values(num_values);
+  in.read(reinterpret_cast<char*>(values.data()), num_values * sizeof(Value));
+  if (static_cast<std::size_t>(in.gcount()) != num_values * sizeof(Value))
+    throw std::ios_base::failure(std::string("The file ") + filename + " is too short for the announced volume");
+  if (sizeof(Value) > 1 && little_endian != is_little_endian()) byteswap_values(values);
+  return values;
+}
+
+// Calls f(sizes, values) with a std::vector of the type described by kind ('u', 'i' or 'f') and size in bytes.
+template <class Function>
+void read_values_and_call(std::ifstream& in, char kind, std::size_t size, bool little_endian,
+                          const std::vector<unsigned>& sizes, const char* filename, Function&& f) {
+  std::size_t n = 1;
+  for (auto s : sizes) n *= s;
+  if (kind == 'u' && size == 1) { f(sizes, read_values<std::uint8_t>(in, n, little_endian, filename)); return; }
+  if (kind == 'i' && size == 1) { f(sizes, read_values<std::int8_t>(in, n, little_endian, filename)); return; }
+  if (kind == 'u' && size == 2) { f(sizes, read_values<std::uint16_t>(in, n, little_endian, filename)); return; }
+  if (kind == 'i' && size == 2) { f(sizes, read_values<std::int16_t>(in, n, little_endian, filename)); return; }
+  if (kind == 'u' && size == 4) { f(sizes, read_values<std::uint32_t>(in, n, little_endian, filename)); return; }
+  if (kind == 'i' && size == 4) { f(sizes, read_values<std::int32_t>(in, n, little_endian, filename)); return; }
+  if (kind == 'f' && size == 4) { f(sizes, read_values<float>(in, n, little_endian, filename)); return; }
+  if (kind == 'f' && size == 8) { f(sizes, read_values<double>(in, n, little_endian, filename)); return; }
+  throw std::invalid_argument(std::string("Unsupported type of values in the file ") + filename);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Reads a raw binary volume, without header.
+ * @ingroup cubical_complex
+ *
+ * @details The values are read in one block, and can be passed directly to the constructor of
+ * `Bitmap_cubical_complex` that takes a range of values, without parsing or converting them first.
+ *
+ * @tparam Value Type of the values stored in the file, in native byte order.
+ * @param[in] filename Name of the file.
+ * @param[in] num_values Number of values to read.
+ * @param[in] offset Number of bytes to skip at the beginning of the file, for instance a header.
+ * @exception std::ios_base::failure If the file cannot be opened or is too short.
+ */
+template <class Value>
+std::vector<Value> read_raw_volume(const char* filename, std::size_t num_values, std::size_t offset = 0) {
+  std::ifstream in(filename, std::ios::binary);
+  if (!in) throw std::ios_base::failure(std::string("Could not open the file ") + filename);
+  in.seekg(offset);
+  return detail::read_values<Value>(in, num_values, detail::is_little_endian(), filename);
+}
+
+/**
+ * @brief Reads a volume stored in a NumPy `.npy` file.
+ * @ingroup cubical_complex
+ *
+ * @details The file must contain an array of 8, 16 or 32 bits integers, or of single or double precision floats. It
+ * calls `f(sizes, values)`, where `sizes` is the shape of the array in Fortran order, as expected by
+ * `Bitmap_cubical_complex`, and `values` is a `std::vector` of the type stored in the file, for instance
+ * \code{.cpp}
+ * read_npy_volume("image.npy", [](const std::vector<unsigned>& sizes, const auto& values) {
+ *   Bitmap_cubical_complex<Bitmap_cubical_complex_base<double>> complex(sizes, values);
+ *   // ...
+ * });
+ * \endcode
+ *
+ * @exception std::ios_base::failure If the file cannot be opened, is not a `.npy` file, or is too short.
+ * @exception std::invalid_argument If the type of the values is not supported.
+ */
+template <class Function>
+void read_npy_volume(const char* filename, Function&& f) {
+  std::ifstream in(filename, std::ios::binary);
+  if (!in) throw std::ios_base::failure(std::string("Could not open the file ") + filename);
+  char magic[8];
+  in.read(magic, 8);
+  if (in.gcount() != 8 || std::memcmp(magic, "\x93NUMPY", 6) != 0)
+    throw std::ios_base::failure(std::string("The file ") + filename + " is not a .npy file");
+  // The length of the header is stored on 2 bytes in version 1, 4 bytes after that, in little endian.
+  unsigned char length_bytes[4] = {0, 0, 0, 0};
+  in.read(reinterpret_cast<char*>(length_bytes), magic[6] == 1 ? 2 : 4);
+  std::size_t header_length = length_bytes[0] | (length_bytes[1] << 8) | (std::size_t(length_bytes[2]) << 16) |
+                              (std::size_t(length_bytes[3]) << 24);
+  std::string header(header_length, ' ');
+  in.read(&header[0], header_length);
+  if (static_cast<std::size_t>(in.gcount()) != header_length)
+    throw std::ios_base::failure(std::string("The file ") + filename + " is not a .npy file");
+
+  // The header is a Python dict like {'descr': '<f8', 'fortran_order': False, 'shape': (3, 4), }
+  auto value_of = [&](const char* key) {
+    std::size_t pos = header.find(key);
+    if (pos == std::string::npos)
+      throw std::ios_base::failure(std::string("No ") + key + " in the header of the file " + filename);
+    pos = header.find(':', pos) + 1;
+    while (header[pos] == ' ') ++pos;
+    return pos;
+  };
+  std::size_t descr = value_of("'descr'") + 1;
+  char byte_order = header[descr];
+  char kind = header[descr + 1];
+  std::size_t size = header[descr + 2] - '0';
+  bool fortran_order = header.compare(value_of("'fortran_order'"), 4, "True") == 0;
+  std::vector<unsigned> sizes;
+  for (std::size_t pos = value_of("'shape'") + 1; header[pos] != ')';) {
+    if (header[pos] >= '0' && header[pos] <= '9') {
+      std::size_t end;
+      sizes.push_back(static_cast<unsigned>(std::stoul(header.substr(pos), &end)));
+      pos += end;
+    } else {
+      ++pos;
+    }
+  }
+  if (!fortran_order) std::reverse(sizes.begin(), sizes.end());
+  bool little_endian = (byte_order == '<') || (byte_order != '>' && detail::is_little_endian());
+  detail::read_values_and_call(in, kind, size, little_endian, sizes, filename, std::forward<Function>(f));
+}
+
+/**
+ * @brief Reads a volume stored in a NRRD file, with the raw encoding and the data in the same file.
+ * @ingroup cubical_complex
+ *
+ * @details Same as `read_npy_volume`, `f(sizes, values)` is called with the sizes of the volume, fastest axis first,
+ * and a `std::vector` of the type stored in the file.
+ *
+ * @exception std::ios_base::failure If the file cannot be opened, is not a NRRD file, or is too short.
+ * @exception std::invalid_argument If the type of the values or the encoding is not supported.
+ */
+template <class Function>
+void read_nrrd_volume(const char* filename, Function&& f) {
+  std::ifstream in(filename, std::ios::binary);
+  if (!in) throw std::ios_base::failure(std::string("Could not open the file ") + filename);
+  std::string line;
+  std::getline(in, line);
+  if (line.compare(0, 4, "NRRD") != 0)
+    throw std::ios_base::failure(std::string("The file ") + filename + " is not a NRRD file");
+
+  std::string type, encoding = "raw", endian = detail::is_little_endian() ? "little" : "big";
+  std::vector<unsigned> sizes;
+  // The header ends with an empty line
+  while (std::getline(in, line) && !line.empty() && line != "\r") {
+    if (line[0] == '#') continue;
+    std::size_t colon = line.find(':');
+    if (colon == std::string::npos) continue;
+    std::string field = line.substr(0, colon);
+    std::size_t start = line.find_first_not_of(' ', colon + 1);
+    std::string value = (start == std::string::npos) ? "" : line.substr(start, line.find_last_not_of(" \r") + 1 - start);
+    if (field == "type") {
+      type = value;
+    } else if (field == "encoding") {
+      encoding = value;
+    } else if (field == "endian") {
+      endian = value;
+    } else if (field == "sizes") {
+      std::size_t pos = 0, end;
+      while ((pos = value.find_first_of("0123456789", pos)) != std::string::npos) {
+        sizes.push_back(static_cast<unsigned>(std::stoul(value.substr(pos), &end)));
+        pos += end;
+      }
+    } else if (field == "data file" || field == "datafile") {
+      throw std::invalid_argument(std::string("Detached data is not supported in the file ") + filename);
+    }
+  }
+  if (encoding != "raw")
+    throw std::invalid_argument(std::string("Only the raw encoding is supported in the file ") + filename);
+
+  char kind = 0;
+  std::size_t size = 0;
+  if (type == "uchar" || type == "unsigned char" || type == "uint8" || type == "uint8_t") {
+    kind = 'u'; size = 1;
+  } else if (type == "signed char" || type == "int8" || type == "int8_t") {
+    kind = 'i'; size = 1;
+  } else if (type == "ushort" || type == "unsigned short" || type == "unsigned short int" || type == "uint16" ||
+             type == "uint16_t") {
+    kind = 'u'; size = 2;
+  } else if (type == "short" || type == "short int" || type == "signed short" || type == "signed short int" ||
+             type == "int16" || type == "int16_t") {
+    kind = 'i'; size = 2;
+  } else if (type == "uint" || type == "unsigned int" || type == "uint32" || type == "uint32_t") {
+    kind = 'u'; size = 4;
+  } else if (type == "int" || type == "signed int" || type == "int32" || type == "int32_t") {
+    kind = 'i'; size = 4;
+  } else if (type == "float") {
+    kind = 'f'; size = 4;
+  } else if (type == "double") {
+    kind = 'f'; size = 8;
+  }
+  detail::read_values_and_call(in, kind, size, endian == "little", sizes, filename, std::forward<Function>(f));
+}
+
+}  // namespace cubical_complex
+
+}  // namespace Gudhi
+
+#endif  // BITMAP_CUBICAL_COMPLEX_READERS_H_
@@ -0,0 +1,103 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// Allocation budgets of the loops over the cells of a cubical complex, only built with the cmake option
+// WITH_GUDHI_ALLOCATION_TESTS.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "cubical_complex_allocations"
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <gudhi/Allocation_counter.h>
+#include <gudhi/Bitmap_cubical_complex.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+GUDHI_COUNT_ALLOCATIONS();
+
+using Bitmap_cubical_complex =
+    Gudhi::cubical_complex::Bitmap_cubical_complex<Gudhi::cubical_complex::Bitmap_cubical_complex_base<double>>;
+using Periodic_cubical_complex = Gudhi::cubical_complex::Bitmap_cubical_complex<
+    Gudhi::cubical_complex::Bitmap_cubical_complex_periodic_boundary_conditions_base<double>>;
+
+Bitmap_cubical_complex make_complex(Bitmap_cubical_complex*, const std::vector<unsigned>& sizes,
+                                    const std::vector<double>& data, bool top_cells) {
+  return Bitmap_cubical_complex(sizes, data, top_cells);
+}
+
+Periodic_cubical_complex make_complex(Periodic_cubical_complex*, const std::vector<unsigned>& sizes,
+                                      const std::vector<double>& data, bool top_cells) {
+  return Periodic_cubical_complex(sizes, data, std::vector<bool>(sizes.size(), true), top_cells);
+}
+
+// Random bitmap of 8x7x6 values, with ties
+template <class Cubical>
+Cubical random_complex(bool top_cells) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> dist(0, 9);
+  const std::vector<unsigned> sizes{8, 7, 6};
+  std::vector<double> data(8 * 7 * 6);
+  for (auto& x : data) x = dist(gen);
+  return make_complex(static_cast<Cubical*>(nullptr), sizes, data, top_cells);
+}
+
+typedef boost::mpl::list<Bitmap_cubical_complex, Periodic_cubical_complex> list_of_complexes;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(boundary_and_coboundary_ranges, Cubical, list_of_complexes) {
+  Cubical cpx = random_complex<Cubical>(true);
+  std::size_t num_faces = 0;
+  Gudhi::allocation_counter::Scope scope;
+  for (std::size_t cell = 0; cell < cpx.num_simplices(); cell++) {
+    for (auto face : cpx.boundary_range(cell)) num_faces += face;
+    for (auto coface : cpx.coboundary_range(cell)) num_faces += coface;
+    for (auto face : cpx.boundary_simplex_range(cell)) num_faces += face;
+  }
+  BOOST_CHECK_EQUAL(scope.allocations(), 0u);
+  BOOST_CHECK(num_faces > 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(endpoints_of_the_edges, Cubical, list_of_complexes) {
+  Cubical cpx = random_complex<Cubical>(true);
+  std::size_t num_edges = 0;
+  Gudhi::allocation_counter::Scope scope;
+  for (std::size_t cell = 0; cell < cpx.num_simplices(); cell++) {
+    if (cpx.dimension(cell) != 1) continue;
+    auto [u, v] = cpx.endpoints(cell);
+    num_edges += (u != v);
+  }
+  BOOST_CHECK_EQUAL(scope.allocations(), 0u);
+  BOOST_CHECK(num_edges > 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(critical_cells, Cubical, list_of_complexes) {
+  Cubical from_top_cells = random_complex<Cubical>(true);
+  Cubical from_vertices = random_complex<Cubical>(false);
+  std::size_t sum = 0;
+  Gudhi::allocation_counter::Scope scope;
+  for (std::size_t cell = 0; cell < from_top_cells.num_simplices(); cell++)
+    sum += from_top_cells.get_top_dimensional_coface_of_a_cell(cell);
+  for (std::size_t cell = 0; cell < from_vertices.num_simplices(); cell++)
+    sum += from_vertices.get_vertex_of_a_cell(cell);
+  BOOST_CHECK_EQUAL(scope.allocations(), 0u);
+  BOOST_CHECK(sum > 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(filtration_range, Cubical, list_of_complexes) {
+  Cubical cpx = random_complex<Cubical>(true);
+  cpx.initialize_filtration();
+  double sum = 0;
+  Gudhi::allocation_counter::Scope scope;
+  for (auto sh : cpx.filtration_simplex_range()) sum += cpx.filtration(sh) * cpx.dimension(sh);
+  BOOST_CHECK_EQUAL(scope.allocations(), 0u);
+  BOOST_CHECK(sum > 0);
+}
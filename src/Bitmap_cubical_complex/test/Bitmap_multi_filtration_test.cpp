@@ -0,0 +1,213 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// Multi-parameter filtrations of cubical complexes, shipped with the python module
+// (src/python/include/Cubical_multi_filtration.h).
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "cubical_multi_filtration"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/Persistent_cohomology.h>
+
+#include "Cubical_multi_filtration.h"
+#include "Simplex_tree_multi_scc.h"
+
+#include <algorithm>
+#include <cmath>  // for std::isnan
+#include <cstdio>  // for std::remove
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>  // for std::pair
+#include <vector>
+
+using Bitmap_cubical_complex_base = Gudhi::cubical_complex::Bitmap_cubical_complex_base<double>;
+using Bitmap_cubical_complex = Gudhi::cubical_complex::Bitmap_cubical_complex<Bitmap_cubical_complex_base>;
+using Cubical_multi_filtration = Gudhi::multiparameter::Cubical_multi_filtration<double>;
+using Line = Cubical_multi_filtration::Line;
+using Point = Line::point_type;
+using Barcode = Cubical_multi_filtration::Barcode;
+
+// num_parameters consecutive blocks of n random values in [0, 1].
+std::vector<double> random_values(unsigned seed, std::size_t n, std::size_t num_parameters) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> value(0., 1.);
+  std::vector<double> values(n * num_parameters);
+  for (auto& x : values) x = value(gen);
+  return values;
+}
+
+// Line parameters of the push forward of the values of the vertices, given parameter by parameter.
+std::vector<double> pushed_forward_vertices(const std::vector<double>& values, std::size_t num_parameters,
+                                            const Line& l) {
+  const std::size_t n = values.size() / num_parameters;
+  std::vector<double> t(n, -std::numeric_limits<double>::infinity());
+  for (std::size_t parameter = 0; parameter < num_parameters; parameter++) {
+    const double b = l.basepoint()[parameter];
+    const double d = l.direction().empty() ? 1. : l.direction()[parameter];
+    for (std::size_t vertex = 0; vertex < n; vertex++) {
+      const double x = values[parameter * n + vertex];
+      if (d == 0)
+        t[vertex] = x > b ? std::numeric_limits<double>::infinity() : t[vertex];
+      else
+        t[vertex] = std::max(t[vertex], (x - b) / d);
+    }
+  }
+  return t;
+}
+
+// Barcode in the given degree of the lower-star filtration of a bitmap given on its vertices.
+Barcode reference_barcode(const std::vector<unsigned>& sizes, const std::vector<double>& vertex_values, int degree) {
+  using Persistent_cohomology =
+      Gudhi::persistent_cohomology::Persistent_cohomology<Bitmap_cubical_complex,
+                                                          Gudhi::persistent_cohomology::Field_Zp>;
+  Bitmap_cubical_complex cplx(sizes, vertex_values, false);
+  Persistent_cohomology pcoh(cplx, true);
+  pcoh.init_coefficients(11);
+  pcoh.compute_persistent_cohomology(0.);
+  const auto intervals = pcoh.intervals_in_dimension(degree);
+  Barcode barcode(intervals.begin(), intervals.end());
+  std::sort(barcode.begin(), barcode.end());
+  return barcode;
+}
+
+Barcode sorted(Barcode barcode) {
+  std::sort(barcode.begin(), barcode.end());
+  return barcode;
+}
+
+BOOST_AUTO_TEST_CASE(cubical_multi_filtration_barcodes) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "CUBICAL MULTI FILTRATION BARCODES" << std::endl;
+  const std::vector<unsigned> sizes{4, 3};
+  const std::vector<double> values = random_values(0, 12, 2);
+  const Cubical_multi_filtration filtration(sizes, values, 2, false);
+  BOOST_CHECK(filtration.num_parameters() == 2);
+  BOOST_CHECK(filtration.dimension() == 2);
+  BOOST_CHECK(filtration.num_cells() == 7 * 5);
+
+  const std::vector<Line> lines{Line(Point{0., 0.}), Line(Point{-0.2, 0.1}, Point{1., 0.5}),
+                                Line(Point{0.3, -0.4}, Point{0.25, 2.})};
+  const std::vector<int> degrees{0, 1, 2};
+  const auto barcodes = filtration.barcodes(lines, degrees);
+  BOOST_REQUIRE(barcodes.size() == lines.size());
+  std::vector<double> t;
+  for (std::size_t line = 0; line < lines.size(); line++) {
+    // The push forward of the lower-star filtration is the lower-star filtration of the pushed forward vertices.
+    const auto vertex_values = pushed_forward_vertices(values, 2, lines[line]);
+    Bitmap_cubical_complex lower_star(sizes, vertex_values, false);
+    filtration.push_forward(lines[line], t);
+    BOOST_REQUIRE(t.size() == lower_star.num_simplices());
+    for (std::size_t cell = 0; cell < t.size(); cell++) BOOST_CHECK(t[cell] == lower_star.get_cell_data(cell));
+
+    BOOST_REQUIRE(barcodes[line].size() == degrees.size());
+    for (std::size_t i = 0; i < degrees.size(); i++)
+      BOOST_CHECK(sorted(barcodes[line][i]) == reference_barcode(sizes, vertex_values, degrees[i]));
+  }
+  BOOST_CHECK(barcodes[0][0].size() >= 1);
+  BOOST_CHECK(filtration.barcodes({}, degrees).empty());
+}
+
+BOOST_AUTO_TEST_CASE(cubical_multi_filtration_push_forward_zero_direction) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "CUBICAL MULTI FILTRATION PUSH FORWARD ON A LINE WITH A ZERO DIRECTION" << std::endl;
+  const std::vector<unsigned> sizes{3, 3};
+  std::vector<double> values = random_values(1, 9, 2);
+  const Line l(Point{0.5, 0.2}, Point{0., 1.});
+  values[4] = 0.5;  // exactly on the basepoint, in the constant parameter
+  values[0] = 0.;
+  values[8] = 1.;
+  const Cubical_multi_filtration filtration(sizes, values, 2, false);
+
+  std::vector<double> t;
+  filtration.push_forward(l, t);
+  const auto vertex_values = pushed_forward_vertices(values, 2, l);
+  Bitmap_cubical_complex lower_star(sizes, vertex_values, false);
+  BOOST_REQUIRE(t.size() == lower_star.num_simplices());
+  for (std::size_t cell = 0; cell < t.size(); cell++) {
+    BOOST_CHECK(!std::isnan(t[cell]));
+    BOOST_CHECK(t[cell] == lower_star.get_cell_data(cell));
+  }
+  // The vertices of the bitmap are the cells with even coordinates, cell 2 * 5 + 2 being vertex 4.
+  BOOST_CHECK(t[12] == values[9 + 4] - 0.2);
+  BOOST_CHECK(t[0] == values[9] - 0.2);
+  BOOST_CHECK(t[24] == std::numeric_limits<double>::infinity());
+  // The sign of the zero does not matter
+  std::vector<double> negative_zero;
+  filtration.push_forward(Line(Point{0.5, 0.2}, Point{-0., 1.}), negative_zero);
+  BOOST_CHECK(negative_zero == t);
+
+  const auto barcodes = filtration.barcodes({l}, {0, 1});
+  for (int degree : {0, 1})
+    BOOST_CHECK(sorted(barcodes[0][degree]) == reference_barcode(sizes, vertex_values, degree));
+}
+
+BOOST_AUTO_TEST_CASE(cubical_multi_filtration_write_scc) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "CUBICAL MULTI FILTRATION SCC ROUND TRIP" << std::endl;
+  const std::vector<unsigned> sizes{3, 2};
+  const std::vector<double> values = random_values(2, 6, 2);
+  const Cubical_multi_filtration filtration(sizes, values, 2);
+  const std::string path = "cubical_multi_filtration.scc";
+
+  // Cells, values and boundaries of the bitmap, one filtration per parameter.
+  Bitmap_cubical_complex_base first(sizes, std::vector<double>(values.begin(), values.begin() + 6));
+  Bitmap_cubical_complex_base second(sizes, std::vector<double>(values.begin() + 6, values.end()));
+  const int dim_max = static_cast<int>(first.dimension());
+  std::vector<std::vector<std::size_t>> cells(dim_max + 1);
+  std::vector<std::uint32_t> index_in_block(first.size());
+  for (std::size_t cell = 0; cell < first.size(); cell++) {
+    auto& block = cells[first.get_dimension_of_a_cell(cell)];
+    index_in_block[cell] = static_cast<std::uint32_t>(block.size());
+    block.push_back(cell);
+  }
+
+  for (bool ignore_last_generators : {false, true}) {
+    for (bool reverse_block : {true, false}) {
+      Gudhi::multiparameter::Scc_writer_options writer_options;
+      writer_options.ignore_last_generators = ignore_last_generators;
+      writer_options.reverse_block = reverse_block;
+      filtration.write_scc(path, writer_options);
+      Gudhi::multiparameter::Scc_reader_options reader_options;
+      reader_options.reverse_block = reverse_block;
+      const auto read = Gudhi::multiparameter::read_scc_chain_complex<double>(path, reader_options);
+
+      BOOST_CHECK(read.num_parameters == 2);
+      BOOST_REQUIRE(read.blocks.size() == cells.size());
+      BOOST_CHECK(read.lowest_dimension == (ignore_last_generators ? 1 : 0));
+      for (int dim = read.lowest_dimension; dim <= dim_max; dim++) {
+        const auto& block = read.blocks[dim];
+        BOOST_REQUIRE(block.size() == cells[dim].size());
+        for (std::size_t row = 0; row < block.size(); row++) {
+          const std::size_t cell = cells[dim][row];
+          BOOST_CHECK(block.values[2 * row] == first.get_cell_data(cell));
+          BOOST_CHECK(block.values[2 * row + 1] == second.get_cell_data(cell));
+          BOOST_CHECK(block.values[2 * row] == filtration.filtration(0, cell));
+          BOOST_CHECK(block.values[2 * row + 1] == filtration.filtration(1, cell));
+          std::vector<std::uint32_t> boundary;
+          for (auto face : first.boundary_range(cell)) boundary.push_back(index_in_block[face]);
+          BOOST_CHECK(std::vector<std::uint32_t>(block.boundaries.begin() + block.offsets[row],
+                                                 block.boundaries.begin() + block.offsets[row + 1]) == boundary);
+        }
+      }
+    }
+  }
+  std::remove(path.c_str());
+
+  Gudhi::multiparameter::Scc_writer_options firep;
+  firep.rivet_compatible = true;
+  const Cubical_multi_filtration single(sizes, std::vector<double>(values.begin(), values.begin() + 6), 1);
+  BOOST_CHECK_THROW(single.write_scc(path, firep), std::invalid_argument);
+  BOOST_CHECK_THROW(Cubical_multi_filtration(sizes, values, 3), std::invalid_argument);
+}
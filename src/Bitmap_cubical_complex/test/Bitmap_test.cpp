@@ -14,13 +14,19 @@
 
 #include <gudhi/reader_utils.h>
 #include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/Bitmap_cubical_complex_readers.h>
 #include <gudhi/Persistent_cohomology.h>
 
 // standard stuff
 #include <iostream>
 #include <sstream>
+#include <fstream>
+#include <string>
 #include <vector>
 #include <limits>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 typedef Gudhi::cubical_complex::Bitmap_cubical_complex_base<double> Bitmap_cubical_complex_base;
 typedef Gudhi::cubical_complex::Bitmap_cubical_complex<Bitmap_cubical_complex_base> Bitmap_cubical_complex;
@@ -1285,3 +1291,153 @@ BOOST_AUTO_TEST_CASE(perseus_file_read) {
   std::clog << "Second value of sinusoid.txt is " << value << std::endl;
   BOOST_CHECK(value == std::numeric_limits<double>::infinity());
 }
+
+BOOST_AUTO_TEST_CASE(boundary_and_coboundary_ranges_match_vectors) {
+  // Compare the non allocating ranges with the vectors of get_boundary_of_a_cell and get_coboundary_of_a_cell
+  std::vector<std::vector<unsigned>> all_sizes = {{5}, {3, 4}, {3, 2, 4}, {2, 3, 2, 2}};
+  for (auto const& sizes : all_sizes) {
+    std::size_t num_top_cells = 1;
+    for (auto s : sizes) num_top_cells *= s;
+    std::vector<double> data(num_top_cells);
+    for (std::size_t i = 0; i != num_top_cells; ++i) data[i] = static_cast<double>(i % 7);
+    Bitmap_cubical_complex_base ba(sizes, data);
+
+    for (auto cell : ba.all_cells_range()) {
+      std::vector<std::size_t> bd = ba.get_boundary_of_a_cell(cell);
+      Bitmap_cubical_complex_base::Boundary_range bdrange = ba.boundary_range(cell);
+      BOOST_CHECK(std::vector<std::size_t>(bdrange.begin(), bdrange.end()) == bd);
+      BOOST_CHECK(static_cast<std::size_t>(std::distance(bdrange.begin(), bdrange.end())) ==
+                  2 * ba.get_dimension_of_a_cell(cell));
+
+      std::vector<std::size_t> cbd = ba.get_coboundary_of_a_cell(cell);
+      Bitmap_cubical_complex_base::Coboundary_range cbdrange = ba.coboundary_range(cell);
+      BOOST_CHECK(std::vector<std::size_t>(cbdrange.begin(), cbdrange.end()) == cbd);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(counting_sort_of_the_filtration) {
+  // Integral values (with an infinite one) and values put in bins are sorted by levels, check that the order is the
+  // same as with the comparison sort.
+  std::vector<unsigned> sizes({7, 5, 4});
+  std::vector<double> integers(7 * 5 * 4), reals(7 * 5 * 4);
+  for (std::size_t i = 0; i != integers.size(); ++i) {
+    integers[i] = static_cast<double>((i * 37) % 11) - 3.;
+    reals[i] = std::sin(static_cast<double>(i));
+  }
+  integers[5] = std::numeric_limits<double>::infinity();
+
+  auto check = [](Bitmap_cubical_complex& cmplx) {
+    std::vector<std::size_t> expected(cmplx.all_cells_iterator_begin(), cmplx.all_cells_iterator_end());
+    std::sort(expected.begin(), expected.end(), Gudhi::cubical_complex::is_before_in_filtration<Bitmap_cubical_complex_base>(&cmplx));
+    auto const& sorted = cmplx.filtration_simplex_range();
+    BOOST_CHECK(std::vector<std::size_t>(sorted.begin(), sorted.end()) == expected);
+  };
+
+  Bitmap_cubical_complex from_integers(sizes, integers);
+  check(from_integers);
+
+  Bitmap_cubical_complex from_reals(sizes, reals);
+  check(from_reals);
+
+  Bitmap_cubical_complex binned(sizes, reals);
+  binned.put_data_to_bins(std::size_t(10));
+  std::vector<double> values;
+  for (auto cell : binned.all_cells_range()) values.push_back(binned.get_cell_data(cell));
+  std::sort(values.begin(), values.end());
+  BOOST_CHECK(std::unique(values.begin(), values.end()) - values.begin() <= 10);
+  check(binned);
+
+  Bitmap_cubical_complex binned_by_diameter(sizes, reals);
+  binned_by_diameter.put_data_to_bins(0.25);
+  check(binned_by_diameter);
+}
+
+BOOST_AUTO_TEST_CASE(construction_from_8_bits_values) {
+  // The buffer of an 8 bits image is read directly, and gives the same complex as its conversion to double.
+  std::vector<unsigned> sizes({5, 4, 3});
+  std::vector<std::uint8_t> pixels(5 * 4 * 3);
+  for (std::size_t i = 0; i != pixels.size(); ++i) pixels[i] = static_cast<std::uint8_t>((i * 97) % 251);
+  std::vector<double> values(pixels.begin(), pixels.end());
+
+  for (bool input_top_cells : {true, false}) {
+    Bitmap_cubical_complex from_pixels(sizes, pixels, input_top_cells);
+    Bitmap_cubical_complex from_values(sizes, values, input_top_cells);
+    BOOST_CHECK(from_pixels.num_simplices() == from_values.num_simplices());
+    for (auto cell : from_values.all_cells_range())
+      BOOST_CHECK(from_pixels.get_cell_data(cell) == from_values.get_cell_data(cell));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(periodic_boundary_and_coboundary_ranges_match_vectors) {
+  // Same as boundary_and_coboundary_ranges_match_vectors, with all the patterns of periodic directions
+  std::vector<std::vector<unsigned>> all_sizes = {{5}, {1}, {3, 4}, {1, 3}, {3, 2, 4}, {2, 3, 1, 2}};
+  for (auto const& sizes : all_sizes) {
+    std::size_t num_top_cells = 1;
+    for (auto s : sizes) num_top_cells *= s;
+    std::vector<double> data(num_top_cells);
+    for (std::size_t i = 0; i != num_top_cells; ++i) data[i] = static_cast<double>(i % 7);
+    for (unsigned pattern = 0; pattern != (1u << sizes.size()); ++pattern) {
+      std::vector<bool> directions;
+      for (std::size_t d = 0; d != sizes.size(); ++d) directions.push_back((pattern >> d) & 1);
+      Bitmap_cubical_complex_periodic_boundary_conditions ba(sizes, data, directions);
+
+      for (auto cell : ba.all_cells_range()) {
+        std::vector<std::size_t> bd = ba.get_boundary_of_a_cell(cell);
+        auto bdrange = ba.boundary_range(cell);
+        BOOST_CHECK(std::vector<std::size_t>(bdrange.begin(), bdrange.end()) == bd);
+
+        std::vector<std::size_t> cbd = ba.get_coboundary_of_a_cell(cell);
+        auto cbdrange = ba.coboundary_range(cell);
+        BOOST_CHECK(std::vector<std::size_t>(cbdrange.begin(), cbdrange.end()) == cbd);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(read_npy_nrrd_and_raw_volumes) {
+  // A 4x3x2 volume of 16 bits values, written in C order with a .npy header, in Fortran order with a NRRD header
+  // (fastest axis first), and without header.
+  std::vector<std::uint16_t> values(4 * 3 * 2);
+  for (std::size_t i = 0; i != values.size(); ++i) values[i] = static_cast<std::uint16_t>((i * 7) % 11 + 300);
+  std::vector<unsigned> sizes({4, 3, 2});
+  Bitmap_cubical_complex expected(sizes, values);
+  auto check = [&](const std::vector<unsigned>& read_sizes, const auto& read_values) {
+    BOOST_CHECK(read_sizes == sizes);
+    BOOST_CHECK(std::vector<double>(read_values.begin(), read_values.end()) ==
+                std::vector<double>(values.begin(), values.end()));
+    Bitmap_cubical_complex cmplx(read_sizes, read_values);
+    BOOST_CHECK(cmplx.num_simplices() == expected.num_simplices());
+    for (auto cell : expected.all_cells_range())
+      BOOST_CHECK(cmplx.get_cell_data(cell) == expected.get_cell_data(cell));
+  };
+  const char* raw = reinterpret_cast<const char*>(values.data());
+  std::size_t num_bytes = values.size() * sizeof(std::uint16_t);
+  {
+    std::ofstream out("volume.raw", std::ios::binary);
+    out.write(raw, num_bytes);
+  }
+  check(sizes, Gudhi::cubical_complex::read_raw_volume<std::uint16_t>("volume.raw", values.size()));
+
+  // Only written in the native byte order, which is little endian on the machines we test on
+  if (!Gudhi::cubical_complex::detail::is_little_endian()) return;
+  {
+    std::string header("{'descr': '<u2', 'fortran_order': False, 'shape': (2, 3, 4), }");
+    // The header is padded so that the data is aligned on 64 bytes
+    header.resize(128 - 10 - 1, ' ');
+    header += '\n';
+    std::ofstream out("volume.npy", std::ios::binary);
+    out.write("\x93NUMPY\x01\x00", 8);
+    out.put(static_cast<char>(header.size()));
+    out.put(0);
+    out << header;
+    out.write(raw, num_bytes);
+  }
+  Gudhi::cubical_complex::read_npy_volume("volume.npy", check);
+  {
+    std::ofstream out("volume.nrrd", std::ios::binary);
+    out << "NRRD0004\n# comment\ntype: unsigned short\ndimension: 3\nsizes: 4 3 2\nencoding: raw\nendian: little\n\n";
+    out.write(raw, num_bytes);
+  }
+  Gudhi::cubical_complex::read_nrrd_volume("volume.nrrd", check);
+}
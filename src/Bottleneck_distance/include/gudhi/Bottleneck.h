@@ -18,7 +18,8 @@
 #include <CGAL/version.h>  // for CGAL_VERSION_NR
 
 #include <vector>
-#include <algorithm>  // for max
+#include <algorithm>  // for max, sort, unique
+#include <iterator>  // for back_inserter
 #include <limits>  // for numeric_limits
 
 #include <cmath>
@@ -33,18 +34,15 @@ namespace Gudhi {
 
 namespace persistence_diagram {
 
-inline double bottleneck_distance_approx(Persistence_graph& g, double e) {
-  double b_lower_bound = 0.;
-  double b_upper_bound = g.max_dist_to_diagonal();
-  int graph_size = g.size();
-  if (graph_size <= 1)
-    // The value of alpha would be wrong in this case
-    return b_upper_bound;
-  const double alpha = std::pow(graph_size, 1. / 5.);
-  Graph_matching m(g);
-  Graph_matching biggest_unperfect(g);
-  while (b_upper_bound - b_lower_bound > 2 * e) {
-    double step = b_lower_bound + (b_upper_bound - b_lower_bound) / alpha;
+namespace internal {
+
+// Binary search on r in [lower, upper], the matching being perfect for upper, until upper - lower <= 2e or the
+// precision of double is reached. The same matching is used for every r: when r grows it is augmented, when r
+// shrinks only its edges that are too long are removed.
+inline void bisect_bottleneck(Graph_matching& m, double alpha, double e, double& lower, double& upper,
+                              bool& lower_tested) {
+  while (upper - lower > 2 * e) {
+    double step = lower + (upper - lower) / alpha;
 #if !defined FLT_EVAL_METHOD || FLT_EVAL_METHOD < 0 || FLT_EVAL_METHOD > 1
     // On platforms where double computation is done with excess precision,
     // we force it to its true precision so the following test is reliable.
@@ -52,37 +50,91 @@ inline double bottleneck_distance_approx(Persistence_graph& g, double e) {
     step = drop_excess_precision;
     // Alternative: step = CGAL::IA_force_to_double(step);
 #endif
-    if (step <= b_lower_bound || step >= b_upper_bound)  // Avoid precision problem
+    if (step <= lower || step >= upper)  // Avoid precision problem
       break;
     m.set_r(step);
     while (m.multi_augment()) {}  // compute a maximum matching (in the graph corresponding to the current r)
     if (m.perfect()) {
-      m = biggest_unperfect;
-      b_upper_bound = step;
+      upper = step;
     } else {
-      biggest_unperfect = m;
-      b_lower_bound = step;
+      lower = step;
+      lower_tested = true;
     }
   }
+}
+
+// Sorted lengths in [lower, upper] of the edges that a matching may use, found with a kd-tree on the points of V
+// instead of enumerating all the pairs.
+inline std::vector<double> sorted_distances_between(const Persistence_graph& g, double lower, double upper) {
+  typedef CGAL::Search_traits<double, Internal_point, const double*, Construct_coord_iterator,
+                              CGAL::Dimension_tag<2>> Traits;
+  std::vector<double> distances;
+  if (lower <= 0.)
+    distances.push_back(0.);  // between projections, and for empty diagrams
+  std::vector<Internal_point> v_points;
+  for (int v_point_index = 0; v_point_index < g.size(); ++v_point_index)
+    if (!g.on_the_v_diagonal(v_point_index))
+      v_points.push_back(g.get_v_point(v_point_index));
+  CGAL::Kd_tree<Traits> kd_t(v_points.begin(), v_points.end());
+  std::vector<Internal_point> near;
+  for (int u_point_index = 0; u_point_index < g.size(); ++u_point_index) {
+    double d = g.distance(u_point_index, g.corresponding_point_in_v(u_point_index));
+    if (d >= lower && d <= upper)
+      distances.push_back(d);
+    near.clear();
+    kd_t.search(std::back_inserter(near), Square_annulus_query(g.get_u_point(u_point_index), lower, upper));
+    for (auto& p : near)
+      distances.push_back(g.distance(u_point_index, p.point_index));
+  }
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_sort(distances.begin(), distances.end());
+#else
+  std::sort(distances.begin(), distances.end());
+#endif
+  distances.erase(std::unique(distances.begin(), distances.end()), distances.end());
+  return distances;
+}
+
+}  // namespace internal
+
+inline double bottleneck_distance_approx(Persistence_graph& g, double e) {
+  double b_lower_bound = 0.;
+  double b_upper_bound = g.max_dist_to_diagonal();
+  int graph_size = g.size();
+  if (graph_size <= 1)
+    // The value of alpha would be wrong in this case
+    return b_upper_bound;
+  const double alpha = std::pow(graph_size, 1. / 5.);
+  Graph_matching m(g);
+  bool lower_tested = false;
+  internal::bisect_bottleneck(m, alpha, e, b_lower_bound, b_upper_bound, lower_tested);
   return (b_lower_bound + b_upper_bound) / 2.;
 }
 
 inline double bottleneck_distance_exact(Persistence_graph& g) {
-  std::vector<double> sd = g.sorted_distances();
+  // Matching every point to its projection is perfect
+  double upper = 0.;
+  for (int u_point_index = 0; u_point_index < g.size(); ++u_point_index)
+    upper = (std::max)(upper, g.distance(u_point_index, g.corresponding_point_in_v(u_point_index)));
+  double lower = 0.;
+  bool lower_tested = false;
+  const double alpha = (std::max)(std::pow(g.size(), 1. / 5.), 2.);
+  Graph_matching m(g);
+  // The distance is an edge length in [lower, upper] (in ]lower, upper] once lower is known not to be enough), and
+  // after bisecting on doubles there are few such edges, while all the pairs would be too many for large diagrams.
+  internal::bisect_bottleneck(m, alpha, 0., lower, upper, lower_tested);
+  std::vector<double> sd = internal::sorted_distances_between(g, lower, upper);
+  if (lower_tested && sd.front() == lower)
+    sd.erase(sd.begin());
   long lower_bound_i = 0;
   long upper_bound_i = sd.size() - 1;
-  const double alpha = std::pow(g.size(), 1. / 5.);
-  Graph_matching m(g);
-  Graph_matching biggest_unperfect(g);
   while (lower_bound_i != upper_bound_i) {
     long step = lower_bound_i + static_cast<long> ((upper_bound_i - lower_bound_i - 1) / alpha);
     m.set_r(sd.at(step));
     while (m.multi_augment()) {}  // compute a maximum matching (in the graph corresponding to the current r)
     if (m.perfect()) {
-      m = biggest_unperfect;
       upper_bound_i = step;
     } else {
-      biggest_unperfect = m;
       lower_bound_i = step + 1;
     }
   }
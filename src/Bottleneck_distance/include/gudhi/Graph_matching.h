@@ -33,7 +33,9 @@ class Graph_matching {
   bool perfect() const;
   /** \internal \brief Augments the matching with a maximal set of edge-disjoint shortest augmenting paths. */
   bool multi_augment();
-  /** \internal \brief Sets the maximum length of the edges allowed to be added in the matching, 0 initially. */
+  /** \internal \brief Sets the maximum length of the edges allowed to be added in the matching, 0 initially. When r
+   * decreases, the matched edges longer than r are removed and the others are kept, so the matching is a warm start
+   * for the new r. */
   void set_r(double r);
 
  private:
@@ -80,6 +82,15 @@ inline bool Graph_matching::multi_augment() {
 }
 
 inline void Graph_matching::set_r(double r) {
+  if (r < this->r) {
+    for (int v_point_index = 0; v_point_index < gp->size(); ++v_point_index) {
+      int u_point_index = v_to_u[v_point_index];
+      if (u_point_index != null_point_index() && gp->distance(u_point_index, v_point_index) > r) {
+        v_to_u[v_point_index] = null_point_index();
+        unmatched_in_u.insert(u_point_index);
+      }
+    }
+  }
   this->r = r;
 }
 
@@ -5,6 +5,7 @@
  *    Copyright (C) 2015 Inria
  *
  *    Modification(s):
+ *      - 2023/10 David Loiseaux: Uniform grid of buckets for the large diagrams
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -18,10 +19,15 @@
 #include <gudhi/Persistence_graph.h>
 #include <gudhi/Internal_point.h>
 
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
+#include <memory>  // for std::unique_ptr
+#include <utility>  // for std::pair
 #include <algorithm>  // for std::max
 #include <cmath>  // for std::abs
+#include <cstddef>  // for std::size_t
+#include <limits>  // for std::numeric_limits
 
 namespace Gudhi {
 
@@ -54,9 +60,107 @@ struct Square_query {
   FT size;
 };
 
+/** \internal \brief Query for the points p such that lo <= max(|p.x()-c.x()|, |p.y()-c.y()|) <= hi, computed as in
+ * Persistence_graph::distance. The boxes are pruned with some slack, so that rounding cannot lose a point.
+ */
+struct Square_annulus_query {
+  typedef CGAL::Dimension_tag<2> D;
+  typedef Internal_point Point_d;
+  typedef double FT;
+  Square_annulus_query(Point_d c, FT lo, FT hi)
+      : c(c), lo(lo), hi(hi),
+        slack(4 * std::numeric_limits<FT>::epsilon() * (std::abs(c.x()) + std::abs(c.y()) + hi)) {}
+  bool contains(Point_d p) const {
+    FT d = (std::max)(std::abs(p.x()-c.x()), std::abs(p.y()-c.y()));
+    return d >= lo && d <= hi;
+  }
+  bool inner_range_intersects(CGAL::Kd_tree_rectangle<FT, D> const&r) const {
+    const FT outer = hi + slack;
+    const FT inner = lo - slack;
+    // Meets the outer square, and is not strictly inside the inner one
+    return
+      r.max_coord(0) >= c.x() - outer &&
+      r.min_coord(0) <= c.x() + outer &&
+      r.max_coord(1) >= c.y() - outer &&
+      r.min_coord(1) <= c.y() + outer &&
+      !(r.min_coord(0) > c.x() - inner &&
+        r.max_coord(0) < c.x() + inner &&
+        r.min_coord(1) > c.y() - inner &&
+        r.max_coord(1) < c.y() + inner);
+  }
+  bool outer_range_contains(CGAL::Kd_tree_rectangle<FT, D> const&) const {
+    // Let contains decide for each point
+    return false;
+  }
+  Point_d c;
+  FT lo, hi, slack;
+};
+
+/** \internal \brief Uniform grid of square buckets, for the points at distance at most r of a query point in the
+ * L-infinity norm. The buckets are a bit larger than r, so that the neighbors of a point are in the 3x3 buckets around
+ * its own despite the rounding of the coordinates, and a point is removed in constant time.
+ */
+class Square_grid {
+ public:
+  /** \internal \brief The side of the buckets for the radius r and coordinates of absolute value at most
+   * max_abs_coordinate, or 0 if the indices of the buckets cannot be represented, e.g. for r = 0. */
+  static double bucket_size(double r, double max_abs_coordinate) {
+    // |x1 - x2| <= r implies |x1/s - x2/s| < 1 after rounding, and the rounded difference can exceed r by one ulp
+    const double s = r + 8 * std::numeric_limits<double>::epsilon() * (max_abs_coordinate + r);
+    if (!(s > 0) || !(max_abs_coordinate / s < static_cast<double>(1LL << 52))) return 0.;
+    return s;
+  }
+
+  explicit Square_grid(double bucket_size) : s(bucket_size) { }
+
+  void add(const Internal_point& p) {
+    buckets[bucket_of(p)].push_back(p);
+  }
+
+  /** \internal \brief Returns and removes a point at distance at most r of c, null_point_index() if there isn't such
+   * a point. */
+  int pull_near(const Internal_point& c, double r) {
+    const Bucket b = bucket_of(c);
+    for (long long i = b.first - 1; i <= b.first + 1; ++i) {
+      for (long long j = b.second - 1; j <= b.second + 1; ++j) {
+        auto it = buckets.find(Bucket(i, j));
+        if (it == buckets.end()) continue;
+        std::vector<Internal_point>& points = it->second;
+        for (std::size_t k = 0; k < points.size(); ++k) {
+          if ((std::max)(std::abs(points[k].x() - c.x()), std::abs(points[k].y() - c.y())) <= r) {
+            const int index = points[k].point_index;
+            points[k] = points.back();
+            points.pop_back();
+            if (points.empty()) buckets.erase(it);
+            return index;
+          }
+        }
+      }
+    }
+    return null_point_index();
+  }
+
+ private:
+  typedef std::pair<long long, long long> Bucket;
+  struct Bucket_hash {
+    std::size_t operator()(const Bucket& b) const {
+      return static_cast<std::size_t>(b.first) * 0x9E3779B97F4A7C15ULL + static_cast<std::size_t>(b.second);
+    }
+  };
+
+  Bucket bucket_of(const Internal_point& p) const {
+    return Bucket(static_cast<long long>(std::floor(p.x() / s)), static_cast<long long>(std::floor(p.y() / s)));
+  }
+
+  double s;
+  std::unordered_map<Bucket, std::vector<Internal_point>, Bucket_hash> buckets;
+};
+
 /** \internal \brief data structure used to find any point (including projections) in V near to a query point from U
  * (which can be a projection).
  *
+ * The points of the large graphs are stored in a `Square_grid`, and the other ones in a kd-tree.
+ *
  * V points have to be added manually using their index and before the first pull. A neighbor pulled is automatically
  * removed.
  *
@@ -78,10 +182,14 @@ class Neighbors_finder {
   /** \internal \brief Returns and remove all the V points near to the U point given as parameter. */
   std::vector<int> pull_all_near(int u_point_index);
 
+  /** \internal \brief Minimal size of the graphs whose points are stored in a `Square_grid`. */
+  static const int grid_min_size = 256;
+
  private:
   const Persistence_graph& g;
   const double r;
   Kd_tree kd_t;
+  std::unique_ptr<Square_grid> grid;
   std::unordered_set<int> projections_f;
 };
 
@@ -112,11 +220,19 @@ class Layered_neighbors_finder {
 };
 
 inline Neighbors_finder::Neighbors_finder(const Persistence_graph& g, double r) :
-    g(g), r(r), kd_t(), projections_f() { }
+    g(g), r(r), kd_t(), grid(), projections_f() {
+  if (g.size() >= grid_min_size) {
+    double s = Square_grid::bucket_size(r, g.max_abs_coordinate());
+    if (s > 0)
+      grid.reset(new Square_grid(s));
+  }
+}
 
 inline void Neighbors_finder::add(int v_point_index) {
   if (g.on_the_v_diagonal(v_point_index))
     projections_f.emplace(v_point_index);
+  else if (grid)
+    grid->add(g.get_v_point(v_point_index));
   else
     kd_t.insert(g.get_v_point(v_point_index));
 }
@@ -135,6 +251,8 @@ inline int Neighbors_finder::pull_near(int u_point_index) {
   } else {
     // Is the query point near to a V point in the plane ?
     Internal_point u_point = g.get_u_point(u_point_index);
+    if (grid)
+      return grid->pull_near(u_point, r);
     auto neighbor = kd_t.search_any_point(Square_query{u_point, r});
     if (!neighbor)
       return null_point_index();
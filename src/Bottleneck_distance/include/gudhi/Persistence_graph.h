@@ -5,6 +5,7 @@
  *    Copyright (C) 2015 Inria
  *
  *    Modification(s):
+ *      - 2023/10 David Loiseaux: Add max_abs_coordinate for the grid of Neighbors_finder
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -54,6 +55,9 @@ public:
   std::vector<double> sorted_distances() const;
   /** \internal \brief Returns an upper bound for the bottleneck distance of the finite points. */
   double max_dist_to_diagonal() const;
+  /** \internal \brief Returns the largest absolute value of the coordinates of the points, including the
+   * projections. */
+  double max_abs_coordinate() const;
   /** \internal \brief Returns the corresponding internal point */
   Internal_point get_u_point(int u_point_index) const;
   /** \internal \brief Returns the corresponding internal point */
@@ -63,12 +67,13 @@ private:
   std::vector<Internal_point> u;
   std::vector<Internal_point> v;
   double b_alive;
+  double max_abs;
 };
 
 template<typename Persistence_diagram1, typename Persistence_diagram2>
 Persistence_graph::Persistence_graph(const Persistence_diagram1 &diag1,
                                      const Persistence_diagram2 &diag2, double e)
-  : u(), v(), b_alive(0.) {
+  : u(), v(), b_alive(0.), max_abs(0.) {
   std::vector<double> u_alive;
   std::vector<double> v_alive;
   std::vector<double> u_nalive;
@@ -104,6 +109,11 @@ Persistence_graph::Persistence_graph(const Persistence_diagram1 &diag1,
   }
   if (u.size() < v.size())
     swap(u, v);
+  // The projections are between the coordinates of their projectors
+  for (auto& p : u)
+    max_abs = (std::max)(max_abs, (std::max)(std::fabs(p.x()), std::fabs(p.y())));
+  for (auto& p : v)
+    max_abs = (std::max)(max_abs, (std::max)(std::fabs(p.x()), std::fabs(p.y())));
 
   if (u_alive.size() != v_alive.size() || u_nalive.size() != v_nalive.size() || u_inf != v_inf) {
     b_alive = std::numeric_limits<double>::infinity();
@@ -169,6 +179,10 @@ inline std::vector<double> Persistence_graph::sorted_distances() const {
   return distances;
 }
 
+inline double Persistence_graph::max_abs_coordinate() const {
+  return max_abs;
+}
+
 inline Internal_point Persistence_graph::get_u_point(int u_point_index) const {
   if (!on_the_u_diagonal(u_point_index))
     return u.at(u_point_index);
@@ -237,3 +237,83 @@ BOOST_AUTO_TEST_CASE(bottleneck_simple_test) {
   b = Gudhi::persistence_diagram::bottleneck_distance(v1, v2, 0.);
   BOOST_CHECK_EQUAL(b, inf);
 }
+
+BOOST_AUTO_TEST_CASE(exact_among_all_pairs) {
+  // The exact distance is the smallest of all the pairwise distances for which there is a perfect matching, starting
+  // each time from an empty matching
+  std::uniform_real_distribution<double> unif1(0., 10.);
+  std::default_random_engine re;
+  for (int trial = 0; trial < 20; trial++) {
+    std::vector< std::pair<double, double> > d1, d2;
+    for (int i = 0; i < 30; i++) {
+      double a = unif1(re), b = unif1(re), c = unif1(re), d = unif1(re);
+      d1.emplace_back(std::min(a, b), std::max(a, b));
+      if (i % 4 != 0) d2.emplace_back(std::min(c, d), std::max(c, d));
+    }
+    Persistence_graph g(d1, d2, 0.);
+    std::vector<double> sd = g.sorted_distances();
+    std::size_t i = 0, j = sd.size() - 1;
+    while (i != j) {
+      std::size_t mid = (i + j) / 2;
+      Graph_matching m(g);
+      m.set_r(sd[mid]);
+      while (m.multi_augment()) {}
+      if (m.perfect())
+        j = mid;
+      else
+        i = mid + 1;
+    }
+    BOOST_CHECK_EQUAL(bottleneck_distance(d1, d2, 0.), sd[i]);
+    // The matching is reusable at a smaller radius
+    Graph_matching m(g);
+    m.set_r(sd.back());
+    while (m.multi_augment()) {}
+    BOOST_CHECK(m.perfect());
+    m.set_r(sd[i]);
+    while (m.multi_augment()) {}
+    BOOST_CHECK(m.perfect());
+    if (i > 0) {
+      m.set_r(sd[i - 1]);
+      while (m.multi_augment()) {}
+      BOOST_CHECK(!m.perfect());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(grid_neighbors_finder) {
+  // Large diagrams on a grid, far from the origin, with many points exactly at distance r
+  std::uniform_int_distribution<int> coordinate(0, 40);
+  std::default_random_engine re;
+  for (double offset : {0., 1e6}) {
+    std::vector< std::pair<double, double> > d1, d2;
+    for (int i = 0; i < 300; i++) {
+      double a = offset + coordinate(re) * 0.25, b = offset + coordinate(re) * 0.25;
+      double c = offset + coordinate(re) * 0.25, d = offset + coordinate(re) * 0.25;
+      d1.emplace_back(std::min(a, b), std::max(a, b) + 0.25);
+      d2.emplace_back(std::min(c, d), std::max(c, d) + 0.25);
+    }
+    Persistence_graph g(d1, d2, 0.);
+    BOOST_CHECK(g.size() >= Neighbors_finder::grid_min_size);
+    for (double r : {0., 0.25, 1.}) {
+      for (int u_point_index = 0; u_point_index < g.size(); u_point_index += 37) {
+        Neighbors_finder nf(g, r);
+        for (int v_point_index = 0; v_point_index < g.size(); ++v_point_index)
+          nf.add(v_point_index);
+        std::vector<int> near = nf.pull_all_near(u_point_index);
+        std::sort(near.begin(), near.end());
+        std::vector<int> expected;
+        for (int v_point_index = 0; v_point_index < g.size(); ++v_point_index)
+          if (g.distance(u_point_index, v_point_index) <= r && !g.on_the_v_diagonal(v_point_index))
+            expected.push_back(v_point_index);
+        // The projections pulled are near too
+        std::vector<int> near_in_plane;
+        for (int v_point_index : near)
+          if (!g.on_the_v_diagonal(v_point_index))
+            near_in_plane.push_back(v_point_index);
+          else
+            BOOST_CHECK(g.distance(u_point_index, v_point_index) <= r);
+        BOOST_CHECK(near_in_plane == expected);
+      }
+    }
+  }
+}
@@ -42,6 +42,11 @@ struct SimplicialComplexForCech {
   template< typename Blocker >
   void expansion_with_blockers(int max_dim, Blocker block_simplex);
 
+  /** \brief Same as above, but a candidate made of a simplex `sh` and an extra vertex `v` is discarded without calling
+   * the blocker if `skip_candidate(sh, v)` returns true. */
+  template< typename Blocker, typename CandidateFilter >
+  void expansion_with_blockers(int max_dim, Blocker block_simplex, CandidateFilter skip_candidate);
+
   /** Returns the number of vertices in the simplicial complex. */
   std::size_t num_vertices();
 
@@ -91,8 +91,12 @@ class Cech_complex {
 
     // insert the proximity graph in the simplicial complex
     complex.insert_graph(cech_skeleton_graph_);
-    // expand the graph until dimension dim_max
-    complex.expansion_with_blockers(dim_max, cech_blocker(&complex, this));
+    // expand the graph until dimension dim_max, discarding early the cofaces that cannot fit in a ball of radius
+    // max_radius
+    cech_blocker blocker(&complex, this);
+    complex.expansion_with_blockers(dim_max, blocker, [&blocker](auto sh, Vertex_handle v) {
+      return blocker.cannot_fit(sh, v);
+    });
   }
 
   /** @return max_radius value given at construction. */
@@ -13,11 +13,13 @@
 
 #include <CGAL/NT_converter.h> // for casting from FT to Filtration_value
 #include <CGAL/Lazy_exact_nt.h> // for CGAL::exact
+#include <CGAL/number_utils.h> // for CGAL::to_double
 
 #include <iostream>
 #include <vector>
 #include <set>
 #include <cmath>  // for std::sqrt
+#include <algorithm>  // for std::max
 
 namespace Gudhi {
 
@@ -53,6 +55,7 @@ class Cech_blocker {
  private:
 
   using Simplex_handle = typename SimplicialComplexForCech::Simplex_handle;
+  using Vertex_handle = typename SimplicialComplexForCech::Vertex_handle;
   using Filtration_value = typename SimplicialComplexForCech::Filtration_value;
   using Simplex_key = typename SimplicialComplexForCech::Simplex_key;
 
@@ -133,6 +136,34 @@ class Cech_blocker {
     return (radius > cc_ptr_->max_radius());
   }
 
+  /** \internal \brief Cheap necessary condition for the blocker to accept the union of a simplex and a vertex.
+   *
+   * If \f$(c, r)\f$ is the minimal enclosing ball of `sh`, any ball of radius \f$R\f$ that contains `sh` has its
+   * center at distance at most \f$\sqrt{R^2 - r^2}\f$ from \f$c\f$. The union can thus only have a radius smaller than
+   * max_radius if the point of `v` is at distance at most \f$R + \sqrt{R^2 - r^2}\f$ from \f$c\f$.
+   *  \param[in] sh The Simplex_handle of a simplex of the complex, whose sphere is already cached unless it is an edge.
+   *  \param[in] v The extra vertex.
+   *  \return true if the union of `sh` and `v` would be blocked.*/
+  bool cannot_fit(Simplex_handle sh, Vertex_handle v) {
+    Simplex_key k = sc_ptr_->key(sh);
+    if (k == sc_ptr_->null_key()) {
+      // Edges are inserted from the proximity graph, put their sphere in cache as the blocker would
+      if (sc_ptr_->dimension(sh) != 1) return false;
+      std::vector<Point_d> points;
+      for (auto vertex : sc_ptr_->simplex_vertex_range(sh)) points.push_back(cc_ptr_->get_point(vertex));
+      k = cc_ptr_->get_cache().size();
+      sc_ptr_->assign_key(sh, k);
+      cc_ptr_->get_cache().push_back(get_sphere(points.cbegin(), points.cend()));
+    }
+    Sphere const& sph = cc_ptr_->get_cache()[k];
+    const double max_radius = cc_ptr_->max_radius();
+    const double squared_distance =
+        CGAL::to_double(kernel_.squared_distance_d_object()(sph.first, cc_ptr_->get_point(v)));
+    const double bound = max_radius + std::sqrt(std::max(0., max_radius * max_radius - CGAL::to_double(sph.second)));
+    // Relative margin, so rounding errors never discard a simplex that the blocker would keep
+    return squared_distance > bound * bound * (1 + 1e-6);
+  }
+
   /** \internal \brief Čech complex blocker constructor. */
   Cech_blocker(SimplicialComplexForCech* sc_ptr, Cech_complex* cc_ptr) : sc_ptr_(sc_ptr), cc_ptr_(cc_ptr) {}
 
@@ -11,6 +11,21 @@
 #ifndef MEB_FILTRATION_H_
 #define MEB_FILTRATION_H_
 
+#include <CGAL/Epick_d.h>
+#include <CGAL/Epeck_d.h>
+#include <CGAL/NT_converter.h>
+#include <CGAL/version.h>  // for CGAL_VERSION_NR
+
+#include <algorithm>  // for std::max
+#include <cstddef>  // for std::size_t
+#include <type_traits>  // for std::decay_t
+#include <utility>  // for std::pair, std::move
+#include <vector>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 namespace Gudhi::cech_complex {
 
 /**
@@ -107,6 +122,155 @@ void assign_MEB_filtration(Kernel&&k, SimplicialComplexForMEB& complex, PointRan
 
   // TODO: use a map if complex does not provide key?
 }
+
+namespace detail {
+
+template<typename Kernel> struct Inexact_MEB_kernel { using type = Kernel; };
+template<typename D> struct Inexact_MEB_kernel<CGAL::Epeck_d<D>> { using type = CGAL::Epick_d<D>; };
+
+template<typename Kernel> struct Is_Epeck_d : std::false_type {};
+template<typename D> struct Is_Epeck_d<CGAL::Epeck_d<D>> : std::true_type {};
+
+// Calls f(i) for i in [0, n), in parallel if possible. The lazy numbers of Epeck_d are only thread-safe since CGAL 5.5.
+template<typename Kernel, typename F>
+void MEB_for_each_index(std::size_t n, F&& f) {
+#ifdef GUDHI_USE_TBB
+  if constexpr (!Is_Epeck_d<Kernel>::value || CGAL_VERSION_NR >= 1050500000) {
+    tbb::parallel_for(std::size_t(0), n, f);
+    return;
+  }
+#endif
+  for (std::size_t i = 0; i < n; ++i) f(i);
+}
+
+// Same values as assign_MEB_filtration, computed dimension by dimension, all the simplices of one dimension at a time.
+template<typename Kernel, typename SimplicialComplexForMEB, typename PointRange>
+void dimension_ordered_MEB_filtration(Kernel const& k, SimplicialComplexForMEB& complex, PointRange const& points,
+                                      bool exact) {
+  using Point_d = typename Kernel::Point_d;
+  using FT = typename Kernel::FT;
+  using Sphere = std::pair<Point_d, FT>;
+
+  using Vertex_handle = typename SimplicialComplexForMEB::Vertex_handle;
+  using Simplex_handle = typename SimplicialComplexForMEB::Simplex_handle;
+  using Filtration_value = typename SimplicialComplexForMEB::Filtration_value;
+
+  std::vector<std::vector<Simplex_handle>> simplices;
+  complex.for_each_simplex([&](Simplex_handle sh, int dim) {
+    if (simplices.size() <= static_cast<std::size_t>(dim)) simplices.resize(dim + 1);
+    simplices[dim].push_back(sh);
+  });
+  if (simplices.empty()) return;
+  for (Simplex_handle sh : simplices[0]) complex.assign_filtration(sh, 0);
+
+  // As in assign_MEB_filtration, the key of a simplex is the index of its MEB in the cache, which may be shared with
+  // one of its faces. Only the spheres of one dimension are computed in parallel, they are added to the cache after.
+  std::vector<Sphere> cache;
+  std::vector<Sphere> new_spheres;
+  std::vector<char> is_new;
+  CGAL::NT_converter<FT, Filtration_value> cvt;
+  for (std::size_t dim = 1; dim < simplices.size(); ++dim) {
+    auto const& simplices_of_dim = simplices[dim];
+    new_spheres.resize(simplices_of_dim.size());
+    is_new.assign(simplices_of_dim.size(), false);
+    MEB_for_each_index<Kernel>(simplices_of_dim.size(), [&](std::size_t i) {
+      Simplex_handle sh = simplices_of_dim[i];
+      if (dim == 1) {
+        auto verts = complex.simplex_vertex_range(sh);
+        auto vert_it = verts.begin();
+        Vertex_handle u = *vert_it;
+        Vertex_handle v = *++vert_it;
+        auto&& pu = points[u];
+        Point_d m = k.midpoint_d_object()(pu, points[v]);
+        FT r = k.squared_distance_d_object()(m, pu);
+        if (exact) CGAL::exact(r);
+        complex.assign_filtration(sh, std::max(cvt(r), Filtration_value(0)));
+        new_spheres[i] = Sphere(std::move(m), std::move(r));
+        is_new[i] = true;
+        return;
+      }
+      Filtration_value maxf = 0; // max filtration of the faces
+      bool found = false;
+      using std::max;
+      for (auto face_opposite_vertex : complex.boundary_opposite_vertex_simplex_range(sh)) {
+        maxf = max(maxf, complex.filtration(face_opposite_vertex.first));
+        if (!found) {
+          auto key = complex.key(face_opposite_vertex.first);
+          Sphere const& sph = cache[key];
+          if (k.squared_distance_d_object()(sph.first, points[face_opposite_vertex.second]) > sph.second) continue;
+          found = true;
+          complex.assign_key(sh, key);
+        }
+      }
+      if (!found) {
+        // None of the faces are good enough, MEB must be the circumsphere.
+        thread_local std::vector<Point_d> pts;
+        pts.clear();
+        for (auto vertex : complex.simplex_vertex_range(sh))
+          pts.push_back(points[vertex]);
+        Point_d c = k.construct_circumcenter_d_object()(pts.begin(), pts.end());
+        FT r = k.squared_distance_d_object()(c, pts.front());
+        if (exact) CGAL::exact(r);
+        maxf = max(maxf, cvt(r)); // maxf = cvt(r) except for rounding errors
+        new_spheres[i] = Sphere(std::move(c), std::move(r));
+        is_new[i] = true;
+      }
+      complex.assign_filtration(sh, maxf);
+    });
+    for (std::size_t i = 0; i < simplices_of_dim.size(); ++i) {
+      if (!is_new[i]) continue;
+      complex.assign_key(simplices_of_dim[i], cache.size());
+      cache.push_back(std::move(new_spheres[i]));
+    }
+  }
+}
+
+}  // namespace detail
+
+/**
+ * \ingroup cech_complex
+ *
+ * \brief
+ * Same as `assign_MEB_filtration()`, but the simplices are processed dimension by dimension, and all the simplices
+ * of one dimension in parallel when \ref tbb is available. The complex must support concurrent reads, and concurrent
+ * calls to `assign_filtration()` and `assign_key()` on different simplices, as `Simplex_tree` does.
+ *
+ * When `exact` is false and `Kernel` is <a href="https://doc.cgal.org/latest/Kernel_d/structCGAL_1_1Epeck__d.html">
+ * CGAL::Epeck_d</a>, the coordinates of the points are converted to `double` and the balls are computed with the
+ * corresponding <a href="https://doc.cgal.org/latest/Kernel_d/structCGAL_1_1Epick__d.html">CGAL::Epick_d</a>, which
+ * is much faster, but the filtration values may then differ from the ones of `assign_MEB_filtration()` by rounding
+ * errors. With `CGAL::Epeck_d` before CGAL 5.5, whose lazy numbers are not thread-safe, the exact computation is
+ * done by a single thread.
+ *
+ * @param[in] k The geometric kernel.
+ * @param[in] complex The simplicial complex.
+ * @param[in] points Embedding of the vertices of the complex.
+ * @param[in] exact If true and `Kernel` is `CGAL::Epeck_d`, the filtration values are computed exactly.
+ * Default is false.
+ */
+template<typename Kernel, typename SimplicialComplexForMEB, typename PointRange>
+void parallel_assign_MEB_filtration(Kernel&&k, SimplicialComplexForMEB& complex, PointRange const& points,
+                                    bool exact = false) {
+  using Kernel_ = std::decay_t<Kernel>;
+  if constexpr (detail::Is_Epeck_d<Kernel_>::value) {
+    if (!exact) {
+      using Inexact_kernel = typename detail::Inexact_MEB_kernel<Kernel_>::type;
+      using Inexact_point = typename Inexact_kernel::Point_d;
+      auto cartesian = k.construct_cartesian_const_iterator_d_object();
+      std::vector<Inexact_point> inexact_points;
+      std::vector<double> coords;
+      for (auto const& p : points) {
+        coords.clear();
+        for (auto it = cartesian(p); it != cartesian(p, 0); ++it) coords.push_back(CGAL::to_double(*it));
+        inexact_points.emplace_back(coords.begin(), coords.end());
+      }
+      detail::dimension_ordered_MEB_filtration(Inexact_kernel(), complex, inexact_points, false);
+      return;
+    }
+  }
+  detail::dimension_ordered_MEB_filtration(k, complex, points, exact);
+}
+
 }  // namespace Gudhi::cech_complex
 
 #endif  // MEB_FILTRATION_H_
@@ -175,6 +175,17 @@ BOOST_AUTO_TEST_CASE(Cech_complex_for_documentation) {
   for (auto sh : st2.complex_simplex_range())
     st2.assign_filtration(sh, std::sqrt(st2.filtration(sh)));
   BOOST_CHECK(st2 == st2_save); // Should only be an approximate test
+
+  // The parallel version gives the same values when exact, and almost the same values with doubles
+  auto st3 = st2;
+  auto st4 = st2;
+  Gudhi::cech_complex::assign_MEB_filtration(Kernel(), st3, points, true);
+  Gudhi::cech_complex::parallel_assign_MEB_filtration(Kernel(), st4, points, true);
+  BOOST_CHECK(st3 == st4);
+  st4.reset_filtration(-1);
+  Gudhi::cech_complex::parallel_assign_MEB_filtration(Kernel(), st4, points);
+  for (auto sh : st4.complex_simplex_range())
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(std::sqrt(st4.filtration(sh)), st2_save.filtration(st2_save.find(st4.simplex_vertex_range(sh))), 1e-10);
 }
 
 BOOST_AUTO_TEST_CASE(Cech_complex_from_points) {
@@ -54,6 +54,15 @@ namespace collapse {
  * The algorithm implemented here does not produce a minimal filtration. Taking its output and applying the algorithm a
  * second time may further simplify the filtration.
  *
+ * \section strong_collapse_definition Strong collapse
+ *
+ * A vertex \f$v\f$ is dominated by another vertex \f$v^{\prime}\f$ if all the maximal simplices that contain
+ * \f$v\f$ also contain \f$v^{\prime}\f$, and its removal with its cofaces is a <b>strong collapse</b>
+ * \cite strongcollapseesa. Unlike edge collapse, this does not require a flag complex:
+ * `Gudhi::collapse::strong_collapse()` reduces any simplicial complex, e.g. an alpha, Čech or witness complex, given by
+ * its maximal simplices in a `Gudhi::Toplex_map`, to a smaller complex with the same homotopy type, and reports the
+ * collapsed vertices.
+ *
  * \subsection edgecollapseexample Basic edge collapse
  * 
  * This example calls `Gudhi::collapse::flag_complex_collapse_edges()` from a proximity graph represented as a list of
@@ -0,0 +1,196 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef COLLAPSED_RIPS_COMPLEX_H_
+#define COLLAPSED_RIPS_COMPLEX_H_
+
+#include <gudhi/Flag_complex_edge_collapser.h>
+#include <gudhi/graph_simplicial_complex.h>
+#include <gudhi/distance_functions.h>
+#include <gudhi/Clock.h>
+
+#include <algorithm>  // for std::sort
+#include <cstddef>  // for std::size_t
+#include <iterator>  // for std::next
+#include <tuple>
+#include <type_traits>  // for std::is_same
+#include <utility>  // for std::move, std::swap, std::pair
+#include <vector>
+
+namespace Gudhi {
+
+namespace collapse {
+
+/** \brief Statistics of the stages of `collapsed_rips_complex`, to see where the time goes.
+ *
+ * \ingroup edge_collapse
+ */
+struct Collapsed_rips_complex_statistics {
+  /** \brief Number of edges of the proximity graph, before collapse. */
+  std::size_t num_edges = 0;
+  /** \brief Number of edges remaining after collapse. */
+  std::size_t num_collapsed_edges = 0;
+  /** \brief Time in seconds to compute the edges of the proximity graph. */
+  double edges_time = 0.;
+  /** \brief Time in seconds of the edge collapse iterations. */
+  double collapse_time = 0.;
+  /** \brief Time in seconds to insert the remaining edges in the complex. */
+  double insertion_time = 0.;
+  /** \brief Time in seconds of the flag expansion. */
+  double expansion_time = 0.;
+};
+
+namespace detail {
+
+/* Collapses the filtered edges, then inserts them in the empty complex as a Csr_proximity_graph with num_vertices
+ * vertices and expands it. The edges are moved from stage to stage, never copied. */
+template<typename SimplicialComplex, typename Filtered_edge>
+void collapse_and_expand(SimplicialComplex& complex, std::size_t num_vertices, std::vector<Filtered_edge>&& edges,
+                         int dim_max, int collapse_iterations, Collapsed_rips_complex_statistics& stats) {
+  using Vertex_handle = typename SimplicialComplex::Vertex_handle;
+  using Filtration_value = typename SimplicialComplex::Filtration_value;
+  using std::get;
+
+  stats.num_edges = edges.size();
+  Gudhi::Clock clock;
+  for (int iter = 0; iter < collapse_iterations; ++iter) {
+    edges = flag_complex_collapse_edges<true>(std::move(edges), [](auto const& d) { return d; });
+  }
+  stats.num_collapsed_edges = edges.size();
+  stats.collapse_time = clock.num_seconds();
+
+  clock.begin();
+  // The collapse does not preserve the order of the edges, and may have kept them as [v,u]
+  for (auto& e : edges) {
+    if (get<1>(e) < get<0>(e)) std::swap(get<0>(e), get<1>(e));
+  }
+  std::sort(edges.begin(), edges.end(), [](Filtered_edge const& a, Filtered_edge const& b) {
+    return std::make_pair(get<0>(a), get<1>(a)) < std::make_pair(get<0>(b), get<1>(b));
+  });
+  Csr_proximity_graph<Vertex_handle, Filtration_value> graph;
+  graph.vertex_filtrations.assign(num_vertices, Filtration_value(0));
+  graph.offsets.assign(num_vertices + 1, 0);
+  graph.neighbors.reserve(edges.size());
+  graph.edge_filtrations.reserve(edges.size());
+  for (auto const& e : edges) {
+    ++graph.offsets[get<0>(e) + 1];
+    graph.neighbors.push_back(get<1>(e));
+    graph.edge_filtrations.push_back(get<2>(e));
+  }
+  for (std::size_t u = 0; u < num_vertices; ++u) graph.offsets[u + 1] += graph.offsets[u];
+  std::vector<Filtered_edge>().swap(edges);
+  complex.insert_graph(graph);
+  stats.insertion_time = clock.num_seconds();
+
+  clock.begin();
+  complex.expansion(dim_max);
+  stats.expansion_time = clock.num_seconds();
+}
+
+}  // namespace detail
+
+/** \brief Builds the Rips complex of the points in one pass: computes the edges of the proximity graph, collapses
+ * them with `parallel_flag_complex_collapse_edges`, inserts the remaining ones in the complex and expands it until
+ * `dim_max`.
+ *
+ * This gives the same result as the edge collapse utilities, which compute a `Proximity_graph`, copy its edges in a
+ * list, collapse them and insert them one by one in a `Simplex_tree`, but the edges are moved from one stage to the
+ * next and inserted at once with `Simplex_tree::insert_graph`.
+ *
+ * @param[out] complex Empty `Simplex_tree`, where the collapsed Rips complex is built.
+ * @param[in] points Range of points.
+ * @param[in] threshold Maximal edge length. All edges strictly greater than `threshold` are ignored.
+ * @param[in] dim_max Maximal dimension of the complex.
+ * @param[in] distance distance function that returns a `Filtration_value` from 2 given points. With
+ * `Gudhi::Euclidean_distance`, only the pairs of close points are compared, see `proximity_graph_edges_with_grid`.
+ * @param[in] collapse_iterations Number of times the edge collapse is performed.
+ *
+ * @return The number of edges before and after collapse, and the time spent in each stage.
+ *
+ * \ingroup edge_collapse
+ */
+template<typename SimplicialComplex, typename ForwardPointRange, typename Distance>
+Collapsed_rips_complex_statistics collapsed_rips_complex(SimplicialComplex& complex, const ForwardPointRange& points,
+                                                         typename SimplicialComplex::Filtration_value threshold,
+                                                         int dim_max, Distance distance, int collapse_iterations = 1) {
+  using Vertex_handle = typename SimplicialComplex::Vertex_handle;
+  using Filtration_value = typename SimplicialComplex::Filtration_value;
+  using Filtered_edge = std::tuple<Vertex_handle, Vertex_handle, Filtration_value>;
+
+  Collapsed_rips_complex_statistics stats;
+  Gudhi::Clock clock;
+  std::vector<Filtered_edge> edges;
+  std::size_t num_vertices = 0;
+  if constexpr (std::is_same<Distance, Euclidean_distance>::value) {
+    std::vector<std::pair<Vertex_handle, Vertex_handle>> pairs;
+    std::vector<Filtration_value> pairs_fil;
+    num_vertices = proximity_graph_edges_with_grid(points, threshold, distance, pairs, pairs_fil);
+    edges.reserve(pairs.size());
+    for (std::size_t e = 0; e < pairs.size(); ++e) edges.emplace_back(pairs[e].first, pairs[e].second, pairs_fil[e]);
+  } else {
+    Vertex_handle idx_u = 0;
+    for (auto it_u = points.begin(); it_u != points.end(); ++it_u, ++idx_u) {
+      Vertex_handle idx_v = idx_u + 1;
+      for (auto it_v = std::next(it_u); it_v != points.end(); ++it_v, ++idx_v) {
+        Filtration_value fil = distance(*it_u, *it_v);
+        if (fil <= threshold) edges.emplace_back(idx_u, idx_v, fil);
+      }
+    }
+    num_vertices = idx_u;
+  }
+  stats.edges_time = clock.num_seconds();
+
+  detail::collapse_and_expand(complex, num_vertices, std::move(edges), dim_max, collapse_iterations, stats);
+  return stats;
+}
+
+/** \brief Builds the Rips complex of a distance matrix in one pass, like `collapsed_rips_complex` from points.
+ *
+ * @param[out] complex Empty `Simplex_tree`, where the collapsed Rips complex is built.
+ * @param[in] distance_matrix Lower triangular (or full) distance matrix, the distance between `i < j` being
+ * `distance_matrix[j][i]`, as read by `Gudhi::read_lower_triangular_matrix_from_csv_file`.
+ * @param[in] threshold Maximal edge length. All edges strictly greater than `threshold` are ignored.
+ * @param[in] dim_max Maximal dimension of the complex.
+ * @param[in] collapse_iterations Number of times the edge collapse is performed.
+ *
+ * @return The number of edges before and after collapse, and the time spent in each stage.
+ *
+ * \ingroup edge_collapse
+ */
+template<typename SimplicialComplex, typename DistanceMatrix>
+Collapsed_rips_complex_statistics collapsed_rips_complex_from_distance_matrix(
+    SimplicialComplex& complex, const DistanceMatrix& distance_matrix,
+    typename SimplicialComplex::Filtration_value threshold, int dim_max, int collapse_iterations = 1) {
+  using Vertex_handle = typename SimplicialComplex::Vertex_handle;
+  using Filtration_value = typename SimplicialComplex::Filtration_value;
+  using Filtered_edge = std::tuple<Vertex_handle, Vertex_handle, Filtration_value>;
+
+  Collapsed_rips_complex_statistics stats;
+  Gudhi::Clock clock;
+  std::vector<Filtered_edge> edges;
+  const std::size_t num_vertices = distance_matrix.size();
+  // Same order of the edges as compute_proximity_graph
+  for (std::size_t u = 0; u < num_vertices; ++u) {
+    for (std::size_t v = u + 1; v < num_vertices; ++v) {
+      Filtration_value fil = distance_matrix[v][u];
+      if (fil <= threshold) edges.emplace_back(u, v, fil);
+    }
+  }
+  stats.edges_time = clock.num_seconds();
+
+  detail::collapse_and_expand(complex, num_vertices, std::move(edges), dim_max, collapse_iterations, stats);
+  return stats;
+}
+
+}  // namespace collapse
+
+}  // namespace Gudhi
+
+#endif  // COLLAPSED_RIPS_COMPLEX_H_
@@ -14,12 +14,14 @@
 #define FLAG_COMPLEX_EDGE_COLLAPSER_H_
 
 #include <gudhi/Debug_utils.h>
+#include <gudhi/Profiler_instrumentation.h>
 
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
 
 #ifdef GUDHI_USE_TBB
 #include <tbb/parallel_sort.h>
+#include <tbb/parallel_for.h>
 #endif
 
 #include <utility>
@@ -27,6 +29,7 @@
 #include <tuple>
 #include <algorithm>
 #include <limits>
+#include <cstdint>  // for std::uint64_t
 
 namespace Gudhi {
 
@@ -50,6 +53,45 @@ struct Flag_complex_edge_collapser {
   std::size_t num_vertices;
   std::vector<std::tuple<Vertex, Vertex, Filtration_value>> res;
 
+  // For dense graphs, the closed neighborhoods are also stored as rows of bits, ignoring the filtration values, so
+  // that most non-dominations are detected with a few word operations, before comparing the filtration values.
+  typedef std::uint64_t Bits_word;
+  static constexpr int bits_per_word = 64;
+  bool use_neighbors_bits = false;
+  std::size_t words_per_row = 0;
+  std::vector<Bits_word> neighbors_bits_data;
+  Bits_word* neighbors_bits(Vertex u){return neighbors_bits_data.data() + words_per_row * u;}
+  static void set_bit(Bits_word* row, Vertex v){row[v / bits_per_word] |= Bits_word(1) << (v % bits_per_word);}
+  static void reset_bit(Bits_word* row, Vertex v){row[v / bits_per_word] &= ~(Bits_word(1) << (v % bits_per_word));}
+
+  // The rows of bits take num_vertices^2 / 8 bytes, and a row is scanned instead of merging two neighborhoods, so
+  // they are used if the average degree is at least the number of words of a row (and the matrix is not too big).
+  // With GUDHI_COLLAPSE_USE_DENSE_ARRAY, the filtration values are directly available instead.
+  void init_neighbors_bits(std::size_t num_edges){
+    words_per_row = (num_vertices + bits_per_word - 1) / bits_per_word;
+#ifdef GUDHI_COLLAPSE_USE_DENSE_ARRAY
+    use_neighbors_bits = false;
+#else
+    use_neighbors_bits = num_vertices <= (std::size_t(1) << 15) && 2 * num_edges >= words_per_row * num_vertices;
+#endif
+    neighbors_bits_data.clear();
+    if (use_neighbors_bits) {
+      neighbors_bits_data.resize(words_per_row * num_vertices, 0);
+      for (std::size_t u = 0; u < num_vertices; ++u)
+        for (auto const& vf : neighbors[u]) set_bit(neighbors_bits(u), vf.first);
+    }
+  }
+
+  // True iff the neighborhood of e, given as a row of bits, is included in the closed neighborhood of c, ignoring
+  // the filtration values. The words outside of [first, last] are 0 in e_ngb_bits.
+  bool is_included_in_neighbors_bits(Bits_word const* e_ngb_bits, Vertex c, Vertex first, Vertex last){
+    Bits_word const* nc = neighbors_bits(c);
+    Bits_word missing = 0;
+    for (std::size_t i = first / bits_per_word; i <= static_cast<std::size_t>(last / bits_per_word); ++i)
+      missing |= e_ngb_bits[i] & ~nc[i];
+    return missing == 0;
+  }
+
 #ifdef GUDHI_COLLAPSE_USE_DENSE_ARRAY
   // Minimal matrix interface
   // Using this matrix generally helps performance, but the memory use may be excessive for a very sparse graph
@@ -75,6 +117,10 @@ struct Flag_complex_edge_collapser {
   void remove_neighbor(Vertex u, Vertex v) {
     neighbors[u].erase(v);
     neighbors[v].erase(u);
+    if (use_neighbors_bits) {
+      reset_bit(neighbors_bits(u), v);
+      reset_bit(neighbors_bits(v), u);
+    }
 #ifdef GUDHI_COLLAPSE_USE_DENSE_ARRAY
     neighbors_dense(u,v)=std::numeric_limits<Filtration_value>::infinity();
     neighbors_dense(v,u)=std::numeric_limits<Filtration_value>::infinity();
@@ -89,7 +135,9 @@ struct Flag_complex_edge_collapser {
 #endif
     // Use the raw sequence to avoid maintaining the order
     std::vector<typename Ngb_list::sequence_type> neighbors_seq(num_vertices);
+    std::size_t num_edges = 0;
     for(auto&&e : r){
+      ++num_edges;
       using std::get;
       Vertex u = get<0>(e);
       Vertex v = get<1>(e);
@@ -108,6 +156,7 @@ struct Flag_complex_edge_collapser {
       neighbors_dense(i,i)=-std::numeric_limits<Filtration_value>::infinity();
 #endif
     }
+    init_neighbors_bits(num_edges);
   }
 
   // Open neighborhood
@@ -184,8 +233,96 @@ struct Flag_complex_edge_collapser {
 #endif
   }
 
-  template<class FilteredEdgeRange, class Delay>
-  void process_edges(FilteredEdgeRange const& edges, Delay&& delay) {
+  // Time from which the edge [u,v], which appears at time, is not dominated anymore, given its common neighbors
+  // e_ngb before time and e_ngb_later after time. Returns true if the edge is dominated until the end, and can be
+  // removed. The graph is not modified, and only its edges between u, v and their common neighbors are read.
+  // e_ngb_bits is a zero row of bits, used as a buffer if use_neighbors_bits, and left zero.
+  bool collapse_edge(Filtration_value& time, boost::container::flat_set<Vertex>& e_ngb,
+                     std::vector<std::pair<Filtration_value, Vertex>>& e_ngb_later,
+                     std::vector<Bits_word>& e_ngb_bits){
+    if (use_neighbors_bits) {
+      for (Vertex w : e_ngb) set_bit(e_ngb_bits.data(), w);
+    }
+    bool dead = collapse_edge_(time, e_ngb, e_ngb_later, e_ngb_bits);
+    if (use_neighbors_bits) {
+      for (Vertex w : e_ngb) reset_bit(e_ngb_bits.data(), w);
+    }
+    return dead;
+  }
+
+  bool collapse_edge_(Filtration_value& time, boost::container::flat_set<Vertex>& e_ngb,
+                      std::vector<std::pair<Filtration_value, Vertex>>& e_ngb_later,
+                      std::vector<Bits_word>& e_ngb_bits){
+    // If we identify a good candidate (the first common neighbor) for being a dominator of e until infinity,
+    // we could check that a bit more cheaply. It does not seem to help though.
+    auto cmp1=[](auto const&a, auto const&b){return a.first > b.first;};
+    auto e_ngb_later_begin=e_ngb_later.begin();
+    auto e_ngb_later_end=e_ngb_later.end();
+    bool heapified = false;
+
+    while(true) {
+      Vertex dominator = -1;
+      // special case for size 1
+      // if(e_ngb.size()==1){dominator=*e_ngb.begin();}else
+      // It is tempting to test the dominators in increasing order of filtration value, which is likely to reduce
+      // the number of calls to is_dominated_by before finding a dominator, but sorting, even partially / lazily,
+      // is very expensive.
+      for(auto c : e_ngb){
+        if(use_neighbors_bits &&
+           !is_included_in_neighbors_bits(e_ngb_bits.data(), c, *e_ngb.begin(), *e_ngb.rbegin()))
+          continue;
+        if(is_dominated_by(e_ngb, c, time)){
+          dominator = c;
+          break;
+        }
+      }
+      if(dominator==-1) break;
+      // Push as long as dominator remains a dominator.
+      // Iterate on times where at least one neighbor appears.
+      for (bool still_dominated = true; still_dominated; ) {
+        if(e_ngb_later_begin == e_ngb_later_end) return true;
+        if(!heapified) {
+          // Eagerly sorting can be slow
+          std::make_heap(e_ngb_later_begin, e_ngb_later_end, cmp1);
+          heapified=true;
+        }
+        time = e_ngb_later_begin->first; // first place it may become critical
+        // Update the neighborhood for this new time, while checking if any of the new neighbors break domination.
+        while (e_ngb_later_begin != e_ngb_later_end && e_ngb_later_begin->first <= time) {
+          Vertex w = e_ngb_later_begin->second;
+#ifdef GUDHI_COLLAPSE_USE_DENSE_ARRAY
+          if (neighbors_dense(dominator,w) > e_ngb_later_begin->first)
+            still_dominated = false;
+#else
+          auto& ngb_dom = neighbors[dominator];
+          auto wit = ngb_dom.find(w); // neighborhood may be open or closed, it does not matter
+          if (wit == ngb_dom.end() || wit->second > e_ngb_later_begin->first)
+            still_dominated = false;
+#endif
+          e_ngb.insert(w);
+          if (use_neighbors_bits) set_bit(e_ngb_bits.data(), w);
+          std::pop_heap(e_ngb_later_begin, e_ngb_later_end--, cmp1);
+        }
+      } // this doesn't seem to help that much...
+    }
+    return false;
+  }
+
+  // Remove the edge, or delay it, and output it
+  void update_edge(Vertex u, Vertex v, Filtration_value input_time, Filtration_value start_time,
+                   Filtration_value time, bool dead){
+    if(dead) {
+      remove_neighbor(u, v);
+    } else if(start_time != time) {
+      delay_neighbor(u, v, time);
+      res.emplace_back(u, v, time);
+    } else {
+      res.emplace_back(u, v, input_time);
+    }
+  }
+
+  template<class FilteredEdgeRange>
+  void init_edges(FilteredEdgeRange const& edges) {
     {
       Vertex maxi = 0, maxj = 0;
       for(auto& fe : edges) {
@@ -198,82 +335,102 @@ struct Flag_complex_edge_collapser {
     }
 
     read_edges(edges);
+  }
+
+  template<class FilteredEdgeRange, class Delay>
+  void process_edges(FilteredEdgeRange const& edges, Delay&& delay) {
+    init_edges(edges);
 
     boost::container::flat_set<Vertex> e_ngb;
     e_ngb.reserve(num_vertices);
     std::vector<std::pair<Filtration_value, Vertex>> e_ngb_later;
+    std::vector<Bits_word> e_ngb_bits(use_neighbors_bits ? words_per_row : 0, 0);
     for(auto&e:edges) {
-      {
-        Vertex u = std::get<0>(e);
-        Vertex v = std::get<1>(e);
-        Filtration_value input_time = std::get<2>(e);
-        auto time = delay(input_time);
-        auto start_time = time;
-        e_ngb.clear();
-        e_ngb_later.clear();
-        common_neighbors(e_ngb, e_ngb_later, u, v, time);
-        // If we identify a good candidate (the first common neighbor) for being a dominator of e until infinity,
-        // we could check that a bit more cheaply. It does not seem to help though.
-        auto cmp1=[](auto const&a, auto const&b){return a.first > b.first;};
-        auto e_ngb_later_begin=e_ngb_later.begin();
-        auto e_ngb_later_end=e_ngb_later.end();
-        bool heapified = false;
-
-        bool dead = false;
-        while(true) {
-          Vertex dominator = -1;
-          // special case for size 1
-          // if(e_ngb.size()==1){dominator=*e_ngb.begin();}else
-          // It is tempting to test the dominators in increasing order of filtration value, which is likely to reduce
-          // the number of calls to is_dominated_by before finding a dominator, but sorting, even partially / lazily,
-          // is very expensive.
-          for(auto c : e_ngb){
-            if(is_dominated_by(e_ngb, c, time)){
-              dominator = c;
-              break;
-            }
-          }
-          if(dominator==-1) break;
-          // Push as long as dominator remains a dominator.
-          // Iterate on times where at least one neighbor appears.
-          for (bool still_dominated = true; still_dominated; ) {
-            if(e_ngb_later_begin == e_ngb_later_end) {
-              dead = true; goto end_move;
-            }
-            if(!heapified) {
-              // Eagerly sorting can be slow
-              std::make_heap(e_ngb_later_begin, e_ngb_later_end, cmp1);
-              heapified=true;
-            }
-            time = e_ngb_later_begin->first; // first place it may become critical
-            // Update the neighborhood for this new time, while checking if any of the new neighbors break domination.
-            while (e_ngb_later_begin != e_ngb_later_end && e_ngb_later_begin->first <= time) {
-              Vertex w = e_ngb_later_begin->second;
-#ifdef GUDHI_COLLAPSE_USE_DENSE_ARRAY
-              if (neighbors_dense(dominator,w) > e_ngb_later_begin->first)
-                still_dominated = false;
+      Vertex u = std::get<0>(e);
+      Vertex v = std::get<1>(e);
+      Filtration_value input_time = std::get<2>(e);
+      auto time = delay(input_time);
+      auto start_time = time;
+      e_ngb.clear();
+      e_ngb_later.clear();
+      common_neighbors(e_ngb, e_ngb_later, u, v, time);
+      bool dead = collapse_edge(time, e_ngb, e_ngb_later, e_ngb_bits);
+      update_edge(u, v, input_time, start_time, time, dead);
+    }
+  }
+
+  // Same result as process_edges, but the edges are collapsed concurrently by batches of consecutive edges. The
+  // collapse of an edge only reads the edges between its vertices and its common neighbors, so an edge can join the
+  // batch if none of the previous edges of the batch has both vertices among them, and the graph is only updated
+  // once the whole batch is collapsed.
+  template<class FilteredEdgeRange, class Delay>
+  void process_edges_in_parallel(FilteredEdgeRange const& edges, Delay&& delay) {
+    init_edges(edges);
+
+    struct Batch_edge {
+      Vertex u, v;
+      Filtration_value input_time, start_time, time;
+      bool dead;
+      boost::container::flat_set<Vertex> e_ngb;
+      std::vector<std::pair<Filtration_value, Vertex>> e_ngb_later;
+      std::vector<Bits_word> e_ngb_bits;
+    };
+    const std::size_t max_batch_size = 128;
+    std::vector<Batch_edge> batch(max_batch_size);
+    if (use_neighbors_bits)
+      for (auto& be : batch) be.e_ngb_bits.resize(words_per_row, 0);
+    std::size_t batch_size = 0;
+    // mark[w] == stamp iff w is a vertex or a common neighbor of the current edge
+    std::vector<std::size_t> mark(num_vertices, 0);
+    std::size_t stamp = 0;
+
+    auto flush = [&](){
+#ifdef GUDHI_USE_TBB
+      tbb::parallel_for(std::size_t(0), batch_size, [&](std::size_t i){
+        batch[i].dead = collapse_edge(batch[i].time, batch[i].e_ngb, batch[i].e_ngb_later, batch[i].e_ngb_bits);
+      });
 #else
-              auto& ngb_dom = neighbors[dominator];
-              auto wit = ngb_dom.find(w); // neighborhood may be open or closed, it does not matter
-              if (wit == ngb_dom.end() || wit->second > e_ngb_later_begin->first)
-                still_dominated = false;
+      for(std::size_t i = 0; i < batch_size; ++i)
+        batch[i].dead = collapse_edge(batch[i].time, batch[i].e_ngb, batch[i].e_ngb_later, batch[i].e_ngb_bits);
 #endif
-              e_ngb.insert(w);
-              std::pop_heap(e_ngb_later_begin, e_ngb_later_end--, cmp1);
-            }
-          } // this doesn't seem to help that much...
-        }
-end_move:
-        if(dead) {
-          remove_neighbor(u, v);
-        } else if(start_time != time) {
-          delay_neighbor(u, v, time);
-          res.emplace_back(u, v, time);
-        } else {
-          res.emplace_back(u, v, input_time);
+      for(std::size_t i = 0; i < batch_size; ++i) {
+        Batch_edge const& be = batch[i];
+        update_edge(be.u, be.v, be.input_time, be.start_time, be.time, be.dead);
+      }
+      batch_size = 0;
+    };
+
+    for(auto&e:edges) {
+      Batch_edge* be = &batch[batch_size];
+      be->u = std::get<0>(e);
+      be->v = std::get<1>(e);
+      be->input_time = std::get<2>(e);
+      be->start_time = be->time = delay(be->input_time);
+      for (bool retry = true; retry; ) {
+        retry = false;
+        be->e_ngb.clear();
+        be->e_ngb_later.clear();
+        common_neighbors(be->e_ngb, be->e_ngb_later, be->u, be->v, be->time);
+        if(batch_size == 0) break;
+        ++stamp;
+        mark[be->u] = mark[be->v] = stamp;
+        for(Vertex w : be->e_ngb) mark[w] = stamp;
+        for(auto const& p : be->e_ngb_later) mark[p.second] = stamp;
+        for(std::size_t i = 0; i < batch_size; ++i) {
+          if(mark[batch[i].u] == stamp && mark[batch[i].v] == stamp) {
+            // The common neighbors may change with the updates of the batch, start a new batch with this edge
+            std::size_t current = batch_size;
+            flush();
+            std::swap(batch[0], batch[current]);
+            be = &batch[0];
+            retry = true;
+            break;
+          }
         }
       }
+      if(++batch_size == max_batch_size) flush();
     }
+    flush();
   }
 
   std::vector<Filtered_edge> output() {
@@ -285,7 +442,7 @@ end_move:
 template<class R> R to_range(R&& r) { return std::move(r); }
 template<class R, class T> R to_range(T const& t) { R r; r.insert(r.end(), t.begin(), t.end()); return r; }
 
-template<class FilteredEdgeRange, class Delay>
+template<bool parallel = false, class FilteredEdgeRange, class Delay>
 auto flag_complex_collapse_edges(FilteredEdgeRange&& edges, Delay&&delay) {
   // Would it help to label the points according to some spatial sorting?
   auto first_edge_itr = std::begin(edges);
@@ -293,6 +450,7 @@ auto flag_complex_collapse_edges(FilteredEdgeRange&& edges, Delay&&delay) {
   using Filtration_value = std::decay_t<decltype(std::get<2>(*first_edge_itr))>;
   using Edge_collapser = Flag_complex_edge_collapser<Vertex, Filtration_value>;
   if (first_edge_itr != std::end(edges)) {
+    GUDHI_PROFILE_SCOPE("collapse::flag_complex_collapse_edges");
     auto edges2 = to_range<std::vector<typename Edge_collapser::Filtered_edge>>(std::forward<FilteredEdgeRange>(edges));
 #ifdef GUDHI_USE_TBB
     // I think this sorting is always negligible compared to the collapse, but parallelizing it shouldn't hurt.
@@ -302,8 +460,13 @@ auto flag_complex_collapse_edges(FilteredEdgeRange&& edges, Delay&&delay) {
     std::sort(edges2.begin(), edges2.end(), [](auto const&a, auto const&b){return std::get<2>(a)>std::get<2>(b);});
 #endif
     Edge_collapser edge_collapser;
-    edge_collapser.process_edges(edges2, std::forward<Delay>(delay));
-    return edge_collapser.output();
+    if constexpr (parallel)
+      edge_collapser.process_edges_in_parallel(edges2, std::forward<Delay>(delay));
+    else
+      edge_collapser.process_edges(edges2, std::forward<Delay>(delay));
+    auto remaining_edges = edge_collapser.output();
+    GUDHI_PROFILE_COUNT("collapse edges collapsed", edges2.size() - remaining_edges.size());
+    return remaining_edges;
   }
   return std::vector<typename Edge_collapser::Filtered_edge>();
 }
@@ -324,12 +487,35 @@ auto flag_complex_collapse_edges(FilteredEdgeRange&& edges, Delay&&delay) {
  * \note
  * Advanced: Defining the macro GUDHI_COLLAPSE_USE_DENSE_ARRAY tells gudhi to allocate a square table of size the
  * maximum vertex index. This usually speeds up the computation for dense graphs. However, for sparse graphs, the memory
- * use may be problematic and initializing this large table may be slow.
+ * use may be problematic and initializing this large table may be slow. Without this macro, when the average degree
+ * is large enough, the neighborhoods are also stored as rows of bits, which only take the square of the number of
+ * vertices divided by 8 bytes, to reject most non-dominating vertices quickly.
  */
 template<class FilteredEdgeRange> auto flag_complex_collapse_edges(const FilteredEdgeRange& edges) {
   return flag_complex_collapse_edges(edges, [](auto const&d){return d;});
 }
 
+/** \brief Same as `flag_complex_collapse_edges()`, with the same output, but independent edges are collapsed
+ * concurrently.
+ *
+ * The edges are still considered by decreasing filtration value, but by batches: an edge joins the current batch as
+ * long as no edge of the batch has both its vertices among the vertices and the common neighbors of this edge. The
+ * edges of a batch are then collapsed in parallel with TBB, and sequentially without it.
+ *
+ * \param[in] edges Range of Filtered edges. There is no need for the range to be sorted, as it will be done internally.
+ *
+ * \tparam FilteredEdgeRange Range of `std::tuple<Vertex_handle, Vertex_handle, Filtration_value>`
+ * where `Vertex_handle` is the type of a vertex index.
+ *
+ * \return Remaining edges after collapse as a range of
+ * `std::tuple<Vertex_handle, Vertex_handle, Filtration_value>`.
+ *
+ * \ingroup edge_collapse
+ */
+template<class FilteredEdgeRange> auto parallel_flag_complex_collapse_edges(const FilteredEdgeRange& edges) {
+  return flag_complex_collapse_edges<true>(edges, [](auto const&d){return d;});
+}
+
 }  // namespace collapse
 
 }  // namespace Gudhi
@@ -0,0 +1,228 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef FLAG_COMPLEX_MULTI_EDGE_COLLAPSER_H_
+#define FLAG_COMPLEX_MULTI_EDGE_COLLAPSER_H_
+
+#include <boost/container/flat_map.hpp>
+
+#include <utility>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <cstddef>
+
+namespace Gudhi {
+
+namespace collapse {
+
+/** \private
+ *
+ * \brief Filtration-domination edge collapser for multi-filtered graphs, cf.
+ * Alonso, Kerber, Pritam, "Filtration-domination in bifiltered graphs", ALENEX 2023.
+ *
+ * An edge \f$e = uv\f$ is filtration-dominated if, at every grade \f$x \geq f(e)\f$, it is dominated in the graph
+ * \f$G_x\f$, i.e., some vertex of its closed neighborhood is adjacent to all its other common neighbors. It is strongly
+ * filtration-dominated if the same vertex \f$w\f$ works for all grades, i.e., iff \f$f(uw), f(vw) \leq f(e)\f$ and
+ * \f$f(wy) \leq f(e) \vee f(uy) \vee f(vy)\f$ for every common neighbor \f$y\f$ of \f$u\f$ and \f$v\f$.
+ * Removing such an edge does not change the multi-parameter persistent homology of the flag complex.
+ *
+ * \tparam Vertex type must be an integer type.
+ * \tparam Filtration_value must be a random access container of values (one per parameter), e.g. `std::vector<float>`.
+ */
+template<typename Vertex, typename Filtration_value>
+struct Flag_complex_multi_edge_collapser {
+  using Filtered_edge = std::tuple<Vertex, Vertex, Filtration_value>;
+  typedef boost::container::flat_map<Vertex, Filtration_value> Ngb_list;
+  typedef std::vector<Ngb_list> Neighbors;
+  // Maximal number of grades tested for a (non-strong) filtration-domination, the edge is kept above this.
+  static constexpr std::size_t max_number_of_grades = 1 << 12;
+
+  Neighbors neighbors; // open neighborhood
+  std::size_t num_parameters = 0;
+
+  static bool leq(const Filtration_value& a, const Filtration_value& b) {
+    for (std::size_t i = 0; i < a.size(); ++i)
+      if (b[i] < a[i]) return false;
+    return true;
+  }
+  static void push_to(Filtration_value& a, const Filtration_value& b) {
+    for (std::size_t i = 0; i < a.size(); ++i)
+      if (a[i] < b[i]) a[i] = b[i];
+  }
+
+  template<class FilteredEdgeRange>
+  void read_edges(FilteredEdgeRange const& edges) {
+    Vertex maxi = 0;
+    for (auto const& e : edges) {
+      maxi = std::max({maxi, std::get<0>(e), std::get<1>(e)});
+      num_parameters = std::get<2>(e).size();
+    }
+    neighbors.assign(static_cast<std::size_t>(maxi) + 1, Ngb_list());
+    std::vector<typename Ngb_list::sequence_type> neighbors_seq(neighbors.size());
+    for (auto const& e : edges) {
+      Vertex u = std::get<0>(e);
+      Vertex v = std::get<1>(e);
+      if (u == v) continue;
+      neighbors_seq[u].emplace_back(v, std::get<2>(e));
+      neighbors_seq[v].emplace_back(u, std::get<2>(e));
+    }
+    for (std::size_t i = 0; i < neighbors_seq.size(); ++i)
+      neighbors[i].adopt_sequence(std::move(neighbors_seq[i])); // calls sort
+  }
+
+  // Common neighbors y of u and v, with the grade f(uy) v f(vy) at which y enters the neighborhood of uv.
+  void common_neighbors(std::vector<std::pair<Vertex, Filtration_value>>& e_ngb, Vertex u, Vertex v) const {
+    e_ngb.clear();
+    auto ui = neighbors[u].begin(), ue = neighbors[u].end();
+    auto vi = neighbors[v].begin(), ve = neighbors[v].end();
+    while (ui != ue && vi != ve) {
+      if (ui->first < vi->first) { ++ui; continue; }
+      if (vi->first < ui->first) { ++vi; continue; }
+      Filtration_value f = ui->second;
+      push_to(f, vi->second);
+      e_ngb.emplace_back(ui->first, std::move(f));
+      ++ui; ++vi;
+    }
+  }
+
+  // f(wy) <= x, i.e., wy is present at grade x
+  bool is_edge_below(Vertex w, Vertex y, const Filtration_value& grade) const {
+    auto const& nw = neighbors[w];
+    auto it = nw.find(y);
+    return it != nw.end() && leq(it->second, grade);
+  }
+
+  bool is_strongly_dominated(const std::vector<std::pair<Vertex, Filtration_value>>& e_ngb,
+                             const Filtration_value& f_e) const {
+    for (auto const& [w, f_w] : e_ngb) {
+      if (!leq(f_w, f_e)) continue; // w has to be a neighbor of e as soon as e appears
+      bool dominates = true;
+      Filtration_value grade;
+      for (auto const& [y, f_y] : e_ngb) {
+        if (y == w) continue;
+        grade = f_e;
+        push_to(grade, f_y);
+        if (!is_edge_below(w, y, grade)) { dominates = false; break; }
+      }
+      if (dominates) return true;
+    }
+    return false;
+  }
+
+  // Domination of e inside G_grade
+  bool is_dominated_at(const std::vector<std::pair<Vertex, Filtration_value>>& e_ngb, const Filtration_value& grade) const {
+    for (auto const& [w, f_w] : e_ngb) {
+      if (!leq(f_w, grade)) continue;
+      bool dominates = true;
+      for (auto const& [y, f_y] : e_ngb) {
+        if (y == w || !leq(f_y, grade)) continue;
+        if (!is_edge_below(w, y, grade)) { dominates = false; break; }
+      }
+      if (dominates) return true;
+    }
+    return false;
+  }
+
+  // The neighborhood of e is constant between the joins of f(e) with at most num_parameters grades of e_ngb,
+  // and domination is monotonous there, so it is enough to test these joins.
+  bool is_dominated(const std::vector<std::pair<Vertex, Filtration_value>>& e_ngb, const Filtration_value& f_e) const {
+    if (e_ngb.empty()) return false;
+    std::size_t num_grades = 1;
+    for (std::size_t i = 0; i < num_parameters; ++i) {
+      num_grades *= e_ngb.size() + 1;
+      if (num_grades > max_number_of_grades) return false;
+    }
+    // Coordinate i of the grade is taken from f(e) (choice 0) or from the (choice-1)th neighbor.
+    std::vector<std::size_t> choice(num_parameters, 0);
+    Filtration_value grade = f_e;
+    for (;;) {
+      for (std::size_t i = 0; i < num_parameters; ++i)
+        grade[i] = choice[i] == 0 ? f_e[i] : std::max(f_e[i], e_ngb[choice[i] - 1].second[i]);
+      if (!is_dominated_at(e_ngb, grade)) return false;
+      std::size_t i = 0;
+      while (i < num_parameters && ++choice[i] > e_ngb.size()) choice[i++] = 0;
+      if (i == num_parameters) return true;
+    }
+  }
+
+  void remove_edge(Vertex u, Vertex v) {
+    neighbors[u].erase(v);
+    neighbors[v].erase(u);
+  }
+
+  /* Removes the dominated edges, in decreasing lexicographic order of their filtration values.
+   * Returns the number of removed edges. */
+  template<class FilteredEdgeRange>
+  std::size_t process_edges(FilteredEdgeRange& edges, bool strong) {
+    std::sort(edges.begin(), edges.end(), [](auto const& a, auto const& b) {
+      return std::lexicographical_compare(std::get<2>(b).begin(), std::get<2>(b).end(),
+                                          std::get<2>(a).begin(), std::get<2>(a).end());
+    });
+    std::vector<std::pair<Vertex, Filtration_value>> e_ngb;
+    std::size_t num_removed = 0;
+    auto out = edges.begin();
+    for (auto& e : edges) {
+      Vertex u = std::get<0>(e);
+      Vertex v = std::get<1>(e);
+      common_neighbors(e_ngb, u, v);
+      const Filtration_value& f_e = std::get<2>(e);
+      if (strong ? is_strongly_dominated(e_ngb, f_e) : is_dominated(e_ngb, f_e)) {
+        remove_edge(u, v);
+        ++num_removed;
+      } else {
+        if (&*out != &e) *out = std::move(e);
+        ++out;
+      }
+    }
+    edges.erase(out, edges.end());
+    return num_removed;
+  }
+};
+
+/** \brief Implicitly constructs a multi-filtered flag complex from 1-critical edges, removes (strongly)
+ * filtration-dominated edges while preserving the multi-parameter persistent homology, and returns the remaining
+ * edges. The filtration value of vertices is irrelevant to this function.
+ *
+ * Passes over the remaining edges are repeated until no edge is removed, or `max_iterations` passes were done.
+ * Strong domination is cheaper to check, and works for any number of parameters. Non-strong domination removes more
+ * edges, but tests a number of grades exponential in the number of parameters; edges with too many such grades
+ * are kept.
+ *
+ * \param[in] edges Range of filtered edges `std::tuple<Vertex_handle, Vertex_handle, Filtration_value>`, where
+ * `Filtration_value` is a random access container of coordinates, all of the same size.
+ * \param[in] strong Whether to only remove strongly filtration-dominated edges.
+ * \param[in] max_iterations Maximal number of passes over the edges. Negative means no limit.
+ *
+ * \return Remaining edges after collapse, as a vector of `std::tuple<Vertex_handle, Vertex_handle, Filtration_value>`.
+ *
+ * \ingroup edge_collapse
+ */
+template<class FilteredEdgeRange>
+auto flag_complex_multi_collapse_edges(const FilteredEdgeRange& edges, bool strong = true, int max_iterations = -1) {
+  auto first_edge_itr = std::begin(edges);
+  using Vertex = std::decay_t<decltype(std::get<0>(*first_edge_itr))>;
+  using Filtration_value = std::decay_t<decltype(std::get<2>(*first_edge_itr))>;
+  using Edge_collapser = Flag_complex_multi_edge_collapser<Vertex, Filtration_value>;
+  std::vector<typename Edge_collapser::Filtered_edge> remaining(std::begin(edges), std::end(edges));
+  if (remaining.empty()) return remaining;
+  Edge_collapser edge_collapser;
+  edge_collapser.read_edges(remaining);
+  for (int iteration = 0; max_iterations < 0 || iteration < max_iterations; ++iteration) {
+    if (edge_collapser.process_edges(remaining, strong) == 0) break;
+  }
+  return remaining;
+}
+
+}  // namespace collapse
+
+}  // namespace Gudhi
+
+#endif  // FLAG_COMPLEX_MULTI_EDGE_COLLAPSER_H_
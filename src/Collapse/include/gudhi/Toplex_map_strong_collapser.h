@@ -0,0 +1,240 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef TOPLEX_MAP_STRONG_COLLAPSER_H_
+#define TOPLEX_MAP_STRONG_COLLAPSER_H_
+
+#include <gudhi/Toplex_map.h>
+
+#include <algorithm>
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <limits>
+#include <unordered_map>
+#include <utility>  // for std::pair
+#include <vector>
+
+namespace Gudhi {
+
+namespace collapse {
+
+/** \brief Report of `strong_collapse()`.
+ *
+ * \ingroup edge_collapse
+ */
+struct Strong_collapse_report {
+  /** \brief Number of vertices of the complex before the collapse. */
+  std::size_t num_vertices_before = 0;
+  /** \brief Number of vertices of the complex after the collapse. */
+  std::size_t num_vertices_after = 0;
+  /** \brief Number of maximal simplices of the complex before the collapse. */
+  std::size_t num_maximal_simplices_before = 0;
+  /** \brief Number of maximal simplices of the complex after the collapse. */
+  std::size_t num_maximal_simplices_after = 0;
+  /** \brief The removed vertices, in the order in which they were collapsed, each one with the vertex that dominated
+   * it at that time. Mapping each removed vertex to its dominating vertex, until a remaining vertex is reached, is a
+   * simplicial retraction of the complex onto the collapsed one. */
+  std::vector<std::pair<Toplex_map::Vertex, Toplex_map::Vertex>> collapsed_vertices;
+};
+
+/** \private
+ *
+ * \brief Strong collapse of a simplicial complex given by its maximal simplices.
+ *
+ * \details The maximal simplices are numbered, and each vertex stores the set of the maximal simplices that contain
+ * it as a sparse bitset: a sorted list of the nonzero words of 64 bits. A vertex \f$v\f$ is dominated by \f$v'\f$ if
+ * and only if the bitset of \f$v\f$ is a subset of the bitset of \f$v'\f$, which is tested word by word.
+ */
+class Toplex_map_strong_collapser {
+ public:
+  using Vertex = Toplex_map::Vertex;
+
+  explicit Toplex_map_strong_collapser(const Toplex_map& complex) {
+    std::unordered_map<Vertex, std::size_t> index_of_vertex;
+    for (const Toplex_map::Simplex_ptr& sptr : complex.maximal_simplices()) {
+      if (sptr->empty()) continue;
+      const std::size_t s = simplices_.size();
+      simplices_.emplace_back();
+      for (Vertex v : *sptr) {
+        auto inserted = index_of_vertex.emplace(v, vertices_.size());
+        if (inserted.second) {
+          vertices_.push_back(v);
+          cofaces_.emplace_back();
+        }
+        simplices_.back().push_back(inserted.first->second);
+        set_bit(cofaces_[inserted.first->second], s);
+      }
+    }
+    alive_.assign(simplices_.size(), true);
+    removed_.assign(vertices_.size(), false);
+  }
+
+  /** \brief Removes the dominated vertices one by one, until none of the remaining vertices is dominated. */
+  void collapse() {
+    std::vector<std::size_t> stack(vertices_.size());
+    std::vector<bool> in_stack(vertices_.size(), true);
+    for (std::size_t v = 0; v < vertices_.size(); ++v) stack[v] = vertices_.size() - 1 - v;
+    while (!stack.empty()) {
+      const std::size_t v = stack.back();
+      stack.pop_back();
+      in_stack[v] = false;
+      if (removed_[v]) continue;
+      const std::size_t u = dominating_vertex(v);
+      if (u == npos) continue;
+      collapsed_.emplace_back(vertices_[v], vertices_[u]);
+      // The vertices whose star changes may become dominated
+      for (std::size_t s : remove_vertex(v))
+        for (std::size_t w : simplices_[s])
+          if (!in_stack[w] && !removed_[w]) {
+            in_stack[w] = true;
+            stack.push_back(w);
+          }
+    }
+  }
+
+  /** \brief Replaces the maximal simplices of `complex` with the ones of the collapsed complex, and returns the
+   * report of the collapse. */
+  Strong_collapse_report output(Toplex_map& complex) const {
+    Strong_collapse_report report;
+    report.num_vertices_before = vertices_.size();
+    report.num_vertices_after = vertices_.size() - collapsed_.size();
+    report.num_maximal_simplices_before = simplices_.size();
+    report.collapsed_vertices = collapsed_;
+    complex.remove_simplex(Toplex_map::Simplex());
+    std::vector<Vertex> simplex;
+    for (std::size_t s = 0; s < simplices_.size(); ++s) {
+      if (!alive_[s]) continue;
+      simplex.clear();
+      for (std::size_t v : simplices_[s]) simplex.push_back(vertices_[v]);
+      complex.insert_independent_simplex(simplex);
+      ++report.num_maximal_simplices_after;
+    }
+    return report;
+  }
+
+ private:
+  using Bits_word = std::uint64_t;
+  static constexpr int bits_per_word = 64;
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+  // The nonzero words of a bitset, sorted by index
+  using Sparse_bits = std::vector<std::pair<std::size_t, Bits_word>>;
+
+  static void set_bit(Sparse_bits& bits, std::size_t i) {
+    const std::size_t word = i / bits_per_word;
+    if (bits.empty() || bits.back().first != word) bits.emplace_back(word, 0);
+    bits.back().second |= Bits_word(1) << (i % bits_per_word);
+  }
+
+  static void reset_bit(Sparse_bits& bits, std::size_t i) {
+    const std::size_t word = i / bits_per_word;
+    auto it = std::lower_bound(bits.begin(), bits.end(), std::make_pair(word, Bits_word(0)));
+    it->second &= ~(Bits_word(1) << (i % bits_per_word));
+    if (it->second == 0) bits.erase(it);
+  }
+
+  static std::size_t lowest_bit(Bits_word word) {
+    std::size_t i = 0;
+    for (; (word & 1) == 0; word >>= 1) ++i;
+    return i;
+  }
+
+  // Is a a subset of b ?
+  static bool included(const Sparse_bits& a, const Sparse_bits& b) {
+    auto it = b.begin();
+    for (const auto& word : a) {
+      while (it != b.end() && it->first < word.first) ++it;
+      if (it == b.end() || it->first != word.first || (word.second & ~it->second) != 0) return false;
+    }
+    return true;
+  }
+
+  // A vertex that dominates v, i.e. that belongs to all the maximal simplices that contain v, or npos. The candidates
+  // are the other vertices of one of these simplices.
+  std::size_t dominating_vertex(std::size_t v) const {
+    const Sparse_bits& bits = cofaces_[v];
+    const std::size_t first_simplex = bits.front().first * bits_per_word + lowest_bit(bits.front().second);
+    for (std::size_t u : simplices_[first_simplex])
+      if (u != v && included(bits, cofaces_[u])) return u;
+    return npos;
+  }
+
+  // Removes v from its maximal simplices, and then the ones that are not maximal anymore, i.e. that are included in
+  // another maximal simplex: the intersection of the bitsets of their vertices is not only themselves. Returns the
+  // maximal simplices that contained v.
+  std::vector<std::size_t> remove_vertex(std::size_t v) {
+    std::vector<std::size_t> star;
+    for (const auto& word : cofaces_[v])
+      for (Bits_word bits = word.second; bits != 0; bits &= bits - 1)
+        star.push_back(word.first * bits_per_word + lowest_bit(bits));
+    cofaces_[v].clear();
+    removed_[v] = true;
+    for (std::size_t s : star) simplices_[s].erase(std::find(simplices_[s].begin(), simplices_[s].end(), v));
+    Sparse_bits intersection;
+    for (std::size_t s : star) {
+      const std::vector<std::size_t>& simplex = simplices_[s];
+      intersection = cofaces_[simplex.front()];
+      for (std::size_t i = 1; i < simplex.size() && !intersection.empty(); ++i)
+        intersect(intersection, cofaces_[simplex[i]]);
+      reset_bit(intersection, s);
+      if (intersection.empty()) continue;
+      alive_[s] = false;
+      for (std::size_t w : simplex) reset_bit(cofaces_[w], s);
+    }
+    return star;
+  }
+
+  static void intersect(Sparse_bits& a, const Sparse_bits& b) {
+    auto out = a.begin();
+    auto it = b.begin();
+    for (const auto& word : a) {
+      while (it != b.end() && it->first < word.first) ++it;
+      if (it == b.end()) break;
+      if (it->first == word.first && (word.second & it->second) != 0) *out++ = {word.first, word.second & it->second};
+    }
+    a.erase(out, a.end());
+  }
+
+  std::vector<Vertex> vertices_;
+  // The vertices of each maximal simplex, as indices in vertices_, and the maximal simplices that contain each vertex
+  std::vector<std::vector<std::size_t>> simplices_;
+  std::vector<Sparse_bits> cofaces_;
+  std::vector<bool> alive_;
+  std::vector<bool> removed_;
+  std::vector<std::pair<Vertex, Vertex>> collapsed_;
+};
+
+/** \brief Strong collapse of a simplicial complex, represented by its maximal simplices in a `Toplex_map`.
+ *
+ * \ingroup edge_collapse
+ *
+ * \details A vertex \f$v\f$ is dominated by another vertex \f$v'\f$ if all the maximal simplices that contain
+ * \f$v\f$ also contain \f$v'\f$, i.e. if the link of \f$v\f$ is a cone of apex \f$v'\f$. The dominated vertices are
+ * removed one by one, with their cofaces, until none is left, which preserves the homotopy type of the complex. The
+ * result, the core of the complex, does not depend on the order of the removals (up to isomorphism)
+ * \cite strongcollapseesa.
+ *
+ * Contrary to `flag_complex_collapse_edges()`, the complex does not need to be a flag complex, e.g. an alpha, Čech or
+ * witness complex can be collapsed after inserting its simplices with `Toplex_map::insert_simplex()`.
+ *
+ * @param[in,out] complex The simplicial complex, replaced by the collapsed complex.
+ * @return The numbers of vertices and of maximal simplices before and after the collapse, and the collapsed vertices
+ * with their dominating vertices.
+ */
+inline Strong_collapse_report strong_collapse(Toplex_map& complex) {
+  Toplex_map_strong_collapser collapser(complex);
+  collapser.collapse();
+  return collapser.output(complex);
+}
+
+}  // namespace collapse
+
+}  // namespace Gudhi
+
+#endif  // TOPLEX_MAP_STRONG_COLLAPSER_H_
@@ -16,6 +16,8 @@
 #include <boost/range/adaptor/transformed.hpp>
 
 #include <gudhi/Flag_complex_edge_collapser.h>
+#include <gudhi/Collapsed_rips_complex.h>
+#include <gudhi/Simplex_tree.h>
 #include <gudhi/distance_functions.h>
 #include <gudhi/graph_simplicial_complex.h>
 
@@ -196,3 +198,83 @@ BOOST_AUTO_TEST_CASE(collapse_from_proximity_graph) {
   BOOST_CHECK(filtration_is_edge_length_nb == 4);
   BOOST_CHECK(filtration_is_diagonal_length_nb == 1);
 }
+
+BOOST_AUTO_TEST_CASE(collapsed_rips_complex_pipeline) {
+  std::cout << "***** COLLAPSED RIPS COMPLEX PIPELINE *****" << std::endl;
+  using Simplex_tree = Gudhi::Simplex_tree<>;
+  using Point = std::vector<double>;
+  using Stree_filtered_edge = std::tuple<Simplex_tree::Vertex_handle, Simplex_tree::Vertex_handle, double>;
+  std::vector<Point> point_cloud;
+  std::vector<std::vector<double>> distance_matrix;
+  for (int i = 0; i < 60; ++i) {
+    // Points on a noisy circle
+    double angle = 2. * 3.14159265358979 * i / 60.;
+    double radius = 1. + 0.1 * std::sin(7. * i);
+    point_cloud.push_back({radius * std::cos(angle), radius * std::sin(angle), 0.05 * std::cos(13. * i)});
+    std::vector<double> row;
+    for (int j = 0; j < i; ++j) row.push_back(Gudhi::Euclidean_distance()(point_cloud[i], point_cloud[j]));
+    distance_matrix.push_back(row);
+  }
+  double threshold = 0.8;
+
+  for (int iterations : {1, 2}) {
+    // What the utilities used to do: proximity graph, collapse, insertion of the edges one by one, expansion
+    std::vector<Stree_filtered_edge> edges_list;
+    for (std::size_t i = 0; i < point_cloud.size(); ++i)
+      for (std::size_t j = i + 1; j < point_cloud.size(); ++j)
+        if (distance_matrix[j][i] <= threshold) edges_list.emplace_back(i, j, distance_matrix[j][i]);
+    for (int iter = 0; iter < iterations; ++iter) edges_list = Gudhi::collapse::flag_complex_collapse_edges(edges_list);
+    Simplex_tree expected;
+    for (int v = 0; v < static_cast<int>(point_cloud.size()); ++v) expected.insert_simplex({v}, 0.);
+    for (auto const& e : edges_list) expected.insert_simplex({std::get<0>(e), std::get<1>(e)}, std::get<2>(e));
+    expected.expansion(3);
+
+    Simplex_tree from_points;
+    auto stats = Gudhi::collapse::collapsed_rips_complex(from_points, point_cloud, threshold, 3,
+                                                         Gudhi::Euclidean_distance(), iterations);
+    std::cout << "Edges: " << stats.num_edges << " -> " << stats.num_collapsed_edges << " - simplices: "
+              << from_points.num_simplices() << std::endl;
+    BOOST_CHECK(stats.num_collapsed_edges == edges_list.size());
+    BOOST_CHECK(stats.num_edges >= stats.num_collapsed_edges);
+    BOOST_CHECK(stats.edges_time >= 0. && stats.collapse_time >= 0.);
+    BOOST_CHECK(stats.insertion_time >= 0. && stats.expansion_time >= 0.);
+    BOOST_CHECK(from_points == expected);
+
+    Simplex_tree from_matrix;
+    stats = Gudhi::collapse::collapsed_rips_complex_from_distance_matrix(from_matrix, distance_matrix, threshold, 3,
+                                                                         iterations);
+    BOOST_CHECK(stats.num_collapsed_edges == edges_list.size());
+    BOOST_CHECK(from_matrix == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_collapse) {
+  std::cout << "***** PARALLEL COLLAPSE *****" << std::endl;
+  // Points on a noisy torus, with many edges of the same length
+  std::vector<std::vector<Filtration_value>> point_cloud;
+  for (int i = 0; i < 30; ++i)
+    for (int j = 0; j < 20; ++j) {
+      double a = 2. * 3.14159265358979 * i / 30.;
+      double b = 2. * 3.14159265358979 * j / 20.;
+      point_cloud.push_back({static_cast<Filtration_value>((3. + std::cos(b)) * std::cos(a)),
+                             static_cast<Filtration_value>((3. + std::cos(b)) * std::sin(a)),
+                             static_cast<Filtration_value>(std::sin(b) + 0.01 * std::sin(7. * i * j))});
+    }
+  Filtered_edge_list edges;
+  for (std::size_t u = 0; u < point_cloud.size(); ++u)
+    for (std::size_t v = u + 1; v < point_cloud.size(); ++v) {
+      Filtration_value fil = Gudhi::Euclidean_distance()(point_cloud[u], point_cloud[v]);
+      if (fil <= 1.5) edges.emplace_back(u, v, fil);
+    }
+  auto remaining_edges = Gudhi::collapse::flag_complex_collapse_edges(edges);
+  auto parallel_remaining_edges = Gudhi::collapse::parallel_flag_complex_collapse_edges(edges);
+  std::cout << edges.size() << " edges, " << remaining_edges.size() << " after collapse" << std::endl;
+  BOOST_CHECK(remaining_edges.size() < edges.size());
+  BOOST_CHECK(parallel_remaining_edges == remaining_edges);
+
+  // Same edges, with a far away edge that makes the graph too sparse for the rows of bits of the neighborhoods
+  edges.emplace_back(3000, 3001, 0.);
+  auto sparse_remaining_edges = Gudhi::collapse::flag_complex_collapse_edges(edges);
+  BOOST_CHECK(sparse_remaining_edges.size() == remaining_edges.size() + 1);
+  for (auto const& edge : remaining_edges) BOOST_CHECK(find_edge_in_list(edge, sparse_remaining_edges));
+}
@@ -0,0 +1,114 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "multi_collapse"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Flag_complex_multi_edge_collapser.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+
+#include <iostream>
+#include <tuple>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+
+using Vertex_handle = int;
+using Filtration_value = std::vector<double>;
+using Filtered_edge = std::tuple<Vertex_handle, Vertex_handle, Filtration_value>;
+using Filtered_edge_list = std::vector<Filtered_edge>;
+
+using Simplex_tree = Gudhi::Simplex_tree<>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+using Persistent_cohomology = Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree, Field_Zp>;
+
+BOOST_AUTO_TEST_CASE(multi_collapse_triangle) {
+  // All edges at the same grade : one of them is dominated, the two others are needed for H0.
+  Filtered_edge_list edges{{0, 1, {0., 0.}}, {1, 2, {0., 0.}}, {0, 2, {0., 0.}}};
+  for (bool strong : {true, false}) {
+    auto remaining = Gudhi::collapse::flag_complex_multi_collapse_edges(edges, strong);
+    BOOST_CHECK(remaining.size() == 2);
+  }
+  // Incomparable grades : the triangle only appears at (1,1), when all edges are present.
+  Filtered_edge_list incomparable{{0, 1, {0., 0.}}, {1, 2, {1., 0.}}, {0, 2, {0., 1.}}};
+  for (bool strong : {true, false}) {
+    auto remaining = Gudhi::collapse::flag_complex_multi_collapse_edges(incomparable, strong);
+    BOOST_CHECK(remaining.size() == 3);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(multi_collapse_cycle) {
+  // No common neighbors, nothing to collapse.
+  Filtered_edge_list edges{{0, 1, {0., 1., 2.}}, {1, 2, {1., 0., 2.}}, {2, 3, {2., 1., 0.}}, {0, 3, {0., 0., 0.}}};
+  auto remaining = Gudhi::collapse::flag_complex_multi_collapse_edges(edges);
+  BOOST_CHECK(remaining.size() == 4);
+}
+
+// Persistence of the flag complex restricted to the line of direction (1,...,1) through basepoint
+std::vector<std::tuple<int, double, double>> line_persistence(const Filtered_edge_list& edges,
+                                                               const std::vector<Filtration_value>& vertices,
+                                                               const Filtration_value& basepoint) {
+  auto push_forward = [&](const Filtration_value& f) {
+    double t = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < f.size(); ++i) t = std::max(t, f[i] - basepoint[i]);
+    return t;
+  };
+  Simplex_tree stree;
+  for (std::size_t v = 0; v < vertices.size(); ++v)
+    stree.insert_simplex({static_cast<Vertex_handle>(v)}, push_forward(vertices[v]));
+  for (auto const& e : edges)
+    stree.insert_simplex({std::get<0>(e), std::get<1>(e)}, push_forward(std::get<2>(e)));
+  stree.expansion(3);
+  stree.initialize_filtration();
+  Persistent_cohomology pcoh(stree);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology(1e-9);
+  std::vector<std::tuple<int, double, double>> out;
+  for (int dim = 0; dim < 3; ++dim)
+    for (auto const& [birth, death] : pcoh.intervals_in_dimension(dim)) out.emplace_back(dim, birth, death);
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+BOOST_AUTO_TEST_CASE(multi_collapse_preserves_persistence) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> unif(0., 1.);
+  for (std::size_t num_parameters : {2u, 3u}) {
+    const std::size_t num_points = 25;
+    std::vector<std::vector<double>> points(num_points, std::vector<double>(2));
+    std::vector<Filtration_value> vertices(num_points, Filtration_value(num_parameters, 0.));
+    for (std::size_t v = 0; v < num_points; ++v) {
+      points[v] = {unif(gen), unif(gen)};
+      for (std::size_t i = 1; i < num_parameters; ++i) vertices[v][i] = std::round(10 * unif(gen)) / 10;
+    }
+    Filtered_edge_list edges;
+    for (std::size_t u = 0; u < num_points; ++u)
+      for (std::size_t v = u + 1; v < num_points; ++v) {
+        Filtration_value f(num_parameters);
+        f[0] = std::round(10 * std::hypot(points[u][0] - points[v][0], points[u][1] - points[v][1])) / 10;
+        for (std::size_t i = 1; i < num_parameters; ++i) f[i] = std::max(vertices[u][i], vertices[v][i]);
+        if (f[0] < 0.5) edges.emplace_back(u, v, f);
+      }
+    for (bool strong : {true, false}) {
+      auto remaining = Gudhi::collapse::flag_complex_multi_collapse_edges(edges, strong);
+      std::clog << num_parameters << " parameters, " << (strong ? "strong" : "non-strong") << " collapse : "
+                << edges.size() << " -> " << remaining.size() << " edges" << std::endl;
+      BOOST_CHECK(remaining.size() < edges.size());
+      for (double b0 : {0., -0.2, 0.3}) {
+        Filtration_value basepoint(num_parameters, 0.);
+        basepoint[0] = b0;
+        BOOST_CHECK(line_persistence(edges, vertices, basepoint) == line_persistence(remaining, vertices, basepoint));
+      }
+    }
+  }
+}
@@ -0,0 +1,104 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "strong_collapse"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Toplex_map_strong_collapser.h>
+#include <gudhi/Toplex_map.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+using Vertex = Gudhi::Toplex_map::Vertex;
+using Simplex = Gudhi::Toplex_map::Simplex;
+using Simplex_tree = Gudhi::Simplex_tree<>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+using Persistent_cohomology = Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree, Field_Zp>;
+
+std::set<Simplex> maximal_simplices(const Gudhi::Toplex_map& tm) {
+  std::set<Simplex> result;
+  for (const auto& sptr : tm.maximal_simplices()) result.insert(*sptr);
+  return result;
+}
+
+std::vector<int> betti_numbers(const Gudhi::Toplex_map& tm) {
+  Simplex_tree st;
+  for (const auto& sptr : tm.maximal_simplices()) st.insert_simplex_and_subfaces(*sptr);
+  Persistent_cohomology pcoh(st, true);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  std::vector<int> betti;
+  for (int dim = 0; dim <= 3; ++dim) betti.push_back(pcoh.betti_number(dim));
+  return betti;
+}
+
+BOOST_AUTO_TEST_CASE(strong_collapse_cone) {
+  // A hexagon, coned from the vertex 0, collapses to a point
+  Gudhi::Toplex_map tm;
+  for (Vertex i = 1; i <= 6; ++i) tm.insert_simplex(std::vector<Vertex>{0, i, i % 6 + 1});
+  auto report = Gudhi::collapse::strong_collapse(tm);
+  BOOST_CHECK(report.num_vertices_before == 7);
+  BOOST_CHECK(report.num_maximal_simplices_before == 6);
+  BOOST_CHECK(report.num_vertices_after == 1);
+  BOOST_CHECK(report.num_maximal_simplices_after == 1);
+  BOOST_CHECK(report.collapsed_vertices.size() == 6);
+  BOOST_CHECK(tm.num_vertices() == 1);
+  BOOST_CHECK(tm.num_maximal_simplices() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(strong_collapse_sphere) {
+  // The boundary of an octahedron has no dominated vertex, but the triangle glued on it collapses on the edge
+  Gudhi::Toplex_map tm;
+  for (Vertex a : {0, 1})
+    for (Vertex b : {2, 3})
+      for (Vertex c : {4, 5}) tm.insert_simplex(std::vector<Vertex>{a, b, c});
+  std::set<Simplex> octahedron = maximal_simplices(tm);
+  tm.insert_simplex(std::vector<Vertex>{0, 2, 6});
+  auto report = Gudhi::collapse::strong_collapse(tm);
+  BOOST_CHECK(report.num_vertices_after == 6);
+  BOOST_CHECK(report.num_maximal_simplices_after == 8);
+  BOOST_CHECK(report.collapsed_vertices.size() == 1);
+  BOOST_CHECK(report.collapsed_vertices[0].first == 6);
+  BOOST_CHECK(maximal_simplices(tm) == octahedron);
+}
+
+BOOST_AUTO_TEST_CASE(strong_collapse_random_complexes) {
+  std::mt19937 gen(17);
+  for (int n_vertices : {8, 15, 40}) {
+    std::uniform_int_distribution<Vertex> vertex(0, n_vertices - 1);
+    std::uniform_int_distribution<int> dimension(0, 3);
+    for (int test = 0; test < 10; ++test) {
+      Gudhi::Toplex_map tm;
+      for (int i = 0; i < 2 * n_vertices; ++i) {
+        Simplex simplex;
+        for (int d = dimension(gen); d >= 0; --d) simplex.insert(vertex(gen));
+        tm.insert_simplex(simplex);
+      }
+      Gudhi::Toplex_map expected(tm);
+      std::vector<int> betti = betti_numbers(tm);
+
+      auto report = Gudhi::collapse::strong_collapse(tm);
+      BOOST_CHECK(report.num_vertices_after == tm.num_vertices());
+      BOOST_CHECK(report.num_maximal_simplices_after == tm.num_maximal_simplices());
+      BOOST_CHECK(report.num_vertices_before == report.num_vertices_after + report.collapsed_vertices.size());
+      // Same as removing the collapsed vertices one by one, with the same homology, and nothing left to collapse
+      for (const auto& collapsed : report.collapsed_vertices) expected.remove_vertex(collapsed.first);
+      BOOST_CHECK(maximal_simplices(tm) == maximal_simplices(expected));
+      BOOST_CHECK(betti_numbers(tm) == betti);
+      BOOST_CHECK(Gudhi::collapse::strong_collapse(tm).collapsed_vertices.empty());
+    }
+  }
+}
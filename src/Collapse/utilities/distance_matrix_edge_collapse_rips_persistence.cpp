@@ -8,22 +8,17 @@
  *      - YYYY/MM Author: Description of the modification
  */
 
-#include <gudhi/Flag_complex_edge_collapser.h>
+#include <gudhi/Collapsed_rips_complex.h>
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/Persistent_cohomology.h>
 #include <gudhi/reader_utils.h>
-#include <gudhi/graph_simplicial_complex.h>
 
 #include <boost/program_options.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 
 using Simplex_tree = Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_persistence>;
 using Filtration_value = Simplex_tree::Filtration_value;
 using Vertex_handle = Simplex_tree::Vertex_handle;
 
-using Filtered_edge = std::tuple<Vertex_handle, Vertex_handle, Filtration_value>;
-using Proximity_graph = Gudhi::Proximity_graph<Simplex_tree>;
-
 using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
 using Persistent_cohomology = Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree, Field_Zp>;
 using Distance_matrix = std::vector<std::vector<Filtration_value>>;
@@ -47,37 +42,13 @@ int main(int argc, char* argv[]) {
   Distance_matrix distances = Gudhi::read_lower_triangular_matrix_from_csv_file<Filtration_value>(csv_matrix_file);
   std::cout << "Read the distance matrix successfully, of size: " << distances.size() << std::endl;
 
-  Proximity_graph proximity_graph = Gudhi::compute_proximity_graph<Simplex_tree>(boost::irange((size_t)0,
-                                                                                               distances.size()),
-                                                                                 threshold,
-                                                                                 [&distances](size_t i, size_t j) {
-                                                                                   return distances[j][i];
-                                                                                 });
-
-  auto edges_from_graph = boost::adaptors::transform(edges(proximity_graph), [&](auto&&edge){
-        return std::make_tuple(source(edge, proximity_graph),
-                               target(edge, proximity_graph),
-                               get(Gudhi::edge_filtration_t(), proximity_graph, edge));
-      });
-  std::vector<Filtered_edge> edges_list(edges_from_graph.begin(), edges_from_graph.end());
-  std::vector<Filtered_edge> remaining_edges;
-  for (int iter = 0; iter < edge_collapse_iter_nb; iter++) {
-    auto remaining_edges = Gudhi::collapse::flag_complex_collapse_edges(edges_list);
-    edges_list = std::move(remaining_edges);
-    remaining_edges.clear();
-  }
-
   Simplex_tree stree;
-  for (Vertex_handle vertex = 0; static_cast<std::size_t>(vertex) < distances.size(); vertex++) {
-    // insert the vertex with a 0. filtration value just like a Rips
-    stree.insert_simplex({vertex}, 0.);
-  }
-  for (auto filtered_edge : edges_list) {
-    stree.insert_simplex({std::get<0>(filtered_edge), std::get<1>(filtered_edge)}, std::get<2>(filtered_edge));
-  }
-
-  stree.expansion(dim_max);
+  auto stats = Gudhi::collapse::collapsed_rips_complex_from_distance_matrix(stree, distances, threshold, dim_max,
+                                                                            edge_collapse_iter_nb);
 
+  std::cout << "Edges: " << stats.num_edges << " before collapse, " << stats.num_collapsed_edges << " after.\n";
+  std::cout << "Time: " << stats.edges_time << "s (edges), " << stats.collapse_time << "s (collapse), "
+            << stats.insertion_time << "s (insertion), " << stats.expansion_time << "s (expansion).\n";
   std::cout << "The complex contains " << stree.num_simplices() << " simplices  after collapse. \n";
   std::cout << "   and has dimension " << stree.dimension() << " \n";
 
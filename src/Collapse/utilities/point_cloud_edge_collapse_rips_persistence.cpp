@@ -8,15 +8,13 @@
  *      - YYYY/MM Author: Description of the modification
  */
 
-#include <gudhi/Flag_complex_edge_collapser.h>
+#include <gudhi/Collapsed_rips_complex.h>
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/Persistent_cohomology.h>
 #include <gudhi/distance_functions.h>
 #include <gudhi/Points_off_io.h>
-#include <gudhi/graph_simplicial_complex.h>
 
 #include <boost/program_options.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 
 #include<utility>  // for std::pair
 #include<vector>
@@ -30,9 +28,6 @@ using Vertex_handle = Simplex_tree::Vertex_handle;
 using Point = std::vector<Filtration_value>;
 using Vector_of_points = std::vector<Point>;
 
-using Filtered_edge = std::tuple<Vertex_handle, Vertex_handle, Filtration_value>;
-using Proximity_graph = Gudhi::Proximity_graph<Simplex_tree>;
-
 using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
 using Persistent_cohomology = Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree, Field_Zp>;
 
@@ -72,41 +67,17 @@ int main(int argc, char* argv[]) {
   std::cout << "Successfully read " << point_vector.size() << " point_vector.\n";
   std::cout << "Ambient dimension is " << point_vector[0].size() << ".\n";
 
-  Proximity_graph proximity_graph = Gudhi::compute_proximity_graph<Simplex_tree>(point_vector,
-                                                                                 threshold,
-                                                                                 Gudhi::Euclidean_distance());
-
-  if (num_edges(proximity_graph) <= 0) {
+  Simplex_tree stree;
+  auto stats = Gudhi::collapse::collapsed_rips_complex(stree, point_vector, threshold, dim_max,
+                                                       Gudhi::Euclidean_distance(), edge_collapse_iter_nb);
+  if (stats.num_edges <= 0) {
     std::cerr << "Total number of edges is zero." << std::endl;
     exit(-1);
   }
 
-  auto edges_from_graph = boost::adaptors::transform(edges(proximity_graph), [&](auto&&edge){
-        return std::make_tuple(source(edge, proximity_graph),
-                               target(edge, proximity_graph),
-                               get(Gudhi::edge_filtration_t(), proximity_graph, edge));
-      });
-  std::vector<Filtered_edge> edges_list(edges_from_graph.begin(), edges_from_graph.end());
-  
-  std::vector<Filtered_edge> remaining_edges;
-  for (int iter = 0; iter < edge_collapse_iter_nb; iter++) {
-    auto remaining_edges = Gudhi::collapse::flag_complex_collapse_edges(edges_list);
-    edges_list = std::move(remaining_edges);
-    remaining_edges.clear();
-  }
-
-  Simplex_tree stree;
-  for (Vertex_handle vertex = 0; static_cast<std::size_t>(vertex) < point_vector.size(); vertex++) {
-    // insert the vertex with a 0. filtration value just like a Rips
-    stree.insert_simplex({vertex}, 0.);
-  }
-
-  for (auto filtered_edge : edges_list) {
-    stree.insert_simplex({std::get<0>(filtered_edge), std::get<1>(filtered_edge)}, std::get<2>(filtered_edge));
-  }
-
-  stree.expansion(dim_max);
-  
+  std::cout << "Edges: " << stats.num_edges << " before collapse, " << stats.num_collapsed_edges << " after.\n";
+  std::cout << "Time: " << stats.edges_time << "s (edges), " << stats.collapse_time << "s (collapse), "
+            << stats.insertion_time << "s (insertion), " << stats.expansion_time << "s (expansion).\n";
   std::cout << "The complex contains " << stree.num_simplices() << " simplices  after collapse. \n";
   std::cout << "   and has dimension " << stree.dimension() << " \n";
 
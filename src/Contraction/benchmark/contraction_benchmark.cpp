@@ -0,0 +1,77 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/Edge_contraction.h>
+#include <gudhi/Skeleton_blocker.h>
+#include <gudhi/Off_reader.h>
+#include <gudhi/Point.h>
+#include <gudhi/Clock.h>
+
+#include <iostream>
+#include <cstdlib>  // for atof
+
+struct Geometry_trait {
+  typedef Point_d Point;
+};
+
+using Complex_geometric_traits = Gudhi::skeleton_blocker::Skeleton_blocker_simple_geometric_traits<Geometry_trait>;
+using Complex = Gudhi::skeleton_blocker::Skeleton_blocker_geometric_complex< Complex_geometric_traits >;
+using Profile = Gudhi::contraction::Edge_profile<Complex>;
+using Complex_contractor = Gudhi::contraction::Skeleton_blocker_contractor<Complex>;
+
+void build_rips(Complex& complex, double offset) {
+  auto vertices = complex.vertex_range();
+  for (auto p = vertices.begin(); p != vertices.end(); ++p)
+    for (auto q = p; ++q != vertices.end(); /**/)
+      if (squared_dist(complex.point(*p), complex.point(*q)) < 4 * offset * offset)
+        complex.add_edge_without_blockers(*p, *q);
+}
+
+int main(int argc, char *argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage " << argv[0] << " ../../data/points/tore3D_1307.off 0.2 to measure the number of edge " <<
+        "contractions per second on the Rips complex of parameter 0.2 of the points of tore3D_1307.off.\n";
+    return EXIT_FAILURE;
+  }
+
+  Complex complex;
+  Gudhi::skeleton_blocker::Skeleton_blocker_off_reader<Complex> off_reader(argv[1], complex, true);
+  if (!off_reader.is_valid()) {
+    std::cerr << "Unable to read file:" << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  build_rips(complex, atof(argv[2]));
+  const std::size_t initial_num_vertices = complex.num_vertices();
+  std::clog << "Initial complex has " << initial_num_vertices << " vertices and " << complex.num_edges() << " edges"
+            << std::endl;
+
+  Gudhi::Clock collect_chrono("Time to collect the edges");
+  Complex_contractor contractor(complex,
+                                new Gudhi::contraction::Edge_length_cost<Profile>,
+                                Gudhi::contraction::make_first_vertex_placement<Profile>(),
+                                Gudhi::contraction::make_link_valid_contraction<Profile>(),
+                                Gudhi::contraction::make_remove_popable_blockers_visitor<Profile>());
+  collect_chrono.end();
+  std::clog << collect_chrono;
+
+  Gudhi::Clock contraction_chrono("Time to contract the edges");
+  contractor.contract_edges();
+  contraction_chrono.end();
+  std::clog << contraction_chrono;
+
+  // Each contraction removes one vertex
+  const std::size_t num_contractions = initial_num_vertices - complex.num_vertices();
+  std::clog << "Final complex has " << complex.num_vertices() << " vertices, " << complex.num_edges() << " edges and "
+            << complex.num_blockers() << " blockers" << std::endl;
+  std::clog << num_contractions << " contractions, " << num_contractions / contraction_chrono.num_seconds()
+            << " contractions per second" << std::endl;
+
+  return EXIT_SUCCESS;
+}
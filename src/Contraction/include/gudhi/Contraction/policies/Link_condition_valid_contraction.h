@@ -35,6 +35,10 @@ class Link_condition_valid_contraction : public Valid_contraction_policy<EdgePro
     DBGMSG("Link_condition_valid_contraction:", profile.complex().link_condition(edge));
     return profile.complex().link_condition(edge);
   }
+
+  bool depends_only_on_blockers() const override {
+    return true;
+  }
 };
 
 }  // namespace contraction
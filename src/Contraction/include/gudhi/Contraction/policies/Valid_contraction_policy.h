@@ -28,6 +28,12 @@ class Valid_contraction_policy {
 
   virtual bool operator()(const EdgeProfile& profile, const boost::optional<Point>& placement) const = 0;
 
+  /**
+   * Returns true if the result only changes when a blocker through the edge is added or removed, which allows the
+   * contractor to cache it.
+   */
+  virtual bool depends_only_on_blockers() const { return false; }
+
   virtual ~Valid_contraction_policy() { }
 };
 
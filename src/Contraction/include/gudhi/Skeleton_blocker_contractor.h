@@ -186,7 +186,7 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
 
   class Edge_data {
    public:
-    Edge_data() : PQHandle_(), cost_() { }
+    Edge_data() : PQHandle_(), cost_(), valid_(), stamp_(0), position_(0) { }
 
     Cost_type const& cost() const {
       return cost_;
@@ -212,9 +212,31 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
       PQHandle_ = false;
     }
 
+    // Cached result of the valid contraction policy, when it only depends on the blockers through the edge
+    boost::optional<bool> const& valid() const {
+      return valid_;
+    }
+
+    boost::optional<bool> & valid() {
+      return valid_;
+    }
+
+    // Last batch of updates in which the edge was queued, to update it only once per batch
+    std::size_t& stamp() {
+      return stamp_;
+    }
+
+    // Position of the edge in this batch
+    std::size_t& position() {
+      return position_;
+    }
+
    private:
     pq_handle PQHandle_;
     Cost_type cost_;
+    boost::optional<bool> valid_;
+    std::size_t stamp_;
+    std::size_t position_;
   };
   typedef Edge_data* Edge_data_ptr;
   typedef boost::scoped_array<Edge_data> Edge_data_array;
@@ -313,9 +335,13 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
     return (*placement_policy_)(profile);
   }
 
-  bool is_contraction_valid(Profile const& profile, Placement_type placement) const {
+  bool is_contraction_valid(Profile const& profile, Placement_type placement) {
     if (!valid_contraction_policy_) return true;
-    return (*valid_contraction_policy_)(profile, placement);
+    if (!valid_contraction_policy_->depends_only_on_blockers())
+      return (*valid_contraction_policy_)(profile, placement);
+    Edge_data& data = get_data(profile.edge_handle());
+    if (!data.valid()) data.valid() = (*valid_contraction_policy_)(profile, placement);
+    return *data.valid();
   }
 
 
@@ -331,6 +357,8 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
   void contract_edges(int num_max_contractions = -1) {
     DBG("\n\nContract edges");
     int num_contraction = 0;
+    // Blockers may have been removed since the last call
+    update_changed_edges();
 
     bool unspecified_num_contractions = (num_max_contractions == -1);
     //
@@ -352,7 +380,7 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
           break;
         }
         Placement_type placement = get_placement(profile);
-        if (is_contraction_valid(profile, placement) && placement) {
+        if (placement && is_contraction_valid(profile, placement)) {
           DBG("contraction_valid");
           contract_edge(profile, placement);
           ++num_contraction;
@@ -467,21 +495,45 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
 
     // the visitor could do something as complex_.remove_popable_blockers();
     if (contraction_visitor_) contraction_visitor_->on_contracted(profile, placement);
+    update_changed_edges();
   }
 
  private:
-  // every time the visitor's method on_changed_edge is called, it adds an
-  // edge to changed_edges_
-  std::vector< Edge_handle > changed_edges_;
+  // An edge to update, stored by its vertices since it may be removed before
+  // the update. The order of the vertices gives the orientation of the
+  // Edge_handle, and thus the vertex kept by the contraction.
+  struct Changed_edge {
+    Vertex_handle a, b;
+    // Whether the edge changed (on_changed_edge), or only a blocker through
+    // the edge was removed (on_delete_blocker)
+    bool changed;
+  };
+
+  // every time the visitor's method on_changed_edge or on_delete_blocker is
+  // called, it adds an edge to changed_edges_, or updates it if it is
+  // already there.
+  std::vector< Changed_edge > changed_edges_;
+  std::size_t current_stamp_ = 1;
+
+  void add_changed_edge(Vertex_handle a, Vertex_handle b, bool changed) {
+    boost::optional<Edge_handle> ab(complex_[std::make_pair(a, b)]);
+    assert(ab);
+    Edge_data& data = get_data(*ab);
+    if (data.stamp() != current_stamp_) {
+      data.stamp() = current_stamp_;
+      data.position() = changed_edges_.size();
+      changed_edges_.push_back({a, b, changed});
+    } else if (changed) {
+      changed_edges_[data.position()] = {a, b, changed};
+    }
+  }
 
   /**
    * @brief we update the cost and the position in the heap of an edge that has
    * been changed
    */
   inline void on_changed_edge(Vertex_handle a, Vertex_handle b) override {
-    boost::optional<Edge_handle> ab(complex_[std::make_pair(a, b)]);
-    assert(ab);
-    changed_edges_.push_back(*ab);
+    add_changed_edge(a, b, true);
   }
 
   void update_changed_edges() {
@@ -489,20 +541,32 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
     DBG("update edges");
 
     // sequential loop
-    for (auto ab : changed_edges_) {
-      // 1-get the Edge_handle corresponding to ab
+    for (auto const& edge : changed_edges_) {
+      // 1-get the Edge_handle corresponding to ab, if it is still there
       // 2-change the data in mEdgeArray[ab.id()]
       // 3-update the heap
-      Edge_data& data = get_data(ab);
-      Profile const& profile = create_profile(ab);
+      boost::optional<Edge_handle> ab(complex_[std::make_pair(edge.a, edge.b)]);
+      if (!ab) continue;
+      Edge_data& data = get_data(*ab);
+      // If only a blocker was removed and the edge is already in the heap
+      // its priority has not changed.
+      if (!edge.changed && data.is_in_PQ()) continue;
+      if (data.valid() && !*data.valid()) {
+        // The contraction stays invalid until a blocker through the edge is
+        // removed, which queues the edge again
+        if (data.is_in_PQ()) remove_from_PQ(*ab, data);
+        continue;
+      }
+      Profile const& profile = create_profile(*ab);
       data.cost() = get_cost(profile);
       if (data.is_in_PQ()) {
-        update_in_PQ(ab, data);
+        update_in_PQ(*ab, data);
       } else {
-        insert_in_PQ(ab, data);
+        insert_in_PQ(*ab, data);
       }
     }
     changed_edges_.clear();
+    ++current_stamp_;
   }
 
 
@@ -527,6 +591,25 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
     boost::optional<Edge_handle> bx(complex_[std::make_pair(b, x)]);
     assert(ax && bx);
     complex_[*ax].index() = complex_[*bx].index();
+    // ax has other blockers than bx, and must be queued even if bx already is
+    Edge_data& data = get_data(*ax);
+    data.valid() = boost::none;
+    data.stamp() = 0;
+  }
+
+ private:
+  /**
+   * @brief Called when a blocker is added.
+   * The edges that pass through the blocker may not be contractible anymore.
+   */
+  void on_add_blocker(const Simplex& blocker) override {
+    for (auto x = blocker.begin(); x != blocker.end(); ++x) {
+      for (auto y = x; ++y != blocker.end();) {
+        auto edge_descr(complex_[std::make_pair(*x, *y)]);
+        assert(edge_descr);
+        get_data(*edge_descr).valid() = boost::none;
+      }
+    }
   }
 
  private:
@@ -542,23 +625,14 @@ typename GeometricSimplifiableComplex::Vertex_handle> {
 
     // todo uniqument utile pour la link condition
     // laisser a l'utilisateur ? boolean update_heap_on_removed_blocker?
-    Simplex blocker_copy(*blocker);
-    for (auto x = blocker_copy.begin(); x != blocker_copy.end(); ++x) {
-      for (auto y = x; ++y != blocker_copy.end();) {
+    // The edges are queued and updated once after the contraction, even if
+    // they pass through several removed blockers
+    for (auto x = blocker->begin(); x != blocker->end(); ++x) {
+      for (auto y = x; ++y != blocker->end();) {
         auto edge_descr(complex_[std::make_pair(*x, *y)]);
         assert(edge_descr);
-        Edge_data& data = get_data(*edge_descr);
-        Profile const& profile = create_profile(*edge_descr);
-        data.cost() = get_cost(profile);
-
-        // If the edge is already in the heap
-        // its priority has not changed.
-        // If the edge is not present, we reinsert it
-        // remark : we could also reinsert the edge
-        // only if it is valid
-        if (!data.is_in_PQ()) {
-          insert_in_PQ(*edge_descr, data);
-        }
+        get_data(*edge_descr).valid() = boost::none;
+        add_changed_edge(*x, *y, false);
       }
     }
   }
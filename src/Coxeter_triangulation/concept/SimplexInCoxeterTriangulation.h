@@ -72,8 +72,16 @@ struct SimplexInCoxeterTriangulation {
 
   /** \brief Returns true, if the simplex is a face of other simplex. */
   bool is_face_of(const Permutahedral_representation& other) const;
+
+  /** \brief Equality operator. */
+  bool operator==(const Permutahedral_representation& other) const;
 };
 
+/** \brief Hash value of a simplex, consistent with its equality operator.
+ *  Makes the simplices usable with boost::hash, for example in Manifold_tracing.
+ */
+std::size_t hash_value(const SimplexInCoxeterTriangulation& simplex);
+
 }  // namespace coxeter_triangulation
 
 }  // namespace Gudhi
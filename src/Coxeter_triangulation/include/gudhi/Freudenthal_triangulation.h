@@ -5,6 +5,7 @@
  *    Copyright (C) 2019 Inria
  *
  *    Modification(s):
+ *      - 2023/10 David Loiseaux: Batched point location.
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -16,10 +17,15 @@
 #include <cmath>      // for std::floor
 #include <numeric>    // for std::iota
 #include <cstdlib>    // for std::size_t
+#include <stdexcept>  // for std::invalid_argument
 
 #include <Eigen/Eigenvalues>
 #include <Eigen/SVD>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
 #include <gudhi/Permutahedral_representation.h>
 #include <gudhi/Debug_utils.h>  // for GUDHI_CHECK
 
@@ -133,43 +139,50 @@ class Freudenthal_triangulation {
    */
   template <class Point_d>
   Simplex_handle locate_point(const Point_d& point, double scale = 1) const {
-    using Ordered_set_partition = typename Simplex_handle::OrderedSetPartition;
-    using Part = typename Ordered_set_partition::value_type;
     unsigned d = point.size();
     GUDHI_CHECK(d == dimension_,
                 std::invalid_argument("The point must be of the same dimension as the triangulation"));
-    double error = 1e-9;
-    Simplex_handle output;
-    std::vector<double> z;
+    Vector x(d);
     if (is_freudenthal_) {
-      for (std::size_t i = 0; i < d; i++) {
-        double x_i = scale * point[i];
-        int y_i = std::floor(x_i);
-        output.vertex().push_back(y_i);
-        z.push_back(x_i - y_i);
-      }
+      for (std::size_t i = 0; i < d; i++) x(i) = scale * point[i];
     } else {
-      Eigen::VectorXd p_vect(d);
+      Vector p_vect(d);
       for (std::size_t i = 0; i < d; i++) p_vect(i) = point[i];
-      Eigen::VectorXd x_vect = colpivhouseholderqr_.solve(p_vect - offset_);
-      for (std::size_t i = 0; i < d; i++) {
-        double x_i = scale * x_vect(i);
-        int y_i = std::floor(x_i);
-        output.vertex().push_back(y_i);
-        z.push_back(x_i - y_i);
-      }
+      x = scale * colpivhouseholderqr_.solve(p_vect - offset_);
     }
-    z.push_back(0);
-    Part indices(d + 1);
-    std::iota(indices.begin(), indices.end(), 0);
-    std::sort(indices.begin(), indices.end(), [&z](std::size_t i1, std::size_t i2) { return z[i1] > z[i2]; });
+    return locate_in_freudenthal(x.data(), d);
+  }
 
-    output.partition().push_back(Part(1, indices[0]));
-    for (std::size_t i = 1; i <= d; ++i)
-      if (z[indices[i - 1]] > z[indices[i]] + error)
-        output.partition().push_back(Part(1, indices[i]));
-      else
-        output.partition().back().push_back(indices[i]);
+  /** \brief Returns the permutahedral representations of the simplices in the
+   *  triangulation that contain the columns of a given matrix.
+   * \details The result is the same as calling `locate_point()` on each column,
+   * but the affine transformation is inverted once for all the points, as a single
+   * solve with the matrix of all the points as right-hand side, and the simplices
+   * are computed in parallel when TBB is available.
+   * The simplices are in the order of the columns.
+   *
+   * @param[in] points The query points, one per column, contiguous in memory.
+   * @param[in] scale The scale of the triangulation.
+   *
+   * @exception std::invalid_argument In debug mode, if the number of rows is different from the triangulation
+   * dimension.
+   */
+  std::vector<Simplex_handle> locate_points(const Matrix& points, double scale = 1) const {
+    GUDHI_CHECK(points.rows() == dimension_,
+                std::invalid_argument("The points must be of the same dimension as the triangulation"));
+    const unsigned d = points.rows();
+    Matrix x;
+    if (is_freudenthal_)
+      x = scale * points;
+    else
+      x = scale * colpivhouseholderqr_.solve(points.colwise() - offset_);
+    std::vector<Simplex_handle> output(points.cols());
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(Eigen::Index(0), x.cols(),
+                      [&](Eigen::Index j) { output[j] = locate_in_freudenthal(x.col(j).data(), d); });
+#else
+    for (Eigen::Index j = 0; j < x.cols(); ++j) output[j] = locate_in_freudenthal(x.col(j).data(), d);
+#endif
     return output;
   }
 
@@ -204,6 +217,35 @@ class Freudenthal_triangulation {
     return (1. / (simplex.dimension() + 1)) * res_vector;
   }
 
+ private:
+  // The minimal simplex of the Freudenthal-Kuhn triangulation that contains the point of coordinates x[0], ..., x[d-1]
+  Simplex_handle locate_in_freudenthal(const double* x, unsigned d) const {
+    using Ordered_set_partition = typename Simplex_handle::OrderedSetPartition;
+    using Part = typename Ordered_set_partition::value_type;
+    double error = 1e-9;
+    Simplex_handle output;
+    output.vertex().reserve(d);
+    std::vector<double> z;
+    z.reserve(d + 1);
+    for (std::size_t i = 0; i < d; i++) {
+      int y_i = std::floor(x[i]);
+      output.vertex().push_back(y_i);
+      z.push_back(x[i] - y_i);
+    }
+    z.push_back(0);
+    Part indices(d + 1);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::sort(indices.begin(), indices.end(), [&z](std::size_t i1, std::size_t i2) { return z[i1] > z[i2]; });
+
+    output.partition().push_back(Part(1, indices[0]));
+    for (std::size_t i = 1; i <= d; ++i)
+      if (z[indices[i - 1]] > z[indices[i]] + error)
+        output.partition().push_back(Part(1, indices[i]));
+      else
+        output.partition().back().push_back(indices[i]);
+    return output;
+  }
+
  protected:
   unsigned dimension_;
   Matrix matrix_;
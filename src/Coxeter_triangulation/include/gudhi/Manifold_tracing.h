@@ -18,8 +18,14 @@
 
 #include <Eigen/Dense>
 
-#include <queue>
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <cstddef>
+#include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace Gudhi {
 
@@ -43,9 +49,7 @@ class Manifold_tracing {
   struct Simplex_hash {
     typedef Simplex_handle argument_type;
     typedef std::size_t result_type;
-    result_type operator()(const argument_type& s) const noexcept {
-      return boost::hash<typename Simplex_handle::Vertex>()(s.vertex());
-    }
+    result_type operator()(const argument_type& s) const noexcept { return boost::hash<Simplex_handle>()(s); }
   };
 
  public:
@@ -80,7 +84,7 @@ class Manifold_tracing {
   void manifold_tracing_algorithm(const Point_range& seed_points, const Triangulation_& triangulation,
                                   const Intersection_oracle& oracle, Out_simplex_map& out_simplex_map) {
     std::size_t cod_d = oracle.cod_d();
-    std::queue<Simplex_handle> queue;
+    std::vector<Simplex_handle> frontier;
 
     for (const auto& p : seed_points) {
       Simplex_handle full_simplex = triangulation.locate_point(p);
@@ -90,22 +94,13 @@ class Manifold_tracing {
 #ifdef DEBUG_TRACES
           mt_seed_inserted_list.push_back(MT_inserted_info(qr, face, false));
 #endif
-          queue.emplace(face);
+          frontier.emplace_back(face);
           break;
         }
       }
     }
 
-    while (!queue.empty()) {
-      Simplex_handle s = queue.front();
-      queue.pop();
-      for (auto cof : s.coface_range(cod_d + 1)) {
-        for (auto face : cof.face_range(cod_d)) {
-          Query_result<Simplex_handle> qr = oracle.intersects(face, triangulation);
-          if (qr.success && out_simplex_map.emplace(face, qr.intersection).second) queue.emplace(face);
-        }
-      }
-    }
+    trace_from_frontier<false>(frontier, triangulation, oracle, out_simplex_map, out_simplex_map);
   }
 
   /**
@@ -137,7 +132,7 @@ class Manifold_tracing {
                                   const Intersection_oracle& oracle, Out_simplex_map& interior_simplex_map,
                                   Out_simplex_map& boundary_simplex_map) {
     std::size_t cod_d = oracle.cod_d();
-    std::queue<Simplex_handle> queue;
+    std::vector<Simplex_handle> frontier;
 
     for (const auto& p : seed_points) {
       Simplex_handle full_simplex = triangulation.locate_point(p);
@@ -148,7 +143,7 @@ class Manifold_tracing {
 #endif
         if (qr.success) {
           if (oracle.lies_in_domain(qr.intersection, triangulation)) {
-            if (interior_simplex_map.emplace(face, qr.intersection).second) queue.emplace(face);
+            if (interior_simplex_map.emplace(face, qr.intersection).second) frontier.emplace_back(face);
           } else {
             for (Simplex_handle cof : face.coface_range(cod_d + 1)) {
               auto qrb = oracle.intersects_boundary(cof, triangulation);
@@ -163,33 +158,108 @@ class Manifold_tracing {
       }
     }
 
-    while (!queue.empty()) {
-      Simplex_handle s = queue.front();
-      queue.pop();
-      for (auto cof : s.coface_range(cod_d + 1)) {
-        for (auto face : cof.face_range(cod_d)) {
-          auto qr = oracle.intersects(face, triangulation);
-#ifdef DEBUG_TRACES
-          mt_inserted_list.push_back(MT_inserted_info(qr, face, false));
+    trace_from_frontier<true>(frontier, triangulation, oracle, interior_simplex_map, boundary_simplex_map);
+  }
+
+  /** \brief Empty constructor */
+  Manifold_tracing() {}
+
+ private:
+  enum class Face_status { outside, interior, exterior };
+  typedef std::unordered_map<Simplex_handle, Face_status, Simplex_hash> Face_status_map;
+  typedef std::unordered_set<Simplex_handle, Simplex_hash> Visited_set;
+
+  // Calls f(i) for all i in [0, n), in parallel if TBB is available.
+  template <class Function>
+  static void for_each_index(std::size_t n, const Function& f) {
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), n, f);
+#else
+    for (std::size_t i = 0; i < n; ++i) f(i);
 #endif
-          if (qr.success) {
-            if (oracle.lies_in_domain(qr.intersection, triangulation)) {
-              if (interior_simplex_map.emplace(face, qr.intersection).second) queue.emplace(face);
-            } else {
-              auto qrb = oracle.intersects_boundary(cof, triangulation);
+  }
+
+  /* Propagation from the simplices in frontier, one layer at a time. The cofaces of the layer and their faces are
+   * enumerated in parallel, the faces that were never queried are then all sent to the oracle in parallel, and the
+   * maps are only updated sequentially between these steps. Each coface and each face is handled at most once, and
+   * since the oracle answers do not depend on the order of the queries, the output is the same as a sequential
+   * breadth-first search. */
+  template <bool with_boundary, class Intersection_oracle>
+  void trace_from_frontier(std::vector<Simplex_handle> frontier, const Triangulation_& triangulation,
+                           const Intersection_oracle& oracle, Out_simplex_map& interior_simplex_map,
+                           Out_simplex_map& boundary_simplex_map) {
+    std::size_t cod_d = oracle.cod_d();
+    Visited_set visited_cofaces;
+    Face_status_map face_status;
+    std::vector<std::vector<Simplex_handle>> cofaces_of_frontier, faces_of_cofaces;
+    std::vector<Simplex_handle> cofaces, faces, boundary_candidates;
+    std::vector<Query_result<Simplex_handle>> results;
+    std::vector<char> in_domain;
+
+    while (!frontier.empty()) {
+      cofaces_of_frontier.assign(frontier.size(), {});
+      for_each_index(frontier.size(), [&](std::size_t i) {
+        for (auto cof : frontier[i].coface_range(cod_d + 1)) cofaces_of_frontier[i].emplace_back(cof);
+      });
+      cofaces.clear();
+      for (auto& range : cofaces_of_frontier)
+        for (auto& cof : range)
+          if (visited_cofaces.insert(cof).second) cofaces.emplace_back(std::move(cof));
+
+      faces_of_cofaces.assign(cofaces.size(), {});
+      for_each_index(cofaces.size(), [&](std::size_t i) {
+        for (auto face : cofaces[i].face_range(cod_d)) faces_of_cofaces[i].emplace_back(face);
+      });
+      faces.clear();
+      for (const auto& range : faces_of_cofaces)
+        for (const auto& face : range)
+          if (face_status.emplace(face, Face_status::outside).second) faces.emplace_back(face);
+
+      results.resize(faces.size());
+      in_domain.assign(faces.size(), true);
+      for_each_index(faces.size(), [&](std::size_t i) {
+        results[i] = oracle.intersects(faces[i], triangulation);
+        if constexpr (with_boundary) {
+          if (results[i].success) in_domain[i] = oracle.lies_in_domain(results[i].intersection, triangulation);
+        }
+      });
+
+      frontier.clear();
+      for (std::size_t i = 0; i < faces.size(); ++i) {
 #ifdef DEBUG_TRACES
-              mt_inserted_list.push_back(MT_inserted_info(qrb, cof, true));
+        if constexpr (with_boundary) mt_inserted_list.push_back(MT_inserted_info(results[i], faces[i], false));
 #endif
-              if (qrb.success) boundary_simplex_map.emplace(cof, qrb.intersection);
+        if (!results[i].success) continue;
+        if (!in_domain[i]) {
+          face_status[faces[i]] = Face_status::exterior;
+          continue;
+        }
+        face_status[faces[i]] = Face_status::interior;
+        if (interior_simplex_map.emplace(faces[i], std::move(results[i].intersection)).second)
+          frontier.emplace_back(faces[i]);
+      }
+
+      if constexpr (with_boundary) {
+        boundary_candidates.clear();
+        for (std::size_t i = 0; i < cofaces.size(); ++i)
+          for (const auto& face : faces_of_cofaces[i])
+            if (face_status[face] == Face_status::exterior) {
+              boundary_candidates.emplace_back(cofaces[i]);
+              break;
             }
-          }
+        results.resize(boundary_candidates.size());
+        for_each_index(boundary_candidates.size(), [&](std::size_t i) {
+          results[i] = oracle.intersects_boundary(boundary_candidates[i], triangulation);
+        });
+        for (std::size_t i = 0; i < boundary_candidates.size(); ++i) {
+#ifdef DEBUG_TRACES
+          mt_inserted_list.push_back(MT_inserted_info(results[i], boundary_candidates[i], true));
+#endif
+          if (results[i].success) boundary_simplex_map.emplace(boundary_candidates[i], results[i].intersection);
         }
       }
     }
   }
-
-  /** \brief Empty constructor */
-  Manifold_tracing() {}
 };
 
 /**
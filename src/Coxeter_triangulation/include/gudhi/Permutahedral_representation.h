@@ -13,6 +13,11 @@
 
 #include <gudhi/Permutahedral_representation/Permutahedral_representation_iterators.h>
 
+#include <boost/container/static_vector.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <cstddef>
+#include <cstdint>
 #include <utility>  // for std::make_pair
 
 namespace Gudhi {
@@ -163,6 +168,33 @@ class Permutahedral_representation {
   OrderedSetPartition partition_;
 };
 
+/** \brief Hash value of a permutahedral representation, compatible with its equality operator.
+ * Makes Permutahedral_representation usable with boost::hash.
+ * \ingroup coxeter_triangulation
+ */
+template <class Vertex, class OrderedSetPartition>
+std::size_t hash_value(const Permutahedral_representation<Vertex, OrderedSetPartition>& simplex) {
+  std::size_t seed = boost::hash_range(simplex.vertex().begin(), simplex.vertex().end());
+  for (const auto& part : simplex.partition())
+    boost::hash_combine(seed, boost::hash_range(part.begin(), part.end()));
+  return seed;
+}
+
+/** \brief Permutahedral representation with a fixed capacity, for triangulations of dimension at most
+ * max_dimension.
+ * \ingroup coxeter_triangulation
+ *
+ * \details The vertex and the parts of the ordered set partition are stored inline, the parts as bytes, so that
+ * copying, comparing and hashing a simplex, as well as iterating over its faces and cofaces, never allocates memory.
+ * max_dimension must be smaller than 255.
+ * It can be used as template parameter of Coxeter_triangulation or Freudenthal_triangulation.
+ */
+template <std::size_t max_dimension>
+using Compact_permutahedral_representation = Permutahedral_representation<
+    boost::container::static_vector<int, max_dimension>,
+    boost::container::static_vector<boost::container::static_vector<std::uint8_t, max_dimension + 1>,
+                                    max_dimension + 1> >;
+
 /** \brief Print a permutahedral representation to a stream.
  * \ingroup coxeter_triangulation
  *
@@ -189,9 +221,10 @@ std::ostream& operator<<(std::ostream& os, const Permutahedral_representation<Ve
     if (p.empty()) {
       os << "}";
     }
+    // the unary + prints small integer types as numbers rather than characters
     auto p_it = p.begin();
-    os << *p_it++;
-    for (; p_it != p.end(); ++p_it) os << ", " << *p_it;
+    os << +*p_it++;
+    for (; p_it != p.end(); ++p_it) os << ", " << +*p_it;
     os << "}";
   };
   os << " [";
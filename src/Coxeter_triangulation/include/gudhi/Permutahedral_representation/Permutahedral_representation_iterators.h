@@ -112,7 +112,7 @@ class Face_iterator : public boost::iterator_facade<Face_iterator<Permutahedral_
 
   void update_value() {
     // Combination *c_it_ is supposed to be sorted in increasing order
-    value_ = face_from_indices<Permutahedral_representation>(simplex_, *c_it_);
+    face_from_indices(simplex_, *c_it_, value_);
   }
 
  public:
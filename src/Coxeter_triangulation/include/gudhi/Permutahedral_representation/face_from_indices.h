@@ -19,7 +19,8 @@ namespace Gudhi {
 namespace coxeter_triangulation {
 
 /** \brief Computes the permutahedral representation of a face of a given simplex
- *  and a range of the vertex indices that compose the face.
+ *  and a range of the vertex indices that compose the face, and stores it in value.
+ *  The storage already held by value is reused.
  *
  * \tparam Permutahedral_representation has to be Permutahedral_representation
  * \tparam Index_range is a range of unsigned integers taking values in 0,...,k,
@@ -27,19 +28,20 @@ namespace coxeter_triangulation {
  *
  * @param[in] simplex Input simplex.
  * @param[in] indices Input range of indices.
+ * @param[out] value The face.
  */
 template <class Permutahedral_representation, class Index_range>
-Permutahedral_representation face_from_indices(const Permutahedral_representation& simplex,
-                                               const Index_range& indices) {
+void face_from_indices(const Permutahedral_representation& simplex, const Index_range& indices,
+                       Permutahedral_representation& value) {
   using range_index = typename Index_range::value_type;
   using Ordered_set_partition = typename Permutahedral_representation::OrderedSetPartition;
   using Part = typename Ordered_set_partition::value_type;
   using part_index = typename Part::value_type;
-  Permutahedral_representation value;
   std::size_t d = simplex.vertex().size();
   value.vertex() = simplex.vertex();
   std::size_t k = indices.size() - 1;
   value.partition().resize(k + 1);
+  for (auto& part : value.partition()) part.clear();
   std::size_t l = simplex.partition().size() - 1;
   for (std::size_t h = 1; h < k + 1; h++)
     for (range_index i = indices[h - 1]; i < indices[h]; i++)
@@ -56,6 +58,23 @@ Permutahedral_representation face_from_indices(const Permutahedral_representatio
     }
   // sort the values in each part (probably not needed)
   for (auto& part : value.partition()) std::sort(part.begin(), part.end());
+}
+
+/** \brief Computes the permutahedral representation of a face of a given simplex
+ *  and a range of the vertex indices that compose the face.
+ *
+ * \tparam Permutahedral_representation has to be Permutahedral_representation
+ * \tparam Index_range is a range of unsigned integers taking values in 0,...,k,
+ * where k is the dimension of the simplex simplex.
+ *
+ * @param[in] simplex Input simplex.
+ * @param[in] indices Input range of indices.
+ */
+template <class Permutahedral_representation, class Index_range>
+Permutahedral_representation face_from_indices(const Permutahedral_representation& simplex,
+                                               const Index_range& indices) {
+  Permutahedral_representation value;
+  face_from_indices(simplex, indices, value);
   return value;
 }
 
@@ -98,6 +98,37 @@ BOOST_AUTO_TEST_CASE(freudenthal_triangulation) {
   BOOST_CHECK(tr.offset() == new_offset);
 }
 
+template <class Triangulation>
+void check_locate_points(const Triangulation& tr, const Eigen::MatrixXd& points, double scale) {
+  auto simplices = tr.locate_points(points, scale);
+  BOOST_CHECK(simplices.size() == static_cast<std::size_t>(points.cols()));
+  for (Eigen::Index j = 0; j < points.cols(); ++j) {
+    std::vector<double> point(points.col(j).data(), points.col(j).data() + points.rows());
+    BOOST_CHECK(simplices[j] == tr.locate_point(point, scale));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(locate_points_same_as_locate_point) {
+  Eigen::MatrixXd points = 5 * Eigen::MatrixXd::Random(3, 200);
+  // Points on faces of the Freudenthal-Kuhn triangulation
+  points.col(0) << 3, -1, 0;
+  points.col(1) << 3.5, -1.5, 0.5;
+
+  Gudhi::coxeter_triangulation::Freudenthal_triangulation<> tr(3);
+  check_locate_points(tr, points, 1);
+  check_locate_points(tr, points, 2);
+  Eigen::MatrixXd new_matrix(3, 3);
+  new_matrix << 1, 0, 0, -1, 1, 0, -1, 0, 1;
+  tr.change_matrix(new_matrix);
+  tr.change_offset(Eigen::Vector3d(1.5, 1, 0.5));
+  check_locate_points(tr, points, 1);
+
+  Gudhi::coxeter_triangulation::Coxeter_triangulation<> cox_tr(3);
+  check_locate_points(cox_tr, points, 1);
+  check_locate_points(cox_tr, points, 3);
+  check_locate_points(cox_tr, Eigen::MatrixXd(3, 0), 1);
+}
+
 #ifdef GUDHI_DEBUG
 BOOST_AUTO_TEST_CASE(freudenthal_triangulation_exceptions_in_debug_mode) {
   // Point location check
@@ -110,5 +141,6 @@ BOOST_AUTO_TEST_CASE(freudenthal_triangulation_exceptions_in_debug_mode) {
   // Point of dimension 4
   std::vector<double> point({3.5, -1.8, 0.3, 4.1});
   BOOST_CHECK_THROW (tr.locate_point(point), std::invalid_argument);
+  BOOST_CHECK_THROW (tr.locate_points(Eigen::MatrixXd::Zero(4, 2)), std::invalid_argument);
 }
 #endif
@@ -60,3 +60,24 @@ BOOST_AUTO_TEST_CASE(manifold_tracing) {
   std::clog << "boundary_simplex_map.size() = " << boundary_simplex_map.size() << "\n";
   BOOST_CHECK(boundary_simplex_map.size() == 54);
 }
+
+BOOST_AUTO_TEST_CASE(manifold_tracing_compact_representation) {
+  // same as above with simplices stored in fixed-capacity containers
+  Function_Sm_in_Rd fun_sph(5.1111, 2);
+  auto oracle = make_oracle(fun_sph);
+  using Triangulation = Coxeter_triangulation<Compact_permutahedral_representation<16> >;
+  Triangulation cox_tr(oracle.amb_d());
+
+  using MT = Manifold_tracing<Triangulation>;
+  std::vector<Eigen::VectorXd> seed_points(1, fun_sph.seed());
+  typename MT::Out_simplex_map out_simplex_map;
+  manifold_tracing_algorithm(seed_points, cox_tr, oracle, out_simplex_map);
+  BOOST_CHECK(out_simplex_map.size() == 1118);
+
+  Function_Sm_in_Rd fun_boundary(3.0, 2, fun_sph.seed());
+  auto oracle_with_boundary = make_oracle(fun_sph, fun_boundary);
+  typename MT::Out_simplex_map interior_simplex_map, boundary_simplex_map;
+  manifold_tracing_algorithm(seed_points, cox_tr, oracle_with_boundary, interior_simplex_map, boundary_simplex_map);
+  BOOST_CHECK(interior_simplex_map.size() == 96);
+  BOOST_CHECK(boundary_simplex_map.size() == 54);
+}
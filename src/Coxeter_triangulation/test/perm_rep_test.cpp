@@ -14,6 +14,10 @@
 
 #include <gudhi/Permutahedral_representation.h>
 
+#include <sstream>
+#include <string>
+#include <vector>
+
 BOOST_AUTO_TEST_CASE(permutahedral_representation) {
   typedef std::vector<int> Vertex;
   typedef std::vector<std::size_t> Part;
@@ -59,3 +63,43 @@ BOOST_AUTO_TEST_CASE(permutahedral_representation) {
   BOOST_CHECK(!s2.is_face_of(s));
   BOOST_CHECK(s.is_face_of(s2));
 }
+
+BOOST_AUTO_TEST_CASE(compact_permutahedral_representation) {
+  typedef std::vector<int> Vertex;
+  typedef std::vector<std::size_t> Part;
+  typedef std::vector<Part> Partition;
+  typedef Gudhi::coxeter_triangulation::Permutahedral_representation<Vertex, Partition> Simplex_handle;
+  typedef Gudhi::coxeter_triangulation::Compact_permutahedral_representation<16> Compact_simplex_handle;
+  Vertex v0(10, 0);
+  Partition omega = {Part({5}), Part({2}), Part({3, 7}), Part({4, 9}), Part({0, 6, 8}), Part({1, 10})};
+  Simplex_handle s(v0, omega);
+  Compact_simplex_handle cs;
+  cs.vertex().assign(v0.begin(), v0.end());
+  for (auto& part : omega) cs.partition().emplace_back(part.begin(), part.end());
+
+  auto to_string = [](const auto& simplex) {
+    std::ostringstream oss;
+    oss << simplex;
+    return oss.str();
+  };
+  BOOST_CHECK(to_string(s) == to_string(cs));
+
+  // Faces and cofaces are the same as with the default containers
+  std::vector<std::string> faces, compact_faces;
+  for (auto& f : s.face_range(3)) faces.push_back(to_string(f));
+  for (auto& f : cs.face_range(3)) compact_faces.push_back(to_string(f));
+  BOOST_CHECK(faces == compact_faces);
+  std::vector<std::string> cofacets, compact_cofacets;
+  for (auto& f : s.cofacet_range()) cofacets.push_back(to_string(f));
+  for (auto& f : cs.cofacet_range()) compact_cofacets.push_back(to_string(f));
+  BOOST_CHECK(cofacets == compact_cofacets);
+
+  // Equal simplices have equal hash values
+  boost::hash<Compact_simplex_handle> hash;
+  for (auto& f : cs.facet_range()) {
+    Compact_simplex_handle copy(f);
+    BOOST_CHECK(copy == f);
+    BOOST_CHECK(hash(copy) == hash(f));
+    BOOST_CHECK(f.is_face_of(cs));
+  }
+}
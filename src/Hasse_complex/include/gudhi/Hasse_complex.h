@@ -11,11 +11,12 @@
 #ifndef HASSE_COMPLEX_H_
 #define HASSE_COMPLEX_H_
 
-#include <gudhi/allocator.h>
-
 #include <boost/iterator/counting_iterator.hpp>
+#include <boost/range/iterator_range.hpp>
 
-#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
 #include <utility>  // for pair
 #include <vector>
 #include <limits>  // for infinity value
@@ -26,38 +27,16 @@
 
 namespace Gudhi {
 
-template < class HasseCpx >
-struct Hasse_simplex {
-  // Complex_ds must verify that cpx->key(sh) is the order of sh in the filtration
-
-  template< class Complex_ds >
-  Hasse_simplex(Complex_ds & cpx
-                , typename Complex_ds::Simplex_handle sh)
-      : filtration_(cpx.filtration(sh))
-      , boundary_() {
-    boundary_.reserve(cpx.dimension(sh) + 1);
-    for (auto b_sh : cpx.boundary_simplex_range(sh)) {
-      boundary_.push_back(cpx.key(b_sh));
-    }
-  }
-
-  Hasse_simplex(typename HasseCpx::Simplex_key key
-                , typename HasseCpx::Filtration_value fil
-                , std::vector<typename HasseCpx::Simplex_handle> const& boundary)
-      : key_(key)
-      , filtration_(fil)
-      , boundary_(boundary) { }
-
-  typename HasseCpx::Simplex_key key_;
-  typename HasseCpx::Filtration_value filtration_;
-  std::vector<typename HasseCpx::Simplex_handle> boundary_;
-};
-
 /** \private 
  * \brief Data structure representing a Hasse diagram, i.e. 
  * a complex where all codimension 1 incidence 
  * relations are explicitly encoded.
  *
+ * \details The diagram is stored in compressed sparse column format: the boundary of the simplex of index `i` is
+ * `boundaries()[boundary_offsets()[i]]`, ..., `boundaries()[boundary_offsets()[i+1]-1]`, and its filtration value is
+ * `filtrations()[i]`. These flat arrays can be saved and given back to the constructor, to compute persistence again
+ * without building the original complex.
+ *
  * \implements FilteredComplex
  * \ingroup simplex_tree
  */
@@ -67,112 +46,138 @@ template < typename FiltrationValue = double
 >
 class Hasse_complex {
  public:
-  typedef Hasse_simplex<Hasse_complex> Hasse_simp;
   typedef FiltrationValue Filtration_value;
   typedef SimplexKey Simplex_key;
-  typedef int Simplex_handle;  // index in vector complex_
+  typedef int Simplex_handle;  // index in the filtration
 
   typedef boost::counting_iterator< Simplex_handle > Filtration_simplex_iterator;
   typedef boost::iterator_range<Filtration_simplex_iterator> Filtration_simplex_range;
 
-  typedef typename std::vector< Simplex_handle >::iterator Boundary_simplex_iterator;
+  typedef typename std::vector< Simplex_handle >::const_iterator Boundary_simplex_iterator;
   typedef boost::iterator_range<Boundary_simplex_iterator> Boundary_simplex_range;
 
-  typedef typename std::vector< Simplex_handle >::iterator Skeleton_simplex_iterator;
+  typedef typename std::vector< Simplex_handle >::const_iterator Skeleton_simplex_iterator;
   typedef boost::iterator_range< Skeleton_simplex_iterator > Skeleton_simplex_range;
 
   /*  only dimension 0 skeleton_simplex_range(...) */
-  Skeleton_simplex_range skeleton_simplex_range(int dim = 0) {
+  Skeleton_simplex_range skeleton_simplex_range(int dim = 0) const {
     if (dim != 0) {
       std::cerr << "Dimension must be 0 \n";
     }
     return Skeleton_simplex_range(vertices_.begin(), vertices_.end());
   }
 
+  /** \brief Builds the Hasse diagram of a FilteredComplex. Complex_ds must verify that cpx.key(sh) is the order of sh
+   * in the filtration. The diagram is filled in parallel if TBB is available. */
   template < class Complex_ds >
   Hasse_complex(Complex_ds & cpx)
-      : complex_(cpx.num_simplices())
-      , vertices_()
+      : filtrations_(cpx.num_simplices())
+      , keys_(cpx.num_simplices())
+      , boundary_offsets_(cpx.num_simplices() + 1)
       , num_vertices_()
       , dim_max_(cpx.dimension()) {
-    int size = complex_.size();
-#ifdef GUDHI_USE_TBB
-    tbb::parallel_for(0, size, [&](int idx){new (&complex_[idx]) Hasse_simp(cpx, cpx.simplex(idx));});
-    for (int idx=0; idx < size; ++idx)
-      if (complex_[idx].boundary_.empty())
-        vertices_.push_back(idx);
-#else
-    for (int idx=0; idx < size; ++idx) {
-      new (&complex_[idx]) Hasse_simp(cpx, cpx.simplex(idx));
-      if (complex_[idx].boundary_.empty())
-        vertices_.push_back(idx);
+    const Simplex_handle size = filtrations_.size();
+    // boundary_offsets_[idx + 1] first holds the size of the boundary of idx, and becomes an offset after the
+    // prefix sum.
+    for_each_simplex(size, [&](Simplex_handle idx) {
+      auto sh = cpx.simplex(idx);
+      filtrations_[idx] = cpx.filtration(sh);
+      int dim = cpx.dimension(sh);
+      boundary_offsets_[idx + 1] = dim > 0 ? dim + 1 : 0;
+    });
+    for (Simplex_handle idx = 0; idx < size; ++idx) {
+      if (boundary_offsets_[idx + 1] == 0) vertices_.push_back(idx);
+      boundary_offsets_[idx + 1] += boundary_offsets_[idx];
+    }
+    boundaries_.resize(boundary_offsets_[size]);
+    for_each_simplex(size, [&](Simplex_handle idx) {
+      if (boundary_offsets_[idx] == boundary_offsets_[idx + 1]) return;
+      auto out = boundaries_.begin() + boundary_offsets_[idx];
+      for (auto b_sh : cpx.boundary_simplex_range(cpx.simplex(idx))) *out++ = cpx.key(b_sh);
+    });
+  }
+
+  /** \brief Builds the Hasse diagram from its arrays in compressed sparse column format, as returned by
+   * boundary_offsets(), boundaries() and filtrations(). The boundary of a simplex only contains simplices that come
+   * before it in the filtration. */
+  Hasse_complex(std::vector<std::size_t> boundary_offsets, std::vector<Simplex_handle> boundaries,
+                std::vector<Filtration_value> filtrations)
+      : filtrations_(std::move(filtrations))
+      , keys_(filtrations_.size())
+      , boundary_offsets_(std::move(boundary_offsets))
+      , boundaries_(std::move(boundaries))
+      , num_vertices_()
+      , dim_max_(-1) {
+    for (Simplex_handle idx = 0; idx < static_cast<Simplex_handle>(filtrations_.size()); ++idx) {
+      int dim = dimension(idx);
+      if (dim == 0) vertices_.push_back(idx);
+      if (dim_max_ < dim) dim_max_ = dim;
     }
-#endif
   }
 
   Hasse_complex()
-      : complex_()
-      , vertices_()
+      : boundary_offsets_(1, 0)
       , num_vertices_(0)
       , dim_max_(-1) { }
 
-  size_t num_simplices() {
-    return complex_.size();
+  size_t num_simplices() const {
+    return filtrations_.size();
   }
 
-  Filtration_simplex_range filtration_simplex_range() {
+  Filtration_simplex_range filtration_simplex_range() const {
     return Filtration_simplex_range(Filtration_simplex_iterator(0)
-                                    , Filtration_simplex_iterator(complex_.size()));
+                                    , Filtration_simplex_iterator(filtrations_.size()));
   }
 
-  Simplex_key key(Simplex_handle sh) {
-    return complex_[sh].key_;
+  Simplex_key key(Simplex_handle sh) const {
+    return keys_[sh];
   }
 
-  Simplex_key null_key() {
+  Simplex_key null_key() const {
     return -1;
   }
 
-  Simplex_handle simplex(Simplex_key key) {
+  Simplex_handle simplex(Simplex_key key) const {
     if (key == null_key()) return null_simplex();
     return key;
   }
 
-  Simplex_handle null_simplex() {
+  Simplex_handle null_simplex() const {
     return -1;
   }
 
-  Filtration_value filtration(Simplex_handle sh) {
+  Filtration_value filtration(Simplex_handle sh) const {
     if (sh == null_simplex()) {
       return std::numeric_limits<Filtration_value>::infinity();
     }
-    return complex_[sh].filtration_;
+    return filtrations_[sh];
   }
 
-  int dimension(Simplex_handle sh) {
-    if (complex_[sh].boundary_.empty()) return 0;
-    return complex_[sh].boundary_.size() - 1;
+  int dimension(Simplex_handle sh) const {
+    std::size_t boundary_size = boundary_offsets_[sh + 1] - boundary_offsets_[sh];
+    if (boundary_size == 0) return 0;
+    return boundary_size - 1;
   }
 
-  int dimension() {
+  int dimension() const {
     return dim_max_;
   }
 
-  std::pair<Simplex_handle, Simplex_handle> endpoints(Simplex_handle sh) {
-    return std::pair<Simplex_handle, Simplex_handle>(complex_[sh].boundary_[0]
-                                                     , complex_[sh].boundary_[1]);
+  std::pair<Simplex_handle, Simplex_handle> endpoints(Simplex_handle sh) const {
+    return std::pair<Simplex_handle, Simplex_handle>(boundaries_[boundary_offsets_[sh]]
+                                                     , boundaries_[boundary_offsets_[sh] + 1]);
   }
 
   void assign_key(Simplex_handle sh, Simplex_key key) {
-    complex_[sh].key_ = key;
+    keys_[sh] = key;
   }
 
-  Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) {
-    return Boundary_simplex_range(complex_[sh].boundary_.begin()
-                                  , complex_[sh].boundary_.end());
+  Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) const {
+    return Boundary_simplex_range(boundaries_.begin() + boundary_offsets_[sh]
+                                  , boundaries_.begin() + boundary_offsets_[sh + 1]);
   }
 
-  void display_simplex(Simplex_handle sh) {
+  void display_simplex(Simplex_handle sh) const {
     std::clog << dimension(sh) << "  ";
     for (auto sh_b : boundary_simplex_range(sh)) std::clog << sh_b << " ";
     std::clog << "  " << filtration(sh) << "         key=" << key(sh);
@@ -180,14 +185,34 @@ class Hasse_complex {
 
   void initialize_filtration() {
     // Setting the keys is done by pcoh, Simplex_tree doesn't do it either.
-#if 0
-    Simplex_key key = 0;
-    for (auto & h_simp : complex_)
-      h_simp.key_ = key++;
+  }
+
+  /** \brief Offsets of the boundaries of the simplices in boundaries(), of size num_simplices() + 1. */
+  const std::vector<std::size_t>& boundary_offsets() const { return boundary_offsets_; }
+
+  /** \brief Concatenation of the boundaries of all the simplices, in the order of the filtration. */
+  const std::vector<Simplex_handle>& boundaries() const { return boundaries_; }
+
+  /** \brief Filtration values of the simplices, in the order of the filtration. */
+  const std::vector<Filtration_value>& filtrations() const { return filtrations_; }
+
+ private:
+  template <class Function>
+  static void for_each_simplex(Simplex_handle size, const Function& f) {
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(Simplex_handle(0), size, f);
+#else
+    for (Simplex_handle idx = 0; idx < size; ++idx) f(idx);
 #endif
   }
 
-  std::vector< Hasse_simp, Gudhi::no_init_allocator<Hasse_simp> > complex_;
+  template< typename T1, typename T2, typename T3 >
+  friend std::istream& operator>>(std::istream & is, Hasse_complex< T1, T2, T3 > & hcpx);
+
+  std::vector<Filtration_value> filtrations_;
+  std::vector<Simplex_key> keys_;
+  std::vector<std::size_t> boundary_offsets_;
+  std::vector<Simplex_handle> boundaries_;
   std::vector<Simplex_handle> vertices_;
   size_t num_vertices_;
   int dim_max_;
@@ -200,17 +225,20 @@ std::istream& operator>>(std::istream & is
 
   size_t num_simp;
   is >> num_simp;
-  hcpx.complex_.reserve(num_simp);
+  hcpx.filtrations_.reserve(num_simp);
+  hcpx.boundary_offsets_.reserve(num_simp + 1);
 
   std::vector< typename Hasse_complex<T1, T2, T3>::Simplex_key > boundary;
   typename Hasse_complex<T1, T2, T3>::Filtration_value fil;
-  typename Hasse_complex<T1, T2, T3>::Filtration_value max_fil = 0;
   int max_dim = -1;
   int key = 0;
   // read all simplices in the file as a list of vertices
   while (read_hasse_simplex(is, boundary, fil)) {
-    // insert every simplex in the simplex tree
-    hcpx.complex_.emplace_back(key, fil, boundary);
+    // insert every simplex in the Hasse diagram
+    hcpx.filtrations_.push_back(fil);
+    hcpx.keys_.push_back(key);
+    hcpx.boundaries_.insert(hcpx.boundaries_.end(), boundary.begin(), boundary.end());
+    hcpx.boundary_offsets_.push_back(hcpx.boundaries_.size());
 
     if (max_dim < hcpx.dimension(key)) {
       max_dim = hcpx.dimension(key);
@@ -218,9 +246,6 @@ std::istream& operator>>(std::istream & is
     if (hcpx.dimension(key) == 0) {
       hcpx.vertices_.push_back(key);
     }
-    if (max_fil < fil) {
-      max_fil = fil;
-    }
 
     ++key;
     boundary.clear();
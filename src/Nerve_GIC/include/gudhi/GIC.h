@@ -14,7 +14,8 @@
 
 #ifdef GUDHI_USE_TBB
 #include <tbb/parallel_for.h>
-#include <mutex>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
 #endif
 
 #if __has_include(<CGAL/version.h>)
@@ -52,6 +53,7 @@ using ssize_t = std::make_signed_t<std::size_t>;
 #include <iostream>
 #include <vector>
 #include <map>
+#include <mutex>  // for std::lock_guard
 #include <string>
 #include <limits>     // for numeric_limits
 #include <utility>    // for std::pair<>
@@ -59,6 +61,7 @@ using ssize_t = std::make_signed_t<std::size_t>;
 #include <random>
 #include <cassert>
 #include <cmath>
+#include <type_traits>  // for std::is_same
 
 namespace Gudhi {
 
@@ -103,6 +106,7 @@ class Cover_complex {
 
   std::vector<Point> point_cloud;               // input point cloud.
   std::vector<std::vector<double> > distances;  // all pairwise distances.
+  bool store_distances = true;                  // whether the pairwise distances are stored in distances.
   int maximal_dim;                              // maximal dimension of output simplicial complex.
   int data_dimension;                           // dimension of input data.
   int num_points;                                        // number of points.
@@ -218,6 +222,19 @@ class Cover_complex {
    */
   void set_mask(int nodemask) { mask = nodemask; }
 
+ public:
+  /** \brief Specifies whether the pairwise distances between the points are computed once and stored in a dense matrix
+   * (the default), or computed when they are needed.
+   *
+   * Without the matrix, the memory only grows with the number of edges of the graph: the Rips graph is computed with
+   * a grid for the Euclidean distance, and all the distances are computed in parallel with TBB. This has no effect
+   * when the distances are given with `set_distances_from_range` or read from a file.
+   *
+   * @param[in] store boolean (true = store the distance matrix, false = compute the distances on demand).
+   *
+   */
+  void set_distance_storage(bool store = true) { store_distances = store; }
+
  public:
 
 
@@ -359,7 +376,17 @@ class Cover_complex {
   template <typename Distance>
   void set_graph_from_rips(double threshold, Distance distance) {
     remove_edges(one_skeleton);
-    if (distances.size() == 0) compute_pairwise_distances(distance);
+    if (distances.size() == 0 && store_distances) compute_pairwise_distances(distance);
+    if (distances.size() == 0) {
+      std::vector<std::pair<int, int> > edges;
+      std::vector<double> lengths;
+      compute_rips_edges(threshold, distance, edges, lengths);
+      for (std::size_t e = 0; e < edges.size(); e++) {
+        auto edge = boost::add_edge(vertices[edges[e].first], vertices[edges[e].second], one_skeleton).first;
+        boost::put(boost::edge_weight, one_skeleton, edge, lengths[e]);
+      }
+      return;
+    }
     for (int i = 0; i < this->num_points; i++) {
       for (int j = i + 1; j < this->num_points; j++) {
         if (distances[i][j] <= threshold) {
@@ -381,6 +408,22 @@ class Cover_complex {
                  distances[index[boost::source(*ei, one_skeleton)]][index[boost::target(*ei, one_skeleton)]]);
   }
 
+  // Same, with the distances computed from the points when they are not stored.
+  template <typename Distance>
+  void set_graph_weights(Distance& distance) {
+    if (distances.size() != 0) {
+      set_graph_weights();
+      return;
+    }
+    Index_map index = boost::get(boost::vertex_index, one_skeleton);
+    Weight_map weight = boost::get(boost::edge_weight, one_skeleton);
+    boost::graph_traits<Graph>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::edges(one_skeleton); ei != ei_end; ++ei)
+      boost::put(weight, *ei,
+                 distance(point_cloud[index[boost::source(*ei, one_skeleton)]],
+                          point_cloud[index[boost::target(*ei, one_skeleton)]]));
+  }
+
  public:
   /** \brief Reads and stores the distance matrices from vector stored in memory.
    *
@@ -405,18 +448,65 @@ class Cover_complex {
     std::vector<double> zeros(this->num_points);
     for (int i = 0; i < this->num_points; i++) distances.push_back(zeros);
     if (verbose) std::clog << "Computing distances..." << std::endl;
-    for (int i = 0; i < this->num_points; i++) {
-      int state = 100 * (i + 1) / this->num_points;
-      if (verbose && state % 10 == 0) std::clog << "\r" << state << "%" << std::flush;
-      for (int j = i; j < this->num_points; j++) {
-        double dis = ref_distance(point_cloud[i], point_cloud[j]);
-        distances[i][j] = dis;
-        distances[j][i] = dis;
+    #ifdef GUDHI_USE_TBB
+      // Each task writes the upper part of its rows and the symmetric entries, which no other task writes.
+      tbb::parallel_for(0, this->num_points, [&](int i){
+        for (int j = i; j < this->num_points; j++) {
+          double dis = ref_distance(point_cloud[i], point_cloud[j]);
+          distances[i][j] = dis;
+          distances[j][i] = dis;
+        }
+      });
+    #else
+      for (int i = 0; i < this->num_points; i++) {
+        int state = 100 * (i + 1) / this->num_points;
+        if (verbose && state % 10 == 0) std::clog << "\r" << state << "%" << std::flush;
+        for (int j = i; j < this->num_points; j++) {
+          double dis = ref_distance(point_cloud[i], point_cloud[j]);
+          distances[i][j] = dis;
+          distances[j][i] = dis;
+        }
       }
-    }
+    #endif
     if (verbose) std::clog << std::endl;
   }
 
+ private:
+  // Distance between the points i and j, read in the matrix if it is stored.
+  template <typename Distance>
+  double pairwise_distance(int i, int j, Distance& distance) const {
+    return distances.size() != 0 ? distances[i][j] : distance(point_cloud[i], point_cloud[j]);
+  }
+
+  // Edges [u,v], u < v, of the Rips graph, by increasing u then v, without the distance matrix.
+  template <typename Distance>
+  void compute_rips_edges(double threshold, Distance& distance, std::vector<std::pair<int, int> >& edges,
+                          std::vector<double>& lengths) const {
+    if constexpr (std::is_same<Distance, Euclidean_distance>::value) {
+      // Range queries in a grid, in parallel with TBB
+      proximity_graph_edges_with_grid(point_cloud, threshold, distance, edges, lengths);
+    } else {
+      std::vector<std::vector<std::pair<int, double> > > neighbors(this->num_points);
+      auto neighbors_of = [&](int i) {
+        for (int j = i + 1; j < this->num_points; j++) {
+          double dis = distance(point_cloud[i], point_cloud[j]);
+          if (dis <= threshold) neighbors[i].emplace_back(j, dis);
+        }
+      };
+      #ifdef GUDHI_USE_TBB
+        tbb::parallel_for(0, this->num_points, neighbors_of);
+      #else
+        for (int i = 0; i < this->num_points; i++) neighbors_of(i);
+      #endif
+      for (int i = 0; i < this->num_points; i++) {
+        for (auto const& neighbor : neighbors[i]) {
+          edges.emplace_back(i, neighbor.first);
+          lengths.push_back(neighbor.second);
+        }
+      }
+    }
+  }
+
  public:  // Automatic tuning of Rips complex.
   /** \brief Creates a graph G from a Rips complex whose threshold value is automatically tuned with subsampling---see
    * \cite Carriere17c.
@@ -436,7 +526,7 @@ class Cover_complex {
     if (verbose) std::clog << this->num_points << " points in R^" << data_dimension << std::endl;
     if (verbose) std::clog << "Subsampling " << m << " points" << std::endl;
 
-    if (distances.size() == 0) compute_pairwise_distances(distance);
+    if (distances.size() == 0 && store_distances) compute_pairwise_distances(distance);
 
     #ifdef GUDHI_USE_TBB
     std::mutex deltamutex;
@@ -445,8 +535,8 @@ class Cover_complex {
         SampleWithoutReplacement(this->num_points, m, samples);
         double hausdorff_dist = 0;
         for (int j = 0; j < this->num_points; j++) {
-          double mj = distances[j][samples[0]];
-          for (int k = 1; k < m; k++) mj = (std::min)(mj, distances[j][samples[k]]);
+          double mj = pairwise_distance(j, samples[0], distance);
+          for (int k = 1; k < m; k++) mj = (std::min)(mj, pairwise_distance(j, samples[k], distance));
           hausdorff_dist = (std::max)(hausdorff_dist, mj);
         }
         deltamutex.lock();
@@ -459,8 +549,8 @@ class Cover_complex {
         SampleWithoutReplacement(this->num_points, m, samples);
         double hausdorff_dist = 0;
         for (int j = 0; j < this->num_points; j++) {
-          double mj = distances[j][samples[0]];
-          for (int k = 1; k < m; k++) mj = (std::min)(mj, distances[j][samples[k]]);
+          double mj = pairwise_distance(j, samples[0], distance);
+          for (int k = 1; k < m; k++) mj = (std::min)(mj, pairwise_distance(j, samples[k], distance));
           hausdorff_dist = (std::max)(hausdorff_dist, mj);
         }
         delta += hausdorff_dist / N;
@@ -610,6 +700,59 @@ class Cover_complex {
       return;
     }
 
+    std::vector<int> points = sorted_points();
+    cover_from_sorted_points(points, function_intervals(), nullptr);
+  }
+
+ public:  // Sweep over the parameters of the cover with preimages of function.
+  /** \brief Computes the complexes of the covers from the preimages of the function f, for several numbers of
+   * intervals and gains, as `set_cover_from_function`, `find_simplices` and `create_complex` would.
+   *
+   * The points are sorted by function value once, and the connected components of a preimage are computed once for
+   * all the intervals that contain the same points, so that a sweep over close parameters only computes the
+   * components of the preimages that changed. The graph and the function must be set before. After the call, the
+   * cover and the simplices are those of the last parameters.
+   *
+   * @param[in] parameters pairs of a number of intervals and a gain.
+   * @result the complexes, one per pair of parameters.
+   *
+   */
+  template <typename SimplicialComplex>
+  std::vector<SimplicialComplex> sweep_cover_from_function(const std::vector<std::pair<int, double> >& parameters) {
+    std::vector<int> points = sorted_points();
+    Component_cache cache;
+    std::vector<SimplicialComplex> complexes(parameters.size());
+    for (std::size_t k = 0; k < parameters.size(); k++) {
+      resolution_int = parameters[k].first;
+      resolution_double = -1;
+      gain = parameters[k].second;
+      for (auto& elements : cover) elements.clear();
+      cover_back.clear();
+      cover_fct.clear();
+      cover_std.clear();
+      cover_color.clear();
+      simplices.clear();
+      cover_from_sorted_points(points, function_intervals(), &cache);
+      find_simplices();
+      create_complex(complexes[k]);
+    }
+    return complexes;
+  }
+
+ private:
+  // Connected components of the preimages, by range of points sorted by function value.
+  typedef std::map<std::pair<int, int>, std::vector<int> > Component_cache;
+
+  // Indices of the points sorted by function value.
+  std::vector<int> sorted_points() const {
+    std::vector<int> points(this->num_points);
+    for (int i = 0; i < this->num_points; i++) points[i] = i;
+    std::sort(points.begin(), points.end(), [this](int p1, int p2){return (this->func[p1] < this->func[p2]);});
+    return points;
+  }
+
+  // Intervals of the cover of im(f), from the resolution and the gain.
+  std::vector<std::pair<double, double> > function_intervals() const {
     // Read function values and compute min and max
     double minf = (std::numeric_limits<float>::max)();
     double maxf = std::numeric_limits<float>::lowest();
@@ -621,79 +764,119 @@ class Cover_complex {
 
     // Compute cover of im(f)
     std::vector<std::pair<double, double> > intervals;
-    int res;
 
     if (resolution_double == -1) {  // Case we use an integer for the number of intervals.
       double incr = (maxf - minf) / resolution_int;
       double x = minf;
       double alpha = (incr * gain) / (2 - 2 * gain);
       double y = minf + incr + alpha;
-      std::pair<double, double> interm(x, y);
-      intervals.push_back(interm);
+      intervals.emplace_back(x, y);
       for (int i = 1; i < resolution_int - 1; i++) {
         x = minf + i * incr - alpha;
         y = minf + (i + 1) * incr + alpha;
-        std::pair<double, double> inter(x, y);
-        intervals.push_back(inter);
+        intervals.emplace_back(x, y);
       }
       x = minf + (resolution_int - 1) * incr - alpha;
       y = maxf;
-      std::pair<double, double> interM(x, y);
-      intervals.push_back(interM);
-      res = intervals.size();
-      if (verbose) {
-        for (int i = 0; i < res; i++)
-          std::clog << "Interval " << i << " = [" << intervals[i].first << ", " << intervals[i].second << "]"
-                    << std::endl;
-      }
+      intervals.emplace_back(x, y);
     } else {
-      if (resolution_int == -1) {  // Case we use a double for the length of the intervals.
-        double x = minf;
-        double y = x + resolution_double;
-        while (y <= maxf && maxf - (y - gain * resolution_double) >= resolution_double) {
-          std::pair<double, double> inter(x, y);
-          intervals.push_back(inter);
-          x = y - gain * resolution_double;
-          y = x + resolution_double;
-        }
-        std::pair<double, double> interM(x, maxf);
-        intervals.push_back(interM);
-        res = intervals.size();
-        if (verbose) {
-          for (int i = 0; i < res; i++)
-            std::clog << "Interval " << i << " = [" << intervals[i].first << ", " << intervals[i].second << "]"
-                      << std::endl;
-        }
-      } else {  // Case we use an integer and a double for the length of the intervals.
-        double x = minf;
-        double y = x + resolution_double;
-        int count = 0;
-        while (count < resolution_int && y <= maxf && maxf - (y - gain * resolution_double) >= resolution_double) {
-          std::pair<double, double> inter(x, y);
-          intervals.push_back(inter);
-          count++;
-          x = y - gain * resolution_double;
-          y = x + resolution_double;
-        }
-        res = intervals.size();
-        if (verbose) {
-          for (int i = 0; i < res; i++)
-            std::clog << "Interval " << i << " = [" << intervals[i].first << ", " << intervals[i].second << "]"
-                      << std::endl;
-        }
+      double x = minf;
+      double y = x + resolution_double;
+      int count = 0;
+      // Without a number of intervals, the last one ends at the maximum.
+      while ((resolution_int == -1 || count < resolution_int) && y <= maxf &&
+             maxf - (y - gain * resolution_double) >= resolution_double) {
+        intervals.emplace_back(x, y);
+        count++;
+        x = y - gain * resolution_double;
+        y = x + resolution_double;
       }
+      if (resolution_int == -1) intervals.emplace_back(x, maxf);
     }
+    if (verbose) {
+      for (std::size_t i = 0; i < intervals.size(); i++)
+        std::clog << "Interval " << i << " = [" << intervals[i].first << ", " << intervals[i].second << "]"
+                  << std::endl;
+    }
+    return intervals;
+  }
 
-    // Sort points according to function values
-    std::vector<int> points(this->num_points);
-    for (int i = 0; i < this->num_points; i++) points[i] = i;
-    std::sort(points.begin(), points.end(), [this](int p1, int p2){return (this->func[p1] < this->func[p2]);});
+  // Neighbors of each point in one_skeleton, in compressed sparse row format.
+  struct Adjacency {
+    std::vector<std::size_t> offsets;
+    std::vector<int> neighbors;
+  };
 
-    int id = 0;
+  Adjacency adjacency() const {
+    auto index = boost::get(boost::vertex_index, one_skeleton);
+    Adjacency adj;
+    adj.offsets.assign(this->num_points + 1, 0);
+    boost::graph_traits<Graph>::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = boost::edges(one_skeleton); ei != ei_end; ++ei) {
+      adj.offsets[index[boost::source(*ei, one_skeleton)] + 1]++;
+      adj.offsets[index[boost::target(*ei, one_skeleton)] + 1]++;
+    }
+    for (int i = 0; i < this->num_points; i++) adj.offsets[i + 1] += adj.offsets[i];
+    adj.neighbors.resize(adj.offsets[this->num_points]);
+    std::vector<std::size_t> next(adj.offsets.begin(), adj.offsets.end() - 1);
+    for (boost::tie(ei, ei_end) = boost::edges(one_skeleton); ei != ei_end; ++ei) {
+      int u = index[boost::source(*ei, one_skeleton)], v = index[boost::target(*ei, one_skeleton)];
+      adj.neighbors[next[u]++] = v;
+      adj.neighbors[next[v]++] = u;
+    }
+    return adj;
+  }
+
+  // Buffers of the union-find of a thread, reused from one preimage to the next.
+  struct Preimage_workspace {
+    std::vector<int> position;  // position of each point in the current preimage, -1 outside.
+    std::vector<int> parent;
+    std::vector<int> label;
+  };
+
+  // Connected components of the subgraph induced by the points, numbered from 0 by order of first point, like
+  // boost::connected_components.
+  std::vector<int> preimage_components(const std::vector<int>& preimage, const Adjacency& adj,
+                                       Preimage_workspace& work) const {
+    int num = preimage.size();
+    if (work.position.empty()) work.position.assign(this->num_points, -1);
+    work.parent.resize(num);
+    for (int j = 0; j < num; j++) {
+      work.position[preimage[j]] = j;
+      work.parent[j] = j;
+    }
+    auto find = [&](int j) {
+      while (work.parent[j] != j) j = work.parent[j] = work.parent[work.parent[j]];
+      return j;
+    };
+    for (int j = 0; j < num; j++) {
+      for (std::size_t e = adj.offsets[preimage[j]]; e < adj.offsets[preimage[j] + 1]; e++) {
+        int k = work.position[adj.neighbors[e]];
+        if (k < 0) continue;
+        int rj = find(j), rk = find(k);
+        if (rj != rk) work.parent[(std::max)(rj, rk)] = (std::min)(rj, rk);
+      }
+    }
+    std::vector<int> component(num);
+    work.label.assign(num, -1);
+    int count = 0;
+    for (int j = 0; j < num; j++) {
+      int r = find(j);
+      if (work.label[r] < 0) work.label[r] = count++;
+      component[j] = work.label[r];
+      work.position[preimage[j]] = -1;
+    }
+    return component;
+  }
+
+  // Fills the cover with the connected components of the preimages of the intervals. The preimage of an interval is a
+  // range of the points sorted by function value, and its components are looked up in the cache, if there is one.
+  void cover_from_sorted_points(const std::vector<int>& points, const std::vector<std::pair<double, double> >& intervals,
+                                Component_cache* cache) {
+    int res = intervals.size();
+    std::vector<std::pair<int, int> > ranges(res);
+    std::vector<double> funcstd(res);
     int pos = 0;
-    Index_map index = boost::get(boost::vertex_index, one_skeleton);  // int maxc = -1;
-    std::map<int, std::vector<int> > preimages;
-    std::map<int, double> funcstd;
 
     if (verbose) std::clog << "Computing preimages..." << std::endl;
     for (int i = 0; i < res; i++) {
@@ -705,111 +888,82 @@ class Cover_complex {
       if (i != res - 1) {
         if (i != 0) {
           std::pair<double, double> inter3 = intervals[i - 1];
-          while (func[points[tmp]] < inter3.second && tmp != this->num_points) {
-            preimages[i].push_back(points[tmp]);
-            tmp++;
-          }
+          while (tmp != this->num_points && func[points[tmp]] < inter3.second) tmp++;
           u = inter3.second;
         } else {
           u = inter1.first;
         }
 
         std::pair<double, double> inter2 = intervals[i + 1];
-        while (func[points[tmp]] < inter2.first && tmp != this->num_points) {
-          preimages[i].push_back(points[tmp]);
-          tmp++;
-        }
+        while (tmp != this->num_points && func[points[tmp]] < inter2.first) tmp++;
         v = inter2.first;
+        ranges[i].first = pos;
         pos = tmp;
-        while (func[points[tmp]] < inter1.second && tmp != this->num_points) {
-          preimages[i].push_back(points[tmp]);
-          tmp++;
-        }
+        while (tmp != this->num_points && func[points[tmp]] < inter1.second) tmp++;
+        ranges[i].second = tmp;
 
       } else {
-        std::pair<double, double> inter3 = intervals[i - 1];
-        while (func[points[tmp]] < inter3.second && tmp != this->num_points) {
-          preimages[i].push_back(points[tmp]);
-          tmp++;
-        }
-        while (tmp != this->num_points) {
-          preimages[i].push_back(points[tmp]);
-          tmp++;
-        }
-        u = inter3.second;
+        ranges[i] = std::make_pair(pos, this->num_points);
+        u = i != 0 ? intervals[i - 1].second : inter1.first;
         v = inter1.second;
       }
 
       funcstd[i] = 0.5 * (u + v);
     }
 
+    int id = 0;
+    const Adjacency adj = adjacency();
+    auto add_preimage = [&](int i, Preimage_workspace& work, auto& covermutex) {
+      std::vector<int> preimage(points.begin() + ranges[i].first, points.begin() + ranges[i].second);
+      int num = preimage.size();
+      // Compute connected components, or find them in the cache
+      const std::vector<int>* component = nullptr;
+      std::vector<int> computed;
+      if (cache != nullptr) {
+        std::lock_guard lock(covermutex);
+        auto it = cache->find(ranges[i]);
+        if (it != cache->end()) component = &it->second;
+      }
+      if (component == nullptr) {
+        computed = preimage_components(preimage, adj, work);
+        component = &computed;
+      }
+      int max = 0;
+
+      std::lock_guard lock(covermutex);
+      // For each point in preimage
+      for (int j = 0; j < num; j++) {
+        // Update number of components in preimage
+        if ((*component)[j] > max) max = (*component)[j];
+
+        // Identify component with Cantor polynomial N^2 -> N
+        int identifier = ((i + (*component)[j]) * (i + (*component)[j]) + 3 * i + (*component)[j]) / 2;
+
+        // Update covers
+        cover[preimage[j]].push_back(identifier);
+        cover_back[identifier].push_back(preimage[j]);
+        cover_fct[identifier] = i;
+        cover_std[identifier] = funcstd[i];
+        cover_color[identifier].second += func_color[preimage[j]];
+        cover_color[identifier].first += 1;
+      }
+      if (cache != nullptr && component == &computed) cache->emplace(ranges[i], std::move(computed));
+
+      // Maximal dimension is total number of connected components
+      id += max + 1;
+    };
+
     #ifdef GUDHI_USE_TBB
       if (verbose) std::clog << "Computing connected components (parallelized)..." << std::endl;
-      std::mutex covermutex, idmutex;
-      tbb::parallel_for(0, res, [&](int i){
-        // Compute connected components
-        Graph G = one_skeleton.create_subgraph();
-        int num = preimages[i].size();
-        std::vector<int> component(num);
-        for (int j = 0; j < num; j++) boost::add_vertex(index[vertices[preimages[i][j]]], G);
-        boost::connected_components(G, &component[0]);
-        int max = 0;
-
-        // For each point in preimage
-        for (int j = 0; j < num; j++) {
-          // Update number of components in preimage
-          if (component[j] > max) max = component[j];
-
-          // Identify component with Cantor polynomial N^2 -> N
-          int identifier = ((i + component[j])*(i + component[j]) + 3 * i + component[j]) / 2;
-
-          // Update covers
-          covermutex.lock();
-          cover[preimages[i][j]].push_back(identifier);
-          cover_back[identifier].push_back(preimages[i][j]);
-          cover_fct[identifier] = i;
-          cover_std[identifier] = funcstd[i];
-          cover_color[identifier].second += func_color[preimages[i][j]];
-          cover_color[identifier].first += 1;
-          covermutex.unlock();
-        }
-
-        // Maximal dimension is total number of connected components
-        idmutex.lock();
-        id += max + 1;
-        idmutex.unlock();
-      });
+      std::mutex covermutex;
+      tbb::enumerable_thread_specific<Preimage_workspace> workspaces;
+      tbb::parallel_for(0, res, [&](int i){ add_preimage(i, workspaces.local(), covermutex); });
     #else
       if (verbose) std::clog << "Computing connected components..." << std::endl;
-      for (int i = 0; i < res; i++) {
-        // Compute connected components
-        Graph G = one_skeleton.create_subgraph();
-        int num = preimages[i].size();
-        std::vector<int> component(num);
-        for (int j = 0; j < num; j++) boost::add_vertex(index[vertices[preimages[i][j]]], G);
-        boost::connected_components(G, &component[0]);
-        int max = 0;
-
-        // For each point in preimage
-        for (int j = 0; j < num; j++) {
-          // Update number of components in preimage
-          if (component[j] > max) max = component[j];
-
-          // Identify component with Cantor polynomial N^2 -> N
-          int identifier = (std::pow(i + component[j], 2) + 3 * i + component[j]) / 2;
-
-          // Update covers
-          cover[preimages[i][j]].push_back(identifier);
-          cover_back[identifier].push_back(preimages[i][j]);
-          cover_fct[identifier] = i;
-          cover_std[identifier] = funcstd[i];
-          cover_color[identifier].second += func_color[preimages[i][j]];
-          cover_color[identifier].first += 1;
-        }
-
-        // Maximal dimension is total number of connected components
-        id += max + 1;
-      }
+      // Nothing to protect without threads
+      struct { void lock() {} void unlock() {} } covermutex;
+      Preimage_workspace work;
+      for (int i = 0; i < res; i++) add_preimage(i, work, covermutex);
     #endif
 
     maximal_dim = id - 1;
@@ -897,8 +1051,8 @@ class Cover_complex {
   void set_cover_from_Voronoi(Distance distance, int m = 100) {
     voronoi_subsamples.resize(m);
     SampleWithoutReplacement(this->num_points, m, voronoi_subsamples);
-    if (distances.size() == 0) compute_pairwise_distances(distance);
-    set_graph_weights();
+    if (distances.size() == 0 && store_distances) compute_pairwise_distances(distance);
+    set_graph_weights(distance);
     Weight_map weight = boost::get(boost::edge_weight, one_skeleton);
     Index_map index = boost::get(boost::vertex_index, one_skeleton);
     std::vector<double> mindist(this->num_points);
@@ -1250,7 +1404,8 @@ class Cover_complex {
         }
         Cboot.set_color_from_range(Cboot.func);
 
-        for (int j = 0; j < this->num_points; j++) {
+        Cboot.store_distances = this->store_distances;
+        for (int j = 0; j < this->num_points && distances.size() != 0; j++) {
           std::vector<double> dist(this->num_points);
           for (int k = 0; k < this->num_points; k++) dist[k] = distances[boot[j]][boot[k]];
           Cboot.distances.push_back(dist);
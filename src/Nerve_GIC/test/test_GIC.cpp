@@ -13,7 +13,9 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>  // for std::abs
 #include <limits>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -79,3 +81,74 @@ BOOST_AUTO_TEST_CASE(check_voronoiGIC) {
   BOOST_CHECK((stree.num_simplices() - stree.num_vertices()) == 1);
   BOOST_CHECK(stree.dimension() == 1);
 }
+
+BOOST_AUTO_TEST_CASE(check_GIC_without_distance_matrix) {
+  // Same complex with the distance matrix and with the distances computed on demand
+  using Point = std::vector<double>;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(300, Point(2));
+  for (Point& p : points)
+    for (double& x : p) x = coordinate(gen);
+  auto manhattan = [](const Point& p, const Point& q) { return std::abs(p[0] - q[0]) + std::abs(p[1] - q[1]); };
+  for (bool euclidean : {true, false}) {
+    Gudhi::Simplex_tree<> stree[2];
+    for (bool store : {true, false}) {
+      Gudhi::cover_complex::Cover_complex<Point> GIC;
+      GIC.set_type("GIC");
+      GIC.set_distance_storage(store);
+      GIC.set_point_cloud_from_range(points);
+      GIC.set_color_from_coordinate();
+      GIC.set_function_from_coordinate(0);
+      if (euclidean)
+        GIC.set_graph_from_rips(0.1, Gudhi::Euclidean_distance());
+      else
+        GIC.set_graph_from_rips(0.12, manhattan);
+      GIC.set_resolution_with_interval_number(8);
+      GIC.set_gain(0.3);
+      GIC.set_cover_from_function();
+      GIC.find_simplices();
+      GIC.create_complex(stree[store]);
+    }
+    std::clog << stree[0].num_simplices() << " simplices\n";
+    BOOST_CHECK(stree[0].num_simplices() > 8);
+    BOOST_CHECK(stree[0] == stree[1]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(check_GIC_parameter_sweep) {
+  // Same complexes as one cover per pair of parameters
+  using Point = std::vector<double>;
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(300, Point(2));
+  for (Point& p : points)
+    for (double& x : p) x = coordinate(gen);
+  const std::vector<std::pair<int, double>> parameters{{5, 0.3}, {5, 0.4}, {8, 0.3}, {8, 0.3}, {10, 0.2}};
+  for (std::string type : {"GIC", "Nerve"}) {
+    Gudhi::cover_complex::Cover_complex<Point> sweep;
+    sweep.set_type(type);
+    sweep.set_point_cloud_from_range(points);
+    sweep.set_color_from_coordinate();
+    sweep.set_function_from_coordinate(1);
+    sweep.set_graph_from_rips(0.1, Gudhi::Euclidean_distance());
+    auto complexes = sweep.sweep_cover_from_function<Gudhi::Simplex_tree<>>(parameters);
+    BOOST_CHECK(complexes.size() == parameters.size());
+    for (std::size_t k = 0; k < parameters.size(); ++k) {
+      Gudhi::cover_complex::Cover_complex<Point> GIC;
+      GIC.set_type(type);
+      GIC.set_point_cloud_from_range(points);
+      GIC.set_color_from_coordinate();
+      GIC.set_function_from_coordinate(1);
+      GIC.set_graph_from_rips(0.1, Gudhi::Euclidean_distance());
+      GIC.set_resolution_with_interval_number(parameters[k].first);
+      GIC.set_gain(parameters[k].second);
+      GIC.set_cover_from_function();
+      GIC.find_simplices();
+      Gudhi::Simplex_tree<> stree;
+      GIC.create_complex(stree);
+      BOOST_CHECK(stree.num_simplices() > 0);
+      BOOST_CHECK(stree == complexes[k]);
+    }
+  }
+}
@@ -72,6 +72,12 @@ namespace Persistence_representations {
  characteristics).
  \li Persistence diagrams / barcodes (allow computation of distances, vectorizations and real value characteristics).
 
+ For collections of representations too large to be kept in memory, \ref
+ Gudhi::Persistence_representations::Running_average computes the mean and the variance of representations given one
+ at a time, and \ref Gudhi::Persistence_representations::Distances_to_references their distances to a fixed set of
+ references. Together with \ref Gudhi::Persistence_representations::for_each_representation_in_files, which reads the
+ files written by `print_to_file` one after the other, they only store a bounded number of representations.
+
 
  Note that at the while functionalities like averaging, distances and scalar products are fixed, there is no canonical
  way of vectorizing and computing real valued characteristics of objects. Therefore the
@@ -130,6 +136,10 @@ namespace Persistence_representations {
  \li Compute just a number of initial nonzero landscapes. This option is available from C++ level as a last parameter of
  the constructor of persistence landscape (set by default to std::numeric_limits<size_t>::max()).
 
+ When only distances and scalar products are needed, \ref Gudhi::Persistence_representations::Persistence_landscape_flat
+ stores the same exact landscape in flat arrays, which takes less memory, and computes them by merging the critical
+ points of the two landscapes.
+
 
 
  \section sec_landscapes_on_grid Persistence Landscapes on a grid
@@ -202,6 +212,9 @@ namespace Persistence_representations {
  is a sum of values of distributions induced by each point of the persistence diagram. At the moment we compute the
  sum of values on a center of a pixels. It can be easily extended to any other function
  (like for instance sum of integrals of the intermediate distribution on a pixel).
+ When the filter is separable, like the Gaussian of create_Gaussian_filter_1d, the weights of the points can first be
+ accumulated in a histogram on the pixels, which is then convolved with the filter along each axis. This is much faster
+ for large diagrams and wide filters.
 
  The parameters that determine the structure are the following:
 
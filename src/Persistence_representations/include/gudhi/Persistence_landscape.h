@@ -450,6 +450,7 @@ class Persistence_landscape {
   void multiply_lanscape_by_real_number_overwrite(double x);
   friend double compute_maximal_distance_non_symmetric(const Persistence_landscape& pl1,
                                                        const Persistence_landscape& pl2);
+  friend class Persistence_landscape_flat;
 
   void set_up_numbers_of_functions_for_vectorization_and_projections_to_reals() {
     // warning, this function can be only called after filling in the intervals vector.
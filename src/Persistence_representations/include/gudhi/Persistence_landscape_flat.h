@@ -0,0 +1,199 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef PERSISTENCE_LANDSCAPE_FLAT_H_
+#define PERSISTENCE_LANDSCAPE_FLAT_H_
+
+#include <gudhi/Persistence_landscape.h>
+
+#include <vector>
+#include <utility>    // for std::pair
+#include <algorithm>  // for std::max, std::upper_bound
+#include <cmath>      // for std::abs, std::pow
+#include <cstddef>    // for std::size_t
+#include <limits>     // for std::numeric_limits
+
+namespace Gudhi {
+namespace Persistence_representations {
+
+/**
+ * \class Persistence_landscape_flat gudhi/Persistence_landscape_flat.h
+ * \brief Exact persistence landscape stored in a few flat arrays, with fast norms, distances and scalar products.
+ *
+ * \ingroup Persistence_representations
+ *
+ * \details
+ * This is the same piecewise linear function as `Persistence_landscape`, but the critical points of all the levels
+ * are stored in 2 arrays of abscissas and ordinates, the points of the level \f$k\f$ being those between
+ * `offsets[k]` and `offsets[k+1]`, without the points at infinity. This uses much less memory than one vector of
+ * pairs per level, and the distances and scalar products are computed by a single merge of the critical points of
+ * the 2 landscapes, without building their difference.
+ *
+ * It implements the concepts Topological_data_with_distances and Topological_data_with_scalar_product.
+**/
+class Persistence_landscape_flat {
+ public:
+  /** Empty landscape. */
+  Persistence_landscape_flat() : offsets_(1, 0) {}
+
+  /**
+   * Constructor from a vector of birth-death pairs. If `number_of_levels` is given, only the first levels are
+   * computed, which is faster when the diagram has many points.
+  **/
+  Persistence_landscape_flat(const std::vector<std::pair<double, double> >& p,
+                             std::size_t number_of_levels = std::numeric_limits<std::size_t>::max())
+      : Persistence_landscape_flat(Persistence_landscape(p, number_of_levels)) {}
+
+  /** Constructor from an existing landscape. */
+  explicit Persistence_landscape_flat(const Persistence_landscape& l) : offsets_(1, 0) {
+    offsets_.reserve(l.land.size() + 1);
+    for (const auto& level : l.land) {
+      // Skip the first and last points, at -infinity and +infinity
+      for (std::size_t i = 1; i + 1 < level.size(); ++i) {
+        x_.push_back(level[i].first);
+        y_.push_back(level[i].second);
+      }
+      offsets_.push_back(x_.size());
+    }
+  }
+
+  /** Number of levels. */
+  std::size_t size() const { return offsets_.size() - 1; }
+
+  /** Value of the level `level` at `x`, 0 if there is no such level. */
+  double compute_value_at_a_given_point(std::size_t level, double x) const {
+    if (level >= size()) return 0;
+    Level l = get_level(level);
+    const double* it = std::upper_bound(l.x, l.x + l.n, x);
+    if (it == l.x || it == l.x + l.n) return 0;
+    std::size_t i = it - l.x;
+    return interpolate(l, i, x);
+  }
+
+  /** Same as compute_value_at_a_given_point. */
+  double operator()(std::size_t level, double x) const { return compute_value_at_a_given_point(level, x); }
+
+  /**
+   * \f$L^p\f$ norm of the landscape, the sum over the levels of the integrals of their \f$p\f$-th powers, to the power
+   * \f$1/p\f$. For the max norm, set `p` to `std::numeric_limits<double>::max()`.
+  **/
+  double compute_norm(double p = 1) const { return distance(Persistence_landscape_flat(), p); }
+
+  /**
+   * \f$L^p\f$ distance to another landscape, computed exactly. For the max norm distance, set `power` to
+   * `std::numeric_limits<double>::max()`. This function is required in Topological_data_with_distances concept.
+  **/
+  double distance(const Persistence_landscape_flat& second, double power = 1) const {
+    const bool max_norm = power >= std::numeric_limits<double>::max();
+    double result = 0;
+    for (std::size_t level = 0; level < std::max(size(), second.size()); ++level) {
+      for_each_piece(get_level(level), second.get_level(level),
+                     [&](double x1, double x2, double f1, double f2, double g1, double g2) {
+                       const double h1 = std::abs(f1 - g1), h2 = std::abs(f2 - g2);
+                       if (max_norm) {
+                         result = std::max({result, h1, h2});
+                       } else if ((f1 - g1) * (f2 - g2) < 0) {
+                         // The difference vanishes inside the piece
+                         result += (x2 - x1) * (power_of(h1, power + 1) + power_of(h2, power + 1)) /
+                                   ((power + 1) * (h1 + h2));
+                       } else {
+                         result += (x2 - x1) * integral_of_power_on_unit_interval(h1, h2, power);
+                       }
+                     });
+    }
+    return max_norm || power == 1 ? result : std::pow(result, 1 / power);
+  }
+
+  /**
+   * Scalar product with another landscape, the sum over the levels of the integrals of the products.
+   * This function is required in Topological_data_with_scalar_product concept.
+  **/
+  double compute_scalar_product(const Persistence_landscape_flat& second) const {
+    double result = 0;
+    for (std::size_t level = 0; level < std::min(size(), second.size()); ++level) {
+      for_each_piece(get_level(level), second.get_level(level),
+                     [&](double x1, double x2, double f1, double f2, double g1, double g2) {
+                       result += (x2 - x1) * (2 * f1 * g1 + f1 * g2 + f2 * g1 + 2 * f2 * g2) / 6;
+                     });
+    }
+    return result;
+  }
+
+  /** Abscissas of the critical points of all the levels. */
+  const std::vector<double>& abscissas() const { return x_; }
+  /** Ordinates of the critical points of all the levels. */
+  const std::vector<double>& ordinates() const { return y_; }
+  /** The critical points of the level `k` are those between `offsets()[k]` and `offsets()[k+1]`. */
+  const std::vector<std::size_t>& offsets() const { return offsets_; }
+
+ private:
+  struct Level {
+    const double* x;
+    const double* y;
+    std::size_t n;
+  };
+
+  Level get_level(std::size_t level) const {
+    if (level >= size()) return {nullptr, nullptr, 0};
+    return {x_.data() + offsets_[level], y_.data() + offsets_[level], offsets_[level + 1] - offsets_[level]};
+  }
+
+  static double power_of(double x, double p) { return p == 1 ? x : p == 2 ? x * x : std::pow(x, p); }
+
+  // Integral on [0,1] of the p-th power of the linear function from h1 >= 0 to h2 >= 0. The closed form
+  // (h2^(p+1)-h1^(p+1))/((p+1)(h2-h1)) cancels catastrophically when h1 and h2 are close, as for parallel pieces.
+  static double integral_of_power_on_unit_interval(double h1, double h2, double p) {
+    if (p == 1) return (h1 + h2) / 2;
+    if (p == 2) return (h1 * h1 + h1 * h2 + h2 * h2) / 3;
+    if (std::abs(h2 - h1) <= 1e-4 * std::max(h1, h2)) return power_of((h1 + h2) / 2, p);
+    return (power_of(h2, p + 1) - power_of(h1, p + 1)) / ((p + 1) * (h2 - h1));
+  }
+
+  // Value at t of a level, where x[i-1] < t <= x[i].
+  static double interpolate(Level l, std::size_t i, double t) {
+    if (l.x[i] == t) return l.y[i];
+    return l.y[i - 1] + (l.y[i] - l.y[i - 1]) * (t - l.x[i - 1]) / (l.x[i] - l.x[i - 1]);
+  }
+
+  // Value at t of a level, where i is the first index such that x[i] >= t.
+  static double value_at(Level l, std::size_t i, double t) {
+    if (i == l.n || (i == 0 && l.x[0] > t)) return 0;
+    return interpolate(l, i, t);
+  }
+
+  // Calls f(x1, x2, f1, f2, g1, g2) on each interval [x1, x2] between 2 consecutive critical points of the union,
+  // where both levels are linear, with their values at the endpoints.
+  template <class F>
+  static void for_each_piece(Level a, Level b, F&& f) {
+    std::size_t i = 0, j = 0;
+    bool first = true;
+    double t_prev = 0, a_prev = 0, b_prev = 0;
+    while (i < a.n || j < b.n) {
+      const double t = (j == b.n || (i < a.n && a.x[i] <= b.x[j])) ? a.x[i] : b.x[j];
+      const double a_t = value_at(a, i, t), b_t = value_at(b, j, t);
+      if (!first) f(t_prev, t, a_prev, a_t, b_prev, b_t);
+      first = false;
+      t_prev = t;
+      a_prev = a_t;
+      b_prev = b_t;
+      while (i < a.n && a.x[i] == t) ++i;
+      while (j < b.n && b.x[j] == t) ++j;
+    }
+  }
+
+  std::vector<std::size_t> offsets_;
+  std::vector<double> x_;
+  std::vector<double> y_;
+};
+
+}  // namespace Persistence_representations
+}  // namespace Gudhi
+
+#endif  // PERSISTENCE_LANDSCAPE_FLAT_H_
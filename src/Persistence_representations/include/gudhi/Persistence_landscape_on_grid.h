@@ -5,6 +5,7 @@
  *    Copyright (C) 2016 Inria
  *
  *    Modification(s):
+ *      - 2023/10 David Loiseaux: Parallel and incremental construction.
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -27,6 +28,13 @@
 #include <utility>
 #include <string>
 #include <cstdint>
+#include <cstddef>  // for std::ptrdiff_t
+#include <map>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
 
 namespace Gudhi {
 namespace Persistence_representations {
@@ -795,6 +803,14 @@ class Persistence_landscape_on_grid {
    **/
   size_t number_of_vectorize_functions() const { return number_of_functions_for_vectorization; }
 
+  /**
+   * Adds the intervals of a persistence diagram to the landscape, on the same grid and with the same maximal number of
+   * levels, without recomputing the values of the intervals that are already there: the result is the landscape of
+   * the union of the diagrams. The grid points are shared between threads when TBB is available.
+   * Intervals outside of the grid only contribute to the grid points they cover.
+  **/
+  void add_intervals(const std::vector<std::pair<double, double> >& p);
+
   /**
    * A function to compute averaged persistence landscape on a grid, based on vector of persistence landscapes on grid.
    * This function is required by Topological_data_with_averages concept.
@@ -824,35 +840,27 @@ class Persistence_landscape_on_grid {
                    "the computations. \n";
     }
 
-    // for every point in the grid:
-    for (size_t grid_point = 0; grid_point != (to_average[0])->values_of_landscapes.size(); ++grid_point) {
-      // set up a vector of the correct size:
-      size_t maximal_size_of_vector = 0;
-      for (size_t land_no = 0; land_no != to_average.size(); ++land_no) {
-        if ((to_average[land_no])->values_of_landscapes[grid_point].size() > maximal_size_of_vector)
-          maximal_size_of_vector = (to_average[land_no])->values_of_landscapes[grid_point].size();
-      }
-      this->values_of_landscapes[grid_point] = std::vector<double>(maximal_size_of_vector);
-
-      if (dbg) {
-        std::clog << "We are considering the point : " << grid_point
-                  << " of the grid. In this point, there are at most : " << maximal_size_of_vector
-                  << " nonzero landscape functions \n";
-      }
+    // for every point in the grid, the ranges of grid points being shared between threads:
+    this->for_each_range_of_grid_points([&](std::size_t range_begin, std::size_t range_end) {
+      for (size_t grid_point = range_begin; grid_point != range_end; ++grid_point) {
+        // set up a vector of the correct size:
+        size_t maximal_size_of_vector = 0;
+        for (size_t land_no = 0; land_no != to_average.size(); ++land_no) {
+          if ((to_average[land_no])->values_of_landscapes[grid_point].size() > maximal_size_of_vector)
+            maximal_size_of_vector = (to_average[land_no])->values_of_landscapes[grid_point].size();
+        }
+        std::vector<double>& average = this->values_of_landscapes[grid_point];
+        average.assign(maximal_size_of_vector, 0.);
 
-      // and compute an arithmetic average:
-      for (size_t land_no = 0; land_no != to_average.size(); ++land_no) {
-        // summing:
-        for (size_t i = 0; i != (to_average[land_no])->values_of_landscapes[grid_point].size(); ++i) {
-          // compute the average in a smarter way.
-          this->values_of_landscapes[grid_point][i] += (to_average[land_no])->values_of_landscapes[grid_point][i];
+        // and compute an arithmetic average:
+        for (size_t land_no = 0; land_no != to_average.size(); ++land_no) {
+          const std::vector<double>& values = (to_average[land_no])->values_of_landscapes[grid_point];
+          for (size_t i = 0; i != values.size(); ++i) average[i] += values[i];
         }
+        // normalizing:
+        for (size_t i = 0; i != average.size(); ++i) average[i] /= static_cast<double>(to_average.size());
       }
-      // normalizing:
-      for (size_t i = 0; i != this->values_of_landscapes[grid_point].size(); ++i) {
-        this->values_of_landscapes[grid_point][i] /= static_cast<double>(to_average.size());
-      }
-    }
+    });
   }  // compute_average
 
   /**
@@ -924,8 +932,109 @@ class Persistence_landscape_on_grid {
                                    size_t number_of_points_,
                                    unsigned number_of_levels = std::numeric_limits<unsigned>::max());
   Persistence_landscape_on_grid multiply_lanscape_by_real_number_not_overwrite(double x) const;
+
+  // Calls fill(begin, end) on ranges of grid points that partition the grid, in parallel if TBB is available. The
+  // ranges are a few per thread, so that every range may iterate over all the intervals.
+  template <typename Fill>
+  void for_each_range_of_grid_points(Fill fill) const {
+    const std::size_t n = this->values_of_landscapes.size();
+#ifdef GUDHI_USE_TBB
+    const std::size_t number_of_ranges =
+        std::min(n, static_cast<std::size_t>(4 * tbb::this_task_arena::max_concurrency()));
+    tbb::parallel_for(std::size_t(0), number_of_ranges,
+                      [&](std::size_t r) { fill(n * r / number_of_ranges, n * (r + 1) / number_of_ranges); });
+#else
+    fill(0, n);
+#endif
+  }
+
+  // maximal number of values kept at each grid point, std::numeric_limits<unsigned>::max() for all of them
+  unsigned number_of_levels_ = std::numeric_limits<unsigned>::max();
 };
 
+void Persistence_landscape_on_grid::add_intervals(const std::vector<std::pair<double, double> >& p) {
+  if (p.empty()) return;
+  const std::ptrdiff_t last_point = static_cast<std::ptrdiff_t>(this->values_of_landscapes.size()) - 1;
+  if (last_point < 1) throw "The landscape is not defined on a grid, intervals cannot be added to it.\n";
+  const double dx = (this->grid_max - this->grid_min) / static_cast<double>(last_point);
+
+  // The tent of an interval goes up by dx at each grid point from the point after its birth until its midpoint, and
+  // then down by dx until its death (the point of the birth itself is the top if it is the midpoint). The values are
+  // accumulated by steps of dx, as the integrals compare consecutive values exactly, and as they only depend on the
+  // height of the top, they are computed once in ascent, and once in a descent per height of top.
+  struct Tent {
+    std::ptrdiff_t begin, midpoint, end;
+    const std::vector<double>* descent;
+  };
+  std::vector<Tent> tents;
+  tents.reserve(p.size());
+  std::map<std::ptrdiff_t, std::vector<double> > descents;
+  std::ptrdiff_t highest_top = 1;
+  for (const auto& interval : p) {
+    Tent tent;
+    tent.begin = static_cast<std::ptrdiff_t>((interval.first - this->grid_min) / dx);
+    tent.end = static_cast<std::ptrdiff_t>((interval.second - this->grid_min) / dx);
+    tent.midpoint = static_cast<std::ptrdiff_t>(0.5 * (tent.begin + tent.end));
+    const std::ptrdiff_t top = std::max(tent.midpoint - tent.begin, std::ptrdiff_t(1));
+    highest_top = std::max(highest_top, top);
+    tent.descent = &descents[top];
+    tents.push_back(tent);
+  }
+  // ascent[k] is the value k grid points after the birth, and the descents start at ascent[top]
+  std::vector<double> ascent(highest_top + 1, 0.);
+  double landscape_value = dx;
+  for (std::ptrdiff_t k = 1; k <= highest_top; ++k) {
+    ascent[k] = landscape_value;
+    landscape_value += dx;
+  }
+  std::vector<std::pair<const std::ptrdiff_t, std::vector<double> >*> tops;
+  for (auto& top : descents) tops.push_back(&top);
+  auto compute_descent = [&](std::size_t t) {
+    std::vector<double>& descent = tops[t]->second;
+    for (double value = ascent[tops[t]->first]; value > 0; value -= dx) descent.push_back(value);
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), tops.size(), compute_descent);
+#else
+  for (std::size_t t = 0; t != tops.size(); ++t) compute_descent(t);
+#endif
+
+  // The values at each grid point are kept sorted in decreasing order. Only the number_of_levels_ largest ones are
+  // kept, with a heap of the smallest one on top while the intervals are added.
+  const unsigned levels = this->number_of_levels_;
+  const bool all_levels = levels == std::numeric_limits<unsigned>::max();
+  auto fill = [&](std::size_t range_begin, std::size_t range_end) {
+    const std::ptrdiff_t lo = range_begin, hi = range_end;
+    if (!all_levels) {
+      for (std::ptrdiff_t i = lo; i < hi; ++i)
+        std::make_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end(),
+                       std::greater<double>());
+    }
+    for (const Tent& tent : tents) {
+      const std::ptrdiff_t first = std::max(lo, std::min(tent.begin + 1, tent.midpoint));
+      const std::ptrdiff_t past_last =
+          std::min({hi, tent.end + 1, tent.midpoint + static_cast<std::ptrdiff_t>(tent.descent->size())});
+      for (std::ptrdiff_t i = first; i < past_last; ++i) {
+        const double value = i < tent.midpoint ? ascent[i - tent.begin] : (*tent.descent)[i - tent.midpoint];
+        std::vector<double>& values = this->values_of_landscapes[i];
+        if (all_levels) {
+          values.push_back(value);
+        } else if (values.size() < levels) {
+          values.push_back(value);
+          std::push_heap(values.begin(), values.end(), std::greater<double>());
+        } else if (levels > 0 && value > values.front()) {
+          std::pop_heap(values.begin(), values.end(), std::greater<double>());
+          values.back() = value;
+          std::push_heap(values.begin(), values.end(), std::greater<double>());
+        }
+      }
+    }
+    for (std::ptrdiff_t i = lo; i < hi; ++i)
+      std::sort(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end(), std::greater<double>());
+  };
+  this->for_each_range_of_grid_points(fill);
+}
+
 void Persistence_landscape_on_grid::set_up_values_of_landscapes(const std::vector<std::pair<double, double> >& p,
                                                                 double grid_min_, double grid_max_,
                                                                 size_t number_of_points_, unsigned number_of_levels) {
@@ -956,117 +1065,15 @@ void Persistence_landscape_on_grid::set_up_values_of_landscapes(const std::vecto
     }
   }
 
-  // if number_of_levels == std::numeric_limits<size_t>::max(), then we will have all the nonzero values of landscapes,
-  // and will store them in a vector
-  // if number_of_levels != std::numeric_limits<size_t>::max(), then we will use those vectors as heaps.
-  this->values_of_landscapes = std::vector<std::vector<double> >(number_of_points_ + 1);
-
-  this->grid_min = grid_min_;
-  this->grid_max = grid_max_;
-
   if (grid_max_ <= grid_min_) {
     throw "Wrong parameters of grid_min and grid_max given to the procedure. The program will now terminate.\n";
   }
 
-  double dx = (grid_max_ - grid_min_) / static_cast<double>(number_of_points_);
-  // for every interval in the diagram:
-  for (size_t int_no = 0; int_no != p.size(); ++int_no) {
-    size_t grid_interval_begin = (p[int_no].first - grid_min_) / dx;
-    size_t grid_interval_end = (p[int_no].second - grid_min_) / dx;
-    size_t grid_interval_midpoint = (size_t)(0.5 * (grid_interval_begin + grid_interval_end));
-
-    if (dbg) {
-      std::clog << "Considering an interval : " << p[int_no].first << "," << p[int_no].second << std::endl;
-
-      std::clog << "grid_interval_begin : " << grid_interval_begin << std::endl;
-      std::clog << "grid_interval_end : " << grid_interval_end << std::endl;
-      std::clog << "grid_interval_midpoint : " << grid_interval_midpoint << std::endl;
-    }
-
-    double landscape_value = dx;
-    for (size_t i = grid_interval_begin + 1; i < grid_interval_midpoint; ++i) {
-      if (dbg) {
-        std::clog << "Adding landscape value (going up) for a point : " << i << " equal : " << landscape_value
-                  << std::endl;
-      }
-      if (number_of_levels != std::numeric_limits<unsigned>::max()) {
-        // we have a heap of no more that number_of_levels values.
-        // Note that if we are using heaps, we want to know the shortest distance in the heap.
-        // This is achieved by putting -distance to the heap.
-        if (this->values_of_landscapes[i].size() >= number_of_levels) {
-          // in this case, the full heap is build, and we need to check if the landscape_value is not larger than the
-          // smallest element in the heap.
-          if (-landscape_value < this->values_of_landscapes[i].front()) {
-            // if it is, we remove the largest value in the heap, and move on.
-            std::pop_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
-            this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1] = -landscape_value;
-            std::push_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
-          }
-        } else {
-          // in this case we are still filling in the array.
-          this->values_of_landscapes[i].push_back(-landscape_value);
-          if (this->values_of_landscapes[i].size() == number_of_levels - 1) {
-            // this->values_of_landscapes[i].size() == number_of_levels
-            // in this case we need to create the heap.
-            std::make_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
-          }
-        }
-      } else {
-        // we have vector of all values
-        this->values_of_landscapes[i].push_back(landscape_value);
-      }
-      landscape_value += dx;
-    }
-    for (size_t i = grid_interval_midpoint; i <= grid_interval_end; ++i) {
-      if (landscape_value > 0) {
-        if (number_of_levels != std::numeric_limits<unsigned>::max()) {
-          // we have a heap of no more that number_of_levels values
-          if (this->values_of_landscapes[i].size() >= number_of_levels) {
-            // in this case, the full heap is build, and we need to check if the landscape_value is not larger than the
-            // smallest element in the heap.
-            if (-landscape_value < this->values_of_landscapes[i].front()) {
-              // if it is, we remove the largest value in the heap, and move on.
-              std::pop_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
-              this->values_of_landscapes[i][this->values_of_landscapes[i].size() - 1] = -landscape_value;
-              std::push_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
-            }
-          } else {
-            // in this case we are still filling in the array.
-            this->values_of_landscapes[i].push_back(-landscape_value);
-            if (this->values_of_landscapes[i].size() == number_of_levels - 1) {
-              // this->values_of_landscapes[i].size() == number_of_levels
-              // in this case we need to create the heap.
-              std::make_heap(this->values_of_landscapes[i].begin(), this->values_of_landscapes[i].end());
-            }
-          }
-        } else {
-          this->values_of_landscapes[i].push_back(landscape_value);
-        }
-
-        if (dbg) {
-          std::clog << "Adding landscape value (going down) for a point : " << i << " equal : " << landscape_value
-                    << std::endl;
-        }
-      }
-      landscape_value -= dx;
-    }
-  }
-
-  if (number_of_levels != std::numeric_limits<unsigned>::max()) {
-    // in this case, vectors are used as heaps. And, since we want to have the smallest element at the top of
-    // each heap, we store minus distances. To get if right at the end, we need to multiply each value
-    // in the heap by -1 to get real vector of distances.
-    for (size_t pt = 0; pt != this->values_of_landscapes.size(); ++pt) {
-      for (size_t j = 0; j != this->values_of_landscapes[pt].size(); ++j) {
-        this->values_of_landscapes[pt][j] *= -1;
-      }
-    }
-  }
-
-  // and now we need to sort the values:
-  for (size_t pt = 0; pt != this->values_of_landscapes.size(); ++pt) {
-    std::sort(this->values_of_landscapes[pt].begin(), this->values_of_landscapes[pt].end(), std::greater<double>());
-  }
+  this->values_of_landscapes = std::vector<std::vector<double> >(number_of_points_ + 1);
+  this->grid_min = grid_min_;
+  this->grid_max = grid_max_;
+  this->number_of_levels_ = number_of_levels;
+  this->add_intervals(p);
 }  // set_up_values_of_landscapes
 
 Persistence_landscape_on_grid::Persistence_landscape_on_grid(const std::vector<std::pair<double, double> >& p,
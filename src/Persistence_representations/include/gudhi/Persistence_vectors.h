@@ -5,6 +5,7 @@
  *    Copyright (C) 2016 Inria
  *
  *    Modification(s):
+ *      - 2023/10 David Loiseaux: Only the pairs that can be among the largest values are computed.
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -22,6 +23,7 @@
 #include <iostream>
 #include <limits>
 #include <functional>
+#include <numeric>  // for std::iota
 #include <utility>
 #include <vector>
 
@@ -74,8 +76,7 @@ class Vector_distances_in_diagram {
   /**
    *  Writing to a stream.
   **/
-  template <typename K>
-  friend std::ostream& operator<<(std::ostream& out, const Vector_distances_in_diagram<K>& d) {
+  friend std::ostream& operator<<(std::ostream& out, const Vector_distances_in_diagram& d) {
     for (size_t i = 0; i != std::min(d.sorted_vector_of_distances.size(), d.where_to_cut); ++i) {
       out << d.sorted_vector_of_distances[i] << " ";
     }
@@ -335,8 +336,7 @@ Vector_distances_in_diagram<F>::Vector_distances_in_diagram(const std::vector<st
     : where_to_cut(where_to_cut_) {
   std::vector<std::pair<double, double> > i(intervals_);
   this->intervals = i;
-  // this->compute_sorted_vector_of_distances_via_heap( where_to_cut );
-  this->compute_sorted_vector_of_distances_via_vector_sorting(where_to_cut);
+  this->compute_sorted_vector_of_distances_via_heap(where_to_cut);
   this->set_up_numbers_of_functions_for_vectorization_and_projections_to_reals();
 }
 
@@ -352,93 +352,56 @@ Vector_distances_in_diagram<F>::Vector_distances_in_diagram(const char* filename
   }
   this->intervals = intervals;
   this->compute_sorted_vector_of_distances_via_heap(where_to_cut);
-  // this->compute_sorted_vector_of_distances_via_vector_sorting( where_to_cut );
   set_up_numbers_of_functions_for_vectorization_and_projections_to_reals();
 }
 
 template <typename F>
 void Vector_distances_in_diagram<F>::compute_sorted_vector_of_distances_via_heap(size_t where_to_cut) {
-  bool dbg = false;
-  if (dbg) {
-    std::clog << "Here are the intervals : \n";
-    for (size_t i = 0; i != this->intervals.size(); ++i) {
-      std::clog << this->intervals[i].first << " , " << this->intervals[i].second << std::endl;
-    }
-  }
-  where_to_cut = std::min(
-      where_to_cut, (size_t)(0.5 * this->intervals.size() * (this->intervals.size() - 1) + this->intervals.size()));
-
-  std::vector<double> heap(where_to_cut, std::numeric_limits<int>::max());
-  std::make_heap(heap.begin(), heap.end());
+  const size_t n = this->intervals.size();
+  where_to_cut = std::min(where_to_cut, n * (n - 1) / 2 + n);
+  this->sorted_vector_of_distances.clear();
+  if (where_to_cut == 0) return;
   F f;
 
-  // for every pair of points in the diagram, compute the minimum of their distance, and distance of those points from
-  // diagonal
-  for (size_t i = 0; i < this->intervals.size(); ++i) {
-    for (size_t j = i + 1; j < this->intervals.size(); ++j) {
-      double value = std::min(
-          f(this->intervals[i], this->intervals[j]),
-          std::min(
-              f(this->intervals[i], std::make_pair(0.5 * (this->intervals[i].first + this->intervals[i].second),
-                                                   0.5 * (this->intervals[i].first + this->intervals[i].second))),
-              f(this->intervals[j], std::make_pair(0.5 * (this->intervals[j].first + this->intervals[j].second),
-                                                   0.5 * (this->intervals[j].first + this->intervals[j].second)))));
-
-      if (dbg) {
-        std::clog << "Value : " << value << std::endl;
-        std::clog << "heap.front() : " << heap.front() << std::endl;
-        getchar();
-      }
-
-      if (-value < heap.front()) {
-        if (dbg) {
-          std::clog << "Replacing : " << heap.front() << " with : " << -value << std::endl;
-          getchar();
-        }
-        // remove the first element from the heap
-        std::pop_heap(heap.begin(), heap.end());
-        // heap.pop_back();
-        // and put value there instead:
-        // heap.push_back(-value);
-        heap[where_to_cut - 1] = -value;
-        std::push_heap(heap.begin(), heap.end());
-      }
-    }
-  }
-
-  // now add distances of all points from diagonal
-  for (size_t i = 0; i < this->intervals.size(); ++i) {
-    double value = f(this->intervals[i], std::make_pair(0.5 * (this->intervals[i].first + this->intervals[i].second),
-                                                        0.5 * (this->intervals[i].first + this->intervals[i].second)));
-    if (-value < heap.front()) {
-      // remove the first element from the heap
-      std::pop_heap(heap.begin(), heap.end());
-      // heap.pop_back();
-      // and put value there instead:
-      // heap.push_back(-value);
-      heap[where_to_cut - 1] = -value;
-      std::push_heap(heap.begin(), heap.end());
-    }
-  }
-
-  std::sort_heap(heap.begin(), heap.end());
-  for (size_t i = 0; i != heap.size(); ++i) {
-    if (heap[i] == std::numeric_limits<int>::max()) {
-      heap[i] = 0;
-    } else {
-      heap[i] *= -1;
+  // distance of every point in the diagram from the diagonal, that bounds the value of every pair containing it
+  std::vector<double> to_diagonal(n);
+  for (size_t i = 0; i < n; ++i) {
+    double middle = 0.5 * (this->intervals[i].first + this->intervals[i].second);
+    to_diagonal[i] = f(this->intervals[i], std::make_pair(middle, middle));
+  }
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return to_diagonal[i] > to_diagonal[j]; });
+
+  // min-heap of the where_to_cut largest values found so far
+  std::vector<double> heap;
+  heap.reserve(where_to_cut);
+  auto is_full_above = [&](double bound) { return heap.size() == where_to_cut && bound <= heap.front(); };
+  auto push = [&](double value) {
+    if (heap.size() < where_to_cut) {
+      heap.push_back(value);
+      std::push_heap(heap.begin(), heap.end(), std::greater<double>());
+    } else if (value > heap.front()) {
+      std::pop_heap(heap.begin(), heap.end(), std::greater<double>());
+      heap.back() = value;
+      std::push_heap(heap.begin(), heap.end(), std::greater<double>());
     }
-  }
-
-  if (dbg) {
-    std::clog << "This is the heap after all the operations :\n";
-    for (size_t i = 0; i != heap.size(); ++i) {
-      std::clog << heap[i] << " ";
+  };
+
+  // The points are processed by decreasing distance from the diagonal, each one with the points before it: the
+  // minimum of their distance and of the distances of both points from the diagonal is then at most the distance of
+  // the current point from the diagonal. Once the heap is full of values at least as large, neither this pair nor any
+  // following one can change the result, and only the pairs among the most persistent points are computed.
+  for (size_t r = 0; r < n && !is_full_above(to_diagonal[order[r]]); ++r) {
+    const size_t i = order[r];
+    push(to_diagonal[i]);
+    for (size_t s = 0; s < r && !is_full_above(to_diagonal[i]); ++s) {
+      push(std::min(f(this->intervals[i], this->intervals[order[s]]), to_diagonal[i]));
     }
-    std::clog << std::endl;
   }
 
-  this->sorted_vector_of_distances = heap;
+  std::sort(heap.begin(), heap.end(), std::greater<double>());
+  this->sorted_vector_of_distances = std::move(heap);
 }
 
 template <typename F>
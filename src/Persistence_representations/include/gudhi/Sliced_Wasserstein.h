@@ -22,6 +22,11 @@
 #include <cmath>      // for std::abs, std::sqrt
 #include <stdexcept>  // for std::invalid_argument
 #include <random>     // for std::random_device
+#include <cstddef>    // for std::size_t
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
 
 namespace Gudhi {
 namespace Persistence_representations {
@@ -96,6 +101,20 @@ class Sliced_Wasserstein {
     }
   }
 
+  // Sum of |v1[j] - v2[j]|, where v1 is the merge of the sorted ranges [a1, e1) and [b1, f1), and v2 the merge of
+  // [a2, e2) and [b2, f2), without storing the merges. Both merges must have the same size.
+  static double l1_between_merges(const double* a1, const double* e1, const double* b1, const double* f1,
+                                  const double* a2, const double* e2, const double* b2, const double* f2) {
+    double f = 0;
+    while (a1 != e1 || b1 != f1) {
+      // Same choice as std::merge for equal values, which does not matter here
+      double x = (b1 == f1 || (a1 != e1 && !(*b1 < *a1))) ? *a1++ : *b1++;
+      double y = (b2 == f2 || (a2 != e2 && !(*b2 < *a2))) ? *a2++ : *b2++;
+      f += std::abs(x - y);
+    }
+    return f;
+  }
+
   // Compute the angle formed by two points of a PD
   double compute_angle(const Persistence_diagram& diag, int i, int j) const {
     if (diag[i].second == diag[j].second)
@@ -310,18 +329,13 @@ class Sliced_Wasserstein {
       }
     } else {
       double step = pi / this->approx;
-      std::vector<double> v1, v2;
       for (int i = 0; i < this->approx; i++) {
-        v1.clear();
-        v2.clear();
-        std::merge(this->projections[i].begin(), this->projections[i].end(), second.projections_diagonal[i].begin(),
-                   second.projections_diagonal[i].end(), std::back_inserter(v1));
-        std::merge(second.projections[i].begin(), second.projections[i].end(), this->projections_diagonal[i].begin(),
-                   this->projections_diagonal[i].end(), std::back_inserter(v2));
-
-        int n = v1.size();
-        double f = 0;
-        for (int j = 0; j < n; j++) f += std::abs(v1[j] - v2[j]);
+        const std::vector<double>& p1 = this->projections[i];
+        const std::vector<double>& d1 = this->projections_diagonal[i];
+        const std::vector<double>& p2 = second.projections[i];
+        const std::vector<double>& d2 = second.projections_diagonal[i];
+        double f = l1_between_merges(p1.data(), p1.data() + p1.size(), d2.data(), d2.data() + d2.size(),
+                                     p2.data(), p2.data() + p2.size(), d1.data(), d1.data() + d1.size());
         sw += f * step;
       }
     }
@@ -373,6 +387,83 @@ class Sliced_Wasserstein {
                      2 * this->compute_scalar_product(second));
   }
 
+  /** \brief Matrix of the Sliced Wasserstein distances between all the pairs of diagrams, approximated with approx
+   * directions.
+   * \ingroup Sliced_Wasserstein
+   *
+   * Each diagram is projected and sorted once per direction, the projections of all the diagrams on a direction are
+   * stored contiguously, and the pairs are computed in parallel if TBB is available. The values are the same as the
+   * ones of the pairwise functions.
+   *
+   * @param[in] diagrams persistence diagrams.
+   * @param[in] approx   number of directions, must be positive.
+   * @exception std::invalid_argument If approx is not positive.
+   */
+  static std::vector<std::vector<double> > compute_sliced_wasserstein_distance_matrix(
+      const std::vector<Persistence_diagram>& diagrams, int approx = 10) {
+    if (approx <= 0) throw std::invalid_argument("Error: the distance matrix needs a positive number of directions");
+    const std::size_t n = diagrams.size();
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (std::size_t d = 0; d < n; d++) offsets[d + 1] = offsets[d] + diagrams[d].size();
+    const std::size_t num_points = offsets[n];
+    // Projections of the diagram d on the direction i: projections[i * num_points + offsets[d] + k]
+    std::vector<double> projections(approx * num_points), projections_diagonal(approx * num_points);
+    double step = pi / approx;
+    for (int i = 0; i < approx; i++) {
+      for (std::size_t d = 0; d < n; d++) {
+        double* l = projections.data() + i * num_points + offsets[d];
+        double* l_diag = projections_diagonal.data() + i * num_points + offsets[d];
+        for (std::size_t j = 0; j < diagrams[d].size(); j++) {
+          // Same computation as build_rep
+          double px = diagrams[d][j].first;
+          double py = diagrams[d][j].second;
+          double proj_diag = (px + py) / 2;
+          l[j] = px * cos(-pi / 2 + i * step) + py * sin(-pi / 2 + i * step);
+          l_diag[j] = proj_diag * cos(-pi / 2 + i * step) + proj_diag * sin(-pi / 2 + i * step);
+        }
+        std::sort(l, l + diagrams[d].size());
+        std::sort(l_diag, l_diag + diagrams[d].size());
+      }
+    }
+
+    std::vector<std::vector<double> > matrix(n, std::vector<double>(n, 0.));
+    auto compute_row = [&](std::size_t a) {
+      for (std::size_t b = a + 1; b < n; b++) {
+        double sw = 0;
+        for (int i = 0; i < approx; i++) {
+          const double* p = projections.data() + i * num_points;
+          const double* q = projections_diagonal.data() + i * num_points;
+          double f = l1_between_merges(p + offsets[a], p + offsets[a + 1], q + offsets[b], q + offsets[b + 1],
+                                       p + offsets[b], p + offsets[b + 1], q + offsets[a], q + offsets[a + 1]);
+          sw += f * step;
+        }
+        matrix[a][b] = matrix[b][a] = sw / pi;
+      }
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), n, compute_row);
+#else
+    for (std::size_t a = 0; a < n; a++) compute_row(a);
+#endif
+    return matrix;
+  }
+
+  /** \brief Matrix of the Sliced Wasserstein kernel between all the pairs of diagrams, with the same conventions as
+   * compute_sliced_wasserstein_distance_matrix.
+   * \ingroup Sliced_Wasserstein
+   *
+   * @param[in] diagrams persistence diagrams.
+   * @param[in] sigma    bandwidth parameter.
+   * @param[in] approx   number of directions, must be positive.
+   */
+  static std::vector<std::vector<double> > compute_kernel_matrix(const std::vector<Persistence_diagram>& diagrams,
+                                                                 double sigma = 1.0, int approx = 10) {
+    std::vector<std::vector<double> > matrix = compute_sliced_wasserstein_distance_matrix(diagrams, approx);
+    for (auto& row : matrix)
+      for (auto& v : row) v = std::exp(-v / (2 * sigma * sigma));
+    return matrix;
+  }
+
 };  // class Sliced_Wasserstein
 }  // namespace Persistence_representations
 }  // namespace Gudhi
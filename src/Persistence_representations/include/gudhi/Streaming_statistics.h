@@ -0,0 +1,151 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef STREAMING_STATISTICS_H_
+#define STREAMING_STATISTICS_H_
+
+#include <vector>
+#include <string>
+#include <utility>   // for std::move
+#include <cstddef>   // for std::size_t
+#include <optional>
+
+namespace Gudhi {
+namespace Persistence_representations {
+
+namespace internal {
+
+// Persistence_landscape and Persistence_landscape_on_grid are read by load_landscape_from_file, the other
+// representations by load_from_file.
+template <typename Representation>
+auto load_representation(Representation& r, const char* filename, int) -> decltype(r.load_from_file(filename)) {
+  return r.load_from_file(filename);
+}
+
+template <typename Representation>
+auto load_representation(Representation& r, const char* filename, long)
+    -> decltype(r.load_landscape_from_file(filename)) {
+  return r.load_landscape_from_file(filename);
+}
+
+}  // namespace internal
+
+/**
+ * \brief Calls `f(i, r)` for each file `filenames[i]`, where `r` is the representation read from this file by its
+ * `load_from_file` (or `load_landscape_from_file`) method, as written by `print_to_file`.
+ *
+ * \ingroup Persistence_representations
+ *
+ * \details Only one representation is in memory at a time, so that statistics on a large collection of
+ * representations can be computed with `Running_average` or `Distances_to_references` in bounded memory.
+ * Some of the `load_from_file` methods append to the existing data, so each file is read in a new representation.
+ */
+template <typename Representation, typename Function>
+void for_each_representation_in_files(const std::vector<std::string>& filenames, Function&& f) {
+  for (std::size_t i = 0; i != filenames.size(); ++i) {
+    Representation r;
+    internal::load_representation(r, filenames[i].c_str(), 0);
+    f(i, r);
+  }
+}
+
+/**
+ * \class Running_average gudhi/Streaming_statistics.h
+ * \brief Mean and variance of representations given one at a time.
+ *
+ * \ingroup Persistence_representations
+ *
+ * \details
+ * The mean is updated with Welford's algorithm, \f$m_k = m_{k-1} + (x_k - m_{k-1}) / k\f$, so only the current mean is
+ * stored, instead of all the representations as in `compute_average`. The variance is the mean of the squared
+ * distances to the mean for the scalar product of the representation, \f$\frac{1}{n}\sum_k \|x_k - m_n\|^2\f$,
+ * accumulated as \f$M_k = M_{k-1} + \langle x_k - m_{k-1}, x_k - m_k\rangle\f$.
+ *
+ * \tparam Representation must implement the concept Topological_data_with_averages, with the operators `+`, `-` and
+ * `*` by a double of the representations of this package. The variance also requires the concept
+ * Topological_data_with_scalar_product.
+ */
+template <typename Representation>
+class Running_average {
+ public:
+  /** Adds a representation to the average. */
+  void add(const Representation& x) {
+    ++count_;
+    if (!mean_) {
+      mean_ = x;
+      return;
+    }
+    Representation delta = x - *mean_;
+    *mean_ = *mean_ + delta * (1. / count_);
+    if (with_variance_) {
+      Representation delta_new = x - *mean_;
+      sum_of_squares_ += delta.compute_scalar_product(delta_new);
+    }
+  }
+
+  /** Number of representations added so far. */
+  std::size_t count() const { return count_; }
+
+  /** Mean of the representations added so far. It must not be called before the first call to `add`. */
+  const Representation& mean() const { return *mean_; }
+
+  /** Mean of the squared distances of the representations to their mean, 0 if nothing was added. */
+  double variance() const { return count_ == 0 ? 0 : sum_of_squares_ / count_; }
+
+  /**
+   * Disables the computation of the variance, which requires a scalar product and costs 2 more operations per added
+   * representation. It must be called before the first call to `add`.
+   */
+  void disable_variance() { with_variance_ = false; }
+
+ private:
+  std::size_t count_ = 0;
+  std::optional<Representation> mean_;
+  double sum_of_squares_ = 0;
+  bool with_variance_ = true;
+};
+
+/**
+ * \class Distances_to_references gudhi/Streaming_statistics.h
+ * \brief Distances of representations given one at a time to a fixed set of references.
+ *
+ * \ingroup Persistence_representations
+ *
+ * \details Only the references are stored, so one row of the (number of representations) x (number of references)
+ * distance matrix can be computed at a time, for instance for each representation given by
+ * `for_each_representation_in_files`.
+ *
+ * \tparam Representation must implement the concept Topological_data_with_distances.
+ */
+template <typename Representation>
+class Distances_to_references {
+ public:
+  /** @param[in] references The reference representations, which are copied. */
+  explicit Distances_to_references(std::vector<Representation> references) : references_(std::move(references)) {}
+
+  /** Distances between `x` and each reference, for the given power (see the `distance` methods). */
+  std::vector<double> operator()(const Representation& x, double power = 1) const {
+    std::vector<double> result;
+    result.reserve(references_.size());
+    for (const Representation& reference : references_) result.push_back(x.distance(reference, power));
+    return result;
+  }
+
+  /** Number of references. */
+  std::size_t size() const { return references_.size(); }
+
+ private:
+  std::vector<Representation> references_;
+};
+
+}  // namespace Persistence_representations
+}  // namespace Gudhi
+
+#endif  // STREAMING_STATISTICS_H_
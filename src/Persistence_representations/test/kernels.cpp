@@ -47,3 +47,22 @@ BOOST_AUTO_TEST_CASE(check_SW) {
   SW sw2(v2, 1.0, 100); SW swex2(v2, 1.0, -1);
   BOOST_CHECK(std::abs(sw1.compute_scalar_product(sw2) - swex1.compute_scalar_product(swex2)) <= 1e-1);
 }
+
+BOOST_AUTO_TEST_CASE(check_SW_matrix) {
+  std::vector<Persistence_diagram> diagrams(5);
+  for (int d = 0; d < 5; d++)
+    for (int i = 0; i <= 2 * d; i++) diagrams[d].emplace_back(0.3 * i + d, 0.5 * i + 2 * d + 1);
+  diagrams[2].clear();
+  auto kernel = SW::compute_kernel_matrix(diagrams, 2.0, 20);
+  auto dist = SW::compute_sliced_wasserstein_distance_matrix(diagrams, 20);
+  for (int a = 0; a < 5; a++) {
+    SW swa(diagrams[a], 2.0, 20);
+    BOOST_CHECK_EQUAL(dist[a][a], 0.);
+    for (int b = 0; b < 5; b++) {
+      SW swb(diagrams[b], 2.0, 20);
+      BOOST_CHECK_EQUAL(dist[a][b], dist[b][a]);
+      if (a != b) BOOST_CHECK_EQUAL(kernel[a][b], swa.compute_scalar_product(swb));
+    }
+  }
+  BOOST_CHECK_THROW(SW::compute_sliced_wasserstein_distance_matrix(diagrams, -1), std::invalid_argument);
+}
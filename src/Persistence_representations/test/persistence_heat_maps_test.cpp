@@ -33,6 +33,25 @@ BOOST_AUTO_TEST_CASE(check_construction_of_heat_maps) {
   BOOST_CHECK(p == q);
 }
 
+BOOST_AUTO_TEST_CASE(check_separable_construction_of_heat_maps) {
+  std::vector<std::pair<double, double> > diag =
+      read_persistence_intervals_in_one_dimension_from_file("data/file_with_diagram");
+  for (bool erase_below_diagonal : {false, true}) {
+    Persistence_heat_maps<distance_from_diagonal_scaling> p(diag, create_Gaussian_filter(15, 1), erase_below_diagonal,
+                                                            200);
+    Persistence_heat_maps<distance_from_diagonal_scaling> q(diag, create_Gaussian_filter_1d(15, 1),
+                                                            erase_below_diagonal, 200);
+    BOOST_CHECK(p.get_min() == q.get_min() && p.get_max() == q.get_max());
+    std::vector<double> vp = p.vectorize(0), vq = q.vectorize(0);
+    BOOST_CHECK(vp.size() == vq.size());
+    for (size_t i = 0; i != vp.size(); ++i) GUDHI_TEST_FLOAT_EQUALITY_CHECK(vp[i], vq[i], 1e-12);
+  }
+  // The points close to the border of a smaller window contribute only partially
+  Persistence_heat_maps<constant_scaling_function> p(diag, create_Gaussian_filter(30, 1), false, 100, 0.2, 0.6);
+  Persistence_heat_maps<constant_scaling_function> q(diag, create_Gaussian_filter_1d(30, 1), false, 100, 0.2, 0.6);
+  BOOST_CHECK(p == q);
+}
+
 BOOST_AUTO_TEST_CASE(check_averages_of_heat_maps) {
   std::vector<std::vector<double> > filter = create_Gaussian_filter(30, 1);
   Persistence_heat_maps<constant_scaling_function> p("data/file_with_diagram", filter, false, 1000, 0, 10);
@@ -214,6 +214,31 @@ BOOST_AUTO_TEST_CASE(check_computations_of_scalar_product) {
   GUDHI_TEST_FLOAT_EQUALITY_CHECK(p.compute_scalar_product(q), 0.754367, epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(check_incremental_construction) {
+  std::vector<std::pair<double, double> > first = read_persistence_intervals_in_one_dimension_from_file(
+      "data/file_with_diagram");
+  std::vector<std::pair<double, double> > second = read_persistence_intervals_in_one_dimension_from_file(
+      "data/file_with_diagram_1");
+  std::vector<std::pair<double, double> > both(first);
+  both.insert(both.end(), second.begin(), second.end());
+
+  for (unsigned levels : {3u, std::numeric_limits<unsigned>::max()}) {
+    Persistence_landscape_on_grid all(both, 0., 1., 500, levels);
+    Persistence_landscape_on_grid incremental(first, 0., 1., 500, levels);
+    incremental.add_intervals(second);
+    BOOST_CHECK(incremental.output_for_visualization() == all.output_for_visualization());
+  }
+
+  // Only the largest levels are kept
+  Persistence_landscape_on_grid all(both, 0., 1., 500);
+  Persistence_landscape_on_grid three_levels(both, 0., 1., 500, 3);
+  for (std::size_t i = 0; i != all.output_for_visualization().size(); ++i) {
+    std::vector<double> values = all.output_for_visualization()[i];
+    if (values.size() > 3) values.resize(3);
+    BOOST_CHECK(three_levels.output_for_visualization()[i] == values);
+  }
+}
+
 // Below I am storing the code used to generate tests for that functionality.
 /*
         Persistence_landscape_on_grid l( "file_with_diagram_1" , 100 );
@@ -13,6 +13,7 @@
 #include <boost/test/unit_test.hpp>
 #include <gudhi/reader_utils.h>
 #include <gudhi/Persistence_landscape.h>
+#include <gudhi/Persistence_landscape_flat.h>
 #include <gudhi/Unitary_tests_utils.h>
 
 #include <iostream>
@@ -218,6 +219,39 @@ BOOST_AUTO_TEST_CASE(check_computations_of_scalar_product) {
   GUDHI_TEST_FLOAT_EQUALITY_CHECK(p.compute_scalar_product(q), 0.754498, epsilon);
 }
 
+BOOST_AUTO_TEST_CASE(check_flat_landscape) {
+  std::vector<std::pair<double, double> > diag =
+      read_persistence_intervals_in_one_dimension_from_file("data/file_with_diagram");
+  std::vector<std::pair<double, double> > diag2 =
+      read_persistence_intervals_in_one_dimension_from_file("data/file_with_diagram_1");
+  Persistence_landscape p(diag), q(diag2);
+  Persistence_landscape_flat fp(diag), fq(diag2);
+  BOOST_CHECK(fp.size() == p.size());
+  BOOST_CHECK(fp.offsets().back() == fp.abscissas().size());
+  for (unsigned level = 0; level != 4; ++level) {
+    for (double x : {0.0, 0.1, 0.25, 0.5, 0.7}) {
+      GUDHI_TEST_FLOAT_EQUALITY_CHECK(fp(level, x), p(level, x), epsilon);
+    }
+  }
+  for (double power : {1., 2., 3.5, std::numeric_limits<double>::max()}) {
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(fp.distance(fq, power), p.distance(q, power), epsilon);
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(fq.distance(fp, power), p.distance(q, power), epsilon);
+  }
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(fp.compute_norm(1), p.compute_integral_of_landscape(), epsilon);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(fp.compute_norm(std::numeric_limits<double>::max()), p.compute_maximum(), epsilon);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(fp.compute_scalar_product(fq), p.compute_scalar_product(q), epsilon);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(fp.distance(fp, 2), 0., epsilon);
+
+  // Only the first levels
+  Persistence_landscape_flat fp2(diag, 2);
+  BOOST_CHECK(fp2.size() == 2);
+  for (double x : {0.1, 0.25, 0.5}) {
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(fp2(1, x), p(1, x), epsilon);
+    BOOST_CHECK(fp2(2, x) == 0);
+  }
+  BOOST_CHECK(Persistence_landscape_flat().compute_norm(2) == 0);
+}
+
 // Below I am storing the code used to generate tests for that functionality.
 /*
 if ( argc != 2 )
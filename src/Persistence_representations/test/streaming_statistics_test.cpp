@@ -0,0 +1,92 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "streaming_statistics_test"
+#include <boost/test/unit_test.hpp>
+#include <gudhi/Streaming_statistics.h>
+#include <gudhi/Persistence_landscape.h>
+#include <gudhi/Persistence_heat_maps.h>
+#include <gudhi/Unitary_tests_utils.h>
+
+#include <string>
+#include <vector>
+
+using namespace Gudhi::Persistence_representations;
+
+static const std::vector<std::string> diagrams = {"data/file_with_diagram", "data/file_with_diagram_1",
+                                                  "data/file_with_diagram_2"};
+
+// Mean of the squared distances to the mean, computed with all the representations in memory.
+template <class Representation>
+double direct_variance(std::vector<Representation> representations, Representation mean) {
+  double sum = 0;
+  for (Representation& r : representations) {
+    Representation d = r - mean;
+    sum += d.compute_scalar_product(d);
+  }
+  return sum / representations.size();
+}
+
+BOOST_AUTO_TEST_CASE(check_streaming_statistics_of_landscapes) {
+  std::vector<Persistence_landscape> landscapes;
+  std::vector<std::string> files;
+  for (const std::string& diagram : diagrams) {
+    files.push_back(diagram + "_streamed_landscape");
+    Persistence_landscape(diagram.c_str()).print_to_file(files.back().c_str());
+    // The files are written with a limited precision, so the reference values use what they contain
+    landscapes.emplace_back();
+    landscapes.back().load_landscape_from_file(files.back().c_str());
+  }
+  Persistence_landscape average;
+  average.compute_average({&landscapes[0], &landscapes[1], &landscapes[2]});
+
+  Running_average<Persistence_landscape> running;
+  Distances_to_references<Persistence_landscape> to_references({landscapes[0], landscapes[2]});
+  BOOST_CHECK(to_references.size() == 2);
+  for_each_representation_in_files<Persistence_landscape>(files, [&](std::size_t i, const Persistence_landscape& l) {
+    running.add(l);
+    std::vector<double> d = to_references(l, 2);
+    BOOST_CHECK(d.size() == 2);
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(d[0], landscapes[i].distance(landscapes[0], 2), 1e-6);
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(d[1], landscapes[i].distance(landscapes[2], 2), 1e-6);
+  });
+  BOOST_CHECK(running.count() == 3);
+  BOOST_CHECK(running.mean().distance(average) < 1e-6);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(running.variance(), direct_variance(landscapes, average), 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(check_streaming_statistics_of_heat_maps) {
+  typedef Persistence_heat_maps<constant_scaling_function> Heat_map;
+  std::vector<std::vector<double> > filter = create_Gaussian_filter(30, 1);
+  std::vector<Heat_map> maps;
+  std::vector<std::string> files;
+  for (const std::string& diagram : diagrams) {
+    files.push_back(diagram + "_streamed_heat_map");
+    Heat_map(diagram.c_str(), filter, false, 1000, 0, 10).print_to_file(files.back().c_str());
+    maps.emplace_back();
+    maps.back().load_from_file(files.back().c_str());
+  }
+  Heat_map average;
+  average.compute_average({&maps[0], &maps[1], &maps[2]});
+
+  Running_average<Heat_map> running;
+  // Each file must be read in a new heat map, load_from_file appends to the existing one
+  for_each_representation_in_files<Heat_map>(files, [&](std::size_t, const Heat_map& h) { running.add(h); });
+  BOOST_CHECK(running.count() == 3);
+  BOOST_CHECK(running.mean().distance(average) < 1e-6);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(running.variance(), direct_variance(maps, average), 1e-6);
+
+  Running_average<Heat_map> mean_only;
+  mean_only.disable_variance();
+  for (const Heat_map& h : maps) mean_only.add(h);
+  BOOST_CHECK(mean_only.variance() == 0);
+  BOOST_CHECK(mean_only.mean().distance(average) < 1e-6);
+}
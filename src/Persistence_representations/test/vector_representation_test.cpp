@@ -20,6 +20,9 @@
 #include <vector>
 #include <cmath>
 #include <iomanip>
+#include <random>
+#include <algorithm>  // for std::sort
+#include <functional>  // for std::greater
 
 using namespace Gudhi;
 using namespace Gudhi::Persistence_representations;
@@ -367,3 +370,50 @@ BOOST_AUTO_TEST_CASE(check_arythmetic_operations) {
   BOOST_CHECK(almost_equal(prod1.vector_in_position(4), 1.41421));
   BOOST_CHECK(almost_equal(prod1.vector_in_position(5), 1.41421));
 }
+
+// All the values, sorted, computed from every pair of points
+template <typename F>
+std::vector<double> all_sorted_distances(const std::vector<std::pair<double, double> >& intervals) {
+  F f;
+  std::vector<double> to_diagonal;
+  for (auto& interval : intervals) {
+    double middle = 0.5 * (interval.first + interval.second);
+    to_diagonal.push_back(f(interval, std::make_pair(middle, middle)));
+  }
+  std::vector<double> distances(to_diagonal);
+  for (std::size_t i = 0; i < intervals.size(); ++i)
+    for (std::size_t j = i + 1; j < intervals.size(); ++j)
+      distances.push_back(std::min(f(intervals[i], intervals[j]), std::min(to_diagonal[i], to_diagonal[j])));
+  std::sort(distances.begin(), distances.end(), std::greater<double>());
+  return distances;
+}
+
+template <typename F>
+void check_largest_distances(const std::vector<std::pair<double, double> >& intervals) {
+  std::vector<double> expected = all_sorted_distances<F>(intervals);
+  for (std::size_t where_to_cut : {std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(50), expected.size(),
+                                   expected.size() + 3}) {
+    Vector_distances_in_diagram<F> v(intervals, where_to_cut);
+    BOOST_CHECK(v.size() == std::min(where_to_cut, expected.size()));
+    for (std::size_t i = 0; i < v.size(); ++i) BOOST_CHECK(v.vector_in_position(i) == expected[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(check_largest_distances_same_as_all_pairs) {
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> birth(0., 10.);
+  std::exponential_distribution<double> life_time(1.);
+  std::vector<std::pair<double, double> > intervals;
+  for (int i = 0; i < 200; ++i) {
+    double b = birth(gen);
+    intervals.emplace_back(b, b + life_time(gen));
+  }
+  // Points far from the diagonal but close to each other, and duplicates
+  for (int i = 0; i < 20; ++i) intervals.emplace_back(1., 20. + 0.01 * i);
+  intervals.emplace_back(3., 4.);
+  intervals.emplace_back(3., 4.);
+  check_largest_distances<Euclidean_distance>(intervals);
+  check_largest_distances<Maximum_distance<double> >(intervals);
+  check_largest_distances<Euclidean_distance>({});
+  check_largest_distances<Euclidean_distance>({{1., 2.}});
+}
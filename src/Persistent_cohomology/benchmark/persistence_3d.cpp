@@ -0,0 +1,82 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/Clock.h>
+#include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Persistence_on_cuboid.h>
+
+#include <vector>
+#include <cstdlib>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+// Set to true to test on an input with many equal values.
+const bool quantized = false;
+
+int main() {
+  std::vector<unsigned> sizes {40, 31, 23};
+  std::vector<double> data(sizes[0] * sizes[1] * sizes[2]);
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_real_distribution<double> dist(0., 1.);
+  std::generate(data.begin(), data.end(), std::bind(dist, gen));
+  if (quantized)
+    for (auto& x : data) x = std::floor(x * 8);
+
+  Gudhi::Clock clock;
+#ifndef ONLY_3D
+  Gudhi::Clock clock_old;
+  typedef Gudhi::cubical_complex::Bitmap_cubical_complex_base<double> Base;
+  typedef Gudhi::cubical_complex::Bitmap_cubical_complex<Base> Cubical;
+  Cubical complex_from_top_cells(sizes, data, true);
+  std::clog << "Construction from top cells: " << clock;
+
+  clock.begin();
+  using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+  Gudhi::persistent_cohomology::Persistent_cohomology<Cubical, Field_Zp> pers(complex_from_top_cells);
+  pers.init_coefficients(2);
+  pers.compute_persistent_cohomology();
+  std::clog << "Compute persistent homology: " << clock;
+  std::vector<std::pair<double, double>> res1[3];
+  for (auto p : pers.get_persistent_pairs()) {
+    double b = complex_from_top_cells.filtration(std::get<0>(p));
+    double d = complex_from_top_cells.filtration(std::get<1>(p));
+    if (b < d) res1[complex_from_top_cells.dimension(std::get<0>(p))].emplace_back(b, d);
+  }
+  std::clog << "Total old code: " << clock_old << std::endl;
+#endif
+
+  clock.begin();
+  std::vector<std::pair<double, double>> res2[3];
+  auto out = [&res2](int dim) { return [&res2, dim](double b, double d) { if (b < d) res2[dim].emplace_back(b, d); }; };
+  // Bitmap_cubical_complex stores the first coordinate contiguously, so the shape is reversed.
+  double global_min = Gudhi::cubical_complex::persistence_on_cuboid_from_top_cells(
+      data.data(), std::size_t(sizes[2]), std::size_t(sizes[1]), std::size_t(sizes[0]), out(0), out(1), out(2));
+  res2[0].emplace_back(global_min, std::numeric_limits<double>::infinity());
+  std::clog << "Total new code: " << clock << std::endl;
+
+#ifndef ONLY_3D
+  for (int dim = 0; dim < 3; ++dim) {
+    std::sort(res1[dim].begin(), res1[dim].end());
+    std::sort(res2[dim].begin(), res2[dim].end());
+    if (res1[dim] != res2[dim]) {
+      std::cerr << "Bug in dimension " << dim << "!\n";
+      std::exit(-2 - dim);
+    }
+  }
+#endif
+
+  return 0;
+}
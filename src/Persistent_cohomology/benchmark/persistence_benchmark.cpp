@@ -0,0 +1,209 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// End-to-end persistence benchmark on synthetic point clouds (sphere, torus, clustered cloud), generated with
+// gudhi/random_point_generators.h. For Rips, Alpha, Cech and cubical complexes, the construction, the sorting of the
+// filtration (initialize_filtration), the reduction and the output of the diagram are timed separately. For each
+// stage are reported the time, the throughput in simplices per second, the peak resident set size of the process
+// and the number of allocations.
+//   persistence_benchmark [number of points]
+
+#include <gudhi/random_point_generators.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Rips_complex.h>
+#include <gudhi/Alpha_complex.h>
+#include <gudhi/Cech_complex.h>
+#include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/distance_functions.h>
+#include <gudhi/Clock.h>
+
+#include <CGAL/Epick_d.h>
+
+#include <sys/resource.h>  // for getrusage
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Number of calls of operator new since the start of the program
+static std::atomic<std::size_t> num_allocations{0};
+
+void* operator new(std::size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+using Kernel = CGAL::Epick_d<CGAL::Dynamic_dimension_tag>;
+using Point_d = Kernel::Point_d;
+using Simplex_tree = Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_persistence>;
+using Filtration_value = Simplex_tree::Filtration_value;
+using Rips_complex = Gudhi::rips_complex::Rips_complex<Filtration_value>;
+using Alpha_complex = Gudhi::alpha_complex::Alpha_complex<Kernel>;
+using Cech_complex = Gudhi::cech_complex::Cech_complex<Kernel, Simplex_tree>;
+using Bitmap_cubical_complex_base = Gudhi::cubical_complex::Bitmap_cubical_complex_base<double>;
+using Bitmap_cubical_complex = Gudhi::cubical_complex::Bitmap_cubical_complex<Bitmap_cubical_complex_base>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+
+// Peak resident set size of the process, in megabytes
+double peak_rss_mb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024. * 1024.);  // bytes
+#else
+  return usage.ru_maxrss / 1024.;  // kilobytes
+#endif
+}
+
+std::vector<std::vector<double>> to_coordinates(const std::vector<Point_d>& points) {
+  std::vector<std::vector<double>> coordinates;
+  for (const auto& p : points) coordinates.emplace_back(p.cartesian_begin(), p.cartesian_end());
+  return coordinates;
+}
+
+// Times a stage and prints its statistics, for a complex of num_simplices() simplices once the stage is done.
+template <class F, class Size>
+void stage(const std::string& name, F&& f, Size&& num_simplices) {
+  const std::size_t allocations = num_allocations.load();
+  Gudhi::Clock clock;
+  f();
+  clock.end();
+  const double seconds = clock.num_seconds();
+  const std::size_t size = num_simplices();
+  std::clog << "  " << name << " : " << seconds << " s, ";
+  if (seconds > 0) std::clog << size / seconds << " simplices/s, ";
+  std::clog << "peak RSS " << peak_rss_mb() << " MB, " << num_allocations.load() - allocations << " allocations"
+            << std::endl;
+}
+
+// Sorting, reduction and output of the persistence of a complex
+template <class FilteredComplex>
+void persistence(FilteredComplex& cpx) {
+  auto size = [&] { return static_cast<std::size_t>(cpx.num_simplices()); };
+  stage("initialize_filtration", [&] { cpx.initialize_filtration(); }, size);
+  Gudhi::persistent_cohomology::Persistent_cohomology<FilteredComplex, Field_Zp> pcoh(cpx);
+  stage("reduction", [&] {
+    pcoh.init_coefficients(2);
+    pcoh.compute_persistent_cohomology();
+  }, size);
+  std::ostringstream diagram;
+  stage("output", [&] { pcoh.output_diagram(diagram); }, size);
+}
+
+void benchmark_rips(const std::vector<Point_d>& points, double threshold, int dim_max) {
+  std::clog << " Rips complex" << std::endl;
+  const auto coordinates = to_coordinates(points);
+  Simplex_tree st;
+  auto size = [&] { return st.num_simplices(); };
+  stage("construction", [&] {
+    Rips_complex rips_complex(coordinates, threshold, Gudhi::Euclidean_distance());
+    rips_complex.create_complex(st, dim_max);
+  }, size);
+  persistence(st);
+}
+
+void benchmark_alpha(const std::vector<Point_d>& points) {
+  std::clog << " Alpha complex" << std::endl;
+  Simplex_tree st;
+  auto size = [&] { return st.num_simplices(); };
+  stage("construction", [&] {
+    Alpha_complex alpha_complex(points);
+    alpha_complex.create_complex(st);
+  }, size);
+  persistence(st);
+}
+
+void benchmark_cech(const std::vector<Point_d>& points, double radius, int dim_max) {
+  std::clog << " Cech complex" << std::endl;
+  Simplex_tree st;
+  auto size = [&] { return st.num_simplices(); };
+  stage("construction", [&] {
+    Cech_complex cech_complex(points, radius);
+    cech_complex.create_complex(st, dim_max);
+  }, size);
+  persistence(st);
+}
+
+// Cubical complex of the distance to the point cloud, sampled on a regular grid of its bounding box
+void benchmark_cubical(const std::vector<Point_d>& points, unsigned resolution) {
+  std::clog << " Cubical complex" << std::endl;
+  const auto coordinates = to_coordinates(points);
+  const int dim = coordinates.front().size();
+  std::vector<double> min(dim, INFINITY), max(dim, -INFINITY);
+  for (const auto& p : coordinates)
+    for (int i = 0; i < dim; i++) {
+      min[i] = std::min(min[i], p[i]);
+      max[i] = std::max(max[i], p[i]);
+    }
+  std::vector<unsigned> sizes(dim, resolution);
+  std::size_t num_cells = 1;
+  for (int i = 0; i < dim; i++) num_cells *= resolution;
+  std::vector<double> cells(num_cells, INFINITY);
+  for (std::size_t cell = 0; cell < num_cells; cell++) {
+    std::vector<double> center(dim);
+    std::size_t r = cell;
+    for (int i = 0; i < dim; i++, r /= resolution)
+      center[i] = min[i] + (max[i] - min[i]) * ((r % resolution) + .5) / resolution;
+    for (const auto& p : coordinates) {
+      double d = 0;
+      for (int i = 0; i < dim; i++) d += (center[i] - p[i]) * (center[i] - p[i]);
+      cells[cell] = std::min(cells[cell], d);
+    }
+  }
+  std::unique_ptr<Bitmap_cubical_complex> cpx;
+  auto size = [&] { return cpx ? static_cast<std::size_t>(cpx->num_simplices()) : std::size_t(0); };
+  stage("construction", [&] { cpx = std::make_unique<Bitmap_cubical_complex>(sizes, cells); }, size);
+  persistence(*cpx);
+}
+
+// Points in balls of radius 0.1 around 10 random centers of the unit cube
+std::vector<Point_d> generate_clustered_points(std::size_t num_points, int dim) {
+  const int num_clusters = 10;
+  const auto centers = to_coordinates(Gudhi::generate_points_in_cube_d<Kernel>(num_clusters, dim, 1.));
+  const auto offsets = to_coordinates(Gudhi::generate_points_in_ball_d<Kernel>(num_points, dim, .1));
+  Kernel k;
+  std::vector<Point_d> points;
+  points.reserve(num_points);
+  for (std::size_t i = 0; i < num_points; i++) {
+    std::vector<double> p(dim);
+    for (int j = 0; j < dim; j++) p[j] = centers[i % num_clusters][j] + offsets[i][j];
+    points.push_back(k.construct_point_d_object()(p.begin(), p.end()));
+  }
+  return points;
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t num_points = argc > 1 ? std::atol(argv[1]) : 2000;
+
+  std::vector<std::pair<std::string, std::vector<Point_d>>> clouds;
+  clouds.emplace_back("sphere", Gudhi::generate_points_on_sphere_d<Kernel>(num_points, 3, 1.));
+  clouds.emplace_back("torus", Gudhi::generate_points_on_torus_3D<Kernel>(num_points, 1., .5));
+  clouds.emplace_back("clusters", generate_clustered_points(num_points, 3));
+
+  for (const auto& [name, points] : clouds) {
+    std::clog << "Benchmark on " << points.size() << " points (" << name << ")" << std::endl;
+    benchmark_rips(points, .3, 3);
+    benchmark_alpha(points);
+    benchmark_cech(points, .15, 3);
+    benchmark_cubical(points, 48);
+  }
+  return 0;
+}
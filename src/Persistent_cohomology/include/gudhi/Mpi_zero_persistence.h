@@ -0,0 +1,161 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef MPI_ZERO_PERSISTENCE_H_
+#define MPI_ZERO_PERSISTENCE_H_
+
+#include <gudhi/Spanning_forest_persistence.h>
+
+#include <mpi.h>
+
+#include <cstddef>  // for std::size_t
+#include <type_traits>
+#include <utility>  // for std::move
+#include <vector>
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+/** \private MPI datatype of `count` contiguous bytes, freed at destruction. */
+class Mpi_bytes_type {
+ public:
+  explicit Mpi_bytes_type(std::size_t count) {
+    MPI_Type_contiguous(static_cast<int>(count), MPI_BYTE, &type_);
+    MPI_Type_commit(&type_);
+  }
+  Mpi_bytes_type(const Mpi_bytes_type&) = delete;
+  Mpi_bytes_type& operator=(const Mpi_bytes_type&) = delete;
+  ~Mpi_bytes_type() { MPI_Type_free(&type_); }
+  MPI_Datatype get() const { return type_; }
+
+ private:
+  MPI_Datatype type_;
+};
+
+/** \brief Merges the minimum spanning forests of the processes of `comm` in a reduction tree.
+ *
+ * \details At the step \f$s\f$, the process of rank \f$r\f$ with \f$r \equiv 2^s \pmod{2^{s+1}}\f$ sends its forest
+ * to the process of rank \f$r - 2^s\f$, which merges it with its own. The forests have fewer edges than vertices, so
+ * that a process receives at most \f$\log_2\f$ of the number of processes forests of the size of the graph.
+ *
+ * @param[in] forest The minimum spanning forest of the edges of the process.
+ * @param[in] comm The communicator of the processes.
+ * @return On the process of rank 0, the minimum spanning forest of the union of the edges of the processes. On the
+ * other processes, an empty forest.
+ */
+template <typename Edge>
+std::vector<Edge> mpi_reduce_spanning_forests(std::vector<Edge> forest, MPI_Comm comm) {
+  static_assert(std::is_trivially_copyable<Edge>::value, "The edges are sent as bytes");
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  Mpi_bytes_type edge_type(sizeof(Edge));
+  for (int step = 1; step < size; step *= 2) {
+    if (rank % (2 * step) == step) {
+      const long long count = static_cast<long long>(forest.size());
+      MPI_Send(&count, 1, MPI_LONG_LONG, rank - step, 0, comm);
+      MPI_Send(forest.data(), static_cast<int>(count), edge_type.get(), rank - step, 1, comm);
+      return {};
+    }
+    if (rank % (2 * step) == 0 && rank + step < size) {
+      long long count;
+      MPI_Recv(&count, 1, MPI_LONG_LONG, rank + step, 0, comm, MPI_STATUS_IGNORE);
+      std::vector<Edge> other(static_cast<std::size_t>(count));
+      MPI_Recv(other.data(), static_cast<int>(count), edge_type.get(), rank + step, 1, comm, MPI_STATUS_IGNORE);
+      forest = merge_spanning_forests(std::move(forest), other);
+    }
+  }
+  return forest;
+}
+
+/** \brief 0-dimensional persistence of the Rips complex of a point cloud, distributed over the processes of `comm`.
+ *
+ * \details The vertices are partitioned in ranges of the same size, one per process, which computes the minimum
+ * spanning forest of the edges starting from its range with `rips_spanning_forest()`. The forests are merged by
+ * `mpi_reduce_spanning_forests()`, and the process of rank 0 computes the diagram.
+ *
+ * @param[in] points The points, on all the processes.
+ * @param[in] threshold Maximal length of the edges.
+ * @param[in] distance Distance between two points.
+ * @param[in] comm The communicator of the processes.
+ * @param[out] out0 On the process of rank 0, for each finite interval (0, d) of the diagram, the function calls
+ * `out0(0, d)`.
+ * @param[out] out_essential On the process of rank 0, for each connected component, the function calls
+ * `out_essential(0)`.
+ */
+template <typename Points, typename Filtration_value, typename Distance, typename Out0, typename Out_essential>
+void mpi_rips_zero_persistence(const Points& points, Filtration_value threshold, Distance&& distance, MPI_Comm comm,
+                               Out0&& out0, Out_essential&& out_essential) {
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  const std::size_t n = points.size();
+  auto forest = rips_spanning_forest(points, threshold, distance, n * rank / size, n * (rank + 1) / size);
+  forest = mpi_reduce_spanning_forests(std::move(forest), comm);
+  if (rank != 0) return;
+  const std::size_t num_edges = forest.size();
+  zero_persistence_of_spanning_forest(std::move(forest), out0, [](Filtration_value) {});
+  // Each edge of the forest merges two components, and the isolated vertices, which are not in the forest, are also
+  // components
+  for (std::size_t i = num_edges; i < n; ++i) out_essential(Filtration_value(0));
+}
+
+/** \brief 0-dimensional persistence of a cubical complex given by its top-dimensional cells, distributed over the
+ * processes of `comm`.
+ *
+ * \details The bitmap is cut in layers along its last coordinate, and each process holds a consecutive range of
+ * layers, the process of rank 0 holding the first one. A process receives the first layer of the next process, and
+ * computes the minimum spanning forest of the edges starting from its layers with `cubical_spanning_forest()`. The
+ * forests are merged by `mpi_reduce_spanning_forests()`, and the process of rank 0 computes the diagram, which is the
+ * one of dimension 0 of `Gudhi::cubical_complex::Bitmap_cubical_complex` built from the whole bitmap.
+ *
+ * @param[in] sizes The number of top-dimensional cells in each direction, the first one varying the fastest. The
+ * bitmap must contain at least 2 cells.
+ * @param[in] cells The filtration values of the cells of the layers `[layer_begin, layer_end)`.
+ * @param[in] layer_begin,layer_end Range of the layers of the process. The ranges of the processes must be
+ * consecutive in the order of the ranks, cover all the layers, and not be empty.
+ * @param[in] comm The communicator of the processes.
+ * @param[out] out0 On the process of rank 0, for each finite interval (b, d) with b < d of the diagram, the function
+ * calls `out0(b, d)`.
+ * @param[out] out_essential On the process of rank 0, the function calls `out_essential(b)` with b the minimum of the
+ * filtration values.
+ */
+template <typename Filtration_value, typename Out0, typename Out_essential>
+void mpi_cubical_zero_persistence(const std::vector<unsigned>& sizes, const Filtration_value* cells,
+                                  std::size_t layer_begin, std::size_t layer_end, MPI_Comm comm, Out0&& out0,
+                                  Out_essential&& out_essential) {
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+  std::size_t layer_size = 1;
+  for (std::size_t i = 0; i + 1 < sizes.size(); ++i) layer_size *= sizes[i];
+  // Exchange of the first layers with the previous processes
+  Mpi_bytes_type layer_type(layer_size * sizeof(Filtration_value));
+  std::vector<Filtration_value> next_layer;
+  MPI_Request request = MPI_REQUEST_NULL;
+  if (layer_end < sizes.back()) {
+    next_layer.resize(layer_size);
+    MPI_Irecv(next_layer.data(), 1, layer_type.get(), rank + 1, 2, comm, &request);
+  }
+  if (rank > 0) MPI_Send(cells, 1, layer_type.get(), rank - 1, 2, comm);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+  auto forest = cubical_spanning_forest(sizes, cells, next_layer.empty() ? nullptr : next_layer.data(), layer_begin,
+                                        layer_end);
+  forest = mpi_reduce_spanning_forests(std::move(forest), comm);
+  if (rank == 0) zero_persistence_of_spanning_forest(std::move(forest), out0, out_essential);
+}
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // MPI_ZERO_PERSISTENCE_H_
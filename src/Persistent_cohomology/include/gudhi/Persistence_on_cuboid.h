@@ -0,0 +1,317 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef PERSISTENCE_ON_CUBOID_H
+#define PERSISTENCE_ON_CUBOID_H
+
+#include <gudhi/Debug_utils.h>
+#ifdef GUDHI_DETAILED_TIMES
+ #include <gudhi/Clock.h>
+#endif
+
+#include <boost/range/adaptor/reversed.hpp>
+
+#ifdef GUDHI_USE_TBB
+ #include <tbb/parallel_sort.h>
+#endif
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <cstddef>
+
+namespace Gudhi::cubical_complex {
+
+// Persistence of a 3d cubical complex built from its top cells (voxels), with the lower-star filtration. Cells are
+// ordered by (filtration value, dimension, index), and each dimension is handled by a dedicated pass:
+// * dimension 0: union-find on the vertices, processing the edges in increasing order,
+// * dimension 2: by Alexander duality, union-find on the voxels and a single exterior cell with filtration +inf,
+//   processing the squares in decreasing order (a square between 2 voxels is a dual edge),
+// * dimension 1: reduction of the coboundary matrix of the edges. The columns of the edges paired with vertices are
+//   cleared, and the rows of the squares paired with voxels are removed (by duality, they cannot be the pivot of a
+//   cocycle), so the unreduced columns have at most 4 entries.
+// The homology of a subset of R^3 has no torsion, so the result does not depend on the coefficient field.
+template <class Filtration_value, class Index = std::size_t>
+struct Persistence_on_cuboid {
+  typedef std::pair<Filtration_value, Index> Sorted_cell;
+
+  Filtration_value const* input_p;
+  Filtration_value input(Index i) const { return input_p[i]; }
+
+  // Number of voxels and vertices in each direction, the last direction being contiguous in memory.
+  Index n[3], m[3];
+  // Strides of the voxels and of the vertices.
+  Index voxel_stride[3], vertex_stride[3];
+  Index num_voxels, num_vertices;
+
+  // The edge in direction d from the vertex v has index 3*v+d, and so does the square orthogonal to direction d whose
+  // smallest vertex is v. Some of those indices are outside of the complex and never used.
+  std::vector<Filtration_value> vertex_filtration;
+  std::vector<Sorted_cell> edges, squares;
+  // Position of each square in `squares`.
+  std::vector<Index> square_rank;
+  std::vector<bool> negative_edge, positive_square;
+  std::vector<Index> ds_parent_;
+
+  static constexpr Index none = std::numeric_limits<Index>::max();
+
+  void init(const Filtration_value* input_, Index n0, Index n1, Index n2) {
+    input_p = input_;
+    n[0] = n0; n[1] = n1; n[2] = n2;
+    for (int d = 0; d < 3; ++d) m[d] = n[d] + 1;
+    voxel_stride[2] = vertex_stride[2] = 1;
+    for (int d = 2; d > 0; --d) {
+      voxel_stride[d - 1] = voxel_stride[d] * n[d];
+      vertex_stride[d - 1] = vertex_stride[d] * m[d];
+    }
+    num_voxels = voxel_stride[0] * n[0];
+    num_vertices = vertex_stride[0] * m[0];
+  }
+
+  void coordinates(Index v, Index (&c)[3]) const {
+    for (int d = 0; d < 3; ++d) {
+      c[d] = v / vertex_stride[d];
+      v = v % vertex_stride[d];
+    }
+  }
+  Index voxel(Index const (&c)[3]) const { return c[0] * voxel_stride[0] + c[1] * voxel_stride[1] + c[2]; }
+
+  // Minimum of the voxels around the vertex c, the coordinates in the directions where `fixed` is true being those
+  // of the voxel (used for edges and squares).
+  Filtration_value min_around(Index const (&c)[3], bool const (&fixed)[3]) const {
+    Filtration_value f = std::numeric_limits<Filtration_value>::infinity();
+    bool first = true;
+    Index lo[3], hi[3];
+    for (int d = 0; d < 3; ++d) {
+      lo[d] = (fixed[d] || c[d] == 0) ? c[d] : c[d] - 1;
+      hi[d] = (c[d] == n[d]) ? c[d] - 1 : c[d];
+    }
+    Index x[3];
+    for (x[0] = lo[0]; x[0] <= hi[0]; ++x[0])
+      for (x[1] = lo[1]; x[1] <= hi[1]; ++x[1])
+        for (x[2] = lo[2]; x[2] <= hi[2]; ++x[2]) {
+          Filtration_value g = input(voxel(x));
+          if (first || g < f) f = g;
+          first = false;
+        }
+    return f;
+  }
+
+  Index ds_find_set(Index v) {
+    // Path halving, see Persistence_on_rectangle
+    Index parent = ds_parent_[v];
+    Index grandparent = ds_parent_[parent];
+    while (parent != grandparent) {
+      ds_parent_[v] = grandparent;
+      v = grandparent;
+      parent = ds_parent_[v];
+      grandparent = ds_parent_[parent];
+    }
+    return parent;
+  }
+
+  template <class Range>
+  static void sort_cells(Range& cells) {
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_sort(cells.begin(), cells.end());
+#else
+    std::sort(cells.begin(), cells.end());
+#endif
+  }
+
+  void fill() {
+    vertex_filtration.resize(num_vertices);
+    edges.reserve(n[0] * m[1] * m[2] + m[0] * n[1] * m[2] + m[0] * m[1] * n[2]);
+    squares.reserve(m[0] * n[1] * n[2] + n[0] * m[1] * n[2] + n[0] * n[1] * m[2]);
+    Index c[3];
+    Index v = 0;
+    for (c[0] = 0; c[0] < m[0]; ++c[0])
+      for (c[1] = 0; c[1] < m[1]; ++c[1])
+        for (c[2] = 0; c[2] < m[2]; ++c[2], ++v) {
+          vertex_filtration[v] = min_around(c, {false, false, false});
+          for (int d = 0; d < 3; ++d) {
+            // The edge in direction d exists if c[d] < n[d], the square orthogonal to d if c[e] < n[e] for e != d.
+            bool fixed[3] = {false, false, false};
+            fixed[d] = true;
+            if (c[d] < n[d]) edges.emplace_back(min_around(c, fixed), 3 * v + d);
+            fixed[0] = !fixed[0]; fixed[1] = !fixed[1]; fixed[2] = !fixed[2];
+            if (c[(d + 1) % 3] < n[(d + 1) % 3] && c[(d + 2) % 3] < n[(d + 2) % 3])
+              squares.emplace_back(min_around(c, fixed), 3 * v + d);
+          }
+        }
+    sort_cells(edges);
+    sort_cells(squares);
+  }
+
+  // Union-find on the vertices, the representative of a component is its oldest vertex.
+  template <class Out>
+  Filtration_value primal(Out&& out) {
+    ds_parent_.resize(num_vertices);
+    for (Index v = 0; v < num_vertices; ++v) ds_parent_[v] = v;
+    negative_edge.assign(3 * num_vertices, false);
+    auto older = [this](Index a, Index b) {
+      return std::make_pair(vertex_filtration[a], a) < std::make_pair(vertex_filtration[b], b);
+    };
+    for (Index r = 0; r < edges.size(); ++r) {
+      Index e = edges[r].second;
+      Index u = e / 3;
+      Index a = ds_find_set(u);
+      Index b = ds_find_set(u + vertex_stride[e % 3]);
+      if (a == b) continue;
+      if (older(b, a)) std::swap(a, b);
+      ds_parent_[b] = a;
+      negative_edge[e] = true;
+      out(vertex_filtration[b], edges[r].first);
+    }
+    Filtration_value global_min = vertex_filtration[ds_find_set(0)];
+    std::vector<Filtration_value>().swap(vertex_filtration);
+    return global_min;
+  }
+
+  // Union-find on the voxels and the exterior, with the squares in decreasing order. The representative of a
+  // component is its oldest voxel for the reversed filtration, i.e. the largest one, and the exterior is older than
+  // all voxels.
+  template <class Out>
+  void dual(Out&& out) {
+    const Index exterior = num_voxels;
+    ds_parent_.resize(num_voxels + 1);
+    for (Index v = 0; v <= num_voxels; ++v) ds_parent_[v] = v;
+    positive_square.assign(3 * num_vertices, false);
+    auto older = [this, exterior](Index a, Index b) {
+      if (a == exterior) return true;
+      if (b == exterior) return false;
+      return std::make_pair(input(b), b) < std::make_pair(input(a), a);
+    };
+    for (auto const& s : boost::adaptors::reverse(squares)) {
+      Index d = s.second % 3;
+      Index c[3];
+      coordinates(s.second / 3, c);
+      Index a = (c[d] == n[d]) ? exterior : voxel(c);
+      --c[d];
+      Index b = (c[d] == none) ? exterior : voxel(c);
+      a = ds_find_set(a);
+      b = ds_find_set(b);
+      if (a == b) continue;
+      if (older(b, a)) std::swap(a, b);
+      ds_parent_[b] = a;
+      positive_square[s.second] = true;
+      out(s.first, input(b));
+    }
+    std::vector<Index>().swap(ds_parent_);
+  }
+
+  // Ranks of the squares in the coboundary of an edge that are not paired with a voxel, in increasing order.
+  void coboundary(Index e, std::vector<Index>& column) const {
+    column.clear();
+    Index v = e / 3;
+    int d = e % 3;
+    Index c[3];
+    coordinates(v, c);
+    for (int k = 1; k < 3; ++k) {
+      // The squares that contain the edge span the directions d and g, they are orthogonal to the third direction.
+      int g = (d + k) % 3, f = 3 - d - g;
+      Index s[2] = {3 * v + f, 3 * (v - vertex_stride[g]) + f};
+      if (c[g] < n[g] && !positive_square[s[0]]) column.push_back(square_rank[s[0]]);
+      if (c[g] > 0 && !positive_square[s[1]]) column.push_back(square_rank[s[1]]);
+    }
+    std::sort(column.begin(), column.end());
+  }
+
+  // Reduction of the coboundary matrix of the edges that are not paired with a vertex, in decreasing order. As in
+  // Ripser, cohomology gives much shorter columns than homology here, and the columns that did not need any reduction
+  // are not stored, their coboundary is recomputed when needed.
+  template <class Out>
+  void reduce(Out&& out) {
+    square_rank.resize(3 * num_vertices);
+    for (Index r = 0; r < squares.size(); ++r) square_rank[squares[r].second] = r;
+    // For each pivot, the edge that owns it and the position of its column in reduced_columns, if it was stored.
+    std::vector<Index> pivot_owner(squares.size(), none), pivot_column(squares.size(), none);
+    std::vector<std::vector<Index>> reduced_columns;
+    std::vector<Index> column, other, tmp;
+    for (auto const& e : boost::adaptors::reverse(edges)) {
+      if (negative_edge[e.second]) continue;
+      coboundary(e.second, column);
+      bool modified = false;
+      while (!column.empty() && pivot_owner[column.front()] != none) {
+        Index pivot = column.front();
+        std::vector<Index> const* reducer = &other;
+        if (pivot_column[pivot] == none) {
+          coboundary(pivot_owner[pivot], other);
+        } else {
+          reducer = &reduced_columns[pivot_column[pivot]];
+        }
+        tmp.clear();
+        std::set_symmetric_difference(column.begin(), column.end(), reducer->begin(), reducer->end(),
+                                      std::back_inserter(tmp));
+        column.swap(tmp);
+        modified = true;
+      }
+      GUDHI_CHECK(!column.empty(), std::logic_error("Bug in Gudhi: an edge is neither positive nor negative"));
+      pivot_owner[column.front()] = e.second;
+      out(e.first, squares[column.front()].first);
+      if (modified) {
+        pivot_column[column.front()] = reduced_columns.size();
+        reduced_columns.push_back(column);
+      }
+    }
+  }
+};
+
+/**
+ * @private
+ * Compute the persistence diagram of a function on a 3d cubical complex, defined as a lower-star filtration of the
+ * values at the top-dimensional cells.
+ *
+ * @tparam Filtration_value Must be comparable with `operator<`, and have an infinity.
+ * @tparam Index This is used to index the cells of the complex, so it must be large enough to represent 3 times
+ *   the number of vertices `(n0+1)*(n1+1)*(n2+1)`.
+ * @param[in] input Pointer to `n0*n1*n2` filtration values for the cubes. Note that the values are assumed
+ *   to be stored in C order, unlike `Gudhi::cubical_complex::Bitmap_cubical_complex` (you can exchange `n0` and
+ *   `n2` for compatibility).
+ * @param[in] n0, n1, n2 Shape of `input`.
+ * @param[out] out0 For each interval (b, d) in the persistence diagram of dimension 0, the function calls `out0(b, d)`.
+ * @param[out] out1 Same as `out0` for persistence in dimension 1.
+ * @param[out] out2 Same as `out0` for persistence in dimension 2.
+ * @returns The global minimum, which is not paired and is thus the birth of an infinite persistence interval of
+ *   dimension 0.
+ */
+template <typename Filtration_value, typename Index, typename Out0, typename Out1, typename Out2>
+Filtration_value persistence_on_cuboid_from_top_cells(Filtration_value const* input, Index n0, Index n1, Index n2,
+                                                      Out0&&out0, Out1&&out1, Out2&&out2){
+#ifdef GUDHI_DETAILED_TIMES
+  Gudhi::Clock clock;
+#endif
+  GUDHI_CHECK(n0 >= 1 && n1 >= 1 && n2 >= 1, std::domain_error("The complex must not be empty"));
+  Persistence_on_cuboid<Filtration_value, Index> X;
+  X.init(input, n0, n1, n2);
+  X.fill();
+#ifdef GUDHI_DETAILED_TIMES
+    std::clog << "fill and sort: " << clock; clock.begin();
+#endif
+  Filtration_value global_min = X.primal(out0);
+#ifdef GUDHI_DETAILED_TIMES
+    std::clog << "primal pass: " << clock; clock.begin();
+#endif
+  X.dual(out2);
+#ifdef GUDHI_DETAILED_TIMES
+    std::clog << "dual pass: " << clock; clock.begin();
+#endif
+  X.reduce(out1);
+#ifdef GUDHI_DETAILED_TIMES
+    std::clog << "reduction: " << clock;
+#endif
+  return global_min;
+}
+}  // namespace Gudhi::cubical_complex
+
+#endif  // PERSISTENCE_ON_CUBOID_H
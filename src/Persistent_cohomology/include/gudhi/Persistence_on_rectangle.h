@@ -28,6 +28,7 @@
 
 #ifdef GUDHI_USE_TBB
  #include <tbb/parallel_sort.h>
+ #include <tbb/parallel_for.h>
 #endif
 
 #ifdef DEBUG_TRACES
@@ -213,6 +214,36 @@ struct Persistence_on_rectangle {
   // Work implicitly from input, only store the filtration value of critical vertices (squares are already in input).
   // Store critical edges for later processing.
   void fill_and_pair() {
+    // Mark the corners as critical, it will be overwritten if not
+    auto mark_corner_critical = [this](Index i, Index c) {
+      ds_parent_vertex(c) = c;
+      data_vertex(c) = T(input(i), i);
+    };
+    mark_corner_critical(0, 0);
+    mark_corner_critical(size_x, size_x - 1);
+    mark_corner_critical(dy * size_y, dy * size_y - dy);
+    mark_corner_critical(size_x + dy * size_y, size_x + dy * size_y - dy - 1);
+#ifdef GUDHI_USE_TBB
+    // Each vertex is written only by the smallest of its squares, so blocks of rows can be paired in parallel, each
+    // with its own list of critical edges. They are concatenated in the order of the sequential version.
+    Index rows_per_block = std::max<Index>(1, (Index(1) << 16) / dy);
+    Index num_blocks = (size_y + rows_per_block) / rows_per_block;
+    if (num_blocks > 1) {
+      std::vector<std::vector<Edge>> block_edges(num_blocks);
+      tbb::parallel_for(Index(0), num_blocks, [&](Index b) {
+        block_edges[b].reserve(rows_per_block * dy / 2);
+        fill_and_pair_rows(b * rows_per_block, std::min<Index>(size_y + 1, (b + 1) * rows_per_block), block_edges[b]);
+      });
+      for (auto const& block : block_edges) edges.insert(edges.end(), block.begin(), block.end());
+      return;
+    }
+#endif
+    fill_and_pair_rows(0, size_y + 1, edges);
+  }
+
+  // Same as fill_and_pair, for the squares of rows y_begin to y_end - 1 (the rows of squares go from 0 to size_y),
+  // except for the corners.
+  void fill_and_pair_rows(Index y_begin, Index y_end, std::vector<Edge>& row_edges) {
     Index i; // Index of the current square
     Filtration_value f; // input(i)
     auto mark_vertex_critical = [&](Index c) {
@@ -223,7 +254,7 @@ struct Persistence_on_rectangle {
       ds_parent_square(i) = i;
     };
     auto mark_edge_critical = [&](Index v1, Index v2) {
-      edges.emplace_back(T(f, i), v1, v2);
+      row_edges.emplace_back(T(f, i), v1, v2);
     };
     auto v_up_left    = [&](){ return i - 1; };
     auto v_up_right   = [&](){ return i; };
@@ -234,35 +265,47 @@ struct Persistence_on_rectangle {
     auto pair_square_left  = [&](){ set_parent_square(i, i - 1); };
     auto pair_square_right = [&](){ set_parent_square(i, i + 1); };
 
-    // Mark the corners as critical, it will be overwritten if not
-    i = 0; f = input(i);
-    mark_vertex_critical(v_up_right());
-    i = size_x; f = input(i);
-    mark_vertex_critical(v_up_left());
-    i = dy * size_y; f = input(i);
-    mark_vertex_critical(v_down_right());
-    i = size_x + dy * size_y; f = input(i);
-    mark_vertex_critical(v_down_left());
-
-    // Boundary nodes, 1st row
-    for(Index x = 1; x < size_x; ++x) {
-      i = x;
-      f = input(x);
-      if (has_larger_input(i + dy, i, f)) {
-        auto up_left  = [&](){ return has_larger_input(i - 1, i, f) && has_larger_input(i + dy - 1, i, f); };
-        auto up_right = [&](){ return has_larger_input(i + 1, i, f) && has_larger_input(i + dy + 1, i, f); };
-        if (up_left()) {
-          set_parent_vertex(v_up_left(), v_up_right());
-          if (up_right()) mark_vertex_critical(v_up_right());
-        } else if (up_right()) {
-          set_parent_vertex(v_up_right(), v_up_left());
-        } else {
-          mark_edge_critical(v_up_left(), v_up_right());
+    for(Index y = y_begin; y < y_end; ++y) {
+      if (y == 0) {
+        // Boundary nodes, 1st row
+        for(Index x = 1; x < size_x; ++x) {
+          i = x;
+          f = input(x);
+          if (has_larger_input(i + dy, i, f)) {
+            auto up_left  = [&](){ return has_larger_input(i - 1, i, f) && has_larger_input(i + dy - 1, i, f); };
+            auto up_right = [&](){ return has_larger_input(i + 1, i, f) && has_larger_input(i + dy + 1, i, f); };
+            if (up_left()) {
+              set_parent_vertex(v_up_left(), v_up_right());
+              if (up_right()) mark_vertex_critical(v_up_right());
+            } else if (up_right()) {
+              set_parent_vertex(v_up_right(), v_up_left());
+            } else {
+              mark_edge_critical(v_up_left(), v_up_right());
+            }
+          }
         }
+        continue;
+      }
+      if (y == size_y) {
+        // Boundary nodes, last row
+        for(Index x = 1; x < size_x; ++x) {
+          i = size_y * dy + x;
+          f = input(i);
+          if (has_larger_input(i - dy, i, f)) {
+            auto down_left  = [&](){ return has_larger_input(i - 1, i, f) && has_larger_input(i - dy - 1, i, f); };
+            auto down_right = [&](){ return has_larger_input(i + 1, i, f) && has_larger_input(i - dy + 1, i, f); };
+            if (down_left()) {
+              set_parent_vertex(v_down_left(), v_down_right());
+              if (down_right()) mark_vertex_critical(v_down_right());
+            } else if (down_right()) {
+              set_parent_vertex(v_down_right(), v_down_left());
+            } else {
+              mark_edge_critical(v_down_left(), v_down_right());
+            }
+          }
+        }
+        continue;
       }
-    }
-    // Internal rows
-    for(Index y = 1; y < size_y; ++y) {
       // First column
       {
         i = y * dy;
@@ -477,30 +520,12 @@ struct Persistence_on_rectangle {
         }
       }
     }
-    // Boundary nodes, last row
-    for(Index x = 1; x < size_x; ++x) {
-      i = size_y * dy + x;
-      f = input(i);
-      if (has_larger_input(i - dy, i, f)) {
-        auto down_left  = [&](){ return has_larger_input(i - 1, i, f) && has_larger_input(i - dy - 1, i, f); };
-        auto down_right = [&](){ return has_larger_input(i + 1, i, f) && has_larger_input(i - dy + 1, i, f); };
-        if (down_left()) {
-          set_parent_vertex(v_down_left(), v_down_right());
-          if (down_right()) mark_vertex_critical(v_down_right());
-        } else if (down_right()) {
-          set_parent_vertex(v_down_right(), v_down_left());
-        } else {
-          mark_edge_critical(v_down_left(), v_down_right());
-        }
-      }
-    }
   }
 
   void sort_edges(){
 #ifdef GUDHI_USE_TBB
-    // Parallelizing just this part is a joke. It would be possible to
-    // parallelize the pairing (one edge list per thread) and run the dual in
-    // parallel with the primal if we were motivated...
+    // The pairing is parallel as well. It would also be possible to run the
+    // dual in parallel with the primal if we were motivated...
     tbb::parallel_sort(edges.begin(), edges.end());
 #else
     std::sort(edges.begin(), edges.end());
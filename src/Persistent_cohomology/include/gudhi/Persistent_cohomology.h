@@ -13,7 +13,11 @@
 
 #include <gudhi/Persistent_cohomology/Persistent_cohomology_column.h>
 #include <gudhi/Persistent_cohomology/Field_Zp.h>
+#include <gudhi/Persistent_cohomology/Field_Z2.h>
 #include <gudhi/Simple_object_pool.h>
+#include <gudhi/Profiler_instrumentation.h>
+#include <gudhi/Cancellation.h>
+#include <gudhi/writing_persistence_to_file.h>
 
 #include <boost/intrusive/set.hpp>
 #include <boost/pending/disjoint_sets.hpp>
@@ -32,6 +36,7 @@
 #include <algorithm>
 #include <string>
 #include <stdexcept>  // for std::out_of_range
+#include <type_traits>  // for std::is_same
 
 namespace Gudhi {
 
@@ -70,7 +75,9 @@ class Persistent_cohomology {
  private:
   // Compressed Annotation Matrix types:
   // Column type
-  typedef Persistent_cohomology_column<Simplex_key, Arith_element> Column;  // contains 1 set_hook
+  // With Field_Z2, the cells do not store their coefficient, always 1
+  typedef Persistent_cohomology_column<Simplex_key, Arith_element,
+                                       !std::is_same<CoefficientField, Field_Z2>::value> Column;  // contains 1 set_hook
   // Cell type
   typedef typename Column::Cell Cell;   // contains 2 list_hooks
   // Remark: constant_time_size must be false because base_hook_cam_h has auto_unlink link_mode
@@ -119,6 +126,48 @@ class Persistent_cohomology {
     }
   }
 
+  /** \brief Prepares the computation of the persistent cohomology of another complex, or of the same complex after
+   * a modification, reusing the memory of the previous computation.
+   *
+   * The memory pools of the compressed annotation matrix and the capacity of the union-find arrays are kept, so that
+   * the computation of the persistence of many small complexes does not allocate again for each complex. The
+   * coefficient field is kept. The persistent pairs of the previous computation are cleared.
+   *
+   * @param[in] cpx Complex for which the persistent homology is computed.
+   * @param[in] persistence_dim_max if true, the persistent homology for the maximal dimension in the
+   *                                complex is computed. If false, it is ignored. Default is false.
+   *
+   * @exception std::out_of_range In case the number of simplices is more than Simplex_key type numeric limit.
+   */
+  void reset(FilteredComplex& cpx, bool persistence_dim_max = false) {
+    // Give the cells and the columns back to their pools, the rows being unlinked when their cells are destroyed
+    cam_.clear_and_dispose([&](Column* col) {
+      col->col_.clear_and_dispose([&](Cell* p) { cell_pool_.destroy(p); });
+      column_pool_.destroy(col);
+    });
+    for (auto& transverse_ref : transverse_idx_) delete transverse_ref.second.row_;
+    transverse_idx_.clear();
+    zero_cocycles_.clear();
+    persistent_pairs_.clear();
+    cocycles_ = Cocycles();
+
+    cpx_ = &cpx;
+    dim_max_ = cpx.dimension();
+    num_simplices_ = cpx.num_simplices();
+    if (num_simplices_ > std::numeric_limits<Simplex_key>::max()) {
+      // num_simplices must be strictly lower than the limit, because a value is reserved for null_key.
+      throw std::out_of_range("The number of simplices is more than Simplex_key type numeric limit.");
+    }
+    if (persistence_dim_max) {
+      ++dim_max_;
+    }
+    ds_rank_.resize(num_simplices_);
+    ds_parent_.resize(num_simplices_);
+    ds_repr_.assign(num_simplices_, NULL);
+    dsets_ = boost::disjoint_sets<int *, Simplex_key *>(ds_rank_.data(), ds_parent_.data());
+    interval_length_policy = length_interval(&cpx, 0);
+  }
+
   ~Persistent_cohomology() {
     // Clean the transversal lists
     for (auto & transverse_ref : transverse_idx_) {
@@ -164,16 +213,59 @@ class Persistent_cohomology {
    *                                less or equal than min_interval_length
    *
    * Assumes that the filtration provided by the simplicial complex is
-   * valid. Undefined behavior otherwise. */
+   * valid. Undefined behavior otherwise.
+   *
+   * The computation checks the `Cancellation_flag` of the `Cancellation_scope` of the calling thread, if any, every
+   * 1024 simplices, and throws `Cancelled` if it is raised. The object must then be destroyed or reset. */
   void compute_persistent_cohomology(Filtration_value min_interval_length = 0) {
+    compute_persistent_cohomology_until(min_interval_length, [](Simplex_handle) { return false; }, dim_max_);
+  }
+
+  /** \brief Compute the persistent homology of the filtered simplicial
+   * complex, until a filtration value and a dimension.
+   *
+   * The computation stops at the first simplex of filtration value strictly greater than `max_filtration`, and
+   * ignores the simplices of dimension strictly greater than `max_dimension + 1`. The intervals of dimension at most
+   * `max_dimension` are the ones of the complex truncated at `max_filtration`: the classes still alive at
+   * `max_filtration` are essential.
+   *
+   * The simplices after the truncation are still sorted by `filtration_simplex_range()`. With a `Simplex_tree`, call
+   * first `Simplex_tree::initialize_filtration(max_filtration, max_dimension + 1)`, so that they are never sorted.
+   *
+   * @param[in] min_interval_length the computation discards all intervals of length
+   *                                less or equal than min_interval_length
+   * @param[in] max_filtration the simplices of filtration value strictly greater than max_filtration are ignored
+   * @param[in] max_dimension the maximal dimension of the intervals
+   */
+  void compute_persistent_cohomology(Filtration_value min_interval_length, Filtration_value max_filtration,
+                                     int max_dimension) {
+    // The simplices of dimension max_dimension + 1 only kill classes, as in a complex of this dimension
+    dim_max_ = std::min(dim_max_, max_dimension + 1);
+    compute_persistent_cohomology_until(
+        min_interval_length, [this, max_filtration](Simplex_handle sh) { return cpx_->filtration(sh) > max_filtration; },
+        max_dimension + 1);
+  }
+
+ private:
+  /* Persistent cohomology of the simplices before the first one for which stop is true, ignoring the simplices of
+   * dimension greater than max_dimension. */
+  template<class Stop>
+  void compute_persistent_cohomology_until(Filtration_value min_interval_length, Stop stop, int max_dimension) {
+    GUDHI_PROFILE_SCOPE("Persistent_cohomology::compute_persistent_cohomology");
     interval_length_policy.set_length(min_interval_length);
+    if (record_cocycles_) ds_next_.resize(num_simplices_);
     Simplex_key idx_fil = -1;
     std::vector<Simplex_key> vertices; // so we can check the connected components at the end
+    const Cancellation_flag* cancellation = current_cancellation_flag();
     // Compute all finite intervals
     for (auto sh : cpx_->filtration_simplex_range()) {
+      if (stop(sh)) break;
+      if ((idx_fil & 1023) == 0) check_cancellation(cancellation);
+      int dim_simplex = cpx_->dimension(sh);
+      if (dim_simplex > max_dimension) continue;
       cpx_->assign_key(sh, ++idx_fil);
       dsets_.make_set(cpx_->key(sh));
-      int dim_simplex = cpx_->dimension(sh);
+      if (record_cocycles_) ds_next_[idx_fil] = idx_fil;
       switch (dim_simplex) {
         case 0:
           vertices.push_back(idx_fil);
@@ -186,6 +278,7 @@ class Persistent_cohomology {
           break;
       }
     }
+    GUDHI_PROFILE_COUNT("Persistent_cohomology columns reduced", static_cast<std::size_t>(idx_fil + 1));
     // Compute infinite intervals of dimension 0
     for (Simplex_key key : vertices) {  // for all 0-dimensional simplices
       if (ds_parent_[key] == key  // root of its tree
@@ -202,10 +295,10 @@ class Persistent_cohomology {
     for (auto cocycle : transverse_idx_) {
       persistent_pairs_.emplace_back(
           cpx_->simplex(cocycle.first), cpx_->null_simplex(), cocycle.second.characteristics_);
+      if (record_cocycles_) record_cocycle(*cocycle.second.row_, idx_fil + 1);
     }
   }
 
- private:
   /** \brief Update the cohomology groups under the insertion of an edge.
    *
    * The 0-homology is maintained with a simple Union-Find data structure, which
@@ -321,7 +414,7 @@ class Persistent_cohomology {
       // The following test is just a heuristic, it is not required, and it is fine that is misses p == 0.
       if (mult != coeff_field_.additive_identity()) {  // For all columns in the boundary,
         for (auto cell_ref : col->col_) {  // insert every cell in map_a_ds with multiplicity
-          Arith_element w_y = coeff_field_.times(cell_ref.coefficient_, mult);  // coefficient * multiplicity
+          Arith_element w_y = coeff_field_.times(cell_ref.coefficient(), mult);  // coefficient * multiplicity
 
           if (w_y != coeff_field_.additive_identity()) {  // if != 0
             result_insert_a_ds = map_a_ds.insert(std::pair<Simplex_key, Arith_element>(cell_ref.key_, w_y));
@@ -415,20 +508,24 @@ class Persistent_cohomology {
                        Simplex_key death_key, Arith_element inv_x,
                        Arith_element charac) {
     // Create a finite persistent interval for which the interval exists
+    auto death_key_row = transverse_idx_.find(death_key);  // Find the beginning of the row.
     if (interval_length_policy(cpx_->simplex(death_key), sigma)) {
       persistent_pairs_.emplace_back(cpx_->simplex(death_key)  // creator
           , sigma                                              // destructor
           , charac);                                           // fields
+      // The row is the cocycle of the class before its death, on the simplices inserted before sigma
+      if (record_cocycles_ &&
+          cpx_->filtration(sigma) - cpx_->filtration(cpx_->simplex(death_key)) > cocycle_min_persistence_)
+        record_cocycle(*death_key_row->second.row_, cpx_->key(sigma));
     }
 
-    auto death_key_row = transverse_idx_.find(death_key);  // Find the beginning of the row.
     std::pair<typename Cam::iterator, bool> result_insert_cam;
 
     auto row_cell_it = death_key_row->second.row_->begin();
 
     while (row_cell_it != death_key_row->second.row_->end()) {  // Traverse all cells in
       // the row at index death_key.
-      Arith_element w = coeff_field_.times_minus(inv_x, row_cell_it->coefficient_);
+      Arith_element w = coeff_field_.times_minus(inv_x, row_cell_it->coefficient());
 
       if (w != coeff_field_.additive_identity()) {
         Column * curr_col = row_cell_it->self_col_;
@@ -458,6 +555,9 @@ class Persistent_cohomology {
             // merge two disjoint sets.
             dsets_.link(curr_col->class_key_,
                         result_insert_cam.first->class_key_);
+            // Splice the circular lists of the members of the two sets
+            if (record_cocycles_)
+              std::swap(ds_next_[curr_col->class_key_], ds_next_[result_insert_cam.first->class_key_]);
 
             Simplex_key key_tmp = dsets_.find_set(curr_col->class_key_);
             ds_repr_[key_tmp] = &(*(result_insert_cam.first));
@@ -484,6 +584,31 @@ class Persistent_cohomology {
     }
   }
 
+  /* Appends to cocycles_ the cocycle of the row, for the last persistent interval, on the simplices of keys lower
+   * than num_keys. The annotation of a simplex is the column of its disjoint set, so the value of the cocycle on a
+   * simplex is the coefficient of the row in this column. Traverses the members of the disjoint sets of the columns
+   * of the row only. */
+  void record_cocycle(Hcell const& row, Simplex_key num_keys) {
+    thread_local std::vector<std::pair<Simplex_key, Arith_element>> entries;
+    entries.clear();
+    for (auto const& cell : row) {
+      const Simplex_key first = dsets_.find_set(cell.self_col_->class_key_);
+      Simplex_key key = first;
+      do {
+        if (key < num_keys) entries.emplace_back(key, cell.coefficient());
+        key = ds_next_[key];
+      } while (key != first);
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](auto const& a, auto const& b) { return a.first < b.first; });
+    for (auto const& [key, coefficient] : entries) {
+      cocycles_.keys.push_back(key);
+      cocycles_.coefficients.push_back(coefficient);
+    }
+    cocycles_.intervals.push_back(persistent_pairs_.size() - 1);
+    cocycles_.offsets.push_back(cocycles_.keys.size());
+  }
+
   /*
    * Assign:    target <- target + w * other.
    */
@@ -499,15 +624,15 @@ class Persistent_cohomology {
           Cell * cell_tmp = cell_pool_.construct(Cell(other_it->first   // key
               , coeff_field_.additive_identity(), &target));
 
-          cell_tmp->coefficient_ = coeff_field_.plus_times_equal(cell_tmp->coefficient_, other_it->second, w);
+          cell_tmp->set_coefficient(coeff_field_.plus_times_equal(cell_tmp->coefficient(), other_it->second, w));
 
           target.col_.insert(target_it, *cell_tmp);
 
           ++other_it;
         } else {  // it1->key == it2->key
-          // target_it->coefficient_ <- target_it->coefficient_ + other_it->second * w
-          target_it->coefficient_ = coeff_field_.plus_times_equal(target_it->coefficient_, other_it->second, w);
-          if (target_it->coefficient_ == coeff_field_.additive_identity()) {
+          // coefficient of target_it <- coefficient of target_it + other_it->second * w
+          Arith_element x = coeff_field_.plus_times_equal(target_it->coefficient(), other_it->second, w);
+          if (x == coeff_field_.additive_identity()) {
             auto tmp_it = target_it;
             ++target_it;
             ++other_it;   // iterators remain valid
@@ -516,6 +641,7 @@ class Persistent_cohomology {
 
             cell_pool_.destroy(tmp_cell_ptr);  // delete from memory
           } else {
+            target_it->set_coefficient(x);
             ++target_it;
             ++other_it;
           }
@@ -524,7 +650,7 @@ class Persistent_cohomology {
     }
     while (other_it != other.end()) {
       Cell * cell_tmp = cell_pool_.construct(Cell(other_it->first, coeff_field_.additive_identity(), &target));
-      cell_tmp->coefficient_ = coeff_field_.plus_times_equal(cell_tmp->coefficient_, other_it->second, w);
+      cell_tmp->set_coefficient(coeff_field_.plus_times_equal(cell_tmp->coefficient(), other_it->second, w));
       target.col_.insert(target.col_.end(), *cell_tmp);
 
       ++other_it;
@@ -566,6 +692,20 @@ class Persistent_cohomology {
     }
   }
 
+  /** \brief Output the persistence diagram in ostream, in the binary format described in
+   * \ref FileFormatsPersBinary, which is faster to write and to read than the text format of `output_diagram()` and
+   * can be memory mapped. The fields of the coefficients are not stored.
+   *
+   * \tparam Value `float` or `double`, the type in which the births and deaths are stored.
+   */
+  template <typename Value = double>
+  void output_diagram_binary(std::ostream& ostream) const {
+    Persistence_diagram_binary_writer<Value> writer(ostream);
+    for (auto pair : persistent_pairs_) {
+      writer.write(cpx_->dimension(get<0>(pair)), cpx_->filtration(get<0>(pair)), cpx_->filtration(get<1>(pair)));
+    }
+  }
+
   void write_output_diagram(std::string diagram_name) {
     std::ofstream diagram_out(diagram_name.c_str());
     diagram_out.exceptions(diagram_out.failbit);
@@ -685,6 +825,79 @@ class Persistent_cohomology {
     return result;
   }
 
+  /** \brief Representative cocycles, in compressed sparse row format.
+   *
+   * The cocycle number `i` represents the class of the persistence interval `get_persistent_pairs()[intervals[i]]`,
+   * just before its death, or at the end of the filtration for an essential class. It takes the value
+   * `coefficients[j]` on the simplex of key `keys[j]`, for `offsets[i] <= j < offsets[i+1]`, and 0 on the other
+   * simplices. The key of a simplex is its position in `filtration_simplex_range()`.
+   */
+  struct Cocycles {
+    std::vector<std::size_t> intervals;
+    std::vector<std::size_t> offsets{0};
+    std::vector<Simplex_key> keys;
+    std::vector<Arith_element> coefficients;
+  };
+
+  /** \brief Records the representative cocycles of the next computations, for the intervals of dimension at least 1
+   * and of length strictly greater than `min_persistence`, essential intervals included.
+   *
+   * Only the cocycles are stored, and the compressed annotation matrix is not modified. The members of each disjoint
+   * set of simplices sharing an annotation are linked, which takes one more key per simplex, so that recording a
+   * cocycle only traverses its support.
+   */
+  void record_cocycles(Filtration_value min_persistence = 0) {
+    record_cocycles_ = true;
+    cocycle_min_persistence_ = min_persistence;
+  }
+
+  /** \brief Returns the representative cocycles recorded during the computation, see `record_cocycles()`. */
+  const Cocycles& cocycles() const {
+    return cocycles_;
+  }
+
+  /** \brief Memory footprint of the computation, in bytes, broken down by part. See `memory_usage()`. */
+  struct Memory_usage {
+    /** \brief Non-zero entries of the compressed annotation matrix, allocated in a pool. */
+    std::size_t cells = 0;
+    /** \brief Columns of the compressed annotation matrix, allocated in a pool. */
+    std::size_t columns = 0;
+    /** \brief Rows of the compressed annotation matrix, and their index by simplex key. */
+    std::size_t rows = 0;
+    /** \brief Union-find structure of the 0-dimensional cohomology, and its cocycles. */
+    std::size_t disjoint_sets = 0;
+    /** \brief Persistence intervals. */
+    std::size_t persistent_pairs = 0;
+    /** \brief Representative cocycles, see `record_cocycles()`. */
+    std::size_t cocycles = 0;
+
+    std::size_t total() const { return cells + columns + rows + disjoint_sets + persistent_pairs + cocycles; }
+  };
+
+  /** \brief Returns the memory currently used by the computation, in bytes, broken down by part, the filtered complex
+   * excluded. Buffers are counted with their capacity, and the nodes of the associative containers with an estimate of
+   * their overhead. The pools keep the memory of the cells and columns freed during the reduction, which is not
+   * counted.
+   */
+  Memory_usage memory_usage() const {
+    Memory_usage usage;
+    usage.cells = cell_pool_.num_objects() * sizeof(Cell);
+    usage.columns = column_pool_.num_objects() * sizeof(Column);
+    usage.rows = transverse_idx_.size() * (sizeof(typename decltype(transverse_idx_)::value_type) + sizeof(Hcell) +
+                                            3 * sizeof(void*));
+    usage.disjoint_sets = ds_rank_.capacity() * sizeof(int) + ds_parent_.capacity() * sizeof(Simplex_key) +
+                          ds_repr_.capacity() * sizeof(Column*) + ds_next_.capacity() * sizeof(Simplex_key) +
+                          zero_cocycles_.bucket_count() * sizeof(void*) +
+                          zero_cocycles_.size() * (sizeof(typename decltype(zero_cocycles_)::value_type) +
+                                                   2 * sizeof(void*));
+    usage.persistent_pairs = persistent_pairs_.capacity() * sizeof(Persistent_interval);
+    usage.cocycles = cocycles_.intervals.capacity() * sizeof(std::size_t) +
+                     cocycles_.offsets.capacity() * sizeof(std::size_t) +
+                     cocycles_.keys.capacity() * sizeof(Simplex_key) +
+                     cocycles_.coefficients.capacity() * sizeof(Arith_element);
+    return usage;
+  }
+
  private:
   /*
    * Structure representing a cocycle.
@@ -716,6 +929,9 @@ class Persistent_cohomology {
   std::vector<int> ds_rank_;
   std::vector<Simplex_key> ds_parent_;
   std::vector<Column *> ds_repr_;
+  /* Next member of the disjoint set of each simplex key, in a circular list. Only maintained when recording the
+   * cocycles. */
+  std::vector<Simplex_key> ds_next_;
   boost::disjoint_sets<int *, Simplex_key *> dsets_;
   /* The compressed annotation matrix fields.*/
   Cam cam_;
@@ -731,6 +947,10 @@ class Persistent_cohomology {
 
   Simple_object_pool<Column> column_pool_;
   Simple_object_pool<Cell> cell_pool_;
+  /* Recording of the representative cocycles. */
+  bool record_cocycles_ = false;
+  Filtration_value cocycle_min_persistence_ = 0;
+  Cocycles cocycles_;
 };
 
 }  // namespace persistent_cohomology
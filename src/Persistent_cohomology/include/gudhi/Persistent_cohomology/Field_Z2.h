@@ -0,0 +1,81 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef PERSISTENT_COHOMOLOGY_FIELD_Z2_H_
+#define PERSISTENT_COHOMOLOGY_FIELD_Z2_H_
+
+#include <utility>
+#include <stdexcept>
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+/** \brief Structure representing the coefficient field \f$\mathbb{Z}/2\mathbb{Z}\f$
+ *
+ * Same as `Field_Zp` initialized with 2, with bitwise operations instead of modular arithmetic. With this field,
+ * `Persistent_cohomology` does not store the coefficients of the annotation matrix, which are all 1.
+ *
+ * \implements CoefficientField
+ * \ingroup persistent_cohomology
+ */
+class Field_Z2 {
+ public:
+  typedef int Element;
+
+  /** Only 2 is a valid characteristic. */
+  void init(int charac) {
+    if (charac != 2)
+      throw std::invalid_argument("Field_Z2 homology_coeff_field must be 2");
+  }
+
+  /** Set x <- x + w * y*/
+  Element plus_times_equal(const Element& x, const Element& y, const Element& w) {
+    return x ^ (y & w & 1);
+  }
+
+  /** Returns y * w */
+  Element times(const Element& y, const Element& w) {
+    return y & w & 1;
+  }
+
+  Element plus_equal(const Element& x, const Element& y) {
+    return x ^ y;
+  }
+
+  /** \brief Returns the additive idendity \f$0_{\Bbbk}\f$ of the field.*/
+  Element additive_identity() const {
+    return 0;
+  }
+  /** \brief Returns the multiplicative identity \f$1_{\Bbbk}\f$ of the field.*/
+  Element multiplicative_identity(Element = 0) const {
+    return 1;
+  }
+  /** Returns the inverse in the field, and P. */
+  std::pair<Element, Element> inverse(Element x, Element P) {
+    return std::pair<Element, Element>(x, P);
+  }
+
+  /** Returns -x * y.*/
+  Element times_minus(Element x, Element y) {
+    return x & y;
+  }
+
+  /** \brief Returns the characteristic \f$p\f$ of the field.*/
+  int characteristic() const {
+    return 2;
+  }
+};
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENT_COHOMOLOGY_FIELD_Z2_H_
@@ -0,0 +1,644 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef PERSISTENT_MATRIX_REDUCTION_H_
+#define PERSISTENT_MATRIX_REDUCTION_H_
+
+#include <gudhi/Persistent_cohomology/Field_Zp.h>
+#include <gudhi/Cancellation.h>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>  // for std::max, std::min, std::fill, std::equal
+#include <chrono>
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t, std::uint64_t
+#include <cstdio>  // for std::rename, std::remove
+#include <fstream>
+#include <functional>  // for std::hash
+#include <iostream>
+#include <limits>
+#include <stdexcept>  // for std::out_of_range, std::invalid_argument
+#include <string>
+#include <tuple>
+#include <type_traits>  // for std::conditional_t
+#include <utility>  // for std::pair
+#include <vector>
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+/** \brief Computes the persistent homology of a filtered complex by reduction of its boundary matrix.
+ *
+ * \ingroup persistent_cohomology
+ *
+ * This is an alternative to `Persistent_cohomology`, with the same interface and the same persistence diagram, for a
+ * single coefficient field. The 0-dimensional pairs are computed with a union-find on the edges. The boundary matrix
+ * of the higher dimensions is stored in a compressed sparse column format and transposed, and the coboundaries are
+ * reduced from the lowest dimension to the highest one, skipping the coboundaries of the simplices that were paired
+ * as deaths in the previous dimension, as they reduce to zero (clearing, or twist \cite Chen11persistenthomology ).
+ * The reduction of the anti-transposed boundary matrix gives the same pairs
+ * \cite DBLP:journals/corr/abs-1107-5665 , and avoids the reduction to zero of the many positive columns of the top
+ * dimension.
+ * With \f$\mathbb{Z}/2\mathbb{Z}\f$ coefficients, the columns are sorted vectors of indices, and are added with a
+ * symmetric difference.
+ *
+ * When GUDHI_USE_TBB is defined, the boundaries are computed in parallel, and the coboundaries of a dimension are
+ * reduced by batches: first in parallel by the columns of the previous batches, then sequentially by the ones of
+ * their batch. The output, including the order of the persistent pairs, does not depend on the number of threads.
+ *
+ * A long reduction can save its state between two batches, and be resumed after an interruption, see
+ * `set_checkpoint`.
+ *
+ * \implements PersistentHomology
+ *
+ * @tparam FilteredComplex A model of FilteredComplex.
+ * @tparam CoefficientField `Field_Zp`; `Multi_field` is not supported.
+ */
+template<class FilteredComplex, class CoefficientField = Field_Zp>
+class Persistent_matrix_reduction {
+ public:
+  /** \brief Data stored for each simplex. */
+  typedef typename FilteredComplex::Simplex_key Simplex_key;
+  /** \brief Handle to specify a simplex. */
+  typedef typename FilteredComplex::Simplex_handle Simplex_handle;
+  /** \brief Type for the value of the filtration function. */
+  typedef typename FilteredComplex::Filtration_value Filtration_value;
+  /** \brief Type of element of the field. */
+  typedef typename CoefficientField::Element Arith_element;
+  /** \brief Type for birth and death FilteredComplex::Simplex_handle, and the characteristic of the field. */
+  typedef std::tuple<Simplex_handle, Simplex_handle, Arith_element> Persistent_interval;
+
+  /** \brief Initializes the Persistent_matrix_reduction class.
+   *
+   * @param[in] cpx Complex for which the persistent homology is computed.
+   * cpx is a model of FilteredComplex
+   *
+   * @param[in] persistence_dim_max if true, the persistent homology for the maximal dimension in the
+   *                                complex is computed. If false, it is ignored. Default is false.
+   *
+   * @exception std::out_of_range In case the number of simplices is more than Simplex_key type numeric limit.
+   */
+  explicit Persistent_matrix_reduction(FilteredComplex& cpx, bool persistence_dim_max = false)
+      : cpx_(&cpx),
+        dim_max_(cpx.dimension()),
+        coeff_field_(),
+        num_simplices_(cpx_->num_simplices()) {
+    if (num_simplices_ > std::numeric_limits<Simplex_key>::max()) {
+      // num_simplices must be strictly lower than the limit, because a value is reserved for null_key.
+      throw std::out_of_range("The number of simplices is more than Simplex_key type numeric limit.");
+    }
+    if (persistence_dim_max) {
+      ++dim_max_;
+    }
+  }
+
+  /** \brief Initializes the coefficient field.*/
+  void init_coefficients(int charac) {
+    coeff_field_.init(charac);
+  }
+
+  /** \brief Saves the state of the reduction in a file, so that it can be resumed after an interruption.
+   *
+   * During `compute_persistent_cohomology`, the pairs found so far, the reduced columns of the current dimension and
+   * the progress of the reduction are written to `path` between two batches of columns, when `interval` has elapsed
+   * since the previous checkpoint, and when the reduction is cancelled. The file is written aside and renamed, so
+   * that an interruption while it is written leaves the previous checkpoint. The time spent writing the checkpoints
+   * is bounded by `max_overhead` times the time of the reduction: after a checkpoint that took t seconds, the next
+   * one is written t / max_overhead seconds later at the earliest.
+   *
+   * If `path` exists when `compute_persistent_cohomology` starts, the reduction resumes from it, with the 0-dimensional
+   * pairs and the columns already reduced. The file is removed when the computation completes.
+   *
+   * @param[in] path Path of the checkpoint. An empty path disables the checkpoints.
+   * @param[in] interval Minimal time between two checkpoints. Default is 10 minutes.
+   * @param[in] max_overhead Maximal fraction of the time spent writing the checkpoints. Default is 1%.
+   */
+  void set_checkpoint(const std::string& path,
+                      std::chrono::duration<double> interval = std::chrono::minutes(10), double max_overhead = 0.01) {
+    checkpoint_path_ = path;
+    checkpoint_interval_ = interval;
+    checkpoint_max_overhead_ = max_overhead;
+  }
+
+  /** \brief Compute the persistent homology of the filtered simplicial complex.
+   *
+   * @param[in] min_interval_length the computation discards all intervals of length
+   *                                less or equal than min_interval_length
+   *
+   * Assumes that the filtration provided by the simplicial complex is
+   * valid. Undefined behavior otherwise.
+   *
+   * The reduction checks the `Cancellation_flag` of the `Cancellation_scope` of the calling thread, if any, before
+   * each batch of columns, and throws `Cancelled` if it is raised.
+   *
+   * @exception std::invalid_argument If the checkpoint of `set_checkpoint` exists and was not written for this
+   * complex, filtration, coefficient field and parameters.
+   * @exception std::ios_base::failure If the checkpoint cannot be read or written. */
+  void compute_persistent_cohomology(Filtration_value min_interval_length = 0) {
+    min_interval_length_ = min_interval_length;
+    persistent_pairs_.clear();
+    num_shortcut_pairs_ = 0;
+    build_boundary_matrix();
+    last_checkpoint_ = Clock::now();
+    last_checkpoint_duration_ = Clock::duration::zero();
+    const bool resume = !checkpoint_path_.empty() && std::ifstream(checkpoint_path_).good();
+    if (!resume) reduce_vertices_and_edges();
+    if (coeff_field_.characteristic() == 2)
+      reduce<true>(resume);
+    else
+      reduce<false>(resume);
+    // Essential classes: the positive simplices that were not paired
+    for (Simplex_key key = 0; key < num_simplices_; ++key) {
+      if (!paired_[key] && positive_[key] && dimensions_[key] < std::max(dim_max_, 1))
+        persistent_pairs_.emplace_back(simplices_[key], cpx_->null_simplex(), coeff_field_.characteristic());
+    }
+    if (!checkpoint_path_.empty()) std::remove(checkpoint_path_.c_str());
+  }
+
+ private:
+  typedef std::pair<Simplex_key, Arith_element> Entry;
+
+  /* Keys in the order of the filtration, and boundaries in a compressed sparse column format. */
+  void build_boundary_matrix() {
+    simplices_.clear();
+    simplices_.reserve(num_simplices_);
+    dimensions_.clear();
+    dimensions_.reserve(num_simplices_);
+    Simplex_key key = 0;
+    // Identifies the complex and the parameters in the checkpoints
+    fingerprint_ = mix_fingerprint(mix_fingerprint(mix_fingerprint(num_simplices_, dim_max_),
+                                                   coeff_field_.characteristic()),
+                                   std::hash<Filtration_value>()(min_interval_length_));
+    for (auto sh : cpx_->filtration_simplex_range()) {
+      cpx_->assign_key(sh, key++);
+      simplices_.push_back(sh);
+      dimensions_.push_back(cpx_->dimension(sh));
+      fingerprint_ = mix_fingerprint(mix_fingerprint(fingerprint_, dimensions_.back()),
+                                     std::hash<Filtration_value>()(cpx_->filtration(sh)));
+    }
+    // The edges are reduced with a union-find, and the columns above dim_max_ are not needed
+    auto has_boundary = [this](Simplex_key key) { return dimensions_[key] >= 2 && dimensions_[key] <= dim_max_; };
+    boundary_offsets_.assign(num_simplices_ + 1, 0);
+    for (Simplex_key key = 0; key < num_simplices_; ++key)
+      boundary_offsets_[key + 1] = boundary_offsets_[key] + (has_boundary(key) ? dimensions_[key] + 1 : 0);
+    boundaries_.resize(boundary_offsets_.back());
+    // The boundaries are independent lookups in the complex, and are filled in parallel with TBB
+    auto fill_boundary = [this, &has_boundary](Simplex_key key) {
+      if (!has_boundary(key)) return;
+      std::size_t i = boundary_offsets_[key];
+      int sign = 1 - 2 * (dimensions_[key] % 2);
+      for (auto sh : cpx_->boundary_simplex_range(simplices_[key])) {
+        boundaries_[i++] = Entry(cpx_->key(sh), sign == 1 ? coeff_field_.multiplicative_identity()
+                                                           : coeff_field_.times_minus(1, 1));
+        sign = -sign;
+      }
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(Simplex_key(0), static_cast<Simplex_key>(num_simplices_), fill_boundary);
+#else
+    for (Simplex_key key = 0; key < num_simplices_; ++key) fill_boundary(key);
+#endif
+    paired_.assign(num_simplices_, false);
+    positive_.assign(num_simplices_, true);
+  }
+
+  /* 0-dimensional pairs with a union-find, the root of a connected component being its oldest vertex. */
+  void reduce_vertices_and_edges() {
+    std::vector<Simplex_key> parent(num_simplices_);
+    auto find = [&parent](Simplex_key key) {
+      while (parent[key] != key) {
+        parent[key] = parent[parent[key]];  // path halving
+        key = parent[key];
+      }
+      return key;
+    };
+    for (Simplex_key key = 0; key < num_simplices_; ++key) {
+      if (dimensions_[key] == 0) {
+        parent[key] = key;
+      } else if (dimensions_[key] == 1) {
+        Simplex_handle u, v;
+        std::tie(u, v) = cpx_->endpoints(simplices_[key]);
+        Simplex_key ku = find(cpx_->key(u));
+        Simplex_key kv = find(cpx_->key(v));
+        if (ku == kv) continue;
+        if (ku < kv) std::swap(ku, kv);
+        // The younger component dies
+        parent[ku] = kv;
+        paired_[ku] = true;
+        positive_[key] = false;
+        add_pair(ku, key);
+      }
+    }
+  }
+
+  /* Reduction of the coboundary matrix, the anti-transpose of the boundary matrix, from dimension 1 to dim_max_ - 1.
+   * A column is a coboundary, its pivot is its oldest coface, and the columns are reduced from the youngest to the
+   * oldest. The pairs are the same as with the boundary matrix, and the coboundaries of the deaths of intervals of
+   * the previous dimension are skipped, as they reduce to zero (clearing). If resume, the state is read from the
+   * checkpoint instead of starting from the first column of dimension 1. */
+  template<bool Z2>
+  void reduce(bool resume) {
+    typedef std::conditional_t<Z2, Simplex_key, Entry> Column_entry;
+    auto row = [](const Column_entry& entry) {
+      if constexpr (Z2) return entry; else return entry.first;
+    };
+    // Transposition of the boundaries, the coboundaries being sorted by key as the boundaries are filled by key
+    std::vector<std::size_t> coboundary_offsets(num_simplices_ + 1, 0);
+    for (const Entry& entry : boundaries_) ++coboundary_offsets[entry.first + 1];
+    for (std::size_t key = 0; key < num_simplices_; ++key) coboundary_offsets[key + 1] += coboundary_offsets[key];
+    std::vector<Entry> coboundaries(boundaries_.size());
+    {
+      std::vector<std::size_t> fill(coboundary_offsets.begin(), coboundary_offsets.end() - 1);
+      for (Simplex_key key = 0; key < num_simplices_; ++key) {
+        for (std::size_t i = boundary_offsets_[key]; i < boundary_offsets_[key + 1]; ++i)
+          coboundaries[fill[boundaries_[i].first]++] = Entry(key, boundaries_[i].second);
+      }
+    }
+    std::vector<Entry>().swap(boundaries_);
+    std::vector<std::size_t>().swap(boundary_offsets_);
+
+    std::vector<std::vector<Column_entry>> reduced(num_simplices_);
+    std::vector<Simplex_key> pivot_owner(num_simplices_, null_key());
+    // Emergent pairs: a column whose pivot has no owner when it is reduced is paired as is, and is not copied
+    std::vector<bool> emergent(num_simplices_, false);
+    auto load = [&](Simplex_key key) {
+      std::vector<Column_entry>& column = reduced[key];
+      column.reserve(coboundary_offsets[key + 1] - coboundary_offsets[key]);
+      for (std::size_t i = coboundary_offsets[key]; i < coboundary_offsets[key + 1]; ++i) {
+        if constexpr (Z2) column.push_back(coboundaries[i].first); else column.push_back(coboundaries[i]);
+      }
+    };
+    auto unreduced_pivot_owner = [&](Simplex_key key) {
+      if (coboundary_offsets[key] == coboundary_offsets[key + 1]) return null_key();
+      return pivot_owner[coboundaries[coboundary_offsets[key]].first];
+    };
+    // buffer = column + (the multiple of other that cancels the pivot of column)
+    auto add = [&](const std::vector<Column_entry>& column, auto other_begin, auto other_end,
+                   std::vector<Column_entry>& buffer) {
+      buffer.clear();
+      if constexpr (Z2) {
+        auto it = column.begin();
+        while (it != column.end() || other_begin != other_end) {
+          if (other_begin == other_end || (it != column.end() && *it < entry_row(*other_begin))) {
+            buffer.push_back(*it++);
+          } else if (it == column.end() || entry_row(*other_begin) < *it) {
+            buffer.push_back(entry_row(*other_begin++));
+          } else {
+            ++it;
+            ++other_begin;
+          }
+        }
+      } else {
+        // column - (column[pivot] / other[pivot]) * other
+        const Arith_element w = coeff_field_.times_minus(
+            column.front().second, coeff_field_.inverse(other_begin->second, coeff_field_.characteristic()).first);
+        add_multiple(column, other_begin, other_end, w, buffer);
+      }
+    };
+    // Adds the columns with the same pivot, registered in pivot_owner, until the pivot of column is new
+    auto reduce_column = [&](std::vector<Column_entry>& column, std::vector<Column_entry>& buffer) {
+      while (!column.empty() && pivot_owner[row(column.front())] != null_key()) {
+        const Simplex_key other = pivot_owner[row(column.front())];
+        if (emergent[other]) {
+          add(column, coboundaries.cbegin() + coboundary_offsets[other],
+              coboundaries.cbegin() + coboundary_offsets[other + 1], buffer);
+        } else {
+          add(column, reduced[other].cbegin(), reduced[other].cend(), buffer);
+        }
+        column.swap(buffer);
+      }
+    };
+
+    auto pair_column = [&](Simplex_key key, Simplex_key pivot) {
+      pivot_owner[pivot] = key;
+      paired_[key] = true;
+      positive_[pivot] = false;
+      add_pair(key, pivot);
+    };
+
+    std::vector<Simplex_key> columns;
+    std::vector<Column_entry> buffer;
+    std::vector<char> loaded(reduction_batch_size);
+    const Cancellation_flag* cancellation = current_cancellation_flag();
+    int first_dim = 1;
+    std::size_t first_column = 0;
+    if (resume) read_checkpoint(first_dim, first_column, reduced, pivot_owner, emergent);
+    for (int dim = first_dim; dim < dim_max_; ++dim) {
+      // Clearing: a death has a coboundary that reduces to zero
+      columns.clear();
+      for (Simplex_key key = num_simplices_; key-- > 0;)
+        if (dimensions_[key] == dim && positive_[key]) columns.push_back(key);
+      // The columns are reduced by batches. With TBB, the columns of a batch are first reduced in parallel by the
+      // columns of the previous batches, whose pivots are final. They are then reduced sequentially, in order, by the
+      // ones of the batch. The pairs do not depend on the order of the additions, as long as a column is only added
+      // to the following ones, so that the output does not depend on the number of threads.
+      for (std::size_t begin = dim == first_dim ? first_column : 0; begin < columns.size();
+           begin += reduction_batch_size) {
+        if (!checkpoint_path_.empty() &&
+            (checkpoint_due() || (cancellation != nullptr && cancellation->is_cancelled())))
+          write_checkpoint(dim, begin, reduced, pivot_owner, emergent);
+        check_cancellation(cancellation);
+        const std::size_t end = std::min(columns.size(), begin + reduction_batch_size);
+        std::fill(loaded.begin(), loaded.end(), false);
+#ifdef GUDHI_USE_TBB
+        tbb::parallel_for(begin, end, [&](std::size_t i) {
+          // The columns that may be emergent are left to the sequential reduction
+          if (unreduced_pivot_owner(columns[i]) == null_key()) return;
+          std::vector<Column_entry> local_buffer;
+          load(columns[i]);
+          reduce_column(reduced[columns[i]], local_buffer);
+          loaded[i - begin] = true;
+        });
+#endif
+        for (std::size_t i = begin; i < end; ++i) {
+          const Simplex_key key = columns[i];
+          std::vector<Column_entry>& column = reduced[key];
+          if (!loaded[i - begin]) {
+            if (coboundary_offsets[key] == coboundary_offsets[key + 1]) continue;
+            if (unreduced_pivot_owner(key) == null_key()) {
+              emergent[key] = true;
+              ++num_shortcut_pairs_;
+              pair_column(key, coboundaries[coboundary_offsets[key]].first);
+              continue;
+            }
+            load(key);
+          }
+          reduce_column(column, buffer);
+          if (column.empty()) {
+            std::vector<Column_entry>().swap(column);
+            continue;
+          }
+          pair_column(key, row(column.front()));
+        }
+      }
+    }
+  }
+
+  /* out = column + w * other, without the zero coefficients. */
+  template<class Iterator>
+  void add_multiple(const std::vector<Entry>& column, Iterator other_it, Iterator other_end, Arith_element w,
+                    std::vector<Entry>& out) {
+    auto it = column.begin();
+    while (it != column.end() || other_it != other_end) {
+      if (other_it == other_end || (it != column.end() && it->first < other_it->first)) {
+        out.push_back(*it++);
+      } else if (it == column.end() || other_it->first < it->first) {
+        out.emplace_back(other_it->first, coeff_field_.times(other_it->second, w));
+        ++other_it;
+      } else {
+        const Arith_element x = coeff_field_.plus_times_equal(it->second, other_it->second, w);
+        if (x != coeff_field_.additive_identity()) out.emplace_back(it->first, x);
+        ++it;
+        ++other_it;
+      }
+    }
+  }
+
+  static Simplex_key entry_row(Simplex_key key) { return key; }
+  static Simplex_key entry_row(const Entry& entry) { return entry.first; }
+
+  void add_pair(Simplex_key birth, Simplex_key death) {
+    if (cpx_->filtration(simplices_[death]) - cpx_->filtration(simplices_[birth]) > min_interval_length_)
+      persistent_pairs_.emplace_back(simplices_[birth], simplices_[death], coeff_field_.characteristic());
+  }
+
+  static Simplex_key null_key() { return std::numeric_limits<Simplex_key>::max(); }
+
+  typedef std::chrono::steady_clock Clock;
+
+  static std::uint64_t mix_fingerprint(std::uint64_t fingerprint, std::uint64_t value) {
+    return (fingerprint ^ value) * 0x100000001b3ULL;
+  }
+
+  bool checkpoint_due() const {
+    const auto elapsed = Clock::now() - last_checkpoint_;
+    return elapsed >= checkpoint_interval_ &&
+           elapsed * checkpoint_max_overhead_ >= last_checkpoint_duration_;
+  }
+
+  template<class T>
+  static void write_value(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template<class T>
+  static T read_value(std::istream& in) {
+    T value;
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+  }
+
+  static void write_flags(std::ostream& out, const std::vector<bool>& flags) {
+    std::vector<char> bytes(flags.begin(), flags.end());
+    out.write(bytes.data(), bytes.size());
+  }
+
+  static void read_flags(std::istream& in, std::vector<bool>& flags) {
+    std::vector<char> bytes(flags.size());
+    in.read(bytes.data(), bytes.size());
+    flags.assign(bytes.begin(), bytes.end());
+  }
+
+  /* The checkpoint is: magic, version, fingerprint, dimension and first column of the next batch, number of shortcut
+   * pairs, paired_, positive_ and emergent as bytes, pivot_owner, the pairs as keys, and the non empty reduced
+   * columns of the dimension, each one as its key, its size and its entries, until null_key(). */
+  template<class Column_entry>
+  void write_checkpoint(int dim, std::size_t begin, const std::vector<std::vector<Column_entry>>& reduced,
+                        const std::vector<Simplex_key>& pivot_owner, const std::vector<bool>& emergent) {
+    const auto start = Clock::now();
+    const std::string tmp_path = checkpoint_path_ + ".tmp";
+    {
+      std::ofstream out(tmp_path, std::ios::binary);
+      out.exceptions(std::ios::failbit | std::ios::badbit);
+      out.write(checkpoint_magic, sizeof(checkpoint_magic));
+      write_value(out, checkpoint_version);
+      write_value(out, fingerprint_);
+      write_value(out, static_cast<std::int32_t>(dim));
+      write_value(out, static_cast<std::uint64_t>(begin));
+      write_value(out, static_cast<std::uint64_t>(num_shortcut_pairs_));
+      write_flags(out, paired_);
+      write_flags(out, positive_);
+      write_flags(out, emergent);
+      out.write(reinterpret_cast<const char*>(pivot_owner.data()), pivot_owner.size() * sizeof(Simplex_key));
+      write_value(out, static_cast<std::uint64_t>(persistent_pairs_.size()));
+      for (const Persistent_interval& pair : persistent_pairs_) {
+        write_value(out, cpx_->key(get<0>(pair)));
+        write_value(out, cpx_->key(get<1>(pair)));
+      }
+      for (Simplex_key key = 0; key < num_simplices_; ++key) {
+        if (dimensions_[key] != dim || reduced[key].empty()) continue;
+        write_value(out, key);
+        write_value(out, static_cast<std::uint64_t>(reduced[key].size()));
+        for (const Column_entry& entry : reduced[key]) {
+          write_value(out, entry_row(entry));
+          if constexpr (!std::is_same_v<Column_entry, Simplex_key>) write_value(out, entry.second);
+        }
+      }
+      write_value(out, null_key());
+    }
+    if (std::rename(tmp_path.c_str(), checkpoint_path_.c_str()) != 0)
+      throw std::ios_base::failure("Persistent_matrix_reduction - cannot rename " + tmp_path);
+    last_checkpoint_ = Clock::now();
+    last_checkpoint_duration_ = last_checkpoint_ - start;
+  }
+
+  template<class Column_entry>
+  void read_checkpoint(int& dim, std::size_t& begin, std::vector<std::vector<Column_entry>>& reduced,
+                       std::vector<Simplex_key>& pivot_owner, std::vector<bool>& emergent) {
+    std::ifstream in(checkpoint_path_, std::ios::binary);
+    in.exceptions(std::ios::failbit | std::ios::badbit);
+    char magic[sizeof(checkpoint_magic)];
+    in.read(magic, sizeof(magic));
+    if (!std::equal(magic, magic + sizeof(magic), checkpoint_magic) ||
+        read_value<std::uint32_t>(in) != checkpoint_version)
+      throw std::invalid_argument("Persistent_matrix_reduction - " + checkpoint_path_ + " is not a checkpoint");
+    if (read_value<std::uint64_t>(in) != fingerprint_)
+      throw std::invalid_argument("Persistent_matrix_reduction - " + checkpoint_path_ +
+                                  " does not match the complex or the parameters");
+    dim = read_value<std::int32_t>(in);
+    begin = read_value<std::uint64_t>(in);
+    num_shortcut_pairs_ = read_value<std::uint64_t>(in);
+    read_flags(in, paired_);
+    read_flags(in, positive_);
+    read_flags(in, emergent);
+    in.read(reinterpret_cast<char*>(pivot_owner.data()), pivot_owner.size() * sizeof(Simplex_key));
+    persistent_pairs_.resize(read_value<std::uint64_t>(in));
+    for (Persistent_interval& pair : persistent_pairs_) {
+      const Simplex_key birth = read_value<Simplex_key>(in);
+      const Simplex_key death = read_value<Simplex_key>(in);
+      pair = Persistent_interval(simplices_[birth], simplices_[death], coeff_field_.characteristic());
+    }
+    for (Simplex_key key = read_value<Simplex_key>(in); key != null_key(); key = read_value<Simplex_key>(in)) {
+      std::vector<Column_entry>& column = reduced[key];
+      column.resize(read_value<std::uint64_t>(in));
+      for (Column_entry& entry : column) {
+        if constexpr (std::is_same_v<Column_entry, Simplex_key>) {
+          entry = read_value<Simplex_key>(in);
+        } else {
+          entry.first = read_value<Simplex_key>(in);
+          entry.second = read_value<Arith_element>(in);
+        }
+      }
+    }
+  }
+
+  static constexpr char checkpoint_magic[8] = {'G', 'U', 'D', 'H', 'I', 'C', 'K', 'P'};
+  static constexpr std::uint32_t checkpoint_version = 1;
+
+  /* Number of columns reduced in parallel, before their sequential reduction by each other. */
+  static constexpr std::size_t reduction_batch_size = 1 << 12;
+
+ public:
+  /** \brief Output the persistence diagram in ostream, in the same format as
+   * `Persistent_cohomology::output_diagram`. */
+  void output_diagram(std::ostream& ostream = std::cout) {
+    for (auto pair : persistent_pairs_) {
+      ostream << get<2>(pair) << "  " << cpx_->dimension(get<0>(pair)) << " "
+        << cpx_->filtration(get<0>(pair)) << " "
+        << cpx_->filtration(get<1>(pair)) << " " << std::endl;
+    }
+  }
+
+  /** @brief Returns Betti numbers.
+   * @return A vector of Betti numbers.
+   */
+  std::vector<int> betti_numbers() const {
+    std::vector<int> betti_numbers(std::max(dim_max_, 0));
+    for (auto pair : persistent_pairs_) {
+      if (cpx_->null_simplex() == get<1>(pair)) betti_numbers[cpx_->dimension(get<0>(pair))] += 1;
+    }
+    return betti_numbers;
+  }
+
+  /** @brief Returns the persistent Betti numbers.
+   * @param[in] from The persistence birth limit to be added in the number \f$(persistent birth \leq from)\f$.
+   * @param[in] to The persistence death limit to be added in the number  \f$(persistent death > to)\f$.
+   * @return A vector of persistent Betti numbers.
+   */
+  std::vector<int> persistent_betti_numbers(Filtration_value from, Filtration_value to) const {
+    std::vector<int> betti_numbers(std::max(dim_max_, 0));
+    for (auto pair : persistent_pairs_) {
+      if (cpx_->filtration(get<0>(pair)) <= from &&
+          (get<1>(pair) == cpx_->null_simplex() || cpx_->filtration(get<1>(pair)) > to)) {
+        betti_numbers[cpx_->dimension(get<0>(pair))] += 1;
+      }
+    }
+    return betti_numbers;
+  }
+
+  /** @brief Returns the number of pairs of positive dimension found without any column addition by the last call
+   * to `compute_persistent_cohomology`, including the ones shorter than `min_interval_length`.
+   *
+   * These are the emergent pairs: the oldest coface of the simplex is not the pivot of a previously reduced column,
+   * so that the coboundary is already reduced, and is neither copied nor stored. They include the apparent pairs,
+   * where the simplex is also the youngest face of its oldest coface, that make most of the pairs of Rips
+   * filtrations. */
+  std::size_t num_shortcut_pairs() const {
+    return num_shortcut_pairs_;
+  }
+
+  /** @brief Returns a list of persistence birth and death FilteredComplex::Simplex_handle pairs.
+   * @return A list of Persistent_matrix_reduction::Persistent_interval
+   */
+  const std::vector<Persistent_interval>& get_persistent_pairs() const {
+    return persistent_pairs_;
+  }
+
+  /** @brief Returns persistence intervals for a given dimension.
+   * @param[in] dimension Dimension to get the birth and death pairs from.
+   * @return A vector of persistence intervals (birth and death) on a fixed dimension.
+   */
+  std::vector<std::pair<Filtration_value, Filtration_value>> intervals_in_dimension(int dimension) {
+    std::vector<std::pair<Filtration_value, Filtration_value>> result;
+    for (auto&& pair : persistent_pairs_) {
+      if (cpx_->dimension(get<0>(pair)) == dimension) {
+        result.emplace_back(cpx_->filtration(get<0>(pair)), cpx_->filtration(get<1>(pair)));
+      }
+    }
+    return result;
+  }
+
+ private:
+  FilteredComplex* cpx_;
+  int dim_max_;
+  CoefficientField coeff_field_;
+  std::size_t num_simplices_;
+  Filtration_value min_interval_length_ = 0;
+  std::size_t num_shortcut_pairs_ = 0;
+
+  /* Checkpoints, see set_checkpoint, and the fingerprint of the complex and the parameters that they store */
+  std::string checkpoint_path_;
+  std::chrono::duration<double> checkpoint_interval_ = std::chrono::minutes(10);
+  double checkpoint_max_overhead_ = 0.01;
+  Clock::time_point last_checkpoint_;
+  Clock::duration last_checkpoint_duration_ = Clock::duration::zero();
+  std::uint64_t fingerprint_ = 0;
+
+  /* Simplices and their dimensions, by key */
+  std::vector<Simplex_handle> simplices_;
+  std::vector<int> dimensions_;
+  /* Boundary of the simplex of key k: boundaries_[boundary_offsets_[k]], ..., boundaries_[boundary_offsets_[k+1]-1] */
+  std::vector<std::size_t> boundary_offsets_;
+  std::vector<Entry> boundaries_;
+  /* paired_[k] if k is the birth of a finite interval, positive_[k] if k is not the death of an interval */
+  std::vector<bool> paired_;
+  std::vector<bool> positive_;
+  std::vector<Persistent_interval> persistent_pairs_;
+};
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENT_MATRIX_REDUCTION_H_
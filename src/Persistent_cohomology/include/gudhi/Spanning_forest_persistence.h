@@ -0,0 +1,260 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef SPANNING_FOREST_PERSISTENCE_H_
+#define SPANNING_FOREST_PERSISTENCE_H_
+
+#include <gudhi/Debug_utils.h>
+
+#include <algorithm>
+#include <cstddef>  // for std::size_t
+#include <stdexcept>
+#include <tuple>
+#include <utility>  // for std::move
+#include <vector>
+
+namespace Gudhi {
+
+namespace persistent_cohomology {
+
+/** \brief Edge of a filtered graph, with the filtration values of its vertices.
+ *
+ * \details The 0-dimensional persistence of a filtered complex only depends on its graph, and more precisely on a
+ * minimum spanning forest of its graph, with the filtration values of the vertices. Minimum spanning forests can be
+ * computed independently on parts of the edges, e.g. on several machines, and merged: the minimum spanning forest of
+ * the union of two forests is a minimum spanning forest of the union of their graphs.
+ */
+template <typename Vertex, typename Filtration_value>
+struct Spanning_forest_edge {
+  Vertex u, v;
+  Filtration_value birth_u, birth_v;
+  Filtration_value filtration;
+};
+
+/** \private Union-find on the vertices of a set of edges, numbered by their rank among the vertices. */
+template <typename Edge>
+struct Spanning_forest_union_find {
+  using Vertex = decltype(Edge::u);
+
+  explicit Spanning_forest_union_find(const std::vector<Edge>& edges) {
+    vertices.reserve(2 * edges.size());
+    for (const Edge& e : edges) {
+      vertices.push_back(e.u);
+      vertices.push_back(e.v);
+    }
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+    parent.resize(vertices.size());
+    for (std::size_t i = 0; i < parent.size(); ++i) parent[i] = i;
+  }
+
+  std::size_t index(Vertex v) const { return std::lower_bound(vertices.begin(), vertices.end(), v) - vertices.begin(); }
+
+  std::size_t find(std::size_t i) {
+    while (parent[i] != i) i = parent[i] = parent[parent[i]];
+    return i;
+  }
+
+  std::vector<Vertex> vertices;
+  std::vector<std::size_t> parent;
+};
+
+/** \brief Sorts edges by filtration value, and then by vertices, which makes the minimum spanning forests unique. */
+template <typename Edge>
+void sort_spanning_forest_edges(std::vector<Edge>& edges) {
+  std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) {
+    return std::make_tuple(a.filtration, a.u, a.v) < std::make_tuple(b.filtration, b.u, b.v);
+  });
+}
+
+/** \brief Minimum spanning forest of a graph, with Kruskal's algorithm.
+ *
+ * @param[in] edges The edges of the graph, in any order. An edge appears once, in any direction.
+ * @return The edges of the forest, sorted by `sort_spanning_forest_edges()`.
+ */
+template <typename Edge>
+std::vector<Edge> minimum_spanning_forest(std::vector<Edge> edges) {
+  sort_spanning_forest_edges(edges);
+  Spanning_forest_union_find<Edge> components(edges);
+  std::size_t forest_size = 0;
+  for (const Edge& e : edges) {
+    const std::size_t ru = components.find(components.index(e.u));
+    const std::size_t rv = components.find(components.index(e.v));
+    if (ru == rv) continue;
+    components.parent[ru] = rv;
+    edges[forest_size++] = e;
+  }
+  edges.resize(forest_size);
+  return edges;
+}
+
+/** \brief Minimum spanning forest of the union of the graphs of two minimum spanning forests. */
+template <typename Edge>
+std::vector<Edge> merge_spanning_forests(std::vector<Edge> forest, const std::vector<Edge>& other) {
+  forest.insert(forest.end(), other.begin(), other.end());
+  return minimum_spanning_forest(std::move(forest));
+}
+
+/** \brief 0-dimensional persistence of a filtered graph, from a minimum spanning forest of the graph.
+ *
+ * \details When two connected components merge at the filtration value of an edge of the forest, the one with the
+ * largest birth dies (elder rule). The vertices which do not belong to any edge of the forest are ignored, as they are
+ * isolated in the graph.
+ *
+ * @param[in] forest A minimum spanning forest, e.g. from `minimum_spanning_forest()`.
+ * @param[out] out0 For each interval (b, d) of the diagram with b < d, the function calls `out0(b, d)`.
+ * @param[out] out_essential For each connected component of the forest, the function calls `out_essential(b)`, with b
+ * the minimal birth of its vertices.
+ */
+template <typename Edge, typename Out0, typename Out_essential>
+void zero_persistence_of_spanning_forest(std::vector<Edge> forest, Out0&& out0, Out_essential&& out_essential) {
+  using Filtration_value = decltype(Edge::filtration);
+  sort_spanning_forest_edges(forest);
+  Spanning_forest_union_find<Edge> components(forest);
+  std::vector<Filtration_value> birth(components.vertices.size());
+  for (const Edge& e : forest) {
+    birth[components.index(e.u)] = e.birth_u;
+    birth[components.index(e.v)] = e.birth_v;
+  }
+  for (const Edge& e : forest) {
+    std::size_t ru = components.find(components.index(e.u));
+    std::size_t rv = components.find(components.index(e.v));
+    GUDHI_CHECK(ru != rv, std::invalid_argument("zero_persistence_of_spanning_forest - the edges contain a cycle"));
+    // rv is the younger component, which dies
+    if (birth[rv] < birth[ru]) std::swap(ru, rv);
+    if (birth[rv] < e.filtration) out0(birth[rv], e.filtration);
+    components.parent[rv] = ru;
+  }
+  for (std::size_t i = 0; i < components.parent.size(); ++i)
+    if (components.parent[i] == i) out_essential(birth[i]);
+}
+
+/** \brief Minimum spanning forest of the edges of a Rips graph that start from a range of vertices.
+ *
+ * \details The edges \f$(i, j)\f$ with \f$i < j\f$ and \f$i\f$ in `[vertex_begin, vertex_end)` are
+ * enumerated by blocks of rows, and the forest is updated after each block, so that the memory is linear in the
+ * number of points. The forests of the ranges of a partition of the vertices can be merged with
+ * `merge_spanning_forests()`. The vertices are the indices of the points, and their filtration values are 0.
+ *
+ * @param[in] points The points, or more generally the objects that `distance` takes.
+ * @param[in] threshold Maximal length of the edges.
+ * @param[in] distance Distance between two points.
+ * @param[in] vertex_begin,vertex_end Range of the first vertices of the edges.
+ */
+template <typename Vertex = std::size_t, typename Points, typename Filtration_value, typename Distance>
+std::vector<Spanning_forest_edge<Vertex, Filtration_value>> rips_spanning_forest(const Points& points,
+                                                                                 Filtration_value threshold,
+                                                                                 Distance&& distance,
+                                                                                 std::size_t vertex_begin,
+                                                                                 std::size_t vertex_end) {
+  using Edge = Spanning_forest_edge<Vertex, Filtration_value>;
+  const std::size_t n = points.size();
+  const std::size_t block_size = std::max(n, std::size_t(1) << 16);
+  std::vector<Edge> forest, block;
+  for (std::size_t i = vertex_begin; i < vertex_end; ++i) {
+    for (std::size_t j = i + 1; j < n; ++j) {
+      const Filtration_value length = distance(points[i], points[j]);
+      if (length <= threshold)
+        block.push_back({static_cast<Vertex>(i), static_cast<Vertex>(j), Filtration_value(0), Filtration_value(0),
+                         length});
+    }
+    if (block.size() >= block_size || i + 1 == vertex_end) {
+      forest = merge_spanning_forests(std::move(forest), block);
+      block.clear();
+    }
+  }
+  return forest;
+}
+
+/** \brief Minimum spanning forest of the graph of the top-dimensional cells of a layer range of a cubical complex.
+ *
+ * \details The complex is the one of `Gudhi::cubical_complex::Bitmap_cubical_complex` built from top-dimensional
+ * cells: the filtration value of a cell is the minimum of the ones of the top-dimensional cells that contain it, so
+ * that two top-dimensional cells are connected as soon as they both appear if they share a vertex. The vertices of
+ * the graph are the top-dimensional cells, numbered by their index in the bitmap, and its edges link the cells that
+ * share a vertex, with the maximum of their filtration values.
+ *
+ * The bitmap is cut in layers along its last coordinate, which varies the slowest. The edges from the cells of the
+ * layers `[layer_begin, layer_end)` to the cells that follow them in the bitmap are enumerated by blocks, and the
+ * forest is updated after each block. The forests of the ranges of a partition of the layers can be merged with
+ * `merge_spanning_forests()`.
+ *
+ * @param[in] sizes The number of top-dimensional cells in each direction, the first one varying the fastest, as in
+ * `Gudhi::cubical_complex::Bitmap_cubical_complex`.
+ * @param[in] cells The filtration values of the cells of the layers `[layer_begin, layer_end)`.
+ * @param[in] next_layer The filtration values of the cells of the layer `layer_end`, or nullptr if it is the last one.
+ * @param[in] layer_begin,layer_end Range of the layers.
+ */
+template <typename Vertex = std::size_t, typename Filtration_value>
+std::vector<Spanning_forest_edge<Vertex, Filtration_value>> cubical_spanning_forest(
+    const std::vector<unsigned>& sizes, const Filtration_value* cells, const Filtration_value* next_layer,
+    std::size_t layer_begin, std::size_t layer_end) {
+  using Edge = Spanning_forest_edge<Vertex, Filtration_value>;
+  const std::size_t dim = sizes.size();
+  GUDHI_CHECK(dim > 0, std::invalid_argument("cubical_spanning_forest - empty sizes"));
+  GUDHI_CHECK(layer_end <= sizes.back() && (next_layer == nullptr) == (layer_end == sizes.back()),
+              std::invalid_argument("cubical_spanning_forest - wrong range of layers"));
+  std::vector<std::size_t> strides(dim);
+  std::size_t layer_size = 1;
+  for (std::size_t i = 0; i < dim; ++i) {
+    strides[i] = layer_size;
+    layer_size *= sizes[i];
+  }
+  layer_size = strides[dim - 1];
+  // The neighbors that follow a cell in the bitmap: the offsets in {-1, 0, 1}^dim whose last nonzero coordinate is 1
+  std::vector<std::vector<int>> offsets;
+  std::vector<int> offset(dim, -1);
+  for (bool done = false; !done;) {
+    std::size_t last = dim;
+    while (last > 0 && offset[last - 1] == 0) --last;
+    if (last > 0 && offset[last - 1] == 1) offsets.push_back(offset);
+    std::size_t i = 0;
+    while (i < dim && offset[i] == 1) offset[i++] = -1;
+    if (i == dim)
+      done = true;
+    else
+      ++offset[i];
+  }
+
+  const std::size_t first = layer_begin * layer_size;
+  const std::size_t past_last = layer_end * layer_size;
+  const std::size_t past_cells = past_last + (next_layer == nullptr ? 0 : layer_size);
+  auto value = [&](std::size_t cell) { return cell < past_last ? cells[cell - first] : next_layer[cell - past_last]; };
+  const std::size_t block_size = std::max(past_last - first, std::size_t(1) << 16);
+  std::vector<Edge> forest, block;
+  std::vector<unsigned> coordinates(dim, 0);
+  coordinates[dim - 1] = static_cast<unsigned>(layer_begin);
+  for (std::size_t cell = first; cell < past_last; ++cell) {
+    for (const std::vector<int>& o : offsets) {
+      std::size_t neighbor = cell;
+      bool inside = true;
+      for (std::size_t i = 0; i < dim && inside; ++i) {
+        const long c = static_cast<long>(coordinates[i]) + o[i];
+        inside = c >= 0 && c < static_cast<long>(sizes[i]);
+        neighbor = neighbor + o[i] * static_cast<long>(strides[i]);
+      }
+      if (!inside || neighbor >= past_cells) continue;
+      const Filtration_value fu = value(cell), fv = value(neighbor);
+      block.push_back({static_cast<Vertex>(cell), static_cast<Vertex>(neighbor), fu, fv, std::max(fu, fv)});
+    }
+    if (block.size() >= block_size || cell + 1 == past_last) {
+      forest = merge_spanning_forests(std::move(forest), block);
+      block.clear();
+    }
+    for (std::size_t i = 0; i < dim && ++coordinates[i] == sizes[i]; ++i) coordinates[i] = 0;
+  }
+  return forest;
+}
+
+}  // namespace persistent_cohomology
+
+}  // namespace Gudhi
+
+#endif  // SPANNING_FOREST_PERSISTENCE_H_
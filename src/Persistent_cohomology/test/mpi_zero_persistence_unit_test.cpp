@@ -0,0 +1,114 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "mpi_zero_persistence"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Mpi_zero_persistence.h>
+#include <gudhi/distance_functions.h>
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using Point = std::vector<double>;
+using Diagram = std::vector<std::pair<double, double>>;
+
+struct Mpi_environment {
+  Mpi_environment() { MPI_Init(nullptr, nullptr); }
+  ~Mpi_environment() { MPI_Finalize(); }
+};
+
+BOOST_TEST_GLOBAL_FIXTURE(Mpi_environment);
+
+int rank() {
+  int r;
+  MPI_Comm_rank(MPI_COMM_WORLD, &r);
+  return r;
+}
+
+int size() {
+  int s;
+  MPI_Comm_size(MPI_COMM_WORLD, &s);
+  return s;
+}
+
+// The diagram of a single process, from the spanning forest of all the edges
+template <class Edge>
+Diagram sequential_diagram(const std::vector<Edge>& forest) {
+  Diagram diagram;
+  zero_persistence_of_spanning_forest(
+      forest, [&](double birth, double death) { diagram.emplace_back(birth, death); },
+      [&](double birth) { diagram.emplace_back(birth, std::numeric_limits<double>::infinity()); });
+  std::sort(diagram.begin(), diagram.end());
+  return diagram;
+}
+
+BOOST_AUTO_TEST_CASE(mpi_rips_zero_persistence) {
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(100);
+  for (Point& p : points) p = {coordinate(gen), coordinate(gen)};
+  const double threshold = 0.2;
+
+  Diagram diagram;
+  Gudhi::persistent_cohomology::mpi_rips_zero_persistence(
+      points, threshold, Gudhi::Euclidean_distance(), MPI_COMM_WORLD,
+      [&](double birth, double death) { diagram.emplace_back(birth, death); },
+      [&](double birth) { diagram.emplace_back(birth, std::numeric_limits<double>::infinity()); });
+  if (rank() != 0) {
+    BOOST_CHECK(diagram.empty());
+    return;
+  }
+  std::sort(diagram.begin(), diagram.end());
+  auto forest = Gudhi::persistent_cohomology::rips_spanning_forest(points, threshold, Gudhi::Euclidean_distance(), 0,
+                                                                   points.size());
+  Diagram expected = sequential_diagram(forest);
+  // The isolated vertices are not in the forest
+  std::size_t num_components = 0;
+  for (const auto& interval : expected)
+    if (interval.second == std::numeric_limits<double>::infinity()) ++num_components;
+  for (std::size_t i = forest.size() + num_components; i < points.size(); ++i)
+    expected.emplace_back(0., std::numeric_limits<double>::infinity());
+  std::sort(expected.begin(), expected.end());
+  BOOST_CHECK(diagram == expected);
+}
+
+BOOST_AUTO_TEST_CASE(mpi_cubical_zero_persistence) {
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> value(0, 20);
+  const std::vector<unsigned> sizes{6, 7, 8};
+  const std::size_t layer_size = sizes[0] * sizes[1];
+  std::vector<double> cells(layer_size * sizes[2]);
+  for (double& c : cells) c = value(gen);
+
+  // Each process only holds its layers
+  const std::size_t layer_begin = sizes[2] * rank() / size(), layer_end = sizes[2] * (rank() + 1) / size();
+  std::vector<double> layers(cells.begin() + layer_begin * layer_size, cells.begin() + layer_end * layer_size);
+  Diagram diagram;
+  Gudhi::persistent_cohomology::mpi_cubical_zero_persistence(
+      sizes, layers.data(), layer_begin, layer_end, MPI_COMM_WORLD,
+      [&](double birth, double death) { diagram.emplace_back(birth, death); },
+      [&](double birth) { diagram.emplace_back(birth, std::numeric_limits<double>::infinity()); });
+  if (rank() != 0) {
+    BOOST_CHECK(diagram.empty());
+    return;
+  }
+  std::sort(diagram.begin(), diagram.end());
+  auto forest = Gudhi::persistent_cohomology::cubical_spanning_forest(sizes, cells.data(),
+                                                                      static_cast<const double*>(nullptr), 0, sizes[2]);
+  BOOST_CHECK(diagram == sequential_diagram(forest));
+}
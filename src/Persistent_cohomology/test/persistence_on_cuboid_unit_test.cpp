@@ -0,0 +1,108 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "persistence_on_cuboid"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Persistence_on_cuboid.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Bitmap_cubical_complex.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using Diagram = std::vector<std::pair<double, double>>;
+using Diagrams = std::array<Diagram, 3>;
+
+const double inf = std::numeric_limits<double>::infinity();
+
+// Intervals of positive length by dimension, sorted, with the essential interval of the global minimum.
+// data has shape (n0, n1, n2) in C order.
+Diagrams cuboid_diagrams(const std::vector<double>& data, std::size_t n0, std::size_t n1, std::size_t n2) {
+  Diagrams diagrams;
+  auto out = [&diagrams](int dim) {
+    return [&diagrams, dim](double b, double d) { if (b < d) diagrams[dim].emplace_back(b, d); };
+  };
+  double global_min =
+      Gudhi::cubical_complex::persistence_on_cuboid_from_top_cells(data.data(), n0, n1, n2, out(0), out(1), out(2));
+  diagrams[0].emplace_back(global_min, inf);
+  for (auto& diagram : diagrams) std::sort(diagram.begin(), diagram.end());
+  return diagrams;
+}
+
+// Same diagrams, with Bitmap_cubical_complex and Persistent_cohomology.
+Diagrams reference_diagrams(const std::vector<double>& data, unsigned n0, unsigned n1, unsigned n2) {
+  using Cubical = Gudhi::cubical_complex::Bitmap_cubical_complex<
+      Gudhi::cubical_complex::Bitmap_cubical_complex_base<double>>;
+  using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+  // Bitmap_cubical_complex stores the first coordinate contiguously, so the shape is reversed.
+  Cubical complex(std::vector<unsigned>{n2, n1, n0}, data, true);
+  Gudhi::persistent_cohomology::Persistent_cohomology<Cubical, Field_Zp> pcoh(complex);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  Diagrams diagrams;
+  for (auto p : pcoh.get_persistent_pairs()) {
+    double b = complex.filtration(std::get<0>(p));
+    double d = std::get<1>(p) == complex.null_simplex() ? inf : complex.filtration(std::get<1>(p));
+    if (b < d) diagrams[complex.dimension(std::get<0>(p))].emplace_back(b, d);
+  }
+  for (auto& diagram : diagrams) std::sort(diagram.begin(), diagram.end());
+  return diagrams;
+}
+
+BOOST_AUTO_TEST_CASE(persistence_on_cuboid_hollow_cube) {
+  // 3x3x3 voxels: a shell at 0 around a center at 2, and one voxel of the shell at 1.
+  std::vector<double> data(27, 0.);
+  data[13] = 2.;
+  data[0] = 1.;
+  Diagrams diagrams = cuboid_diagrams(data, 3, 3, 3);
+  BOOST_CHECK(diagrams[0] == (Diagram{{0., inf}}));
+  BOOST_CHECK(diagrams[1].empty());
+  BOOST_CHECK(diagrams[2] == (Diagram{{0., 2.}}));
+}
+
+BOOST_AUTO_TEST_CASE(persistence_on_cuboid_ring) {
+  // 3x3x1 voxels: a ring at 0 around a center at 3, and 2 components born at 0 and 1 joined at 2.
+  std::vector<double> ring{0., 0., 0.,
+                           0., 3., 0.,
+                           0., 0., 0.};
+  Diagrams diagrams = cuboid_diagrams(ring, 1, 3, 3);
+  BOOST_CHECK(diagrams[0] == (Diagram{{0., inf}}));
+  BOOST_CHECK(diagrams[1] == (Diagram{{0., 3.}}));
+  BOOST_CHECK(diagrams[2].empty());
+
+  std::vector<double> components{0., 2., 1.};
+  diagrams = cuboid_diagrams(components, 3, 1, 1);
+  BOOST_CHECK(diagrams[0] == (Diagram{{0., inf}, {1., 2.}}));
+  BOOST_CHECK(diagrams[1].empty());
+  BOOST_CHECK(diagrams[2].empty());
+}
+
+BOOST_AUTO_TEST_CASE(persistence_on_cuboid_random) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0., 1.);
+  for (bool quantized : {false, true}) {
+    for (std::array<unsigned, 3> shape : {std::array<unsigned, 3>{7, 5, 6}, std::array<unsigned, 3>{1, 9, 8},
+                                          std::array<unsigned, 3>{4, 1, 3}, std::array<unsigned, 3>{11, 10, 9}}) {
+      std::vector<double> data(shape[0] * shape[1] * shape[2]);
+      for (auto& x : data) x = quantized ? std::floor(dist(gen) * 4) : dist(gen);
+      Diagrams diagrams = cuboid_diagrams(data, shape[0], shape[1], shape[2]);
+      Diagrams reference = reference_diagrams(data, shape[0], shape[1], shape[2]);
+      for (int dim = 0; dim < 3; ++dim) BOOST_CHECK(diagrams[dim] == reference[dim]);
+    }
+  }
+}
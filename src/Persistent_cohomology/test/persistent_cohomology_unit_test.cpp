@@ -5,6 +5,9 @@
 #include <cmath> // float comparison
 #include <limits>
 #include <cstdint>  // for std::uint8_t
+#include <map>
+#include <random>
+#include <vector>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "persistent_cohomology"
@@ -13,6 +16,7 @@
 #include <gudhi/graph_simplicial_complex.h>
 #include <gudhi/reader_utils.h>
 #include <gudhi/Simplex_tree.h>
+#include <gudhi/Hasse_complex.h>
 #include <gudhi/Persistent_cohomology.h>
 
 using namespace Gudhi;
@@ -21,6 +25,7 @@ using namespace boost::unit_test;
 
 typedef Simplex_tree<> typeST;
 
+template<class CoefficientField = Field_Zp>
 std::string test_persistence(int coefficient, int min_persistence) {
   // file is copied in CMakeLists.txt
   std::ifstream simplex_tree_stream;
@@ -41,7 +46,7 @@ std::string test_persistence(int coefficient, int min_persistence) {
   st.initialize_filtration();
 
   // Compute the persistence diagram of the complex
-  Persistent_cohomology<Simplex_tree<>, Field_Zp> pcoh(st);
+  Persistent_cohomology<Simplex_tree<>, CoefficientField> pcoh(st);
 
   pcoh.init_coefficients( coefficient );  // initializes the coefficient field for homology
   // Compute the persistent homology of the complex
@@ -53,6 +58,7 @@ std::string test_persistence(int coefficient, int min_persistence) {
   return strPers;
 }
 
+template<class CoefficientField = Field_Zp>
 void test_persistence_with_coeff_field(int coeff_field) {
   std::string value0("  0 0.02 1.12");
   std::string value1("  0 0.03 1.13");
@@ -79,7 +85,7 @@ void test_persistence_with_coeff_field(int coeff_field) {
   std::clog << "********************************************************************" << std::endl;
   std::clog << "TEST OF PERSISTENT_COHOMOLOGY_SINGLE_FIELD COEFF_FIELD=" << coeff_field << " MIN_PERS=0" << std::endl;
 
-  std::string str_persistence = test_persistence(coeff_field, 0);
+  std::string str_persistence = test_persistence<CoefficientField>(coeff_field, 0);
   std::clog << str_persistence << std::endl;
   
   BOOST_CHECK(str_persistence.find(value0) != std::string::npos); // Check found
@@ -97,7 +103,7 @@ void test_persistence_with_coeff_field(int coeff_field) {
   std::clog << "********************************************************************" << std::endl;
   std::clog << "TEST OF PERSISTENT_COHOMOLOGY_SINGLE_FIELD COEFF_FIELD=" << coeff_field << " MIN_PERS=1" << std::endl;
 
-  str_persistence = test_persistence(coeff_field, 1);
+  str_persistence = test_persistence<CoefficientField>(coeff_field, 1);
 
   BOOST_CHECK(str_persistence.find(value0) != std::string::npos); // Check found
   BOOST_CHECK(str_persistence.find(value1) != std::string::npos); // Check found
@@ -114,7 +120,7 @@ void test_persistence_with_coeff_field(int coeff_field) {
   std::clog << "********************************************************************" << std::endl;
   std::clog << "TEST OF PERSISTENT_COHOMOLOGY_SINGLE_FIELD COEFF_FIELD=" << coeff_field << " MIN_PERS=2" << std::endl;
 
-  str_persistence = test_persistence(coeff_field, 2);
+  str_persistence = test_persistence<CoefficientField>(coeff_field, 2);
 
   BOOST_CHECK(str_persistence.find(value0) == std::string::npos); // Check not found
   BOOST_CHECK(str_persistence.find(value1) == std::string::npos); // Check not found
@@ -131,7 +137,7 @@ void test_persistence_with_coeff_field(int coeff_field) {
   std::clog << "********************************************************************" << std::endl;
   std::clog << "TEST OF PERSISTENT_COHOMOLOGY_SINGLE_FIELD COEFF_FIELD=" << coeff_field << " MIN_PERS=Inf" << std::endl;
 
-  str_persistence = test_persistence(coeff_field, (std::numeric_limits<int>::max)());
+  str_persistence = test_persistence<CoefficientField>(coeff_field, (std::numeric_limits<int>::max)());
 
   BOOST_CHECK(str_persistence.find(value0) == std::string::npos); // Check not found
   BOOST_CHECK(str_persistence.find(value1) == std::string::npos); // Check not found
@@ -163,6 +169,93 @@ BOOST_AUTO_TEST_CASE( persistent_cohomology_single_field_coeff_limit )
   BOOST_CHECK_THROW(test_persistence_with_coeff_field(46349), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE( persistent_cohomology_single_field_z2 )
+{
+  test_persistence_with_coeff_field<Field_Z2>(2);
+  // Same diagram, in the same order, as with Field_Zp
+  BOOST_CHECK(test_persistence<Field_Z2>(2, 0) == test_persistence<Field_Zp>(2, 0));
+  BOOST_CHECK_THROW(test_persistence<Field_Z2>(3, 0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( persistent_cohomology_reset )
+{
+  // file is copied in CMakeLists.txt
+  std::ifstream simplex_tree_stream("simplex_tree_file_for_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  st.initialize_filtration();
+
+  typeST circle;
+  for (int i = 0; i < 5; ++i)
+    circle.insert_simplex_and_subfaces({i, (i + 1) % 5}, static_cast<double>(i));
+  circle.initialize_filtration();
+
+  auto diagram = [](Persistent_cohomology<typeST, Field_Zp>& pcoh) {
+    std::ostringstream oss;
+    pcoh.output_diagram(oss);
+    return oss.str();
+  };
+  Persistent_cohomology<typeST, Field_Zp> pcoh_st(st);
+  pcoh_st.init_coefficients(3);
+  pcoh_st.compute_persistent_cohomology();
+  const std::string st_diagram = diagram(pcoh_st);
+  Persistent_cohomology<typeST, Field_Zp> pcoh_circle(circle, true);
+  pcoh_circle.init_coefficients(3);
+  pcoh_circle.compute_persistent_cohomology(0.5);
+  const std::string circle_diagram = diagram(pcoh_circle);
+  BOOST_CHECK(pcoh_circle.betti_numbers() == std::vector<int>({1, 1}));
+
+  // The same object computes the persistence of several complexes
+  Persistent_cohomology<typeST, Field_Zp> pcoh(st);
+  pcoh.init_coefficients(3);
+  for (int i = 0; i < 3; ++i) {
+    pcoh.reset(st);
+    pcoh.compute_persistent_cohomology();
+    BOOST_CHECK(diagram(pcoh) == st_diagram);
+    pcoh.reset(circle, true);
+    pcoh.compute_persistent_cohomology(0.5);
+    BOOST_CHECK(diagram(pcoh) == circle_diagram);
+    BOOST_CHECK(pcoh.betti_numbers() == std::vector<int>({1, 1}));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( persistent_cohomology_memory_usage )
+{
+  std::ifstream simplex_tree_stream("simplex_tree_file_for_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  st.initialize_filtration();
+
+  typeST circle;
+  for (int i = 0; i < 5; ++i)
+    circle.insert_simplex_and_subfaces({i, (i + 1) % 5}, static_cast<double>(i));
+  circle.initialize_filtration();
+
+  Persistent_cohomology<typeST, Field_Zp> pcoh_circle(circle, true);
+  pcoh_circle.init_coefficients(2);
+  pcoh_circle.compute_persistent_cohomology();
+  auto circle_usage = pcoh_circle.memory_usage();
+  // One column and one cell for the class of dimension 1, the connected components live in the disjoint sets
+  BOOST_CHECK(circle_usage.columns > 0);
+  BOOST_CHECK(circle_usage.cells > 0);
+  BOOST_CHECK(circle_usage.disjoint_sets > 0);
+  BOOST_CHECK(circle_usage.persistent_pairs > 0);
+  BOOST_CHECK(circle_usage.total() == circle_usage.cells + circle_usage.columns + circle_usage.rows +
+                                      circle_usage.disjoint_sets + circle_usage.persistent_pairs +
+                                      circle_usage.cocycles);
+
+  // The cells and columns given back to the pools by reset() are not counted
+  Persistent_cohomology<typeST, Field_Zp> pcoh(st);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  BOOST_CHECK(pcoh.memory_usage().disjoint_sets > circle_usage.disjoint_sets);
+  pcoh.reset(circle, true);
+  pcoh.compute_persistent_cohomology();
+  BOOST_CHECK(pcoh.memory_usage().cells == circle_usage.cells);
+  BOOST_CHECK(pcoh.memory_usage().columns == circle_usage.columns);
+  BOOST_CHECK(pcoh.memory_usage().rows == circle_usage.rows);
+}
+
 /** SimplexTree minimal options to test the limits.
  * 
  * Maximum number of simplices to compute persistence is <CODE>std::numeric_limits<std::uint8_t>::max()<\CODE> = 256.*/
@@ -184,6 +277,124 @@ using Mini_simplex_tree = Gudhi::Simplex_tree<MiniSTOptions>;
 using Mini_st_persistence =
     Gudhi::persistent_cohomology::Persistent_cohomology<Mini_simplex_tree, Gudhi::persistent_cohomology::Field_Zp>;
 
+BOOST_AUTO_TEST_CASE( persistent_cohomology_truncated )
+{
+  // A circle filled at 7
+  typeST disk;
+  for (int i = 0; i < 5; ++i)
+    disk.insert_simplex_and_subfaces({i, (i + 1) % 5}, static_cast<double>(i));
+  disk.insert_simplex_and_subfaces({0, 1, 2}, 5.);
+  disk.insert_simplex_and_subfaces({0, 2, 3}, 6.);
+  disk.insert_simplex_and_subfaces({0, 3, 4}, 7.);
+
+  auto diagram = [](Persistent_cohomology<typeST, Field_Zp>& pcoh) {
+    std::ostringstream oss;
+    pcoh.output_diagram(oss);
+    return oss.str();
+  };
+  // Same persistence as the complex pruned above the maximal filtration value
+  typeST pruned(disk);
+  pruned.prune_above_filtration(6.5);
+  Persistent_cohomology<typeST, Field_Zp> pcoh_pruned(pruned, true);
+  pcoh_pruned.init_coefficients(3);
+  pcoh_pruned.compute_persistent_cohomology();
+
+  disk.initialize_filtration(6.5, 2);
+  BOOST_CHECK(disk.filtration_simplex_range().size() == pruned.num_simplices());
+  Persistent_cohomology<typeST, Field_Zp> pcoh(disk, true);
+  pcoh.init_coefficients(3);
+  pcoh.compute_persistent_cohomology(0., 6.5, 2);
+  BOOST_CHECK(diagram(pcoh) == diagram(pcoh_pruned));
+  BOOST_CHECK(pcoh.betti_numbers() == std::vector<int>({1, 1, 0}));
+
+  // Without the triangles, the 1-dimensional class is never killed
+  disk.initialize_filtration(10., 1);
+  BOOST_CHECK(disk.filtration_simplex_range().size() == 12);
+  pcoh.reset(disk);
+  pcoh.compute_persistent_cohomology(0., 10., 0);
+  BOOST_CHECK(pcoh.betti_numbers() == std::vector<int>({1}));
+  BOOST_CHECK(pcoh.intervals_in_dimension(1).empty());
+
+  // The whole filtration
+  disk.initialize_filtration();
+  pcoh.reset(disk);
+  pcoh.compute_persistent_cohomology();
+  BOOST_CHECK(pcoh.betti_numbers() == std::vector<int>({1, 0}));
+  BOOST_CHECK(pcoh.intervals_in_dimension(1) ==
+              (std::vector<std::pair<double, double>>({{4., 7.}})));
+}
+
+BOOST_AUTO_TEST_CASE( persistent_cohomology_cocycles )
+{
+  // Random flag complex
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> length(0., 1.);
+  typeST st;
+  for (int u = 0; u < 14; ++u)
+    for (int v = 0; v < u; ++v)
+      if (length(gen) < 0.5) st.insert_simplex_and_subfaces({u, v}, length(gen));
+  for (int u = 0; u < 14; ++u) st.insert_simplex({u}, 0.);
+  st.expansion(3);
+  st.initialize_filtration();
+
+  // Position in the filtration, which is the key of the simplices in the cocycles
+  std::map<std::vector<int>, std::size_t> position;
+  std::vector<typeST::Simplex_handle> simplices;
+  for (auto sh : st.filtration_simplex_range()) {
+    auto vertices = st.simplex_vertex_range(sh);
+    position.emplace(std::vector<int>(vertices.begin(), vertices.end()), simplices.size());
+    simplices.push_back(sh);
+  }
+  auto key = [&](typeST::Simplex_handle sh) {
+    auto vertices = st.simplex_vertex_range(sh);
+    return position.at(std::vector<int>(vertices.begin(), vertices.end()));
+  };
+
+  const int p = 5;
+  Persistent_cohomology<typeST, Field_Zp> pcoh(st);
+  pcoh.init_coefficients(p);
+  pcoh.record_cocycles(0.05);
+  pcoh.compute_persistent_cohomology();
+  auto const& cocycles = pcoh.cocycles();
+  auto const& pairs = pcoh.get_persistent_pairs();
+  BOOST_CHECK(cocycles.intervals.size() > 0);
+  BOOST_CHECK(cocycles.offsets.size() == cocycles.intervals.size() + 1);
+
+  std::size_t num_expected = 0;
+  for (auto const& pair : pairs) {
+    if (st.dimension(std::get<0>(pair)) > 0 && (std::get<1>(pair) == st.null_simplex() ||
+        st.filtration(std::get<1>(pair)) - st.filtration(std::get<0>(pair)) > 0.05)) ++num_expected;
+  }
+  BOOST_CHECK(cocycles.intervals.size() == num_expected);
+
+  for (std::size_t i = 0; i < cocycles.intervals.size(); ++i) {
+    std::map<std::size_t, int> cocycle;
+    for (std::size_t j = cocycles.offsets[i]; j < cocycles.offsets[i + 1]; ++j) {
+      BOOST_CHECK(cocycles.coefficients[j] != 0);
+      cocycle.emplace(cocycles.keys[j], cocycles.coefficients[j]);
+    }
+    auto const& pair = pairs[cocycles.intervals[i]];
+    const int dim = st.dimension(std::get<0>(pair));
+    const bool essential = std::get<1>(pair) == st.null_simplex();
+    const std::size_t death = essential ? simplices.size() : key(std::get<1>(pair));
+    // Coboundary of the cocycle on a simplex of dimension dim + 1, with the signs of the algorithm
+    auto coboundary = [&](typeST::Simplex_handle tau) {
+      int value = 0, sign = 1 - 2 * ((dim + 1) % 2);
+      for (auto face : st.boundary_simplex_range(tau)) {
+        auto it = cocycle.find(key(face));
+        if (it != cocycle.end()) value += sign * it->second;
+        sign = -sign;
+      }
+      return ((value % p) + p) % p;
+    };
+    for (std::size_t k = 0; k < death; ++k) {
+      if (st.dimension(simplices[k]) == dim + 1) BOOST_CHECK(coboundary(simplices[k]) == 0);
+    }
+    // The class dies at the insertion of the destructor
+    if (!essential) BOOST_CHECK(coboundary(simplices[death]) != 0);
+  }
+}
+
 BOOST_AUTO_TEST_CASE( persistence_constructor_exception )
 {
   Mini_simplex_tree st;
@@ -205,3 +416,33 @@ BOOST_AUTO_TEST_CASE( persistence_constructor_exception )
   BOOST_CHECK_THROW(Mini_st_persistence pcoh2(st), std::out_of_range);
 
 }
+
+BOOST_AUTO_TEST_CASE( persistent_cohomology_hasse_complex )
+{
+  std::ifstream simplex_tree_stream("simplex_tree_file_for_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  simplex_tree_stream.close();
+  std::string st_diagram = test_persistence(11, 0);
+
+  int count = 0;
+  for (auto sh : st.filtration_simplex_range())
+    st.assign_key(sh, count++);
+  Hasse_complex<> hcpx(st);
+  BOOST_CHECK(hcpx.num_simplices() == st.num_simplices());
+  BOOST_CHECK(hcpx.dimension() == st.dimension());
+
+  // Same diagram as on the simplex tree, and as on the Hasse diagram rebuilt from its flat arrays
+  auto diagram = [](Hasse_complex<>& cpx) {
+    Persistent_cohomology<Hasse_complex<>, Field_Zp> pcoh(cpx);
+    pcoh.init_coefficients(11);
+    pcoh.compute_persistent_cohomology(0);
+    std::ostringstream oss;
+    pcoh.output_diagram(oss);
+    return oss.str();
+  };
+  BOOST_CHECK(diagram(hcpx) == st_diagram);
+  Hasse_complex<> copy(hcpx.boundary_offsets(), hcpx.boundaries(), hcpx.filtrations());
+  BOOST_CHECK(copy.dimension() == hcpx.dimension());
+  BOOST_CHECK(diagram(copy) == st_diagram);
+}
@@ -0,0 +1,219 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "persistent_matrix_reduction"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Persistent_matrix_reduction.h>
+#include <gudhi/Cancellation.h>
+
+using namespace Gudhi;
+using namespace Gudhi::persistent_cohomology;
+
+typedef Simplex_tree<> typeST;
+typedef std::tuple<int, double, double> Diagram_point;
+
+template<class Persistence>
+std::vector<Diagram_point> diagram(typeST& st, int coefficient, double min_persistence, bool persistence_dim_max) {
+  Persistence pers(st, persistence_dim_max);
+  pers.init_coefficients(coefficient);
+  pers.compute_persistent_cohomology(min_persistence);
+  std::vector<Diagram_point> out;
+  for (auto pair : pers.get_persistent_pairs())
+    out.emplace_back(st.dimension(std::get<0>(pair)), st.filtration(std::get<0>(pair)),
+                     st.filtration(std::get<1>(pair)));
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+void check_same_diagrams(typeST& st) {
+  for (int coefficient : {2, 3, 11}) {
+    for (double min_persistence : {0., 0.1}) {
+      for (bool persistence_dim_max : {false, true}) {
+        auto cohomology = diagram<Persistent_cohomology<typeST, Field_Zp>>(st, coefficient, min_persistence,
+                                                                           persistence_dim_max);
+        auto reduction = diagram<Persistent_matrix_reduction<typeST>>(st, coefficient, min_persistence,
+                                                                      persistence_dim_max);
+        std::clog << "Z" << coefficient << " - min_persistence = " << min_persistence << " - persistence_dim_max = "
+                  << persistence_dim_max << " - " << reduction.size() << " intervals" << std::endl;
+        BOOST_CHECK(cohomology == reduction);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_on_file) {
+  // file is copied in CMakeLists.txt
+  std::ifstream simplex_tree_stream("simplex_tree_file_for_unit_test.txt");
+  typeST st;
+  simplex_tree_stream >> st;
+  BOOST_CHECK(st.num_simplices() == 98);
+  check_same_diagrams(st);
+}
+
+typeST random_rips(int num_points, double threshold, int max_dimension) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<std::vector<double>> points(num_points, std::vector<double>(3));
+  for (auto& point : points)
+    for (auto& x : point) x = coordinate(gen);
+  typeST st;
+  for (int i = 0; i < num_points; ++i) {
+    st.insert_simplex({i}, 0.);
+    for (int j = 0; j < i; ++j) {
+      double distance = 0.;
+      for (int k = 0; k < 3; ++k) distance += (points[i][k] - points[j][k]) * (points[i][k] - points[j][k]);
+      distance = std::sqrt(distance);
+      if (distance < threshold) st.insert_simplex({j, i}, distance);
+    }
+  }
+  st.expansion(max_dimension);
+  std::clog << "Rips complex with " << st.num_simplices() << " simplices" << std::endl;
+  return st;
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_on_random_rips) {
+  typeST st = random_rips(40, 0.5, 3);
+  check_same_diagrams(st);
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_on_several_batches) {
+  // More columns per dimension than a batch of the (parallel) reduction
+  typeST st = random_rips(60, 0.6, 3);
+  check_same_diagrams(st);
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_on_projective_plane) {
+  // Minimal triangulation of the real projective plane: H1 depends on the coefficient field
+  typeST st;
+  for (auto triangle : {std::vector<int>{0, 1, 2}, {0, 2, 3}, {0, 3, 4}, {0, 4, 5}, {0, 5, 1},
+                        {1, 2, 4}, {1, 3, 4}, {1, 3, 5}, {2, 3, 5}, {2, 4, 5}})
+    st.insert_simplex_and_subfaces(triangle, 1.);
+  check_same_diagrams(st);
+
+  Persistent_matrix_reduction<typeST> z2(st, true);
+  z2.init_coefficients(2);
+  z2.compute_persistent_cohomology();
+  BOOST_CHECK(z2.betti_numbers() == std::vector<int>({1, 1, 1}));
+  Persistent_matrix_reduction<typeST> z3(st, true);
+  z3.init_coefficients(3);
+  z3.compute_persistent_cohomology();
+  BOOST_CHECK(z3.betti_numbers() == std::vector<int>({1, 0, 0}));
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_shortcut_pairs) {
+  typeST st;
+  st.insert_simplex_and_subfaces({0, 1}, 1.);
+  st.insert_simplex_and_subfaces({0, 2}, 2.);
+  st.insert_simplex_and_subfaces({1, 2}, 3.);
+  st.insert_simplex_and_subfaces({0, 1, 2}, 4.);
+  Persistent_matrix_reduction<typeST> pers(st);
+  pers.init_coefficients(2);
+  pers.compute_persistent_cohomology();
+  // The coboundary of the edge {1, 2} is the triangle, which is not the pivot of another column
+  BOOST_CHECK(pers.num_shortcut_pairs() == 1);
+  BOOST_CHECK(pers.intervals_in_dimension(1) ==
+              (std::vector<std::pair<double, double>>{{3., 4.}}));
+
+  typeST rips = random_rips(40, 0.5, 3);
+  for (int coefficient : {2, 3}) {
+    Persistent_matrix_reduction<typeST> rips_pers(rips);
+    rips_pers.init_coefficients(coefficient);
+    rips_pers.compute_persistent_cohomology(-1.);
+    std::size_t num_positive_dimension_pairs = 0;
+    for (auto pair : rips_pers.get_persistent_pairs())
+      if (rips.dimension(std::get<0>(pair)) > 0 && std::get<1>(pair) != rips.null_simplex())
+        ++num_positive_dimension_pairs;
+    std::clog << rips_pers.num_shortcut_pairs() << " shortcut pairs out of " << num_positive_dimension_pairs
+              << std::endl;
+    BOOST_CHECK(rips_pers.num_shortcut_pairs() > 0);
+    BOOST_CHECK(rips_pers.num_shortcut_pairs() <= num_positive_dimension_pairs);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(matrix_reduction_checkpoint) {
+  typeST st = random_rips(60, 0.6, 3);
+  const std::string checkpoint = "persistent_matrix_reduction_unit_test.checkpoint";
+  std::remove(checkpoint.c_str());
+  for (int coefficient : {2, 3}) {
+    auto expected = diagram<Persistent_matrix_reduction<typeST>>(st, coefficient, 0., false);
+    auto resumed = [&]() {
+      Persistent_matrix_reduction<typeST> pers(st);
+      pers.init_coefficients(coefficient);
+      pers.set_checkpoint(checkpoint, std::chrono::seconds(0));
+      pers.compute_persistent_cohomology();
+      std::vector<Diagram_point> out;
+      for (auto pair : pers.get_persistent_pairs())
+        out.emplace_back(st.dimension(std::get<0>(pair)), st.filtration(std::get<0>(pair)),
+                         st.filtration(std::get<1>(pair)));
+      std::sort(out.begin(), out.end());
+      return out;
+    };
+
+    // Interrupted before the first batch, after the 0-dimensional pairs
+    Gudhi::Cancellation_flag flag;
+    flag.cancel();
+    {
+      Gudhi::Cancellation_scope scope(&flag);
+      BOOST_CHECK_THROW(resumed(), Gudhi::Cancelled);
+    }
+    BOOST_CHECK(std::ifstream(checkpoint).good());
+    BOOST_CHECK(resumed() == expected);
+    // The checkpoint is removed once the computation completes
+    BOOST_CHECK(!std::ifstream(checkpoint).good());
+
+    // Interrupted during the reduction, if it is not complete by then
+    Gudhi::Cancellation_flag later;
+    std::thread canceller([&later]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      later.cancel();
+    });
+    {
+      Gudhi::Cancellation_scope scope(&later);
+      try {
+        BOOST_CHECK(resumed() == expected);
+      } catch (const Gudhi::Cancelled&) {
+        std::clog << "Z" << coefficient << " - reduction interrupted" << std::endl;
+        BOOST_CHECK(std::ifstream(checkpoint).good());
+      }
+    }
+    canceller.join();
+    BOOST_CHECK(resumed() == expected);
+  }
+
+  // A checkpoint of another computation is rejected
+  Gudhi::Cancellation_flag flag;
+  flag.cancel();
+  {
+    Gudhi::Cancellation_scope scope(&flag);
+    Persistent_matrix_reduction<typeST> pers(st);
+    pers.init_coefficients(2);
+    pers.set_checkpoint(checkpoint);
+    BOOST_CHECK_THROW(pers.compute_persistent_cohomology(), Gudhi::Cancelled);
+  }
+  Persistent_matrix_reduction<typeST> other(st);
+  other.init_coefficients(3);
+  other.set_checkpoint(checkpoint);
+  BOOST_CHECK_THROW(other.compute_persistent_cohomology(), std::invalid_argument);
+  std::remove(checkpoint.c_str());
+}
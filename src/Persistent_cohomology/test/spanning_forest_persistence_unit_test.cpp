@@ -0,0 +1,121 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "spanning_forest_persistence"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Spanning_forest_persistence.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Rips_complex.h>
+#include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/distance_functions.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using Point = std::vector<double>;
+using Diagram = std::vector<std::pair<double, double>>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+
+// The finite intervals of positive length and the essential ones, sorted
+template <class Complex>
+Diagram zero_persistence(Complex& complex) {
+  Gudhi::persistent_cohomology::Persistent_cohomology<Complex, Field_Zp> pcoh(complex);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  Diagram diagram;
+  for (const auto& interval : pcoh.intervals_in_dimension(0))
+    if (interval.first < interval.second) diagram.push_back(interval);
+  std::sort(diagram.begin(), diagram.end());
+  return diagram;
+}
+
+template <class Edge>
+Diagram zero_persistence(const std::vector<Edge>& forest) {
+  Diagram diagram;
+  zero_persistence_of_spanning_forest(
+      forest, [&](double birth, double death) { diagram.emplace_back(birth, death); },
+      [&](double birth) { diagram.emplace_back(birth, std::numeric_limits<double>::infinity()); });
+  std::sort(diagram.begin(), diagram.end());
+  return diagram;
+}
+
+// Merges the forests of the parts as the processes would do, in a reduction tree
+template <class Edge>
+std::vector<Edge> reduce(std::vector<std::vector<Edge>> forests) {
+  for (std::size_t step = 1; step < forests.size(); step *= 2)
+    for (std::size_t i = 0; i + step < forests.size(); i += 2 * step)
+      forests[i] = Gudhi::persistent_cohomology::merge_spanning_forests(std::move(forests[i]), forests[i + step]);
+  return forests[0];
+}
+
+BOOST_AUTO_TEST_CASE(rips_spanning_forest_persistence) {
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(80);
+  for (Point& p : points) p = {coordinate(gen), coordinate(gen)};
+  const double threshold = 0.15;
+
+  Gudhi::Simplex_tree<> st;
+  Gudhi::rips_complex::Rips_complex<double> rips(points, threshold, Gudhi::Euclidean_distance());
+  rips.create_complex(st, 1);
+  Diagram expected = zero_persistence(st);
+
+  for (std::size_t parts : {1, 2, 3, 5}) {
+    std::vector<std::vector<Gudhi::persistent_cohomology::Spanning_forest_edge<std::size_t, double>>> forests;
+    for (std::size_t k = 0; k < parts; ++k)
+      forests.push_back(Gudhi::persistent_cohomology::rips_spanning_forest(
+          points, threshold, Gudhi::Euclidean_distance(), points.size() * k / parts, points.size() * (k + 1) / parts));
+    auto forest = reduce(std::move(forests));
+    Diagram diagram;
+    zero_persistence_of_spanning_forest(
+        forest, [&](double birth, double death) { diagram.emplace_back(birth, death); }, [](double) {});
+    // Each edge of the forest merges two components, the isolated vertices are not in the forest
+    for (std::size_t i = forest.size(); i < points.size(); ++i)
+      diagram.emplace_back(0., std::numeric_limits<double>::infinity());
+    std::sort(diagram.begin(), diagram.end());
+    BOOST_CHECK(diagram == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cubical_spanning_forest_persistence) {
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> value(0, 20);
+  for (const std::vector<unsigned>& sizes : {std::vector<unsigned>{30}, std::vector<unsigned>{7, 9},
+                                             std::vector<unsigned>{4, 5, 6}}) {
+    std::size_t num_cells = 1;
+    for (unsigned s : sizes) num_cells *= s;
+    std::vector<double> cells(num_cells);
+    for (double& c : cells) c = value(gen);
+
+    Gudhi::cubical_complex::Bitmap_cubical_complex<Gudhi::cubical_complex::Bitmap_cubical_complex_base<double>> cubical(
+        sizes, cells);
+    Diagram expected = zero_persistence(cubical);
+
+    const std::size_t num_layers = sizes.back();
+    const std::size_t layer_size = num_cells / num_layers;
+    for (std::size_t parts : {std::size_t(1), std::size_t(2), std::size_t(3), num_layers}) {
+      std::vector<std::vector<Gudhi::persistent_cohomology::Spanning_forest_edge<std::size_t, double>>> forests;
+      for (std::size_t k = 0; k < parts; ++k) {
+        const std::size_t begin = num_layers * k / parts, end = num_layers * (k + 1) / parts;
+        const double* next_layer = end < num_layers ? cells.data() + end * layer_size : nullptr;
+        forests.push_back(Gudhi::persistent_cohomology::cubical_spanning_forest(
+            sizes, cells.data() + begin * layer_size, next_layer, begin, end));
+      }
+      BOOST_CHECK(zero_persistence(reduce(std::move(forests))) == expected);
+    }
+  }
+}
@@ -48,6 +48,11 @@ struct SimplicialComplexForRips {
   template< typename Blocker >
   void expansion_with_blockers(int max_dim, Blocker block_simplex);
 
+  /** \brief Same as `expansion_with_blockers`, for a blocker that blocks all the cofaces of the simplices it blocks,
+   * and only examines the vertices and the filtration value of the simplex it is given. */
+  template< typename Blocker >
+  void expansion_with_monotone_blockers(int max_dim, Blocker block_simplex);
+
   /** \brief Returns a range over the vertices of a simplex.  */
   unspecified simplex_vertex_range(Simplex_handle sh);
 
@@ -94,6 +94,10 @@ namespace rips_complex {
  * `Gudhi::subsampling::sparsify_point_set()` is a more efficient way of
  * ignoring small filtration values.
  *
+ * The number of vertices can also be limited to a number of landmarks, the first points of the farthest point
+ * ordering that the construction computes anyway, instead of subsampling the points with
+ * `Gudhi::subsampling::choose_n_farthest_points_metric()` beforehand.
+ *
  * Theoretical guarantees are only available for \f$\epsilon<1\f$. The
  * construction accepts larger values of &epsilon;, and the size of the complex
  * keeps decreasing, but there is no guarantee on the quality of the result.
@@ -101,6 +105,29 @@ namespace rips_complex {
  * number of higher-dimensional simplices may not be monotonous when
  * \f$\frac12\leq\epsilon\leq 1\f$.
  *
+ * \section weightedrips Weighted Rips complex
+ *
+ * `Gudhi::rips_complex::Weighted_rips_complex` builds the weighted Rips filtration of \cite dtmfiltrations (with
+ * \f$p=1\f$), from a distance matrix and one weight per vertex: the vertex \f$i\f$ enters at \f$2w_i\f$ and the
+ * edge \f$ij\f$ at \f$\max(2w_i, 2w_j, d_{ij}+w_i+w_j)\f$. With the weights computed by
+ * `Gudhi::rips_complex::distance_to_measure`, this is the DTM-Rips filtration, which is much less sensitive to
+ * outliers than the Rips filtration.
+ *
+ * \section ripspersistence Persistence without the complex
+ *
+ * When only the persistence diagram of the Rips complex is needed, `Gudhi::rips_complex::Rips_persistence` computes
+ * it from the points or the distance matrix, without building a `Simplex_tree`. The simplices are enumerated from the
+ * distance matrix when they are needed, as in \cite bauer2021ripser, and the diagram is the same as the one of the
+ * complex built by `Rips_complex::create_complex` with `Gudhi::persistent_cohomology::Persistent_cohomology`.
+ *
+ * \section slidingwindowrips Sliding window
+ *
+ * For a stream of points, e.g. the time-delay embedding of a time series, where the Rips complex of the last points
+ * is needed at each step, `Gudhi::rips_complex::Sliding_window_rips_complex` maintains it in a `Simplex_tree`
+ * instead of rebuilding it: the star of a point entering the window is inserted with
+ * `Simplex_tree::insert_edge_as_flag`, and the star of the point leaving it is removed, so that a step only costs the
+ * simplices that change.
+ *
  * \section ripspointsdistance Point cloud and distance function
  * 
  * \subsection ripspointscloudexample Example from a point cloud and a distance function
@@ -183,6 +210,10 @@ namespace rips_complex {
  * 
  * \include one_skeleton_rips_for_doc.txt
  * 
+ * A sparse distance matrix, whose absent entries are infinite distances, can also be given in compressed sparse row
+ * format, like a kNN graph: the memory then only depends on the number of entries, and not on the square of the
+ * number of points.
+ *
  * \subsection ripscsvdistanceexample Example from a distance matrix read in a csv file
  * 
  * This example builds the one skeleton graph from the given distance matrix read in a csv file and threshold value.
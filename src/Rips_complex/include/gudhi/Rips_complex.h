@@ -13,15 +13,23 @@
 
 #include <gudhi/Debug_utils.h>
 #include <gudhi/graph_simplicial_complex.h>
+#include <gudhi/distance_functions.h>
+#include <gudhi/Profiler_instrumentation.h>
 
-#include <boost/graph/adjacency_list.hpp>
+#include <boost/range/irange.hpp>
 
+#include <algorithm>  // for std::sort, std::stable_sort, std::partition_point, std::upper_bound, std::min, std::max
+#include <cstddef>  // for std::size_t
 #include <iostream>
+#include <iterator>  // for std::size
+#include <stdexcept>  // for std::invalid_argument
 #include <vector>
 #include <map>
 #include <string>
 #include <limits>  // for numeric_limits
 #include <utility>  // for pair<>
+#include <tuple>
+#include <type_traits>  // for std::is_same
 
 
 namespace Gudhi {
@@ -45,11 +53,9 @@ template<typename Filtration_value>
 class Rips_complex {
  public:
   /**
-   * \brief Type of the one skeleton graph stored inside the Rips complex structure.
+   * \brief Type of the one skeleton graph stored inside the Rips complex structure, in compressed sparse row format.
    */
-  typedef typename boost::adjacency_list < boost::vecS, boost::vecS, boost::directedS
-  , boost::property < vertex_filtration_t, Filtration_value >
-  , boost::property < edge_filtration_t, Filtration_value >> OneSkeletonGraph;
+  typedef Csr_proximity_graph<int, Filtration_value> OneSkeletonGraph;
 
  private:
   typedef int Vertex_handle;
@@ -90,6 +96,54 @@ class Rips_complex {
                             [&](size_t i, size_t j){return distance_matrix[j][i];});
   }
 
+  /** \brief Rips_complex constructor from a sparse distance matrix in compressed sparse row format, as the
+   * `indptr`, `indices` and `data` of a `scipy.sparse.csr_matrix`.
+   *
+   * The distance between the points \f$i\f$ and `indices[k]` is `distances[k]`, for `offsets[i]` \f$\leq k <\f$
+   * `offsets[i+1]`. The absent entries are infinite distances, so that the memory and the time only depend on the
+   * number of entries, and not on the square of the number of points. An entry and its symmetric entry do not both
+   * need to be present. If they are, or if an entry is repeated, the smallest distance is used. The entries of the
+   * diagonal are ignored.
+   *
+   * @param[in] offsets Range of size the number of points plus one.
+   * @param[in] indices Range of the column indices of the entries, smaller than the number of points.
+   * @param[in] distances Range of the distances of the entries.
+   * @param[in] threshold Maximal edge length. All edges of the graph strictly greater than `threshold` are not
+   * inserted in the graph.
+   *
+   * \tparam OffsetRange, IndexRange and DistanceRange are random access ranges of integers, integers and values
+   * convertible to `Filtration_value`.
+   */
+  template<typename OffsetRange, typename IndexRange, typename DistanceRange>
+  Rips_complex(const OffsetRange& offsets, const IndexRange& indices, const DistanceRange& distances,
+               Filtration_value threshold) {
+    GUDHI_PROFILE_SCOPE("Rips_complex::compute_proximity_graph");
+    const std::size_t num_vertices = std::size(offsets) == 0 ? 0 : std::size(offsets) - 1;
+    std::vector<std::tuple<Vertex_handle, Vertex_handle, Filtration_value>> entries;
+    for (std::size_t i = 0; i < num_vertices; ++i) {
+      for (std::size_t k = offsets[i]; k < static_cast<std::size_t>(offsets[i + 1]); ++k) {
+        std::size_t j = indices[k];
+        GUDHI_CHECK(j < num_vertices, std::invalid_argument("Rips_complex - index out of the sparse matrix"));
+        Filtration_value fil = distances[k];
+        if (i == j || !(fil <= threshold)) continue;
+        entries.emplace_back(static_cast<Vertex_handle>(std::min(i, j)), static_cast<Vertex_handle>(std::max(i, j)),
+                             fil);
+      }
+    }
+    // By increasing u, then increasing v, then increasing filtration value to keep the smallest of each edge
+    std::sort(entries.begin(), entries.end());
+    std::vector<std::pair<Vertex_handle, Vertex_handle>> edges;
+    std::vector<Filtration_value> edges_fil;
+    for (auto const& entry : entries) {
+      std::pair<Vertex_handle, Vertex_handle> edge(std::get<0>(entry), std::get<1>(entry));
+      if (!edges.empty() && edges.back() == edge) continue;
+      edges.push_back(edge);
+      edges_fil.push_back(std::get<2>(entry));
+    }
+    std::vector<std::tuple<Vertex_handle, Vertex_handle, Filtration_value>>().swap(entries);
+    rips_skeleton_graph_ = OneSkeletonGraph(num_vertices, edges, edges_fil);
+  }
+
   /** \brief Initializes the simplicial complex from the Rips graph and expands it until a given maximal
    * dimension.
    *
@@ -102,6 +156,7 @@ class Rips_complex {
    */
   template <typename SimplicialComplexForRips>
   void create_complex(SimplicialComplexForRips& complex, int dim_max) {
+    GUDHI_PROFILE_SCOPE("Rips_complex::create_complex");
     GUDHI_CHECK(complex.num_vertices() == 0,
                 std::invalid_argument("Rips_complex::create_complex - simplicial complex is not empty"));
 
@@ -111,6 +166,81 @@ class Rips_complex {
     complex.expansion(dim_max);
   }
 
+  /** \brief Grows the simplicial complex to the Rips complex of a larger threshold, expanded until a given maximal
+   * dimension.
+   *
+   * The edges are sorted by length once, and each call inserts the edges of length at most `threshold` that are not
+   * in the complex yet. A few new edges are inserted one by one, by increasing length, with `insert_edge_as_flag`.
+   * Since an edge costs several times more that way than with `expansion`, the complex is rebuilt from the sorted
+   * edges when they are many, so that a sweep over increasing thresholds costs at most a few times the construction
+   * at the largest one. After each call, the complex is the same as the one `create_complex` builds from a
+   * `Rips_complex` with this threshold.
+   *
+   * The complex must only be modified by this method between the calls. The sweep starts again from an empty
+   * complex.
+   *
+   * \tparam SimplicialComplexForRips must meet `SimplicialComplexForRips` concept, and furnish `clear` and
+   * `insert_edge_as_flag`, like a `Simplex_tree` with `Options::link_nodes_by_label`.
+   *
+   * @param[in] complex SimplicialComplexForRips to be grown.
+   * @param[in] threshold Maximal edge length, at most the one of the constructor.
+   * @param[in] dim_max Expansion maximal dimension.
+   * @exception std::invalid_argument If `threshold` is smaller than the one of the previous call on a non-empty
+   * complex.
+   */
+  template <typename SimplicialComplexForRips>
+  void grow_complex(SimplicialComplexForRips& complex, Filtration_value threshold, int dim_max) {
+    const auto& offsets = rips_skeleton_graph_.offsets;
+    const auto& neighbors = rips_skeleton_graph_.neighbors;
+    const auto& edge_filtrations = rips_skeleton_graph_.edge_filtrations;
+    if (complex.num_vertices() == 0) {
+      next_edge_ = 0;
+    } else if (threshold < grown_threshold_) {
+      throw std::invalid_argument("Rips_complex::grow_complex - threshold is smaller than the previous one");
+    }
+    grown_threshold_ = threshold;
+    if (sorted_edges_.size() != rips_skeleton_graph_.num_edges()) {
+      sorted_edges_.resize(rips_skeleton_graph_.num_edges());
+      for (std::size_t e = 0; e < sorted_edges_.size(); ++e) sorted_edges_[e] = e;
+      std::stable_sort(sorted_edges_.begin(), sorted_edges_.end(), [&](std::size_t e1, std::size_t e2) {
+        return edge_filtrations[e1] < edge_filtrations[e2];
+      });
+    }
+    const std::size_t end_edge = std::partition_point(sorted_edges_.begin() + next_edge_, sorted_edges_.end(),
+                                                      [&](std::size_t e) { return edge_filtrations[e] <= threshold; })
+                                 - sorted_edges_.begin();
+
+    // Inserting an edge with insert_edge_as_flag costs about 8 times more than with expansion
+    const std::size_t flag_cost_ratio = 8;
+    if (complex.num_vertices() == 0 || dim_max < 1 || flag_cost_ratio * (end_edge - next_edge_) >= end_edge) {
+      OneSkeletonGraph graph;
+      graph.vertex_filtrations.assign(rips_skeleton_graph_.num_vertices(), Filtration_value(0));
+      for (std::size_t u = 0; u < rips_skeleton_graph_.num_vertices(); ++u) {
+        for (std::size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+          if (edge_filtrations[e] <= threshold) {
+            graph.neighbors.push_back(neighbors[e]);
+            graph.edge_filtrations.push_back(edge_filtrations[e]);
+          }
+        }
+        graph.offsets.push_back(graph.neighbors.size());
+      }
+      complex.clear();
+      complex.insert_graph(graph);
+      complex.expansion(dim_max);
+    } else {
+      std::vector<typename SimplicialComplexForRips::Simplex_handle> added_simplices;
+      for (std::size_t i = next_edge_; i < end_edge; ++i) {
+        const std::size_t e = sorted_edges_[i];
+        // The source of the edge is the vertex whose neighbors contain it
+        const auto u = static_cast<Vertex_handle>(std::upper_bound(offsets.begin(), offsets.end(), e) -
+                                                  offsets.begin() - 1);
+        complex.insert_edge_as_flag(u, neighbors[e], edge_filtrations[e], dim_max, added_simplices);
+        added_simplices.clear();
+      }
+    }
+    next_edge_ = end_edge;
+  }
+
  private:
   /** \brief Computes the proximity graph of the points.
    *
@@ -126,6 +256,7 @@ class Rips_complex {
   template< typename ForwardPointRange, typename Distance >
   void compute_proximity_graph(const ForwardPointRange& points, Filtration_value threshold,
                Distance distance) {
+    GUDHI_PROFILE_SCOPE("Rips_complex::compute_proximity_graph");
     std::vector< std::pair< Vertex_handle, Vertex_handle > > edges;
     std::vector< Filtration_value > edges_fil;
 
@@ -135,38 +266,32 @@ class Rips_complex {
     // --------------------------------------------------------------------------------------------
     // Creates the vector of edges and its filtration values (returned by distance function)
     Vertex_handle idx_u = 0;
-    for (auto it_u = std::begin(points); it_u != std::end(points); ++it_u, ++idx_u) {
-      Vertex_handle idx_v = idx_u + 1;
-      for (auto it_v = it_u + 1; it_v != std::end(points); ++it_v, ++idx_v) {
-        Filtration_value fil = distance(*it_u, *it_v);
-        if (fil <= threshold) {
-          edges.emplace_back(idx_u, idx_v);
-          edges_fil.push_back(fil);
+    if constexpr (std::is_same<Distance, Euclidean_distance>::value) {
+      // Only the pairs of points in neighboring cells of a grid are compared
+      idx_u = proximity_graph_edges_with_grid(points, threshold, distance, edges, edges_fil);
+    } else {
+      for (auto it_u = std::begin(points); it_u != std::end(points); ++it_u, ++idx_u) {
+        Vertex_handle idx_v = idx_u + 1;
+        for (auto it_v = it_u + 1; it_v != std::end(points); ++it_v, ++idx_v) {
+          Filtration_value fil = distance(*it_u, *it_v);
+          if (fil <= threshold) {
+            edges.emplace_back(idx_u, idx_v);
+            edges_fil.push_back(fil);
+          }
         }
       }
     }
 
-    // --------------------------------------------------------------------------------------------
-    // Creates the proximity graph from edges and sets the property with the filtration value.
-    // Number of points is labeled from 0 to idx_u-1
-    // --------------------------------------------------------------------------------------------
-    // Do not use : rips_skeleton_graph_ = OneSkeletonGraph(...) -> deep copy of the graph (boost graph is not
-    // move-enabled)
-    rips_skeleton_graph_.~OneSkeletonGraph();
-    new(&rips_skeleton_graph_)OneSkeletonGraph(edges.begin(), edges.end(), edges_fil.begin(), idx_u);
-
-    auto vertex_prop = boost::get(vertex_filtration_t(), rips_skeleton_graph_);
-
-    using vertex_iterator = typename boost::graph_traits<OneSkeletonGraph>::vertex_iterator;
-    vertex_iterator vi, vi_end;
-    for (std::tie(vi, vi_end) = boost::vertices(rips_skeleton_graph_);
-         vi != vi_end; ++vi) {
-      boost::put(vertex_prop, *vi, 0.);
-    }
+    // Creates the proximity graph from the sorted edges, the points are labeled from 0 to idx_u-1
+    rips_skeleton_graph_ = OneSkeletonGraph(idx_u, edges, edges_fil);
   }
 
  private:
   OneSkeletonGraph rips_skeleton_graph_;
+  // State of grow_complex: the edges by increasing length, the next one to insert and the last threshold
+  std::vector<std::size_t> sorted_edges_;
+  std::size_t next_edge_ = 0;
+  Filtration_value grown_threshold_ = 0;
 };
 
 }  // namespace rips_complex
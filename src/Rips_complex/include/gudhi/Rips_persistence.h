@@ -0,0 +1,434 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef RIPS_PERSISTENCE_H_
+#define RIPS_PERSISTENCE_H_
+
+#include <gudhi/Persistent_cohomology/Field_Zp.h>
+#include <gudhi/Debug_utils.h>
+
+#include <algorithm>  // for std::max, std::sort
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::int64_t
+#include <iostream>
+#include <limits>  // for numeric_limits
+#include <numeric>  // for std::iota
+#include <stdexcept>  // for std::invalid_argument, std::overflow_error
+#include <tuple>
+#include <unordered_map>
+#include <utility>  // for std::pair
+#include <vector>
+
+namespace Gudhi {
+
+namespace rips_complex {
+
+/**
+ * \class Rips_persistence
+ * \brief Persistent homology of a Rips complex, without building the complex.
+ *
+ * \ingroup rips_complex
+ *
+ * \details
+ * Computes the same persistence diagram as the `Rips_complex` expanded in a `Simplex_tree` until `dim_max`, with
+ * `Gudhi::persistent_cohomology::Persistent_cohomology`, but the simplices are never stored in a complex. A simplex is
+ * identified by its index in the combinatorial number system, its filtration value is computed from the distance
+ * matrix, and its cofaces are enumerated from its index. The coboundary matrix is reduced dimension by dimension,
+ * with clearing, and the columns whose pivot is new are not stored, but recomputed when they are needed (emergent
+ * pairs), as in Ripser \cite bauer2021ripser .
+ *
+ * The simplices of each dimension are enumerated from the edges when this dimension is reduced, and discarded
+ * before the next one, so that the memory is the distance matrix and, for one dimension at a time, the columns to
+ * reduce, their pivots and the reduced columns that are not emergent, instead of the simplex tree of all the
+ * simplices and the compressed annotation matrix.
+ *
+ * \tparam Filtration_value is the type used to store the filtration values of the simplicial complex.
+ * \tparam CoefficientField `Gudhi::persistent_cohomology::Field_Zp` or `Gudhi::persistent_cohomology::Field_Z2`.
+ */
+template<typename Filtration_value, typename CoefficientField = persistent_cohomology::Field_Zp>
+class Rips_persistence {
+ public:
+  /** \brief Type of element of the field. */
+  typedef typename CoefficientField::Element Arith_element;
+  /** \brief Dimension, birth and death of a persistence interval, the death being infinite for an essential class. */
+  typedef std::tuple<int, Filtration_value, Filtration_value> Persistent_interval;
+
+  /** \brief Rips_persistence constructor from a list of points.
+   *
+   * @param[in] points Range of points.
+   * @param[in] threshold Maximal edge length. All edges strictly greater than `threshold` are ignored.
+   * @param[in] dim_max Maximal dimension of the simplices of the Rips complex. The persistence is computed until
+   * dimension `dim_max - 1`.
+   * @param[in] distance distance function that returns a `Filtration_value` from 2 given points.
+   *
+   * \tparam ForwardPointRange must be a range for which `std::begin` and `std::end` return forward iterators on a
+   * point.
+   *
+   * \tparam Distance furnishes `operator()(const Point& p1, const Point& p2)`, where
+   * `Point` is a point from the `ForwardPointRange`, and that returns a `Filtration_value`.
+   *
+   * @exception std::overflow_error If the number of simplices of dimension `dim_max` cannot be indexed.
+   */
+  template<typename ForwardPointRange, typename Distance>
+  Rips_persistence(const ForwardPointRange& points, Filtration_value threshold, int dim_max, Distance distance)
+      : threshold_(threshold), dim_max_(dim_max) {
+    num_vertices_ = 0;
+    for (auto it_u = std::begin(points); it_u != std::end(points); ++it_u, ++num_vertices_) {
+      for (auto it_v = std::begin(points); it_v != it_u; ++it_v) distances_.push_back(distance(*it_u, *it_v));
+    }
+    init_binomial_coefficients();
+  }
+
+  /** \brief Rips_persistence constructor from a distance matrix.
+   *
+   * @param[in] distance_matrix Range of distances.
+   * @param[in] threshold Maximal edge length. All edges strictly greater than `threshold` are ignored.
+   * @param[in] dim_max Maximal dimension of the simplices of the Rips complex. The persistence is computed until
+   * dimension `dim_max - 1`.
+   *
+   * \tparam DistanceMatrix must have a `size()` method and on which `distance_matrix[i][j]` returns
+   * the distance between points \f$i\f$ and \f$j\f$ as long as \f$ 0 \leqslant j < i \leqslant
+   * distance\_matrix.size().\f$
+   *
+   * @exception std::overflow_error If the number of simplices of dimension `dim_max` cannot be indexed.
+   */
+  template<typename DistanceMatrix>
+  Rips_persistence(const DistanceMatrix& distance_matrix, Filtration_value threshold, int dim_max)
+      : num_vertices_(distance_matrix.size()), threshold_(threshold), dim_max_(dim_max) {
+    distances_.reserve(num_vertices_ * (num_vertices_ - (num_vertices_ > 0)) / 2);
+    for (std::size_t i = 0; i < num_vertices_; ++i)
+      for (std::size_t j = 0; j < i; ++j) distances_.push_back(distance_matrix[i][j]);
+    init_binomial_coefficients();
+  }
+
+  /** \brief Initializes the coefficient field.*/
+  void init_coefficients(int charac) {
+    coeff_field_.init(charac);
+  }
+
+  /** \brief Compute the persistent homology of the Rips complex.
+   *
+   * @param[in] min_interval_length the computation discards all intervals of length
+   *                                less or equal than min_interval_length
+   */
+  void compute_persistent_cohomology(Filtration_value min_interval_length = 0) {
+    min_interval_length_ = min_interval_length;
+    persistent_pairs_.clear();
+    if (dim_max_ < 0) return;
+    std::vector<Simplex> columns = reduce_vertices_and_edges();
+    for (int dim = 1; dim < dim_max_; ++dim) {
+      std::unordered_map<Simplex_index, std::size_t> pivot_column;
+      reduce(dim, columns, pivot_column);
+      columns.clear();
+      if (dim + 1 < dim_max_) {
+        // Simplices of the next dimension. Clearing: the pivots are deaths, and their coboundary reduces to zero.
+        for_each_simplex(dim + 1, [&](const Simplex& simplex) {
+          if (pivot_column.find(simplex.index) == pivot_column.end()) columns.push_back(simplex);
+        });
+        sort_from_youngest(columns);
+      }
+    }
+  }
+
+  /** \brief Output the persistence diagram in ostream, in the same format as
+   * `Gudhi::persistent_cohomology::Persistent_cohomology::output_diagram`. */
+  void output_diagram(std::ostream& ostream = std::cout) const {
+    for (const Persistent_interval& interval : persistent_pairs_) {
+      ostream << coeff_field_.characteristic() << "  " << std::get<0>(interval) << " " << std::get<1>(interval) << " "
+              << std::get<2>(interval) << " " << std::endl;
+    }
+  }
+
+  /** @brief Returns Betti numbers.
+   * @return A vector of Betti numbers.
+   */
+  std::vector<int> betti_numbers() const {
+    // Dimension 0 is computed even without edges
+    std::vector<int> betti_numbers(dim_max_ < 0 ? 0 : std::max(dim_max_, 1));
+    for (const Persistent_interval& interval : persistent_pairs_) {
+      if (std::get<2>(interval) == std::numeric_limits<Filtration_value>::infinity())
+        betti_numbers[std::get<0>(interval)] += 1;
+    }
+    return betti_numbers;
+  }
+
+  /** @brief Returns the persistence intervals, in the order of their computation.
+   * @return A list of Rips_persistence::Persistent_interval
+   */
+  const std::vector<Persistent_interval>& get_persistent_pairs() const {
+    return persistent_pairs_;
+  }
+
+  /** @brief Returns persistence intervals for a given dimension.
+   * @param[in] dimension Dimension to get the birth and death pairs from.
+   * @return A vector of persistence intervals (birth and death) on a fixed dimension.
+   */
+  std::vector<std::pair<Filtration_value, Filtration_value>> intervals_in_dimension(int dimension) const {
+    std::vector<std::pair<Filtration_value, Filtration_value>> result;
+    for (const Persistent_interval& interval : persistent_pairs_) {
+      if (std::get<0>(interval) == dimension) result.emplace_back(std::get<1>(interval), std::get<2>(interval));
+    }
+    return result;
+  }
+
+ private:
+  /* Index of a simplex \f$\{v_d > ... > v_0\}\f$ in the combinatorial number system: \f$\sum_i {v_i \choose i+1}\f$.
+   * The index of an edge {i, j}, i > j, is also its position in distances_. */
+  typedef std::int64_t Simplex_index;
+  typedef std::int64_t Vertex;
+
+  struct Simplex {
+    Filtration_value diameter;
+    Simplex_index index;
+  };
+
+  struct Entry {
+    Filtration_value diameter;
+    Simplex_index index;
+    Arith_element coefficient;
+  };
+
+  /* Reduced column, that is not stored if it is the coboundary of its simplex. */
+  struct Column {
+    bool emergent = false;
+    std::vector<Entry> entries;
+  };
+
+  /* Order of the filtration: by diameter, then by decreasing index. */
+  template<class S1, class S2>
+  static bool before(const S1& s1, const S2& s2) {
+    return s1.diameter < s2.diameter || (s1.diameter == s2.diameter && s1.index > s2.index);
+  }
+
+  static void sort_from_youngest(std::vector<Simplex>& simplices) {
+    std::sort(simplices.begin(), simplices.end(), [](const Simplex& s1, const Simplex& s2) { return before(s2, s1); });
+  }
+
+  void init_binomial_coefficients() {
+    const int k_max = std::max(dim_max_, 0) + 1;
+    num_k_ = k_max + 1;
+    binomial_.assign((num_vertices_ + 1) * num_k_, 0);
+    for (std::size_t n = 0; n <= num_vertices_; ++n) {
+      binomial_[n * num_k_] = 1;
+      for (int k = 1; k <= k_max && k <= static_cast<int>(n); ++k) {
+        const Simplex_index a = binomial_[(n - 1) * num_k_ + k - 1], b = binomial_[(n - 1) * num_k_ + k];
+        if (a > std::numeric_limits<Simplex_index>::max() - b)
+          throw std::overflow_error("Rips_persistence - too many simplices to index them, decrease dim_max");
+        binomial_[n * num_k_ + k] = a + b;
+      }
+    }
+  }
+
+  Simplex_index binomial(Vertex n, int k) const {
+    GUDHI_CHECK(k < num_k_, std::invalid_argument("Rips_persistence - binomial coefficient out of range"));
+    return binomial_[n * num_k_ + k];
+  }
+
+  Filtration_value distance(Vertex i, Vertex j) const {
+    if (i < j) std::swap(i, j);
+    return distances_[i * (i - 1) / 2 + j];
+  }
+
+  /* Vertices of the simplex of dimension dim and index index, in decreasing order. */
+  void vertices(Simplex_index index, int dim, std::vector<Vertex>& out) const {
+    out.clear();
+    Vertex top = static_cast<Vertex>(num_vertices_) - 1;
+    for (int k = dim + 1; k > 1; --k) {
+      // Largest vertex v <= top with binomial(v, k) <= index, by binary search
+      Vertex bottom = k - 1;
+      while (bottom < top) {
+        const Vertex middle = top - (top - bottom) / 2;
+        if (binomial(middle, k) <= index) bottom = middle; else top = middle - 1;
+      }
+      out.push_back(top);
+      index -= binomial(top, k);
+      --top;
+    }
+    out.push_back(index);
+  }
+
+  /* Calls f(coface, coefficient) for the cofaces of simplex, of dimension dim, with a diameter at most threshold_. */
+  template<class F>
+  void for_each_coface(const Simplex& simplex, int dim, F&& f) const {
+    thread_local std::vector<Vertex> simplex_vertices;
+    vertices(simplex.index, dim, simplex_vertices);
+    Simplex_index index_below = simplex.index, index_above = 0;
+    int k = dim + 1;
+    for (Vertex j = static_cast<Vertex>(num_vertices_) - 1; j >= k; --j) {
+      // Skip the vertices of simplex, k being the number of vertices of simplex smaller than j
+      while (binomial(j, k) <= index_below) {
+        index_below -= binomial(j, k);
+        index_above += binomial(j, k + 1);
+        --j;
+        --k;
+      }
+      Filtration_value diameter = simplex.diameter;
+      for (Vertex v : simplex_vertices) diameter = std::max(diameter, distance(j, v));
+      if (diameter <= threshold_)
+        f(Simplex{diameter, index_above + binomial(j, k + 1) + index_below}, k % 2 == 0);
+    }
+  }
+
+  /* Calls f(simplex) for the simplices of dimension dim > 0, enumerated depth first from the edges by adding vertices
+   * larger than the ones of the simplex, so that each simplex is enumerated once and the simplices of the lower
+   * dimensions are not stored. */
+  template<class F>
+  void for_each_simplex(int dim, F&& f) const {
+    // Vertices of the current simplex, in increasing order
+    std::vector<Vertex> simplex_vertices;
+    auto extend = [&](auto&& self, const Simplex& simplex, int simplex_dim) -> void {
+      if (simplex_dim == dim) {
+        f(simplex);
+        return;
+      }
+      for (Vertex j = static_cast<Vertex>(num_vertices_) - 1; j > simplex_vertices.back(); --j) {
+        Filtration_value diameter = simplex.diameter;
+        for (Vertex v : simplex_vertices) diameter = std::max(diameter, distance(j, v));
+        if (diameter <= threshold_) {
+          simplex_vertices.push_back(j);
+          self(self, Simplex{diameter, binomial(j, simplex_dim + 2) + simplex.index}, simplex_dim + 1);
+          simplex_vertices.pop_back();
+        }
+      }
+    };
+    Simplex_index index = 0;
+    for (Vertex i = 1; i < static_cast<Vertex>(num_vertices_); ++i) {
+      for (Vertex j = 0; j < i; ++j, ++index) {
+        if (distances_[index] > threshold_) continue;
+        simplex_vertices.assign({j, i});
+        extend(extend, Simplex{distances_[index], index}, 1);
+      }
+    }
+  }
+
+  /* Coboundary of simplex, sorted in the order of the filtration. */
+  void coboundary(const Simplex& simplex, int dim, std::vector<Entry>& out) {
+    out.clear();
+    for_each_coface(simplex, dim, [&](const Simplex& coface, bool positive_sign) {
+      out.push_back(Entry{coface.diameter, coface.index,
+                          positive_sign ? coeff_field_.multiplicative_identity() : coeff_field_.times_minus(1, 1)});
+    });
+    std::sort(out.begin(), out.end(), [](const Entry& e1, const Entry& e2) { return before(e1, e2); });
+  }
+
+  /* 0-dimensional pairs with a union-find on the edges. Returns the positive edges, from the youngest. */
+  std::vector<Simplex> reduce_vertices_and_edges() {
+    std::vector<Simplex> edges;
+    if (dim_max_ > 0) {
+      for (Simplex_index index = 0; index < static_cast<Simplex_index>(distances_.size()); ++index)
+        if (distances_[index] <= threshold_) edges.push_back(Simplex{distances_[index], index});
+    }
+    std::sort(edges.begin(), edges.end(), [](const Simplex& s1, const Simplex& s2) { return before(s1, s2); });
+    std::vector<Vertex> parent(num_vertices_);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](Vertex v) {
+      while (parent[v] != v) {
+        parent[v] = parent[parent[v]];  // path halving
+        v = parent[v];
+      }
+      return v;
+    };
+    std::vector<Simplex> positive_edges;
+    std::vector<Vertex> edge_vertices;
+    for (const Simplex& edge : edges) {
+      vertices(edge.index, 1, edge_vertices);
+      const Vertex u = find(edge_vertices[0]), v = find(edge_vertices[1]);
+      if (u != v) {
+        parent[u] = v;
+        add_pair(0, 0, edge.diameter);
+      } else if (dim_max_ > 1) {
+        positive_edges.push_back(edge);
+      }
+    }
+    for (Vertex v = 0; v < static_cast<Vertex>(num_vertices_); ++v)
+      if (parent[v] == v) add_pair(0, 0, std::numeric_limits<Filtration_value>::infinity());
+    sort_from_youngest(positive_edges);
+    return positive_edges;
+  }
+
+  /* Reduction of the coboundaries of the simplices of dimension dim in columns, from the youngest. */
+  void reduce(int dim, const std::vector<Simplex>& columns,
+              std::unordered_map<Simplex_index, std::size_t>& pivot_column) {
+    std::vector<Column> reduced(columns.size());
+    std::vector<Entry> column, buffer, other_coboundary;
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+      coboundary(columns[i], dim, column);
+      auto owner = column.empty() ? pivot_column.end() : pivot_column.find(column.front().index);
+      if (!column.empty() && owner == pivot_column.end()) {
+        // Emergent pair: the coboundary is already reduced, and can be recomputed
+        reduced[i].emergent = true;
+      }
+      while (owner != pivot_column.end()) {
+        const std::vector<Entry>* other = &reduced[owner->second].entries;
+        if (reduced[owner->second].emergent) {
+          coboundary(columns[owner->second], dim, other_coboundary);
+          other = &other_coboundary;
+        }
+        // column - (column[pivot] / other[pivot]) * other
+        const Arith_element w = coeff_field_.times_minus(
+            column.front().coefficient,
+            coeff_field_.inverse(other->front().coefficient, coeff_field_.characteristic()).first);
+        add_multiple(column, *other, w, buffer);
+        column.swap(buffer);
+        owner = column.empty() ? pivot_column.end() : pivot_column.find(column.front().index);
+      }
+      if (column.empty()) {
+        add_pair(dim, columns[i].diameter, std::numeric_limits<Filtration_value>::infinity());
+        continue;
+      }
+      pivot_column.emplace(column.front().index, i);
+      add_pair(dim, columns[i].diameter, column.front().diameter);
+      if (!reduced[i].emergent) reduced[i].entries = column;
+    }
+  }
+
+  /* out = column + w * other, without the zero coefficients. */
+  void add_multiple(const std::vector<Entry>& column, const std::vector<Entry>& other, Arith_element w,
+                    std::vector<Entry>& out) {
+    out.clear();
+    auto it = column.begin();
+    auto other_it = other.begin();
+    while (it != column.end() || other_it != other.end()) {
+      if (other_it == other.end() || (it != column.end() && before(*it, *other_it))) {
+        out.push_back(*it++);
+      } else if (it == column.end() || before(*other_it, *it)) {
+        out.push_back(Entry{other_it->diameter, other_it->index, coeff_field_.times(other_it->coefficient, w)});
+        ++other_it;
+      } else {
+        const Arith_element x = coeff_field_.plus_times_equal(it->coefficient, other_it->coefficient, w);
+        if (x != coeff_field_.additive_identity()) out.push_back(Entry{it->diameter, it->index, x});
+        ++it;
+        ++other_it;
+      }
+    }
+  }
+
+  void add_pair(int dim, Filtration_value birth, Filtration_value death) {
+    if (death - birth > min_interval_length_) persistent_pairs_.emplace_back(dim, birth, death);
+  }
+
+  std::size_t num_vertices_;
+  Filtration_value threshold_;
+  int dim_max_;
+  /* Lower triangular distance matrix: the distance between i and j < i is distances_[i * (i - 1) / 2 + j] */
+  std::vector<Filtration_value> distances_;
+  /* binomial_[n * num_k_ + k] is n choose k */
+  std::vector<Simplex_index> binomial_;
+  int num_k_;
+  CoefficientField coeff_field_;
+  Filtration_value min_interval_length_ = 0;
+  std::vector<Persistent_interval> persistent_pairs_;
+};
+
+}  // namespace rips_complex
+
+}  // namespace Gudhi
+
+#endif  // RIPS_PERSISTENCE_H_
@@ -0,0 +1,152 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef SLIDING_WINDOW_RIPS_COMPLEX_H_
+#define SLIDING_WINDOW_RIPS_COMPLEX_H_
+
+#include <gudhi/Debug_utils.h>
+
+#include <algorithm>  // for std::max
+#include <cstddef>  // for std::size_t
+#include <deque>
+#include <iterator>  // for std::prev
+#include <limits>  // for numeric_limits
+#include <stdexcept>  // for std::out_of_range
+#include <utility>  // for std::move
+#include <vector>
+
+namespace Gudhi {
+
+namespace rips_complex {
+
+/**
+ * \class Sliding_window_rips_complex
+ * \brief Rips complex of a sliding window over a stream of points, updated in place in a `Simplex_tree` when a
+ * point enters or leaves the window.
+ *
+ * \ingroup rips_complex
+ *
+ * \details
+ * The complex is always equal (with the same filtration values) to the Rips complex of the points of the window,
+ * expanded until `dim_max`, but it is never rebuilt: `push_back()` inserts the edges from the new point to the
+ * points of the window with `Simplex_tree::insert_edge_as_flag()`, so that only the star of the new point is
+ * created, and `pop_front()` removes the star of the oldest point with `Simplex_tree::remove_maximal_simplex()`. The
+ * cost of a step is then proportional to the number of simplices entering or leaving the complex, and not to its
+ * size.
+ *
+ * The vertices are numbered by their position in the stream: the first point pushed is the vertex 0, the next one
+ * the vertex 1, etc. The oldest point of the window is then always the smallest vertex of the complex, and its star
+ * is the subtree of its node in the simplex tree.
+ *
+ * The filtration order cache of the complex is cleared at each update, so that the persistence can be computed
+ * after any number of steps, e.g. with `Gudhi::persistent_cohomology::Persistent_cohomology`.
+ *
+ * \tparam SimplexTree must be a `Simplex_tree` whose `SimplexTreeOptions::link_nodes_by_label` is true, e.g.
+ * `Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_cofaces>`.
+ * \tparam Point is the type of the points of the stream.
+ * \tparam Distance furnishes `operator()(const Point& p1, const Point& p2)`, that returns a
+ * `SimplexTree::Filtration_value`.
+ */
+template <typename SimplexTree, typename Point, typename Distance>
+class Sliding_window_rips_complex {
+ public:
+  typedef typename SimplexTree::Vertex_handle Vertex_handle;
+  typedef typename SimplexTree::Filtration_value Filtration_value;
+
+  /** \brief Sliding_window_rips_complex constructor, with an empty window.
+   *
+   * @param[in] threshold Maximal edge length. All edges strictly greater than `threshold` are ignored.
+   * @param[in] dim_max Maximal dimension of the simplices of the complex.
+   * @param[in] distance distance function that returns a `Filtration_value` from 2 given points.
+   */
+  Sliding_window_rips_complex(Filtration_value threshold, int dim_max, Distance distance = Distance())
+      : threshold_(threshold), dim_max_(dim_max), distance_(std::move(distance)), first_vertex_(0) {
+    static_assert(SimplexTree::Options::link_nodes_by_label,
+                  "Sliding_window_rips_complex requires SimplexTreeOptions::link_nodes_by_label");
+  }
+
+  /** \brief Adds a point at the end of the window, with its edges of length at most the threshold to the points of
+   * the window and the simplices of the flag complex that contain them.
+   *
+   * @return The vertex of the new point in the complex.
+   */
+  Vertex_handle push_back(const Point& point) {
+    const Vertex_handle vertex = first_vertex_ + static_cast<Vertex_handle>(points_.size());
+    // distances[i] is the length of the edge to the point i of the window, or infinity if there is no such edge
+    distances_.assign(points_.size(), std::numeric_limits<Filtration_value>::infinity());
+    added_simplices_.clear();
+    complex_.insert_edge_as_flag(vertex, vertex, 0, dim_max_, added_simplices_);
+    for (std::size_t i = 0; i < points_.size(); ++i) {
+      Filtration_value length = distance_(points_[i], point);
+      if (length > threshold_) continue;
+      distances_[i] = length;
+      complex_.insert_edge_as_flag(first_vertex_ + static_cast<Vertex_handle>(i), vertex, length, dim_max_,
+                                   added_simplices_);
+    }
+    points_.push_back(point);
+    // insert_edge_as_flag gives a new simplex the length of the edge that created it, which may be shorter than the
+    // other edges of the simplex. As the new vertex is the largest one, the simplex is the node of this vertex under
+    // the node of its facet that does not contain it, whose value is already right.
+    for (auto sh : complex_.star_simplex_range(complex_.find({vertex}))) {
+      auto* siblings = SimplexTree::self_siblings(sh);
+      if (siblings == complex_.root()) continue;
+      Filtration_value filtration = complex_.filtration(siblings->oncles()->members().find(siblings->parent()));
+      for (auto v : complex_.simplex_vertex_range(sh))
+        if (v != vertex) filtration = std::max(filtration, distances_[v - first_vertex_]);
+      complex_.assign_filtration(sh, filtration);
+    }
+    complex_.clear_filtration();
+    return vertex;
+  }
+
+  /** \brief Removes the oldest point of the window, and all the simplices that contain it.
+   *
+   * @exception std::out_of_range If the window is empty.
+   */
+  void pop_front() {
+    if (points_.empty()) throw std::out_of_range("Sliding_window_rips_complex::pop_front - empty window");
+    remove_star(complex_.find({first_vertex_}));
+    points_.pop_front();
+    ++first_vertex_;
+    complex_.clear_filtration();
+  }
+
+  /** \brief Number of points in the window. */
+  std::size_t size() const { return points_.size(); }
+
+  /** \brief Vertex of the oldest point of the window. */
+  Vertex_handle first_vertex() const { return first_vertex_; }
+
+  /** \brief The Rips complex of the window. It must not be modified. */
+  SimplexTree& complex() { return complex_; }
+
+ private:
+  // Removes sh and its subtree. The children are removed from the last one, so that the erasure does not move the
+  // others, and the siblings of the last one are deleted with it.
+  void remove_star(typename SimplexTree::Simplex_handle sh) {
+    while (complex_.has_children(sh)) remove_star(std::prev(sh->second.children()->members().end()));
+    complex_.remove_maximal_simplex(sh);
+  }
+
+  SimplexTree complex_;
+  Filtration_value threshold_;
+  int dim_max_;
+  Distance distance_;
+  std::deque<Point> points_;
+  Vertex_handle first_vertex_;
+  std::vector<Filtration_value> distances_;
+  std::vector<typename SimplexTree::Simplex_handle> added_simplices_;
+};
+
+}  // namespace rips_complex
+
+}  // namespace Gudhi
+
+#endif  // SLIDING_WINDOW_RIPS_COMPLEX_H_
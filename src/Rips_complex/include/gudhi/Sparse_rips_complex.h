@@ -19,6 +19,13 @@
 #include <boost/range/metafunctions.hpp>
 #include <boost/iterator/counting_iterator.hpp>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>  // for std::min, std::max
+#include <cstddef>  // for std::size_t
+#include <limits>  // for std::numeric_limits
 #include <vector>
 
 namespace Gudhi {
@@ -103,7 +110,6 @@ namespace rips_complex {
 template <typename Filtration_value>
 class Sparse_rips_complex {
  private:
-  // TODO(MG): use a different graph where we know we can safely insert in parallel.
   typedef int Vertex_handle;
   typedef rips_complex::Graph<Vertex_handle, Filtration_value> Graph;
 
@@ -111,19 +117,32 @@ class Sparse_rips_complex {
   /** \brief Sparse_rips_complex constructor from a list of points.
    *
    * @param[in] points Range of points.
-   * @param[in] distance Distance function that returns a `Filtration_value` from 2 given points.
+   * @param[in] distance Distance function that returns a `Filtration_value` from 2 given points. With TBB, it is
+   * called concurrently to compute the sparse graph.
    * @param[in] epsilon Approximation parameter. epsilon must be positive.
    * @param[in] mini Minimal filtration value. Ignore anything below this scale. This is a less efficient version of `Gudhi::subsampling::sparsify_point_set()`.
    * @param[in] maxi Maximal filtration value. Ignore anything above this scale.
+   * @param[in] num_landmarks Maximal number of vertices. Only the first `num_landmarks` points of the farthest point
+   * ordering are kept, the landmarks that `Gudhi::subsampling::choose_n_farthest_points_metric()` would select.
+   * @param[in] starting_point Index of the first point of the farthest point ordering, or
+   * `Gudhi::subsampling::random_starting_point` to pick it at random.
    *
+   * The farthest point ordering of the points is computed once, and gives at the same time the landmarks, the points
+   * that are kept above `mini`, and the order in which the sparse Rips graph is built. This is equivalent to, and
+   * cheaper than, subsampling the points first, and building the sparse Rips complex of the subsample.
    */
   template <typename RandomAccessPointRange, typename Distance>
-  Sparse_rips_complex(const RandomAccessPointRange& points, Distance distance, double const epsilon, Filtration_value const mini=-std::numeric_limits<Filtration_value>::infinity(), Filtration_value const maxi=std::numeric_limits<Filtration_value>::infinity())
+  Sparse_rips_complex(const RandomAccessPointRange& points, Distance distance, double const epsilon,
+                      Filtration_value const mini = -std::numeric_limits<Filtration_value>::infinity(),
+                      Filtration_value const maxi = std::numeric_limits<Filtration_value>::infinity(),
+                      std::size_t const num_landmarks = std::numeric_limits<std::size_t>::max(),
+                      std::size_t const starting_point = subsampling::random_starting_point)
       : epsilon_(epsilon) {
     GUDHI_CHECK(epsilon > 0, "epsilon must be positive");
     auto dist_fun = [&](Vertex_handle i, Vertex_handle j) { return distance(points[i], points[j]); };
     // TODO: stop choose_n_farthest_points once it reaches mini or 0?
-    subsampling::choose_n_farthest_points_metric(dist_fun, boost::irange<Vertex_handle>(0, boost::size(points)), -1, -1,
+    subsampling::choose_n_farthest_points_metric(dist_fun, boost::irange<Vertex_handle>(0, boost::size(points)),
+                                                 num_landmarks, starting_point,
                                                  std::back_inserter(sorted_points), std::back_inserter(params));
     compute_sparse_graph(dist_fun, epsilon, mini, maxi);
   }
@@ -137,16 +156,25 @@ class Sparse_rips_complex {
    * @param[in] epsilon Approximation parameter. epsilon must be positive.
    * @param[in] mini Minimal filtration value. Ignore anything below this scale. This is a less efficient version of `Gudhi::subsampling::sparsify_point_set()`.
    * @param[in] maxi Maximal filtration value. Ignore anything above this scale.
+   * @param[in] num_landmarks Maximal number of vertices, the first points of the farthest point ordering.
+   * @param[in] starting_point Index of the first point of the farthest point ordering, or
+   * `Gudhi::subsampling::random_starting_point` to pick it at random.
    */
   template <typename DistanceMatrix>
-  Sparse_rips_complex(const DistanceMatrix& distance_matrix, double const epsilon, Filtration_value const mini=-std::numeric_limits<Filtration_value>::infinity(), Filtration_value const maxi=std::numeric_limits<Filtration_value>::infinity())
+  Sparse_rips_complex(const DistanceMatrix& distance_matrix, double const epsilon,
+                      Filtration_value const mini = -std::numeric_limits<Filtration_value>::infinity(),
+                      Filtration_value const maxi = std::numeric_limits<Filtration_value>::infinity(),
+                      std::size_t const num_landmarks = std::numeric_limits<std::size_t>::max(),
+                      std::size_t const starting_point = subsampling::random_starting_point)
       : Sparse_rips_complex(boost::irange<Vertex_handle>(0, boost::size(distance_matrix)),
                             [&](Vertex_handle i, Vertex_handle j) { return (i==j) ? 0 : (i<j) ? distance_matrix[j][i] : distance_matrix[i][j]; },
-                            epsilon, mini, maxi) {}
+                            epsilon, mini, maxi, num_landmarks, starting_point) {}
 
   /** \brief Fills the simplicial complex with the sparse Rips graph and
    * expands it with all the cliques, stopping at a given maximal dimension.
    *
+   * With TBB, the expansion is parallel, see `Simplex_tree::expansion_with_monotone_blockers`.
+   *
    * \tparam SimplicialComplexForRips must meet `SimplicialComplexForRips` concept.
    *
    * @param[in] complex the complex to fill
@@ -179,7 +207,8 @@ class Sparse_rips_complex {
       }
       return false;
     };
-    complex.expansion_with_blockers(dim_max, block);
+    // The blocker is monotone, it blocks the cofaces of the simplices it blocks
+    complex.expansion_with_monotone_blockers(dim_max, block);
   }
 
  private:
@@ -200,38 +229,50 @@ class Sparse_rips_complex {
     }
     n = num_vertices(graph_);
 
-    // TODO(MG):
-    // - make it parallel
-    // - only test near-enough neighbors
-    for (std::size_t i = 0; i < n; ++i) {
-      auto&& pi = points[i];
-      auto li = params[i];
-      // If we inserted all the points, points with multiplicity would get connected to their first representative,
-      // no need to handle the redundant ones in the outer loop.
-      // if (li <= 0 && i != 0) break;
-      for (std::size_t j = i + 1; j < n; ++j) {
-        auto&& pj = points[j];
-        auto d = dist(pi, pj);
-        auto lj = params[j];
-        GUDHI_CHECK(lj <= li, "Bad furthest point sorting");
-        Filtration_value alpha;
-
-        // The paper has d/2 and d-lj/e to match the Cech, but we use doubles to match the Rips
-        if (d * epsilon <= 2 * lj)
-          alpha = d;
-        else if (d * epsilon > li + lj)
-          continue;
-        else {
-          alpha = (d - lj / epsilon) * 2;
-          // Keep the test exactly the same as in block to avoid inconsistencies
-          if (epsilon < 1 && alpha * cst > lj)
+    // TODO(MG): only test near-enough neighbors
+    // The points are processed by blocks in parallel, whose edges are concatenated in order. The first points have
+    // the most neighbors, small blocks balance the load.
+    const std::size_t block_size = 64;
+    const std::size_t num_blocks = (n + block_size - 1) / block_size;
+    std::vector<typename Graph::EList> block_edges(num_blocks);
+    auto process_block = [&](std::size_t block) {
+      const std::size_t end = (std::min)(n, (block + 1) * block_size);
+      for (std::size_t i = block * block_size; i < end; ++i) {
+        auto&& pi = points[i];
+        auto li = params[i];
+        // If we inserted all the points, points with multiplicity would get connected to their first representative,
+        // no need to handle the redundant ones in the outer loop.
+        // if (li <= 0 && i != 0) break;
+        for (std::size_t j = i + 1; j < n; ++j) {
+          auto&& pj = points[j];
+          auto d = dist(pi, pj);
+          auto lj = params[j];
+          GUDHI_CHECK(lj <= li, "Bad furthest point sorting");
+          Filtration_value alpha;
+
+          // The paper has d/2 and d-lj/e to match the Cech, but we use doubles to match the Rips
+          if (d * epsilon <= 2 * lj)
+            alpha = d;
+          else if (d * epsilon > li + lj)
             continue;
-        }
+          else {
+            alpha = (d - lj / epsilon) * 2;
+            // Keep the test exactly the same as in block to avoid inconsistencies
+            if (epsilon < 1 && alpha * cst > lj)
+              continue;
+          }
 
-        if (alpha <= maxi)
-          add_edge(pi, pj, alpha, graph_);
+          if (alpha <= maxi)
+            block_edges[block].emplace_back(pi, pj, alpha);
+        }
       }
-    }
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), num_blocks, process_block);
+#else
+    for (std::size_t block = 0; block < num_blocks; ++block) process_block(block);
+#endif
+    for (auto& edges : block_edges) graph_.elist.insert(graph_.elist.end(), edges.begin(), edges.end());
   }
 
   Graph graph_;
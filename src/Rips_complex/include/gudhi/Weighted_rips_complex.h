@@ -0,0 +1,186 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef WEIGHTED_RIPS_COMPLEX_H_
+#define WEIGHTED_RIPS_COMPLEX_H_
+
+#include <gudhi/Debug_utils.h>
+#include <gudhi/graph_simplicial_complex.h>
+
+#include <algorithm>  // for std::max, std::nth_element
+#include <cmath>  // for std::pow
+#include <cstddef>  // for std::size_t
+#include <iterator>  // for std::size
+#include <stdexcept>  // for std::invalid_argument
+#include <vector>
+
+namespace Gudhi {
+
+namespace rips_complex {
+
+/**
+ * \brief Computes the distance to the empirical measure of each point, from a full distance matrix, as introduced in
+ * \cite dtm.
+ *
+ * \ingroup rips_complex
+ *
+ * The value of the point \f$i\f$ is \f$(\frac{1}{k}\sum_{j} d_j^q)^{1/q}\f$, where the \f$d_j\f$ are the \f$k\f$
+ * smallest distances of the row \f$i\f$ of the matrix, the point itself included.
+ *
+ * @param[in] distance_matrix Full square distance matrix, where `distance_matrix[i][j]` is the distance between the
+ * points \f$i\f$ and \f$j\f$.
+ * @param[in] k Number of neighbors, between 1 and the number of points.
+ * @param[in] q Order of the distance to measure.
+ * @exception std::invalid_argument If `k` is 0 or larger than the size of a row.
+ */
+template <typename DistanceMatrix>
+std::vector<double> distance_to_measure(const DistanceMatrix& distance_matrix, std::size_t k, double q = 2) {
+  std::vector<double> dtm;
+  dtm.reserve(std::size(distance_matrix));
+  std::vector<double> row;
+  for (const auto& r : distance_matrix) {
+    row.assign(std::begin(r), std::end(r));
+    if (k == 0 || k > row.size())
+      throw std::invalid_argument("distance_to_measure - k must be between 1 and the number of points");
+    std::nth_element(row.begin(), row.begin() + (k - 1), row.end());
+    double sum = 0;
+    if (q == 2) {
+      for (std::size_t j = 0; j < k; ++j) sum += row[j] * row[j];
+      dtm.push_back(std::sqrt(sum / k));
+    } else {
+      for (std::size_t j = 0; j < k; ++j) sum += std::pow(row[j], q);
+      dtm.push_back(std::pow(sum / k, 1 / q));
+    }
+  }
+  return dtm;
+}
+
+/**
+ * \class Weighted_rips_complex
+ * \brief Weighted Rips complex, of a distance matrix and weights on the vertices, in the way described in
+ * \cite dtmfiltrations with \f$p=1\f$.
+ *
+ * \ingroup rips_complex
+ *
+ * \details
+ * The filtration value of the vertex \f$i\f$ is \f$2w_i\f$, and the filtration value of the edge \f$ij\f$ is
+ * \f$\max(2w_i, 2w_j, d_{ij}+w_i+w_j)\f$. As for `Rips_complex`, all the filtration values are doubled compared to
+ * the paper. With the distances to measure of `distance_to_measure` as weights, this is the DTM-Rips filtration.
+ *
+ * The edges are computed in one pass over the matrix and stored in compressed sparse row format, which is inserted in
+ * the complex as it is.
+ *
+ * \tparam Filtration_value is the type used to store the filtration values of the simplicial complex.
+ */
+template <typename Filtration_value>
+class Weighted_rips_complex {
+ public:
+  /**
+   * \brief Type of the one skeleton graph stored inside the weighted Rips complex structure.
+   */
+  typedef Csr_proximity_graph<int, Filtration_value> OneSkeletonGraph;
+
+ private:
+  typedef int Vertex_handle;
+
+ public:
+  /** \brief Weighted_rips_complex constructor from a distance matrix and weights.
+   *
+   * @param[in] distance_matrix Range of distances, full square or lower triangular.
+   * @param[in] weights Range of (one half of) the weights of the vertices, of the size of the matrix.
+   * @param[in] threshold Maximal filtration value. The vertices and the edges of larger filtration value are not
+   * inserted in the complex.
+   *
+   * \tparam DistanceMatrix must have a `size()` method and on which `distance_matrix[i][j]` returns
+   * the distance between points \f$i\f$ and \f$j\f$ as long as \f$ 0 \leqslant j < i \leqslant
+   * distance\_matrix.size().\f$
+   * \tparam WeightRange is a random access range of values convertible to `Filtration_value`.
+   */
+  template <typename DistanceMatrix, typename WeightRange>
+  Weighted_rips_complex(const DistanceMatrix& distance_matrix, const WeightRange& weights,
+                        Filtration_value threshold)
+      : threshold_(threshold) {
+    const std::size_t n = distance_matrix.size();
+    GUDHI_CHECK(std::size(weights) == n,
+                std::invalid_argument("Weighted_rips_complex - there must be one weight per vertex"));
+    std::vector<Filtration_value> w(n);
+    for (std::size_t i = 0; i < n; ++i) w[i] = weights[i];
+
+    graph_.vertex_filtrations.resize(n);
+    for (std::size_t i = 0; i < n; ++i) graph_.vertex_filtrations[i] = 2 * w[i];
+    // The row v of a lower triangular matrix contains the edges [u,v] for u < v, so the edges are first counted per
+    // source u, then written at the position of their source, by increasing v.
+    std::vector<char> kept;
+    std::vector<std::size_t> count(n + 1, 0);
+    std::vector<Filtration_value> row_fil;
+    std::vector<Filtration_value> fil;
+    for (std::size_t v = 1; v < n; ++v) {
+      const auto& row = distance_matrix[v];
+      const Filtration_value fv = graph_.vertex_filtrations[v];
+      row_fil.resize(v);
+      // The max is needed when the weights are not 1-Lipschitz
+      for (std::size_t u = 0; u < v; ++u)
+        row_fil[u] = std::max({graph_.vertex_filtrations[u], fv, static_cast<Filtration_value>(row[u]) + w[v] + w[u]});
+      for (std::size_t u = 0; u < v; ++u) {
+        const bool keep = row_fil[u] <= threshold;
+        kept.push_back(keep);
+        count[u + 1] += keep;
+        if (keep) fil.push_back(row_fil[u]);
+      }
+    }
+    for (std::size_t u = 0; u < n; ++u) count[u + 1] += count[u];
+    graph_.offsets = count;
+    graph_.neighbors.resize(fil.size());
+    graph_.edge_filtrations.resize(fil.size());
+    std::size_t pair = 0, e = 0;
+    for (std::size_t v = 1; v < n; ++v) {
+      for (std::size_t u = 0; u < v; ++u, ++pair) {
+        if (!kept[pair]) continue;
+        const std::size_t pos = count[u]++;
+        graph_.neighbors[pos] = static_cast<Vertex_handle>(v);
+        graph_.edge_filtrations[pos] = fil[e++];
+      }
+    }
+  }
+
+  /** \brief Initializes the simplicial complex from the weighted Rips graph and expands it until a given maximal
+   * dimension.
+   *
+   * \tparam SimplicialComplexForRips must meet `SimplicialComplexForRips` concept. If some vertices have a filtration
+   * value larger than the threshold, it must also provide `find` and `remove_maximal_simplex`, like
+   * `Simplex_tree`.
+   *
+   * @param[in] complex SimplicialComplexForRips to be created.
+   * @param[in] dim_max graph expansion until this given maximal dimension.
+   * @exception std::invalid_argument In debug mode, if `complex.num_vertices()` does not return 0.
+   */
+  template <typename SimplicialComplexForRips>
+  void create_complex(SimplicialComplexForRips& complex, int dim_max) {
+    GUDHI_CHECK(complex.num_vertices() == 0,
+                std::invalid_argument("Weighted_rips_complex::create_complex - simplicial complex is not empty"));
+
+    complex.insert_graph(graph_);
+    // Vertices above the threshold have no edge, since the filtration of an edge is at least the one of its vertices
+    for (std::size_t u = 0; u < graph_.num_vertices(); ++u)
+      if (!(graph_.vertex_filtrations[u] <= threshold_))
+        complex.remove_maximal_simplex(complex.find(std::vector<Vertex_handle>{static_cast<Vertex_handle>(u)}));
+    complex.expansion(dim_max);
+  }
+
+ private:
+  OneSkeletonGraph graph_;
+  Filtration_value threshold_;
+};
+
+}  // namespace rips_complex
+
+}  // namespace Gudhi
+
+#endif  // WEIGHTED_RIPS_COMPLEX_H_
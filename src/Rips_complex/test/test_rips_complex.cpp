@@ -11,15 +11,20 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "rips_complex"
 #include <boost/test/unit_test.hpp>
+#include <boost/range/irange.hpp>
 
 #include <cmath>  // float comparison
 #include <limits>
 #include <string>
 #include <vector>
 #include <algorithm>    // std::max
+#include <random>
+#include <iterator>  // for std::back_inserter
 
 #include <gudhi/Rips_complex.h>
 #include <gudhi/Sparse_rips_complex.h>
+#include <gudhi/choose_n_farthest_points.h>
+#include <gudhi/Weighted_rips_complex.h>
 // to construct Rips_complex from a OFF file of points
 #include <gudhi/Points_off_io.h>
 #include <gudhi/Simplex_tree.h>
@@ -285,6 +290,53 @@ BOOST_AUTO_TEST_CASE(Sparse_rips_complex_from_points) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(Sparse_rips_complex_with_landmarks) {
+  // Only the first points of the farthest point ordering are vertices, and the complex is the sparse Rips complex of
+  // these landmarks
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(200, Point(2));
+  for (Point& p : points)
+    for (double& x : p) x = coordinate(gen);
+  Distance_matrix distances(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    for (std::size_t j = 0; j < i; ++j) distances[i].push_back(Gudhi::Euclidean_distance()(points[i], points[j]));
+  const double inf = std::numeric_limits<double>::infinity();
+  for (std::size_t starting_point : {std::size_t(0), std::size_t(123)}) {
+    for (std::size_t num_landmarks : {std::size_t(1), std::size_t(10), std::size_t(50), std::size_t(200),
+                                      std::size_t(1000)}) {
+      Simplex_tree st, st_matrix, st_reference;
+      Sparse_rips_complex(points, Gudhi::Euclidean_distance(), .5, -inf, inf, num_landmarks, starting_point)
+          .create_complex(st, 2);
+      Sparse_rips_complex(distances, .5, -inf, inf, num_landmarks, starting_point).create_complex(st_matrix, 2);
+      std::size_t expected = std::min(num_landmarks, points.size());
+      BOOST_CHECK(st.num_vertices() == expected);
+      BOOST_CHECK(st == st_matrix);
+
+      // Reference: the sparse Rips complex of the landmarks, in the order of their selection
+      std::vector<std::size_t> landmarks;
+      auto distance = [&points](std::size_t i, std::size_t j) {
+        return Gudhi::Euclidean_distance()(points[i], points[j]);
+      };
+      Gudhi::subsampling::choose_n_farthest_points_metric(distance, boost::irange<std::size_t>(0, points.size()),
+                                                          num_landmarks, starting_point,
+                                                          std::back_inserter(landmarks));
+      std::vector<Point> subsample;
+      for (std::size_t landmark : landmarks) subsample.push_back(points[landmark]);
+      Sparse_rips_complex(subsample, Gudhi::Euclidean_distance(), .5, -inf, inf,
+                          std::numeric_limits<std::size_t>::max(), 0).create_complex(st_reference, 2);
+      BOOST_CHECK(st.num_simplices() == st_reference.num_simplices());
+      for (auto sh : st_reference.complex_simplex_range()) {
+        std::vector<int> simplex;
+        for (auto v : st_reference.simplex_vertex_range(sh)) simplex.push_back(static_cast<int>(landmarks[v]));
+        auto st_sh = st.find(simplex);
+        BOOST_CHECK(st_sh != st.null_simplex());
+        if (st_sh != st.null_simplex()) BOOST_CHECK(st.filtration(st_sh) == st_reference.filtration(sh));
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(Rips_doc_csv_file) {
   // ----------------------------------------------------------------------------
   //
@@ -403,3 +455,201 @@ BOOST_AUTO_TEST_CASE(Rips_create_complex_throw) {
   BOOST_CHECK_THROW (rips_complex_from_file.create_complex(stree, 1), std::invalid_argument);
 }
 #endif
+
+BOOST_AUTO_TEST_CASE(Rips_grid_proximity_graph) {
+  // With Euclidean_distance, only the pairs of points in neighboring cells of a grid are compared. The complex is
+  // the same as the one of the same distance compared on all the pairs.
+  auto all_pairs_distance = [](const Point& p1, const Point& p2) { return Gudhi::Euclidean_distance()(p1, p2); };
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> coordinate(-3., 3.);
+  for (int dim : {1, 2, 3, 5}) {
+    std::vector<Point> points(120, Point(dim));
+    for (Point& p : points)
+      for (double& x : p) x = std::round(coordinate(gen) * 4) / 4;  // with duplicate points and distances
+    for (Filtration_value threshold : {0., 0.5, 1., 2.5, 20., std::numeric_limits<Filtration_value>::infinity()}) {
+      Simplex_tree st_grid, st;
+      Rips_complex(points, threshold, Gudhi::Euclidean_distance()).create_complex(st_grid, 2);
+      Rips_complex(points, threshold, all_pairs_distance).create_complex(st, 2);
+      BOOST_CHECK(st_grid == st);
+      std::clog << "dim=" << dim << " - threshold=" << threshold << " - " << st.num_simplices() << " simplices\n";
+    }
+  }
+  // Points as pairs
+  std::vector<std::pair<double, double>> pairs = {{0., 0.}, {0., 1.}, {1., 0.}, {5., 5.}, {5.5, 5.}};
+  Simplex_tree st_pairs;
+  Rips_complex(pairs, 1., Gudhi::Euclidean_distance()).create_complex(st_pairs, 1);
+  BOOST_CHECK(st_pairs.num_simplices() == 5 + 3);
+}
+
+BOOST_AUTO_TEST_CASE(Rips_euclidean_proximity_edges) {
+  // The tiled kernel gives the same edges and lengths as Euclidean_distance, over several tiles and blocks
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> coordinate(-1.f, 1.f);
+  const std::size_t n = 700;
+  for (std::size_t dim : {3, 200}) {
+    std::vector<float> buffer(n * dim);
+    for (float& x : buffer) x = coordinate(gen);
+    std::vector<std::vector<float>> points(n);
+    for (std::size_t u = 0; u < n; ++u) points[u].assign(buffer.begin() + u * dim, buffer.begin() + (u + 1) * dim);
+    for (float threshold : {0.f, 0.3f, 1.f, 11.f, std::numeric_limits<float>::infinity()}) {
+      std::vector<std::size_t> offsets;
+      std::vector<int> neighbors;
+      std::vector<float> filtrations;
+      Gudhi::euclidean_proximity_edges(buffer.data(), n, dim, threshold, offsets, neighbors, filtrations);
+      BOOST_CHECK(offsets.size() == n + 1);
+      std::size_t e = 0;
+      bool same = true;
+      for (std::size_t u = 0; u < n; ++u) {
+        same = same && offsets[u] == e;
+        for (std::size_t v = u + 1; v < n; ++v) {
+          float fil = Gudhi::Euclidean_distance()(points[u], points[v]);
+          if (fil <= threshold) {
+            same = same && e < neighbors.size() && neighbors[e] == static_cast<int>(v) && filtrations[e] == fil;
+            ++e;
+          }
+        }
+      }
+      BOOST_CHECK(same);
+      BOOST_CHECK(offsets[n] == e && neighbors.size() == e);
+      std::clog << "dim=" << dim << " threshold=" << threshold << " - " << e << " edges\n";
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Rips_high_dimensional_points) {
+  // The grid on the first coordinates keeps most of the pairs of high-dimensional points at the larger thresholds,
+  // which are then all compared with the tiled kernel, with the same complex
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> first_coordinate(0., 30.), coordinate(-1., 1.);
+  std::vector<Point> points(300, Point(64));
+  for (Point& p : points)
+    for (std::size_t k = 0; k < p.size(); ++k) p[k] = k < 3 ? first_coordinate(gen) : coordinate(gen);
+  for (double threshold : {6.5, 8., 10.}) {
+    Simplex_tree st, expected;
+    Rips_complex(points, threshold, Gudhi::Euclidean_distance()).create_complex(st, 1);
+    Rips_complex(points, threshold, [](const Point& p, const Point& q) {
+      return Gudhi::Euclidean_distance()(p, q);
+    }).create_complex(expected, 1);
+    BOOST_CHECK(st == expected);
+    std::clog << "threshold=" << threshold << " - " << st.num_simplices() << " simplices\n";
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Rips_grow_complex) {
+  // Growing the complex over increasing thresholds, by rebuilding it or inserting a few edges, gives the complexes
+  // built at each threshold
+  using Fast_cofaces_tree = Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_cofaces>;
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(60, Point(2));
+  for (Point& p : points)
+    for (double& x : p) x = std::round(coordinate(gen) * 20) / 20;  // with equal lengths
+  const int dim_max = 3;
+  Rips_complex sweep(points, 0.4, Gudhi::Euclidean_distance());
+  Fast_cofaces_tree st_grown;
+  for (Filtration_value threshold : {0., 0.1, 0.2, 0.2, 0.21, 0.22, 0.3, 0.4}) {
+    sweep.grow_complex(st_grown, threshold, dim_max);
+    Fast_cofaces_tree st;
+    Rips_complex(points, threshold, Gudhi::Euclidean_distance()).create_complex(st, dim_max);
+    BOOST_CHECK(st_grown == st);
+    std::clog << "threshold=" << threshold << " - " << st_grown.num_simplices() << " simplices\n";
+  }
+  BOOST_CHECK_THROW(sweep.grow_complex(st_grown, 0.3, dim_max), std::invalid_argument);
+
+  // The sweep starts again from an empty complex
+  Fast_cofaces_tree st_again;
+  sweep.grow_complex(st_again, 0.2, dim_max);
+  Fast_cofaces_tree st;
+  Rips_complex(points, 0.2, Gudhi::Euclidean_distance()).create_complex(st, dim_max);
+  BOOST_CHECK(st_again == st);
+}
+
+BOOST_AUTO_TEST_CASE(Rips_sparse_distance_matrix) {
+  // A sparse distance matrix, with the absent entries infinite, gives the same complex as the full distance matrix
+  std::mt19937 gen(13);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(80, Point(2));
+  for (Point& p : points)
+    for (double& x : p) x = coordinate(gen);
+  const double radius = 0.3;
+  Distance_matrix distances(points.size());
+  // Entries below radius, stored in one or both triangles, a few of them twice with a larger duplicate
+  std::vector<std::size_t> offsets{0};
+  std::vector<int> indices;
+  std::vector<double> values;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    for (std::size_t j = 0; j < points.size(); ++j) {
+      double d = Gudhi::Euclidean_distance()(points[i], points[j]);
+      if (j < i) distances[i].push_back(d <= radius ? d : std::numeric_limits<double>::infinity());
+      if (d > radius || (j < i && (i + j) % 3 == 0) || (i < j && (i + j) % 3 == 1)) continue;
+      indices.push_back(j);
+      values.push_back(d);
+      if ((i + j) % 5 == 0) {
+        indices.push_back(j);
+        values.push_back(d + 1.);
+      }
+    }
+    offsets.push_back(indices.size());
+  }
+  for (double threshold : {0., 0.1, 0.25, radius}) {
+    Simplex_tree st_sparse, st;
+    Rips_complex(offsets, indices, values, threshold).create_complex(st_sparse, 3);
+    Rips_complex(distances, threshold).create_complex(st, 3);
+    BOOST_CHECK(st_sparse == st);
+    std::clog << "threshold=" << threshold << " - " << st_sparse.num_simplices() << " simplices\n";
+  }
+  // The absent entries are not edges, even with an infinite threshold
+  Simplex_tree st_inf, st_radius;
+  Rips_complex(offsets, indices, values, std::numeric_limits<double>::infinity()).create_complex(st_inf, 3);
+  Rips_complex(offsets, indices, values, radius).create_complex(st_radius, 3);
+  BOOST_CHECK(st_inf == st_radius);
+  // Without any entry
+  Simplex_tree st_empty;
+  Rips_complex(std::vector<std::size_t>{0, 0, 0}, std::vector<int>(), std::vector<double>(), 1.)
+      .create_complex(st_empty, 2);
+  BOOST_CHECK(st_empty.num_simplices() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(Weighted_rips_complex) {
+  // Same complex as inserting the vertices and the edges one by one, as the Python WeightedRipsComplex does
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(60, Point(2));
+  for (Point& p : points)
+    for (double& x : p) x = coordinate(gen);
+  Distance_matrix full(points.size()), lower(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    for (std::size_t j = 0; j < points.size(); ++j) {
+      double d = Gudhi::Euclidean_distance()(points[i], points[j]);
+      full[i].push_back(d);
+      if (j < i) lower[i].push_back(d);
+    }
+  }
+  std::vector<double> dtm = Gudhi::rips_complex::distance_to_measure(full, 5);
+  // Not 1-Lipschitz, so that the filtration of some edges is the one of a vertex
+  std::vector<double> weights = dtm;
+  weights[3] = 0.4;
+  for (double threshold : {0.3, 0.5, std::numeric_limits<double>::infinity()}) {
+    Simplex_tree st, st_expected;
+    Gudhi::rips_complex::Weighted_rips_complex<Filtration_value>(lower, weights, threshold).create_complex(st, 2);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      if (2 * weights[i] <= threshold) st_expected.insert_simplex({static_cast<int>(i)}, 2 * weights[i]);
+      for (std::size_t j = 0; j < i; ++j) {
+        double fil = std::max({2 * weights[i], 2 * weights[j], lower[i][j] + weights[i] + weights[j]});
+        if (fil <= threshold) st_expected.insert_simplex({static_cast<int>(j), static_cast<int>(i)}, fil);
+      }
+    }
+    st_expected.expansion(2);
+    BOOST_CHECK(st == st_expected);
+    std::clog << "threshold=" << threshold << " - " << st.num_simplices() << " simplices\n";
+  }
+
+  // The point itself is one of its k nearest neighbors
+  Distance_matrix small{{0., 1., 3.}, {1., 0., 2.}, {3., 2., 0.}};
+  std::vector<double> small_dtm = Gudhi::rips_complex::distance_to_measure(small, 2);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(small_dtm[0], std::sqrt(.5));
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(small_dtm[2], std::sqrt(2.));
+  small_dtm = Gudhi::rips_complex::distance_to_measure(small, 3, 1.);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(small_dtm[1], 1.);
+  BOOST_CHECK_THROW(Gudhi::rips_complex::distance_to_measure(small, 4), std::invalid_argument);
+}
@@ -0,0 +1,97 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "rips_persistence"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>  // for std::sort
+#include <limits>
+#include <random>
+#include <utility>  // for std::pair
+#include <vector>
+
+#include <gudhi/Rips_complex.h>
+#include <gudhi/Rips_persistence.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Persistent_cohomology/Field_Z2.h>
+#include <gudhi/distance_functions.h>
+
+using Point = std::vector<double>;
+using Simplex_tree = Gudhi::Simplex_tree<>;
+using Filtration_value = Simplex_tree::Filtration_value;
+using Rips_complex = Gudhi::rips_complex::Rips_complex<Filtration_value>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+using Field_Z2 = Gudhi::persistent_cohomology::Field_Z2;
+using Interval = std::pair<Filtration_value, Filtration_value>;
+
+std::vector<Point> random_points(int n, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> coordinate(0., 1.);
+  std::vector<Point> points(n);
+  for (Point& p : points) p = {coordinate(gen), coordinate(gen), coordinate(gen)};
+  return points;
+}
+
+template<class CoefficientField>
+void test_same_diagram_as_simplex_tree(const std::vector<Point>& points, Filtration_value threshold, int dim_max,
+                                       int charac) {
+  Simplex_tree st;
+  Rips_complex(points, threshold, Gudhi::Euclidean_distance()).create_complex(st, dim_max);
+  Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree, CoefficientField> pcoh(st);
+  pcoh.init_coefficients(charac);
+  pcoh.compute_persistent_cohomology();
+
+  Gudhi::rips_complex::Rips_persistence<Filtration_value, CoefficientField> rips_persistence(
+      points, threshold, dim_max, Gudhi::Euclidean_distance());
+  rips_persistence.init_coefficients(charac);
+  rips_persistence.compute_persistent_cohomology();
+
+  BOOST_CHECK(rips_persistence.betti_numbers() == pcoh.betti_numbers());
+  for (int dim = 0; dim < dim_max; ++dim) {
+    std::vector<Interval> expected = pcoh.intervals_in_dimension(dim);
+    std::vector<Interval> intervals = rips_persistence.intervals_in_dimension(dim);
+    std::sort(expected.begin(), expected.end());
+    std::sort(intervals.begin(), intervals.end());
+    std::clog << "Dimension " << dim << " - " << intervals.size() << " intervals" << std::endl;
+    BOOST_CHECK(intervals == expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(rips_persistence_same_diagram_as_simplex_tree) {
+  std::vector<Point> points = random_points(40, 0);
+  test_same_diagram_as_simplex_tree<Field_Zp>(points, 0.5, 3, 11);
+  test_same_diagram_as_simplex_tree<Field_Zp>(points, 0.4, 4, 3);
+  test_same_diagram_as_simplex_tree<Field_Z2>(points, 0.45, 4, 2);
+  test_same_diagram_as_simplex_tree<Field_Zp>(points, std::numeric_limits<Filtration_value>::infinity(), 2, 2);
+  test_same_diagram_as_simplex_tree<Field_Zp>(points, 0.3, 1, 2);
+}
+
+BOOST_AUTO_TEST_CASE(rips_persistence_from_distance_matrix) {
+  // Square with unit sides and diagonals of length 2: one 1-dimensional class, born at 1 and dead at 2
+  std::vector<std::vector<Filtration_value>> distance_matrix = {{}, {1.}, {2., 1.}, {1., 2., 1.}};
+  Gudhi::rips_complex::Rips_persistence<Filtration_value> rips_persistence(distance_matrix, 3., 3);
+  rips_persistence.init_coefficients(2);
+  rips_persistence.compute_persistent_cohomology();
+
+  BOOST_CHECK(rips_persistence.intervals_in_dimension(1) == std::vector<Interval>({{1., 2.}}));
+  BOOST_CHECK(rips_persistence.betti_numbers() == std::vector<int>({1, 0, 0}));
+  // All the finite intervals have length 1, and are discarded with min_interval_length = 1
+  rips_persistence.compute_persistent_cohomology(1.);
+  BOOST_CHECK(rips_persistence.get_persistent_pairs().size() == 1);
+  BOOST_CHECK(rips_persistence.betti_numbers() == std::vector<int>({1, 0, 0}));
+
+  // Only the vertices
+  Gudhi::rips_complex::Rips_persistence<Filtration_value> vertices_persistence(distance_matrix, 3., 0);
+  vertices_persistence.init_coefficients(2);
+  vertices_persistence.compute_persistent_cohomology();
+  BOOST_CHECK(vertices_persistence.betti_numbers() == std::vector<int>({4}));
+}
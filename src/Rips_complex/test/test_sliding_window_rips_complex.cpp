@@ -0,0 +1,104 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "sliding_window_rips_complex"
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>  // for std::sort
+#include <cmath>
+#include <random>
+#include <utility>  // for std::pair
+#include <vector>
+
+#include <gudhi/Rips_complex.h>
+#include <gudhi/Sliding_window_rips_complex.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/distance_functions.h>
+
+using Point = std::vector<double>;
+using Simplex_tree = Gudhi::Simplex_tree<>;
+using Stream_simplex_tree = Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_cofaces>;
+using Filtration_value = Simplex_tree::Filtration_value;
+using Rips_complex = Gudhi::rips_complex::Rips_complex<Filtration_value>;
+using Sliding_window_rips_complex =
+    Gudhi::rips_complex::Sliding_window_rips_complex<Stream_simplex_tree, Point, Gudhi::Euclidean_distance>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+using Interval = std::pair<Filtration_value, Filtration_value>;
+using Simplex = std::pair<std::vector<int>, Filtration_value>;
+
+// Noisy samples of a circle, as a time-delay embedding of a periodic signal
+std::vector<Point> stream(int n, int seed) {
+  std::mt19937 gen(seed);
+  std::normal_distribution<double> noise(0., 0.05);
+  std::vector<Point> points(n);
+  for (int i = 0; i < n; ++i) points[i] = {std::cos(0.4 * i) + noise(gen), std::sin(0.4 * i) + noise(gen)};
+  return points;
+}
+
+// The simplices of the complex, with their vertices shifted by -first_vertex
+template <class SimplexTree>
+std::vector<Simplex> simplices(SimplexTree& st, int first_vertex) {
+  std::vector<Simplex> result;
+  for (auto sh : st.complex_simplex_range()) {
+    std::vector<int> vertices;
+    for (auto v : st.simplex_vertex_range(sh)) vertices.push_back(v - first_vertex);
+    std::sort(vertices.begin(), vertices.end());
+    result.emplace_back(vertices, st.filtration(sh));
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+template <class SimplexTree>
+std::vector<Interval> intervals(SimplexTree& st, int dim) {
+  Gudhi::persistent_cohomology::Persistent_cohomology<SimplexTree, Field_Zp> pcoh(st);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  std::vector<Interval> result = pcoh.intervals_in_dimension(dim);
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+void test_same_as_rips_complex(Filtration_value threshold, int dim_max, std::size_t window) {
+  std::vector<Point> points = stream(60, 42);
+  Sliding_window_rips_complex sliding(threshold, dim_max);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    sliding.push_back(points[i]);
+    if (sliding.size() > window) sliding.pop_front();
+    BOOST_CHECK(sliding.size() == std::min(i + 1, window));
+
+    std::vector<Point> window_points(points.begin() + sliding.first_vertex(), points.begin() + i + 1);
+    Simplex_tree st;
+    Rips_complex(window_points, threshold, Gudhi::Euclidean_distance()).create_complex(st, dim_max);
+    BOOST_CHECK(simplices(sliding.complex(), sliding.first_vertex()) == simplices(st, 0));
+    for (int dim = 0; dim < dim_max; ++dim) BOOST_CHECK(intervals(sliding.complex(), dim) == intervals(st, dim));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window_rips_complex_same_as_rips_complex) {
+  test_same_as_rips_complex(0.8, 2, 15);
+  test_same_as_rips_complex(0.5, 3, 20);
+  test_same_as_rips_complex(std::numeric_limits<Filtration_value>::infinity(), 3, 8);
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window_rips_complex_empty_window) {
+  Sliding_window_rips_complex sliding(1., 2);
+  BOOST_CHECK_THROW(sliding.pop_front(), std::out_of_range);
+  sliding.push_back({0., 0.});
+  sliding.push_back({0.5, 0.});
+  sliding.pop_front();
+  sliding.pop_front();
+  BOOST_CHECK(sliding.size() == 0);
+  BOOST_CHECK(sliding.complex().num_simplices() == 0);
+  BOOST_CHECK(sliding.push_back({1., 0.}) == 2);
+  BOOST_CHECK(sliding.complex().num_simplices() == 1);
+}
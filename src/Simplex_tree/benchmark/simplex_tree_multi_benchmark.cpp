@@ -0,0 +1,171 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// Benchmark of the hot paths of the multi-parameter simplex tree (src/python/include/Simplex_tree_multi.h), for
+// several sizes and numbers of parameters. The timings are printed as a JSON array, on the standard output or in
+// the file given as first argument, e.g.
+//   simplex_tree_multi_benchmark multi_benchmark.json
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Clock.h>
+
+#include "Simplex_tree_multi.h"
+#include "Simplex_tree_multi_scc.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <random>
+#include <numeric>  // for std::iota
+#include <string>
+#include <vector>
+#include <cstdio>  // for std::remove
+
+using Simplex_tree_multi = Gudhi::Simplex_tree<Gudhi::multiparameter::options_multi>;
+using Filtration_value = Simplex_tree_multi::Filtration_value;
+using value_type = Gudhi::multiparameter::options_multi::value_type;
+
+std::mt19937 gen(42);
+
+struct Benchmark_result {
+  std::string name;
+  int num_vertices;
+  int num_parameters;
+  std::size_t num_simplices;
+  double seconds;
+};
+
+std::vector<Benchmark_result> results;
+
+template <class F>
+void run(const std::string& name, int num_vertices, int num_parameters, std::size_t num_simplices, F&& f) {
+  Gudhi::Clock clock(name);
+  f();
+  clock.end();
+  std::clog << "... " << clock;
+  results.push_back({name, num_vertices, num_parameters, num_simplices, clock.num_seconds()});
+}
+
+Filtration_value random_filtration(int num_parameters) {
+  std::uniform_real_distribution<value_type> dist(0, 1);
+  std::vector<value_type> f(num_parameters);
+  for (auto& x : f) x = dist(gen);
+  return Filtration_value(f);
+}
+
+// Random graph with about `degree * num_vertices / 2` edges.
+std::vector<std::vector<int>> random_edges(int num_vertices, int degree) {
+  std::uniform_int_distribution<int> vertex(0, num_vertices - 1);
+  std::vector<std::vector<int>> edges;
+  for (int i = 0; i < degree * num_vertices / 2; i++) {
+    int u = vertex(gen), v = vertex(gen);
+    if (u != v) edges.push_back({u, v});
+  }
+  return edges;
+}
+
+void benchmark(int num_vertices, int num_parameters) {
+  std::clog << "Benchmark with " << num_vertices << " vertices and " << num_parameters << " parameters" << std::endl;
+  const int max_dimension = 3;
+  auto edges = random_edges(num_vertices, 20);
+
+  // Graph, then its expansion
+  Simplex_tree_multi st;
+  st.set_number_of_parameters(num_parameters);
+  for (int v = 0; v < num_vertices; v++) st.insert_simplex({v}, random_filtration(num_parameters));
+  for (const auto& edge : edges) st.insert_simplex(edge, random_filtration(num_parameters));
+  run("expansion", num_vertices, num_parameters, st.num_simplices(), [&] { st.expansion(max_dimension); });
+  const std::size_t num_simplices = st.num_simplices();
+  results.back().num_simplices = num_simplices;
+
+  // Same complex, inserted from its simplices at once
+  std::vector<std::vector<int>> simplices;
+  std::vector<Filtration_value> filtrations;
+  for (auto sh : st.complex_simplex_range()) {
+    auto vertices = st.simplex_vertex_range(sh);
+    simplices.emplace_back(vertices.begin(), vertices.end());
+    filtrations.push_back(random_filtration(num_parameters));
+  }
+  Simplex_tree_multi st_batch;
+  st_batch.set_number_of_parameters(num_parameters);
+  run("insert_batch", num_vertices, num_parameters, num_simplices,
+      [&] { st_batch.insert_batch(simplices, [&](std::size_t i) { return filtrations[i]; }); });
+
+  run("make_filtration_non_decreasing", num_vertices, num_parameters, num_simplices,
+      [&] { st_batch.make_filtration_non_decreasing(); });
+
+  std::vector<std::vector<value_type>> functions(num_parameters, std::vector<value_type>(num_vertices));
+  for (auto& function : functions)
+    for (auto& x : function) x = std::uniform_real_distribution<value_type>(0, 1)(gen);
+  std::vector<int> axes(num_parameters);
+  std::iota(axes.begin(), axes.end(), 0);
+  run("fill_lowerstar", num_vertices, num_parameters, num_simplices,
+      [&] { Gudhi::multiparameter::fill_lowerstar(st_batch, functions, axes); });
+
+  // Regular grid of 100 values in [0, 1] for each parameter
+  Gudhi::multiparameter::multi_filtration_grid grid(num_parameters);
+  for (auto& values : grid)
+    for (int i = 0; i < 100; i++) values.push_back(i / 99.f);
+
+  run("find_coordinates", num_vertices, num_parameters, num_simplices, [&] {
+    for (auto sh : st.complex_simplex_range()) {
+      Filtration_value f = st.filtration(sh);
+      Gudhi::multiparameter::find_coordinates(f, grid);
+    }
+  });
+
+  Simplex_tree_multi st_squeezed(st);
+  run("squeeze_filtration", num_vertices, num_parameters, num_simplices,
+      [&] { Gudhi::multiparameter::squeeze_filtration(st_squeezed, grid, true); });
+
+  Gudhi::Simplex_tree<> st_projection;
+  Gudhi::multiparameter::flatten(st_projection, st, 0);
+  std::vector<value_type> linear_form(num_parameters, 1.f / num_parameters);
+  run("linear_projection", num_vertices, num_parameters, num_simplices,
+      [&] { Gudhi::multiparameter::linear_projection(st_projection, st, linear_form); });
+
+  Gudhi::Simplex_tree<> st_diag;
+  std::vector<value_type> basepoint(num_parameters, 0);
+  basepoint[0] = -0.5;
+  run("flatten_diag", num_vertices, num_parameters, num_simplices,
+      [&] { Gudhi::multiparameter::flatten_diag(st_diag, st, basepoint, 0); });
+
+  const std::string path = (std::filesystem::temp_directory_path() / "simplex_tree_multi_benchmark.scc").string();
+  Gudhi::multiparameter::Scc_writer_options options;
+  run("write_scc", num_vertices, num_parameters, num_simplices,
+      [&] { Gudhi::multiparameter::write_scc(st, path, options); });
+  options.binary = true;
+  run("write_scc_binary", num_vertices, num_parameters, num_simplices,
+      [&] { Gudhi::multiparameter::write_scc(st, path, options); });
+  std::remove(path.c_str());
+}
+
+int main(int argc, char* argv[]) {
+  for (int num_vertices : {1000, 10000, 100000})
+    for (int num_parameters : {2, 4}) benchmark(num_vertices, num_parameters);
+
+  std::ostringstream json;
+  json << "[\n";
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const auto& result = results[i];
+    json << "  {\"name\": \"" << result.name << "\", \"num_vertices\": " << result.num_vertices
+         << ", \"num_parameters\": " << result.num_parameters << ", \"num_simplices\": " << result.num_simplices
+         << ", \"seconds\": " << result.seconds << "}" << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  json << "]\n";
+  if (argc > 1) {
+    std::ofstream file(argv[1]);
+    file << json.str();
+  } else {
+    std::cout << json.str();
+  }
+  return 0;
+}
@@ -33,5 +33,7 @@ struct SimplexTreeOptions {
   static const bool stable_simplex_handles;
   /// If true, assumes that Filtration_value is vector-like instead of float-like. This also assumes that Filtration_values is a class, which has a push_to method to push a filtration value $x$ onto $this>=0$. 
   static const bool is_multi_parameter;
+  /// Optional, false if not defined. If true, the `Siblings` and the buffers of their members are allocated in pools owned by the simplex tree, and released at once by `Gudhi::Simplex_tree::clear` and the destructor. The pools are not thread safe, so that `Gudhi::Simplex_tree::expansion` is then sequential. The buffers of the members can be allocated in a file mapped in memory, for trees larger than the memory, with `Gudhi::Simplex_tree::set_siblings_memory_resource` and `Gudhi::simplex_tree::Mapped_file_resource`, or in huge pages interleaved on the NUMA nodes with `Gudhi::simplex_tree::Huge_page_resource`.
+  static const bool pool_siblings;
 };
 
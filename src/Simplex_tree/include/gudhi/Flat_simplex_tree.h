@@ -0,0 +1,405 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef FLAT_SIMPLEX_TREE_H_
+#define FLAT_SIMPLEX_TREE_H_
+
+#include <gudhi/Simplex_tree.h>
+
+#include <boost/range/iterator_range.hpp>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_sort.h>
+#endif
+
+#include <algorithm>  // for std::sort, std::lower_bound, std::mismatch
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <cstring>  // for std::memcpy, std::memcmp
+#include <initializer_list>
+#include <limits>
+#include <numeric>  // for std::iota
+#include <stdexcept>
+#include <type_traits>
+#include <utility>  // for std::pair
+#include <vector>
+
+namespace Gudhi {
+
+namespace simplex_tree {
+
+/** \addtogroup simplex_tree
+ * @{
+ */
+
+/** @private @brief Layout of the flat serialization of a simplex tree, cf. `Flat_simplex_tree`.
+ *
+ * The buffer starts with this header, followed by the sections, each aligned on 8 bytes:
+ * - nodes : one `Flat_node` per simplex, the children of a node being consecutive and sorted by vertex,
+ * - values : `num_parameters` filtration values per simplex,
+ * - labels : the sorted vertices, i.e., the vertices of the first `num_vertices` nodes,
+ * - label offsets and label nodes : the nodes with label `labels[i]` are
+ *   `label_nodes[label_offsets[i]], ..., label_nodes[label_offsets[i+1] - 1]`, in increasing order,
+ * - filtration order : the nodes in the order of `Simplex_tree::filtration_simplex_range()`, the multi-parameter
+ *   filtration values being compared lexicographically.
+ */
+struct Flat_header {
+  static constexpr char magic_string[8] = {'G', 'U', 'D', 'H', 'I', 'S', 'T', '\0'};
+  static constexpr std::uint32_t current_version = 1;
+  static constexpr std::uint32_t native_byte_order = 0x01020304;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t vertex_size;  // sizeof(Vertex_handle)
+  std::uint32_t value_size;  // sizeof of one filtration value
+  std::uint32_t node_size;  // sizeof(Flat_node)
+  std::uint32_t num_parameters;  // number of filtration values per simplex, 0 if they are not stored
+  std::int64_t dimension;
+  std::uint64_t num_simplices;
+  std::uint64_t num_vertices;
+  // Offsets of the sections, in bytes from the beginning of the buffer
+  std::uint64_t nodes;
+  std::uint64_t values;
+  std::uint64_t labels;
+  std::uint64_t label_offsets;
+  std::uint64_t label_nodes;
+  std::uint64_t filtration_order;
+  std::uint64_t size;  // of the whole buffer
+};
+
+/** @private @brief Node of a `Flat_simplex_tree`. */
+template<typename Vertex_handle>
+struct Flat_node {
+  std::uint64_t parent;  // null if the node is a vertex
+  std::uint64_t first_child;
+  std::uint64_t num_children;
+  Vertex_handle vertex;
+};
+
+/** @private @brief Sets the sizes and offsets of the header of a flat serialization. */
+template<typename Vertex_handle, typename Value>
+Flat_header make_flat_header(std::size_t num_simplices, std::size_t num_vertices, std::size_t num_parameters,
+                             int dimension) {
+  auto aligned = [](std::uint64_t offset) { return (offset + 7) / 8 * 8; };
+  Flat_header header;
+  std::memcpy(header.magic, Flat_header::magic_string, sizeof(header.magic));
+  header.version = Flat_header::current_version;
+  header.byte_order = Flat_header::native_byte_order;
+  header.vertex_size = sizeof(Vertex_handle);
+  header.value_size = sizeof(Value);
+  header.node_size = sizeof(Flat_node<Vertex_handle>);
+  header.num_parameters = static_cast<std::uint32_t>(num_parameters);
+  header.dimension = dimension;
+  header.num_simplices = num_simplices;
+  header.num_vertices = num_vertices;
+  header.nodes = aligned(sizeof(Flat_header));
+  header.values = aligned(header.nodes + num_simplices * sizeof(Flat_node<Vertex_handle>));
+  header.labels = aligned(header.values + num_simplices * num_parameters * sizeof(Value));
+  header.label_offsets = aligned(header.labels + num_vertices * sizeof(Vertex_handle));
+  header.label_nodes = aligned(header.label_offsets + (num_vertices + 1) * sizeof(std::uint64_t));
+  header.filtration_order = aligned(header.label_nodes + num_simplices * sizeof(std::uint64_t));
+  header.size = header.filtration_order + num_simplices * sizeof(std::uint64_t);
+  return header;
+}
+
+/** @private @brief Type and number of the values stored for the filtration value of a simplex. */
+template<class SimplexTree, bool = SimplexTree::Options::is_multi_parameter>
+struct Flat_filtration_traits {
+  using Value = typename SimplexTree::Filtration_value;
+  static std::size_t num_parameters(const SimplexTree&) { return SimplexTree::Options::store_filtration ? 1 : 0; }
+  static const Value* begin(const Value& filtration) { return &filtration; }
+};
+
+template<class SimplexTree>
+struct Flat_filtration_traits<SimplexTree, true> {
+  using Value = typename SimplexTree::Options::value_type;
+  static std::size_t num_parameters(const SimplexTree& st) {
+    return SimplexTree::Options::store_filtration ? st.get_number_of_parameters() : 0;
+  }
+  static auto begin(const typename SimplexTree::Filtration_value& filtration) { return filtration.begin(); }
+};
+
+/** @brief Returns the size in bytes of the flat serialization of a simplex tree, cf. `flat_serialize`. */
+template<class SimplexTree>
+std::size_t get_flat_serialization_size(SimplexTree& st) {
+  using Traits = Flat_filtration_traits<SimplexTree>;
+  return make_flat_header<typename SimplexTree::Vertex_handle, typename Traits::Value>(
+      st.num_simplices(), st.num_vertices(), Traits::num_parameters(st), st.dimension()).size;
+}
+
+/** @brief Serializes a simplex tree in a format that can be queried in place, without rebuilding the tree, with a
+ * `Flat_simplex_tree`, e.g. from a memory mapped file shared by several processes.
+ *
+ * @param[in] st The simplex tree. Multi-parameter filtration values must all have `st.get_number_of_parameters()`
+ * coordinates, and multi-critical filtrations are not supported.
+ * @param[in] buffer An array of char, aligned on 8 bytes, of size `get_flat_serialization_size(st)`.
+ * @param[in] buffer_size The buffer size.
+ *
+ * @exception std::invalid_argument If the buffer size or alignment is wrong, or if a filtration value does not have
+ * the right number of coordinates.
+ *
+ * @warning The format is versioned, but not portable: it is meant to be read on a computer with the same
+ * architecture, with the same `Vertex_handle` and filtration value types.
+ */
+template<class SimplexTree>
+void flat_serialize(SimplexTree& st, char* buffer, const std::size_t buffer_size) {
+  using Vertex_handle = typename SimplexTree::Vertex_handle;
+  using Simplex_handle = typename SimplexTree::Simplex_handle;
+  using Traits = Flat_filtration_traits<SimplexTree>;
+  using Value = typename Traits::Value;
+  using Node = Flat_node<Vertex_handle>;
+  static_assert(!is_multi_critical<typename SimplexTree::Filtration_value>::value,
+                "Multi-critical filtrations cannot be serialized in a flat buffer.");
+  constexpr std::uint64_t null = std::numeric_limits<std::uint64_t>::max();
+
+  const std::size_t num_parameters = Traits::num_parameters(st);
+  const Flat_header header = make_flat_header<Vertex_handle, Value>(st.num_simplices(), st.num_vertices(),
+                                                                    num_parameters, st.dimension());
+  if (buffer_size != header.size)
+    throw std::invalid_argument("Flat serialization does not match the buffer size");
+  if (reinterpret_cast<std::uintptr_t>(buffer) % alignof(std::uint64_t) != 0)
+    throw std::invalid_argument("Flat serialization buffer must be aligned on 8 bytes");
+  std::memset(buffer, 0, buffer_size);
+  std::memcpy(buffer, &header, sizeof(Flat_header));
+  Node* nodes = reinterpret_cast<Node*>(buffer + header.nodes);
+  Value* values = reinterpret_cast<Value*>(buffer + header.values);
+  Vertex_handle* labels = reinterpret_cast<Vertex_handle*>(buffer + header.labels);
+  std::uint64_t* label_offsets = reinterpret_cast<std::uint64_t*>(buffer + header.label_offsets);
+  std::uint64_t* label_nodes = reinterpret_cast<std::uint64_t*>(buffer + header.label_nodes);
+  std::uint64_t* filtration_order = reinterpret_cast<std::uint64_t*>(buffer + header.filtration_order);
+
+  // Breadth first traversal, so that the children of a node are consecutive.
+  std::vector<Simplex_handle> handles;
+  handles.reserve(header.num_simplices);
+  auto push_node = [&](Simplex_handle sh, std::uint64_t parent) {
+    nodes[handles.size()] = Node{parent, null, 0, sh->first};
+    if (num_parameters > 0) {
+      const auto& filtration = SimplexTree::filtration(sh);
+      if constexpr (SimplexTree::Options::is_multi_parameter) {
+        if (filtration.size() != num_parameters)
+          throw std::invalid_argument("A filtration value does not have the number of parameters of the simplex tree");
+      }
+      std::copy_n(Traits::begin(filtration), num_parameters, values + handles.size() * num_parameters);
+    }
+    handles.push_back(sh);
+  };
+  for (auto sh = st.root()->members().begin(); sh != st.root()->members().end(); ++sh) push_node(sh, null);
+  for (std::size_t i = 0; i < handles.size(); ++i) {
+    Simplex_handle sh = handles[i];
+    if (!st.has_children(sh)) continue;
+    auto& children = sh->second.children()->members();
+    nodes[i].first_child = handles.size();
+    nodes[i].num_children = children.size();
+    for (auto child = children.begin(); child != children.end(); ++child) push_node(child, i);
+  }
+
+  // Lists of the nodes with the same label, the labels being the vertices.
+  for (std::size_t i = 0; i < header.num_vertices; ++i) labels[i] = nodes[i].vertex;
+  std::vector<std::uint64_t> label_index(header.num_simplices);
+  for (std::size_t i = 0; i < header.num_simplices; ++i) {
+    label_index[i] = std::lower_bound(labels, labels + header.num_vertices, nodes[i].vertex) - labels;
+    ++label_offsets[label_index[i] + 1];
+  }
+  for (std::size_t i = 0; i < header.num_vertices; ++i) label_offsets[i + 1] += label_offsets[i];
+  std::vector<std::uint64_t> position(label_offsets, label_offsets + header.num_vertices);
+  for (std::size_t i = 0; i < header.num_simplices; ++i) label_nodes[position[label_index[i]]++] = i;
+
+  // Same order as Simplex_tree::is_before_in_filtration, the ties being resolved with the reverse lexicographic
+  // order of the vertices, read from the nodes to the root, which puts the faces before their cofaces. The
+  // multi-parameter filtration values are only partially ordered, they are compared lexicographically to get a
+  // strict weak ordering, which is compatible with the partial order.
+  std::iota(filtration_order, filtration_order + header.num_simplices, 0);
+  auto is_before_in_filtration = [&](std::uint64_t a, std::uint64_t b) {
+    if (num_parameters > 0) {
+      const Value* fa = values + a * num_parameters;
+      const Value* fb = values + b * num_parameters;
+      auto [ita, itb] = std::mismatch(fa, fa + num_parameters, fb);
+      if (ita != fa + num_parameters) return *ita < *itb;
+    }
+    while (a != null && b != null) {
+      if (nodes[a].vertex != nodes[b].vertex) return nodes[a].vertex < nodes[b].vertex;
+      a = nodes[a].parent;
+      b = nodes[b].parent;
+    }
+    return a == null && b != null;
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_sort(filtration_order, filtration_order + header.num_simplices, is_before_in_filtration);
+#else
+  std::sort(filtration_order, filtration_order + header.num_simplices, is_before_in_filtration);
+#endif
+}
+
+/** @} */  // end addtogroup simplex_tree
+
+}  // namespace simplex_tree
+
+/** \addtogroup simplex_tree
+ * @{
+ */
+
+/**
+ * \class Flat_simplex_tree Flat_simplex_tree.h gudhi/Flat_simplex_tree.h
+ * \brief Read-only simplex tree over a buffer written by `Gudhi::simplex_tree::flat_serialize`.
+ *
+ * \details Nothing is allocated nor copied at construction: the buffer, e.g. a memory mapped file, is queried in
+ * place, so that several processes can share the same complex. The buffer must stay valid, and aligned on 8 bytes,
+ * as long as the object is used.
+ *
+ * Simplices are represented by the index of their node in the buffer. The vertices of the node `i` are the
+ * vertices of its parents, and the filtration values of a simplex are the `num_parameters()` values at
+ * `filtration_values(i)`.
+ *
+ * @tparam Vertex_handle Vertex handle type of the serialized simplex tree.
+ * @tparam Value Type of the filtration values, or of their coordinates for multi-parameter filtrations.
+ */
+template<typename Vertex_handle = int, typename Value = double>
+class Flat_simplex_tree {
+ public:
+  /** \brief Index of a simplex. */
+  typedef std::uint64_t Simplex_handle;
+  typedef boost::iterator_range<const Simplex_handle*> Filtration_simplex_range;
+
+  /** \brief Checks the header of the buffer and reads it.
+   * @exception std::invalid_argument If the buffer is not a flat serialization of version 1, with the same types,
+   * or if it is smaller than expected.
+   */
+  Flat_simplex_tree(const char* buffer, std::size_t buffer_size) {
+    if (buffer_size < sizeof(simplex_tree::Flat_header))
+      throw std::invalid_argument("Flat_simplex_tree - buffer is too small");
+    if (reinterpret_cast<std::uintptr_t>(buffer) % alignof(std::uint64_t) != 0)
+      throw std::invalid_argument("Flat_simplex_tree - buffer must be aligned on 8 bytes");
+    std::memcpy(&header_, buffer, sizeof(simplex_tree::Flat_header));
+    if (std::memcmp(header_.magic, simplex_tree::Flat_header::magic_string, sizeof(header_.magic)) != 0)
+      throw std::invalid_argument("Flat_simplex_tree - not a flat serialization of a simplex tree");
+    if (header_.version != simplex_tree::Flat_header::current_version)
+      throw std::invalid_argument("Flat_simplex_tree - unsupported version");
+    const auto expected = simplex_tree::make_flat_header<Vertex_handle, Value>(
+        header_.num_simplices, header_.num_vertices, header_.num_parameters, static_cast<int>(header_.dimension));
+    if (header_.byte_order != expected.byte_order || header_.vertex_size != expected.vertex_size ||
+        header_.value_size != expected.value_size || header_.node_size != expected.node_size)
+      throw std::invalid_argument("Flat_simplex_tree - the types do not match the serialized ones");
+    if (header_.size != expected.size || header_.filtration_order != expected.filtration_order ||
+        buffer_size < header_.size)
+      throw std::invalid_argument("Flat_simplex_tree - buffer is too small");
+    nodes_ = reinterpret_cast<const Node*>(buffer + header_.nodes);
+    values_ = reinterpret_cast<const Value*>(buffer + header_.values);
+    labels_ = reinterpret_cast<const Vertex_handle*>(buffer + header_.labels);
+    label_offsets_ = reinterpret_cast<const std::uint64_t*>(buffer + header_.label_offsets);
+    label_nodes_ = reinterpret_cast<const std::uint64_t*>(buffer + header_.label_nodes);
+    filtration_order_ = reinterpret_cast<const std::uint64_t*>(buffer + header_.filtration_order);
+  }
+
+  std::size_t num_simplices() const { return header_.num_simplices; }
+  std::size_t num_vertices() const { return header_.num_vertices; }
+  int dimension() const { return static_cast<int>(header_.dimension); }
+  /** \brief Number of filtration values per simplex, 0 if the simplex tree did not store them. */
+  std::size_t num_parameters() const { return header_.num_parameters; }
+  static Simplex_handle null_simplex() { return std::numeric_limits<Simplex_handle>::max(); }
+
+  /** \brief Dimension of the simplex. */
+  int dimension(Simplex_handle sh) const {
+    int dim = -1;
+    for (; sh != null_simplex(); sh = nodes_[sh].parent) ++dim;
+    return dim;
+  }
+
+  /** \brief Vertices of the simplex, in increasing order. */
+  std::vector<Vertex_handle> simplex_vertices(Simplex_handle sh) const {
+    std::vector<Vertex_handle> vertices;
+    for (; sh != null_simplex(); sh = nodes_[sh].parent) vertices.push_back(nodes_[sh].vertex);
+    std::reverse(vertices.begin(), vertices.end());
+    return vertices;
+  }
+
+  /** \brief Pointer on the `num_parameters()` filtration values of the simplex. */
+  const Value* filtration_values(Simplex_handle sh) const { return values_ + sh * header_.num_parameters; }
+
+  /** \brief Filtration value of the simplex, or its coordinate `parameter` for multi-parameter filtrations.
+   * 0 if the filtration values were not stored. */
+  Value filtration(Simplex_handle sh, std::size_t parameter = 0) const {
+    if (parameter >= header_.num_parameters) return Value{};
+    return filtration_values(sh)[parameter];
+  }
+
+  /** \brief Returns the simplex with the given vertices, `null_simplex()` if it is not in the complex. */
+  template<class InputVertexRange = std::initializer_list<Vertex_handle>>
+  Simplex_handle find(const InputVertexRange& s) const {
+    std::vector<Vertex_handle> simplex(std::begin(s), std::end(s));
+    std::sort(simplex.begin(), simplex.end());
+    simplex.erase(std::unique(simplex.begin(), simplex.end()), simplex.end());
+    Simplex_handle sh = null_simplex();
+    std::uint64_t first = 0, last = header_.num_vertices;
+    for (Vertex_handle v : simplex) {
+      const Node* it = std::lower_bound(nodes_ + first, nodes_ + last, v,
+                                        [](const Node& node, Vertex_handle vertex) { return node.vertex < vertex; });
+      if (it == nodes_ + last || it->vertex != v) return null_simplex();
+      sh = it - nodes_;
+      first = it->first_child;
+      last = it->first_child + it->num_children;
+    }
+    return sh;
+  }
+
+  /** \brief Cofaces of the simplex with codimension `codimension`, all its cofaces (including itself) if
+   * `codimension` is 0, as Simplex_tree::cofaces_simplex_range. Their order is not specified. */
+  std::vector<Simplex_handle> cofaces(Simplex_handle sh, int codimension) const {
+    std::vector<Simplex_handle> out;
+    if (sh == null_simplex()) return out;
+    const std::vector<Vertex_handle> simplex = simplex_vertices(sh);
+    // All the cofaces are below a node with the same label as sh containing its vertices.
+    const Vertex_handle* label = std::lower_bound(labels_, labels_ + header_.num_vertices, nodes_[sh].vertex);
+    const std::size_t index = label - labels_;
+    std::vector<std::pair<Simplex_handle, int>> stack;
+    for (std::uint64_t k = label_offsets_[index]; k != label_offsets_[index + 1]; ++k) {
+      const Simplex_handle candidate = label_nodes_[k];
+      // Vertices of the candidate, decreasing from the node to the root, containing the ones of the simplex
+      auto v = simplex.rbegin();
+      for (Simplex_handle p = candidate; p != null_simplex() && v != simplex.rend(); p = nodes_[p].parent) {
+        if (nodes_[p].vertex == *v) ++v;
+        else if (nodes_[p].vertex < *v) break;
+      }
+      if (v != simplex.rend()) continue;
+      stack.emplace_back(candidate, dimension(candidate) - static_cast<int>(simplex.size()) + 1);
+      while (!stack.empty()) {
+        auto [node, codim] = stack.back();
+        stack.pop_back();
+        if (codimension == 0 || codim == codimension) out.push_back(node);
+        if (codimension != 0 && codim >= codimension) continue;
+        for (std::uint64_t c = 0; c < nodes_[node].num_children; ++c)
+          stack.emplace_back(nodes_[node].first_child + c, codim + 1);
+      }
+    }
+    return out;
+  }
+
+  /** \brief Simplices in the order of `Simplex_tree::filtration_simplex_range()` at the serialization. */
+  Filtration_simplex_range filtration_simplex_range() const {
+    return Filtration_simplex_range(filtration_order_, filtration_order_ + header_.num_simplices);
+  }
+
+ private:
+  typedef simplex_tree::Flat_node<Vertex_handle> Node;
+
+  simplex_tree::Flat_header header_;
+  const Node* nodes_;
+  const Value* values_;
+  const Vertex_handle* labels_;
+  const std::uint64_t* label_offsets_;
+  const std::uint64_t* label_nodes_;
+  const std::uint64_t* filtration_order_;
+};
+
+/** @} */  // end addtogroup simplex_tree
+
+}  // namespace Gudhi
+
+#endif  // FLAT_SIMPLEX_TREE_H_
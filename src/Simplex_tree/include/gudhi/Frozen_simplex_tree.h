@@ -0,0 +1,313 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef FROZEN_SIMPLEX_TREE_H_
+#define FROZEN_SIMPLEX_TREE_H_
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Flat_simplex_tree.h>  // for Flat_filtration_traits
+
+#include <boost/range/iterator_range.hpp>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_sort.h>
+#endif
+
+#include <algorithm>  // for std::sort, std::lower_bound, std::upper_bound, std::mismatch
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint32_t
+#include <initializer_list>
+#include <limits>
+#include <numeric>  // for std::iota
+#include <stdexcept>
+#include <utility>  // for std::pair
+#include <vector>
+
+namespace Gudhi {
+
+/** \addtogroup simplex_tree
+ * @{
+ */
+
+/**
+ * \class Frozen_simplex_tree Frozen_simplex_tree.h gudhi/Frozen_simplex_tree.h
+ * \brief Read-only compact copy of a simplex tree, cf. `Gudhi::simplex_tree::freeze`.
+ *
+ * \details The trie of the simplex tree is stored level by level in a few arrays, without any pointer: the nodes of
+ * dimension `k` are consecutive and sorted by their parents, and the children of the node `i` are the nodes
+ * `child_offsets[i]`, ..., `child_offsets[i+1]-1`, sorted by vertex. A node thus costs its vertex, one child offset,
+ * its position in the filtration order and in the list of its label, all of type `Index`, and its filtration values,
+ * which is several times less than a node of a `Simplex_tree`. The parent of a node is not stored but found by a
+ * binary search on the child offsets, so that going up in the trie costs a logarithmic time per level.
+ *
+ * Simplices are represented by the index of their node. The object can be copied, and queried concurrently.
+ *
+ * @tparam Vertex_handle Vertex handle type of the simplex tree.
+ * @tparam Value Type of the filtration values, or of their coordinates for multi-parameter filtrations.
+ * @tparam Index Unsigned integer type of the node indices, large enough for the number of simplices.
+ */
+template<typename Vertex_handle = int, typename Value = double, typename Index = std::uint32_t>
+class Frozen_simplex_tree {
+ public:
+  /** \brief Index of a simplex. */
+  typedef Index Simplex_handle;
+  typedef boost::iterator_range<typename std::vector<Index>::const_iterator> Filtration_simplex_range;
+
+  /** \brief Builds the compact copy of a simplex tree, which is not modified.
+   *
+   * Multi-parameter filtration values must all have `st.get_number_of_parameters()` coordinates, and multi-critical
+   * filtrations are not supported.
+   * @exception std::invalid_argument If `Index` cannot represent all the simplices, or if a filtration value does
+   * not have the right number of coordinates.
+   */
+  template<class SimplexTree>
+  explicit Frozen_simplex_tree(SimplexTree& st) {
+    using Traits = simplex_tree::Flat_filtration_traits<SimplexTree>;
+    using St_simplex_handle = typename SimplexTree::Simplex_handle;
+    static_assert(!simplex_tree::is_multi_critical<typename SimplexTree::Filtration_value>::value,
+                  "Multi-critical filtrations cannot be frozen.");
+    const std::size_t num_simplices = st.num_simplices();
+    const std::size_t num_vertices = st.num_vertices();
+    if (num_simplices >= static_cast<std::size_t>(null_simplex()))
+      throw std::invalid_argument("Frozen_simplex_tree - too many simplices for the index type");
+    num_parameters_ = Traits::num_parameters(st);
+    labels_.reserve(num_simplices);
+    child_offsets_.reserve(num_simplices + 1);
+    values_.reserve(num_simplices * num_parameters_);
+    level_offsets_.push_back(0);
+
+    // Breadth first traversal, so that the children of a node are consecutive. The parents are only kept to sort the
+    // filtration.
+    std::vector<St_simplex_handle> handles;
+    std::vector<Index> parents;
+    handles.reserve(num_simplices);
+    parents.reserve(num_simplices);
+    auto push_node = [&](St_simplex_handle sh, Index parent) {
+      labels_.push_back(sh->first);
+      if (num_parameters_ > 0) {
+        const auto& filtration = SimplexTree::filtration(sh);
+        if constexpr (SimplexTree::Options::is_multi_parameter) {
+          if (filtration.size() != num_parameters_)
+            throw std::invalid_argument("A filtration value does not have the number of parameters of the simplex tree");
+        }
+        values_.insert(values_.end(), Traits::begin(filtration), Traits::begin(filtration) + num_parameters_);
+      }
+      handles.push_back(sh);
+      parents.push_back(parent);
+    };
+    for (auto sh = st.root()->members().begin(); sh != st.root()->members().end(); ++sh) push_node(sh, null_simplex());
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+      if (i == level_offsets_.back()) level_offsets_.push_back(static_cast<Index>(handles.size()));
+      child_offsets_.push_back(static_cast<Index>(handles.size()));
+      St_simplex_handle sh = handles[i];
+      if (!st.has_children(sh)) continue;
+      auto& children = sh->second.children()->members();
+      for (auto child = children.begin(); child != children.end(); ++child) push_node(child, static_cast<Index>(i));
+    }
+    child_offsets_.push_back(static_cast<Index>(handles.size()));
+
+    // Lists of the nodes with the same label, the labels being the vertices.
+    label_offsets_.assign(num_vertices + 1, 0);
+    std::vector<Index> label_index(num_simplices);
+    for (std::size_t i = 0; i < num_simplices; ++i) {
+      label_index[i] = static_cast<Index>(
+          std::lower_bound(labels_.begin(), labels_.begin() + num_vertices, labels_[i]) - labels_.begin());
+      ++label_offsets_[label_index[i] + 1];
+    }
+    for (std::size_t i = 0; i < num_vertices; ++i) label_offsets_[i + 1] += label_offsets_[i];
+    label_nodes_.resize(num_simplices);
+    std::vector<Index> position(label_offsets_.begin(), label_offsets_.end() - 1);
+    for (std::size_t i = 0; i < num_simplices; ++i) label_nodes_[position[label_index[i]]++] = static_cast<Index>(i);
+
+    // Same order as flat_serialize, i.e., as Simplex_tree::is_before_in_filtration, the multi-parameter filtration
+    // values being compared lexicographically.
+    filtration_order_.resize(num_simplices);
+    std::iota(filtration_order_.begin(), filtration_order_.end(), 0);
+    auto is_before_in_filtration = [&](Index a, Index b) {
+      if (num_parameters_ > 0) {
+        auto fa = values_.begin() + a * num_parameters_;
+        auto fb = values_.begin() + b * num_parameters_;
+        auto [ita, itb] = std::mismatch(fa, fa + num_parameters_, fb);
+        if (ita != fa + num_parameters_) return *ita < *itb;
+      }
+      while (a != null_simplex() && b != null_simplex()) {
+        if (labels_[a] != labels_[b]) return labels_[a] < labels_[b];
+        a = parents[a];
+        b = parents[b];
+      }
+      return a == null_simplex() && b != null_simplex();
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_sort(filtration_order_.begin(), filtration_order_.end(), is_before_in_filtration);
+#else
+    std::sort(filtration_order_.begin(), filtration_order_.end(), is_before_in_filtration);
+#endif
+  }
+
+  std::size_t num_simplices() const { return labels_.size(); }
+  std::size_t num_vertices() const { return label_offsets_.size() - 1; }
+  int dimension() const { return static_cast<int>(level_offsets_.size()) - 2; }
+  /** \brief Number of filtration values per simplex, 0 if the simplex tree did not store them. */
+  std::size_t num_parameters() const { return num_parameters_; }
+  static Simplex_handle null_simplex() { return std::numeric_limits<Simplex_handle>::max(); }
+
+  /** \brief Size in bytes of the arrays of the complex. */
+  std::size_t memory_size() const {
+    return labels_.size() * sizeof(Vertex_handle) + values_.size() * sizeof(Value) +
+           (child_offsets_.size() + level_offsets_.size() + label_offsets_.size() + label_nodes_.size() +
+            filtration_order_.size()) * sizeof(Index);
+  }
+
+  /** \brief Dimension of the simplex. */
+  int dimension(Simplex_handle sh) const {
+    return static_cast<int>(std::upper_bound(level_offsets_.begin(), level_offsets_.end(), sh) -
+                            level_offsets_.begin()) - 1;
+  }
+
+  /** \brief Parent of the simplex in the trie, i.e., the simplex without its largest vertex, `null_simplex()` for a
+   * vertex. */
+  Simplex_handle parent(Simplex_handle sh) const { return parent(sh, dimension(sh)); }
+
+  /** \brief Vertices of the simplex, in increasing order. */
+  std::vector<Vertex_handle> simplex_vertices(Simplex_handle sh) const {
+    std::vector<Vertex_handle> vertices(dimension(sh) + 1);
+    for (int dim = static_cast<int>(vertices.size()) - 1; dim >= 0; --dim) {
+      vertices[dim] = labels_[sh];
+      sh = parent(sh, dim);
+    }
+    return vertices;
+  }
+
+  /** \brief Pointer on the `num_parameters()` filtration values of the simplex. */
+  const Value* filtration_values(Simplex_handle sh) const { return values_.data() + sh * num_parameters_; }
+
+  /** \brief Filtration value of the simplex, or its coordinate `parameter` for multi-parameter filtrations.
+   * 0 if the filtration values were not stored. */
+  Value filtration(Simplex_handle sh, std::size_t parameter = 0) const {
+    if (parameter >= num_parameters_) return Value{};
+    return filtration_values(sh)[parameter];
+  }
+
+  /** \brief Returns the simplex with the given vertices, `null_simplex()` if it is not in the complex. */
+  template<class InputVertexRange = std::initializer_list<Vertex_handle>>
+  Simplex_handle find(const InputVertexRange& s) const {
+    std::vector<Vertex_handle> simplex(std::begin(s), std::end(s));
+    std::sort(simplex.begin(), simplex.end());
+    simplex.erase(std::unique(simplex.begin(), simplex.end()), simplex.end());
+    return find_sorted(simplex, simplex.size());
+  }
+
+  /** \brief Facets of the simplex, in the order of Simplex_tree::boundary_simplex_range(): the `i`-th facet is the
+   * simplex without its `i`-th largest vertex. Empty for a vertex. */
+  std::vector<Simplex_handle> boundary(Simplex_handle sh) const {
+    std::vector<Simplex_handle> facets;
+    const std::vector<Vertex_handle> simplex = simplex_vertices(sh);
+    if (simplex.size() < 2) return facets;
+    facets.reserve(simplex.size());
+    for (std::size_t i = simplex.size(); i-- > 0;) facets.push_back(find_sorted(simplex, i));
+    return facets;
+  }
+
+  /** \brief Cofaces of the simplex with codimension `codimension`, all its cofaces (including itself) if
+   * `codimension` is 0, as Simplex_tree::cofaces_simplex_range. Their order is not specified. */
+  std::vector<Simplex_handle> cofaces(Simplex_handle sh, int codimension) const {
+    std::vector<Simplex_handle> out;
+    if (sh == null_simplex()) return out;
+    const std::vector<Vertex_handle> simplex = simplex_vertices(sh);
+    // All the cofaces are below a node with the same label as sh containing its vertices.
+    const std::size_t index =
+        std::lower_bound(labels_.begin(), labels_.begin() + num_vertices(), labels_[sh]) - labels_.begin();
+    std::vector<std::pair<Simplex_handle, int>> stack;
+    for (Index k = label_offsets_[index]; k != label_offsets_[index + 1]; ++k) {
+      const Simplex_handle candidate = label_nodes_[k];
+      const int candidate_dim = dimension(candidate);
+      // Vertices of the candidate, decreasing from the node to the root, containing the ones of the simplex
+      auto v = simplex.rbegin();
+      Simplex_handle p = candidate;
+      for (int dim = candidate_dim; dim >= 0 && v != simplex.rend(); p = parent(p, dim--)) {
+        if (labels_[p] == *v) ++v;
+        else if (labels_[p] < *v) break;
+      }
+      if (v != simplex.rend()) continue;
+      stack.emplace_back(candidate, candidate_dim - static_cast<int>(simplex.size()) + 1);
+      while (!stack.empty()) {
+        auto [node, codim] = stack.back();
+        stack.pop_back();
+        if (codimension == 0 || codim == codimension) out.push_back(node);
+        if (codimension != 0 && codim >= codimension) continue;
+        for (Index c = child_offsets_[node]; c != child_offsets_[node + 1]; ++c) stack.emplace_back(c, codim + 1);
+      }
+    }
+    return out;
+  }
+
+  /** \brief Simplices in the order of `Simplex_tree::filtration_simplex_range()` when the complex was frozen. */
+  Filtration_simplex_range filtration_simplex_range() const {
+    return Filtration_simplex_range(filtration_order_.begin(), filtration_order_.end());
+  }
+
+ private:
+  // Parent of the node sh of dimension dim, searched among the nodes of dimension dim - 1
+  Simplex_handle parent(Simplex_handle sh, int dim) const {
+    if (dim == 0) return null_simplex();
+    auto first = child_offsets_.begin() + level_offsets_[dim - 1];
+    auto last = child_offsets_.begin() + level_offsets_[dim];
+    return static_cast<Simplex_handle>(std::upper_bound(first, last, sh) - child_offsets_.begin() - 1);
+  }
+
+  // Simplex with the sorted vertices of simplex but the one at position skip
+  Simplex_handle find_sorted(const std::vector<Vertex_handle>& simplex, std::size_t skip) const {
+    Simplex_handle sh = null_simplex();
+    Index first = 0, last = static_cast<Index>(num_vertices());
+    for (std::size_t i = 0; i < simplex.size(); ++i) {
+      if (i == skip) continue;
+      auto it = std::lower_bound(labels_.begin() + first, labels_.begin() + last, simplex[i]);
+      if (it == labels_.begin() + last || *it != simplex[i]) return null_simplex();
+      sh = static_cast<Simplex_handle>(it - labels_.begin());
+      first = child_offsets_[sh];
+      last = child_offsets_[sh + 1];
+    }
+    return sh;
+  }
+
+  std::vector<Vertex_handle> labels_;
+  std::vector<Index> child_offsets_;
+  std::vector<Index> level_offsets_;
+  std::vector<Value> values_;
+  std::size_t num_parameters_;
+  std::vector<Index> label_offsets_;
+  std::vector<Index> label_nodes_;
+  std::vector<Index> filtration_order_;
+};
+
+/** @} */  // end addtogroup simplex_tree
+
+namespace simplex_tree {
+
+/** \addtogroup simplex_tree
+ * @{
+ */
+
+/** \brief Returns a `Frozen_simplex_tree` copy of the simplex tree, for read-only workloads once the complex is built.
+ * The simplex tree can then be destroyed to release its memory.
+ */
+template<typename Index = std::uint32_t, class SimplexTree>
+auto freeze(SimplexTree& st) {
+  return Frozen_simplex_tree<typename SimplexTree::Vertex_handle, typename Flat_filtration_traits<SimplexTree>::Value,
+                             Index>(st);
+}
+
+/** @} */  // end addtogroup simplex_tree
+
+}  // namespace simplex_tree
+
+}  // namespace Gudhi
+
+#endif  // FROZEN_SIMPLEX_TREE_H_
@@ -10,6 +10,10 @@
  *      - 2023/05 Clément Maria: Edge insertion method for flag complexes
  *      - 2023/05 Hannah Schreiber: Factorization of expansion methods
  *      - 2023/08 Hannah Schreiber (& Clément Maria): Add possibility of stable simplex handles.
+ *      - 2023/10 David Loiseaux: Memory resource of the siblings pool, e.g. a mapped file.
+ *      - 2023/10 David Loiseaux: Cooperative cancellation of the expansion.
+ *      - 2023/10 David Loiseaux: Options with float filtration values.
+ *      - 2023/10 David Loiseaux: Constant time access to the root when the vertices are 0, 1, etc.
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -22,11 +26,15 @@
 #include <gudhi/Simplex_tree/Simplex_tree_star_simplex_iterators.h>
 #include <gudhi/Simplex_tree/indexing_tag.h>
 #include <gudhi/Simplex_tree/serialization_utils.h>  // for Gudhi::simplex_tree::de/serialize_trivial
+#include <gudhi/Simplex_tree/radix_sort.h>
 #include <gudhi/Simplex_tree/hooks_simplex_base.h>
 
 #include <gudhi/reader_utils.h>
 #include <gudhi/graph_simplicial_complex.h>
 #include <gudhi/Debug_utils.h>
+#include <gudhi/Cancellation.h>
+#include <gudhi/Simple_object_pool.h>
+#include <gudhi/Profiler_instrumentation.h>
 
 #include <boost/container/map.hpp>
 #include <boost/container/flat_map.hpp>
@@ -44,20 +52,32 @@
 
 #ifdef GUDHI_USE_TBB
 #include <tbb/parallel_sort.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <tbb/concurrent_vector.h>
 #endif
 
 #include <utility>  // for std::move
+#include <array>
+#include <tuple>
 #include <vector>
 #include <functional>  // for greater<>
 #include <stdexcept>
 #include <limits>  // Inf
+#include <random>  // for std::mt19937
 #include <initializer_list>
 #include <algorithm>  // for std::max
 #include <cstdint>  // for std::uint32_t
+#include <cstring>  // for std::memcpy
 #include <iterator>  // for std::distance
 #include <type_traits>  // for std::conditional
 #include <unordered_map>
+#include <atomic>  // for std::atomic
+#include <mutex>  // for std::mutex, std::lock_guard
 #include <iterator>  // for std::prev
+#include <memory>  // for std::unique_ptr
+#include <memory_resource>  // for std::pmr::unsynchronized_pool_resource
 
 namespace Gudhi {
 
@@ -79,6 +99,29 @@ namespace Gudhi {
  */
 enum class Extended_simplex_type {UP, DOWN, EXTRA};
 
+namespace simplex_tree {
+
+/** \brief True if the filtration values of a multi-parameter simplex tree are sets of incomparable grades (multi-critical
+ * filtrations), i.e., if `Filtration_value::is_multi_critical` is true. Such values must have an `insert_new` member,
+ * which adds the grades of another value, and a `push_to` member, which intersects the upsets of the grades. */
+template<class Filtration_value, class = void>
+struct is_multi_critical : std::false_type {};
+
+template<class Filtration_value>
+struct is_multi_critical<Filtration_value, std::void_t<decltype(Filtration_value::is_multi_critical)>>
+    : std::bool_constant<Filtration_value::is_multi_critical> {};
+
+/** \brief True if `SimplexTreeOptions::pool_siblings` is defined and true, in which case the `Siblings` and the buffers
+ * of their members are allocated in pools owned by the simplex tree. */
+template<class SimplexTreeOptions, class = void>
+struct pool_siblings : std::false_type {};
+
+template<class SimplexTreeOptions>
+struct pool_siblings<SimplexTreeOptions, std::void_t<decltype(SimplexTreeOptions::pool_siblings)>>
+    : std::bool_constant<SimplexTreeOptions::pool_siblings> {};
+
+}  // namespace simplex_tree
+
 struct Simplex_tree_options_full_featured;
 
 /**
@@ -90,6 +133,14 @@ struct Simplex_tree_options_full_featured;
  *
  * Details may be found in \cite boissonnatmariasimplextreealgorithmica.
  *
+ * \section simplextreethreadsafety Thread safety
+ * As long as no thread inserts or removes simplices, the functions that only read the structure, like `find()`,
+ * `filtration()`, `dimension(Simplex_handle)`, `simplex_vertex_range()`, `boundary_simplex_range()` or
+ * `for_each_simplex()`, can be called concurrently, and the data of distinct simplices (filtration value, key) can be
+ * modified concurrently. `filtration_simplex_range()` and `dimension()` may update a cache and must not be called
+ * concurrently with any other function. The tree can be split by smallest vertex with `vertex_subtree_range()` for
+ * parallel iterations, see `parallel_for_each_simplex()`.
+ *
  * \implements FilteredComplex
  *
  */
@@ -118,10 +169,21 @@ class Simplex_tree {
   // Note: this wastes space when Vertex_handle is 32 bits and Node is aligned on 64 bits. It would be better to use a
   // flat_set (with our own comparator) where we can control the layout of the struct (put Vertex_handle and
   // Simplex_key next to each other).
-  typedef typename boost::container::flat_map<Vertex_handle, Node> flat_map;
+  // With SimplexTreeOptions::pool_siblings, the buffers of the dictionaries are allocated in a pool of the simplex tree,
+  // released at once when the tree is cleared or destroyed.
+  static constexpr bool pool_siblings = simplex_tree::pool_siblings<Options>::value;
+  typedef typename std::conditional<
+      pool_siblings,
+      boost::container::flat_map<Vertex_handle, Node, std::less<Vertex_handle>,
+                                 std::pmr::polymorphic_allocator<std::pair<Vertex_handle, Node>>>,
+      boost::container::flat_map<Vertex_handle, Node>>::type flat_map;
   //Dictionary::iterator remain valid under insertions and deletions,
   //necessary e.g. when computing oscillating rips zigzag filtrations.
-  typedef typename boost::container::map<Vertex_handle, Node> map;
+  typedef typename std::conditional<
+      pool_siblings,
+      boost::container::map<Vertex_handle, Node, std::less<Vertex_handle>,
+                            std::pmr::polymorphic_allocator<std::pair<const Vertex_handle, Node>>>,
+      boost::container::map<Vertex_handle, Node>>::type map;
   typedef typename std::conditional<Options::stable_simplex_handles,
                                     map,
                                     flat_map>::type Dictionary;
@@ -181,6 +243,7 @@ class Simplex_tree {
 
  private:
   typedef typename Dictionary::iterator Dictionary_it;
+  typedef typename Dictionary::const_iterator Dictionary_const_it;
   typedef typename Dictionary_it::value_type Dit_value_t;
 
   struct return_first {
@@ -413,6 +476,20 @@ class Simplex_tree {
     copy_from(complex_source);
   }
 
+  /** \brief Copy constructor from a simplex tree with other options, e.g. to turn a 1-parameter simplex tree into a
+   * multi-parameter one. The filtration value of each simplex is `translate_filtration_value(f)`, where `f` is its
+   * filtration value in `complex_source`.
+   *
+   * The tree structure is copied node by node, as with the copy constructor, without searching the simplices as
+   * `insert_simplex` would. The filtration values are then translated in a second pass, in parallel over the subtrees
+   * of the vertices if TBB is available, so `translate_filtration_value` may be called concurrently.
+   */
+  template<typename OtherSimplexTreeOptions, typename F>
+  Simplex_tree(const Simplex_tree<OtherSimplexTreeOptions>& complex_source, F&& translate_filtration_value)
+      : Simplex_tree() {
+    copy_from(complex_source, translate_filtration_value);
+  }
+
   /** \brief User-defined move constructor relocates the whole tree structure.
    *  \exception std::invalid_argument In debug mode, if the complex_source is invalid.
    */
@@ -471,6 +548,8 @@ class Simplex_tree {
     null_vertex_ = complex_source.null_vertex_;
     filtration_vect_.clear();
     dimension_ = complex_source.dimension_;
+    number_of_parameters_ = complex_source.number_of_parameters_;
+    find_index_.enabled = complex_source.find_index_.enabled;
     auto root_source = complex_source.root_;
 
     // root members copy
@@ -488,7 +567,7 @@ class Simplex_tree {
          sh != sib->members().end(); ++sh, ++sh_source) {
       update_simplex_tree_after_node_insertion(sh);
       if (has_children(sh_source)) {
-        Siblings * newsib = new Siblings(sib, sh_source->first);
+        Siblings * newsib = new_siblings(sib, sh_source->first);
         if constexpr (!Options::stable_simplex_handles) {
           newsib->members_.reserve(sh_source->second.children()->members().size());
         }
@@ -500,15 +579,88 @@ class Simplex_tree {
     }
   }
 
+  // Copy from complex_source, with other options, to "this"
+  template<typename OtherSimplexTreeOptions, typename F>
+  void copy_from(const Simplex_tree<OtherSimplexTreeOptions>& complex_source, F& translate_filtration_value) {
+    null_vertex_ = static_cast<Vertex_handle>(complex_source.null_vertex_);
+    filtration_vect_.clear();
+    dimension_ = complex_source.dimension_;
+    number_of_parameters_ = complex_source.number_of_parameters_;
+    // The source is only read, so that its filtration values are not copied
+    const auto& root_source = complex_source.root_;
+
+    if constexpr (!Options::stable_simplex_handles) {
+      root_.members().reserve(root_source.members().size());
+    }
+    for (auto& map_el : root_source.members())
+      root_.members().emplace_hint(root_.members().end(), static_cast<Vertex_handle>(map_el.first), Node(&root_));
+    rec_copy_structure(&root_, &root_source);
+
+    std::vector<std::pair<Dictionary_it, decltype(root_source.members().begin())>> roots;
+    roots.reserve(root_.members().size());
+    auto sh_source = root_source.members().begin();
+    for (auto sh = root_.members().begin(); sh != root_.members().end(); ++sh, ++sh_source)
+      roots.emplace_back(sh, sh_source);
+    auto translate_subtree = [&](std::size_t i) {
+      auto [sh, sh_source] = roots[i];
+      sh->second.assign_filtration(translate_filtration_value(sh_source->second.filtration()));
+      if (has_children(sh_source))
+        rec_translate_filtration(sh->second.children(), sh_source->second.children(), translate_filtration_value);
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), roots.size(), translate_subtree);
+#else
+    for (std::size_t i = 0; i < roots.size(); ++i) translate_subtree(i);
+#endif
+  }
+
+  /** \brief Same as rec_copy for a source with other options, with default filtration values. */
+  template<class OtherSiblings>
+  void rec_copy_structure(Siblings *sib, OtherSiblings *sib_source) {
+    auto sh_source = sib_source->members().begin();
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh, ++sh_source) {
+      update_simplex_tree_after_node_insertion(sh);
+      if (has_children(sh_source)) {
+        Siblings * newsib = new_siblings(sib, static_cast<Vertex_handle>(sh_source->first));
+        if constexpr (!Options::stable_simplex_handles) {
+          newsib->members_.reserve(sh_source->second.children()->members().size());
+        }
+        for (auto & child : sh_source->second.children()->members())
+          newsib->members_.emplace_hint(newsib->members_.end(), static_cast<Vertex_handle>(child.first), Node(newsib));
+        rec_copy_structure(newsib, sh_source->second.children());
+        sh->second.assign_children(newsib);
+      }
+    }
+  }
+
+  /** \brief Assigns the translated filtration values of a subtree of a source with the same structure. */
+  template<class OtherSiblings, typename F>
+  void rec_translate_filtration(Siblings *sib, OtherSiblings *sib_source, F& translate_filtration_value) {
+    auto sh_source = sib_source->members().begin();
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh, ++sh_source) {
+      sh->second.assign_filtration(translate_filtration_value(sh_source->second.filtration()));
+      if (has_children(sh_source))
+        rec_translate_filtration(sh->second.children(), sh_source->second.children(), translate_filtration_value);
+    }
+  }
+
   // Move from complex_source to "this"
   void move_from(Simplex_tree& complex_source) {
     null_vertex_ = std::move(complex_source.null_vertex_);
     root_ = std::move(complex_source.root_);
     filtration_vect_ = std::move(complex_source.filtration_vect_);
     dimension_ = complex_source.dimension_;
+    number_of_parameters_ = complex_source.number_of_parameters_;
+    // The index of the source is dropped, the one of this tree is built by the next find()
+    find_index_.enabled = complex_source.find_index_.enabled;
+    complex_source.clear_find_index();
     if constexpr (Options::link_nodes_by_label) {
       nodes_label_to_list_.swap(complex_source.nodes_label_to_list_);
     }
+    if constexpr (pool_siblings) {
+      // The siblings stay in the pools where they were allocated
+      siblings_pool_.swap(complex_source.siblings_pool_);
+    }
     // Need to update root members (children->oncles and children need to point on the new root pointer)
     for (auto& map_el : root_.members()) {
       if (map_el.second.children() != &(complex_source.root_)) {
@@ -526,12 +678,22 @@ class Simplex_tree {
 
   // delete all root_.members() recursively
   void root_members_recursive_deletion() {
+    clear_find_index();
+    if constexpr (pool_siblings) {
+      if (std::is_trivially_destructible<Node>::value) {
+        // No need to visit the tree, the siblings and their members only own memory of the pools.
+        root_.members().clear();
+        siblings_pool_->release();
+        return;
+      }
+    }
     for (auto sh = root_.members().begin(); sh != root_.members().end(); ++sh) {
       if (has_children(sh)) {
         rec_delete(sh->second.children());
       }
     }
     root_.members().clear();
+    if constexpr (pool_siblings) siblings_pool_->release();
   }
 
   // Recursive deletion
@@ -541,7 +703,26 @@ class Simplex_tree {
         rec_delete(sh->second.children());
       }
     }
-    delete sib;
+    delete_siblings(sib);
+  }
+
+  // Allocates new Siblings, in the pools if Options::pool_siblings.
+  template<typename... Args>
+  Siblings* new_siblings(Args&&... args) {
+    if constexpr (pool_siblings) {
+      return siblings_pool_->siblings.construct(std::forward<Args>(args)...,
+                                                typename Siblings::Dictionary_allocator(&siblings_pool_->members));
+    } else {
+      return new Siblings(std::forward<Args>(args)...);
+    }
+  }
+
+  void delete_siblings(Siblings* sib) {
+    if constexpr (pool_siblings) {
+      siblings_pool_->siblings.destroy(sib);
+    } else {
+      delete sib;
+    }
   }
 
  public:
@@ -726,6 +907,128 @@ class Simplex_tree {
     return res;
   }
 
+  /** \brief Memory footprint of a simplex tree, in bytes, broken down by part. See `memory_usage()`. */
+  struct Memory_usage {
+    /** \brief Buffers of the members of the `Siblings`, i.e. the nodes, with their unused capacity. */
+    std::size_t nodes = 0;
+    /** \brief `Siblings` objects, i.e. sets of children. */
+    std::size_t siblings = 0;
+    /** \brief Heap memory owned by the filtration values, e.g. the coordinates of multi-parameter filtrations. */
+    std::size_t filtration_values = 0;
+    /** \brief Lists of the nodes by label, if `SimplexTreeOptions::link_nodes_by_label`. */
+    std::size_t label_lists = 0;
+    /** \brief Simplices sorted by filtration, cf. `initialize_filtration()`. */
+    std::size_t filtration_cache = 0;
+    /** \brief Hash table of `enable_find_index()`. */
+    std::size_t find_index = 0;
+
+    std::size_t total() const {
+      return nodes + siblings + filtration_values + label_lists + filtration_cache + find_index;
+    }
+  };
+
+ private:
+  // Approximate size of a node of a node-based container, on top of its value.
+  static constexpr std::size_t tree_node_overhead = 3 * sizeof(void*);
+  static constexpr std::size_t hash_node_overhead = 2 * sizeof(void*);
+
+  template <class Unordered_map>
+  static std::size_t hash_table_memory(const Unordered_map& table) {
+    return table.bucket_count() * sizeof(void*) +
+           table.size() * (sizeof(typename Unordered_map::value_type) + hash_node_overhead);
+  }
+
+  template <class F, class = void>
+  struct has_heap_storage : std::false_type {};
+  template <class F>
+  struct has_heap_storage<F, std::void_t<decltype(std::declval<const F&>().capacity()), typename F::value_type>>
+      : std::true_type {};
+
+  void memory_usage(Siblings* sib, Memory_usage& usage) {
+    usage.siblings += sizeof(Siblings);
+    if constexpr (Options::stable_simplex_handles) {
+      usage.nodes += sib->members().size() * (sizeof(Dit_value_t) + tree_node_overhead);
+    } else {
+      usage.nodes += sib->members().capacity() * sizeof(Dit_value_t);
+    }
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
+      usage.filtration_values += filtration_heap_memory(sh);
+      if (has_children(sh)) memory_usage(sh->second.children(), usage);
+    }
+  }
+
+  // Heap memory owned by the filtration value of a node.
+  std::size_t filtration_heap_memory(Simplex_handle sh) const {
+    if constexpr (Options::store_filtration && has_heap_storage<Filtration_value>::value) {
+      return sh->second.filtration().capacity() * sizeof(typename Filtration_value::value_type);
+    } else {
+      return 0;
+    }
+  }
+
+  // Memory of a node in its Siblings, without unused capacity, and of its filtration value.
+  std::size_t node_memory(Simplex_handle sh) const {
+    if constexpr (Options::stable_simplex_handles) {
+      return sizeof(Dit_value_t) + tree_node_overhead + filtration_heap_memory(sh);
+    } else {
+      return sizeof(Dit_value_t) + filtration_heap_memory(sh);
+    }
+  }
+
+ public:
+  /** \brief Returns the memory used by the simplex tree, in bytes, broken down by part.
+   *
+   * The sizes of the buffers are exact, those of the node-based containers (`SimplexTreeOptions::stable_simplex_handles`,
+   * label lists, `enable_find_index()`) are estimated from typical implementations. The root `Siblings`, which is a
+   * member of the simplex tree, is counted in `Memory_usage::siblings`. This function takes time linear in the number of
+   * simplices. */
+  Memory_usage memory_usage() {
+    Memory_usage usage;
+    memory_usage(&root_, usage);
+    if constexpr (Options::link_nodes_by_label) usage.label_lists = hash_table_memory(nodes_label_to_list_);
+    usage.filtration_cache = filtration_vect_.capacity() * sizeof(Simplex_handle);
+    usage.find_index = hash_table_memory(find_index_.table);
+    return usage;
+  }
+
+  /** \brief Estimates the memory used by a simplex tree with `num_simplices_by_dimension[d]` simplices of dimension
+   * `d`, e.g. to predict the memory needed by an `expansion()` from the size of the result on a smaller sample.
+   *
+   * @param[in] num_simplices_by_dimension Number of simplices of each dimension, as `num_simplices_by_dimension()`.
+   * @param[in] filtration_value_heap_size Heap memory owned by each filtration value, in bytes, e.g. the number of
+   * parameters times the size of a coordinate for multi-parameter filtrations.
+   *
+   * The estimate assumes that the buffers have no unused capacity, as after an `expansion()` or an `insert_batch()`, and
+   * includes the `filtration_cache` filled by `initialize_filtration()` (hence by the persistence computation). Each
+   * simplex of dimension `d` has at most one `Siblings` of children, and there are at most as many of them as simplices
+   * of dimension `d+1`, which bounds `Memory_usage::siblings`. */
+  static Memory_usage estimate_memory_usage(const std::vector<std::size_t>& num_simplices_by_dimension,
+                                            std::size_t filtration_value_heap_size = 0) {
+    Memory_usage usage;
+    std::size_t num_simplices = 0;
+    std::size_t num_siblings = 1;
+    for (std::size_t d = 0; d < num_simplices_by_dimension.size(); ++d) {
+      num_simplices += num_simplices_by_dimension[d];
+      if (d + 1 < num_simplices_by_dimension.size())
+        num_siblings += std::min(num_simplices_by_dimension[d], num_simplices_by_dimension[d + 1]);
+    }
+    if constexpr (Options::stable_simplex_handles) {
+      usage.nodes = num_simplices * (sizeof(Dit_value_t) + tree_node_overhead);
+    } else {
+      usage.nodes = num_simplices * sizeof(Dit_value_t);
+    }
+    usage.siblings = num_siblings * sizeof(Siblings);
+    if constexpr (Options::store_filtration) usage.filtration_values = num_simplices * filtration_value_heap_size;
+    if constexpr (Options::link_nodes_by_label) {
+      if (!num_simplices_by_dimension.empty())
+        usage.label_lists = num_simplices_by_dimension[0] *
+                            (sizeof(typename decltype(nodes_label_to_list_)::value_type) + hash_node_overhead +
+                             sizeof(void*));
+    }
+    usage.filtration_cache = num_simplices * sizeof(Simplex_handle);
+    return usage;
+  }
+
   /** \brief Returns the dimension of a simplex.
    *
    * Must be different from null_simplex().*/
@@ -786,27 +1089,149 @@ class Simplex_tree {
     // Copy before sorting
     std::vector<Vertex_handle> copy(first, last);
     std::sort(std::begin(copy), std::end(copy));
+    if constexpr (std::is_integral_v<Vertex_handle>) {
+      if (find_index_.enabled) {
+        Simplex_handle sh;
+        if (find_in_index(copy, sh)) return sh;
+      }
+    }
     return find_simplex(copy);
   }
 
+  /** \brief Makes find() use a hash table from the vertices of the simplices to their Simplex_handle, instead of
+   * descending the tree with a binary search per vertex.
+   *
+   * The vertices of a simplex are packed into a 128-bit key, so that only the simplices of at most
+   * \f$2 \lfloor 64 / b \rfloor\f$ vertices are in the table, where \f$b\f$ is the number of bits of the largest
+   * vertex plus one, and only when the vertices are nonnegative integers. The larger simplices are searched in the
+   * tree.
+   *
+   * The table is built at the first call to find() after each insertion or removal of simplices, in
+   * \f$O(n)\f$ time and memory for \f$n\f$ simplices, and is meant for read-only phases with many calls to find().
+   * Concurrent calls to find() remain safe. */
+  void enable_find_index(bool enable = true) {
+    find_index_.enabled = enable;
+    clear_find_index();
+  }
+
  private:
+  // Key of a simplex in the find index, made of its sorted vertices plus one, vertex_bits bits each, in two words
+  struct Packed_simplex {
+    std::uint64_t words[2] = {0, 0};
+    bool operator==(const Packed_simplex& other) const {
+      return words[0] == other.words[0] && words[1] == other.words[1];
+    }
+  };
+  struct Packed_simplex_hash {
+    std::size_t operator()(const Packed_simplex& key) const {
+      std::uint64_t h = key.words[0] * 0x9E3779B97F4A7C15ULL ^ key.words[1];
+      h ^= h >> 31;
+      h *= 0xBF58476D1CE4E5B9ULL;
+      return static_cast<std::size_t>(h ^ (h >> 29));
+    }
+  };
+  struct Find_index {
+    bool enabled = false;
+    std::atomic<bool> built = false;
+    std::mutex mutex;
+    int vertex_bits = 0;  // 0 if the vertices cannot be packed
+    std::size_t vertices_per_word = 0;
+    std::unordered_map<Packed_simplex, Simplex_handle, Packed_simplex_hash> table;
+  };
+
+  // Sets key to the packed vertices of simplex, or returns false if they do not all fit
+  bool pack_simplex(const std::vector<Vertex_handle>& simplex, Packed_simplex& key) const {
+    const int bits = find_index_.vertex_bits;
+    if (simplex.size() > 2 * find_index_.vertices_per_word) return false;
+    for (std::size_t i = 0; i < simplex.size(); ++i) {
+      std::uint64_t v = static_cast<std::uint64_t>(simplex[i]) + 1;
+      key.words[i / find_index_.vertices_per_word] |= v << (bits * (i % find_index_.vertices_per_word));
+    }
+    return true;
+  }
+
+  // Returns true if the index decides whether the sorted simplex is in the complex, and its handle in sh
+  bool find_in_index(const std::vector<Vertex_handle>& simplex, Simplex_handle& sh) {
+    if (!find_index_.built.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(find_index_.mutex);
+      if (!find_index_.built.load(std::memory_order_relaxed)) {
+        build_find_index();
+        find_index_.built.store(true, std::memory_order_release);
+      }
+    }
+    if (find_index_.vertex_bits == 0 || simplex.size() > 2 * find_index_.vertices_per_word) return false;
+    sh = null_simplex();
+    // The vertices of the complex are all between 0 and the largest one
+    const std::uint64_t max_vertex = (std::uint64_t(1) << find_index_.vertex_bits) - 2;
+    if (is_negative(simplex.front()) || static_cast<std::uint64_t>(simplex.back()) > max_vertex) return true;
+    Packed_simplex key;
+    pack_simplex(simplex, key);
+    auto it = find_index_.table.find(key);
+    if (it != find_index_.table.end()) sh = it->second;
+    return true;
+  }
+
+  void build_find_index() {
+    find_index_.table.clear();
+    find_index_.vertex_bits = 0;
+    if (root_.members().empty() || is_negative(root_.members().begin()->first)) return;
+    const std::uint64_t max_vertex = static_cast<std::uint64_t>(std::prev(root_.members().end())->first);
+    int bits = 1;
+    while (bits < 63 && (max_vertex + 1) >> bits) ++bits;
+    if (bits > 32) return;
+    find_index_.vertex_bits = bits;
+    find_index_.vertices_per_word = 64 / bits;
+    find_index_.table.reserve(num_simplices());
+    std::vector<Vertex_handle> vertices;
+    auto rec_index = [&](auto&& self, Siblings* sib) -> void {
+      for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
+        vertices.push_back(sh->first);
+        Packed_simplex key;
+        if (!pack_simplex(vertices, key)) {
+          vertices.pop_back();
+          return;
+        }
+        find_index_.table.emplace(key, sh);
+        if (has_children(sh)) self(self, sh->second.children());
+        vertices.pop_back();
+      }
+    };
+    rec_index(rec_index, &root_);
+  }
+
+  static bool is_negative(Vertex_handle v) {
+    if constexpr (std::is_signed_v<Vertex_handle>) return v < 0;
+    else return false;
+  }
+
+  // Must be called when simplices are inserted or removed
+  void clear_find_index() {
+    if (find_index_.built.load(std::memory_order_relaxed)) {
+      find_index_.table = decltype(find_index_.table)();
+      find_index_.built.store(false, std::memory_order_relaxed);
+    }
+  }
+
   /** Find function, with a sorted range of vertices. */
   Simplex_handle find_simplex(const std::vector<Vertex_handle> & simplex) {
     Siblings * tmp_sib = &root_;
     Dictionary_it tmp_dit;
     auto vi = simplex.begin();
-    if constexpr (Options::contiguous_vertices && !Options::stable_simplex_handles) {
-      // Equivalent to the first iteration of the normal loop
-      GUDHI_CHECK(contiguous_vertices(), "non-contiguous vertices");
-      Vertex_handle v = *vi++;
-      if(v < 0 || v >= static_cast<Vertex_handle>(root_.members_.size()))
-        return null_simplex();
-      tmp_dit = root_.members_.begin() + v;
-      if (vi == simplex.end())
-        return tmp_dit;
-      if (!has_children(tmp_dit))
-        return null_simplex();
-      tmp_sib = tmp_dit->second.children();
+    if constexpr (!Options::stable_simplex_handles) {
+      // Equivalent to the first iteration of the normal loop. The vertices of the complexes built from point clouds
+      // are 0, 1, etc., even without the option, and the root is then indexed like an array.
+      GUDHI_CHECK(!Options::contiguous_vertices || contiguous_vertices(), "non-contiguous vertices");
+      if (Options::contiguous_vertices || contiguous_vertices()) {
+        Vertex_handle v = *vi++;
+        if (is_negative(v) || v >= static_cast<Vertex_handle>(root_.members_.size()))
+          return null_simplex();
+        tmp_dit = root_.members_.begin() + v;
+        if (vi == simplex.end())
+          return tmp_dit;
+        if (!has_children(tmp_dit))
+          return null_simplex();
+        tmp_sib = tmp_dit->second.children();
+      }
     }
     for (;;) {
       tmp_dit = tmp_sib->members_.find(*vi++);
@@ -827,10 +1252,28 @@ class Simplex_tree {
       assert(contiguous_vertices());
       return root_.members_.begin() + v;
     } else {
+      if constexpr (!Options::stable_simplex_handles) {
+        if (contiguous_vertices()) {
+          if (is_negative(v) || v >= static_cast<Vertex_handle>(root_.members_.size()))
+            return root_.members_.end();
+          return root_.members_.begin() + v;
+        }
+      }
       return root_.members_.find(v);
     }
   }
 
+  /** \brief Inserts a node in `sib`, or returns the existing one. A vertex already in a root with contiguous
+   * vertices is found in constant time. */
+  std::pair<Dictionary_it, bool> emplace_node(Siblings* sib, Vertex_handle v, const Filtration_value& filtration) {
+    if constexpr (!Options::stable_simplex_handles) {
+      if (sib == &root_ && !is_negative(v) && v < static_cast<Vertex_handle>(root_.members_.size()) &&
+          contiguous_vertices())
+        return {root_.members_.begin() + v, false};
+    }
+    return sib->members_.emplace(v, Node(sib, filtration));
+  }
+
  public:
   /** \private \brief Test if the vertices have contiguous numbering: 0, 1, etc.  */
   bool contiguous_vertices() const {
@@ -863,21 +1306,27 @@ class Simplex_tree {
     auto vi = simplex.begin();
     for (; vi != std::prev(simplex.end()); ++vi) {
       GUDHI_CHECK(*vi != null_vertex(), "cannot use the dummy null_vertex() as a real vertex");
-      res_insert = curr_sib->members_.emplace(*vi, Node(curr_sib, filtration));
+      res_insert = emplace_node(curr_sib, *vi, filtration);
       if (res_insert.second) {
         // Only required when insertion is successful
         update_simplex_tree_after_node_insertion(res_insert.first);
       }
       if (!(has_children(res_insert.first))) {
-        res_insert.first->second.assign_children(new Siblings(curr_sib, *vi));
+        res_insert.first->second.assign_children(new_siblings(curr_sib, *vi));
       }
       curr_sib = res_insert.first->second.children();
     }
     GUDHI_CHECK(*vi != null_vertex(), "cannot use the dummy null_vertex() as a real vertex");
-    res_insert = curr_sib->members_.emplace(*vi, Node(curr_sib, filtration));
+    res_insert = emplace_node(curr_sib, *vi, filtration);
     if (!res_insert.second) {
       // if already in the complex
-      if (res_insert.first->second.filtration() > filtration) {
+      if constexpr (simplex_tree::is_multi_critical<Filtration_value>::value) {
+        if (!(res_insert.first->second.filtration() <= filtration)) {
+          // the simplex also appears at the grades of filtration
+          filtration_mutable(res_insert.first).insert_new(filtration);
+          return res_insert;
+        }
+      } else if (res_insert.first->second.filtration() > filtration) {
         // if filtration value modified
         res_insert.first->second.assign_filtration(filtration);
         return res_insert;
@@ -909,7 +1358,8 @@ class Simplex_tree {
    * fails and the simplex already in the complex has a filtration value strictly bigger than 'filtration',
    * we assign this simplex with the new value 'filtration', and set the Simplex_handle field of the
    * output pair to the Simplex_handle of the simplex. Otherwise, we set the Simplex_handle part to
-   * null_simplex.
+   * null_simplex. For multi-critical filtrations (cf. simplex_tree::is_multi_critical), the grades of 'filtration'
+   * are added to the existing ones instead, unless they are all above them.
    *
    * All subsimplices do not necessary need to be already in the simplex tree to proceed to an
    * insertion. However, the property of being a simplicial complex will be violated. This allows
@@ -960,8 +1410,7 @@ class Simplex_tree {
       return { null_simplex(), true }; // FIXME: false would make more sense to me.
 
     thread_local std::vector<Vertex_handle> copy;
-    copy.clear();
-    copy.insert(copy.end(), first, last);
+    copy.assign(first, last);
     std::sort(copy.begin(), copy.end());
     auto last_unique = std::unique(copy.begin(), copy.end());
     copy.erase(last_unique, copy.end());
@@ -987,8 +1436,7 @@ class Simplex_tree {
     // - insert all the vertices at once in sib
     // - loop over those (new or not) simplices, with a recursive call(++first, last)
     Vertex_handle vertex_one = *first;
-    auto&& dict = sib->members();
-    auto insertion_result = dict.emplace(vertex_one, Node(sib, filt));
+    auto insertion_result = emplace_node(sib, vertex_one, filt);
     // update extra data structures in the insertion is successful
     if (insertion_result.second) {
       // Only required when insertion is successful
@@ -999,19 +1447,7 @@ class Simplex_tree {
     bool one_is_new = insertion_result.second;
     if (!one_is_new) {
       if (!(filtration(simplex_one) <= filt)) { 
-        if constexpr (SimplexTreeOptions::is_multi_parameter){
-          // By default, does nothing and assumes that the user is smart.
-          if (filt < filtration(simplex_one)){
-            // placeholder for comparable filtrations
-          }
-          else{
-            // placeholder for incomparable filtrations
-          }
-        }
-        else{ // non-multiparameter
-          assign_filtration(simplex_one, filt);
-        }
-        
+        reinsert_filtration(simplex_one, filt);
       } else {
         // FIXME: this interface makes no sense, and it doesn't seem to be tested.
         insertion_result.first = null_simplex();
@@ -1020,13 +1456,139 @@ class Simplex_tree {
     if (++first == last) return insertion_result;
     if (!has_children(simplex_one))
       // TODO: have special code here, we know we are building the whole subtree from scratch.
-      simplex_one->second.assign_children(new Siblings(sib, vertex_one));
+      simplex_one->second.assign_children(new_siblings(sib, vertex_one));
     auto res = rec_insert_simplex_and_subfaces_sorted(simplex_one->second.children(), first, last, filt);
     // No need to continue if the full simplex was already there with a low enough filtration value.
     if (res.first != null_simplex()) rec_insert_simplex_and_subfaces_sorted(sib, first, last, filt);
     return res;
   }
 
+  // Inserts again the simplex sh, already there, with the filtration value filt, which is not above its value.
+  void reinsert_filtration(Simplex_handle sh, const Filtration_value& filt) {
+    if constexpr (simplex_tree::is_multi_critical<Filtration_value>::value){
+      // The simplex also appears at the grades of filt.
+      filtration_mutable(sh).insert_new(filt);
+    }
+    else if constexpr (SimplexTreeOptions::is_multi_parameter){
+      // By default, does nothing and assumes that the user is smart.
+      if (filt < filtration(sh)){
+        // placeholder for comparable filtrations
+      }
+      else{
+        // placeholder for incomparable filtrations
+      }
+    }
+    else{ // non-multiparameter
+      assign_filtration(sh, filt);
+    }
+  }
+
+ public:
+  /** \brief Inserts a batch of N-simplices and all their subfaces. The result is the same as inserting the simplices
+   * one by one, in order, with `insert_simplex_and_subfaces`.
+   *
+   * The faces of all the simplices are sorted lexicographically once, so that the tree is then filled in depth-first
+   * order: new nodes are appended at the end of their siblings, and the path to the current face is kept, instead of
+   * being searched again from the root for each face. This is much faster than successive insertions on large batches.
+   *
+   * @param[in] simplices Range of simplices, each one being a range of `Vertex_handle`.
+   * @param[in] filtration Callable such that `filtration(i)` is the filtration value of the i-th simplex.
+   * \exception std::invalid_argument If a simplex has more than 63 vertices.
+   */
+  template<class SimplexRange, class FiltrationFunction>
+  void insert_batch(const SimplexRange& simplices, FiltrationFunction&& filtration) {
+    GUDHI_PROFILE_SCOPE("Simplex_tree::insert_batch");
+    // Sorted vertices of the simplices, one after the other.
+    std::vector<Vertex_handle> vertices;
+    std::vector<std::size_t> offsets(1, 0);
+    for (const auto& simplex : simplices) {
+      const auto begin = vertices.size();
+      vertices.insert(vertices.end(), std::begin(simplex), std::end(simplex));
+      std::sort(vertices.begin() + begin, vertices.end());
+      vertices.erase(std::unique(vertices.begin() + begin, vertices.end()), vertices.end());
+      if (vertices.size() - begin >= 64)
+        throw std::invalid_argument("Simplex_tree::insert_batch - simplices cannot have more than 63 vertices");
+      offsets.push_back(vertices.size());
+    }
+    // A face is a subset of the vertices of a simplex, the bit j of the mask standing for its j-th vertex
+    struct Face {
+      std::size_t simplex;
+      std::uint64_t mask;
+    };
+    std::vector<Face> faces;
+    std::size_t num_faces = 0;
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+      num_faces += (std::uint64_t(1) << (offsets[i + 1] - offsets[i])) - 1;
+    faces.reserve(num_faces);
+    for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+      for (std::uint64_t mask = 1; mask < (std::uint64_t(1) << (offsets[i + 1] - offsets[i])); ++mask)
+        faces.push_back({i, mask});
+    // Lexicographic order of the faces, the copies of a face being in the order of their simplices.
+    auto is_before = [&vertices, &offsets](const Face& a, const Face& b) {
+      const Vertex_handle* va = vertices.data() + offsets[a.simplex];
+      const Vertex_handle* vb = vertices.data() + offsets[b.simplex];
+      std::uint64_t ma = a.mask, mb = b.mask;
+      while (ma != 0 && mb != 0) {
+        for (; !(ma & 1); ma >>= 1) ++va;
+        for (; !(mb & 1); mb >>= 1) ++vb;
+        if (*va != *vb) return *va < *vb;
+        ma >>= 1; ++va;
+        mb >>= 1; ++vb;
+      }
+      if (ma != mb) return ma == 0;  // a is a prefix of b
+      return a.simplex < b.simplex;
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_sort(faces.begin(), faces.end(), is_before);
+#else
+    std::sort(faces.begin(), faces.end(), is_before);
+#endif
+    // path[j] is the node of the j+1 first vertices of the current face. As the faces are sorted, the prefixes of a
+    // face have just been visited, and no insertion in their siblings invalidated these handles.
+    std::vector<Simplex_handle> path;
+    [[maybe_unused]] std::size_t num_inserted = 0;
+    for (const Face& face : faces) {
+      const Vertex_handle* v = vertices.data() + offsets[face.simplex];
+      int dim = -1;
+      Vertex_handle last_vertex = null_vertex_;
+      for (std::uint64_t mask = face.mask; mask != 0; mask >>= 1, ++v) {
+        if (mask & 1) {
+          ++dim;
+          last_vertex = *v;
+        }
+      }
+      path.resize(dim);
+      Siblings* sib = root();
+      if (dim > 0) {
+        Simplex_handle parent = path.back();
+        if (!has_children(parent)) parent->second.assign_children(new_siblings(self_siblings(parent), parent->first));
+        sib = parent->second.children();
+      }
+      auto&& dict = sib->members();
+      Simplex_handle sh;
+      if (dict.empty() || std::prev(dict.end())->first < last_vertex) {
+        sh = dict.emplace_hint(dict.end(), last_vertex, Node(sib, filtration(face.simplex)));
+        update_simplex_tree_after_node_insertion(sh);
+        ++num_inserted;
+      } else {
+        sh = dict.find(last_vertex);
+        if (sh == dict.end()) {
+          sh = dict.emplace(last_vertex, Node(sib, filtration(face.simplex))).first;
+          update_simplex_tree_after_node_insertion(sh);
+          ++num_inserted;
+        } else if constexpr (!SimplexTreeOptions::is_multi_parameter ||
+                             simplex_tree::is_multi_critical<Filtration_value>::value) {
+          // 1-critical multi-parameter values of simplices already there are kept as they are
+          const Filtration_value& filt = filtration(face.simplex);
+          if (!(filtration_(sh) <= filt)) reinsert_filtration(sh, filt);
+        }
+      }
+      path.push_back(sh);
+      dimension_ = (std::max)(dimension_, dim);
+    }
+    GUDHI_PROFILE_COUNT("Simplex_tree simplices inserted", num_inserted);
+  }
+
  public:
   /** \brief Assign a value 'key' to the key of the simplex
    * represented by the Simplex_handle 'sh'. */
@@ -1077,6 +1639,7 @@ class Simplex_tree {
    * Any insertion, deletion or change of filtration value invalidates this cache,
    * which can be cleared with clear_filtration().  */
   void initialize_filtration(bool ignore_infinite_values = false) {
+    GUDHI_PROFILE_SCOPE("Simplex_tree::initialize_filtration");
     filtration_vect_.clear();
     filtration_vect_.reserve(num_simplices());
     for (Simplex_handle sh : complex_simplex_range()) {
@@ -1085,7 +1648,132 @@ class Simplex_tree {
           filtration(sh) == std::numeric_limits<Filtration_value>::infinity()) continue;
       filtration_vect_.push_back(sh);
     }
+    sort_filtration();
+  }
+  /** \brief Initializes the filtration cache with only the simplices of dimension at most `max_dimension` and of
+   * filtration value at most `max_filtration`, sorted according to their order in the filtration.
+   *
+   * The other simplices are neither collected nor sorted, so that a computation that stops at `max_filtration`, like
+   * `Gudhi::persistent_cohomology::Persistent_cohomology::compute_persistent_cohomology(min_interval_length,
+   * max_filtration, max_dimension - 1)`, does not pay for the whole complex. Until the cache is cleared,
+   * `filtration_simplex_range()` only contains these simplices. */
+  void initialize_filtration(Filtration_value max_filtration, int max_dimension) {
+    GUDHI_PROFILE_SCOPE("Simplex_tree::initialize_filtration");
+    filtration_vect_.clear();
+    for (Simplex_handle sh : skeleton_simplex_range(max_dimension)) {
+      if (filtration(sh) <= max_filtration) filtration_vect_.push_back(sh);
+    }
+    sort_filtration();
+  }
+  /** \brief Sorts again the filtration cache after some filtration values changed, without collecting the simplices
+   * again.
+   *
+   * It gives the same order as initialize_filtration(), but it is only valid if no simplex was inserted or removed
+   * since the cache was initialized. It does nothing if the cache is not initialized.
+   *
+   * The previous order is first repaired by insertion, which is linear when the values only changed slightly, as
+   * between 2 steps of an optimization. After a bounded number of moves, the simplices are sorted from scratch. */
+  void update_filtration_order() {
+    const std::size_t n = filtration_vect_.size();
+    std::size_t budget = 16 * n;
+    is_before_in_filtration is_before(this);
+    for (std::size_t i = 1; i < n; ++i) {
+      Simplex_handle sh = filtration_vect_[i];
+      std::size_t j = i;
+      for (; j > 0 && is_before(sh, filtration_vect_[j - 1]); --j) {
+        filtration_vect_[j] = filtration_vect_[j - 1];
+        if (--budget == 0) {
+          filtration_vect_[j - 1] = sh;
+          sort_filtration();
+          return;
+        }
+      }
+      filtration_vect_[j] = sh;
+    }
+  }
+  /** \brief Initializes the filtration cache if it isn't initialized yet.
+   *
+   * Automatically called by filtration_simplex_range(). */
+  void maybe_initialize_filtration() {
+    if (filtration_vect_.empty()) {
+      initialize_filtration();
+    }
+  }
+  /** \brief Clears the filtration cache produced by initialize_filtration().
+   *
+   * Useful when initialize_filtration() has already been called and we perform an operation
+   * (say an insertion) that invalidates the cache. */
+  void clear_filtration() {
+    filtration_vect_.clear();
+  }
+
+  /** \brief Returns the number of nonzero entries of the boundary matrix written by fill_boundary_matrix(), i.e. the
+   * sum of the numbers of facets of the simplices of positive dimension in filtration_simplex_range(). */
+  std::size_t num_boundary_entries() {
+    std::size_t count = 0;
+    for (Simplex_handle sh : filtration_simplex_range()) {
+      int dim = dimension(sh);
+      if (dim > 0) count += dim + 1;
+    }
+    return count;
+  }
+
+  /** \brief Writes the boundary matrix of the complex in compressed sparse column format, with the simplices in the
+   * order of filtration_simplex_range().
+   *
+   * Column `i` represents the `i`-th simplex of the filtration: its dimension is written in `dimensions[i]`, its
+   * filtration value in `filtrations[i]`, and the indices in the filtration of its facets are written in increasing
+   * order in `row_indices[column_offsets[i]]`, ..., `row_indices[column_offsets[i+1]-1]`. The columns are filled in
+   * parallel if TBB is available.
+   *
+   * As a side effect, the key of each simplex is set to its index in the filtration.
+   *
+   * @param[out] column_offsets Random access iterator to `n+1` values, where `n` is the size of
+   * filtration_simplex_range(). `column_offsets[0]` is 0 and `column_offsets[n]` is num_boundary_entries().
+   * @param[out] row_indices Random access iterator to num_boundary_entries() values.
+   * @param[out] dimensions Random access iterator to `n` values.
+   * @param[out] filtrations Random access iterator to `n` values, to which the filtration values are assigned.
+   */
+  template <class Offset_iterator, class Index_iterator, class Dimension_iterator, class Filtration_iterator>
+  void fill_boundary_matrix(Offset_iterator column_offsets, Index_iterator row_indices, Dimension_iterator dimensions,
+                            Filtration_iterator filtrations) {
+    static_assert(Options::store_key, "fill_boundary_matrix needs the simplices to store a key.");
+    auto const& simplices = filtration_simplex_range();
+    const std::size_t n = simplices.size();
+    auto for_each_column = [n](const auto& f) {
+#ifdef GUDHI_USE_TBB
+      tbb::parallel_for(std::size_t(0), n, f);
+#else
+      for (std::size_t i = 0; i < n; ++i) f(i);
+#endif
+    };
+    for_each_column([&](std::size_t i) {
+      assign_key(simplices[i], static_cast<Simplex_key>(i));
+      dimensions[i] = dimension(simplices[i]);
+      filtrations[i] = filtration(simplices[i]);
+    });
+    column_offsets[0] = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      int dim = dimensions[i];
+      column_offsets[i + 1] = column_offsets[i] + (dim > 0 ? dim + 1 : 0);
+    }
+    // The keys of all the simplices must be assigned before the facets are looked up.
+    for_each_column([&](std::size_t i) {
+      if (dimensions[i] == 0) return;
+      auto begin = row_indices + column_offsets[i];
+      auto end = begin;
+      for (Simplex_handle facet : boundary_simplex_range(simplices[i])) *end++ = key(facet);
+      std::sort(begin, end);
+    });
+  }
 
+ private:
+  /** \brief Sorts filtration_vect_ with is_before_in_filtration. */
+  void sort_filtration() {
+    if constexpr (std::is_arithmetic_v<Filtration_value> && std::is_integral_v<Vertex_handle>) {
+      sort_filtration_by_keys();
+      return;
+    }
     /* We use stable_sort here because with libstdc++ it is faster than sort.
      * is_before_in_filtration is now a total order, but we used to call
      * stable_sort for the following heuristic:
@@ -1101,23 +1789,55 @@ class Simplex_tree {
     std::stable_sort(filtration_vect_.begin(), filtration_vect_.end(), is_before_in_filtration(this));
 #endif
   }
-  /** \brief Initializes the filtration cache if it isn't initialized yet.
+
+  /** \brief Same order as is_before_in_filtration, for numerical filtration values, without comparison sort on the
+   * filtration values.
    *
-   * Automatically called by filtration_simplex_range(). */
-  void maybe_initialize_filtration() {
-    if (filtration_vect_.empty()) {
-      initialize_filtration();
+   * The simplices are radix sorted by their filtration value, and then by their last vertex, which is the first
+   * criterion of the reverse lexicographic order, both encoded as order preserving integers. Only the simplices with
+   * the same filtration value and the same last vertex are then compared with reverse_lexicographic_order. */
+  void sort_filtration_by_keys() {
+    struct Entry {
+      std::uint64_t primary;  // filtration value
+      std::uint64_t secondary;  // last vertex
+      Simplex_handle sh;
+    };
+    const std::size_t n = filtration_vect_.size();
+    std::vector<Entry> entries(n);
+    auto fill = [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        Simplex_handle sh = filtration_vect_[i];
+        entries[i] = Entry{Gudhi::simplex_tree::radix_sort_key(sh->second.filtration()),
+                           Gudhi::simplex_tree::radix_sort_key(sh->first), sh};
+      }
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n),
+                      [&](const tbb::blocked_range<std::size_t>& range) { fill(range.begin(), range.end()); });
+#else
+    fill(0, n);
+#endif
+    Gudhi::simplex_tree::radix_sort(entries);
+    for (std::size_t i = 0; i < n; ++i) filtration_vect_[i] = entries[i].sh;
+
+    // Ties
+    std::vector<std::pair<std::size_t, std::size_t>> ties;
+    for (std::size_t begin = 0, end = 1; begin < n; begin = end++) {
+      while (end < n && entries[end].primary == entries[begin].primary &&
+             entries[end].secondary == entries[begin].secondary) ++end;
+      if (end - begin > 1) ties.emplace_back(begin, end);
     }
-  }
-  /** \brief Clears the filtration cache produced by initialize_filtration().
-   *
-   * Useful when initialize_filtration() has already been called and we perform an operation
-   * (say an insertion) that invalidates the cache. */
-  void clear_filtration() {
-    filtration_vect_.clear();
+    auto sort_ties = [&](std::size_t tie) {
+      std::sort(filtration_vect_.begin() + ties[tie].first, filtration_vect_.begin() + ties[tie].second,
+                [this](Simplex_handle sh1, Simplex_handle sh2) { return reverse_lexicographic_order(sh1, sh2); });
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), ties.size(), sort_ties);
+#else
+    for (std::size_t tie = 0; tie < ties.size(); ++tie) sort_ties(tie);
+#endif
   }
 
- private:
   /** Recursive search of cofaces
    * This function uses DFS
    *\param vertices contains a list of vertices, which represent the vertices of the simplex not found yet.
@@ -1222,6 +1942,86 @@ class Simplex_tree {
     }
   }
 
+  /** \brief Computes the cofaces of several simplices at once, in compressed sparse row format.
+   *
+   * The cofaces of `simplices[i]` of codimension `codimension`, or its star if `codimension` is 0, i.e. the simplices
+   * of cofaces_simplex_range(simplices[i], codimension), are written in `cofaces[offsets[i]]`, ...,
+   * `cofaces[offsets[i+1]-1]`, in an unspecified order. The queries are answered in parallel if TBB is available.
+   *
+   * When all the simplices are vertices and there are many of them, as when computing local features around every
+   * vertex, the queries share a single traversal of the complex, where each simplex is appended to the lists of its
+   * queried vertices, instead of walking the tree once per vertex.
+   *
+   * @param[in] simplices Random access range of Simplex_handle.
+   * @param[in] codimension Codimension of the cofaces, 0 for the whole star.
+   * @param[out] offsets Resized to `simplices.size()+1`, with `offsets[0]` equal to 0.
+   * @param[out] cofaces Resized to `offsets.back()`.
+   */
+  template <class SimplexHandleRange>
+  void cofaces_simplex_ranges(const SimplexHandleRange& simplices, int codimension, std::vector<std::size_t>& offsets,
+                              std::vector<Simplex_handle>& cofaces) {
+    assert(codimension >= 0);
+    const std::size_t n = std::size(simplices);
+    auto for_each_query = [n](const auto& f) {
+#ifdef GUDHI_USE_TBB
+      tbb::parallel_for(std::size_t(0), n, f);
+#else
+      for (std::size_t i = 0; i < n; ++i) f(i);
+#endif
+    };
+    offsets.assign(n + 1, 0);
+    bool only_vertices = std::all_of(std::begin(simplices), std::end(simplices),
+                                     [this](Simplex_handle sh) { return dimension(sh) == 0; });
+    if (n > 0 && only_vertices && 4 * n >= num_vertices()) {
+      // Several queries may ask for the same vertex, they are answered once.
+      std::unordered_map<Vertex_handle, std::size_t> vertex_slots;
+      std::vector<std::size_t> query_slots(n);
+      for (std::size_t i = 0; i < n; ++i)
+        query_slots[i] = vertex_slots.try_emplace(std::begin(simplices)[i]->first, vertex_slots.size()).first->second;
+      const std::size_t num_slots = vertex_slots.size();
+      std::unique_ptr<std::atomic<std::size_t>[]> slot_sizes(new std::atomic<std::size_t>[num_slots]);
+      for (std::size_t s = 0; s < num_slots; ++s) slot_sizes[s] = 0;
+      // Calls fun(slot) for each queried vertex of each coface, and prunes the subtrees that are too deep.
+      auto for_each_coface_slot = [&](const auto& fun) {
+        parallel_for_each_simplex([&](Simplex_handle sh, int dim) {
+          if (codimension == 0 || dim == codimension) {
+            for (Vertex_handle v : simplex_vertex_range(sh)) {
+              auto it = vertex_slots.find(v);
+              if (it != vertex_slots.end()) fun(it->second, sh);
+            }
+          }
+          return codimension != 0 && dim >= codimension;
+        });
+      };
+      for_each_coface_slot([&](std::size_t slot, Simplex_handle) { ++slot_sizes[slot]; });
+      std::vector<std::size_t> slot_offsets(num_slots + 1, 0);
+      for (std::size_t s = 0; s < num_slots; ++s) {
+        slot_offsets[s + 1] = slot_offsets[s] + slot_sizes[s];
+        slot_sizes[s] = slot_offsets[s];
+      }
+      std::vector<Simplex_handle> slot_cofaces(slot_offsets[num_slots]);
+      for_each_coface_slot([&](std::size_t slot, Simplex_handle sh) { slot_cofaces[slot_sizes[slot]++] = sh; });
+      for (std::size_t i = 0; i < n; ++i)
+        offsets[i + 1] = offsets[i] + slot_offsets[query_slots[i] + 1] - slot_offsets[query_slots[i]];
+      cofaces.resize(offsets[n]);
+      for_each_query([&](std::size_t i) {
+        std::copy(slot_cofaces.begin() + slot_offsets[query_slots[i]],
+                  slot_cofaces.begin() + slot_offsets[query_slots[i] + 1], cofaces.begin() + offsets[i]);
+      });
+    } else {
+      std::vector<std::vector<Simplex_handle>> query_cofaces(n);
+      for_each_query([&](std::size_t i) {
+        auto&& range = cofaces_simplex_range(std::begin(simplices)[i], codimension);
+        query_cofaces[i].assign(range.begin(), range.end());
+      });
+      for (std::size_t i = 0; i < n; ++i) offsets[i + 1] = offsets[i] + query_cofaces[i].size();
+      cofaces.resize(offsets[n]);
+      for_each_query([&](std::size_t i) {
+        std::copy(query_cofaces[i].begin(), query_cofaces[i].end(), cofaces.begin() + offsets[i]);
+      });
+    }
+  }
+
  private:
   /** \brief Returns true iff the list of vertices of sh1
    * is smaller than the list of vertices of sh2 w.r.t.
@@ -1339,7 +2139,7 @@ class Simplex_tree {
       if (v < u) std::swap(u, v);
       auto sh = find_vertex(u);
       if (!has_children(sh)) {
-        sh->second.assign_children(new Siblings(&root_, sh->first));
+        sh->second.assign_children(new_siblings(&root_, sh->first));
       }
 
       auto insertion_res = sh->second.children()->members().emplace(
@@ -1348,18 +2148,148 @@ class Simplex_tree {
     }
   }
 
-  /** \brief Inserts several vertices.
-   * @param[in] vertices A range of Vertex_handle
-   * @param[in] filt filtration value of the new vertices (the same for all)
+  /** \brief Inserts all vertices and edges of a proximity graph in compressed sparse row format.
    *
-   * This may be faster than inserting the vertices one by one, especially in a random order.
-   * The complex does not need to be empty before calling this function. However, if a vertex is
+   * The sorted neighbor arrays of the graph become the children of the vertices as they are, without searching nor
+   * sorting, which is faster and uses less memory than going through a generic OneSkeletonGraph.
+   *
+   * The simplex tree must be empty. */
+  template<typename GraphVertexHandle, typename GraphFiltrationValue>
+  void insert_graph(const Csr_proximity_graph<GraphVertexHandle, GraphFiltrationValue>& graph) {
+    insert_sorted_graph(
+        graph.num_vertices(), [](std::size_t u) { return static_cast<Vertex_handle>(u); },
+        [&](std::size_t u) { return graph.vertex_filtrations[u]; }, graph.offsets,
+        [&](std::size_t e) { return static_cast<Vertex_handle>(graph.neighbors[e]); },
+        [&](std::size_t e) { return graph.edge_filtrations[e]; });
+  }
+
+  /** \brief Inserts a batch of edges and their vertices. The result is the same as inserting the edges one by one,
+   * in any order, with `insert_simplex_and_subfaces`: the value of a repeated edge is the smallest one, and the value
+   * of a vertex is the smallest one of its edges. An edge \f$(u, u)\f$ is the vertex \f$u\f$.
+   *
+   * The edges are sorted once (in parallel with TBB) and deduplicated. If the simplex tree is empty, the vertices and
+   * the children of each vertex are then built directly in order, as in `insert_graph()`, without any search, else
+   * they are inserted with `insert_batch()`.
+   *
+   * @param[in] edges The edges \f$(u, v, filtration)\f$, in any order.
+   */
+  void insert_edges(std::vector<std::tuple<Vertex_handle, Vertex_handle, Filtration_value>> edges) {
+    GUDHI_PROFILE_SCOPE("Simplex_tree::insert_edges");
+    for (auto& [u, v, filt] : edges)
+      if (v < u) std::swap(u, v);
+    // Lexicographic order, so that the first copy of an edge has the smallest value
+    auto is_before = [](const auto& a, const auto& b) {
+      if (std::get<0>(a) != std::get<0>(b)) return std::get<0>(a) < std::get<0>(b);
+      if (std::get<1>(a) != std::get<1>(b)) return std::get<1>(a) < std::get<1>(b);
+      return std::get<2>(a) < std::get<2>(b);
+    };
+    auto same_edge = [](const auto& a, const auto& b) {
+      return std::get<0>(a) == std::get<0>(b) && std::get<1>(a) == std::get<1>(b);
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_sort(edges.begin(), edges.end(), is_before);
+#else
+    std::sort(edges.begin(), edges.end(), is_before);
+#endif
+    edges.erase(std::unique(edges.begin(), edges.end(), same_edge), edges.end());
+
+    if (num_vertices() != 0) {
+      insert_batch(edges | boost::adaptors::transformed([](const auto& edge) {
+                     return std::array<Vertex_handle, 2>{std::get<0>(edge), std::get<1>(edge)};
+                   }),
+                   [&edges](std::size_t e) { return std::get<2>(edges[e]); });
+      return;
+    }
+
+    // Smallest value of each vertex, among its edges
+    std::vector<std::pair<Vertex_handle, Filtration_value>> vertices;
+    vertices.reserve(2 * edges.size());
+    for (const auto& [u, v, filt] : edges) {
+      vertices.emplace_back(u, filt);
+      if (v != u) vertices.emplace_back(v, filt);
+    }
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_sort(vertices.begin(), vertices.end());
+#else
+    std::sort(vertices.begin(), vertices.end());
+#endif
+    vertices.erase(std::unique(vertices.begin(), vertices.end(),
+                               [](const auto& a, const auto& b) { return a.first == b.first; }),
+                   vertices.end());
+
+    // The edges of the vertex i are from offsets[i] to offsets[i+1] in the edges without the loops, which are sorted
+    edges.erase(std::remove_if(edges.begin(), edges.end(),
+                               [](const auto& edge) { return std::get<0>(edge) == std::get<1>(edge); }),
+                edges.end());
+    std::vector<std::size_t> offsets(vertices.size() + 1, 0);
+    for (std::size_t i = 0, e = 0; i < vertices.size(); ++i) {
+      while (e < edges.size() && std::get<0>(edges[e]) == vertices[i].first) ++e;
+      offsets[i + 1] = e;
+    }
+    insert_sorted_graph(
+        vertices.size(), [&](std::size_t i) { return vertices[i].first; },
+        [&](std::size_t i) { return vertices[i].second; }, offsets,
+        [&](std::size_t e) { return std::get<1>(edges[e]); }, [&](std::size_t e) { return std::get<2>(edges[e]); });
+  }
+
+ private:
+  /* Fills the empty tree with n vertices and their edges, in compressed sparse row format: the i-th vertex has the
+   * label vertex(i), increasing with i, and the value vertex_filtration(i), and its children are the edges
+   * offsets[i] <= e < offsets[i+1], of increasing labels neighbor(e), larger than vertex(i), and of values
+   * edge_filtration(e). The nodes are built in order with boost::container::ordered_unique_range, without any search
+   * nor sort. */
+  template<class VertexLabel, class VertexFiltration, class Offsets, class Neighbor, class EdgeFiltration>
+  void insert_sorted_graph(std::size_t n, VertexLabel&& vertex, VertexFiltration&& vertex_filtration,
+                           const Offsets& offsets, Neighbor&& neighbor, EdgeFiltration&& edge_filtration) {
+    // the simplex tree must be empty
+    assert(num_simplices() == 0);
+
+    if (n == 0) {
+      return;
+    }
+    dimension_ = offsets[n] == offsets[0] ? 0 : 1;
+
+    std::vector<std::pair<Vertex_handle, Node>> members;
+    members.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+      members.emplace_back(vertex(i), Node(&root_, vertex_filtration(i)));
+    root_.members() = Dictionary(boost::container::ordered_unique_range, members.begin(), members.end());
+
+    for (Dictionary_it sh = root_.members_.begin(); sh != root_.members_.end(); ++sh) {
+      update_simplex_tree_after_node_insertion(sh);
+    }
+    std::size_t i = 0;
+    for (Dictionary_it sh = root_.members_.begin(); sh != root_.members_.end(); ++sh, ++i) {
+      if (offsets[i] == offsets[i + 1]) continue;
+      members.clear();
+      for (std::size_t e = offsets[i]; e < offsets[i + 1]; ++e) {
+        GUDHI_CHECK(neighbor(e) > sh->first,
+                    std::invalid_argument("Simplex_tree::insert_graph - neighbors must be larger than the vertex"));
+        members.emplace_back(neighbor(e), Node(nullptr, edge_filtration(e)));
+      }
+      // Siblings constructor with boost::container::ordered_unique_range
+      Siblings* sib = new_siblings(&root_, sh->first, members);
+      sh->second.assign_children(sib);
+      for (Dictionary_it child = sib->members().begin(); child != sib->members().end(); ++child) {
+        update_simplex_tree_after_node_insertion(child);
+      }
+    }
+  }
+
+ public:
+  /** \brief Inserts several vertices.
+   * @param[in] vertices A range of Vertex_handle
+   * @param[in] filt filtration value of the new vertices (the same for all)
+   *
+   * This may be faster than inserting the vertices one by one, especially in a random order.
+   * The complex does not need to be empty before calling this function. However, if a vertex is
    * already present, its filtration value is not modified, unlike with other insertion functions. */
   template <class VertexRange>
   void insert_batch_vertices(VertexRange const& vertices, const Filtration_value& filt ={}) {
     auto verts = vertices | boost::adaptors::transformed([&](auto v){
         return Dit_value_t(v, Node(&root_, filt)); });
     root_.members_.insert(boost::begin(verts), boost::end(verts));
+    clear_find_index();
     if (dimension_ < 0 && !root_.members_.empty()) dimension_ = 0;
     if constexpr (Options::link_nodes_by_label) {
       for (auto sh = root_.members().begin(); sh != root_.members().end(); sh++) {
@@ -1377,23 +2307,282 @@ class Simplex_tree {
    * attached to a graph \f$G\f$ is the maximal simplicial complex of
    * dimension at most \f$d\f$ admitting the graph \f$G\f$ as \f$1\f$-skeleton.
    * The filtration value assigned to a simplex is the maximal filtration
-   * value of one of its edges.
+   * value of one of its edges. For 1-critical multi-parameter filtration values, it is the coordinate-wise maximum of
+   * the values of its edges, so that the filtration is non-decreasing if the one of the graph is.
    *
    * The Simplex_tree must contain no simplex of dimension bigger than
-   * 1 when calling the method. */
+   * 1 when calling the method.
+   *
+   * With TBB, the subtrees of the vertices, which do not share any Siblings, are expanded in parallel. The resulting
+   * tree, including the order of the lists of nodes with the same label, is the same as with the sequential
+   * expansion.
+   *
+   * The expansion checks the `Cancellation_flag` of the `Cancellation_scope` of the calling thread, if any, before
+   * expanding each vertex. If it is raised, the simplices of dimension at least 2 are removed, so that the
+   * Simplex_tree contains again its one skeleton, and `Cancelled` is thrown. */
   void expansion(int max_dim) {
+    expansion_impl(max_dim, static_cast<No_blocker*>(nullptr));
+  }
+
+  /** \brief Expands a simplex tree containing only a graph, like `expansion_with_blockers`, for a blocker that is
+   * monotone: if `block_simplex` returns true for a simplex, it returns true for all its cofaces.
+   *
+   * @param[in] max_dim Expansion maximal dimension value.
+   * @param[in] block_simplex Blocker oracle. Its concept is <CODE>bool block_simplex(Simplex_handle sh)</CODE>
+   *
+   * The simplices are the cliques of the graph, up to dimension `max_dim`, for which `block_simplex` returns false,
+   * with the maximal filtration value of their edges, as with `expansion_with_blockers`. Blocked simplices are
+   * removed before being expanded, and with TBB the subtrees of the vertices are expanded in parallel as with
+   * `expansion`, so `block_simplex` may be called concurrently and must only examine the simplex it is given: its
+   * vertices and its filtration value.
+   */
+  template< typename Blocker >
+  void expansion_with_monotone_blockers(int max_dim, Blocker block_simplex) {
+    expansion_impl(max_dim, &block_simplex);
+  }
+
+  /** \brief Limits on the size of the complex for `expansion_with_budget()`. */
+  struct Expansion_budget {
+    /** \brief Maximal number of simplices of the complex. */
+    std::size_t max_num_simplices = std::numeric_limits<std::size_t>::max();
+    /** \brief Maximal memory used by the complex, in bytes, as reported by `Memory_usage::total()`. */
+    std::size_t max_memory = std::numeric_limits<std::size_t>::max();
+  };
+
+  /** \brief Expands a simplex tree containing only a graph, like `expansion(max_dim)`, unless the complex exceeds the
+   * budget, in which case the expansion stops.
+   *
+   * @param[in] max_dim Expansion maximal dimension value.
+   * @param[in] budget Maximal number of simplices and memory of the complex.
+   * @return Whether the expansion is complete, i.e. whether the budget was respected.
+   *
+   * The subtrees of the vertices are expanded one after the other, from the greatest vertex. When a subtree exceeds
+   * the budget, its simplices of dimension at least 2 are removed and the expansion stops, so that the complex
+   * contains the graph and the cliques, of dimension at most `max_dim`, whose vertices are all greater than some
+   * vertex. It is a simplicial complex, and the complex is never larger than the budget. The memory is counted as the
+   * expansion proceeds, without the unused capacity of the buffers, so that it is a bit lower than the one reported
+   * by `memory_usage()` afterwards.
+   *
+   * The expansion is sequential. `estimate_expansion_size()` helps choosing the budget or `max_dim` beforehand.
+   */
+  bool expansion_with_budget(int max_dim, const Expansion_budget& budget) {
+    if (max_dim <= 1) return true;
+    GUDHI_PROFILE_SCOPE("Simplex_tree::expansion_with_budget");
+    clear_filtration(); // Drop the cache.
+    std::size_t num_simplices = this->num_simplices();
+    std::size_t memory = memory_usage().total();
+    if (num_simplices > budget.max_num_simplices || memory > budget.max_memory) return false;
+    bool exceeded = false;
+    // Monotone blocker, which blocks all the simplices once the budget is exceeded
+    auto block_simplex = [&](Simplex_handle sh) {
+      if (exceeded) return true;
+      ++num_simplices;
+      memory += node_memory(sh);
+      // The first member of a new Siblings also pays for it
+      if (sh == self_siblings(sh)->members().begin()) memory += sizeof(Siblings);
+      exceeded = num_simplices > budget.max_num_simplices || memory > budget.max_memory;
+      return exceeded;
+    };
+    dimension_ = max_dim;
+    // The simplices of the subtrees of the vertices greater than a vertex are closed under taking faces.
+    for (Dictionary_it root_it = root_.members_.end(); root_it != root_.members_.begin();) {
+      --root_it;
+      if (!has_children(root_it)) continue;
+      Siblings* edges = root_it->second.children();
+      siblings_expansion(edges, max_dim - 1, nullptr, &block_simplex);
+      if (exceeded) {
+        for (Dictionary_it edge = edges->members().begin(); edge != edges->members().end(); ++edge) {
+          if (has_children(edge)) {
+            rec_delete(edge->second.children());
+            edge->second.assign_children(edges);
+          }
+        }
+        dimension_ = max_dim - dimension_;
+        dimension_to_be_lowered_ = true;
+        return false;
+      }
+    }
+    dimension_ = max_dim - dimension_;
+    return true;
+  }
+
+ private:
+  // Vertices of the sorted candidates that are in the members of a Siblings, appended to out if not null, and their
+  // number.
+  static std::size_t common_neighbours(const std::vector<Vertex_handle>& candidates, const Dictionary& neighbours,
+                                       std::vector<Vertex_handle>* out) {
+    std::size_t count = 0;
+    auto it = neighbours.begin();
+    for (Vertex_handle w : candidates) {
+      while (it != neighbours.end() && it->first < w) ++it;
+      if (it == neighbours.end()) break;
+      if (it->first == w) {
+        ++count;
+        if (out != nullptr) out->push_back(w);
+      }
+    }
+    return count;
+  }
+
+ public:
+  /** \brief Estimates the number of simplices of each dimension, up to `max_dim`, of the expansion of the graph of
+   * the simplex tree, see `expansion()`, without building it.
+   *
+   * @param[in] max_dim Expansion maximal dimension value.
+   * @param[in] num_samples Number of random samples.
+   * @param[in] seed Seed of the random number generator.
+   * @return The estimated number of simplices of dimension `d`, for `0 <= d <= max_dim`.
+   *
+   * The numbers of vertices and edges are exact. The cliques are counted with Knuth's estimator of the size of a
+   * search tree, whose nodes are the cliques and the children of a clique are its extensions by a common neighbour
+   * greater than its vertices. Each sample goes down a random path of the tree and counts exactly the grandchildren of
+   * the cliques on its path, the children being picked in proportion to their numbers of children, so that the
+   * estimate is unbiased. A sample takes time about `max_dim` times the square of the degree of the vertices, and the
+   * relative error decreases as the inverse of the square root of `num_samples`, times a factor which depends on how
+   * unevenly the cliques are spread in the graph.
+   *
+   * The simplices of dimension at least 2 of the simplex tree, if any, are ignored.
+   */
+  std::vector<double> estimate_expansion_size(int max_dim, std::size_t num_samples = 1000,
+                                              unsigned int seed = std::random_device()()) {
+    std::vector<double> sizes(std::max(max_dim + 1, 0), 0.);
+    if (max_dim < 0 || is_empty()) return sizes;
+    sizes[0] = static_cast<double>(root_.members_.size());
+    if (max_dim == 0) return sizes;
+    // Edges {v, w}, v < w, are picked uniformly by picking v with a probability proportional to its number of
+    // neighbours greater than it
+    std::vector<Dictionary_it> vertices;
+    std::vector<double> upper_degrees;
+    for (Dictionary_it v = root_.members_.begin(); v != root_.members_.end(); ++v) {
+      if (!has_children(v)) continue;
+      vertices.push_back(v);
+      upper_degrees.push_back(static_cast<double>(v->second.children()->members().size()));
+      sizes[1] += upper_degrees.back();
+    }
+    if (max_dim == 1 || vertices.empty() || num_samples == 0) return sizes;
+    std::mt19937 gen(seed);
+    std::discrete_distribution<std::size_t> pick_vertex(upper_degrees.begin(), upper_degrees.end());
+    std::vector<Vertex_handle> candidates, next_candidates;
+    std::vector<double> num_next_candidates;
+    for (std::size_t sample = 0; sample < num_samples; ++sample) {
+      // The current clique is extended by any candidate, and the weight is the inverse of its probability
+      std::size_t first = pick_vertex(gen);
+      candidates.clear();
+      for (auto& w : vertices[first]->second.children()->members()) candidates.push_back(w.first);
+      double weight = sizes[1] / upper_degrees[first];
+      for (int d = 1; d < max_dim; ++d) {
+        // Number of candidates left after each candidate is added to the clique
+        num_next_candidates.clear();
+        double total = 0;
+        for (Vertex_handle u : candidates) {
+          Simplex_handle u_sh = find_vertex(u);
+          num_next_candidates.push_back(has_children(u_sh) ? static_cast<double>(common_neighbours(
+              candidates, u_sh->second.children()->members(), nullptr)) : 0.);
+          total += num_next_candidates.back();
+        }
+        // Exact count of the cliques of dimension d+1 containing the current clique, as vertices smaller than theirs
+        sizes[d + 1] += weight * total;
+        if (total == 0) break;
+        // The deeper cliques are sampled, picking the candidates in proportion to their numbers of extensions
+        std::size_t next = std::discrete_distribution<std::size_t>(num_next_candidates.begin(),
+                                                                   num_next_candidates.end())(gen);
+        weight *= total / num_next_candidates[next];
+        Simplex_handle u_sh = find_vertex(candidates[next]);
+        next_candidates.clear();
+        common_neighbours(candidates, u_sh->second.children()->members(), &next_candidates);
+        candidates.swap(next_candidates);
+      }
+    }
+    for (int d = 2; d <= max_dim; ++d) sizes[d] /= static_cast<double>(num_samples);
+    return sizes;
+  }
+
+ private:
+  // Blocker of expansion, which does not block anything.
+  struct No_blocker {
+    bool operator()(Simplex_handle) const { return false; }
+  };
+
+  template< typename Blocker >
+  void expansion_impl(int max_dim, Blocker* block_simplex) {
     if (max_dim <= 1) return;
+    GUDHI_PROFILE_SCOPE("Simplex_tree::expansion");
     clear_filtration(); // Drop the cache.
+    // The parallel expansion does not call update_simplex_tree_after_node_insertion
+    clear_find_index();
+    const Cancellation_flag* cancellation = current_cancellation_flag();
+    try {
+      expand_roots(max_dim, block_simplex, cancellation);
+    } catch (const Cancelled&) {
+      // Back to the one skeleton, which was expanded
+      for (Dictionary_it root_it = root_.members_.begin(); root_it != root_.members_.end(); ++root_it) {
+        if (!has_children(root_it)) continue;
+        Siblings* edges = root_it->second.children();
+        for (Dictionary_it edge = edges->members().begin(); edge != edges->members().end(); ++edge) {
+          if (has_children(edge)) {
+            rec_delete(edge->second.children());
+            edge->second.assign_children(edges);
+          }
+        }
+      }
+      dimension_ = 1;
+      dimension_to_be_lowered_ = true;
+      throw;
+    }
+  }
+
+  template <typename Blocker>
+  void expand_roots(int max_dim, Blocker* block_simplex, const Cancellation_flag* cancellation) {
+#ifdef GUDHI_USE_TBB
+    // The pools of SimplexTreeOptions::pool_siblings are not thread safe, the expansion is then sequential.
+    if constexpr (!pool_siblings) {
+      // Each range of vertices has its own bookkeeping, merged afterwards in the order of the vertices.
+      std::vector<Dictionary_it> roots;
+      roots.reserve(root_.members_.size());
+      for (Dictionary_it root_it = root_.members_.begin(); root_it != root_.members_.end(); ++root_it)
+        roots.push_back(root_it);
+      tbb::concurrent_vector<std::pair<std::size_t, std::unique_ptr<Expansion_bookkeeping>>> bookkeepings;
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, roots.size()),
+                        [&](const tbb::blocked_range<std::size_t>& range) {
+        auto bookkeeping = std::make_unique<Expansion_bookkeeping>(max_dim);
+        for (std::size_t i = range.begin(); i != range.end(); ++i) {
+          check_cancellation(cancellation);
+          Dictionary_it root_it = roots[i];
+          if (has_children(root_it)) {
+            siblings_expansion(root_it->second.children(), max_dim - 1, bookkeeping.get(), block_simplex);
+          }
+        }
+        bookkeepings.emplace_back(range.begin(), std::move(bookkeeping));
+      });
+      std::sort(bookkeepings.begin(), bookkeepings.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+      dimension_ = max_dim;
+      for (auto& [begin, bookkeeping] : bookkeepings) {
+        dimension_ = (std::min)(dimension_, bookkeeping->dimension);
+        if constexpr (Options::link_nodes_by_label) {
+          for (auto& [label, nodes] : bookkeeping->nodes_label_to_list) {
+            auto& list = nodes_label_to_list_[label];
+            list.splice(list.end(), nodes);
+          }
+        }
+      }
+      dimension_ = max_dim - dimension_;
+      return;
+    }
+#endif
     dimension_ = max_dim;
     for (Dictionary_it root_it = root_.members_.begin();
          root_it != root_.members_.end(); ++root_it) {
+      check_cancellation(cancellation);
       if (has_children(root_it)) {
-        siblings_expansion(root_it->second.children(), max_dim - 1);
+        siblings_expansion(root_it->second.children(), max_dim - 1, nullptr, block_simplex);
       }
     }
     dimension_ = max_dim - dimension_;
   }
 
+ public:
+
   /**
     * @brief Adds a new vertex or a new edge in a flag complex, as well as all
     * simplices of its star, defined to maintain the property
@@ -1510,7 +2699,7 @@ class Simplex_tree {
           if (!has_children(sh_u)) {
             //then node_u was a leaf and now has a new child Node labeled v
             //the child v is created in compute_punctual_expansion
-            node_u.assign_children(new Siblings(sib_u, u));
+            node_u.assign_children(new_siblings(sib_u, u));
           }
           dimension_ = dim_max - curr_dim - 1;
           compute_punctual_expansion(
@@ -1572,7 +2761,7 @@ class Simplex_tree {
           root_sh->second.children()->members().find(v) != root_sh->second.children()->members().end())
       { //edge {x,v} is in the complex
         if (!has_children(sh)){
-          sh->second.assign_children(new Siblings(sib, sh->first));
+          sh->second.assign_children(new_siblings(sib, sh->first));
         }
         //insert v in the children of sh, and expand.
         compute_punctual_expansion(  v
@@ -1636,12 +2825,20 @@ class Simplex_tree {
     }
   }
 
+  struct Expansion_bookkeeping;
+
   /** \brief Recursive expansion of the simplex tree.
-   * Only called in the case of `void expansion(int max_dim)`. */
+   * Only called in the case of `void expansion(int max_dim)`. If `bookkeeping` is not null, it is updated instead of
+   * the data of the simplex tree, so that several subtrees can be expanded at the same time. If `block_simplex` is
+   * not null, the simplices it blocks are removed before being expanded. */
+  template<typename Blocker = No_blocker>
   void siblings_expansion(Siblings * siblings,  // must contain elements
-                          int k) {
-    if (k >= 0 && dimension_ > k) {
-      dimension_ = k;
+                          int k,
+                          Expansion_bookkeeping* bookkeeping = nullptr,
+                          Blocker* block_simplex = nullptr) {
+    int& dimension = bookkeeping == nullptr ? dimension_ : bookkeeping->dimension;
+    if (k >= 0 && dimension > k) {
+      dimension = k;
     }
     if (k == 0)
       return;
@@ -1651,7 +2848,7 @@ class Simplex_tree {
     for (Dictionary_it s_h = siblings->members().begin();
          s_h != siblings->members().end(); ++s_h, ++next)
     {
-      create_expansion<false>(siblings, s_h, next, s_h->second.filtration(), k);
+      create_expansion<false>(siblings, s_h, next, s_h->second.filtration(), k, nullptr, bookkeeping, block_simplex);
     }
   }
 
@@ -1659,13 +2856,15 @@ class Simplex_tree {
    * The method is used with `force_filtration_value == true` by `void insert_edge_as_flag(...)` and with
    * `force_filtration_value == false` by `void expansion(int max_dim)`. Therefore, `added_simplices` is assumed
    * to bon non-null in the first case and null in the second.*/
-  template<bool force_filtration_value>
+  template<bool force_filtration_value, typename Blocker = No_blocker>
   void create_expansion(Siblings * siblings,
                         Dictionary_it& s_h,
                         Dictionary_it& next,
                         Filtration_value fil,
                         int k,
-                        std::vector<Simplex_handle>* added_simplices = nullptr)
+                        std::vector<Simplex_handle>* added_simplices = nullptr,
+                        Expansion_bookkeeping* bookkeeping = nullptr,
+                        Blocker* block_simplex = nullptr)
   {
     Simplex_handle root_sh = find_vertex(s_h->first);
     thread_local std::vector<std::pair<Vertex_handle, Node> > inter;
@@ -1680,11 +2879,32 @@ class Simplex_tree {
           root_sh->second.children()->members().end(),
           fil);
     if (inter.size() != 0) {
-      Siblings * new_sib = new Siblings(siblings,   // oncles
-                                        s_h->first, // parent
-                                        inter);     // boost::container::ordered_unique_range_t
+      Siblings * new_sib = new_siblings(siblings,   // oncles
+                                         s_h->first, // parent
+                                         inter);     // boost::container::ordered_unique_range_t
+      if constexpr (!std::is_same_v<Blocker, No_blocker>) {
+        if (block_simplex != nullptr) {
+          // The blocker is monotone, a blocked simplex has no cofaces to expand
+          inter.clear();
+          for (auto it = new_sib->members().begin(); it != new_sib->members().end(); ++it)
+            if ((*block_simplex)(it)) inter.emplace_back(it->first, Node());
+          for (auto& blocked : inter) new_sib->members().erase(blocked.first);
+          inter.clear();
+          if (new_sib->members().empty()) {
+            delete_siblings(new_sib);
+            // ensure the children property
+            s_h->second.assign_children(siblings);
+            return;
+          }
+        }
+      }
+      GUDHI_PROFILE_COUNT("Simplex_tree simplices inserted", new_sib->members().size());
       for (auto it = new_sib->members().begin(); it != new_sib->members().end(); ++it) {
-        update_simplex_tree_after_node_insertion(it);
+        if (bookkeeping == nullptr) {
+          update_simplex_tree_after_node_insertion(it);
+        } else if constexpr (Options::link_nodes_by_label) {
+          bookkeeping->nodes_label_to_list[it->first].push_back(it->second);
+        }
         if constexpr (force_filtration_value){
           //the way create_expansion is used, added_simplices != nullptr when force_filtration_value == true
           added_simplices->push_back(it);
@@ -1695,7 +2915,7 @@ class Simplex_tree {
       if constexpr (force_filtration_value){
         siblings_expansion(new_sib, fil, k - 1, *added_simplices);
       } else {
-        siblings_expansion(new_sib, k - 1);
+        siblings_expansion(new_sib, k - 1, bookkeeping, block_simplex);
       }
     } else {
       // ensure the children property
@@ -1717,6 +2937,14 @@ class Simplex_tree {
       if (begin1->first == begin2->first) {
         if constexpr (force_filtration_value){
           intersection.emplace_back(begin1->first, Node(nullptr, filtration_));
+        } else if constexpr (SimplexTreeOptions::is_multi_parameter &&
+                             !simplex_tree::is_multi_critical<Filtration_value>::value) {
+          // The faces cover all the edges of the new simplex, so that their coordinate-wise maximum is the one of its
+          // edges, computed in place in its node.
+          intersection.emplace_back(begin1->first, Node(nullptr, filtration_));
+          Filtration_value& filt = intersection.back().second.filtration();
+          filt.push_to(begin1->second.filtration());
+          filt.push_to(begin2->second.filtration());
         } else {
           Filtration_value filt = (std::max)({begin1->second.filtration(), begin2->second.filtration(), filtration_});
           intersection.emplace_back(begin1->first, Node(nullptr, filt));
@@ -1754,18 +2982,34 @@ class Simplex_tree {
    */
   template< typename Blocker >
   void expansion_with_blockers(int max_dim, Blocker block_simplex) {
+    expansion_with_blockers(max_dim, block_simplex, [](Simplex_handle, Vertex_handle) { return false; });
+  }
+
+  /** \brief Same as `expansion_with_blockers(int, Blocker)`, but a candidate simplex, made of a simplex `sh` of the
+   * complex and an extra vertex `v`, is not even inserted if `skip_candidate(sh, v)` returns true.
+   *
+   * @param[in] max_dim Expansion maximal dimension value.
+   * @param[in] block_simplex Blocker oracle. Its concept is <CODE>bool block_simplex(Simplex_handle sh)</CODE>
+   * @param[in] skip_candidate Cheap test of the candidates, for instance a necessary condition for `block_simplex`
+   * to accept them. Its concept is <CODE>bool skip_candidate(Simplex_handle sh, Vertex_handle v)</CODE>, it is only
+   * called on candidates whose faces are all in the complex.
+   */
+  template< typename Blocker, typename CandidateFilter >
+  void expansion_with_blockers(int max_dim, Blocker block_simplex, CandidateFilter skip_candidate) {
     // Loop must be from the end to the beginning, as higher dimension simplex are always on the left part of the tree
     for (auto& simplex : boost::adaptors::reverse(root_.members())) {
       if (has_children(&simplex)) {
-        siblings_expansion_with_blockers(simplex.second.children(), max_dim, max_dim - 1, block_simplex);
+        siblings_expansion_with_blockers(simplex.second.children(), max_dim, max_dim - 1, block_simplex,
+                                         skip_candidate);
       }
     }
   }
 
  private:
   /** \brief Recursive expansion with blockers of the simplex tree.*/
-  template< typename Blocker >
-  void siblings_expansion_with_blockers(Siblings* siblings, int max_dim, int k, Blocker block_simplex) {
+  template< typename Blocker, typename CandidateFilter >
+  void siblings_expansion_with_blockers(Siblings* siblings, int max_dim, int k, Blocker block_simplex,
+                                        CandidateFilter skip_candidate) {
     if (dimension_ < max_dim - k) {
       dimension_ = max_dim - k;
     }
@@ -1787,15 +3031,20 @@ class Simplex_tree {
             to_be_inserted=false;
             break;
           }
-          filt = (std::max)(filt, filtration(border_child));
+          if constexpr (SimplexTreeOptions::is_multi_parameter &&
+                        !simplex_tree::is_multi_critical<Filtration_value>::value) {
+            filt.push_to(filtration(border_child));
+          } else {
+            filt = (std::max)(filt, filtration(border_child));
+          }
         }
-        if (to_be_inserted) {
+        if (to_be_inserted && !skip_candidate(std::prev(simplex.base()), next->first)) {
           intersection.emplace_back(next->first, Node(nullptr, filt));
         }
       }
       if (intersection.size() != 0) {
         // Reverse the order to insert
-        Siblings * new_sib = new Siblings(
+        Siblings * new_sib = new_siblings(
               siblings,                                 // oncles
               simplex->first,                           // parent
               boost::adaptors::reverse(intersection));  // boost::container::ordered_unique_range_t
@@ -1818,7 +3067,7 @@ class Simplex_tree {
         }
         if (blocked_new_sib_vertex_list.size() == new_sib->members().size()) {
           // Specific case where all have to be deleted
-          delete new_sib;
+          delete_siblings(new_sib);
           // ensure the children property
           simplex->second.assign_children(siblings);
         } else {
@@ -1826,7 +3075,7 @@ class Simplex_tree {
             new_sib->members().erase(blocked_new_sib_member);
           }
           // ensure recursive call
-          siblings_expansion_with_blockers(new_sib, max_dim, k - 1, block_simplex);
+          siblings_expansion_with_blockers(new_sib, max_dim, k - 1, block_simplex, skip_candidate);
         }
       } else {
         // ensure the children property
@@ -1881,8 +3130,79 @@ class Simplex_tree {
    */
   template<class Fun>
   void for_each_simplex(Fun&& fun) {
-    // Wrap callback so it always returns bool
-    auto f = [&fun](Simplex_handle sh, int dim) -> bool {
+    if (!is_empty())
+      rec_for_each_simplex(root(), 0, bool_returning(fun));
+  }
+
+  /** \brief Range of vertices of the complex, each one standing for the subtree of the simplices whose smallest
+   * vertex it is. These subtrees do not share any simplex.
+   *
+   * \details The range can be split in two halves, with the same interface as `tbb::blocked_range`, so that it can be
+   * given to `tbb::parallel_for`, whose body calls `for_each_simplex(const Vertex_subtree_range&, Fun&&)`.
+   */
+  class Vertex_subtree_range {
+   public:
+    Vertex_subtree_range(Dictionary_it begin, Dictionary_it end, std::size_t size)
+        : begin_(begin), end_(end), size_(size) {}
+
+    /** \brief Splitting constructor: `other` keeps the first half of the vertices and the new range the second one.
+     * `Split` is `tbb::split` when called by TBB. */
+    template <class Split>
+    Vertex_subtree_range(Vertex_subtree_range& other, Split)
+        : begin_(std::next(other.begin_, other.size_ / 2)), end_(other.end_), size_(other.size_ - other.size_ / 2) {
+      other.end_ = begin_;
+      other.size_ /= 2;
+    }
+
+    Dictionary_it begin() const { return begin_; }
+    Dictionary_it end() const { return end_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool is_divisible() const { return size_ > 1; }
+
+   private:
+    Dictionary_it begin_, end_;
+    std::size_t size_;
+  };
+
+  /** \brief Returns the range of all the vertices of the complex, see Vertex_subtree_range. */
+  Vertex_subtree_range vertex_subtree_range() {
+    return Vertex_subtree_range(root_.members().begin(), root_.members().end(), root_.members().size());
+  }
+
+  /** \brief Same as for_each_simplex(), restricted to the simplices whose smallest vertex is in `range`.
+   *
+   * Calls on disjoint ranges visit disjoint sets of simplices, and can run concurrently as long as no thread inserts or
+   * removes simplices. */
+  template<class Fun>
+  void for_each_simplex(const Vertex_subtree_range& range, Fun&& fun) {
+    auto&& f = bool_returning(fun);
+    for (Dictionary_it sh = range.end(); sh != range.begin();) {
+      --sh;
+      if (!f(sh, 0) && has_children(sh)) rec_for_each_simplex(sh->second.children(), 1, f);
+    }
+  }
+
+  /** \brief Same as for_each_simplex(), with the subtrees of the vertices visited in parallel if TBB is available.
+   *
+   * `fun` may then be called concurrently on different simplices, and a simplex is only guaranteed to be visited
+   * after its faces that have the same smallest vertex. The structure of the complex must not be modified during the
+   * iteration, see the thread safety section of Simplex_tree.
+   */
+  template<class Fun>
+  void parallel_for_each_simplex(Fun&& fun) {
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(vertex_subtree_range(), [&](const Vertex_subtree_range& range) { for_each_simplex(range, fun); });
+#else
+    for_each_simplex(fun);
+#endif
+  }
+
+ private:
+  // Wraps a callback of for_each_simplex so that it always returns bool
+  template<class Fun>
+  static auto bool_returning(Fun& fun) {
+    return [&fun](Simplex_handle sh, int dim) -> bool {
       if constexpr (std::is_same_v<void, decltype(fun(sh, dim))>) {
         fun(sh, dim);
         return false;
@@ -1890,11 +3210,8 @@ class Simplex_tree {
         return fun(sh, dim);
       }
     };
-    if (!is_empty())
-      rec_for_each_simplex(root(), 0, f);
   }
 
- private:
   template<class Fun>
   void rec_for_each_simplex(Siblings* sib, int dim, Fun&& fun) {
     Simplex_handle sh = sib->members().end();
@@ -1918,43 +3235,95 @@ class Simplex_tree {
    */
   bool make_filtration_non_decreasing() {
     bool modified = false;
-    auto fun = [&modified, this](Simplex_handle sh, int dim) -> void {
-      if (dim == 0) return;
-      // Find the maximum filtration value in the border
-      Boundary_simplex_range&& boundary = boundary_simplex_range(sh);
-      Filtration_value max_filt_border_value;
-      if constexpr (SimplexTreeOptions::is_multi_parameter){
-        // in that case, we assume that Filtration_value has a `push_to` member to handle this.
-        max_filt_border_value = Filtration_value(this->number_of_parameters_);
-        for (auto &face_sh : boundary){
-          max_filt_border_value.push_to(filtration(face_sh)); // pushes the value of max_filt_border_value to reach simplex' filtration
-        }
-      }
-      else{
+    if constexpr (SimplexTreeOptions::is_multi_parameter) {
+      modified = make_multi_filtration_non_decreasing();
+    } else {
+      auto fun = [&modified, this](Simplex_handle sh, int dim) -> void {
+        if (dim == 0) return;
+        // Find the maximum filtration value in the border
+        Boundary_simplex_range&& boundary = boundary_simplex_range(sh);
         Boundary_simplex_iterator max_border = std::max_element(std::begin(boundary), std::end(boundary),
-                                                              [](Simplex_handle sh1, Simplex_handle sh2) {
-                                                                return filtration(sh1) < filtration(sh2);
-                                                              });
-        max_filt_border_value = filtration(*max_border);
-      }
-      
-      // Replacing if(f<max) with if(!(f>=max)) would mean that if f is NaN, we replace it with the max of the children.
-      // That seems more useful than keeping NaN.
-      if (!(sh->second.filtration() >= max_filt_border_value)) {
-        // Store the filtration modification information
-        modified = true;
-        sh->second.assign_filtration(max_filt_border_value);
-      }
-    };
-    // Loop must be from the end to the beginning, as higher dimension simplex are always on the left part of the tree
-    for_each_simplex(fun);
+                                                                [](Simplex_handle sh1, Simplex_handle sh2) {
+                                                                  return filtration(sh1) < filtration(sh2);
+                                                                });
+        Filtration_value max_filt_border_value = filtration(*max_border);
+        // Replacing if(f<max) with if(!(f>=max)) would mean that if f is NaN, we replace it with the max of the children.
+        // That seems more useful than keeping NaN.
+        if (!(sh->second.filtration() >= max_filt_border_value)) {
+          // Store the filtration modification information
+          modified = true;
+          sh->second.assign_filtration(max_filt_border_value);
+        }
+      };
+      // Loop must be from the end to the beginning, as higher dimension simplex are always on the left part of the tree
+      for_each_simplex(fun);
+    }
 
     if(modified)
       clear_filtration(); // Drop the cache.
     return modified;
   }
 
+ private:
+  /** \brief make_filtration_non_decreasing for multi-parameter filtration values, which are pushed in place (with
+   * their `push_to` member) to the values of the faces, i.e., to their join. For multi-critical filtrations, the grades
+   * of a simplex are intersected with the ones of its faces.
+   *
+   * The simplices of dimension d only depend on the ones of dimension d-1, so that the tree is processed dimension by
+   * dimension, in parallel with TBB. */
+  bool make_multi_filtration_non_decreasing() {
+    std::vector<std::vector<Simplex_handle>> simplices_by_dimension(upper_bound_dimension() + 1);
+    for_each_simplex([&simplices_by_dimension](Simplex_handle sh, int dim) {
+      if (dim == 0) return;
+      if (dim >= static_cast<int>(simplices_by_dimension.size())) simplices_by_dimension.resize(dim + 1);
+      simplices_by_dimension[dim].push_back(sh);
+    });
+    // Pushes sh to its faces, returns true if it was modified.
+    auto push_to_faces = [this](Simplex_handle sh) {
+      bool modified = false;
+      Filtration_value& value = filtration_mutable(sh);
+      for (auto face_sh : boundary_simplex_range(sh)) {
+        const Filtration_value& face_value = filtration(face_sh);
+        if (!(value >= face_value)) {
+          value.push_to(face_value);
+          modified = true;
+        }
+      }
+      return modified;
+    };
+    bool modified = false;
+    for (const auto& simplices : simplices_by_dimension) {
+#ifdef GUDHI_USE_TBB
+      modified |= tbb::parallel_reduce(
+          tbb::blocked_range<std::size_t>(0, simplices.size()), false,
+          [&](const tbb::blocked_range<std::size_t>& range, bool range_modified) {
+            for (std::size_t i = range.begin(); i != range.end(); ++i) range_modified |= push_to_faces(simplices[i]);
+            return range_modified;
+          },
+          [](bool a, bool b) { return a || b; });
+#else
+      for (Simplex_handle sh : simplices) modified |= push_to_faces(sh);
+#endif
+    }
+    return modified;
+  }
+
  public:
+  /** \brief Allocates the buffers of the members of the `Siblings`, i.e. the nodes below the root, in `resource`,
+   * e.g. a `Gudhi::simplex_tree::Mapped_file_resource` to build a simplex tree larger than the memory, or a
+   * `Gudhi::simplex_tree::Huge_page_resource` to traverse a very large one with fewer TLB misses.
+   *
+   * Requires `SimplexTreeOptions::pool_siblings`. The resource must outlive the simplex tree, or its simplices. The
+   * copies of the simplex tree do not use it, while it follows the simplex tree when it is moved.
+   *
+   * @exception std::logic_error If the simplex tree is not empty.
+   */
+  void set_siblings_memory_resource(std::pmr::memory_resource* resource) {
+    static_assert(pool_siblings, "set_siblings_memory_resource requires SimplexTreeOptions::pool_siblings");
+    if (!is_empty()) throw std::logic_error("Simplex_tree::set_siblings_memory_resource - Simplex_tree must be empty");
+    siblings_pool_ = std::make_unique<Siblings_pool>(resource);
+  }
+
   /** \brief Remove all the simplices, leaving an empty complex. */
   void clear() {
     root_members_recursive_deletion();
@@ -1971,35 +3340,61 @@ class Simplex_tree {
    * \post Note that the dimension of the simplicial complex may be lower after calling `prune_above_filtration()`
    * than it was before. However, `upper_bound_dimension()` will return the old value, which remains a valid upper
    * bound. If you care, you can call `dimension()` to recompute the exact dimension.
+   *
+   * With TBB, the subtrees of the vertices are pruned in parallel, unless SimplexTreeOptions::pool_siblings.
    */
   bool prune_above_filtration(const Filtration_value& filtration) {
     if (std::numeric_limits<Filtration_value>::has_infinity && filtration == std::numeric_limits<Filtration_value>::infinity())
       return false;  // ---->>
-    bool modified = rec_prune_above_filtration(root(), filtration);
-    if(modified)
+    bool modified = prune_above_filtration_impl(filtration);
+    if(modified) {
+      // dimension may need to be lowered
+      dimension_to_be_lowered_ = true;
       clear_filtration(); // Drop the cache.
+      clear_find_index();
+    }
     return modified;
   }
 
  private:
-  bool rec_prune_above_filtration(Siblings* sib, const Filtration_value& filt) {
+  bool prune_above_filtration_impl(const Filtration_value& filt) {
+#ifdef GUDHI_USE_TBB
+    // The pools of SimplexTreeOptions::pool_siblings are not thread safe, the pruning is then sequential.
+    if constexpr (!pool_siblings) {
+      bool modified = parallel_prune([this, &filt](Dictionary_it sh) {
+        if (!(sh->second.filtration() <= filt)) {
+          // The vertex is removed below, once it is a leaf
+          if (has_children(sh)) {
+            rec_delete(sh->second.children());
+            sh->second.assign_children(&root_);
+          }
+          return true;
+        }
+        return has_children(sh) && rec_prune_above_filtration(sh->second.children(), filt);
+      });
+      erase_members_above_filtration(root(), filt);
+      relink_nodes_by_label();
+      return modified;
+    }
+#endif
+    return rec_prune_above_filtration(root(), filt);
+  }
+
+  // Removes the members of sib above filt with their subtrees, in a single compaction pass of the members.
+  // Returns true if any member was removed.
+  bool erase_members_above_filtration(Siblings* sib, const Filtration_value& filt) {
     auto&& list = sib->members();
-    bool modified = false;
-    bool emptied = false;
-    Simplex_handle last;
 
-    auto to_remove = [this, filt](Dit_value_t& simplex) {
+    auto to_remove = [this, &filt](Dit_value_t& simplex) {
       if (simplex.second.filtration() <= filt) return false;
       if (has_children(&simplex)) rec_delete(simplex.second.children());
-      // dimension may need to be lowered
-      dimension_to_be_lowered_ = true;
       return true;
     };
 
     //TODO: `if constexpr` replacable by `std::erase_if` in C++20? Has a risk of additional runtime,
     //so to benchmark first.
     if constexpr (Options::stable_simplex_handles) {
-      modified = false;
+      bool modified = false;
       for (auto sh = list.begin(); sh != list.end();) {
         if (to_remove(*sh)) {
           sh = list.erase(sh);
@@ -2008,26 +3403,28 @@ class Simplex_tree {
           ++sh;
         }
       }
-      emptied = (list.empty() && sib != root());
+      return modified;
     } else {
-      last = std::remove_if(list.begin(), list.end(), to_remove);
-      modified = (last != list.end());
-      emptied = (last == list.begin() && sib != root());
+      auto last = std::remove_if(list.begin(), list.end(), to_remove);
+      bool modified = (last != list.end());
+      list.erase(last, list.end());
+      return modified;
     }
+  }
+
+  // Does not modify anything outside of the subtree of sib, except the children of its parent if sib is emptied.
+  bool rec_prune_above_filtration(Siblings* sib, const Filtration_value& filt) {
+    bool modified = erase_members_above_filtration(sib, filt);
 
-    if (emptied) {
+    if (sib->members().empty() && sib != root()) {
       // Removing the whole siblings, parent becomes a leaf.
       sib->oncles()->members()[sib->parent()].assign_children(sib->oncles());
-      delete sib;
-      // dimension may need to be lowered
-      dimension_to_be_lowered_ = true;
+      delete_siblings(sib);
       return true;
-    } else {
-      // Keeping some elements of siblings. Remove the others, and recurse in the remaining ones.
-      if constexpr (!Options::stable_simplex_handles) list.erase(last, list.end());
-      for (auto&& simplex : list)
-        if (has_children(&simplex)) modified |= rec_prune_above_filtration(simplex.second.children(), filt);
     }
+    // Keeping some elements of siblings, recurse in the remaining ones.
+    for (auto&& simplex : sib->members())
+      if (has_children(&simplex)) modified |= rec_prune_above_filtration(simplex.second.children(), filt);
 
     return modified;
   }
@@ -2036,6 +3433,8 @@ class Simplex_tree {
   /** \brief Remove all simplices of dimension greater than a given value.
    * @param[in] dimension Maximum dimension value.
    * @return True if any simplex was removed, false if all simplices already had a value below the dimension.
+   *
+   * With TBB, the subtrees of the vertices are pruned in parallel, unless SimplexTreeOptions::pool_siblings.
    */
   bool prune_above_dimension(int dimension) {
     if (dimension >= dimension_)
@@ -2050,17 +3449,37 @@ class Simplex_tree {
       // Force dimension to -1, in case user calls `prune_above_dimension(-10)`
       dimension = -1;
     } else {
-      modified = rec_prune_above_dimension(root(), dimension, 0);
+      modified = prune_above_dimension_impl(dimension);
     }
     if(modified) {
       // Thanks to `if (dimension >= dimension_)` and dimension forced to -1 `if (dimension < 0)`, we know the new dimension
       dimension_ = dimension;
       clear_filtration(); // Drop the cache.
+      clear_find_index();
     }
     return modified;
   }
 
  private:
+  bool prune_above_dimension_impl(int dim) {
+#ifdef GUDHI_USE_TBB
+    if constexpr (!pool_siblings) {
+      bool modified = parallel_prune([this, dim](Dictionary_it sh) {
+        if (!has_children(sh)) return false;
+        if (dim == 0) {
+          rec_delete(sh->second.children());
+          sh->second.assign_children(&root_);
+          return true;
+        }
+        return rec_prune_above_dimension(sh->second.children(), dim, 1);
+      });
+      relink_nodes_by_label();
+      return modified;
+    }
+#endif
+    return rec_prune_above_dimension(root(), dim, 0);
+  }
+
   bool rec_prune_above_dimension(Siblings* sib, int dim, int actual_dim) {
     bool modified = false;
     auto&& list = sib->members();
@@ -2079,6 +3498,47 @@ class Simplex_tree {
     return modified;
   }
 
+#ifdef GUDHI_USE_TBB
+  /** \brief Calls `prune_subtree` on every vertex of the complex, in parallel over the vertex subtrees, and returns
+   * true if any call returned true. `prune_subtree` may only remove simplices of the subtree of the vertex, and the
+   * vertex itself must not be removed from the root yet.
+   *
+   * The lists of Nodes by label link Nodes of different subtrees: they are emptied first, and must be rebuilt with
+   * relink_nodes_by_label() afterwards. */
+  template<class Prune>
+  bool parallel_prune(Prune&& prune_subtree) {
+    if constexpr (Options::link_nodes_by_label) nodes_label_to_list_.clear();
+    return tbb::parallel_reduce(
+        vertex_subtree_range(), false,
+        [&](const Vertex_subtree_range& range, bool range_modified) {
+          for (Dictionary_it sh = range.begin(); sh != range.end(); ++sh) range_modified |= prune_subtree(sh);
+          return range_modified;
+        },
+        [](bool a, bool b) { return a || b; });
+  }
+
+  /** \brief Rebuilds the lists of Nodes by label, which must be empty, in one parallel traversal of the tree. The
+   * lists of each range of vertices are merged afterwards in the order of the vertices. */
+  void relink_nodes_by_label() {
+    if constexpr (Options::link_nodes_by_label) {
+      tbb::concurrent_vector<std::pair<Vertex_handle, std::unordered_map<Vertex_handle, List_max_vertex>>> range_lists;
+      tbb::parallel_for(vertex_subtree_range(), [&](const Vertex_subtree_range& range) {
+        std::unordered_map<Vertex_handle, List_max_vertex> lists;
+        for_each_simplex(range, [&lists](Simplex_handle sh, int) { lists[sh->first].push_back(sh->second); });
+        range_lists.emplace_back(range.begin()->first, std::move(lists));
+      });
+      std::sort(range_lists.begin(), range_lists.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+      for (auto& [first_vertex, lists] : range_lists) {
+        for (auto& [label, nodes] : lists) {
+          auto& list = nodes_label_to_list_[label];
+          list.splice(list.end(), nodes);
+        }
+      }
+    }
+  }
+#endif
+
  private:
   /** \brief Deep search simplex tree dimension recompute.
    * @return True if the dimension was modified, false otherwise.
@@ -2135,7 +3595,7 @@ class Simplex_tree {
     } else {
       // Sibling is emptied : must be deleted, and its parent must point on his own Sibling
       child->oncles()->members().at(child->parent()).assign_children(child->oncles());
-      delete child;
+      delete_siblings(child);
       // dimension may need to be lowered
       dimension_to_be_lowered_ = true;
     }
@@ -2171,6 +3631,28 @@ class Simplex_tree {
     return p;
   };
 
+ private:
+  /* Cones the simplices of sib and of their subtrees with the vertex cone, which is larger than all the vertices.
+   * up is the maximal ascending value of the vertices of the parent simplex of sib, and down the maximal descending
+   * value, i.e. the opposite of the minimal ascending value. The ascending value of a simplex is then the maximal
+   * one of its vertices, and the descending value of its cone the maximal descending value of its vertices, between 1
+   * and 2. The cone of a simplex is its child of label cone, which is added after its subtree is processed. */
+  void rec_extend_filtration(Siblings* sib, Vertex_handle cone, Filtration_value up, Filtration_value down) {
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
+      Filtration_value vertex_value = filtration(find_vertex(sh->first));
+      Filtration_value sh_up = (std::max)(up, vertex_value);
+      Filtration_value sh_down = (std::max)(down, -vertex_value);
+      if (has_children(sh))
+        rec_extend_filtration(sh->second.children(), cone, sh_up, sh_down);
+      else
+        sh->second.assign_children(new_siblings(sib, sh->first));
+      sh->second.assign_filtration(sh_up);
+      Siblings* children = sh->second.children();
+      update_simplex_tree_after_node_insertion(children->members().emplace(cone, Node(children, sh_down)).first);
+    }
+  }
+
+ public:
   /** \brief Extend filtration for computing extended persistence. 
    * This function only uses the filtration values at the 0-dimensional simplices, 
    * and computes the extended persistence diagram induced by the lower-star filtration 
@@ -2201,40 +3683,22 @@ class Simplex_tree {
     GUDHI_CHECK(maxvert < std::numeric_limits<Vertex_handle>::max(), std::invalid_argument("Simplex_tree contains a vertex with the largest Vertex_handle"));
     maxvert++;
 
-    Simplex_tree st_copy = *this;
-
-    // Add point for coning the simplicial complex
-    this->insert_simplex_raw({maxvert}, -3);
-
     Filtration_value scale = maxval-minval;
     if (scale != 0)
       scale = 1 / scale;
 
-    // For each simplex
-    std::vector<Vertex_handle> vr;
-    for (auto sh_copy : st_copy.complex_simplex_range()) {
-      auto&& simplex_range = st_copy.simplex_vertex_range(sh_copy);
-      vr.assign(simplex_range.begin(), simplex_range.end());
-      auto sh = this->find(vr);
-
-      // Create cone on simplex
-      vr.push_back(maxvert);
-      if (this->dimension(sh) == 0) {
-        Filtration_value v = this->filtration(sh);
-        Filtration_value scaled_v = (v - minval) * scale;
-        // Assign ascending value between -2 and -1 to vertex
-        this->assign_filtration(sh, -2 + scaled_v);
-        // Assign descending value between 1 and 2 to cone on vertex
-        this->insert_simplex(vr, 2 - scaled_v);
-      } else {
-        // Assign value -3 to simplex and cone on simplex
-        this->assign_filtration(sh, -3);
-        this->insert_simplex(vr, -3);
-      }
-    }
+    // Assign ascending value between -2 and -1 to vertices
+    for (auto& vertex : root_.members())
+      vertex.second.assign_filtration(-2 + (vertex.second.filtration() - minval) * scale);
 
-    // Automatically assign good values for simplices
-    this->make_filtration_non_decreasing();
+    // Cone each simplex in place, with the values that make_filtration_non_decreasing() would give, without any copy
+    // of the tree
+    if (dimension_ >= 0) ++dimension_;
+    rec_extend_filtration(&root_, maxvert, -std::numeric_limits<Filtration_value>::infinity(),
+                          -std::numeric_limits<Filtration_value>::infinity());
+
+    // Add point for coning the simplicial complex
+    this->insert_simplex_raw({maxvert}, -3);
 
     // Return the filtration data 
     return Extended_filtration_data(minval, maxval);
@@ -2319,6 +3783,14 @@ class Simplex_tree {
   // unordered_map Vertex_handle v -> list of all Nodes with label v.
   std::unordered_map<Vertex_handle, List_max_vertex> nodes_label_to_list_;
 
+  /** \brief Data updated by an expansion, which is kept per thread by a parallel `void expansion(int max_dim)`.
+   * `dimension` plays the role of `dimension_`, and `nodes_label_to_list` of `nodes_label_to_list_`. */
+  struct Expansion_bookkeeping {
+    explicit Expansion_bookkeeping(int max_dim) : dimension(max_dim) {}
+    int dimension;
+    std::unordered_map<Vertex_handle, List_max_vertex> nodes_label_to_list;
+  };
+
   List_max_vertex* nodes_by_label(Vertex_handle v) {
     if constexpr (Options::link_nodes_by_label) {
       auto it_v = nodes_label_to_list_.find(v);
@@ -2386,6 +3858,7 @@ class Simplex_tree {
 #ifdef DEBUG_TRACES
     std::clog << "update_simplex_tree_after_node_insertion" << std::endl;
 #endif  // DEBUG_TRACES
+    clear_find_index();
     if constexpr (Options::link_nodes_by_label) {
       // Creates an entry with sh->first if not already in the map and insert sh->second at the end of the list
       nodes_label_to_list_[sh->first].push_back(sh->second);
@@ -2398,6 +3871,7 @@ class Simplex_tree {
 #ifdef DEBUG_TRACES
     std::clog << "update_simplex_tree_before_node_removal" << std::endl;
 #endif  // DEBUG_TRACES
+    clear_find_index();
     if constexpr (Options::link_nodes_by_label) {
       sh->second.unlink_hooks();  // remove from lists of same label Nodes
       if (nodes_label_to_list_[sh->first].empty())
@@ -2415,27 +3889,12 @@ class Simplex_tree {
    * @param[in] min_dim The minimal dimension. Default value is 0.
    */
   void reset_filtration(const Filtration_value& filt_value, int min_dim = 0) {
-    rec_reset_filtration(&root_, filt_value, min_dim);
+    parallel_for_each_simplex([&](Simplex_handle sh, int dim) {
+      if (dim >= min_dim) sh->second.assign_filtration(filt_value);
+    });
     clear_filtration(); // Drop the cache.
   }
 
- private:
-  /** \brief Recursively resets filtration value when minimal depth <= 0.
-   * @param[in] sib Siblings to be parsed.
-   * @param[in] filt_value The new filtration value.
-   * @param[in] min_depth The minimal depth.
-   */
-  void rec_reset_filtration(Siblings * sib, const Filtration_value& filt_value, int min_depth) {
-    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
-      if (min_depth <= 0) {
-        sh->second.assign_filtration(filt_value);
-      }
-      if (has_children(sh)) {
-        rec_reset_filtration(sh->second.children(), filt_value, min_depth - 1);
-      }
-    }
-  }
-
  public:
    /** @private @brief Returns the serialization required buffer size.
    * 
@@ -2445,9 +3904,18 @@ class Simplex_tree {
    *   architecture.
    */
   std::size_t get_serialization_size() {
+    using namespace Gudhi::simplex_tree;  // for get_serialization_size_of, found by ADL for the other types
     const std::size_t vh_byte_size = sizeof(Vertex_handle);
-    const std::size_t fv_byte_size = SimplexTreeOptions::store_filtration ? sizeof(Filtration_value) : 0;
-    const std::size_t buffer_byte_size = vh_byte_size + num_simplices() * (fv_byte_size + 2 * vh_byte_size);
+    std::size_t fv_byte_size = 0;
+    if constexpr (SimplexTreeOptions::store_filtration) {
+      if constexpr (std::is_trivially_copyable_v<Filtration_value>) {
+        fv_byte_size = num_simplices() * sizeof(Filtration_value);
+      } else {
+        // Vector-valued filtration values do not all have the same size
+        for (auto sh : complex_simplex_range()) fv_byte_size += get_serialization_size_of(filtration(sh));
+      }
+    }
+    const std::size_t buffer_byte_size = vh_byte_size + num_simplices() * 2 * vh_byte_size + fv_byte_size;
 #ifdef DEBUG_TRACES
       std::clog << "Gudhi::simplex_tree::get_serialization_size - buffer size = " << buffer_byte_size << std::endl;
 #endif  // DEBUG_TRACES
@@ -2492,6 +3960,7 @@ class Simplex_tree {
  private:
   /** \brief Serialize each element of the sibling and recursively call serialization. */
   char* rec_serialize(Siblings *sib, char* buffer) {
+    using namespace Gudhi::simplex_tree;  // for serialize_value_to_char_buffer, found by ADL for the other types
     char* ptr = buffer;
     ptr = Gudhi::simplex_tree::serialize_trivial(static_cast<Vertex_handle>(sib->members().size()), ptr);
 #ifdef DEBUG_TRACES
@@ -2500,7 +3969,7 @@ class Simplex_tree {
     for (auto& map_el : sib->members()) {
       ptr = Gudhi::simplex_tree::serialize_trivial(map_el.first, ptr); // Vertex
       if (Options::store_filtration)
-        ptr = Gudhi::simplex_tree::serialize_trivial(map_el.second.filtration(), ptr); // Filtration
+        ptr = serialize_value_to_char_buffer(map_el.second.filtration(), ptr); // Filtration
 #ifdef DEBUG_TRACES
       std::clog << " [ " << map_el.first << " | " << map_el.second.filtration() << " ] ";
 #endif  // DEBUG_TRACES
@@ -2518,6 +3987,67 @@ class Simplex_tree {
     return ptr;
   }
 
+ public:
+  /** \brief Returns a hash of the simplices and of their filtration values, e.g. to recognize a complex whose
+   * persistence was already computed.
+   *
+   * The simplex tree is visited in the order of its serialization, the subtrees of the root vertices in parallel
+   * with TBB. Two simplex trees with the same simplices and filtration values have the same hash, whatever the order
+   * of their construction. Like the serialization, it is meant to be compared on a computer with the same
+   * architecture and with the same SimplexTreeOptions.
+   */
+  std::uint64_t content_hash() const {
+    std::vector<Dictionary_const_it> roots;
+    roots.reserve(root_.members().size());
+    for (auto it = root_.members().begin(); it != root_.members().end(); ++it) roots.push_back(it);
+    std::vector<std::uint64_t> subtree_hashes(roots.size());
+    auto hash_subtree = [&](std::size_t i) {
+      subtree_hashes[i] = has_children(roots[i]) ? rec_content_hash(roots[i]->second.children(), 0) : 0;
+    };
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), roots.size(), hash_subtree);
+#else
+    for (std::size_t i = 0; i < roots.size(); ++i) hash_subtree(i);
+#endif
+    std::uint64_t hash = hash_siblings_members(root_, mix_hash(0, roots.size()));
+    for (std::uint64_t subtree_hash : subtree_hashes) hash = mix_hash(hash, subtree_hash);
+    return hash;
+  }
+
+ private:
+  static std::uint64_t mix_hash(std::uint64_t hash, std::uint64_t value) {
+    value *= 0x9e3779b97f4a7c15ULL;
+    hash ^= value ^ (value >> 32);
+    hash *= 0xff51afd7ed558ccdULL;
+    return hash ^ (hash >> 33);
+  }
+
+  // Hashes the vertices and the serialized filtration values of the members of sib, as rec_serialize writes them
+  static std::uint64_t hash_siblings_members(const Siblings& sib, std::uint64_t hash) {
+    using namespace Gudhi::simplex_tree;  // for serialize_value_to_char_buffer, found by ADL for the other types
+    std::vector<char> bytes;
+    for (const auto& map_el : sib.members()) {
+      hash = mix_hash(hash, static_cast<std::uint64_t>(map_el.first));
+      if constexpr (Options::store_filtration) {
+        bytes.resize(get_serialization_size_of(map_el.second.filtration()));
+        serialize_value_to_char_buffer(map_el.second.filtration(), bytes.data());
+        for (std::size_t i = 0; i < bytes.size(); i += sizeof(std::uint64_t)) {
+          std::uint64_t word = 0;
+          std::memcpy(&word, bytes.data() + i, std::min(sizeof(std::uint64_t), bytes.size() - i));
+          hash = mix_hash(hash, word);
+        }
+      }
+    }
+    return hash;
+  }
+
+  std::uint64_t rec_content_hash(const Siblings* sib, std::uint64_t hash) const {
+    hash = hash_siblings_members(*sib, mix_hash(hash, sib->members().size()));
+    for (const auto& map_el : sib->members())
+      hash = has_children(&map_el) ? rec_content_hash(map_el.second.children(), hash) : mix_hash(hash, 0);
+    return hash;
+  }
+
  public:
   /** @private @brief Deserialize the array of char (flatten version of the tree) to initialize a Simplex tree.
    * It is the user's responsibility to provide an 'empty' Simplex_tree, there is no guarantee otherwise.
@@ -2547,6 +4077,7 @@ class Simplex_tree {
  private:
   /** \brief Serialize each element of the sibling and recursively call serialization. */
   const char* rec_deserialize(Siblings *sib, Vertex_handle members_size, const char* ptr, int dim) {
+    using namespace Gudhi::simplex_tree;  // for deserialize_value_from_char_buffer, found by ADL for the other types
     // In case buffer is just a 0 char
     if (members_size > 0) {
       if constexpr (!Options::stable_simplex_handles) sib->members_.reserve(members_size);
@@ -2555,7 +4086,7 @@ class Simplex_tree {
       for (Vertex_handle idx = 0; idx < members_size; idx++) {
         ptr = Gudhi::simplex_tree::deserialize_trivial(vertex, ptr);
         if (Options::store_filtration) {
-          ptr = Gudhi::simplex_tree::deserialize_trivial(filtration, ptr);
+          ptr = deserialize_value_from_char_buffer(filtration, ptr);
           // Default is no children
           sib->members_.emplace_hint(sib->members_.end(), vertex, Node(sib, filtration));
         } else {
@@ -2568,7 +4099,7 @@ class Simplex_tree {
         update_simplex_tree_after_node_insertion(sh);
         ptr = Gudhi::simplex_tree::deserialize_trivial(child_size, ptr);
         if (child_size > 0) {
-          Siblings* child = new Siblings(sib, sh->first);
+          Siblings* child = new_siblings(sib, sh->first);
           sh->second.assign_children(child);
           ptr = rec_deserialize(child, child_size, ptr, dim + 1);
         }
@@ -2591,6 +4122,33 @@ class Simplex_tree {
   /** \brief Upper bound on the dimension of the simplicial complex.*/
   int dimension_;
   bool dimension_to_be_lowered_ = false;
+  /** \brief Hash table used by find(), see enable_find_index().*/
+  Find_index find_index_;
+
+  /** \brief Memory of the Siblings and of the buffers of their members, if Options::pool_siblings.
+   *
+   * It is released at once when the tree is cleared, and follows the tree when it is moved.*/
+  struct Siblings_pool {
+    explicit Siblings_pool(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : members(upstream) {}
+    Simple_object_pool<Siblings> siblings;
+    std::pmr::unsynchronized_pool_resource members;
+    void release() {
+      siblings.release();
+      members.release();
+    }
+  };
+  struct Siblings_pool_dummy {};
+  typedef typename std::conditional<pool_siblings, std::unique_ptr<Siblings_pool>, Siblings_pool_dummy>::type
+      Siblings_pool_ptr;
+  static Siblings_pool_ptr make_siblings_pool() {
+    if constexpr (pool_siblings) {
+      return std::make_unique<Siblings_pool>();
+    } else {
+      return Siblings_pool_dummy();
+    }
+  }
+  Siblings_pool_ptr siblings_pool_ = make_siblings_pool();
 
 //MULTIPERS STUFF
 public: 
@@ -2602,7 +4160,7 @@ public:
 	}
   inline static Filtration_value inf_ = std::numeric_limits<Filtration_value>::infinity();
 private:
-	int number_of_parameters_;
+	int number_of_parameters_ = 1;
 };
 
 // Print a Simplex_tree in os.
@@ -2657,6 +4215,15 @@ struct Simplex_tree_options_full_featured {
   static const bool is_multi_parameter = false;
 };
 
+/** Model of SimplexTreeOptions, as `Simplex_tree_options_full_featured` with `float` filtration values, which make
+ * the nodes of the tree smaller, e.g. for large flag complexes whose filtration values do not need double precision.
+ * 
+ * Maximum number of simplices to compute persistence is <CODE>std::numeric_limits<std::uint32_t>::max()</CODE>
+ * (about 4 billions of simplices). */
+struct Simplex_tree_options_float_filtration : Simplex_tree_options_full_featured {
+  typedef float Filtration_value;
+};
+
 /** Model of SimplexTreeOptions, faster than `Simplex_tree_options_full_featured` but note the unsafe
  * `contiguous_vertices` option.
  * 
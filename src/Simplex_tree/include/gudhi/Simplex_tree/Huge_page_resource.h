@@ -0,0 +1,165 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef SIMPLEX_TREE_HUGE_PAGE_RESOURCE_H_
+#define SIMPLEX_TREE_HUGE_PAGE_RESOURCE_H_
+
+#include <sys/mman.h>  // for mmap, munmap, madvise
+#include <unistd.h>  // for sysconf, syscall
+#if defined(__linux__)
+#include <sys/syscall.h>  // for SYS_get_mempolicy, SYS_mbind
+#endif
+
+#include <cerrno>
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uintptr_t
+#include <memory_resource>
+#include <new>  // for std::bad_alloc
+#include <string>
+#include <system_error>
+
+namespace Gudhi {
+
+namespace simplex_tree {
+
+/** \brief Placement of the pages of a `Huge_page_resource` on the memory nodes of a NUMA machine. */
+enum class Page_placement {
+  /** \brief A page is placed on the node of the thread that writes it first, the default of the system. */
+  first_touch,
+  /** \brief The pages are spread round-robin on all the nodes allowed to the process, so that the passes over the
+   * tree by the threads of all the sockets, e.g. one root vertex per task, access the local and remote memory alike.
+   */
+  interleaved
+};
+
+/** \brief Memory resource whose memory is an anonymous mapping backed by transparent huge pages, for very large
+ * simplex trees.
+ *
+ * \details Given to `Simplex_tree::set_siblings_memory_resource()` for a simplex tree with
+ * `SimplexTreeOptions::pool_siblings`, it receives the buffers of the members of the `Siblings`, i.e. the nodes of the
+ * tree below the root. With pages of 2 MiB instead of 4 KiB, the traversals of a tree of hundreds of gigabytes, e.g.
+ * `Simplex_tree::complex_simplex_range()`, are not dominated by the misses of the TLB anymore.
+ *
+ * The pools of `SimplexTreeOptions::pool_siblings` are filled by one thread, so that with the first touch placement
+ * the whole tree lands on the node of this thread. The interleaved placement spreads it on all the nodes instead,
+ * which is better for the parallel passes that follow.
+ *
+ * The huge pages and the placement are advice to the system. They are only available on Linux, with transparent huge
+ * pages enabled (`madvise` or `always` in `/sys/kernel/mm/transparent_hugepage/enabled`) and a kernel with NUMA
+ * support respectively, and are silently ignored otherwise; `huge_pages()` and `interleaved()` tell if they were
+ * accepted.
+ *
+ * The memory is allocated contiguously in a range of addresses reserved at construction. The pages are only given by
+ * the system when they are written. The deallocated memory is only reused once all the memory has been deallocated,
+ * e.g. when the simplex tree is cleared.
+ *
+ * This class is only available on POSIX systems. It is not thread safe.
+ */
+class Huge_page_resource : public std::pmr::memory_resource {
+ public:
+  /** \brief Size of the huge pages, to which the memory is aligned. */
+  static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+  /** \brief Reserves the range of addresses of the memory and advises the system on its pages.
+   *
+   * @param[in] max_size Maximal size of the memory, in bytes. Only addresses are reserved, the memory is committed
+   * when it is written. Default is 1 TiB.
+   * @param[in] placement Placement of the pages on the memory nodes.
+   * @exception std::system_error If the addresses cannot be reserved.
+   */
+  explicit Huge_page_resource(std::size_t max_size = std::size_t(1) << 40,
+                              Page_placement placement = Page_placement::first_touch) {
+    reserved_ = (max_size + huge_page_size - 1) / huge_page_size * huge_page_size;
+    // Reserve one more huge page to align the beginning of the memory
+    const std::size_t mapped = reserved_ + huge_page_size;
+    void* area = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (area == MAP_FAILED) throw_system_error("cannot reserve the addresses");
+    char* begin = static_cast<char*>(area);
+    base_ = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(begin) + huge_page_size - 1) /
+                                    huge_page_size * huge_page_size);
+    if (base_ != begin) ::munmap(begin, base_ - begin);
+    if (begin + mapped != base_ + reserved_) ::munmap(base_ + reserved_, begin + mapped - (base_ + reserved_));
+#if defined(MADV_HUGEPAGE)
+    huge_pages_ = ::madvise(base_, reserved_, MADV_HUGEPAGE) == 0;
+#endif
+    if (placement == Page_placement::interleaved) interleaved_ = interleave();
+  }
+
+  Huge_page_resource(const Huge_page_resource&) = delete;
+  Huge_page_resource& operator=(const Huge_page_resource&) = delete;
+
+  ~Huge_page_resource() override { ::munmap(base_, reserved_); }
+
+  /** \brief Number of bytes in use, including the memory that was deallocated but not reused yet. */
+  std::size_t size() const { return used_; }
+
+  /** \brief True if the system accepted to back the memory with transparent huge pages. */
+  bool huge_pages() const { return huge_pages_; }
+
+  /** \brief True if the system accepted to interleave the pages on the memory nodes. */
+  bool interleaved() const { return interleaved_; }
+
+  /** \brief Frees all the memory at once and gives its pages back to the system. The memory allocated from this
+   * resource must not be used anymore, like after `std::pmr::monotonic_buffer_resource::release()`. */
+  void release() {
+    const std::size_t touched = (used_ + huge_page_size - 1) / huge_page_size * huge_page_size;
+    if (touched > 0 && ::madvise(base_, touched, MADV_DONTNEED) != 0) throw_system_error("cannot drop the pages");
+    used_ = live_ = 0;
+  }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    const std::size_t begin = (used_ + alignment - 1) / alignment * alignment;
+    if (begin + bytes > reserved_) throw std::bad_alloc();
+    used_ = begin + bytes;
+    live_ += bytes;
+    return base_ + begin;
+  }
+
+  void do_deallocate(void*, std::size_t bytes, std::size_t) override {
+    // The memory is reused once nothing is allocated anymore
+    live_ -= bytes;
+    if (live_ == 0) used_ = 0;
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  // Sets the policy of the memory to interleave its pages on the nodes allowed to the process, without libnuma
+  bool interleave() {
+#if defined(__linux__) && defined(SYS_get_mempolicy) && defined(SYS_mbind)
+    constexpr int mpol_interleave = 3;  // MPOL_INTERLEAVE of <linux/mempolicy.h>
+    constexpr unsigned long mpol_f_mems_allowed = 1UL << 2;  // MPOL_F_MEMS_ALLOWED
+    constexpr unsigned long max_nodes = 1024;
+    unsigned long nodes[max_nodes / (8 * sizeof(unsigned long))] = {};
+    if (::syscall(SYS_get_mempolicy, nullptr, nodes, max_nodes, nullptr, mpol_f_mems_allowed) != 0) return false;
+    return ::syscall(SYS_mbind, base_, reserved_, mpol_interleave, nodes, max_nodes, 0) == 0;
+#else
+    return false;
+#endif
+  }
+
+  [[noreturn]] static void throw_system_error(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), "Huge_page_resource - " + what);
+  }
+
+  char* base_;
+  std::size_t reserved_;
+  // Bytes used from base_ and bytes allocated and not deallocated
+  std::size_t used_ = 0;
+  std::size_t live_ = 0;
+  bool huge_pages_ = false;
+  bool interleaved_ = false;
+};
+
+}  // namespace simplex_tree
+
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_HUGE_PAGE_RESOURCE_H_
@@ -0,0 +1,150 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef SIMPLEX_TREE_MAPPED_FILE_RESOURCE_H_
+#define SIMPLEX_TREE_MAPPED_FILE_RESOURCE_H_
+
+#include <sys/mman.h>  // for mmap, munmap, madvise
+#include <fcntl.h>  // for open
+#include <unistd.h>  // for ftruncate, close, unlink, sysconf
+
+#include <algorithm>  // for std::max
+#include <cerrno>
+#include <cstddef>  // for std::size_t
+#include <memory_resource>
+#include <new>  // for std::bad_alloc
+#include <string>
+#include <system_error>
+
+namespace Gudhi {
+
+namespace simplex_tree {
+
+/** \brief Memory resource whose memory is a file mapped in memory, to build simplex trees larger than the memory.
+ *
+ * \details Given to `Simplex_tree::set_siblings_memory_resource()` for a simplex tree with
+ * `SimplexTreeOptions::pool_siblings`, it receives the buffers of the members of the `Siblings`, i.e. the nodes of the
+ * tree below the root. The pages of the file are then loaded by the system when the nodes are visited, and written
+ * back and dropped from memory when the memory is needed, so that the resident set of the construction, of
+ * `Simplex_tree::filtration_simplex_range()` and of the persistence is bounded by the memory of the machine, and not
+ * by the size of the tree. As the nodes are allocated in the order of their insertion, the nodes of a tree built one
+ * vertex at a time, e.g. by `Simplex_tree::expansion()`, are grouped by root vertex in the file.
+ *
+ * The memory is allocated contiguously in a range of addresses reserved at construction, in which the file is mapped
+ * as it grows. The deallocated memory is only reused once all the memory has been deallocated, e.g. when the simplex
+ * tree is cleared.
+ *
+ * This class is only available on POSIX systems. It is not thread safe.
+ */
+class Mapped_file_resource : public std::pmr::memory_resource {
+ public:
+  /** \brief Creates the file and reserves the range of addresses where it is mapped.
+   *
+   * @param[in] path Path of the file. It is truncated if it exists.
+   * @param[in] max_size Maximal size of the file, in bytes. Only addresses are reserved, the file grows with the
+   * allocations. Default is 1 TiB.
+   * @param[in] remove_file If true (the default), the file is removed from the file system at once, and its space is
+   * freed when the resource is destroyed.
+   * @exception std::system_error If the file cannot be created or mapped.
+   */
+  explicit Mapped_file_resource(const std::string& path, std::size_t max_size = std::size_t(1) << 40,
+                                bool remove_file = true)
+      : chunk_size_(std::size_t(64) << 20) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd_ < 0) throw_system_error("cannot create " + path);
+    if (remove_file) ::unlink(path.c_str());
+    const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    chunk_size_ = (chunk_size_ + page_size - 1) / page_size * page_size;
+    reserved_ = (max_size + chunk_size_ - 1) / chunk_size_ * chunk_size_;
+    void* base = ::mmap(nullptr, reserved_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+      ::close(fd_);
+      throw_system_error("cannot reserve the addresses");
+    }
+    base_ = static_cast<char*>(base);
+  }
+
+  Mapped_file_resource(const Mapped_file_resource&) = delete;
+  Mapped_file_resource& operator=(const Mapped_file_resource&) = delete;
+
+  ~Mapped_file_resource() override {
+    ::munmap(base_, reserved_);
+    ::close(fd_);
+  }
+
+  /** \brief Number of bytes of the file in use, including the memory that was deallocated but not reused yet. */
+  std::size_t size() const { return used_; }
+
+  /** \brief Drops the pages of the file from the memory of the process. They are loaded again, from the page cache or
+   * from the file, when they are accessed, e.g. to bound the resident set after building the star of a root vertex.
+   */
+  void release_resident_pages() {
+    if (mapped_ > 0 && ::madvise(base_, mapped_, MADV_DONTNEED) != 0) throw_system_error("cannot drop the pages");
+  }
+
+  /** \brief Frees all the memory at once and truncates the file. The memory allocated from this resource must not be
+   * used anymore, like after `std::pmr::monotonic_buffer_resource::release()`. */
+  void release() {
+    if (mapped_ > 0) {
+      void* none = ::mmap(base_, mapped_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0);
+      if (none == MAP_FAILED) throw_system_error("cannot unmap the file");
+      if (::ftruncate(fd_, 0) != 0) throw_system_error("cannot truncate the file");
+    }
+    mapped_ = used_ = live_ = 0;
+  }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    const std::size_t begin = (used_ + alignment - 1) / alignment * alignment;
+    if (begin + bytes > reserved_) throw std::bad_alloc();
+    if (begin + bytes > mapped_) map_until(begin + bytes);
+    used_ = begin + bytes;
+    live_ += bytes;
+    return base_ + begin;
+  }
+
+  void do_deallocate(void*, std::size_t bytes, std::size_t) override {
+    // The memory is reused once nothing is allocated anymore
+    live_ -= bytes;
+    if (live_ == 0) used_ = 0;
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  // Grows the file and its mapping by chunks, at least doubling it, until size bytes are mapped
+  void map_until(std::size_t size) {
+    std::size_t new_mapped = std::max(2 * mapped_, (size + chunk_size_ - 1) / chunk_size_ * chunk_size_);
+    if (new_mapped > reserved_) new_mapped = reserved_;
+    if (::ftruncate(fd_, static_cast<off_t>(new_mapped)) != 0) throw_system_error("cannot grow the file");
+    void* mapped = ::mmap(base_ + mapped_, new_mapped - mapped_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd_,
+                          static_cast<off_t>(mapped_));
+    if (mapped == MAP_FAILED) throw_system_error("cannot map the file");
+    mapped_ = new_mapped;
+  }
+
+  [[noreturn]] static void throw_system_error(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), "Mapped_file_resource - " + what);
+  }
+
+  int fd_;
+  char* base_;
+  std::size_t chunk_size_;
+  std::size_t reserved_;
+  // Bytes of the file mapped at base_, bytes used from base_ and bytes allocated and not deallocated
+  std::size_t mapped_ = 0;
+  std::size_t used_ = 0;
+  std::size_t live_ = 0;
+};
+
+}  // namespace simplex_tree
+
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_MAPPED_FILE_RESOURCE_H_
@@ -43,6 +43,7 @@ class Simplex_tree_siblings {
   typedef typename SimplexTree::Node Node;
   typedef MapContainer Dictionary;
   typedef typename MapContainer::iterator Dictionary_it;
+  typedef typename MapContainer::allocator_type Dictionary_allocator;
 
   /* Default constructor.*/
   Simplex_tree_siblings()
@@ -58,6 +59,13 @@ class Simplex_tree_siblings {
         members_() {
   }
 
+  /* Constructor with values, the members are allocated with 'allocator'.*/
+  Simplex_tree_siblings(Simplex_tree_siblings * oncles, Vertex_handle parent, const Dictionary_allocator & allocator)
+      : oncles_(oncles),
+        parent_(parent),
+        members_(allocator) {
+  }
+
   /** \brief Constructor with initialized set of members.
    *
    * 'members' must be sorted and unique.*/
@@ -72,6 +80,21 @@ class Simplex_tree_siblings {
     }
   }
 
+  /** \brief Constructor with initialized set of members, allocated with 'allocator'.
+   *
+   * 'members' must be sorted and unique.*/
+  template<typename RandomAccessVertexRange>
+  Simplex_tree_siblings(Simplex_tree_siblings * oncles, Vertex_handle parent, const RandomAccessVertexRange & members,
+                        const Dictionary_allocator & allocator)
+      : oncles_(oncles),
+        parent_(parent),
+        members_(boost::container::ordered_unique_range, members.begin(),
+                 members.end(), allocator) {
+    for (auto& map_el : members_) {
+      map_el.second.assign_children(this);
+    }
+  }
+
   /** \brief Inserts a Node in the set of siblings nodes.
    *
    * If already present, assigns the minimal filtration value 
@@ -100,6 +123,10 @@ class Simplex_tree_siblings {
     return members_;
   }
 
+  const Dictionary & members() const {
+    return members_;
+  }
+
   size_t size() const {
     return members_.size();
   }
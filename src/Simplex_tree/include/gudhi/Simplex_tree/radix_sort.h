@@ -0,0 +1,127 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef SIMPLEX_TREE_RADIX_SORT_H_
+#define SIMPLEX_TREE_RADIX_SORT_H_
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>  // for std::min
+#include <array>
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+#include <cstring>  // for std::memcpy
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Gudhi {
+
+namespace simplex_tree {
+
+/** @private @brief Maps a number to an unsigned integer with the same order, for `radix_sort`.
+ *
+ * Floating point values are mapped through their bit representation, negative values having all their bits flipped
+ * and the other ones only their sign bit. -0 and +0 have the same key, as they compare equal. NaN is not supported.
+ */
+template<typename T>
+std::uint64_t radix_sort_key(T value) {
+  static_assert(std::is_arithmetic_v<T> && sizeof(T) <= sizeof(std::uint64_t),
+                "Radix sort keys are only defined for arithmetic types of at most 64 bits");
+  if constexpr (std::is_floating_point_v<T>) {
+    using Bits = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+    static_assert(sizeof(T) == sizeof(Bits), "Unsupported floating point type");
+    if (value == 0) value = 0;  // -0 -> +0
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    constexpr Bits sign = Bits(1) << (8 * sizeof(Bits) - 1);
+    return (bits & sign) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | sign);
+  } else if constexpr (std::is_signed_v<T>) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(value) ^ (U(1) << (8 * sizeof(T) - 1)));
+  } else {
+    return static_cast<std::uint64_t>(value);
+  }
+}
+
+/** @private @brief Stable least significant digit radix sort of `entries` by `(entry.primary, entry.secondary)`,
+ * two `std::uint64_t` members of `Entry`.
+ *
+ * The bytes that are the same for all the entries are skipped, so that small keys (e.g. a float filtration value and
+ * a vertex handle) cost as many passes as they have significant bytes. With TBB, each pass counts and scatters blocks
+ * of entries in parallel; the blocks do not depend on the number of threads, so that the result is deterministic.
+ */
+template<class Entry>
+void radix_sort(std::vector<Entry>& entries) {
+  constexpr std::size_t num_buckets = 256;
+  const std::size_t n = entries.size();
+  if (n < 2) return;
+
+  // Bytes that are not constant over the entries
+  std::uint64_t and_primary = ~std::uint64_t(0), or_primary = 0, and_secondary = ~std::uint64_t(0), or_secondary = 0;
+  for (const Entry& e : entries) {
+    and_primary &= e.primary;
+    or_primary |= e.primary;
+    and_secondary &= e.secondary;
+    or_secondary |= e.secondary;
+  }
+  const std::uint64_t varying_primary = and_primary ^ or_primary;
+  const std::uint64_t varying_secondary = and_secondary ^ or_secondary;
+
+  const std::size_t block_size = std::max<std::size_t>(1 << 16, (n + 255) / 256);
+  const std::size_t num_blocks = (n + block_size - 1) / block_size;
+  std::vector<std::array<std::size_t, num_buckets>> offsets(num_blocks);
+  std::vector<Entry> buffer(n);
+
+  auto pass = [&](bool on_primary, int shift) {
+    auto digit = [on_primary, shift](const Entry& e) {
+      return static_cast<std::size_t>(((on_primary ? e.primary : e.secondary) >> shift) & 0xff);
+    };
+    auto for_each_block = [num_blocks](auto&& f) {
+#ifdef GUDHI_USE_TBB
+      tbb::parallel_for(std::size_t(0), num_blocks, f);
+#else
+      for (std::size_t block = 0; block < num_blocks; ++block) f(block);
+#endif
+    };
+    for_each_block([&](std::size_t block) {
+      offsets[block].fill(0);
+      const std::size_t end = std::min(n, (block + 1) * block_size);
+      for (std::size_t i = block * block_size; i < end; ++i) ++offsets[block][digit(entries[i])];
+    });
+    // Exclusive prefix sum, bucket major then block major, for stability
+    std::size_t sum = 0;
+    for (std::size_t bucket = 0; bucket < num_buckets; ++bucket) {
+      for (std::size_t block = 0; block < num_blocks; ++block) {
+        const std::size_t count = offsets[block][bucket];
+        offsets[block][bucket] = sum;
+        sum += count;
+      }
+    }
+    for_each_block([&](std::size_t block) {
+      const std::size_t end = std::min(n, (block + 1) * block_size);
+      for (std::size_t i = block * block_size; i < end; ++i) buffer[offsets[block][digit(entries[i])]++] = entries[i];
+    });
+    entries.swap(buffer);
+  };
+
+  for (int shift = 0; shift < 64; shift += 8)
+    if ((varying_secondary >> shift) & 0xff) pass(false, shift);
+  for (int shift = 0; shift < 64; shift += 8)
+    if ((varying_primary >> shift) & 0xff) pass(true, shift);
+}
+
+}  // namespace simplex_tree
+
+}  // namespace Gudhi
+
+#endif  // SIMPLEX_TREE_RADIX_SORT_H_
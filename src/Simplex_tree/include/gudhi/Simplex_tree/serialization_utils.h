@@ -13,6 +13,7 @@
 
 #include <cstring>  // for memcpy and std::size_t
 #include <iostream>
+#include <type_traits>
 
 namespace Gudhi {
 
@@ -48,6 +49,36 @@ const char* deserialize_trivial(ArgumentType& value, const char* start) {
   return (start + arg_size);
 }
 
+/** \brief Returns the number of bytes used by `serialize_value_to_char_buffer` to serialize the given value.
+ *
+ * Overloads for the filtration values that are not trivially copyable, e.g. vector-valued multi-parameter
+ * filtration values, are found by argument-dependent lookup, next to their class. They must be given together with
+ * `serialize_value_to_char_buffer` and `deserialize_value_from_char_buffer`.
+ */
+template<class ArgumentType, class = std::enable_if_t<std::is_trivially_copyable_v<ArgumentType>>>
+constexpr std::size_t get_serialization_size_of([[maybe_unused]] const ArgumentType& value) {
+  return sizeof(ArgumentType);
+}
+
+/** \brief Serialize the given value and insert it at start position, cf. `serialize_trivial`.
+ * 
+ * @return The new position in the array of char for the next serialization.
+ */
+template<class ArgumentType, class = std::enable_if_t<std::is_trivially_copyable_v<ArgumentType>>>
+char* serialize_value_to_char_buffer(const ArgumentType& value, char* start) {
+  return serialize_trivial(value, start);
+}
+
+/** \brief Deserialize at the start position in an array of char and sets the value with it,
+ * cf. `deserialize_trivial`.
+ * 
+ * @return The new position in the array of char for the next deserialization.
+ */
+template<class ArgumentType, class = std::enable_if_t<std::is_trivially_copyable_v<ArgumentType>>>
+const char* deserialize_value_from_char_buffer(ArgumentType& value, const char* start) {
+  return deserialize_trivial(value, start);
+}
+
 }  // namespace simplex_tree
 
 }  // namespace Gudhi
@@ -0,0 +1,223 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// Allocation budgets of the traversals of a simplex tree, and of the projections of a multi-parameter simplex tree
+// (src/python/include/Simplex_tree_multi.h). Only built with the cmake option WITH_GUDHI_ALLOCATION_TESTS.
+
+#include <cmath>  // for std::abs
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simplex_tree_allocations"
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <gudhi/Allocation_counter.h>
+#include <gudhi/Simplex_tree.h>
+
+#include "Simplex_tree_multi.h"
+
+GUDHI_COUNT_ALLOCATIONS();
+
+using namespace Gudhi;
+
+using Simplex_tree_multi = Simplex_tree<multiparameter::options_multi>;
+using value_type = multiparameter::options_multi::value_type;
+
+typedef boost::mpl::list<Simplex_tree<>,
+                         Simplex_tree<Simplex_tree_options_fast_persistence>,
+                         Simplex_tree<Simplex_tree_options_fast_cofaces>> list_of_tested_variants;
+
+// Random graph on 100 vertices with about 1000 edges
+std::vector<std::vector<int>> random_edges() {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> vertex(0, 99);
+  std::vector<std::vector<int>> edges;
+  for (int i = 0; i < 1000; i++) {
+    int u = vertex(gen), v = vertex(gen);
+    if (u != v) edges.push_back({u, v});
+  }
+  return edges;
+}
+
+template <class Stree>
+Stree random_flag_complex() {
+  std::mt19937 gen(8);
+  std::uniform_real_distribution<double> dist(0, 1);
+  Stree st;
+  for (const auto& edge : random_edges()) st.insert_simplex_and_subfaces(edge, dist(gen));
+  st.expansion(3);
+  st.make_filtration_non_decreasing();
+  return st;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_traversals, Stree, list_of_tested_variants) {
+  Stree st = random_flag_complex<Stree>();
+  st.initialize_filtration();
+  std::size_t sum = 0;
+  Gudhi::allocation_counter::Scope scope;
+  for (auto sh : st.complex_simplex_range())
+    for (auto v : st.simplex_vertex_range(sh)) sum += v;
+  for (auto sh : st.skeleton_simplex_range(2))
+    for (auto b : st.boundary_simplex_range(sh)) sum += st.dimension(b);
+  for (auto sh : st.filtration_simplex_range()) sum += st.dimension(sh);
+  BOOST_CHECK_EQUAL(scope.allocations(), 0u);
+  BOOST_CHECK(sum > 0);
+}
+
+Simplex_tree_multi random_multi_flag_complex(int num_parameters) {
+  std::mt19937 gen(9);
+  std::uniform_real_distribution<value_type> dist(0, 1);
+  Simplex_tree_multi st;
+  st.set_number_of_parameters(num_parameters);
+  auto filtration = [&] {
+    std::vector<value_type> f(num_parameters);
+    for (auto& x : f) x = dist(gen);
+    return Simplex_tree_multi::Filtration_value(f);
+  };
+  for (int v = 0; v < 100; v++) st.insert_simplex({v}, filtration());
+  for (const auto& edge : random_edges()) st.insert_simplex(edge, filtration());
+  st.expansion(3);
+  st.make_filtration_non_decreasing();
+  return st;
+}
+
+BOOST_AUTO_TEST_CASE(line_push_forward) {
+  multiparameter::multi_filtrations::Line<value_type> line({-0.5, 0, 0.25});
+  Simplex_tree_multi st = random_multi_flag_complex(3);
+  value_type sum = 0;
+  Gudhi::allocation_counter::Scope scope;
+  for (auto sh : st.complex_simplex_range()) sum += line.push_forward_coordinate(st.filtration(sh), 1);
+  BOOST_CHECK_EQUAL(scope.allocations(), 0u);
+  BOOST_CHECK(sum > 0);
+}
+
+// The projections on a line allocate no more than the insertion of the same simplices in a 1-parameter simplex tree,
+// i.e. nothing per simplex on top of the nodes of the tree, up to a few buffers.
+BOOST_AUTO_TEST_CASE(flatten_budget) {
+  Simplex_tree_multi st_multi = random_multi_flag_complex(2);
+  std::vector<std::vector<int>> simplices;
+  for (auto sh : st_multi.complex_simplex_range()) {
+    auto vertices = st_multi.simplex_vertex_range(sh);
+    simplices.emplace_back(vertices.begin(), vertices.end());
+  }
+
+  Gudhi::allocation_counter::Scope scope;
+  {
+    Simplex_tree<> st;
+    for (const auto& simplex : simplices) st.insert_simplex(simplex, 0.);
+  }
+  const std::size_t budget = scope.allocations() + 8;
+
+  std::size_t num_simplices = 0;
+  scope.restart();
+  {
+    Simplex_tree<> st;
+    multiparameter::flatten(st, st_multi, 1);
+    num_simplices = st.num_simplices();
+  }
+  BOOST_CHECK_LE(scope.allocations(), budget);
+  BOOST_CHECK_EQUAL(num_simplices, st_multi.num_simplices());
+
+  std::vector<value_type> basepoint{-0.5, 0};
+  scope.restart();
+  {
+    Simplex_tree<> st;
+    multiparameter::flatten_diag(st, st_multi, basepoint, 0);
+    num_simplices = st.num_simplices();
+  }
+  BOOST_CHECK_LE(scope.allocations(), budget);
+  BOOST_CHECK_EQUAL(num_simplices, st_multi.num_simplices());
+}
+
+// Squeezing on a grid allocates no more than the insertion of the same simplices in a multi-parameter simplex tree,
+// i.e. one buffer of coordinates per simplex, like the float filtration values, and reading them allocates nothing.
+BOOST_AUTO_TEST_CASE(squeeze_to_coordinates_budget) {
+  using Simplex_tree_coordinates = Simplex_tree<multiparameter::options_multi_coordinates<std::int16_t>>;
+  Simplex_tree_multi st_multi = random_multi_flag_complex(2);
+  std::vector<std::vector<int>> simplices;
+  for (auto sh : st_multi.complex_simplex_range()) {
+    auto vertices = st_multi.simplex_vertex_range(sh);
+    simplices.emplace_back(vertices.begin(), vertices.end());
+  }
+  multiparameter::multi_filtration_grid grid(2);
+  for (int i = 0; i <= 100; i++)
+    for (auto& filtration : grid) filtration.push_back(static_cast<value_type>(i) / 100);
+
+  Gudhi::allocation_counter::Scope scope;
+  {
+    Simplex_tree_multi st;
+    st.set_number_of_parameters(2);
+    Simplex_tree_multi::Filtration_value filtration(2);
+    for (const auto& simplex : simplices) st.insert_simplex(simplex, filtration);
+  }
+  const std::size_t budget = scope.allocations() + 16;
+
+  Simplex_tree_coordinates st_coordinates;
+  scope.restart();
+  multiparameter::squeeze_to_coordinates(st_multi, st_coordinates, grid);
+  BOOST_CHECK_LE(scope.allocations(), budget);
+  BOOST_CHECK_EQUAL(st_coordinates.num_simplices(), st_multi.num_simplices());
+
+  long sum = 0;
+  scope.restart();
+  for (auto sh : st_coordinates.complex_simplex_range()) {
+    const auto& coordinates = st_coordinates.filtration(sh);
+    sum += coordinates[0] + coordinates[1];
+  }
+  BOOST_CHECK_EQUAL(scope.allocations(), 0u);
+  BOOST_CHECK(sum > 0);
+
+  scope.restart();
+  {
+    Simplex_tree_multi st;
+    multiparameter::unsqueeze_from_coordinates(st_coordinates, st, grid);
+  }
+  BOOST_CHECK_LE(scope.allocations(), budget);
+}
+
+// With a number of parameters fixed at compile time, the coordinates are stored in the nodes: squeezing only allocates
+// the structure of the tree, as a copy of a simplex tree with inline filtration values does.
+BOOST_AUTO_TEST_CASE(squeeze_to_inline_coordinates_budget) {
+  using Simplex_tree_coordinates = Simplex_tree<multiparameter::options_multi_coordinates<std::int16_t, 2>>;
+  Simplex_tree_multi st_multi = random_multi_flag_complex(2);
+  Simplex_tree<multiparameter::options_multi_fixed<2>> st;
+  for (auto sh : st_multi.complex_simplex_range()) st.insert_simplex(st_multi.simplex_vertex_range(sh), {0., 0.});
+  multiparameter::multi_filtration_grid grid(2);
+  for (int i = 0; i <= 100; i++)
+    for (auto& filtration : grid) filtration.push_back(static_cast<value_type>(i) / 100);
+
+  Gudhi::allocation_counter::Scope scope;
+  {
+    Simplex_tree<multiparameter::options_multi_fixed<2>> copy(st);
+  }
+  const std::size_t budget = scope.allocations() + 16;
+
+  Simplex_tree_coordinates st_coordinates;
+  scope.restart();
+  multiparameter::squeeze_to_coordinates(st_multi, st_coordinates, grid);
+  BOOST_CHECK_LE(scope.allocations(), budget);
+  BOOST_CHECK_EQUAL(st_coordinates.num_simplices(), st_multi.num_simplices());
+  BOOST_CHECK(st_coordinates.get_number_of_parameters() == 2);
+  static_assert(sizeof(Simplex_tree_coordinates::Filtration_value) == 2 * sizeof(std::int16_t));
+
+  Simplex_tree_multi unsqueezed;
+  multiparameter::unsqueeze_from_coordinates(st_coordinates, unsqueezed, grid);
+  BOOST_CHECK_EQUAL(unsqueezed.num_simplices(), st_multi.num_simplices());
+  for (auto sh : st_multi.complex_simplex_range()) {
+    const auto& filtration = st_multi.filtration(sh);
+    const auto& unsqueezed_filtration = unsqueezed.filtration(unsqueezed.find(st_multi.simplex_vertex_range(sh)));
+    for (int parameter = 0; parameter < 2; parameter++)
+      BOOST_CHECK_LE(std::abs(unsqueezed_filtration[parameter] - filtration[parameter]), 0.01 + 1e-5);
+  }
+}
@@ -0,0 +1,102 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simplex_tree_cancellation"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Cancellation.h>
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Persistent_matrix_reduction.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+using Simplex_tree = Gudhi::Simplex_tree<>;
+using Field_Zp = Gudhi::persistent_cohomology::Field_Zp;
+using Diagram = std::vector<std::pair<double, double>>;
+
+// Random graph with many triangles and tetrahedra
+Simplex_tree random_graph() {
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> filtration(0., 1.);
+  std::bernoulli_distribution has_edge(0.4);
+  Simplex_tree st;
+  const int n = 40;
+  for (int u = 0; u < n; ++u) st.insert_simplex({u}, 0.);
+  for (int u = 0; u < n; ++u)
+    for (int v = u + 1; v < n; ++v)
+      if (has_edge(gen)) st.insert_simplex({u, v}, filtration(gen));
+  return st;
+}
+
+// The sorted intervals of all the dimensions
+template <class Persistence>
+Diagram diagram(Simplex_tree& st) {
+  Persistence pcoh(st);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  Diagram diagram;
+  for (int dim = 0; dim < st.dimension(); ++dim)
+    for (const auto& interval : pcoh.intervals_in_dimension(dim)) diagram.push_back(interval);
+  std::sort(diagram.begin(), diagram.end());
+  return diagram;
+}
+
+BOOST_AUTO_TEST_CASE(cancelled_expansion) {
+  Simplex_tree graph = random_graph();
+  Simplex_tree expected = graph;
+  expected.expansion(4);
+
+  Gudhi::Cancellation_flag flag;
+  Simplex_tree st = graph;
+  {
+    Gudhi::Cancellation_scope scope(&flag);
+    st.expansion(4);
+  }
+  // A flag that is not raised does not change the expansion
+  BOOST_CHECK(st == expected);
+
+  flag.cancel();
+  st = graph;
+  {
+    Gudhi::Cancellation_scope scope(&flag);
+    BOOST_CHECK_THROW(st.expansion(4), Gudhi::Cancelled);
+  }
+  // The expansion is rolled back
+  BOOST_CHECK(st == graph);
+  BOOST_CHECK(st.dimension() == 1);
+  // The scope is over
+  BOOST_CHECK(Gudhi::current_cancellation_flag() == nullptr);
+  st.expansion(4);
+  BOOST_CHECK(st == expected);
+}
+
+BOOST_AUTO_TEST_CASE(cancelled_persistence) {
+  Simplex_tree st = random_graph();
+  st.expansion(3);
+  using Cohomology = Gudhi::persistent_cohomology::Persistent_cohomology<Simplex_tree, Field_Zp>;
+  using Reduction = Gudhi::persistent_cohomology::Persistent_matrix_reduction<Simplex_tree, Field_Zp>;
+  const Diagram expected = diagram<Cohomology>(st);
+
+  Gudhi::Cancellation_flag flag;
+  {
+    Gudhi::Cancellation_scope scope(&flag);
+    BOOST_CHECK(diagram<Cohomology>(st) == expected);
+    BOOST_CHECK(diagram<Reduction>(st) == expected);
+    flag.cancel();
+    BOOST_CHECK_THROW(diagram<Cohomology>(st), Gudhi::Cancelled);
+    BOOST_CHECK_THROW(diagram<Reduction>(st), Gudhi::Cancelled);
+  }
+  BOOST_CHECK(diagram<Cohomology>(st) == expected);
+}
@@ -39,10 +39,20 @@ struct Simplex_tree_options_stable_simplex_handles {
   static const bool is_multi_parameter = false;
 };
 
+struct Simplex_tree_options_pool_siblings : Simplex_tree_options_full_featured {
+  static const bool pool_siblings = true;
+};
+
+struct Simplex_tree_options_stable_pool_siblings : Simplex_tree_options_stable_simplex_handles {
+  static const bool pool_siblings = true;
+};
+
 typedef boost::mpl::list<Simplex_tree<>,
                          Simplex_tree<Simplex_tree_options_fast_persistence>,
                          Simplex_tree<Simplex_tree_options_fast_cofaces>,
-                         Simplex_tree<Simplex_tree_options_stable_simplex_handles> > list_of_tested_variants;
+                         Simplex_tree<Simplex_tree_options_stable_simplex_handles>,
+                         Simplex_tree<Simplex_tree_options_pool_siblings>,
+                         Simplex_tree<Simplex_tree_options_stable_pool_siblings> > list_of_tested_variants;
 
 template<typename Simplex_tree>
 void print_simplex_filtration(Simplex_tree& st, const std::string& msg) {
@@ -180,6 +190,41 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_copy_constructor, Simplex_tree, list_of_te
 
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_copy_constructor_from_other_options, Simplex_tree, list_of_tested_variants) {
+  Simplex_tree_options_full_featured::Filtration_value shift = 10.;
+  Gudhi::Simplex_tree<> st;
+
+  st.insert_simplex_and_subfaces({2, 1, 0}, 3.0);
+  st.insert_simplex_and_subfaces({0, 1, 6, 7}, 4.0);
+  st.insert_simplex_and_subfaces({3, 0}, 2.0);
+  st.insert_simplex_and_subfaces({3, 4, 5}, 3.0);
+  st.insert_simplex_and_subfaces({8}, 1.0);
+
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "TEST OF COPY CONSTRUCTOR FROM OTHER OPTIONS" << std::endl;
+
+  Simplex_tree st1(st, [shift](double filtration) { return filtration + shift; });
+  print_simplex_filtration(st1, "Copy constructor from the default Simplex_tree with shifted filtration values");
+
+  BOOST_CHECK(st1.num_simplices() == st.num_simplices());
+  BOOST_CHECK(st1.dimension() == st.dimension());
+  for (auto sh : st.complex_simplex_range()) {
+    auto sh1 = st1.find(st.simplex_vertex_range(sh));
+    BOOST_CHECK(sh1 != st1.null_simplex());
+    BOOST_CHECK(st1.filtration(sh1) == st.filtration(sh) + shift);
+  }
+  st1.assign_filtration(st1.find({8}), 1.0);
+  st1.insert_simplex_and_subfaces({8, 9}, 20.0);
+  BOOST_CHECK(st1.num_simplices() == st.num_simplices() + 2);
+
+  // Back to the default Simplex_tree
+  Gudhi::Simplex_tree<> st2(st1, [shift](typename Simplex_tree::Filtration_value filtration) { return filtration - shift; });
+  st2.remove_maximal_simplex(st2.find({8, 9}));
+  st2.remove_maximal_simplex(st2.find({9}));
+  st2.assign_filtration(st2.find({8}), 1.0);
+  BOOST_CHECK(st2 == st);
+}
+
 template<typename Simplex_tree>
 std::vector<std::vector<typename Simplex_tree::Vertex_handle>> get_star(Simplex_tree& st) {
   std::vector<std::vector<typename Simplex_tree::Vertex_handle>> output;
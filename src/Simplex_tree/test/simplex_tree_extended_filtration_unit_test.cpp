@@ -10,6 +10,8 @@
 
 #include <iostream>
 #include <cstdint>  // for std::uint8_t
+#include <random>
+#include <vector>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "simplex_tree_extended_filtration"
@@ -25,7 +27,8 @@ struct Low_options : Gudhi::Simplex_tree_options_full_featured {
 };
 
 typedef boost::mpl::list<Gudhi::Simplex_tree<>,
-                         Gudhi::Simplex_tree<Low_options>> list_of_tested_variants;
+                         Gudhi::Simplex_tree<Low_options>,
+                         Gudhi::Simplex_tree<Gudhi::Simplex_tree_options_fast_cofaces>> list_of_tested_variants;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(basic_simplex_tree_extend_filtration, Stree, list_of_tested_variants) {
   std::clog << "********************************************************************" << std::endl;
@@ -243,4 +246,59 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_extend_same_filtration, Stree, list_o
   std::clog << filt << " - " << static_cast<int>(est) << std::endl;
   BOOST_CHECK(std::isnan(filt));
   BOOST_CHECK(est == Gudhi::Extended_simplex_type::EXTRA);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_extend_filtration_same_as_cone, Stree, list_of_tested_variants) {
+  // The extended filtration is built in place, it must be the cone built with insert_simplex and
+  // make_filtration_non_decreasing
+  using Vertex_handle = typename Stree::Vertex_handle;
+  using Filtration_value = typename Stree::Filtration_value;
+  std::mt19937 gen(17);
+  std::uniform_int_distribution<int> vertex(0, 19);
+  std::uniform_real_distribution<double> value(-5., 5.);
+  Stree st;
+  for (int i = 0; i < 40; ++i) {
+    std::vector<Vertex_handle> simplex{static_cast<Vertex_handle>(vertex(gen)), static_cast<Vertex_handle>(vertex(gen)),
+                                       static_cast<Vertex_handle>(vertex(gen))};
+    st.insert_simplex_and_subfaces(simplex, static_cast<Filtration_value>(value(gen)));
+  }
+  for (auto sh : st.skeleton_simplex_range(0))
+    if (st.dimension(sh) == 0) st.assign_filtration(sh, static_cast<Filtration_value>(value(gen)));
+
+  Stree expected = st;
+  Vertex_handle cone = 20;
+  Filtration_value minval = std::numeric_limits<Filtration_value>::infinity();
+  Filtration_value maxval = -minval;
+  for (auto sh : expected.skeleton_simplex_range(0)) {
+    if (expected.dimension(sh) != 0) continue;
+    minval = std::min(minval, expected.filtration(sh));
+    maxval = std::max(maxval, expected.filtration(sh));
+  }
+  Stree copy = st;
+  expected.insert_simplex({cone}, -3);
+  for (auto sh_copy : copy.complex_simplex_range()) {
+    std::vector<Vertex_handle> vr(copy.simplex_vertex_range(sh_copy).begin(), copy.simplex_vertex_range(sh_copy).end());
+    auto sh = expected.find(vr);
+    vr.push_back(cone);
+    if (expected.dimension(sh) == 0) {
+      Filtration_value scaled_v = (expected.filtration(sh) - minval) / (maxval - minval);
+      expected.assign_filtration(sh, -2 + scaled_v);
+      expected.insert_simplex(vr, 2 - scaled_v);
+    } else {
+      expected.assign_filtration(sh, -3);
+      expected.insert_simplex(vr, -3);
+    }
+  }
+  expected.make_filtration_non_decreasing();
+
+  auto efd = st.extend_filtration();
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(efd.minval, minval);
+  GUDHI_TEST_FLOAT_EQUALITY_CHECK(efd.maxval, maxval);
+  BOOST_CHECK(st.num_simplices() == expected.num_simplices());
+  BOOST_CHECK(st.dimension() == expected.dimension());
+  for (auto sh : expected.complex_simplex_range()) {
+    auto st_sh = st.find(expected.simplex_vertex_range(sh));
+    BOOST_REQUIRE(st_sh != st.null_simplex());
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(st.filtration(st_sh), expected.filtration(sh));
+  }
+}
@@ -0,0 +1,151 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>  // for std::sort, std::includes
+#include <cstdint>  // for std::uint8_t
+#include <stdexcept>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simplex_tree_frozen"
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Frozen_simplex_tree.h>
+#include <gudhi/Flat_simplex_tree.h>  // for get_flat_serialization_size
+#include <gudhi/Unitary_tests_utils.h>  // for GUDHI_TEST_FLOAT_EQUALITY_CHECK
+#include "Simplex_tree_multi.h"  // for the multi-parameter options, from src/python/include
+
+using namespace Gudhi;
+
+struct Low_options : Gudhi::Simplex_tree_options_full_featured {
+  static const bool store_filtration = false;
+  typedef std::uint8_t Vertex_handle;
+};
+
+typedef boost::mpl::list<Simplex_tree<>,
+                         Simplex_tree<Simplex_tree_options_fast_persistence>,
+                         Simplex_tree<Low_options>,
+                         Simplex_tree<Simplex_tree_options_fast_cofaces>> list_of_tested_variants;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_freeze, Stree, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "FROZEN SIMPLEX TREE" << std::endl;
+  using Vertex_type = typename Stree::Vertex_handle;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> vertex(0, 20);
+  std::uniform_real_distribution<double> value(0., 1.);
+  Stree st;
+  for (int i = 0; i < 60; ++i)
+    st.insert_simplex_and_subfaces({static_cast<Vertex_type>(vertex(gen)), static_cast<Vertex_type>(vertex(gen)),
+                                    static_cast<Vertex_type>(vertex(gen)), static_cast<Vertex_type>(vertex(gen))});
+  if constexpr (Stree::Options::store_filtration) {
+    for (auto sh : st.complex_simplex_range()) st.assign_filtration(sh, value(gen));
+    st.make_filtration_non_decreasing();
+  }
+
+  auto frozen = simplex_tree::freeze(st);
+  BOOST_CHECK(frozen.num_simplices() == st.num_simplices());
+  BOOST_CHECK(frozen.num_vertices() == st.num_vertices());
+  BOOST_CHECK(frozen.dimension() == st.dimension());
+  BOOST_CHECK(frozen.num_parameters() == (Stree::Options::store_filtration ? 1u : 0u));
+  std::clog << "Frozen size in bytes = " << frozen.memory_size() << " - flat serialization size in bytes = "
+            << simplex_tree::get_flat_serialization_size(st) << std::endl;
+  BOOST_CHECK(frozen.memory_size() < simplex_tree::get_flat_serialization_size(st));
+
+  auto vertices = [](auto&& range) {
+    std::vector<Vertex_type> simplex(std::begin(range), std::end(range));
+    std::sort(simplex.begin(), simplex.end());
+    return simplex;
+  };
+  std::clog << "Same filtration order, vertices, filtration values, boundaries and cofaces" << std::endl;
+  auto frozen_sh = frozen.filtration_simplex_range().begin();
+  for (auto sh : st.filtration_simplex_range()) {
+    auto simplex = vertices(st.simplex_vertex_range(sh));
+    BOOST_CHECK(frozen.simplex_vertices(*frozen_sh) == simplex);
+    BOOST_CHECK(frozen.dimension(*frozen_sh) == st.dimension(sh));
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(frozen.filtration(*frozen_sh), st.filtration(sh));
+    BOOST_CHECK(frozen.find(st.simplex_vertex_range(sh)) == *frozen_sh);
+
+    auto facets = frozen.boundary(*frozen_sh);
+    BOOST_CHECK(facets.size() == (st.dimension(sh) > 0 ? simplex.size() : 0u));
+    auto facet = facets.begin();
+    for (auto st_facet : st.boundary_simplex_range(sh))
+      BOOST_CHECK(frozen.simplex_vertices(*facet++) == vertices(st.simplex_vertex_range(st_facet)));
+    if (st.dimension(sh) > 0) BOOST_CHECK(facets.front() == frozen.parent(*frozen_sh));
+
+    for (int codimension = 0; codimension < 3; codimension++) {
+      std::vector<std::vector<Vertex_type>> cofaces, frozen_cofaces;
+      for (auto coface : st.complex_simplex_range()) {
+        auto coface_vertices = vertices(st.simplex_vertex_range(coface));
+        if ((codimension == 0 || st.dimension(coface) == st.dimension(sh) + codimension) &&
+            std::includes(coface_vertices.begin(), coface_vertices.end(), simplex.begin(), simplex.end()))
+          cofaces.push_back(coface_vertices);
+      }
+      for (auto coface : frozen.cofaces(*frozen_sh, codimension))
+        frozen_cofaces.push_back(frozen.simplex_vertices(coface));
+      std::sort(cofaces.begin(), cofaces.end());
+      std::sort(frozen_cofaces.begin(), frozen_cofaces.end());
+      BOOST_CHECK(frozen_cofaces == cofaces);
+    }
+    ++frozen_sh;
+  }
+  BOOST_CHECK(frozen.find({21}) == frozen.null_simplex());
+  BOOST_CHECK(frozen.parent(*frozen.filtration_simplex_range().begin()) == frozen.null_simplex());
+
+  std::clog << "Too many simplices for the index type" << std::endl;
+  BOOST_CHECK_THROW(simplex_tree::freeze<std::uint8_t>(st), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_freeze_empty, Stree, list_of_tested_variants) {
+  Stree st;
+  auto frozen = simplex_tree::freeze(st);
+  BOOST_CHECK(frozen.num_simplices() == 0);
+  BOOST_CHECK(frozen.num_vertices() == 0);
+  BOOST_CHECK(frozen.dimension() == -1);
+  BOOST_CHECK(frozen.filtration_simplex_range().empty());
+  BOOST_CHECK(frozen.find({0}) == frozen.null_simplex());
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_freeze_multi_parameter) {
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  using Value = multiparameter::options_multi::value_type;
+  Stree st;
+  st.set_number_of_parameters(2);
+  // Lower star filtration of random grades on few values, with many ties and incomparable grades
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> vertex(0, 11), grade(0, 3);
+  std::vector<Stree::Filtration_value> grades(12);
+  for (auto& g : grades) g = Stree::Filtration_value{static_cast<Value>(grade(gen)), static_cast<Value>(grade(gen))};
+  for (int i = 0; i < 40; ++i) st.insert_simplex_and_subfaces({vertex(gen), vertex(gen), vertex(gen), vertex(gen)});
+  for (auto sh : st.complex_simplex_range()) {
+    Stree::Filtration_value f{0, 0};
+    for (auto v : st.simplex_vertex_range(sh)) f.push_to(grades[v]);
+    st.assign_filtration(sh, f);
+  }
+
+  auto frozen = simplex_tree::freeze(st);
+  BOOST_CHECK(frozen.num_parameters() == 2);
+  std::vector<std::size_t> position(frozen.num_simplices());
+  std::size_t i = 0;
+  for (auto sh : frozen.filtration_simplex_range()) position[sh] = i++;
+  BOOST_CHECK(i == st.num_simplices());
+  for (auto sh : st.complex_simplex_range()) {
+    auto frozen_sh = frozen.find(st.simplex_vertex_range(sh));
+    BOOST_REQUIRE(frozen_sh != frozen.null_simplex());
+    const auto& f = st.filtration(sh);
+    BOOST_CHECK(std::equal(f.begin(), f.end(), frozen.filtration_values(frozen_sh)));
+    for (auto face : st.boundary_simplex_range(sh))
+      BOOST_CHECK(position[frozen.find(st.simplex_vertex_range(face))] < position[frozen_sh]);
+  }
+}
@@ -10,6 +10,7 @@
 
 #include <iostream>
 #include <vector>
+#include <random>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "simplex_tree_graph_expansion"
@@ -365,3 +366,202 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_expansion_2, typeST, list_of_tested_v
                                                           static_cast<typename typeST::Filtration_value>(5.));
   BOOST_CHECK(simplex_tree.find({0,1,2,3}) == simplex_tree.null_simplex());
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_expansion_large_graph, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************\n";
+  std::clog << "simplex_tree_expansion_large_graph\n";
+  std::clog << "********************************************************************\n";
+  // Enough vertices for the root subtrees to be expanded by several threads with TBB.
+  typeST simplex_tree;
+  std::mt19937 gen(12);
+  std::uniform_real_distribution<double> dist(0., 1.);
+  const int num_vertices = 300;
+  for (int u = 0; u < num_vertices; u++) {
+    simplex_tree.insert_simplex({u}, 0.);
+    for (int v = u + 1; v < num_vertices; v++)
+      if (dist(gen) < 0.1) simplex_tree.insert_simplex({u, v}, dist(gen));
+  }
+  typeST stree_copy = simplex_tree;
+
+  simplex_tree.expansion(4);
+  // Sequential reference
+  stree_copy.expansion_with_blockers(4, [](typename typeST::Simplex_handle) { return false; });
+
+  std::clog << "* The complex contains " << simplex_tree.num_simplices() << " simplices";
+  std::clog << " - dimension " << simplex_tree.dimension() << "\n";
+  BOOST_CHECK(simplex_tree == stree_copy);
+  BOOST_CHECK(simplex_tree.dimension() == stree_copy.dimension());
+  // Uses the lists of nodes with the same label, when they are available.
+  for (auto v : simplex_tree.complex_vertex_range()) {
+    BOOST_CHECK(boost::distance(simplex_tree.cofaces_simplex_range(simplex_tree.find({v}), 0)) ==
+                boost::distance(stree_copy.cofaces_simplex_range(stree_copy.find({v}), 0)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_expansion_with_monotone_blockers, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************\n";
+  std::clog << "simplex_tree_expansion_with_monotone_blockers\n";
+  std::clog << "********************************************************************\n";
+  using Simplex_handle = typename typeST::Simplex_handle;
+  typeST simplex_tree;
+  std::mt19937 gen(13);
+  std::uniform_real_distribution<double> dist(0., 1.);
+  const int num_vertices = 300;
+  std::vector<double> weight(num_vertices);
+  for (int u = 0; u < num_vertices; u++) {
+    weight[u] = dist(gen);
+    simplex_tree.insert_simplex({u}, 0.);
+    for (int v = u + 1; v < num_vertices; v++)
+      if (dist(gen) < 0.15) simplex_tree.insert_simplex({u, v}, dist(gen));
+  }
+  typeST stree_copy = simplex_tree;
+
+  // Blocks a simplex born after the weight of one of its vertices, like Sparse_rips_complex
+  auto block = [&weight](typeST& st) {
+    return [&weight, &st](Simplex_handle sh) {
+      for (auto v : st.simplex_vertex_range(sh))
+        if (weight[v] < st.filtration(sh)) return true;
+      return false;
+    };
+  };
+  simplex_tree.expansion_with_monotone_blockers(4, block(simplex_tree));
+  stree_copy.expansion_with_blockers(4, block(stree_copy));
+
+  std::clog << "* The complex contains " << simplex_tree.num_simplices() << " simplices";
+  std::clog << " - dimension " << simplex_tree.dimension() << "\n";
+  BOOST_CHECK(simplex_tree == stree_copy);
+  BOOST_CHECK(simplex_tree.dimension() == stree_copy.dimension());
+  for (auto v : simplex_tree.complex_vertex_range()) {
+    BOOST_CHECK(boost::distance(simplex_tree.cofaces_simplex_range(simplex_tree.find({v}), 0)) ==
+                boost::distance(stree_copy.cofaces_simplex_range(stree_copy.find({v}), 0)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_expansion_with_blockers_and_candidate_filter, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************\n";
+  std::clog << "simplex_tree_expansion_with_blockers_and_candidate_filter\n";
+  std::clog << "********************************************************************\n";
+  using Simplex_handle = typename typeST::Simplex_handle;
+  using Vertex_handle = typename typeST::Vertex_handle;
+  typeST simplex_tree;
+  std::mt19937 gen(14);
+  std::uniform_real_distribution<double> dist(0., 1.);
+  const int num_vertices = 100;
+  std::vector<double> weight(num_vertices);
+  for (int u = 0; u < num_vertices; u++) {
+    weight[u] = dist(gen);
+    simplex_tree.insert_simplex({u}, 0.);
+    for (int v = u + 1; v < num_vertices; v++)
+      if (dist(gen) < 0.3) simplex_tree.insert_simplex({u, v}, dist(gen));
+  }
+  typeST stree_copy = simplex_tree;
+
+  auto block = [&weight](typeST& st) {
+    return [&weight, &st](Simplex_handle sh) {
+      for (auto v : st.simplex_vertex_range(sh))
+        if (weight[v] < st.filtration(sh)) return true;
+      return false;
+    };
+  };
+  // Necessary condition for the blocker to accept the candidate, as the filtration value of the candidate is at least
+  // the one of sh
+  std::size_t num_skipped = 0;
+  simplex_tree.expansion_with_blockers(4, block(simplex_tree), [&](Simplex_handle sh, Vertex_handle v) {
+    bool skip = weight[v] < simplex_tree.filtration(sh);
+    num_skipped += skip;
+    return skip;
+  });
+  stree_copy.expansion_with_blockers(4, block(stree_copy));
+
+  std::clog << "* The complex contains " << simplex_tree.num_simplices() << " simplices, " << num_skipped
+            << " candidates were skipped\n";
+  BOOST_CHECK(num_skipped > 0);
+  BOOST_CHECK(simplex_tree == stree_copy);
+  BOOST_CHECK(simplex_tree.dimension() == stree_copy.dimension());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_expansion_with_budget, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************\n";
+  std::clog << "simplex_tree_expansion_with_budget\n";
+  std::clog << "********************************************************************\n";
+  typeST graph;
+  std::mt19937 gen(14);
+  std::uniform_real_distribution<double> dist(0., 1.);
+  const int num_vertices = 200;
+  for (int u = 0; u < num_vertices; u++) {
+    graph.insert_simplex({u}, 0.);
+    for (int v = u + 1; v < num_vertices; v++)
+      if (dist(gen) < 0.15) graph.insert_simplex({u, v}, dist(gen));
+  }
+  typeST reference = graph;
+  reference.expansion(4);
+
+  // A large enough budget gives the expansion
+  typeST simplex_tree = graph;
+  typename typeST::Expansion_budget budget;
+  budget.max_num_simplices = reference.num_simplices();
+  BOOST_CHECK(simplex_tree.expansion_with_budget(4, budget));
+  BOOST_CHECK(simplex_tree == reference);
+  BOOST_CHECK(simplex_tree.dimension() == reference.dimension());
+
+  // Otherwise the expansion stops within the budget, and the complex is a simplicial complex
+  auto check_closed = [](typeST& st) {
+    for (auto sh : st.complex_simplex_range())
+      for (auto b : st.boundary_simplex_range(sh)) {
+        std::vector<int> facet(st.simplex_vertex_range(b).begin(), st.simplex_vertex_range(b).end());
+        BOOST_CHECK(st.find(facet) != st.null_simplex());
+      }
+  };
+  simplex_tree = graph;
+  budget.max_num_simplices = (graph.num_simplices() + reference.num_simplices()) / 2;
+  BOOST_CHECK(!simplex_tree.expansion_with_budget(4, budget));
+  std::clog << "* The complex contains " << simplex_tree.num_simplices() << " simplices";
+  std::clog << " - dimension " << simplex_tree.dimension() << "\n";
+  BOOST_CHECK(simplex_tree.num_simplices() <= budget.max_num_simplices);
+  BOOST_CHECK(simplex_tree.num_simplices() > graph.num_simplices());
+  BOOST_CHECK(simplex_tree.dimension() <= 4);
+  check_closed(simplex_tree);
+
+  simplex_tree = graph;
+  budget = typename typeST::Expansion_budget();
+  budget.max_memory = graph.memory_usage().total() + 1000;
+  BOOST_CHECK(!simplex_tree.expansion_with_budget(4, budget));
+  BOOST_CHECK(simplex_tree.memory_usage().total() <= budget.max_memory + 1000);
+  check_closed(simplex_tree);
+
+  // Nothing is expanded if the graph is over budget
+  simplex_tree = graph;
+  budget.max_memory = 0;
+  BOOST_CHECK(!simplex_tree.expansion_with_budget(4, budget));
+  BOOST_CHECK(simplex_tree == graph);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_estimate_expansion_size, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************\n";
+  std::clog << "simplex_tree_estimate_expansion_size\n";
+  std::clog << "********************************************************************\n";
+  typeST simplex_tree;
+  std::mt19937 gen(15);
+  std::uniform_real_distribution<double> dist(0., 1.);
+  const int num_vertices = 200;
+  for (int u = 0; u < num_vertices; u++) {
+    simplex_tree.insert_simplex({u}, 0.);
+    for (int v = u + 1; v < num_vertices; v++)
+      if (dist(gen) < 0.2) simplex_tree.insert_simplex({u, v}, dist(gen));
+  }
+  auto estimate = simplex_tree.estimate_expansion_size(4, 2000, 16);
+  simplex_tree.expansion(4);
+  auto sizes = simplex_tree.num_simplices_by_dimension();
+  BOOST_CHECK(estimate.size() == 5);
+  BOOST_CHECK(sizes.size() == 5);
+  BOOST_CHECK(estimate[0] == sizes[0]);
+  BOOST_CHECK(estimate[1] == sizes[1]);
+  for (int d = 2; d <= 4; ++d) {
+    std::clog << "* dimension " << d << ": " << sizes[d] << " simplices, estimated " << estimate[d] << "\n";
+    BOOST_CHECK(std::abs(estimate[d] - sizes[d]) <= 0.2 * sizes[d]);
+  }
+  // The simplices of dimension at least 2 are ignored
+  auto estimate_after = simplex_tree.estimate_expansion_size(4, 2000, 16);
+  BOOST_CHECK(estimate_after == estimate);
+  BOOST_CHECK(simplex_tree.estimate_expansion_size(1) == std::vector<double>({200., static_cast<double>(sizes[1])}));
+}
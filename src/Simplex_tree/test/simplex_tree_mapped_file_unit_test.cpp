@@ -0,0 +1,121 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simplex_tree_mapped_file"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Simplex_tree/Mapped_file_resource.h>
+#include <gudhi/Simplex_tree/Huge_page_resource.h>
+#include <gudhi/Persistent_cohomology.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+struct Simplex_tree_options_pool_siblings : Gudhi::Simplex_tree_options_full_featured {
+  static const bool pool_siblings = true;
+};
+
+using Simplex_tree = Gudhi::Simplex_tree<>;
+using Mapped_simplex_tree = Gudhi::Simplex_tree<Simplex_tree_options_pool_siblings>;
+using Mapped_file_resource = Gudhi::simplex_tree::Mapped_file_resource;
+using Huge_page_resource = Gudhi::simplex_tree::Huge_page_resource;
+
+template <class SimplexTree>
+void build(SimplexTree& st, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> length(0., 1.);
+  for (int u = 0; u < 40; ++u) {
+    st.insert_simplex({u}, 0.);
+    for (int v = u + 1; v < 40; ++v)
+      if (length(gen) < 0.3) st.insert_simplex({u, v}, length(gen));
+  }
+  st.expansion(4);
+}
+
+template <class SimplexTree>
+std::vector<std::tuple<std::vector<int>, double>> filtration(SimplexTree& st) {
+  std::vector<std::tuple<std::vector<int>, double>> result;
+  for (auto sh : st.filtration_simplex_range()) {
+    auto vertices = st.simplex_vertex_range(sh);
+    result.emplace_back(std::vector<int>(vertices.begin(), vertices.end()), st.filtration(sh));
+  }
+  return result;
+}
+
+template <class SimplexTree>
+std::vector<std::tuple<int, double, double>> persistence(SimplexTree& st) {
+  Gudhi::persistent_cohomology::Persistent_cohomology<SimplexTree, Gudhi::persistent_cohomology::Field_Zp> pcoh(st);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  std::vector<std::tuple<int, double, double>> result;
+  for (const auto& pair : pcoh.get_persistent_pairs())
+    result.emplace_back(st.dimension(std::get<0>(pair)), st.filtration(std::get<0>(pair)),
+                        st.filtration(std::get<1>(pair)));
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_in_mapped_file) {
+  Mapped_file_resource resource("simplex_tree_mapped_file_unit_test.arena");
+  Mapped_simplex_tree st;
+  st.set_siblings_memory_resource(&resource);
+  build(st, 3);
+  BOOST_CHECK(resource.size() > 0);
+
+  Simplex_tree expected;
+  build(expected, 3);
+  BOOST_CHECK(st.num_simplices() == expected.num_simplices());
+  BOOST_CHECK(filtration(st) == filtration(expected));
+  BOOST_CHECK(persistence(st) == persistence(expected));
+
+  // The nodes are read again from the file
+  resource.release_resident_pages();
+  BOOST_CHECK(filtration(st) == filtration(expected));
+
+  // A copy is in memory, and the memory of the file is reused once the tree is cleared
+  Mapped_simplex_tree copy(st);
+  const std::size_t size = resource.size();
+  st.clear();
+  build(st, 3);
+  BOOST_CHECK(resource.size() == size);
+  BOOST_CHECK(st == copy);
+
+  Mapped_simplex_tree moved(std::move(st));
+  BOOST_CHECK(moved == copy);
+  BOOST_CHECK_THROW(moved.set_siblings_memory_resource(&resource), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_in_huge_pages) {
+  Simplex_tree expected;
+  build(expected, 5);
+  // The advice may be refused by the system, the memory is usable anyway
+  for (auto placement : {Gudhi::simplex_tree::Page_placement::first_touch,
+                         Gudhi::simplex_tree::Page_placement::interleaved}) {
+    Huge_page_resource resource(std::size_t(1) << 30, placement);
+    Mapped_simplex_tree st;
+    st.set_siblings_memory_resource(&resource);
+    build(st, 5);
+    BOOST_CHECK(resource.size() > 0);
+    BOOST_CHECK(filtration(st) == filtration(expected));
+    BOOST_CHECK(persistence(st) == persistence(expected));
+
+    const std::size_t size = resource.size();
+    st.clear();
+    BOOST_CHECK(resource.size() == 0);
+    build(st, 5);
+    BOOST_CHECK(resource.size() == size);
+    BOOST_CHECK(filtration(st) == filtration(expected));
+  }
+}
@@ -0,0 +1,130 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// Multi-parameter simplex tree interface of the python module (src/python/include/Simplex_tree_interface_multi.h),
+// through its raw-pointer methods.
+
+#include <cstdint>  // for std::uintptr_t
+#include <iostream>
+#include <memory>  // for std::unique_ptr
+#include <stdexcept>
+#include <random>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simplex_tree_multi_interface"
+#include <boost/test/unit_test.hpp>
+
+#include "Simplex_tree_interface_multi.h"
+
+using namespace Gudhi;
+using Interface = multiparameter::interface_multi;
+
+// Clique complex of a random graph, with random filtration values in [0, 1], which need not be non-decreasing.
+void fill_random(Interface& st, unsigned seed, int num_parameters) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(0., 1.);
+  auto random_filtration = [&]() {
+    Interface::Filtration_value filtration(num_parameters);
+    for (auto& x : filtration) x = value(gen);
+    return filtration;
+  };
+  st.set_number_of_parameters(num_parameters);
+  const int num_vertices = 10;
+  for (int u = 0; u < num_vertices; u++) st.insert_simplex(Interface::Simplex{u}, random_filtration());
+  for (int u = 0; u < num_vertices; u++)
+    for (int v = u + 1; v < num_vertices; v++)
+      if (value(gen) < 0.5) st.insert_simplex(Interface::Simplex{u, v}, random_filtration());
+  st.expansion(3);
+  for (auto simplex_handle : st.complex_simplex_range()) st.filtration_mutable(simplex_handle) = random_filtration();
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_interface_fill_simplices_and_filtrations) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER SIMPLICES AND FILTRATIONS BY DIMENSION" << std::endl;
+  Interface st;
+  fill_random(st, 1, 3);
+  const int dimension = st.dimension();
+  BOOST_CHECK(dimension >= 2);
+  for (int max_dimension : {-1, dimension, 1, 0}) {
+    const auto counts = st.num_simplices_by_dimension(max_dimension);
+    BOOST_CHECK(counts.size() == static_cast<std::size_t>(max_dimension < 0 ? dimension + 1 : max_dimension + 1));
+    std::vector<std::vector<int>> vertices(counts.size());
+    std::vector<std::vector<float>> filtrations(counts.size());
+    std::vector<std::uintptr_t> vertex_pointers, filtration_pointers;
+    for (std::size_t d = 0; d < counts.size(); d++) {
+      vertices[d].resize(counts[d] * (d + 1));
+      filtrations[d].resize(counts[d] * 3);
+      vertex_pointers.push_back(reinterpret_cast<std::uintptr_t>(vertices[d].data()));
+      filtration_pointers.push_back(reinterpret_cast<std::uintptr_t>(filtrations[d].data()));
+    }
+    st.fill_simplices_and_filtrations(vertex_pointers, filtration_pointers);
+
+    // Row by row, in the order of get_skeleton, with increasing vertices as in python
+    std::vector<std::size_t> rows(counts.size(), 0);
+    std::size_t num_simplices = 0;
+    for (auto simplex_handle : st.skeleton_simplex_range(static_cast<int>(counts.size()) - 1)) {
+      const int d = st.dimension(simplex_handle);
+      const std::size_t row = rows[d]++;
+      std::vector<int> simplex;
+      for (auto vertex : st.simplex_vertex_range(simplex_handle)) simplex.insert(simplex.begin(), vertex);
+      BOOST_CHECK(std::vector<int>(vertices[d].begin() + row * (d + 1), vertices[d].begin() + (row + 1) * (d + 1)) ==
+                  simplex);
+      const auto& filtration = st.filtration(simplex_handle);
+      BOOST_CHECK(std::vector<float>(filtrations[d].begin() + row * 3, filtrations[d].begin() + (row + 1) * 3) ==
+                  std::vector<float>(filtration.begin(), filtration.end()));
+      num_simplices++;
+    }
+    BOOST_CHECK(rows == counts);
+    if (max_dimension < 0) BOOST_CHECK(num_simplices == st.num_simplices());
+  }
+
+  std::vector<std::uintptr_t> one_array(1);
+  BOOST_CHECK_THROW(st.fill_simplices_and_filtrations(one_array, {}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_interface_filtration_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER FILTRATION VARIANTS" << std::endl;
+  Interface st;
+  fill_random(st, 2, 2);
+  Interface original(st);
+  std::vector<float> vertex_values(10);
+  for (int vertex = 0; vertex < 10; vertex++) vertex_values[vertex] = (vertex * 7) % 10 / 10.f;
+  const multiparameter::multi_filtration_grid grid = {{0., 0.2, 0.4, 0.6, 0.8, 1.}, {0., 0.5, 1.}};
+
+  // Editing a variant leaves its parent unchanged
+  std::unique_ptr<Interface::Filtration_table> variant(st.new_filtration_variant());
+  st.fill_lowerstar_variant(*variant, vertex_values, 0);
+  st.squeeze_filtration_variant(*variant, grid, true);
+  BOOST_CHECK(st == original);
+  BOOST_CHECK_THROW(st.fill_lowerstar_variant(*variant, vertex_values, 2), std::invalid_argument);
+
+  // The keys are overwritten by another table and by an arbitrary assignment, e.g. from a persistence computation
+  std::unique_ptr<Interface::Filtration_table> other(st.new_filtration_variant());
+  Interface::Simplex_key key = 0;
+  for (auto simplex_handle : st.complex_simplex_range()) st.assign_key(simplex_handle, st.num_simplices() - 1 - key++);
+
+  // Assigning the variant gives the same tree as the in-place operations
+  Interface expected(original);
+  multiparameter::fill_lowerstar(expected, {vertex_values}, {0});
+  multiparameter::squeeze_filtration(expected, grid, true);
+  Interface copy(original);
+  copy.assign_filtration_variant(*variant);
+  BOOST_CHECK(copy == expected);
+  st.assign_filtration_variant(*variant);
+  BOOST_CHECK(st == expected);
+  st.assign_filtration_variant(*other);
+  BOOST_CHECK(st == original);
+
+  Interface larger(original);
+  larger.insert_simplex(Interface::Simplex{10}, Interface::Filtration_value{0., 0.});
+  BOOST_CHECK_THROW(larger.assign_filtration_variant(*variant), std::invalid_argument);
+}
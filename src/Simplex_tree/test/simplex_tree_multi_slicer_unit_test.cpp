@@ -0,0 +1,673 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// Persistence invariants of multi-parameter simplex trees (src/python/include/Simplex_tree_multi_slicer.h,
+// Simplex_tree_multi_presentation.h and multi_filtrations/mobius_inversion.h), compared with the persistence of
+// Simplex_tree<> copies.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <iterator>  // for std::back_inserter
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simplex_tree_multi_slicer"
+#include <boost/test/unit_test.hpp>
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+
+#include "Simplex_tree_multi.h"
+#include "Simplex_tree_multi_presentation.h"
+#include "Simplex_tree_multi_slicer.h"
+#include "Simplex_tree_multi_view.h"
+#include "multi_filtrations/mobius_inversion.h"
+
+using namespace Gudhi;
+using Stree = Simplex_tree<multiparameter::options_multi>;
+using Filtration_value = Stree::Filtration_value;
+using Line = multiparameter::multi_filtrations::Line<float>;
+using Barcode = std::vector<std::pair<double, double>>;
+
+// A non-decreasing bifiltration of a square with one diagonal, filled later than its boundary, and an isolated vertex.
+Stree make_square() {
+  Stree st;
+  st.set_number_of_parameters(2);
+  st.insert_simplex_and_subfaces({0, 1, 2}, Filtration_value{3., 4.});
+  st.insert_simplex_and_subfaces({0, 2, 3}, Filtration_value{5., 1.5});
+  st.insert_simplex_and_subfaces({4}, Filtration_value{0.5, 0.5});
+  st.assign_filtration(st.find({0}), Filtration_value{0., 0.});
+  st.assign_filtration(st.find({1}), Filtration_value{1., 0.});
+  st.assign_filtration(st.find({2}), Filtration_value{0., 1.});
+  st.assign_filtration(st.find({3}), Filtration_value{0.5, 0.25});
+  st.assign_filtration(st.find({0, 1}), Filtration_value{1., 0.5});
+  st.assign_filtration(st.find({1, 2}), Filtration_value{1., 1.});
+  st.assign_filtration(st.find({2, 3}), Filtration_value{0.5, 1.});
+  st.assign_filtration(st.find({0, 3}), Filtration_value{0.5, 0.25});
+  st.assign_filtration(st.find({0, 2}), Filtration_value{2., 1.});
+  st.make_filtration_non_decreasing();
+  return st;
+}
+
+// Sorted intervals of positive length, as the order of the pairs depends on how ties are broken.
+Barcode normalized(Barcode barcode) {
+  barcode.erase(std::remove_if(barcode.begin(), barcode.end(), [](auto& bar) { return !(bar.first < bar.second); }),
+                barcode.end());
+  std::sort(barcode.begin(), barcode.end());
+  return barcode;
+}
+
+// Barcode of the push forward of st on l, through a Simplex_tree<> copy.
+Barcode reference_barcode(Stree& st, const Line& l, int degree) {
+  Simplex_tree<> line_st;
+  for (int dimension = 0; dimension <= st.dimension(); dimension++) {
+    for (auto sh : st.skeleton_simplex_range(dimension)) {
+      if (st.dimension(sh) != dimension) continue;
+      const auto& f = st.filtration(sh);
+      float t = -std::numeric_limits<float>::infinity();
+      for (std::size_t i = 0; i < l.basepoint().size(); i++)
+        t = std::max(t, (f[i] - l.basepoint()[i]) / (l.direction().size() > i ? l.direction()[i] : 1.f));
+      line_st.insert_simplex(st.simplex_vertex_range(sh), t);
+    }
+  }
+  persistent_cohomology::Persistent_cohomology<Simplex_tree<>, persistent_cohomology::Field_Zp> pcoh(line_st, true);
+  pcoh.init_coefficients(11);
+  pcoh.compute_persistent_cohomology();
+  return normalized(pcoh.intervals_in_dimension(degree));
+}
+
+std::vector<Line> test_lines() {
+  using Point = Line::point_type;
+  return {Line(Point{0., 0.}), Line(Point{-1., 0.5}), Line({0., -2.}, {1., 2.}), Line({3., 0.}, {0.5, 1.})};
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_sliced_barcodes) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER SLICED BARCODES" << std::endl;
+  Stree st = make_square();
+  const auto lines = test_lines();
+  const std::vector<int> degrees{0, 1, 2};
+  const auto barcodes = multiparameter::sliced_barcodes(st, lines, degrees);
+  BOOST_REQUIRE(barcodes.size() == lines.size());
+  for (std::size_t line = 0; line < lines.size(); line++) {
+    BOOST_REQUIRE(barcodes[line].size() == degrees.size());
+    for (std::size_t i = 0; i < degrees.size(); i++)
+      BOOST_CHECK(normalized(barcodes[line][i]) == reference_barcode(st, lines[line], degrees[i]));
+  }
+  // The diagonal line through 0 : two connected components, and two cycles filled by the triangles
+  const float inf = std::numeric_limits<float>::infinity();
+  BOOST_CHECK(normalized(barcodes[0][0]) == Barcode({{0., inf}, {0.5, inf}}));
+  BOOST_CHECK(normalized(barcodes[0][1]) == Barcode({{1., 5.}, {2., 4.}}));
+  BOOST_CHECK(barcodes[0][2].empty());
+
+  // No line, no degree
+  BOOST_CHECK(multiparameter::sliced_barcodes(st, std::vector<Line>{}, degrees).empty());
+  const auto no_degree = multiparameter::sliced_barcodes(st, lines, {});
+  BOOST_CHECK(no_degree.size() == lines.size());
+  for (const auto& barcode : no_degree) BOOST_CHECK(barcode.empty());
+
+  // Empty complex, single vertex and complex of dimension 0
+  Stree empty;
+  empty.set_number_of_parameters(2);
+  for (const auto& barcode : multiparameter::sliced_barcodes(empty, lines, degrees))
+    for (const auto& intervals : barcode) BOOST_CHECK(intervals.empty());
+  Stree vertex;
+  vertex.set_number_of_parameters(2);
+  vertex.insert_simplex({0}, Filtration_value{1., 2.});
+  const auto vertex_barcodes = multiparameter::sliced_barcodes(vertex, lines, degrees);
+  for (std::size_t line = 0; line < lines.size(); line++)
+    BOOST_CHECK(vertex_barcodes[line][0] == reference_barcode(vertex, lines[line], 0));
+  BOOST_CHECK(vertex_barcodes[0][0] == Barcode({{2., inf}}));
+  BOOST_CHECK(vertex_barcodes[0][1].empty());
+  Stree points;
+  points.set_number_of_parameters(2);
+  points.insert_simplex({0}, Filtration_value{1., 2.});
+  points.insert_simplex({1}, Filtration_value{0., 3.});
+  const auto points_barcodes = multiparameter::sliced_barcodes(points, lines, degrees);
+  for (std::size_t line = 0; line < lines.size(); line++)
+    BOOST_CHECK(normalized(points_barcodes[line][0]) == reference_barcode(points, lines[line], 0));
+  BOOST_CHECK(normalized(points_barcodes[0][0]) == Barcode({{2., inf}, {3., inf}}));
+}
+
+template<class FilteredComplex>
+Barcode persistence(FilteredComplex& complex, int degree) {
+  persistent_cohomology::Persistent_cohomology<FilteredComplex, persistent_cohomology::Field_Zp> pcoh(complex, true);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  const auto intervals = pcoh.intervals_in_dimension(degree);
+  return normalized(Barcode(intervals.begin(), intervals.end()));
+}
+
+// The view has the filtration of st, and a filtration order compatible with it.
+void check_view(Stree& st_multi, const multiparameter::Simplex_tree_multi_view<Stree>& view, Simplex_tree<>& st) {
+  BOOST_REQUIRE(view.num_simplices() == st.num_simplices());
+  BOOST_CHECK(view.dimension() == st.dimension());
+  for (auto sh : st_multi.complex_simplex_range()) {
+    auto st_sh = st.find(st_multi.simplex_vertex_range(sh));
+    BOOST_REQUIRE(st_sh != st.null_simplex());
+    BOOST_CHECK_SMALL(view.filtration(sh) - st.filtration(st_sh), 1e-6);
+    BOOST_CHECK(view.dimension(sh) == st.dimension(st_sh));
+  }
+  const auto& order = view.filtration_simplex_range();
+  BOOST_REQUIRE(order.size() == st.num_simplices());
+  std::vector<std::size_t> position(order.size());
+  for (std::size_t i = 0; i < order.size(); i++) {
+    BOOST_CHECK(view.simplex(static_cast<Stree::Simplex_key>(i)) == order[i]);
+    position[Stree::key(order[i])] = i;
+    if (i > 0) BOOST_CHECK(view.filtration(order[i - 1]) <= view.filtration(order[i]));
+  }
+  for (auto sh : order)
+    for (auto facet : view.boundary_simplex_range(sh)) BOOST_CHECK(position[Stree::key(facet)] < position[Stree::key(sh)]);
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_view) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER 1-PARAMETER VIEWS" << std::endl;
+  using View = multiparameter::Simplex_tree_multi_view<Stree>;
+  Stree st_multi = make_square();
+  View view(st_multi);
+
+  for (int parameter = 0; parameter < 2; parameter++) {
+    view.flatten(parameter);
+    Simplex_tree<> st;
+    multiparameter::flatten(st, st_multi, parameter);
+    check_view(st_multi, view, st);
+    for (int degree = 0; degree < 3; degree++) BOOST_CHECK(persistence(view, degree) == persistence(st, degree));
+  }
+
+  const std::vector<float> linear_form{1., 2.};
+  view.linear_projection(linear_form);
+  Simplex_tree<> projected;
+  multiparameter::flatten(projected, st_multi, 0);
+  multiparameter::linear_projection(projected, st_multi, linear_form);
+  check_view(st_multi, view, projected);
+  for (int degree = 0; degree < 3; degree++) BOOST_CHECK(persistence(view, degree) == persistence(projected, degree));
+
+  const std::vector<float> basepoint{0., 0.5};
+  view.push_forward(Line(Line::point_type(basepoint)), 1);
+  Simplex_tree<> diagonal;
+  multiparameter::flatten_diag(diagonal, st_multi, basepoint, 1);
+  check_view(st_multi, view, diagonal);
+  for (int degree = 0; degree < 3; degree++) BOOST_CHECK(persistence(view, degree) == persistence(diagonal, degree));
+
+  // Copies share the index, but not the filtration
+  View copy(view);
+  copy.flatten(0);
+  check_view(st_multi, view, diagonal);
+  BOOST_CHECK(&copy.simplex_handles() == &view.simplex_handles());
+  std::vector<float> values(view.num_simplices(), 1.);
+  copy.assign_filtration_values(values);
+  for (auto sh : copy.filtration_simplex_range()) BOOST_CHECK(copy.filtration(sh) == 1.);
+  values.pop_back();
+  BOOST_CHECK_THROW(copy.assign_filtration_values(values), std::invalid_argument);
+  BOOST_CHECK(view.filtration(View::null_simplex()) == std::numeric_limits<float>::infinity());
+
+  // Empty complex, single vertex and complex of dimension 0
+  Stree empty;
+  empty.set_number_of_parameters(2);
+  View empty_view(empty);
+  empty_view.flatten(0);
+  BOOST_CHECK(empty_view.num_simplices() == 0);
+  BOOST_CHECK(empty_view.dimension() == -1);
+  BOOST_CHECK(empty_view.filtration_simplex_range().empty());
+  BOOST_CHECK(persistence(empty_view, 0).empty());
+  Stree points;
+  points.set_number_of_parameters(2);
+  points.insert_simplex({0}, Filtration_value{1., 2.});
+  View vertex_view(points);
+  vertex_view.flatten(1);
+  BOOST_CHECK(vertex_view.num_simplices() == 1);
+  BOOST_CHECK(vertex_view.dimension() == 0);
+  const float inf = std::numeric_limits<float>::infinity();
+  BOOST_CHECK(persistence(vertex_view, 0) == Barcode({{2., inf}}));
+  points.insert_simplex({1}, Filtration_value{0., 3.});
+  View points_view(points);
+  points_view.flatten(0);
+  Simplex_tree<> flat_points;
+  multiparameter::flatten(flat_points, points, 0);
+  check_view(points, points_view, flat_points);
+  BOOST_CHECK(persistence(points_view, 0) == Barcode({{0., inf}, {1., inf}}));
+}
+
+// Vineyard of the filtration of st, identified by the keys of its simplices.
+multiparameter::Vineyard<double> make_vineyard(Simplex_tree<>& st) {
+  std::vector<std::vector<std::size_t>> boundaries;
+  std::vector<int> dimensions;
+  std::vector<double> filtration;
+  for (auto sh : st.complex_simplex_range()) {
+    const auto key = st.key(sh);
+    if (key >= boundaries.size()) {
+      boundaries.resize(key + 1);
+      dimensions.resize(key + 1);
+      filtration.resize(key + 1);
+    }
+    for (auto facet : st.boundary_simplex_range(sh)) boundaries[key].push_back(st.key(facet));
+    dimensions[key] = st.dimension(sh);
+    filtration[key] = st.filtration(sh);
+  }
+  return multiparameter::Vineyard<double>(boundaries, dimensions, filtration);
+}
+
+// Lower star filtration of a random function on the vertices.
+std::vector<double> random_lower_star(Simplex_tree<>& st, std::mt19937& generator) {
+  std::uniform_int_distribution<int> distribution(0, 10); // with ties
+  std::vector<double> vertex_values;
+  for (auto vertex : st.complex_vertex_range()) {
+    if (static_cast<std::size_t>(vertex) >= vertex_values.size()) vertex_values.resize(vertex + 1);
+    vertex_values[vertex] = distribution(generator);
+  }
+  std::vector<double> filtration(st.num_simplices());
+  for (auto sh : st.complex_simplex_range()) {
+    double value = -std::numeric_limits<double>::infinity();
+    for (auto vertex : st.simplex_vertex_range(sh)) value = std::max(value, vertex_values[vertex]);
+    st.assign_filtration(sh, value);
+    filtration[st.key(sh)] = value;
+  }
+  st.clear_filtration();
+  return filtration;
+}
+
+template<class Intervals>
+Barcode to_barcode(const Intervals& intervals) {
+  return normalized(Barcode(intervals.begin(), intervals.end()));
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_vineyard) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER VINEYARD" << std::endl;
+  // A triangulated 3x3 grid of vertices, with one missing triangle, and a tetrahedron
+  Simplex_tree<> st;
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 2; j++) {
+      const int v = 3 * i + j;
+      if (i != 1 || j != 1) st.insert_simplex_and_subfaces({v, v + 1, v + 4}, 0.);
+      st.insert_simplex_and_subfaces({v, v + 3, v + 4}, 0.);
+    }
+  st.insert_simplex_and_subfaces({9, 10, 11, 12}, 0.);
+  int key = 0;
+  for (auto sh : st.complex_simplex_range()) st.assign_key(sh, key++);
+
+  std::mt19937 generator(42);
+  random_lower_star(st, generator);
+  auto vineyard = make_vineyard(st);
+  BOOST_CHECK(vineyard.num_simplices() == st.num_simplices());
+  for (int round = 0; round < 50; round++) {
+    const auto filtration = random_lower_star(st, generator);
+    vineyard.update(filtration);
+    auto fresh = make_vineyard(st);
+    // Persistent_cohomology overwrites the keys, which identify the simplices of the vineyard
+    Simplex_tree<> copy(st);
+    for (int dimension = 0; dimension < 4; dimension++) {
+      const auto reference = persistence(copy, dimension);
+      BOOST_CHECK(to_barcode(vineyard.barcode(dimension)) == reference);
+      BOOST_CHECK(to_barcode(fresh.barcode(dimension)) == reference);
+    }
+  }
+  BOOST_CHECK(vineyard.num_transpositions() > 0);
+  // Bars of length at most min_persistence are discarded
+  for (const auto& [birth, death] : vineyard.barcode(1, 2.)) BOOST_CHECK(death - birth > 2.);
+
+  BOOST_CHECK_THROW(vineyard.update(std::vector<double>(st.num_simplices() + 1, 0.)), std::invalid_argument);
+  BOOST_CHECK_THROW(multiparameter::Vineyard<double>({{}}, {0, 0}, {0., 0.}), std::invalid_argument);
+
+  // Empty complex and single vertex
+  multiparameter::Vineyard<double> empty({}, {}, {});
+  empty.update({});
+  BOOST_CHECK(empty.num_simplices() == 0);
+  BOOST_CHECK(empty.barcode(0).empty());
+  multiparameter::Vineyard<double> vertex({{}}, {0}, {1.});
+  vertex.update({2.});
+  BOOST_CHECK(vertex.barcode(0) == (multiparameter::Vineyard<double>::Barcode{{2., std::numeric_limits<double>::infinity()}}));
+  BOOST_CHECK(vertex.barcode(1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_vineyard_barcodes) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER VINEYARD BARCODES" << std::endl;
+  Stree st = make_square();
+  // Lines sweeping the filtration, and the lines of the other tests
+  std::vector<Line> lines;
+  for (int k = -8; k <= 8; k++) lines.emplace_back(Line::point_type{0.25f * k, -0.25f * k});
+  for (const auto& l : test_lines()) lines.push_back(l);
+  const std::vector<int> degrees{0, 1, 2};
+  const auto barcodes = multiparameter::vineyard_barcodes(st, lines, degrees);
+  BOOST_REQUIRE(barcodes.size() == lines.size());
+  for (std::size_t line = 0; line < lines.size(); line++) {
+    BOOST_REQUIRE(barcodes[line].size() == degrees.size());
+    for (std::size_t i = 0; i < degrees.size(); i++)
+      BOOST_CHECK(normalized(barcodes[line][i]) == reference_barcode(st, lines[line], degrees[i]));
+  }
+  BOOST_CHECK(multiparameter::vineyard_barcodes(st, std::vector<Line>{}, degrees).empty());
+
+  // Empty complex, single vertex and complex of dimension 0
+  Stree empty;
+  empty.set_number_of_parameters(2);
+  for (const auto& barcode : multiparameter::vineyard_barcodes(empty, lines, degrees))
+    for (const auto& intervals : barcode) BOOST_CHECK(intervals.empty());
+  Stree points;
+  points.set_number_of_parameters(2);
+  points.insert_simplex({0}, Filtration_value{1., 2.});
+  const auto vertex_barcodes = multiparameter::vineyard_barcodes(points, lines, degrees);
+  for (std::size_t line = 0; line < lines.size(); line++)
+    BOOST_CHECK(vertex_barcodes[line][0] == reference_barcode(points, lines[line], 0));
+  points.insert_simplex({1}, Filtration_value{0., 3.});
+  const auto points_barcodes = multiparameter::vineyard_barcodes(points, lines, degrees);
+  for (std::size_t line = 0; line < lines.size(); line++) {
+    BOOST_CHECK(normalized(points_barcodes[line][0]) == reference_barcode(points, lines[line], 0));
+    BOOST_CHECK(points_barcodes[line][1].empty());
+  }
+}
+
+// Dimension of the homology of the subcomplex of the simplices below the grid point.
+int reference_betti_number(Stree& st, const std::vector<std::size_t>& point, int degree) {
+  Simplex_tree<> subcomplex;
+  for (int dimension = 0; dimension <= st.dimension(); dimension++) {
+    for (auto sh : st.skeleton_simplex_range(dimension)) {
+      if (st.dimension(sh) != dimension) continue;
+      const auto& f = st.filtration(sh);
+      bool below = true;
+      for (std::size_t i = 0; i < point.size(); i++) below = below && f[i] <= static_cast<float>(point[i]);
+      if (below) subcomplex.insert_simplex(st.simplex_vertex_range(sh), 0.);
+    }
+  }
+  persistent_cohomology::Persistent_cohomology<Simplex_tree<>, persistent_cohomology::Field_Zp> pcoh(subcomplex, true);
+  pcoh.init_coefficients(2);
+  pcoh.compute_persistent_cohomology();
+  return pcoh.betti_number(degree);
+}
+
+void check_hilbert_function(Stree& st, const std::vector<std::size_t>& grid_shape, const std::vector<int>& degrees) {
+  const auto hilbert = multiparameter::hilbert_function(st, grid_shape, degrees);
+  std::size_t num_points = 1;
+  for (auto size : grid_shape) num_points *= size;
+  BOOST_REQUIRE(hilbert.size() == degrees.size() * num_points);
+  std::vector<std::size_t> point(grid_shape.size());
+  for (std::size_t index = 0; index < num_points; index++) {
+    for (std::size_t parameter = grid_shape.size(), rest = index; parameter-- > 0;) {
+      point[parameter] = rest % grid_shape[parameter];
+      rest /= grid_shape[parameter];
+    }
+    for (std::size_t i = 0; i < degrees.size(); i++)
+      BOOST_CHECK(hilbert[i * num_points + index] == reference_betti_number(st, point, degrees[i]));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_hilbert_function) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER HILBERT FUNCTION" << std::endl;
+  // The square, squeezed on the grid of the multiples of 1/4
+  Stree st = make_square();
+  for (auto sh : st.complex_simplex_range()) {
+    Filtration_value f = st.filtration(sh);
+    for (std::size_t i = 0; i < f.size(); i++) f[i] *= 4;
+    st.assign_filtration(sh, f);
+  }
+  const std::vector<int> degrees{0, 1, 2};
+  check_hilbert_function(st, {21, 21}, degrees);
+  // A grid smaller than the filtration, and a single line
+  check_hilbert_function(st, {5, 7}, degrees);
+  check_hilbert_function(st, {1, 21}, {1});
+  check_hilbert_function(st, {21, 1}, {0});
+  BOOST_CHECK(multiparameter::hilbert_function(st, {21, 21}, {}).empty());
+  BOOST_CHECK(multiparameter::hilbert_function(st, {0, 21}, degrees).empty());
+  BOOST_CHECK_THROW(multiparameter::hilbert_function(st, {21}, degrees), std::invalid_argument);
+
+  // 3 parameters
+  Stree st3;
+  st3.set_number_of_parameters(3);
+  st3.insert_simplex_and_subfaces({0, 1, 2}, Filtration_value{2., 2., 2.});
+  st3.assign_filtration(st3.find({0}), Filtration_value{0., 0., 0.});
+  st3.assign_filtration(st3.find({1}), Filtration_value{1., 0., 1.});
+  st3.assign_filtration(st3.find({2}), Filtration_value{0., 1., 0.});
+  st3.assign_filtration(st3.find({0, 1}), Filtration_value{1., 1., 1.});
+  st3.assign_filtration(st3.find({0, 2}), Filtration_value{0., 2., 1.});
+  st3.assign_filtration(st3.find({1, 2}), Filtration_value{1., 1., 2.});
+  BOOST_CHECK(!st3.make_filtration_non_decreasing());
+  check_hilbert_function(st3, {3, 3, 3}, degrees);
+
+  // Empty complex, single vertex and complex of dimension 0
+  Stree empty;
+  empty.set_number_of_parameters(2);
+  const auto empty_hilbert = multiparameter::hilbert_function(empty, {3, 3}, degrees);
+  BOOST_CHECK(empty_hilbert == std::vector<std::int32_t>(27, 0));
+  Stree points;
+  points.set_number_of_parameters(2);
+  points.insert_simplex({0}, Filtration_value{1., 2.});
+  check_hilbert_function(points, {3, 3}, degrees);
+  points.insert_simplex({1}, Filtration_value{2., 0.});
+  check_hilbert_function(points, {3, 3}, degrees);
+  BOOST_CHECK(multiparameter::hilbert_function(points, {3, 3}, {0})[8] == 2);
+}
+
+// Dimension of the module presented at the grid point : the number of generators below it, minus the rank of the
+// relations below it.
+template<class Presentation>
+int presented_dimension(const Presentation& presentation, const std::vector<std::size_t>& point) {
+  auto below = [&](const auto& grade) {
+    return grade[0] <= static_cast<float>(point[0]) && grade[1] <= static_cast<float>(point[1]);
+  };
+  int num_generators = 0;
+  for (const auto& grade : presentation.generator_grades) num_generators += below(grade);
+  // Rank with Z/2Z coefficients, by Gaussian elimination on the largest index
+  std::vector<std::vector<std::size_t>> reduced;
+  for (std::size_t r = 0; r < presentation.relations.size(); r++) {
+    if (!below(presentation.relation_grades[r])) continue;
+    std::vector<std::size_t> relation = presentation.relations[r];
+    for (bool changed = true; changed && !relation.empty();) {
+      changed = false;
+      for (const auto& other : reduced) {
+        if (other.back() != relation.back()) continue;
+        std::vector<std::size_t> sum;
+        std::set_symmetric_difference(relation.begin(), relation.end(), other.begin(), other.end(), std::back_inserter(sum));
+        relation.swap(sum);
+        changed = true;
+        break;
+      }
+    }
+    if (!relation.empty()) reduced.push_back(std::move(relation));
+  }
+  return num_generators - static_cast<int>(reduced.size());
+}
+
+void check_presentation(Stree& st, int degree, std::size_t grid_size) {
+  const auto presentation = multiparameter::minimal_presentation(st, degree);
+  BOOST_REQUIRE(presentation.relations.size() == presentation.relation_grades.size());
+  for (std::size_t r = 0; r < presentation.relations.size(); r++) {
+    const auto& relation = presentation.relations[r];
+    const auto& grade = presentation.relation_grades[r];
+    BOOST_CHECK(!relation.empty());
+    BOOST_CHECK(std::is_sorted(relation.begin(), relation.end()));
+    for (std::size_t g : relation) {
+      BOOST_REQUIRE(g < presentation.generator_grades.size());
+      const auto& generator_grade = presentation.generator_grades[g];
+      // Relations are above their generators, and a generator of the same grade would not be minimal
+      BOOST_CHECK(generator_grade[0] <= grade[0] && generator_grade[1] <= grade[1]);
+      BOOST_CHECK(generator_grade != grade);
+    }
+  }
+  for (std::size_t x = 0; x < grid_size; x++)
+    for (std::size_t y = 0; y < grid_size; y++)
+      BOOST_CHECK(presented_dimension(presentation, {x, y}) == reference_betti_number(st, {x, y}, degree));
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_minimal_presentation) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER MINIMAL PRESENTATION" << std::endl;
+  using Grades = std::vector<std::array<float, 2>>;
+  // The boundary of a triangle, whose edges appear at incomparable grades, filled later
+  Stree triangle;
+  triangle.set_number_of_parameters(2);
+  triangle.insert_simplex_and_subfaces({0, 1, 2}, Filtration_value{2., 2.});
+  for (int v = 0; v < 3; v++) triangle.assign_filtration(triangle.find({v}), Filtration_value{0., 0.});
+  triangle.assign_filtration(triangle.find({0, 1}), Filtration_value{1., 0.});
+  triangle.assign_filtration(triangle.find({0, 2}), Filtration_value{0., 1.});
+  triangle.assign_filtration(triangle.find({1, 2}), Filtration_value{1., 1.});
+  const auto h0 = multiparameter::minimal_presentation(triangle, 0);
+  BOOST_CHECK(h0.generator_grades == Grades(3, {0., 0.}));
+  std::vector<std::array<float, 2>> h0_relations = h0.relation_grades;
+  std::sort(h0_relations.begin(), h0_relations.end());
+  BOOST_CHECK(h0_relations == Grades({{0., 1.}, {1., 0.}}));
+  const auto h1 = multiparameter::minimal_presentation(triangle, 1);
+  BOOST_CHECK(h1.generator_grades == Grades({{1., 1.}}));
+  BOOST_CHECK(h1.relation_grades == Grades({{2., 2.}}));
+  BOOST_CHECK(h1.relations == std::vector<std::vector<std::size_t>>({{0}}));
+  BOOST_CHECK(multiparameter::minimal_presentation(triangle, 2).generator_grades.empty());
+  for (int degree = 0; degree < 3; degree++) check_presentation(triangle, degree, 3);
+
+  // The square, squeezed on the grid of the multiples of 1/4
+  Stree st = make_square();
+  for (auto sh : st.complex_simplex_range()) {
+    Filtration_value f = st.filtration(sh);
+    for (std::size_t i = 0; i < f.size(); i++) f[i] *= 4;
+    st.assign_filtration(sh, f);
+  }
+  for (int degree = 0; degree < 3; degree++) check_presentation(st, degree, 21);
+
+  BOOST_CHECK_THROW(multiparameter::minimal_presentation(st, -1), std::invalid_argument);
+  Stree st3;
+  st3.set_number_of_parameters(3);
+  st3.insert_simplex({0}, Filtration_value{0., 0., 0.});
+  BOOST_CHECK_THROW(multiparameter::minimal_presentation(st3, 0), std::invalid_argument);
+
+  // Empty complex, single vertex and complex of dimension 0
+  Stree empty;
+  empty.set_number_of_parameters(2);
+  const auto empty_presentation = multiparameter::minimal_presentation(empty, 0);
+  BOOST_CHECK(empty_presentation.generator_grades.empty());
+  BOOST_CHECK(empty_presentation.relations.empty());
+  Stree points;
+  points.set_number_of_parameters(2);
+  points.insert_simplex({0}, Filtration_value{1., 2.});
+  BOOST_CHECK(multiparameter::minimal_presentation(points, 0).generator_grades == Grades({{1., 2.}}));
+  BOOST_CHECK(multiparameter::minimal_presentation(points, 1).generator_grades.empty());
+  points.insert_simplex({1}, Filtration_value{2., 0.});
+  const auto points_presentation = multiparameter::minimal_presentation(points, 0);
+  BOOST_CHECK(points_presentation.generator_grades.size() == 2);
+  BOOST_CHECK(points_presentation.relations.empty());
+  check_presentation(points, 0, 3);
+}
+
+// Möbius inversion by its definition : the alternating sum over the corners of the unit cube below each point.
+std::vector<int> reference_mobius_inversion(const std::vector<int>& tensor, const std::vector<std::size_t>& shape,
+                                            std::size_t first_axis) {
+  const std::size_t num_axes = shape.size();
+  std::vector<int> out(tensor.size(), 0);
+  std::vector<std::size_t> point(num_axes);
+  for (std::size_t index = 0; index < tensor.size(); index++) {
+    for (std::size_t axis = num_axes, rest = index; axis-- > 0;) {
+      point[axis] = rest % shape[axis];
+      rest /= shape[axis];
+    }
+    for (std::size_t corner = 0; corner < (std::size_t(1) << (num_axes - first_axis)); corner++) {
+      std::size_t other = 0;
+      int sign = 1;
+      bool in_grid = true;
+      for (std::size_t axis = 0; axis < num_axes; axis++) {
+        std::size_t coordinate = point[axis];
+        if (axis >= first_axis && (corner >> (axis - first_axis)) & 1) {
+          in_grid = in_grid && coordinate > 0;
+          coordinate--;
+          sign = -sign;
+        }
+        other = other * shape[axis] + coordinate;
+      }
+      if (in_grid) out[index] += sign * tensor[other];
+    }
+  }
+  return out;
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_mobius_inversion) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER MOBIUS INVERSION" << std::endl;
+  namespace mf = multiparameter::multi_filtrations;
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> distribution(-3, 3);
+  // The second shape has more inner entries than a block of the inversion, and entries than a chunk of sparsify
+  for (const std::vector<std::size_t>& shape :
+       std::vector<std::vector<std::size_t>>{{2, 3, 4, 5}, {3, 600, 11}, {7}, {1, 1}}) {
+    std::size_t size = 1;
+    for (auto n : shape) size *= n;
+    std::vector<int> tensor(size);
+    for (auto& value : tensor) value = distribution(generator) * (distribution(generator) > 0);
+    for (std::size_t first_axis = 0; first_axis <= shape.size(); first_axis++) {
+      std::vector<int> inverted = tensor;
+      mf::mobius_inversion(inverted, shape, first_axis);
+      BOOST_CHECK(inverted == reference_mobius_inversion(tensor, shape, first_axis));
+    }
+    std::vector<std::int32_t> coordinates;
+    std::vector<int> weights;
+    mf::sparsify(tensor, shape, coordinates, weights);
+    BOOST_REQUIRE(coordinates.size() == weights.size() * shape.size());
+    std::vector<int> dense(size, 0);
+    std::size_t previous = 0;
+    for (std::size_t i = 0; i < weights.size(); i++) {
+      std::size_t index = 0;
+      for (std::size_t axis = 0; axis < shape.size(); axis++) index = index * shape[axis] + coordinates[i * shape.size() + axis];
+      BOOST_CHECK(weights[i] != 0);
+      BOOST_CHECK(i == 0 || index > previous);  // row-major order
+      previous = index;
+      dense[index] = weights[i];
+    }
+    BOOST_CHECK(dense == tensor);
+  }
+
+  // Wrong sizes, empty tensor, and a tensor without axis
+  std::vector<int> tensor(5, 1);
+  std::vector<std::int32_t> coordinates;
+  std::vector<int> weights;
+  BOOST_CHECK_THROW(mf::mobius_inversion(tensor, {2, 3}), std::invalid_argument);
+  BOOST_CHECK_THROW(mf::sparsify(tensor, {2, 3}, coordinates, weights), std::invalid_argument);
+  std::vector<int> empty;
+  mf::signed_measure(empty, {0, 3}, 0, coordinates, weights);
+  BOOST_CHECK(coordinates.empty() && weights.empty());
+  std::vector<int> scalar{4};
+  mf::signed_measure(scalar, {}, 0, coordinates, weights);
+  BOOST_CHECK(coordinates.empty());
+  BOOST_CHECK(weights == std::vector<int>({4}));
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_hilbert_signed_measure) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER HILBERT SIGNED MEASURE" << std::endl;
+  Stree st = make_square();
+  for (auto sh : st.complex_simplex_range()) {
+    Filtration_value f = st.filtration(sh);
+    for (std::size_t i = 0; i < f.size(); i++) f[i] *= 4;
+    st.assign_filtration(sh, f);
+  }
+  Stree points;
+  points.set_number_of_parameters(2);
+  points.insert_simplex({0}, Filtration_value{1., 2.});
+  Stree empty;
+  empty.set_number_of_parameters(2);
+  const std::vector<int> degrees{0, 1, 2};
+  for (Stree* complex : {&st, &points, &empty}) {
+    const std::vector<std::size_t> shape{degrees.size(), 21, 21};
+    const auto hilbert = multiparameter::hilbert_function(*complex, {21, 21}, degrees);
+    std::vector<std::int32_t> tensor = hilbert;
+    std::vector<std::int32_t> coordinates, weights;
+    multiparameter::multi_filtrations::signed_measure(tensor, shape, 1, coordinates, weights);
+    // The Hilbert function is the sum of the weights of the points below
+    std::vector<std::int32_t> recovered(hilbert.size(), 0);
+    for (std::size_t i = 0; i < weights.size(); i++) {
+      const std::size_t degree = coordinates[3 * i];
+      for (std::size_t x = coordinates[3 * i + 1]; x < 21; x++)
+        for (std::size_t y = coordinates[3 * i + 2]; y < 21; y++) recovered[(degree * 21 + x) * 21 + y] += weights[i];
+    }
+    BOOST_CHECK(recovered == hilbert);
+  }
+}
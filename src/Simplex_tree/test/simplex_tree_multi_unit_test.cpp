@@ -0,0 +1,858 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// Multi-parameter simplex trees, whose options and filtration values are shipped with the python module
+// (src/python/include/Simplex_tree_multi.h).
+
+#include <algorithm>  // for std::max, std::copy_if
+#include <cmath>
+#include <cstdint>
+#include <cstdio>  // for std::remove
+#include <fstream>
+#include <iostream>
+#include <iterator>  // for std::istreambuf_iterator, std::back_inserter
+#include <limits>
+#include <numeric>  // for std::accumulate
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>  // for std::pair
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "simplex_tree_multi"
+#include <boost/test/unit_test.hpp>
+#include <boost/mpl/list.hpp>
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Rips_complex.h>
+#include <gudhi/distance_functions.h>
+#include <gudhi/Unitary_tests_utils.h>
+
+#include "Simplex_tree_multi.h"
+#include "Simplex_tree_multi_scc.h"
+
+using namespace Gudhi;
+using namespace Gudhi::multiparameter::multi_filtrations;
+
+typedef boost::mpl::list<Simplex_tree<multiparameter::options_multi>,
+                         Simplex_tree<multiparameter::options_multi_fixed<2>>> list_of_tested_variants;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_multi_insertion, Stree, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER INSERTION" << std::endl;
+  using Filtration_value = typename Stree::Filtration_value;
+  Stree st;
+  st.set_number_of_parameters(2);
+  st.insert_simplex_and_subfaces({0, 1, 2}, Filtration_value{1., 2.});
+  st.insert_simplex_and_subfaces({2, 3}, Filtration_value{0., 3.});
+  BOOST_CHECK(st.num_simplices() == 9);
+  BOOST_CHECK(st.dimension() == 2);
+  BOOST_CHECK(st.filtration(st.find({0, 2})) == Filtration_value({1., 2.}));
+  BOOST_CHECK(st.filtration(st.find({3})) == Filtration_value({0., 3.}));
+  // The vertex 2 keeps the grade of its first insertion
+  BOOST_CHECK(st.filtration(st.find({2})) == Filtration_value({1., 2.}));
+  BOOST_CHECK(st.find({0, 3}) == st.null_simplex());
+
+  st.assign_filtration(st.find({1, 2}), Filtration_value{0.5, 4.});
+  BOOST_CHECK(st.filtration(st.find({1, 2})) == Filtration_value({0.5, 4.}));
+  Stree copy(st);
+  BOOST_CHECK(copy == st);
+  BOOST_CHECK(copy.get_number_of_parameters() == 2);
+
+  std::vector<char> buffer(st.get_serialization_size());
+  st.serialize(buffer.data(), buffer.size());
+  Stree deserialized;
+  deserialized.deserialize(buffer.data(), buffer.size());
+  BOOST_CHECK(deserialized == st);
+
+  // Empty and single vertex complexes
+  Stree empty;
+  BOOST_CHECK(empty.num_simplices() == 0);
+  BOOST_CHECK(empty.dimension() == -1);
+  empty.insert_simplex_and_subfaces({4}, Filtration_value{2., 1.});
+  BOOST_CHECK(empty.num_simplices() == 1);
+  BOOST_CHECK(empty.dimension() == 0);
+  BOOST_CHECK(empty.filtration(empty.find({4})) == Filtration_value({2., 1.}));
+}
+
+BOOST_AUTO_TEST_CASE(grid_snapper_strategies) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "GRID SNAPPER" << std::endl;
+  const float inf = std::numeric_limits<float>::infinity();
+  // Small grid, evenly spread grid, and unevenly spread grid
+  std::vector<float> small{0., 1., 1., 3.};
+  std::vector<float> regular, irregular;
+  for (int i = 0; i < 100; ++i) regular.push_back(static_cast<float>(i));
+  for (int i = 0; i < 100; ++i) irregular.push_back(i < 90 ? static_cast<float>(i) / 1000 : static_cast<float>(i));
+  regular.push_back(inf);
+  BOOST_CHECK(Grid_snapper<float>(small).strategy() == Snapping_strategy::linear_scan);
+  BOOST_CHECK(Grid_snapper<float>(regular).strategy() == Snapping_strategy::bucket_table);
+  BOOST_CHECK(Grid_snapper<float>(irregular).strategy() == Snapping_strategy::binary_search);
+
+  // Same coordinates as a linear scan, whatever the strategy
+  for (const auto& grid : {small, regular, irregular}) {
+    Grid_snapper<float> snapper(grid);
+    for (float x = -2.f; x < 102.f; x += 0.37f) {
+      BOOST_CHECK(snapper.coordinate(x) == Gudhi::multiparameter::find_coordinate(x, grid));
+      BOOST_CHECK(snapper.value(x) == grid[static_cast<std::size_t>(snapper.coordinate(x))]);
+    }
+    BOOST_CHECK(snapper.coordinate(inf) == inf);
+  }
+  // Ties go to the largest value, the first one of its duplicates
+  Grid_snapper<float> snapper(small);
+  BOOST_CHECK(snapper.coordinate(0.5f) == 1.f);
+  BOOST_CHECK(snapper.coordinate(2.f) == 3.f);
+  BOOST_CHECK(snapper.coordinate(-1.f) == 0.f);
+
+  // Empty grid
+  Grid_snapper<float> empty(std::vector<float>{});
+  BOOST_CHECK(empty.coordinate(1.f) == 0.f);
+  BOOST_CHECK(empty.value(1.f) == 1.f);
+}
+
+BOOST_AUTO_TEST_CASE(grid_snapper_unsorted_grid) {
+  BOOST_CHECK_THROW(Grid_snapper<float>(std::vector<float>{0., 2., 1.}), std::invalid_argument);
+  std::vector<float> large;
+  for (int i = 100; i > 0; --i) large.push_back(static_cast<float>(i));
+  BOOST_CHECK_THROW(Grid_snapper<float>{large}, std::invalid_argument);
+  // The squeeze functions forward the exception
+  Simplex_tree<multiparameter::options_multi> st;
+  st.set_number_of_parameters(2);
+  st.insert_simplex_and_subfaces({0, 1}, {1., 2.});
+  BOOST_CHECK_THROW(multiparameter::squeeze_filtration(st, {{0., 1.}, {3., 1.}}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_multi_make_filtration_non_decreasing, Stree, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER MAKE FILTRATION NON DECREASING" << std::endl;
+  using Filtration_value = typename Stree::Filtration_value;
+  Stree st;
+  st.set_number_of_parameters(2);
+  st.insert_simplex_and_subfaces({0, 1, 2}, Filtration_value{0., 0.});
+  // Incomparable grades of the vertices, and of the edges with their vertices
+  st.assign_filtration(st.find({0}), Filtration_value{0., 2.});
+  st.assign_filtration(st.find({1}), Filtration_value{2., 0.});
+  st.assign_filtration(st.find({2}), Filtration_value{1., 1.});
+  st.assign_filtration(st.find({0, 2}), Filtration_value{5., 0.});
+  st.assign_filtration(st.find({1, 2}), Filtration_value{3., 3.});
+  BOOST_CHECK(st.make_filtration_non_decreasing());
+  // Each simplex is pushed to the join of its value and of the values of its faces
+  BOOST_CHECK(st.filtration(st.find({0})) == Filtration_value({0., 2.}));
+  BOOST_CHECK(st.filtration(st.find({0, 1})) == Filtration_value({2., 2.}));
+  BOOST_CHECK(st.filtration(st.find({0, 2})) == Filtration_value({5., 2.}));
+  BOOST_CHECK(st.filtration(st.find({1, 2})) == Filtration_value({3., 3.}));
+  BOOST_CHECK(st.filtration(st.find({0, 1, 2})) == Filtration_value({5., 3.}));
+  // Already non decreasing
+  BOOST_CHECK(!st.make_filtration_non_decreasing());
+  Stree empty;
+  BOOST_CHECK(!empty.make_filtration_non_decreasing());
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_critical_make_filtration_non_decreasing) {
+  using Stree = Simplex_tree<multiparameter::options_multi_critical<float>>;
+  using Filtration_value = Stree::Filtration_value;
+  Stree st;
+  st.set_number_of_parameters(2);
+  st.insert_simplex_and_subfaces({0, 1}, Filtration_value{0., 0.});
+  st.assign_filtration(st.find({0}), Filtration_value(std::vector<std::vector<float>>{{0., 1.}, {1., 0.}}));
+  st.assign_filtration(st.find({1}), Filtration_value{0.5, 0.5});
+  BOOST_CHECK(st.make_filtration_non_decreasing());
+  // The edge appears when both vertices appeared, i.e., at the joins of their grades
+  BOOST_CHECK(st.filtration(st.find({0, 1})) ==
+              Filtration_value(std::vector<std::vector<float>>{{0.5, 1.}, {1., 0.5}}));
+  BOOST_CHECK(!st.make_filtration_non_decreasing());
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_critical_filtration_values) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-CRITICAL FILTRATION VALUES" << std::endl;
+  using Filtration_value = Multi_critical_filtration<float>;
+  using Generators = std::vector<std::vector<float>>;
+  // Minimal antichain, sorted lexicographically whatever the insertion order
+  Filtration_value a(Generators{{1., 2.}, {0., 3.}, {2., 1.}, {1., 3.}});
+  Filtration_value b(Generators{{2., 1.}, {1., 3.}, {0., 3.}, {1., 2.}});
+  BOOST_CHECK(a.num_parameters() == 2);
+  BOOST_CHECK(a.get_generators() == Generators({{0., 3.}, {1., 2.}, {2., 1.}}));
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(!b.add_generator(std::vector<float>{2., 2.}));
+  BOOST_CHECK(a == b);
+  BOOST_CHECK_THROW(b.add_generator(std::vector<float>{0.}), std::logic_error);
+  BOOST_CHECK(b.add_generator(std::vector<float>{0., 0.}));
+  BOOST_CHECK(b.get_generators() == Generators({{0., 0.}}));
+
+  // Union and intersection of the upsets
+  Filtration_value c{0., 3.};
+  c.insert_new(Filtration_value{3., 0.});
+  c.insert_new(Filtration_value());
+  BOOST_CHECK(c.get_generators() == Generators({{0., 3.}, {3., 0.}}));
+  Filtration_value d;
+  d.insert_new(c);
+  BOOST_CHECK(d == c);
+  a.push_to(Filtration_value{1., 1.});
+  BOOST_CHECK(a.get_generators() == Generators({{1., 2.}, {2., 1.}}));
+  BOOST_CHECK_THROW(a.push_to(Filtration_value{1., 1., 1.}), std::logic_error);
+  d.push_to(Filtration_value());
+  BOOST_CHECK(d.empty());
+  d.push_to(c);
+  BOOST_CHECK(d.empty());
+
+  // Order : a value is below another one if each grade of the latter is above a grade of the former
+  const Filtration_value corners(Generators{{0., 1.}, {1., 0.}});
+  BOOST_CHECK(corners <= Filtration_value({1., 1.}));
+  BOOST_CHECK(corners < Filtration_value({1., 1.}));
+  BOOST_CHECK(!(Filtration_value({1., 1.}) <= corners));
+  BOOST_CHECK(!(corners <= Filtration_value({0.5, 0.5})) && !(Filtration_value({0.5, 0.5}) <= corners));
+  const auto infinity = std::numeric_limits<Filtration_value>::infinity();
+  BOOST_CHECK(infinity.empty());
+  BOOST_CHECK(corners <= infinity);
+  BOOST_CHECK(!(infinity <= corners));
+  BOOST_CHECK(c.linear_projection({1., 1.}) == 3.);
+  BOOST_CHECK(corners.linear_projection({2., 1.}) == 1.);
+  BOOST_CHECK(infinity.linear_projection({1., 1.}) == std::numeric_limits<float>::infinity());
+
+  // Serialization
+  std::vector<char> buffer(get_serialization_size_of(c));
+  BOOST_CHECK(serialize_value_to_char_buffer(c, buffer.data()) == buffer.data() + buffer.size());
+  Filtration_value deserialized;
+  BOOST_CHECK(deserialize_value_from_char_buffer(deserialized, buffer.data()) == buffer.data() + buffer.size());
+  BOOST_CHECK(deserialized == c);
+
+  // No generator, no parameter
+  BOOST_CHECK(Filtration_value(Generators{}).num_generators() == 0);
+  BOOST_CHECK(Filtration_value(std::vector<float>{}).num_generators() == 0);
+  BOOST_CHECK(Filtration_value(std::vector<float>{}).empty());
+
+  // In a simplex tree, inserting an existing simplex at an incomparable grade adds it
+  Simplex_tree<multiparameter::options_multi_critical<float>> st;
+  st.set_number_of_parameters(2);
+  BOOST_CHECK(st.insert_simplex({0}, Filtration_value{0., 1.}).second);
+  st.insert_simplex({0}, Filtration_value{1., 0.});
+  st.insert_simplex({0}, Filtration_value{2., 2.});
+  BOOST_CHECK(st.num_simplices() == 1);
+  BOOST_CHECK(st.dimension() == 0);
+  BOOST_CHECK(st.filtration(st.find({0})) == corners);
+  st.insert_simplex({0}, Filtration_value{0., 0.});
+  BOOST_CHECK(st.filtration(st.find({0})) == Filtration_value({0., 0.}));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_multi_expansion, Stree, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER EXPANSION" << std::endl;
+  using Filtration_value = typename Stree::Filtration_value;
+  Stree st;
+  st.set_number_of_parameters(2);
+  // Non-decreasing graph, with incomparable grades on the vertices and on the edges
+  st.insert_simplex({0}, Filtration_value{0., 2.});
+  st.insert_simplex({1}, Filtration_value{2., 0.});
+  st.insert_simplex({2}, Filtration_value{1., 1.});
+  st.insert_simplex({3}, Filtration_value{0., 0.});
+  st.insert_simplex({0, 1}, Filtration_value{2., 2.});
+  st.insert_simplex({0, 2}, Filtration_value{4., 2.});
+  st.insert_simplex({1, 2}, Filtration_value{2., 3.});
+  st.insert_simplex({0, 3}, Filtration_value{1., 2.});
+  st.insert_simplex({1, 3}, Filtration_value{2., 1.});
+  st.insert_simplex({2, 3}, Filtration_value{1., 5.});
+  st.expansion(3);
+  BOOST_CHECK(st.num_simplices() == 15);
+  // The join of the edges
+  BOOST_CHECK(st.filtration(st.find({0, 1, 2})) == Filtration_value({4., 3.}));
+  BOOST_CHECK(st.filtration(st.find({0, 1, 3})) == Filtration_value({2., 2.}));
+  BOOST_CHECK(st.filtration(st.find({1, 2, 3})) == Filtration_value({2., 5.}));
+  BOOST_CHECK(st.filtration(st.find({0, 1, 2, 3})) == Filtration_value({4., 5.}));
+  BOOST_CHECK(!st.make_filtration_non_decreasing());
+
+  // An edge with a grade incomparable to the one of a vertex: the expansion only uses the edges, and
+  // make_filtration_non_decreasing, which the python expansion calls afterwards, repairs the filtration.
+  Stree graph;
+  graph.set_number_of_parameters(2);
+  graph.insert_simplex({0}, Filtration_value{0., 3.});
+  graph.insert_simplex({1}, Filtration_value{0., 0.});
+  graph.insert_simplex({2}, Filtration_value{0., 0.});
+  graph.insert_simplex({0, 1}, Filtration_value{1., 1.});
+  graph.insert_simplex({0, 2}, Filtration_value{1., 1.});
+  graph.insert_simplex({1, 2}, Filtration_value{1., 1.});
+  graph.expansion(2);
+  BOOST_CHECK(graph.filtration(graph.find({0, 1, 2})) == Filtration_value({1., 1.}));
+  BOOST_CHECK(graph.make_filtration_non_decreasing());
+  BOOST_CHECK(graph.filtration(graph.find({0, 1})) == Filtration_value({1., 3.}));
+  BOOST_CHECK(graph.filtration(graph.find({0, 1, 2})) == Filtration_value({1., 3.}));
+
+  // Nothing to expand
+  Stree vertex;
+  vertex.insert_simplex({0}, Filtration_value{1., 1.});
+  vertex.expansion(0);
+  vertex.expansion(3);
+  BOOST_CHECK(vertex.num_simplices() == 1);
+  BOOST_CHECK(vertex.dimension() == 0);
+}
+
+std::string file_content(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_write_scc) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER SCC WRITER" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  multiparameter::Scc_writer_options options;
+  options.strip_comments = true;
+  options.ignore_last_generators = false;
+  const std::string path = "simplex_tree_multi_write_scc.scc";
+
+  Stree st;
+  st.set_number_of_parameters(2);
+  st.insert_simplex_and_subfaces({0, 1}, {0.5, 2.});
+  st.assign_filtration(st.find({0}), {0.25, 1.});
+  st.assign_filtration(st.find({1}), {0., 0.125});
+  multiparameter::write_scc(st, path, options);
+  // Shortest representations, with std::to_chars as with the snprintf fallback for exact values
+  BOOST_CHECK(file_content(path) == "scc2020\n2\n1 2\n0.5 2 ; 0 1\n0 0.125 ;\n0.25 1 ;\n");
+
+  // A single vertex, and an empty complex
+  Stree vertex;
+  vertex.set_number_of_parameters(2);
+  vertex.insert_simplex({0}, {1., 2.});
+  multiparameter::write_scc(vertex, path, options);
+  BOOST_CHECK(file_content(path) == "scc2020\n2\n1\n1 2 ;\n");
+  Stree empty;
+  empty.set_number_of_parameters(2);
+  multiparameter::write_scc(empty, path, options);
+  BOOST_CHECK(file_content(path) == "scc2020\n2\n\n");
+  std::remove(path.c_str());
+
+  BOOST_CHECK_THROW(multiparameter::write_scc(st, "does_not_exist/simplex_tree.scc", options), std::runtime_error);
+#ifdef __linux__
+  // Writing errors are reported
+  BOOST_CHECK_THROW(multiparameter::write_scc(st, "/dev/full", options), std::runtime_error);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_read_scc) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER SCC READER" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  multiparameter::Scc_writer_options options;
+  options.ignore_last_generators = false;
+  const std::string path = "simplex_tree_multi_read_scc.scc";
+
+  // Round trip
+  Stree st;
+  st.set_number_of_parameters(2);
+  st.insert_simplex_and_subfaces({0, 1, 2}, {1.5, 2.});
+  st.assign_filtration(st.find({0}), {0.25, 1.});
+  st.assign_filtration(st.find({1}), {-3., 0.1});
+  st.assign_filtration(st.find({1, 2}), {1., 1e-7});
+  multiparameter::write_scc(st, path, options);
+  Stree read;
+  multiparameter::read_scc(read, path);
+  BOOST_CHECK(read.num_simplices() == st.num_simplices());
+  for (auto sh : st.complex_simplex_range()) {
+    auto read_sh = read.find(st.simplex_vertex_range(sh));
+    BOOST_REQUIRE(read_sh != read.null_simplex());
+    BOOST_CHECK(read.filtration(read_sh) == st.filtration(sh));
+  }
+
+  // A single vertex, and an empty complex
+  Stree vertex;
+  vertex.set_number_of_parameters(2);
+  vertex.insert_simplex({0}, {1., 2.});
+  multiparameter::write_scc(vertex, path, options);
+  Stree read_vertex;
+  multiparameter::read_scc(read_vertex, path);
+  BOOST_CHECK(read_vertex.num_simplices() == 1);
+  BOOST_CHECK(read_vertex.dimension() == 0);
+  BOOST_CHECK(read_vertex.filtration(read_vertex.find({0})) == vertex.filtration(vertex.find({0})));
+  Stree empty;
+  empty.set_number_of_parameters(2);
+  multiparameter::write_scc(empty, path, options);
+  Stree read_empty;
+  multiparameter::read_scc(read_empty, path);
+  BOOST_CHECK(read_empty.num_simplices() == 0);
+  BOOST_CHECK(read_empty.get_number_of_parameters() == 2);
+
+  // Malformed files
+  for (const std::string content : {"", "unknown\n", "scc2020\nx\n", "scc2020\n2\n1\n1 ;\n",
+                                    "scc2020\n2\n1\n1 2\n", "scc2020\n2\n1\n1 2 ; x\n",
+                                    "scc2020\n2\n1 2\n1 2 ; 0\n", "scc2020\n2\n1 2\n1 2 ; 0 3\n0 0 ;\n0 0 ;\n"}) {
+    std::ofstream(path, std::ios::binary) << content;
+    Stree malformed;
+    BOOST_CHECK_THROW(multiparameter::read_scc(malformed, path), std::invalid_argument);
+  }
+  std::remove(path.c_str());
+
+  Stree missing;
+  BOOST_CHECK_THROW(multiparameter::read_scc(missing, "does_not_exist/simplex_tree.scc"), std::runtime_error);
+}
+
+// Clique complex of a random graph, with random filtration values in [0, 1], which need not be non-decreasing.
+Simplex_tree<multiparameter::options_multi> random_multi_tree(unsigned seed, int num_parameters, int max_dimension = 3) {
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(0., 1.);
+  auto random_filtration = [&]() {
+    Stree::Filtration_value filtration(num_parameters);
+    for (auto& x : filtration) x = value(gen);
+    return filtration;
+  };
+  Stree st;
+  st.set_number_of_parameters(num_parameters);
+  const int num_vertices = 10;
+  for (int u = 0; u < num_vertices; u++) st.insert_simplex({u}, random_filtration());
+  for (int u = 0; u < num_vertices; u++)
+    for (int v = u + 1; v < num_vertices; v++)
+      if (value(gen) < 0.5) st.insert_simplex({u, v}, random_filtration());
+  st.expansion(max_dimension);
+  for (auto simplex_handle : st.complex_simplex_range()) st.filtration_mutable(simplex_handle) = random_filtration();
+  return st;
+}
+
+std::vector<float> random_vertex_values(unsigned seed, int num_vertices) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(-1., 1.);
+  std::vector<float> values(num_vertices);
+  for (auto& x : values) x = value(gen);
+  return values;
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_filtration_table) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER FILTRATION TABLE" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  Stree st = random_multi_tree(1, 3);
+  auto table = multiparameter::make_filtration_table(st);
+  BOOST_CHECK(table.num_parameters() == 3);
+  BOOST_CHECK(table.num_simplices() == st.num_simplices());
+  for (auto simplex_handle : st.complex_simplex_range()) {
+    const auto key = st.key(simplex_handle);
+    BOOST_CHECK(key < table.num_simplices());
+    BOOST_CHECK(table.dimension(key) == st.dimension(simplex_handle));
+    for (std::size_t parameter = 0; parameter < 3; parameter++)
+      BOOST_CHECK(table(parameter, key) == st.filtration(simplex_handle)[parameter]);
+    // Faces before cofaces
+    for (auto face : st.boundary_simplex_range(simplex_handle)) BOOST_CHECK(st.key(face) < key);
+  }
+
+  // Round trip, after the keys have been overwritten
+  for (std::size_t key = 0; key < table.num_simplices(); key++)
+    for (std::size_t parameter = 0; parameter < 3; parameter++) table(parameter, key) = 10. * parameter + key;
+  std::vector<std::vector<float>> expected;
+  for (auto simplex_handle : st.complex_simplex_range()) {
+    const auto key = st.key(simplex_handle);
+    expected.push_back({static_cast<float>(key), 10.f + key, 20.f + key});
+  }
+  for (auto simplex_handle : st.complex_simplex_range()) st.assign_key(simplex_handle, 0);
+  multiparameter::assign_traversal_keys(st);
+  multiparameter::assign_filtration_table(st, table);
+  std::size_t i = 0;
+  for (auto simplex_handle : st.complex_simplex_range()) {
+    const auto& filtration = st.filtration(simplex_handle);
+    BOOST_CHECK(std::vector<float>(filtration.begin(), filtration.end()) == expected[i++]);
+  }
+
+  // The table versions of fill_lowerstar and squeeze_filtration match the ones on the nodes
+  Stree reference = random_multi_tree(2, 2);
+  Stree st_table(reference);
+  auto lowerstar_table = multiparameter::make_filtration_table(st_table);
+  const auto vertex_values = random_vertex_values(3, 10);
+  multiparameter::fill_lowerstar(lowerstar_table, st_table, vertex_values, 1);
+  multiparameter::assign_filtration_table(st_table, lowerstar_table);
+  multiparameter::fill_lowerstar(reference, {vertex_values}, {1});
+  BOOST_CHECK(st_table == reference);
+  BOOST_CHECK_THROW(multiparameter::fill_lowerstar(lowerstar_table, st_table, vertex_values, 2), std::invalid_argument);
+  BOOST_CHECK_THROW(multiparameter::fill_lowerstar(lowerstar_table, st_table, vertex_values, -1), std::invalid_argument);
+
+  const multiparameter::multi_filtration_grid grid = {{-1., -0.5, 0., 0.5, 1.}, {0., 0.1, 0.3, 0.7}};
+  for (bool coordinate_values : {false, true}) {
+    Stree squeezed(reference);
+    Stree squeezed_table(reference);
+    auto squeeze_table = multiparameter::make_filtration_table(squeezed_table);
+    BOOST_CHECK(multiparameter::squeeze_filtration(squeeze_table, grid, coordinate_values) ==
+                multiparameter::squeeze_filtration(squeezed, grid, coordinate_values));
+    multiparameter::assign_filtration_table(squeezed_table, squeeze_table);
+    BOOST_CHECK(squeezed_table == squeezed);
+  }
+  auto bad_grid = grid;
+  bad_grid.pop_back();
+  BOOST_CHECK_THROW(multiparameter::squeeze_filtration(lowerstar_table, bad_grid), std::invalid_argument);
+}
+
+typedef boost::mpl::list<Simplex_tree<multiparameter::options_multi_coordinates<std::int16_t>>,
+                         Simplex_tree<multiparameter::options_multi_coordinates<std::int16_t, 2>>,
+                         Simplex_tree<multiparameter::options_multi_coordinates<std::int32_t, 2>>>
+    list_of_coordinate_variants;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_multi_squeeze_to_coordinates, Stree_coordinates, list_of_coordinate_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER SQUEEZE TO COORDINATES" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  using coordinate_type = typename Stree_coordinates::Options::value_type;
+  Stree st = random_multi_tree(4, 2);
+  st.assign_filtration(st.find({0}), {plus_infinity<float>(), 0.5});
+  const multiparameter::multi_filtration_grid grid = {{0., 0.25, 0.5, 0.75, 1.}, {0., 0.5, 1.}};
+  Stree squeezed(st);
+  multiparameter::squeeze_filtration(squeezed, grid, true);
+  Stree_coordinates st_coordinates;
+  multiparameter::squeeze_to_coordinates(st, st_coordinates, grid);
+  BOOST_CHECK(st_coordinates.num_simplices() == st.num_simplices());
+  BOOST_CHECK(st_coordinates.get_number_of_parameters() == 2);
+  for (auto simplex_handle : squeezed.complex_simplex_range()) {
+    const auto& coordinates = st_coordinates.filtration(st_coordinates.find(squeezed.simplex_vertex_range(simplex_handle)));
+    for (int parameter = 0; parameter < 2; parameter++) {
+      const float coordinate = squeezed.filtration(simplex_handle)[parameter];
+      if (coordinate == plus_infinity<float>())
+        BOOST_CHECK(coordinates[parameter] == plus_infinity<coordinate_type>());
+      else
+        BOOST_CHECK(coordinates[parameter] == coordinate);
+    }
+  }
+
+  Stree unsqueezed;
+  multiparameter::unsqueeze_from_coordinates(st_coordinates, unsqueezed, grid);
+  Stree snapped(st);
+  multiparameter::squeeze_filtration(snapped, grid, false);
+  BOOST_CHECK(unsqueezed == snapped);
+  BOOST_CHECK(unsqueezed.get_number_of_parameters() == 2);
+  BOOST_CHECK(unsqueezed.filtration(unsqueezed.find({0}))[0] == plus_infinity<float>());
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_fill_lowerstar) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER LOWER-STAR FILTRATIONS" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  Stree st = random_multi_tree(5, 3);
+  Stree original(st);
+  const std::vector<std::vector<float>> filtrations = {random_vertex_values(6, 10), random_vertex_values(7, 10)};
+  const std::vector<int> axes = {2, 0};
+  const auto timings = multiparameter::fill_lowerstar(st, filtrations, axes);
+  BOOST_CHECK(timings.num_simplices == st.num_simplices());
+  BOOST_CHECK(timings.num_axes == 2);
+  BOOST_CHECK(timings.num_tasks == st.num_vertices());
+  for (auto simplex_handle : st.complex_simplex_range()) {
+    const auto& filtration = st.filtration(simplex_handle);
+    // The lower-star value of a simplex is the maximum of the values of its vertices
+    for (std::size_t i = 0; i < axes.size(); i++) {
+      float value = -std::numeric_limits<float>::infinity();
+      for (auto vertex : st.simplex_vertex_range(simplex_handle)) value = std::max(value, filtrations[i][vertex]);
+      BOOST_CHECK(filtration[axes[i]] == value);
+    }
+    // The other parameter is untouched
+    BOOST_CHECK(filtration[1] == original.filtration(original.find(st.simplex_vertex_range(simplex_handle)))[1]);
+  }
+
+  BOOST_CHECK_THROW(multiparameter::fill_lowerstar(st, filtrations, {0, 3}), std::invalid_argument);
+  BOOST_CHECK_THROW(multiparameter::fill_lowerstar(st, filtrations, {-1, 0}), std::invalid_argument);
+  BOOST_CHECK_THROW(multiparameter::fill_lowerstar(st, filtrations, {0}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_function_rips) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER FUNCTION RIPS" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  std::mt19937 gen(8);
+  std::uniform_real_distribution<float> coordinate(0., 1.);
+  std::vector<std::vector<float>> points(30, std::vector<float>(2));
+  for (auto& point : points)
+    for (auto& x : point) x = coordinate(gen);
+  const auto vertex_values = random_vertex_values(9, 30);
+  const float threshold = 0.3;
+  const int max_dimension = 3;
+
+  Stree st;
+  multiparameter::function_rips(st, points, vertex_values, threshold, max_dimension);
+
+  // Rips complex, then the lower-star filtration on the second parameter
+  Simplex_tree<> rips_st;
+  rips_complex::Rips_complex<double>(points, threshold, Euclidean_distance()).create_complex(rips_st, max_dimension);
+  Stree expected;
+  expected.set_number_of_parameters(2);
+  multiparameter::multify(rips_st, expected, 2);
+  multiparameter::fill_lowerstar(expected, {vertex_values}, {1});
+  expected.make_filtration_non_decreasing();
+
+  BOOST_CHECK(st.num_simplices() == expected.num_simplices());
+  BOOST_CHECK(st.dimension() == expected.dimension());
+  BOOST_CHECK(st.get_number_of_parameters() == 2);
+  for (auto simplex_handle : expected.complex_simplex_range()) {
+    auto found = st.find(expected.simplex_vertex_range(simplex_handle));
+    BOOST_REQUIRE(found != st.null_simplex());
+    const auto& filtration = st.filtration(found);
+    const auto& expected_filtration = expected.filtration(simplex_handle);
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(filtration[0], expected_filtration[0], 1e-5f);
+    BOOST_CHECK(filtration[1] == expected_filtration[1]);
+  }
+  BOOST_CHECK(!st.make_filtration_non_decreasing());
+
+  Stree vertices;
+  multiparameter::function_rips(vertices, points, vertex_values, threshold, 0);
+  BOOST_CHECK(vertices.num_simplices() == points.size());
+
+  Stree invalid;
+  BOOST_CHECK_THROW(multiparameter::function_rips(invalid, points, vertex_values, threshold, -1), std::invalid_argument);
+  auto mixed = points;
+  mixed[3].push_back(0.);
+  BOOST_CHECK_THROW(multiparameter::function_rips(invalid, mixed, vertex_values, threshold, 2), std::invalid_argument);
+  BOOST_CHECK_THROW(multiparameter::function_rips(invalid, points, {1.}, threshold, 2), std::invalid_argument);
+  BOOST_CHECK_THROW(multiparameter::function_rips(st, points, vertex_values, threshold, 2), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_projections_in_box) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER PROJECTIONS IN A BOX" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  Stree st = random_multi_tree(10, 2);
+  st.make_filtration_non_decreasing();
+  const Box<float> box({0.2, 0.1}, {0.7, 0.8});
+  const auto& bottom = box.get_bottom_corner();
+  const auto& upper = box.get_upper_corner();
+  // The full projections are computed on the filtration values clamped to the bottom corner
+  Stree clamped(st);
+  for (auto simplex_handle : clamped.complex_simplex_range()) {
+    auto& filtration = clamped.filtration_mutable(simplex_handle);
+    for (int parameter = 0; parameter < 2; parameter++)
+      filtration[parameter] = std::max(filtration[parameter], bottom[parameter]);
+  }
+  std::size_t num_simplices_in_box = 0;
+  for (auto simplex_handle : st.complex_simplex_range())
+    if (st.filtration(simplex_handle)[0] <= upper[0] && st.filtration(simplex_handle)[1] <= upper[1])
+      num_simplices_in_box++;
+  BOOST_CHECK(num_simplices_in_box > 0);
+  BOOST_CHECK(num_simplices_in_box < st.num_simplices());
+
+  // The projection in the box is the full projection, restricted to the simplices in the box
+  auto check = [&](Simplex_tree<>& in_box, Simplex_tree<>& full) {
+    BOOST_CHECK(in_box.num_simplices() == num_simplices_in_box);
+    for (auto simplex_handle : st.complex_simplex_range()) {
+      const auto& filtration = st.filtration(simplex_handle);
+      auto found = in_box.find(st.simplex_vertex_range(simplex_handle));
+      if (filtration[0] <= upper[0] && filtration[1] <= upper[1]) {
+        BOOST_REQUIRE(found != in_box.null_simplex());
+        GUDHI_TEST_FLOAT_EQUALITY_CHECK(in_box.filtration(found),
+                                        full.filtration(full.find(st.simplex_vertex_range(simplex_handle))), 1e-6);
+      } else {
+        BOOST_CHECK(found == in_box.null_simplex());
+      }
+    }
+  };
+  for (int dimension : {0, 1}) {
+    Simplex_tree<> in_box, full;
+    multiparameter::flatten_in_box(in_box, st, box, dimension);
+    multiparameter::flatten(full, clamped, dimension);
+    check(in_box, full);
+  }
+  const std::vector<float> basepoint = {-0.5, 0.};
+  for (int dimension : {0, 1}) {
+    Simplex_tree<> in_box, full;
+    multiparameter::flatten_diag_in_box(in_box, st, box, basepoint, dimension);
+    multiparameter::flatten_diag(full, clamped, basepoint, dimension);
+    check(in_box, full);
+  }
+  const std::vector<float> linear_form = {0.25, 2.};
+  Simplex_tree<> in_box, full;
+  multiparameter::linear_projection_in_box(in_box, st, box, linear_form);
+  multiparameter::flatten(full, clamped, 0);
+  multiparameter::linear_projection(full, clamped, linear_form);
+  check(in_box, full);
+}
+
+// Values of the ranks around q * (n - 1) in sorted values, between which the quantile q is interpolated
+std::pair<float, float> quantile_bounds(const std::vector<float>& sorted, double q) {
+  const std::size_t below = static_cast<std::size_t>(q * (sorted.size() - 1));
+  return {sorted[below], sorted[std::min(below + 1, sorted.size() - 1)]};
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_filtration_statistics) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER FILTRATION STATISTICS" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  Stree st = random_multi_tree(11, 2);
+  // A few infinite values, which are counted apart from the finite ones
+  st.assign_filtration(st.find({0}), {plus_infinity<float>(), 0.5});
+  st.assign_filtration(st.find({1}), {minus_infinity<float>(), plus_infinity<float>()});
+  for (const std::vector<int>& degrees : {std::vector<int>{}, {1}, {0, 2}}) {
+    const auto statistics = multiparameter::compute_filtration_statistics(st, degrees);
+    BOOST_CHECK(statistics.num_parameters() == 2);
+    std::vector<std::size_t> num_simplices_per_dimension;
+    std::vector<std::vector<float>> finite_values(2);
+    std::vector<std::size_t> num_plus_infinite(2, 0), num_minus_infinite(2, 0);
+    for (auto simplex_handle : st.complex_simplex_range()) {
+      const int dimension = st.dimension(simplex_handle);
+      if (!degrees.empty() && std::find(degrees.begin(), degrees.end(), dimension) == degrees.end()) continue;
+      if (num_simplices_per_dimension.size() <= static_cast<std::size_t>(dimension))
+        num_simplices_per_dimension.resize(dimension + 1, 0);
+      num_simplices_per_dimension[dimension]++;
+      for (int parameter = 0; parameter < 2; parameter++) {
+        const float value = st.filtration(simplex_handle)[parameter];
+        if (value == plus_infinity<float>())
+          num_plus_infinite[parameter]++;
+        else if (value == minus_infinity<float>())
+          num_minus_infinite[parameter]++;
+        else
+          finite_values[parameter].push_back(value);
+      }
+    }
+    BOOST_CHECK(statistics.num_simplices_per_dimension() == num_simplices_per_dimension);
+    BOOST_CHECK(statistics.num_simplices() ==
+                std::accumulate(num_simplices_per_dimension.begin(), num_simplices_per_dimension.end(), std::size_t(0)));
+    for (int parameter = 0; parameter < 2; parameter++) {
+      auto& values = finite_values[parameter];
+      std::sort(values.begin(), values.end());
+      BOOST_CHECK(statistics.num_finite(parameter) == values.size());
+      BOOST_CHECK(statistics.num_plus_infinite(parameter) == num_plus_infinite[parameter]);
+      BOOST_CHECK(statistics.num_minus_infinite(parameter) == num_minus_infinite[parameter]);
+      BOOST_CHECK(statistics.num_nan(parameter) == 0);
+      BOOST_CHECK(statistics.min(parameter) == values.front());
+      BOOST_CHECK(statistics.max(parameter) == values.back());
+      BOOST_CHECK(statistics.quantile(parameter, 0) == values.front());
+      BOOST_CHECK(statistics.quantile(parameter, 1) == values.back());
+      // The quantile is interpolated in a histogram bin, which spans 1/32 of the (positive) values it contains
+      for (double q : {0.1, 0.25, 0.5, 0.75, 0.9}) {
+        const auto [low, high] = quantile_bounds(values, q);
+        BOOST_CHECK_GE(statistics.quantile(parameter, q), low * (1 - 1. / 32) - 1e-6);
+        BOOST_CHECK_LE(statistics.quantile(parameter, q), high * (1 + 1. / 32) + 1e-6);
+      }
+    }
+
+    Box<float> box;
+    box.infer_from_statistics(statistics);
+    BOOST_CHECK(box.get_bottom_corner() == Finitely_critical_multi_filtration<float>({finite_values[0].front(), finite_values[1].front()}));
+    BOOST_CHECK(box.get_upper_corner() == Finitely_critical_multi_filtration<float>({finite_values[0].back(), finite_values[1].back()}));
+    box.infer_from_statistics(statistics, 0.1, 0.2);
+    for (int parameter = 0; parameter < 2; parameter++) {
+      BOOST_CHECK(box.get_bottom_corner()[parameter] == statistics.quantile(parameter, 0.1));
+      BOOST_CHECK(box.get_upper_corner()[parameter] == statistics.quantile(parameter, 0.8));
+    }
+  }
+}
+
+// Port of the python grid computation that compute_filtration_grid replaced (SimplexTreeMulti._reduce_grid on the
+// np.unique of the finite values of each parameter), with numpy's linspace and closest_observation quantiles.
+namespace baseline {
+
+std::vector<double> linspace(double start, double stop, std::size_t num) {
+  std::vector<double> out;
+  const double step = num > 1 ? (stop - start) / (num - 1) : 0;
+  for (std::size_t i = 0; i < num; i++) out.push_back(i * step + start);
+  if (num > 1) out.back() = stop;
+  return out;
+}
+
+// np.quantile(values, q, method="closest_observation"), i.e., Hyndman and Fan's definition 3
+float quantile(const std::vector<float>& sorted, double q) {
+  const double virtual_index = sorted.size() * q - 1 - 0.5;
+  const double previous = std::floor(virtual_index);
+  const bool gamma_is_zero = virtual_index - previous == 0;
+  const bool odd = static_cast<long>(std::abs(previous)) % 2 == 1;
+  const long index = gamma_is_zero && odd ? static_cast<long>(previous) : static_cast<long>(previous) + 1;
+  return sorted[std::max(index, 0L)];
+}
+
+std::vector<float> unique(std::vector<float> values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+std::vector<std::vector<float>> reduce_grid(const std::vector<std::vector<float>>& filtrations_values,
+                                            const std::string& strategy, const std::vector<int>& resolutions,
+                                            double q_factor = 1.) {
+  std::vector<std::vector<float>> F;
+  if (strategy == "exact") return filtrations_values;
+  if (strategy == "quantile") {
+    bool all_short = true;
+    for (std::size_t p = 0; p < filtrations_values.size(); p++) {
+      const auto& f = filtrations_values[p];
+      std::vector<float> grid;
+      for (double q : linspace(0, 1, static_cast<std::size_t>(resolutions[p] * q_factor)))
+        grid.push_back(quantile(f, q));
+      F.push_back(unique(grid));
+      all_short = all_short && std::min<std::size_t>(f.size(), resolutions[p]) > F.back().size();
+    }
+    if (all_short) return reduce_grid(filtrations_values, strategy, resolutions, 1.5 * q_factor);
+    return F;
+  }
+  for (std::size_t p = 0; p < filtrations_values.size(); p++) {
+    const auto& f = filtrations_values[p];
+    std::vector<float> grid;
+    if (strategy == "regular") {
+      for (double x : linspace(f.front(), f.back(), resolutions[p])) grid.push_back(static_cast<float>(x));
+    } else if (strategy == "regular_closest") {
+      for (double x : linspace(f.front(), f.back(), resolutions[p])) {
+        std::size_t argmin = 0;
+        for (std::size_t i = 1; i < f.size(); i++)
+          if (std::abs(f[i] - x) < std::abs(f[argmin] - x)) argmin = i;
+        grid.push_back(f[argmin]);
+      }
+      grid = unique(grid);
+    } else if (strategy == "partition") {
+      const std::size_t resolution = std::min<std::size_t>(f.size(), resolutions[p]);
+      const std::size_t k = f.size() / resolution;
+      for (std::size_t i = 0; i < resolution; i++) grid.push_back(f[i * k]);
+      grid = unique(grid);
+    }
+    F.push_back(grid);
+  }
+  return F;
+}
+
+}  // namespace baseline
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_filtration_grid) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER FILTRATION GRIDS" << std::endl;
+  using Stree = Simplex_tree<multiparameter::options_multi>;
+  // Values of numpy.quantile(numpy.arange(10), [0, .25, .5, .75, 1], method="closest_observation")
+  const std::vector<float> range = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  const std::vector<std::size_t> ranks = {0, 1, 4, 7, 9};
+  for (std::size_t i = 0; i < ranks.size(); i++) {
+    BOOST_CHECK(closest_observation_rank(10, i * 0.25) == ranks[i]);
+    BOOST_CHECK(baseline::quantile(range, i * 0.25) == range[ranks[i]]);
+  }
+
+  Stree st = random_multi_tree(12, 2);
+  st.assign_filtration(st.find({0}), {plus_infinity<float>(), 0.5});
+  // Duplicated values
+  st.assign_filtration(st.find({1}), st.filtration(st.find({2})));
+  const std::uintptr_t ptr = reinterpret_cast<std::uintptr_t>(&st);
+  for (const std::vector<int>& degrees : {std::vector<int>{0, 1, 2, 3}, {0}, {1, 2}}) {
+    std::vector<std::vector<float>> filtrations_values(2);
+    for (auto simplex_handle : st.complex_simplex_range()) {
+      if (std::find(degrees.begin(), degrees.end(), st.dimension(simplex_handle)) == degrees.end()) continue;
+      for (int parameter = 0; parameter < 2; parameter++) {
+        const float value = st.filtration(simplex_handle)[parameter];
+        if (std::isfinite(value)) filtrations_values[parameter].push_back(value);
+      }
+    }
+    for (auto& values : filtrations_values) values = baseline::unique(values);
+    for (const std::vector<int>& resolutions : {std::vector<int>{5, 8}, {3, 1000}, {1000, 1000}}) {
+      for (const std::string strategy : {"exact", "regular", "regular_closest", "quantile", "partition"}) {
+        BOOST_TEST_CONTEXT("strategy " << strategy << ", resolutions " << resolutions[0] << " " << resolutions[1]) {
+          BOOST_CHECK(multiparameter::compute_filtration_grid(ptr, degrees, strategy, resolutions) ==
+                      baseline::reduce_grid(filtrations_values, strategy, resolutions));
+        }
+      }
+    }
+
+    // The values below the quantile 0.1 and above the quantile 1 - 0.2 of the distinct values are dropped
+    std::vector<std::vector<float>> kept(2);
+    for (int parameter = 0; parameter < 2; parameter++) {
+      const auto& values = filtrations_values[parameter];
+      const float low = baseline::quantile(values, 0.1), high = baseline::quantile(values, 1 - 0.2);
+      std::copy_if(values.begin(), values.end(), std::back_inserter(kept[parameter]),
+                   [&](float x) { return low <= x && x <= high; });
+    }
+    BOOST_CHECK(multiparameter::compute_filtration_grid(ptr, degrees, "exact", {}, 0.1, 0.2) == kept);
+    BOOST_CHECK(multiparameter::compute_filtration_grid(ptr, degrees, "quantile", {4, 4}, 0.1, 0.2) ==
+                baseline::reduce_grid(kept, "quantile", {4, 4}));
+  }
+  BOOST_CHECK_THROW(multiparameter::compute_filtration_grid(ptr, {0}, "unknown", {2, 2}), std::invalid_argument);
+  BOOST_CHECK_THROW(multiparameter::compute_filtration_grid(ptr, {0}, "regular", {2}), std::invalid_argument);
+}
@@ -9,6 +9,10 @@
  */
 
 #include <iostream>
+#include <random>
+#include <vector>
+#include <utility>  // for std::pair
+#include <iterator>  // for std::distance
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "simplex_tree_remove"
@@ -567,4 +571,54 @@ BOOST_AUTO_TEST_CASE(mini_prune_above_dimension) {
   BOOST_CHECK(st.num_simplices() == 0);
   BOOST_CHECK(st.upper_bound_dimension() == -1);
   BOOST_CHECK(st.dimension() == -1);
-}
\ No newline at end of file
+}
+
+BOOST_AUTO_TEST_CASE(prune_large_complex_with_cofaces) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "PRUNE LARGE COMPLEX WITH COFACES" << std::endl;
+  // Enough vertices for the subtrees to be pruned in parallel, and lists of nodes by label to be relinked
+  using Cofaces_stree = Simplex_tree<Simplex_tree_options_fast_cofaces>;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> vertex(0, 200);
+  std::uniform_real_distribution<double> filtration(0., 10.);
+  std::vector<std::pair<std::vector<int>, double>> simplices;
+  for (int i = 0; i < 2000; ++i)
+    simplices.push_back({{vertex(gen), vertex(gen), vertex(gen), vertex(gen)}, filtration(gen)});
+
+  Cofaces_stree st;
+  for (auto& [simplex, filt] : simplices) st.insert_simplex_and_subfaces(simplex, filt);
+  st.make_filtration_non_decreasing();
+
+  // Same complex and same cofaces as the simplices of st below the threshold inserted in a new tree
+  auto check = [&st](Cofaces_stree& reference) {
+    BOOST_CHECK(st == reference);
+    for (auto sh : st.complex_simplex_range()) {
+      std::vector<int> simplex(st.simplex_vertex_range(sh).begin(), st.simplex_vertex_range(sh).end());
+      auto star = st.star_simplex_range(sh);
+      auto reference_star = reference.star_simplex_range(reference.find(simplex));
+      BOOST_CHECK(std::distance(star.begin(), star.end()) ==
+                  std::distance(reference_star.begin(), reference_star.end()));
+    }
+  };
+  // Faces are inserted before their cofaces
+  auto subcomplex = [&st](auto&& keep) {
+    Cofaces_stree reference;
+    for (auto sh : st.filtration_simplex_range())
+      if (keep(sh)) reference.insert_simplex_and_subfaces(st.simplex_vertex_range(sh), st.filtration(sh));
+    return reference;
+  };
+
+  Cofaces_stree reference = subcomplex([&st](auto sh) { return st.filtration(sh) <= 5.; });
+  BOOST_CHECK(st.prune_above_filtration(5.));
+  BOOST_CHECK(!st.prune_above_filtration(5.));
+  check(reference);
+
+  reference = subcomplex([&st](auto sh) { return st.dimension(sh) <= 1; });
+  BOOST_CHECK(st.prune_above_dimension(1));
+  BOOST_CHECK(st.upper_bound_dimension() == 1);
+  check(reference);
+
+  reference = subcomplex([&st](auto sh) { return st.dimension(sh) == 0; });
+  BOOST_CHECK(st.prune_above_dimension(0));
+  check(reference);
+}
@@ -13,6 +13,7 @@
 #include <random>
 #include <iterator>  // for std::distance
 #include <vector>
+#include <algorithm>  // for std::sort
 #include <cstdint>  // for std::uint8_t
 #include <iomanip>  // for std::setfill, setw
 #include <ios>  // for std::hex, uppercase
@@ -23,8 +24,10 @@
 #include <boost/mpl/list.hpp>
 
 #include <gudhi/Simplex_tree.h>
+#include <gudhi/Flat_simplex_tree.h>
 #include <gudhi/Simplex_tree/serialization_utils.h>  // for de/serialize_trivial
 #include <gudhi/Unitary_tests_utils.h>  // for GUDHI_TEST_FLOAT_EQUALITY_CHECK
+#include "Simplex_tree_multi.h"  // for the multi-parameter options, from src/python/include
 
 using namespace Gudhi;
 using namespace Gudhi::simplex_tree;
@@ -320,3 +323,215 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_serialization_and_cofaces, Stree, lis
   BOOST_CHECK(num_stars == 5);
 
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_flat_serialization, Stree, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "FLAT SIMPLEX TREE SERIALIZATION" << std::endl;
+  using Vertex_type = typename Stree::Vertex_handle;
+  using Filtration_type = typename Stree::Filtration_value;
+  Stree st;
+
+  st.insert_simplex_and_subfaces({2, 1, 0});
+  st.insert_simplex_and_subfaces({3, 0});
+  st.insert_simplex_and_subfaces({3, 4, 5});
+  st.insert_simplex_and_subfaces({0, 1, 6, 7});
+  if constexpr (Stree::Options::store_filtration) {
+    for (auto sh : st.complex_simplex_range()) st.assign_filtration(sh, random_filtration<Filtration_type>());
+    st.make_filtration_non_decreasing();
+  }
+
+  const std::size_t buffer_size = get_flat_serialization_size(st);
+  std::clog << "Flat serialization size in bytes = " << buffer_size << std::endl;
+  // std::uint64_t only for the alignment
+  std::vector<std::uint64_t> buffer((buffer_size + 7) / 8);
+  char* data = reinterpret_cast<char*>(buffer.data());
+  BOOST_CHECK_THROW(flat_serialize(st, data, buffer_size - 1), std::invalid_argument);
+  flat_serialize(st, data, buffer_size);
+
+  Flat_simplex_tree<Vertex_type, Filtration_type> flat(data, buffer_size);
+  BOOST_CHECK(flat.num_simplices() == st.num_simplices());
+  BOOST_CHECK(flat.num_vertices() == st.num_vertices());
+  BOOST_CHECK(flat.dimension() == st.dimension());
+  BOOST_CHECK(flat.num_parameters() == (Stree::Options::store_filtration ? 1u : 0u));
+
+  auto vertices = [](auto&& range) {
+    std::vector<Vertex_type> simplex(std::begin(range), std::end(range));
+    std::sort(simplex.begin(), simplex.end());
+    return simplex;
+  };
+  std::clog << "Same filtration order, vertices and filtration values" << std::endl;
+  auto flat_sh = flat.filtration_simplex_range().begin();
+  for (auto sh : st.filtration_simplex_range()) {
+    BOOST_CHECK(flat.simplex_vertices(*flat_sh) == vertices(st.simplex_vertex_range(sh)));
+    BOOST_CHECK(flat.dimension(*flat_sh) == st.dimension(sh));
+    GUDHI_TEST_FLOAT_EQUALITY_CHECK(flat.filtration(*flat_sh), st.filtration(sh));
+    BOOST_CHECK(flat.find(st.simplex_vertex_range(sh)) == *flat_sh);
+    for (int codimension = 0; codimension < 3; codimension++) {
+      std::vector<std::vector<Vertex_type>> cofaces, flat_cofaces;
+      // Brute force, the star of a maximal simplex being empty for some options of cofaces_simplex_range
+      auto simplex = vertices(st.simplex_vertex_range(sh));
+      for (auto coface : st.complex_simplex_range()) {
+        auto coface_vertices = vertices(st.simplex_vertex_range(coface));
+        if ((codimension == 0 || st.dimension(coface) == st.dimension(sh) + codimension) &&
+            std::includes(coface_vertices.begin(), coface_vertices.end(), simplex.begin(), simplex.end()))
+          cofaces.push_back(coface_vertices);
+      }
+      for (auto coface : flat.cofaces(*flat_sh, codimension))
+        flat_cofaces.push_back(flat.simplex_vertices(coface));
+      std::sort(cofaces.begin(), cofaces.end());
+      std::sort(flat_cofaces.begin(), flat_cofaces.end());
+      BOOST_CHECK(flat_cofaces == cofaces);
+    }
+    ++flat_sh;
+  }
+  BOOST_CHECK(flat.find({0, 4}) == flat.null_simplex());
+  BOOST_CHECK(flat.find({8}) == flat.null_simplex());
+
+  std::clog << "Bad header" << std::endl;
+  BOOST_CHECK_THROW((Flat_simplex_tree<Vertex_type, Filtration_type>(data, buffer_size - 1)), std::invalid_argument);
+  BOOST_CHECK_THROW((Flat_simplex_tree<Vertex_type, long double>(data, buffer_size)), std::invalid_argument);
+  data[0] = 'X';
+  BOOST_CHECK_THROW((Flat_simplex_tree<Vertex_type, Filtration_type>(data, buffer_size)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_empty_flat_serialization, Stree, list_of_tested_variants) {
+  Stree st;
+  const std::size_t buffer_size = get_flat_serialization_size(st);
+  std::vector<std::uint64_t> buffer((buffer_size + 7) / 8);
+  char* data = reinterpret_cast<char*>(buffer.data());
+  flat_serialize(st, data, buffer_size);
+
+  Flat_simplex_tree<typename Stree::Vertex_handle, typename Stree::Filtration_value> flat(data, buffer_size);
+  BOOST_CHECK(flat.num_simplices() == 0);
+  BOOST_CHECK(flat.dimension() == -1);
+  BOOST_CHECK(flat.filtration_simplex_range().empty());
+  BOOST_CHECK(flat.find({0}) == flat.null_simplex());
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_multi_parameter_flat_serialization) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "MULTI-PARAMETER FLAT SIMPLEX TREE SERIALIZATION" << std::endl;
+  using Stree = Simplex_tree<Gudhi::multiparameter::options_multi>;
+  using Value = Gudhi::multiparameter::options_multi::value_type;
+  Stree st;
+  st.set_number_of_parameters(2);
+  // Lower star filtration of random grades on few values, with many ties and incomparable grades
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> vertex(0, 11), grade(0, 3);
+  std::vector<Stree::Filtration_value> grades(12);
+  for (auto& g : grades) g = Stree::Filtration_value{static_cast<Value>(grade(gen)), static_cast<Value>(grade(gen))};
+  for (int i = 0; i < 40; ++i) st.insert_simplex_and_subfaces({vertex(gen), vertex(gen), vertex(gen), vertex(gen)});
+  for (auto sh : st.complex_simplex_range()) {
+    Stree::Filtration_value f{0, 0};
+    for (auto v : st.simplex_vertex_range(sh)) f.push_to(grades[v]);
+    st.assign_filtration(sh, f);
+  }
+
+  const std::size_t buffer_size = get_flat_serialization_size(st);
+  std::vector<std::uint64_t> buffer((buffer_size + 7) / 8);
+  char* data = reinterpret_cast<char*>(buffer.data());
+  flat_serialize(st, data, buffer_size);
+  Flat_simplex_tree<Stree::Vertex_handle, Value> flat(data, buffer_size);
+  BOOST_CHECK(flat.num_simplices() == st.num_simplices());
+  BOOST_CHECK(flat.num_parameters() == 2);
+
+  // Same filtration values, and every face before its cofaces
+  std::vector<std::size_t> position(flat.num_simplices());
+  std::size_t i = 0;
+  for (auto sh : flat.filtration_simplex_range()) position[sh] = i++;
+  BOOST_CHECK(i == st.num_simplices());
+  for (auto sh : st.complex_simplex_range()) {
+    auto flat_sh = flat.find(st.simplex_vertex_range(sh));
+    BOOST_REQUIRE(flat_sh != flat.null_simplex());
+    const auto& f = st.filtration(sh);
+    BOOST_CHECK(std::equal(f.begin(), f.end(), flat.filtration_values(flat_sh)));
+    for (auto face : st.boundary_simplex_range(sh)) {
+      auto flat_face = flat.find(st.simplex_vertex_range(face));
+      BOOST_CHECK(position[flat_face] < position[flat_sh]);
+    }
+  }
+}
+
+namespace vector_filtration {
+// Filtration value that is not trivially copyable, serialized with its size first
+struct Vector_filtration : std::vector<double> {
+  using std::vector<double>::vector;
+  friend std::size_t get_serialization_size_of(const Vector_filtration& value) {
+    return sizeof(std::size_t) + value.size() * sizeof(double);
+  }
+  friend char* serialize_value_to_char_buffer(const Vector_filtration& value, char* start) {
+    start = serialize_trivial(value.size(), start);
+    for (double v : value) start = serialize_trivial(v, start);
+    return start;
+  }
+  friend const char* deserialize_value_from_char_buffer(Vector_filtration& value, const char* start) {
+    std::size_t size;
+    start = deserialize_trivial(size, start);
+    value.resize(size);
+    for (double& v : value) start = deserialize_trivial(v, start);
+    return start;
+  }
+};
+}  // namespace vector_filtration
+
+struct Vector_filtration_options : Gudhi::Simplex_tree_options_full_featured {
+  typedef vector_filtration::Vector_filtration Filtration_value;
+};
+
+BOOST_AUTO_TEST_CASE(simplex_tree_vector_filtration_serialization) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "SIMPLEX TREE WITH VECTOR FILTRATION VALUES SERIALIZATION/DESERIALIZATION" << std::endl;
+  using Stree = Simplex_tree<Vector_filtration_options>;
+  Stree st;
+  st.insert_simplex_and_subfaces({2, 1, 0}, {1., 2.});
+  st.insert_simplex_and_subfaces({3, 0}, {0.5, 3., 4.});
+  st.insert_simplex_and_subfaces({3, 4, 5}, {});
+
+  const std::size_t buffer_size = st.get_serialization_size();
+  std::size_t filtration_size = 0;
+  for (auto sh : st.complex_simplex_range())
+    filtration_size += sizeof(std::size_t) + st.filtration(sh).size() * sizeof(double);
+  BOOST_CHECK(buffer_size == sizeof(Stree::Vertex_handle) * (1 + 2 * st.num_simplices()) + filtration_size);
+
+  std::vector<char> buffer(buffer_size);
+  st.serialize(buffer.data(), buffer_size);
+  Stree st_copy;
+  st_copy.deserialize(buffer.data(), buffer_size);
+  BOOST_CHECK(st == st_copy);
+  BOOST_CHECK(st_copy.filtration(st_copy.find({0, 3})) == Stree::Filtration_value({0.5, 3., 4.}));
+  BOOST_CHECK(st_copy.filtration(st_copy.find({4})).empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_content_hash, Stree, list_of_tested_variants) {
+  // Low_options does not store the filtration values
+  auto f = [](double value) { return Stree::Options::store_filtration ? value : 0.; };
+  Stree st, reversed;
+  BOOST_CHECK(st.content_hash() == reversed.content_hash());
+  st.insert_simplex_and_subfaces({0, 1, 6, 7}, f(4.));
+  st.insert_simplex_and_subfaces({3, 4, 5}, f(3.));
+  st.insert_simplex_and_subfaces({3, 0}, f(2.));
+  st.insert_simplex_and_subfaces({2, 1, 0}, f(3.));
+  // Same complex, inserted in another order
+  reversed.insert_simplex_and_subfaces({2, 1, 0}, f(3.));
+  reversed.insert_simplex_and_subfaces({3, 0}, f(2.));
+  reversed.insert_simplex_and_subfaces({3, 4, 5}, f(3.));
+  reversed.insert_simplex_and_subfaces({0, 1, 6, 7}, f(4.));
+  BOOST_CHECK(st.content_hash() == reversed.content_hash());
+
+  // Another filtration value, or another simplex, changes the hash
+  Stree other(st);
+  const Stree& const_other = other;
+  BOOST_CHECK(const_other.content_hash() == st.content_hash());
+  if constexpr (Stree::Options::store_filtration) {
+    other.assign_filtration(other.find({3, 4}), 3.5);
+    BOOST_CHECK(other.content_hash() != st.content_hash());
+    other.assign_filtration(other.find({3, 4}), 3.);
+    BOOST_CHECK(other.content_hash() == st.content_hash());
+  }
+  other.insert_simplex_and_subfaces({2, 4}, f(3.));
+  BOOST_CHECK(other.content_hash() != st.content_hash());
+  other.remove_maximal_simplex(other.find({2, 4}));
+  BOOST_CHECK(other.content_hash() == st.content_hash());
+  other.insert_simplex_and_subfaces({8}, f(3.));
+  BOOST_CHECK(other.content_hash() != st.content_hash());
+}
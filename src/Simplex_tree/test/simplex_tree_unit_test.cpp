@@ -18,7 +18,11 @@
 #include <functional>  // greater
 #include <tuple>  // std::tie
 #include <iterator>  // for std::distance
+#include <numeric>  // for std::iota
 #include <cstddef>  // for std::size_t
+#include <random>
+#include <atomic>
+#include <vector>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "simplex_tree"
@@ -44,10 +48,20 @@ struct Simplex_tree_options_stable_simplex_handles {
   static const bool is_multi_parameter = false;
 };
 
+struct Simplex_tree_options_pool_siblings : Simplex_tree_options_full_featured {
+  static const bool pool_siblings = true;
+};
+
+struct Simplex_tree_options_stable_pool_siblings : Simplex_tree_options_stable_simplex_handles {
+  static const bool pool_siblings = true;
+};
+
 typedef boost::mpl::list<Simplex_tree<>,
                          Simplex_tree<Simplex_tree_options_fast_persistence>,
                          Simplex_tree<Simplex_tree_options_fast_cofaces>,
-                         Simplex_tree<Simplex_tree_options_stable_simplex_handles> > list_of_tested_variants;
+                         Simplex_tree<Simplex_tree_options_stable_simplex_handles>,
+                         Simplex_tree<Simplex_tree_options_pool_siblings>,
+                         Simplex_tree<Simplex_tree_options_stable_pool_siblings> > list_of_tested_variants;
 
 template<class typeST>
 void test_empty_simplex_tree(typeST& tst) {
@@ -969,6 +983,60 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_insert_graph, Graph, list_of_graph_va
   BOOST_CHECK(sst1 == sst2);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_insert_csr_graph, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "INSERT CSR GRAPH" << std::endl;
+  using Filtration_value = typename typeST::Filtration_value;
+  using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                                      boost::property<vertex_filtration_t, Filtration_value>,
+                                      boost::property<edge_filtration_t, Filtration_value>>;
+  const int n = 30;
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> fil(0., 1.);
+  std::vector<std::pair<int, int>> edges;
+  std::vector<Filtration_value> edges_fil;
+  for (int u = 0; u < n; ++u)
+    for (int v = u + 1; v < n; ++v)
+      if (fil(gen) < 0.3) {
+        edges.emplace_back(u, v);
+        edges_fil.push_back(fil(gen));
+      }
+  Csr_proximity_graph<int, Filtration_value> csr(n, edges, edges_fil);
+  // The last vertices are isolated
+  Graph g(edges.begin(), edges.end(), edges_fil.begin(), n + 2);
+  csr.vertex_filtrations.resize(n + 2);
+  csr.offsets.resize(n + 3, csr.offsets.back());
+  for (int u = 0; u < n + 2; ++u) {
+    put(vertex_filtration_t(), g, u, 0.1 * u);
+    csr.vertex_filtrations[u] = 0.1 * u;
+  }
+  BOOST_CHECK(csr.num_vertices() == static_cast<std::size_t>(n + 2));
+  BOOST_CHECK(csr.num_edges() == edges.size());
+
+  typeST st_csr, st_graph;
+  st_csr.insert_graph(csr);
+  st_graph.insert_graph(g);
+  BOOST_CHECK(st_csr == st_graph);
+  BOOST_CHECK(st_csr.dimension() == 1);
+  st_csr.expansion(3);
+  st_graph.expansion(3);
+  BOOST_CHECK(st_csr == st_graph);
+  for (int u = 0; u < n + 2; ++u) {
+    auto sh_csr = st_csr.find({u});
+    auto sh_graph = st_graph.find({u});
+    BOOST_CHECK(boost::size(st_csr.cofaces_simplex_range(sh_csr, 0)) ==
+                boost::size(st_graph.cofaces_simplex_range(sh_graph, 0)));
+  }
+
+  typeST st_vertices;
+  st_vertices.insert_graph(Csr_proximity_graph<int, Filtration_value>(3, {}, {}));
+  BOOST_CHECK(st_vertices.num_simplices() == 3);
+  BOOST_CHECK(st_vertices.dimension() == 0);
+  typeST st_empty;
+  st_empty.insert_graph(Csr_proximity_graph<int, Filtration_value>());
+  BOOST_CHECK(st_empty.is_empty());
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(insert_duplicated_vertices, typeST, list_of_tested_variants) {
   std::clog << "********************************************************************" << std::endl;
   std::clog << "TEST INSERT DUPLICATED VERTICES" << std::endl;
@@ -1242,3 +1310,420 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(for_each_simplex_skip_iteration, typeST, list_of_t
   BOOST_CHECK(num_simplices_by_dim_until_two[0] == num_simplices_by_dim[0]);
   BOOST_CHECK(num_simplices_by_dim_until_two[1] == num_simplices_by_dim[1]);
 }
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_insert_batch, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "TEST INSERT BATCH" << std::endl;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> vertex(0, 20);
+  std::uniform_int_distribution<int> size(1, 5);
+  std::uniform_int_distribution<int> value(0, 9);
+  std::vector<std::vector<int>> simplices;
+  std::vector<typename typeST::Filtration_value> filtrations;
+  for (int i = 0; i < 300; ++i) {
+    // duplicated vertices are allowed, as for insert_simplex_and_subfaces
+    std::vector<int> simplex(size(gen));
+    for (auto& v : simplex) v = vertex(gen);
+    simplices.push_back(simplex);
+    filtrations.push_back(value(gen));
+  }
+
+  typeST st_batch, st;
+  // simplices already there are updated as with insert_simplex_and_subfaces
+  for (int i = 0; i < 10; ++i) {
+    st_batch.insert_simplex_and_subfaces({i, i + 1, i + 2}, value(gen));
+    st.insert_simplex_and_subfaces({i, i + 1, i + 2}, st_batch.filtration(st_batch.find({i, i + 1, i + 2})));
+  }
+  st_batch.insert_batch(simplices, [&filtrations](std::size_t i) { return filtrations[i]; });
+  for (std::size_t i = 0; i < simplices.size(); ++i)
+    st.insert_simplex_and_subfaces(simplices[i], filtrations[i]);
+
+  std::clog << "dimension = " << st_batch.dimension() << " - num_simplices = " << st_batch.num_simplices() << std::endl;
+  BOOST_CHECK(st_batch == st);
+  BOOST_CHECK(st_batch.dimension() == st.dimension());
+  BOOST_CHECK(st_batch.num_simplices() == st.num_simplices());
+  // the lists of nodes with the same label are also up to date
+  for (auto vertex : st.complex_vertex_range()) {
+    std::size_t num_cofaces = 0, num_cofaces_batch = 0;
+    for (auto sh : st.cofaces_simplex_range(st.find({vertex}), 0)) {
+      BOOST_CHECK(st_batch.find(st.simplex_vertex_range(sh)) != st_batch.null_simplex());
+      ++num_cofaces;
+    }
+    for ([[maybe_unused]] auto sh : st_batch.cofaces_simplex_range(st_batch.find({vertex}), 0)) ++num_cofaces_batch;
+    BOOST_CHECK(num_cofaces == num_cofaces_batch);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_insert_edges, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "TEST INSERT EDGES" << std::endl;
+  using Vertex_handle = typename typeST::Vertex_handle;
+  using Filtration_value = typename typeST::Filtration_value;
+  std::mt19937 gen(42);
+  // Repeated edges in both orientations, and loops
+  std::uniform_int_distribution<int> vertex(0, 15);
+  std::uniform_int_distribution<int> value(0, 9);
+  std::vector<std::tuple<Vertex_handle, Vertex_handle, Filtration_value>> edges;
+  for (int i = 0; i < 200; ++i) edges.emplace_back(vertex(gen), vertex(gen), value(gen));
+
+  typeST st_edges, st;
+  st_edges.insert_edges(edges);
+  for (const auto& [u, v, filt] : edges) st.insert_simplex_and_subfaces({u, v}, filt);
+  BOOST_CHECK(st_edges == st);
+  BOOST_CHECK(st_edges.dimension() == 1);
+  for (auto vertex : st.complex_vertex_range())
+    BOOST_CHECK(boost::size(st_edges.cofaces_simplex_range(st_edges.find({vertex}), 0)) ==
+                boost::size(st.cofaces_simplex_range(st.find({vertex}), 0)));
+
+  // Into a non empty complex
+  std::vector<std::tuple<Vertex_handle, Vertex_handle, Filtration_value>> more_edges;
+  for (int i = 0; i < 100; ++i) more_edges.emplace_back(vertex(gen) + 10, vertex(gen) + 10, value(gen));
+  st_edges.insert_edges(more_edges);
+  for (const auto& [u, v, filt] : more_edges) st.insert_simplex_and_subfaces({u, v}, filt);
+  BOOST_CHECK(st_edges == st);
+
+  typeST st_empty;
+  st_empty.insert_edges({});
+  BOOST_CHECK(st_empty.is_empty());
+  typeST st_loop;
+  st_loop.insert_edges({{0, 0, 1.}, {0, 0, 0.5}});
+  BOOST_CHECK(st_loop.num_simplices() == 1);
+  BOOST_CHECK(st_loop.dimension() == 0);
+  BOOST_CHECK(st_loop.filtration(st_loop.find({0})) == 0.5);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_filtration_order, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "TEST FILTRATION ORDER" << std::endl;
+  using Filtration_value = typename typeST::Filtration_value;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> vertex(0, 30);
+  std::uniform_int_distribution<int> value(0, 4);
+  // Many ties, negative values, both zeros and infinity
+  const Filtration_value values[] = {-1.5, -0., 0., 2., std::numeric_limits<Filtration_value>::infinity()};
+  typeST st;
+  for (int i = 0; i < 200; ++i)
+    st.insert_simplex_and_subfaces({vertex(gen), vertex(gen), vertex(gen), vertex(gen)}, values[value(gen)]);
+
+  auto check_order = [&st]() {
+    BOOST_CHECK(boost::size(st.filtration_simplex_range()) == st.num_simplices());
+    auto vertices = [&st](auto sh) {
+      // decreasing order
+      auto range = st.simplex_vertex_range(sh);
+      return std::vector<int>(range.begin(), range.end());
+    };
+    auto range = st.filtration_simplex_range();
+    for (auto it = range.begin(); std::next(it) != range.end(); ++it) {
+      auto next = std::next(it);
+      if (st.filtration(*it) == st.filtration(*next)) {
+        std::vector<int> simplex = vertices(*it), next_simplex = vertices(*next);
+        BOOST_CHECK(std::lexicographical_compare(simplex.begin(), simplex.end(),
+                                                 next_simplex.begin(), next_simplex.end()));
+      } else {
+        BOOST_CHECK(st.filtration(*it) < st.filtration(*next));
+      }
+    }
+  };
+  st.initialize_filtration();
+  check_order();
+
+  // Only the filtration values change
+  for (auto sh : st.complex_simplex_range()) st.assign_filtration(sh, values[value(gen)]);
+  st.update_filtration_order();
+  check_order();
+
+  // Small changes, repaired without sorting from scratch
+  std::uniform_int_distribution<int> change(0, 9);
+  for (auto sh : st.complex_simplex_range()) {
+    Filtration_value f = st.filtration(sh);
+    if (change(gen) == 0 && f < 2) st.assign_filtration(sh, f == -1.5 ? 0. : 2.);
+  }
+  st.update_filtration_order();
+  check_order();
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_boundary_matrix, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "TEST BOUNDARY MATRIX" << std::endl;
+  using Filtration_value = typename typeST::Filtration_value;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> vertex(0, 20);
+  std::uniform_int_distribution<int> value(0, 10);
+  typeST st;
+  for (int i = 0; i < 100; ++i)
+    st.insert_simplex_and_subfaces({vertex(gen), vertex(gen), vertex(gen), vertex(gen)}, value(gen));
+  st.make_filtration_non_decreasing();
+
+  const std::size_t n = st.num_simplices();
+  const std::size_t nnz = st.num_boundary_entries();
+  std::vector<std::size_t> column_offsets(n + 1);
+  std::vector<int> row_indices(nnz), dimensions(n);
+  std::vector<Filtration_value> filtrations(n);
+  st.fill_boundary_matrix(column_offsets.begin(), row_indices.begin(), dimensions.begin(), filtrations.begin());
+  BOOST_CHECK(column_offsets[n] == nnz);
+
+  std::size_t i = 0;
+  for (auto sh : st.filtration_simplex_range()) {
+    BOOST_CHECK(st.key(sh) == i);
+    BOOST_CHECK(dimensions[i] == st.dimension(sh));
+    BOOST_CHECK(filtrations[i] == st.filtration(sh));
+    std::vector<int> expected;
+    if (st.dimension(sh) > 0)
+      for (auto facet : st.boundary_simplex_range(sh)) expected.push_back(st.key(facet));
+    std::sort(expected.begin(), expected.end());
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), row_indices.begin() + column_offsets[i],
+                           row_indices.begin() + column_offsets[i + 1]));
+    // Facets come first in the filtration
+    if (!expected.empty()) BOOST_CHECK(static_cast<std::size_t>(expected.back()) < i);
+    ++i;
+  }
+  BOOST_CHECK(i == n);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_vertex_subtree_range, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "TEST VERTEX SUBTREE RANGE" << std::endl;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> vertex(0, 30);
+  typeST st;
+  for (int i = 0; i < 100; ++i)
+    st.insert_simplex_and_subfaces({vertex(gen), vertex(gen), vertex(gen), vertex(gen)});
+
+  // The halves of a split range visit all the simplices once
+  struct Split {};
+  auto first = st.vertex_subtree_range();
+  BOOST_CHECK(first.size() == st.num_vertices());
+  BOOST_CHECK(first.is_divisible());
+  decltype(first) second(first, Split());
+  BOOST_CHECK(first.size() + second.size() == st.num_vertices());
+  BOOST_CHECK(first.end() == second.begin());
+  std::vector<typename typeST::Simplex_handle> visited;
+  auto visit = [&](typename typeST::Simplex_handle sh, int dim) {
+    BOOST_CHECK(dim == st.dimension(sh));
+    visited.push_back(sh);
+  };
+  st.for_each_simplex(second, visit);
+  st.for_each_simplex(first, visit);
+  BOOST_CHECK(visited.size() == st.num_simplices());
+  // Same order as for_each_simplex
+  std::size_t i = 0;
+  st.for_each_simplex([&](typename typeST::Simplex_handle sh, int) { BOOST_CHECK(visited[i++] == sh); });
+
+  // Concurrent visit
+  std::atomic<std::size_t> count = 0;
+  st.parallel_for_each_simplex([&](typename typeST::Simplex_handle sh, int dim) {
+    st.assign_key(sh, dim);
+    ++count;
+  });
+  BOOST_CHECK(count == st.num_simplices());
+  for (auto sh : st.complex_simplex_range())
+    BOOST_CHECK(st.key(sh) == static_cast<typename typeST::Simplex_key>(st.dimension(sh)));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_cofaces_simplex_ranges, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "TEST BATCH COFACES" << std::endl;
+  using Simplex_handle = typename typeST::Simplex_handle;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> vertex(0, 30);
+  typeST st;
+  for (int i = 0; i < 100; ++i)
+    st.insert_simplex_and_subfaces({vertex(gen), vertex(gen), vertex(gen), vertex(gen)});
+
+  auto check = [&](const std::vector<Simplex_handle>& simplices, int codimension) {
+    std::vector<std::size_t> offsets;
+    std::vector<Simplex_handle> cofaces;
+    st.cofaces_simplex_ranges(simplices, codimension, offsets, cofaces);
+    BOOST_CHECK(offsets.size() == simplices.size() + 1);
+    BOOST_CHECK(offsets.front() == 0);
+    BOOST_CHECK(offsets.back() == cofaces.size());
+    for (std::size_t i = 0; i < simplices.size(); ++i) {
+      std::vector<Simplex_handle> expected;
+      for (auto sh : st.cofaces_simplex_range(simplices[i], codimension)) expected.push_back(sh);
+      std::vector<Simplex_handle> batch(cofaces.begin() + offsets[i], cofaces.begin() + offsets[i + 1]);
+      BOOST_CHECK(batch.size() == expected.size());
+      for (auto sh : expected) BOOST_CHECK(std::find(batch.begin(), batch.end(), sh) != batch.end());
+    }
+  };
+  // All the vertices, with a duplicate, share one traversal of the complex
+  std::vector<Simplex_handle> vertices;
+  for (auto v : st.complex_vertex_range()) vertices.push_back(st.find({v}));
+  vertices.push_back(vertices.front());
+  // A few simplices of various dimensions are queried one by one
+  std::vector<Simplex_handle> simplices{vertices[3], st.find({*st.complex_vertex_range().begin()})};
+  for (auto sh : st.skeleton_simplex_range(2))
+    if (st.dimension(sh) > 0 && simplices.size() < 6) simplices.push_back(sh);
+  for (int codimension = 0; codimension < 4; ++codimension) {
+    check(vertices, codimension);
+    check(simplices, codimension);
+  }
+  check({}, 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_find_index, typeST, list_of_tested_variants) {
+  std::clog << "********************************************************************" << std::endl;
+  std::clog << "TEST FIND INDEX" << std::endl;
+  using Vertex_handle = typename typeST::Vertex_handle;
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> vertex(0, 30);
+  typeST st;
+  for (int i = 0; i < 100; ++i)
+    st.insert_simplex_and_subfaces({vertex(gen), vertex(gen), vertex(gen), vertex(gen)});
+  typeST reference(st);
+  st.enable_find_index();
+
+  // Same answers as the tree, for the simplices of the complex and random ones
+  auto check = [&]() {
+    for (auto sh : st.complex_simplex_range()) {
+      std::vector<Vertex_handle> simplex(st.simplex_vertex_range(sh).begin(), st.simplex_vertex_range(sh).end());
+      BOOST_CHECK(st.find(simplex) == sh);
+    }
+    for (int i = 0; i < 200; ++i) {
+      std::vector<Vertex_handle> simplex{vertex(gen), vertex(gen) + 20, vertex(gen)};
+      BOOST_CHECK((st.find(simplex) == st.null_simplex()) == (reference.find(simplex) == reference.null_simplex()));
+    }
+    BOOST_CHECK(st.find({-1}) == st.null_simplex());
+    BOOST_CHECK(st.find({0, 1000}) == st.null_simplex());
+    BOOST_CHECK(st.find({3, 3}) == st.null_simplex());
+  };
+  check();
+  // The index is rebuilt after modifications
+  st.insert_simplex_and_subfaces({31, 32, 33});
+  reference.insert_simplex_and_subfaces({31, 32, 33});
+  BOOST_CHECK(st.find({31, 32, 33}) != st.null_simplex());
+  check();
+  st.remove_maximal_simplex(st.find({31, 32, 33}));
+  reference.remove_maximal_simplex(reference.find({31, 32, 33}));
+  BOOST_CHECK(st.find({31, 32, 33}) == st.null_simplex());
+  check();
+  st.prune_above_dimension(1);
+  reference.prune_above_dimension(1);
+  check();
+  // Also after the bulk insertions, including the parallel expansion when GUDHI_USE_TBB is defined
+  st.expansion(3);
+  reference.expansion(3);
+  check();
+  st.prune_above_dimension(1);
+  reference.prune_above_dimension(1);
+  check();
+  auto no_blocker = [](auto) { return false; };
+  st.expansion_with_monotone_blockers(3, no_blocker);
+  reference.expansion_with_monotone_blockers(3, no_blocker);
+  check();
+  st.insert_batch_vertices(std::vector<Vertex_handle>{34, 35});
+  reference.insert_batch_vertices(std::vector<Vertex_handle>{34, 35});
+  BOOST_CHECK(st.find({35}) != st.null_simplex());
+  check();
+  if constexpr (!typeST::Options::contiguous_vertices) {
+    // Simplices with too many vertices to be packed are searched in the tree
+    std::vector<Vertex_handle> large{1 << 20, 1, 2, 3, 4, 5, 6};
+    st.insert_simplex_and_subfaces(large);
+    BOOST_CHECK(st.find(large) != st.null_simplex());
+    BOOST_CHECK(st.find({1, 2, 3, 4, 5, 6}) != st.null_simplex());
+    BOOST_CHECK(st.dimension(st.find(large)) == 6);
+    typeST copy(st);
+    BOOST_CHECK(copy.find(large) != copy.null_simplex());
+    st.enable_find_index(false);
+    BOOST_CHECK(st.find(large) != st.null_simplex());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(simplex_tree_memory_usage, typeST, list_of_tested_variants) {
+  typeST st;
+  auto empty = st.memory_usage();
+  BOOST_CHECK(empty.siblings == sizeof(typename typeST::Siblings));
+  BOOST_CHECK(empty.filtration_cache == 0);
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> vertex(0, 29);
+  for (int i = 0; i < 150; ++i) {
+    int u = vertex(gen), v = vertex(gen);
+    if (u != v) st.insert_simplex_and_subfaces(std::vector<int>{u, v}, 1.);
+  }
+  st.expansion(3);
+  auto usage = st.memory_usage();
+  std::clog << "memory usage of " << st.num_simplices() << " simplices: " << usage.total() << " bytes" << std::endl;
+  BOOST_CHECK(usage.nodes >= st.num_simplices() * sizeof(typename typeST::Dictionary::value_type));
+  BOOST_CHECK(usage.siblings > empty.siblings);
+  BOOST_CHECK(usage.filtration_values == 0);
+  BOOST_CHECK(usage.filtration_cache == 0);
+  BOOST_CHECK(usage.total() ==
+              usage.nodes + usage.siblings + usage.label_lists + usage.filtration_cache + usage.find_index);
+  if constexpr (typeST::Options::link_nodes_by_label) BOOST_CHECK(usage.label_lists > 0);
+
+  st.initialize_filtration();
+  BOOST_CHECK(st.memory_usage().filtration_cache >= st.num_simplices() * sizeof(typename typeST::Simplex_handle));
+
+  // The estimate counts the nodes without unused capacity, and bounds the number of siblings
+  auto estimate = typeST::estimate_memory_usage(st.num_simplices_by_dimension());
+  BOOST_CHECK(estimate.nodes <= usage.nodes);
+  BOOST_CHECK(estimate.siblings >= usage.siblings);
+  BOOST_CHECK(estimate.filtration_cache == st.num_simplices() * sizeof(typename typeST::Simplex_handle));
+  BOOST_CHECK(estimate.total() <= 2 * st.memory_usage().total());
+  BOOST_CHECK(2 * estimate.total() >= st.memory_usage().total());
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_float_filtration) {
+  Simplex_tree<> st;
+  Simplex_tree<Simplex_tree_options_float_filtration> st_float;
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> vertex(0, 29);
+  std::uniform_real_distribution<double> filtration(0., 1.);
+  for (int i = 0; i < 150; ++i) {
+    int u = vertex(gen), v = vertex(gen);
+    double f = filtration(gen);
+    if (u != v) {
+      st.insert_simplex_and_subfaces(std::vector<int>{u, v}, f);
+      st_float.insert_simplex_and_subfaces(std::vector<int>{u, v}, static_cast<float>(f));
+    }
+  }
+  st.expansion(3);
+  st_float.expansion(3);
+  BOOST_CHECK(st.num_simplices() == st_float.num_simplices());
+  // The filtration values are the ones of the double tree rounded to float
+  for (auto sh : st.complex_simplex_range()) {
+    auto sh_float = st_float.find(st.simplex_vertex_range(sh));
+    BOOST_CHECK(st_float.filtration(sh_float) == static_cast<float>(st.filtration(sh)));
+  }
+  // The nodes are smaller
+  BOOST_CHECK(sizeof(Simplex_tree<Simplex_tree_options_float_filtration>::Node) < sizeof(Simplex_tree<>::Node));
+  BOOST_CHECK(st_float.memory_usage().nodes < st.memory_usage().nodes);
+}
+
+BOOST_AUTO_TEST_CASE(simplex_tree_contiguous_root) {
+  // The root of st has the vertices 0 to 9, the one of shifted the vertices 1 to 10
+  Simplex_tree<> st, shifted;
+  std::vector<int> vertices(10);
+  std::iota(vertices.begin(), vertices.end(), 0);
+  st.insert_batch_vertices(vertices, 1.);
+  for (int& v : vertices) ++v;
+  shifted.insert_batch_vertices(vertices, 1.);
+  BOOST_CHECK(st.contiguous_vertices());
+  BOOST_CHECK(!shifted.contiguous_vertices());
+  for (int u = 0; u < 10; u += 2) {
+    for (int v = u + 1; v < 10; v += 3) {
+      BOOST_CHECK(st.insert_simplex_and_subfaces({u, v}, u + v).second);
+      BOOST_CHECK(shifted.insert_simplex_and_subfaces({u + 1, v + 1}, u + v).second);
+    }
+  }
+  // Lower filtration value for an existing vertex
+  BOOST_CHECK(st.insert_simplex({3}, 0.).first != st.null_simplex());
+  BOOST_CHECK(shifted.insert_simplex({4}, 0.).first != shifted.null_simplex());
+  BOOST_CHECK(st.num_simplices() == shifted.num_simplices());
+  for (auto sh : shifted.complex_simplex_range()) {
+    std::vector<int> simplex;
+    for (int v : shifted.simplex_vertex_range(sh)) simplex.push_back(v - 1);
+    auto st_sh = st.find(simplex);
+    BOOST_CHECK(st_sh != st.null_simplex());
+    BOOST_CHECK(st.filtration(st_sh) == shifted.filtration(sh));
+  }
+  BOOST_CHECK(st.filtration(st.find({3})) == 0.);
+  BOOST_CHECK(st.find({-1}) == st.null_simplex());
+  BOOST_CHECK(st.find({10}) == st.null_simplex());
+  BOOST_CHECK(st.find({1, 10}) == st.null_simplex());
+  // A new vertex after the last one keeps the root contiguous
+  BOOST_CHECK(st.insert_simplex_and_subfaces({9, 10}, 2.).second);
+  BOOST_CHECK(st.contiguous_vertices());
+  BOOST_CHECK(st.find({9, 10}) != st.null_simplex());
+  BOOST_CHECK(st.num_vertices() == 11);
+}
@@ -35,10 +35,6 @@ ComplexType> {
   typedef typename ComplexType::Root_vertex_handle Root_vertex_handle;
   typedef typename ComplexType::Simplex Simplex;
   typedef typename ComplexType::Root_simplex_handle Root_simplex_handle;
-  typedef typename ComplexType::BlockerMap BlockerMap;
-  typedef typename ComplexType::BlockerPair BlockerPair;
-  typedef typename ComplexType::BlockerMapIterator BlockerMapIterator;
-  typedef typename ComplexType::BlockerMapConstIterator BlockerMapConstIterator;
   typedef typename ComplexType::Simplex::Simplex_vertex_const_iterator AddressSimplexConstIterator;
   typedef typename ComplexType::Root_simplex_handle::Simplex_vertex_const_iterator IdSimplexConstIterator;
 
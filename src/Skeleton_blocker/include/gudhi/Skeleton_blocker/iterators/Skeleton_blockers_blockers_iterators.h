@@ -13,43 +13,51 @@
 
 #include <boost/iterator/iterator_facade.hpp>
 
+#include <cstddef>  // for std::size_t
+
 namespace Gudhi {
 
 namespace skeleton_blocker {
 
 /**
- * @brief Iterator through the blockers of a vertex.
+ * @brief Iterator through the blockers of the complex.
  */
 // ReturnType = const Simplex* or Simplex*
-// MapIteratorType = BlockerMapConstIterator or BlockerMapIterator
+// ListsIteratorType = iterator or const_iterator on the lists of blockers of each vertex
 
-template<typename MapIteratorType, typename ReturnType>
+template<typename ListsIteratorType, typename ReturnType>
 class Blocker_iterator_internal : public boost::iterator_facade<
-Blocker_iterator_internal<MapIteratorType, ReturnType>,
+Blocker_iterator_internal<ListsIteratorType, ReturnType>,
 ReturnType,
 boost::forward_traversal_tag,
 ReturnType
 > {
  private:
-  MapIteratorType current_position;
-  MapIteratorType end_of_map;
+  // The blockers of the vertex 'vertex_' are in '*current_list_'
+  ListsIteratorType current_list_;
+  ListsIteratorType end_of_lists_;
+  std::size_t vertex_;
+  std::size_t position_;
 
  public:
-  Blocker_iterator_internal() : current_position() { }
+  Blocker_iterator_internal() : current_list_(), end_of_lists_(), vertex_(0), position_(0) { }
 
-  Blocker_iterator_internal(MapIteratorType position, MapIteratorType end_of_map_) :
-      current_position(position), end_of_map(end_of_map_) { }
+  Blocker_iterator_internal(ListsIteratorType begin_of_lists, ListsIteratorType end_of_lists) :
+      current_list_(begin_of_lists), end_of_lists_(end_of_lists), vertex_(0), position_(0) {
+    goto_first_time_blocker_is_seen();
+  }
 
   bool equal(const Blocker_iterator_internal& other) const {
-    return current_position == other.current_position;
+    return current_list_ == other.current_list_ && position_ == other.position_;
   }
 
   void increment() {
-    goto_next_blocker();
+    ++position_;
+    goto_first_time_blocker_is_seen();
   }
 
   ReturnType dereference() const {
-    return (current_position->second);
+    return (*current_list_)[position_];
   }
 
  private:
@@ -58,14 +66,22 @@ ReturnType
    * If v is not the first vertex of sigma then we already have seen sigma as a blocker
    * and we look for the next one.
    */
-  void goto_next_blocker() {
-    do {
-      ++current_position;
-    } while (!(current_position == end_of_map) && !first_time_blocker_is_seen());
+  void goto_first_time_blocker_is_seen() {
+    while (current_list_ != end_of_lists_) {
+      if (position_ == current_list_->size()) {
+        ++current_list_;
+        ++vertex_;
+        position_ = 0;
+      } else if (first_time_blocker_is_seen()) {
+        return;
+      } else {
+        ++position_;
+      }
+    }
   }
 
   bool first_time_blocker_is_seen() const {
-    return current_position->first == current_position->second->first_vertex();
+    return static_cast<std::size_t>((*current_list_)[position_]->first_vertex().vertex) == vertex_;
   }
 };
 
@@ -73,22 +89,22 @@ ReturnType
  * @brief Iterator through the blockers of a vertex
  */
 // ReturnType = const Simplex* or Simplex*
-// MapIteratorType = BlockerMapConstIterator or BlockerMapIterator
+// ListIteratorType = iterator or const_iterator on the list of blockers of the vertex
 
-template<typename MapIteratorType, typename ReturnType>
+template<typename ListIteratorType, typename ReturnType>
 class Blocker_iterator_around_vertex_internal : public boost::iterator_facade<
-Blocker_iterator_around_vertex_internal<MapIteratorType, ReturnType>,
+Blocker_iterator_around_vertex_internal<ListIteratorType, ReturnType>,
 ReturnType,
 boost::forward_traversal_tag,
 ReturnType
 > {
  private:
-  MapIteratorType current_position_;
+  ListIteratorType current_position_;
 
  public:
   Blocker_iterator_around_vertex_internal() : current_position_() { }
 
-  Blocker_iterator_around_vertex_internal(MapIteratorType position) :
+  Blocker_iterator_around_vertex_internal(ListIteratorType position) :
       current_position_(position) { }
 
   Blocker_iterator_around_vertex_internal& operator=(Blocker_iterator_around_vertex_internal other) {
@@ -105,10 +121,10 @@ ReturnType
   }
 
   ReturnType dereference() const {
-    return (current_position_->second);
+    return *current_position_;
   }
 
-  MapIteratorType current_position() {
+  ListIteratorType current_position() {
     return this->current_position_;
   }
 };
@@ -114,10 +114,12 @@ class Skeleton_blocker_complex {
   typedef typename boost::graph_traits<Graph>::edge_descriptor Edge_handle;
 
  protected:
-  typedef std::multimap<Vertex_handle, Simplex *> BlockerMap;
-  typedef typename std::multimap<Vertex_handle, Simplex *>::value_type BlockerPair;
-  typedef typename std::multimap<Vertex_handle, Simplex *>::iterator BlockerMapIterator;
-  typedef typename std::multimap<Vertex_handle, Simplex *>::const_iterator BlockerMapConstIterator;
+  // The blockers passing through a vertex, in their order of insertion
+  typedef std::vector<Simplex *> Blocker_list;
+  typedef typename Blocker_list::iterator Blocker_list_iterator;
+  typedef typename Blocker_list::const_iterator Blocker_list_const_iterator;
+  // blocker_lists_[v] are the blockers passing through the vertex v
+  typedef std::vector<Blocker_list> Blocker_lists;
 
  protected:
   size_t num_vertices_;
@@ -138,8 +140,21 @@ class Skeleton_blocker_complex {
   std::vector<boost_vertex_handle> degree_;
   Graph skeleton; /** 1-skeleton of the simplicial complex. */
 
-  /** Each vertex can access to the blockers passing through it. */
-  BlockerMap blocker_map_;
+  /** Each vertex can access to the blockers passing through it.
+   * A blocker is stored once for each of its vertices, in flat vectors, which uses much less memory than a
+   * multimap. */
+  Blocker_lists blocker_lists_;
+
+  Blocker_list& blockers_around(Vertex_handle v) {
+    if (blocker_lists_.size() <= static_cast<std::size_t>(v.vertex)) blocker_lists_.resize(v.vertex + 1);
+    return blocker_lists_[v.vertex];
+  }
+
+  const Blocker_list& blockers_around(Vertex_handle v) const {
+    static const Blocker_list no_blockers;
+    if (blocker_lists_.size() <= static_cast<std::size_t>(v.vertex)) return no_blockers;
+    return blocker_lists_[v.vertex];
+  }
 
  public:
   /////////////////////////////////////////////////////////////////////////////
@@ -675,11 +690,8 @@ class Skeleton_blocker_complex {
         visitor->on_add_blocker(blocker);
       Blocker_handle blocker_pt = new Simplex(blocker);
       num_blockers_++;
-      auto vertex = blocker_pt->begin();
-      while (vertex != blocker_pt->end()) {
-        blocker_map_.insert(BlockerPair(*vertex, blocker_pt));
-        ++vertex;
-      }
+      for (auto vertex : *blocker_pt)
+        blockers_around(vertex).push_back(blocker_pt);
       return blocker_pt;
     }
   }
@@ -696,11 +708,8 @@ class Skeleton_blocker_complex {
       if (visitor)
         visitor->on_add_blocker(*blocker);
       num_blockers_++;
-      auto vertex = blocker->begin();
-      while (vertex != blocker->end()) {
-        blocker_map_.insert(BlockerPair(*vertex, blocker));
-        ++vertex;
-      }
+      for (auto vertex : *blocker)
+        blockers_around(vertex).push_back(blocker);
     }
   }
 
@@ -709,18 +718,14 @@ class Skeleton_blocker_complex {
    * Removes sigma from the blocker map of vertex v
    */
   void remove_blocker(const Blocker_handle sigma, Vertex_handle v) {
-    Complex_blocker_around_vertex_iterator blocker;
-    for (blocker = blocker_range(v).begin(); blocker != blocker_range(v).end();
-         ++blocker) {
-      if (*blocker == sigma)
-        break;
-    }
-    if (*blocker != sigma) {
+    Blocker_list& blockers = blockers_around(v);
+    auto blocker = std::find(blockers.begin(), blockers.end(), sigma);
+    if (blocker == blockers.end()) {
       std::cerr
-          << "bug ((*blocker).second == sigma) ie try to remove a blocker not present\n";
+          << "bug (*blocker == sigma) ie try to remove a blocker not present\n";
       assert(false);
     } else {
-      blocker_map_.erase(blocker.current_position());
+      blockers.erase(blocker);
     }
   }
 
@@ -740,12 +745,15 @@ class Skeleton_blocker_complex {
    * complex to the smallest flag complex that contains it.
    */
   void remove_blockers() {
-    // Deallocate the blockers
-    while (!blocker_map_.empty()) {
-      delete_blocker(blocker_map_.begin()->second);
-    }
+    // Deallocate the blockers, after notifying the visitor of all of them
+    std::vector<Blocker_handle> blockers(blocker_range().begin(), blocker_range().end());
+    if (visitor)
+      for (auto blocker : blockers)
+        visitor->on_delete_blocker(blocker);
+    for (auto blocker : blockers)
+      delete blocker;
     num_blockers_ = 0;
-    blocker_map_.clear();
+    blocker_lists_.clear();
   }
 
  protected:
@@ -812,9 +820,10 @@ class Skeleton_blocker_complex {
    * is a face of sigma.
    */
   bool blocks(const Simplex & sigma) const {
+    // A blocker contained in sigma is checked only once, at its first vertex
     for (auto s : sigma)
       for (auto blocker : const_blocker_range(s))
-        if (sigma.contains(*blocker))
+        if (blocker->first_vertex() == s && blocker->dimension() <= sigma.dimension() && sigma.contains(*blocker))
           return true;
     return false;
   }
@@ -1044,7 +1053,7 @@ class Skeleton_blocker_complex {
       return true;
     for (auto vi : vertex_range()) {
       // xxx todo create a method: bool is_in_blocker(Vertex_handle)
-      if (blocker_map_.find(vi) == blocker_map_.end()) {
+      if (blockers_around(vi).empty()) {
         // no blocker passes through the vertex, we just need to
         // check if the current vertex is linked to all others vertices of the complex
         if (degree_[vi.vertex] == num_vertices() - 1)
@@ -1446,7 +1455,7 @@ class Skeleton_blocker_complex {
    * @brief Iterator over the blockers adjacent to a vertex
    */
   typedef Blocker_iterator_around_vertex_internal<
-  typename std::multimap<Vertex_handle, Simplex *>::iterator,
+  Blocker_list_iterator,
   Blocker_handle>
   Complex_blocker_around_vertex_iterator;
 
@@ -1454,7 +1463,7 @@ class Skeleton_blocker_complex {
    * @brief Iterator over (constant) blockers adjacent to a vertex
    */
   typedef Blocker_iterator_around_vertex_internal<
-  typename std::multimap<Vertex_handle, Simplex *>::const_iterator,
+  Blocker_list_const_iterator,
   const Blocker_handle>
   Const_complex_blocker_around_vertex_iterator;
 
@@ -1467,8 +1476,9 @@ class Skeleton_blocker_complex {
    * @brief Returns a range of the blockers of the complex passing through a vertex
    */
   Complex_blocker_around_vertex_range blocker_range(Vertex_handle v) {
-    auto begin = Complex_blocker_around_vertex_iterator(blocker_map_.lower_bound(v));
-    auto end = Complex_blocker_around_vertex_iterator(blocker_map_.upper_bound(v));
+    Blocker_list& blockers = blockers_around(v);
+    auto begin = Complex_blocker_around_vertex_iterator(blockers.begin());
+    auto end = Complex_blocker_around_vertex_iterator(blockers.end());
     return Complex_blocker_around_vertex_range(begin, end);
   }
 
@@ -1476,8 +1486,9 @@ class Skeleton_blocker_complex {
    * @brief Returns a range of the blockers of the complex passing through a vertex
    */
   Const_complex_blocker_around_vertex_range const_blocker_range(Vertex_handle v) const {
-    auto begin = Const_complex_blocker_around_vertex_iterator(blocker_map_.lower_bound(v));
-    auto end = Const_complex_blocker_around_vertex_iterator(blocker_map_.upper_bound(v));
+    const Blocker_list& blockers = blockers_around(v);
+    auto begin = Const_complex_blocker_around_vertex_iterator(blockers.begin());
+    auto end = Const_complex_blocker_around_vertex_iterator(blockers.end());
     return Const_complex_blocker_around_vertex_range(begin, end);
   }
 
@@ -1486,7 +1497,7 @@ class Skeleton_blocker_complex {
    * @brief Iterator over the blockers.
    */
   typedef Blocker_iterator_internal<
-  typename std::multimap<Vertex_handle, Simplex *>::iterator,
+  typename Blocker_lists::iterator,
   Blocker_handle>
   Complex_blocker_iterator;
 
@@ -1494,7 +1505,7 @@ class Skeleton_blocker_complex {
    * @brief Iterator over the (constant) blockers.
    */
   typedef Blocker_iterator_internal<
-  typename std::multimap<Vertex_handle, Simplex *>::const_iterator,
+  typename Blocker_lists::const_iterator,
   const Blocker_handle>
   Const_complex_blocker_iterator;
 
@@ -1506,8 +1517,8 @@ class Skeleton_blocker_complex {
    * @brief Returns a range of the blockers of the complex
    */
   Complex_blocker_range blocker_range() {
-    auto begin = Complex_blocker_iterator(blocker_map_.begin(), blocker_map_.end());
-    auto end = Complex_blocker_iterator(blocker_map_.end(), blocker_map_.end());
+    auto begin = Complex_blocker_iterator(blocker_lists_.begin(), blocker_lists_.end());
+    auto end = Complex_blocker_iterator(blocker_lists_.end(), blocker_lists_.end());
     return Complex_blocker_range(begin, end);
   }
 
@@ -1515,8 +1526,8 @@ class Skeleton_blocker_complex {
    * @brief Returns a range of the blockers of the complex
    */
   Const_complex_blocker_range const_blocker_range() const {
-    auto begin = Const_complex_blocker_iterator(blocker_map_.begin(), blocker_map_.end());
-    auto end = Const_complex_blocker_iterator(blocker_map_.end(), blocker_map_.end());
+    auto begin = Const_complex_blocker_iterator(blocker_lists_.begin(), blocker_lists_.end());
+    auto end = Const_complex_blocker_iterator(blocker_lists_.end(), blocker_lists_.end());
     return Const_complex_blocker_range(begin, end);
   }
 
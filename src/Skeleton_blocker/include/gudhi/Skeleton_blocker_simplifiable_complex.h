@@ -78,6 +78,8 @@ void Skeleton_blocker_complex<SkeletonBlockerDS>::remove_popable_blockers(Vertex
       if (is_popable_blocker(block)) {
         this->delete_blocker(block);
         blocker_popable_found = true;
+        // The range is invalidated by the removal
+        break;
       }
     }
   }
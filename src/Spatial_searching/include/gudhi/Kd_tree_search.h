@@ -6,6 +6,7 @@
  *
  *    Modification(s):
  *      - 2019/08 Vincent Rouvreau: Fix issue #10 for CGAL and Eigen3
+ *      - 2023/11 David Loiseaux: Batched queries
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -25,8 +26,17 @@
 
 #include <boost/property_map/property_map.hpp>
 #include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/function_output_iterator.hpp>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>  // for std::min
 #include <cstddef>
+#include <functional>  // for std::ref
+#include <iterator>  // for std::size
+#include <utility>  // for std::pair
 #include <vector>
 
 // Make compilation fail - required for external projects - https://github.com/GUDHI/gudhi-devel/issues/10
@@ -358,11 +368,99 @@ class Kd_tree_search {
     m_tree.search(it, Sphere_for_kdtree_search(p, sq_radius_min, sq_radius_max, true, m_tree.traits()));
   }
 
+  /// \brief Neighbors of a batch of query points, in compressed sparse row format.
+  /// \details The neighbors of the i-th query are at the positions `offsets[i]` to `offsets[i+1]-1` of `indices`
+  /// (indices of the points) and `squared_distances` (squared distances to the query).
+  struct Batch_neighbors {
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> indices;
+    std::vector<FT> squared_distances;
+  };
+
+  /// \brief Same as `k_nearest_neighbors` for each point of a range, in parallel when TBB is available.
+  /// @param[in] queries Random access range of query points.
+  /// @param[in] k Number of nearest points to search for each query.
+  /// @param[in] sorted Indicates if the k-nearest neighbors of each query need to be sorted.
+  /// @param[in] eps Approximation factor.
+  /// @return The neighbors of the queries, `min(k, number of points in the tree)` for each query.
+  template <typename Query_range>
+  Batch_neighbors k_nearest_neighbors_batch(
+    Query_range const& queries,
+    unsigned int k,
+    bool sorted = true,
+    FT eps = FT(0)) const {
+    const std::size_t num_queries = std::size(queries);
+    const std::size_t num_neighbors = (std::min)(static_cast<std::size_t>(k), m_tree.size());
+    Batch_neighbors result;
+    result.offsets.resize(num_queries + 1);
+    for (std::size_t i = 0; i <= num_queries; ++i) result.offsets[i] = i * num_neighbors;
+    result.indices.resize(num_queries * num_neighbors);
+    result.squared_distances.resize(num_queries * num_neighbors);
+    for_each_query(num_queries, [&](std::size_t i) {
+      std::size_t pos = result.offsets[i];
+      for (auto const& neighbor : k_nearest_neighbors(queries[i], k, sorted, eps)) {
+        result.indices[pos] = neighbor.first;
+        result.squared_distances[pos] = neighbor.second;
+        ++pos;
+      }
+    });
+    return result;
+  }
+
+  /// \brief Same as `all_near_neighbors` for each point of a range, in parallel when TBB is available.
+  /// @param[in] queries Random access range of query points.
+  /// @param[in] radius The search radius.
+  /// @param[in] eps Approximation factor.
+  /// @return The neighbors of the queries, in no particular order for each query.
+  template <typename Query_range>
+  Batch_neighbors all_near_neighbors_batch(
+    Query_range const& queries,
+    FT const& radius,
+    FT eps = FT(0)) const {
+    const std::size_t num_queries = std::size(queries);
+    Orthogonal_distance distance(std::begin(m_points));
+    // The number of neighbors is not known in advance, so they are first stored per query.
+    std::vector<std::vector<std::pair<std::size_t, FT>>> neighbors(num_queries);
+    for_each_query(num_queries, [&](std::size_t i) {
+      auto output = [&](std::ptrdiff_t idx) {
+        neighbors[i].emplace_back(idx, distance.transformed_distance(queries[i], idx));
+      };
+      all_near_neighbors(queries[i], radius, boost::make_function_output_iterator(std::ref(output)), eps);
+    });
+    Batch_neighbors result;
+    result.offsets.resize(num_queries + 1);
+    result.offsets[0] = 0;
+    for (std::size_t i = 0; i < num_queries; ++i) result.offsets[i + 1] = result.offsets[i] + neighbors[i].size();
+    result.indices.resize(result.offsets[num_queries]);
+    result.squared_distances.resize(result.offsets[num_queries]);
+    for_each_query(num_queries, [&](std::size_t i) {
+      std::size_t pos = result.offsets[i];
+      for (auto const& neighbor : neighbors[i]) {
+        result.indices[pos] = neighbor.first;
+        result.squared_distances[pos] = neighbor.second;
+        ++pos;
+      }
+      std::vector<std::pair<std::size_t, FT>>().swap(neighbors[i]);
+    });
+    return result;
+  }
+
   int tree_depth() const {
     return m_tree.root()->depth();
   }
 
  private:
+  // Calls f(i) for each query i, in parallel when TBB is available. The tree is already built, so the queries
+  // do not modify it.
+  template <typename Function>
+  static void for_each_query(std::size_t num_queries, Function const& f) {
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(std::size_t(0), num_queries, f);
+#else
+    for (std::size_t i = 0; i < num_queries; ++i) f(i);
+#endif
+  }
+
   Point_range const& m_points;
   Tree m_tree;
 };
@@ -18,6 +18,8 @@
 #include <CGAL/Random.h>
 
 #include <vector>
+#include <algorithm>  // for std::sort
+#include <cmath>  // for std::abs
 
 BOOST_AUTO_TEST_CASE(test_Kd_tree_search) {
   typedef CGAL::Epick_d<CGAL::Dimension_tag<4> > K;
@@ -106,3 +108,51 @@ BOOST_AUTO_TEST_CASE(test_Kd_tree_search) {
   for (auto const& p_idx : rs_result)
     BOOST_CHECK(k.squared_distance_d_object()(points[p_idx], rs_q) <= 0.5);
 }
+
+BOOST_AUTO_TEST_CASE(test_Kd_tree_search_batch) {
+  typedef CGAL::Epick_d<CGAL::Dimension_tag<3> > K;
+  typedef K::Point_d Point;
+  typedef std::vector<Point> Points;
+
+  typedef Gudhi::spatial_searching::Kd_tree_search<
+      K, Points> Points_ds;
+
+  CGAL::Random rd(3);
+
+  Points points, queries;
+  for (int i = 0; i < 1000; ++i)
+    points.push_back(Point(rd.get_double(-1., 1), rd.get_double(-1., 1), rd.get_double(-1., 1)));
+  for (int i = 0; i < 100; ++i)
+    queries.push_back(Point(rd.get_double(-1., 1), rd.get_double(-1., 1), rd.get_double(-1., 1)));
+
+  Points_ds points_ds(points);
+
+  // Same neighbors as the individual queries
+  auto knn = points_ds.k_nearest_neighbors_batch(queries, 10);
+  BOOST_CHECK(knn.offsets.size() == queries.size() + 1);
+  BOOST_CHECK(knn.indices.size() == 10 * queries.size());
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    std::size_t pos = knn.offsets[i];
+    for (auto const& nghb : points_ds.k_nearest_neighbors(queries[i], 10)) {
+      BOOST_CHECK(knn.indices[pos] == nghb.first);
+      BOOST_CHECK(knn.squared_distances[pos] == nghb.second);
+      ++pos;
+    }
+    BOOST_CHECK(pos == knn.offsets[i + 1]);
+  }
+
+  auto rs = points_ds.all_near_neighbors_batch(queries, 0.3);
+  BOOST_CHECK(rs.offsets.size() == queries.size() + 1);
+  K k;
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    std::vector<std::size_t> rs_result;
+    points_ds.all_near_neighbors(queries[i], 0.3, std::back_inserter(rs_result));
+    std::vector<std::size_t> batch_result(rs.indices.begin() + rs.offsets[i], rs.indices.begin() + rs.offsets[i + 1]);
+    std::sort(rs_result.begin(), rs_result.end());
+    std::sort(batch_result.begin(), batch_result.end());
+    BOOST_CHECK(rs_result == batch_result);
+    for (std::size_t pos = rs.offsets[i]; pos < rs.offsets[i + 1]; ++pos)
+      BOOST_CHECK(std::abs(rs.squared_distances[pos] -
+                           k.squared_distance_d_object()(points[rs.indices[pos]], queries[i])) < 1e-12);
+  }
+}
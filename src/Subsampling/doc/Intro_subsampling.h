@@ -43,6 +43,8 @@ namespace subsampling {
  * 
  * There is an alternative version `choose_n_farthest_points_metric()` with the same syntax,
  * which can be faster in many cases.
+ * `parallel_choose_n_farthest_points()`, also with the same syntax, computes the distances in parallel
+ * when TBB is available, which helps for large inputs where the triangle inequality does not prune much.
  *
  * \section randompointexamples Example: pick_n_random_points
  *
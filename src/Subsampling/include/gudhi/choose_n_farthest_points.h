@@ -23,6 +23,11 @@
 
 #include <gudhi/Null_output_iterator.h>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#endif
+
 #include <iterator>
 #include <vector>
 #include <utility>
@@ -149,6 +154,102 @@ void choose_n_farthest_points(Distance dist,
   }
 }
 
+/**
+ *  \ingroup subsampling
+ *  \brief Subsample by an iterative, greedy strategy, in parallel.
+ *  \details
+ *  This computes the same thing as `choose_n_farthest_points()`, with the same arguments. When TBB is available,
+ *  at each iteration, the update of the distances to the landmarks and the search for the farthest point are done
+ *  together, by chunks of points, in parallel. Ties are broken as in `choose_n_farthest_points()`, so the output
+ *  does not depend on the number of threads.
+ *
+ *  `dist` is called concurrently from several threads, it must be thread-safe (for instance, with `CGAL::Epeck_d`,
+ *  this requires CGAL 5.5 or later). The parallelism only pays off when there are many input points.
+ */
+template < typename Distance,
+typename Point_range,
+typename PointOutputIterator,
+typename DistanceOutputIterator = Null_output_iterator>
+void parallel_choose_n_farthest_points(Distance dist,
+                                       Point_range const &input_pts,
+                                       std::size_t final_size,
+                                       std::size_t starting_point,
+                                       PointOutputIterator output_it,
+                                       DistanceOutputIterator dist_it = {}) {
+#ifdef GUDHI_USE_TBB
+  std::size_t nb_points = boost::size(input_pts);
+  if (final_size > nb_points)
+    final_size = nb_points;
+
+  // Tests to the limit
+  if (final_size < 1)
+    return;
+
+  if (starting_point == random_starting_point) {
+    // Choose randomly the first landmark
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<std::size_t> dis(0, nb_points - 1);
+    starting_point = dis(gen);
+  }
+
+  typedef double FT;
+  static_assert(std::numeric_limits<FT>::has_infinity, "the number type needs to support infinity()");
+
+  *output_it++ = input_pts[starting_point];
+  *dist_it++ = std::numeric_limits<FT>::infinity();
+  if (final_size == 1) return;
+
+  // Same layout as in choose_n_farthest_points, the latest landmark is removed by swapping with the last point.
+  std::vector<std::size_t> points(nb_points);
+  std::vector< FT > dist_to_L(nb_points, std::numeric_limits<FT>::infinity());
+  for(std::size_t i = 0; i < nb_points; ++i)
+    points[i] = i;
+
+  // Position in points of the farthest point, and its distance to L
+  typedef std::pair<std::size_t, FT> Farthest;
+  auto farther = [](Farthest const& a, Farthest const& b) {
+    // Prefer the first position on ties, like the sequential scan
+    return (b.second > a.second || (b.second == a.second && b.first < a.first)) ? b : a;
+  };
+  // Updates the distances to L with the new landmark, and returns the farthest point
+  auto update = [&](std::size_t latest_landmark) {
+    return tbb::parallel_reduce(tbb::blocked_range<std::size_t>(0, points.size(), 1024),
+        Farthest(0, -std::numeric_limits<FT>::infinity()),
+        [&](tbb::blocked_range<std::size_t> const& r, Farthest farthest) {
+          for (std::size_t i = r.begin(); i != r.end(); ++i) {
+            FT curr_dist = dist(input_pts[points[i]], input_pts[latest_landmark]);
+            if (curr_dist < dist_to_L[i])
+              dist_to_L[i] = curr_dist;
+            if (dist_to_L[i] > farthest.second || (dist_to_L[i] == farthest.second && i < farthest.first))
+              farthest = Farthest(i, dist_to_L[i]);
+          }
+          return farthest;
+        }, farther);
+  };
+
+  // The distances to the starting point are computed in the first iteration, after removing it
+  std::size_t curr_max_w = starting_point;
+
+  for (std::size_t current_number_of_landmarks = 1; current_number_of_landmarks != final_size; current_number_of_landmarks++) {
+    std::size_t latest_landmark = points[curr_max_w];
+    std::size_t last = points.size() - 1;
+    if (curr_max_w != last) {
+      points[curr_max_w] = points[last];
+      dist_to_L[curr_max_w] = dist_to_L[last];
+    }
+    points.pop_back();
+    dist_to_L.pop_back();
+
+    Farthest farthest = update(latest_landmark);
+    curr_max_w = farthest.first;
+    *output_it++ = input_pts[points[curr_max_w]];
+    *dist_it++ = farthest.second;
+  }
+#else
+  choose_n_farthest_points(dist, input_pts, final_size, starting_point, output_it, dist_it);
+#endif
+}
 
 // How bad is it to use the triangle inequality with inexact double computations?
 // Hopefully we still get a net-tree.
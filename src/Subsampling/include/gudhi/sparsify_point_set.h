@@ -18,7 +18,19 @@
 #include <gudhi/Clock.h>
 #endif
 
+#include <CGAL/number_utils.h>  // for CGAL::to_double
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
 #include <vector>
 
 namespace Gudhi {
@@ -83,6 +95,119 @@ sparsify_point_set(
 #endif
 }
 
+/**
+ *  \ingroup subsampling
+ *  \brief Outputs a subset of the input points so that the squared distance between any two points is greater than
+ *         `min_squared_dist`, in parallel.
+ *
+ *  \details As with `sparsify_point_set()`, every input point is at squared distance at most `min_squared_dist` from
+ *  an output point, and the output points are in the same order as in the input, but the subset may be different.
+ *  The space is divided into a grid of cells of side slightly larger than `sqrt(min_squared_dist)`, and the cells
+ *  are colored according to the parity of their coordinates. Two distinct cells of the same color are separated by
+ *  a whole cell, so their points cannot drop each other: the \f$2^d\f$ colors are processed one after the other,
+ *  the cells of a color in parallel (when TBB is available), and the points of a cell in the input order.
+ *  The grid makes this variant mostly useful in low dimension.
+ *
+ *  The parameters are the same as for `sparsify_point_set()`, and the kernel must also provide
+ *  `Compute_coordinate_d` and `Point_dimension_d`.
+ */
+template <typename Kernel, typename Point_range, typename OutputIterator>
+void
+parallel_sparsify_point_set(
+                   const Kernel &k, Point_range const& input_pts,
+                   typename Kernel::FT min_squared_dist,
+                   OutputIterator output_it) {
+  typedef typename Gudhi::spatial_searching::Kd_tree_search<
+      Kernel, Point_range> Points_ds;
+
+#ifdef GUDHI_SUBSAMPLING_PROFILING
+  Gudhi::Clock t;
+#endif
+
+  const std::size_t n = input_pts.size();
+  if (n == 0) return;
+  auto coord = k.compute_coordinate_d_object();
+  const int dim = k.point_dimension_d_object()(input_pts[0]);
+  // Cells a bit larger than the distance, so that points in cells separated by a whole cell are too far apart
+  const double cell_size = std::sqrt(CGAL::to_double(min_squared_dist)) * (1 + 1e-6);
+
+  // Coordinates of the cell of each point. A zero distance is handled by a single cell, processed sequentially.
+  std::vector<std::int64_t> cells(n * dim, 0);
+  if (cell_size > 0) {
+    for (std::size_t i = 0; i < n; ++i)
+      for (int j = 0; j < dim; ++j)
+        cells[i * dim + j] = static_cast<std::int64_t>(std::floor(CGAL::to_double(coord(input_pts[i], j)) / cell_size));
+  }
+  auto color = [&](std::size_t i) {
+    std::size_t c = 0;
+    for (int j = 0; j < dim; ++j) c = 2 * c + (cells[i * dim + j] & 1);
+    return c;
+  };
+  auto same_cell = [&](std::size_t a, std::size_t b) {
+    return std::equal(cells.begin() + a * dim, cells.begin() + (a + 1) * dim, cells.begin() + b * dim);
+  };
+  // Sort the points by color, then cell, then input order
+  std::vector<std::size_t> order(n);
+  std::iota(order.begin(), order.end(), std::size_t(0));
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+    std::size_t ca = color(a), cb = color(b);
+    if (ca != cb) return ca < cb;
+    auto a_begin = cells.begin() + a * dim, b_begin = cells.begin() + b * dim;
+    if (std::lexicographical_compare(a_begin, a_begin + dim, b_begin, b_begin + dim)) return true;
+    if (std::lexicographical_compare(b_begin, b_begin + dim, a_begin, a_begin + dim)) return false;
+    return a < b;
+  });
+  // Start of each cell in order, grouped by color
+  std::vector<std::size_t> cell_begin;
+  std::vector<std::size_t> color_begin;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i == 0 || !same_cell(order[i - 1], order[i])) {
+      if (i == 0 || color(order[i - 1]) != color(order[i])) color_begin.push_back(cell_begin.size());
+      cell_begin.push_back(i);
+    }
+  }
+  cell_begin.push_back(n);
+  color_begin.push_back(cell_begin.size() - 1);
+
+  Points_ds points_ds(input_pts);
+  // Only the points of a cell read their own flag, but neighboring cells of the same color may drop the same point.
+  std::unique_ptr<std::atomic<bool>[]> dropped_points(new std::atomic<bool>[n]);
+  for (std::size_t i = 0; i < n; ++i) dropped_points[i].store(false, std::memory_order_relaxed);
+  std::vector<char> kept_points(n, false);
+
+  auto process_cell = [&](std::size_t c) {
+    auto drop = [&dropped_points] (std::ptrdiff_t neighbor_point_idx) {
+      dropped_points[neighbor_point_idx].store(true, std::memory_order_relaxed);
+    };
+    for (std::size_t i = cell_begin[c]; i < cell_begin[c + 1]; ++i) {
+      std::size_t pt_idx = order[i];
+      if (dropped_points[pt_idx].load(std::memory_order_relaxed))
+        continue;
+      kept_points[pt_idx] = true;
+      // If another point Q is closer that min_squared_dist, mark Q to be dropped
+      points_ds.all_near_neighbors2(input_pts[pt_idx], min_squared_dist, min_squared_dist,
+                                    boost::make_function_output_iterator(std::ref(drop)));
+    }
+  };
+  for (std::size_t col = 0; col + 1 < color_begin.size(); ++col) {
+#ifdef GUDHI_USE_TBB
+    tbb::parallel_for(color_begin[col], color_begin[col + 1], process_cell);
+#else
+    for (std::size_t c = color_begin[col]; c < color_begin[col + 1]; ++c) process_cell(c);
+#endif
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+    if (kept_points[i])
+      *output_it++ = input_pts[i];
+
+#ifdef GUDHI_SUBSAMPLING_PROFILING
+  t.end();
+  std::cerr << "Point set sparsified in parallel in " << t.num_seconds() << " seconds ("
+      << n / t.num_seconds() << " points per second)." << std::endl;
+#endif
+}
+
 }  // namespace subsampling
 }  // namespace Gudhi
 
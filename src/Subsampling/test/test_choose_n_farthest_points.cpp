@@ -133,3 +133,24 @@ BOOST_AUTO_TEST_CASE(test_compare_choose_farthest_point)
   BOOST_CHECK(dist1 == dist2);
   // We may need to replace this last == with an approximate check (or not test dist).
 }
+
+BOOST_AUTO_TEST_CASE(test_parallel_choose_farthest_point)
+{
+  std::default_random_engine e;
+  std::uniform_int_distribution<int> r(0, 20);
+  typedef std::array<double, 3> Point;
+  typedef std::vector<Point> Cloud;
+  Cloud orig;
+  // Points on a grid, with many ties
+  for(int i=0; i<20000; ++i) {
+    orig.push_back({ double(r(e)), double(r(e)), double(r(e)) });
+  }
+  Cloud out1, out2;
+  std::vector<double> dist1, dist2;
+  Gudhi::Euclidean_distance d;
+  Gudhi::subsampling::choose_n_farthest_points(d, orig, 500, 3, std::back_inserter(out1), std::back_inserter(dist1));
+  Gudhi::subsampling::parallel_choose_n_farthest_points(d, orig, 500, 3, std::back_inserter(out2), std::back_inserter(dist2));
+  // Ties are broken the same way
+  BOOST_CHECK(out1 == out2);
+  BOOST_CHECK(dist1 == dist2);
+}
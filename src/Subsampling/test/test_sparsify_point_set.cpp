@@ -41,3 +41,35 @@ BOOST_AUTO_TEST_CASE(test_sparsify_point_set)
 
   BOOST_CHECK(points.size() > results.size());
 }
+
+BOOST_AUTO_TEST_CASE(test_parallel_sparsify_point_set)
+{
+  typedef CGAL::Epick_d<CGAL::Dimension_tag<3> >   K;
+  typedef typename K::Point_d                      Point_d;
+
+  CGAL::Random rd(42);
+
+  std::vector<Point_d> points;
+  for (int i = 0 ; i < 5000 ; ++i)
+    points.push_back(Point_d(rd.get_double(-1.,1),rd.get_double(-1.,1),rd.get_double(-1.,1)));
+
+  K k;
+  const double min_squared_dist = 0.01;
+  std::vector<Point_d> results;
+  Gudhi::subsampling::parallel_sparsify_point_set(k, points, min_squared_dist, std::back_inserter(results));
+  std::clog << "After parallel sparsification: " << results.size() << " points.\n";
+  BOOST_CHECK(points.size() > results.size());
+
+  auto sqdist = k.squared_distance_d_object();
+  // The output points are far from each other
+  for (std::size_t i = 0; i < results.size(); ++i)
+    for (std::size_t j = i + 1; j < results.size(); ++j)
+      BOOST_CHECK(sqdist(results[i], results[j]) > min_squared_dist);
+  // and close to every input point
+  for (auto const& p : points) {
+    bool covered = false;
+    for (auto const& q : results)
+      if (sqdist(p, q) <= min_squared_dist) { covered = true; break; }
+    BOOST_CHECK(covered);
+  }
+}
@@ -61,7 +61,6 @@
 #ifdef GUDHI_USE_TBB
 #include <tbb/parallel_for.h>
 #include <tbb/combinable.h>
-#include <mutex>
 #endif
 
 // #define GUDHI_TC_EXPORT_NORMALS // Only for 3D surfaces (k=2, d=3)
@@ -148,7 +147,6 @@ class Tangential_complex {
   typedef typename Tr_traits::Vector_d Tr_vector;
 
 #if defined(GUDHI_USE_TBB)
-  typedef std::mutex Mutex_for_perturb;
   typedef Vector Translation_for_perturb;
   typedef std::vector<Atomic_wrapper<FT> > Weights;
 #else
@@ -247,12 +245,7 @@ class Tangential_complex {
         m_intrinsic_dim(intrinsic_dimension),
         m_ambient_dim(points.empty() ? 0 : k.point_dimension_d_object()(*points.begin())),
         m_points(points.begin(), points.end()),
-        m_weights(m_points.size(), FT(0))
-#if defined(GUDHI_USE_TBB) && defined(GUDHI_TC_PERTURB_POSITION)
-        ,
-        m_p_perturb_mutexes(NULL)
-#endif
-        ,
+        m_weights(m_points.size(), FT(0)),
         m_points_ds(m_points),
         m_last_max_perturb(0.),
         m_are_tangent_spaces_computed(m_points.size(), false),
@@ -270,11 +263,7 @@ class Tangential_complex {
   }
 
   /// Destructor
-  ~Tangential_complex() {
-#if defined(GUDHI_USE_TBB) && defined(GUDHI_TC_PERTURB_POSITION)
-    delete[] m_p_perturb_mutexes;
-#endif
-  }
+  ~Tangential_complex() {}
 
   /// Returns the intrinsic dimension of the manifold.
   int intrinsic_dimension() const { return m_intrinsic_dim; }
@@ -351,10 +340,6 @@ class Tangential_complex {
     } else {
       m_translations.resize(m_points.size(), m_k.construct_vector_d_object()(m_ambient_dim));
     }
-#if defined(GUDHI_USE_TBB)
-    delete[] m_p_perturb_mutexes;
-    m_p_perturb_mutexes = new Mutex_for_perturb[m_points.size()];
-#endif
 #endif
 
 #ifdef GUDHI_USE_TBB
@@ -455,14 +440,10 @@ class Tangential_complex {
                           });
 
         num_inconsistent_stars = num_inconsistencies.combine(std::plus<std::size_t>());
-        updated_points =
-            tls_updated_points.combine([](std::vector<std::size_t> const &x, std::vector<std::size_t> const &y) {
-              std::vector<std::size_t> res;
-              res.reserve(x.size() + y.size());
-              res.insert(res.end(), x.begin(), x.end());
-              res.insert(res.end(), y.begin(), y.end());
-              return res;
-            });
+        // Concatenate the thread-local lists, without the copies of pairwise combinations
+        tls_updated_points.combine_each([&updated_points](std::vector<std::size_t> const &pts) {
+          updated_points.insert(updated_points.end(), pts.begin(), pts.end());
+        });
       } else {
 #endif  // GUDHI_USE_TBB
         // Sequential
@@ -1015,8 +996,7 @@ class Tangential_complex {
 
       // ith point = p, which is already inserted
       if (neighbor_point_idx != i) {
-        // No need to lock the Mutex_for_perturb here since this will not be
-        // called while other threads are perturbing the positions
+        // This is not called while other threads are perturbing the positions
         Point neighbor_pt;
         FT neighbor_weight;
         compute_perturbed_weighted_point(neighbor_point_idx, neighbor_pt, neighbor_weight);
@@ -1135,8 +1115,7 @@ class Tangential_complex {
     if (verbose) std::cerr << "** Computing tangent tri #" << i << " **\n";
     // std::cerr << "***********************************************\n";
 
-    // No need to lock the mutex here since this will not be called while
-    // other threads are perturbing the positions
+    // This is not called while other threads are perturbing the positions
     const Point center_pt = compute_perturbed_point(i);
     Tangent_space_basis &tsb = m_tangent_spaces[i];
 
@@ -1204,6 +1183,14 @@ class Tangential_complex {
     }
   }
 
+  // Buffers of the PCA in compute_tangent_space
+  struct Pca_workspace {
+    Eigen::MatrixXd points;
+    Eigen::RowVectorXd mean;
+    Eigen::MatrixXd cov;
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig;
+  };
+
   // Estimates tangent subspaces using PCA
 
   Tangent_space_basis compute_tangent_space(const Point &p, const std::size_t i, bool normalize_basis = true,
@@ -1224,17 +1211,24 @@ class Tangential_complex {
     const Points &points_for_pca = m_points;
 #endif
 
+    // The matrices are reused from one point to the next by each thread, they only allocate for the first point.
+    thread_local Pca_workspace ws;
     // One row = one point
-    Eigen::MatrixXd mat_points(num_pts_for_pca, m_ambient_dim);
-    auto nn_it = kns_range.begin();
-    for (unsigned int j = 0; j < num_pts_for_pca && nn_it != kns_range.end(); ++j, ++nn_it) {
+    ws.points.resize(num_pts_for_pca, m_ambient_dim);
+    unsigned int num_rows = 0;
+    for (auto nn_it = kns_range.begin(); num_rows < num_pts_for_pca && nn_it != kns_range.end(); ++num_rows, ++nn_it) {
       for (int i = 0; i < m_ambient_dim; ++i) {
-        mat_points(j, i) = CGAL::to_double(coord(points_for_pca[nn_it->first], i));
+        ws.points(num_rows, i) = CGAL::to_double(coord(points_for_pca[nn_it->first], i));
       }
     }
-    Eigen::MatrixXd centered = mat_points.rowwise() - mat_points.colwise().mean();
-    Eigen::MatrixXd cov = centered.adjoint() * centered;
-    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(cov);
+    auto mat_points = ws.points.topRows(num_rows);
+    ws.mean = mat_points.colwise().mean();
+    mat_points.rowwise() -= ws.mean;
+    // Only the lower triangle of the covariance is computed, which is all the eigen solver reads
+    ws.cov.setZero(m_ambient_dim, m_ambient_dim);
+    ws.cov.template selfadjointView<Eigen::Lower>().rankUpdate(mat_points.adjoint());
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>& eig = ws.eig;
+    eig.compute(ws.cov);
 
     Tangent_space_basis tsb(i);  // p = compute_perturbed_point(i) here
 
@@ -1589,15 +1583,9 @@ class Tangential_complex {
     for (int i = 0; i < m_intrinsic_dim; ++i) {
       global_transl = k_transl(global_transl, k_scaled_vec(tsb[i], coord(local_random_transl, i)));
     }
-    // Parallel
-#if defined(GUDHI_USE_TBB)
-    m_p_perturb_mutexes[point_idx].lock();
+    // Even in parallel, the translation of a point is only modified by the task that handles its star, and only
+    // read after the fix step, so no lock is needed.
     m_translations[point_idx] = global_transl;
-    m_p_perturb_mutexes[point_idx].unlock();
-    // Sequential
-#else
-    m_translations[point_idx] = global_transl;
-#endif
   }
 
   // Return true if inconsistencies were found
@@ -1991,9 +1979,6 @@ class Tangential_complex {
   Weights m_weights;
 #ifdef GUDHI_TC_PERTURB_POSITION
   Translations_for_perturb m_translations;
-#if defined(GUDHI_USE_TBB)
-  Mutex_for_perturb *m_p_perturb_mutexes;
-#endif
 #endif
 
   Points_ds m_points_ds;
@@ -14,6 +14,13 @@
 #include <gudhi/Toplex_map.h>
 #include <boost/heap/fibonacci_heap.hpp>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <vector>
+#include <utility>  // for std::pair
+
 namespace Gudhi {
 
 /**
@@ -42,6 +49,12 @@ class Lazy_toplex_map {
   template <typename Input_vertex_range>
   void insert_independent_simplex(const Input_vertex_range &vertex_range);
 
+  /** Adds the given simplices to the complex, as `insert_independent_simplex`.
+   * The cleaning of the vertices is deferred to the end of the batch, which is faster for a large number of
+   * simplices. */
+  template <typename Simplex_range>
+  void insert_independent_simplices(const Simplex_range &simplex_range);
+
   /** \brief Adds the given simplex to the complex.
    * Nothing happens if the simplex is already in the complex (i.e. it is a face of one of the toplices). */
   template <typename Input_vertex_range>
@@ -65,6 +78,15 @@ class Lazy_toplex_map {
    * Returns the remaining vertex. */
   Vertex contraction(const Vertex x, const Vertex y);
 
+  /** Contracts the edges of a range of pairs of vertices, one after the other, and returns the remaining vertex of
+   * each contraction, as `contraction`.
+   * The new toplices of all the contractions are computed from the current complex, in parallel if TBB is available.
+   * An edge whose toplices have been modified by a previous contraction of the batch (for instance if it is adjacent
+   * to a previously contracted edge) is contracted again from the updated complex, so the edges should be
+   * independent to benefit from the parallelism. */
+  template <typename Edge_range>
+  std::vector<Vertex> contractions(const Edge_range &edge_range);
+
   /** \brief Number of maximal simplices. */
   std::size_t num_maximal_simplices() const { return size; }
 
@@ -74,6 +96,11 @@ class Lazy_toplex_map {
  private:
   template <typename Input_vertex_range>
   void erase_max(const Input_vertex_range &vertex_range);
+  // insert_simplex without the cleaning
+  template <typename Input_vertex_range>
+  bool insert_toplex(const Input_vertex_range &vertex_range);
+  template <typename Input_vertex_range>
+  void add_gamma0_lbounds(const Input_vertex_range &vertex_range);
   template <typename Input_vertex_range>
   Vertex best_index(const Input_vertex_range &vertex_range);
   void clean(const Vertex v);
@@ -98,17 +125,45 @@ class Lazy_toplex_map {
 
 template <typename Input_vertex_range>
 void Lazy_toplex_map::insert_independent_simplex(const Input_vertex_range &vertex_range) {
+  add_gamma0_lbounds(vertex_range);
+  insert_simplex(vertex_range);
+}
+
+template <typename Simplex_range>
+void Lazy_toplex_map::insert_independent_simplices(const Simplex_range &simplex_range) {
+  std::size_t inserted = 0;
+  for (const auto &vertex_range : simplex_range) {
+    add_gamma0_lbounds(vertex_range);
+    insert_toplex(vertex_range);
+    ++inserted;
+  }
+  // At most as many cleanings as insert_independent_simplex would have done
+  for (; inserted > 0 && size > (size_lbound + 1) * BETTA && !cleaning_priority.empty(); --inserted) {
+    const Vertex v = cleaning_priority.top().second;
+    if (!t0.count(v)) break;
+    clean(v);
+  }
+}
+
+template <typename Input_vertex_range>
+void Lazy_toplex_map::add_gamma0_lbounds(const Input_vertex_range &vertex_range) {
   for (const Vertex &v : vertex_range)
     if (!gamma0_lbounds.count(v))
       gamma0_lbounds.emplace(v, 1);
     else
       gamma0_lbounds[v]++;
   size_lbound++;
-  insert_simplex(vertex_range);
 }
 
 template <typename Input_vertex_range>
 bool Lazy_toplex_map::insert_simplex(const Input_vertex_range &vertex_range) {
+  bool inserted = insert_toplex(vertex_range);
+  if (size > (size_lbound + 1) * BETTA) clean(cleaning_priority.top().second);
+  return inserted;
+}
+
+template <typename Input_vertex_range>
+bool Lazy_toplex_map::insert_toplex(const Input_vertex_range &vertex_range) {
   Simplex sigma(vertex_range.begin(), vertex_range.end());
   // Check empty face management
   empty_toplex = (sigma.size() == 0);
@@ -124,7 +179,6 @@ bool Lazy_toplex_map::insert_simplex(const Input_vertex_range &vertex_range) {
     cleaning_priority.update(cp_handles.at(v), std::make_pair(t0.at(v).size() - get_gamma0_lbound(v), v));
   }
   if (inserted) size++;
-  if (size > (size_lbound + 1) * BETTA) clean(cleaning_priority.top().second);
   return inserted;
 }
 
@@ -199,6 +253,64 @@ Lazy_toplex_map::Vertex Lazy_toplex_map::contraction(const Vertex x, const Verte
   return k;
 }
 
+template <typename Edge_range>
+std::vector<Lazy_toplex_map::Vertex> Lazy_toplex_map::contractions(const Edge_range &edge_range) {
+  struct Contraction {
+    Vertex x, y, k, d;
+    std::size_t k_size;
+    std::vector<Simplex_ptr> old_toplices;
+    std::vector<Simplex> new_toplices;
+  };
+  std::vector<Contraction> batch;
+  for (const auto &edge : edge_range) batch.push_back({edge.first, edge.second, 0, 0, 0, {}, {}});
+  // Only reads t0, so the contractions can be prepared concurrently
+  auto prepare = [this](Contraction &c) {
+    auto it_x = t0.find(c.x), it_y = t0.find(c.y);
+    if (it_x == t0.end() || it_y == t0.end()) return;
+    if (it_x->second.size() > it_y->second.size())
+      c.k = c.x, c.d = c.y;
+    else
+      c.k = c.y, c.d = c.x;
+    c.k_size = (c.k == c.x ? it_x : it_y)->second.size();
+    const Simplex_ptr_set &star = (c.d == c.x ? it_x : it_y)->second;
+    c.old_toplices.assign(star.begin(), star.end());
+    c.new_toplices.reserve(star.size());
+    for (const Simplex_ptr &sptr : c.old_toplices) {
+      Simplex sigma(*sptr);
+      sigma.erase(c.d);
+      sigma.insert(c.k);
+      c.new_toplices.push_back(std::move(sigma));
+    }
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), batch.size(), [&](std::size_t i) { prepare(batch[i]); });
+#else
+  for (Contraction &c : batch) prepare(c);
+#endif
+  std::vector<Vertex> remaining;
+  remaining.reserve(batch.size());
+  for (const Contraction &c : batch) {
+    // The prepared contraction is still valid if the toplices of d, and the choice of k, were not modified since
+    bool valid = !c.old_toplices.empty() && t0.count(c.k) && t0.count(c.d) && t0.at(c.k).size() == c.k_size &&
+                 t0.at(c.d).size() == c.old_toplices.size();
+    if (valid)
+      for (const Simplex_ptr &sptr : c.old_toplices)
+        if (!t0.at(c.d).count(sptr)) {
+          valid = false;
+          break;
+        }
+    if (!valid) {
+      remaining.push_back(contraction(c.x, c.y));
+      continue;
+    }
+    for (const Simplex_ptr &sptr : c.old_toplices) erase_max(*sptr);
+    for (const Simplex &sigma : c.new_toplices) insert_simplex(sigma);
+    t0.erase(c.d);
+    remaining.push_back(c.k);
+  }
+  return remaining;
+}
+
 /* No facets insert_simplexed */
 template <typename Input_vertex_range>
 inline void Lazy_toplex_map::erase_max(const Input_vertex_range &vertex_range) {
@@ -17,6 +17,8 @@
 #include <unordered_map>
 #include <memory>
 #include <limits>
+#include <cstdint>
+#include <type_traits>
 
 namespace Gudhi {
 
@@ -105,8 +107,21 @@ class Toplex_map {
   template <typename Input_vertex_range>
   Vertex best_index(const Input_vertex_range& vertex_range) const;
 
+  /** \internal Bitset of the vertices modulo 64. If a simplex is a face of another one, its signature is a subset of
+   * the signature of the other one, which discards most of the candidates before calling `included`. */
+  using Signature = std::uint64_t;
+
+  template <typename Input_vertex_range>
+  static Signature signature(const Input_vertex_range& vertex_range);
+
+  /** \internal The toplices containing a vertex, with their signatures. */
+  using Toplex_set = std::unordered_map<Toplex_map::Simplex_ptr, Signature, Sptr_hash, Sptr_equal>;
+
+  /** \internal Copy of the toplices containing a vertex, for the loops which modify the map. */
+  std::vector<Toplex_map::Simplex_ptr> toplices_of(const Vertex v) const;
+
   /** \internal The map from vertices to toplices */
-  std::unordered_map<Vertex, Toplex_map::Simplex_ptr_set> t0;
+  std::unordered_map<Vertex, Toplex_set> t0;
 
   const Vertex VERTEX_UPPER_BOUND = std::numeric_limits<Vertex>::max();
 
@@ -137,12 +152,18 @@ void Toplex_map::insert_simplex(const Input_vertex_range& vertex_range) {
     }
   if (replace_facets)
     for (const Toplex_map::Simplex& facet : facets(vertex_range)) erase_maximal(get_key(facet));
-  else
-    for (const Vertex& v : vertex_range)
-      if (t0.count(v))
-        for (const Toplex_map::Simplex_ptr& fptr : Simplex_ptr_set(t0.at(v)))
-          // Copy constructor needed because the set is modified
-          if (included(*fptr, vertex_range)) erase_maximal(fptr);
+  else {
+    const Signature sig = signature(vertex_range);
+    for (const Vertex& v : vertex_range) {
+      if (!t0.count(v)) continue;
+      std::vector<Toplex_map::Simplex_ptr> candidates;
+      for (const auto& kv : t0.at(v))
+        if ((kv.second & ~sig) == 0) candidates.push_back(kv.first);
+      // Copy needed because the set is modified
+      for (const Toplex_map::Simplex_ptr& fptr : candidates)
+        if (included(*fptr, vertex_range)) erase_maximal(fptr);
+    }
+  }
   // We erase all the maximal faces of the simplex
   insert_independent_simplex(vertex_range);
 }
@@ -153,15 +174,19 @@ void Toplex_map::remove_simplex(const Input_vertex_range& vertex_range) {
   // Removal of the empty simplex means cleaning everything
   else {
     const Vertex& v = best_index(vertex_range);
+    const Signature sig = signature(vertex_range);
+    std::vector<Toplex_map::Simplex_ptr> candidates;
     if (t0.count(v))
-      for (const Toplex_map::Simplex_ptr& sptr : Simplex_ptr_set(t0.at(v)))
-        // Copy constructor needed because the set is modified
-        if (included(vertex_range, *sptr)) {
-          erase_maximal(sptr);
-          for (const Toplex_map::Simplex& f : facets(vertex_range))
-            if (!membership(f)) insert_independent_simplex(f);
-          // We add the facets which are new maximal simplices
-        }
+      for (const auto& kv : t0.at(v))
+        if ((sig & ~kv.second) == 0) candidates.push_back(kv.first);
+    // Copy needed because the set is modified
+    for (const Toplex_map::Simplex_ptr& sptr : candidates)
+      if (included(vertex_range, *sptr)) {
+        erase_maximal(sptr);
+        for (const Toplex_map::Simplex& f : facets(vertex_range))
+          if (!membership(f)) insert_independent_simplex(f);
+        // We add the facets which are new maximal simplices
+      }
   }
 }
 
@@ -171,8 +196,9 @@ bool Toplex_map::membership(const Input_vertex_range& vertex_range) const {
   const Vertex& v = best_index(vertex_range);
   if (!t0.count(v)) return false;
   if (maximality(vertex_range)) return true;
-  for (const Toplex_map::Simplex_ptr& sptr : t0.at(v))
-    if (included(vertex_range, *sptr)) return true;
+  const Signature sig = signature(vertex_range);
+  for (const auto& kv : t0.at(v))
+    if ((sig & ~kv.second) == 0 && included(vertex_range, *kv.first)) return true;
   return false;
 }
 
@@ -191,17 +217,18 @@ Toplex_map::Simplex_ptr_set Toplex_map::maximal_cofaces(const Input_vertex_range
     cofaces.emplace(get_key(vertex_range));
   else if (vertex_range.begin() == vertex_range.end())
     for (const auto& kv : t0)
-      for (const Toplex_map::Simplex_ptr& sptr : kv.second) {
-        // kv.second is a Simplex_ptr_set
-        cofaces.emplace(sptr);
+      for (const auto& toplex : kv.second) {
+        // kv.second is a Toplex_set
+        cofaces.emplace(toplex.first);
         if (cofaces.size() == max_number) return cofaces;
       }
   else {
     const Vertex& v = best_index(vertex_range);
+    const Signature sig = signature(vertex_range);
     if (t0.count(v))
-      for (const Toplex_map::Simplex_ptr& sptr : t0.at(v))
-        if (included(vertex_range, *sptr)) {
-          cofaces.emplace(sptr);
+      for (const auto& kv : t0.at(v))
+        if ((sig & ~kv.second) == 0 && included(vertex_range, *kv.first)) {
+          cofaces.emplace(kv.first);
           if (cofaces.size() == max_number) return cofaces;
         }
   }
@@ -216,8 +243,8 @@ Toplex_map::Vertex Toplex_map::contraction(const Toplex_map::Vertex x, const Top
     k = x, d = y;
   else
     k = y, d = x;
-  for (const Toplex_map::Simplex_ptr& sptr : Simplex_ptr_set(t0.at(d))) {
-    // Copy constructor needed because the set is modified
+  for (const Toplex_map::Simplex_ptr& sptr : toplices_of(d)) {
+    // Copy needed because the set is modified
     Simplex sigma(*sptr);
     erase_maximal(sptr);
     sigma.erase(d);
@@ -229,8 +256,8 @@ Toplex_map::Vertex Toplex_map::contraction(const Toplex_map::Vertex x, const Top
 
 std::set<Toplex_map::Vertex> Toplex_map::unitary_collapse(const Toplex_map::Vertex k, const Toplex_map::Vertex d) {
   Toplex_map::Simplex r;
-  for (const Toplex_map::Simplex_ptr& sptr : Simplex_ptr_set(t0.at(d))) {
-    // Copy constructor needed because the set is modified
+  for (const Toplex_map::Simplex_ptr& sptr : toplices_of(d)) {
+    // Copy needed because the set is modified
     Simplex sigma(*sptr);
     erase_maximal(sptr);
     sigma.erase(d);
@@ -244,14 +271,12 @@ std::set<Toplex_map::Vertex> Toplex_map::unitary_collapse(const Toplex_map::Vert
 template <typename Input_vertex_range>
 void Toplex_map::insert_independent_simplex(const Input_vertex_range& vertex_range) {
   auto key = get_key(vertex_range);
-  for (const Vertex& v : vertex_range) {
-    if (!t0.count(v)) t0.emplace(v, Simplex_ptr_set());
-    t0.at(v).emplace(key);
-  }
+  const Signature sig = signature(*key);
+  for (const Vertex& v : vertex_range) t0[v].emplace(key, sig);
 }
 
 void Toplex_map::remove_vertex(const Toplex_map::Vertex x) {
-  for (const Toplex_map::Simplex_ptr& sptr : Simplex_ptr_set(t0.at(x))) {
+  for (const Toplex_map::Simplex_ptr& sptr : toplices_of(x)) {
     Simplex sigma(*sptr);
     erase_maximal(sptr);
     sigma.erase(x);
@@ -268,6 +293,20 @@ inline void Toplex_map::erase_maximal(const Toplex_map::Simplex_ptr& sptr) {
   }
 }
 
+template <typename Input_vertex_range>
+Toplex_map::Signature Toplex_map::signature(const Input_vertex_range& vertex_range) {
+  Signature sig = 0;
+  for (const Vertex& v : vertex_range) sig |= Signature(1) << (v % 64);
+  return sig;
+}
+
+inline std::vector<Toplex_map::Simplex_ptr> Toplex_map::toplices_of(const Vertex v) const {
+  std::vector<Simplex_ptr> toplices;
+  toplices.reserve(t0.at(v).size());
+  for (const auto& kv : t0.at(v)) toplices.push_back(kv.first);
+  return toplices;
+}
+
 template <typename Input_vertex_range>
 Toplex_map::Vertex Toplex_map::best_index(const Input_vertex_range& vertex_range) const {
   std::size_t min = std::numeric_limits<size_t>::max();
@@ -303,10 +342,16 @@ Toplex_map::Simplex_ptr get_key(const Input_vertex_range& vertex_range) {
 
 template <typename Input_vertex_range1, typename Input_vertex_range2>
 bool included(const Input_vertex_range1& vertex_range1, const Input_vertex_range2& vertex_range2) {
-  Toplex_map::Simplex s2(vertex_range2.begin(), vertex_range2.end());
-  for (const Toplex_map::Vertex& v : vertex_range1)
-    if (!s2.count(v)) return false;
-  return true;
+  auto included_in = [&](const Toplex_map::Simplex& s2) {
+    for (const Toplex_map::Vertex& v : vertex_range1)
+      if (!s2.count(v)) return false;
+    return true;
+  };
+  // The toplices are already sets, there is no need to copy them
+  if constexpr (std::is_same_v<Input_vertex_range2, Toplex_map::Simplex>)
+    return included_in(vertex_range2);
+  else
+    return included_in(Toplex_map::Simplex(vertex_range2.begin(), vertex_range2.end()));
 }
 
 template <typename Input_vertex_range>
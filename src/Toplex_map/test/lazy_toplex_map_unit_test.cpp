@@ -156,3 +156,36 @@ BOOST_AUTO_TEST_CASE(toplex_map_empty_toplex) {
   std::clog << "Check the edge 2,7 is not a member." << std::endl;
   BOOST_CHECK(!tm.membership(edge));
 }
+
+BOOST_AUTO_TEST_CASE(lazy_toplex_map_batches) {
+  using Vertex = Gudhi::Lazy_toplex_map::Vertex;
+  using Simplex = Gudhi::Lazy_toplex_map::Simplex;
+
+  // A strip of triangles, inserted in a batch in one map and one at a time in the other
+  const Vertex n = 100;
+  std::vector<Simplex> triangles;
+  for (Vertex i = 0; i < n; ++i) triangles.push_back({i, i + 1, i + 2});
+  Gudhi::Lazy_toplex_map batch, one_by_one;
+  batch.insert_independent_simplices(triangles);
+  for (const Simplex& t : triangles) one_by_one.insert_independent_simplex(t);
+  BOOST_CHECK(batch.num_maximal_simplices() == n);
+  BOOST_CHECK(batch.num_vertices() == n + 2);
+  for (const Simplex& t : triangles) BOOST_CHECK(batch.membership(t));
+  BOOST_CHECK(!batch.membership(std::vector<Vertex>{0, 3}));
+
+  // Independent edges, then 2 adjacent ones which cannot be prepared together
+  std::vector<std::pair<Vertex, Vertex>> edges = {{0, 1}, {10, 11}, {20, 21}, {50, 51}, {70, 71}, {71, 72}};
+  std::vector<Vertex> remaining = batch.contractions(edges);
+  BOOST_CHECK(remaining.size() == edges.size());
+  for (std::size_t i = 0; i < edges.size(); ++i)
+    BOOST_CHECK(remaining[i] == one_by_one.contraction(edges[i].first, edges[i].second));
+  BOOST_CHECK(batch.num_vertices() == one_by_one.num_vertices());
+  BOOST_CHECK(batch.num_vertices() == n + 2 - edges.size());
+  for (Vertex i = 0; i < n; ++i) {
+    Simplex t = {i, i + 1, i + 2};
+    BOOST_CHECK(batch.membership(t) == one_by_one.membership(t));
+    Simplex e = {i, i + 1};
+    BOOST_CHECK(batch.membership(e) == one_by_one.membership(e));
+  }
+  BOOST_CHECK(batch.membership(std::vector<Vertex>{remaining[1], 12}));
+}
@@ -124,3 +124,33 @@ BOOST_AUTO_TEST_CASE(toplex_map) {
   edge = {7, 5};
   BOOST_CHECK(tm.membership(edge));
 }
+
+BOOST_AUTO_TEST_CASE(toplex_map_star_of_high_degree_vertex) {
+  using Vertex = Gudhi::Toplex_map::Vertex;
+
+  // Many triangles around the vertex 0, with vertices that are equal modulo 64 so that their signatures collide
+  Gudhi::Toplex_map tm;
+  const Vertex n = 200;
+  for (Vertex i = 1; i < n; ++i) tm.insert_simplex(std::vector<Vertex>{0, i, i + 1});
+  BOOST_CHECK(tm.num_maximal_simplices() == n - 1);
+  for (Vertex i = 1; i < n; ++i) {
+    BOOST_CHECK(tm.maximality(std::vector<Vertex>{0, i, i + 1}));
+    BOOST_CHECK(tm.membership(std::vector<Vertex>{i, i + 1}));
+    BOOST_CHECK(!tm.membership(std::vector<Vertex>{0, i, i + 65}));
+    BOOST_CHECK(!tm.membership(std::vector<Vertex>{i, i + 64}));
+  }
+  BOOST_CHECK(tm.maximal_cofaces(std::vector<Vertex>{0, 65}).size() == 2);
+
+  // A tetrahedron which contains 2 of the triangles replaces them
+  tm.insert_simplex(std::vector<Vertex>{0, 65, 66, 67});
+  BOOST_CHECK(tm.num_maximal_simplices() == n - 2);
+  BOOST_CHECK(!tm.maximality(std::vector<Vertex>{0, 65, 66}));
+  BOOST_CHECK(tm.membership(std::vector<Vertex>{0, 65, 66}));
+  BOOST_CHECK(tm.maximal_cofaces(std::vector<Vertex>{0, 66}).size() == 1);
+
+  tm.remove_simplex(std::vector<Vertex>{0, 66});
+  BOOST_CHECK(!tm.membership(std::vector<Vertex>{0, 66}));
+  BOOST_CHECK(tm.membership(std::vector<Vertex>{0, 65}));
+  BOOST_CHECK(tm.membership(std::vector<Vertex>{66}));
+  BOOST_CHECK(tm.membership(std::vector<Vertex>{0, 1, 2}));
+}
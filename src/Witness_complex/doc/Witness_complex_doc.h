@@ -40,6 +40,11 @@
    Hence for small relaxation weak version is preferable.
    However, to capture the homotopy type (for example using Gudhi::persistent_cohomology::Persistent_cohomology) it is often necessary to work with higher filtration values. In this case strong relaxed witness complex is faster to compute and offers similar results.
 
+   The filtration value of a simplex in a complex of relaxation \f$\alpha^2\f$ is the smallest squared relaxation for
+   which it belongs to the complex. Therefore, to try several relaxations, the complex only needs to be created once,
+   with the largest one: the complex of a smaller relaxation \f$a\f$ is the result of
+   `Gudhi::Simplex_tree::prune_above_filtration(a)`, applied from the largest relaxation to the smallest one.
+
    \section witnessimplementation Implementation
    
    The two complexes described above are implemented in the corresponding classes 
@@ -57,6 +62,11 @@
 
    The constructors take on the steps 1 and 2, while the function 'create_complex' executes the step 3.
 
+   When the number of landmarks that a witness may need is bounded, the function
+   Gudhi::witness_complex::compute_nearest_landmark_table computes (in parallel if TBB is available) a
+   Gudhi::witness_complex::Nearest_landmark_table with the k nearest landmarks of each witness stored contiguously,
+   which can be given to the non-Euclidean classes instead of the incremental searches.
+
    \section witnessexample1 Example 1: Constructing weak relaxed witness complex from an off file
 
    Let's start with a simple example, which reads an off point file and computes a weak witness complex.
@@ -14,12 +14,15 @@
 
 #include <gudhi/Witness_complex.h>
 #include <gudhi/Active_witness/Active_witness.h>
+#include <gudhi/Witness_complex/Nearest_landmark_table.h>
 #include <gudhi/Kd_tree_search.h>
 
 #include <CGAL/version.h>  // for CGAL_VERSION_NR
+#include <CGAL/number_utils.h>  // for CGAL::to_double
 
 #include <Eigen/src/Core/util/Macros.h>  // for EIGEN_VERSION_AT_LEAST
 
+#include <algorithm>  // for std::min, std::copy, std::transform
 #include <utility>
 #include <vector>
 #include <list>
@@ -101,6 +104,43 @@ class Euclidean_witness_complex
   //@}
 };
 
+/**
+ * \brief Computes the `num_neighbors` nearest landmarks of each witness, with the batched queries of
+ * `Kd_tree_search`, in parallel when TBB is available.
+ * \ingroup witness_complex
+ *
+ * \details The result can be given to `Witness_complex` or `Strong_witness_complex` instead of the incremental
+ * searches of `Euclidean_witness_complex` and `Euclidean_strong_witness_complex`, which traverse the search tree
+ * again each time a witness needs one more landmark. The complexes are the same if the landmarks that a witness
+ * needs are among its `num_neighbors` nearest ones, which always holds if `num_neighbors` is the number of landmarks.
+ *
+ * \tparam Kernel requires a <a target="_blank"
+ * href="http://doc.cgal.org/latest/Kernel_d/classCGAL_1_1Epick__d.html">CGAL::Epick_d</a> class.
+ * @param[in] landmarks Range of landmarks of type `Kernel::Point_d`.
+ * @param[in] witnesses Range of witnesses of type `Kernel::Point_d`.
+ * @param[in] num_neighbors Number of nearest landmarks to keep for each witness, at most the number of landmarks.
+ */
+template< class Kernel, typename LandmarkRange, typename WitnessRange >
+Nearest_landmark_table compute_nearest_landmark_table(const LandmarkRange & landmarks,
+                                                      const WitnessRange & witnesses,
+                                                      std::size_t num_neighbors) {
+  typedef std::vector<typename Kernel::Point_d> Point_range;
+  Point_range landmark_points(std::begin(landmarks), std::end(landmarks));
+  Point_range witness_points(std::begin(witnesses), std::end(witnesses));
+  Gudhi::spatial_searching::Kd_tree_search<Kernel, Point_range> landmark_tree(landmark_points);
+  num_neighbors = std::min(num_neighbors, landmark_points.size());
+  auto neighbors = landmark_tree.k_nearest_neighbors_batch(witness_points, static_cast<unsigned>(num_neighbors));
+  Nearest_landmark_table table(witness_points.size(), num_neighbors);
+  for (std::size_t w = 0; w < witness_points.size(); ++w) {
+    std::copy(neighbors.indices.begin() + neighbors.offsets[w], neighbors.indices.begin() + neighbors.offsets[w + 1],
+              table.landmarks(w));
+    std::transform(neighbors.squared_distances.begin() + neighbors.offsets[w],
+                   neighbors.squared_distances.begin() + neighbors.offsets[w + 1], table.squared_distances(w),
+                   [](auto const& d) { return CGAL::to_double(d); });
+  }
+  return table;
+}
+
 }  // namespace witness_complex
 
 }  // namespace Gudhi
@@ -5,6 +5,7 @@
  *    Copyright (C) 2015 Inria
  *
  *    Modification(s):
+ *      - 2023/11 David Loiseaux: Inclusive relaxation bound in double precision, for relaxation sweeps.
  *      - YYYY/MM Author: Description of the modification
  */
 
@@ -77,6 +78,10 @@ class Strong_witness_complex {
   /** \brief Outputs the strong witness complex of relaxation 'max_alpha_square' 
    *         in a simplicial complex data structure.
    *  \details The function returns true if the construction is successful and false otherwise.
+   *
+   *  The filtration value of a simplex is the smallest relaxation for which it is strongly witnessed, so that the
+   *  complex of any smaller relaxation is obtained from this one with `prune_above_filtration`, instead of being
+   *  created again. To sweep over the relaxations, create the complex once with the largest one.
    *  @param[out] complex Simplicial complex data structure, which is a model of
    *              SimplicialComplexForWitness concept.
    *  @param[in] max_alpha_square Maximal squared relaxation parameter.
@@ -101,15 +106,15 @@ class Strong_witness_complex {
       ActiveWitness aw(w);
       typeVectorVertex simplex;
       typename ActiveWitness::iterator aw_it = aw.begin();
-      float lim_dist2 = aw.begin()->second + max_alpha_square;
-      while ((Landmark_id)simplex.size() <= limit_dimension && aw_it != aw.end() && aw_it->second < lim_dist2) {
+      double lim_dist2 = aw.begin()->second + max_alpha_square;
+      while ((Landmark_id)simplex.size() <= limit_dimension && aw_it != aw.end() && aw_it->second <= lim_dist2) {
         simplex.push_back(aw_it->first);
         complex.insert_simplex_and_subfaces(simplex, aw_it->second - aw.begin()->second);
         aw_it++;
       }
       // continue inserting limD-faces of the following simplices
       typeVectorVertex& vertices = simplex;  // 'simplex' now will be called vertices
-      while (aw_it != aw.end() && aw_it->second < lim_dist2) {
+      while (aw_it != aw.end() && aw_it->second <= lim_dist2) {
         typeVectorVertex facet = {};
         add_all_faces_of_dimension(limit_dimension, vertices, vertices.begin(), aw_it,
                                    aw_it->second - aw.begin()->second, facet, complex);
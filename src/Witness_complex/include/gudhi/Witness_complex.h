@@ -14,11 +14,19 @@
 #include <gudhi/Active_witness/Active_witness.h>
 #include <gudhi/Witness_complex/all_faces_in.h>
 
+#include <algorithm>  // for std::copy_n
+#include <iostream>
 #include <utility>
 #include <vector>
 #include <list>
 #include <limits>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
 namespace Gudhi {
 
 namespace witness_complex {
@@ -79,6 +87,11 @@ class Witness_complex {
   /** \brief Outputs the (weak) witness complex of relaxation 'max_alpha_square'
    *         in a simplicial complex data structure.
    *  \details The function returns true if the construction is successful and false otherwise.
+   *
+   *  The filtration value of a simplex is the smallest relaxation for which it is witnessed and all its faces are in
+   *  the complex, so that the complex of any smaller relaxation is obtained from this one with
+   *  `prune_above_filtration`, instead of being created again. To sweep over the relaxations, create the complex once
+   *  with the largest one.
    *  @param[out] complex Simplicial complex data structure compatible which is a model of
    *              SimplicialComplexForWitness concept.
    *  @param[in] max_alpha_square Maximal squared relaxation parameter.
@@ -105,6 +118,9 @@ class Witness_complex {
       typename ActiveWitnessList::iterator aw_it = active_witnesses.begin();
       std::vector<Landmark_id> simplex;
       simplex.reserve(k+1);
+      auto insert = [&complex](const std::vector<Landmark_id>& face, double filtration_value) {
+        complex.insert_simplex(face, filtration_value);
+      };
       while (aw_it != active_witnesses.end()) {
         bool ok = add_all_faces_of_dimension(k,
                                              max_alpha_square,
@@ -112,7 +128,8 @@ class Witness_complex {
                                              aw_it->begin(),
                                              simplex,
                                              complex,
-                                             aw_it->end());
+                                             aw_it->end(),
+                                             insert);
         assert(simplex.empty());
         if (!ok)
           active_witnesses.erase(aw_it++);  // First increase the iterator and then erase the previous element
@@ -124,22 +141,105 @@ class Witness_complex {
     return true;
   }
 
+  /** \brief Same as `create_complex`, but the witnesses are processed in parallel when TBB is available.
+   *  \details Dimension by dimension, chunks of active witnesses look for the simplices they witness in the complex
+   *  of lower dimension, which is not modified meanwhile, and record them in thread-local buffers. These simplices are
+   *  then inserted sequentially, each one getting the minimal filtration value among its witnesses, so that the
+   *  resulting complex is the same as with `create_complex`.
+   *  @param[out] complex Simplicial complex data structure compatible which is a model of
+   *              SimplicialComplexForWitness concept.
+   *  @param[in] max_alpha_square Maximal squared relaxation parameter.
+   *  @param[in] limit_dimension Represents the maximal dimension of the simplicial complex
+   *         (default value = no limit).
+   */
+  template < typename SimplicialComplexForWitness >
+  bool parallel_create_complex(SimplicialComplexForWitness& complex,
+                               double  max_alpha_square,
+                               std::size_t limit_dimension = std::numeric_limits<std::size_t>::max()) const {
+#ifdef GUDHI_USE_TBB
+    if (complex.num_vertices() > 0) {
+      std::cerr << "Witness complex cannot create complex - complex is not empty.\n";
+      return false;
+    }
+    if (max_alpha_square < 0) {
+      std::cerr << "Witness complex cannot create complex - squared relaxation parameter must be non-negative.\n";
+      return false;
+    }
+    // Active witnesses stay in a list, as their iterators point inside them, and are accessed through a vector.
+    ActiveWitnessList active_witnesses;
+    for (auto&& w : nearest_landmark_table_)
+      active_witnesses.emplace_back(w);
+    std::vector<typename ActiveWitnessList::iterator> active;
+    std::vector<char> still_active;
+    // Vertices of the witnessed simplices, k+1 at a time, and their filtration values.
+    struct Buffer {
+      std::vector<Landmark_id> vertices;
+      std::vector<double> filtration_values;
+    };
+    tbb::enumerable_thread_specific<Buffer> buffers;
+    for (Landmark_id k = 0; !active_witnesses.empty() && k <= limit_dimension; k++) {
+      active.clear();
+      for (auto aw_it = active_witnesses.begin(); aw_it != active_witnesses.end(); ++aw_it)
+        active.push_back(aw_it);
+      still_active.assign(active.size(), false);
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, active.size()),
+                        [&](const tbb::blocked_range<std::size_t>& range) {
+        Buffer& buffer = buffers.local();
+        auto insert = [&buffer](const std::vector<Landmark_id>& face, double filtration_value) {
+          buffer.vertices.insert(buffer.vertices.end(), face.begin(), face.end());
+          buffer.filtration_values.push_back(filtration_value);
+        };
+        std::vector<Landmark_id> simplex;
+        simplex.reserve(k+1);
+        for (std::size_t i = range.begin(); i != range.end(); ++i) {
+          still_active[i] = add_all_faces_of_dimension(k,
+                                                       max_alpha_square,
+                                                       std::numeric_limits<double>::infinity(),
+                                                       active[i]->begin(),
+                                                       simplex,
+                                                       complex,
+                                                       active[i]->end(),
+                                                       insert);
+        }
+      });
+      std::vector<Landmark_id> simplex(k+1);
+      for (Buffer& buffer : buffers) {
+        for (std::size_t i = 0; i < buffer.filtration_values.size(); i++) {
+          std::copy_n(buffer.vertices.begin() + i * (k+1), k+1, simplex.begin());
+          // Keeps the minimum if the simplex was already inserted
+          complex.insert_simplex(simplex, buffer.filtration_values[i]);
+        }
+        buffer.vertices.clear();
+        buffer.filtration_values.clear();
+      }
+      for (std::size_t i = 0; i < active.size(); i++)
+        if (!still_active[i])
+          active_witnesses.erase(active[i]);
+    }
+    return true;
+#else
+    return create_complex(complex, max_alpha_square, limit_dimension);
+#endif
+  }
+
   //@}
 
  private:
   /** \brief Adds recursively all the faces of a certain dimension dim witnessed by the same witness.
    * Iterator is needed to know until how far we can take landmarks to form simplexes.
    * simplex is the prefix of the simplexes to insert.
+   * The simplices of dimension dim are passed to insert(simplex, filtration_value), the complex is only read.
    * The output value indicates if the witness rests active or not.
    */
-  template < typename SimplicialComplexForWitness >
+  template < typename SimplicialComplexForWitness, typename Insert >
   bool add_all_faces_of_dimension(int dim,
                                   double alpha2,
                                   double norelax_dist2,
                                   typename ActiveWitness::iterator curr_l,
                                   std::vector<Landmark_id>& simplex,
                                   SimplicialComplexForWitness& sc,
-                                  typename ActiveWitness::iterator end) const {
+                                  typename ActiveWitness::iterator end,
+                                  Insert& insert) const {
     if (curr_l == end)
       return false;
     bool will_be_active = false;
@@ -155,7 +255,8 @@ class Witness_complex {
                                                       ++next_it,
                                                       simplex,
                                                       sc,
-                                                      end) || will_be_active;
+                                                      end,
+                                                      insert) || will_be_active;
         }
         assert(!simplex.empty());
         simplex.pop_back();
@@ -172,7 +273,7 @@ class Witness_complex {
           filtration_value = l_it->second - norelax_dist2;
         if (all_faces_in(simplex, &filtration_value, sc)) {
           will_be_active = true;
-          sc.insert_simplex(simplex, filtration_value);
+          insert(simplex, filtration_value);
         }
         assert(!simplex.empty());
         simplex.pop_back();
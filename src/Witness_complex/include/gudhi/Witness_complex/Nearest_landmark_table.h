@@ -0,0 +1,132 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef WITNESS_COMPLEX_NEAREST_LANDMARK_TABLE_H_
+#define WITNESS_COMPLEX_NEAREST_LANDMARK_TABLE_H_
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Gudhi {
+
+namespace witness_complex {
+
+/**
+ * \class Nearest_landmark_table
+ * \brief Table of the k nearest landmarks of each witness, stored contiguously.
+ * \ingroup witness_complex
+ *
+ * \details The landmark indices and the squared distances are stored in two separate arrays, witness after witness,
+ * so that a witness reads its nearest landmarks sequentially instead of querying a search tree. It can be passed
+ * to the constructors of `Witness_complex` and `Strong_witness_complex`, which only keep views on its rows: the
+ * table must outlive them.
+ *
+ * Only the k nearest landmarks of each witness are known, so the complexes built from the table are the same as with
+ * all the landmarks only if k is large enough for the relaxation and the dimension, for instance if k is the number
+ * of landmarks.
+ */
+class Nearest_landmark_table {
+ public:
+  /** \brief Range of the nearest landmarks of a witness, as pairs of a landmark index and a squared distance. */
+  class Row {
+   public:
+    class iterator : public boost::iterator_facade<iterator, std::pair<std::size_t, double>,
+                                                   boost::random_access_traversal_tag,
+                                                   std::pair<std::size_t, double>> {
+     public:
+      iterator() = default;
+      iterator(const std::size_t* landmarks, const double* squared_distances)
+          : landmarks_(landmarks), squared_distances_(squared_distances) {}
+
+     private:
+      friend class boost::iterator_core_access;
+      std::pair<std::size_t, double> dereference() const { return {*landmarks_, *squared_distances_}; }
+      bool equal(const iterator& other) const { return landmarks_ == other.landmarks_; }
+      void increment() { ++landmarks_; ++squared_distances_; }
+      void decrement() { --landmarks_; --squared_distances_; }
+      void advance(std::ptrdiff_t n) { landmarks_ += n; squared_distances_ += n; }
+      std::ptrdiff_t distance_to(const iterator& other) const { return other.landmarks_ - landmarks_; }
+
+      const std::size_t* landmarks_ = nullptr;
+      const double* squared_distances_ = nullptr;
+    };
+    using const_iterator = iterator;
+
+    Row(const std::size_t* landmarks, const double* squared_distances, std::size_t size)
+        : landmarks_(landmarks), squared_distances_(squared_distances), size_(size) {}
+    iterator begin() const { return iterator(landmarks_, squared_distances_); }
+    iterator end() const { return iterator(landmarks_ + size_, squared_distances_ + size_); }
+    std::size_t size() const { return size_; }
+
+   private:
+    const std::size_t* landmarks_;
+    const double* squared_distances_;
+    std::size_t size_;
+  };
+
+  using value_type = Row;
+
+  class iterator : public boost::iterator_facade<iterator, Row, boost::random_access_traversal_tag, Row> {
+   public:
+    iterator() = default;
+    iterator(const Nearest_landmark_table* table, std::size_t witness) : table_(table), witness_(witness) {}
+
+   private:
+    friend class boost::iterator_core_access;
+    Row dereference() const { return (*table_)[witness_]; }
+    bool equal(const iterator& other) const { return witness_ == other.witness_; }
+    void increment() { ++witness_; }
+    void decrement() { --witness_; }
+    void advance(std::ptrdiff_t n) { witness_ += n; }
+    std::ptrdiff_t distance_to(const iterator& other) const {
+      return static_cast<std::ptrdiff_t>(other.witness_) - static_cast<std::ptrdiff_t>(witness_);
+    }
+
+    const Nearest_landmark_table* table_ = nullptr;
+    std::size_t witness_ = 0;
+  };
+  using const_iterator = iterator;
+
+  /** \brief Creates a table for `num_witnesses` witnesses and `num_neighbors` landmarks per witness, to be filled
+   * through `landmarks` and `squared_distances`. */
+  Nearest_landmark_table(std::size_t num_witnesses, std::size_t num_neighbors)
+      : num_witnesses_(num_witnesses), num_neighbors_(num_neighbors),
+        landmarks_(num_witnesses * num_neighbors), squared_distances_(num_witnesses * num_neighbors) {}
+
+  std::size_t size() const { return num_witnesses_; }
+  std::size_t num_neighbors() const { return num_neighbors_; }
+
+  /** \brief Indices of the nearest landmarks of the witness `witness`, sorted by increasing distance. */
+  std::size_t* landmarks(std::size_t witness) { return landmarks_.data() + witness * num_neighbors_; }
+  /** \brief Squared distances from the witness `witness` to its nearest landmarks, in increasing order. */
+  double* squared_distances(std::size_t witness) { return squared_distances_.data() + witness * num_neighbors_; }
+
+  Row operator[](std::size_t witness) const {
+    return Row(landmarks_.data() + witness * num_neighbors_, squared_distances_.data() + witness * num_neighbors_,
+               num_neighbors_);
+  }
+  iterator begin() const { return iterator(this, 0); }
+  iterator end() const { return iterator(this, num_witnesses_); }
+
+ private:
+  std::size_t num_witnesses_;
+  std::size_t num_neighbors_;
+  std::vector<std::size_t> landmarks_;
+  std::vector<double> squared_distances_;
+};
+
+}  // namespace witness_complex
+
+}  // namespace Gudhi
+
+#endif  // WITNESS_COMPLEX_NEAREST_LANDMARK_TABLE_H_
@@ -131,5 +131,25 @@ BOOST_AUTO_TEST_CASE(simple_witness_complex) {
   BOOST_CHECK(strong_relaxed_complex2_ne.num_simplices() == 92);
 
 
+  // Precomputed table of all the nearest landmarks
+  Gudhi::witness_complex::Nearest_landmark_table precomputed_table =
+      Gudhi::witness_complex::compute_nearest_landmark_table<Kernel>(landmarks, witnesses, landmarks.size());
+  BOOST_CHECK(precomputed_table.size() == witnesses.size());
+  BOOST_CHECK(precomputed_table.num_neighbors() == landmarks.size());
+
+  Simplex_tree relaxed_complex_pre, strong_relaxed_complex_pre;
+  Gudhi::witness_complex::Witness_complex<Gudhi::witness_complex::Nearest_landmark_table>
+      witness_complex_pre(precomputed_table);
+  witness_complex_pre.create_complex(relaxed_complex_pre, 8.01);
+  std::clog << "relaxed_complex_pre.num_simplices() = " << relaxed_complex_pre.num_simplices() << std::endl;
+  BOOST_CHECK(relaxed_complex_pre.num_simplices() == 239);
+
+  Gudhi::witness_complex::Strong_witness_complex<Gudhi::witness_complex::Nearest_landmark_table>
+      strong_witness_complex_pre(precomputed_table);
+  strong_witness_complex_pre.create_complex(strong_relaxed_complex_pre, 9.1, 2);
+  std::clog << "strong_relaxed_complex_pre.num_simplices() = " << strong_relaxed_complex_pre.num_simplices()
+            << std::endl;
+  BOOST_CHECK(strong_relaxed_complex_pre.num_simplices() == 92);
+
   // 8 vertices, 28 edges, 56 triangles
 }
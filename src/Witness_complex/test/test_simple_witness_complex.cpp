@@ -6,10 +6,14 @@
 #include <gudhi/Simplex_tree.h>
 
 #include <gudhi/Witness_complex.h>
+#include <gudhi/Strong_witness_complex.h>
+#include <gudhi/Witness_complex/Nearest_landmark_table.h>
 
 #include <iostream>
 #include <vector>
 #include <utility>
+#include <random>
+#include <algorithm>
 
 
 BOOST_AUTO_TEST_CASE(simple_witness_complex) {
@@ -51,3 +55,119 @@ BOOST_AUTO_TEST_CASE(simple_witness_complex) {
   BOOST_CHECK(stree2.num_simplices() == 25);
 
 }
+
+BOOST_AUTO_TEST_CASE(parallel_witness_complex) {
+  using Nearest_landmark_range = std::vector<std::pair<std::size_t, double>>;
+  using Nearest_landmark_table = std::vector<Nearest_landmark_range>;
+  using Witness_complex = Gudhi::witness_complex::Witness_complex<Nearest_landmark_table>;
+  using Simplex_tree = Gudhi::Simplex_tree<>;
+
+  // Random points on a line, the landmarks being the first ones
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0., 10.);
+  const std::size_t num_landmarks = 30, num_witnesses = 2000;
+  std::vector<double> landmarks(num_landmarks);
+  for (auto& l : landmarks) l = dist(gen);
+  Nearest_landmark_table nlt;
+  for (std::size_t w = 0; w < num_witnesses; w++) {
+    double x = dist(gen);
+    Nearest_landmark_range range;
+    for (std::size_t l = 0; l < num_landmarks; l++) range.emplace_back(l, (x - landmarks[l]) * (x - landmarks[l]));
+    std::sort(range.begin(), range.end(), [](auto const& a, auto const& b) { return a.second < b.second; });
+    nlt.push_back(range);
+  }
+
+  Witness_complex witness_complex(nlt);
+  Simplex_tree stree, stree_parallel;
+  BOOST_CHECK(witness_complex.create_complex(stree, 1., 3));
+  BOOST_CHECK(witness_complex.parallel_create_complex(stree_parallel, 1., 3));
+  std::clog << "Number of simplices: " << stree.num_simplices() << std::endl;
+  BOOST_CHECK(stree.dimension() == 3);
+  BOOST_CHECK(stree == stree_parallel);
+
+  // Same errors as create_complex
+  BOOST_CHECK(!witness_complex.parallel_create_complex(stree_parallel, 1.));
+  Simplex_tree stree2;
+  BOOST_CHECK(!witness_complex.parallel_create_complex(stree2, -0.02));
+}
+
+BOOST_AUTO_TEST_CASE(witness_complex_from_contiguous_table) {
+  using Nearest_landmark_range = std::vector<std::pair<std::size_t, double>>;
+  using Nearest_landmark_table = std::vector<Nearest_landmark_range>;
+  using Contiguous_table = Gudhi::witness_complex::Nearest_landmark_table;
+  using Simplex_tree = Gudhi::Simplex_tree<>;
+
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(0., 10.);
+  const std::size_t num_landmarks = 20, num_witnesses = 500;
+  std::vector<double> landmarks(num_landmarks);
+  for (auto& l : landmarks) l = dist(gen);
+  Nearest_landmark_table nlt;
+  Contiguous_table table(num_witnesses, num_landmarks);
+  BOOST_CHECK(table.size() == num_witnesses);
+  BOOST_CHECK(table.num_neighbors() == num_landmarks);
+  for (std::size_t w = 0; w < num_witnesses; w++) {
+    double x = dist(gen);
+    Nearest_landmark_range range;
+    for (std::size_t l = 0; l < num_landmarks; l++) range.emplace_back(l, (x - landmarks[l]) * (x - landmarks[l]));
+    std::sort(range.begin(), range.end(), [](auto const& a, auto const& b) { return a.second < b.second; });
+    for (std::size_t i = 0; i < num_landmarks; i++) {
+      table.landmarks(w)[i] = range[i].first;
+      table.squared_distances(w)[i] = range[i].second;
+    }
+    nlt.push_back(range);
+  }
+  BOOST_CHECK(std::equal(table[3].begin(), table[3].end(), nlt[3].begin(), nlt[3].end()));
+
+  Simplex_tree stree, stree_table;
+  Gudhi::witness_complex::Witness_complex<Nearest_landmark_table>(nlt).create_complex(stree, 1.5, 3);
+  Gudhi::witness_complex::Witness_complex<Contiguous_table>(table).create_complex(stree_table, 1.5, 3);
+  std::clog << "Number of simplices: " << stree.num_simplices() << std::endl;
+  BOOST_CHECK(stree == stree_table);
+
+  Simplex_tree strong, strong_table;
+  Gudhi::witness_complex::Strong_witness_complex<Nearest_landmark_table>(nlt).create_complex(strong, 1.5, 3);
+  Gudhi::witness_complex::Strong_witness_complex<Contiguous_table>(table).create_complex(strong_table, 1.5, 3);
+  std::clog << "Number of simplices: " << strong.num_simplices() << std::endl;
+  BOOST_CHECK(strong == strong_table);
+}
+
+BOOST_AUTO_TEST_CASE(witness_complex_relaxation_sweep) {
+  using Nearest_landmark_range = std::vector<std::pair<std::size_t, double>>;
+  using Nearest_landmark_table = std::vector<Nearest_landmark_range>;
+  using Simplex_tree = Gudhi::Simplex_tree<>;
+
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> dist(0., 10.);
+  const std::size_t num_landmarks = 20, num_witnesses = 300;
+  std::vector<double> landmarks(num_landmarks);
+  for (auto& l : landmarks) l = dist(gen);
+  Nearest_landmark_table nlt;
+  for (std::size_t w = 0; w < num_witnesses; w++) {
+    double x = dist(gen);
+    Nearest_landmark_range range;
+    for (std::size_t l = 0; l < num_landmarks; l++) range.emplace_back(l, (x - landmarks[l]) * (x - landmarks[l]));
+    std::sort(range.begin(), range.end(), [](auto const& a, auto const& b) { return a.second < b.second; });
+    nlt.push_back(range);
+  }
+  Gudhi::witness_complex::Witness_complex<Nearest_landmark_table> weak(nlt);
+  Gudhi::witness_complex::Strong_witness_complex<Nearest_landmark_table> strong(nlt);
+
+  Simplex_tree weak_sweep, strong_sweep;
+  BOOST_CHECK(weak.create_complex(weak_sweep, 3., 3));
+  BOOST_CHECK(strong.create_complex(strong_sweep, 3., 3));
+  for (double max_alpha_square : {2., 1., 0.3, 0.}) {
+    Simplex_tree weak_rebuilt, strong_rebuilt;
+    weak.create_complex(weak_rebuilt, max_alpha_square, 3);
+    strong.create_complex(strong_rebuilt, max_alpha_square, 3);
+    weak_sweep.prune_above_filtration(max_alpha_square);
+    strong_sweep.prune_above_filtration(max_alpha_square);
+    std::clog << "Number of simplices: " << weak_sweep.num_simplices() << " " << strong_sweep.num_simplices()
+              << std::endl;
+    BOOST_CHECK(weak_sweep == weak_rebuilt);
+    BOOST_CHECK(strong_sweep == strong_rebuilt);
+  }
+  // The 0-relaxed strong witness complex consists of the nearest landmarks of the witnesses
+  BOOST_CHECK(strong_sweep.num_vertices() > 0);
+  BOOST_CHECK(strong_sweep.dimension() == 0);
+}
@@ -43,6 +43,11 @@ if (DEBUG_TRACES)
   add_definitions(-DDEBUG_TRACES)
 endif()
 
+if (WITH_GUDHI_PROFILING)
+  message(STATUS "Profiling instrumentation is activated")
+  add_definitions(-DGUDHI_USE_PROFILING)
+endif()
+
 if(CMAKE_BUILD_TYPE MATCHES Debug)
   message("++ Debug compilation flags are: ${CMAKE_CXX_FLAGS} ${CMAKE_CXX_FLAGS_DEBUG}")
 else()
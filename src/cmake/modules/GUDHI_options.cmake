@@ -1,6 +1,8 @@
 option(WITH_GUDHI_BENCHMARK "Activate/deactivate benchmark compilation" OFF)
 option(WITH_GUDHI_EXAMPLE "Activate/deactivate examples compilation and installation" OFF)
 option(WITH_GUDHI_REMOTE_TEST "Activate/deactivate datasets fetching test which uses the Internet" OFF)
+option(WITH_GUDHI_PROFILING "Activate/deactivate the scoped timers and counters of gudhi/Profiler.h" OFF)
+option(WITH_GUDHI_ALLOCATION_TESTS "Activate/deactivate the tests of the allocation budgets of the hot loops, which replace the global operator new" OFF)
 option(WITH_GUDHI_PYTHON "Activate/deactivate python module compilation and installation" ON)
 option(WITH_GUDHI_TEST "Activate/deactivate examples compilation and installation" ON)
 option(WITH_GUDHI_UTILITIES "Activate/deactivate utilities compilation and installation" ON)
@@ -90,6 +90,16 @@ if(WITH_GUDHI_USE_TBB)
   endif()
 endif()
 
+option(WITH_GUDHI_MPI "Build the distributed (MPI) persistence tests and examples" OFF)
+
+# Find MPI for the distributed persistence - not mandatory, just optional.
+if(WITH_GUDHI_MPI)
+  find_package(MPI COMPONENTS CXX)
+  if(TARGET MPI::MPI_CXX)
+    message("++ MPI version ${MPI_CXX_VERSION} found - run with ${MPIEXEC_EXECUTABLE}")
+  endif()
+endif()
+
 set(CGAL_WITH_EIGEN3_VERSION 0.0.0)
 find_package(Eigen3 3.1.0)
 if (EIGEN3_FOUND)
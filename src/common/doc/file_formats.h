@@ -67,6 +67,30 @@ namespace Gudhi {
  Such files can be generated with `Gudhi::persistent_cohomology::Persistent_cohomology::output_diagram()` and read with
  `Gudhi::read_persistence_intervals_and_dimension()`, `Gudhi::read_persistence_intervals_grouped_by_dimension()` or
  `Gudhi::read_persistence_intervals_in_dimension()`.
+
+ \section FileFormatsPersBinary Binary Persistence Diagram
+
+ For large diagrams, a persistence diagram can also be stored in binary, with the births and deaths in contiguous
+ arrays that can be memory mapped. The integers and values are in the byte order of the machine (little-endian on all
+ the supported platforms). The file starts with a 16-byte header:
+ \verbatim
+   char[8]   magic number "GUDHIDGM"
+   uint32    version of the format, 1
+   uint32    size in bytes of a birth or a death, 4 for float32 or 8 for float64
+ \endverbatim
+ followed by blocks until the end of the file, each one holding intervals of the same dimension:
+ \verbatim
+   int64     dimension
+   uint64    number n of intervals
+   2n values birth_1 death_1 ... birth_n death_n
+   padding   zero bytes up to the next multiple of 8 bytes
+ \endverbatim
+ A dimension may have several blocks when the diagram is streamed. Essential intervals have an infinite death.
+
+ Such files can be generated with `Gudhi::Persistence_diagram_binary_writer`,
+ `Gudhi::write_persistence_intervals_to_binary_stream()` or
+ `Gudhi::persistent_cohomology::Persistent_cohomology::output_diagram_binary()`, and are read by the same functions
+ as the text format above, or in Python by `gudhi.read_persistence_intervals_from_binary_file()`.
  
 
  \section FileFormatsIsoCuboid Iso-cuboid
@@ -0,0 +1,78 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef ALLOCATION_COUNTER_H_
+#define ALLOCATION_COUNTER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>  // for std::malloc, std::free
+#include <new>
+
+namespace Gudhi {
+
+/** \brief Counting of the dynamic allocations, to check that a hot loop does not allocate.
+ *
+ * The allocations are only counted in a program that replaces the global `operator new`, which is done by expanding
+ * the macro `GUDHI_COUNT_ALLOCATIONS()` once, at namespace scope, in one of its translation units. This is meant for
+ * tests, and is enabled in the ones of the library by the cmake option `WITH_GUDHI_ALLOCATION_TESTS`.
+ *
+ * \code{.cpp}
+ * GUDHI_COUNT_ALLOCATIONS();
+ * ...
+ * Gudhi::allocation_counter::Scope scope;
+ * for (auto sh : st.complex_simplex_range()) ...;
+ * assert(scope.allocations() == 0);
+ * \endcode
+ */
+namespace allocation_counter {
+
+/** \brief Number of calls of the global `operator new` since the start of the program, in all the threads. */
+inline std::atomic<std::size_t>& num_allocations() {
+  static std::atomic<std::size_t> count{0};
+  return count;
+}
+
+/** \brief Counts the allocations from its construction. */
+class Scope {
+ public:
+  Scope() : start_(num_allocations().load()) {}
+
+  /** \brief Number of allocations since the construction or the last call of `restart()`. */
+  std::size_t allocations() const { return num_allocations().load() - start_; }
+
+  void restart() { start_ = num_allocations().load(); }
+
+ private:
+  std::size_t start_;
+};
+
+inline void* allocate(std::size_t size) {
+  num_allocations().fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+  throw std::bad_alloc();
+}
+
+}  // namespace allocation_counter
+
+}  // namespace Gudhi
+
+// The replacement functions of the global operator new cannot be inline, hence a macro to expand in only one
+// translation unit. The aligned overloads are not replaced, they do not go through these ones.
+#define GUDHI_COUNT_ALLOCATIONS()                                                                      \
+  void* operator new(std::size_t size) { return Gudhi::allocation_counter::allocate(size); }         \
+  void* operator new[](std::size_t size) { return Gudhi::allocation_counter::allocate(size); }       \
+  void operator delete(void* ptr) noexcept { std::free(ptr); }                                        \
+  void operator delete[](void* ptr) noexcept { std::free(ptr); }                                      \
+  void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }                           \
+  void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }                         \
+  static_assert(true, "")
+
+#endif  // ALLOCATION_COUNTER_H_
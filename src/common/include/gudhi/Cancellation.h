@@ -0,0 +1,77 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef CANCELLATION_H_
+#define CANCELLATION_H_
+
+#include <atomic>
+#include <stdexcept>
+
+namespace Gudhi {
+
+/** \brief Exception thrown by a long computation that was cancelled through its `Cancellation_flag`. */
+class Cancelled : public std::runtime_error {
+ public:
+  Cancelled() : std::runtime_error("Computation cancelled") {}
+};
+
+/** \brief Flag that another thread raises to stop the long computations run under a `Cancellation_scope`.
+ *
+ * \details The computations that support cancellation check the flag in their main loops, e.g. once per vertex in
+ * `Simplex_tree::expansion()` and once every few simplices in
+ * `Persistent_cohomology::compute_persistent_cohomology()`, and then throw `Cancelled`. The cost of the checks is
+ * negligible, and nothing is checked when no flag is set.
+ */
+class Cancellation_flag {
+ public:
+  /** \brief Requests the cancellation of the computations that check this flag. It can be called from any thread. */
+  void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+  /** \brief Whether `cancel()` was called. */
+  bool is_cancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<bool> cancelled_{false};
+};
+
+/** \brief Flag checked by the computations started by the current thread, or nullptr. */
+inline Cancellation_flag*& current_cancellation_flag() {
+  static thread_local Cancellation_flag* flag = nullptr;
+  return flag;
+}
+
+/** \brief Sets the flag checked by the computations started by the current thread, e.g. `nullptr` for none, and
+ * returns the previous one. */
+inline Cancellation_flag* exchange_cancellation_flag(Cancellation_flag* flag) {
+  Cancellation_flag* previous = current_cancellation_flag();
+  current_cancellation_flag() = flag;
+  return previous;
+}
+
+/** \brief Sets the flag checked by the computations started by the current thread for the lifetime of the scope. */
+class Cancellation_scope {
+ public:
+  explicit Cancellation_scope(Cancellation_flag* flag) : previous_(exchange_cancellation_flag(flag)) {}
+  Cancellation_scope(const Cancellation_scope&) = delete;
+  Cancellation_scope& operator=(const Cancellation_scope&) = delete;
+  ~Cancellation_scope() { exchange_cancellation_flag(previous_); }
+
+ private:
+  Cancellation_flag* previous_;
+};
+
+/** \brief Throws `Cancelled` if the flag is not null and raised. The computations read `current_cancellation_flag()`
+ * once, in the thread that starts them, and give it to this function in their loops, also in the threads of TBB. */
+inline void check_cancellation(const Cancellation_flag* flag) {
+  if (flag != nullptr && flag->is_cancelled()) throw Cancelled();
+}
+
+}  // namespace Gudhi
+
+#endif  // CANCELLATION_H_
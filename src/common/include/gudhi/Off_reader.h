@@ -13,6 +13,8 @@
 #define OFF_READER_H_
 
 
+#include <gudhi/text_parsing.h>
+
 #include <sstream>
 #include <iostream>
 #include <iterator>
@@ -25,6 +27,8 @@ namespace Gudhi {
 /** \brief OFF file reader top class visitor. 
  * 
  * OFF file must be conform to \ref FileFormatsOFF
+ *
+ * The rest of the stream is read at once and parsed in memory, which is much faster than reading it line by line.
  */
 class Off_reader {
  public:
@@ -49,6 +53,10 @@ class Off_reader {
    */
   template<typename OffVisitor>
   bool read(OffVisitor& off_visitor) {
+    content_ = text_parsing::read_all(stream_);
+    position_ = content_.c_str();
+    end_ = position_ + content_.size();
+
     bool success_read_off_preamble = read_off_preamble(off_visitor);
     if (!success_read_off_preamble) {
       std::cerr << "could not read off preambule\n";
@@ -73,6 +81,10 @@ class Off_reader {
 
  private:
   std::ifstream& stream_;
+  // Content of the stream, and current position in it
+  std::string content_;
+  const char* position_ = nullptr;
+  const char* end_ = nullptr;
 
   struct Off_info {
     int dim;
@@ -85,56 +97,72 @@ class Off_reader {
 
   template<typename OffVisitor>
   bool read_off_preamble(OffVisitor& off_visitor) {
-    std::string line;
-    if (!goto_next_uncomment_line(line)) return false;
+    const char* line;
+    const char* line_end;
+    if (!goto_next_uncomment_line(line, line_end)) return false;
+    std::string header(line, line_end);
 
-    bool is_off_file = (line.find("OFF") != std::string::npos);
-    bool is_noff_file = (line.find("nOFF") != std::string::npos);
+    bool is_off_file = (header.find("OFF") != std::string::npos);
+    bool is_noff_file = (header.find("nOFF") != std::string::npos);
 
 
 
     if (!is_off_file && !is_noff_file) {
-      std::cerr << line << std::endl;
+      std::cerr << header << std::endl;
       std::cerr << "missing off header\n";
       return false;
     }
 
     if (is_noff_file) {
       // Should be on a separate line, but we accept it on the same line as the number of vertices
-      stream_ >> off_info_.dim;
+      while (position_ != end_ && text_parsing::is_space(*position_)) ++position_;
+      const char* dim_end = text_parsing::parse_number(position_, end_, off_info_.dim);
+      if (dim_end == position_) return false;
+      position_ = dim_end;
     } else {
       off_info_.dim = 3;
     }
 
-    if (!goto_next_uncomment_line(line)) return false;
-    std::istringstream iss(line);
-    if (!(iss >> off_info_.num_vertices >> off_info_.num_faces >> off_info_.num_edges)) {
+    if (!goto_next_uncomment_line(line, line_end)) return false;
+    int counts[3];
+    int num_counts = 0;
+    text_parsing::for_each_number<int>(line, line_end, ' ', [&](int count) {
+      if (num_counts < 3) counts[num_counts++] = count;
+    });
+    if (num_counts < 3) {
       std::cerr << "incorrect number of vertices/faces/edges\n";
       return false;
     }
+    off_info_.num_vertices = counts[0];
+    off_info_.num_faces = counts[1];
+    off_info_.num_edges = counts[2];
     off_visitor.init(off_info_.dim, off_info_.num_vertices, off_info_.num_faces, off_info_.num_edges);
 
     return true;
   }
 
-  bool goto_next_uncomment_line(std::string& uncomment_line) {
+  bool goto_next_uncomment_line(const char*& line, const char*& line_end) {
     do {
       // skip whitespace, including empty lines
-      if (!std::ifstream::sentry(stream_)) return false;
-      std::getline(stream_, uncomment_line);
-    } while (uncomment_line[0] == '#');
-    return static_cast<bool>(stream_);
+      while (position_ != end_ && text_parsing::is_space(*position_)) ++position_;
+      if (position_ == end_) return false;
+      line = position_;
+      line_end = text_parsing::line_end(position_, end_);
+      position_ = (line_end == end_) ? end_ : line_end + 1;
+    } while (*line == '#');
+    return true;
   }
 
   template<typename OffVisitor>
   bool read_off_points(OffVisitor& visitor) {
     int num_vertices_to_read = off_info_.num_vertices;
+    std::vector<double> point;
     while (num_vertices_to_read--) {
-      std::string line;
-      if (!goto_next_uncomment_line(line)) return false;
-      std::vector<double> point;
-      std::istringstream iss(line);
-      point.assign(std::istream_iterator<double>(iss), std::istream_iterator<double>());
+      const char* line;
+      const char* line_end;
+      if (!goto_next_uncomment_line(line, line_end)) return false;
+      point.clear();
+      text_parsing::for_each_number<double>(line, line_end, ' ', [&point](double x) { point.push_back(x); });
       // if(point.size() != off_info_.dim) return false;
       visitor.point(point);
     }
@@ -143,13 +171,17 @@ class Off_reader {
 
   template<typename OffVisitor>
   bool read_off_faces(OffVisitor& visitor) {
-    std::string line;
-    while (goto_next_uncomment_line(line)) {
-      std::istringstream iss(line);
-      int num_face_vertices;
-      iss >> num_face_vertices;
-      std::vector<int> face;
-      face.assign(std::istream_iterator<int>(iss), std::istream_iterator<int>());
+    const char* line;
+    const char* line_end;
+    std::vector<int> face;
+    while (goto_next_uncomment_line(line, line_end)) {
+      face.clear();
+      bool first = true;
+      // The first number is the number of vertices of the face
+      text_parsing::for_each_number<int>(line, line_end, ' ', [&](int v) {
+        if (!first) face.push_back(v);
+        first = false;
+      });
       // if (face.size() != (off_info_.dim + 1)) return false;
       visitor.maximal_face(face);
     }
@@ -0,0 +1,136 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <gudhi/Profiler_instrumentation.h>
+
+#include <algorithm>  // for std::stable_sort
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <stdexcept>  // for std::runtime_error
+#include <string>
+#include <vector>
+
+namespace Gudhi {
+
+/** \brief Instrumentation of the library : nestable scoped timers, event counters and traces.
+ *
+ * The instrumentation points are the macros `GUDHI_PROFILE_SCOPE(name)`, which times the end of the enclosing scope,
+ * and `GUDHI_PROFILE_COUNT(name, n)`, which adds `n` to a counter. The timers and counters are compiled out unless
+ * `GUDHI_USE_PROFILING` is defined (cmake option `WITH_GUDHI_PROFILING`), so that they cost nothing by default.
+ *
+ * The headers of the library only include the instrumentation points, from `gudhi/Profiler_instrumentation.h`.
+ * `GUDHI_USE_PROFILING` has to be defined in the same way in all the translation units of a program.
+ *
+ * Each thread records its own timers and counters, and `report()` sums them over the threads. The data of a thread is
+ * merged in a single record of the finished threads when it ends. A timer is identified by the path of the timers
+ * enclosing it in its thread, e.g. `Persistent_cohomology::compute_persistent_cohomology/
+ * Simplex_tree::initialize_filtration`. `report()` and `reset()` should not be called while instrumented code runs.
+ *
+ * The scopes are also the phases of a trace, which is recorded between `start_tracing()` and `stop_tracing()`
+ * whatever `GUDHI_USE_PROFILING`, and can be written in the Chrome trace format with `write_chrome_trace()`, to be
+ * viewed in `chrome://tracing` or Perfetto. When no trace is recorded, a scope only costs the load of an atomic
+ * boolean.
+ */
+namespace profiling {
+
+/** \brief Timers, by path, and counters, by name, summed over the threads. */
+struct Report {
+  std::map<std::string, Timer_entry> timers;
+  std::map<std::string, std::size_t> counters;
+};
+
+namespace internal {
+
+inline void clear_trace() {
+  Registry::instance().for_each_thread([](Thread_data& data) { data.events.clear(); });
+}
+
+}  // namespace internal
+
+/** \brief Starts recording a trace, after clearing the events recorded before. */
+inline void start_tracing() {
+  internal::clear_trace();
+  internal::Registry::instance().tracing().store(true);
+}
+
+/** \brief Stops recording the trace. Its events are kept until the next call of `start_tracing()`. */
+inline void stop_tracing() { internal::Registry::instance().tracing().store(false); }
+
+/** \brief Events of the trace, of all the threads, sorted by timestamp. */
+inline std::vector<Trace_event> trace_events() {
+  std::vector<Trace_event> out;
+  internal::Registry::instance().for_each_thread(
+      [&out](const internal::Thread_data& data) { out.insert(out.end(), data.events.begin(), data.events.end()); });
+  std::stable_sort(out.begin(), out.end(),
+                   [](const Trace_event& a, const Trace_event& b) { return a.timestamp < b.timestamp; });
+  return out;
+}
+
+/** \brief Writes `events` as a JSON object in the Chrome trace event format. */
+inline void write_chrome_trace(std::ostream& out, const std::vector<Trace_event>& events) {
+  out << "{\"traceEvents\": [";
+  for (std::size_t i = 0; i < events.size(); i++) {
+    const auto& event = events[i];
+    out << (i ? ",\n" : "\n") << "  {\"name\": \"";
+    for (char c : event.name) {
+      if (c == '"' || c == '\\') out << '\\';
+      out << c;
+    }
+    out << "\", \"ph\": \"" << event.phase << "\", \"ts\": " << std::fixed << event.timestamp << std::defaultfloat
+        << ", \"pid\": 0, \"tid\": " << event.thread << "}";
+  }
+  out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+/** \brief Writes the events of the trace in the file `filename`, in the Chrome trace event format.
+ * @exception std::runtime_error If the file cannot be written.
+ */
+inline void write_chrome_trace(const std::string& filename) {
+  std::ofstream out(filename);
+  if (!out) throw std::runtime_error("Cannot write the trace in " + filename);
+  write_chrome_trace(out, trace_events());
+}
+
+/** \brief Timers and counters recorded since the start of the program or the last call of `reset()`. */
+inline Report report() {
+  Report out;
+#ifdef GUDHI_USE_PROFILING
+  internal::Registry::instance().for_each_thread([&out](const internal::Thread_data& data) {
+    for (const auto& [path, entry] : data.timers) {
+      auto& total = out.timers[path];
+      total.seconds += entry.seconds;
+      total.calls += entry.calls;
+    }
+    for (const auto& [name, count] : data.counters) out.counters[name] += count;
+  });
+#endif
+  return out;
+}
+
+/** \brief Clears all the timers and counters. */
+inline void reset() {
+#ifdef GUDHI_USE_PROFILING
+  internal::Registry::instance().for_each_thread([](internal::Thread_data& data) {
+    data.timers.clear();
+    data.counters.clear();
+  });
+#endif
+}
+
+}  // namespace profiling
+
+}  // namespace Gudhi
+
+#endif  // PROFILER_H_
@@ -0,0 +1,270 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef PROFILER_INSTRUMENTATION_H_
+#define PROFILER_INSTRUMENTATION_H_
+
+#include <algorithm>  // for std::find
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>  // for std::less, std::hash
+#include <memory>  // for std::unique_ptr
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>  // for std::move
+#include <vector>
+
+#ifdef GUDHI_USE_PROFILING
+#include <map>
+#endif
+
+namespace Gudhi {
+
+// Instrumentation points of gudhi/Profiler.h, included by the headers of the library. Without GUDHI_USE_PROFILING,
+// they only record traces, and do not need the standard maps of the timers and counters.
+namespace profiling {
+
+/** \brief Accumulated time of a timer, and number of times its scope was entered. */
+struct Timer_entry {
+  double seconds = 0;
+  std::size_t calls = 0;
+};
+
+/** \brief Beginning (`phase` 'B') or end ('E') of a scope in a trace. The timestamp is in microseconds of
+ * `std::chrono::steady_clock`, and the thread is a 31 bits hash of its `std::thread::id`, so that the events recorded by
+ * several copies of the library in a process, e.g. several python modules, can be merged. */
+struct Trace_event {
+  std::string name;
+  char phase;
+  double timestamp;
+  std::size_t thread;
+};
+
+namespace internal {
+
+// The locks are hardly ever contended: a thread only competes with report(), reset() and the tracing functions.
+class Spin_lock {
+ public:
+  void lock() {
+    while (flag_.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+  }
+  void unlock() { flag_.clear(std::memory_order_release); }
+
+ private:
+  std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+};
+
+class Lock_guard {
+ public:
+  explicit Lock_guard(Spin_lock& lock) : lock_(lock) { lock_.lock(); }
+  ~Lock_guard() { lock_.unlock(); }
+  Lock_guard(const Lock_guard&) = delete;
+  Lock_guard& operator=(const Lock_guard&) = delete;
+
+ private:
+  Spin_lock& lock_;
+};
+
+struct Thread_data {
+  // Only locked by the owner thread, and by the Registry
+  Spin_lock lock;
+  std::vector<Trace_event> events;
+  std::size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id()) & 0x7fffffff;
+#ifdef GUDHI_USE_PROFILING
+  std::map<std::string, Timer_entry, std::less<>> timers;
+  std::map<std::string, std::size_t, std::less<>> counters;
+  // Path of the innermost running timer of the thread
+  std::string scope;
+#endif
+
+  // Adds the timers, counters and events of other to this one.
+  void merge(Thread_data& other) {
+    events.insert(events.end(), other.events.begin(), other.events.end());
+#ifdef GUDHI_USE_PROFILING
+    for (const auto& [path, entry] : other.timers) {
+      auto& total = timers[path];
+      total.seconds += entry.seconds;
+      total.calls += entry.calls;
+    }
+    for (const auto& [name, count] : other.counters) counters[name] += count;
+#endif
+  }
+};
+
+class Registry {
+ public:
+  static Registry& instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  // Data of the calling thread, registered on first use. At the end of the thread, it is merged in the data of the
+  // finished threads, so that the registry does not grow with short-lived threads.
+  Thread_data& local() {
+    thread_local Thread_handle handle(*this);
+    return *handle.data;
+  }
+
+  // Calls f on the data of the running threads and on the merged data of the finished ones, each one locked.
+  template <class F>
+  void for_each_thread(F&& f) {
+    Lock_guard lock(lock_);
+    {
+      Lock_guard finished_lock(finished_.lock);
+      f(finished_);
+    }
+    for (Thread_data* data : threads_) {
+      Lock_guard thread_lock(data->lock);
+      f(*data);
+    }
+  }
+
+  std::size_t number_of_running_threads() {
+    Lock_guard lock(lock_);
+    return threads_.size();
+  }
+
+  std::atomic<bool>& tracing() { return tracing_; }
+
+ private:
+  struct Thread_handle {
+    explicit Thread_handle(Registry& registry) : registry(registry), data(std::make_unique<Thread_data>()) {
+      Lock_guard lock(registry.lock_);
+      registry.threads_.push_back(data.get());
+    }
+    ~Thread_handle() {
+      Lock_guard lock(registry.lock_);
+      registry.threads_.erase(std::find(registry.threads_.begin(), registry.threads_.end(), data.get()));
+      Lock_guard finished_lock(registry.finished_.lock);
+      registry.finished_.merge(*data);
+    }
+    Registry& registry;
+    std::unique_ptr<Thread_data> data;
+  };
+
+  Spin_lock lock_;
+  std::vector<Thread_data*> threads_;
+  Thread_data finished_;
+  std::atomic<bool> tracing_{false};
+};
+
+inline void add_event(std::string_view name, char phase) {
+  const std::chrono::duration<double, std::micro> timestamp = std::chrono::steady_clock::now().time_since_epoch();
+  auto& data = Registry::instance().local();
+  Lock_guard lock(data.lock);
+  data.events.push_back({std::string(name), phase, timestamp.count(), data.thread});
+}
+
+}  // namespace internal
+
+/** \brief Whether a trace is being recorded. */
+inline bool is_tracing() { return internal::Registry::instance().tracing().load(std::memory_order_relaxed); }
+
+/** \brief Records the beginning of a phase of the trace in the calling thread, if a trace is being recorded.
+ * Each call must be matched by a call of `end_event()` in the same thread. */
+inline void begin_event(std::string_view name) {
+  if (is_tracing()) internal::add_event(name, 'B');
+}
+
+/** \brief Records the end of the innermost running phase of the calling thread, if a trace is being recorded. */
+inline void end_event(std::string_view name) {
+  if (is_tracing()) internal::add_event(name, 'E');
+}
+
+/** \brief Records its lifetime as a phase of the trace, if a trace is being recorded when it is constructed. */
+class Scoped_trace {
+ public:
+  explicit Scoped_trace(std::string_view name) : name_(is_tracing() ? name : std::string_view()) {
+    if (!name_.empty()) internal::add_event(name_, 'B');
+  }
+
+  ~Scoped_trace() {
+    if (!name_.empty()) internal::add_event(name_, 'E');
+  }
+
+  Scoped_trace(const Scoped_trace&) = delete;
+  Scoped_trace& operator=(const Scoped_trace&) = delete;
+
+ private:
+  std::string_view name_;
+};
+
+#ifdef GUDHI_USE_PROFILING
+/** \brief Times its lifetime, nested in the running timers of the thread, and records it in the trace as
+ * `Scoped_trace`. */
+class Scoped_timer {
+ public:
+  explicit Scoped_timer(std::string_view name)
+      : trace_(name), data_(internal::Registry::instance().local()), parent_length_(data_.scope.size()) {
+    if (!data_.scope.empty()) data_.scope += '/';
+    data_.scope += name;
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  ~Scoped_timer() {
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+    {
+      internal::Lock_guard lock(data_.lock);
+      auto& entry = data_.timers[data_.scope];
+      entry.seconds += elapsed.count();
+      entry.calls++;
+    }
+    data_.scope.resize(parent_length_);
+  }
+
+  Scoped_timer(const Scoped_timer&) = delete;
+  Scoped_timer& operator=(const Scoped_timer&) = delete;
+
+ private:
+  Scoped_trace trace_;
+  internal::Thread_data& data_;
+  std::size_t parent_length_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/** \brief Adds `n` to the counter `name` of the calling thread. */
+inline void count(std::string_view name, std::size_t n = 1) {
+  auto& data = internal::Registry::instance().local();
+  internal::Lock_guard lock(data.lock);
+  auto it = data.counters.find(name);
+  if (it == data.counters.end()) it = data.counters.emplace(std::string(name), 0).first;
+  it->second += n;
+}
+#endif  // GUDHI_USE_PROFILING
+
+/** \brief Whether the instrumentation points are compiled, i.e. `GUDHI_USE_PROFILING` is defined. */
+constexpr bool enabled() {
+#ifdef GUDHI_USE_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace profiling
+
+}  // namespace Gudhi
+
+#define GUDHI_PROFILE_CONCAT_(a, b) a##b
+#define GUDHI_PROFILE_CONCAT(a, b) GUDHI_PROFILE_CONCAT_(a, b)
+
+#ifdef GUDHI_USE_PROFILING
+#define GUDHI_PROFILE_SCOPE(name) \
+  Gudhi::profiling::Scoped_timer GUDHI_PROFILE_CONCAT(gudhi_profile_scope_, __LINE__)(name)
+#define GUDHI_PROFILE_COUNT(name, n) Gudhi::profiling::count(name, n)
+#else
+#define GUDHI_PROFILE_SCOPE(name) \
+  Gudhi::profiling::Scoped_trace GUDHI_PROFILE_CONCAT(gudhi_profile_scope_, __LINE__)(name)
+#define GUDHI_PROFILE_COUNT(name, n)
+#endif
+
+#endif  // PROFILER_INSTRUMENTATION_H_
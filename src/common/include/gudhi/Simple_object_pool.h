@@ -55,13 +55,29 @@ class Simple_object_pool : protected boost::pool<boost::default_user_allocator_m
       base().free BOOST_PREVENT_MACRO_SUBSTITUTION(p);
       throw;
     }
+    ++num_objects_;
     return static_cast<pointer> (p);
   }
 
   void destroy(pointer p) {
     p->~T();
     base().free BOOST_PREVENT_MACRO_SUBSTITUTION(p);
+    --num_objects_;
   }
+
+  /* Gives back the memory of all the objects at once, without calling their destructors. */
+  void release() {
+    base().purge_memory();
+    num_objects_ = 0;
+  }
+
+  /* Number of objects constructed and not yet destroyed or released. */
+  size_type num_objects() const {
+    return num_objects_;
+  }
+
+ private:
+  size_type num_objects_ = 0;
 };
 
 }  // namespace Gudhi
@@ -0,0 +1,230 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef FLAT_FILE_READERS_H_
+#define FLAT_FILE_READERS_H_
+
+#include <gudhi/text_parsing.h>
+
+#include <boost/range/iterator_range.hpp>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <cstddef>  // for std::size_t
+#include <stdexcept>  // for std::invalid_argument
+#include <string>
+#include <utility>  // for std::pair
+#include <vector>
+
+namespace Gudhi {
+
+/** \brief Points stored contiguously, row after row, as read by `read_flat_points_from_off_file`.
+ *
+ * It is a range of points, each point being a `boost::iterator_range<const T*>` on its coordinates, so that it can be
+ * given directly to `Gudhi::rips_complex::Rips_complex` with `Gudhi::Euclidean_distance`.
+ * It can be moved but not copied, as the points refer to the coordinates.
+ */
+template <typename T>
+class Flat_point_cloud {
+ public:
+  using Point = boost::iterator_range<const T*>;
+  using const_iterator = typename std::vector<Point>::const_iterator;
+
+  Flat_point_cloud() = default;
+  Flat_point_cloud(std::size_t dimension, std::vector<T>&& data) : dimension_(dimension), data_(std::move(data)) {
+    const std::size_t num_points = dimension_ == 0 ? 0 : data_.size() / dimension_;
+    points_.reserve(num_points);
+    for (std::size_t i = 0; i < num_points; ++i)
+      points_.emplace_back(data_.data() + i * dimension_, data_.data() + (i + 1) * dimension_);
+  }
+  Flat_point_cloud(const Flat_point_cloud&) = delete;
+  Flat_point_cloud& operator=(const Flat_point_cloud&) = delete;
+  Flat_point_cloud(Flat_point_cloud&&) = default;
+  Flat_point_cloud& operator=(Flat_point_cloud&&) = default;
+
+  /** \brief Number of coordinates of each point. */
+  std::size_t dimension() const { return dimension_; }
+  /** \brief Number of points. */
+  std::size_t size() const { return points_.size(); }
+  /** \brief Coordinates of all the points, of size `size() * dimension()`. */
+  const std::vector<T>& data() const { return data_; }
+  const Point& operator[](std::size_t i) const { return points_[i]; }
+  const_iterator begin() const { return points_.begin(); }
+  const_iterator end() const { return points_.end(); }
+
+ private:
+  std::size_t dimension_ = 0;
+  std::vector<T> data_;
+  std::vector<Point> points_;
+};
+
+/** \brief Lower triangular distance matrix stored contiguously, as read by
+ * `read_flat_lower_triangular_matrix_from_csv_file`.
+ *
+ * `matrix[i][j]` is the distance between \f$i\f$ and \f$j\f$ for \f$j < i\f$, so that it can be given directly to
+ * `Gudhi::rips_complex::Rips_complex` and `Gudhi::rips_complex::Rips_persistence`.
+ */
+template <typename T>
+class Flat_lower_triangular_matrix {
+ public:
+  Flat_lower_triangular_matrix() = default;
+  /** \brief The rows of size 0 to `size - 1` are concatenated in data, which must be of size `size * (size - 1) / 2`. */
+  Flat_lower_triangular_matrix(std::size_t size, std::vector<T>&& data) : size_(size), data_(std::move(data)) {}
+
+  /** \brief Number of points. */
+  std::size_t size() const { return size_; }
+  /** \brief Rows of the matrix below the diagonal, concatenated. */
+  const std::vector<T>& data() const { return data_; }
+  /** \brief Start of the row i, of size i. */
+  const T* operator[](std::size_t i) const { return data_.data() + i * (i - 1) / 2; }
+
+ private:
+  std::size_t size_ = 0;
+  std::vector<T> data_;
+};
+
+namespace detail {
+
+/* Calls parse_row(i) for each i in [0, n), in parallel with TBB if parallel is true. */
+template <typename Parse_row>
+void for_each_row(std::size_t n, bool parallel, Parse_row&& parse_row) {
+#ifdef GUDHI_USE_TBB
+  if (parallel) {
+    tbb::parallel_for(std::size_t(0), n, [&](std::size_t i) { parse_row(i); });
+    return;
+  }
+#endif
+  (void)parallel;
+  for (std::size_t i = 0; i < n; ++i) parse_row(i);
+}
+
+/* Parses the first size numbers of [line, line_end) in row, or throws if there are fewer. */
+template <typename T>
+void parse_row(const char* line, const char* line_end, char separator, T* row, std::size_t size,
+               const char* error_message) {
+  std::size_t count = 0;
+  const char* p = line;
+  for (; count < size; ++count) {
+    p = text_parsing::skip_blanks(p, line_end, separator);
+    const char* next = text_parsing::parse_number(p, line_end, row[count]);
+    if (next == p) throw std::invalid_argument(error_message);
+    p = next;
+  }
+}
+
+}  // namespace detail
+
+/** \brief Reads the points of an OFF file, see \ref FileFormatsOFF, in a `Flat_point_cloud`. The faces are ignored.
+ *
+ * The file is read at once, the lines of the points are located sequentially, and then parsed with `std::from_chars`,
+ * in parallel with TBB if `parallel` is true. This is much faster than `Gudhi::Points_off_reader` on large files.
+ *
+ * @exception std::invalid_argument If the file cannot be read, its header is invalid, or a point has fewer
+ * coordinates than the dimension.
+ */
+template <typename T = double>
+Flat_point_cloud<T> read_flat_points_from_off_file(const std::string& file_name, bool parallel = true) {
+  std::string content;
+  if (!text_parsing::read_file(file_name, content))
+    throw std::invalid_argument("read_flat_points_from_off_file - Unable to open file " + file_name);
+  const char* position = content.c_str();
+  const char* end = position + content.size();
+
+  // Next line that is not empty nor a comment
+  auto next_line = [&position, end]() -> std::pair<const char*, const char*> {
+    while (true) {
+      while (position != end && text_parsing::is_space(*position)) ++position;
+      if (position == end) return {end, end};
+      const char* line = position;
+      const char* line_end = text_parsing::line_end(position, end);
+      position = (line_end == end) ? end : line_end + 1;
+      if (*line != '#') return {line, line_end};
+    }
+  };
+
+  auto [header, header_end] = next_line();
+  const std::string header_line(header, header_end);
+  if (header_line.find("OFF") == std::string::npos)
+    throw std::invalid_argument("read_flat_points_from_off_file - missing off header in " + file_name);
+  std::size_t dimension = 3;
+  if (header_line.find("nOFF") != std::string::npos) {
+    // Should be on a separate line, but we accept it on the same line as the number of vertices
+    while (position != end && text_parsing::is_space(*position)) ++position;
+    const char* dimension_end = text_parsing::parse_number(position, end, dimension);
+    if (dimension_end == position)
+      throw std::invalid_argument("read_flat_points_from_off_file - missing dimension in " + file_name);
+    position = dimension_end;
+  }
+
+  auto [counts, counts_end] = next_line();
+  std::size_t num_points = 0;
+  if (text_parsing::parse_number(text_parsing::skip_blanks(counts, counts_end), counts_end, num_points) == counts)
+    throw std::invalid_argument("read_flat_points_from_off_file - incorrect number of vertices in " + file_name);
+
+  std::vector<std::pair<const char*, const char*>> lines;
+  lines.reserve(num_points);
+  for (std::size_t i = 0; i < num_points; ++i) {
+    lines.push_back(next_line());
+    if (lines.back().first == end)
+      throw std::invalid_argument("read_flat_points_from_off_file - missing points in " + file_name);
+  }
+
+  std::vector<T> data(num_points * dimension);
+  detail::for_each_row(num_points, parallel, [&](std::size_t i) {
+    detail::parse_row(lines[i].first, lines[i].second, ' ', data.data() + i * dimension, dimension,
+                      "read_flat_points_from_off_file - a point has too few coordinates");
+  });
+  return Flat_point_cloud<T>(dimension, std::move(data));
+}
+
+/** \brief Reads a lower triangular distance matrix from a csv file, in the same format as
+ * `read_lower_triangular_matrix_from_csv_file`, in a `Flat_lower_triangular_matrix`.
+ *
+ * The first line is ignored, and the matrix stops at the first empty line. The row \f$i\f$ must have at least
+ * \f$i\f$ entries, the other ones are ignored, so that a full square matrix can also be read.
+ * The file is read at once, the lines are located sequentially, and then parsed with `std::from_chars`, in parallel
+ * with TBB if `parallel` is true.
+ *
+ * @exception std::invalid_argument If the file cannot be read or a row has too few entries.
+ */
+template <typename T = double>
+Flat_lower_triangular_matrix<T> read_flat_lower_triangular_matrix_from_csv_file(const std::string& file_name,
+                                                                               const char separator = ';',
+                                                                               bool parallel = true) {
+  std::string content;
+  if (!text_parsing::read_file(file_name, content))
+    throw std::invalid_argument("read_flat_lower_triangular_matrix_from_csv_file - Unable to open file " + file_name);
+  const char* position = content.c_str();
+  const char* end = position + content.size();
+
+  // The first line is the row 0, which is empty
+  position = text_parsing::line_end(position, end);
+  std::vector<std::pair<const char*, const char*>> lines(1, {position, position});
+  while (position != end) {
+    const char* line = position + 1;
+    position = text_parsing::line_end(line, end);
+    if (text_parsing::skip_blanks(line, position) == position) break;
+    lines.emplace_back(line, position);
+  }
+
+  const std::size_t size = lines.size();
+  std::vector<T> data(size * (size - 1) / 2);
+  detail::for_each_row(size, parallel, [&](std::size_t i) {
+    detail::parse_row(lines[i].first, lines[i].second, separator, data.data() + i * (i - 1) / 2, i,
+                      "read_flat_lower_triangular_matrix_from_csv_file - a row has too few entries");
+  });
+  return Flat_lower_triangular_matrix<T>(size, std::move(data));
+}
+
+}  // namespace Gudhi
+
+#endif  // FLAT_FILE_READERS_H_
@@ -0,0 +1,166 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef FLAT_RANDOM_POINT_GENERATORS_H_
+#define FLAT_RANDOM_POINT_GENERATORS_H_
+
+#include <boost/math/constants/constants.hpp>  // for pi constant
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
+#include <cmath>  // for std::sqrt, std::log, std::cos, std::sin, std::pow
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uint64_t
+
+namespace Gudhi {
+
+/** \brief Counter-based random numbers: the i-th number of the stream of a point only depends on the seed, the
+ * index of the point and i, so that the points can be generated in parallel, in any order, with the same result.
+ *
+ * The numbers are the outputs of the SplitMix64 finalizer on the combination of the seed, the point and the counter.
+ * They are meant for the generation of data sets and benchmarks, not for cryptography.
+ */
+class Counter_based_random {
+ public:
+  explicit Counter_based_random(std::uint64_t seed) : seed_(mix(seed ^ 0x243f6a8885a308d3ULL)) {}
+
+  /** \brief The i-th 64-bit number of the stream of point. */
+  std::uint64_t bits(std::uint64_t point, std::uint64_t i) const {
+    return mix(seed_ ^ mix(point * 0x9e3779b97f4a7c15ULL + i));
+  }
+
+  /** \brief The i-th number of the stream of point, uniform in [0, 1). */
+  double uniform(std::uint64_t point, std::uint64_t i) const {
+    return static_cast<double>(bits(point, i) >> 11) * 0x1p-53;
+  }
+
+  /** \brief The i-th and i+1-th numbers of the stream of point, standard normal with Box-Muller. */
+  void normal_pair(std::uint64_t point, std::uint64_t i, double& x, double& y) const {
+    using boost::math::double_constants::two_pi;
+    // 1 - u is in (0, 1], whose logarithm is finite
+    const double radius = std::sqrt(-2. * std::log(1. - uniform(point, i)));
+    const double angle = two_pi * uniform(point, i + 1);
+    x = radius * std::cos(angle);
+    y = radius * std::sin(angle);
+  }
+
+ private:
+  static std::uint64_t mix(std::uint64_t z) {
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  std::uint64_t seed_;
+};
+
+namespace detail {
+
+/* Calls generate(i, out + i * dim) for each point i in [0, num_points), in parallel with TBB if parallel is true. */
+template <typename T, typename Generate_point>
+void generate_flat_points(std::size_t num_points, int dim, T* out, bool parallel, Generate_point&& generate) {
+#ifdef GUDHI_USE_TBB
+  if (parallel) {
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_points), [&](const tbb::blocked_range<std::size_t>& r) {
+      for (std::size_t i = r.begin(); i != r.end(); ++i) generate(i, out + i * dim);
+    });
+    return;
+  }
+#endif
+  (void)parallel;
+  for (std::size_t i = 0; i < num_points; ++i) generate(i, out + i * dim);
+}
+
+/* Fills point with dim standard normal coordinates and returns its squared norm. */
+template <typename T>
+double normal_point(const Counter_based_random& rng, std::size_t i, int dim, T* point) {
+  double squared_norm = 0.;
+  for (int j = 0; j < dim; j += 2) {
+    double x, y;
+    rng.normal_pair(i, j, x, y);
+    point[j] = static_cast<T>(x);
+    squared_norm += x * x;
+    if (j + 1 < dim) {
+      point[j + 1] = static_cast<T>(y);
+      squared_norm += y * y;
+    }
+  }
+  return squared_norm;
+}
+
+}  // namespace detail
+
+/** \brief Generates random i.i.d. points uniformly on the sphere of dimension `dim - 1` of radius `radius` centered at
+ * the origin of \f$\mathbb{R}^{dim}\f$, as normalized Gaussian vectors.
+ *
+ * The `num_points * dim` coordinates are written contiguously, point after point, in `out`. The points only depend on
+ * `seed`, not on the number of threads: they are generated in parallel with TBB if `parallel` is true, and the
+ * numbers of a point are drawn from `Counter_based_random` with the index of the point. This is much faster than
+ * `generate_points_on_sphere_d`, which draws the points one after the other with CGAL, on large samples.
+ */
+template <typename T>
+void generate_flat_points_on_sphere_d(std::size_t num_points, int dim, double radius, std::uint64_t seed, T* out,
+                                      bool parallel = true) {
+  Counter_based_random rng(seed);
+  detail::generate_flat_points(num_points, dim, out, parallel, [&](std::size_t i, T* point) {
+    const double scale = radius / std::sqrt(detail::normal_point(rng, i, dim, point));
+    for (int j = 0; j < dim; ++j) point[j] = static_cast<T>(point[j] * scale);
+  });
+}
+
+/** \brief Generates random i.i.d. points uniformly in the ball of dimension `dim` of radius `radius` centered at the
+ * origin, in `out`, as `generate_flat_points_on_sphere_d`. */
+template <typename T>
+void generate_flat_points_in_ball_d(std::size_t num_points, int dim, double radius, std::uint64_t seed, T* out,
+                                    bool parallel = true) {
+  Counter_based_random rng(seed);
+  detail::generate_flat_points(num_points, dim, out, parallel, [&](std::size_t i, T* point) {
+    // The draws 0 to dim - 1 of the point are its direction, the next one its distance to the center
+    const double distance = radius * std::pow(rng.uniform(i, dim + dim % 2), 1. / dim);
+    const double scale = distance / std::sqrt(detail::normal_point(rng, i, dim, point));
+    for (int j = 0; j < dim; ++j) point[j] = static_cast<T>(point[j] * scale);
+  });
+}
+
+/** \brief Generates random i.i.d. points uniformly in the cube \f$[-radius, radius]^{dim}\f$, in `out`, as
+ * `generate_flat_points_on_sphere_d`. */
+template <typename T>
+void generate_flat_points_in_cube_d(std::size_t num_points, int dim, double radius, std::uint64_t seed, T* out,
+                                    bool parallel = true) {
+  Counter_based_random rng(seed);
+  detail::generate_flat_points(num_points, dim, out, parallel, [&](std::size_t i, T* point) {
+    for (int j = 0; j < dim; ++j) point[j] = static_cast<T>(radius * (2. * rng.uniform(i, j) - 1.));
+  });
+}
+
+/** \brief Generates random i.i.d. points uniformly on the flat torus of dimension `dim` in \f$\mathbb{R}^{2 dim}\f$,
+ * the product of `dim` unit circles, in `out`, as `generate_flat_points_on_sphere_d`. A point has `2 * dim`
+ * coordinates. */
+template <typename T>
+void generate_flat_points_on_torus_d(std::size_t num_points, int dim, std::uint64_t seed, T* out,
+                                     bool parallel = true) {
+  using boost::math::double_constants::two_pi;
+  Counter_based_random rng(seed);
+  detail::generate_flat_points(num_points, 2 * dim, out, parallel, [&](std::size_t i, T* point) {
+    for (int j = 0; j < dim; ++j) {
+      const double angle = two_pi * rng.uniform(i, j);
+      point[2 * j] = static_cast<T>(std::cos(angle));
+      point[2 * j + 1] = static_cast<T>(std::sin(angle));
+    }
+  });
+}
+
+}  // namespace Gudhi
+
+#endif  // FLAT_RANDOM_POINT_GENERATORS_H_
@@ -11,12 +11,26 @@
 #ifndef GRAPH_SIMPLICIAL_COMPLEX_H_
 #define GRAPH_SIMPLICIAL_COMPLEX_H_
 
+#include <gudhi/distance_functions.h>
+
 #include <boost/graph/adjacency_list.hpp>
 
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>  // for std::sort, std::equal_range, std::min
+#include <array>
+#include <cmath>  // for std::floor, std::isfinite
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::int64_t
+#include <iterator>  // for std::begin, std::end, std::next, std::distance
+#include <limits>  // for std::numeric_limits
 #include <utility>  // for pair<>
 #include <vector>
 #include <map>
 #include <tuple>  // for std::tie
+#include <type_traits>  // for std::is_same
 
 namespace Gudhi {
 /** @file
@@ -44,11 +58,365 @@ using Proximity_graph = typename boost::adjacency_list < boost::vecS, boost::vec
 , boost::property < vertex_filtration_t, typename SimplicialComplexForProximityGraph::Filtration_value >
 , boost::property < edge_filtration_t, typename SimplicialComplexForProximityGraph::Filtration_value >>;
 
+/** \brief Proximity graph in compressed sparse row format, a compact alternative to `Proximity_graph` that
+ * `Simplex_tree::insert_graph` inserts directly.
+ *
+ * The vertices are \f$0, \ldots, n-1\f$. The neighbors \f$v > u\f$ of the vertex \f$u\f$ are `neighbors[offsets[u]]`,
+ * ..., `neighbors[offsets[u+1]-1]`, sorted and without duplicates, and the filtration value of the edge \f$[u,
+ * neighbors[e]]\f$ is `edge_filtrations[e]`. Each edge is only stored once, from its smallest vertex.
+ */
+template<typename Vertex_handle, typename Filtration_value>
+struct Csr_proximity_graph {
+  /** \brief Filtration values of the vertices. */
+  std::vector<Filtration_value> vertex_filtrations;
+  /** \brief Offsets of the neighbors of each vertex, of size `num_vertices() + 1`. */
+  std::vector<std::size_t> offsets{0};
+  /** \brief Neighbors of the vertices. */
+  std::vector<Vertex_handle> neighbors;
+  /** \brief Filtration values of the edges. */
+  std::vector<Filtration_value> edge_filtrations;
+
+  Csr_proximity_graph() = default;
+
+  /** \brief Builds the graph with `num_vertices` vertices of filtration value 0, from its edges [u,v], u < v, sorted
+   * by increasing u, then increasing v, like the edges computed by `proximity_graph_edges_with_grid`. */
+  Csr_proximity_graph(std::size_t num_vertices, const std::vector<std::pair<Vertex_handle, Vertex_handle>>& edges,
+                      const std::vector<Filtration_value>& edges_fil)
+      : vertex_filtrations(num_vertices, Filtration_value(0)),
+        offsets(num_vertices + 1, 0),
+        neighbors(edges.size()),
+        edge_filtrations(edges_fil) {
+    for (std::size_t e = 0; e < edges.size(); ++e) {
+      ++offsets[edges[e].first + 1];
+      neighbors[e] = edges[e].second;
+    }
+    for (std::size_t u = 0; u < num_vertices; ++u) offsets[u + 1] += offsets[u];
+  }
+
+  /** \brief Returns the number of vertices. */
+  std::size_t num_vertices() const { return vertex_filtrations.size(); }
+  /** \brief Returns the number of edges. */
+  std::size_t num_edges() const { return neighbors.size(); }
+};
+
+namespace detail {
+
+/* Coordinate i of a point, as a double, for the grid of proximity_graph_edges_with_grid. */
+template<typename Point>
+double grid_coordinate(const Point& point, int i) {
+  return static_cast<double>(*std::next(std::begin(point), i));
+}
+
+template<typename T>
+double grid_coordinate(const std::pair<T, T>& point, int i) {
+  return static_cast<double>(i == 0 ? point.first : point.second);
+}
+
+template<typename Point>
+int grid_num_coordinates(const Point& point) {
+  return static_cast<int>(std::distance(std::begin(point), std::end(point)));
+}
+
+template<typename T>
+int grid_num_coordinates(const std::pair<T, T>&) {
+  return 2;
+}
+
+/* Appends the coordinates of a point to a row-major buffer, for euclidean_proximity_edges. */
+template<typename Point, typename Coordinate>
+void append_coordinates(const Point& point, std::vector<Coordinate>& buffer) {
+  buffer.insert(buffer.end(), std::begin(point), std::end(point));
+}
+
+template<typename T, typename Coordinate>
+void append_coordinates(const std::pair<T, T>& point, std::vector<Coordinate>& buffer) {
+  buffer.push_back(point.first);
+  buffer.push_back(point.second);
+}
+
+}  // namespace detail
+
+/** \brief Computes the edges of length at most threshold of the Euclidean proximity graph of points given as a
+ * contiguous row-major buffer, in compressed sparse row format.
+ *
+ * The neighbors \f$v > u\f$ of the vertex \f$u\f$ are `neighbors[offsets[u]]`, ..., `neighbors[offsets[u+1]-1]`, by
+ * increasing order, and `filtrations` contains the lengths of the corresponding edges. The distances are the ones of
+ * `Gudhi::Euclidean_distance`, rounding included.
+ *
+ * The pairs are processed by tiles, as a GPU kernel would: a block of points is compared with a tile of the next
+ * points, whose coordinates are transposed into a buffer that stays in cache for all the points of the block. The
+ * distances from a point to the tile are then computed by loops on contiguous coordinates, which the compiler
+ * vectorizes with the instruction set it targets, and only the edges of the tile shorter than the threshold are kept,
+ * so that the memory is linear in the number of points and edges, even for high-dimensional points. Blocks of points
+ * are processed in parallel with TBB.
+ *
+ * @param[in] points The `num_points * dimension` coordinates, point by point.
+ * @param[in] num_points Number of points.
+ * @param[in] dimension Number of coordinates of each point.
+ * @param[in] threshold Maximal length of the edges.
+ * @param[out] offsets Filled with the `num_points + 1` offsets of the neighbors of each vertex.
+ * @param[out] neighbors Filled with the neighbors.
+ * @param[out] filtrations Filled with the lengths of the edges.
+ */
+template<typename Vertex_handle, typename Filtration_value, typename Coordinate>
+void euclidean_proximity_edges(const Coordinate* points, std::size_t num_points, std::size_t dimension,
+                               Filtration_value threshold, std::vector<std::size_t>& offsets,
+                               std::vector<Vertex_handle>& neighbors, std::vector<Filtration_value>& filtrations) {
+  const std::size_t n = num_points;
+  const std::size_t block_size = 64;
+  // The transposed tile has at most 16384 coordinates, to stay in the L2 cache
+  const std::size_t tile_size = std::clamp<std::size_t>(16384 / std::max<std::size_t>(dimension, 1), 16, 256);
+  // Squared distances above this bound are longer than threshold, the other ones are checked exactly
+  const Coordinate bound = std::isfinite(static_cast<double>(threshold))
+                               ? static_cast<Coordinate>(static_cast<double>(threshold) *
+                                                         static_cast<double>(threshold) * (1. + 1e-6))
+                               : std::numeric_limits<Coordinate>::infinity();
+
+  const std::size_t num_blocks = (n + block_size - 1) / block_size;
+  std::vector<std::vector<std::size_t>> block_counts(num_blocks);
+  std::vector<std::vector<Vertex_handle>> block_neighbors(num_blocks);
+  std::vector<std::vector<Filtration_value>> block_filtrations(num_blocks);
+  auto process_block = [&](std::size_t block) {
+    const std::size_t begin = block * block_size;
+    const std::size_t end = std::min(n, begin + block_size);
+    // tile[k * count + j] is the coordinate k of the point first + j
+    std::vector<Coordinate> tile(tile_size * dimension);
+    std::vector<Coordinate> squared(tile_size);
+    // The edges of each point of the block, which come tile by tile
+    std::vector<std::vector<Vertex_handle>> point_neighbors(end - begin);
+    std::vector<std::vector<Filtration_value>> point_filtrations(end - begin);
+    for (std::size_t first = begin + 1; first < n; first += tile_size) {
+      const std::size_t count = std::min(n - first, tile_size);
+      for (std::size_t j = 0; j < count; ++j)
+        for (std::size_t k = 0; k < dimension; ++k) tile[k * count + j] = points[(first + j) * dimension + k];
+      for (std::size_t u = begin; u < std::min(end, first + count); ++u) {
+        // Only the points v > u of the tile
+        const std::size_t skip = u + 1 > first ? u + 1 - first : 0;
+        Coordinate* sq = squared.data();
+        std::fill(sq + skip, sq + count, Coordinate(0));
+        // Same operations, in the same order, as Euclidean_distance
+        for (std::size_t k = 0; k < dimension; ++k) {
+          const Coordinate x = points[u * dimension + k];
+          const Coordinate* column = tile.data() + k * count;
+          for (std::size_t j = skip; j < count; ++j) {
+            const Coordinate diff = x - column[j];
+            sq[j] += diff * diff;
+          }
+        }
+        for (std::size_t j = skip; j < count; ++j) {
+          if (!(sq[j] <= bound)) continue;
+          Filtration_value fil = std::sqrt(sq[j]);
+          if (fil <= threshold) {
+            point_neighbors[u - begin].push_back(static_cast<Vertex_handle>(first + j));
+            point_filtrations[u - begin].push_back(fil);
+          }
+        }
+      }
+    }
+    for (std::size_t i = 0; i < end - begin; ++i) {
+      block_counts[block].push_back(point_neighbors[i].size());
+      block_neighbors[block].insert(block_neighbors[block].end(), point_neighbors[i].begin(),
+                                    point_neighbors[i].end());
+      block_filtrations[block].insert(block_filtrations[block].end(), point_filtrations[i].begin(),
+                                      point_filtrations[i].end());
+    }
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), num_blocks, process_block);
+#else
+  for (std::size_t block = 0; block < num_blocks; ++block) process_block(block);
+#endif
+
+  offsets.assign(1, 0);
+  offsets.reserve(n + 1);
+  neighbors.clear();
+  filtrations.clear();
+  for (std::size_t block = 0; block < num_blocks; ++block) {
+    for (std::size_t count : block_counts[block]) offsets.push_back(offsets.back() + count);
+    neighbors.insert(neighbors.end(), block_neighbors[block].begin(), block_neighbors[block].end());
+    filtrations.insert(filtrations.end(), block_filtrations[block].begin(), block_filtrations[block].end());
+  }
+}
+
+/** \brief Computes the edges of the proximity graph of the points, in the same order as `compute_proximity_graph`:
+ * the edges [u,v], u < v, of length at most threshold, by increasing u, then increasing v.
+ *
+ * The points are put in the cells of a grid of side `threshold`, on their first 3 coordinates, and each point is
+ * only compared with the points of the neighboring cells, in parallel with TBB. This is exact as long as the
+ * distance is at least the difference of any coordinate, \f$d(p,q) \geq |p_i - q_i|\f$, like the Euclidean distance
+ * and the other \f$L_p\f$ distances. All the pairs are compared if the threshold is not finite. With
+ * `Gudhi::Euclidean_distance` on floating point coordinates, when the grid keeps more than a quarter of the pairs, e.g.
+ * for high-dimensional points, all the pairs are compared with the tiled kernel of `euclidean_proximity_edges` instead.
+ *
+ * \tparam ForwardPointRange contains its points, which are ranges of coordinates or `std::pair`.
+ *
+ * \tparam Distance furnishes `operator()(const Point& p1, const Point& p2)`, which can be called concurrently.
+ *
+ * @return The number of points.
+ */
+template<typename Vertex_handle, typename Filtration_value, typename ForwardPointRange, typename Distance>
+Vertex_handle proximity_graph_edges_with_grid(const ForwardPointRange& points, Filtration_value threshold,
+                                              Distance distance,
+                                              std::vector<std::pair<Vertex_handle, Vertex_handle>>& edges,
+                                              std::vector<Filtration_value>& edges_fil) {
+  using Point = typename std::iterator_traits<decltype(std::begin(points))>::value_type;
+  using Cell = std::array<std::int64_t, 3>;
+  std::vector<const Point*> point_ptrs;
+  for (auto it = std::begin(points); it != std::end(points); ++it) point_ptrs.push_back(&*it);
+  const std::size_t n = point_ptrs.size();
+
+  // Cells of the points, if they can be represented
+  const int grid_dimension = n == 0 ? 0 : std::min(detail::grid_num_coordinates(*point_ptrs[0]), 3);
+  const double side = threshold > 0 ? static_cast<double>(threshold) : 1.;
+  bool use_grid = grid_dimension > 0 && std::isfinite(static_cast<double>(threshold));
+  std::vector<std::pair<Cell, Vertex_handle>> cells(n);
+  for (std::size_t u = 0; u < n && use_grid; ++u) {
+    Cell cell{0, 0, 0};
+    for (int i = 0; i < grid_dimension; ++i) {
+      double c = std::floor(detail::grid_coordinate(*point_ptrs[u], i) / side);
+      // Leave room for the neighboring cells
+      if (!(std::abs(c) < 1e18)) use_grid = false;
+      cell[i] = static_cast<std::int64_t>(c);
+    }
+    cells[u] = std::make_pair(cell, static_cast<Vertex_handle>(u));
+  }
+
+  // All the pairs are candidates when the points span at most 3 cells in each direction
+  bool all_pairs = !use_grid;
+  if (use_grid && n > 0) {
+    Cell low = cells[0].first, high = cells[0].first;
+    for (const auto& cell : cells) {
+      for (int i = 0; i < grid_dimension; ++i) {
+        low[i] = std::min(low[i], cell.first[i]);
+        high[i] = std::max(high[i], cell.first[i]);
+      }
+    }
+    all_pairs = true;
+    for (int i = 0; i < grid_dimension; ++i) all_pairs = all_pairs && high[i] - low[i] <= 2;
+  }
+
+  std::vector<std::pair<Cell, Vertex_handle>> sorted_cells;
+  auto cell_range = [&](const Cell& cell) {
+    return std::equal_range(sorted_cells.begin(), sorted_cells.end(), std::make_pair(cell, Vertex_handle()),
+                            [](const std::pair<Cell, Vertex_handle>& a, const std::pair<Cell, Vertex_handle>& b) {
+                              return a.first < b.first;
+                            });
+  };
+  // Calls f on the 3^grid_dimension cells around a cell, with offsets in {-1, 0, 1}
+  auto for_each_neighboring_cell = [&](const Cell& cell, auto&& f) {
+    Cell offset{0, 0, 0};
+    for (int i = 0; i < grid_dimension; ++i) offset[i] = -1;
+    while (true) {
+      Cell neighbor = cell;
+      for (int i = 0; i < grid_dimension; ++i) neighbor[i] += offset[i];
+      f(neighbor);
+      int i = 0;
+      while (i < grid_dimension && offset[i] == 1) offset[i++] = -1;
+      if (i == grid_dimension) break;
+      ++offset[i];
+    }
+  };
+  if (use_grid) {
+    sorted_cells = cells;
+    std::sort(sorted_cells.begin(), sorted_cells.end());
+  }
+  if (use_grid && !all_pairs) {
+    // With high-dimensional points, the grid on the first coordinates may not separate the points: the tiled kernel
+    // is then faster than the comparison of the candidates one by one, if the grid keeps more than a quarter of the
+    // ordered pairs
+    double candidates = 0;
+    for (auto it = sorted_cells.begin(); it != sorted_cells.end();) {
+      auto range = cell_range(it->first);
+      for_each_neighboring_cell(it->first, [&](const Cell& neighbor) {
+        auto neighbors = cell_range(neighbor);
+        candidates += static_cast<double>(range.second - range.first) * (neighbors.second - neighbors.first);
+      });
+      it = range.second;
+    }
+    all_pairs = 4 * candidates > static_cast<double>(n) * static_cast<double>(n);
+  }
+
+  using Distance_value = decltype(distance(*point_ptrs[0], *point_ptrs[0]));
+  if constexpr (std::is_same<Distance, Euclidean_distance>::value &&
+                std::is_floating_point<std::decay_t<Distance_value>>::value) {
+    if (all_pairs && n > 0) {
+      // Same distances with a vectorized kernel on a contiguous copy of the coordinates
+      using Coordinate = std::decay_t<Distance_value>;
+      const std::size_t dimension = static_cast<std::size_t>(detail::grid_num_coordinates(*point_ptrs[0]));
+      std::vector<Coordinate> buffer;
+      buffer.reserve(n * dimension);
+      for (const Point* point : point_ptrs) detail::append_coordinates(*point, buffer);
+      std::vector<std::size_t> offsets;
+      std::vector<Vertex_handle> neighbors;
+      std::vector<Filtration_value> filtrations;
+      euclidean_proximity_edges(buffer.data(), n, dimension, threshold, offsets, neighbors, filtrations);
+      edges.reserve(edges.size() + neighbors.size());
+      for (std::size_t u = 0; u < n; ++u)
+        for (std::size_t e = offsets[u]; e < offsets[u + 1]; ++e)
+          edges.emplace_back(static_cast<Vertex_handle>(u), neighbors[e]);
+      edges_fil.insert(edges_fil.end(), filtrations.begin(), filtrations.end());
+      return static_cast<Vertex_handle>(n);
+    }
+  }
+
+  if (!use_grid) {
+    for (std::size_t u = 0; u < n; ++u) {
+      for (std::size_t v = u + 1; v < n; ++v) {
+        Filtration_value fil = distance(*point_ptrs[u], *point_ptrs[v]);
+        if (fil <= threshold) {
+          edges.emplace_back(u, v);
+          edges_fil.push_back(fil);
+        }
+      }
+    }
+    return static_cast<Vertex_handle>(n);
+  }
+
+  // The points are processed by blocks, whose edges are concatenated in order
+  const std::size_t block_size = 1024;
+  const std::size_t num_blocks = (n + block_size - 1) / block_size;
+  std::vector<std::vector<std::pair<Vertex_handle, Vertex_handle>>> block_edges(num_blocks);
+  std::vector<std::vector<Filtration_value>> block_edges_fil(num_blocks);
+  auto process_block = [&](std::size_t block) {
+    std::vector<Vertex_handle> candidates;
+    const std::size_t end = std::min(n, (block + 1) * block_size);
+    for (std::size_t u = block * block_size; u < end; ++u) {
+      candidates.clear();
+      for_each_neighboring_cell(cells[u].first, [&](const Cell& neighbor) {
+        auto range = cell_range(neighbor);
+        for (auto it = range.first; it != range.second; ++it)
+          if (static_cast<std::size_t>(it->second) > u) candidates.push_back(it->second);
+      });
+      std::sort(candidates.begin(), candidates.end());
+      for (Vertex_handle v : candidates) {
+        Filtration_value fil = distance(*point_ptrs[u], *point_ptrs[v]);
+        if (fil <= threshold) {
+          block_edges[block].emplace_back(static_cast<Vertex_handle>(u), v);
+          block_edges_fil[block].push_back(fil);
+        }
+      }
+    }
+  };
+#ifdef GUDHI_USE_TBB
+  tbb::parallel_for(std::size_t(0), num_blocks, process_block);
+#else
+  for (std::size_t block = 0; block < num_blocks; ++block) process_block(block);
+#endif
+  for (std::size_t block = 0; block < num_blocks; ++block) {
+    edges.insert(edges.end(), block_edges[block].begin(), block_edges[block].end());
+    edges_fil.insert(edges_fil.end(), block_edges_fil[block].begin(), block_edges_fil[block].end());
+  }
+  return static_cast<Vertex_handle>(n);
+}
+
 /** \brief Computes the proximity graph of the points.
  *
  * If points contains n elements, the proximity graph is the graph with n vertices, and an edge [u,v] iff the
  * distance function between points u and v is smaller than threshold.
  *
+ * With `Gudhi::Euclidean_distance`, only the pairs of close points are compared, see
+ * `proximity_graph_edges_with_grid`.
+ *
  * \tparam SimplicialComplexForProximityGraph furnishes `Filtration_value` and `Vertex_handle` type definitions.
  *
  * \tparam ForwardPointRange furnishes `.begin()` and `.end()` methods.
@@ -68,21 +436,24 @@ Proximity_graph<SimplicialComplexForProximityGraph> compute_proximity_graph(
 
   std::vector<std::pair< Vertex_handle, Vertex_handle >> edges;
   std::vector< Filtration_value > edges_fil;
-  std::map< Vertex_handle, Filtration_value > vertices;
-
-  Vertex_handle idx_u, idx_v;
-  Filtration_value fil;
-  idx_u = 0;
-  for (auto it_u = points.begin(); it_u != points.end(); ++it_u) {
-    idx_v = idx_u + 1;
-    for (auto it_v = it_u + 1; it_v != points.end(); ++it_v, ++idx_v) {
-      fil = distance(*it_u, *it_v);
-      if (fil <= threshold) {
-        edges.emplace_back(idx_u, idx_v);
-        edges_fil.push_back(fil);
+
+  Vertex_handle idx_u = 0;
+  if constexpr (std::is_same<Distance, Euclidean_distance>::value) {
+    idx_u = proximity_graph_edges_with_grid(points, threshold, distance, edges, edges_fil);
+  } else {
+    Vertex_handle idx_v;
+    Filtration_value fil;
+    for (auto it_u = points.begin(); it_u != points.end(); ++it_u) {
+      idx_v = idx_u + 1;
+      for (auto it_v = it_u + 1; it_v != points.end(); ++it_v, ++idx_v) {
+        fil = distance(*it_u, *it_v);
+        if (fil <= threshold) {
+          edges.emplace_back(idx_u, idx_v);
+          edges_fil.push_back(fil);
+        }
       }
+      ++idx_u;
     }
-    ++idx_u;
   }
 
   // Points are labeled from 0 to idx_u-1
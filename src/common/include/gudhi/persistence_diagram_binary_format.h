@@ -0,0 +1,112 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef PERSISTENCE_DIAGRAM_BINARY_FORMAT_H_
+#define PERSISTENCE_DIAGRAM_BINARY_FORMAT_H_
+
+#include <cstdint>  // for std::int64_t, std::uint64_t, std::uint32_t
+#include <cstring>  // for std::memcmp, std::memcpy
+#include <cstddef>  // for std::size_t
+#include <istream>
+#include <ostream>
+#include <stdexcept>  // for std::invalid_argument
+#include <vector>
+
+namespace Gudhi {
+
+namespace persistence_diagram_binary {
+
+/* Layout of the binary persistence diagram format, see \ref FileFormatsPersBinary. The integers and values are
+ * stored in the byte order of the machine, which is little-endian on all the supported platforms. */
+constexpr char magic[8] = {'G', 'U', 'D', 'H', 'I', 'D', 'G', 'M'};
+constexpr std::uint32_t version = 1;
+constexpr std::size_t header_size = 16;
+constexpr std::size_t block_header_size = 16;
+
+/* Number of zero bytes after the values of a block of num_intervals intervals, so that the next block is 8-byte
+ * aligned. */
+inline std::size_t padding(std::uint64_t num_intervals, std::size_t value_size) {
+  return (8 - (2 * num_intervals * value_size) % 8) % 8;
+}
+
+inline void write_header(std::ostream& out, std::uint32_t value_size) {
+  out.write(magic, sizeof(magic));
+  out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  out.write(reinterpret_cast<const char*>(&value_size), sizeof(value_size));
+}
+
+/* Writes a block of values.size() / 2 intervals of dimension dim, values being the births and deaths interleaved. */
+template <typename Value>
+void write_block(std::ostream& out, std::int64_t dim, const std::vector<Value>& values) {
+  const std::uint64_t num_intervals = values.size() / 2;
+  out.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+  out.write(reinterpret_cast<const char*>(&num_intervals), sizeof(num_intervals));
+  out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(Value));
+  const char zeros[8] = {};
+  out.write(zeros, padding(num_intervals, sizeof(Value)));
+}
+
+/* Returns true if the first bytes of in are the magic number of the format. The position of in is restored. */
+inline bool has_magic(std::istream& in) {
+  char start[sizeof(magic)];
+  const auto position = in.tellg();
+  in.read(start, sizeof(start));
+  const bool binary = in.gcount() == sizeof(start) && std::memcmp(start, magic, sizeof(magic)) == 0;
+  in.clear();
+  in.seekg(position);
+  return binary;
+}
+
+/* Reads a binary persistence diagram, and calls out(dim, birth, death) for each interval, block by block.
+ * @exception std::invalid_argument If the header or a block is invalid. */
+template <typename Output>
+void read(std::istream& in, Output&& out) {
+  char header[header_size];
+  in.read(header, header_size);
+  std::uint32_t file_version, value_size;
+  std::memcpy(&file_version, header + 8, sizeof(file_version));
+  std::memcpy(&value_size, header + 12, sizeof(value_size));
+  if (!in || std::memcmp(header, magic, sizeof(magic)) != 0 || file_version != version ||
+      (value_size != sizeof(float) && value_size != sizeof(double)))
+    throw std::invalid_argument("persistence_diagram_binary::read - invalid header");
+  std::vector<char> values;
+  while (true) {
+    char block_header[block_header_size];
+    in.read(block_header, block_header_size);
+    if (in.gcount() == 0) return;
+    if (in.gcount() != static_cast<std::streamsize>(block_header_size))
+      throw std::invalid_argument("persistence_diagram_binary::read - truncated block");
+    std::int64_t dim;
+    std::uint64_t num_intervals;
+    std::memcpy(&dim, block_header, sizeof(dim));
+    std::memcpy(&num_intervals, block_header + 8, sizeof(num_intervals));
+    values.resize(2 * num_intervals * value_size + padding(num_intervals, value_size));
+    in.read(values.data(), values.size());
+    if (in.gcount() != static_cast<std::streamsize>(values.size()))
+      throw std::invalid_argument("persistence_diagram_binary::read - truncated block");
+    for (std::uint64_t i = 0; i < num_intervals; ++i) {
+      if (value_size == sizeof(float)) {
+        float interval[2];
+        std::memcpy(interval, values.data() + 2 * i * sizeof(float), sizeof(interval));
+        out(static_cast<int>(dim), interval[0], interval[1]);
+      } else {
+        double interval[2];
+        std::memcpy(interval, values.data() + 2 * i * sizeof(double), sizeof(interval));
+        out(static_cast<int>(dim), interval[0], interval[1]);
+      }
+    }
+  }
+}
+
+}  // namespace persistence_diagram_binary
+
+}  // namespace Gudhi
+
+#endif  // PERSISTENCE_DIAGRAM_BINARY_FORMAT_H_
@@ -13,6 +13,8 @@
 
 #include <gudhi/graph_simplicial_complex.h>
 #include <gudhi/Debug_utils.h>
+#include <gudhi/persistence_diagram_binary_format.h>
+#include <gudhi/text_parsing.h>
 
 # include <boost/iterator/function_output_iterator.hpp>
 #include <boost/graph/adjacency_list.hpp>
@@ -223,53 +225,34 @@ std::vector<std::vector<Filtration_value>> read_lower_triangular_matrix_from_csv
   std::clog << "Using procedure read_lower_triangular_matrix_from_csv_file \n";
 #endif  // DEBUG_TRACES
   std::vector<std::vector<Filtration_value>> result;
-  std::ifstream in;
-  in.open(filename.c_str());
-  if (!in.is_open()) {
+  // The file is read at once and parsed in memory, which is much faster than going through iostreams.
+  std::string content;
+  if (!text_parsing::read_file(filename, content)) {
     return result;
   }
-
-  std::string line;
+  const char* position = content.c_str();
+  const char* end = position + content.size();
 
   // the first line is empty, so we ignore it:
-  std::getline(in, line);
-  std::vector<Filtration_value> values_in_this_line;
-  result.push_back(values_in_this_line);
-
-  int number_of_line = 0;
+  position = text_parsing::line_end(position, end);
+  result.emplace_back();
 
-  // first, read the file line by line to a string:
-  while (std::getline(in, line)) {
+  std::size_t number_of_line = 0;
+  while (position != end) {
+    const char* line = position + 1;
+    position = text_parsing::line_end(line, end);
     // if line is empty, break
-    if (line.size() == 0) break;
-
-    // if the last element of a string is comma:
-    if (line[line.size() - 1] == separator) {
-      // then shrink the string by one
-      line.pop_back();
-    }
-
-    // replace all commas with spaces
-    std::replace(line.begin(), line.end(), separator, ' ');
+    if (text_parsing::skip_blanks(line, position) == position) break;
 
-    // put the new line to a stream
-    std::istringstream iss(line);
-    // and now read the doubles.
-
-    int number_of_entry = 0;
+    // Only the entries below the diagonal are kept
     std::vector<Filtration_value> values_in_this_line;
-    while (iss.good()) {
-      double entry;
-      iss >> entry;
-      if (number_of_entry <= number_of_line) {
-        values_in_this_line.push_back(entry);
-      }
-      ++number_of_entry;
-    }
-    if (!values_in_this_line.empty()) result.push_back(values_in_this_line);
+    values_in_this_line.reserve(number_of_line + 1);
+    text_parsing::for_each_number<double>(line, position, separator, [&](double entry) {
+      if (values_in_this_line.size() <= number_of_line) values_in_this_line.push_back(entry);
+    });
+    if (!values_in_this_line.empty()) result.push_back(std::move(values_in_this_line));
     ++number_of_line;
   }
-  in.close();
 
 #ifdef DEBUG_TRACES
   std::clog << "Here is the matrix we read : \n";
@@ -287,6 +270,8 @@ std::vector<std::vector<Filtration_value>> read_lower_triangular_matrix_from_csv
 /**
 Reads a file containing persistence intervals.
 Each line might contain 2, 3 or 4 values: [[field] dimension] birth death
+The file may also be in the binary format described in \ref FileFormatsPersBinary, which is detected from its first
+bytes.
 The output iterator `out` is used this way: `*out++ = std::make_tuple(dim, birth, death);`
 where `dim` is an `int`, `birth` a `double`, and `death` a `double`.
 Note: the function does not check that birth <= death.
@@ -296,7 +281,7 @@ void read_persistence_intervals_and_dimension(std::string const& filename, Outpu
 #ifdef DEBUG_TRACES
   std::clog << "read_persistence_intervals_and_dimension - " << filename << std::endl;
 #endif  // DEBUG_TRACES
-  std::ifstream in(filename);
+  std::ifstream in(filename, std::ios::binary);
   if (!in.is_open()) {
     std::string error_str("read_persistence_intervals_and_dimension - Unable to open file ");
     error_str.append(filename);
@@ -304,6 +289,13 @@ void read_persistence_intervals_and_dimension(std::string const& filename, Outpu
     throw std::invalid_argument(error_str);
   }
 
+  if (persistence_diagram_binary::has_magic(in)) {
+    persistence_diagram_binary::read(in, [&out](int dim, double birth, double death) {
+      *out++ = std::make_tuple(dim, birth, death);
+    });
+    return;
+  }
+
   while (!in.eof()) {
     std::string line;
     getline(in, line);
@@ -328,6 +320,7 @@ void read_persistence_intervals_and_dimension(std::string const& filename, Outpu
 /**
 Reads a file containing persistence intervals.
 Each line might contain 2, 3 or 4 values: [[field] dimension] birth death
+The file may also be binary, as in `read_persistence_intervals_and_dimension()`.
 The return value is an `std::map<dim, std::vector<std::pair<birth, death>>>`
 where `dim` is an `int`, `birth` a `double`, and `death` a `double`.
 Note: the function does not check that birth <= death.
@@ -345,6 +338,7 @@ inline std::map<int, std::vector<std::pair<double, double>>> read_persistence_in
 /**
 Reads a file containing persistence intervals.
 Each line might contain 2, 3 or 4 values: [[field] dimension] birth death
+The file may also be binary, as in `read_persistence_intervals_and_dimension()`.
 If `only_this_dim` = -1, dimension is ignored and all lines are returned.
 If `only_this_dim` is >= 0, only the lines where dimension = `only_this_dim`
 (or where dimension is not specified) are returned.
@@ -0,0 +1,102 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef TEXT_PARSING_H_
+#define TEXT_PARSING_H_
+
+#include <algorithm>  // for std::find
+#include <charconv>  // for std::from_chars
+#include <cstdlib>  // for std::strtod
+#include <fstream>
+#include <iterator>  // for std::istreambuf_iterator
+#include <string>
+#include <system_error>  // for std::errc
+#include <type_traits>  // for std::is_integral_v, std::is_floating_point_v
+
+namespace Gudhi {
+
+namespace text_parsing {
+
+/* Helpers to parse text files read at once in memory, which is much faster than reading them value by value through
+ * iostreams. The numbers are parsed with std::from_chars, or with strtod when the standard library does not support
+ * it for floating point. The content must be null terminated, as a std::string, for strtod. */
+
+/* Reads the remaining content of in. */
+inline std::string read_all(std::istream& in) {
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/* Reads the whole file in content, returns false if it cannot be opened. */
+inline bool read_file(const std::string& file_name, std::string& content) {
+  std::ifstream in(file_name, std::ios::binary);
+  if (!in.is_open()) return false;
+  content = read_all(in);
+  return true;
+}
+
+inline bool is_blank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline bool is_space(char c) { return is_blank(c) || c == '\n' || c == '\v' || c == '\f'; }
+
+/* Skips the blanks, and the separator characters if separator is not a blank, without going to the next line. */
+inline const char* skip_blanks(const char* p, const char* end, char separator = ' ') {
+  while (p != end && (is_blank(*p) || *p == separator)) ++p;
+  return p;
+}
+
+/* End of the line starting at p, i.e. the position of its '\n' or end. */
+inline const char* line_end(const char* p, const char* end) { return std::find(p, end, '\n'); }
+
+/* Parses a number starting exactly at p and ending before end, and returns the position after it, or p if there is
+ * no number. A leading '+' is accepted. */
+template <typename T>
+const char* parse_number(const char* p, const char* end, T& value) {
+  const char* q = (p != end && *p == '+') ? p + 1 : p;
+  if constexpr (std::is_integral_v<T>) {
+    auto [number_end, error] = std::from_chars(q, end, value);
+    return error == std::errc() ? number_end : p;
+  } else {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    if constexpr (std::is_floating_point_v<T>) {
+      auto [number_end, error] = std::from_chars(q, end, value);
+      return error == std::errc() ? number_end : p;
+    }
+#endif
+    // strtod skips spaces and newlines, the number must start at q and not be looked for on the next line
+    if (q == end || is_space(*q)) return p;
+    char* number_end;
+    double x = std::strtod(q, &number_end);
+    if (number_end == q || number_end > end) return p;
+    value = static_cast<T>(x);
+    return number_end;
+  }
+}
+
+/* Parses the numbers of [p, end) separated by blanks or separator, and calls f(value) for each one, until the end or
+ * something that is not a number. Returns the number of values. */
+template <typename T, typename F>
+std::size_t for_each_number(const char* p, const char* end, char separator, F&& f) {
+  std::size_t count = 0;
+  T value;
+  for (p = skip_blanks(p, end, separator); p != end; p = skip_blanks(p, end, separator)) {
+    const char* next = parse_number(p, end, value);
+    if (next == p) break;
+    f(value);
+    ++count;
+    p = next;
+  }
+  return count;
+}
+
+}  // namespace text_parsing
+
+}  // namespace Gudhi
+
+#endif  // TEXT_PARSING_H_
@@ -11,9 +11,15 @@
 #ifndef WRITING_PERSISTENCE_TO_FILE_H_
 #define WRITING_PERSISTENCE_TO_FILE_H_
 
+#include <gudhi/persistence_diagram_binary_format.h>
+
 #include <iostream>
 #include <string>
 #include <limits>
+#include <map>
+#include <vector>
+#include <tuple>  // for std::get
+#include <cstddef>  // for std::size_t
 
 namespace Gudhi {
 
@@ -100,6 +106,70 @@ void write_persistence_intervals_to_stream(const Persistence_interval_range& int
   }
 }
 
+/**
+ * \brief Writes persistence intervals to a stream in the binary format described in \ref FileFormatsPersBinary.
+ *
+ * The intervals are buffered by dimension, and a block is written as soon as `block_size` intervals of the same
+ * dimension are buffered, so that a diagram can be streamed with a bounded memory, whatever the order of the
+ * dimensions. The remaining intervals are written by `flush()` or by the destructor.
+ *
+ * \tparam Value `float` or `double`, the type in which the births and deaths are stored.
+**/
+template <typename Value = double>
+class Persistence_diagram_binary_writer {
+  static_assert(sizeof(Value) == 4 || sizeof(Value) == 8, "Persistence_diagram_binary_writer - float or double only");
+
+ public:
+  /** \brief Writes the header of the diagram in `out`, which must be opened in binary mode and outlive the writer. */
+  explicit Persistence_diagram_binary_writer(std::ostream& out, std::size_t block_size = 1 << 16)
+      : out_(out), block_size_(block_size > 0 ? block_size : 1) {
+    persistence_diagram_binary::write_header(out_, sizeof(Value));
+  }
+
+  Persistence_diagram_binary_writer(const Persistence_diagram_binary_writer&) = delete;
+  Persistence_diagram_binary_writer& operator=(const Persistence_diagram_binary_writer&) = delete;
+
+  ~Persistence_diagram_binary_writer() { flush(); }
+
+  /** \brief Adds the interval [`birth`, `death`) of dimension `dim`. */
+  template <typename Filtration_type>
+  void write(int dim, Filtration_type birth, Filtration_type death) {
+    std::vector<Value>& buffer = buffers_[dim];
+    buffer.push_back(static_cast<Value>(birth));
+    buffer.push_back(static_cast<Value>(death));
+    if (buffer.size() >= 2 * block_size_) {
+      persistence_diagram_binary::write_block(out_, dim, buffer);
+      buffer.clear();
+    }
+  }
+
+  /** \brief Writes all the buffered intervals, one block per dimension. */
+  void flush() {
+    for (auto& [dim, buffer] : buffers_) {
+      if (buffer.empty()) continue;
+      persistence_diagram_binary::write_block(out_, dim, buffer);
+      buffer.clear();
+    }
+    out_.flush();
+  }
+
+ private:
+  std::ostream& out_;
+  std::size_t block_size_;
+  std::map<int, std::vector<Value>> buffers_;
+};
+
+/**
+ * This function writes a range of persistence intervals, given as tuples (dimension, birth, death) such as
+ * `Gudhi::rips_complex::Rips_persistence::Persistent_interval`, to a stream in the binary format described in
+ * \ref FileFormatsPersBinary, with one block per dimension.
+**/
+template <typename Value = double, typename Persistence_interval_range>
+void write_persistence_intervals_to_binary_stream(const Persistence_interval_range& intervals, std::ostream& out) {
+  Persistence_diagram_binary_writer<Value> writer(out, std::numeric_limits<std::size_t>::max() / 2);
+  for (const auto& interval : intervals) writer.write(std::get<0>(interval), std::get<1>(interval), std::get<2>(interval));
+}
+
 }  // namespace Gudhi
 
 #endif  // WRITING_PERSISTENCE_TO_FILE_H_
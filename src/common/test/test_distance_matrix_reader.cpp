@@ -9,8 +9,11 @@
  */
 
 #include <gudhi/reader_utils.h>
+#include <gudhi/flat_file_readers.h>
 
+#include <fstream>
 #include <iostream>
+#include <stdexcept>  // for std::invalid_argument
 #include <string>
 #include <vector>
 
@@ -71,3 +74,31 @@ BOOST_AUTO_TEST_CASE( full_square_distance_matrix )
     BOOST_CHECK(from_full_square[i].size() == i);
   }  
 }
+
+BOOST_AUTO_TEST_CASE( flat_distance_matrix )
+{
+  for (bool parallel : {false, true}) {
+    auto lower = Gudhi::read_flat_lower_triangular_matrix_from_csv_file<double>("lower_triangular_distance_matrix.csv",
+                                                                              ',', parallel);
+    BOOST_CHECK(lower.size() == 5);
+    std::vector<double> expected = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    BOOST_CHECK(lower.data() == expected);
+    BOOST_CHECK(lower[3][1] == 5);
+
+    // Same entries as read_lower_triangular_matrix_from_csv_file
+    auto square = Gudhi::read_flat_lower_triangular_matrix_from_csv_file<double>("full_square_distance_matrix.csv",
+                                                                               ';', parallel);
+    Distance_matrix from_full_square =
+        Gudhi::read_lower_triangular_matrix_from_csv_file<double>("full_square_distance_matrix.csv", ';');
+    BOOST_CHECK(square.size() == from_full_square.size());
+    for (std::size_t i = 0; i < square.size(); i++)
+      BOOST_CHECK(std::vector<double>(square[i], square[i] + i) == from_full_square[i]);
+  }
+
+  {
+    std::ofstream out("flat_distance_matrix_too_short.csv");
+    out << "\n1\n2\n";
+  }
+  BOOST_CHECK_THROW(Gudhi::read_flat_lower_triangular_matrix_from_csv_file<double>(
+                        "flat_distance_matrix_too_short.csv", ','), std::invalid_argument);
+}
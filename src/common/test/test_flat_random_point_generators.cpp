@@ -0,0 +1,71 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <gudhi/flat_random_point_generators.h>
+
+#include <algorithm>  // for std::equal
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "flat_random_point_generators"
+#include <boost/test/unit_test.hpp>
+
+const std::size_t num_points = 20000;
+
+BOOST_AUTO_TEST_CASE( reproducible_in_parallel )
+{
+  for (int dim : {2, 3, 5}) {
+    std::vector<double> parallel(num_points * dim), sequential(num_points * dim), other_seed(num_points * dim);
+    Gudhi::generate_flat_points_on_sphere_d(num_points, dim, 1., 7, parallel.data(), true);
+    Gudhi::generate_flat_points_on_sphere_d(num_points, dim, 1., 7, sequential.data(), false);
+    Gudhi::generate_flat_points_on_sphere_d(num_points, dim, 1., 8, other_seed.data());
+    BOOST_CHECK(parallel == sequential);
+    BOOST_CHECK(parallel != other_seed);
+    // A prefix of a larger sample is the smaller sample
+    std::vector<double> prefix(num_points / 2 * dim);
+    Gudhi::generate_flat_points_on_sphere_d(num_points / 2, dim, 1., 7, prefix.data());
+    BOOST_CHECK(std::equal(prefix.begin(), prefix.end(), parallel.begin()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( points_on_the_shapes )
+{
+  const int dim = 3;
+  std::vector<double> sphere(num_points * dim), ball(num_points * dim), cube(num_points * dim);
+  std::vector<float> torus(num_points * 2 * dim);
+  Gudhi::generate_flat_points_on_sphere_d(num_points, dim, 2., 1, sphere.data());
+  Gudhi::generate_flat_points_in_ball_d(num_points, dim, 2., 1, ball.data());
+  Gudhi::generate_flat_points_in_cube_d(num_points, dim, 2., 1, cube.data());
+  Gudhi::generate_flat_points_on_torus_d(num_points, dim, 1, torus.data());
+  auto norm = [](const auto* point, int d) {
+    double squared_norm = 0.;
+    for (int j = 0; j < d; ++j) squared_norm += point[j] * point[j];
+    return std::sqrt(squared_norm);
+  };
+  std::size_t inside_half_ball = 0;
+  double mean = 0.;
+  for (std::size_t i = 0; i < num_points; ++i) {
+    BOOST_CHECK_CLOSE(norm(&sphere[i * dim], dim), 2., 1e-10);
+    const double distance = norm(&ball[i * dim], dim);
+    BOOST_CHECK(distance <= 2.);
+    if (distance <= 1.) ++inside_half_ball;
+    for (int j = 0; j < dim; ++j) {
+      BOOST_CHECK(cube[i * dim + j] >= -2. && cube[i * dim + j] < 2.);
+      BOOST_CHECK_CLOSE(norm(&torus[i * 2 * dim + 2 * j], 2), 1., 1e-4);
+    }
+    mean += sphere[i * dim];
+  }
+  // Uniform in the ball: a proportion 1/2^3 of the points is in the ball of half radius
+  BOOST_CHECK(std::abs(static_cast<double>(inside_half_ball) / num_points - 0.125) < 0.01);
+  // Symmetric on the sphere
+  BOOST_CHECK(std::abs(mean / num_points) < 0.05);
+}
@@ -9,6 +9,7 @@
  */
 
 #include <gudhi/reader_utils.h>
+#include <gudhi/writing_persistence_to_file.h>
 
 #include <iostream>
 #include <vector>
@@ -16,6 +17,10 @@
 #include <tuple>
 #include <limits>  // for inf
 #include <map>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdexcept>  // for std::invalid_argument
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "persistence_intervals_reader"
@@ -308,3 +313,35 @@ BOOST_AUTO_TEST_CASE( persistence_intervals_with_field )
   BOOST_CHECK(persistence_intervals_in_dimension == expected_intervals_in_dimension);
 
 }
+
+BOOST_AUTO_TEST_CASE( persistence_intervals_binary )
+{
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<std::tuple<int, double, double>> intervals = {{0, 0., inf}, {1, 9.5, 14.}, {0, 2.5, 3.75},
+                                                            {3, 34.25, 35.}, {1, 3., inf}, {0, 0., 1.}};
+  Persistence_intervals_by_dimension expected_intervals_by_dimension;
+  for (auto [dim, birth, death] : intervals) expected_intervals_by_dimension[dim].emplace_back(birth, death);
+
+  // Blocks of 2 intervals, so that dimension 0 is in 2 blocks
+  {
+    std::ofstream out("persistence_intervals_binary_float.pers", std::ios::binary);
+    Gudhi::Persistence_diagram_binary_writer<float> writer(out, 2);
+    for (auto [dim, birth, death] : intervals) writer.write(dim, birth, death);
+  }
+  {
+    std::ofstream out("persistence_intervals_binary_double.pers", std::ios::binary);
+    Gudhi::write_persistence_intervals_to_binary_stream(intervals, out);
+  }
+  for (std::string file : {"persistence_intervals_binary_float.pers", "persistence_intervals_binary_double.pers"}) {
+    // The values are exact in float
+    BOOST_CHECK(Gudhi::read_persistence_intervals_grouped_by_dimension(file) == expected_intervals_by_dimension);
+    BOOST_CHECK(Gudhi::read_persistence_intervals_in_dimension(file, 1) == expected_intervals_by_dimension[1]);
+  }
+
+  // Truncated file
+  std::ifstream in("persistence_intervals_binary_double.pers", std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  std::ofstream("persistence_intervals_binary_truncated.pers", std::ios::binary) << content.substr(0, content.size() - 8);
+  BOOST_CHECK_THROW(Gudhi::read_persistence_intervals_grouped_by_dimension("persistence_intervals_binary_truncated.pers"),
+                    std::invalid_argument);
+}
@@ -9,8 +9,11 @@
  */
 
 #include <gudhi/Points_off_io.h>
+#include <gudhi/flat_file_readers.h>
 
+#include <fstream>
 #include <iostream>
+#include <stdexcept>  // for std::invalid_argument
 #include <string>
 #include <vector>
 
@@ -59,3 +62,43 @@ BOOST_AUTO_TEST_CASE( Delaunay_triangulation_unexisting_file_read_test )
   std::vector<Point_d> point_cloud = off_reader.get_point_cloud();
   BOOST_CHECK(point_cloud.size() == 0);
 }
+
+BOOST_AUTO_TEST_CASE( flat_points_doc_test )
+{
+  for (bool parallel : {false, true}) {
+    Gudhi::Flat_point_cloud<double> point_cloud = Gudhi::read_flat_points_from_off_file("alphacomplexdoc.off", parallel);
+    BOOST_CHECK(point_cloud.size() == 7);
+    BOOST_CHECK(point_cloud.dimension() == 3);
+    std::vector<double> expected = {1., 1., 0., 7., 0., 0., 4., 6., 0., 9., 6., 0., 0., 14., 0., 2., 19., 0., 9., 17., 0.};
+    BOOST_CHECK(point_cloud.data() == expected);
+    // Same points as the Points_off_reader
+    Gudhi::Points_off_reader<Point_d> off_reader("alphacomplexdoc.off");
+    std::vector<Point_d> points = off_reader.get_point_cloud();
+    std::size_t i = 0;
+    for (const auto& point : point_cloud) {
+      BOOST_CHECK(Point_d(point.begin(), point.end()) == points[i++]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( flat_points_noff_test )
+{
+  {
+    std::ofstream out("flat_points_noff.off");
+    out << "nOFF\n4 3 0 0\n# comment\n\n+1.5 2 3e1 4\n-1 .5 0 1e-1 # color\n  7\t8 9 10\r\n";
+  }
+  Gudhi::Flat_point_cloud<float> point_cloud = Gudhi::read_flat_points_from_off_file<float>("flat_points_noff.off");
+  BOOST_CHECK(point_cloud.size() == 3);
+  BOOST_CHECK(point_cloud.dimension() == 4);
+  std::vector<float> expected = {1.5f, 2.f, 30.f, 4.f, -1.f, .5f, 0.f, .1f, 7.f, 8.f, 9.f, 10.f};
+  BOOST_CHECK(point_cloud.data() == expected);
+  BOOST_CHECK(point_cloud[1][3] == .1f);
+
+  {
+    std::ofstream out("flat_points_too_short.off");
+    out << "OFF\n2 0 0\n1 2 3\n4 5\n";
+  }
+  BOOST_CHECK_THROW(Gudhi::read_flat_points_from_off_file("flat_points_too_short.off"), std::invalid_argument);
+  BOOST_CHECK_THROW(Gudhi::read_flat_points_from_off_file("some_impossible_weird_file_name.off"),
+                    std::invalid_argument);
+}
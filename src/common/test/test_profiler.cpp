@@ -0,0 +1,129 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+// The instrumentation points are tested whatever the cmake option WITH_GUDHI_PROFILING
+#ifndef GUDHI_USE_PROFILING
+#define GUDHI_USE_PROFILING
+#endif
+#include <gudhi/Profiler.h>
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "profiler"
+#include <boost/test/unit_test.hpp>
+
+void inner() {
+  GUDHI_PROFILE_SCOPE("inner");
+  GUDHI_PROFILE_COUNT("events", 2);
+}
+
+void outer() {
+  GUDHI_PROFILE_SCOPE("outer");
+  inner();
+  inner();
+}
+
+BOOST_AUTO_TEST_CASE( nested_timers_and_counters )
+{
+  Gudhi::profiling::reset();
+  outer();
+  inner();
+  auto report = Gudhi::profiling::report();
+  BOOST_CHECK(Gudhi::profiling::enabled());
+  BOOST_CHECK_EQUAL(report.timers.size(), 3u);
+  BOOST_CHECK_EQUAL(report.timers["outer"].calls, 1u);
+  BOOST_CHECK_EQUAL(report.timers["outer/inner"].calls, 2u);
+  BOOST_CHECK_EQUAL(report.timers["inner"].calls, 1u);
+  BOOST_CHECK(report.timers["outer"].seconds >= report.timers["outer/inner"].seconds);
+  BOOST_CHECK_EQUAL(report.counters["events"], 6u);
+
+  Gudhi::profiling::reset();
+  report = Gudhi::profiling::report();
+  BOOST_CHECK(report.timers.empty());
+  BOOST_CHECK(report.counters.empty());
+}
+
+BOOST_AUTO_TEST_CASE( aggregation_over_threads )
+{
+  Gudhi::profiling::reset();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) threads.emplace_back([] { for (int j = 0; j < 100; j++) outer(); });
+  for (auto& thread : threads) thread.join();
+  auto report = Gudhi::profiling::report();
+  BOOST_CHECK_EQUAL(report.timers["outer"].calls, 400u);
+  BOOST_CHECK_EQUAL(report.timers["outer/inner"].calls, 800u);
+  BOOST_CHECK_EQUAL(report.counters["events"], 1600u);
+}
+
+BOOST_AUTO_TEST_CASE( finished_threads_are_merged )
+{
+  Gudhi::profiling::reset();
+  outer();
+  auto& registry = Gudhi::profiling::internal::Registry::instance();
+  const std::size_t running = registry.number_of_running_threads();
+  Gudhi::profiling::start_tracing();
+  for (int i = 0; i < 20; i++) std::thread(outer).join();
+  Gudhi::profiling::stop_tracing();
+  BOOST_CHECK_EQUAL(registry.number_of_running_threads(), running);
+
+  auto report = Gudhi::profiling::report();
+  BOOST_CHECK_EQUAL(report.timers["outer"].calls, 21u);
+  BOOST_CHECK_EQUAL(report.counters["events"], 84u);
+  BOOST_CHECK_EQUAL(Gudhi::profiling::trace_events().size(), 120u);
+  Gudhi::profiling::start_tracing();
+  Gudhi::profiling::stop_tracing();
+}
+
+BOOST_AUTO_TEST_CASE( chrome_trace )
+{
+  outer();
+  BOOST_CHECK(!Gudhi::profiling::is_tracing());
+  BOOST_CHECK(Gudhi::profiling::trace_events().empty());
+
+  Gudhi::profiling::start_tracing();
+  outer();
+  Gudhi::profiling::begin_event("user \"phase\"");
+  inner();
+  Gudhi::profiling::end_event("user \"phase\"");
+  Gudhi::profiling::stop_tracing();
+  outer();
+
+  auto events = Gudhi::profiling::trace_events();
+  BOOST_CHECK_EQUAL(events.size(), 10u);
+  std::vector<std::string> names;
+  std::string phases;
+  for (const auto& event : events) {
+    names.push_back(event.name);
+    phases += event.phase;
+    BOOST_CHECK_EQUAL(event.thread, events.front().thread);
+  }
+  BOOST_CHECK_EQUAL(phases, "BBEBEEBBEE");
+  BOOST_CHECK_EQUAL(names.front(), "outer");
+  BOOST_CHECK_EQUAL(names[1], "inner");
+  BOOST_CHECK_EQUAL(names[6], "user \"phase\"");
+  for (std::size_t i = 1; i < events.size(); i++) BOOST_CHECK(events[i - 1].timestamp <= events[i].timestamp);
+
+  std::ostringstream out;
+  Gudhi::profiling::write_chrome_trace(out, events);
+  const std::string json = out.str();
+  BOOST_CHECK(json.find("{\"traceEvents\": [") == 0);
+  BOOST_CHECK(json.find("{\"name\": \"outer\", \"ph\": \"B\", \"ts\": ") != std::string::npos);
+  BOOST_CHECK(json.find("\"name\": \"user \\\"phase\\\"\", \"ph\": \"E\"") != std::string::npos);
+
+  // A new trace forgets the previous one
+  Gudhi::profiling::start_tracing();
+  Gudhi::profiling::stop_tracing();
+  BOOST_CHECK(Gudhi::profiling::trace_events().empty());
+}
@@ -0,0 +1,159 @@
+#!/usr/bin/env python
+
+""" This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+    Author(s):       David Loiseaux
+
+    Copyright (C) 2023 Inria
+
+    Modification(s):
+      - YYYY/MM Author: Description of the modification
+"""
+
+__author__ = "David Loiseaux"
+__copyright__ = "Copyright (C) 2023 Inria"
+__license__ = "MIT"
+
+import argparse
+import json
+import sys
+import time
+
+import numpy as np
+
+# Benchmark of the distances between persistence diagrams: the bottleneck distance of gudhi (exact and approximate),
+# the bottleneck and Wasserstein distances of hera, and the Wasserstein distance computed with POT. The diagrams
+# look like the ones of noisy data: many points near the diagonal and a few long bars. Each method is only run up to
+# the size where it stays tractable, e.g. POT builds a dense cost matrix.
+#
+# The timings are written as JSON, and can be compared to the ones of a previous run, e.g.
+#   python diagram_distances_benchmark.py --output new.json --baseline old.json
+# which lists the methods that got slower than the tolerance, and then exits with a non-zero status.
+
+
+def random_diagram(n, rng, long_bars=0.02, noise_scale=0.01):
+    """Diagram of n points, a fraction long_bars of which are far from the diagonal, the others being near it with
+    exponentially distributed persistence."""
+    num_long = max(1, int(long_bars * n))
+    births = rng.uniform(0.0, 1.0, n)
+    persistence = rng.exponential(noise_scale, n)
+    persistence[:num_long] = rng.uniform(0.2, 1.0, num_long)
+    return np.column_stack((births, births + persistence))
+
+
+def perturbed_diagram(diagram, rng, sigma=0.005, resampled=0.1, noise_scale=0.01):
+    """Close diagram: the points of diagram moved by a Gaussian noise, a fraction resampled of them being replaced
+    by new points near the diagonal."""
+    out = diagram + rng.normal(0.0, sigma, diagram.shape)
+    out[:, 1] = np.maximum(out[:, 1], out[:, 0] + 1e-6)
+    num_resampled = int(resampled * len(out))
+    replaced = rng.choice(np.arange(len(out)), num_resampled, replace=False)
+    births = rng.uniform(0.0, 1.0, num_resampled)
+    out[replaced] = np.column_stack((births, births + rng.exponential(noise_scale, num_resampled)))
+    return out
+
+
+def methods():
+    """(name, function, maximal size) of the available methods."""
+    out = []
+    try:
+        from gudhi import bottleneck_distance
+
+        out.append(("gudhi.bottleneck_distance exact", lambda X, Y: bottleneck_distance(X, Y, 0.0), 10**5))
+        out.append(("gudhi.bottleneck_distance e=0.01", lambda X, Y: bottleneck_distance(X, Y, 0.01), 10**6))
+    except ImportError:
+        print("gudhi.bottleneck_distance is not available (it requires CGAL)", file=sys.stderr)
+    try:
+        from gudhi import hera
+
+        out.append(("gudhi.hera.bottleneck_distance exact", lambda X, Y: hera.bottleneck_distance(X, Y, 0.0), 10**5))
+        out.append(
+            ("gudhi.hera.bottleneck_distance delta=0.01", lambda X, Y: hera.bottleneck_distance(X, Y, 0.01), 10**6)
+        )
+        out.append(
+            (
+                "gudhi.hera.wasserstein_distance delta=0.01",
+                lambda X, Y: hera.wasserstein_distance(X, Y, order=1, internal_p=np.inf, delta=0.01),
+                10**5,
+            )
+        )
+    except ImportError:
+        print("gudhi.hera is not available", file=sys.stderr)
+    try:
+        import ot  # noqa: F401
+        from gudhi.wasserstein import wasserstein_distance
+
+        out.append(
+            (
+                "gudhi.wasserstein.wasserstein_distance pot",
+                lambda X, Y: wasserstein_distance(X, Y, order=1, internal_p=np.inf),
+                5000,
+            )
+        )
+    except ImportError:
+        print("POT is not available", file=sys.stderr)
+    return out
+
+
+def run(sizes, repeat, seed):
+    results = []
+    rng = np.random.default_rng(seed)
+    available = methods()
+    for n in sizes:
+        X = random_diagram(n, rng)
+        Y = perturbed_diagram(X, rng)
+        for name, distance, max_size in available:
+            if n > max_size:
+                continue
+            seconds = []
+            for _ in range(repeat):
+                start = time.perf_counter()
+                value = distance(X, Y)
+                seconds.append(time.perf_counter() - start)
+            result = {"method": name, "size": n, "seconds": min(seconds), "distance": float(value)}
+            print(f"{name:45} n={n:8} {result['seconds']:10.4f} s  distance={value:.6g}", file=sys.stderr)
+            results.append(result)
+    return results
+
+
+def regressions(results, baseline, tolerance):
+    """Results slower than tolerance times the one of the same method and size in baseline."""
+    reference = {(r["method"], r["size"]): r["seconds"] for r in baseline}
+    slower = []
+    for r in results:
+        old = reference.get((r["method"], r["size"]))
+        if old is not None and old > 0 and r["seconds"] > tolerance * old:
+            slower.append((r["method"], r["size"], old, r["seconds"]))
+    return slower
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark of the distances between persistence diagrams.")
+    parser.add_argument(
+        "--sizes", type=int, nargs="+", default=[10**2, 10**3, 10**4, 10**5, 10**6], help="numbers of points"
+    )
+    parser.add_argument("--repeat", type=int, default=3, help="number of runs of each method, the best is kept")
+    parser.add_argument("--seed", type=int, default=0, help="seed of the random diagrams")
+    parser.add_argument("--output", help="JSON file of the results, the standard output by default")
+    parser.add_argument("--baseline", help="JSON file of previous results, to compare with")
+    parser.add_argument("--tolerance", type=float, default=1.2, help="slowdown reported as a regression")
+    args = parser.parse_args()
+
+    results = run(args.sizes, args.repeat, args.seed)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2)
+    else:
+        json.dump(results, sys.stdout, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            slower = regressions(results, json.load(f), args.tolerance)
+        for method, size, old, new in slower:
+            print(f"Regression: {method} n={size} {old:.4f} s -> {new:.4f} s", file=sys.stderr)
+        if slower:
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
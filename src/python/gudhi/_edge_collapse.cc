@@ -11,12 +11,15 @@
 #include <vector>
 #include <utility>
 #include <stdexcept>
+#include <string>
+#include <tuple>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
 #include <gudhi/Flag_complex_edge_collapser.h>
+#include <gudhi/Profiler.h>
 
 namespace py = pybind11;
 
@@ -61,7 +64,18 @@ py::object collapse(py::array_t<Index> is, py::array_t<Index> js, py::array_t<Fi
   return py::make_tuple(std::move(indices), std::move(filtrs));
 }
 
+// Events of the trace recorded by this module, cf. gudhi.tracing
+std::vector<std::tuple<std::string, std::string, double, std::size_t>> trace_events() {
+  std::vector<std::tuple<std::string, std::string, double, std::size_t>> out;
+  for (const auto& event : Gudhi::profiling::trace_events())
+    out.emplace_back(event.name, std::string(1, event.phase), event.timestamp, event.thread);
+  return out;
+}
+
 PYBIND11_MODULE(_edge_collapse, m) {
   m.def("_collapse_edges", collapse<int, float>, py::arg("i").noconvert(), py::arg("j").noconvert(), py::arg("f").noconvert(), py::arg("nb_iterations")=1);
   m.def("_collapse_edges", collapse<py::ssize_t, double>, py::arg("i"), py::arg("j"), py::arg("f"), py::arg("nb_iterations")=1);
+  m.def("_start_tracing", &Gudhi::profiling::start_tracing);
+  m.def("_stop_tracing", &Gudhi::profiling::stop_tracing);
+  m.def("_trace_events", &trace_events);
 }
@@ -10,8 +10,12 @@
 
 #include <vector>
 #include <array>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <stdexcept>
+#include <optional>
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -20,11 +24,15 @@
 
 #include <boost/range/counting_range.hpp>
 #include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include <gudhi/Persistence_on_a_line.h>
 #include <gudhi/Persistence_on_rectangle.h>
+#include <gudhi/Persistence_on_cuboid.h>
 #include <gudhi/Debug_utils.h>
 
+#include <Thread_pool.h>
+
 namespace py = pybind11;
 typedef std::vector<std::array< float, 2>> Vf;
 typedef std::vector<std::array<double, 2>> Vd;
@@ -49,7 +57,69 @@ py::array wrap_persistence_1d(py::array_t<T> data) {
   return py::array(py::cast(std::move(dgm)));
 }
 
-py::list wrap_persistence_2d(py::array_t<double, py::array::c_style | py::array::forcecast> data, double min_persistence) {
+// Diagrams of a batch of signals, the rows of a 2-dimensional array, or the consecutive slices [offsets[i],
+// offsets[i+1]) of a 1-dimensional array. The pairs of all the signals are packed in one array, the ones of signal i
+// being [row_offsets[i], row_offsets[i+1]), to avoid creating one Python object per signal. The rows are processed by
+// n_jobs threads of the shared pool (all if 0), in chunks of consecutive rows, whose pairs are concatenated at the end.
+template<class T>
+py::tuple wrap_persistence_1d_batch(py::array_t<T, py::array::c_style | py::array::forcecast> data,
+                                    std::optional<py::array_t<std::int64_t, py::array::c_style | py::array::forcecast>> offsets,
+                                    double min_persistence, int n_jobs) {
+  py::buffer_info buf = data.request();
+  std::vector<std::int64_t> starts;
+  if (offsets) {
+    if (buf.ndim != 1)
+      throw std::runtime_error("Data must be a 1-dimensional array when offsets are given");
+    py::buffer_info obuf = offsets->request();
+    std::int64_t const* o = static_cast<std::int64_t const*>(obuf.ptr);
+    if (obuf.ndim != 1 || obuf.shape[0] < 1 || o[0] != 0 || o[obuf.shape[0] - 1] != buf.shape[0])
+      throw std::runtime_error("Offsets must be a 1-dimensional array from 0 to the size of data");
+    if (!std::is_sorted(o, o + obuf.shape[0]))
+      throw std::runtime_error("Offsets must be non-decreasing");
+    starts.assign(o, o + obuf.shape[0]);
+  } else {
+    if (buf.ndim != 2)
+      throw std::runtime_error("Data must be a 2-dimensional array when offsets are not given");
+    starts.resize(buf.shape[0] + 1);
+    for (std::size_t i = 0; i < starts.size(); ++i) starts[i] = static_cast<std::int64_t>(i) * buf.shape[1];
+  }
+  std::size_t n_rows = starts.size() - 1;
+  T const* p = static_cast<T const*>(buf.ptr);
+  std::vector<std::int64_t> row_offsets(n_rows + 1, 0);
+  std::vector<std::vector<std::array<T, 2>>> chunk_pairs;
+  {
+    py::gil_scoped_release release;
+    // About 64k values per chunk, so that millions of short signals do not allocate one vector each
+    std::size_t rows_per_chunk = std::max<std::size_t>(1, (std::size_t(1) << 16) * n_rows / (starts.back() + 1));
+    std::size_t n_chunks = (n_rows + rows_per_chunk - 1) / rows_per_chunk;
+    chunk_pairs.resize(n_chunks);
+    Gudhi::thread_pool::parallel_for(n_chunks, n_jobs, [&](std::size_t c) {
+      auto& pairs = chunk_pairs[c];
+      for (std::size_t i = c * rows_per_chunk; i < std::min(n_rows, (c + 1) * rows_per_chunk); ++i) {
+        std::size_t before = pairs.size();
+        Gudhi::persistent_cohomology::compute_persistence_of_function_on_line(
+            boost::make_iterator_range(p + starts[i], p + starts[i + 1]),
+            [&](T b, T d){ if (d - b > min_persistence) pairs.push_back({b, d}); });
+        row_offsets[i + 1] = pairs.size() - before;
+      }
+    });
+    for (std::size_t i = 0; i < n_rows; ++i) row_offsets[i + 1] += row_offsets[i];
+  }
+  py::array_t<T> dgm({static_cast<py::ssize_t>(row_offsets.back()), py::ssize_t(2)});
+  T* out = static_cast<T*>(dgm.request().ptr);
+  for (auto const& pairs : chunk_pairs) {
+    for (auto const& pair : pairs) {
+      *out++ = pair[0];
+      *out++ = pair[1];
+    }
+  }
+  return py::make_tuple(dgm, py::array_t<std::int64_t>(row_offsets.size(), row_offsets.data()));
+}
+
+// The images of float32, common in training loops, are read directly instead of being converted to a copy in double.
+// Their values convert exactly to double, so that the pairs are the same as with the copy.
+template<class T>
+py::list wrap_persistence_2d(py::array_t<T, py::array::c_style | py::array::forcecast> data, double min_persistence) {
   py::buffer_info buf = data.request();
   if(buf.ndim!=2)
     throw std::runtime_error("Data must be a 2-dimensional array");
@@ -60,7 +130,7 @@ py::list wrap_persistence_2d(py::array_t<double, py::array::c_style | py::array:
   {
     py::gil_scoped_release release;
     double mini = Gudhi::cubical_complex::persistence_on_rectangle_from_top_cells(
-        static_cast<double const*>(buf.ptr),
+        static_cast<T const*>(buf.ptr),
         static_cast<unsigned>(buf.shape[0]),
         static_cast<unsigned>(buf.shape[1]),
         [&](double b, double d){ if (d - b > min_persistence) dgm0.push_back({b, d}); },
@@ -73,10 +143,102 @@ py::list wrap_persistence_2d(py::array_t<double, py::array::c_style | py::array:
   return ret;
 }
 
+// Diagrams in dimension 0 and 1 of a batch of images of shape (N, H, W), computed by n_jobs threads of the shared pool
+// (all if 0) that do not need the GIL. If memory_budget (in bytes) is not 0, fewer threads are used so their working
+// memory fits in the budget.
+template<class T>
+py::list wrap_persistence_2d_batch(py::array_t<T, py::array::c_style | py::array::forcecast> data,
+                                   double min_persistence, int n_jobs, std::size_t memory_budget) {
+  py::buffer_info buf = data.request();
+  if(buf.ndim!=3)
+    throw std::runtime_error("Data must be a 3-dimensional array");
+  if(buf.shape[1] < 2 || buf.shape[2] < 2)
+    throw std::runtime_error("The Python caller is supposed to ensure that shape[i]>=2 for i>0");
+  std::size_t n_images = buf.shape[0];
+  unsigned n_rows = static_cast<unsigned>(buf.shape[1]), n_cols = static_cast<unsigned>(buf.shape[2]);
+  std::size_t image_size = std::size_t(n_rows) * n_cols;
+  std::vector<Vd> dgms0(n_images), dgms1(n_images);
+  {
+    py::gil_scoped_release release;
+    std::size_t n_threads = n_jobs > 0 ? n_jobs : Gudhi::thread_pool::max_threads();
+    if (memory_budget != 0) {
+      // Persistence_on_rectangle needs about 2 indices, 1 filtration value and half an edge per square.
+      std::size_t per_image = image_size * (2 * sizeof(unsigned) + 2 * sizeof(T));
+      n_threads = std::min(n_threads, std::max<std::size_t>(1, memory_budget / per_image));
+    }
+    T const* p = static_cast<T const*>(buf.ptr);
+    Gudhi::thread_pool::parallel_for(n_images, static_cast<int>(n_threads), [&](std::size_t k) {
+      Vd& dgm0 = dgms0[k];
+      Vd& dgm1 = dgms1[k];
+      double mini = Gudhi::cubical_complex::persistence_on_rectangle_from_top_cells(
+          p + k * image_size, n_rows, n_cols,
+          [&](double b, double d){ if (d - b > min_persistence) dgm0.push_back({b, d}); },
+          [&](double b, double d){ if (d - b > min_persistence) dgm1.push_back({b, d}); });
+      dgm0.push_back({mini, std::numeric_limits<double>::infinity()});
+    });
+  }
+  py::list ret;
+  for (std::size_t k = 0; k < n_images; ++k) {
+    py::list diags;
+    diags.append(py::array(py::cast(std::move(dgms0[k]))));
+    diags.append(py::array(py::cast(std::move(dgms1[k]))));
+    ret.append(diags);
+  }
+  return ret;
+}
+
+typedef std::vector<std::pair<int, std::pair<double, double>>> Persistence;
+
+template<class Index>
+void persistence_3d(double const* data, Index n0, Index n1, Index n2, double min_persistence, Persistence& dgm) {
+  auto out = [&](int dim) {
+    return [&dgm, dim, min_persistence](double b, double d){ if (d - b > min_persistence) dgm.push_back({dim, {b, d}}); };
+  };
+  double mini = Gudhi::cubical_complex::persistence_on_cuboid_from_top_cells(data, n0, n1, n2, out(0), out(1), out(2));
+  dgm.push_back({0, {mini, std::numeric_limits<double>::infinity()}});
+}
+
+// Same output as CubicalComplex.persistence(), in the same order.
+Persistence wrap_persistence_3d(py::array_t<double, py::array::c_style | py::array::forcecast> data, double min_persistence) {
+  py::buffer_info buf = data.request();
+  if(buf.ndim!=3)
+    throw std::runtime_error("Data must be a 3-dimensional array");
+  if(buf.size == 0)
+    throw std::runtime_error("The Python caller is supposed to ensure that the array is not empty");
+  Persistence dgm;
+  {
+    py::gil_scoped_release release;
+    double const* p = static_cast<double const*>(buf.ptr);
+    std::size_t n0 = buf.shape[0], n1 = buf.shape[1], n2 = buf.shape[2];
+    // 32 bits indices are enough for a 512^3 image, and use less memory
+    if (3 * (n0 + 1) * (n1 + 1) * (n2 + 1) < std::numeric_limits<std::uint32_t>::max())
+      persistence_3d<std::uint32_t>(p, n0, n1, n2, min_persistence, dgm);
+    else
+      persistence_3d<std::size_t>(p, n0, n1, n2, min_persistence, dgm);
+    std::sort(dgm.begin(), dgm.end(), [](auto const& a, auto const& b) {
+      if (a.first != b.first) return a.first > b.first;
+      return a.second.second - a.second.first > b.second.second - b.second.first;
+    });
+  }
+  return dgm;
+}
+
 PYBIND11_MODULE(_pers_cub_low_dim, m) {
   py::bind_vector<Vf>(m, "VectorPairFloat" , py::buffer_protocol());
   py::bind_vector<Vd>(m, "VectorPairDouble", py::buffer_protocol());
   m.def("_persistence_on_a_line", wrap_persistence_1d<float>, py::arg().noconvert());
   m.def("_persistence_on_a_line", wrap_persistence_1d<double>);
-  m.def("_persistence_on_rectangle_from_top_cells", wrap_persistence_2d);
+  m.def("_persistence_on_lines", wrap_persistence_1d_batch<float>, py::arg("data").noconvert(),
+        py::arg("offsets") = py::none(), py::arg("min_persistence") = -1., py::arg("n_jobs") = 1);
+  m.def("_persistence_on_lines", wrap_persistence_1d_batch<double>, py::arg("data"),
+        py::arg("offsets") = py::none(), py::arg("min_persistence") = -1., py::arg("n_jobs") = 1);
+  m.def("_persistence_on_rectangle_from_top_cells", wrap_persistence_2d<float>, py::arg().noconvert(),
+        py::arg());
+  m.def("_persistence_on_rectangle_from_top_cells", wrap_persistence_2d<double>);
+  m.def("_persistence_on_rectangles_from_top_cells", wrap_persistence_2d_batch<float>,
+        py::arg("data").noconvert(), py::arg("min_persistence"), py::arg("n_jobs") = 1,
+        py::arg("memory_budget") = 0);
+  m.def("_persistence_on_rectangles_from_top_cells", wrap_persistence_2d_batch<double>,
+        py::arg("data"), py::arg("min_persistence"), py::arg("n_jobs") = 1, py::arg("memory_budget") = 0);
+  m.def("_persistence_on_cuboid_from_top_cells", wrap_persistence_3d);
 }
@@ -0,0 +1,29 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <pybind11/pybind11.h>
+
+#include <Thread_pool.h>
+
+namespace py = pybind11;
+
+// The limit of the pool is owned by this module, cf. gudhi/parallel.py
+PYBIND11_MODULE(_thread_pool, m) {
+  m.def("_set_max_threads", &Gudhi::thread_pool::set_max_threads, py::arg("n"),
+        "Limits the number of threads of the pool shared by the compiled modules, 0 removes the limit.");
+  m.def("_max_threads", &Gudhi::thread_pool::max_threads, "Number of threads of the pool.");
+  m.def("_has_tbb", []() {
+#ifdef GUDHI_USE_TBB
+    return true;
+#else
+    return false;
+#endif
+  }, "Whether the pool is the one of TBB, shared by all the compiled modules.");
+}
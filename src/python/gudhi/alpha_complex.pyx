@@ -15,11 +15,14 @@ from libcpp.vector cimport vector
 from libcpp.utility cimport pair
 from libcpp.string cimport string
 from libcpp cimport bool
-from libc.stdint cimport intptr_t
+from libc.stdint cimport intptr_t, uintptr_t
+from libc.stddef cimport ptrdiff_t
+import numpy as np
 import warnings
 
 from gudhi.simplex_tree cimport *
-from gudhi.simplex_tree import SimplexTree
+from gudhi.simplex_tree import SimplexTree, _CancellationFlag
+from gudhi.parallel import _submit_cancellable
 from gudhi import read_points_from_off_file
 
 __author__ = "Vincent Rouvreau"
@@ -29,6 +32,10 @@ __license__ = "GPL v3"
 cdef extern from "Alpha_complex_interface.h" namespace "Gudhi":
     cdef cppclass Alpha_complex_interface "Gudhi::alpha_complex::Alpha_complex_interface":
         Alpha_complex_interface(vector[vector[double]] points, vector[double] weights, bool fast_version, bool exact_version) nogil except +
+        Alpha_complex_interface(const float* data, size_t num_points, size_t dimension, ptrdiff_t stride0,
+                                ptrdiff_t stride1, vector[double] weights, bool fast_version, bool exact_version) nogil except +
+        Alpha_complex_interface(const double* data, size_t num_points, size_t dimension, ptrdiff_t stride0,
+                                ptrdiff_t stride1, vector[double] weights, bool fast_version, bool exact_version) nogil except +
         vector[double] get_point(int vertex) nogil except +
         void create_simplex_tree(Simplex_tree_interface_full_featured* simplex_tree, double max_alpha_square, bool default_filtration_value) nogil except +
         @staticmethod
@@ -37,6 +44,10 @@ cdef extern from "Alpha_complex_interface.h" namespace "Gudhi":
         double get_float_relative_precision() nogil
 
 # AlphaComplex python interface
+def _exchange_cancellation_flag(uintptr_t flag):
+    """Same as `gudhi.simplex_tree._exchange_cancellation_flag`, for the computations of this module."""
+    return <uintptr_t>exchange_cancellation_flag(<Cancellation_flag*>flag)
+
 cdef class AlphaComplex:
     """AlphaComplex is a simplicial complex constructed from the finite cells of a Delaunay Triangulation.
 
@@ -58,8 +69,9 @@ cdef class AlphaComplex:
     def __init__(self, points=[], off_file='', weights=None, precision='safe'):
         """AlphaComplex constructor.
 
-        :param points: A list of points in d-Dimension.
-        :type points: Iterable[Iterable[float]]
+        :param points: A list of points in d-Dimension. A 2d numpy array of float32 or float64 is read in place,
+            without any copy.
+        :type points: Iterable[Iterable[float]] or numpy.ndarray
 
         :param off_file: **[deprecated]** An `OFF file style <fileformats.html#off-file-format>`_ name.
             If an `off_file` is given with `points` as arguments, only points from the file are taken into account.
@@ -90,12 +102,30 @@ cdef class AlphaComplex:
         if weights is not None and len(weights) != len(points):
             raise ValueError("Inconsistency between the number of points and weights")
 
-        # need to copy the points to use them without the gil
         cdef vector[vector[double]] pts
         cdef vector[double] wgts
-        pts = points
+        # 2d arrays of float32 or float64 are read in place, with any strides
+        cdef const float[:, :] points_f32
+        cdef const double[:, :] points_f64
         if weights is not None:
             wgts = weights
+        if (isinstance(points, np.ndarray) and points.ndim == 2 and points.size > 0
+                and points.dtype in (np.float32, np.float64)):
+            if points.dtype == np.float32:
+                points_f32 = points
+                with nogil:
+                    self.this_ptr = new Alpha_complex_interface(&points_f32[0, 0], points_f32.shape[0],
+                                                                points_f32.shape[1], points_f32.strides[0],
+                                                                points_f32.strides[1], wgts, fast, exact)
+            else:
+                points_f64 = points
+                with nogil:
+                    self.this_ptr = new Alpha_complex_interface(&points_f64[0, 0], points_f64.shape[0],
+                                                                points_f64.shape[1], points_f64.strides[0],
+                                                                points_f64.strides[1], wgts, fast, exact)
+            return
+        # need to copy the points to use them without the gil
+        pts = points
         with nogil:
             self.this_ptr = new Alpha_complex_interface(pts, wgts, fast, exact)
 
@@ -138,6 +168,17 @@ cdef class AlphaComplex:
                                               mas, compute_filtration)
         return stree
 
+    def create_simplex_tree_async(self, max_alpha_square = float('inf'), default_filtration_value = False):
+        """Same as :func:`create_simplex_tree`, computed on a thread of the pool of :mod:`gudhi.parallel` while the
+        caller goes on, with the same parameters.
+
+        :returns: The future of the simplex tree, whose `cancel()` also stops the computation when it is running.
+            `result()` then raises `concurrent.futures.CancelledError`.
+        :rtype: concurrent.futures.Future
+        """
+        return _submit_cancellable(lambda: self.create_simplex_tree(max_alpha_square, default_filtration_value),
+                                   _CancellationFlag(), _exchange_cancellation_flag)
+
     @staticmethod
     def set_float_relative_precision(precision):
         """
@@ -0,0 +1,213 @@
+# This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+# See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+# Author(s):       David Loiseaux
+#
+# Copyright (C) 2023 Inria
+#
+# Modification(s):
+#   - YYYY/MM Author: Description of the modification
+
+"""Micro-benchmarks of the overhead of the Python bindings of the simplex trees: the per-call cost of the small
+methods (e.g. :meth:`~gudhi.SimplexTree.insert`), and the per-item cost of the methods returning many simplices or
+intervals (e.g. :meth:`~gudhi.SimplexTree.get_simplices`, :meth:`~gudhi.SimplexTree.persistence_pairs`), so that
+a change of the bindings can be evaluated. Run it with
+
+.. code-block:: bash
+
+    python -m gudhi.benchmarks --output new.json --baseline old.json
+
+which lists the benchmarks that got slower than the tolerance compared to a previous run, and then exits with a
+non-zero status.
+"""
+
+import argparse
+import json
+import sys
+import time
+
+import numpy as np
+
+__author__ = "David Loiseaux"
+__copyright__ = "Copyright (C) 2023 Inria"
+__license__ = "MIT"
+
+__all__ = ["measure", "run_benchmarks", "regressions"]
+
+
+def measure(f, number, repeat=3):
+    """Best time over `repeat` runs of `number` calls of `f`, divided by `number`.
+
+    :returns: The time of a call of `f`, in seconds.
+    :rtype: float
+    """
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        for _ in range(number):
+            f()
+        best = min(best, time.perf_counter() - start)
+    return best / number
+
+
+def _random_flag_complex(SimplexTree, num_vertices, degree, rng, filtration):
+    """Flag complex of dimension 3 of a random graph, and its edges."""
+    edges = rng.integers(0, num_vertices, (2, degree * num_vertices // 2))
+    edges = edges[:, edges[0] != edges[1]]
+    st = SimplexTree()
+    st.insert_batch(np.arange(num_vertices, dtype=np.intc).reshape(1, -1), filtration(num_vertices))
+    st.insert_batch(edges.astype(np.intc), filtration(edges.shape[1]))
+    st.expansion(3)
+    return st, edges
+
+
+def _simplex_tree_benchmarks(num_vertices, rng, repeat):
+    from gudhi import SimplexTree
+
+    st, edges = _random_flag_complex(SimplexTree, num_vertices, 10, rng, lambda n: rng.random(n))
+    num_simplices = st.num_simplices()
+    simplices = [[int(u), int(v)] for u, v in edges.T[:1000]]
+    vertex = [0]
+
+    def insert():
+        tree = SimplexTree()
+        for simplex in simplices:
+            tree.insert(simplex, 1.0)
+
+    def persistence():
+        st.compute_persistence()
+
+    yield "SimplexTree.insert", len(simplices), measure(insert, 1, repeat)
+    yield "SimplexTree.find", len(simplices), measure(lambda: [st.find(s) for s in simplices], 1, repeat)
+    yield "SimplexTree.filtration", len(simplices), measure(lambda: [st.filtration(s) for s in simplices], 1, repeat)
+    yield "SimplexTree.get_star", 1, measure(lambda: list(st.get_star(vertex)), 100, repeat)
+    yield "SimplexTree.get_cofaces", 1, measure(lambda: list(st.get_cofaces(vertex, 1)), 100, repeat)
+    yield "SimplexTree.get_boundaries", 1, measure(lambda: list(st.get_boundaries(simplices[0])), 100, repeat)
+    yield "SimplexTree.get_simplices", num_simplices, measure(lambda: list(st.get_simplices()), 1, repeat)
+    yield "SimplexTree.get_filtration", num_simplices, measure(lambda: list(st.get_filtration()), 1, repeat)
+    yield "SimplexTree.get_skeleton", num_simplices, measure(lambda: list(st.get_skeleton(3)), 1, repeat)
+    yield "SimplexTree.compute_persistence", num_simplices, measure(persistence, 1, repeat)
+    num_pairs = len(st.persistence_pairs())
+    yield "SimplexTree.persistence_intervals_in_dimension", num_pairs, measure(
+        lambda: [st.persistence_intervals_in_dimension(d) for d in range(3)], 1, repeat
+    )
+    yield "SimplexTree.persistence_pairs", num_pairs, measure(st.persistence_pairs, 1, repeat)
+    yield "SimplexTree.lower_star_persistence_generators", num_pairs, measure(
+        st.lower_star_persistence_generators, 1, repeat
+    )
+    yield "SimplexTree.flag_persistence_generators", num_pairs, measure(st.flag_persistence_generators, 1, repeat)
+
+
+def _simplex_tree_multi_benchmarks(num_vertices, rng, repeat, num_parameters=2):
+    from gudhi.simplex_tree_multi import SimplexTreeMulti
+
+    def tree():
+        return SimplexTreeMulti(num_parameters=num_parameters)
+
+    st, edges = _random_flag_complex(tree, num_vertices, 10, rng, lambda n: rng.random((n, num_parameters)))
+    num_simplices = st.num_simplices
+    simplices = [[int(u), int(v)] for u, v in edges.T[:1000]]
+    filtration = np.ones(num_parameters)
+
+    def insert():
+        t = tree()
+        for simplex in simplices:
+            t.insert(simplex, filtration)
+
+    yield "SimplexTreeMulti.insert", len(simplices), measure(insert, 1, repeat)
+    yield "SimplexTreeMulti.filtration", len(simplices), measure(
+        lambda: [st.filtration(s) for s in simplices], 1, repeat
+    )
+    yield "SimplexTreeMulti.get_simplices", num_simplices, measure(lambda: list(st.get_simplices()), 1, repeat)
+    yield "SimplexTreeMulti.get_filtration", num_simplices, measure(lambda: list(st.get_filtration()), 1, repeat)
+    yield "SimplexTreeMulti.get_simplices_and_filtrations", num_simplices, measure(
+        st.get_simplices_and_filtrations, 1, repeat
+    )
+
+
+def run_benchmarks(sizes=(1000, 10000), repeat=3, seed=0, verbose=False):
+    """Runs the benchmarks on flag complexes of dimension 3 of random graphs.
+
+    :param sizes: Numbers of vertices of the graphs.
+    :type sizes: Iterable[int]
+    :param repeat: Number of runs of each benchmark, the best is kept.
+    :type repeat: int
+    :param seed: Seed of the random graphs.
+    :type seed: int
+    :param verbose: Whether to print the results as they are computed on the standard error.
+    :type verbose: bool
+    :returns: For each benchmark, a dictionary with the keys `name`, `size` (number of vertices), `items` (number of
+        simplices or intervals processed by one run), `seconds` (time of one run) and `seconds_per_item`.
+    :rtype: list of dict
+    """
+    results = []
+    rng = np.random.default_rng(seed)
+    suites = [_simplex_tree_benchmarks]
+    try:
+        import gudhi.simplex_tree_multi  # noqa: F401
+
+        suites.append(_simplex_tree_multi_benchmarks)
+    except ImportError:
+        print("gudhi.simplex_tree_multi is not available", file=sys.stderr)
+    for n in sizes:
+        for suite in suites:
+            for name, items, seconds in suite(n, rng, repeat):
+                result = {
+                    "name": name,
+                    "size": n,
+                    "items": items,
+                    "seconds": seconds,
+                    "seconds_per_item": seconds / max(items, 1),
+                }
+                if verbose:
+                    print(
+                        f"{name:50} n={n:7} {items:9} items {1e9 * result['seconds_per_item']:10.1f} ns/item",
+                        file=sys.stderr,
+                    )
+                results.append(result)
+    return results
+
+
+def regressions(results, baseline, tolerance=1.2):
+    """Results slower than `tolerance` times the one of the same benchmark and size in `baseline`.
+
+    :returns: The tuples (name, size, baseline seconds per item, new seconds per item).
+    :rtype: list of tuple
+    """
+    reference = {(r["name"], r["size"]): r["seconds_per_item"] for r in baseline}
+    slower = []
+    for r in results:
+        old = reference.get((r["name"], r["size"]))
+        if old is not None and old > 0 and r["seconds_per_item"] > tolerance * old:
+            slower.append((r["name"], r["size"], old, r["seconds_per_item"]))
+    return slower
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Micro-benchmarks of the Python bindings of the simplex trees.")
+    parser.add_argument("--sizes", type=int, nargs="+", default=[1000, 10000], help="numbers of vertices")
+    parser.add_argument("--repeat", type=int, default=3, help="number of runs of each benchmark, the best is kept")
+    parser.add_argument("--seed", type=int, default=0, help="seed of the random complexes")
+    parser.add_argument("--output", help="JSON file of the results, the standard output by default")
+    parser.add_argument("--baseline", help="JSON file of previous results, to compare with")
+    parser.add_argument("--tolerance", type=float, default=1.2, help="slowdown reported as a regression")
+    args = parser.parse_args(argv)
+
+    results = run_benchmarks(args.sizes, args.repeat, args.seed, verbose=True)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2)
+    else:
+        json.dump(results, sys.stdout, indent=2)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            slower = regressions(results, json.load(f), args.tolerance)
+        for name, size, old, new in slower:
+            print(f"Regression: {name} n={size} {1e9 * old:.1f} ns/item -> {1e9 * new:.1f} ns/item", file=sys.stderr)
+        if slower:
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -29,6 +29,23 @@ double bottleneck(Dgm d1, Dgm d2, std::optional<double> epsilon)
   return Gudhi::persistence_diagram::bottleneck_distance(diag1, diag2, e);
 }
 
+// All the distances between the packed diagrams of X, or between those of X and Y, each diagram being converted once.
+py::array_t<double> bottleneck_matrix(Packed_coords X, Packed_offsets X_offsets,
+                                      std::optional<Packed_coords> Y, std::optional<Packed_offsets> Y_offsets,
+                                      std::optional<double> epsilon, int n_jobs)
+{
+  double e = epsilon.value_or((std::numeric_limits<double>::min)());
+  auto diags1 = unpack_diagrams(X, X_offsets, make_point);
+  std::optional<decltype(diags1)> diags2;
+  if(Y) {
+    if(!Y_offsets) throw std::runtime_error("Y needs offsets");
+    diags2 = unpack_diagrams(*Y, *Y_offsets, make_point);
+  }
+  return diagram_distance_matrix(diags1, diags2, [e](auto const& d1, auto const& d2) {
+      return Gudhi::persistence_diagram::bottleneck_distance(d1, d2, e);
+    }, n_jobs);
+}
+
 PYBIND11_MODULE(bottleneck, m) {
       m.attr("__license__") = "GPL v3";
       m.def("bottleneck_distance", &bottleneck,
@@ -54,4 +71,8 @@ PYBIND11_MODULE(bottleneck, m) {
     :rtype: float
     :returns: the bottleneck distance.
     )pbdoc");
+      m.def("_bottleneck_distance_matrix", &bottleneck_matrix,
+          py::arg("X"), py::arg("X_offsets"), py::arg("Y") = py::none(), py::arg("Y_offsets") = py::none(),
+          py::arg("e") = py::none(), py::arg("n_jobs") = 1,
+          "Bottleneck distances between packed diagrams, see gudhi.representations.pairwise_persistence_diagram_distances");
 }
@@ -17,6 +17,11 @@
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/range/irange.hpp>
 #include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include <unordered_map>
 #include <pybind11/pybind11.h>
@@ -46,9 +51,25 @@ struct Merge {
   double persist;
 };
 
+// Output of tomato, converted to numpy arrays once the GIL is held again.
+struct Hierarchy {
+  std::vector<Cluster_index> raw_cluster_ordered;
+  std::vector<std::array<Cluster_index, 2>> children;
+  std::vector<std::array<double, 2>> persistence;
+  std::vector<double> max_cc;
+
+  py::tuple to_python() const {
+    // TODO avoid copies: https://github.com/pybind/pybind11/issues/1042
+    return py::make_tuple(py::array(raw_cluster_ordered.size(), raw_cluster_ordered.data()),
+                          py::array(children.size(), children.data()),
+                          py::array(persistence.size(), persistence.data()), py::array(max_cc.size(), max_cc.data()));
+  }
+};
+
+// neighbors(p) is a range of the neighbors of the point p; an index outside [0, num_points) is ignored.
 template <class Neighbors, class Density, class Order, class ROrder>
-auto tomato(Point_index num_points, Neighbors const& neighbors, Density const& density, Order const& order,
-            ROrder const& rorder) {
+Hierarchy tomato(Point_index num_points, Neighbors const& neighbors, Density const& density, Order const& order,
+                 ROrder const& rorder) {
   // point index --> index of raw cluster it belongs to
   std::vector<Cluster_index> raw_cluster;
   raw_cluster.reserve(num_points);
@@ -77,16 +98,14 @@ auto tomato(Point_index num_points, Neighbors const& neighbors, Density const& d
   // insert in the vector if merged is absent from the set
 
   for (Point_index i = 0; i < num_points; ++i) {
-    // auto&& ngb = neighbors[order[i]];
-    // TODO: have a specialization where we don't need python types and py::cast
-    // TODO: move py::cast and getint into Neighbors
-    py::object ngb = neighbors[py::cast(order[i])];  // auto&& also seems to work
+    auto&& ngb = neighbors(order[i]);
     adj_clusters.clear();
     Point_index j = i;  // highest neighbor
-    // for(Point_index k : ngb)
-    for (auto k_py : ngb) {
-      Point_index k = rorder[getint(k_py)];
-      if (k >= i || k < 0)  // ???
+    for (auto k_any : ngb) {
+      Point_index neighbor = getint<decltype(k_any)>(k_any);
+      if (neighbor < 0 || neighbor >= num_points) continue;
+      Point_index k = rorder[neighbor];
+      if (k >= i)
         continue;
       if (k < j) j = k;
       Cluster_index rk = raw_cluster[k];
@@ -188,65 +207,105 @@ auto tomato(Point_index num_points, Neighbors const& neighbors, Density const& d
   std::vector<Cluster_index> raw_cluster_ordered(num_points);
   for (int i = 0; i < num_points; ++i) raw_cluster_ordered[i] = raw_cluster[rorder[i]];
   // return raw_cluster, children, persistence
-  // TODO avoid copies: https://github.com/pybind/pybind11/issues/1042
-  return py::make_tuple(py::array(raw_cluster_ordered.size(), raw_cluster_ordered.data()),
-                        py::array(children.size(), children.data()), py::array(persistence.size(), persistence.data()),
-                        py::array(max_cc.size(), max_cc.data()));
+  return {std::move(raw_cluster_ordered), std::move(children), std::move(persistence), std::move(max_cc)};
+}
+
+// order[i] is the index of the point with i-th largest density, rorder[i] is the rank of the i-th point in order of
+// decreasing density.
+template <class Neighbors>
+Hierarchy sort_and_tomato(Point_index n, Neighbors const& neighbors, double const* d) {
+  // Vector { 0, 1, ..., n-1 }
+  std::vector<Point_index> order(boost::counting_iterator<Point_index>(0), boost::counting_iterator<Point_index>(n));
+  // Permutation of the indices to get points in decreasing order of density
+  std::sort(std::begin(order), std::end(order), [=](Point_index i, Point_index j) { return d[i] > d[j]; });
+  // Inverse permutation
+  std::vector<Point_index> rorder(n);
+  for (Point_index i : boost::irange(0, n)) rorder[order[i]] = i;
+  return tomato(n, neighbors, d, order, rorder);
 }
 
-auto merge(py::array_t<Cluster_index, py::array::c_style> children, Cluster_index n_leaves, Cluster_index n_final) {
+// Clamps the number of clusters required to what the hierarchy can provide.
+Cluster_index check_n_final(Cluster_index n_leaves, Cluster_index n_merges, Cluster_index n_final) {
   if (n_final > n_leaves) {
     std::cerr << "The number of clusters required " << n_final << " is larger than the number of mini-clusters " << n_leaves << '\n';
     n_final = n_leaves; // or return something special and let Tomato use leaf_labels_?
   }
-  py::buffer_info cbuf = children.request();
-  if ((cbuf.ndim != 2 || cbuf.shape[1] != 2) && (cbuf.ndim != 1 || cbuf.shape[0] != 0))
-    throw std::runtime_error("internal error: children have to be (n,2) or empty");
-  const int n_merges = cbuf.shape[0];
-  Cluster_index* d = (Cluster_index*)cbuf.ptr;
   if (n_merges + n_final < n_leaves) {
     std::cerr << "The number of clusters required " << n_final << " is smaller than the number of connected components " << n_leaves - n_merges << '\n';
     n_final = n_leaves - n_merges;
   }
-  struct Dat {
-    Cluster_index parent;
-    int rank;
-    int name;
-  };
-  std::vector<Dat> ds_bas(2 * n_leaves - 1);
-  auto ds_dat = boost::make_function_property_map<std::size_t>([&ds_bas](std::size_t n) -> Dat& { return ds_bas[n]; });
-  auto ds_par = boost::make_transform_value_property_map([](auto& p) -> Cluster_index& { return p.parent; }, ds_dat);
-  auto ds_ran = boost::make_transform_value_property_map([](auto& p) -> int& { return p.rank; }, ds_dat);
-  boost::disjoint_sets<decltype(ds_ran), decltype(ds_par)> ds(ds_ran, ds_par);
-  Cluster_index i;
-  for (i = 0; i < n_leaves; ++i) {
-    ds.make_set(i);
-    ds_bas[i].name = -1;
-  }
-  for (Cluster_index m = 0; m < n_leaves - n_final; ++m) {
-    Cluster_index j = ds.find_set(d[2 * m]);
-    Cluster_index k = ds.find_set(d[2 * m + 1]);
-    assert(j != k);
-    ds.make_set(i);
-    ds.link(i, j);
-    ds.link(ds.find_set(i), k);
-    ++i;
+  return n_final;
+}
+
+// The merge tree as a parent array: node n_leaves + m is created by the m-th merge, parent[c] is the node created by
+// the merge of c, or -1 if c is never merged. Since parent[c] > c, a pass by decreasing node index sees the parent of a
+// node before the node itself.
+py::array_t<Cluster_index> merge_tree(py::array_t<Cluster_index, py::array::c_style> children, Cluster_index n_leaves) {
+  py::buffer_info cbuf = children.request();
+  if ((cbuf.ndim != 2 || cbuf.shape[1] != 2) && (cbuf.ndim != 1 || cbuf.shape[0] != 0))
+    throw std::runtime_error("internal error: children have to be (n,2) or empty");
+  const Cluster_index n_merges = cbuf.shape[0];
+  Cluster_index const* d = static_cast<Cluster_index const*>(cbuf.ptr);
+  py::array_t<Cluster_index> parent(n_leaves + n_merges);
+  Cluster_index* p = parent.mutable_data();
+  std::fill(p, p + n_leaves + n_merges, -1);
+  for (Cluster_index m = 0; m < n_merges; ++m) p[d[2 * m]] = p[d[2 * m + 1]] = n_leaves + m;
+  return parent;
+}
+
+// Labels of the leaves once the first n_leaves - n_final merges are done, numbered in order of first appearance.
+// root and name are work arrays of size parent.size().
+void merge_labels(Cluster_index const* parent, Cluster_index n_leaves, Cluster_index n_final,
+                  std::vector<Cluster_index>& root, std::vector<Cluster_index>& name, Cluster_index* out) {
+  const Cluster_index n_nodes = 2 * n_leaves - n_final;
+  for (Cluster_index c = n_nodes - 1; c >= 0; --c) {
+    Cluster_index p = parent[c];
+    root[c] = (p >= 0 && p < n_nodes) ? root[p] : c;
   }
+  std::fill(name.begin(), name.begin() + n_nodes, -1);
   Cluster_index next_cluster_name = 0;
-  std::vector<Cluster_index> ret;
-  ret.reserve(n_leaves);
   for (Cluster_index j = 0; j < n_leaves; ++j) {
-    Cluster_index k = ds.find_set(j);
-    if (ds_bas[k].name == -1) ds_bas[k].name = next_cluster_name++;
-    ret.push_back(ds_bas[k].name);
+    Cluster_index& k = name[root[j]];
+    if (k == -1) k = next_cluster_name++;
+    out[j] = k;
+  }
+}
+
+// Renaming of the leaves for each number of clusters in n_finals, as an array of shape (len(n_finals), n_leaves).
+py::array_t<Cluster_index> merge_batch(py::array_t<Cluster_index, py::array::c_style> parent, Cluster_index n_leaves,
+                                       py::array_t<Cluster_index, py::array::c_style | py::array::forcecast> n_finals) {
+  if (parent.ndim() != 1 || parent.shape(0) < n_leaves)
+    throw std::runtime_error("internal error: parent has to be 1D with at least n_leaves elements");
+  if (n_finals.ndim() != 1) throw std::runtime_error("the numbers of clusters must be 1D");
+  const Cluster_index n_merges = parent.shape(0) - n_leaves;
+  std::vector<Cluster_index> finals(n_finals.data(), n_finals.data() + n_finals.shape(0));
+  for (auto& n_final : finals) n_final = check_n_final(n_leaves, n_merges, n_final);
+  py::array_t<Cluster_index> ret({finals.size(), static_cast<std::size_t>(n_leaves)});
+  Cluster_index const* p = parent.data();
+  Cluster_index* out = ret.mutable_data();
+  {
+    py::gil_scoped_release release;
+    std::vector<Cluster_index> root(n_leaves + n_merges), name(n_leaves + n_merges);
+    for (std::size_t i = 0; i < finals.size(); ++i)
+      merge_labels(p, n_leaves, finals[i], root, name, out + i * n_leaves);
   }
-  return py::array(ret.size(), ret.data());
+  return ret;
+}
+
+// Renaming of the leaves for n_final clusters, a single pass over the merge tree computed by merge_tree.
+py::array_t<Cluster_index> merge(py::array_t<Cluster_index, py::array::c_style> parent, Cluster_index n_leaves,
+                                 Cluster_index n_final) {
+  if (parent.ndim() != 1 || parent.shape(0) < n_leaves)
+    throw std::runtime_error("internal error: parent has to be 1D with at least n_leaves elements");
+  const Cluster_index n_merges = parent.shape(0) - n_leaves;
+  n_final = check_n_final(n_leaves, n_merges, n_final);
+  py::array_t<Cluster_index> ret(n_leaves);
+  std::vector<Cluster_index> root(n_leaves + n_merges), name(n_leaves + n_merges);
+  merge_labels(parent.data(), n_leaves, n_final, root, name, ret.mutable_data());
+  return ret;
 }
 
-// TODO: Do a special version when ngb is a numpy array, where we can cast to int[k][n] ?
-// py::isinstance<py::array_t<std::int32_t>> (ou py::isinstance<py::array> et tester dtype) et flags&c_style
-// ou overload (en virant forcecast?)
-// aussi le faire au cas où on n'aurait pas un tableau, mais où chaque liste de voisins serait un tableau ?
+// See hierarchy_csr for a version that does not go through Python objects.
 auto hierarchy(py::handle ngb, py::array_t<double, py::array::c_style | py::array::forcecast> density) {
   // used to be py::iterable ngb, but that's inconvenient if it doesn't come pre-sorted
   // use py::handle and check if [] (aka __getitem__) works? But then we need to build an object to pass it to []
@@ -255,23 +314,40 @@ auto hierarchy(py::handle ngb, py::array_t<double, py::array::c_style | py::arra
   if (wbuf.ndim != 1) throw std::runtime_error("density must be 1D");
   const int n = wbuf.shape[0];
   double* d = (double*)wbuf.ptr;
-  // Vector { 0, 1, ..., n-1 }
-  std::vector<Point_index> order(boost::counting_iterator<Point_index>(0), boost::counting_iterator<Point_index>(n));
-  // Permutation of the indices to get points in decreasing order of density
-  std::sort(std::begin(order), std::end(order), [=](Point_index i, Point_index j) { return d[i] > d[j]; });
-  // Inverse permutation
-  std::vector<Point_index> rorder(n);
-  for (Point_index i : boost::irange(0, n)) rorder[order[i]] = i;
-  // Used as:
-  // order[i] is the index of the point with i-th largest density
-  // rorder[i] is the rank of the i-th point in order of decreasing density
-  // TODO: put a wrapper on ngb and d so we don't need to pass (r)order (there is still the issue of reordering the
-  // output)
-  return tomato(n, ngb, d, order, rorder);
+  auto neighbors = [ngb](Point_index i) -> py::object { return ngb[py::cast(i)]; };
+  return sort_and_tomato(n, neighbors, d).to_python();
+}
+
+// Same as hierarchy, with the graph in compressed sparse row format: the neighbors of the point i are
+// indices[offsets[i]:offsets[i+1]], for instance offsets = k * arange(n+1) and indices = neighbors.ravel() for a
+// (n, k) array of nearest neighbors. It does not hold the GIL during the computation.
+py::tuple hierarchy_csr(py::array_t<std::int64_t, py::array::c_style | py::array::forcecast> offsets,
+                        py::array_t<Point_index, py::array::c_style | py::array::forcecast> indices,
+                        py::array_t<double, py::array::c_style | py::array::forcecast> density) {
+  py::buffer_info wbuf = density.request();
+  if (wbuf.ndim != 1) throw std::runtime_error("density must be 1D");
+  const int n = wbuf.shape[0];
+  if (offsets.ndim() != 1 || offsets.shape(0) != n + 1) throw std::runtime_error("offsets must have size n+1");
+  std::int64_t const* off = offsets.data();
+  if (off[0] != 0 || off[n] > indices.size()) throw std::runtime_error("offsets do not match indices");
+  for (int i = 0; i < n; ++i)
+    if (off[i] > off[i + 1]) throw std::runtime_error("offsets must be non-decreasing");
+  Point_index const* ind = indices.data();
+  double const* d = wbuf.size == 0 ? nullptr : static_cast<double const*>(wbuf.ptr);
+  Hierarchy h;
+  {
+    py::gil_scoped_release release;
+    auto neighbors = [=](Point_index i) { return boost::make_iterator_range(ind + off[i], ind + off[i + 1]); };
+    h = sort_and_tomato(n, neighbors, d);
+  }
+  return h.to_python();
 }
 
 PYBIND11_MODULE(_tomato, m) {
   m.doc() = "Internals of tomato clustering";
   m.def("hierarchy", &hierarchy, "does the clustering");
+  m.def("hierarchy_csr", &hierarchy_csr, "does the clustering, from a graph in compressed sparse row format");
+  m.def("merge_tree", &merge_tree, "parent array of the merge tree");
   m.def("merge", &merge, "merge clusters");
+  m.def("merge_batch", &merge_batch, "merge clusters, for several numbers of clusters");
 }
@@ -235,18 +235,29 @@ class Tomato:
 
         self.weights_ = weights
         # This is where the main computation happens
-        self.leaf_labels_, self.children_, self.diagram_, self.max_weight_per_cc_ = hierarchy(self.neighbors_, weights)
+        if isinstance(self.neighbors_, numpy.ndarray) and self.neighbors_.ndim == 2:
+            # Typically a knn graph, read directly as a CSR graph without going through Python objects
+            n, k = self.neighbors_.shape
+            offsets = numpy.arange(n + 1, dtype=numpy.int64) * k
+            self.leaf_labels_, self.children_, self.diagram_, self.max_weight_per_cc_ = hierarchy_csr(
+                offsets, self.neighbors_.ravel(), weights
+            )
+        else:
+            self.leaf_labels_, self.children_, self.diagram_, self.max_weight_per_cc_ = hierarchy(
+                self.neighbors_, weights
+            )
         self.n_leaves_ = len(self.max_weight_per_cc_) + len(self.children_)
         assert self.leaf_labels_.max() + 1 == len(self.max_weight_per_cc_) + len(self.children_)
+        # Kept so that changing the number of clusters is a single pass, without replaying the merges
+        self.__merge_tree = merge_tree(self.children_, self.n_leaves_)
+        self.__sorted_prominences = numpy.sort(self.diagram_[:, 0] - self.diagram_[:, 1])
         # TODO: deduplicate this code with the setters below
         if self.__merge_threshold:
             assert not self.__n_clusters
-            self.__n_clusters = numpy.count_nonzero(
-                self.diagram_[:, 0] - self.diagram_[:, 1] > self.__merge_threshold
-            ) + len(self.max_weight_per_cc_)
+            self.__n_clusters = self.__n_clusters_for_thresholds(self.__merge_threshold)
         if self.__n_clusters:
             # TODO: set corresponding merge_threshold?
-            renaming = merge(self.children_, self.n_leaves_, self.__n_clusters)
+            renaming = merge(self.__merge_tree, self.n_leaves_, self.__n_clusters)
             self.labels_ = renaming[self.leaf_labels_]
             # In case the user asked for something impossible.
             # TODO: check for impossible situations before calling merge.
@@ -262,6 +273,32 @@ class Tomato:
         """
         return self.fit(X, y, weights).labels_
 
+    def __n_clusters_for_thresholds(self, merge_thresholds):
+        # Number of finite points of the diagram with a prominence larger than the threshold, plus the infinite ones
+        p = self.__sorted_prominences
+        return len(p) - numpy.searchsorted(p, merge_thresholds, side="right") + len(self.max_weight_per_cc_)
+
+    def labels_for(self, n_clusters=None, merge_thresholds=None):
+        """
+        Labels of the points for several numbers of clusters, or several merge thresholds, without changing
+        `labels_`. The hierarchy computed by :func:`fit` is reused, so this only costs a linear pass over the tree and
+        the points per value.
+
+        Parameters:
+            n_clusters (sequence of int): numbers of clusters.
+            merge_thresholds (sequence of float): minimum prominences of a cluster so it doesn't get merged.
+
+        Returns:
+            ndarray of shape (len(n_clusters) or len(merge_thresholds), n_samples): the i-th row is what `labels_`
+            would be after setting `n_clusters_` to n_clusters[i], or `merge_threshold_` to merge_thresholds[i].
+        """
+        if (n_clusters is None) == (merge_thresholds is None):
+            raise ValueError("Specify exactly one of n_clusters and merge_thresholds")
+        if merge_thresholds is not None:
+            n_clusters = self.__n_clusters_for_thresholds(numpy.asarray(merge_thresholds, dtype=float))
+        renamings = merge_batch(self.__merge_tree, self.n_leaves_, numpy.asarray(n_clusters, dtype=numpy.int32))
+        return renamings[:, self.leaf_labels_]
+
     # TODO: add argument k or threshold? Have a version where you can click and it shows the line and the corresponding k?
     def plot_diagram(self):
         """
@@ -299,7 +336,7 @@ class Tomato:
         self.__n_clusters = n_clusters
         self.__merge_threshold = None
         if hasattr(self, "leaf_labels_"):
-            renaming = merge(self.children_, self.n_leaves_, self.__n_clusters)
+            renaming = merge(self.__merge_tree, self.n_leaves_, self.__n_clusters)
             self.labels_ = renaming[self.leaf_labels_]
             # In case the user asked for something impossible
             self.__n_clusters = self.labels_.max() + 1
@@ -313,9 +350,7 @@ class Tomato:
         if merge_threshold == self.__merge_threshold:
             return
         if hasattr(self, "leaf_labels_"):
-            self.n_clusters_ = numpy.count_nonzero(self.diagram_[:, 0] - self.diagram_[:, 1] > merge_threshold) + len(
-                self.max_weight_per_cc_
-            )
+            self.n_clusters_ = self.__n_clusters_for_thresholds(merge_threshold)
         else:
             self.__n_clusters = None
         self.__merge_threshold = merge_threshold
@@ -14,6 +14,7 @@ from cython cimport numeric
 from libcpp.vector cimport vector
 from libcpp.utility cimport pair
 from libcpp cimport bool
+from libc.stdint cimport uint8_t, uint16_t, uintptr_t
 import errno
 import os
 import sys
@@ -21,6 +22,8 @@ import sys
 import numpy as np
 cimport numpy as np
 
+from gudhi._pers_cub_low_dim import _persistence_on_cuboid_from_top_cells
+
 __author__ = "Vincent Rouvreau"
 __copyright__ = "Copyright (C) 2016 Inria"
 __license__ = "MIT"
@@ -31,6 +34,10 @@ np.import_array()
 cdef extern from "Cubical_complex_interface.h" namespace "Gudhi":
     cdef cppclass Bitmap_cubical_complex_interface "Gudhi::Cubical_complex::Cubical_complex_interface":
         Bitmap_cubical_complex_interface(vector[unsigned] dimensions, vector[double] cells, bool input_top_cells) nogil except +
+        Bitmap_cubical_complex_interface(vector[unsigned] dimensions, const uint8_t* cells, size_t size, bool input_top_cells) nogil except +
+        Bitmap_cubical_complex_interface(vector[unsigned] dimensions, const uint16_t* cells, size_t size, bool input_top_cells) nogil except +
+        Bitmap_cubical_complex_interface(vector[unsigned] dimensions, const float* cells, size_t size, bool input_top_cells) nogil except +
+        Bitmap_cubical_complex_interface(vector[unsigned] dimensions, const double* cells, size_t size, bool input_top_cells) nogil except +
         Bitmap_cubical_complex_interface(const char* perseus_file) nogil except +
         int num_simplices() nogil
         int dimension() nogil
@@ -42,11 +49,16 @@ cdef extern from "Persistent_cohomology_interface.h" namespace "Gudhi":
         Cubical_complex_persistence_interface(Bitmap_cubical_complex_interface * st, bool persistence_dim_max) nogil
         void compute_persistence(int homology_coeff_field, double min_persistence) nogil except +
         vector[pair[int, pair[double, double]]] get_persistence() nogil
+        vector[pair[int, pair[double, double]]] get_persistence(size_t max_intervals) nogil
         vector[vector[int]] cofaces_of_cubical_persistence_pairs() nogil
         vector[vector[int]] vertices_of_cubical_persistence_pairs() nogil
         vector[int] betti_numbers() nogil
         vector[int] persistent_betti_numbers(double from_value, double to_value) nogil
         vector[pair[double,double]] intervals_in_dimension(int dimension) nogil
+        vector[size_t] num_intervals_by_dimension() nogil
+        void fill_intervals_by_dimension(const vector[uintptr_t]& intervals, bool single_precision) nogil
+
+    vector[int] cofaces_of_cubical_persistence_pairs_batch "Gudhi::cofaces_of_cubical_persistence_pairs_batch<Gudhi::Cubical_complex::Cubical_complex_interface>"(vector[unsigned] dimensions, const double* cells, size_t n, int homology_coeff_field, double min_persistence, size_t* offsets) nogil except +
 
 # CubicalComplex python interface
 cdef class CubicalComplex:
@@ -57,6 +69,8 @@ cdef class CubicalComplex:
     cdef Bitmap_cubical_complex_interface * thisptr
     cdef Cubical_complex_persistence_interface * pcohptr
     cdef bool _built_from_vertices
+    # Arguments of the last call to persistence() that did not need pcohptr
+    cdef object _persistence_args
 
     # Fake constructor that does nothing but documenting the constructor
     def __init__(self, *, top_dimensional_cells=None, vertices=None, dimensions=None, perseus_file=''):
@@ -103,6 +117,7 @@ cdef class CubicalComplex:
     def __cinit__(self, *, top_dimensional_cells=None, vertices=None, dimensions=None, perseus_file=''):
         cdef const char* file
         self._built_from_vertices = False
+        self._persistence_args = None
         if perseus_file:
             if top_dimensional_cells is not None or vertices is not None or dimensions is not None:
                 raise ValueError("The Perseus file contains all the information, do not specify anything else")
@@ -125,9 +140,38 @@ cdef class CubicalComplex:
             array = array.ravel(order='F')
         self._construct_from_cells(dimensions, array, vertices is None)
 
-    def _construct_from_cells(self, vector[unsigned] dimensions, vector[double] cells, bool input_top_cells):
-        with nogil:
-            self.thisptr = new Bitmap_cubical_complex_interface(dimensions, cells, input_top_cells)
+    def _construct_from_cells(self, vector[unsigned] dimensions, cells, bool input_top_cells):
+        # Images are often stored as uint8, uint16 or float32: read their buffer directly instead of copying it
+        # to a vector[double] first.
+        cdef const uint8_t[::1] cells_u8
+        cdef const uint16_t[::1] cells_u16
+        cdef const float[::1] cells_f32
+        cdef const double[::1] cells_f64
+        cdef vector[double] empty
+        cells = np.ravel(cells, order='A')
+        if cells.size == 0:
+            with nogil:
+                self.thisptr = new Bitmap_cubical_complex_interface(dimensions, empty, input_top_cells)
+        elif cells.dtype == np.uint8:
+            cells_u8 = np.ascontiguousarray(cells)
+            with nogil:
+                self.thisptr = new Bitmap_cubical_complex_interface(dimensions, &cells_u8[0], cells_u8.shape[0],
+                                                                    input_top_cells)
+        elif cells.dtype == np.uint16:
+            cells_u16 = np.ascontiguousarray(cells)
+            with nogil:
+                self.thisptr = new Bitmap_cubical_complex_interface(dimensions, &cells_u16[0], cells_u16.shape[0],
+                                                                    input_top_cells)
+        elif cells.dtype == np.float32:
+            cells_f32 = np.ascontiguousarray(cells)
+            with nogil:
+                self.thisptr = new Bitmap_cubical_complex_interface(dimensions, &cells_f32[0], cells_f32.shape[0],
+                                                                    input_top_cells)
+        else:
+            cells_f64 = np.ascontiguousarray(cells, dtype=np.float64)
+            with nogil:
+                self.thisptr = new Bitmap_cubical_complex_interface(dimensions, &cells_f64[0], cells_f64.shape[0],
+                                                                    input_top_cells)
 
     def _construct_from_file(self, const char* filename):
         with nogil:
@@ -216,7 +260,7 @@ cdef class CubicalComplex:
             self.pcohptr = new Cubical_complex_persistence_interface(self.thisptr, 1)
             self.pcohptr.compute_persistence(field, minp)
 
-    def persistence(self, homology_coeff_field=11, min_persistence=0):
+    def persistence(self, homology_coeff_field=11, min_persistence=0, max_intervals_per_dimension=None):
         """This function computes and returns the persistence of the complex.
 
         :param homology_coeff_field: The homology coefficient field. Must be a
@@ -227,11 +271,45 @@ cdef class CubicalComplex:
             0.0.
             Sets min_persistence to -1.0 to see all values.
         :type min_persistence: float.
+        :param max_intervals_per_dimension: If not None, only the given number of most persistent intervals of
+            each dimension are returned. They are selected while the intervals are converted, so the others are
+            never stored, which saves memory on noisy images with many tiny features. Default value is None.
+        :type max_intervals_per_dimension: int or None.
         :returns: list of pairs(dimension, pair(birth, death)) -- the
             persistence of the complex.
+
+        :note: The persistence of a 3d complex built from its top-dimensional cells is computed by a dedicated
+            algorithm, much faster on large images. It does not depend on homology_coeff_field, as the homology
+            of a subset of R^3 has no torsion. The functions that need :func:`compute_persistence` call it
+            with the same arguments when needed.
         """
+        if not self._built_from_vertices and self.thisptr.dimension() == 3 and self.num_simplices() > 0:
+            if self.pcohptr != NULL:
+                del self.pcohptr
+                self.pcohptr = NULL
+            self._persistence_args = (homology_coeff_field, min_persistence)
+            persistence = _persistence_on_cuboid_from_top_cells(self.top_dimensional_cells(), min_persistence)
+            if max_intervals_per_dimension is None:
+                return persistence
+            # The intervals are sorted by dimension, then by decreasing length
+            kept = []
+            count = {}
+            for interval in persistence:
+                count[interval[0]] = count.get(interval[0], 0) + 1
+                if count[interval[0]] <= max_intervals_per_dimension:
+                    kept.append(interval)
+            return kept
         self.compute_persistence(homology_coeff_field, min_persistence)
-        return self.pcohptr.get_persistence()
+        if max_intervals_per_dimension is None:
+            return self.pcohptr.get_persistence()
+        return self.pcohptr.get_persistence(<size_t>max_intervals_per_dimension)
+
+    def _compute_persistence_if_needed(self):
+        """Computes the persistence with :func:`compute_persistence` if the last call to :func:`persistence` used
+        the dedicated 3d algorithm.
+        """
+        if self.pcohptr == NULL and self._persistence_args is not None:
+            self.compute_persistence(*self._persistence_args)
 
     def cofaces_of_persistence_pairs(self):
         """A persistence interval is described by a pair of cells, one that creates the
@@ -267,6 +345,7 @@ cdef class CubicalComplex:
             integers of each row in each array correspond to: (index of positive top-dimensional cell).
         """
 
+        self._compute_persistence_if_needed()
         assert self.pcohptr != NULL, "compute_persistence() must be called before cofaces_of_persistence_pairs()"
         assert not self._built_from_vertices, (
                 "cofaces_of_persistence_pairs() only makes sense for a complex"
@@ -321,6 +400,7 @@ cdef class CubicalComplex:
             integers of each row in each array correspond to: (index of positive vertex).
         """
 
+        self._compute_persistence_if_needed()
         assert self.pcohptr != NULL, "compute_persistence() must be called before vertices_of_persistence_pairs()"
         assert self._built_from_vertices, (
                 "vertices_of_persistence_pairs() only makes sense for a complex"
@@ -360,6 +440,7 @@ cdef class CubicalComplex:
         :note: betti_numbers function always returns [1, 0, 0, ...] as infinity
             filtration cubes are not removed from the complex.
         """
+        self._compute_persistence_if_needed()
         assert self.pcohptr != NULL, "compute_persistence() must be called before betti_numbers()"
         return self.pcohptr.betti_numbers()
 
@@ -379,6 +460,7 @@ cdef class CubicalComplex:
         :note: persistent_betti_numbers function requires :func:`compute_persistence`
             function to be launched first.
         """
+        self._compute_persistence_if_needed()
         assert self.pcohptr != NULL, "compute_persistence() must be called before persistent_betti_numbers()"
         return self.pcohptr.persistent_betti_numbers(<double>from_value, <double>to_value)
 
@@ -394,9 +476,81 @@ cdef class CubicalComplex:
         :note: intervals_in_dim function requires :func:`compute_persistence` function to be
             launched first.
         """
+        self._compute_persistence_if_needed()
         assert self.pcohptr != NULL, "compute_persistence() must be called before persistence_intervals_in_dimension()"
         piid = np.array(self.pcohptr.intervals_in_dimension(dimension))
         # Workaround https://github.com/GUDHI/gudhi-devel/issues/507
         if len(piid) == 0:
             return np.empty(shape = [0, 2])
         return piid
+
+    def persistence_intervals_by_dimension(self, dtype=np.float64):
+        """This function returns the persistence intervals of the complex in all the dimensions at once. The arrays
+        are allocated once and filled by the C++ code, which is much faster than converting the list of
+        :func:`persistence` when there are many intervals.
+
+        :param dtype: Type of the births and deaths, `numpy.float64` (default) or `numpy.float32`.
+        :type dtype: numpy.dtype
+        :returns: The persistence intervals of each dimension, in the same order as
+            :func:`persistence_intervals_in_dimension`, until the last dimension that has some.
+        :rtype:  list of numpy array of shape (n,2)
+
+        :note: persistence_intervals_by_dimension function requires :func:`compute_persistence` function to be
+            launched first.
+        """
+        self._compute_persistence_if_needed()
+        assert self.pcohptr != NULL, "compute_persistence() must be called before persistence_intervals_by_dimension()"
+        dtype = np.dtype(dtype)
+        if dtype != np.float64 and dtype != np.float32:
+            raise ValueError("dtype must be numpy.float64 or numpy.float32")
+        cdef bool single_precision = dtype == np.float32
+        cdef vector[size_t] counts
+        with nogil:
+            counts = self.pcohptr.num_intervals_by_dimension()
+        intervals = [np.empty((n, 2), dtype=dtype) for n in counts]
+        cdef vector[uintptr_t] ptrs = [d.ctypes.data for d in intervals]
+        with nogil:
+            self.pcohptr.fill_intervals_by_dimension(ptrs, single_precision)
+        return intervals
+
+
+def _cofaces_of_persistence_pairs_batch(images, homology_coeff_field=11, min_persistence=0):
+    """Computes :func:`CubicalComplex.cofaces_of_persistence_pairs` for each image of a batch, with the images in
+    parallel and without the GIL. The cells are the pixels of the images, in C order.
+
+    :param images: The top-dimensional cells of the images, all of the same shape.
+    :type images: numpy.array of shape (N, d_1, ..., d_k)
+    :param homology_coeff_field: The homology coefficient field. Default value is 11.
+    :param min_persistence: The minimum persistence value to take into account. Default value is 0.
+    :returns: The regular and the essential pairs, in two lists with one element per dimension from 0 to k-1. Each
+        element is a pair of an array of flat pixel indices, of shape (M, 2) for the regular pairs and (M,) for the
+        essential ones, and of an array of row splits of shape (N+1,): the pairs of the image i are the rows from
+        row_splits[i] to row_splits[i+1].
+    :rtype: Tuple[List[Tuple[numpy.array[int32], numpy.array[int64]]], List[Tuple[numpy.array[int32], numpy.array[int64]]]]
+    """
+    images = np.ascontiguousarray(images, dtype=np.float64)
+    cdef size_t n = images.shape[0]
+    # CubicalComplex uses the Fortran order
+    cdef vector[unsigned] dimensions = images.shape[1:][::-1]
+    cdef const double[::1] cells = images.reshape(-1)
+    cdef const double* cells_ptr = &cells[0] if cells.shape[0] > 0 else NULL
+    offsets = np.empty(n + 1, dtype=np.uintp)
+    cdef size_t[::1] offsets_view = offsets
+    cdef int field = homology_coeff_field
+    cdef double minp = min_persistence
+    cdef vector[int] flat
+    with nogil:
+        flat = cofaces_of_cubical_persistence_pairs_batch(dimensions, cells_ptr, n, field, minp, &offsets_view[0])
+    if flat.size() > 0:
+        pairs = np.array(<int[:flat.size()]> flat.data(), dtype=np.int32).reshape(-1, 3)
+    else:
+        pairs = np.empty((0, 3), dtype=np.int32)
+    image_of_pair = np.repeat(np.arange(n), np.diff(offsets))
+    regular, essential = [], []
+    for dim in range(images.ndim - 1):
+        for output, selected, columns in ((regular, (pairs[:, 0] == dim) & (pairs[:, 2] != -1), [1, 2]),
+                                          (essential, (pairs[:, 0] == dim) & (pairs[:, 2] == -1), 1)):
+            row_splits = np.zeros(n + 1, dtype=np.int64)
+            np.cumsum(np.bincount(image_of_pair[selected], minlength=n), out=row_splits[1:])
+            output.append((pairs[selected][:, columns], row_splits))
+    return regular, essential
@@ -10,18 +10,32 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
+#include <pybind11/stl.h>
 
 #include <gudhi/random_point_generators.h>
+#include <gudhi/flat_random_point_generators.h>
 #include <gudhi/Debug_utils.h>
 
 #include <CGAL/Epick_d.h>
 
+#include <cstdint>  // for std::uint64_t
+#include <optional>
+#include <random>  // for std::random_device
+
 namespace py = pybind11;
 
 
 typedef CGAL::Epick_d< CGAL::Dynamic_dimension_tag > Kern;
 
-py::array_t<double> generate_points_on_sphere(size_t n_samples, int ambient_dim, double radius, std::string sample) {
+// A random seed when none is given
+std::uint64_t seed_or_random(std::optional<std::uint64_t> seed) {
+    if (seed) return *seed;
+    std::random_device rd;
+    return (std::uint64_t(rd()) << 32) ^ rd();
+}
+
+py::array_t<double> generate_points_on_sphere(size_t n_samples, int ambient_dim, double radius, std::string sample,
+                                              std::optional<std::uint64_t> seed) {
 
     if (sample != "random") {
         throw pybind11::value_error("This sample type is not supported");
@@ -35,27 +49,34 @@ py::array_t<double> generate_points_on_sphere(size_t n_samples, int ambient_dim,
     GUDHI_CHECK(n_samples == buf.shape[0], "Py array first dimension not matching n_samples on sphere");
     GUDHI_CHECK(ambient_dim == buf.shape[1], "Py array second dimension not matching the ambient space dimension");
 
-
-    std::vector<typename Kern::Point_d> points_generated;
-
+    const std::uint64_t s = seed_or_random(seed);
     {
         py::gil_scoped_release release;
-        points_generated = Gudhi::generate_points_on_sphere_d<Kern>(n_samples, ambient_dim, radius);
+        // Generated in parallel directly in the numpy array
+        Gudhi::generate_flat_points_on_sphere_d(n_samples, ambient_dim, radius, s, ptr);
     }
 
-    for (size_t i = 0; i < n_samples; i++)
-        for (int j = 0; j < ambient_dim; j++)
-            ptr[i*ambient_dim+j] = points_generated[i][j];
-
     return points;
 }
 
-py::array_t<double> generate_points_on_torus(size_t n_samples, int dim, std::string sample) {
+py::array_t<double> generate_points_on_torus(size_t n_samples, int dim, std::string sample,
+                                             std::optional<std::uint64_t> seed) {
 
     if ( (sample != "random") && (sample != "grid")) {
         throw pybind11::value_error("This sample type is not supported");
     }
 
+    if (sample == "random") {
+        py::array_t<double> points({n_samples, (size_t)2*dim});
+        double *ptr = static_cast<double *>(points.request().ptr);
+        const std::uint64_t s = seed_or_random(seed);
+        {
+            py::gil_scoped_release release;
+            Gudhi::generate_flat_points_on_torus_d(n_samples, dim, s, ptr);
+        }
+        return points;
+    }
+
     std::vector<typename Kern::Point_d> points_generated;
 
     {
@@ -84,7 +105,7 @@ PYBIND11_MODULE(_points, m) {
 
     m.def("sphere", &generate_points_on_sphere,
           py::arg("n_samples"), py::arg("ambient_dim"),
-          py::arg("radius") = 1., py::arg("sample") = "random",
+          py::arg("radius") = 1., py::arg("sample") = "random", py::arg("seed") = py::none(),
           R"pbdoc(
           Generate random i.i.d. points uniformly on a (d-1)-sphere in R^d
 
@@ -96,11 +117,14 @@ PYBIND11_MODULE(_points, m) {
           :type radius: float
           :param sample: The sample type. Default and only available value is `"random"`.
           :type sample: string
+          :param seed: The seed of the generator. The points are generated in parallel, and only depend on the seed,
+              not on the number of threads. Default is None, for a random seed.
+          :type seed: integer
           :returns: the generated points on a sphere.
           )pbdoc");
 
     m.def("ctorus", &generate_points_on_torus,
-          py::arg("n_samples"), py::arg("dim"), py::arg("sample") = "random",
+          py::arg("n_samples"), py::arg("dim"), py::arg("sample") = "random", py::arg("seed") = py::none(),
           R"pbdoc(
           Generate random i.i.d. points on a d-torus in R^2d or as a grid
 
@@ -110,6 +134,9 @@ PYBIND11_MODULE(_points, m) {
           :type dim: integer
           :param sample: The sample type. Available values are: `"random"` and `"grid"`. Default value is `"random"`.
           :type sample: string
+          :param seed: The seed of the generator of the random sample, as for :func:`sphere`. Default is None, for a
+              random seed.
+          :type seed: integer
           :returns: the generated points on a torus.
 
           The shape of returned numpy array is:
@@ -9,7 +9,7 @@
 
 
 from gudhi.weighted_rips_complex import WeightedRipsComplex
-from gudhi.point_cloud.dtm import DistanceToMeasure
+from gudhi.rips_complex import _distance_to_measure
 from scipy.spatial.distance import cdist
 import numpy as np
 
@@ -45,6 +45,5 @@ class DTMRipsComplex(WeightedRipsComplex):
         if k <= 1:
             self.weights = [0] * len(distance_matrix)
         else:
-            dtm = DistanceToMeasure(k, q=q, metric="precomputed")
-            self.weights = dtm.fit_transform(distance_matrix)
+            self.weights = np.array(_distance_to_measure(distance_matrix, k, q))
         self.max_filtration = max_filtration
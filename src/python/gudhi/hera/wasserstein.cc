@@ -130,6 +130,28 @@ py::object wasserstein_distance(
   return py::make_tuple(dist, ret);
 }
 
+// All the distances between the packed diagrams of X, or between those of X and Y, each diagram being converted once.
+py::array_t<double> wasserstein_matrix(Packed_coords X, Packed_offsets X_offsets,
+                                       std::optional<Packed_coords> Y, std::optional<Packed_offsets> Y_offsets,
+                                       double wasserstein_power, double internal_p, double delta, int n_jobs)
+{
+  auto diags1 = unpack_diagrams(X, X_offsets, make_hera_point);
+  std::optional<decltype(diags1)> diags2;
+  if(Y) {
+    if(!Y_offsets) throw std::runtime_error("Y needs offsets");
+    diags2 = unpack_diagrams(*Y, *Y_offsets, make_hera_point);
+  }
+  hera::AuctionParams<double> params;
+  params.wasserstein_power = wasserstein_power;
+  // hera encodes infinity as -1...
+  if(std::isinf(internal_p)) internal_p = hera::get_infinity<double>();
+  params.internal_p = internal_p;
+  params.delta = delta;
+  return diagram_distance_matrix(diags1, diags2, [params](auto const& d1, auto const& d2) {
+      return std::pow(hera::wasserstein_cost_detailed(d1, d2, params).cost, 1./params.wasserstein_power);
+    }, n_jobs);
+}
+
 PYBIND11_MODULE(wasserstein, m) {
       m.def("wasserstein_distance", &wasserstein_distance,
           py::arg("X"), py::arg("Y"),
@@ -152,4 +174,11 @@ PYBIND11_MODULE(wasserstein, m) {
         Returns:
             float|Tuple[float,numpy.array|None]: Approximate Wasserstein distance W_q(X,Y), and optionally the corresponding matching
     )pbdoc");
+      m.def("_wasserstein_distance_matrix", &wasserstein_matrix,
+          py::arg("X"), py::arg("X_offsets"), py::arg("Y") = py::none(), py::arg("Y_offsets") = py::none(),
+          py::arg("order") = 1,
+          py::arg("internal_p") = std::numeric_limits<double>::infinity(),
+          py::arg("delta") = .01,
+          py::arg("n_jobs") = 1,
+          "Wasserstein distances between packed diagrams, see gudhi.representations.pairwise_persistence_diagram_distances");
 }
@@ -36,6 +36,7 @@ cdef extern from "Nerve_gic_interface.h" namespace "Gudhi":
         vector[pair[double, double]] compute_PD()
         void find_simplices()
         void create_simplex_tree(Simplex_tree_interface_full_featured* simplex_tree)
+        void create_simplex_trees_from_sweep(vector[pair[int, double]] parameters, vector[Simplex_tree_interface_full_featured*] simplex_trees)
         bool read_point_cloud(string off_file_name)
         double set_automatic_resolution()
         void set_color_from_coordinate(int k)
@@ -54,6 +55,7 @@ cdef extern from "Nerve_gic_interface.h" namespace "Gudhi":
         void set_graph_from_OFF()
         void set_graph_from_euclidean_rips(double threshold)
         void set_mask(int nodemask)
+        void set_distance_storage(bool store)
         void set_resolution_with_interval_length(double resolution)
         void set_resolution_with_interval_number(int resolution)
         void set_subsampling(double constant, double power)
@@ -177,6 +179,27 @@ cdef class CoverComplex:
             <Simplex_tree_interface_full_featured*>stree_int_ptr)
         return stree
 
+    def create_simplex_trees_from_sweep(self, parameters):
+        """Computes the simplex trees of the covers from the preimages of the
+        function, for several numbers of intervals and gains. The points are
+        sorted and the connected components of the preimages are computed only
+        once for all the parameters. After the call, the cover is the one of
+        the last parameters.
+
+        :param parameters: Pairs of a number of intervals and a gain.
+        :type parameters: List[Tuple[int, float]]
+        :returns: The simplex trees, one per pair of parameters.
+        :rtype: List[SimplexTree]
+        """
+        strees = [SimplexTree() for _ in parameters]
+        cdef vector[Simplex_tree_interface_full_featured*] stree_ptrs
+        cdef intptr_t stree_int_ptr
+        for stree in strees:
+            stree_int_ptr = stree.thisptr
+            stree_ptrs.push_back(<Simplex_tree_interface_full_featured*>stree_int_ptr)
+        self.thisptr.create_simplex_trees_from_sweep(parameters, stree_ptrs)
+        return strees
+
     def find_simplices(self):
         """Computes the simplices of the simplicial complex.
         """
@@ -358,6 +381,17 @@ cdef class CoverComplex:
         """
         self.thisptr.set_mask(nodemask)
 
+    def set_distance_storage(self, store):
+        """Specifies whether the pairwise distances are stored in a dense
+        matrix (the default), or computed when they are needed, which uses
+        much less memory on large point clouds.
+
+        :param store: true = store the distance matrix, false = compute the
+            distances on demand.
+        :type store: boolean
+        """
+        self.thisptr.set_distance_storage(store)
+
     def set_resolution_with_interval_length(self, resolution):
         """Sets a length of intervals from a value stored in memory.
 
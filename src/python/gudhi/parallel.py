@@ -0,0 +1,140 @@
+# This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+# See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+# Author(s):       David Loiseaux
+#
+# Copyright (C) 2023 Inria
+#
+# Modification(s):
+#   - YYYY/MM Author: Description of the modification
+
+"""The pool of threads shared by the batch computations of gudhi, e.g. the scikit-learn transformers of
+:mod:`gudhi.sklearn` and :mod:`gudhi.representations`. Their C++ loops run on the threads of the pool without the
+GIL, and their parameter `n_jobs` selects how many of these threads a call may use. When gudhi is built with TBB, the
+pool is the one of TBB, so that concurrent calls do not oversubscribe the machine and no thread is started per call.
+"""
+
+import threading
+from concurrent.futures import CancelledError, Future, ThreadPoolExecutor
+
+from gudhi._thread_pool import _set_max_threads, _max_threads
+
+__author__ = "David Loiseaux"
+__copyright__ = "Copyright (C) 2023 Inria"
+__license__ = "MIT"
+
+__all__ = ["set_num_threads", "get_num_threads"]
+
+_executor = None
+_executor_lock = threading.Lock()
+# Set in the threads of the executor, whose tasks must not wait for other tasks of the executor
+_in_pool = threading.local()
+
+
+def set_num_threads(n):
+    """Sets the number of threads of the pool. The default is the number of threads of the machine.
+
+    :param n: Number of threads, or None to restore the default.
+    :type n: int or None
+    :raises ValueError: If `n` is not positive.
+    """
+    global _executor
+    if n is not None and n < 1:
+        raise ValueError("The number of threads must be positive")
+    _set_max_threads(0 if n is None else int(n))
+    with _executor_lock:
+        if _executor is not None:
+            _executor.shutdown(wait=False)
+            _executor = None
+
+
+def get_num_threads():
+    """Number of threads of the pool.
+
+    :rtype: int
+    """
+    return _max_threads()
+
+
+def _native_n_jobs(n_jobs):
+    # Number of threads of the pool for a call, from n_jobs with the same meaning as for joblib, None meaning 1 and
+    # -1 all the threads of the pool
+    n = get_num_threads()
+    if n_jobs is None:
+        return 1
+    if n_jobs <= 0:
+        return max(1, n + 1 + n_jobs) if n_jobs < 0 else n
+    return min(n, n_jobs)
+
+
+def _get_executor():
+    global _executor
+    with _executor_lock:
+        if _executor is None:
+            _executor = ThreadPoolExecutor(
+                max_workers=get_num_threads(), thread_name_prefix="gudhi", initializer=_mark_pool_thread
+            )
+        return _executor
+
+
+def _mark_pool_thread():
+    _in_pool.active = True
+
+
+def _map(f, items, n_jobs):
+    """`[f(x) for x in items]`, computed on at most `n_jobs` (with the meaning of joblib) threads of the shared pool,
+    for functions that release the GIL. The items are processed by contiguous chunks, one per thread.
+    """
+    items = list(items)
+    n = min(_native_n_jobs(n_jobs), len(items))
+    if n <= 1 or getattr(_in_pool, "active", False):
+        return [f(x) for x in items]
+    bounds = [len(items) * k // n for k in range(n + 1)]
+    futures = [
+        _get_executor().submit(lambda chunk: [f(x) for x in chunk], items[bounds[k] : bounds[k + 1]]) for k in range(n)
+    ]
+    return [y for future in futures for y in future.result()]
+
+
+class _CancellableFuture(Future):
+    """`concurrent.futures.Future` of a computation of the `*_async` methods, e.g.
+    :func:`~gudhi.SimplexTree.persistence_async`, whose :func:`cancel` also stops the computation when it is running.
+    """
+
+    def __init__(self, flag):
+        super().__init__()
+        self._flag = flag
+
+    def cancel(self):
+        """Cancels the computation if it is not running yet, like `concurrent.futures.Future.cancel`. Otherwise, asks
+        the running computation to stop at its next check, after which :func:`result` raises
+        `concurrent.futures.CancelledError`, unless it was already complete.
+
+        :returns: Whether the computation was cancelled before it started.
+        :rtype: bool
+        """
+        self._flag.cancel()
+        return super().cancel()
+
+
+def _submit_cancellable(f, flag, exchange_flag):
+    """Runs `f()` on a thread of the shared pool, and returns its `_CancellableFuture`. `flag` is a new cancellation
+    flag, e.g. a `gudhi.simplex_tree._CancellationFlag`, and `exchange_flag` the function of the compiled module of the
+    computation that sets the flag checked by the computations of the current thread, and returns the previous one.
+    """
+    future = _CancellableFuture(flag)
+
+    def run():
+        if not future.set_running_or_notify_cancel():
+            return
+        previous = exchange_flag(flag._address())
+        try:
+            result = f()
+        except BaseException as e:
+            exchange_flag(previous)
+            future.set_exception(CancelledError() if flag.is_cancelled() else e)
+        else:
+            exchange_flag(previous)
+            future.set_result(result)
+
+    _get_executor().submit(run)
+    return future
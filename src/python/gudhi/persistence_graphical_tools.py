@@ -8,6 +8,7 @@
 #   - 2020/02 Theo Lacombe: Added more options for improved rendering and more flexibility.
 #   - 2022/11 Vincent Rouvreau: "Automatic" legend display detected by _array_handler that returns if the persistence
 #                               was a nx2 array.
+#   - 2023/10 David Loiseaux: Binned rendering of diagrams and densities with many points.
 #   - YYYY/MM Author: Description of the modification
 
 from os import path
@@ -86,12 +87,82 @@ def _limit_to_max_intervals(persistence, max_intervals, key):
             "There are %s intervals given as input, whereas max_intervals is set to %s."
             % (len(persistence), max_intervals)
         )
-        # Sort by life time, then takes only the max_intervals elements
-        return sorted(persistence, key=key, reverse=True)[:max_intervals]
+        # Select the max_intervals longest life times without sorting all of them, keeping the first ones in the
+        # input order in case of ties, then sort the selected ones by decreasing life time (stable)
+        life_times = -np.array([key(interval) for interval in persistence], dtype=float)
+        kth = np.partition(life_times, max_intervals - 1)[max_intervals - 1]
+        longer = np.flatnonzero(life_times < kth)
+        ties = np.flatnonzero(life_times == kth)[: max_intervals - len(longer)]
+        selected = np.concatenate((longer, ties))
+        selected = selected[np.lexsort((selected, life_times[selected]))]
+        if isinstance(persistence, np.ndarray):
+            return persistence[selected]
+        return [persistence[i] for i in selected]
     else:
         return persistence
 
 
+def _plot_binned_diagram(axes, births, deaths, dimensions, colormap, alpha, nbins, extent):
+    """This function draws the points of a persistence diagram as one image per dimension, where each pixel of a
+    nbins x nbins grid over extent has the color of the dimension and an opacity that grows with the logarithm of the
+    number of points it contains.
+
+    :param births: birth values of the points.
+    :type births: numpy array of float.
+    :param deaths: death values of the points, with infinity already replaced.
+    :type deaths: numpy array of float.
+    :param dimensions: dimension of the points.
+    :type dimensions: numpy array of int.
+    :param extent: (x_min, x_max, y_min, y_max) of the grid.
+    :type extent: tuple of float.
+    """
+    from matplotlib.colors import to_rgb
+
+    x_min, x_max, y_min, y_max = extent
+    for dim in np.unique(dimensions):
+        selected = dimensions == dim
+        counts, _, _ = np.histogram2d(
+            deaths[selected], births[selected], bins=nbins, range=[[y_min, y_max], [x_min, x_max]]
+        )
+        image = np.zeros(counts.shape + (4,))
+        image[..., :3] = to_rgb(colormap[dim])
+        # A single point must remain visible next to bins with millions of them
+        image[..., 3] = alpha * np.where(counts > 0, 0.25 + 0.75 * np.log1p(counts) / np.log1p(counts.max()), 0.0)
+        axes.imshow(image, extent=extent, origin="lower", aspect="auto", interpolation="nearest")
+
+
+def _binned_kde(births, deaths, covariance, x_grid, y_grid):
+    """This function returns the values on the x_grid x y_grid grid of the gaussian kde of the points with the given
+    kernel covariance, approximated by binning the points on the grid and convolving the counts with the kernel, in
+    a time that does not depend on the number of points.
+
+    :param covariance: covariance matrix of the gaussian kernel, e.g. `scipy.stats.gaussian_kde.covariance`.
+    :type covariance: 2x2 numpy array.
+    :param x_grid: regularly spaced birth values (at least 2).
+    :type x_grid: numpy array of float.
+    :param y_grid: regularly spaced death values (at least 2).
+    :type y_grid: numpy array of float.
+    :returns: numpy array of shape (len(x_grid), len(y_grid)).
+    """
+    from scipy.signal import fftconvolve
+
+    dx = x_grid[1] - x_grid[0]
+    dy = y_grid[1] - y_grid[0]
+    x_edges = np.append(x_grid - dx / 2, x_grid[-1] + dx / 2)
+    y_edges = np.append(y_grid - dy / 2, y_grid[-1] + dy / 2)
+    counts, _, _ = np.histogram2d(births, deaths, bins=[x_edges, y_edges])
+    # The kernel sampled on the grid, up to 4 standard deviations (and no further than the size of the grid)
+    rx = int(min(np.ceil(4 * np.sqrt(covariance[0, 0]) / dx), len(x_grid)))
+    ry = int(min(np.ceil(4 * np.sqrt(covariance[1, 1]) / dy), len(y_grid)))
+    u, v = np.mgrid[-rx : rx + 1, -ry : ry + 1]
+    u = u * dx
+    v = v * dy
+    inverse = np.linalg.inv(covariance)
+    kernel = np.exp(-0.5 * (inverse[0, 0] * u * u + 2 * inverse[0, 1] * u * v + inverse[1, 1] * v * v))
+    kernel /= 2 * np.pi * np.sqrt(np.linalg.det(covariance))
+    return np.maximum(fftconvolve(counts, kernel, mode="same"), 0.0) / len(births)
+
+
 @lru_cache(maxsize=1)
 def _matplotlib_can_use_tex():
     """This function returns True if matplotlib can deal with LaTeX, False otherwise.
@@ -239,6 +310,8 @@ def plot_persistence_diagram(
     axes=None,
     fontsize=16,
     greyblock=True,
+    max_scatter_points=100000,
+    nbins=300,
 ):
     r"""This function plots the persistence diagram from persistence values
     list, a np.array of shape (N x 2) representing a diagram in a single
@@ -275,6 +348,13 @@ def plot_persistence_diagram(
     :type fontsize: int
     :param greyblock: if we want to plot a grey patch on the lower half plane for nicer rendering. Default True.
     :type greyblock: boolean
+    :param max_scatter_points: maximal number of points drawn one by one. Beyond it, the points are binned on a grid
+        of nbins x nbins, drawn as an image whose opacity grows with the number of points in each bin, which remains
+        fast for diagrams of millions of points. Set it to 0 to always draw the points one by one. Default value is
+        100000.
+    :type max_scatter_points: int
+    :param nbins: number of bins along each axis when the points are binned (default is 300).
+    :type nbins: int
     :returns: (`matplotlib.axes.Axes`): The axes on which the plot was drawn.
     """
     try:
@@ -339,12 +419,19 @@ def plot_persistence_diagram(
         # line display of equation : birth = death
         axes.plot([axis_start, axis_end], [axis_start, axis_end], linewidth=1.0, color="k")
 
-        x = [birth for (dim, (birth, death)) in persistence]
-        y = [death if death != float("inf") else infinity for (dim, (birth, death)) in persistence]
-        c = [colormap[dim] for (dim, (birth, death)) in persistence]
+        x = np.array([birth for (dim, (birth, death)) in persistence], dtype=float)
+        y = np.array([death for (dim, (birth, death)) in persistence], dtype=float)
+        dims = np.array([dim for (dim, (birth, death)) in persistence], dtype=int)
+        has_infinity = np.isinf(y).any()
+        y[np.isinf(y)] = infinity
 
-        axes.scatter(x, y, alpha=alpha, color=c)
-        if float("inf") in (death for (dim, (birth, death)) in persistence):
+        if 0 < max_scatter_points < len(x):
+            _plot_binned_diagram(
+                axes, x, y, dims, colormap, alpha, nbins, (axis_start, axis_end, axis_start, infinity + delta / 2)
+            )
+        else:
+            axes.scatter(x, y, alpha=alpha, color=[colormap[dim] for dim in dims])
+        if has_infinity:
             # infinity line and text
             axes.plot([axis_start, axis_end], [infinity, infinity], linewidth=1.0, color="k", alpha=alpha)
             # Infinity label
@@ -390,6 +477,7 @@ def plot_persistence_density(
     axes=None,
     fontsize=16,
     greyblock=False,
+    max_kde_points=10000,
 ):
     """This function plots the persistence density from persistence values list, np.array of shape (N x 2) representing
     a diagram in a single homology dimension, or from a `persistence diagram <fileformats.html#persistence-diagram>`_
@@ -427,6 +515,11 @@ def plot_persistence_density(
     :type fontsize: int
     :param greyblock: if we want to plot a grey patch on the lower half plane for nicer rendering. Default False.
     :type greyblock: boolean
+    :param max_kde_points: maximal number of points for which the gaussian kde is evaluated exactly on the grid.
+        Beyond it, the points are binned on the grid and the counts are convolved with the kernel of the kde, which
+        costs the same for any number of points. Set it to 0 to always evaluate the kde exactly. Default value is
+        10000.
+    :type max_kde_points: int
     :returns: (`matplotlib.axes.Axes`): The axes on which the plot was drawn.
     """
     try:
@@ -490,9 +583,12 @@ def plot_persistence_density(
                 birth_min : birth_max : nbins * 1j,
                 death_min : death_max : nbins * 1j,
             ]
-            zi = k(np.vstack([xi.ravel(), yi.ravel()]))
+            if 0 < max_kde_points < len(birth) and nbins > 1:
+                zi = _binned_kde(birth, death, k.covariance, xi[:, 0], yi[0, :])
+            else:
+                zi = k(np.vstack([xi.ravel(), yi.ravel()])).reshape(xi.shape)
             # Make the plot
-            img = axes.pcolormesh(xi, yi, zi.reshape(xi.shape), cmap=cmap, shading="auto")
+            img = axes.pcolormesh(xi, yi, zi, cmap=cmap, shading="auto")
             plot_success = True
 
         # IndexError on empty diagrams, ValueError on only inf death values
@@ -0,0 +1,102 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <gudhi/Kd_tree_search.h>
+
+#include <CGAL/Epick_d.h>
+
+#include <Thread_pool.h>
+
+namespace py = pybind11;
+
+// Kd-tree on a copy of the reference points, queried in batches.
+class Knn_tree {
+  typedef CGAL::Epick_d<CGAL::Dynamic_dimension_tag> Kernel;
+  typedef Kernel::Point_d Point;
+  typedef std::vector<Point> Points;
+  typedef Gudhi::spatial_searching::Kd_tree_search<Kernel, Points> Tree;
+
+  // The points are converted to double, float32 inputs only save memory on the Python side.
+  template <class T>
+  static Points to_points(py::array_t<T, py::array::c_style | py::array::forcecast> const& data) {
+    py::buffer_info buf = data.request();
+    if (buf.ndim != 2) throw std::runtime_error("Data must be a 2-dimensional array");
+    T const* p = static_cast<T const*>(buf.ptr);
+    py::ssize_t n = buf.shape[0], d = buf.shape[1];
+    py::gil_scoped_release release;
+    Points points;
+    points.reserve(n);
+    for (py::ssize_t i = 0; i < n; ++i) points.emplace_back(p + i * d, p + (i + 1) * d);
+    return points;
+  }
+
+ public:
+  // The tree refers to points_, which must not move
+  Knn_tree(Knn_tree const&) = delete;
+  Knn_tree& operator=(Knn_tree const&) = delete;
+
+  template <class T>
+  explicit Knn_tree(py::array_t<T, py::array::c_style | py::array::forcecast> data)
+      : points_(to_points(data)), dimension_(data.shape(1)) {
+    py::gil_scoped_release release;
+    tree_ = std::make_unique<Tree>(points_);
+  }
+
+  // Returns the indices and the distances (not squared) of the k nearest neighbors of each query, with the same
+  // number type as the queries.
+  template <class T>
+  py::tuple query(py::array_t<T, py::array::c_style | py::array::forcecast> data, unsigned k, bool sort_results,
+                  double eps, int n_jobs) const {
+    if (data.ndim() != 2 || data.shape(1) != dimension_)
+      throw std::runtime_error("The query points must have the same dimension as the reference points");
+    if (k > points_.size()) throw std::runtime_error("k is larger than the number of reference points");
+    Points queries = to_points(data);
+    py::array_t<std::int64_t> indices({queries.size(), static_cast<std::size_t>(k)});
+    py::array_t<T> distances({queries.size(), static_cast<std::size_t>(k)});
+    std::int64_t* out_indices = indices.mutable_data();
+    T* out_distances = distances.mutable_data();
+    {
+      py::gil_scoped_release release;
+      typename Tree::Batch_neighbors neighbors;
+      auto run = [&] { neighbors = tree_->k_nearest_neighbors_batch(queries, k, sort_results, eps); };
+      // The batch is parallelized by TBB, on n_jobs threads of the shared pool (all if 0)
+      Gudhi::thread_pool::execute(n_jobs, run);
+      for (std::size_t i = 0; i < neighbors.indices.size(); ++i) {
+        out_indices[i] = static_cast<std::int64_t>(neighbors.indices[i]);
+        out_distances[i] = static_cast<T>(std::sqrt(neighbors.squared_distances[i]));
+      }
+    }
+    return py::make_tuple(indices, distances);
+  }
+
+ private:
+  Points points_;
+  py::ssize_t dimension_;
+  std::unique_ptr<Tree> tree_;
+};
+
+PYBIND11_MODULE(_knn, m) {
+  py::class_<Knn_tree>(m, "_KnnTree")
+      .def(py::init<py::array_t<float, py::array::c_style | py::array::forcecast>>(), py::arg("data").noconvert())
+      .def(py::init<py::array_t<double, py::array::c_style | py::array::forcecast>>(), py::arg("data"))
+      .def("query", &Knn_tree::query<float>, py::arg("data").noconvert(), py::arg("k"), py::arg("sort_results"),
+           py::arg("eps"), py::arg("n_jobs"))
+      .def("query", &Knn_tree::query<double>, py::arg("data"), py::arg("k"), py::arg("sort_results"),
+           py::arg("eps"), py::arg("n_jobs"));
+}
@@ -17,6 +17,14 @@ __copyright__ = "Copyright (C) 2020 Inria"
 __license__ = "MIT"
 
 
+def _has_gudhi_knn():
+    try:
+        from gudhi.point_cloud import _knn
+    except ImportError:
+        return False
+    return True
+
+
 class KNearestNeighbors:
     """
     Class wrapping several implementations for computing the k nearest neighbors in a point set.
@@ -42,9 +50,13 @@ class KNearestNeighbors:
                   algorithm="brute".
                 * 'hnsw' for hnswlib.Index. It can be very fast but does not provide guarantees. Only supports
                   "euclidean" for now.
-                * None will try to select a sensible one (scipy if possible, scikit-learn otherwise).
+                * 'gudhi' for GUDHI's own kd-tree, queried in parallel. It supports float32 inputs, for which it
+                  returns float32 distances. Only supports "euclidean" for now, and requires GUDHI to be compiled
+                  with CGAL.
+                * None will try to select a sensible one ('gudhi' for "euclidean" if available, scipy for other
+                  "minkowski" metrics, scikit-learn otherwise).
             metric (str): see `sklearn.neighbors.NearestNeighbors`.
-            eps (float): relative error when computing nearest neighbors with the cKDTree.
+            eps (float): relative error when computing nearest neighbors with the cKDTree or 'gudhi'.
             p (float): norm L^p on input points (including numpy.inf) if metric is "minkowski". Defaults to 2.
             n_jobs (int): number of jobs to schedule for parallel processing of nearest neighbors on the CPU.
                 If -1 is given all processors are used. Default: 1.
@@ -78,10 +90,12 @@ class KNearestNeighbors:
             self.params["p"] = kwargs.get("p", 2)
         if self.params.get("implementation") in {"keops", "ckdtree"}:
             assert self.metric == "minkowski"
-        if self.params.get("implementation") == "hnsw":
+        if self.params.get("implementation") in {"hnsw", "gudhi"}:
             assert self.metric == "minkowski" and self.params["p"] == 2
         if not self.params.get("implementation"):
-            if self.metric == "minkowski":
+            if self.metric == "minkowski" and self.params["p"] == 2 and _has_gudhi_knn():
+                self.params["implementation"] = "gudhi"
+            elif self.metric == "minkowski":
                 self.params["implementation"] = "ckdtree"
             else:
                 self.params["implementation"] = "sklearn"
@@ -109,6 +123,11 @@ class KNearestNeighbors:
                 # I don't know a clever way to reuse a GPU tensor from tensorflow in pytorch
                 # without copying to/from the CPU.
                 X = X.numpy()
+        if self.params["implementation"] == "gudhi":
+            from gudhi.point_cloud._knn import _KnnTree
+
+            self.gudhi_tree = _KnnTree(X)
+
         if self.params["implementation"] == "ckdtree":
             # sklearn could handle this, but it is much slower
             from scipy.spatial import cKDTree
@@ -324,6 +343,20 @@ class KNearestNeighbors:
                 return distances
             return None
 
+        if self.params["implementation"] == "gudhi":
+            n_jobs = self.params.get("n_jobs", 1)
+            neighbors, distances = self.gudhi_tree.query(
+                X, k, self.params.get("sort_results", True), self.params.get("eps", 0.0), n_jobs
+            )
+            if self.return_index:
+                if self.return_distance:
+                    return neighbors, distances
+                else:
+                    return neighbors
+            if self.return_distance:
+                return distances
+            return None
+
         if self.params["implementation"] == "ckdtree":
             qargs = {key: val for key, val in self.params.items() if key in {"p", "eps"}}
             # SciPy renamed n_jobs to workers
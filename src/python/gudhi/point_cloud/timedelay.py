@@ -34,7 +34,7 @@ class TimeDelayEmbedding:
                        [6, 7, 8, 9]]
     """
 
-    def __init__(self, dim=3, delay=1, skip=1):
+    def __init__(self, dim=3, delay=1, skip=1, copy=True):
         """
         Constructor for the TimeDelayEmbedding class.
 
@@ -42,10 +42,16 @@ class TimeDelayEmbedding:
             dim (int): `d` of R^d to be embedded. Optional (default=3).
             delay (int): Time-Delay embedding. Optional (default=1).
             skip (int): How often to skip embedded points. Optional (default=1).
+            copy (bool): If False, the point clouds are read-only views of the time-series, with strides, instead of
+                copies, so that a long time-series is not duplicated `dim` times. Their float32 or float64
+                coordinates are then read in place by :class:`~gudhi.RipsComplex`, :func:`~gudhi.rips_persistence`
+                or :class:`~gudhi.AlphaComplex`. This is not possible for a vector time-series whose rows are not
+                contiguous, or with a delay, in which case a copy is returned. Optional (default=True).
         """
         self._dim = dim
         self._delay = delay
         self._skip = skip
+        self._copy = copy
 
     def __call__(self, ts):
         """Transform method for single time-series data.
@@ -60,7 +66,7 @@ class TimeDelayEmbedding:
         point cloud : n x dim numpy arrays
             Makes point cloud from a single time-series data.
         """
-        return self._transform(np.array(ts))
+        return self._transform(np.asarray(ts))
 
     def fit(self, ts, y=None):
         return self
@@ -73,9 +79,22 @@ class TimeDelayEmbedding:
             assert self._dim % ts.shape[1] == 0
             repeat = self._dim // ts.shape[1]
         end = len(ts) - self._delay * (repeat - 1)
-        short = np.arange(0, end, self._skip)
-        vertical = np.arange(0, repeat * self._delay, self._delay)
-        return ts[np.add.outer(short, vertical)].reshape(len(short), -1)
+        num_points = len(range(0, max(end, 0), self._skip))
+        # The coordinate j of the point i is ts[i * skip + j * delay]: a view of ts with strides, without any copy
+        if ts.ndim == 1:
+            shape = (num_points, repeat)
+            strides = (self._skip * ts.strides[0], self._delay * ts.strides[0])
+        elif self._delay == 1 and ts.strides[0] == ts.shape[1] * ts.strides[1]:
+            # The point i is made of the consecutive rows from i * skip, as contiguous coordinates
+            shape = (num_points, self._dim)
+            strides = (self._skip * ts.strides[0], ts.strides[1])
+        else:
+            shape = (num_points, repeat, ts.shape[1])
+            strides = (self._skip * ts.strides[0], self._delay * ts.strides[0], ts.strides[1])
+        view = np.lib.stride_tricks.as_strided(ts, shape=shape, strides=strides, writeable=False)
+        if self._copy or view.ndim == 3:
+            return np.array(view).reshape(num_points, -1)
+        return view
 
     def transform(self, ts):
         """Transform method for multiple time-series data.
@@ -90,4 +109,4 @@ class TimeDelayEmbedding:
         point clouds : list of n x dim numpy arrays
             Makes point cloud from each time-series data.
         """
-        return [self._transform(np.array(s)) for s in ts]
+        return [self._transform(np.asarray(s)) for s in ts]
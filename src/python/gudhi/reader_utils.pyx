@@ -15,6 +15,7 @@ from libcpp.pair cimport pair
 
 from os import path
 from numpy import array as np_array
+import numpy as np
 
 __author__ = "Vincent Rouvreau"
 __copyright__ = "Copyright (C) 2017 Inria"
@@ -84,3 +85,42 @@ def read_persistence_intervals_in_dimension(persistence_file='', only_this_dim=-
                 'utf-8'), only_this_dim))
     print("file " + persistence_file + " not set or not found.")
     return []
+
+def read_persistence_intervals_from_binary_file(persistence_file, mmap=True):
+    """Reads a persistence diagram in the binary format of
+    :doc:`the file formats <fileformats>`, as written by the C++ `Persistence_diagram_binary_writer` or
+    `Persistent_cohomology::output_diagram_binary`. The other readers of this module also read such files, but return
+    lists of tuples.
+
+    :param persistence_file: A binary persistence file name.
+    :type persistence_file: string
+    :param mmap: If True, the file is memory mapped and the arrays of the dimensions stored in a single block are
+        read-only views on the file, which are only read when accessed. Otherwise, the file is read in memory.
+    :type mmap: bool
+
+    :returns: The persistence intervals grouped by dimension, as arrays of shape (n, 2) of float32 or float64,
+        depending on the file.
+    :rtype: Dict[int, numpy.ndarray]
+    :raises ValueError: If the file is not a valid binary persistence diagram.
+    """
+    data = np.memmap(persistence_file, dtype=np.uint8, mode='r') if mmap else np.fromfile(persistence_file, dtype=np.uint8)
+    if len(data) < 16 or bytes(data[:8]) != b"GUDHIDGM":
+        raise ValueError(f"{persistence_file} is not a binary persistence diagram")
+    version, value_size = (int(x) for x in data[8:16].view(np.uint32))
+    if version != 1 or value_size not in (4, 8):
+        raise ValueError(f"{persistence_file} has an unsupported version or value size")
+    dtype = np.float32 if value_size == 4 else np.float64
+    blocks = {}
+    position = 16
+    while position < len(data):
+        if position + 16 > len(data):
+            raise ValueError(f"{persistence_file} is truncated")
+        dim = int(data[position:position + 8].view(np.int64)[0])
+        n = int(data[position + 8:position + 16].view(np.uint64)[0])
+        position += 16
+        size = 2 * n * value_size
+        if position + size > len(data):
+            raise ValueError(f"{persistence_file} is truncated")
+        blocks.setdefault(dim, []).append(data[position:position + size].view(dtype).reshape(n, 2))
+        position += size + (-size) % 8
+    return {dim: arrays[0] if len(arrays) == 1 else np.concatenate(arrays) for dim, arrays in blocks.items()}
@@ -0,0 +1,302 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - 2023/10 David Loiseaux: Betti curves and Atol.
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <pybind11_diagram_utils.h>
+#include <Thread_pool.h>
+
+#include <boost/math/constants/constants.hpp>
+
+
+namespace py = pybind11;
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> Array;
+typedef std::vector<std::array<double, 2>> Diagram;
+
+namespace {
+
+std::vector<Diagram> unpack(Packed_coords coords, Packed_offsets offsets) {
+  return unpack_diagrams(coords, offsets, [](double x, double y, py::ssize_t) { return std::array<double, 2>{x, y}; });
+}
+
+// One weight per point of the packed diagrams.
+double const* checked_weights(Array const& weights, Packed_coords const& coords) {
+  if (weights.ndim() != 1 || weights.shape(0) != (coords.ndim() == 2 ? coords.shape(0) : 0))
+    throw std::runtime_error("There must be one weight per point");
+  return weights.data();
+}
+
+// Fills the row i of a (n, row_size) matrix for each diagram i, the rows being shared between n_jobs threads of the
+// pool (all if 0) without the GIL. The output is zero-initialized.
+template <class T = double, class Fill>
+py::array_t<T> vectorize(std::size_t n, std::size_t row_size, int n_jobs, Fill fill) {
+  py::array_t<T> ret({n, row_size});
+  T* out = ret.mutable_data();
+  {
+    py::gil_scoped_release release;
+    std::fill(out, out + n * row_size, T(0));
+    Gudhi::thread_pool::parallel_for(n, n_jobs, [&](std::size_t i) { fill(i, out + i * row_size); });
+  }
+  return ret;
+}
+
+// The Gaussian is separable, so each point only needs one exponential per row and per column of pixels, and its
+// contribution to the image is an outer product. The points are in (birth, persistence) coordinates.
+py::array_t<double> persistence_images(Packed_coords coords, Packed_offsets offsets, Array weights, Array x_values,
+                                       Array y_values, double bandwidth, int n_jobs) {
+  const double* w = checked_weights(weights, coords);
+  std::vector<Diagram> diagrams = unpack(coords, offsets);
+  const std::int64_t* off = offsets.data();
+  const double* xs = x_values.data();
+  const double* ys = y_values.data();
+  const std::size_t nx = x_values.size(), ny = y_values.size();
+  const double factor = -1 / (2 * bandwidth * bandwidth);
+  const double normalization = 1 / (2 * boost::math::double_constants::pi * bandwidth * bandwidth);
+  return vectorize(diagrams.size(), nx * ny, n_jobs, [&](std::size_t i, double* image) {
+    std::vector<double> gx(nx), gy(ny);
+    for (std::size_t j = 0; j < diagrams[i].size(); ++j) {
+      const auto [x, y] = diagrams[i][j];
+      for (std::size_t k = 0; k < nx; ++k) gx[k] = std::exp(factor * (x - xs[k]) * (x - xs[k]));
+      const double c = w[off[i] + j] * normalization;
+      for (std::size_t k = 0; k < ny; ++k) gy[k] = c * std::exp(factor * (y - ys[k]) * (y - ys[k]));
+      for (std::size_t r = 0; r < ny; ++r) {
+        double* row = image + r * nx;
+        const double g = gy[r];
+        for (std::size_t k = 0; k < nx; ++k) row[k] += g * gx[k];
+      }
+    }
+  });
+}
+
+// Same as persistence_images, where each point is first moved to the nearest pixel, on regularly spaced x_values and
+// y_values. The image is then the convolution of the histogram of the weights with the Gaussian, truncated at 4
+// bandwidths, which is done along each axis in O(pixels * (2 * radius + 1)) whatever the number of points.
+py::array_t<double> persistence_images_binned(Packed_coords coords, Packed_offsets offsets, Array weights,
+                                              Array x_values, Array y_values, double bandwidth, int n_jobs) {
+  const double* w = checked_weights(weights, coords);
+  std::vector<Diagram> diagrams = unpack(coords, offsets);
+  const std::int64_t* off = offsets.data();
+  const std::size_t nx = x_values.size(), ny = y_values.size();
+  if (nx < 2 || ny < 2) throw std::runtime_error("Binning needs at least 2 pixels along each axis");
+  if (!(bandwidth > 0)) throw std::runtime_error("Binning needs a positive bandwidth");
+  const double x0 = x_values.data()[0], y0 = y_values.data()[0];
+  const double dx = (x_values.data()[nx - 1] - x0) / (nx - 1), dy = (y_values.data()[ny - 1] - y0) / (ny - 1);
+  if (!(dx > 0 && dy > 0)) throw std::runtime_error("Binning needs an image of positive size");
+  // filter[k] is the Gaussian at k - radius pixels
+  auto gaussian_filter = [&](double step) {
+    const std::size_t radius = static_cast<std::size_t>(std::ceil(4 * bandwidth / step));
+    std::vector<double> filter(2 * radius + 1);
+    for (std::size_t k = 0; k < filter.size(); ++k) {
+      const double t = (static_cast<double>(k) - static_cast<double>(radius)) * step;
+      filter[k] = std::exp(-t * t / (2 * bandwidth * bandwidth));
+    }
+    return filter;
+  };
+  const std::vector<double> fx = gaussian_filter(dx), fy = gaussian_filter(dy);
+  const std::ptrdiff_t rx = fx.size() / 2, ry = fy.size() / 2;
+  const std::ptrdiff_t px = nx + 2 * rx, py = ny + 2 * ry;
+  const double normalization = 1 / (2 * boost::math::double_constants::pi * bandwidth * bandwidth);
+  return vectorize(diagrams.size(), nx * ny, n_jobs, [&](std::size_t i, double* image) {
+    // Histogram with a margin of the radius of the filter, for the points slightly outside of the image
+    std::vector<double> histogram(px * py, 0.);
+    for (std::size_t j = 0; j < diagrams[i].size(); ++j) {
+      const auto [x, y] = diagrams[i][j];
+      const double bx = std::round((x - x0) / dx) + rx, by = std::round((y - y0) / dy) + ry;
+      if (bx < 0 || bx >= px || by < 0 || by >= py) continue;
+      histogram[static_cast<std::size_t>(by) * px + static_cast<std::size_t>(bx)] += w[off[i] + j];
+    }
+    std::vector<double> rows(py * nx, 0.);
+    for (std::ptrdiff_t r = 0; r < py; ++r) {
+      const double* h = histogram.data() + r * px;
+      double* out = rows.data() + r * nx;
+      for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(fx.size()); ++k) {
+        const double c = fx[k];
+        const double* src = h + 2 * rx - k;
+        for (std::size_t col = 0; col < nx; ++col) out[col] += c * src[col];
+      }
+    }
+    for (std::size_t r = 0; r < ny; ++r) {
+      double* out = image + r * nx;
+      for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(fy.size()); ++k) {
+        const double c = normalization * fy[k];
+        const double* src = rows.data() + (r + 2 * ry - k) * nx;
+        for (std::size_t col = 0; col < nx; ++col) out[col] += c * src[col];
+      }
+    }
+  });
+}
+
+// Row layout: the num_landscapes landscapes one after the other, each sampled on the grid.
+py::array_t<double> landscapes(Packed_coords coords, Packed_offsets offsets, Array grid, std::size_t num_landscapes,
+                               int n_jobs) {
+  std::vector<Diagram> diagrams = unpack(coords, offsets);
+  const double* xs = grid.data();
+  const std::size_t n_samples = grid.size();
+  const double root_two = boost::math::double_constants::root_two;
+  return vectorize(diagrams.size(), num_landscapes * n_samples, n_jobs, [&](std::size_t i, double* out) {
+    const Diagram& diagram = diagrams[i];
+    std::vector<double> mid(diagram.size()), height(diagram.size()), tents;
+    for (std::size_t j = 0; j < diagram.size(); ++j) {
+      mid[j] = (diagram[j][0] + diagram[j][1]) / 2;
+      height[j] = (diagram[j][1] - diagram[j][0]) / 2;
+    }
+    for (std::size_t k = 0; k < n_samples; ++k) {
+      tents.clear();
+      for (std::size_t j = 0; j < diagram.size(); ++j) {
+        const double t = height[j] - std::abs(xs[k] - mid[j]);
+        if (t > 0) tents.push_back(t);
+      }
+      const std::size_t top = std::min(num_landscapes, tents.size());
+      std::partial_sort(tents.begin(), tents.begin() + top, tents.end(), std::greater<double>());
+      for (std::size_t l = 0; l < top; ++l) out[l * n_samples + k] = root_two * tents[l];
+    }
+  });
+}
+
+// Weighted average of the tent functions, which is 0 for an empty diagram.
+py::array_t<double> silhouettes(Packed_coords coords, Packed_offsets offsets, Array weights, Array grid, int n_jobs) {
+  const double* w = checked_weights(weights, coords);
+  std::vector<Diagram> diagrams = unpack(coords, offsets);
+  const std::int64_t* off = offsets.data();
+  const double* xs = grid.data();
+  const std::size_t n_samples = grid.size();
+  return vectorize(diagrams.size(), n_samples, n_jobs, [&](std::size_t i, double* out) {
+    const Diagram& diagram = diagrams[i];
+    double total_weight = 0;
+    for (std::size_t j = 0; j < diagram.size(); ++j) total_weight += w[off[i] + j];
+    for (std::size_t j = 0; j < diagram.size(); ++j) {
+      const double mid = (diagram[j][0] + diagram[j][1]) / 2;
+      const double height = (diagram[j][1] - diagram[j][0]) / 2;
+      const double c = boost::math::double_constants::root_two * w[off[i] + j] / total_weight;
+      for (std::size_t k = 0; k < n_samples; ++k) out[k] += c * std::max(height - std::abs(xs[k] - mid), 0.);
+    }
+  });
+}
+
+// Betti number at each value of the (sorted) grid, i.e. the number of births minus the number of deaths that are at
+// most this value, by merging the sorted births and deaths of each diagram with the grid.
+py::array_t<std::int64_t> betti_curves(Packed_coords coords, Packed_offsets offsets, Array grid, int n_jobs) {
+  std::vector<Diagram> diagrams = unpack(coords, offsets);
+  const double* xs = grid.data();
+  const std::size_t n_samples = grid.size();
+  return vectorize<std::int64_t>(diagrams.size(), n_samples, n_jobs, [&](std::size_t i, std::int64_t* out) {
+    const Diagram& diagram = diagrams[i];
+    std::vector<double> births(diagram.size()), deaths(diagram.size());
+    for (std::size_t j = 0; j < diagram.size(); ++j) {
+      births[j] = diagram[j][0];
+      deaths[j] = diagram[j][1];
+    }
+    std::sort(births.begin(), births.end());
+    std::sort(deaths.begin(), deaths.end());
+    std::size_t b = 0, d = 0;
+    for (std::size_t k = 0; k < n_samples; ++k) {
+      while (b < births.size() && births[b] <= xs[k]) ++b;
+      while (d < deaths.size() && deaths[d] <= xs[k]) ++d;
+      out[k] = static_cast<std::int64_t>(b) - static_cast<std::int64_t>(d);
+    }
+  });
+}
+
+enum class Contrast { gaussian, laplacian, indicator };
+
+// Row i: for each center c, the sum over the points x of the measure i of weight(x) * contrast(|x - c| / inertia[c]).
+// The measures are packed in coords of shape (n, dim), like the diagrams. For each point, the squared distances to all
+// the centers are computed first, so that the contrast is applied by a separate loop over contiguous values, without
+// branches, that the compiler can vectorize (with the vector math library for the exponentials, when available).
+py::array_t<double> atol_vectors(Packed_coords coords, Packed_offsets offsets, Array weights, Array centers,
+                                 Array inertias, std::string const& contrast_name, int n_jobs) {
+  Contrast contrast;
+  if (contrast_name == "gaussian")
+    contrast = Contrast::gaussian;
+  else if (contrast_name == "laplacian")
+    contrast = Contrast::laplacian;
+  else if (contrast_name == "indicator")
+    contrast = Contrast::indicator;
+  else
+    throw std::runtime_error("Unknown contrast " + contrast_name);
+  if (centers.ndim() != 2) throw std::runtime_error("Centers must be a 2D array");
+  const std::size_t n_centers = centers.shape(0), dim = centers.shape(1);
+  if (static_cast<std::size_t>(inertias.size()) != n_centers)
+    throw std::runtime_error("There must be one inertia per center");
+  if (coords.ndim() != 2 || static_cast<std::size_t>(coords.shape(1)) != dim)
+    throw std::runtime_error("Measures must be packed in an array with as many columns as the centers");
+  if (offsets.ndim() != 1 || offsets.shape(0) == 0) throw std::runtime_error("Offsets must be a non-empty 1D array");
+  const std::int64_t* off = offsets.data();
+  const std::size_t n = offsets.shape(0) - 1;
+  if (off[0] != 0 || off[n] != coords.shape(0)) throw std::runtime_error("Offsets do not match the number of points");
+  for (std::size_t i = 0; i < n; ++i)
+    if (off[i] > off[i + 1]) throw std::runtime_error("Offsets must be non-decreasing");
+  const double* w = checked_weights(weights, coords);
+  const double* p = coords.data();
+  const double* ctr = centers.data();
+  // The same divisions as the NumPy contrasts, for the same rounding
+  std::vector<double> scale(inertias.data(), inertias.data() + n_centers);
+  if (contrast == Contrast::gaussian)
+    for (double& s : scale) s *= s;
+  return vectorize(n, n_centers, n_jobs, [&](std::size_t i, double* out) {
+    std::vector<double> t(n_centers);
+    for (std::int64_t j = off[i]; j < off[i + 1]; ++j) {
+      const double* x = p + j * dim;
+      for (std::size_t c = 0; c < n_centers; ++c) {
+        double s = 0;
+        for (std::size_t l = 0; l < dim; ++l) {
+          const double diff = x[l] - ctr[c * dim + l];
+          s += diff * diff;
+        }
+        t[c] = s;
+      }
+      switch (contrast) {
+        case Contrast::gaussian:
+          for (std::size_t c = 0; c < n_centers; ++c) t[c] = std::exp(-t[c] / scale[c]);
+          break;
+        case Contrast::laplacian:
+          for (std::size_t c = 0; c < n_centers; ++c) t[c] = std::exp(-std::sqrt(t[c]) / scale[c]);
+          break;
+        case Contrast::indicator:
+          for (std::size_t c = 0; c < n_centers; ++c) t[c] = std::clamp(2 - std::sqrt(t[c]) / scale[c], 0., 1.);
+          break;
+      }
+      for (std::size_t c = 0; c < n_centers; ++c) out[c] += w[j] * t[c];
+    }
+  });
+}
+
+}  // namespace
+
+PYBIND11_MODULE(_vector_methods, m) {
+  m.def("_persistence_images", &persistence_images, py::arg("coords"), py::arg("offsets"), py::arg("weights"),
+        py::arg("x_values"), py::arg("y_values"), py::arg("bandwidth"), py::arg("n_jobs") = 1,
+        "Persistence images of packed diagrams in (birth, persistence) coordinates, one flattened image per row.");
+  m.def("_persistence_images_binned", &persistence_images_binned, py::arg("coords"), py::arg("offsets"),
+        py::arg("weights"), py::arg("x_values"), py::arg("y_values"), py::arg("bandwidth"), py::arg("n_jobs") = 1,
+        "Same as _persistence_images, with the points binned to the nearest pixel and a separable convolution.");
+  m.def("_landscapes", &landscapes, py::arg("coords"), py::arg("offsets"), py::arg("grid"),
+        py::arg("num_landscapes"), py::arg("n_jobs") = 1,
+        "Persistence landscapes of packed diagrams sampled on a grid, one diagram per row.");
+  m.def("_silhouettes", &silhouettes, py::arg("coords"), py::arg("offsets"), py::arg("weights"), py::arg("grid"),
+        py::arg("n_jobs") = 1, "Persistence silhouettes of packed diagrams sampled on a grid, one diagram per row.");
+  m.def("_betti_curves", &betti_curves, py::arg("coords"), py::arg("offsets"), py::arg("grid"), py::arg("n_jobs") = 1,
+        "Betti curves of packed diagrams at the values of a sorted grid, one diagram per row.");
+  m.def("_atol", &atol_vectors, py::arg("coords"), py::arg("offsets"), py::arg("weights"), py::arg("centers"),
+        py::arg("inertias"), py::arg("contrast"), py::arg("n_jobs") = 1,
+        "Atol vectorization of packed measures, one measure per row and one center per column.");
+}
@@ -10,7 +10,7 @@
 import numpy as np
 from sklearn.base import BaseEstimator, TransformerMixin
 from sklearn.metrics import pairwise_distances, pairwise_kernels
-from .metrics import SlicedWassersteinDistance, PersistenceFisherDistance, _sklearn_wrapper, _pairwise, pairwise_persistence_diagram_distances, _sliced_wasserstein_distance, _persistence_fisher_distance
+from .metrics import SlicedWassersteinDistance, PersistenceFisherDistance, _sklearn_wrapper, _pairwise, pairwise_persistence_diagram_distances, _sliced_wasserstein_distance, _persistence_fisher_distance, _pack_diagrams
 from .preprocessing import Padding
 
 #############################################
@@ -61,6 +61,43 @@ def _persistence_scale_space_kernel(D1, D2, kernel_approx=None, bandwidth=1.):
     return 0.5 * _persistence_weighted_gaussian_kernel(DD1, DD2, weight=weight_pss, kernel_approx=kernel_approx, bandwidth=bandwidth)
 
 
+def _draw_random_fourier_features(num_random_features, bandwidth, random_state=None):
+    """
+    Draws the frequencies and phases of random Fourier features for the Gaussian kernel of the given bandwidth on the plane: the frequencies follow a normal distribution of standard deviation 1/bandwidth and the phases are uniform in [0, 2pi].
+    """
+    rng = np.random.default_rng(random_state)
+    frequencies = rng.normal(scale=1./bandwidth, size=(num_random_features, 2))
+    phases = rng.uniform(0, 2*np.pi, size=num_random_features)
+    return frequencies, phases
+
+def _random_fourier_features(X, frequencies, phases, bandwidth, weight=lambda x: 1, scale_space=False):
+    """
+    Computes the embeddings of a list of persistence diagrams whose dot products approximate the persistence weighted Gaussian kernel (or the persistence scale space kernel if scale_space is True). All the points of all the diagrams are projected at once, so the kernel matrix between N and M diagrams with n points costs O((N+M)*n*D) instead of O(N*M*n^2), where D is the number of features.
+
+    Parameters:
+        X (list of n x 2 numpy arrays): input persistence diagrams.
+        frequencies ((D x 2) numpy array), phases ((D) numpy array): random features drawn by _draw_random_fourier_features.
+
+    Returns:
+        numpy array of shape (len(X) x D): one embedding per diagram.
+    """
+    coords, offsets = _pack_diagrams(X)
+    if scale_space:
+        # Each point and its symmetric to the diagonal, weighted 1 above the diagonal and -1 below, the kernel being halved
+        ws = np.where(coords[:,1] >= coords[:,0], 1., -1.)
+        ws_sym = np.where(coords[:,0] >= coords[:,1], 1., -1.)
+        proj = np.cos(np.matmul(coords, frequencies.T) + phases) * ws[:,np.newaxis]
+        proj += np.cos(np.matmul(coords[:,[1,0]], frequencies.T) + phases) * ws_sym[:,np.newaxis]
+        factor = 0.5
+    else:
+        ws = np.array([weight(coords[j,:]) for j in range(len(coords))], dtype=float)
+        proj = np.cos(np.matmul(coords, frequencies.T) + phases) * ws[:,np.newaxis]
+        factor = 1.
+    features = np.zeros((len(X), len(phases)))
+    np.add.at(features, np.repeat(np.arange(len(X)), np.diff(offsets)), proj)
+    # E[2 cos(w.x+b) cos(w.y+b)] is the Gaussian of x-y, the kernel has an extra 1/(sqrt(2pi)*bandwidth)
+    return features * np.sqrt(2. * factor / (len(phases) * np.sqrt(2*np.pi) * bandwidth))
+
 def pairwise_persistence_diagram_kernels(X, Y=None, kernel="sliced_wasserstein", n_jobs=None, **kwargs):
     """
     This function computes the kernel matrix between two lists of persistence diagrams given as numpy arrays of shape (nx2).
@@ -69,7 +106,7 @@ def pairwise_persistence_diagram_kernels(X, Y=None, kernel="sliced_wasserstein",
         X (list of n numpy arrays of shape (numx2)): first list of persistence diagrams. 
         Y (list of m numpy arrays of shape (numx2)): second list of persistence diagrams (optional). If None, pairwise kernel values are computed from the first list only.
         kernel: kernel to use. It can be either a string ("sliced_wasserstein", "persistence_scale_space", "persistence_weighted_gaussian", "persistence_fisher") or a function taking two numpy arrays of shape (nx2) and (mx2) as inputs. If it is a function, make sure that it is symmetric.
-        n_jobs (int): number of jobs to use for the computation. This uses joblib.Parallel(prefer="threads"), so kernels that do not release the GIL may not scale unless run inside a `joblib.parallel_backend <https://joblib.readthedocs.io/en/latest/parallel.html#joblib.parallel_backend>`_ block.
+        n_jobs (int): number of jobs to use for the computation. The pairs are computed on that many threads of the pool of :mod:`gudhi.parallel` (by scikit-learn if Y is given), so kernels that do not release the GIL may not scale.
         **kwargs: optional keyword parameters. Any further parameters are passed directly to the kernel function. See the docs of the various kernel classes in this module.
 
     Returns: 
@@ -145,7 +182,7 @@ class PersistenceWeightedGaussianKernel(BaseEstimator, TransformerMixin):
     """
     This is a class for computing the persistence weighted Gaussian kernel matrix from a list of persistence diagrams. The persistence weighted Gaussian kernel is computed by convolving the persistence diagram points with weighted Gaussian kernels. See http://proceedings.mlr.press/v48/kusano16.html for more details. 
     """
-    def __init__(self, bandwidth=1., weight=lambda x: 1, kernel_approx=None, n_jobs=None):
+    def __init__(self, bandwidth=1., weight=lambda x: 1, kernel_approx=None, n_jobs=None, num_random_features=None, random_state=None):
         """
         Constructor for the PersistenceWeightedGaussianKernel class.
   
@@ -154,22 +191,40 @@ class PersistenceWeightedGaussianKernel(BaseEstimator, TransformerMixin):
             weight (function): weight function for the persistence diagram points (default constant function, ie lambda x: 1). This function must be defined on 2D points, ie lists or numpy arrays of the form [p_x,p_y].
             kernel_approx (class): kernel approximation class used to speed up computation (default None). Common kernel approximations classes can be found in the scikit-learn library (such as RBFSampler for instance).
             n_jobs (int): number of jobs to use for the computation. See :func:`pairwise_persistence_diagram_kernels` for details.
+            num_random_features (int): if not None, each diagram is embedded with this number of random Fourier features, drawn in the fit() method, and the kernel values are the dot products of the embeddings (default None). This is much faster for large lists of diagrams, the error decreasing as 1/sqrt(num_random_features).
+            random_state (int or numpy.random.Generator): seed of the random Fourier features (default None).
         """
         self.bandwidth, self.weight = bandwidth, weight
         self.kernel_approx = kernel_approx
         self.n_jobs = n_jobs
+        self.num_random_features, self.random_state = num_random_features, random_state
 
     def fit(self, X, y=None):
         """
-        Fit the PersistenceWeightedGaussianKernel class on a list of persistence diagrams: persistence diagrams are stored in a numpy array called **diagrams** and the kernel approximation class (if not None) is applied on them. 
+        Fit the PersistenceWeightedGaussianKernel class on a list of persistence diagrams: persistence diagrams are stored in a numpy array called **diagrams** and the kernel approximation class (if not None) is applied on them. If num_random_features is not None, the random Fourier features are drawn and the embeddings of the diagrams are stored instead.
 
         Parameters:
             X (list of n x 2 numpy arrays): input persistence diagrams.
             y (n x 1 array): persistence diagram labels (unused).
         """
         self.diagrams_ = X
+        if self.num_random_features is not None:
+            self.frequencies_, self.phases_ = _draw_random_fourier_features(self.num_random_features, self.bandwidth, self.random_state)
+            self.features_ = self.random_features(X)
         return self
 
+    def random_features(self, X):
+        """
+        Compute the embeddings of a list of persistence diagrams with the random Fourier features drawn by the fit() method, whose dot products approximate the kernel values.
+
+        Parameters:
+            X (list of n x 2 numpy arrays): input persistence diagrams.
+
+        Returns:
+            numpy array of shape (number of diagrams in X) x num_random_features: one embedding per diagram.
+        """
+        return _random_fourier_features(X, self.frequencies_, self.phases_, self.bandwidth, weight=self.weight)
+
     def transform(self, X):
         """
         Compute all persistence weighted Gaussian kernel values between the persistence diagrams that were stored after calling the fit() method, and a given list of (possibly different) persistence diagrams.
@@ -180,6 +235,8 @@ class PersistenceWeightedGaussianKernel(BaseEstimator, TransformerMixin):
         Returns:
             numpy array of shape (number of diagrams in X) x (number of diagrams in **diagrams**): matrix of pairwise persistence weighted Gaussian kernel values.
         """
+        if self.num_random_features is not None:
+            return np.matmul(self.random_features(X), self.features_.T)
         return pairwise_persistence_diagram_kernels(X, self.diagrams_, kernel="persistence_weighted_gaussian", bandwidth=self.bandwidth, weight=self.weight, kernel_approx=self.kernel_approx, n_jobs=self.n_jobs)
 
     def __call__(self, diag1, diag2):
@@ -193,13 +250,16 @@ class PersistenceWeightedGaussianKernel(BaseEstimator, TransformerMixin):
         Returns:
             float: persistence weighted Gaussian kernel value.
         """
+        if self.num_random_features is not None:
+            f = self.random_features([diag1, diag2])
+            return np.dot(f[0], f[1])
         return _persistence_weighted_gaussian_kernel(diag1, diag2, weight=self.weight, kernel_approx=self.kernel_approx, bandwidth=self.bandwidth)
 
 class PersistenceScaleSpaceKernel(BaseEstimator, TransformerMixin):
     """
     This is a class for computing the persistence scale space kernel matrix from a list of persistence diagrams. The persistence scale space kernel is computed by adding the symmetric to the diagonal of each point in each persistence diagram, with negative weight, and then convolving the points with a Gaussian kernel. See https://www.cv-foundation.org/openaccess/content_cvpr_2015/papers/Reininghaus_A_Stable_Multi-Scale_2015_CVPR_paper.pdf for more details. 
     """
-    def __init__(self, bandwidth=1., kernel_approx=None, n_jobs=None):
+    def __init__(self, bandwidth=1., kernel_approx=None, n_jobs=None, num_random_features=None, random_state=None):
         """
         Constructor for the PersistenceScaleSpaceKernel class.
   
@@ -207,21 +267,39 @@ class PersistenceScaleSpaceKernel(BaseEstimator, TransformerMixin):
             bandwidth (double): bandwidth of the Gaussian kernel with which persistence diagrams will be convolved (default 1.)
             kernel_approx (class): kernel approximation class used to speed up computation (default None). Common kernel approximations classes can be found in the scikit-learn library (such as RBFSampler for instance).
             n_jobs (int): number of jobs to use for the computation. See :func:`pairwise_persistence_diagram_kernels` for details.
+            num_random_features (int): if not None, each diagram is embedded with this number of random Fourier features, drawn in the fit() method, and the kernel values are the dot products of the embeddings (default None). See :class:`PersistenceWeightedGaussianKernel`.
+            random_state (int or numpy.random.Generator): seed of the random Fourier features (default None).
         """
         self.bandwidth, self.kernel_approx = bandwidth, kernel_approx
         self.n_jobs = n_jobs
+        self.num_random_features, self.random_state = num_random_features, random_state
 
     def fit(self, X, y=None):
         """
-        Fit the PersistenceScaleSpaceKernel class on a list of persistence diagrams: symmetric to the diagonal of all points are computed and an instance of the PersistenceWeightedGaussianKernel class is fitted on the diagrams and then stored. 
+        Fit the PersistenceScaleSpaceKernel class on a list of persistence diagrams: symmetric to the diagonal of all points are computed and an instance of the PersistenceWeightedGaussianKernel class is fitted on the diagrams and then stored. If num_random_features is not None, the random Fourier features are drawn and the embeddings of the diagrams are stored instead.
 
         Parameters:
             X (list of n x 2 numpy arrays): input persistence diagrams.
             y (n x 1 array): persistence diagram labels (unused).
         """
         self.diagrams_ = X
+        if self.num_random_features is not None:
+            self.frequencies_, self.phases_ = _draw_random_fourier_features(self.num_random_features, self.bandwidth, self.random_state)
+            self.features_ = self.random_features(X)
         return self
 
+    def random_features(self, X):
+        """
+        Compute the embeddings of a list of persistence diagrams with the random Fourier features drawn by the fit() method, whose dot products approximate the kernel values.
+
+        Parameters:
+            X (list of n x 2 numpy arrays): input persistence diagrams.
+
+        Returns:
+            numpy array of shape (number of diagrams in X) x num_random_features: one embedding per diagram.
+        """
+        return _random_fourier_features(X, self.frequencies_, self.phases_, self.bandwidth, scale_space=True)
+
     def transform(self, X):
         """
         Compute all persistence scale space kernel values between the persistence diagrams that were stored after calling the fit() method, and a given list of (possibly different) persistence diagrams.
@@ -232,6 +310,8 @@ class PersistenceScaleSpaceKernel(BaseEstimator, TransformerMixin):
         Returns:
             numpy array of shape (number of diagrams in X) x (number of diagrams in **diagrams**): matrix of pairwise persistence scale space kernel values.
         """
+        if self.num_random_features is not None:
+            return np.matmul(self.random_features(X), self.features_.T)
         return pairwise_persistence_diagram_kernels(X, self.diagrams_, kernel="persistence_scale_space", bandwidth=self.bandwidth, kernel_approx=self.kernel_approx, n_jobs=self.n_jobs)
 
     def __call__(self, diag1, diag2):
@@ -245,6 +325,9 @@ class PersistenceScaleSpaceKernel(BaseEstimator, TransformerMixin):
         Returns:
             float: persistence scale space kernel value.
         """
+        if self.num_random_features is not None:
+            f = self.random_features([diag1, diag2])
+            return np.dot(f[0], f[1])
         return _persistence_scale_space_kernel(diag1, diag2, bandwidth=self.bandwidth, kernel_approx=self.kernel_approx)
 
 class PersistenceFisherKernel(BaseEstimator, TransformerMixin):
@@ -11,8 +11,9 @@ import numpy as np
 from sklearn.base import BaseEstimator, TransformerMixin
 from sklearn.metrics import pairwise_distances
 from gudhi.hera import wasserstein_distance as hera_wasserstein_distance
+from gudhi.hera.wasserstein import _wasserstein_distance_matrix
 from .preprocessing import Padding
-from joblib import Parallel, delayed
+from ..parallel import _map, _native_n_jobs
 
 #############################################
 # Metrics ###################################
@@ -122,8 +123,8 @@ def _pairwise(fallback, skipdiag, X, Y, metric, n_jobs):
         return fallback(X, Y, metric=metric, n_jobs=n_jobs)
     triu = np.triu_indices(len(X), k=skipdiag)
     tril = (triu[1], triu[0])
-    par = Parallel(n_jobs=n_jobs, prefer="threads")
-    d = par(delayed(metric)([triu[0][i]], [triu[1][i]]) for i in range(len(triu[0])))
+    # The pairs are shared by the threads of the pool, on which the metrics releasing the GIL run in parallel
+    d = _map(lambda k: metric([triu[0][k]], [triu[1][k]]), range(len(triu[0])), n_jobs)
     m = np.empty((len(X), len(X)))
     m[triu] = d
     m[tril] = d
@@ -143,6 +144,19 @@ def _sklearn_wrapper(metric, X, Y, **kwargs):
             return metric(X[int(a[0])], Y[int(b[0])], **kwargs)
     return flat_metric
 
+def _pack_diagrams(X):
+    """
+    Packs a list of diagrams in a single (nx2) array of coordinates and the offsets of each diagram in it, which is
+    the input of the C++ distance matrices.
+    """
+    if X is None:
+        return None, None
+    X = [np.asarray(D, dtype=float).reshape(-1, 2) for D in X]
+    offsets = np.zeros(len(X) + 1, dtype=np.int64)
+    np.cumsum([len(D) for D in X], out=offsets[1:])
+    coords = np.concatenate(X) if len(X) > 0 else np.empty((0, 2))
+    return coords, offsets
+
 PAIRWISE_DISTANCE_FUNCTIONS = {
     "wasserstein": hera_wasserstein_distance,
     "hera_wasserstein": hera_wasserstein_distance,
@@ -157,7 +171,7 @@ def pairwise_persistence_diagram_distances(X, Y=None, metric="bottleneck", n_job
         X (list of n numpy arrays of shape (numx2)): first list of persistence diagrams. 
         Y (list of m numpy arrays of shape (numx2)): second list of persistence diagrams (optional). If None, pairwise distances are computed from the first list only.
         metric: distance to use. It can be either a string ("sliced_wasserstein", "wasserstein", "hera_wasserstein" (Wasserstein distance computed with Hera---note that Hera is also used for the default option "wasserstein"), "pot_wasserstein" (Wasserstein distance computed with POT), "bottleneck", "persistence_fisher") or a function taking two numpy arrays of shape (nx2) and (mx2) as inputs. If it is a function, make sure that it is symmetric and that it outputs 0 if called on the same two arrays. 
-        n_jobs (int): number of jobs to use for the computation. This uses joblib.Parallel(prefer="threads"), so metrics that do not release the GIL may not scale unless run inside a `joblib.parallel_backend <https://joblib.readthedocs.io/en/latest/parallel.html#joblib.parallel_backend>`_ block.
+        n_jobs (int): number of jobs to use for the computation. For "bottleneck" and the Hera Wasserstein distance, all the pairs are computed in C++ on that many threads. Otherwise, the pairs are computed on that many threads of the pool of :mod:`gudhi.parallel` (by scikit-learn if Y is given), so metrics that do not release the GIL may not scale.
         **kwargs: optional keyword parameters. Any further parameters are passed directly to the distance function. See the docs of the various distance classes in this module.
 
     Returns: 
@@ -167,11 +181,16 @@ def pairwise_persistence_diagram_distances(X, Y=None, metric="bottleneck", n_job
     YY = None if Y is None or Y is X else np.reshape(np.arange(len(Y)), [-1,1])
     if metric == "bottleneck":
         try: 
-            from .. import bottleneck_distance
-            return _pairwise(pairwise_distances, True, XX, YY, metric=_sklearn_wrapper(bottleneck_distance, X, Y, **kwargs), n_jobs=n_jobs)
+            from ..bottleneck import _bottleneck_distance_matrix
         except ImportError:
             print("Gudhi built without CGAL")
             raise
+        # All the pairs are scheduled in C++, without the GIL, and each diagram is converted only once
+        return _bottleneck_distance_matrix(*_pack_diagrams(X), *_pack_diagrams(None if YY is None else Y),
+                                           n_jobs=_native_n_jobs(n_jobs), **kwargs)
+    elif metric in ["wasserstein", "hera_wasserstein"] and set(kwargs) <= {"order", "internal_p", "delta"}:
+        return _wasserstein_distance_matrix(*_pack_diagrams(X), *_pack_diagrams(None if YY is None else Y),
+                                            n_jobs=_native_n_jobs(n_jobs), **kwargs)
     elif metric == "pot_wasserstein":
         try:
             from gudhi.wasserstein import wasserstein_distance as pot_wasserstein_distance
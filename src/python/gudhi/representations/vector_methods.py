@@ -8,6 +8,8 @@
 #   - 2020/06 Martin: ATOL integration
 #   - 2020/12 Gard: A more flexible Betti curve class capable of computing exact curves.
 #   - 2021/11 Vincent Rouvreau: factorize _automatic_sample_range
+#   - 2023/10 David Loiseaux: TopologicalVector only computes the largest distances
+#   - 2023/10 David Loiseaux: Atol and BettiCurve computed in C++
 
 import numpy as np
 from scipy.spatial.distance import cdist
@@ -15,14 +17,12 @@ from sklearn.base          import BaseEstimator, TransformerMixin
 from sklearn.exceptions    import NotFittedError
 from sklearn.preprocessing import MinMaxScaler, MaxAbsScaler
 from sklearn.metrics       import pairwise
-try:
-    # New location since 1.0
-    from sklearn.metrics     import DistanceMetric
-except ImportError:
-    # Will be removed in 1.3
-    from sklearn.neighbors     import DistanceMetric
 
 from .preprocessing import DiagramScaler, BirthPersistenceTransform, _maybe_fit_transform
+from .metrics import _pack_diagrams
+from ..parallel import _native_n_jobs
+from ._vector_methods import _persistence_images, _persistence_images_binned, _landscapes, _silhouettes, _betti_curves, _atol
+from ..tracing import _traced
 
 #############################################
 # Finite Vectorization methods ##############
@@ -32,7 +32,7 @@ class PersistenceImage(BaseEstimator, TransformerMixin):
     """
     This is a class for computing persistence images from a list of persistence diagrams. A persistence image is a 2D function computed from a persistence diagram by convolving the diagram points with a weighted Gaussian kernel. The plane is then discretized into an image with pixels, which is flattened and returned as a vector. See http://jmlr.org/papers/v18/16-337.html for more details.
     """
-    def __init__(self, bandwidth=1., weight=lambda x: 1, resolution=[20,20], im_range=[np.nan, np.nan, np.nan, np.nan]):
+    def __init__(self, bandwidth=1., weight=lambda x: 1, resolution=[20,20], im_range=[np.nan, np.nan, np.nan, np.nan], *, binned=False, n_jobs=None):
         """
         Constructor for the PersistenceImage class.
 
@@ -41,9 +41,13 @@ class PersistenceImage(BaseEstimator, TransformerMixin):
             weight (function): weight function for the persistence diagram points (default constant function, ie lambda x: 1). This function must be defined on 2D points, ie lists or numpy arrays of the form [p_x,p_y].
             resolution ([int,int]): size (in pixels) of the persistence image (default [20,20]).
             im_range ([double,double,double,double]): minimum and maximum of each axis of the persistence image, of the form [x_min, x_max, y_min, y_max] (default [numpy.nan, numpy.nan, numpy.nan, numpyp.nan]). If one of the values is numpy.nan, it can be computed from the persistence diagrams with the fit() method.
+            binned (bool): move each point to the nearest pixel, and convolve the resulting histogram with the Gaussian kernel (truncated at 4 bandwidths), one axis at a time (default False). The cost does not grow with the number of points times the number of pixels anymore, which is much faster for large diagrams, but the images are only approximations, whose precision depends on the size of the pixels compared to the bandwidth.
+            n_jobs (int): number of threads that compute the images, with the same meaning as in joblib (default None, ie 1).
         """
         self.bandwidth, self.weight = bandwidth, weight
         self.resolution, self.im_range = resolution, im_range
+        self.binned = binned
+        self.n_jobs = n_jobs
 
     def fit(self, X, y=None):
         """
@@ -65,6 +69,7 @@ class PersistenceImage(BaseEstimator, TransformerMixin):
             self.im_range_fixed_ = self.im_range
         return self
 
+    @_traced("PersistenceImage.transform")
     def transform(self, X):
         """
         Compute the persistence image for each persistence diagram individually and store the results in a single numpy array.
@@ -75,26 +80,13 @@ class PersistenceImage(BaseEstimator, TransformerMixin):
         Returns:
             numpy array with shape (number of diagrams) x (number of pixels = **resolution[0]** x **resolution[1]**): output persistence images.
         """
-        num_diag, Xfit = len(X), []
         new_X = BirthPersistenceTransform().fit_transform(X)
-
-        for i in range(num_diag):
-
-            diagram, num_pts_in_diag = new_X[i], X[i].shape[0]
-
-            w = np.empty(num_pts_in_diag)
-            for j in range(num_pts_in_diag):
-                w[j] = self.weight(diagram[j,:])
-
-            x_values, y_values = np.linspace(self.im_range_fixed_[0], self.im_range_fixed_[1], self.resolution[0]), np.linspace(self.im_range_fixed_[2], self.im_range_fixed_[3], self.resolution[1])
-            Xs, Ys = np.tile((diagram[:,0][:,np.newaxis,np.newaxis]-x_values[np.newaxis,np.newaxis,:]),[1,self.resolution[1],1]), np.tile(diagram[:,1][:,np.newaxis,np.newaxis]-y_values[np.newaxis,:,np.newaxis],[1,1,self.resolution[0]])
-            image = np.tensordot(w, np.exp((-np.square(Xs)-np.square(Ys))/(2*np.square(self.bandwidth)))/(np.square(self.bandwidth)*2*np.pi), 1)
-
-            Xfit.append(image.reshape(1,-1))
-
-        Xfit = np.concatenate(Xfit, 0)
-
-        return Xfit
+        coords, offsets = _pack_diagrams(new_X)
+        weights = np.array([self.weight(pt) for pt in coords], dtype=float)
+        x_values, y_values = np.linspace(self.im_range_fixed_[0], self.im_range_fixed_[1], self.resolution[0]), np.linspace(self.im_range_fixed_[2], self.im_range_fixed_[3], self.resolution[1])
+        # The images are all computed in C++, the rows of each image being along the x axis.
+        compute = _persistence_images_binned if self.binned else _persistence_images
+        return compute(coords, offsets, weights, x_values, y_values, self.bandwidth, _native_n_jobs(self.n_jobs))
 
     def __call__(self, diag):
         """
@@ -159,7 +151,7 @@ class Landscape(BaseEstimator, TransformerMixin):
     Attributes:
         grid_ (1d array): The grid on which the landscapes are computed.
     """
-    def __init__(self, num_landscapes=5, resolution=100, sample_range=[np.nan, np.nan], *, keep_endpoints=False):
+    def __init__(self, num_landscapes=5, resolution=100, sample_range=[np.nan, np.nan], *, keep_endpoints=False, n_jobs=None):
         """
         Constructor for the Landscape class.
 
@@ -168,9 +160,11 @@ class Landscape(BaseEstimator, TransformerMixin):
             resolution (int): number of sample for all piecewise-linear functions (default 100).
             sample_range ([double, double]): minimum and maximum of all piecewise-linear function domains, of the form [x_min, x_max] (default [numpy.nan, numpy.nan]). It is the interval on which samples will be drawn evenly. If one of the values is numpy.nan, it can be computed from the persistence diagrams with the fit() method.
             keep_endpoints (bool): when computing `sample_range`, use the exact extremities (where the value is always 0). This is mostly useful for plotting, the default is to use a slightly smaller range.
+            n_jobs (int): number of threads that compute the landscapes, with the same meaning as in joblib (default None, ie 1).
         """
         self.num_landscapes, self.resolution, self.sample_range = num_landscapes, resolution, sample_range
         self.keep_endpoints = keep_endpoints
+        self.n_jobs = n_jobs
 
     def fit(self, X, y=None):
         """
@@ -183,6 +177,7 @@ class Landscape(BaseEstimator, TransformerMixin):
         _grid_from_sample_range(self, X)
         return self
 
+    @_traced("Landscape.transform")
     def transform(self, X):
         """
         Compute the persistence landscape for each persistence diagram individually and concatenate the results.
@@ -193,26 +188,8 @@ class Landscape(BaseEstimator, TransformerMixin):
         Returns:
             numpy array with shape (number of diagrams) x (number of samples = **num_landscapes** x **resolution**): output persistence landscapes.
         """
-
-        Xfit = []
-        x_values = self.grid_
-        for diag in X:
-            midpoints, heights = (diag[:, 0] + diag[:, 1]) / 2., (diag[:, 1] - diag[:, 0]) / 2.
-            tent_functions = np.maximum(heights[None, :] - np.abs(x_values[:, None] - midpoints[None, :]), 0)
-            n_points = diag.shape[0]
-            # Complete the array with zeros to get the right number of landscapes
-            if self.num_landscapes > n_points:
-                tent_functions = np.concatenate(
-                    [tent_functions, np.zeros((tent_functions.shape[0], self.num_landscapes-n_points))],
-                    axis=1
-                )
-            tent_functions.partition(tent_functions.shape[1]-self.num_landscapes, axis=1)
-            landscapes = np.sort(tent_functions[:, -self.num_landscapes:], axis=1)[:, ::-1].T
-
-            landscapes = np.sqrt(2) * np.ravel(landscapes)
-            Xfit.append(landscapes)
-
-        return np.stack(Xfit, axis=0)
+        coords, offsets = _pack_diagrams(X)
+        return _landscapes(coords, offsets, self.grid_, self.num_landscapes, _native_n_jobs(self.n_jobs))
 
     def __call__(self, diag):
         """
@@ -234,7 +211,7 @@ class Silhouette(BaseEstimator, TransformerMixin):
     Attributes:
         grid_ (1d array): The grid on which the silhouette is computed.
     """
-    def __init__(self, weight=lambda x: 1, resolution=100, sample_range=[np.nan, np.nan], *, keep_endpoints=False):
+    def __init__(self, weight=lambda x: 1, resolution=100, sample_range=[np.nan, np.nan], *, keep_endpoints=False, n_jobs=None):
         """
         Constructor for the Silhouette class.
 
@@ -243,9 +220,11 @@ class Silhouette(BaseEstimator, TransformerMixin):
             resolution (int): number of samples for the weighted average (default 100).
             sample_range ([double, double]): minimum and maximum for the weighted average domain, of the form [x_min, x_max] (default [numpy.nan, numpy.nan]). It is the interval on which samples will be drawn evenly. If one of the values is numpy.nan, it can be computed from the persistence diagrams with the fit() method.
             keep_endpoints (bool): when computing `sample_range`, use the exact extremities (where the value is always 0). This is mostly useful for plotting, the default is to use a slightly smaller range.
+            n_jobs (int): number of threads that compute the silhouettes, with the same meaning as in joblib (default None, ie 1).
         """
         self.weight, self.resolution, self.sample_range = weight, resolution, sample_range
         self.keep_endpoints = keep_endpoints
+        self.n_jobs = n_jobs
 
     def fit(self, X, y=None):
         """
@@ -258,6 +237,7 @@ class Silhouette(BaseEstimator, TransformerMixin):
         _grid_from_sample_range(self, X)
         return self
 
+    @_traced("Silhouette.transform")
     def transform(self, X):
         """
         Compute the persistence silhouette for each persistence diagram individually and concatenate the results.
@@ -268,19 +248,9 @@ class Silhouette(BaseEstimator, TransformerMixin):
         Returns:
             numpy array with shape (number of diagrams) x (**resolution**): output persistence silhouettes.
         """
-        Xfit = []
-        x_values = self.grid_
-
-        for diag in X:
-            midpoints, heights = (diag[:, 0] + diag[:, 1]) / 2., (diag[:, 1] - diag[:, 0]) / 2.
-            weights = np.array([self.weight(pt) for pt in diag])
-            total_weight = np.sum(weights)
-
-            tent_functions = np.maximum(heights[None, :] - np.abs(x_values[:, None] - midpoints[None, :]), 0)
-            silhouette = np.sum(weights[None, :] / total_weight * tent_functions, axis=1)
-            Xfit.append(silhouette * np.sqrt(2))
-
-        return np.stack(Xfit, axis=0)
+        coords, offsets = _pack_diagrams(X)
+        weights = np.array([self.weight(pt) for pt in coords], dtype=float)
+        return _silhouettes(coords, offsets, weights, self.grid_, _native_n_jobs(self.n_jobs))
 
     def __call__(self, diag):
         """
@@ -323,7 +293,7 @@ class BettiCurve(BaseEstimator, TransformerMixin):
         The grid on which the Betti numbers are computed. If predefined_grid was specified, `grid_` will always be that grid, independently of data. If not and resolution is None, the grid is fitted to capture all filtration values at which the Betti numbers change.
     """
 
-    def __init__(self, resolution=100, sample_range=[np.nan, np.nan], predefined_grid=None, *, keep_endpoints=False):
+    def __init__(self, resolution=100, sample_range=[np.nan, np.nan], predefined_grid=None, *, keep_endpoints=False, n_jobs=None):
         """
         Constructor for the BettiCurve class.
 
@@ -332,6 +302,7 @@ class BettiCurve(BaseEstimator, TransformerMixin):
             sample_range ([double, double]): minimum and maximum of the piecewise-constant function domain, of the form [x_min, x_max] (default [numpy.nan, numpy.nan]). It is the interval on which samples will be drawn evenly. If one of the values is numpy.nan, it can be computed from the persistence diagrams with the fit() method.
             predefined_grid (1d array or None, default=None): Predefined filtration grid points at which to compute the Betti curves. Must be strictly ordered. Infinities are ok. If None (default), and resolution is given, the grid will be uniform from x_min to x_max in 'resolution' steps, otherwise a grid will be computed that captures all changes in Betti numbers in the provided data.
             keep_endpoints (bool): when computing `sample_range` (fixed `resolution`, no `predefined_grid`), use the exact extremities. This is mostly useful for plotting, the default is to use a slightly smaller range.
+            n_jobs (int): number of threads that compute the Betti curves, with the same meaning as in joblib (default None, ie 1).
         """
 
         if (predefined_grid is not None) and (not isinstance(predefined_grid, np.ndarray)):
@@ -341,6 +312,7 @@ class BettiCurve(BaseEstimator, TransformerMixin):
         self.resolution = resolution
         self.sample_range = sample_range
         self.keep_endpoints = keep_endpoints
+        self.n_jobs = n_jobs
 
     def is_fitted(self):
         return hasattr(self, "grid_")
@@ -365,6 +337,7 @@ class BettiCurve(BaseEstimator, TransformerMixin):
 
         return self
 
+    @_traced("BettiCurve.transform")
     def transform(self, X):
         """
         Compute Betti curves.
@@ -381,71 +354,15 @@ class BettiCurve(BaseEstimator, TransformerMixin):
 
         if not X:
             X = [np.zeros((0, 2))]
-        
-        N = len(X)
-
-        events = np.concatenate([pd.ravel(order="F") for pd in X], axis=0)
-        sorting = np.argsort(events)
-        offsets = np.zeros(1 + N, dtype=int)
-        for i in range(0, N):
-            offsets[i+1] = offsets[i] + 2*X[i].shape[0]
-        starts = offsets[0:N]
-        ends = offsets[1:N + 1] - 1
-
-        bettis = [[0] for i in range(0, N)]
-
-        i = 0
-        for x in self.grid_:
-            while i < len(sorting) and events[sorting[i]] <= x:
-                j = np.searchsorted(ends, sorting[i])
-                delta = 1 if sorting[i] - starts[j] < len(X[j]) else -1
-                bettis[j][-1] += delta
-                i += 1
-            for k in range(0, N):
-                bettis[k].append(bettis[k][-1])
-
-        return np.array(bettis, dtype=int)[:, 0:-1]
+
+        coords, offsets = _pack_diagrams(X)
+        return _betti_curves(coords, offsets, np.asarray(self.grid_, dtype=float), _native_n_jobs(self.n_jobs))
 
     def fit_transform(self, X):
         """
-        The result is the same as fit(X) followed by transform(X), but potentially faster.
+        The result is the same as fit(X) followed by transform(X).
         """
-
-        if self.predefined_grid is None and self.resolution is None:
-            if not X:
-                X = [np.zeros((0, 2))]
-
-            N = len(X)
-
-            events = np.concatenate([pd.ravel(order="F") for pd in X], axis=0)
-            sorting = np.argsort(events)
-            offsets = np.zeros(1 + N, dtype=int)
-            for i in range(0, N):
-                offsets[i+1] = offsets[i] + 2*X[i].shape[0]
-            starts = offsets[0:N]
-            ends = offsets[1:N + 1] - 1
-
-            xs = [-np.inf]
-            bettis = [[0] for i in range(0, N)]
-
-            for i in sorting:
-                j = np.searchsorted(ends, i)
-                delta = 1 if i - starts[j] < len(X[j]) else -1
-                if events[i] == xs[-1]:
-                    bettis[j][-1] += delta
-                else:
-                    xs.append(events[i])
-                    for k in range(0, j):
-                        bettis[k].append(bettis[k][-1])
-                    bettis[j].append(bettis[j][-1] + delta)
-                    for k in range(j+1, N):
-                        bettis[k].append(bettis[k][-1])
-
-            self.grid_ = np.array(xs)
-            return np.array(bettis, dtype=int)
-
-        else:
-            return self.fit(X).transform(X)
+        return self.fit(X).transform(X)
 
     def __call__(self, diag):
         """
@@ -490,6 +407,7 @@ class Entropy(BaseEstimator, TransformerMixin):
             self.step_ = self.grid_[1] - self.grid_[0]
         return self
 
+    @_traced("Entropy.transform")
     def transform(self, X):
         """
         Compute the entropy for each persistence diagram individually and concatenate the results.
@@ -538,6 +456,39 @@ class Entropy(BaseEstimator, TransformerMixin):
         """
         return _maybe_fit_transform(self, 'grid_', diag)
 
+def _largest_topological_distances(diagram, k):
+    """
+    Compute the k largest values, in decreasing order, of min(chebyshev(p_i, p_j), pers_j) for the pairs i < j of
+    points of the diagram, where pers_j is half the life time of p_j, clipped at 0 (fewer than k if there are fewer
+    pairs).
+
+    The rows j are processed by decreasing pers_j, by blocks, as pers_j bounds all the values of the row: once k
+    values at least as large are found, the remaining rows are skipped, so that only the distances between the most
+    persistent points are computed, and never a full n x n matrix.
+
+    Parameters:
+        diagram (n x 2 numpy array): input persistence diagram.
+        k (int): number of values.
+    """
+    n = diagram.shape[0]
+    if n < 2 or k <= 0:
+        return np.empty(0)
+    pers = 0.5 * (diagram[:,1] - diagram[:,0])
+    order = np.argsort(-pers, kind="stable")
+    # About one million distances per block
+    block = max(1, (1 << 20) // n)
+    largest = np.empty(0)
+    for start in range(0, n, block):
+        rows = order[start:start + block]
+        if len(largest) == k and pers[rows[0]] <= largest[-1]:
+            break
+        values = np.minimum(cdist(diagram[rows], diagram, "chebyshev"), pers[rows, np.newaxis])
+        values = np.concatenate((largest, values[np.arange(n) < rows[:, np.newaxis]]))
+        if len(values) > k:
+            values = values[np.argpartition(-values, k - 1)[:k]]
+        largest = np.maximum(-np.sort(-values), 0)
+    return largest
+
 class TopologicalVector(BaseEstimator, TransformerMixin):
     """
     This is a class for computing topological vectors from a list of persistence diagrams. The topological vector associated to a persistence diagram is the sorted vector of a slight modification of the pairwise distances between the persistence diagram points. See https://diglib.eg.org/handle/10.1111/cgf12692 for more details.
@@ -561,6 +512,7 @@ class TopologicalVector(BaseEstimator, TransformerMixin):
         """
         return self
 
+    @_traced("TopologicalVector.transform")
     def transform(self, X):
         """
         Compute the topological vector for each persistence diagram individually and concatenate the results.
@@ -580,20 +532,9 @@ class TopologicalVector(BaseEstimator, TransformerMixin):
         Xfit = np.zeros([num_diag, thresh])
 
         for i in range(num_diag):
-
-            diagram, num_pts_in_diag = X[i], X[i].shape[0]
-            pers = 0.5 * (diagram[:,1]-diagram[:,0])
-            min_pers = np.minimum(pers,np.transpose(pers))
-            # Works fine with sklearn 1.0, but an ValueError exception is thrown on past versions
-            try:
-                distances = DistanceMetric.get_metric("chebyshev").pairwise(diagram)
-            except ValueError:
-                # Empty persistence diagram case - https://github.com/GUDHI/gudhi-devel/issues/507
-                assert len(diagram) == 0
-                distances = np.empty(shape = [0, 0])
-            vect = np.flip(np.sort(np.triu(np.minimum(distances, min_pers)), axis=None), 0)
-            dim = min(len(vect), thresh)
-            Xfit[i, :dim] = vect[:dim]
+            # Only the thresh largest values are computed, the other ones are 0
+            vect = _largest_topological_distances(X[i], thresh)
+            Xfit[i, :len(vect)] = vect
 
         return Xfit
 
@@ -633,6 +574,7 @@ class ComplexPolynomial(BaseEstimator, TransformerMixin):
         """
         return self
 
+    @_traced("ComplexPolynomial.transform")
     def transform(self, X):
         """
         Compute the complex vector of coefficients for each persistence diagram individually and concatenate the results.
@@ -733,7 +675,7 @@ class Atol(BaseEstimator, TransformerMixin):
            [1.25157463, 0.02062512]])
     """
     # Note the example above must be up to date with the one in tests called test_atol_doc
-    def __init__(self, quantiser, weighting_method="cloud", contrast="gaussian"):
+    def __init__(self, quantiser, weighting_method="cloud", contrast="gaussian", n_jobs=None):
         """
         Constructor for the Atol measure vectorisation class.
 
@@ -747,10 +689,13 @@ class Atol(BaseEstimator, TransformerMixin):
             contrast (string): constant function for evaluating proximity of a measure with respect to centers
                 choose from {"gaussian", "laplacian", "indicator"}
                 (default: gaussian contrast function, see page 3 in the ATOL paper).
+            n_jobs (int): number of threads that vectorise the measures in `transform`, with the same meaning as in
+                joblib (default None, ie 1).
         """
         self.quantiser = quantiser
         self.contrast = contrast
         self.weighting_method = weighting_method
+        self.n_jobs = n_jobs
 
     def get_contrast(self):
         return {
@@ -815,10 +760,9 @@ class Atol(BaseEstimator, TransformerMixin):
         Returns:
             numpy array in R^self.quantiser.n_clusters.
         """
-        if sample_weight is None:
-            sample_weight = self.get_weighting_method()(measure)
-        return np.sum(sample_weight * self.get_contrast()(measure, self.centers, self.inertias.T).T, axis=1)
+        return self.transform([measure], sample_weight=None if sample_weight is None else [sample_weight])[0]
 
+    @_traced("Atol.transform")
     def transform(self, X, sample_weight=None):
         """
         Apply measure vectorisation on a list of measures.
@@ -834,4 +778,12 @@ class Atol(BaseEstimator, TransformerMixin):
         """
         if sample_weight is None:
             sample_weight = [self.get_weighting_method()(measure) for measure in X]
-        return np.stack([self(measure, sample_weight=weight) for measure, weight in zip(X, sample_weight)])
+        # All the measures are vectorised at once in C++, with the contrast of get_contrast
+        dim = self.centers.shape[1]
+        X = [np.asarray(measure, dtype=float).reshape(-1, dim) for measure in X]
+        offsets = np.zeros(len(X) + 1, dtype=np.int64)
+        np.cumsum([len(measure) for measure in X], out=offsets[1:])
+        coords = np.concatenate(X) if len(X) > 0 else np.empty((0, dim))
+        weights = np.concatenate([np.asarray(w, dtype=float).ravel() for w in sample_weight] + [np.empty(0)])
+        contrast = self.contrast if self.contrast in ("laplacian", "indicator") else "gaussian"
+        return _atol(coords, offsets, weights, self.centers, self.inertias, contrast, _native_n_jobs(self.n_jobs))
@@ -12,7 +12,9 @@ from libcpp.vector cimport vector
 from libcpp.utility cimport pair
 from libcpp.string cimport string
 from libcpp cimport bool
-from libc.stdint cimport intptr_t
+from libc.stdint cimport intptr_t, uintptr_t
+from libc.stddef cimport ptrdiff_t
+import numpy as np
 
 from gudhi.simplex_tree cimport *
 from gudhi.simplex_tree import SimplexTree
@@ -25,11 +27,61 @@ cdef extern from "Rips_complex_interface.h" namespace "Gudhi":
     cdef cppclass Rips_complex_interface "Gudhi::rips_complex::Rips_complex_interface":
         Rips_complex_interface() nogil
         void init_points(vector[vector[double]] values, double threshold) nogil
+        void init_points_buffer(const float* data, size_t num_points, size_t dimension, ptrdiff_t stride0,
+                                ptrdiff_t stride1, double threshold) nogil except +
+        void init_points_buffer(const double* data, size_t num_points, size_t dimension, ptrdiff_t stride0,
+                                ptrdiff_t stride1, double threshold) nogil except +
         void init_matrix(vector[vector[double]] values, double threshold) nogil
+        void init_csr_matrix(vector[size_t] offsets, vector[int] indices, vector[double] distances, double threshold) nogil
+        void init_weighted_matrix(vector[vector[double]] values, vector[double] weights, double threshold) nogil
         void init_points_sparse(vector[vector[double]] values, double threshold, double sparse) nogil
+        void init_points_sparse_buffer(const float* data, size_t num_points, size_t dimension, ptrdiff_t stride0,
+                                       ptrdiff_t stride1, double threshold, double sparse) nogil except +
+        void init_points_sparse_buffer(const double* data, size_t num_points, size_t dimension, ptrdiff_t stride0,
+                                       ptrdiff_t stride1, double threshold, double sparse) nogil except +
         void init_matrix_sparse(vector[vector[double]] values, double threshold, double sparse) nogil
         void create_simplex_tree(Simplex_tree_interface_full_featured* simplex_tree, int dim_max) nogil except +
 
+cdef extern from "Rips_complex_interface.h" namespace "Gudhi::rips_complex":
+    vector[double] distance_to_measure(vector[vector[double]] distance_matrix, size_t k, double q) nogil except +
+    vector[pair[int, pair[double, double]]] rips_persistence_from_points(vector[vector[double]] points,
+        double threshold, int dim_max, int homology_coeff_field, double min_persistence) nogil except +
+    vector[pair[int, pair[double, double]]] rips_persistence_from_points_buffer(const float* data, size_t num_points,
+        size_t dimension, ptrdiff_t stride0, ptrdiff_t stride1, double threshold, int dim_max,
+        int homology_coeff_field, double min_persistence) nogil except +
+    vector[pair[int, pair[double, double]]] rips_persistence_from_points_buffer(const double* data, size_t num_points,
+        size_t dimension, ptrdiff_t stride0, ptrdiff_t stride1, double threshold, int dim_max,
+        int homology_coeff_field, double min_persistence) nogil except +
+    vector[pair[int, pair[double, double]]] rips_persistence_from_matrix(vector[vector[double]] matrix,
+        double threshold, int dim_max, int homology_coeff_field, double min_persistence) nogil except +
+    vector[vector[pair[int, pair[double, double]]]] rips_persistence_batch_from_points(const float* data,
+        const vector[size_t]& offsets, size_t dimension, ptrdiff_t stride0, ptrdiff_t stride1, double threshold,
+        int dim_max, int num_collapse_iterations, int homology_coeff_field, double min_persistence,
+        int n_jobs) nogil except +
+    vector[vector[pair[int, pair[double, double]]]] rips_persistence_batch_from_points(const double* data,
+        const vector[size_t]& offsets, size_t dimension, ptrdiff_t stride0, ptrdiff_t stride1, double threshold,
+        int dim_max, int num_collapse_iterations, int homology_coeff_field, double min_persistence,
+        int n_jobs) nogil except +
+    vector[vector[pair[int, pair[double, double]]]] rips_persistence_batch_from_matrices(const double* data,
+        const vector[size_t]& sizes, double threshold, int dim_max, int num_collapse_iterations,
+        int homology_coeff_field, double min_persistence, int n_jobs) nogil except +
+    void fill_persistence_diagrams(const vector[vector[pair[int, pair[double, double]]]]& diagrams,
+        uintptr_t dimensions, uintptr_t intervals) nogil
+    cdef cppclass Sliding_window_rips_interface "Gudhi::rips_complex::Sliding_window_rips_interface":
+        Sliding_window_rips_interface(double threshold, int dim_max) nogil
+        void push_back(const vector[double]& point) nogil
+        void pop_front() nogil except +
+        size_t size() nogil
+        size_t num_simplices() nogil
+        vector[pair[int, pair[double, double]]] persistence(int homology_coeff_field,
+                                                            double min_persistence) nogil except +
+
+def _is_points_buffer(points):
+    """Whether the points are a non empty 2d array of float32 or float64, which is read in place by the C++ code
+    (with any strides) instead of being copied to a vector[vector[double]]."""
+    return (isinstance(points, np.ndarray) and points.ndim == 2 and points.size > 0
+            and points.dtype in (np.float32, np.float64))
+
 # RipsComplex python interface
 cdef class RipsComplex:
     """The data structure is a one skeleton graph, or Rips graph, containing edges when the edge length is less or
@@ -43,13 +95,16 @@ cdef class RipsComplex:
     def __init__(self, *, points=None, distance_matrix=None, max_edge_length=float('inf'), sparse=None):
         """RipsComplex constructor.
 
-        :param points: A list of points in d-Dimension.
-        :type points: List[List[float]]
+        :param points: A list of points in d-Dimension. A 2d numpy array of float32 or float64 is read in place,
+            without any copy.
+        :type points: List[List[float]] or numpy.ndarray
 
         Or
 
-        :param distance_matrix: A distance matrix (full square or lower triangular).
-        :type distance_matrix: List[List[float]]
+        :param distance_matrix: A distance matrix (full square or lower triangular), or a sparse matrix (e.g.
+            `scipy.sparse.csr_matrix`), whose absent entries are infinite distances, and which is never densified.
+            If both entries (i,j) and (j,i) are present, the smallest one is used.
+        :type distance_matrix: List[List[float]] or scipy sparse matrix
 
         And in both cases
 
@@ -63,6 +118,17 @@ cdef class RipsComplex:
 
     # The real cython constructor
     def __cinit__(self, *, points=None, distance_matrix=None, max_edge_length=float('inf'), sparse=None):
+        if distance_matrix is not None and hasattr(distance_matrix, "tocsr"):
+            if sparse is not None:
+                raise ValueError("sparse is not supported with a sparse distance_matrix")
+            if distance_matrix.shape[0] != distance_matrix.shape[1]:
+                raise ValueError("The sparse distance_matrix must be square")
+            csr = distance_matrix.tocsr()
+            self.thisref.init_csr_matrix(csr.indptr, csr.indices, csr.data, max_edge_length)
+            return
+        if distance_matrix is None and _is_points_buffer(points):
+            self._init_points_buffer(points, max_edge_length, sparse)
+            return
         if sparse is not None:
           if distance_matrix is not None:
               self.thisref.init_matrix_sparse(distance_matrix, max_edge_length, sparse)
@@ -81,6 +147,32 @@ cdef class RipsComplex:
               self.thisref.init_points(points, max_edge_length)
 
 
+    def _init_points_buffer(self, points, double threshold, sparse):
+        cdef const float[:, :] points_f32
+        cdef const double[:, :] points_f64
+        cdef bool is_sparse = sparse is not None
+        cdef double epsilon = sparse if is_sparse else 0.
+        if points.dtype == np.float32:
+            points_f32 = points
+            with nogil:
+                if is_sparse:
+                    self.thisref.init_points_sparse_buffer(&points_f32[0, 0], points_f32.shape[0], points_f32.shape[1],
+                                                           points_f32.strides[0], points_f32.strides[1], threshold,
+                                                           epsilon)
+                else:
+                    self.thisref.init_points_buffer(&points_f32[0, 0], points_f32.shape[0], points_f32.shape[1],
+                                                    points_f32.strides[0], points_f32.strides[1], threshold)
+        else:
+            points_f64 = points
+            with nogil:
+                if is_sparse:
+                    self.thisref.init_points_sparse_buffer(&points_f64[0, 0], points_f64.shape[0], points_f64.shape[1],
+                                                           points_f64.strides[0], points_f64.strides[1], threshold,
+                                                           epsilon)
+                else:
+                    self.thisref.init_points_buffer(&points_f64[0, 0], points_f64.shape[0], points_f64.shape[1],
+                                                    points_f64.strides[0], points_f64.strides[1], threshold)
+
     def create_simplex_tree(self, max_dimension=1):
         """
         :param max_dimension: graph expansion for Rips until this given maximal dimension.
@@ -94,3 +186,260 @@ cdef class RipsComplex:
         with nogil:
             self.thisref.create_simplex_tree(<Simplex_tree_interface_full_featured*>stree_int_ptr, maxdim)
         return stree
+
+
+def rips_persistence(*, points=None, distance_matrix=None, max_edge_length=float('inf'), max_dimension=1,
+                     homology_coeff_field=11, min_persistence=0):
+    """Persistence of the Rips complex, without building it. This gives the same result as
+    `RipsComplex(...).create_simplex_tree(max_dimension).persistence(homology_coeff_field, min_persistence)`, but H0
+    is computed with a union-find on the sorted edges, and the simplices of each higher dimension are enumerated from
+    the distances when this dimension is reduced, and discarded before the next one. The memory is then bounded by the
+    distance matrix and the simplices of one dimension, instead of all the simplices of the complex.
+
+    :param points: A list of points in d-Dimension, with the euclidean distance. A 2d numpy array of float32 or
+        float64 is read in place, without any copy.
+    :type points: List[List[float]] or numpy.ndarray
+
+    Or
+
+    :param distance_matrix: A distance matrix (full square or lower triangular).
+    :type distance_matrix: List[List[float]]
+
+    And in both cases
+
+    :param max_edge_length: Maximal edge length. All edges strictly greater than `max_edge_length` are ignored.
+    :type max_edge_length: float
+    :param max_dimension: Maximal dimension of the simplices of the Rips complex. The persistence is computed until
+        dimension `max_dimension - 1`.
+    :type max_dimension: int
+    :param homology_coeff_field: The homology coefficient field. Must be a prime number. Default value is 11.
+    :type homology_coeff_field: int
+    :param min_persistence: The minimum persistence value to take into account (strictly greater than
+        min_persistence). Default value is 0.0.
+    :type min_persistence: float
+    :returns: The persistence of the Rips complex, in the same order as :func:`~gudhi.SimplexTree.persistence`.
+    :rtype: list of pairs(dimension, pair(birth, death))
+    """
+    cdef vector[vector[double]] values
+    cdef double threshold = max_edge_length
+    cdef int dim_max = max_dimension
+    cdef int field = homology_coeff_field
+    cdef double min_pers = min_persistence
+    cdef vector[pair[int, pair[double, double]]] persistence
+    cdef const float[:, :] points_f32
+    cdef const double[:, :] points_f64
+    if distance_matrix is None and _is_points_buffer(points):
+        if points.dtype == np.float32:
+            points_f32 = points
+            with nogil:
+                persistence = rips_persistence_from_points_buffer(&points_f32[0, 0], points_f32.shape[0],
+                    points_f32.shape[1], points_f32.strides[0], points_f32.strides[1], threshold, dim_max, field,
+                    min_pers)
+        else:
+            points_f64 = points
+            with nogil:
+                persistence = rips_persistence_from_points_buffer(&points_f64[0, 0], points_f64.shape[0],
+                    points_f64.shape[1], points_f64.strides[0], points_f64.strides[1], threshold, dim_max, field,
+                    min_pers)
+    elif distance_matrix is not None:
+        values = distance_matrix
+        with nogil:
+            persistence = rips_persistence_from_matrix(values, threshold, dim_max, field, min_pers)
+    else:
+        if points is not None:
+            values = points
+        with nogil:
+            persistence = rips_persistence_from_points(values, threshold, dim_max, field, min_pers)
+    return persistence
+
+
+def _rips_persistence_batch(X, input_type='point cloud', max_edge_length=float('inf'), max_dimension=1,
+                            num_collapse_iterations=0, homology_coeff_field=11, min_persistence=0, n_jobs=0):
+    """Persistence of the Rips complexes of a batch of point clouds or of distance matrices, computed in C++ in
+    parallel and without the GIL, each as :func:`rips_persistence`. If `num_collapse_iterations` is positive, the
+    edges of each complex are first collapsed that many times (cf. :meth:`~gudhi.SimplexTree.collapse_edges`), and
+    the persistence is computed on the expansion of the collapsed graph in a simplex tree.
+
+    :param X: The point clouds (of the same dimension), with 'point cloud', or the full square distance matrices, with
+        'full distance matrix'. A 3d numpy array of float32 or float64 point clouds is read in place.
+    :type X: list of array-like or numpy.ndarray
+    :param n_jobs: Number of threads of the pool of :mod:`gudhi.parallel`, all of them if 0.
+    :type n_jobs: int
+    :returns: The diagrams, packed in 3 arrays `(offsets, dimensions, intervals)` as :func:`persistence_batch`.
+    :rtype: Tuple[numpy.array[int] of shape (n+1,), numpy.array[int] of shape (m,), numpy.array[float] of shape (m,2)]
+    """
+    cdef double threshold = max_edge_length
+    cdef int dim_max = max_dimension
+    cdef int collapses = num_collapse_iterations
+    cdef int field = homology_coeff_field
+    cdef double min_pers = min_persistence
+    cdef int jobs = n_jobs
+    cdef vector[size_t] offsets
+    cdef vector[vector[pair[int, pair[double, double]]]] diagrams
+    cdef const float[:, :] points_f32
+    cdef const double[:, :] points_f64
+    cdef const double[::1] matrices
+    if input_type == 'point cloud':
+        if isinstance(X, np.ndarray) and X.ndim == 3 and X.dtype in (np.float32, np.float64):
+            points = X.reshape(X.shape[0] * X.shape[1], X.shape[2])
+            offsets = np.arange(X.shape[0] + 1) * X.shape[1]
+        else:
+            clouds = [np.asarray(cloud, dtype=np.float64) for cloud in X]
+            dimension = max([cloud.shape[-1] for cloud in clouds if cloud.size > 0], default=0)
+            clouds = [cloud.reshape(-1, dimension) for cloud in clouds]
+            points = np.concatenate(clouds) if len(clouds) > 0 else np.empty((0, 0))
+            offsets = np.concatenate([[0], np.cumsum([len(cloud) for cloud in clouds])]).astype(np.uintp)
+        if points.size == 0:
+            # No coordinate to read, all the distances are 0
+            points = np.zeros((max(points.shape[0], 1), 1))
+        if points.dtype == np.float32:
+            points_f32 = points
+            with nogil:
+                diagrams = rips_persistence_batch_from_points(&points_f32[0, 0], offsets, points_f32.shape[1],
+                    points_f32.strides[0], points_f32.strides[1], threshold, dim_max, collapses, field, min_pers,
+                    jobs)
+        else:
+            points_f64 = points
+            with nogil:
+                diagrams = rips_persistence_batch_from_points(&points_f64[0, 0], offsets, points_f64.shape[1],
+                    points_f64.strides[0], points_f64.strides[1], threshold, dim_max, collapses, field, min_pers,
+                    jobs)
+    elif input_type == 'full distance matrix':
+        squares = [np.asarray(matrix, dtype=np.float64) for matrix in X]
+        if any(m.size > 0 and (m.ndim != 2 or m.shape[0] != m.shape[1]) for m in squares):
+            raise ValueError("The distance matrices must be square")
+        offsets = [len(m) if m.size > 0 else 0 for m in squares]
+        matrices = np.concatenate([m.reshape(-1) for m in squares] + [np.zeros(1)])
+        with nogil:
+            diagrams = rips_persistence_batch_from_matrices(&matrices[0], offsets, threshold, dim_max, collapses,
+                                                            field, min_pers, jobs)
+    else:
+        raise ValueError("input_type can only be 'point cloud' or 'full distance matrix'")
+    diagram_offsets = np.zeros(diagrams.size() + 1, dtype=np.intp)
+    cdef size_t k
+    for k in range(diagrams.size()):
+        diagram_offsets[k + 1] = diagram_offsets[k] + diagrams[k].size()
+    dimensions = np.empty(diagram_offsets[-1], dtype=np.intc)
+    intervals = np.empty((diagram_offsets[-1], 2), dtype=np.float64)
+    cdef uintptr_t dimensions_ptr = dimensions.ctypes.data
+    cdef uintptr_t intervals_ptr = intervals.ctypes.data
+    with nogil:
+        fill_persistence_diagrams(diagrams, dimensions_ptr, intervals_ptr)
+    return diagram_offsets, dimensions, intervals
+
+
+cdef class SlidingWindowRipsPersistence:
+    """Persistence of the Rips complex of the last points of a stream, e.g. of the time-delay embedding of a time
+    series, as a window where the points enter at the end and leave from the front. The complex is not rebuilt at
+    each step: the simplices that contain a new point are inserted in it, and the ones that contain the point leaving
+    the window are removed from it. Only the persistence is computed again from the updated complex.
+    """
+
+    cdef Sliding_window_rips_interface* thisptr
+
+    # Fake constructor that does nothing but documenting the constructor
+    def __init__(self, max_edge_length=float('inf'), max_dimension=2):
+        """SlidingWindowRipsPersistence constructor, with an empty window.
+
+        :param max_edge_length: Maximal edge length. All edges strictly greater than `max_edge_length` are ignored.
+        :type max_edge_length: float
+        :param max_dimension: Maximal dimension of the simplices of the Rips complex. The persistence is computed
+            until dimension `max_dimension - 1`.
+        :type max_dimension: int
+        """
+
+    # The real cython constructor
+    def __cinit__(self, max_edge_length=float('inf'), max_dimension=2):
+        self.thisptr = new Sliding_window_rips_interface(max_edge_length, max_dimension)
+
+    def __dealloc__(self):
+        if self.thisptr != NULL:
+            del self.thisptr
+
+    def __len__(self):
+        return self.thisptr.size()
+
+    def append(self, point):
+        """Adds a point at the end of the window, with the euclidean distance to the other points.
+
+        :param point: The coordinates of the point.
+        :type point: List[float]
+        """
+        cdef vector[double] p = point
+        with nogil:
+            self.thisptr.push_back(p)
+
+    def popleft(self):
+        """Removes the oldest point of the window.
+
+        :raises IndexError: If the window is empty.
+        """
+        if self.thisptr.size() == 0:
+            raise IndexError("popleft from an empty window")
+        with nogil:
+            self.thisptr.pop_front()
+
+    def num_simplices(self):
+        """
+        :returns: The number of simplices of the Rips complex of the window.
+        :rtype: int
+        """
+        return self.thisptr.num_simplices()
+
+    def persistence(self, homology_coeff_field=11, min_persistence=0):
+        """Persistence of the Rips complex of the points of the window.
+
+        :param homology_coeff_field: The homology coefficient field. Must be a prime number. Default value is 11.
+        :type homology_coeff_field: int
+        :param min_persistence: The minimum persistence value to take into account (strictly greater than
+            min_persistence). Default value is 0.0.
+        :type min_persistence: float
+        :returns: The persistence of the Rips complex, in the same order as :func:`~gudhi.SimplexTree.persistence`.
+        :rtype: list of pairs(dimension, pair(birth, death))
+        """
+        cdef int field = homology_coeff_field
+        cdef double min_pers = min_persistence
+        cdef vector[pair[int, pair[double, double]]] persistence
+        with nogil:
+            persistence = self.thisptr.persistence(field, min_pers)
+        return persistence
+
+
+def _weighted_rips_simplex_tree(distance_matrix, weights, max_filtration, max_dimension):
+    """Weighted Rips filtration of :class:`~gudhi.weighted_rips_complex.WeightedRipsComplex`, built in C++."""
+    cdef Rips_complex_interface rips
+    rips.init_weighted_matrix(distance_matrix, weights, max_filtration)
+    stree = SimplexTree()
+    cdef intptr_t stree_int_ptr=stree.thisptr
+    cdef int maxdim = max_dimension
+    with nogil:
+        rips.create_simplex_tree(<Simplex_tree_interface_full_featured*>stree_int_ptr, maxdim)
+    return stree
+
+
+def _distance_to_measure(distance_matrix, k, q):
+    """Distance to measure of each row of a full distance matrix, with k neighbors (including the point itself)."""
+    cdef vector[vector[double]] matrix = distance_matrix
+    cdef size_t c_k = k
+    cdef double c_q = q
+    cdef vector[double] dtm
+    with nogil:
+        dtm = distance_to_measure(matrix, c_k, c_q)
+    return dtm
+
+# Tracing of the C++ code called by this module, which has its own copy of the instrumentation, cf. gudhi.tracing
+def _start_tracing():
+    c_start_tracing()
+
+def _stop_tracing():
+    c_stop_tracing()
+
+def _trace_events():
+    cdef vector[Profiling_trace_event] events
+    cdef Profiling_trace_event event
+    with nogil:
+        events = c_trace_events()
+    out = []
+    for event in events:
+        out.append((event.name.decode("utf-8"), chr(event.phase), event.timestamp, event.thread))
+    return out
@@ -6,6 +6,7 @@
 #
 # Modification(s):
 #   - 2023/02 Vincent Rouvreau: Add serialize/deserialize for pickle feature
+#   - 2023/10 David Loiseaux: Simplex tree with float filtration values
 #   - YYYY/MM Author: Description of the modification
 
 from cython cimport numeric
@@ -13,6 +14,8 @@ from libcpp.vector cimport vector
 from libcpp.utility cimport pair
 from libcpp cimport bool
 from libcpp.string cimport string
+from libcpp.map cimport map
+from libc.stdint cimport uintptr_t, uint64_t
 
 __author__ = "Vincent Rouvreau"
 __copyright__ = "Copyright (C) 2016 Inria"
@@ -44,6 +47,19 @@ cdef extern from "Simplex_tree_interface.h" namespace "Gudhi":
         bint operator!=(Simplex_tree_boundary_iterator) nogil
 
 
+    cdef cppclass Simplex_tree_memory_usage "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_full_featured>::Memory_usage":
+        size_t nodes
+        size_t siblings
+        size_t filtration_values
+        size_t label_lists
+        size_t filtration_cache
+        size_t find_index
+        size_t total() nogil
+
+    cdef cppclass Simplex_tree_expansion_budget "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_full_featured>::Expansion_budget":
+        size_t max_num_simplices
+        size_t max_memory
+
     cdef cppclass Simplex_tree_interface_full_featured "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_full_featured>":
         Simplex_tree_interface_full_featured() nogil
         Simplex_tree_interface_full_featured(Simplex_tree_interface_full_featured&) nogil
@@ -60,9 +76,15 @@ cdef extern from "Simplex_tree_interface.h" namespace "Gudhi":
         bool insert(vector[int] simplex, double filtration) nogil
         void insert_matrix(double* filtrations, int n, int stride0, int stride1, double max_filtration) nogil except +
         void insert_batch_vertices(vector[int] v, double f) nogil except +
+        void insert_batch_array(const int* vertices, size_t n, size_t k, const double* filtrations) nogil except +
+        void insert_edges_array(const int* rows, const int* cols, const double* filtrations, size_t n) nogil except +
         vector[pair[vector[int], double]] get_star(vector[int] simplex) nogil
         vector[pair[vector[int], double]] get_cofaces(vector[int] simplex, int dimension) nogil
+        vector[vector[pair[vector[int], double]]] get_cofaces_batch(vector[vector[int]] simplices, int dimension) nogil
         void expansion(int max_dim) nogil except +
+        bool expansion_with_budget(int max_dim, const Simplex_tree_expansion_budget& budget) nogil except +
+        vector[double] estimate_expansion_size(int max_dim, size_t num_samples) nogil
+        vector[double] estimate_expansion_size(int max_dim, size_t num_samples, unsigned int seed) nogil
         void remove_maximal_simplex(vector[int] simplex) nogil
         bool prune_above_filtration(double filtration) nogil
         bool prune_above_dimension(int dimension) nogil
@@ -70,6 +92,10 @@ cdef extern from "Simplex_tree_interface.h" namespace "Gudhi":
         void compute_extended_filtration() nogil
         Simplex_tree_interface_full_featured* collapse_edges(int nb_collapse_iteration) nogil except +
         void reset_filtration(double filtration, int dimension) nogil
+        void assign_lower_star_filtration(const double* values, size_t n) nogil except +
+        void assign_flag_filtration(const double* distances, size_t n) nogil except +
+        void fill_filtration_values(uintptr_t filtrations) nogil
+        void assign_filtration_values(const double* values, size_t n) nogil except +
         bint operator==(Simplex_tree_interface_full_featured) nogil
         # Iterators over Simplex tree
         pair[vector[int], double] get_simplex_and_filtration(Simplex_tree_simplex_handle f_simplex) nogil
@@ -80,23 +106,151 @@ cdef extern from "Simplex_tree_interface.h" namespace "Gudhi":
         Simplex_tree_skeleton_iterator get_skeleton_iterator_begin(int dimension) nogil
         Simplex_tree_skeleton_iterator get_skeleton_iterator_end(int dimension) nogil
         pair[Simplex_tree_boundary_iterator, Simplex_tree_boundary_iterator] get_boundary_iterators(vector[int] simplex) nogil except +
+        pair[size_t, size_t] boundary_matrix_sizes() nogil
+        void fill_boundary_matrix(uintptr_t column_offsets, uintptr_t row_indices, uintptr_t dimensions, uintptr_t filtrations) nogil except +
         # Expansion with blockers
         ctypedef bool (*blocker_func_t)(vector[int], void *user_data) except +
         void expansion_with_blockers_callback(int dimension, blocker_func_t user_func, void *user_data) except +
         void serialize(char* buffer, const size_t buffer_size) nogil except +
         void deserialize(const char* buffer, const size_t buffer_size) nogil except +
         size_t get_serialization_size() nogil
+        uint64_t content_hash() nogil
+        Simplex_tree_memory_usage memory_usage() nogil
+
+    Simplex_tree_memory_usage estimate_simplex_tree_memory_usage "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_full_featured>::estimate_memory_usage"(const vector[size_t]& num_simplices_by_dimension) nogil
+
+    # The simplex tree with float filtration values, of the SimplexTree of dtype float32
+    cdef cppclass Simplex_tree_float_simplex_handle "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_float_filtration>::Simplex_handle":
+        pass
+
+    cdef cppclass Simplex_tree_float_simplices_iterator "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_float_filtration>::Complex_simplex_iterator":
+        Simplex_tree_float_simplices_iterator() nogil
+        Simplex_tree_float_simplex_handle& operator*() nogil
+        Simplex_tree_float_simplices_iterator operator++() nogil
+        bint operator!=(Simplex_tree_float_simplices_iterator) nogil
+
+    cdef cppclass Simplex_tree_float_skeleton_iterator "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_float_filtration>::Skeleton_simplex_iterator":
+        Simplex_tree_float_skeleton_iterator() nogil
+        Simplex_tree_float_simplex_handle& operator*() nogil
+        Simplex_tree_float_skeleton_iterator operator++() nogil
+        bint operator!=(Simplex_tree_float_skeleton_iterator) nogil
+
+    cdef cppclass Simplex_tree_float_memory_usage "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_float_filtration>::Memory_usage":
+        size_t nodes
+        size_t siblings
+        size_t filtration_values
+        size_t label_lists
+        size_t filtration_cache
+        size_t find_index
+        size_t total() nogil
+
+    cdef cppclass Simplex_tree_interface_float "Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_float_filtration>":
+        Simplex_tree_interface_float() nogil
+        Simplex_tree_interface_float(Simplex_tree_interface_float&) nogil
+        double simplex_filtration(vector[int] simplex) nogil
+        void assign_simplex_filtration(vector[int] simplex, double filtration) nogil except +
+        void initialize_filtration() nogil
+        int num_vertices() nogil
+        int num_simplices() nogil
+        bool is_empty() nogil
+        int dimension() nogil
+        int upper_bound_dimension() nogil
+        bool find_simplex(vector[int] simplex) nogil
+        bool insert(vector[int] simplex, double filtration) nogil
+        void insert_batch_array(const int* vertices, size_t n, size_t k, const double* filtrations) nogil except +
+        void expansion(int max_dim) nogil except +
+        bool make_filtration_non_decreasing() nogil
+        void fill_filtration_values(uintptr_t filtrations) nogil
+        bint operator==(Simplex_tree_interface_float) nogil
+        pair[vector[int], double] get_simplex_and_filtration(Simplex_tree_float_simplex_handle f_simplex) nogil
+        Simplex_tree_float_simplices_iterator get_simplices_iterator_begin() nogil
+        Simplex_tree_float_simplices_iterator get_simplices_iterator_end() nogil
+        vector[Simplex_tree_float_simplex_handle].const_iterator get_filtration_iterator_begin() nogil
+        vector[Simplex_tree_float_simplex_handle].const_iterator get_filtration_iterator_end() nogil
+        Simplex_tree_float_skeleton_iterator get_skeleton_iterator_begin(int dimension) nogil
+        Simplex_tree_float_skeleton_iterator get_skeleton_iterator_end(int dimension) nogil
+        void serialize(char* buffer, const size_t buffer_size) nogil except +
+        size_t get_serialization_size() nogil
+        uint64_t content_hash() nogil
+        Simplex_tree_float_memory_usage memory_usage() nogil
+
+cdef extern from "gudhi/Cancellation.h" namespace "Gudhi":
+    cdef cppclass Cancellation_flag "Gudhi::Cancellation_flag":
+        Cancellation_flag() nogil
+        void cancel() nogil
+        bool is_cancelled() nogil
+
+    Cancellation_flag* exchange_cancellation_flag "Gudhi::exchange_cancellation_flag"(Cancellation_flag* flag) nogil
 
 cdef extern from "Persistent_cohomology_interface.h" namespace "Gudhi":
+    cdef cppclass Simplex_tree_persistence_memory_usage "Gudhi::Persistent_cohomology_interface<Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_full_featured>>::Memory_usage":
+        size_t cells
+        size_t columns
+        size_t rows
+        size_t disjoint_sets
+        size_t persistent_pairs
+        size_t cocycles
+        size_t total() nogil
+
     cdef cppclass Simplex_tree_persistence_interface "Gudhi::Persistent_cohomology_interface<Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_full_featured>>":
         Simplex_tree_persistence_interface(Simplex_tree_interface_full_featured * st, bool persistence_dim_max) nogil
+        void reset(bool persistence_dim_max) nogil except +
         void compute_persistence(int homology_coeff_field, double min_persistence) nogil except +
+        void compute_persistence(int homology_coeff_field, double min_persistence, bool matrix_reduction) nogil except +
+        void compute_persistence(int homology_coeff_field, double min_persistence, double max_filtration, int max_dimension) nogil except +
         vector[pair[int, pair[double, double]]] get_persistence() nogil
         vector[int] betti_numbers() nogil
         vector[int] persistent_betti_numbers(double from_value, double to_value) nogil
         vector[pair[double,double]] intervals_in_dimension(int dimension) nogil
         void write_output_diagram(string diagram_file_name) nogil except +
+        void write_persistence_binary(string file_name) nogil except +
         vector[pair[vector[int], vector[int]]] persistence_pairs() nogil
-        pair[vector[vector[int]], vector[vector[int]]] lower_star_generators() nogil
-        pair[vector[vector[int]], vector[vector[int]]] flag_generators() nogil
+        vector[size_t] num_intervals_by_dimension() nogil
+        void fill_intervals_by_dimension(const vector[uintptr_t]& intervals, bool single_precision) nogil
+        pair[vector[size_t], vector[size_t]] num_generators_by_dimension() nogil
+        void fill_lower_star_generators(const vector[uintptr_t]& regular, const vector[uintptr_t]& essential) nogil
+        void fill_flag_generators(const vector[uintptr_t]& regular, const vector[uintptr_t]& essential) nogil
         vector[vector[pair[int, pair[double, double]]]] compute_extended_persistence_subdiagrams(double min_persistence) nogil
+        Simplex_tree_persistence_memory_usage memory_usage() nogil
+
+    cdef cppclass Simplex_tree_float_persistence_interface "Gudhi::Persistent_cohomology_interface<Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_float_filtration>>":
+        Simplex_tree_float_persistence_interface(Simplex_tree_interface_float * st, bool persistence_dim_max) nogil
+        void reset(bool persistence_dim_max) nogil except +
+        void compute_persistence(int homology_coeff_field, double min_persistence, bool matrix_reduction) nogil except +
+        void compute_persistence(int homology_coeff_field, double min_persistence, double max_filtration, int max_dimension) nogil except +
+        vector[pair[int, pair[double, double]]] get_persistence() nogil
+        vector[int] betti_numbers() nogil
+        vector[int] persistent_betti_numbers(double from_value, double to_value) nogil
+        vector[pair[double,double]] intervals_in_dimension(int dimension) nogil
+        void write_output_diagram(string diagram_file_name) nogil except +
+        void write_persistence_binary(string file_name) nogil except +
+        vector[pair[vector[int], vector[int]]] persistence_pairs() nogil
+        vector[size_t] num_intervals_by_dimension() nogil
+        void fill_intervals_by_dimension(const vector[uintptr_t]& intervals, bool single_precision) nogil
+
+    vector[size_t] compute_persistence_batch "Gudhi::compute_persistence_batch<Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_full_featured>>"(const vector[Simplex_tree_persistence_interface*]& pcoh, int homology_coeff_field, double min_persistence, bool persistence_dim_max) nogil except +
+    void fill_persistence_batch "Gudhi::fill_persistence_batch<Gudhi::Simplex_tree_interface<Gudhi::Simplex_tree_options_full_featured>>"(const vector[Simplex_tree_persistence_interface*]& pcoh, const vector[size_t]& offsets, uintptr_t dimensions, uintptr_t intervals) nogil
+
+cdef extern from "gudhi/Profiler.h" namespace "Gudhi::profiling":
+    cdef cppclass Profiling_timer_entry "Gudhi::profiling::Timer_entry":
+        double seconds
+        size_t calls
+
+    cdef cppclass Profiling_report "Gudhi::profiling::Report":
+        map[string, Profiling_timer_entry] timers
+        map[string, size_t] counters
+
+    Profiling_report c_profiling_report "Gudhi::profiling::report"() nogil
+    void c_reset_profiling "Gudhi::profiling::reset"() nogil
+    bool c_profiling_enabled "Gudhi::profiling::enabled"() nogil
+
+    cdef cppclass Profiling_trace_event "Gudhi::profiling::Trace_event":
+        string name
+        char phase
+        double timestamp
+        size_t thread
+    void c_start_tracing "Gudhi::profiling::start_tracing"() nogil
+    void c_stop_tracing "Gudhi::profiling::stop_tracing"() nogil
+    void c_begin_event "Gudhi::profiling::begin_event"(string name) nogil
+    void c_end_event "Gudhi::profiling::end_event"(string name) nogil
+    vector[Profiling_trace_event] c_trace_events "Gudhi::profiling::trace_events"() nogil
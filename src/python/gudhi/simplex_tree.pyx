@@ -6,12 +6,16 @@
 #
 # Modification(s):
 #   - 2023/02 Vincent Rouvreau: Add serialize/deserialize for pickle feature
+#   - 2023/10 David Loiseaux: Simplex tree with float filtration values
 #   - YYYY/MM Author: Description of the modification
 
 from cython.operator import dereference, preincrement
-from libc.stdint cimport intptr_t, int32_t, int64_t
+from libc.stdint cimport intptr_t, int32_t, int64_t, uintptr_t, uint64_t
+import hashlib
+import os
 import numpy as np
 cimport gudhi.simplex_tree
+from gudhi.parallel import _submit_cancellable
 cimport cython
 from numpy.math cimport INFINITY
 
@@ -30,6 +34,42 @@ ctypedef fused some_float:
 cdef bool callback(vector[int] simplex, void *blocker_func):
     return (<object>blocker_func)(simplex)
 
+cdef _simplex_tree_memory_usage_dict(Simplex_tree_memory_usage& usage):
+    return {"nodes": usage.nodes, "siblings": usage.siblings, "filtration_values": usage.filtration_values,
+            "label_lists": usage.label_lists, "filtration_cache": usage.filtration_cache,
+            "find_index": usage.find_index, "total": usage.total()}
+
+cdef _simplex_tree_float_memory_usage_dict(Simplex_tree_float_memory_usage& usage):
+    return {"nodes": usage.nodes, "siblings": usage.siblings, "filtration_values": usage.filtration_values,
+            "label_lists": usage.label_lists, "filtration_cache": usage.filtration_cache,
+            "find_index": usage.find_index, "total": usage.total()}
+
+cdef class _CancellationFlag:
+    """Flag of the cooperative cancellation of a computation of the `*_async` methods, e.g.
+    :func:`~gudhi.SimplexTree.persistence_async`, shared by the compiled modules through its address.
+    """
+    cdef Cancellation_flag* thisptr
+
+    def __cinit__(self):
+        self.thisptr = new Cancellation_flag()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def cancel(self):
+        self.thisptr.cancel()
+
+    def is_cancelled(self):
+        return self.thisptr.is_cancelled()
+
+    def _address(self):
+        return <uintptr_t>self.thisptr
+
+def _exchange_cancellation_flag(uintptr_t flag):
+    """Sets the cancellation flag, given by its address or 0, checked by the computations of this module started by
+    the current thread, and returns the address of the previous one."""
+    return <uintptr_t>exchange_cancellation_flag(<Cancellation_flag*>flag)
+
 # SimplexTree python interface
 cdef class SimplexTree:
     """The simplex tree is an efficient and flexible data structure for
@@ -40,58 +80,117 @@ cdef class SimplexTree:
 
     This class is a filtered, with keys, and non contiguous vertices version
     of the simplex tree.
+
+    The filtration values are stored as `double` by default, or as `float` with `dtype=numpy.float32`, which makes
+    the nodes of the tree a quarter smaller, e.g. for large flag complexes whose filtration values do not need
+    double precision. A SimplexTree of dtype float32 supports the construction of a filtration and its persistence:
+    :func:`insert`, :func:`insert_batch`, :func:`expansion`, :func:`make_filtration_non_decreasing`,
+    :func:`filtration`, :func:`assign_filtration`, :func:`initialize_filtration`, :func:`find`,
+    :func:`num_vertices`, :func:`num_simplices`, :func:`is_empty`, :func:`dimension`,
+    :func:`upper_bound_dimension`, :func:`memory_usage`, :func:`get_simplices`, :func:`get_filtration`,
+    :func:`get_skeleton`, :func:`filtration_values`, :func:`persistence`, :func:`compute_persistence`,
+    :func:`betti_numbers`, :func:`persistent_betti_numbers`, :func:`persistence_intervals_in_dimension`,
+    :func:`persistence_intervals_by_dimension`, :func:`persistence_pairs`, :func:`write_persistence_diagram`,
+    their `_async` variants, :func:`copy` and `==`. The other methods raise a `TypeError`.
     """
     # unfortunately 'cdef public Simplex_tree_interface_full_featured* thisptr' is not possible
-    # Use intptr_t instead to cast the pointer
+    # Use intptr_t instead to cast the pointer. It is 0 for a SimplexTree of dtype float32.
     cdef public intptr_t thisptr
+    # The simplex tree with float filtration values of a SimplexTree of dtype float32, 0 otherwise
+    cdef intptr_t float_thisptr
 
     # Get the pointer casted as it should be
-    cdef Simplex_tree_interface_full_featured* get_ptr(self) nogil:
+    cdef Simplex_tree_interface_full_featured* get_ptr(self) nogil except NULL:
+        if self.thisptr == 0:
+            with gil:
+                raise TypeError("This method is not available for a SimplexTree of dtype float32")
         return <Simplex_tree_interface_full_featured*>(self.thisptr)
 
+    cdef Simplex_tree_interface_float* get_float_ptr(self) nogil:
+        return <Simplex_tree_interface_float*>(self.float_thisptr)
+
+    # For the methods that do not call get_ptr() first
+    cdef _check_not_float32(self):
+        if self.thisptr == 0:
+            raise TypeError("This method is not available for a SimplexTree of dtype float32")
+
     cdef Simplex_tree_persistence_interface * pcohptr
+    cdef Simplex_tree_float_persistence_interface * float_pcohptr
+    # Parameters of a persistence read from the cache of persistence(), computed when first accessed
+    cdef object deferred_persistence
 
     # Fake constructor that does nothing but documenting the constructor
-    def __init__(self, other = None):
+    def __init__(self, other = None, dtype = None):
         """SimplexTree constructor.
 
         :param other: If `other` is `None` (default value), an empty `SimplexTree` is created.
             If `other` is a `SimplexTree`, the `SimplexTree` is constructed from a deep copy of `other`.
         :type other: SimplexTree (Optional)
+        :param dtype: Type of the filtration values, `numpy.float64` or `numpy.float32`. Default is the dtype of
+            `other`, or `numpy.float64`.
+        :type dtype: numpy.dtype (Optional)
         :returns: An empty or a copy simplex tree.
         :rtype: SimplexTree
 
         :raises TypeError: In case `other` is neither `None`, nor a `SimplexTree`.
+        :raises ValueError: In case `dtype` is neither `numpy.float64` nor `numpy.float32`, or is not the dtype of
+            `other`.
         :note: If the `SimplexTree` is a copy, the persistence information is not copied. If you need it in the clone,
             you have to call :func:`compute_persistence` on it even if you had already computed it in the original.
         """
 
     # The real cython constructor
-    def __cinit__(self, other = None):
-        if other:
-            if isinstance(other, SimplexTree):
-                self.thisptr = _get_copy_intptr(other)
+    def __cinit__(self, other = None, dtype = None):
+        if other is not None and not isinstance(other, SimplexTree):
+            raise TypeError("`other` argument requires to be of type `SimplexTree`, or `None`.")
+        if dtype is None:
+            dtype = np.float64 if other is None else other.dtype
+        dtype = np.dtype(dtype)
+        if dtype != np.float64 and dtype != np.float32:
+            raise ValueError("dtype must be numpy.float64 or numpy.float32")
+        if other is not None and dtype != other.dtype:
+            raise ValueError("The copy of a SimplexTree must have its dtype")
+        cdef SimplexTree stree
+        if dtype == np.float32:
+            if other is None:
+                self.float_thisptr = <intptr_t>(new Simplex_tree_interface_float())
             else:
-                raise TypeError("`other` argument requires to be of type `SimplexTree`, or `None`.")
+                stree = other
+                self.float_thisptr = <intptr_t>(new Simplex_tree_interface_float(dereference(stree.get_float_ptr())))
+        elif other is not None:
+            self.thisptr = _get_copy_intptr(other)
         else:
             self.thisptr = <intptr_t>(new Simplex_tree_interface_full_featured())
 
     def __dealloc__(self):
-        cdef Simplex_tree_interface_full_featured* ptr = self.get_ptr()
+        cdef Simplex_tree_interface_full_featured* ptr = <Simplex_tree_interface_full_featured*>(self.thisptr)
+        cdef Simplex_tree_interface_float* float_ptr = self.get_float_ptr()
         if ptr != NULL:
             del ptr
+        if float_ptr != NULL:
+            del float_ptr
         if self.pcohptr != NULL:
             del self.pcohptr
+        if self.float_pcohptr != NULL:
+            del self.float_pcohptr
 
     def _is_defined(self):
         """Returns true if SimplexTree pointer is not NULL.
          """
-        return self.get_ptr() != NULL
+        return self.thisptr != 0 or self.float_thisptr != 0
 
     def _is_persistence_defined(self):
         """Returns true if Persistence pointer is not NULL.
          """
-        return self.pcohptr != NULL
+        return self.pcohptr != NULL or self.float_pcohptr != NULL
+
+    @property
+    def dtype(self):
+        """The type of the filtration values, `numpy.float64` or `numpy.float32`.
+
+        :rtype: numpy.dtype
+        """
+        return np.dtype(np.float32) if self.float_thisptr != 0 else np.dtype(np.float64)
 
     def copy(self):
         """ 
@@ -101,9 +200,7 @@ cdef class SimplexTree:
         :note: The persistence information is not copied. If you need it in the clone, you have to call
             :func:`compute_persistence` on it even if you had already computed it in the original.
         """
-        stree = SimplexTree()
-        stree.thisptr = _get_copy_intptr(self)
-        return stree
+        return SimplexTree(self)
 
     def __deepcopy__(self):
         return self.copy()
@@ -117,6 +214,8 @@ cdef class SimplexTree:
         :returns:  The simplicial complex filtration value.
         :rtype:  float
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().simplex_filtration(simplex)
         return self.get_ptr().simplex_filtration(simplex)
 
     def assign_filtration(self, simplex, filtration):
@@ -137,7 +236,10 @@ cdef class SimplexTree:
             any function that relies on the filtration property, like
             :meth:`persistence`.
         """
-        self.get_ptr().assign_simplex_filtration(simplex, filtration)
+        if self.float_thisptr != 0:
+            self.get_float_ptr().assign_simplex_filtration(simplex, filtration)
+        else:
+            self.get_ptr().assign_simplex_filtration(simplex, filtration)
 
     def initialize_filtration(self):
         """This function initializes and sorts the simplicial complex
@@ -147,7 +249,10 @@ cdef class SimplexTree:
         """
         import warnings
         warnings.warn("Since Gudhi 3.2, calling SimplexTree.initialize_filtration is unnecessary.", DeprecationWarning)
-        self.get_ptr().initialize_filtration()
+        if self.float_thisptr != 0:
+            self.get_float_ptr().initialize_filtration()
+        else:
+            self.get_ptr().initialize_filtration()
 
     def num_vertices(self):
         """This function returns the number of vertices of the simplicial
@@ -156,6 +261,8 @@ cdef class SimplexTree:
         :returns:  The simplicial complex number of vertices.
         :rtype:  int
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().num_vertices()
         return self.get_ptr().num_vertices()
 
     def num_simplices(self):
@@ -165,14 +272,102 @@ cdef class SimplexTree:
         :returns:  the simplicial complex number of simplices.
         :rtype:  int
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().num_simplices()
         return self.get_ptr().num_simplices()
 
+    def memory_usage(self):
+        """This function returns the memory used by the simplex tree, in bytes, broken down by part: the nodes
+        (`nodes`), the sets of children (`siblings`), the heap memory of the filtration values (`filtration_values`),
+        the lists of nodes by label (`label_lists`), the simplices sorted by filtration value
+        (`filtration_cache`, filled by :func:`initialize_filtration` and :func:`compute_persistence`), and the hash
+        table of the find index (`find_index`). This function takes time linear in the number of simplices.
+
+        :returns: The memory used by each part, and their sum `total`.
+        :rtype: dict of int
+        """
+        cdef Simplex_tree_memory_usage usage
+        cdef Simplex_tree_float_memory_usage float_usage
+        if self.float_thisptr != 0:
+            with nogil:
+                float_usage = self.get_float_ptr().memory_usage()
+            return _simplex_tree_float_memory_usage_dict(float_usage)
+        with nogil:
+            usage = self.get_ptr().memory_usage()
+        return _simplex_tree_memory_usage_dict(usage)
+
+    def content_hash(self):
+        """This function returns a hash of the simplices and of their filtration values, computed in parallel over
+        the subtrees of the vertices. Two simplex trees with the same simplices and filtration values have the same
+        hash, whatever the order of their construction. It is meant to be compared on the same machine, with the same
+        version of gudhi. As a 64-bit hash, different simplex trees may collide: the cache of :func:`persistence`
+        uses a SHA-256 digest of the serialization instead.
+
+        :returns: The hash of the simplex tree.
+        :rtype: int
+        """
+        cdef uint64_t hash
+        if self.float_thisptr != 0:
+            with nogil:
+                hash = self.get_float_ptr().content_hash()
+            return hash
+        with nogil:
+            hash = self.get_ptr().content_hash()
+        return hash
+
+    def _content_digest(self):
+        """SHA-256 digest of the serialization of the simplex tree, i.e., of its simplices and of their filtration
+        values, which does not depend on the order of their insertion.
+
+        :rtype: bytes
+        """
+        cdef size_t buffer_size
+        if self.float_thisptr != 0:
+            buffer_size = self.get_float_ptr().get_serialization_size()
+        else:
+            buffer_size = self.get_ptr().get_serialization_size()
+        np_buffer = np.empty(buffer_size, dtype='B')
+        cdef char[:] buffer = np_buffer
+        cdef char* buffer_start = &buffer[0]
+        with nogil:
+            if self.float_thisptr != 0:
+                self.get_float_ptr().serialize(buffer_start, buffer_size)
+            else:
+                self.get_ptr().serialize(buffer_start, buffer_size)
+        return hashlib.sha256(np_buffer).digest()
+
+    cdef _compute_deferred_persistence(self):
+        # After a hit of the cache of persistence(), the persistence is computed when it is first accessed
+        if self.deferred_persistence is not None and self.pcohptr == NULL and self.float_pcohptr == NULL:
+            self.compute_persistence(*self.deferred_persistence)
+
+    @staticmethod
+    def estimate_memory_usage(num_simplices_by_dimension):
+        """This function estimates the memory used by a simplex tree with `num_simplices_by_dimension[d]` simplices
+        of dimension `d`, in bytes, broken down by part as :func:`memory_usage`. It can be used to predict the memory
+        needed by :func:`expansion` before running it, from the number of simplices of each dimension of the
+        expansion of a sample. The buffers are assumed to have no unused capacity, as after :func:`expansion`, and
+        the simplices sorted by :func:`compute_persistence` are included.
+
+        :param num_simplices_by_dimension: The number of simplices of each dimension.
+        :type num_simplices_by_dimension: list of int
+        :returns: The estimated memory used by each part, and their sum `total`.
+        :rtype: dict of int
+        """
+        cdef vector[size_t] counts = num_simplices_by_dimension
+        cdef Simplex_tree_memory_usage usage
+        with nogil:
+            usage = estimate_simplex_tree_memory_usage(counts)
+        return _simplex_tree_memory_usage_dict(usage)
+
     def is_empty(self):
         """This function returns whether the simplicial complex is empty.
 
         :returns:  True if the simplicial complex is empty.
         :rtype:  bool
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().is_empty()
         return self.get_ptr().is_empty()
 
     def dimension(self):
@@ -190,6 +385,8 @@ cdef class SimplexTree:
             :func:`prune_above_filtration`
             methods).
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().dimension()
         return self.get_ptr().dimension()
 
     def upper_bound_dimension(self):
@@ -199,6 +396,8 @@ cdef class SimplexTree:
         :returns:  an upper bound on the dimension of the simplicial complex.
         :rtype:  int
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().upper_bound_dimension()
         return self.get_ptr().upper_bound_dimension()
 
     def set_dimension(self, dimension):
@@ -228,6 +427,8 @@ cdef class SimplexTree:
         :returns:  true if the simplex was found, false otherwise.
         :rtype:  bool
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().find_simplex(simplex)
         return self.get_ptr().find_simplex(simplex)
 
     def insert(self, simplex, filtration=0.0):
@@ -245,6 +446,8 @@ cdef class SimplexTree:
             otherwise (whatever its original filtration value).
         :rtype:  bool
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().insert(simplex, <double>filtration)
         return self.get_ptr().insert(simplex, <double>filtration)
 
     @staticmethod
@@ -291,11 +494,15 @@ cdef class SimplexTree:
 
         .. seealso:: :func:`insert_batch`
         """
-        # Without this, it could be slow if we end up inserting vertices in a bad order (flat_map).
-        self.get_ptr().insert_batch_vertices(np.unique(np.stack((edges.row, edges.col))), INFINITY)
-        # TODO: optimize this?
-        for edge in zip(edges.row, edges.col, edges.data):
-            self.get_ptr().insert((edge[0], edge[1]), edge[2])
+        # The edges are sorted and inserted in C++, without one call per edge
+        cdef const int[::1] rows = np.ascontiguousarray(edges.row, dtype=np.intc)
+        cdef const int[::1] cols = np.ascontiguousarray(edges.col, dtype=np.intc)
+        cdef const double[::1] data = np.ascontiguousarray(edges.data, dtype=np.float64)
+        cdef size_t n = rows.shape[0]
+        if n == 0:
+            return
+        with nogil:
+            self.get_ptr().insert_edges_array(&rows[0], &cols[0], &data[0], n)
 
     @cython.boundscheck(False)
     @cython.wraparound(False)
@@ -315,22 +522,20 @@ cdef class SimplexTree:
         :param filtrations: the filtration values.
         :type filtrations: numpy.array of shape (n,)
         """
-        cdef vector[int] vertices = np.unique(vertex_array)
         cdef Py_ssize_t k = vertex_array.shape[0]
         cdef Py_ssize_t n = vertex_array.shape[1]
         assert filtrations.shape[0] == n, 'inconsistent sizes for vertex_array and filtrations'
-        cdef Py_ssize_t i
-        cdef Py_ssize_t j
-        cdef vector[int] v
+        if n == 0 or k == 0:
+            return
+        # One simplex per row, all the faces being then sorted and inserted at once in C++
+        cdef const int[:, ::1] vertices = np.ascontiguousarray(np.asarray(vertex_array).T, dtype=np.intc)
+        cdef const double[::1] values = np.ascontiguousarray(np.asarray(filtrations), dtype=np.float64)
+        if self.float_thisptr != 0:
+            with nogil:
+                self.get_float_ptr().insert_batch_array(&vertices[0, 0], n, k, &values[0])
+            return
         with nogil:
-            # Without this, it could be slow if we end up inserting vertices in a bad order (flat_map).
-            # NaN currently does the wrong thing
-            self.get_ptr().insert_batch_vertices(vertices, INFINITY)
-            for i in range(n):
-                for j in range(k):
-                    v.push_back(vertex_array[j, i])
-                self.get_ptr().insert(v, filtrations[i])
-                v.clear()
+            self.get_ptr().insert_batch_array(&vertices[0, 0], n, k, &values[0])
 
     def get_simplices(self):
         """This function returns a generator with simplices and their given
@@ -339,6 +544,9 @@ cdef class SimplexTree:
         :returns:  The simplices.
         :rtype:  generator with tuples(simplex, filtration)
         """
+        if self.float_thisptr != 0:
+            yield from self._get_float_simplices()
+            return
         cdef Simplex_tree_simplices_iterator it = self.get_ptr().get_simplices_iterator_begin()
         cdef Simplex_tree_simplices_iterator end = self.get_ptr().get_simplices_iterator_end()
         cdef Simplex_tree_simplex_handle sh = dereference(it)
@@ -354,6 +562,9 @@ cdef class SimplexTree:
         :returns:  The simplices sorted by increasing filtration values.
         :rtype:  generator with tuples(simplex, filtration)
         """
+        if self.float_thisptr != 0:
+            yield from self._get_float_filtration()
+            return
         cdef vector[Simplex_tree_simplex_handle].const_iterator it = self.get_ptr().get_filtration_iterator_begin()
         cdef vector[Simplex_tree_simplex_handle].const_iterator end = self.get_ptr().get_filtration_iterator_end()
 
@@ -369,6 +580,9 @@ cdef class SimplexTree:
         :returns:  The (simplices of the) skeleton of a maximum dimension.
         :rtype:  generator with tuples(simplex, filtration)
         """
+        if self.float_thisptr != 0:
+            yield from self._get_float_skeleton(dimension)
+            return
         cdef Simplex_tree_skeleton_iterator it = self.get_ptr().get_skeleton_iterator_begin(dimension)
         cdef Simplex_tree_skeleton_iterator end = self.get_ptr().get_skeleton_iterator_end(dimension)
 
@@ -376,6 +590,33 @@ cdef class SimplexTree:
             yield self.get_ptr().get_simplex_and_filtration(dereference(it))
             preincrement(it)
 
+    # The generators of a SimplexTree of dtype float32
+    def _get_float_simplices(self):
+        cdef Simplex_tree_float_simplices_iterator it = self.get_float_ptr().get_simplices_iterator_begin()
+        cdef Simplex_tree_float_simplices_iterator end = self.get_float_ptr().get_simplices_iterator_end()
+
+        while it != end:
+            yield self.get_float_ptr().get_simplex_and_filtration(dereference(it))
+            preincrement(it)
+
+    def _get_float_filtration(self):
+        cdef vector[Simplex_tree_float_simplex_handle].const_iterator it = \
+            self.get_float_ptr().get_filtration_iterator_begin()
+        cdef vector[Simplex_tree_float_simplex_handle].const_iterator end = \
+            self.get_float_ptr().get_filtration_iterator_end()
+
+        while it != end:
+            yield self.get_float_ptr().get_simplex_and_filtration(dereference(it))
+            preincrement(it)
+
+    def _get_float_skeleton(self, dimension):
+        cdef Simplex_tree_float_skeleton_iterator it = self.get_float_ptr().get_skeleton_iterator_begin(dimension)
+        cdef Simplex_tree_float_skeleton_iterator end = self.get_float_ptr().get_skeleton_iterator_end(dimension)
+
+        while it != end:
+            yield self.get_float_ptr().get_simplex_and_filtration(dereference(it))
+            preincrement(it)
+
     def get_star(self, simplex):
         """This function returns the star of a given N-simplex.
 
@@ -422,6 +663,30 @@ cdef class SimplexTree:
             ct.append((v, filtered_simplex.second))
         return ct
 
+    def get_cofaces_batch(self, simplices, codimension):
+        """This function returns the cofaces of several simplices with a given
+        codimension, as :func:`get_cofaces` called on each of them, but in a
+        single query that runs in parallel. It is much faster than calling
+        :func:`get_cofaces` on every vertex, e.g. to compute local features.
+
+        :param simplices: The simplices, each represented by a list of vertex.
+        :type simplices: list of list of int
+        :param codimension: The codimension. If codimension = 0, all cofaces
+            are returned (equivalent of get_star function)
+        :type codimension: int
+        :returns:  For each simplex, the (simplices of the) cofaces of the
+            simplex, in no particular order. A simplex that is not in the
+            complex has no cofaces.
+        :rtype:  list of list of tuples(simplex, filtration)
+        """
+        cdef vector[vector[int]] csimplices = simplices
+        cdef int ccodimension = codimension
+        cdef vector[vector[pair[vector[int], double]]] cofaces
+        with nogil:
+            cofaces = self.get_ptr().get_cofaces_batch(csimplices, ccodimension)
+        return [[(list(filtered_simplex.first), filtered_simplex.second) for filtered_simplex in simplex_cofaces]
+                for simplex_cofaces in cofaces]
+
     def get_boundaries(self, simplex):
         """This function returns a generator with the boundaries of a given N-simplex.
         If you do not need the filtration values, the boundary can also be obtained as
@@ -438,6 +703,33 @@ cdef class SimplexTree:
             yield self.get_ptr().get_simplex_and_filtration(dereference(it.first))
             preincrement(it.first)
 
+    def boundary_matrix(self):
+        """Returns the boundary matrix of the complex in compressed sparse column format, with the simplices in the
+        order of :meth:`get_filtration`. The arrays are allocated by NumPy and filled in C++, without the GIL.
+
+        The column `i` represents the `i`-th simplex of the filtration, and the indices of its facets in the
+        filtration are `indices[indptr[i]:indptr[i+1]]`, in increasing order. A SciPy matrix sharing the same memory
+        is given by :code:`scipy.sparse.csc_matrix((np.ones(len(indices), dtype=np.int8), indices, indptr))`.
+
+        :returns: The arrays `indptr` (of size `n+1`), `indices`, `dimensions` and `filtrations` (of size `n`), where
+            `n` is the number of simplices.
+        :rtype: tuple(numpy.ndarray[int64], numpy.ndarray[int64], numpy.ndarray[int], numpy.ndarray[float])
+        """
+        cdef pair[size_t, size_t] sizes
+        with nogil:
+            sizes = self.get_ptr().boundary_matrix_sizes()
+        indptr = np.empty(sizes.first + 1, dtype=np.int64)
+        indices = np.empty(sizes.second, dtype=np.int64)
+        dimensions = np.empty(sizes.first, dtype=np.intc)
+        filtrations = np.empty(sizes.first, dtype=float)
+        cdef uintptr_t indptr_ptr = indptr.ctypes.data
+        cdef uintptr_t indices_ptr = indices.ctypes.data
+        cdef uintptr_t dimensions_ptr = dimensions.ctypes.data
+        cdef uintptr_t filtrations_ptr = filtrations.ctypes.data
+        with nogil:
+            self.get_ptr().fill_boundary_matrix(indptr_ptr, indices_ptr, dimensions_ptr, filtrations_ptr)
+        return indptr, indices, dimensions, filtrations
+
     def remove_maximal_simplex(self, simplex):
         """This function removes a given maximal N-simplex from the simplicial
         complex.
@@ -508,9 +800,88 @@ cdef class SimplexTree:
         :type max_dimension: int
         """
         cdef int maxdim = max_dimension
+        if self.float_thisptr != 0:
+            with nogil:
+                self.get_float_ptr().expansion(maxdim)
+            return
         with nogil:
             self.get_ptr().expansion(maxdim)
 
+    def expansion_async(self, max_dimension):
+        """Same as :func:`expansion`, computed on a thread of the pool of :mod:`gudhi.parallel` while the caller goes
+        on. The simplex tree must not be used until the computation is complete.
+
+        :param max_dimension: The maximal dimension.
+        :type max_dimension: int
+        :returns: The future of the expansion, whose `cancel()` also stops it when it is running, at the next vertex.
+            The simplex tree then contains its one skeleton again, and `result()` raises
+            `concurrent.futures.CancelledError`.
+        :rtype: concurrent.futures.Future
+        """
+        return _submit_cancellable(lambda: self.expansion(max_dimension), _CancellationFlag(),
+                                   _exchange_cancellation_flag)
+
+    def expansion_with_budget(self, max_dimension, max_num_simplices=None, max_memory=None, raise_on_budget=False):
+        """Expands the simplex tree containing only its one skeleton until dimension max_dim, like
+        :func:`expansion`, unless the complex gets larger than a budget, in which case the expansion stops.
+
+        The subtrees of the vertices are expanded one after the other, from the greatest vertex, and the simplices of
+        dimension at least 2 of the subtree which exceeds the budget are removed, so that the simplex tree is a
+        simplicial complex within the budget: the graph and the cliques whose vertices are all greater than some
+        vertex. :func:`estimate_expansion_size` helps choosing the budget beforehand.
+
+        :param max_dimension: The maximal dimension.
+        :type max_dimension: int
+        :param max_num_simplices: The maximal number of simplices of the complex. Default is no limit.
+        :type max_num_simplices: int
+        :param max_memory: The maximal memory of the complex, in bytes, as the `total` of :func:`memory_usage`.
+            Default is no limit.
+        :type max_memory: int
+        :param raise_on_budget: Raises a `MemoryError` if the expansion stops, instead of returning False.
+        :type raise_on_budget: bool
+        :returns: Whether the expansion is complete.
+        :rtype: bool
+        """
+        cdef int maxdim = max_dimension
+        cdef Simplex_tree_expansion_budget budget
+        cdef bool complete
+        if max_num_simplices is not None:
+            budget.max_num_simplices = max_num_simplices
+        if max_memory is not None:
+            budget.max_memory = max_memory
+        with nogil:
+            complete = self.get_ptr().expansion_with_budget(maxdim, budget)
+        if not complete and raise_on_budget:
+            raise MemoryError("The expansion exceeds its budget, it was stopped.")
+        return complete
+
+    def estimate_expansion_size(self, max_dimension, num_samples=1000, seed=None):
+        """Estimates the number of simplices of each dimension of the :func:`expansion` of the one skeleton of the
+        simplex tree, without building it, by sampling its cliques. The numbers of vertices and edges are exact, and
+        the relative error of the others decreases as the inverse of the square root of `num_samples`.
+
+        :param max_dimension: The maximal dimension.
+        :type max_dimension: int
+        :param num_samples: The number of random samples.
+        :type num_samples: int
+        :param seed: The seed of the random number generator. Default is a random seed.
+        :type seed: int
+        :returns: The estimated number of simplices of each dimension, up to max_dimension.
+        :rtype: list of float
+        """
+        cdef int maxdim = max_dimension
+        cdef size_t samples = num_samples
+        cdef unsigned int c_seed
+        cdef vector[double] sizes
+        if seed is None:
+            with nogil:
+                sizes = self.get_ptr().estimate_expansion_size(maxdim, samples)
+        else:
+            c_seed = seed
+            with nogil:
+                sizes = self.get_ptr().estimate_expansion_size(maxdim, samples, c_seed)
+        return sizes
+
     def make_filtration_non_decreasing(self):
         """This function ensures that each simplex has a higher filtration
         value than its faces by increasing the filtration values.
@@ -519,6 +890,8 @@ cdef class SimplexTree:
             False if the filtration was already non-decreasing.
         :rtype: bool
         """
+        if self.float_thisptr != 0:
+            return self.get_float_ptr().make_filtration_non_decreasing()
         return self.get_ptr().make_filtration_non_decreasing()
 
     def reset_filtration(self, filtration, min_dim = 0):
@@ -535,6 +908,90 @@ cdef class SimplexTree:
         """
         self.get_ptr().reset_filtration(filtration, min_dim)
 
+    def assign_lower_star_filtration(self, filtration):
+        """This function sets the filtration value of each simplex to the maximum of the values of its vertices, i.e.
+        the lower-star filtration of a function on the vertices. It is equivalent to, but faster than,
+        `reset_filtration(-inf)`, assigning the value of each vertex and calling `make_filtration_non_decreasing`.
+
+        The filtration order computed by a previous call to :func:`compute_persistence` is kept and only repaired,
+        which is much faster than sorting it again when the values only changed slightly, as between 2 steps of an
+        optimization.
+
+        :param filtration: The value of each vertex. The vertices must be named with integers from 0 to n-1.
+        :type filtration: numpy.array of shape (n,)
+        :raises ValueError: If a vertex has no value.
+        """
+        cdef double[::1] values = np.ascontiguousarray(filtration, dtype=float).reshape(-1)
+        cdef size_t n = values.shape[0]
+        cdef const double* ptr = &values[0] if n > 0 else NULL
+        with nogil:
+            self.get_ptr().assign_lower_star_filtration(ptr, n)
+
+    def assign_flag_filtration(self, distance_matrix):
+        """This function sets the filtration value of each vertex to 0 and of each other simplex to the largest
+        distance between two of its vertices, i.e. the filtration of the Rips complex of the distance matrix, without
+        inserting or removing any simplex.
+
+        As for :func:`assign_lower_star_filtration`, the filtration order computed by a previous call to
+        :func:`compute_persistence` is kept and only repaired, which is fast when the distances only changed slightly.
+
+        :param distance_matrix: The distances between the vertices, which must be named with integers from 0 to n-1.
+        :type distance_matrix: numpy.array of shape (n, n)
+        :raises ValueError: If a vertex has no row in the matrix.
+        """
+        distance_matrix = np.ascontiguousarray(distance_matrix, dtype=float)
+        if distance_matrix.ndim != 2 or distance_matrix.shape[0] != distance_matrix.shape[1]:
+            raise ValueError("The distance matrix must be a square matrix")
+        cdef double[::1] values = distance_matrix.reshape(-1)
+        cdef size_t n = distance_matrix.shape[0]
+        cdef const double* ptr = &values[0] if n > 0 else NULL
+        with nogil:
+            self.get_ptr().assign_flag_filtration(ptr, n)
+
+    def filtration_values(self):
+        """Returns the filtration values of all the simplices at once, in the order of :func:`get_filtration`: the
+        `i`-th value is the one of the `i`-th simplex of the filtration, which is also the column `i` of
+        :func:`boundary_matrix`. The array is allocated by NumPy and filled in C++, without the GIL.
+
+        :returns: The filtration values.
+        :rtype: numpy.ndarray[float] of shape (num_simplices,)
+        """
+        cdef size_t n
+        cdef uintptr_t filtrations_ptr
+        if self.float_thisptr != 0:
+            n = self.get_float_ptr().num_simplices()
+            filtrations = np.empty(n, dtype=float)
+            filtrations_ptr = filtrations.ctypes.data
+            with nogil:
+                self.get_float_ptr().fill_filtration_values(filtrations_ptr)
+            return filtrations
+        with nogil:
+            n = self.get_ptr().boundary_matrix_sizes().first
+        filtrations = np.empty(n, dtype=float)
+        filtrations_ptr = filtrations.ctypes.data
+        with nogil:
+            self.get_ptr().fill_filtration_values(filtrations_ptr)
+        return filtrations
+
+    def assign_filtration_values(self, filtrations):
+        """Assigns the filtration values of all the simplices at once, in the order of :func:`filtration_values`:
+        the `i`-th value is assigned to the `i`-th simplex of the current filtration order. The order is then repaired
+        once for all the simplices, which is fast when the values only changed slightly, as between 2 steps of an
+        optimization. The indices then refer to the new order, as returned by :func:`filtration_values`.
+
+        As with :func:`reset_filtration`, it is the user's responsibility to keep a valid filtration, e.g. with
+        :func:`make_filtration_non_decreasing`.
+
+        :param filtrations: One value per simplex.
+        :type filtrations: numpy.array of shape (num_simplices,)
+        :raises ValueError: If there is not one value per simplex.
+        """
+        cdef double[::1] values = np.ascontiguousarray(filtrations, dtype=float).reshape(-1)
+        cdef size_t n = values.shape[0]
+        cdef const double* ptr = &values[0] if n > 0 else NULL
+        with nogil:
+            self.get_ptr().assign_filtration_values(ptr, n)
+
     def extend_filtration(self):
         """ Extend filtration for computing extended persistence. This function only uses the filtration values at the
         0-dimensional simplices, and computes the extended persistence diagram induced by the lower-star filtration
@@ -612,7 +1069,8 @@ cdef class SimplexTree:
         """
         self.get_ptr().expansion_with_blockers_callback(max_dim, callback, <void*>blocker_func)
 
-    def persistence(self, homology_coeff_field=11, min_persistence=0, persistence_dim_max = False):
+    def persistence(self, homology_coeff_field=11, min_persistence=0, persistence_dim_max = False,
+                    algorithm = "cohomology", max_filtration = float('inf'), max_dimension = None, cache_dir = None):
         """This function computes and returns the persistence of the simplicial complex.
 
         :param homology_coeff_field: The homology coefficient field. Must be a
@@ -627,13 +1085,87 @@ cdef class SimplexTree:
             maximal dimension in the complex is computed. If false, it is
             ignored. Default is false.
         :type persistence_dim_max: bool
+        :param algorithm: "cohomology" for the annotation-based persistent
+            cohomology algorithm, or "matrix_reduction" for a reduction of the
+            sparse boundary matrix with clearing, multi-threaded when gudhi
+            is built with TBB. Both give the same persistence. Default is
+            "cohomology".
+        :type algorithm: str
+        :param max_filtration: The computation stops at this filtration
+            value: the simplices of greater filtration values are ignored,
+            without being sorted, and the classes still alive at
+            max_filtration are essential. Default is infinity.
+        :type max_filtration: float
+        :param max_dimension: The maximal dimension of the persistence
+            intervals. The simplices of dimension greater than
+            max_dimension + 1 are ignored. Default is None, for all the
+            dimensions.
+        :type max_dimension: int
+        :param cache_dir: If not None, a directory where the persistence is stored in the binary format of
+            :doc:`the file formats <fileformats>`, under a name made of a SHA-256 digest of the serialization of the
+            simplex tree and of the parameters. The persistence of a simplex tree already seen with the same
+            parameters is then read from the file instead of being computed. The functions that access the
+            persistence, e.g. :func:`betti_numbers`, then compute it with these parameters when first called.
+            Default is None.
+        :type cache_dir: str
         :returns: The persistence of the simplicial complex.
         :rtype:  list of pairs(dimension, pair(birth, death))
         """
-        self.compute_persistence(homology_coeff_field, min_persistence, persistence_dim_max)
+        cdef string cache_file
+        if cache_dir is not None:
+            parameters = (homology_coeff_field, min_persistence, persistence_dim_max, algorithm, max_filtration,
+                          max_dimension)
+            key = (self.dtype.name, homology_coeff_field, float(min_persistence), bool(persistence_dim_max),
+                   algorithm, float(max_filtration), max_dimension)
+            digest = hashlib.sha256(self._content_digest() + repr(key).encode("utf-8"))
+            path = os.path.join(cache_dir, digest.hexdigest() + ".pers")
+            if os.path.exists(path):
+                from gudhi.reader_utils import read_persistence_intervals_from_binary_file
+                intervals = read_persistence_intervals_from_binary_file(path, mmap=False)
+                # The persistence of a previous computation may not match this diagram, it is computed again with
+                # these parameters by the accessors
+                del self.pcohptr
+                self.pcohptr = NULL
+                del self.float_pcohptr
+                self.float_pcohptr = NULL
+                self.deferred_persistence = parameters
+                # Same order as the computed persistence: decreasing dimension, then the order of the file
+                return [(dim, (float(birth), float(death))) for dim in sorted(intervals, reverse=True)
+                        for birth, death in intervals[dim]]
+        self.compute_persistence(homology_coeff_field, min_persistence, persistence_dim_max, algorithm,
+                                 max_filtration, max_dimension)
+        if cache_dir is not None:
+            # Written aside and renamed, so that a concurrent reader never sees a partial file
+            tmp_path = f"{path}.{os.getpid()}.tmp"
+            cache_file = tmp_path.encode("utf-8")
+            with nogil:
+                if self.float_thisptr != 0:
+                    self.float_pcohptr.write_persistence_binary(cache_file)
+                else:
+                    self.pcohptr.write_persistence_binary(cache_file)
+            os.replace(tmp_path, path)
+        if self.float_thisptr != 0:
+            return self.float_pcohptr.get_persistence()
         return self.pcohptr.get_persistence()
 
-    def compute_persistence(self, homology_coeff_field=11, min_persistence=0, persistence_dim_max = False):
+    def persistence_async(self, homology_coeff_field=11, min_persistence=0, persistence_dim_max = False,
+                          algorithm = "cohomology", max_filtration = float('inf'), max_dimension = None,
+                          cache_dir = None):
+        """Same as :func:`persistence`, computed on a thread of the pool of :mod:`gudhi.parallel` while the caller
+        goes on, with the same parameters. The simplex tree must not be used until the computation is complete.
+
+        :returns: The future of the persistence, whose `cancel()` also stops it when it is running. `result()` then
+            raises `concurrent.futures.CancelledError`, and the persistence must be computed again before being
+            accessed.
+        :rtype: concurrent.futures.Future
+        """
+        return _submit_cancellable(
+            lambda: self.persistence(homology_coeff_field, min_persistence, persistence_dim_max, algorithm,
+                                     max_filtration, max_dimension, cache_dir),
+            _CancellationFlag(), _exchange_cancellation_flag)
+
+    def compute_persistence(self, homology_coeff_field=11, min_persistence=0, persistence_dim_max = False,
+                            algorithm = "cohomology", max_filtration = float('inf'), max_dimension = None):
         """This function computes the persistence of the simplicial complex, so it can be accessed through
         :func:`persistent_betti_numbers`, :func:`persistence_pairs`, etc. This function is equivalent to :func:`persistence`
         when you do not want the list :func:`persistence` returns.
@@ -650,16 +1182,67 @@ cdef class SimplexTree:
             maximal dimension in the complex is computed. If false, it is
             ignored. Default is false.
         :type persistence_dim_max: bool
+        :param algorithm: "cohomology" for the annotation-based persistent
+            cohomology algorithm, or "matrix_reduction" for a reduction of the
+            sparse boundary matrix with clearing, multi-threaded when gudhi
+            is built with TBB. Both give the same persistence. Default is
+            "cohomology".
+        :type algorithm: str
+        :param max_filtration: The computation stops at this filtration
+            value: the simplices of greater filtration values are ignored,
+            without being sorted, and the classes still alive at
+            max_filtration are essential. Default is infinity.
+        :type max_filtration: float
+        :param max_dimension: The maximal dimension of the persistence
+            intervals. The simplices of dimension greater than
+            max_dimension + 1 are ignored. Default is None, for all the
+            dimensions.
+        :type max_dimension: int
         :returns: Nothing.
+        :raises ValueError: If `algorithm` is not "cohomology" or "matrix_reduction", or if `max_filtration` or
+            `max_dimension` is given with "matrix_reduction".
         """
-        if self.pcohptr != NULL:
-            del self.pcohptr
+        if algorithm not in ("cohomology", "matrix_reduction"):
+            raise ValueError(f"Unknown persistence algorithm {algorithm}, expected 'cohomology' or 'matrix_reduction'")
+        cdef bool truncated = max_filtration != float('inf') or max_dimension is not None
+        if truncated and algorithm != "cohomology":
+            raise ValueError("max_filtration and max_dimension are only supported by the 'cohomology' algorithm")
         cdef bool pdm = persistence_dim_max
         cdef int coef = homology_coeff_field
         cdef double minp = min_persistence
-        with nogil:
-            self.pcohptr = new Simplex_tree_persistence_interface(self.get_ptr(), pdm)
-            self.pcohptr.compute_persistence(coef, minp)
+        cdef bool reduction = algorithm == "matrix_reduction"
+        cdef double maxf = max_filtration
+        cdef int maxd = self.dimension() if max_dimension is None else max_dimension
+        self.deferred_persistence = None
+        try:
+            if self.float_thisptr != 0:
+                with nogil:
+                    if self.float_pcohptr != NULL:
+                        self.float_pcohptr.reset(pdm)
+                    else:
+                        self.float_pcohptr = new Simplex_tree_float_persistence_interface(self.get_float_ptr(), pdm)
+                    if truncated:
+                        self.float_pcohptr.compute_persistence(coef, minp, maxf, maxd)
+                    else:
+                        self.float_pcohptr.compute_persistence(coef, minp, reduction)
+                return
+            with nogil:
+                # Reuse the memory of the previous computation, if any
+                if self.pcohptr != NULL:
+                    self.pcohptr.reset(pdm)
+                else:
+                    self.pcohptr = new Simplex_tree_persistence_interface(self.get_ptr(), pdm)
+                if truncated:
+                    self.pcohptr.compute_persistence(coef, minp, maxf, maxd)
+                else:
+                    self.pcohptr.compute_persistence(coef, minp, reduction)
+        except:
+            # A cancelled or failed computation leaves no partial persistence
+            del self.pcohptr
+            self.pcohptr = NULL
+            del self.float_pcohptr
+            self.float_pcohptr = NULL
+            raise
 
     def betti_numbers(self):
         """This function returns the Betti numbers of the simplicial complex.
@@ -671,6 +1254,10 @@ cdef class SimplexTree:
             :func:`compute_persistence`
             function to be launched first.
         """
+        self._compute_deferred_persistence()
+        if self.float_thisptr != 0:
+            assert self.float_pcohptr != NULL, "compute_persistence() must be called before betti_numbers()"
+            return self.float_pcohptr.betti_numbers()
         assert self.pcohptr != NULL, "compute_persistence() must be called before betti_numbers()"
         return self.pcohptr.betti_numbers()
 
@@ -692,6 +1279,10 @@ cdef class SimplexTree:
             :func:`compute_persistence`
             function to be launched first.
         """
+        self._compute_deferred_persistence()
+        if self.float_thisptr != 0:
+            assert self.float_pcohptr != NULL, "compute_persistence() must be called before persistent_betti_numbers()"
+            return self.float_pcohptr.persistent_betti_numbers(<double>from_value, <double>to_value)
         assert self.pcohptr != NULL, "compute_persistence() must be called before persistent_betti_numbers()"
         return self.pcohptr.persistent_betti_numbers(<double>from_value, <double>to_value)
 
@@ -708,13 +1299,57 @@ cdef class SimplexTree:
             :func:`compute_persistence`
             function to be launched first.
         """
-        assert self.pcohptr != NULL, "compute_persistence() must be called before persistence_intervals_in_dimension()"
-        piid = np.array(self.pcohptr.intervals_in_dimension(dimension))
+        self._compute_deferred_persistence()
+        if self.float_thisptr != 0:
+            assert self.float_pcohptr != NULL, \
+                "compute_persistence() must be called before persistence_intervals_in_dimension()"
+            piid = np.array(self.float_pcohptr.intervals_in_dimension(dimension))
+        else:
+            assert self.pcohptr != NULL, \
+                "compute_persistence() must be called before persistence_intervals_in_dimension()"
+            piid = np.array(self.pcohptr.intervals_in_dimension(dimension))
         # Workaround https://github.com/GUDHI/gudhi-devel/issues/507
         if len(piid) == 0:
             return np.empty(shape = [0, 2])
         return piid
 
+    def persistence_intervals_by_dimension(self, dtype=np.float64):
+        """This function returns the persistence intervals of the simplicial complex in all the dimensions at once.
+        The arrays are allocated once and filled by the C++ code, which is much faster than converting the list of
+        :func:`persistence` when there are many intervals.
+
+        :param dtype: Type of the births and deaths, `numpy.float64` (default) or `numpy.float32`.
+        :type dtype: numpy.dtype
+        :returns: The persistence intervals of each dimension, in the same order as
+            :func:`persistence_intervals_in_dimension`, until the last dimension that has some.
+        :rtype:  list of numpy array of shape (n,2)
+
+        :note: persistence_intervals_by_dimension function requires
+            :func:`compute_persistence`
+            function to be launched first.
+        """
+        self._compute_deferred_persistence()
+        assert self._is_persistence_defined(), \
+            "compute_persistence() must be called before persistence_intervals_by_dimension()"
+        dtype = np.dtype(dtype)
+        if dtype != np.float64 and dtype != np.float32:
+            raise ValueError("dtype must be numpy.float64 or numpy.float32")
+        cdef bool single_precision = dtype == np.float32
+        cdef vector[size_t] counts
+        with nogil:
+            if self.float_pcohptr != NULL:
+                counts = self.float_pcohptr.num_intervals_by_dimension()
+            else:
+                counts = self.pcohptr.num_intervals_by_dimension()
+        intervals = [np.empty((n, 2), dtype=dtype) for n in counts]
+        cdef vector[uintptr_t] ptrs = [d.ctypes.data for d in intervals]
+        with nogil:
+            if self.float_pcohptr != NULL:
+                self.float_pcohptr.fill_intervals_by_dimension(ptrs, single_precision)
+            else:
+                self.pcohptr.fill_intervals_by_dimension(ptrs, single_precision)
+        return intervals
+
     def persistence_pairs(self):
         """This function returns a list of persistence birth and death simplices pairs.
 
@@ -725,9 +1360,34 @@ cdef class SimplexTree:
             :func:`compute_persistence`
             function to be launched first.
         """
+        self._compute_deferred_persistence()
+        if self.float_thisptr != 0:
+            assert self.float_pcohptr != NULL, "compute_persistence() must be called before persistence_pairs()"
+            return self.float_pcohptr.persistence_pairs()
         assert self.pcohptr != NULL, "compute_persistence() must be called before persistence_pairs()"
         return self.pcohptr.persistence_pairs()
 
+    def persistence_memory_usage(self):
+        """This function returns the memory used by the last persistence computation, in bytes, the simplex tree
+        excluded, broken down by part: the cells (`cells`), columns (`columns`) and rows (`rows`) of the compressed
+        annotation matrix, the union-find structure of the connected components (`disjoint_sets`), the persistence
+        intervals (`persistent_pairs`) and the representative cocycles (`cocycles`).
+
+        :returns: The memory used by each part, and their sum `total`.
+        :rtype: dict of int
+
+        :note: persistence_memory_usage function requires
+            :func:`compute_persistence`
+            function to be launched first.
+        """
+        self._check_not_float32()
+        self._compute_deferred_persistence()
+        assert self.pcohptr != NULL, "compute_persistence() must be called before persistence_memory_usage()"
+        cdef Simplex_tree_persistence_memory_usage usage = self.pcohptr.memory_usage()
+        return {"cells": usage.cells, "columns": usage.columns, "rows": usage.rows,
+                "disjoint_sets": usage.disjoint_sets, "persistent_pairs": usage.persistent_pairs,
+                "cocycles": usage.cocycles, "total": usage.total()}
+
     def write_persistence_diagram(self, persistence_file):
         """This function writes the persistence intervals of the simplicial
         complex in a user given file name.
@@ -739,6 +1399,11 @@ cdef class SimplexTree:
             :func:`compute_persistence`
             function to be launched first.
         """
+        self._compute_deferred_persistence()
+        if self.float_thisptr != 0:
+            assert self.float_pcohptr != NULL, "compute_persistence() must be called before write_persistence_diagram()"
+            self.float_pcohptr.write_output_diagram(persistence_file.encode('utf-8'))
+            return
         assert self.pcohptr != NULL, "compute_persistence() must be called before write_persistence_diagram()"
         self.pcohptr.write_output_diagram(persistence_file.encode('utf-8'))
 
@@ -752,10 +1417,18 @@ cdef class SimplexTree:
 
         :note: lower_star_persistence_generators requires that `persistence()` be called first.
         """
+        self._check_not_float32()
+        self._compute_deferred_persistence()
         assert self.pcohptr != NULL, "lower_star_persistence_generators() requires that persistence() be called first."
-        gen = self.pcohptr.lower_star_generators()
-        normal = [np.array(d).reshape(-1,2) for d in gen.first]
-        infinite = [np.array(d) for d in gen.second]
+        cdef pair[vector[size_t], vector[size_t]] counts
+        with nogil:
+            counts = self.pcohptr.num_generators_by_dimension()
+        normal = [np.empty((n, 2), dtype=np.intc) for n in counts.first]
+        infinite = [np.empty(n, dtype=np.intc) for n in counts.second]
+        cdef vector[uintptr_t] normal_ptrs = [d.ctypes.data for d in normal]
+        cdef vector[uintptr_t] infinite_ptrs = [d.ctypes.data for d in infinite]
+        with nogil:
+            self.pcohptr.fill_lower_star_generators(normal_ptrs, infinite_ptrs)
         return (normal, infinite)
 
     def flag_persistence_generators(self):
@@ -770,22 +1443,23 @@ cdef class SimplexTree:
 
         :note: flag_persistence_generators requires that `persistence()` be called first.
         """
+        self._check_not_float32()
+        self._compute_deferred_persistence()
         assert self.pcohptr != NULL, "flag_persistence_generators() requires that persistence() be called first."
-        gen = self.pcohptr.flag_generators()
-        if len(gen.first) == 0:
-            normal0 = np.empty((0,3))
-            normals = []
-        else:
-            l = iter(gen.first)
-            normal0 = np.array(next(l)).reshape(-1,3)
-            normals = [np.array(d).reshape(-1,4) for d in l]
-        if len(gen.second) == 0:
-            infinite0 = np.empty(0)
-            infinites = []
-        else:
-            l = iter(gen.second)
-            infinite0 = np.array(next(l))
-            infinites = [np.array(d).reshape(-1,2) for d in l]
+        cdef pair[vector[size_t], vector[size_t]] counts
+        with nogil:
+            counts = self.pcohptr.num_generators_by_dimension()
+        normal = [np.empty((n, 3 if d == 0 else 4), dtype=np.intc) for d, n in enumerate(counts.first)]
+        infinite = [np.empty(n, dtype=np.intc) if d == 0 else np.empty((n, 2), dtype=np.intc)
+                    for d, n in enumerate(counts.second)]
+        cdef vector[uintptr_t] normal_ptrs = [d.ctypes.data for d in normal]
+        cdef vector[uintptr_t] infinite_ptrs = [d.ctypes.data for d in infinite]
+        with nogil:
+            self.pcohptr.fill_flag_generators(normal_ptrs, infinite_ptrs)
+        normal0 = normal[0] if normal else np.empty((0, 3), dtype=np.intc)
+        normals = normal[1:]
+        infinite0 = infinite[0] if infinite else np.empty(0, dtype=np.intc)
+        infinites = infinite[1:]
         return (normal0, normals, infinite0, infinites)
 
     def collapse_edges(self, nb_iterations = 1):
@@ -814,7 +1488,12 @@ cdef class SimplexTree:
         """:returns: True if the 2 complexes have the same simplices with the same filtration values, False otherwise.
         :rtype: bool
         """
-        return dereference(self.get_ptr()) == dereference(other.get_ptr())
+        cdef SimplexTree other_stree = other
+        if self.dtype != other_stree.dtype:
+            return False
+        if self.float_thisptr != 0:
+            return dereference(self.get_float_ptr()) == dereference(other_stree.get_float_ptr())
+        return dereference(self.get_ptr()) == dereference(other_stree.get_ptr())
     
     def __getstate__(self):
         """:returns: Serialized (or flattened) SimplexTree data structure in order to pickle SimplexTree.
@@ -849,5 +1528,110 @@ cdef class SimplexTree:
             self.get_ptr().deserialize(buffer_start, buffer_size)
 
 
+def persistence_batch(simplex_trees, homology_coeff_field=11, min_persistence=0, persistence_dim_max = False):
+    """This function computes the persistence of several simplex trees, in parallel when gudhi is built with TBB,
+    without holding the GIL. It is equivalent to calling :meth:`SimplexTree.persistence` on each of them, whose
+    persistence can then be accessed through :meth:`SimplexTree.betti_numbers`,
+    :meth:`SimplexTree.persistence_pairs`, etc.
+
+    :param simplex_trees: The simplex trees. A simplex tree cannot appear twice.
+    :type simplex_trees: list of SimplexTree
+    :param homology_coeff_field: The homology coefficient field. Must be a
+        prime number. Default value is 11. Max is 46337.
+    :type homology_coeff_field: int
+    :param min_persistence: The minimum persistence value to take into
+        account (strictly greater than min_persistence). Default value is
+        0.0.
+        Set min_persistence to -1.0 to see all values.
+    :type min_persistence: float
+    :param persistence_dim_max: If true, the persistent homology for the
+        maximal dimension in the complex is computed. If false, it is
+        ignored. Default is false.
+    :type persistence_dim_max: bool
+    :returns: The diagrams, packed in 3 arrays `(offsets, dimensions, intervals)`. The diagram of `simplex_trees[i]`
+        is made of the intervals `intervals[offsets[i]:offsets[i+1]]` of dimensions
+        `dimensions[offsets[i]:offsets[i+1]]`, in the order of :meth:`SimplexTree.persistence`.
+    :rtype: Tuple[numpy.array[int] of shape (n+1,), numpy.array[int] of shape (m,), numpy.array[float] of shape (m,2)]
+    :raises ValueError: If a simplex tree appears twice.
+    """
+    if len({id(st) for st in simplex_trees}) != len(simplex_trees):
+        raise ValueError("A simplex tree cannot appear twice in a persistence batch")
+    cdef bool pdm = persistence_dim_max
+    cdef int coef = homology_coeff_field
+    cdef double minp = min_persistence
+    cdef vector[Simplex_tree_persistence_interface*] pcoh
+    cdef SimplexTree stree
+    for st in simplex_trees:
+        stree = st
+        if stree.pcohptr == NULL:
+            stree.pcohptr = new Simplex_tree_persistence_interface(stree.get_ptr(), pdm)
+        pcoh.push_back(stree.pcohptr)
+    cdef vector[size_t] offsets
+    with nogil:
+        offsets = compute_persistence_batch(pcoh, coef, minp, pdm)
+    dimensions = np.empty(offsets.back(), dtype=np.intc)
+    intervals = np.empty((offsets.back(), 2), dtype=np.float64)
+    cdef uintptr_t dimensions_ptr = dimensions.ctypes.data
+    cdef uintptr_t intervals_ptr = intervals.ctypes.data
+    with nogil:
+        fill_persistence_batch(pcoh, offsets, dimensions_ptr, intervals_ptr)
+    return (np.array(offsets, dtype=np.intp), dimensions, intervals)
+
+
+def profiling_report():
+    """Returns the timers and counters recorded by the instrumentation of the C++ code since the import of gudhi or
+    the last call of :func:`reset_profiling`, e.g. during :meth:`SimplexTree.expansion` or
+    :meth:`SimplexTree.persistence`. The instrumentation is only compiled when gudhi is built with the cmake option
+    `WITH_GUDHI_PROFILING`, otherwise the timers and counters are always empty.
+
+    Timers are identified by the path of the timers enclosing them, and summed over the threads. This only covers
+    the calls made through this module.
+
+    :returns: A dictionary with the keys `timers`, whose values are dictionaries `{"seconds": float, "calls": int}`,
+        and `counters`, whose values are integers, and the boolean `enabled`.
+    :rtype: dict
+    """
+    cdef Profiling_report report
+    cdef pair[string, Profiling_timer_entry] timer
+    cdef pair[string, size_t] counter
+    with nogil:
+        report = c_profiling_report()
+    timers = {}
+    for timer in report.timers:
+        timers[timer.first.decode("utf-8")] = {"seconds": timer.second.seconds, "calls": timer.second.calls}
+    counters = {}
+    for counter in report.counters:
+        counters[counter.first.decode("utf-8")] = counter.second
+    return {"enabled": c_profiling_enabled(), "timers": timers, "counters": counters}
+
+def reset_profiling():
+    """Clears the timers and counters returned by :func:`profiling_report`."""
+    with nogil:
+        c_reset_profiling()
+
+# Tracing of the C++ code called by this module, cf. gudhi.tracing
+def _start_tracing():
+    c_start_tracing()
+
+def _stop_tracing():
+    c_stop_tracing()
+
+def _begin_event(name):
+    c_begin_event(name.encode("utf-8"))
+
+def _end_event(name):
+    c_end_event(name.encode("utf-8"))
+
+def _trace_events():
+    cdef vector[Profiling_trace_event] events
+    cdef Profiling_trace_event event
+    with nogil:
+        events = c_trace_events()
+    out = []
+    for event in events:
+        out.append((event.name.decode("utf-8"), chr(event.phase), event.timestamp, event.thread))
+    return out
+
 cdef intptr_t _get_copy_intptr(SimplexTree stree) nogil:
-    return <intptr_t>(new Simplex_tree_interface_full_featured(dereference(stree.get_ptr())))
+    return <intptr_t>(new Simplex_tree_interface_full_featured(
+        dereference(<Simplex_tree_interface_full_featured*>(stree.thisptr))))
@@ -13,6 +13,8 @@ from libcpp.vector cimport vector
 from libcpp.utility cimport pair
 from libcpp cimport bool
 from libcpp.string cimport string
+from libcpp.memory cimport shared_ptr
+from libc.stdint cimport int16_t, int32_t, uintptr_t
 
 __author__ = "Vincent Rouvreau"
 __copyright__ = "Copyright (C) 2016 Inria"
@@ -44,10 +46,24 @@ cdef extern from "multi_filtrations/finitely_critical_filtrations.h" namespace "
 		
 
 
+cdef extern from "multi_filtrations/filtration_table.h" namespace "Gudhi::multiparameter::multi_filtrations":
+	cdef cppclass Filtration_table "Gudhi::multiparameter::multi_filtrations::Filtration_table<Gudhi::multiparameter::Simplex_tree_options_multidimensional_filtration::value_type>":
+		Filtration_table() nogil
+		size_t num_parameters() nogil
+		size_t num_simplices() nogil
+		value_type* data() nogil
+
+
 cdef extern from "Simplex_tree_interface_multi.h" namespace "Gudhi::multiparameter":
 	cdef cppclass Simplex_tree_options_multidimensional_filtration:
 		pass
 
+	cdef struct Lowerstar_timings:
+		double seconds
+		size_t num_simplices
+		size_t num_axes
+		size_t num_tasks
+
 	cdef cppclass Simplex_tree_multi_simplex_handle "Gudhi::multiparameter::Simplex_tree_interface_multi<Gudhi::multiparameter::Simplex_tree_options_multidimensional_filtration>::Simplex_handle":
 		pass
 
@@ -70,6 +86,19 @@ cdef extern from "Simplex_tree_interface_multi.h" namespace "Gudhi::multiparamet
 		bint operator!=(Simplex_tree_multi_boundary_iterator) nogil
 
 
+	cdef cppclass Simplex_tree_multi_memory_usage "Gudhi::multiparameter::Simplex_tree_interface_multi<Gudhi::multiparameter::Simplex_tree_options_multidimensional_filtration>::Memory_usage":
+		size_t nodes
+		size_t siblings
+		size_t filtration_values
+		size_t label_lists
+		size_t filtration_cache
+		size_t find_index
+		size_t total() nogil
+
+	cdef cppclass Simplex_tree_multi_expansion_budget "Gudhi::multiparameter::Simplex_tree_interface_multi<Gudhi::multiparameter::Simplex_tree_options_multidimensional_filtration>::Expansion_budget":
+		size_t max_num_simplices
+		size_t max_memory
+
 	cdef cppclass Simplex_tree_multi_interface "Gudhi::multiparameter::Simplex_tree_interface_multi<Gudhi::multiparameter::Simplex_tree_options_multidimensional_filtration>":
 		Simplex_tree_multi_interface() nogil
 		Simplex_tree_multi_interface(Simplex_tree_multi_interface&) nogil
@@ -85,7 +114,11 @@ cdef extern from "Simplex_tree_interface_multi.h" namespace "Gudhi::multiparamet
 		bool insert(vector[int]& simplex, filtration_type& filtration) nogil
 		vector[simplex_filtration_type] get_star(const vector[int]& simplex) nogil
 		vector[simplex_filtration_type] get_cofaces(const vector[int]& simplex, int dimension) nogil
+		vector[vector[simplex_filtration_type]] get_cofaces_batch(const vector[simplex_type]& simplices, int dimension) nogil
 		void expansion(int max_dim)  except + nogil
+		bool expansion_with_budget(int max_dim, const Simplex_tree_multi_expansion_budget& budget) except + nogil
+		vector[double] estimate_expansion_size(int max_dim, size_t num_samples) nogil
+		vector[double] estimate_expansion_size(int max_dim, size_t num_samples, unsigned int seed) nogil
 		void remove_maximal_simplex(simplex_type simplex) nogil
 		# bool prune_above_filtration(filtration_type filtration) nogil
 		bool prune_above_dimension(int dimension) nogil
@@ -94,6 +127,9 @@ cdef extern from "Simplex_tree_interface_multi.h" namespace "Gudhi::multiparamet
 		# Simplex_tree_multi_interface* collapse_edges(int nb_collapse_iteration)  except + nogil
 		void reset_filtration(const filtration_type& filtration, int dimension) nogil
 		bint operator==(Simplex_tree_multi_interface) nogil
+		void serialize(char* buffer, const size_t buffer_size) except + nogil
+		void deserialize(const char* buffer, const size_t buffer_size) except + nogil
+		size_t get_serialization_size() nogil
 		# Iterators over Simplex tree
 		simplex_filtration_type get_simplex_and_filtration(Simplex_tree_multi_simplex_handle f_simplex) nogil
 		Simplex_tree_multi_simplices_iterator get_simplices_iterator_begin() nogil
@@ -111,12 +147,69 @@ cdef extern from "Simplex_tree_interface_multi.h" namespace "Gudhi::multiparamet
 		void set_keys_to_enumerate() nogil const
 		int get_key(const simplex_type) nogil
 		void set_key(simplex_type, int) nogil
-		void fill_lowerstar(const vector[value_type]&, int) nogil
+		void fill_lowerstar(const vector[value_type]&, int) except + nogil
+		Lowerstar_timings fill_lowerstars(const vector[vector[value_type]]&, const vector[int]&) except + nogil
+		void fill_function_rips(const vector[vector[value_type]]&, const vector[value_type]&, value_type, int) except + nogil
 		simplex_list get_simplices_of_dimension(int) nogil
+		void insert_batch(uintptr_t, size_t, size_t, uintptr_t) except + nogil
+		vector[size_t] num_simplices_by_dimension(int) nogil
+		void fill_simplices_and_filtrations(const vector[uintptr_t]&, const vector[uintptr_t]&) except + nogil
+		pair[size_t, size_t] boundary_matrix_sizes() nogil
+		void fill_boundary_matrix(uintptr_t, uintptr_t, uintptr_t, uintptr_t) except + nogil
 		edge_list get_edge_list() nogil
 		# euler_char_list euler_char(const vector[filtration_type]&) nogil
 		void resize_all_filtrations(int) nogil
 		void set_number_of_parameters(int) nogil
 		int get_number_of_parameters() nogil
+		shared_ptr[Filtration_table] build_filtration_table() nogil
+		void commit_filtration_table() except + nogil
+		void clear_filtration_table() nogil
+		void fill_lowerstar_table(const vector[value_type]&, int) except + nogil
+		void squeeze_filtration_table(const vector[vector[value_type]]&, bool) except + nogil
+		Filtration_table* new_filtration_variant() nogil
+		void fill_lowerstar_variant(Filtration_table&, const vector[value_type]&, int) except + nogil
+		void squeeze_filtration_variant(Filtration_table&, const vector[vector[value_type]]&, bool) except + nogil
+		void assign_filtration_variant(const Filtration_table&) except + nogil
+		Simplex_tree_multi_memory_usage memory_usage() nogil
+		void to_scc(const string&, bool, bool, bool, bool, bool) except + nogil
+		void from_scc(const string&, bool) except + nogil
+		void from_rivet(const string&) except + nogil
+		void collapse_edges(int, int, bool, bool) except + nogil
+		vector[vector[vector[pair[double, double]]]] sliced_barcodes(const vector[vector[value_type]]&, const vector[vector[value_type]]&, const vector[int]&, int, double, bool) except + nogil
+		vector[int32_t] hilbert_function(const vector[size_t]&, const vector[int]&) except + nogil
+		void hilbert_signed_measure(const vector[size_t]&, const vector[int]&, vector[int32_t]&, vector[int32_t]&) except + nogil
+		void minimal_presentation(int, vector[value_type]&, vector[value_type]&, vector[vector[size_t]]&) except + nogil
+
+	Simplex_tree_multi_memory_usage estimate_simplex_tree_multi_memory_usage "Gudhi::multiparameter::Simplex_tree_interface_multi<Gudhi::multiparameter::Simplex_tree_options_multidimensional_filtration>::estimate_memory_usage"(const vector[size_t]& num_simplices_by_dimension, size_t filtration_value_heap_size) nogil
+
+	cdef cppclass Simplex_tree_multi_squeezed_int32_interface "Gudhi::multiparameter::Simplex_tree_interface_multi_squeezed<int32_t>":
+		Simplex_tree_multi_squeezed_int32_interface() nogil
+		Simplex_tree_multi_squeezed_int32_interface(Simplex_tree_multi_squeezed_int32_interface&) nogil
+		const vector[vector[value_type]]& get_filtration_grid() nogil
+		void squeeze_from_ptr(uintptr_t, const vector[vector[value_type]]&) except + nogil
+		void unsqueeze_to_ptr(uintptr_t) except + nogil
+		bool find_simplex(const vector[int]& simplex) nogil
+		int32_t* simplex_filtration(const vector[int]& simplex) nogil
+		vector[vector[int32_t]] get_filtrations(int) nogil
+		int num_vertices() nogil
+		int num_simplices() nogil
+		int dimension() nogil
+		int get_number_of_parameters() nogil
+		bool make_filtration_non_decreasing() nogil
+
+	cdef cppclass Simplex_tree_multi_squeezed_int16_interface "Gudhi::multiparameter::Simplex_tree_interface_multi_squeezed<int16_t>":
+		Simplex_tree_multi_squeezed_int16_interface() nogil
+		Simplex_tree_multi_squeezed_int16_interface(Simplex_tree_multi_squeezed_int16_interface&) nogil
+		const vector[vector[value_type]]& get_filtration_grid() nogil
+		void squeeze_from_ptr(uintptr_t, const vector[vector[value_type]]&) except + nogil
+		void unsqueeze_to_ptr(uintptr_t) except + nogil
+		bool find_simplex(const vector[int]& simplex) nogil
+		int16_t* simplex_filtration(const vector[int]& simplex) nogil
+		vector[vector[int16_t]] get_filtrations(int) nogil
+		int num_vertices() nogil
+		int num_simplices() nogil
+		int dimension() nogil
+		int get_number_of_parameters() nogil
+		bool make_filtration_non_decreasing() nogil
 
 
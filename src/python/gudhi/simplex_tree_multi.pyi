@@ -56,6 +56,20 @@ class SimplexTreeMulti:
 	def __deepcopy__(self):
 		...
 
+	def filtration_variant(self)->SimplexTreeMultiVariant:
+		"""Returns a copy of the filtration values of this simplextree, sharing its structure.
+
+		Only the filtration values are copied, in a table of `num_parameters * num_simplices` values, so that many
+		variants of a large simplextree, e.g. with different lower-star functions or grids, cost much less memory than
+		as many calls of :meth:`copy`. The structure of this simplextree should not be modified while its variants
+		are used; its filtration values can.
+
+		Returns
+		-------
+		variant:SimplexTreeMultiVariant
+		"""
+		...
+
 	def filtration(self, simplex:list|np.ndarray)->np.ndarray:
 		"""This function returns the filtration value for a given N-simplex in
 		this simplicial complex, or +infinity if it is not in the complex.
@@ -111,6 +125,21 @@ class SimplexTreeMulti:
 		"""
 		...
 
+	def memory_usage(self)->dict:
+		"""Memory used by this simplextree, in bytes, broken down by part: the nodes (`nodes`), the sets of children
+		(`siblings`), the coordinates of the filtration values (`filtration_values`), the lists of nodes by label
+		(`label_lists`), the simplices sorted by filtration (`filtration_cache`) and the hash table of the find index
+		(`find_index`), and their sum (`total`). Takes time linear in the number of simplices.
+		"""
+		...
+
+	@staticmethod
+	def estimate_memory_usage(num_simplices_by_dimension:list[int], num_parameters:int)->dict:
+		"""Estimates the memory used by a simplextree with `num_simplices_by_dimension[d]` simplices of dimension `d`
+		and `num_parameters` parameters, in bytes, broken down by part as :meth:`memory_usage`.
+		"""
+		...
+
 	@property
 	def dimension(self)->int:
 		"""This function returns the dimension of the simplicial complex.
@@ -195,21 +224,20 @@ class SimplexTreeMulti:
 		
 	@cython.boundscheck(False)
 	@cython.wraparound(False)
-	def insert_batch(self, some_int[:,:] vertex_array, some_float[:,:]  filtrations)->SimplexTreeMulti:
+	def insert_batch(self, vertex_array:np.ndarray, filtrations:np.ndarray)->SimplexTreeMulti:
 		"""Inserts k-simplices given by a sparse array in a format similar
 		to `torch.sparse <https://pytorch.org/docs/stable/sparse.html>`_.
 		The n-th simplex has vertices `vertex_array[0,n]`, ...,
 		`vertex_array[k,n]` and filtration value `filtrations[n,num_parameters]`.
 		/!\ Only compatible with 1-critical filtrations. If a simplex is repeated, 
 		only one filtration value will be taken into account.
+		The faces of all the simplices are sorted once in C++, and the simplextree is built from them in a single pass.
 
 		:param vertex_array: the k-simplices to insert.
 		:type vertex_array: numpy.array of shape (k+1,n)
 		:param filtrations: the filtration values.
 		:type filtrations: numpy.array of shape (n,num_parameters)
 		"""
-		# TODO : multi-critical
-		# cdef vector[int] vertices = np.unique(vertex_array)
 		...
 
 
@@ -260,6 +288,38 @@ class SimplexTreeMulti:
 		"""
 		...
 
+	def get_simplices_and_filtrations(self, max_dimension:int=-1)->list[tuple[np.ndarray,np.ndarray]]:
+		"""Returns all the simplices of dimension at most `max_dimension` and their filtration values at once, grouped
+		by dimension. This is much faster than :meth:`get_simplices` or :meth:`get_skeleton` on large complexes, as the
+		arrays are filled in C++, without the GIL.
+
+		Parameters
+		----------
+		max_dimension:int
+			Maximal dimension of the simplices, all of them if negative.
+
+		Returns
+		-------
+		A list whose element `d` is a pair of arrays `(vertices, filtrations)` of shapes `(n_d, d+1)` and
+		`(n_d, num_parameters)`, where `n_d` is the number of simplices of dimension `d`. The rows follow the order of
+		:meth:`get_skeleton`, and the vertices of each simplex are increasing.
+		"""
+		...
+
+	def boundary_matrix(self)->tuple[np.ndarray,np.ndarray,np.ndarray,np.ndarray]:
+		"""Returns the boundary matrix of the complex in compressed sparse column format, with the simplices in the
+		order of the filtration. The arrays are allocated by NumPy and filled in C++, without the GIL.
+
+		Returns
+		-------
+		The arrays `(indptr, indices, dimensions, filtrations)`, of shapes `(n+1,)`, `(nnz,)`, `(n,)` and
+		`(n, num_parameters)`, where `n` is the number of simplices. The indices of the facets of the `i`-th simplex are
+		`indices[indptr[i]:indptr[i+1]]`, in increasing order, so that
+		:code:`scipy.sparse.csc_matrix((np.ones(len(indices), dtype=np.int8), indices, indptr))` shares their memory.
+		This overwrites the keys of the simplices with their indices in the filtration.
+		"""
+		...
+
 	def get_star(self, simplex):
 		"""This function returns the star of a given N-simplex.
 
@@ -284,6 +344,23 @@ class SimplexTreeMulti:
 		"""
 		...
 
+	def get_cofaces_batch(self, simplices, codimension):
+		"""This function returns the cofaces of several simplices with a given
+		codimension, as :func:`get_cofaces` called on each of them, but in a
+		single query that runs in parallel.
+
+		:param simplices: The simplices, each represented by a list of vertex.
+		:type simplices: list of list of int
+		:param codimension: The codimension. If codimension = 0, all cofaces
+			are returned (equivalent of get_star function)
+		:type codimension: int
+		:returns:  For each simplex, the (simplices of the) cofaces of the
+			simplex, in no particular order. A simplex that is not in the
+			complex has no cofaces.
+		:rtype:  list of list of tuples(simplex, filtration)
+		"""
+		...
+
 	def get_boundaries(self, simplex):
 		"""This function returns a generator with the boundaries of a given N-simplex.
 		If you do not need the filtration values, the boundary can also be obtained as
@@ -346,8 +423,11 @@ class SimplexTreeMulti:
 		attached to a graph :math:`G` is the maximal simplicial complex of
 		dimension at most :math:`d` admitting the graph :math:`G` as
 		:math:`1`-skeleton.
-		The filtration value assigned to a simplex is the maximal filtration
-		value of one of its edges.
+		The filtration value assigned to a simplex is the coordinate-wise maximum
+		of the filtration values of its edges. If the filtration of the graph is
+		not non-decreasing, e.g., an edge with a grade incomparable to the one of
+		a vertex, :meth:`make_filtration_non_decreasing` is applied afterwards,
+		so that the result is always a valid filtration.
 
 		The simplex tree must contain no simplex of dimension bigger than
 		1 when calling the method.
@@ -357,6 +437,54 @@ class SimplexTreeMulti:
 		"""
 		...
 
+	def expansion_with_budget(self, max_dim:int, max_num_simplices:int|None=None, max_memory:int|None=None, raise_on_budget:bool=False)->bool:
+		"""Expands the simplex tree containing only its one skeleton until dimension max_dim, like :meth:`expansion`,
+		unless the complex gets larger than a budget, in which case the expansion stops.
+
+		The subtrees of the vertices are expanded one after the other, from the greatest vertex, and the simplices of
+		dimension at least 2 of the subtree which exceeds the budget are removed, so that the simplextree is a
+		simplicial complex within the budget: the graph and the cliques whose vertices are all greater than some
+		vertex. :meth:`estimate_expansion_size` helps choosing the budget beforehand.
+
+		Parameters
+		----------
+		max_dim:int
+			The maximal dimension.
+		max_num_simplices:int
+			The maximal number of simplices of the complex. Default is no limit.
+		max_memory:int
+			The maximal memory of the complex, in bytes, as the `total` of :meth:`memory_usage`. Default is no limit.
+		raise_on_budget:bool
+			Raises a `MemoryError` if the expansion stops, instead of returning False.
+
+		Returns
+		-------
+		complete:bool
+			Whether the expansion is complete.
+		"""
+		...
+
+	def estimate_expansion_size(self, max_dim:int, num_samples:int=1000, seed:int|None=None)->list[float]:
+		"""Estimates the number of simplices of each dimension of the :meth:`expansion` of the one skeleton of the
+		simplextree, without building it, by sampling its cliques. The numbers of vertices and edges are exact, and the
+		relative error of the others decreases as the inverse of the square root of `num_samples`.
+
+		Parameters
+		----------
+		max_dim:int
+			The maximal dimension.
+		num_samples:int
+			The number of random samples.
+		seed:int
+			The seed of the random number generator. Default is a random seed.
+
+		Returns
+		-------
+		sizes:list[float]
+			The estimated number of simplices of each dimension, up to max_dim.
+		"""
+		...
+
 	def make_filtration_non_decreasing(self)->bool: 
 		"""This function ensures that each simplex has a higher filtration
 		value than its faces by increasing the filtration values.
@@ -615,8 +743,12 @@ class SimplexTreeMulti:
 			box=None : pair[list[float]]
 				Grid bounds. format : [low bound, high bound]
 				If None is given, will use the filtration bounds of the simplextree.
-			grid_strategy="regular" : string
-				Either "regular", "quantile", or "exact".
+			drop_quantiles=0 : float or pair of floats
+				The values below the quantile `drop_quantiles[0]` and above the quantile `1 - drop_quantiles[1]` of the
+				distinct values are removed before computing the grid.
+			grid_strategy="exact" : string
+				Either "exact" (all the distinct values), "regular", "regular_closest", "quantile" or "partition".
+				The grid is computed in C++, from the sorted distinct finite values of each parameter.
 		Returns
 		-------
 			List of filtration values, for each parameter, defining the grid.
@@ -643,6 +775,24 @@ class SimplexTreeMulti:
 	def filtration_bounds(self, degrees:Iterable[int]|None=None, q:float|tuple=0, split_dimension:bool=False)->np.ndarray:
 		"""
 		Returns the filtrations bounds of the finite filtration values.
+
+		The bounds are the (approximate) quantiles `q[0]` and `1-q[1]` of the finite values of each parameter, computed
+		in a single pass over the simplices, cf. :meth:`filtration_statistics`. If `split_dimension` is true, the
+		bounds are given for each degree.
+		"""
+		...
+
+	def filtration_statistics(self, degrees:Iterable[int]|None=None, quantiles:Iterable[float]=())->dict:
+		"""
+		Statistics of the filtration values of the simplices of the given degrees (all of them by default), computed
+		in a single parallel pass over the simplices, without copying the filtration values.
+
+		:param quantiles: Quantiles of the finite values of each parameter to compute. They are approximated with a
+			precision of about 3% of the values, except for the quantiles 0 and 1 which are the exact bounds.
+		:returns: A dictionary with the number of simplices `"num_simplices_per_dimension"`, and for each parameter
+			the bounds of the finite values `"min"` and `"max"`, the number of finite, infinite and NaN values
+			`"num_finite"`, `"num_plus_infinite"`, `"num_minus_infinite"`, `"num_nan"`, and the `"quantiles"`, of
+			shape (number of quantiles, number of parameters).
 		"""
 		...
 
@@ -667,7 +817,25 @@ class SimplexTreeMulti:
 		# 	self.assign_filtration(s, [f if i != dimension else np.max(np.array(F)[s]) for i,f in enumerate(sf)])
 		...
 
-	def project_on_line(self, parameter:int=0, basepoint:None|list|np.ndarray= None)->SimplexTree:
+	def fill_lowerstars(self, Fs, parameters:Iterable[int])->dict:
+		""" Fills several filtration parameters at once, by the lower-star filtrations defined by the rows of Fs.
+		The simplextree is walked once, and the subtrees of the vertices are filled in parallel.
+
+		Parameters
+		----------
+		Fs:2d array of shape (len(parameters), num_vertices)
+			The functions over the vertices, that induce the lower-star filtrations.
+		parameters:Iterable[int]
+			Which filtration parameter to fill with each row of Fs.
+
+		Returns
+		-------
+		Counters of the fill : its time in seconds (`seconds`), and its numbers of simplices (`num_simplices`),
+		of filled parameters (`num_axes`) and of independent subtrees (`num_tasks`).
+		"""
+		...
+
+	def project_on_line(self, parameter:int=0, basepoint:None|list|np.ndarray= None, box:None|list|np.ndarray=None)->SimplexTree:
 		"""Converts an multi simplextree to a gudhi simplextree.
 		Parameters
 		----------
@@ -675,6 +843,11 @@ class SimplexTreeMulti:
 				The parameter to keep. WARNING will crash if the multi simplextree is not well filled.
 			basepoint:None
 				Instead of keeping a single parameter, will consider the filtration defined by the diagonal line crossing the basepoint.
+			box:None
+				Array of shape (2, num_parameters), the bottom and upper corners of a box. If given, only the simplices
+				whose filtration value is smaller than the upper corner are kept, and their filtration values are
+				clamped to the bottom corner. The simplices out of the box are skipped with their cofaces, without being
+				visited, so that the filtration has to be non-decreasing, cf. :meth:`make_filtration_non_decreasing`.
 		WARNING 
 		-------
 			There are no safeguard yet, it WILL crash if asking for a parameter that is not filled.
@@ -684,13 +857,15 @@ class SimplexTreeMulti:
 		"""
 		...
 
-	def linear_projections(self, linear_forms:np.ndarray)->Iterable[SimplexTree]:
+	def linear_projections(self, linear_forms:np.ndarray, box:None|list|np.ndarray=None)->Iterable[SimplexTree]:
 		"""
 		Compute the 1-parameter projections, w.r.t. given the linear forms, of this simplextree.
 
 		Input
 		-----
 		 - Array of shape (num_linear_forms, num_parameters)
+		 - box : if given, array of shape (2, num_parameters). Only the part of the filtration in this box is
+		   projected, cf. :meth:`project_on_line`.
 		
 		Output
 		------
@@ -698,6 +873,87 @@ class SimplexTreeMulti:
 		"""
 		...
 
+	def sliced_barcodes(self, basepoints:np.ndarray, directions:np.ndarray|None=None, degrees:Iterable[int]=[0,1], coefficient_field:int=11, min_persistence:float=0., vineyard:bool=False)->list[list[np.ndarray]]:
+		"""
+		Computes the barcodes of the 1-parameter filtrations given by the restriction of this filtration to many lines.
+		The simplextree is walked once, and the lines are processed in parallel, without building a `SimplexTree` per line.
+
+		Input
+		-----
+		 - basepoints : array of shape (num_lines, num_parameters)
+		 - directions : array of shape (num_lines, num_parameters), with positive coordinates. Diagonal lines if None.
+		 - degrees : homological degrees to compute
+		 - coefficient_field : prime number of the field of coefficients
+		 - min_persistence : bars of length smaller or equal to this are discarded
+		 - vineyard : if True, the lines are processed in the given order, and persistence is updated from one line to the next
+		   by transpositions (vineyards) instead of being recomputed. Faster for sweeps of close lines. Coefficients are then in Z/2Z.
+		
+		Output
+		------
+		 - List (over lines) of list (over degrees) of barcodes, as arrays of shape (num_bars, 2).
+		 A value t of a bar of the line (b,d) stands for the point b + t*d.
+		"""
+		...
+
+	def hilbert_function(self, degrees:Iterable[int]=[0,1], grid_shape:Iterable[int]|None=None)->np.ndarray:
+		"""
+		Computes the Hilbert function of this filtration on its grid, i.e., the dimension of the homology of the
+		subcomplex of the simplices whose filtration values are smaller or equal to each point of the grid.
+		The simplextree has to be squeezed on a grid with coordinate values, cf. :meth:`grid_squeeze`.
+		The grid is cut in lines along the last parameter, processed in parallel by blocks, and persistence is updated
+		from one line to the next with vineyards. Coefficients are in Z/2Z.
+
+		Input
+		-----
+		 - degrees : homological degrees to compute
+		 - grid_shape : number of values of the grid for each parameter. Defaults to the shape of `filtration_grid`.
+
+		Output
+		------
+		 - Array of shape (len(degrees), *grid_shape), of int32.
+		"""
+		...
+
+
+	def hilbert_signed_measure(self, degrees:Iterable[int]=[0,1], grid_shape:Iterable[int]|None=None)->list[tuple[np.ndarray, np.ndarray]]:
+		"""
+		Computes the signed measure of the Hilbert function, i.e., its Möbius inversion on the grid, cf.
+		:meth:`hilbert_function`. The inversion is done in C++, in place, and only the points with a non-zero weight
+		are returned, so that no dense tensor is copied to Python.
+
+		Input
+		-----
+		 - degrees : homological degrees to compute
+		 - grid_shape : number of values of the grid for each parameter. Defaults to the shape of `filtration_grid`.
+
+		Output
+		------
+		 - For each degree, the pair (coordinates, weights) of the measure: an int32 array of shape (num_points,
+		   num_parameters) of grid coordinates, and an int32 array of shape (num_points,).
+		"""
+		...
+
+
+	def minimal_presentation(self, degree:int)->tuple[np.ndarray, np.ndarray, list[np.ndarray]]:
+		"""
+		Computes a minimal presentation of the homology in degree `degree` of this 2-parameter filtration, with
+		coefficients in Z/2Z, directly from the boundary matrices (Lesnick and Wright's algorithm). This is much smaller
+		than the chain complex exported by :meth:`to_scc`. The filtration does not have to be squeezed, but squeezing
+		it first, cf. :meth:`grid_squeeze`, makes it faster. Simplices with an infinite filtration value are ignored.
+		WARNING : this overwrites the keys of the simplices.
+
+		Input
+		-----
+		 - degree : homological degree
+
+		Output
+		------
+		 - generator_grades : array of shape (num_generators, 2), the filtration values of the generators,
+		 - relation_grades : array of shape (num_relations, 2), the filtration values of the relations,
+		 - relations : list of num_relations int arrays, the generators of each relation.
+		"""
+		...
+
 
 	def set_num_parameter(self, num:int):
 		"""
@@ -712,4 +968,104 @@ class SimplexTreeMulti:
 		:rtype: bool
 		"""
 		...
-	
\ No newline at end of file
+
+	def __getstate__(self):
+		""":returns: Serialized (or flattened) SimplexTreeMulti data structure, its number of parameters and its
+			filtration grid, in order to pickle SimplexTreeMulti.
+		:rtype: tuple of a numpy.array of shape (n,), an int and a list of lists of floats
+		"""
+		...
+
+	def __setstate__(self, state):
+		"""Construct the SimplexTreeMulti data structure from the output of
+		:func:`~gudhi.SimplexTreeMulti.__getstate__` in order to unpickle a SimplexTreeMulti.
+
+		:param state: Serialized SimplexTreeMulti data structure, number of parameters and filtration grid
+		:type state: tuple of a numpy.array of shape (n,), an int and a list of lists of floats
+		"""
+		...
+	
+
+class SimplexTreeMultiVariant:
+	"""Filtration values of a :class:`SimplexTreeMulti`, sharing its structure.
+
+	It is built with :meth:`SimplexTreeMulti.filtration_variant`, and only stores a `(num_parameters, num_simplices)`
+	table of filtration values, cf. :meth:`SimplexTreeMulti.filtration_table`. It can be modified without modifying
+	the simplextree, and :meth:`to_simplextree` materializes it as a full :class:`SimplexTreeMulti`.
+	"""
+	simplextree:SimplexTreeMulti
+	filtration_grid:list|None
+
+	def __init__(self, simplextree:SimplexTreeMulti):
+		...
+
+	@property
+	def num_parameters(self)->int:
+		...
+
+	@property
+	def num_simplices(self)->int:
+		...
+
+	def filtration_table(self)->np.ndarray:
+		"""The filtration values, as a `(num_parameters, num_simplices)` array, cf.
+		:meth:`SimplexTreeMulti.filtration_table`. It is a view, which can be modified in place and remains valid as
+		long as this variant.
+		"""
+		...
+
+	def fill_lowerstar(self, F, parameter:int)->SimplexTreeMultiVariant:
+		"""Same as :meth:`SimplexTreeMulti.fill_lowerstar`, on this variant only.
+		"""
+		...
+
+	def grid_squeeze(self, filtration_grid:np.ndarray|list, coordinate_values:bool=True)->SimplexTreeMultiVariant:
+		"""Same as :meth:`SimplexTreeMulti.grid_squeeze`, on this variant only.
+		"""
+		...
+
+	def to_simplextree(self)->SimplexTreeMulti:
+		"""Returns a :class:`SimplexTreeMulti` with the structure of the shared simplextree and the filtration values
+		of this variant.
+		"""
+		...
+
+def signed_measure_from_grid(invariant:np.ndarray, num_invariant_axes:int=0)->tuple[np.ndarray, np.ndarray]:
+	"""
+	Computes the signed measure of an invariant on a grid, e.g. a Hilbert function, i.e., its Möbius inversion,
+	in C++ and in parallel, and returns its points with a non-zero weight.
+
+	Input
+	-----
+	 - invariant : integer array, whose last axes are the axes of the grid.
+	 - num_invariant_axes : number of first axes that are not grid axes, e.g. 1 for the degrees of
+	   :meth:`SimplexTreeMulti.hilbert_function`. They are not inverted.
+
+	Output
+	------
+	 - coordinates : int32 array of shape (num_points, invariant.ndim), the indices of the points in `invariant`,
+	 - weights : int32 array of shape (num_points,).
+	"""
+	...
+
+def function_rips(points, function, threshold:float=np.inf, max_dimension:int=2)->SimplexTreeMulti:
+	"""
+	Builds the function-Rips bifiltration of a point cloud, e.g. Rips x codensity: the first parameter is the Rips
+	filtration, i.e., the length of the longest edge of the simplices, and the second one is the lower-star filtration
+	of `function`, i.e., its maximum on their vertices.
+	The edges, the expansion and both parameters are computed in a single C++ call, in parallel, and the filtration is
+	non-decreasing, so that there is no need to call :meth:`SimplexTreeMulti.fill_lowerstar` or
+	:meth:`SimplexTreeMulti.make_filtration_non_decreasing`.
+
+	Input
+	-----
+	 - points : array of shape (num_points, dimension)
+	 - function : array of shape (num_points,), e.g. a codensity estimated with `gudhi.point_cloud.dtm`.
+	 - threshold : edges longer than this are not inserted.
+	 - max_dimension : dimension of the expansion.
+
+	Output
+	------
+	 - A SimplexTreeMulti with 2 parameters.
+	"""
+	...
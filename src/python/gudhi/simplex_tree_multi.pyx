@@ -20,6 +20,8 @@ from cython.operator import dereference, preincrement
 from libc.stdint cimport intptr_t
 from libc.stdint cimport uintptr_t
 from libcpp.map cimport map
+from libcpp.memory cimport shared_ptr
+from cpython.ref cimport Py_INCREF
 
 
 ctypedef fused some_int:
@@ -50,18 +52,46 @@ from tqdm import tqdm
 from warnings import warn
 
 
+cdef extern from "multi_filtrations/filtration_statistics.h" namespace "Gudhi::multiparameter::multi_filtrations":
+	cdef cppclass Filtration_statistics[T]:
+		Filtration_statistics() nogil
+		size_t num_parameters() nogil
+		size_t num_simplices() nogil
+		const vector[size_t]& num_simplices_per_dimension() nogil
+		T min(size_t) nogil
+		T max(size_t) nogil
+		size_t num_finite(size_t) nogil
+		size_t num_plus_infinite(size_t) nogil
+		size_t num_minus_infinite(size_t) nogil
+		size_t num_nan(size_t) nogil
+		T quantile(size_t, double) nogil
+
+cdef extern from "multi_filtrations/mobius_inversion.h" namespace "Gudhi::multiparameter::multi_filtrations":
+	void signed_measure[T, I](vector[T]&, const vector[size_t]&, size_t, vector[I]&, vector[T]&)  except + nogil
+
 cdef extern from "Simplex_tree_multi.h" namespace "Gudhi::multiparameter":
 	void multify_from_ptr(const uintptr_t, const uintptr_t, const unsigned int, const vector[value_type]&)  except + nogil
 	void flatten_from_ptr(const uintptr_t, const uintptr_t, const unsigned int) nogil
 	void linear_projection_from_ptr(const uintptr_t, const uintptr_t, const vector[value_type]&) nogil
+	void flatten_in_box_from_ptr(const uintptr_t, const uintptr_t, const vector[value_type]&, const vector[value_type]&, const int) nogil
+	void flatten_diag_in_box_from_ptr(const uintptr_t, const uintptr_t, const vector[value_type]&, const vector[value_type]&, const vector[value_type]&, int) nogil
+	void linear_projection_in_box_from_ptr(const uintptr_t, const uintptr_t, const vector[value_type]&, const vector[value_type]&, const vector[value_type]&) nogil
 	void flatten_diag_from_ptr(const uintptr_t, const uintptr_t, const vector[value_type], int) nogil
 	void squeeze_filtration(uintptr_t, const vector[vector[value_type]]&, bool)  except + nogil
 	vector[vector[vector[value_type]]] get_filtration_values(uintptr_t, const vector[int]&)  except + nogil
+	vector[vector[value_type]] compute_filtration_grid(uintptr_t, const vector[int]&, const string&, const vector[int]&, double, double)  except + nogil
+	Filtration_statistics[value_type] compute_filtration_statistics(uintptr_t, const vector[int]&)  except + nogil
+
 
 
 # cdef bool callback(vector[int] simplex, void *blocker_func):
 	# 	return (<object>blocker_func)(simplex)
 
+cdef _memory_usage_dict(Simplex_tree_multi_memory_usage& usage):
+	return {"nodes": usage.nodes, "siblings": usage.siblings, "filtration_values": usage.filtration_values,
+		"label_lists": usage.label_lists, "filtration_cache": usage.filtration_cache,
+		"find_index": usage.find_index, "total": usage.total()}
+
 # SimplexTree python interface
 cdef class SimplexTreeMulti:
 	"""The simplex tree is an efficient and flexible data structure for
@@ -77,6 +107,8 @@ cdef class SimplexTreeMulti:
 	# Use intptr_t instead to cast the pointer
 	cdef public intptr_t thisptr
 	cdef public vector[vector[value_type]] filtration_grid
+	# Grid of the last grid_squeeze_table with coordinate values, applied by commit_filtration_table
+	cdef object _table_filtration_grid
 
 	# Get the pointer casted as it should be
 	cdef Simplex_tree_multi_interface* get_ptr(self) nogil:
@@ -213,6 +245,46 @@ bool safe_conversion=False,
 		"""
 		return self.get_ptr().num_simplices()
 
+	def memory_usage(self)->dict:
+		"""Memory used by this simplextree, in bytes, broken down by part: the nodes (`nodes`), the sets of children
+		(`siblings`), the coordinates of the filtration values (`filtration_values`), the lists of nodes by label
+		(`label_lists`), the simplices sorted by filtration (`filtration_cache`) and the hash table of the find index
+		(`find_index`), and their sum (`total`). Takes time linear in the number of simplices.
+
+		Returns
+		-------
+		usage:dict[str, int]
+		"""
+		cdef Simplex_tree_multi_memory_usage usage
+		with nogil:
+			usage = self.get_ptr().memory_usage()
+		return _memory_usage_dict(usage)
+
+	@staticmethod
+	def estimate_memory_usage(num_simplices_by_dimension, int num_parameters)->dict:
+		"""Estimates the memory used by a simplextree with `num_simplices_by_dimension[d]` simplices of dimension `d`
+		and `num_parameters` parameters, in bytes, broken down by part as :meth:`memory_usage`. This predicts the
+		memory needed by an :meth:`expansion` before running it, e.g. from the number of simplices of each
+		dimension of the expansion of a sample.
+
+		Parameters
+		----------
+		num_simplices_by_dimension:list[int]
+			The number of simplices of each dimension.
+		num_parameters:int
+			The number of parameters of the filtration.
+
+		Returns
+		-------
+		usage:dict[str, int]
+		"""
+		cdef vector[size_t] counts = num_simplices_by_dimension
+		cdef size_t filtration_value_heap_size = num_parameters * sizeof(value_type)
+		cdef Simplex_tree_multi_memory_usage usage
+		with nogil:
+			usage = estimate_simplex_tree_multi_memory_usage(counts, filtration_value_heap_size)
+		return _memory_usage_dict(usage)
+
 	@property
 	def dimension(self)->int:
 		"""This function returns the dimension of the simplicial complex.
@@ -300,15 +372,14 @@ bool safe_conversion=False,
 			filtration = np.array([-np.inf]*num_parameters, dtype = float)
 		return self.get_ptr().insert(simplex, Finitely_critical_multi_filtration(<python_filtration_type>filtration))
 		
-	@cython.boundscheck(False)
-	@cython.wraparound(False)
-	def insert_batch(self, some_int[:,:] vertex_array, some_float[:,:]  filtrations)->SimplexTreeMulti:
+	def insert_batch(self, vertex_array, filtrations)->SimplexTreeMulti:
 		"""Inserts k-simplices given by a sparse array in a format similar
 		to `torch.sparse <https://pytorch.org/docs/stable/sparse.html>`_.
 		The n-th simplex has vertices `vertex_array[0,n]`, ...,
 		`vertex_array[k,n]` and filtration value `filtrations[n,num_parameters]`.
 		/!\ Only compatible with 1-critical filtrations. If a simplex is repeated, 
 		only one filtration value will be taken into account.
+		The faces of all the simplices are sorted once in C++, and the simplextree is built from them in a single pass.
 
 		:param vertex_array: the k-simplices to insert.
 		:type vertex_array: numpy.array of shape (k+1,n)
@@ -316,25 +387,16 @@ bool safe_conversion=False,
 		:type filtrations: numpy.array of shape (n,num_parameters)
 		"""
 		# TODO : multi-critical
-		# cdef vector[int] vertices = np.unique(vertex_array)
-		cdef Py_ssize_t k = vertex_array.shape[0]
-		cdef Py_ssize_t n = vertex_array.shape[1]
+		vertex_array = np.ascontiguousarray(vertex_array, dtype=np.intc)
+		filtrations = np.ascontiguousarray(filtrations, dtype=np.float32)
+		cdef size_t k = vertex_array.shape[0]
+		cdef size_t n = vertex_array.shape[1]
 		assert filtrations.shape[0] == n, 'inconsistent sizes for vertex_array and filtrations'
 		assert filtrations.shape[1] == self.num_parameters, "wrong number of parameters"
-		cdef Py_ssize_t i
-		cdef Py_ssize_t j
-		cdef vector[int] v
-		cdef Finitely_critical_multi_filtration w
-		cdef int n_parameters = self.num_parameters
+		cdef uintptr_t vertices_ptr = vertex_array.ctypes.data
+		cdef uintptr_t filtrations_ptr = filtrations.ctypes.data
 		with nogil:
-			for i in range(n):
-				for j in range(k):
-					v.push_back(vertex_array[j, i])
-				for j in range(n_parameters):
-					w.push_back(filtrations[i,j])
-				self.get_ptr().insert(v, w)
-				v.clear()
-				w.clear()
+			self.get_ptr().insert_batch(vertices_ptr, k, n, filtrations_ptr)
 		return self
 
 
@@ -434,6 +496,62 @@ bool safe_conversion=False,
 			yield (np.asarray(pair.first, dtype=int),np.asarray(<value_type[:num_parameters]> pair.second))
 			preincrement(it)
 
+	def get_simplices_and_filtrations(self, int max_dimension=-1)->list[tuple[np.ndarray,np.ndarray]]:
+		"""Returns all the simplices of dimension at most `max_dimension` and their filtration values at once, grouped
+		by dimension. This is much faster than :meth:`get_simplices` or :meth:`get_skeleton` on large complexes, as the
+		arrays are filled in C++, without the GIL.
+
+		Parameters
+		----------
+		max_dimension:int
+			Maximal dimension of the simplices, all of them if negative.
+
+		Returns
+		-------
+		A list whose element `d` is a pair of arrays `(vertices, filtrations)` of shapes `(n_d, d+1)` and
+		`(n_d, num_parameters)`, where `n_d` is the number of simplices of dimension `d`. The rows follow the order of
+		:meth:`get_skeleton`, and the vertices of each simplex are increasing.
+		"""
+		cdef vector[size_t] counts
+		with nogil:
+			counts = self.get_ptr().num_simplices_by_dimension(max_dimension)
+		cdef int num_parameters = self.get_ptr().get_number_of_parameters()
+		out = [(np.empty((counts[d], d+1), dtype=np.intc), np.empty((counts[d], num_parameters), dtype=np.float32))
+			for d in range(counts.size())]
+		cdef vector[uintptr_t] vertices = [v.ctypes.data for v,_ in out]
+		cdef vector[uintptr_t] filtrations = [f.ctypes.data for _,f in out]
+		with nogil:
+			self.get_ptr().fill_simplices_and_filtrations(vertices, filtrations)
+		return out
+
+	def boundary_matrix(self)->tuple[np.ndarray,np.ndarray,np.ndarray,np.ndarray]:
+		"""Returns the boundary matrix of the complex in compressed sparse column format, with the simplices in the
+		order of the filtration. The arrays are allocated by NumPy and filled in C++, without the GIL.
+
+		Returns
+		-------
+		The arrays `(indptr, indices, dimensions, filtrations)`, of shapes `(n+1,)`, `(nnz,)`, `(n,)` and
+		`(n, num_parameters)`, where `n` is the number of simplices. The indices of the facets of the `i`-th simplex are
+		`indices[indptr[i]:indptr[i+1]]`, in increasing order, so that
+		:code:`scipy.sparse.csc_matrix((np.ones(len(indices), dtype=np.int8), indices, indptr))` shares their memory.
+		This overwrites the keys of the simplices with their indices in the filtration.
+		"""
+		cdef pair[size_t, size_t] sizes
+		with nogil:
+			sizes = self.get_ptr().boundary_matrix_sizes()
+		cdef int num_parameters = self.get_ptr().get_number_of_parameters()
+		indptr = np.empty(sizes.first + 1, dtype=np.int64)
+		indices = np.empty(sizes.second, dtype=np.int64)
+		dimensions = np.empty(sizes.first, dtype=np.intc)
+		filtrations = np.empty((sizes.first, num_parameters), dtype=np.float32)
+		cdef uintptr_t indptr_ptr = indptr.ctypes.data
+		cdef uintptr_t indices_ptr = indices.ctypes.data
+		cdef uintptr_t dimensions_ptr = dimensions.ctypes.data
+		cdef uintptr_t filtrations_ptr = filtrations.ctypes.data
+		with nogil:
+			self.get_ptr().fill_boundary_matrix(indptr_ptr, indices_ptr, dimensions_ptr, filtrations_ptr)
+		return indptr, indices, dimensions, filtrations
+
 	def get_star(self, simplex):
 		"""This function returns the star of a given N-simplex.
 
@@ -483,6 +601,30 @@ bool safe_conversion=False,
 			ct.append((v, np.asarray(<value_type[:num_parameters]>filtered_simplex.second)))
 		return ct
 
+	def get_cofaces_batch(self, simplices, codimension):
+		"""This function returns the cofaces of several simplices with a given
+		codimension, as :func:`get_cofaces` called on each of them, but in a
+		single query that runs in parallel.
+
+		:param simplices: The simplices, each represented by a list of vertex.
+		:type simplices: list of list of int
+		:param codimension: The codimension. If codimension = 0, all cofaces
+			are returned (equivalent of get_star function)
+		:type codimension: int
+		:returns:  For each simplex, the (simplices of the) cofaces of the
+			simplex, in no particular order. A simplex that is not in the
+			complex has no cofaces.
+		:rtype:  list of list of tuples(simplex, filtration)
+		"""
+		cdef vector[simplex_type] csimplices = simplices
+		cdef int ccodimension = codimension
+		cdef int num_parameters = self.num_parameters
+		cdef vector[vector[simplex_filtration_type]] cofaces
+		with nogil:
+			cofaces = self.get_ptr().get_cofaces_batch(csimplices, ccodimension)
+		return [[(list(filtered_simplex.first), np.asarray(<value_type[:num_parameters]>filtered_simplex.second))
+				for filtered_simplex in simplex_cofaces] for simplex_cofaces in cofaces]
+
 	def get_boundaries(self, simplex):
 		"""This function returns a generator with the boundaries of a given N-simplex.
 		If you do not need the filtration values, the boundary can also be obtained as
@@ -562,8 +704,11 @@ bool safe_conversion=False,
 		attached to a graph :math:`G` is the maximal simplicial complex of
 		dimension at most :math:`d` admitting the graph :math:`G` as
 		:math:`1`-skeleton.
-		The filtration value assigned to a simplex is the maximal filtration
-		value of one of its edges.
+		The filtration value assigned to a simplex is the coordinate-wise maximum
+		of the filtration values of its edges. If the filtration of the graph is
+		not non-decreasing, e.g., an edge with a grade incomparable to the one of
+		a vertex, :meth:`make_filtration_non_decreasing` is applied afterwards,
+		so that the result is always a valid filtration.
 
 		The simplex tree must contain no simplex of dimension bigger than
 		1 when calling the method.
@@ -573,10 +718,78 @@ bool safe_conversion=False,
 		"""
 		with nogil:
 			self.get_ptr().expansion(max_dim)
-			# This is a fix for multipersistence. FIXME expansion in c++
+			# The expansion only pushes the new simplices to the values of their edges
 			self.get_ptr().make_filtration_non_decreasing()
 		return self
 
+	def expansion_with_budget(self, int max_dim, max_num_simplices=None, max_memory=None, bool raise_on_budget=False)->bool:
+		"""Expands the simplex tree containing only its one skeleton until dimension max_dim, like :meth:`expansion`,
+		unless the complex gets larger than a budget, in which case the expansion stops.
+
+		The subtrees of the vertices are expanded one after the other, from the greatest vertex, and the simplices of
+		dimension at least 2 of the subtree which exceeds the budget are removed, so that the simplextree is a
+		simplicial complex within the budget: the graph and the cliques whose vertices are all greater than some
+		vertex. :meth:`estimate_expansion_size` helps choosing the budget beforehand.
+
+		Parameters
+		----------
+		max_dim:int
+			The maximal dimension.
+		max_num_simplices:int
+			The maximal number of simplices of the complex. Default is no limit.
+		max_memory:int
+			The maximal memory of the complex, in bytes, as the `total` of :meth:`memory_usage`. Default is no limit.
+		raise_on_budget:bool
+			Raises a `MemoryError` if the expansion stops, instead of returning False.
+
+		Returns
+		-------
+		complete:bool
+			Whether the expansion is complete.
+		"""
+		cdef Simplex_tree_multi_expansion_budget budget
+		cdef bool complete
+		if max_num_simplices is not None:
+			budget.max_num_simplices = max_num_simplices
+		if max_memory is not None:
+			budget.max_memory = max_memory
+		with nogil:
+			complete = self.get_ptr().expansion_with_budget(max_dim, budget)
+			self.get_ptr().make_filtration_non_decreasing()
+		if not complete and raise_on_budget:
+			raise MemoryError("The expansion exceeds its budget, it was stopped.")
+		return complete
+
+	def estimate_expansion_size(self, int max_dim, size_t num_samples=1000, seed=None)->list:
+		"""Estimates the number of simplices of each dimension of the :meth:`expansion` of the one skeleton of the
+		simplextree, without building it, by sampling its cliques. The numbers of vertices and edges are exact, and the
+		relative error of the others decreases as the inverse of the square root of `num_samples`.
+
+		Parameters
+		----------
+		max_dim:int
+			The maximal dimension.
+		num_samples:int
+			The number of random samples.
+		seed:int
+			The seed of the random number generator. Default is a random seed.
+
+		Returns
+		-------
+		sizes:list[float]
+			The estimated number of simplices of each dimension, up to max_dim.
+		"""
+		cdef unsigned int c_seed
+		cdef vector[double] sizes
+		if seed is None:
+			with nogil:
+				sizes = self.get_ptr().estimate_expansion_size(max_dim, num_samples)
+		else:
+			c_seed = seed
+			with nogil:
+				sizes = self.get_ptr().estimate_expansion_size(max_dim, num_samples, c_seed)
+		return sizes
+
 	def make_filtration_non_decreasing(self)->bool: 
 		"""This function ensures that each simplex has a higher filtration
 		value than its faces by increasing the filtration values.
@@ -713,47 +926,42 @@ bool safe_conversion=False,
 			out = self.get_ptr().get_edge_list()
 		return out
 	
-	def collapse_edges(self, max_dimension:int=None, num:int=1, progress:bool=False, strong:bool=True, full:bool=False, ignore_warning:bool=False)->SimplexTreeMulti:
-		"""Edge collapse for 1-critical 2-parameter clique complex (see https://arxiv.org/abs/2211.05574).
-		It uses the code from the github repository https://github.com/aj-alonso/filtration_domination .
+	def collapse_edges(self, max_dimension:int=None, num:int=1, strong:bool=True, full:bool=False, ignore_warning:bool=False)->SimplexTreeMulti:
+		"""Edge collapse for 1-critical multi-parameter clique complex (see https://arxiv.org/abs/2211.05574).
+		The filtration-domination collapser is in `gudhi/Flag_complex_multi_edge_collapser.h`, and runs without the GIL.
 
 		Parameters
 		----------
 		max_dimension:int
 			Max simplicial dimension of the complex. Unless specified, keeps the same dimension.
 		num:int
-			The number of collapses to do.
+			The maximal number of passes of collapses; stops earlier if a pass does not remove any edge.
 		strong:bool
 			Whether to use strong collapses or standard collapses (slower, but may remove more edges)
 		full:bool
 			Collapses the maximum number of edges if true, i.e., will do (at most) 100 strong collapses and (at most) 100 non-strong collapses afterward.
-		progress:bool
-			If true, shows the progress of the number of collapses.
 
 		WARNING
 		-------
 			- This will destroy all of the k-simplices, with k>=2. Be sure to use this with a clique complex, if you want to preserve the homology >= dimension 1.
-			- This is for 1 critical simplices, with 2 parameter persistence.
+			- This is for 1 critical simplices.
+			- Non-strong collapses test a number of grades exponential in the number of parameters, and keep the edges having too many of them.
 		Returns
 		-------
 		self:SimplexTreeMulti
-			A (smaller) simplex tree that has the same homology over this bifiltration.
+			A (smaller) simplex tree that has the same homology over this multifiltration.
 
 		"""
-		# TODO : find a way to do multiple edge collapses without python conversions.
 		if num <= 0:
 			return self
-		assert self.num_parameters == 2, "Number of parameters has to be 2 to use edge collapses ! This is a limitation of Filtration-domination"
 		if self.dimension > 1 and not ignore_warning: warn("This method ignores simplices of dimension > 1 !")
 		
-		max_dimension = self.dimension if max_dimension is None else max_dimension
-
-		# Retrieves the edge list, and send it to filration_domination
-		edges = self.get_edge_list()
-		from gudhi.multiparameter_edge_collapse import _collapse_edge_list
-		edges = _collapse_edge_list(edges, num=num, full=full, strong=strong, progress=progress)
-		# Retrieves the collapsed simplicial complex
-		self._reconstruct_from_edge_list(edges, swap=True, expand_dimension=max_dimension)
+		cdef int c_max_dimension = self.dimension if max_dimension is None else max_dimension
+		cdef int c_num = num
+		cdef bool c_strong = strong
+		cdef bool c_full = full
+		with nogil:
+			self.get_ptr().collapse_edges(c_max_dimension, c_num, c_strong, c_full)
 		return self
 	def _reconstruct_from_edge_list(self, edges, swap:bool=True, expand_dimension:int=None)->SimplexTreeMulti:
 		"""
@@ -805,7 +1013,7 @@ bool safe_conversion=False,
 		return
 	
 	
-	def to_scc(self, path="scc_dataset.txt", progress:bool=True, overwrite:bool=False, ignore_last_generators:bool=True, strip_comments:bool=False, reverse_block:bool=True, rivet_compatible=False)->None:
+	def to_scc(self, path="scc_dataset.txt", progress:bool=True, overwrite:bool=False, ignore_last_generators:bool=True, strip_comments:bool=False, reverse_block:bool=True, rivet_compatible=False, binary:bool=False)->None:
 		""" Create a file with the scc2020 standard, representing the n-filtration of the simplextree.
 		Link : https://bitbucket.org/mkerber/chain_complex_format/src/master/
 
@@ -816,7 +1024,7 @@ bool safe_conversion=False,
 		ignore_last_generators:bool = True
 			If false, will include the filtration values of the last free persistence module.
 		progress:bool = True
-			Shows the progress bar.
+			Unused, kept for compatibility. The file is written in C++, without the GIL.
 		overwrite:bool = False
 			If true, will overwrite the previous file if it already exists.
 		ignore_last_generators:bool=True
@@ -825,72 +1033,71 @@ bool safe_conversion=False,
 			Some obscure programs reverse the inside-block order.
 		rivet_compatible:bool=False
 			Returns a firep (old scc2020) format instead. Only Rivet uses this.
+		binary:bool=False
+			Writes a binary variant of the format instead, see `write_scc` in `Simplex_tree_multi_scc.h`.
 
 		Returns
 		-------
 		Nothing
 		"""
-		### initialize keys
-		self.set_keys_to_enumerate()
-		### File 
 		from os.path import exists
-		from os import remove
-		if exists(path):
-			if not(overwrite):
-				raise Exception(f"The file {path} already exists. Use the `overwrite` flag if you want to overwrite.")
-			remove(path)
-		file = open(path, "a")
-		file.write("scc2020\n") if not rivet_compatible else file.write("firep\n")
-		if not strip_comments and not rivet_compatible: file.write("# Number of parameters\n")
-		num_parameters = self.get_ptr().get_number_of_parameters()
-		if rivet_compatible:
-			assert num_parameters == 2
-			file.write("Filtration 1\n")
-			file.write("Filtration 2\n")
-		else:
-			file.write(f"{num_parameters}\n") 
-		if not strip_comments: file.write("# Sizes of generating sets\n")
-		## WRITES TSR VARIABLES
-		tsr:list= [0]*(self.dimension+1) # dimension --- 0
-		for splx,f in self.get_simplices():
-			dim = len(splx)-1
-			tsr[dim] += (int)(len(f) // num_parameters)
-		tsr.reverse()
-		file.write(" ".join([str(n) for n in tsr])+"\n")
-
-		## Adds the boundaries to the dictionnary + tsr
-		dict_splx_to_firep_number = {}
-		tsr:list = [[] for _ in range(len(tsr))] # tsr stores simplices vertices, according to dimension, and the dictionnary
-		for dim in range(self.dimension,-1 , -1): # range(2,-1,-1):
-			for splx,F in self.get_skeleton(dim):
-				if len(splx) != dim+1:	continue
-				for b,_ in self.get_boundaries(splx):
-					if not self.key(b) in dict_splx_to_firep_number:
-						dict_splx_to_firep_number[self.key(b)] = len(tsr[dim-1])
-						tsr[dim-1].append(b)
-		
-		## Adds simplices that are not borders to tsr, i.e., simplices not in the dictionnary 
-		for splx,_ in self.get_simplices():
-			if not self.key(splx) in dict_splx_to_firep_number:
-				tsr[len(splx)-1].append(splx)
-		## Writes simplices of tsr to file
-		dim_range = range(self.dimension,0,-1) if ignore_last_generators else range(self.dimension,-1,-1)
-		for dim in dim_range: # writes block by block
-			if not strip_comments: file.write(f"# Block of dimension {dim}\n")
-			if reverse_block:	tsr[dim].reverse()
-			for splx in tsr[dim]: # for simplices of dimension
-				F = np.concatenate(self.filtration(splx), axis=0)
-				nbirth = (int)(len(F)//num_parameters)
-				for i in range(nbirth):
-					simplex_filtration = F[i*num_parameters:(i+1)*num_parameters]
-					file.write(" ".join([str(f) for f in simplex_filtration]))
-					file.write(" ;")
-					for b,_ in self.get_boundaries(splx):
-						file.write(f" {dict_splx_to_firep_number[self.key(b)]}")
-					file.write("\n")
-		file.close()
+		if exists(path) and not(overwrite):
+			raise Exception(f"The file {path} already exists. Use the `overwrite` flag if you want to overwrite.")
+		cdef string c_path = str(path).encode()
+		cdef bool c_ignore_last_generators = ignore_last_generators
+		cdef bool c_strip_comments = strip_comments
+		cdef bool c_reverse_block = reverse_block
+		cdef bool c_rivet_compatible = rivet_compatible
+		cdef bool c_binary = binary
+		with nogil:
+			self.get_ptr().to_scc(c_path, c_ignore_last_generators, c_strip_comments, c_reverse_block, c_rivet_compatible, c_binary)
 		return
 	
+	@staticmethod
+	def from_scc(path, reverse_block:bool=True)->SimplexTreeMulti:
+		""" Builds a SimplexTreeMulti from a simplicial scc2020 (or firep) file, e.g., written by :meth:`to_scc`.
+		The file is parsed in C++, without the GIL.
+
+		Parameters
+		----------
+		path:str
+			path of the file.
+		reverse_block:bool=True
+			Has to be the `reverse_block` argument used to write the file.
+
+		Returns
+		-------
+		The SimplexTreeMulti. Its vertices are the indices of the block of dimension 0 of the file.
+		"""
+		st = SimplexTreeMulti()
+		cdef string c_path = str(path).encode()
+		cdef bool c_reverse_block = reverse_block
+		cdef intptr_t ptr = st.thisptr
+		with nogil:
+			(<Simplex_tree_multi_interface*>ptr).from_scc(c_path, c_reverse_block)
+		return st
+
+	@staticmethod
+	def from_rivet(path)->SimplexTreeMulti:
+		""" Builds a SimplexTreeMulti from a Rivet bifiltration file, e.g., written by :meth:`to_rivet`.
+		The file is parsed in C++, without the GIL.
+
+		Parameters
+		----------
+		path:str
+			path of the file.
+
+		Returns
+		-------
+		The SimplexTreeMulti, with 2 parameters.
+		"""
+		st = SimplexTreeMulti(num_parameters=2)
+		cdef string c_path = str(path).encode()
+		cdef intptr_t ptr = st.thisptr
+		with nogil:
+			(<Simplex_tree_multi_interface*>ptr).from_rivet(c_path)
+		return st
+
 	def to_rivet(self, path="rivet_dataset.txt", degree:int|None = None, progress:bool=False, overwrite:bool=False, xbins:int|None=None, ybins:int|None=None)->None:
 		""" Create a file that can be imported by rivet, representing the filtration of the simplextree.
 
@@ -1015,28 +1222,51 @@ bool safe_conversion=False,
 			box=None : pair[list[float]]
 				Grid bounds. format : [low bound, high bound]
 				If None is given, will use the filtration bounds of the simplextree.
-			grid_strategy="regular" : string
-				Either "regular", "quantile", or "exact".
+			drop_quantiles=0 : float or pair of floats
+				The values below the quantile `drop_quantiles[0]` and above the quantile `1 - drop_quantiles[1]` of the
+				distinct values are removed before computing the grid.
+			grid_strategy="exact" : string
+				Either "exact" (all the distinct values), "regular", "regular_closest", "quantile" or "partition".
+				The grid is computed in C++, from the sorted distinct finite values of each parameter.
 		Returns
 		-------
 			List of filtration values, for each parameter, defining the grid.
 		"""
 		if degrees is None:
 			degrees = range(self.dimension+1)
-		
-
-		## preprocesses the filtration values:
-		filtrations_values = np.concatenate(self._get_filtration_values(degrees, inf_to_nan=True), axis=1)
-		# removes duplicate + sort (nan at the end)
-		filtrations_values = [np.unique(filtration) for filtration in filtrations_values]
-		# removes nan
-		filtrations_values = [filtration[:-1] if np.isnan(filtration[-1]) else filtration for filtration in filtrations_values]
-		
-		return self._reduce_grid(filtrations_values=filtrations_values, resolutions=resolution,strategy=grid_strategy,drop_quantiles=drop_quantiles)
+		if grid_strategy == "precomputed":
+			grid_strategy = "exact"
+		if grid_strategy not in ["exact", "regular", "regular_closest", "quantile", "partition"]:
+			raise Exception("Invalid strategy. Pick either regular, regular_closest, partition, quantile, precomputed or exact.")
+		num_parameters = self.get_ptr().get_number_of_parameters()
+		if resolution is None and grid_strategy != "exact":
+			raise ValueError("Resolutions must be provided for this strategy.")
+		if resolution is None:
+			resolution = []
+		else:
+			try:
+				resolution = [int(resolution)]*num_parameters
+			except TypeError:
+				pass
+		try:
+			a,b=drop_quantiles
+		except TypeError:
+			a,b=drop_quantiles,drop_quantiles
+		cdef intptr_t ptr = self.thisptr
+		cdef vector[int] c_degrees = degrees
+		cdef string c_strategy = grid_strategy.encode()
+		cdef vector[int] c_resolutions = resolution
+		cdef double c_low = a
+		cdef double c_high = b
+		cdef vector[vector[value_type]] grid
+		## the values are collected, sorted and reduced in C++, one parameter at a time.
+		with nogil:
+			grid = compute_filtration_grid(ptr, c_degrees, c_strategy, c_resolutions, c_low, c_high)
+		return [np.asarray(f) for f in grid]
 	
 	
 
-	def grid_squeeze(self, filtration_grid:np.ndarray|list|None=None, bool coordinate_values=True, force=False, **filtration_grid_kwargs)->SimplexTreeMulti:
+	def grid_squeeze(self, filtration_grid:np.ndarray|list|None=None, bool coordinate_values=True, force=False, coordinate_dtype=None, **filtration_grid_kwargs)->SimplexTreeMulti|SimplexTreeMultiSqueezed:
 		"""
 		Fit the filtration of the simplextree to a grid.
 		
@@ -1044,11 +1274,16 @@ bool safe_conversion=False,
 		:type filtration_grid: list[list[float]]
 		:param coordinate_values: If true, the filtrations values of the simplices will be set to the coordinate of the filtration grid.
 		:type coordinate_values: bool
+		:param coordinate_dtype: If `np.int16` or `np.int32`, self is left untouched, and a :class:`SimplexTreeMultiSqueezed`
+			storing the coordinates with this integer type (and the grid once) is returned instead.
+		:type coordinate_dtype: None or numpy integer dtype
 		"""
 		if not force and self._is_squeezed:
 			raise Exception("SimplexTree already squeezed, use `force=True` if that's really what you want to do.") 
 		#TODO : multi-critical
 		if filtration_grid is None:	filtration_grid = self.get_filtration_grid(**filtration_grid_kwargs)
+		if coordinate_dtype is not None:
+			return SimplexTreeMultiSqueezed(self, filtration_grid, dtype=coordinate_dtype)
 		cdef vector[vector[value_type]] c_filtration_grid = filtration_grid
 		cdef intptr_t ptr = self.thisptr
 		if coordinate_values:
@@ -1064,16 +1299,57 @@ bool safe_conversion=False,
 	def filtration_bounds(self, degrees:Iterable[int]|None=None, q:float|tuple=0, split_dimension:bool=False)->np.ndarray:
 		"""
 		Returns the filtrations bounds of the finite filtration values.
+
+		The bounds are the (approximate) quantiles `q[0]` and `1-q[1]` of the finite values of each parameter, computed
+		in a single pass over the simplices, cf. :meth:`filtration_statistics`. If `split_dimension` is true, the
+		bounds are given for each degree.
 		"""
 		try:
 			a,b =q
-		except:
+		except TypeError:
 			a,b,=q,q
 		degrees = range(self.dimension+1) if degrees is None else degrees
-		filtrations_values = self._get_filtration_values(degrees, inf_to_nan=True) ## degree, parameter, pt
-		boxes = np.array([np.nanquantile(filtration, [a, 1-b], axis=1) for filtration in filtrations_values],dtype=float)
-		if split_dimension: return boxes
-		return np.asarray([np.nanmin(boxes, axis=(0,1)), np.nanmax(boxes, axis=(0,1))]) # box, birth/death, filtration
+		if split_dimension:
+			return np.asarray([self._filtration_bounds([degree], a, b) for degree in degrees])
+		return self._filtration_bounds(degrees, a, b)
+
+	def _filtration_bounds(self, degrees, double a, double b)->np.ndarray:
+		cdef intptr_t ptr = self.thisptr
+		cdef vector[int] c_degrees = degrees
+		cdef Filtration_statistics[value_type] statistics
+		with nogil:
+			statistics = compute_filtration_statistics(ptr, c_degrees)
+		return np.asarray([[statistics.quantile(parameter, a) for parameter in range(statistics.num_parameters())],
+			[statistics.quantile(parameter, 1-b) for parameter in range(statistics.num_parameters())]], dtype=float)
+
+	def filtration_statistics(self, degrees:Iterable[int]|None=None, quantiles:Iterable[float]=())->dict:
+		"""
+		Statistics of the filtration values of the simplices of the given degrees (all of them by default), computed
+		in a single parallel pass over the simplices, without copying the filtration values.
+
+		:param quantiles: Quantiles of the finite values of each parameter to compute. They are approximated with a
+			precision of about 3% of the values, except for the quantiles 0 and 1 which are the exact bounds.
+		:returns: A dictionary with the number of simplices `"num_simplices_per_dimension"`, and for each parameter
+			the bounds of the finite values `"min"` and `"max"`, the number of finite, infinite and NaN values
+			`"num_finite"`, `"num_plus_infinite"`, `"num_minus_infinite"`, `"num_nan"`, and the `"quantiles"`, of
+			shape (number of quantiles, number of parameters).
+		"""
+		cdef intptr_t ptr = self.thisptr
+		cdef vector[int] c_degrees = [] if degrees is None else degrees
+		cdef Filtration_statistics[value_type] statistics
+		with nogil:
+			statistics = compute_filtration_statistics(ptr, c_degrees)
+		parameters = range(statistics.num_parameters())
+		return {
+			"num_simplices_per_dimension": np.asarray(statistics.num_simplices_per_dimension(), dtype=np.int64),
+			"min": np.asarray([statistics.min(p) for p in parameters]),
+			"max": np.asarray([statistics.max(p) for p in parameters]),
+			"num_finite": np.asarray([statistics.num_finite(p) for p in parameters], dtype=np.int64),
+			"num_plus_infinite": np.asarray([statistics.num_plus_infinite(p) for p in parameters], dtype=np.int64),
+			"num_minus_infinite": np.asarray([statistics.num_minus_infinite(p) for p in parameters], dtype=np.int64),
+			"num_nan": np.asarray([statistics.num_nan(p) for p in parameters], dtype=np.int64),
+			"quantiles": np.asarray([[statistics.quantile(p, q) for p in parameters] for q in quantiles], dtype=float).reshape(-1, len(parameters)),
+		}
 
 
 	
@@ -1100,8 +1376,117 @@ bool safe_conversion=False,
 			self.get_ptr().fill_lowerstar(c_F, c_parameter)
 		return self
 
+	def fill_lowerstars(self, Fs, parameters:Iterable[int])->dict:
+		""" Fills several filtration parameters at once, by the lower-star filtrations defined by the rows of Fs.
+		The simplextree is walked once, and the subtrees of the vertices are filled in parallel.
+
+		Parameters
+		----------
+		Fs:2d array of shape (len(parameters), num_vertices)
+			The functions over the vertices, that induce the lower-star filtrations.
+		parameters:Iterable[int]
+			Which filtration parameter to fill with each row of Fs.
+
+		Returns
+		-------
+		Counters of the fill : its time in seconds (`seconds`), and its numbers of simplices (`num_simplices`),
+		of filled parameters (`num_axes`) and of independent subtrees (`num_tasks`).
+		"""
+		cdef vector[vector[value_type]] c_Fs = np.asarray(Fs, dtype=np.float32).reshape(len(parameters), -1)
+		cdef vector[int] c_parameters = parameters
+		cdef Lowerstar_timings timings
+		with nogil:
+			timings = self.get_ptr().fill_lowerstars(c_Fs, c_parameters)
+		return timings
+
+
+	def filtration_table(self)->np.ndarray:
+		"""Returns the filtration values of all simplices at once, as a `(num_parameters, num_simplices)` array.
+
+		Column `k` is the filtration of the simplex of key `k` (see :meth:`get_key`); keys are reset by this method,
+		such that faces have smaller keys than their cofaces. Each parameter is a contiguous row.
+
+		The returned array is a view on a new table, which it keeps alive: it remains valid after the next call of
+		this method, of :meth:`clear_filtration_table`, or the deletion of the simplextree. Modifications of the
+		table of the last call, e.g. by :meth:`fill_lowerstar_table` and :meth:`grid_squeeze_table`, are applied by
+		:meth:`commit_filtration_table`.
+
+		Returns
+		-------
+		table:np.ndarray of shape (num_parameters, num_simplices)
+		"""
+		cdef shared_ptr[Filtration_table] table
+		with nogil:
+			table = self.get_ptr().build_filtration_table()
+		self._table_filtration_grid = None
+		owner = _Filtration_table_owner()
+		owner.table = table
+		return _filtration_table_view(table.get(), owner)
+
+	def fill_lowerstar_table(self, F, int parameter)->SimplexTreeMulti:
+		"""Same as :meth:`fill_lowerstar`, on the table of the last call of :meth:`filtration_table` : a single
+		pass writes one contiguous row of the table.
+
+		Returns
+		-------
+		self:SimplexTreeMulti
+		"""
+		cdef vector[value_type] c_F = np.asarray(F, dtype=np.float32)
+		with nogil:
+			self.get_ptr().fill_lowerstar_table(c_F, parameter)
+		return self
+
+	def grid_squeeze_table(self, filtration_grid:np.ndarray|list, bool coordinate_values=True)->SimplexTreeMulti:
+		"""Same as :meth:`grid_squeeze`, on the table of the last call of :meth:`filtration_table`, one contiguous
+		row at a time. The grid is recorded by :meth:`commit_filtration_table`.
+
+		Returns
+		-------
+		self:SimplexTreeMulti
+		"""
+		cdef vector[vector[value_type]] c_filtration_grid = filtration_grid
+		with nogil:
+			self.get_ptr().squeeze_filtration_table(c_filtration_grid, coordinate_values)
+		if coordinate_values:
+			self._table_filtration_grid = c_filtration_grid
+		return self
+
+	def commit_filtration_table(self)->SimplexTreeMulti:
+		"""Writes the table returned by the last call of :meth:`filtration_table` back into the simplextree.
+
+		Returns
+		-------
+		self:SimplexTreeMulti
+		"""
+		with nogil:
+			self.get_ptr().commit_filtration_table()
+		if self._table_filtration_grid is not None:
+			self.filtration_grid = self._table_filtration_grid
+		return self
+
+	def clear_filtration_table(self)->SimplexTreeMulti:
+		"""Releases the table of the last call of :meth:`filtration_table`. It is freed with the last view on it.
+		"""
+		with nogil:
+			self.get_ptr().clear_filtration_table()
+		self._table_filtration_grid = None
+		return self
+
+	def filtration_variant(self)->SimplexTreeMultiVariant:
+		"""Returns a copy of the filtration values of this simplextree, sharing its structure.
+
+		Only the filtration values are copied, in a table of `num_parameters * num_simplices` values, so that many
+		variants of a large simplextree, e.g. with different lower-star functions or grids, cost much less memory than
+		as many calls of :meth:`copy`. The structure of this simplextree should not be modified while its variants
+		are used; its filtration values can.
 
-	def project_on_line(self, parameter:int=0, basepoint:None|list|np.ndarray= None)->SimplexTree:
+		Returns
+		-------
+		variant:SimplexTreeMultiVariant
+		"""
+		return SimplexTreeMultiVariant(self)
+
+	def project_on_line(self, parameter:int=0, basepoint:None|list|np.ndarray= None, box:None|list|np.ndarray=None)->SimplexTree:
 		"""Converts an multi simplextree to a gudhi simplextree.
 		Parameters
 		----------
@@ -1109,6 +1494,11 @@ bool safe_conversion=False,
 				The parameter to keep. WARNING will crash if the multi simplextree is not well filled.
 			basepoint:None
 				Instead of keeping a single parameter, will consider the filtration defined by the diagonal line crossing the basepoint.
+			box:None
+				Array of shape (2, num_parameters), the bottom and upper corners of a box. If given, only the simplices
+				whose filtration value is smaller than the upper corner are kept, and their filtration values are
+				clamped to the bottom corner. The simplices out of the box are skipped with their cofaces, without being
+				visited, so that the filtration has to be non-decreasing, cf. :meth:`make_filtration_non_decreasing`.
 		WARNING 
 		-------
 			There are no safeguard yet, it WILL crash if asking for a parameter that is not filled.
@@ -1124,6 +1514,17 @@ bool safe_conversion=False,
 		cdef intptr_t old_ptr = self.thisptr
 		cdef intptr_t new_ptr = new_simplextree.thisptr
 		cdef vector[value_type] c_basepoint = [] if basepoint is None else basepoint
+		cdef vector[value_type] c_bottom
+		cdef vector[value_type] c_upper
+		if box is not None:
+			c_bottom, c_upper = box
+			if basepoint is None:
+				with nogil:
+					flatten_in_box_from_ptr(old_ptr, new_ptr, c_bottom, c_upper, c_parameter)
+			else:
+				with nogil:
+					flatten_diag_in_box_from_ptr(old_ptr, new_ptr, c_bottom, c_upper, c_basepoint, c_parameter)
+			return new_simplextree
 		if basepoint is None:
 			with nogil:
 				flatten_from_ptr(old_ptr, new_ptr, c_parameter)
@@ -1132,13 +1533,15 @@ bool safe_conversion=False,
 				flatten_diag_from_ptr(old_ptr, new_ptr, c_basepoint, c_parameter)
 		return new_simplextree
 
-	def linear_projections(self, linear_forms:np.ndarray)->Iterable[SimplexTree]:
+	def linear_projections(self, linear_forms:np.ndarray, box:None|list|np.ndarray=None)->Iterable[SimplexTree]:
 		"""
 		Compute the 1-parameter projections, w.r.t. given the linear forms, of this simplextree.
 
 		Input
 		-----
 		 - Array of shape (num_linear_forms, num_parameters)
+		 - box : if given, array of shape (2, num_parameters). Only the part of the filtration in this box is
+		   projected, cf. :meth:`project_on_line`.
 		
 		Output
 		------
@@ -1150,10 +1553,23 @@ bool safe_conversion=False,
 		cdef vector[vector[value_type]] c_linear_forms = linear_forms
 		assert num_parameters==self.num_parameters, f"The linear forms has to have the same number of parameter as the simplextree ({self.num_parameters})."
 		
-		# Gudhi copies are faster than inserting simplices one by one
 		import gudhi as gd
-		flattened_simplextree = gd.SimplexTree()
 		cdef intptr_t multi_prt = self.thisptr
+		cdef vector[value_type] c_bottom
+		cdef vector[value_type] c_upper
+		cdef vector[intptr_t] c_out_ptrs
+		if box is not None:
+			# Only the simplices in the box are visited and inserted, for each projection
+			c_bottom, c_upper = box
+			out = [gd.SimplexTree() for _ in range(num_projections)]
+			c_out_ptrs = [st.thisptr for st in out]
+			with nogil:
+				for i in range(num_projections):
+					linear_projection_in_box_from_ptr(c_out_ptrs[i], multi_prt, c_bottom, c_upper, c_linear_forms[i])
+			return out
+
+		# Gudhi copies are faster than inserting simplices one by one
+		flattened_simplextree = gd.SimplexTree()
 		cdef intptr_t flattened_ptr = flattened_simplextree.thisptr
 		with nogil:
 			flatten_from_ptr(multi_prt, flattened_ptr, num_parameters)
@@ -1166,6 +1582,124 @@ bool safe_conversion=False,
 				linear_projection_from_ptr(out_ptrs[i], multi_prt, c_linear_forms[i])
 		return out
 
+	def sliced_barcodes(self, basepoints:np.ndarray, directions:np.ndarray|None=None, degrees:Iterable[int]=[0,1], coefficient_field:int=11, min_persistence:float=0., vineyard:bool=False):
+		"""
+		Computes the barcodes of the 1-parameter filtrations given by the restriction of this filtration to many lines.
+		The simplextree is walked once, and the lines are processed in parallel, without building a `SimplexTree` per line.
+
+		Input
+		-----
+		 - basepoints : array of shape (num_lines, num_parameters)
+		 - directions : array of shape (num_lines, num_parameters), with positive coordinates. Diagonal lines if None.
+		 - degrees : homological degrees to compute
+		 - coefficient_field : prime number of the field of coefficients
+		 - min_persistence : bars of length smaller or equal to this are discarded
+		 - vineyard : if True, the lines are processed in the given order, and persistence is updated from one line to the next
+		   by transpositions (vineyards) instead of being recomputed. Faster for sweeps of close lines. Coefficients are then in Z/2Z.
+		
+		Output
+		------
+		 - List (over lines) of list (over degrees) of barcodes, as arrays of shape (num_bars, 2).
+		 A value t of a bar of the line (b,d) stands for the point b + t*d.
+		"""
+		# FIXME : deal with multicritical filtrations
+		cdef vector[vector[value_type]] c_basepoints = np.asarray(basepoints, dtype=np.float32)
+		cdef vector[vector[value_type]] c_directions = [] if directions is None else np.asarray(directions, dtype=np.float32)
+		cdef vector[int] c_degrees = degrees
+		cdef int c_coefficient_field = coefficient_field
+		cdef double c_min_persistence = min_persistence
+		cdef bool c_vineyard = vineyard
+		assert c_basepoints.size() == 0 or c_basepoints[0].size() == self.num_parameters, f"The basepoints has to have the same number of parameter as the simplextree ({self.num_parameters})."
+		cdef vector[vector[vector[pair[double, double]]]] out
+		with nogil:
+			out = self.get_ptr().sliced_barcodes(c_basepoints, c_directions, c_degrees, c_coefficient_field, c_min_persistence, c_vineyard)
+		return [[np.asarray(barcode, dtype=np.float64).reshape(-1,2) for barcode in line_barcodes] for line_barcodes in out]
+
+	def hilbert_function(self, degrees:Iterable[int]=[0,1], grid_shape:Iterable[int]|None=None)->np.ndarray:
+		"""
+		Computes the Hilbert function of this filtration on its grid, i.e., the dimension of the homology of the
+		subcomplex of the simplices whose filtration values are smaller or equal to each point of the grid.
+		The simplextree has to be squeezed on a grid with coordinate values, cf. :meth:`grid_squeeze`.
+		The grid is cut in lines along the last parameter, processed in parallel by blocks, and persistence is updated
+		from one line to the next with vineyards. Coefficients are in Z/2Z.
+
+		Input
+		-----
+		 - degrees : homological degrees to compute
+		 - grid_shape : number of values of the grid for each parameter. Defaults to the shape of `filtration_grid`.
+
+		Output
+		------
+		 - Array of shape (len(degrees), *grid_shape), of int32.
+		"""
+		if grid_shape is None:
+			assert self._is_squeezed, "The simplextree has to be squeezed with coordinate values, cf. grid_squeeze, or grid_shape has to be given."
+			grid_shape = [len(f) for f in self.filtration_grid]
+		cdef vector[size_t] c_grid_shape = grid_shape
+		cdef vector[int] c_degrees = degrees
+		cdef vector[int32_t] out
+		with nogil:
+			out = self.get_ptr().hilbert_function(c_grid_shape, c_degrees)
+		return np.asarray(out, dtype=np.int32).reshape(len(c_degrees), *c_grid_shape)
+
+
+	def hilbert_signed_measure(self, degrees:Iterable[int]=[0,1], grid_shape:Iterable[int]|None=None)->list[tuple[np.ndarray, np.ndarray]]:
+		"""
+		Computes the signed measure of the Hilbert function, i.e., its Möbius inversion on the grid, cf.
+		:meth:`hilbert_function`. The inversion is done in C++, in place, and only the points with a non-zero weight
+		are returned, so that no dense tensor is copied to Python.
+
+		Input
+		-----
+		 - degrees : homological degrees to compute
+		 - grid_shape : number of values of the grid for each parameter. Defaults to the shape of `filtration_grid`.
+
+		Output
+		------
+		 - For each degree, the pair (coordinates, weights) of the measure: an int32 array of shape (num_points,
+		   num_parameters) of grid coordinates, and an int32 array of shape (num_points,).
+		"""
+		if grid_shape is None:
+			assert self._is_squeezed, "The simplextree has to be squeezed with coordinate values, cf. grid_squeeze, or grid_shape has to be given."
+			grid_shape = [len(f) for f in self.filtration_grid]
+		cdef vector[size_t] c_grid_shape = grid_shape
+		cdef vector[int] c_degrees = degrees
+		cdef vector[int32_t] coordinates
+		cdef vector[int32_t] weights
+		with nogil:
+			self.get_ptr().hilbert_signed_measure(c_grid_shape, c_degrees, coordinates, weights)
+		return _split_signed_measure(coordinates, weights, c_degrees.size(), c_grid_shape.size())
+
+
+	def minimal_presentation(self, degree:int)->tuple[np.ndarray, np.ndarray, list[np.ndarray]]:
+		"""
+		Computes a minimal presentation of the homology in degree `degree` of this 2-parameter filtration, with
+		coefficients in Z/2Z, directly from the boundary matrices (Lesnick and Wright's algorithm). This is much smaller
+		than the chain complex exported by :meth:`to_scc`. The filtration does not have to be squeezed, but squeezing
+		it first, cf. :meth:`grid_squeeze`, makes it faster. Simplices with an infinite filtration value are ignored.
+		WARNING : this overwrites the keys of the simplices.
+
+		Input
+		-----
+		 - degree : homological degree
+
+		Output
+		------
+		 - generator_grades : array of shape (num_generators, 2), the filtration values of the generators,
+		 - relation_grades : array of shape (num_relations, 2), the filtration values of the relations,
+		 - relations : list of num_relations int arrays, the generators of each relation.
+		"""
+		cdef vector[value_type] c_generator_grades
+		cdef vector[value_type] c_relation_grades
+		cdef vector[vector[size_t]] c_relations
+		cdef int c_degree = degree
+		with nogil:
+			self.get_ptr().minimal_presentation(c_degree, c_generator_grades, c_relation_grades, c_relations)
+		generator_grades = np.asarray(c_generator_grades, dtype=np.float32).reshape(-1, 2)
+		relation_grades = np.asarray(c_relation_grades, dtype=np.float32).reshape(-1, 2)
+		relations = [np.asarray(relation, dtype=np.int64) for relation in c_relations]
+		return generator_grades, relation_grades, relations
+
 
 	def set_num_parameter(self, num:int):
 		"""
@@ -1182,11 +1716,260 @@ bool safe_conversion=False,
 		:rtype: bool
 		"""
 		return dereference(self.get_ptr()) == dereference(other.get_ptr())
-	
+
+	def __getstate__(self):
+		""":returns: Serialized (or flattened) SimplexTreeMulti data structure, its number of parameters and its
+			filtration grid, in order to pickle SimplexTreeMulti.
+		:rtype: tuple of a numpy.array of shape (n,), an int and a list of lists of floats
+		"""
+		cdef size_t buffer_size = self.get_ptr().get_serialization_size()
+		# Let's use numpy to allocate a buffer. Will be deleted automatically
+		np_buffer = np.empty(buffer_size, dtype='B')
+		cdef char[:] buffer = np_buffer
+		cdef char* buffer_start = &buffer[0]
+		with nogil:
+			self.get_ptr().serialize(buffer_start, buffer_size)
+		return np_buffer, self.num_parameters, self.filtration_grid
+
+	def __setstate__(self, state):
+		"""Construct the SimplexTreeMulti data structure from the output of
+		:func:`~gudhi.SimplexTreeMulti.__getstate__` in order to unpickle a SimplexTreeMulti.
+
+		:param state: Serialized SimplexTreeMulti data structure, number of parameters and filtration grid
+		:type state: tuple of a numpy.array of shape (n,), an int and a list of lists of floats
+		"""
+		np_buffer, num_parameters, filtration_grid = state
+		cdef char[:] buffer = np_buffer
+		cdef size_t buffer_size = np_buffer.shape[0]
+		cdef char* buffer_start = &buffer[0]
+		# Delete pointer, just in case, as deserialization requires an empty SimplexTreeMulti
+		cdef Simplex_tree_multi_interface* ptr = self.get_ptr()
+		del ptr
+		self.thisptr = <intptr_t>(new Simplex_tree_multi_interface())
+		with nogil:
+			# New pointer is a deserialized simplex tree
+			self.get_ptr().deserialize(buffer_start, buffer_size)
+		self.get_ptr().set_number_of_parameters(num_parameters)
+		self.filtration_grid = filtration_grid
+
 cdef intptr_t _get_copy_intptr(SimplexTreeMulti stree) nogil:
 	return <intptr_t>(new Simplex_tree_multi_interface(dereference(stree.get_ptr())))
 
 
+cdef class SimplexTreeMultiSqueezed:
+	"""A :class:`SimplexTreeMulti` squeezed on a grid. The filtration values are stored as integer coordinates
+	(`np.int16` or `np.int32`) in the grid, which is stored once in the tree.
+
+	It is usually built with :meth:`SimplexTreeMulti.grid_squeeze` and `coordinate_dtype`,
+	and :meth:`unsqueeze` recovers a :class:`SimplexTreeMulti`.
+	"""
+	cdef public intptr_t thisptr
+	cdef bint _int16
+
+	cdef Simplex_tree_multi_squeezed_int32_interface* get_ptr32(self) nogil:
+		return <Simplex_tree_multi_squeezed_int32_interface*>(self.thisptr)
+	cdef Simplex_tree_multi_squeezed_int16_interface* get_ptr16(self) nogil:
+		return <Simplex_tree_multi_squeezed_int16_interface*>(self.thisptr)
+
+	def __cinit__(self, SimplexTreeMulti other=None, filtration_grid=None, dtype=np.int32):
+		"""
+		:param other: The simplextree to squeeze. If `None`, an empty tree is created.
+		:param filtration_grid: The grid on which to squeeze `other`, one sorted array per parameter.
+		:param dtype: `np.int16` or `np.int32`, the type of the coordinates.
+		"""
+		cdef vector[vector[value_type]] c_filtration_grid
+		cdef uintptr_t other_ptr
+		if np.dtype(dtype) == np.int16:
+			self._int16 = True
+			self.thisptr = <intptr_t>(new Simplex_tree_multi_squeezed_int16_interface())
+		elif np.dtype(dtype) == np.int32:
+			self._int16 = False
+			self.thisptr = <intptr_t>(new Simplex_tree_multi_squeezed_int32_interface())
+		else:
+			raise ValueError(f"Coordinates have to be np.int16 or np.int32, got {dtype}.")
+		if other is None:
+			return
+		if filtration_grid is None:
+			filtration_grid = other.get_filtration_grid()
+		c_filtration_grid = filtration_grid
+		other_ptr = other.thisptr
+		with nogil:
+			if self._int16:
+				self.get_ptr16().squeeze_from_ptr(other_ptr, c_filtration_grid)
+			else:
+				self.get_ptr32().squeeze_from_ptr(other_ptr, c_filtration_grid)
+
+	def __dealloc__(self):
+		if self.thisptr == 0:
+			return
+		if self._int16:
+			del self.get_ptr16()
+		else:
+			del self.get_ptr32()
+
+	@property
+	def dtype(self):
+		return np.int16 if self._int16 else np.int32
+
+	@property
+	def num_vertices(self)->int:
+		return self.get_ptr16().num_vertices() if self._int16 else self.get_ptr32().num_vertices()
+
+	@property
+	def num_simplices(self)->int:
+		return self.get_ptr16().num_simplices() if self._int16 else self.get_ptr32().num_simplices()
+
+	@property
+	def num_parameters(self)->int:
+		return self.get_ptr16().get_number_of_parameters() if self._int16 else self.get_ptr32().get_number_of_parameters()
+
+	@property
+	def dimension(self)->int:
+		return self.get_ptr16().dimension() if self._int16 else self.get_ptr32().dimension()
+
+	@property
+	def filtration_grid(self)->list[np.ndarray]:
+		"""The grid on which the coordinates are taken."""
+		grid = self.get_ptr16().get_filtration_grid() if self._int16 else self.get_ptr32().get_filtration_grid()
+		return [np.asarray(f, dtype=np.float32) for f in grid]
+
+	@property
+	def _is_squeezed(self)->bool:
+		return True
+
+	def filtration(self, simplex)->np.ndarray:
+		"""Returns the grid coordinates of the filtration value of `simplex`.
+		"""
+		cdef vector[int] csimplex = simplex
+		cdef int num_parameters = self.num_parameters
+		if self._int16:
+			if not self.get_ptr16().find_simplex(csimplex):
+				raise KeyError(f"{simplex} is not in the complex.")
+			return np.array(<int16_t[:num_parameters]> self.get_ptr16().simplex_filtration(csimplex))
+		if not self.get_ptr32().find_simplex(csimplex):
+			raise KeyError(f"{simplex} is not in the complex.")
+		return np.array(<int32_t[:num_parameters]> self.get_ptr32().simplex_filtration(csimplex))
+
+	def get_filtrations(self, int dimension=-1)->np.ndarray:
+		"""Returns the coordinates of the simplices of dimension `dimension` (all simplices if negative),
+		as a `(num_simplices, num_parameters)` array, in the order of :meth:`SimplexTreeMulti.get_simplices`.
+		"""
+		if self._int16:
+			out = np.asarray(self.get_ptr16().get_filtrations(dimension), dtype=np.int16)
+		else:
+			out = np.asarray(self.get_ptr32().get_filtrations(dimension), dtype=np.int32)
+		return out.reshape(-1, self.num_parameters)
+
+	def make_filtration_non_decreasing(self)->bool:
+		"""Same as :meth:`SimplexTreeMulti.make_filtration_non_decreasing`, on integer coordinates.
+		"""
+		cdef bool modified
+		with nogil:
+			if self._int16:
+				modified = self.get_ptr16().make_filtration_non_decreasing()
+			else:
+				modified = self.get_ptr32().make_filtration_non_decreasing()
+		return modified
+
+	def unsqueeze(self)->SimplexTreeMulti:
+		"""Returns a :class:`SimplexTreeMulti` whose filtration values are the grid values of the coordinates.
+		"""
+		st = SimplexTreeMulti(num_parameters=self.num_parameters)
+		cdef uintptr_t st_ptr = st.thisptr
+		with nogil:
+			if self._int16:
+				self.get_ptr16().unsqueeze_to_ptr(st_ptr)
+			else:
+				self.get_ptr32().unsqueeze_to_ptr(st_ptr)
+		return st
+
+
+cdef class _Filtration_table_owner:
+	"""Keeps alive the table viewed by the array returned by :meth:`SimplexTreeMulti.filtration_table`."""
+	cdef shared_ptr[Filtration_table] table
+
+cdef cnp.ndarray _filtration_table_view(Filtration_table* table, object owner):
+	# (num_parameters, num_simplices) view on the table, which keeps owner alive
+	cdef cnp.npy_intp shape[2]
+	shape[0] = table.num_parameters()
+	shape[1] = table.num_simplices()
+	if shape[0] == 0 or shape[1] == 0:
+		return np.empty((shape[0], shape[1]), dtype=np.float32)
+	cdef cnp.ndarray view = cnp.PyArray_SimpleNewFromData(2, shape, cnp.NPY_FLOAT32, table.data())
+	Py_INCREF(owner) # PyArray_SetBaseObject steals a reference
+	cnp.PyArray_SetBaseObject(view, owner)
+	return view
+
+cdef class SimplexTreeMultiVariant:
+	"""Filtration values of a :class:`SimplexTreeMulti`, sharing its structure.
+
+	It is built with :meth:`SimplexTreeMulti.filtration_variant`, and only stores a `(num_parameters, num_simplices)`
+	table of filtration values, cf. :meth:`SimplexTreeMulti.filtration_table`. It can be modified without modifying
+	the simplextree, and :meth:`to_simplextree` materializes it as a full :class:`SimplexTreeMulti`.
+	"""
+	cdef Filtration_table* table
+	cdef public SimplexTreeMulti simplextree
+	cdef public object filtration_grid
+
+	def __cinit__(self, SimplexTreeMulti simplextree):
+		"""
+		:param simplextree: The simplextree whose structure is shared, and whose current filtration values are copied.
+		"""
+		self.simplextree = simplextree
+		self.filtration_grid = None
+		with nogil:
+			self.table = simplextree.get_ptr().new_filtration_variant()
+
+	def __dealloc__(self):
+		if self.table != NULL:
+			del self.table
+
+	@property
+	def num_parameters(self)->int:
+		return self.table.num_parameters()
+
+	@property
+	def num_simplices(self)->int:
+		return self.table.num_simplices()
+
+	def filtration_table(self)->np.ndarray:
+		"""The filtration values, as a `(num_parameters, num_simplices)` array, cf.
+		:meth:`SimplexTreeMulti.filtration_table`. It is a view, which can be modified in place and remains valid as
+		long as this variant.
+		"""
+		return _filtration_table_view(self.table, self)
+
+	def fill_lowerstar(self, F, int parameter)->SimplexTreeMultiVariant:
+		"""Same as :meth:`SimplexTreeMulti.fill_lowerstar`, on this variant only.
+		"""
+		cdef vector[value_type] c_F = F
+		with nogil:
+			self.simplextree.get_ptr().fill_lowerstar_variant(dereference(self.table), c_F, parameter)
+		return self
+
+	def grid_squeeze(self, filtration_grid:np.ndarray|list, bool coordinate_values=True)->SimplexTreeMultiVariant:
+		"""Same as :meth:`SimplexTreeMulti.grid_squeeze`, on this variant only.
+		"""
+		cdef vector[vector[value_type]] c_filtration_grid = filtration_grid
+		with nogil:
+			self.simplextree.get_ptr().squeeze_filtration_variant(dereference(self.table), c_filtration_grid, coordinate_values)
+		if coordinate_values:
+			self.filtration_grid = c_filtration_grid
+		return self
+
+	def to_simplextree(self)->SimplexTreeMulti:
+		"""Returns a :class:`SimplexTreeMulti` with the structure of the shared simplextree and the filtration values
+		of this variant.
+		"""
+		st = self.simplextree.copy()
+		cdef intptr_t ptr = st.thisptr
+		with nogil:
+			(<Simplex_tree_multi_interface*>ptr).assign_filtration_variant(dereference(self.table))
+		if self.filtration_grid is not None:
+			st.filtration_grid = self.filtration_grid
+		return st
+
+
 def _todo_regular_closest(cnp.ndarray[some_float,ndim=1] f, int r, bool unique):
 	f_regular = np.linspace(np.min(f),np.max(f),num=r)
 	f_regular_closest = np.asarray([f[np.argmin(np.abs(f-x))] for x in f_regular])
@@ -1203,6 +1986,68 @@ def _todo_partition(cnp.ndarray[some_float,ndim=1] data,int resolution, bool uni
 
 
 
+def _split_signed_measure(vector[int32_t]& coordinates, vector[int32_t]& weights, size_t num_degrees, size_t num_parameters):
+	# The first coordinate of the points is the index of their degree, and the points are sorted by degree.
+	points = np.asarray(coordinates, dtype=np.int32).reshape(-1, num_parameters+1)
+	weights_ = np.asarray(weights, dtype=np.int32)
+	splits = np.searchsorted(points[:,0], np.arange(1, num_degrees))
+	return [(pts[:,1:], w) for pts, w in zip(np.split(points, splits), np.split(weights_, splits))]
+
+def signed_measure_from_grid(invariant:np.ndarray, int num_invariant_axes=0)->tuple[np.ndarray, np.ndarray]:
+	"""
+	Computes the signed measure of an invariant on a grid, e.g. a Hilbert function, i.e., its Möbius inversion,
+	in C++ and in parallel, and returns its points with a non-zero weight.
+
+	Input
+	-----
+	 - invariant : integer array, whose last axes are the axes of the grid.
+	 - num_invariant_axes : number of first axes that are not grid axes, e.g. 1 for the degrees of
+	   :meth:`SimplexTreeMulti.hilbert_function`. They are not inverted.
+
+	Output
+	------
+	 - coordinates : int32 array of shape (num_points, invariant.ndim), the indices of the points in `invariant`,
+	 - weights : int32 array of shape (num_points,).
+	"""
+	cdef vector[size_t] c_shape = invariant.shape
+	cdef vector[int32_t] c_tensor = np.ascontiguousarray(invariant, dtype=np.int32).ravel()
+	cdef size_t c_first_axis = num_invariant_axes
+	cdef vector[int32_t] coordinates
+	cdef vector[int32_t] weights
+	with nogil:
+		signed_measure[int32_t, int32_t](c_tensor, c_shape, c_first_axis, coordinates, weights)
+	return np.asarray(coordinates, dtype=np.int32).reshape(-1, c_shape.size()), np.asarray(weights, dtype=np.int32)
+
+def function_rips(points, function, threshold:float=np.inf, int max_dimension=2)->SimplexTreeMulti:
+	"""
+	Builds the function-Rips bifiltration of a point cloud, e.g. Rips x codensity: the first parameter is the Rips
+	filtration, i.e., the length of the longest edge of the simplices, and the second one is the lower-star filtration
+	of `function`, i.e., its maximum on their vertices.
+	The edges, the expansion and both parameters are computed in a single C++ call, in parallel, and the filtration is
+	non-decreasing, so that there is no need to call :meth:`SimplexTreeMulti.fill_lowerstar` or
+	:meth:`SimplexTreeMulti.make_filtration_non_decreasing`.
+
+	Input
+	-----
+	 - points : array of shape (num_points, dimension)
+	 - function : array of shape (num_points,), e.g. a codensity estimated with `gudhi.point_cloud.dtm`.
+	 - threshold : edges longer than this are not inserted.
+	 - max_dimension : dimension of the expansion.
+
+	Output
+	------
+	 - A SimplexTreeMulti with 2 parameters.
+	"""
+	st = SimplexTreeMulti(num_parameters=2)
+	cdef vector[vector[value_type]] c_points = np.asarray(points, dtype=np.float32)
+	cdef vector[value_type] c_function = np.asarray(function, dtype=np.float32)
+	cdef value_type c_threshold = threshold
+	cdef intptr_t ptr = st.thisptr
+	with nogil:
+		(<Simplex_tree_multi_interface*>ptr).fill_function_rips(c_points, c_function, c_threshold, max_dimension)
+	return st
+
+
 def _simplextree_multify(simplextree:SimplexTree, num_parameters:int=2, default_values=[])->SimplexTreeMulti:
 	"""Converts a gudhi simplextree to a multi simplextree.
 	Parameters
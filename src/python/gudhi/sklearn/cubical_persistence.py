@@ -8,12 +8,16 @@
 #   - YYYY/MM Author: Description of the modification
 
 from .. import CubicalComplex
-from .._pers_cub_low_dim import _persistence_on_a_line, _persistence_on_rectangle_from_top_cells
+from .._pers_cub_low_dim import (
+    _persistence_on_a_line,
+    _persistence_on_lines,
+    _persistence_on_rectangle_from_top_cells,
+    _persistence_on_rectangles_from_top_cells,
+)
 from sklearn.base import BaseEstimator, TransformerMixin
 
 import numpy as np
-# joblib is required by scikit-learn
-from joblib import Parallel, delayed
+from ..parallel import _map, _native_n_jobs
 
 # Mermaid sequence diagram - https://mermaid-js.github.io/mermaid-live-editor/
 # sequenceDiagram
@@ -52,7 +56,8 @@ class CubicalPersistence(BaseEstimator, TransformerMixin):
             homology_coeff_field (int): The homology coefficient field. Must be a prime number. Default value is 11.
             min_persistence (float): The minimum persistence value to take into account (strictly greater than
                 `min_persistence`). Default value is `0.0`. Set `min_persistence` to `-1.0` to see all values.
-            n_jobs (int): cf. https://joblib.readthedocs.io/en/latest/generated/joblib.Parallel.html
+            n_jobs (int): Number of threads of the pool of :mod:`gudhi.parallel` that compute the diagrams, with the
+                same meaning as in joblib (default None, ie 1).
         """
         self.homology_dimensions = homology_dimensions
         self.input_type = input_type
@@ -105,8 +110,10 @@ class CubicalPersistence(BaseEstimator, TransformerMixin):
     def transform(self, X, Y=None):
         """Compute all the cubical complexes and their associated persistence diagrams.
 
-        :param X: Filtration values of the top-dimensional cells or vertices for each complex.
-        :type X: list of array-like
+        :param X: Filtration values of the top-dimensional cells or vertices for each complex. A 3d numpy array of
+            top-dimensional cells is processed as a batch of 2d images, and a 2d numpy array as a batch of 1d signals,
+            without going through Python for each image or signal.
+        :type X: list of array-like or numpy.ndarray
 
         :return: Persistence diagrams in the format:
 
@@ -122,8 +129,27 @@ class CubicalPersistence(BaseEstimator, TransformerMixin):
             unwrap = False
             self.dim_list_ = self.homology_dimensions
 
-        # threads is preferred as cubical construction and persistence computation releases the GIL
-        res = Parallel(n_jobs=self.n_jobs, prefer="threads")(delayed(self.__transform)(cells) for cells in X)
+        if (
+            isinstance(X, np.ndarray)
+            and X.ndim == 3
+            and X.shape[1] > 2
+            and X.shape[2] > 2
+            and self.input_type == 'top_dimensional_cells'
+            and self.min_persistence >= 0
+        ):
+            # A batch of images of the same shape is handled in C++ by the threads of the pool, without the GIL
+            diags = _persistence_on_rectangles_from_top_cells(X, self.min_persistence, _native_n_jobs(self.n_jobs))
+            res = [[d[i] if i in (0, 1) else np.empty((0,2)) for i in self.dim_list_] for d in diags]
+        elif isinstance(X, np.ndarray) and X.ndim == 2 and self.min_persistence >= 0:
+            # A batch of signals of the same length is handled in C++, with the pairs of all the signals packed in one
+            # array. As for a single signal, the pairs of length 0 are kept if min_persistence is 0.
+            pairs, offsets = _persistence_on_lines(
+                X, None, self.min_persistence if self.min_persistence > 0 else -1.0, _native_n_jobs(self.n_jobs)
+            )
+            res = [[d if i == 0 else np.empty((0,2)) for i in self.dim_list_] for d in np.split(pairs, offsets[1:-1])]
+        else:
+            # The cubical construction and persistence computation release the GIL
+            res = _map(self.__transform, X, self.n_jobs)
         if unwrap:
             res = [d[0] for d in res]
         return res
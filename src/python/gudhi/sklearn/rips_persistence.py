@@ -0,0 +1,117 @@
+# This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+# See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+# Author(s):       David Loiseaux
+#
+# Copyright (C) 2023 Inria
+#
+# Modification(s):
+#   - YYYY/MM Author: Description of the modification
+
+from ..rips_complex import _rips_persistence_batch
+from ..parallel import _native_n_jobs
+from sklearn.base import BaseEstimator, TransformerMixin
+
+import numpy as np
+
+
+class RipsPersistence(BaseEstimator, TransformerMixin):
+    """
+    This is a class for computing the persistence diagrams of the Rips complexes of point clouds or of distance
+    matrices. All of them are sent at once to C++, where they are computed in parallel, without the GIL.
+    """
+
+    def __init__(
+        self,
+        homology_dimensions,
+        threshold=float('inf'),
+        input_type='point cloud',
+        num_collapses='auto',
+        homology_coeff_field=11,
+        min_persistence=0.0,
+        n_jobs=None,
+    ):
+        """
+        Constructor for the RipsPersistence class.
+
+        Parameters:
+            homology_dimensions (int or list of int): The returned persistence diagrams dimension(s).
+                Short circuit the use of :class:`~gudhi.representations.preprocessing.DimensionSelector` when only one
+                dimension matters (in other words, when `homology_dimensions` is an int).
+            threshold (float): Rips maximal edge length value. Default is +Inf.
+            input_type (str): Can be 'point cloud' when inputs are point clouds (of the same dimension), or
+                'full distance matrix' when inputs are square distance matrices. Default is 'point cloud'.
+            num_collapses (int|str): Number of iterations of :meth:`~gudhi.SimplexTree.collapse_edges` on the graph
+                of each complex before its expansion, which is worth it when the homology in dimension 1 or more is
+                needed. If 0, the persistence is computed by :func:`~gudhi.rips_persistence`, without any simplex
+                tree. Default is 'auto', i.e. 1 if a homology dimension is positive, 0 otherwise.
+            homology_coeff_field (int): The homology coefficient field. Must be a prime number. Default value is 11.
+            min_persistence (float): The minimum persistence value to take into account (strictly greater than
+                `min_persistence`). Default value is `0.0`. Set `min_persistence` to `-1.0` to see all values.
+            n_jobs (int): Number of threads of the pool of :mod:`gudhi.parallel` that compute the diagrams, with the
+                same meaning as in joblib (default None, ie 1).
+        """
+        self.homology_dimensions = homology_dimensions
+        self.threshold = threshold
+        self.input_type = input_type
+        self.num_collapses = num_collapses
+        self.homology_coeff_field = homology_coeff_field
+        self.min_persistence = min_persistence
+        self.n_jobs = n_jobs
+
+    def fit(self, X, Y=None):
+        """
+        Nothing to be done, but useful when included in a scikit-learn Pipeline.
+        """
+        return self
+
+    def transform(self, X, Y=None):
+        """Compute all the Rips complexes and their associated persistence diagrams.
+
+        :param X: The point clouds or the distance matrices. A 3d numpy array of float32 or float64 point clouds is
+            read in place.
+        :type X: list of array-like or numpy.ndarray
+
+        :return: Persistence diagrams in the format:
+
+              - If `homology_dimensions` was set to `n`: `[array( Hn(X[0]) ), array( Hn(X[1]) ), ...]`
+              - If `homology_dimensions` was set to `[i, j]`: `[[array( Hi(X[0]) ), array( Hj(X[0]) )], [array( Hi(X[1]) ), array( Hj(X[1]) )], ...]`
+        :rtype: list of (,2) array_like or list of list of (,2) array_like
+        """
+        # Depends on homology_dimensions is an integer or a list of integer (else case)
+        if isinstance(self.homology_dimensions, int):
+            unwrap = True
+            self.dim_list_ = [self.homology_dimensions]
+        else:
+            unwrap = False
+            self.dim_list_ = self.homology_dimensions
+        max_dimension = max(self.dim_list_, default=0) + 1
+
+        if self.num_collapses == 'auto':
+            num_collapses = 1 if max_dimension > 1 else 0
+        elif isinstance(self.num_collapses, int) and self.num_collapses >= 0:
+            num_collapses = self.num_collapses
+        else:
+            raise ValueError("num_collapses must be a non-negative integer or 'auto'")
+
+        offsets, dimensions, intervals = _rips_persistence_batch(
+            X,
+            input_type=self.input_type,
+            max_edge_length=self.threshold,
+            max_dimension=max_dimension,
+            num_collapse_iterations=num_collapses,
+            homology_coeff_field=self.homology_coeff_field,
+            min_persistence=self.min_persistence,
+            n_jobs=_native_n_jobs(self.n_jobs),
+        )
+        # For each dimension, the intervals of all the diagrams, split by diagram
+        n = len(offsets) - 1
+        diagram_of_interval = np.repeat(np.arange(n), np.diff(offsets))
+        by_dimension = []
+        for dim in self.dim_list_:
+            selected = dimensions == dim
+            splits = np.cumsum(np.bincount(diagram_of_interval[selected], minlength=n))[:-1]
+            by_dimension.append(np.split(intervals[selected], splits))
+        res = [[diags[i] for diags in by_dimension] for i in range(n)]
+        if unwrap:
+            res = [d[0] for d in res]
+        return res
@@ -11,6 +11,8 @@ from cython cimport numeric
 from libcpp.vector cimport vector
 from libcpp.string cimport string
 from libcpp cimport bool
+from libc.stddef cimport ptrdiff_t
+import numpy as np
 import os
 
 __author__ = "Vincent Rouvreau"
@@ -20,9 +22,17 @@ __license__ = "MIT (GPL v3 for sparsify_point_set)"
 cdef extern from "Subsampling_interface.h" namespace "Gudhi::subsampling":
     vector[vector[double]] subsampling_n_farthest_points(bool, vector[vector[double]] points, size_t nb_points)
     vector[vector[double]] subsampling_n_farthest_points(bool, vector[vector[double]] points, size_t nb_points, size_t starting_point)
+    vector[vector[double]] subsampling_n_farthest_points_buffer(bool, const float* data, size_t num_points,
+        size_t dimension, ptrdiff_t stride0, ptrdiff_t stride1, size_t nb_points, size_t starting_point) nogil except +
+    vector[vector[double]] subsampling_n_farthest_points_buffer(bool, const double* data, size_t num_points,
+        size_t dimension, ptrdiff_t stride0, ptrdiff_t stride1, size_t nb_points, size_t starting_point) nogil except +
     vector[vector[double]] subsampling_n_farthest_points_from_file(bool, string off_file, size_t nb_points)
     vector[vector[double]] subsampling_n_farthest_points_from_file(bool, string off_file, size_t nb_points, size_t starting_point)
     vector[vector[double]] subsampling_n_random_points(vector[vector[double]] points, unsigned nb_points)
+    vector[vector[double]] subsampling_n_random_points_buffer(const float* data, size_t num_points, size_t dimension,
+        ptrdiff_t stride0, ptrdiff_t stride1, unsigned nb_points) nogil except +
+    vector[vector[double]] subsampling_n_random_points_buffer(const double* data, size_t num_points, size_t dimension,
+        ptrdiff_t stride0, ptrdiff_t stride1, unsigned nb_points) nogil except +
     vector[vector[double]] subsampling_n_random_points_from_file(string off_file, unsigned nb_points)
     vector[vector[double]] subsampling_sparsify_points(vector[vector[double]] points, double min_squared_dist)
     vector[vector[double]] subsampling_sparsify_points_from_file(string off_file, double min_squared_dist)
@@ -32,13 +42,51 @@ cdef extern from "Subsampling_interface.h":
 
 GUDHI_SUBSAMPLING_USE_CGAL = _GUDHI_SUBSAMPLING_USE_CGAL
 
+def _is_points_buffer(points):
+    """Whether the points are a non empty 2d array of float32 or float64, which is read in place by the C++ code
+    (with any strides) instead of being copied to a vector[vector[double]]."""
+    return (isinstance(points, np.ndarray) and points.ndim == 2 and points.size > 0
+            and points.dtype in (np.float32, np.float64))
+
+def _farthest_points_buffer(bool fast, points, size_t nb_points, size_t starting_point):
+    cdef const float[:, :] points_f32
+    cdef const double[:, :] points_f64
+    cdef vector[vector[double]] landmarks
+    if points.dtype == np.float32:
+        points_f32 = points
+        with nogil:
+            landmarks = subsampling_n_farthest_points_buffer(fast, &points_f32[0, 0], points_f32.shape[0],
+                points_f32.shape[1], points_f32.strides[0], points_f32.strides[1], nb_points, starting_point)
+    else:
+        points_f64 = points
+        with nogil:
+            landmarks = subsampling_n_farthest_points_buffer(fast, &points_f64[0, 0], points_f64.shape[0],
+                points_f64.shape[1], points_f64.strides[0], points_f64.strides[1], nb_points, starting_point)
+    return landmarks
+
+def _random_points_buffer(points, unsigned nb_points):
+    cdef const float[:, :] points_f32
+    cdef const double[:, :] points_f64
+    cdef vector[vector[double]] landmarks
+    if points.dtype == np.float32:
+        points_f32 = points
+        with nogil:
+            landmarks = subsampling_n_random_points_buffer(&points_f32[0, 0], points_f32.shape[0],
+                points_f32.shape[1], points_f32.strides[0], points_f32.strides[1], nb_points)
+    else:
+        points_f64 = points
+        with nogil:
+            landmarks = subsampling_n_random_points_buffer(&points_f64[0, 0], points_f64.shape[0],
+                points_f64.shape[1], points_f64.strides[0], points_f64.strides[1], nb_points)
+    return landmarks
+
 def choose_n_farthest_points(points=None, off_file='', nb_points=-<size_t>1, starting_point=None, fast=True):
     """Subsample by a greedy strategy of iteratively adding the farthest point
     from the current chosen point set to the subsampling.
     The iteration starts with the landmark `starting point`.
 
-    :param points: The input point set.
-    :type points: Iterable[Iterable[float]]
+    :param points: The input point set. A 2d numpy array of float32 or float64 is read in place, without any copy.
+    :type points: Iterable[Iterable[float]] or numpy.ndarray
 
     Or
 
@@ -74,6 +122,10 @@ def choose_n_farthest_points(points=None, off_file='', nb_points=-<size_t>1, sta
         if points is None:
             # Empty points
             points=[]
+        if _is_points_buffer(points):
+            # -1 is random_starting_point
+            return _farthest_points_buffer(fast, points, nb_points,
+                                           -<size_t>1 if starting_point is None else starting_point)
         if starting_point is None:
             return subsampling_n_farthest_points(fast, points, nb_points)
         else:
@@ -82,8 +134,8 @@ def choose_n_farthest_points(points=None, off_file='', nb_points=-<size_t>1, sta
 def pick_n_random_points(points=None, off_file='', nb_points=0):
     """Subsample a point set by picking random vertices.
 
-    :param points: The input point set.
-    :type points: Iterable[Iterable[float]]
+    :param points: The input point set. A 2d numpy array of float32 or float64 is read in place, without any copy.
+    :type points: Iterable[Iterable[float]] or numpy.ndarray
 
     Or
 
@@ -107,6 +159,8 @@ def pick_n_random_points(points=None, off_file='', nb_points=0):
         if points is None:
             # Empty points
             points=[]
+        if _is_points_buffer(points):
+            return _random_points_buffer(points, nb_points)
         return subsampling_n_random_points(points, nb_points)
 
 def sparsify_point_set(points=None, off_file='', min_squared_dist=0.0):
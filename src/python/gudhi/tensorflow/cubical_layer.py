@@ -1,6 +1,6 @@
 import numpy               as np
 import tensorflow          as tf
-from ..cubical_complex  import CubicalComplex
+from ..cubical_complex  import CubicalComplex, _cofaces_of_persistence_pairs_batch
 
 ######################
 # Cubical filtration #
@@ -37,7 +37,7 @@ class CubicalLayer(tf.keras.layers.Layer):
     """
     TensorFlow layer for computing the persistent homology of a cubical complex
     """
-    def __init__(self, homology_dimensions, min_persistence=None, homology_coeff_field=11, **kwargs):
+    def __init__(self, homology_dimensions, min_persistence=None, homology_coeff_field=11, batched=False, **kwargs):
         """
         Constructor for the CubicalLayer class
 
@@ -45,11 +45,13 @@ class CubicalLayer(tf.keras.layers.Layer):
             homology_dimensions (List[int]): list of homology dimensions
             min_persistence (List[float]): minimum distance-to-diagonal of the points in the output persistence diagrams (default None, in which case 0. is used for all dimensions)
             homology_coeff_field (int): homology field coefficient. Must be a prime number. Default value is 11. Max is 46337.
+            batched (bool): if True, the first axis of the input indexes a batch of images of the same shape, whose persistence is computed in parallel in C++, and the diagrams are ragged tensors with one row per image (default False).
         """
         super().__init__(dynamic=True, **kwargs)
         self.dimensions = homology_dimensions
         self.min_persistence = min_persistence if min_persistence is not None else [0.] * len(self.dimensions)
         self.hcf = homology_coeff_field
+        self.batched = batched
         assert len(self.min_persistence) == len(self.dimensions)
 
     def call(self, X):
@@ -62,6 +64,8 @@ class CubicalLayer(tf.keras.layers.Layer):
         Returns:
             List[Tuple[tf.Tensor,tf.Tensor]]: List of cubical persistence diagrams. The length of this list is the same than that of dimensions, i.e., there is one persistence diagram per homology dimension provided in the input list dimensions. Moreover, the finite and essential parts of the persistence diagrams are provided separately: each element of this list is a tuple of size two that contains the finite and essential parts of the corresponding persistence diagram, of shapes [num_finite_points, 2] and [num_essential_points, 1] respectively. Note that the essential part is always empty in cubical persistence diagrams, except in homology dimension zero, where the essential part always contains a single point, with abscissa equal to the smallest value in the complex, and infinite ordinate
         """
+        if self.batched:
+            return self._call_batched(X)
         # Compute pixels associated to positive and negative simplices 
         # Don't compute gradient for this operation
         Xflat = tf.reshape(X, [-1])
@@ -80,3 +84,33 @@ class CubicalLayer(tf.keras.layers.Layer):
             else:
                 self.dgms.append((finite_dgm, essential_dgm))
         return self.dgms
+
+    def _call_batched(self, X):
+        """
+        Same as call, for a batch of images X of shape [batch_size, ...]. The finite and essential parts of the persistence diagrams are ragged tensors of shapes [batch_size, None, 2] and [batch_size, None, 1], whose row i is the diagram of the image i.
+        """
+        # The persistence pairs of all the images, as flat pixel indices and row splits, without gradient
+        Xnumpy = X.numpy()
+        batch_size, image_size = Xnumpy.shape[0], Xnumpy[0].size
+        regular, essential = _cofaces_of_persistence_pairs_batch(Xnumpy, homology_coeff_field=self.hcf)
+        Xflat = tf.reshape(X, [-1])
+        def ragged_diagram(indices, row_splits, width):
+            # Pixel indices in the whole batch
+            shift = np.repeat(np.arange(batch_size, dtype=np.int64) * image_size, np.diff(row_splits))
+            values = tf.reshape(tf.gather(Xflat, indices.reshape(len(shift), -1) + shift[:, np.newaxis]), [-1, width])
+            return tf.RaggedTensor.from_row_splits(values, row_splits)
+        self.dgms = []
+        for idx_dim, dimension in enumerate(self.dimensions):
+            if dimension < len(regular):
+                finite_dgm = ragged_diagram(*regular[dimension], 2)
+                essential_dgm = ragged_diagram(*essential[dimension], 1)
+            else:
+                empty_splits = np.zeros(batch_size + 1, dtype=np.int64)
+                finite_dgm = tf.RaggedTensor.from_row_splits(tf.zeros([0, 2], dtype=X.dtype), empty_splits)
+                essential_dgm = tf.RaggedTensor.from_row_splits(tf.zeros([0, 1], dtype=X.dtype), empty_splits)
+            min_pers = self.min_persistence[idx_dim]
+            if min_pers >= 0:
+                persistent = tf.math.abs(finite_dgm.values[:,1]-finite_dgm.values[:,0]) > min_pers
+                finite_dgm = tf.ragged.boolean_mask(finite_dgm, finite_dgm.with_values(persistent))
+            self.dgms.append((finite_dgm, essential_dgm))
+        return self.dgms
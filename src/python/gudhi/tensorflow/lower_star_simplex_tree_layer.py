@@ -13,13 +13,9 @@ def _LowerStarSimplexTree(simplextree, filtration, dimensions, homology_coeff_fi
     #             dimensions (homology dimensions),
     #             homology_coeff_field (homology field coefficient)
     
-    simplextree.reset_filtration(-np.inf, 0)
+    # Assign new filtration values, the filtration order and the persistence workspace of the previous call are reused
+    simplextree.assign_lower_star_filtration(filtration)
 
-    # Assign new filtration values
-    for i in range(simplextree.num_vertices()):
-        simplextree.assign_filtration([i], filtration[i])
-    simplextree.make_filtration_non_decreasing()
-    
     # Compute persistence diagram
     simplextree.compute_persistence(homology_coeff_field=homology_coeff_field, persistence_dim_max=persistence_dim_max)
     
@@ -32,8 +28,8 @@ def _LowerStarSimplexTree(simplextree, filtration, dimensions, homology_coeff_fi
         finite_pairs = pairs[0][dimension] if len(pairs[0]) >= dimension+1 else np.empty(shape=[0,2])
         essential_pairs = pairs[1][dimension] if len(pairs[1]) >= dimension+1 else np.empty(shape=[0,1])
         
-        finite_indices = np.array(finite_pairs.flatten(), dtype=np.int32)
-        essential_indices = np.array(essential_pairs.flatten(), dtype=np.int32)
+        finite_indices = np.asarray(finite_pairs.reshape(-1), dtype=np.int32)
+        essential_indices = np.asarray(essential_pairs.reshape(-1), dtype=np.int32)
 
         L_indices.append((finite_indices, essential_indices))
 
@@ -160,6 +160,29 @@ class GaussianPerslayPhi(tf.keras.layers.Layer):
         output = tf.expand_dims(gauss,-1)
         output_shape = M[0].shape + tuple([1])
         return output, output_shape
+
+    def weighted_sum(self, diagrams, weight):
+        """
+        Compute, for each persistence diagram, the sum over its points of their weights times the output of call, without the intermediate tensor that contains one image per point. The Gaussian functions are separable, so each point only needs its values on the rows and on the columns of the grid, and the sum is a product of these values.
+
+        Parameters:
+            diagrams (n x None x 2): ragged tensor containing n persistence diagrams. The second dimension is ragged since persistence diagrams can have different numbers of points.
+            weight (n x None): ragged tensor containing the weights of the points in the n persistence diagrams.
+
+        Returns:
+            output (n x image_size x image_size x 1): tensor containing the weighted sums of the 2D images of the points of each persistence diagram.
+        """
+        step = [(self.image_bnds[i][1]-self.image_bnds[i][0])/self.image_size[i] for i in range(2)]
+        coords = [tf.range(self.image_bnds[i][0], self.image_bnds[i][1], step[i]) for i in range(2)]
+        # Padding points have a zero weight
+        points = diagrams.to_tensor() if isinstance(diagrams, tf.RaggedTensor) else diagrams
+        weight = weight.to_tensor() if isinstance(weight, tf.RaggedTensor) else weight
+        two_variances = 2*tf.math.square(self.variance)
+        births, persistences = points[:,:,0:1], points[:,:,1:2]-points[:,:,0:1]
+        gauss_x = tf.math.exp(-tf.math.square(births-coords[0]) / two_variances)
+        gauss_y = tf.math.exp(-tf.math.square(persistences-coords[1]) / two_variances)
+        output = tf.einsum('np,npr,npc->nrc', weight, gauss_y, gauss_x) / (math.pi*two_variances)
+        return tf.expand_dims(output, -1)
      
 class TentPerslayPhi(tf.keras.layers.Layer):
     """
@@ -241,7 +264,7 @@ class Perslay(tf.keras.layers.Layer):
 
         Parameters:
             weight (function): weight function for the persistence diagram points. Can be either :class:`~gudhi.tensorflow.perslay.GridPerslayWeight`, :class:`~gudhi.tensorflow.perslay.GaussianMixturePerslayWeight`, :class:`~gudhi.tensorflow.perslay.PowerPerslayWeight`, or a custom TensorFlow function that takes persistence diagrams as argument (represented as an (n x None x 2) ragged tensor, where n is the number of diagrams).
-            phi (function): transformation function for the persistence diagram points. Can be either :class:`~gudhi.tensorflow.perslay.GaussianPerslayPhi`, :class:`~gudhi.tensorflow.perslay.TentPerslayPhi`, :class:`~gudhi.tensorflow.perslay.FlatPerslayPhi`, or a custom TensorFlow class (that can have trainable parameters) with a method `call` that takes persistence diagrams as argument (represented as an (n x None x 2) ragged tensor, where n is the number of diagrams).
+            phi (function): transformation function for the persistence diagram points. Can be either :class:`~gudhi.tensorflow.perslay.GaussianPerslayPhi`, :class:`~gudhi.tensorflow.perslay.TentPerslayPhi`, :class:`~gudhi.tensorflow.perslay.FlatPerslayPhi`, or a custom TensorFlow class (that can have trainable parameters) with a method `call` that takes persistence diagrams as argument (represented as an (n x None x 2) ragged tensor, where n is the number of diagrams). If perm_op is `tf.math.reduce_sum` or `tf.math.reduce_mean` and phi has a method `weighted_sum(diagrams, weight)`, like :class:`~gudhi.tensorflow.perslay.GaussianPerslayPhi`, it is called instead of `call`, so that the output of phi for each point is never stored.
             perm_op (function): permutation invariant function, such as `tf.math.reduce_sum`, `tf.math.reduce_mean`, `tf.math.reduce_max`, `tf.math.reduce_min`, or a custom TensorFlow function that takes two arguments: a tensor and an axis on which to apply the permutation invariant operation. If perm_op is the string "topk" (where k is a number), this function will be computed as `tf.math.top_k` with parameter `int(k)`.
             rho (function): postprocessing function that is applied after the permutation invariant operation. Can be any TensorFlow layer.
         """
@@ -264,8 +287,15 @@ class Perslay(tf.keras.layers.Layer):
         Returns:
             vector (n x output_shape): tensor containing the vectorizations of the persistence diagrams.
         """
-        vector, dim = self.phi(diagrams)
         weight = self.weight(diagrams)
+        if self.perm_op in (tf.math.reduce_sum, tf.math.reduce_mean) and hasattr(self.phi, 'weighted_sum'):
+            # Same result, without the tensor with one image per point
+            vector = self.phi.weighted_sum(diagrams, weight)
+            if self.perm_op is tf.math.reduce_mean:
+                vector = vector / tf.reshape(tf.cast(diagrams.row_lengths(), vector.dtype), [-1, 1, 1, 1])
+            return self.rho(vector)
+
+        vector, dim = self.phi(diagrams)
         for _ in range(len(dim)):
             weight = tf.expand_dims(weight, -1)
         vector = tf.math.multiply(vector, weight)
@@ -8,14 +8,19 @@ from ..rips_complex     import RipsComplex
 
 # The parameters of the model are the point coordinates.
 
-def _Rips(DX, max_edge, dimensions, homology_coeff_field):
+def _Rips(DX, max_edge, dimensions, homology_coeff_field, st=None):
     # Parameters: DX (distance matrix), 
     #             max_edge (maximum edge length for Rips filtration), 
     #             dimensions (homology dimensions)
+    #             st (simplex tree of the Rips complex of a previous distance matrix with the same edges, or None)
 
     # Compute the persistence pairs with Gudhi
-    rc = RipsComplex(distance_matrix=DX, max_edge_length=max_edge)
-    st = rc.create_simplex_tree(max_dimension=max(dimensions)+1)
+    if st is None:
+        rc = RipsComplex(distance_matrix=DX, max_edge_length=max_edge)
+        st = rc.create_simplex_tree(max_dimension=max(dimensions)+1)
+    else:
+        # Same complex, only the filtration values and their order change
+        st.assign_flag_filtration(DX)
     st.compute_persistence(homology_coeff_field=homology_coeff_field)
     pairs = st.flag_persistence_generators()
 
@@ -29,8 +34,8 @@ def _Rips(DX, max_edge, dimensions, homology_coeff_field):
             finite_pairs = pairs[1][dimension-1] if len(pairs[1]) >= dimension else np.empty(shape=[0,4])
             essential_pairs = pairs[3][dimension-1] if len(pairs[3]) >= dimension else np.empty(shape=[0,2])
         
-        finite_indices = np.array(finite_pairs.flatten(), dtype=np.int32)
-        essential_indices = np.array(essential_pairs.flatten(), dtype=np.int32)
+        finite_indices = np.asarray(finite_pairs.reshape(-1), dtype=np.int32)
+        essential_indices = np.asarray(essential_pairs.reshape(-1), dtype=np.int32)
 
         L_indices.append((finite_indices, essential_indices))
 
@@ -40,7 +45,7 @@ class RipsLayer(tf.keras.layers.Layer):
     """
     TensorFlow layer for computing Rips persistence out of a point cloud
     """
-    def __init__(self, homology_dimensions, maximum_edge_length=np.inf, min_persistence=None, homology_coeff_field=11, **kwargs):
+    def __init__(self, homology_dimensions, maximum_edge_length=np.inf, min_persistence=None, homology_coeff_field=11, reuse_complex=False, **kwargs):
         """
         Constructor for the RipsLayer class
 
@@ -49,12 +54,15 @@ class RipsLayer(tf.keras.layers.Layer):
             homology_dimensions (List[int]): list of homology dimensions
             min_persistence (List[float]): minimum distance-to-diagonal of the points in the output persistence diagrams (default None, in which case 0. is used for all dimensions)
             homology_coeff_field (int): homology field coefficient. Must be a prime number. Default value is 11. Max is 46337.
+            reuse_complex (bool): if True, the simplex tree of the previous call is kept when the set of edges shorter than maximum_edge_length did not change, as for a point cloud that moves slightly at each gradient step. Only its filtration values are updated, and the order of its simplices is repaired instead of being sorted again (default False).
         """
         super().__init__(dynamic=True, **kwargs)
         self.max_edge = maximum_edge_length
         self.dimensions = homology_dimensions
         self.min_persistence = min_persistence if min_persistence is not None else [0. for _ in range(len(self.dimensions))]
         self.hcf = homology_coeff_field
+        self.reuse_complex = reuse_complex
+        self._simplextree, self._edges = None, None
         assert len(self.min_persistence) == len(self.dimensions)
         
     def call(self, X):
@@ -71,7 +79,17 @@ class RipsLayer(tf.keras.layers.Layer):
         DX = tf.norm(tf.expand_dims(X, 1)-tf.expand_dims(X, 0), axis=2)
         # Compute vertices associated to positive and negative simplices 
         # Don't compute gradient for this operation
-        indices = _Rips(DX.numpy(), self.max_edge, self.dimensions, self.hcf)
+        DXnumpy = DX.numpy()
+        if self.reuse_complex:
+            # The complex is the same as long as the same pairs of points are closer than max_edge
+            edges = DXnumpy <= self.max_edge
+            reusable = self._simplextree is not None and np.array_equal(edges, self._edges)
+            if not reusable:
+                self._simplextree = RipsComplex(distance_matrix=DXnumpy, max_edge_length=self.max_edge).create_simplex_tree(max_dimension=max(self.dimensions)+1)
+                self._edges = edges
+            indices = _Rips(DXnumpy, self.max_edge, self.dimensions, self.hcf, st=self._simplextree)
+        else:
+            indices = _Rips(DXnumpy, self.max_edge, self.dimensions, self.hcf)
         # Get persistence diagrams by simply picking the corresponding entries in the distance matrix
         self.dgms = []
         for idx_dim, dimension in enumerate(self.dimensions):
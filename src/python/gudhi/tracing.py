@@ -0,0 +1,154 @@
+# This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+# See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+# Author(s):       David Loiseaux
+#
+# Copyright (C) 2023 Inria
+#
+# Modification(s):
+#   - YYYY/MM Author: Description of the modification
+
+import atexit
+import json
+import os
+from contextlib import contextmanager
+from functools import wraps
+from importlib import import_module
+
+__author__ = "David Loiseaux"
+__copyright__ = "Copyright (C) 2023 Inria"
+__license__ = "MIT"
+
+__all__ = ["trace", "trace_phase", "start_tracing", "stop_tracing", "trace_events", "write_trace"]
+
+# Each compiled module has its own copy of the C++ instrumentation (gudhi/Profiler.h), whose events are merged. Their
+# timestamps come from the same monotonic clock, and their threads are identified the same way.
+_traced_modules = ("gudhi.simplex_tree", "gudhi.rips_complex", "gudhi._edge_collapse")
+
+_tracing = False
+
+
+def _modules():
+    out = []
+    for name in _traced_modules:
+        try:
+            out.append(import_module(name))
+        except ImportError:
+            pass
+    return out
+
+
+def start_tracing():
+    """Starts recording a trace of the phases of the computations, e.g. the construction of a
+    :class:`~gudhi.RipsComplex`, :meth:`~gudhi.SimplexTree.collapse_edges`, :meth:`~gudhi.SimplexTree.expansion` and
+    :meth:`~gudhi.SimplexTree.persistence`, after clearing the previous trace. The events of the C++ code are
+    recorded at the beginning and at the end of each phase, so that tracing has no noticeable cost.
+    """
+    global _tracing
+    for module in _modules():
+        module._start_tracing()
+    _tracing = True
+
+
+def stop_tracing():
+    """Stops recording the trace. Its events are kept until the next call of :func:`start_tracing`."""
+    global _tracing
+    _tracing = False
+    for module in _modules():
+        module._stop_tracing()
+
+
+def trace_events():
+    """Events of the trace, in the Chrome trace event format.
+
+    :returns: The events, sorted by timestamp (in microseconds).
+    :rtype: list of dict
+    """
+    events = []
+    for module in _modules():
+        events += module._trace_events()
+    events.sort(key=lambda event: event[2])
+    return [{"name": name, "ph": phase, "ts": ts, "pid": 0, "tid": tid} for name, phase, ts, tid in events]
+
+
+def write_trace(path):
+    """Writes the trace as a JSON file in the Chrome trace event format, which can be viewed in `chrome://tracing`
+    or `Perfetto <https://ui.perfetto.dev>`_.
+
+    :param path: Name of the file.
+    :type path: str
+    """
+    with open(path, "w") as f:
+        json.dump({"traceEvents": trace_events(), "displayTimeUnit": "ms"}, f)
+
+
+@contextmanager
+def trace(path=None):
+    """Context manager that records a trace of the computations of its block, e.g.
+
+    .. code-block:: python
+
+        with gudhi.trace("trace.json"):
+            st = gudhi.RipsComplex(points=points, max_edge_length=0.5).create_simplex_tree()
+            st.collapse_edges()
+            st.expansion(3)
+            diagrams = st.persistence()
+
+    The trace can also be recorded for a whole program by setting the environment variable `GUDHI_TRACE` to the
+    name of the file, in which it is written at exit.
+
+    :param path: Name of the file in which the trace is written at the end of the block, cf. :func:`write_trace`. If
+        None, the events can be retrieved with :func:`trace_events`.
+    :type path: str or None
+    """
+    start_tracing()
+    try:
+        yield
+    finally:
+        stop_tracing()
+        if path is not None:
+            write_trace(path)
+
+
+@contextmanager
+def trace_phase(name):
+    """Context manager that records its block as a phase of the trace, e.g. a vectorization of the diagrams in
+    Python. It does nothing when no trace is recorded.
+
+    :param name: Name of the phase.
+    :type name: str
+    """
+    if not _tracing:
+        yield
+        return
+    simplex_tree = import_module("gudhi.simplex_tree")
+    simplex_tree._begin_event(name)
+    try:
+        yield
+    finally:
+        simplex_tree._end_event(name)
+
+
+def _traced(name):
+    """Decorator recording each call of the function as the phase `name` of the trace."""
+
+    def decorator(f):
+        @wraps(f)
+        def wrapper(*args, **kwargs):
+            if not _tracing:
+                return f(*args, **kwargs)
+            with trace_phase(name):
+                return f(*args, **kwargs)
+
+        return wrapper
+
+    return decorator
+
+
+def _write_trace_at_exit(path):
+    stop_tracing()
+    write_trace(path)
+
+
+if os.environ.get("GUDHI_TRACE"):
+    start_tracing()
+    atexit.register(_write_trace_at_exit, os.environ["GUDHI_TRACE"])
@@ -12,26 +12,34 @@ import ot
 import numpy as np
 import scipy.spatial.distance as sc
 import warnings
+from joblib import Parallel, delayed
 
 from gudhi.wasserstein import wasserstein_distance
 
 
-def _mean(x, m):
+def _mean_with_diagonal(sums, counts, m):
     '''
-    :param x: a list of 2D-points, off diagonal, x_0... x_{k-1}
-    :param m: total amount of points taken into account, that is we have (m-k) copies of diagonal
-    :returns: the weighted mean of x with (m-k) copies of the diagonal
+    :param sums: (K x 2) array, the sums of the k_j points matched to each point.
+    :param counts: (K) array of the numbers k_j > 0 of points in these sums.
+    :param m: total amount of points taken into account, that is we have (m-k_j) copies of diagonal
+    :returns: (K x 2) array, the weighted means of the k_j points with (m-k_j) copies of the diagonal
     '''
-    k = len(x)
-    if k > 0:
-        w = np.mean(x, axis=0)
-        w_delta = (w[0] + w[1]) / 2 * np.ones(2)
-        return (k * w + (m-k) * w_delta) / m
-    else:
-        return np.array([0, 0])
+    w = sums / counts[:, None]
+    w_delta = (w[:, 0] + w[:, 1]) / 2
+    return (counts[:, None] * w + ((m - counts) * w_delta)[:, None]) / m
+
+
+def _matchings(Y, X, n_jobs, **kwargs):
+    '''
+    :returns: the list of the optimal matchings between Y and each diagram of X, computed in parallel.
+    '''
+    match = lambda X_i: wasserstein_distance(Y, X_i, matching=True, order=2., internal_p=2., **kwargs)
+    if n_jobs is None or n_jobs == 1:
+        return [match(X_i) for X_i in X]
+    return Parallel(n_jobs=n_jobs, prefer="threads")(delayed(match)(X_i) for X_i in X)
 
 
-def lagrangian_barycenter(pdiagset, init=None, verbose=False):
+def lagrangian_barycenter(pdiagset, init=None, verbose=False, n_jobs=None, backend="pot", delta=0.01):
     '''
     :param pdiagset: a list of ``numpy.array`` of shape `(n x 2)` (`n` can variate), encoding a set of persistence
         diagrams with only finite coordinates.
@@ -42,6 +50,14 @@ def lagrangian_barycenter(pdiagset, init=None, verbose=False):
     :type init: ``int``, or (n x 2) ``np.array``
     :param verbose: if ``True``, returns additional information about the barycenter.
     :type verbose: boolean
+    :param n_jobs: number of threads computing the matchings to the diagrams of pdiagset at each iteration, as for
+        joblib (POT and Hera release the GIL).
+    :type n_jobs: int
+    :param backend: ``"pot"`` or ``"hera"``, passed to :func:`~gudhi.wasserstein.wasserstein_distance`. With Hera,
+        the matchings are only optimal up to a factor (1+delta), but they do not need a dense cost matrix.
+    :type backend: str
+    :param delta: relative error of the ``"hera"`` backend.
+    :type delta: float
     :returns: If not verbose (default), a ``numpy.array`` encoding the barycenter estimate of pdiagset
         (local minimum of the energy function).
         If ``pdiagset`` is empty, returns ``None``.
@@ -54,14 +70,13 @@ def lagrangian_barycenter(pdiagset, init=None, verbose=False):
 
         - `"nb_iter"`, ``int`` number of iterations performed before convergence of the algorithm.
     '''
-    X = pdiagset  # to shorten notations, not a copy
-    m = len(X)  # number of diagrams we are averaging
+    m = len(pdiagset)  # number of diagrams we are averaging
     if m == 0:
         warnings.warn("Computing barycenter of empty diag set. Returns None.")
         return None
+    X = [np.asarray(X_i, dtype=float).reshape(-1, 2) for X_i in pdiagset]
+    kwargs = dict(backend=backend, delta=delta) if backend != "pot" else {}
 
-    # store the number of off-diagonal point for each of the X_i
-    nb_off_diag = np.array([len(X_i) for X_i in X])
     # Initialisation of barycenter
     if init is None:
         i0 = np.random.randint(m)  # Index of first state for the barycenter
@@ -78,49 +93,34 @@ def lagrangian_barycenter(pdiagset, init=None, verbose=False):
     while not converged:
         nb_iter += 1
         K = len(Y)  # current nb of points in Y (some might be on diagonal)
-        G = np.full((K, m), -1, dtype=int)  # will store for each j, the (index)
-                              # point matched in each other diagram
-                              #(might be the diagonal).
-                              # that is G[j, i] = k <=> y_j is matched to
-                              # x_k in the diagram i-th diagram X[i]
-        updated_points = np.zeros((K, 2))  # will store the new positions of
-                                           # the points of Y.
-                                           # If points disappear, there thrown
-                                           # on [0,0] by default.
+        # For each point y_j of Y, the sum and the number of the off-diagonal points matched to it in the diagrams of X
+        # (the other diagrams match it to the diagonal).
+        sums = np.zeros((K, 2))
+        counts = np.zeros(K, dtype=int)
         new_created_points = []  # will store potential new points.
 
         # Step 1 : compute optimal matching (Y, X_i) for each X_i
         #          and create new points in Y if needed
-        for i in range(m):
-            _, indices = wasserstein_distance(Y, X[i], matching=True, order=2., internal_p=2.)
-            for y_j, x_i_j in indices:
-                if y_j >= 0:  # we matched an off diagonal point to x_i_j...
-                    if x_i_j >= 0:  # ...which is also an off-diagonal point.
-                        G[y_j, i] = x_i_j
-                    else:  # ...which is a diagonal point
-                        G[y_j, i] = -1  # -1 stands for the diagonal (mask)
-                else:  # We matched a diagonal point to x_i_j...
-                    if x_i_j >= 0:  # which is a off-diag point !
-                                                # need to create new point in Y
-                        new_y = _mean(np.array([X[i][x_i_j]]), m)
-                        # Average this point with (m-1) copies of Delta
-                        new_created_points.append(new_y)
-
-        # Step 2 : Update current point position thanks to groupings computed
-        to_delete = []
-        for j in range(K):
-            matched_points = [X[i][G[j, i]] for i in range(m) if G[j, i] > -1]
-            new_y_j = _mean(matched_points, m)
-            if not np.array_equal(new_y_j, np.array([0,0])):
-                updated_points[j] = new_y_j
-            else: # this points is no longer of any use.
-                to_delete.append(j)
-        # we remove the point to be deleted now.
-        updated_points = np.delete(updated_points, to_delete, axis=0)
+        for X_i, (_, indices) in zip(X, _matchings(Y, X, n_jobs, **kwargs)):
+            indices = np.asarray(indices, dtype=int).reshape(-1, 2)
+            y, x = indices[:, 0], indices[:, 1]
+            matched = (y >= 0) & (x >= 0)
+            np.add.at(sums, y[matched], X_i[x[matched]])
+            np.add.at(counts, y[matched], 1)
+            # A diagonal point matched to an off-diagonal point of X_i: a new point in Y, the average of that point
+            # with (m-1) copies of the diagonal
+            new_x = X_i[x[(y < 0) & (x >= 0)]]
+            if len(new_x):
+                new_created_points.append(_mean_with_diagonal(new_x, np.ones(len(new_x)), m))
+
+        # Step 2 : Update current point position thanks to groupings computed.
+        # The points no longer matched to any off-diagonal point are removed.
+        kept = counts > 0
+        updated_points = _mean_with_diagonal(sums[kept], counts[kept], m)
 
         # we cannot converge if there have been new created points.
         if new_created_points:
-            Y = np.concatenate((updated_points, new_created_points))
+            Y = np.concatenate([updated_points] + new_created_points)
         else:
             # Step 3 : we check convergence
             if np.array_equal(updated_points, Y):
@@ -133,8 +133,7 @@ def lagrangian_barycenter(pdiagset, init=None, verbose=False):
         energy = 0
         log = {}
         n_y = len(Y)
-        for i in range(m):
-            cost, edges = wasserstein_distance(Y, X[i], matching=True, order=2., internal_p=2.)
+        for cost, edges in _matchings(Y, X, n_jobs, **kwargs):
             groupings.append(edges)
             energy += cost
             log["groupings"] = groupings
@@ -197,6 +197,30 @@ def _finite_part(X):
     return X[np.where(np.isfinite(X[:,0]) & np.isfinite(X[:,1]))]
 
 
+def _autodiff_cost(X_orig, Y_orig, pairs_X_Y, pairs_X_diag, pairs_Y_diag, order, internal_p):
+    '''
+    :param X_orig: first diagram, as an eagerpy tensor.
+    :param Y_orig: second diagram, as an eagerpy tensor.
+    :param pairs_X_Y: (k x 2) array of the indices of the points matched together.
+    :param pairs_X_diag: tuple of the array of the indices of the points of X matched to the diagonal (as np.nonzero).
+    :param pairs_Y_diag: tuple of the array of the indices of the points of Y matched to the diagonal (as np.nonzero).
+    :returns: the cost of the matching, as a tensor of the framework of X_orig and Y_orig.
+    '''
+    import eagerpy as ep
+
+    dists = []
+    # empty arrays are not handled properly by the helpers, so we avoid calling them
+    if len(pairs_X_Y):
+        dists.append((Y_orig[pairs_X_Y[:, 1]] - X_orig[pairs_X_Y[:, 0]]).norms.lp(internal_p, axis=-1).norms.lp(order))
+    if len(pairs_X_diag[0]):
+        dists.append(_perstot_autodiff(X_orig[pairs_X_diag], order, internal_p))
+    if len(pairs_Y_diag[0]):
+        dists.append(_perstot_autodiff(Y_orig[pairs_Y_diag], order, internal_p))
+    dists = [dist.reshape(1) for dist in dists]
+    return ep.concatenate(dists).norms.lp(order).raw
+    # We can also concatenate the 3 vectors to compute just one norm.
+
+
 def _warn_infty(matching):
     '''
     Handle essential parts with different cardinalities. Warn the user about cost being infinite and (if
@@ -211,9 +235,10 @@ def _warn_infty(matching):
 
 
 def wasserstein_distance(X, Y, matching=False, order=1., internal_p=np.inf, enable_autodiff=False,
-                         keep_essential_parts=True):
+                         keep_essential_parts=True, backend="pot", delta=0.01):
     '''
-    Compute the Wasserstein distance between persistence diagram using Python Optimal Transport backend.
+    Compute the Wasserstein distance between persistence diagram using Python Optimal Transport backend, or the
+    auction algorithm of Hera.
     Diagrams can contain points with infinity coordinates (essential parts).
     Points with (-inf,-inf) and (+inf,+inf) coordinates are considered as belonging to the diagonal.
     If the distance between two diagrams is +inf (which happens if the cardinalities of essential
@@ -240,6 +265,13 @@ def wasserstein_distance(X, Y, matching=False, order=1., internal_p=np.inf, enab
     :param keep_essential_parts: If ``False``, only considers the finite points in the diagrams.
                                  Otherwise, include essential parts in cost and matching computation.
     :type keep_essential_parts: bool
+    :param backend: ``"pot"`` solves the exact transport problem with POT, on a dense cost matrix of size
+        (n+1) x (m+1). ``"hera"`` uses the auction algorithm of Hera, which searches the bids in kd-trees and never
+        builds the cost matrix, so it scales to much larger diagrams. It supports ``matching`` and
+        ``enable_autodiff``, and its cost is within a factor (1+delta) of the optimal one.
+    :type backend: str
+    :param delta: Relative error of the ``"hera"`` backend, unused by ``"pot"``.
+    :type delta: float
     :returns: The Wasserstein distance of order q (1 <= q < infinity) between persistence diagrams with
               respect to the internal_p-norm as ground metric.
               If matching is set to True, also returns the optimal matching between X and Y.
@@ -310,6 +342,28 @@ def wasserstein_distance(X, Y, matching=False, order=1., internal_p=np.inf, enab
     n = len(X)
     m = len(Y)
 
+    if backend == "hera":
+        from gudhi.hera import wasserstein_distance as hera_wasserstein_distance
+
+        # The finite parts only, so the matching indices refer to X and Y as above
+        ot_dist, match = hera_wasserstein_distance(X, Y, order=order, internal_p=internal_p, delta=delta,
+                                                   matching=True)
+        ot_cost = ot_dist ** order
+        match = np.asarray(match).reshape(-1, 2)
+        if matching:
+            assert not enable_autodiff, "matching and enable_autodiff are currently incompatible"
+            if essential_matching is not None:
+                match = np.concatenate([match, essential_matching]) if essential_matching.size else match
+            return (ot_cost + essential_cost) ** (1./order), match
+        if enable_autodiff:
+            pairs_X_Y = match[(match[:, 0] >= 0) & (match[:, 1] >= 0)]
+            pairs_X_diag = (match[match[:, 1] < 0, 0],)
+            pairs_Y_diag = (match[match[:, 0] < 0, 1],)
+            return _autodiff_cost(X_orig, Y_orig, pairs_X_Y, pairs_X_diag, pairs_Y_diag, order, internal_p)
+        return (ot_cost + essential_cost) ** (1./order)
+    elif backend != "pot":
+        raise ValueError("Unknown backend " + str(backend))
+
     M = _build_dist_matrix(X, Y, order=order, internal_p=internal_p)
     a = np.ones(n+1) # weight vector of the input diagram. Uniform here.
     a[-1] = m
@@ -335,17 +389,7 @@ def wasserstein_distance(X, Y, matching=False, order=1., internal_p=np.inf, enab
         pairs_X_Y = np.argwhere(P[:-1, :-1])
         pairs_X_diag = np.nonzero(P[:-1, -1])
         pairs_Y_diag = np.nonzero(P[-1, :-1])
-        dists = []
-        # empty arrays are not handled properly by the helpers, so we avoid calling them
-        if len(pairs_X_Y):
-            dists.append((Y_orig[pairs_X_Y[:, 1]] - X_orig[pairs_X_Y[:, 0]]).norms.lp(internal_p, axis=-1).norms.lp(order))
-        if len(pairs_X_diag[0]):
-            dists.append(_perstot_autodiff(X_orig[pairs_X_diag], order, internal_p))
-        if len(pairs_Y_diag[0]):
-            dists.append(_perstot_autodiff(Y_orig[pairs_Y_diag], order, internal_p))
-        dists = [dist.reshape(1) for dist in dists]
-        return ep.concatenate(dists).norms.lp(order).raw
-        # We can also concatenate the 3 vectors to compute just one norm.
+        return _autodiff_cost(X_orig, Y_orig, pairs_X_Y, pairs_X_diag, pairs_Y_diag, order, internal_p)
 
     # Comptuation of the ot cost using the ot.emd2 library.
     # Note: it is the Wasserstein distance to the power q.
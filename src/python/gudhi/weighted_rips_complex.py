@@ -7,7 +7,7 @@
 # Modification(s):
 #   - YYYY/MM Author: Description of the modification
 
-from gudhi import SimplexTree
+from gudhi.rips_complex import _weighted_rips_simplex_tree
 
 class WeightedRipsComplex:
     """
@@ -40,22 +40,4 @@ class WeightedRipsComplex:
         Args:
             max_dimension (int): graph expansion until this given dimension.
         """
-        dist = self.distance_matrix
-        F = self.weights
-        num_pts = len(dist)
-        
-        st = SimplexTree()
-        
-        for i in range(num_pts):
-            if 2*F[i] <= self.max_filtration:
-                st.insert([i], 2*F[i])
-        for i in range(num_pts):
-            for j in range(i):
-                value = max(2*F[i], 2*F[j], dist[i][j] + F[i] + F[j])
-                # max is needed when F is not 1-Lipschitz
-                if value <= self.max_filtration:
-                    st.insert([i,j], filtration=value)
-                    
-        st.expansion(max_dimension) 
-        return st
-        
+        return _weighted_rips_simplex_tree(self.distance_matrix, self.weights, self.max_filtration, max_dimension)
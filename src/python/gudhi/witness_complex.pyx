@@ -65,6 +65,10 @@ cdef class WitnessComplex:
         :type max_alpha_square: float
         :returns: A simplex tree created from the Delaunay Triangulation.
         :rtype: SimplexTree
+
+        The filtration value of a simplex is the smallest relaxation for which it is in the complex, so that the
+        complex of a smaller relaxation `a` is obtained with
+        :func:`~gudhi.SimplexTree.prune_above_filtration` (`a`) instead of being created again.
         """
         stree = SimplexTree()
         cdef intptr_t stree_int_ptr=stree.thisptr
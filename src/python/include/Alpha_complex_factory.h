@@ -19,6 +19,7 @@
 #include <CGAL/Epick_d.h>
 
 #include <boost/range/adaptor/transformed.hpp>
+#include <boost/range/value_type.hpp>
 
 #include "Simplex_tree_interface.h"
 
@@ -58,12 +59,16 @@ struct Point_cgal_to_cython<CgalPointType, true> {
   }
 };
 
-// Function that transforms a cython point (aka. a vector of double) to a CGAL point
-template <typename CgalPointType>
-static CgalPointType pt_cython_to_cgal(std::vector<double> const& vec) {
+// Function that transforms a cython point (aka. a vector of double, or a Strided_point read in place from a numpy
+// array) to a CGAL point
+template <typename CgalPointType, typename InputPoint = std::vector<double>>
+static CgalPointType pt_cython_to_cgal(InputPoint const& vec) {
   return CgalPointType(vec.size(), vec.begin(), vec.end());
 }
 
+template <typename PointRange>
+using Input_point = typename boost::range_value<PointRange>::type;
+
 class Abstract_alpha_complex {
  public:
   virtual std::vector<double> get_point(int vh) = 0;
@@ -85,15 +90,17 @@ class Exact_alpha_complex_dD final : public Abstract_alpha_complex {
                                              typename Kernel::Point_d>;
 
  public:
-  Exact_alpha_complex_dD(const std::vector<std::vector<double>>& points, bool exact_version)
+  template <typename PointRange>
+  Exact_alpha_complex_dD(const PointRange& points, bool exact_version)
     : exact_version_(exact_version),
-      alpha_complex_(boost::adaptors::transform(points, pt_cython_to_cgal<Bare_point>)) {
+      alpha_complex_(boost::adaptors::transform(points, pt_cython_to_cgal<Bare_point, Input_point<PointRange>>)) {
   }
 
-  Exact_alpha_complex_dD(const std::vector<std::vector<double>>& points,
-                           const std::vector<double>& weights, bool exact_version)
+  template <typename PointRange>
+  Exact_alpha_complex_dD(const PointRange& points, const std::vector<double>& weights, bool exact_version)
     : exact_version_(exact_version),
-      alpha_complex_(boost::adaptors::transform(points, pt_cython_to_cgal<Bare_point>), weights) {
+      alpha_complex_(boost::adaptors::transform(points, pt_cython_to_cgal<Bare_point, Input_point<PointRange>>),
+                     weights) {
   }
 
   virtual std::vector<double> get_point(int vh) override {
@@ -124,12 +131,15 @@ class Inexact_alpha_complex_dD final : public Abstract_alpha_complex {
                                              typename Kernel::Point_d>;
 
  public:
-  Inexact_alpha_complex_dD(const std::vector<std::vector<double>>& points)
-    : alpha_complex_(boost::adaptors::transform(points, pt_cython_to_cgal<Bare_point>)) {
+  template <typename PointRange>
+  Inexact_alpha_complex_dD(const PointRange& points)
+    : alpha_complex_(boost::adaptors::transform(points, pt_cython_to_cgal<Bare_point, Input_point<PointRange>>)) {
   }
 
-  Inexact_alpha_complex_dD(const std::vector<std::vector<double>>& points, const std::vector<double>& weights)
-    : alpha_complex_(boost::adaptors::transform(points, pt_cython_to_cgal<Bare_point>), weights) {
+  template <typename PointRange>
+  Inexact_alpha_complex_dD(const PointRange& points, const std::vector<double>& weights)
+    : alpha_complex_(boost::adaptors::transform(points, pt_cython_to_cgal<Bare_point, Input_point<PointRange>>),
+                     weights) {
   }
 
   virtual std::vector<double> get_point(int vh) override {
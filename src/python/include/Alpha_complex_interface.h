@@ -15,11 +15,13 @@
 #include <gudhi/Alpha_complex_options.h>
 
 #include "Simplex_tree_interface.h"
+#include "Strided_points.h"
 
 #include <iostream>
 #include <vector>
 #include <string>
 #include <memory>  // for std::unique_ptr
+#include <cstddef>  // for std::size_t, std::ptrdiff_t
 
 namespace Gudhi {
 
@@ -30,20 +32,15 @@ class Alpha_complex_interface {
   Alpha_complex_interface(const std::vector<std::vector<double>>& points,
                           const std::vector<double>& weights,
                           bool fast_version, bool exact_version) {
-    const bool weighted = (weights.size() > 0);
-    if (fast_version) {
-      if (weighted) {
-        alpha_ptr_ = std::make_unique<Inexact_alpha_complex_dD<true>>(points, weights);
-      } else {
-        alpha_ptr_ = std::make_unique<Inexact_alpha_complex_dD<false>>(points);
-      }
-    } else {
-      if (weighted) {
-        alpha_ptr_ = std::make_unique<Exact_alpha_complex_dD<true>>(points, weights, exact_version);
-      } else {
-        alpha_ptr_ = std::make_unique<Exact_alpha_complex_dD<false>>(points, exact_version);
-      }
-    }
+    init(points, weights, fast_version, exact_version);
+  }
+
+  // Points read in place from a 2d buffer of float or double, with strides in bytes, cf. Strided_points.h
+  template <typename T>
+  Alpha_complex_interface(const T* data, std::size_t num_points, std::size_t dimension, std::ptrdiff_t stride0,
+                          std::ptrdiff_t stride1, const std::vector<double>& weights, bool fast_version,
+                          bool exact_version) {
+    init(strided_points(data, num_points, dimension, stride0, stride1), weights, fast_version, exact_version);
   }
 
   std::vector<double> get_point(int vh) {
@@ -68,6 +65,24 @@ class Alpha_complex_interface {
   }
 
  private:
+  template <typename PointRange>
+  void init(const PointRange& points, const std::vector<double>& weights, bool fast_version, bool exact_version) {
+    const bool weighted = (weights.size() > 0);
+    if (fast_version) {
+      if (weighted) {
+        alpha_ptr_ = std::make_unique<Inexact_alpha_complex_dD<true>>(points, weights);
+      } else {
+        alpha_ptr_ = std::make_unique<Inexact_alpha_complex_dD<false>>(points);
+      }
+    } else {
+      if (weighted) {
+        alpha_ptr_ = std::make_unique<Exact_alpha_complex_dD<true>>(points, weights, exact_version);
+      } else {
+        alpha_ptr_ = std::make_unique<Exact_alpha_complex_dD<false>>(points, exact_version);
+      }
+    }
+  }
+
   std::unique_ptr<Abstract_alpha_complex> alpha_ptr_;
 };
 
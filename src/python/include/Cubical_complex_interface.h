@@ -15,6 +15,9 @@
 #include <gudhi/Bitmap_cubical_complex_base.h>
 #include <gudhi/Bitmap_cubical_complex_periodic_boundary_conditions_base.h>
 
+#include <boost/range/iterator_range.hpp>
+
+#include <cstddef>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -31,6 +34,12 @@ class Cubical_complex_interface : public Bitmap_cubical_complex<Bitmap_cubical_c
   using Base::Base; // inheriting constructors
   using Base::data;
 
+  // Reads the buffer of a contiguous numpy array of any supported dtype, without converting it to a vector<double>
+  template <class Value>
+  Cubical_complex_interface(const std::vector<unsigned>& dimensions, const Value* cells, std::size_t size,
+                            bool input_top_cells)
+      : Base(dimensions, boost::make_iterator_range(cells, cells + size), input_top_cells) {}
+
   // not const because cython does not handle const very well
   std::vector<unsigned>& shape() { return this->sizes; };
 };
@@ -0,0 +1,279 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file Cubical_multi_filtration.h
+ * @brief Multi-parameter filtrations of cubical complexes, exported to scc2020 or sliced along lines, without going
+ * through a simplex tree.
+ */
+
+#ifndef CUBICAL_MULTI_FILTRATION_H_
+#define CUBICAL_MULTI_FILTRATION_H_
+
+#include <gudhi/Bitmap_cubical_complex.h>
+#include <gudhi/Bitmap_cubical_complex_base.h>
+#include <gudhi/Persistent_cohomology.h>
+#include "Simplex_tree_multi_scc.h"
+#include "multi_filtrations/filtration_table.h"
+#include "multi_filtrations/line.h"
+
+#include <boost/range/iterator_range.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+namespace Gudhi::multiparameter {
+
+namespace internal {
+
+// Cubical complex whose filtration values can be replaced, the structure (and its copies) being reused from one
+// line to the next.
+template<class T>
+class Cubical_slice : public cubical_complex::Bitmap_cubical_complex<cubical_complex::Bitmap_cubical_complex_base<T>> {
+	using Base = cubical_complex::Bitmap_cubical_complex<cubical_complex::Bitmap_cubical_complex_base<T>>;
+public:
+	Cubical_slice(const std::vector<unsigned>& sizes, const T* cells, std::size_t num_cells, bool input_top_cells)
+		: Base(sizes, boost::make_iterator_range(cells, cells + num_cells), input_top_cells) {}
+
+	// values are indexed like the cells of the bitmap.
+	void assign_filtration_values(const std::vector<T>& values){
+		std::copy(values.begin(), values.end(), this->data.begin());
+		this->initialize_filtration();
+	}
+};
+
+}  // namespace internal
+
+/**
+ * @brief Multi-parameter filtration of a cubical complex, given by several values on each top-dimensional cell or on
+ * each vertex.
+ *
+ * The values of the cells are stored parameter by parameter in a Filtration_table, indexed like the cells of
+ * the bitmap, and the boundaries are those of Bitmap_cubical_complex_base, so that the filtration can be written in
+ * the scc2020 format or restricted to lines without building a simplicial complex.
+ *
+ * With values on the vertices, a cell gets the coordinate-wise maximum of the values of its vertices, which is
+ * exactly the multi-parameter lower-star filtration. With values on the top-dimensional cells, a cell gets the
+ * coordinate-wise minimum of the values of its top-dimensional cofaces. The exact filtration would be multi-critical
+ * (a cell appears as soon as one of its cofaces does), this 1-critical one enters each cell at the meet of
+ * its critical values, and both agree when there is a single parameter.
+ */
+template<class T>
+class Cubical_multi_filtration {
+public:
+	using value_type = T;
+	using Line = multi_filtrations::Line<T>;
+	using Barcode = std::vector<std::pair<double, double>>;
+	using Field_Zp = persistent_cohomology::Field_Zp;
+
+	/**
+	 * @param[in] sizes Shape of the top-dimensional cells if `input_top_cells` is `true`, of the vertices otherwise,
+	 * in Fortran order.
+	 * @param[in] values `num_parameters` consecutive blocks, one per parameter, of one value per input cell (in the
+	 * same order as the constructors of Bitmap_cubical_complex).
+	 * @param[in] num_parameters Number of parameters.
+	 * @param[in] input_top_cells Whether the values are given on the top-dimensional cells or on the vertices.
+	 * @exception std::invalid_argument If the number of values does not match the sizes.
+	 */
+	Cubical_multi_filtration(const std::vector<unsigned>& sizes, const std::vector<T>& values,
+			std::size_t num_parameters, bool input_top_cells = true)
+		: slice_(sizes, values.data(), checked_num_input_cells(sizes, values, num_parameters), input_top_cells),
+		  table_(num_parameters, slice_.num_simplices()) {
+		const std::size_t num_input_cells = values.size() / num_parameters;
+		for (std::size_t cell = 0; cell < slice_.num_simplices(); cell++)
+			table_.dimension(cell) = static_cast<int>(slice_.get_dimension_of_a_cell(cell));
+		for (std::size_t parameter = 0; parameter < num_parameters; parameter++){
+			internal::Cubical_slice<T> filtration(sizes, values.data() + parameter * num_input_cells, num_input_cells, input_top_cells);
+			T* out = table_.parameter(parameter);
+			for (std::size_t cell = 0; cell < filtration.num_simplices(); cell++)
+				out[cell] = filtration.get_cell_data(cell);
+		}
+	}
+
+	std::size_t num_parameters() const { return table_.num_parameters(); }
+	std::size_t num_cells() const { return table_.num_simplices(); }
+	int dimension() const { return static_cast<int>(slice_.dimension()); }
+	/** Value of the parameter `parameter` on the cell `cell` of the bitmap. */
+	T filtration(std::size_t parameter, std::size_t cell) const { return table_(parameter, cell); }
+
+	// Line parameter of the push forward of the filtration values on l, indexed by cells. A zero component of the
+	// direction leaves the cells below the basepoint in this parameter unconstrained, and the others at infinity.
+	void push_forward(const Line& l, std::vector<T>& out) const {
+		const std::size_t n = table_.num_simplices();
+		out.assign(n, -std::numeric_limits<T>::infinity());
+		const auto& basepoint = l.basepoint();
+		const auto& direction = l.direction();
+		const std::size_t size = std::min(table_.num_parameters(), basepoint.size());
+		for (std::size_t parameter = 0; parameter < size; parameter++){
+			const T b = basepoint[parameter];
+			const T d = direction.size() > parameter ? direction[parameter] : 1;
+			const T* values = table_.parameter(parameter);
+			T* t = out.data();
+			if (d == 0){
+				for (std::size_t cell = 0; cell < n; cell++)
+					if (values[cell] > b) t[cell] = std::numeric_limits<T>::infinity();
+				continue;
+			}
+			for (std::size_t cell = 0; cell < n; cell++)
+				t[cell] = std::max(t[cell], (values[cell] - b) / d);
+		}
+	}
+
+	/**
+	 * @brief Barcodes of the filtration restricted to each line, in the given homological degrees, with the same
+	 * conventions as Line_slicer::barcodes.
+	 * @return out[line][i] is the barcode in degree `degrees[i]` of the line `lines[line]`.
+	 */
+	std::vector<std::vector<Barcode>> barcodes(const std::vector<Line>& lines, const std::vector<int>& degrees,
+			int coefficient_field = 11, double min_persistence = 0) const {
+		using Persistent_cohomology = persistent_cohomology::Persistent_cohomology<internal::Cubical_slice<T>, Field_Zp>;
+		std::vector<std::vector<Barcode>> out(lines.size());
+		const bool persistence_dim_max = !degrees.empty() && *std::max_element(degrees.begin(), degrees.end()) >= dimension();
+		auto compute = [&](Worker& worker, std::size_t line){
+			push_forward(lines[line], worker.values);
+			worker.slice.assign_filtration_values(worker.values);
+			Persistent_cohomology pcoh(worker.slice, persistence_dim_max);
+			pcoh.init_coefficients(coefficient_field);
+			pcoh.compute_persistent_cohomology(static_cast<T>(min_persistence));
+			out[line].reserve(degrees.size());
+			for (int degree : degrees){
+				const auto intervals = pcoh.intervals_in_dimension(degree);
+				out[line].emplace_back(intervals.begin(), intervals.end());
+			}
+		};
+#ifdef GUDHI_USE_TBB
+		tbb::enumerable_thread_specific<Worker> workers([&](){ return Worker(slice_); });
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0, lines.size()), [&](const tbb::blocked_range<std::size_t>& range){
+			Worker& worker = workers.local();
+			for (std::size_t line = range.begin(); line < range.end(); line++)
+				compute(worker, line);
+		});
+#else
+		Worker worker(slice_);
+		for (std::size_t line = 0; line < lines.size(); line++)
+			compute(worker, line);
+#endif
+		return out;
+	}
+
+	/**
+	 * @brief Writes the chain complex in the scc2020 format (or its binary variant), with the same options as write_scc.
+	 *
+	 * The block of dimension d contains the cells of dimension d, in the order of the bitmap, and the boundaries are
+	 * given as indices in the block of dimension d-1. As for simplex trees, the coefficients of the boundaries are not
+	 * written, which is enough over \f$\mathbb{Z}/2\mathbb{Z}\f$.
+	 */
+	void write_scc(const std::string& path, const Scc_writer_options& options = {}) const {
+		const std::size_t num_parameters = table_.num_parameters();
+		if (options.rivet_compatible && num_parameters != 2)
+			throw std::invalid_argument("The firep format requires 2 parameters.");
+		const int dim_max = dimension();
+		const std::size_t n = table_.num_simplices();
+
+		std::vector<std::uint32_t> index_in_block(n);
+		std::vector<std::vector<std::size_t>> blocks(dim_max + 1);
+		for (std::size_t cell = 0; cell < n; cell++){
+			auto& block = blocks[table_.dimension(cell)];
+			index_in_block[cell] = static_cast<std::uint32_t>(block.size());
+			block.push_back(cell);
+		}
+
+		internal::Scc_buffered_writer out(path, options.binary);
+		if (options.binary){
+			out.write("SCCB", 4);
+			out.write_raw(static_cast<std::uint32_t>(1));
+			out.write_raw(static_cast<std::uint32_t>(num_parameters));
+			out.write_raw(static_cast<std::uint32_t>(blocks.size()));
+			for (int dim = dim_max; dim >= 0; dim--) out.write_raw(static_cast<std::uint64_t>(blocks[dim].size()));
+		} else {
+			out.write(options.rivet_compatible ? "firep\n" : "scc2020\n");
+			if (options.rivet_compatible){
+				out.write("Filtration 1\nFiltration 2\n");
+			} else {
+				if (!options.strip_comments) out.write("# Number of parameters\n");
+				out.write_number(num_parameters);
+				out.write('\n');
+			}
+			if (!options.strip_comments) out.write("# Sizes of generating sets\n");
+			for (int dim = dim_max; dim >= 0; dim--){
+				if (dim < dim_max) out.write(' ');
+				out.write_number(blocks[dim].size());
+			}
+			out.write('\n');
+		}
+
+		const int last_block = options.ignore_last_generators ? 1 : 0;
+		for (int dim = dim_max; dim >= last_block; dim--){
+			if (!options.binary && !options.strip_comments){
+				out.write("# Block of dimension ");
+				out.write_number(dim);
+				out.write('\n');
+			}
+			auto& block = blocks[dim];
+			if (options.reverse_block) std::reverse(block.begin(), block.end());
+			for (auto cell : block){
+				if (options.binary){
+					for (std::size_t parameter = 0; parameter < num_parameters; parameter++)
+						out.write_raw(table_(parameter, cell));
+					out.write_raw(static_cast<std::uint32_t>(2 * dim));
+					for (auto face : slice_.boundary_range(cell)) out.write_raw(index_in_block[face]);
+				} else {
+					for (std::size_t parameter = 0; parameter < num_parameters; parameter++){
+						if (parameter > 0) out.write(' ');
+						out.write_number(table_(parameter, cell));
+					}
+					out.write(" ;");
+					for (auto face : slice_.boundary_range(cell)){
+						out.write(' ');
+						out.write_number(index_in_block[face]);
+					}
+					out.write('\n');
+				}
+			}
+		}
+		out.close();
+	}
+
+private:
+	static std::size_t checked_num_input_cells(const std::vector<unsigned>& sizes, const std::vector<T>& values,
+			std::size_t num_parameters){
+		std::size_t num_input_cells = 1;
+		for (auto size : sizes) num_input_cells *= size;
+		if (num_parameters == 0 || values.size() != num_input_cells * num_parameters)
+			throw std::invalid_argument("The number of values does not match the sizes and the number of parameters.");
+		return num_input_cells;
+	}
+
+	// Per-thread copy of the cubical complex.
+	struct Worker {
+		Worker(const internal::Cubical_slice<T>& slice) : slice(slice) {}
+		internal::Cubical_slice<T> slice;
+		std::vector<T> values;
+	};
+
+	// Structure of the complex; its own filtration values are those of the first parameter, and are not used.
+	internal::Cubical_slice<T> slice_;
+	multi_filtrations::Filtration_table<T> table_;
+};
+
+}  // namespace Gudhi::multiparameter
+
+#endif  // CUBICAL_MULTI_FILTRATION_H_
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <utility>  // for std::pair, std::move
 
 namespace Gudhi {
 
@@ -39,6 +40,11 @@ class Nerve_gic_interface : public Cover_complex<std::vector<double>> {
   void set_graph_from_euclidean_rips(double threshold) {
     set_graph_from_rips(threshold, Gudhi::Euclidean_distance());
   }
+  void create_simplex_trees_from_sweep(const std::vector<std::pair<int, double>>& parameters,
+                                       const std::vector<Simplex_tree_interface<>*>& simplex_trees) {
+    auto complexes = sweep_cover_from_function<Simplex_tree_interface<>>(parameters);
+    for (std::size_t k = 0; k < complexes.size(); k++) *simplex_trees[k] = std::move(complexes[k]);
+  }
 };
 
 }  // namespace cover_complex
@@ -12,10 +12,18 @@
 #define INCLUDE_PERSISTENT_COHOMOLOGY_INTERFACE_H_
 
 #include <gudhi/Persistent_cohomology.h>
+#include <gudhi/Persistent_matrix_reduction.h>
 #include <gudhi/Simplex_tree.h>  // for Extended_simplex_type
+#include <gudhi/writing_persistence_to_file.h>  // for Persistence_diagram_binary_writer
 
+#include "Thread_pool.h"
 
 #include <cstdlib>
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::uintptr_t
+#include <fstream>
+#include <limits>
+#include <string>
 #include <vector>
 #include <utility>  // for std::pair
 #include <algorithm>  // for sort
@@ -50,12 +58,49 @@ persistent_cohomology::Persistent_cohomology<FilteredComplex, persistent_cohomol
       : Base(*stptr, persistence_dim_max),
         stptr_(stptr) { }
 
+  // Reuses the memory of the previous computation for a new one on the same, possibly modified, complex.
+  void reset(bool persistence_dim_max) {
+    Base::reset(*stptr_, persistence_dim_max);
+  }
+
   // TODO: move to the constructors?
   void compute_persistence(int homology_coeff_field, double min_persistence) {
     Base::init_coefficients(homology_coeff_field);
     Base::compute_persistent_cohomology(min_persistence);
   }
 
+  // Same as compute_persistence, with a reduction of the boundary matrix instead of the annotation-based algorithm if
+  // matrix_reduction is true. The pairs are the same, up to the order.
+  void compute_persistence(int homology_coeff_field, double min_persistence, bool matrix_reduction) {
+    if (!matrix_reduction) {
+      compute_persistence(homology_coeff_field, min_persistence);
+      return;
+    }
+    Base::init_coefficients(homology_coeff_field);
+    persistent_cohomology::Persistent_matrix_reduction<FilteredComplex, persistent_cohomology::Field_Zp>
+        reduction(*stptr_, Base::dim_max_ > stptr_->dimension());
+    reduction.init_coefficients(homology_coeff_field);
+    reduction.compute_persistent_cohomology(min_persistence);
+    Base::persistent_pairs_ = reduction.get_persistent_pairs();
+  }
+
+  // Same as compute_persistence, until the filtration value max_filtration and the dimension max_dimension. The
+  // simplices after them are not sorted.
+  void compute_persistence(int homology_coeff_field, double min_persistence, double max_filtration,
+                           int max_dimension) {
+    stptr_->initialize_filtration(max_filtration, max_dimension + 1);
+    Base::init_coefficients(homology_coeff_field);
+    try {
+      Base::compute_persistent_cohomology(min_persistence, max_filtration, max_dimension);
+    } catch (...) {
+      // e.g. Cancelled
+      stptr_->clear_filtration();
+      throw;
+    }
+    // The truncated filtration cache must not be seen by the other functions of the complex
+    stptr_->clear_filtration();
+  }
+
   std::vector<std::pair<int, std::pair<double, double>>> get_persistence() {
     std::vector<std::pair<int, std::pair<double, double>>> persistence;
     auto const& persistent_pairs = Base::get_persistent_pairs();
@@ -71,6 +116,46 @@ persistent_cohomology::Persistent_cohomology<FilteredComplex, persistent_cohomol
     return persistence;
   }
 
+  // Writes get_persistence() in the binary persistence diagram format, with one block per dimension in which the
+  // intervals keep their order.
+  void write_persistence_binary(const std::string& file_name) {
+    std::ofstream out(file_name, std::ios::binary);
+    out.exceptions(out.failbit | out.badbit);
+    Persistence_diagram_binary_writer<double> writer(out, std::numeric_limits<std::size_t>::max() / 2);
+    for (auto const& [dim, interval] : get_persistence()) writer.write(dim, interval.first, interval.second);
+  }
+
+  // Same as get_persistence, restricted to the max_intervals longest intervals in each dimension. They are selected
+  // with a bounded heap per dimension while going through the pairs, so the other ones are never stored.
+  std::vector<std::pair<int, std::pair<double, double>>> get_persistence(std::size_t max_intervals) {
+    typedef std::pair<int, std::pair<double, double>> Interval;
+    cmp_intervals_by_dim_then_length cmp;
+    // The top of each heap is the shortest interval kept in this dimension
+    std::vector<std::vector<Interval>> heaps;
+    if (max_intervals == 0) return {};
+    for (auto const& pair : Base::get_persistent_pairs()) {
+      std::size_t dim = stptr_->dimension(get<0>(pair));
+      if (dim >= heaps.size()) heaps.resize(dim + 1);
+      std::vector<Interval>& heap = heaps[dim];
+      Interval interval(dim, std::make_pair(stptr_->filtration(get<0>(pair)), stptr_->filtration(get<1>(pair))));
+      if (heap.size() < max_intervals) {
+        heap.push_back(interval);
+        std::push_heap(heap.begin(), heap.end(), cmp);
+      } else if (cmp(interval, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        heap.back() = interval;
+        std::push_heap(heap.begin(), heap.end(), cmp);
+      }
+    }
+    // Same order as get_persistence: decreasing dimension, then decreasing length
+    std::vector<Interval> persistence;
+    for (auto heap = heaps.rbegin(); heap != heaps.rend(); ++heap) {
+      std::sort_heap(heap->begin(), heap->end(), cmp);
+      persistence.insert(persistence.end(), heap->begin(), heap->end());
+    }
+    return persistence;
+  }
+
   // This function computes the top-dimensional cofaces associated to the positive and negative
   // simplices of a cubical complex. The output format is a vector of vectors of three integers,
   // which are [homological dimension, index of top-dimensional coface of positive simplex,
@@ -178,89 +263,92 @@ persistent_cohomology::Persistent_cohomology<FilteredComplex, persistent_cohomol
     return persistence_pairs;
   }
 
-  // TODO: (possibly at the python level)
-  // - an option to return only some of those vectors?
-  typedef std::pair<std::vector<std::vector<int>>, std::vector<std::vector<int>>> Generators;
+  // Number of persistence intervals in each dimension, until the last dimension that has some, to allocate the arrays
+  // of fill_intervals_by_dimension.
+  std::vector<std::size_t> num_intervals_by_dimension() {
+    std::vector<std::size_t> counts;
+    for (auto const& pair : Base::get_persistent_pairs()) {
+      std::size_t dim = stptr_->dimension(get<0>(pair));
+      if (counts.size() < dim + 1) counts.resize(dim + 1);
+      ++counts[dim];
+    }
+    return counts;
+  }
+
+  // intervals[i] is the address of an array with 2 columns and as many rows as intervals of dimension i, according to
+  // num_intervals_by_dimension, of float if single_precision and of double otherwise, which is filled with their
+  // births and deaths, in the order of intervals_in_dimension.
+  void fill_intervals_by_dimension(const std::vector<std::uintptr_t>& intervals, bool single_precision) {
+    if (single_precision)
+      fill_intervals_by_dimension<float>(intervals);
+    else
+      fill_intervals_by_dimension<double>(intervals);
+  }
+
+  // Number of regular and essential persistence pairs in each dimension, until the last dimension that has some, to
+  // allocate the arrays of fill_lower_star_generators and fill_flag_generators.
+  std::pair<std::vector<std::size_t>, std::vector<std::size_t>> num_generators_by_dimension() {
+    std::pair<std::vector<std::size_t>, std::vector<std::size_t>> counts;
+    for (auto pair : Base::get_persistent_pairs()) {
+      std::size_t dim = stptr_->dimension(std::get<0>(pair));
+      auto& count = std::get<1>(pair) == stptr_->null_simplex() ? counts.second : counts.first;
+      if (count.size() < dim + 1) count.resize(dim + 1);
+      ++count[dim];
+    }
+    return counts;
+  }
 
-  Generators lower_star_generators() {
-    Generators out;
-    // diags[i] should be interpreted as vector<array<int,2>>
-    auto& diags = out.first;
-    // diagsinf[i] should be interpreted as vector<int>
-    auto& diagsinf = out.second;
+  // regular[i] (resp. essential[i]) is the address of an array of int with 2 (resp. 1) columns and as many rows as
+  // regular (resp. essential) pairs of dimension i, according to num_generators_by_dimension, which is filled with the
+  // vertices that gave their filtration values to the simplices of the pairs.
+  void fill_lower_star_generators(const std::vector<std::uintptr_t>& regular,
+                                  const std::vector<std::uintptr_t>& essential) {
+    std::vector<int*> regular_out(regular.size()), essential_out(essential.size());
+    std::transform(regular.begin(), regular.end(), regular_out.begin(), [](std::uintptr_t p) { return (int*)p; });
+    std::transform(essential.begin(), essential.end(), essential_out.begin(), [](std::uintptr_t p) { return (int*)p; });
     for (auto pair : Base::get_persistent_pairs()) {
       auto s = std::get<0>(pair);
       auto t = std::get<1>(pair);
       int dim = stptr_->dimension(s);
-      auto v = stptr_->vertex_with_same_filtration(s);
-      if(t == stptr_->null_simplex()) {
-        while(diagsinf.size() < dim+1) diagsinf.emplace_back();
-        diagsinf[dim].push_back(v);
+      int v = stptr_->vertex_with_same_filtration(s);
+      if (t == stptr_->null_simplex()) {
+        *essential_out[dim]++ = v;
       } else {
-        while(diags.size() < dim+1) diags.emplace_back();
-        auto w = stptr_->vertex_with_same_filtration(t);
-        auto& d = diags[dim];
-        d.insert(d.end(), { v, w });
+        int*& d = regular_out[dim];
+        *d++ = v;
+        *d++ = stptr_->vertex_with_same_filtration(t);
       }
     }
-    return out;
   }
 
+  // Same as fill_lower_star_generators, with the vertices of the edges that gave their filtration values to the
+  // simplices. regular[0] has 3 columns (a vertex and an edge) and the other regular[i] have 4 columns (two edges),
+  // essential[0] has 1 column (a vertex) and the other essential[i] have 2 columns (an edge).
   // An alternative, to avoid those different sizes, would be to "pad" vertex generator v as (v, v) or (v, -1). When using it as index, this corresponds to adding the vertex filtration values either on the diagonal of the distance matrix, or as an extra row or column.
-  // We could also merge the vectors for different dimensions into a single one, with an extra column for the dimension (converted to type double).
-  Generators flag_generators() {
-    Generators out;
-    // diags[0] should be interpreted as vector<array<int,3>> and other diags[i] as vector<array<int,4>>
-    auto& diags = out.first;
-    // diagsinf[0] should be interpreted as vector<int> and other diagsinf[i] as vector<array<int,2>>
-    auto& diagsinf = out.second;
+  void fill_flag_generators(const std::vector<std::uintptr_t>& regular, const std::vector<std::uintptr_t>& essential) {
+    std::vector<int*> regular_out(regular.size()), essential_out(essential.size());
+    std::transform(regular.begin(), regular.end(), regular_out.begin(), [](std::uintptr_t p) { return (int*)p; });
+    std::transform(essential.begin(), essential.end(), essential_out.begin(), [](std::uintptr_t p) { return (int*)p; });
+    // Writes the vertices of the edge that gave its filtration value to simplex
+    auto write_edge = [this](auto simplex, int*& d) {
+      auto&& vertices = stptr_->simplex_vertex_range(stptr_->edge_with_same_filtration(simplex));
+      auto it = std::begin(vertices);
+      *d++ = *it;
+      *d++ = *++it;
+      GUDHI_CHECK(++it==std::end(vertices), "must be an edge");
+    };
     for (auto pair : Base::get_persistent_pairs()) {
       auto s = std::get<0>(pair);
       auto t = std::get<1>(pair);
       int dim = stptr_->dimension(s);
-      bool infinite = t == stptr_->null_simplex();
-      if(infinite) {
-        if(dim == 0) {
-          auto v = *std::begin(stptr_->simplex_vertex_range(s));
-          if(diagsinf.size()==0)diagsinf.emplace_back();
-          diagsinf[0].push_back(v);
-        } else {
-          auto e = stptr_->edge_with_same_filtration(s);
-          auto&& e_vertices = stptr_->simplex_vertex_range(e);
-          auto i = std::begin(e_vertices);
-          auto v1 = *i;
-          auto v2 = *++i;
-          GUDHI_CHECK(++i==std::end(e_vertices), "must be an edge");
-          while(diagsinf.size() < dim+1) diagsinf.emplace_back();
-          auto& d = diagsinf[dim];
-          d.insert(d.end(), { v1, v2 });
-        }
+      int*& d = t == stptr_->null_simplex() ? essential_out[dim] : regular_out[dim];
+      if (dim == 0) {
+        *d++ = *std::begin(stptr_->simplex_vertex_range(s));
       } else {
-        auto et = stptr_->edge_with_same_filtration(t);
-        auto&& et_vertices = stptr_->simplex_vertex_range(et);
-        auto it = std::begin(et_vertices);
-        auto w1 = *it;
-        auto w2 = *++it;
-        GUDHI_CHECK(++it==std::end(et_vertices), "must be an edge");
-        if(dim == 0) {
-          auto v = *std::begin(stptr_->simplex_vertex_range(s));
-          if(diags.size()==0)diags.emplace_back();
-          auto& d = diags[0];
-          d.insert(d.end(), { v, w1, w2 });
-        } else {
-          auto es = stptr_->edge_with_same_filtration(s);
-          auto&& es_vertices = stptr_->simplex_vertex_range(es);
-          auto is = std::begin(es_vertices);
-          auto v1 = *is;
-          auto v2 = *++is;
-          GUDHI_CHECK(++is==std::end(es_vertices), "must be an edge");
-          while(diags.size() < dim+1) diags.emplace_back();
-          auto& d = diags[dim];
-          d.insert(d.end(), { v1, v2, w1, w2 });
-        }
+        write_edge(s, d);
       }
+      if (t != stptr_->null_simplex()) write_edge(t, d);
     }
-    return out;
   }
 
   using Filtration_value = typename FilteredComplex::Filtration_value;
@@ -270,7 +358,8 @@ persistent_cohomology::Persistent_cohomology<FilteredComplex, persistent_cohomol
   Persistence_subdiagrams compute_extended_persistence_subdiagrams(Filtration_value min_persistence){
     Persistence_subdiagrams pers_subs(4);
     auto const& persistent_pairs = Base::get_persistent_pairs();
-    for (auto pair : persistent_pairs) {
+    // The pairs are decoded and dispatched one by one, without any intermediate diagram
+    for (auto const& pair : persistent_pairs) {
       std::pair<Filtration_value, Extended_simplex_type> px = stptr_->decode_extended_filtration(stptr_->filtration(get<0>(pair)),
                                                                                                         stptr_->efd);
       std::pair<Filtration_value, Extended_simplex_type> py = stptr_->decode_extended_filtration(stptr_->filtration(get<1>(pair)),
@@ -302,10 +391,93 @@ persistent_cohomology::Persistent_cohomology<FilteredComplex, persistent_cohomol
   }
 
  private:
+  template <typename T>
+  void fill_intervals_by_dimension(const std::vector<std::uintptr_t>& intervals) {
+    std::vector<T*> out(intervals.size());
+    std::transform(intervals.begin(), intervals.end(), out.begin(), [](std::uintptr_t p) { return (T*)p; });
+    for (auto const& pair : Base::get_persistent_pairs()) {
+      T*& d = out[stptr_->dimension(get<0>(pair))];
+      *d++ = static_cast<T>(stptr_->filtration(get<0>(pair)));
+      *d++ = static_cast<T>(stptr_->filtration(get<1>(pair)));
+    }
+  }
+
   // A copy
   FilteredComplex* stptr_;
 };
 
+// Calls f(i) for 0 <= i < n, in parallel with TBB on all the threads of the shared pool.
+template<class F>
+void for_each_in_batch(std::size_t n, F&& f) {
+#ifdef GUDHI_USE_TBB
+  thread_pool::parallel_for(n, 0, f);
+#else
+  for (std::size_t i = 0; i < n; ++i) f(i);
+#endif
+}
+
+// Computes the persistence of the complexes of several persistence objects, each as compute_persistence after a
+// reset, in parallel. The complexes must be distinct, as the computation modifies them (keys and filtration cache).
+// Returns the offsets of the packed diagrams of fill_persistence_batch: the intervals of pcoh[i] are between
+// offsets[i] and offsets[i+1].
+template<class FilteredComplex>
+std::vector<std::size_t> compute_persistence_batch(const std::vector<Persistent_cohomology_interface<FilteredComplex>*>& pcoh,
+                                                   int homology_coeff_field, double min_persistence,
+                                                   bool persistence_dim_max) {
+  for_each_in_batch(pcoh.size(), [&](std::size_t i) {
+    pcoh[i]->reset(persistence_dim_max);
+    pcoh[i]->compute_persistence(homology_coeff_field, min_persistence);
+  });
+  std::vector<std::size_t> offsets(pcoh.size() + 1, 0);
+  for (std::size_t i = 0; i < pcoh.size(); ++i) offsets[i + 1] = offsets[i] + pcoh[i]->get_persistent_pairs().size();
+  return offsets;
+}
+
+// Writes the diagram of pcoh[i], in the order of get_persistence, from the row offsets[i] of the int array of
+// dimensions and of the double array of (birth, death) with 2 columns, at the given addresses.
+template<class FilteredComplex>
+void fill_persistence_batch(const std::vector<Persistent_cohomology_interface<FilteredComplex>*>& pcoh,
+                            const std::vector<std::size_t>& offsets, std::uintptr_t dimensions,
+                            std::uintptr_t intervals) {
+  for_each_in_batch(pcoh.size(), [&](std::size_t i) {
+    int* dimensions_out = (int*)dimensions + offsets[i];
+    double* intervals_out = (double*)intervals + 2 * offsets[i];
+    for (auto const& interval : pcoh[i]->get_persistence()) {
+      *dimensions_out++ = interval.first;
+      *intervals_out++ = interval.second.first;
+      *intervals_out++ = interval.second.second;
+    }
+  });
+}
+
+// Computes, in parallel, the persistence of n images of the same shape given by their top-dimensional cells, stored
+// one after the other from cells, each as a CubicalComplex followed by cofaces_of_cubical_persistence_pairs. The
+// triples [dimension, birth cell, death cell] of all the images are concatenated in the returned vector, those of the
+// image i being between the rows offsets[i] and offsets[i+1], where offsets must have size n + 1.
+template<class CubicalComplex>
+std::vector<int> cofaces_of_cubical_persistence_pairs_batch(const std::vector<unsigned>& dimensions,
+                                                            const double* cells, std::size_t n,
+                                                            int homology_coeff_field, double min_persistence,
+                                                            std::size_t* offsets) {
+  std::size_t size = 1;
+  for (unsigned d : dimensions) size *= d;
+  std::vector<std::vector<std::vector<int>>> pairs(n);
+  for_each_in_batch(n, [&](std::size_t i) {
+    CubicalComplex complex(dimensions, cells + i * size, size, true);
+    Persistent_cohomology_interface<CubicalComplex> pcoh(&complex, true);
+    pcoh.compute_persistence(homology_coeff_field, min_persistence);
+    pairs[i] = pcoh.cofaces_of_cubical_persistence_pairs();
+  });
+  offsets[0] = 0;
+  for (std::size_t i = 0; i < n; ++i) offsets[i + 1] = offsets[i] + pairs[i].size();
+  std::vector<int> flat(3 * offsets[n]);
+  for_each_in_batch(n, [&](std::size_t i) {
+    int* out = flat.data() + 3 * offsets[i];
+    for (auto const& pair : pairs[i]) out = std::copy(pair.begin(), pair.end(), out);
+  });
+  return flat;
+}
+
 }  // namespace Gudhi
 
 #endif  // INCLUDE_PERSISTENT_COHOMOLOGY_INTERFACE_H_
@@ -14,16 +14,29 @@
 #include <gudhi/Simplex_tree.h>
 #include <gudhi/Rips_complex.h>
 #include <gudhi/Sparse_rips_complex.h>
+#include <gudhi/Weighted_rips_complex.h>
+#include <gudhi/Rips_persistence.h>
+#include <gudhi/Sliding_window_rips_complex.h>
 #include <gudhi/distance_functions.h>
 
 #include <boost/optional.hpp>
 
+#include <gudhi/Flag_complex_edge_collapser.h>
+
 #include "Simplex_tree_interface.h"
+#include "Persistent_cohomology_interface.h"
+#include "Strided_points.h"
+#include "Thread_pool.h"
 
 #include <iostream>
 #include <vector>
 #include <utility>  // std::pair
+#include <algorithm>  // std::sort
 #include <string>
+#include <cstddef>  // for std::size_t, std::ptrdiff_t
+#include <cstdint>  // for std::uintptr_t
+#include <memory>  // for std::unique_ptr
+#include <tuple>
 
 namespace Gudhi {
 
@@ -37,13 +50,37 @@ class Rips_complex_interface {
   void init_points(const std::vector<std::vector<double>>& points, double threshold) {
     rips_complex_.emplace(points, threshold, Gudhi::Euclidean_distance());
   }
+  // Points read in place from a 2d buffer of float or double, with strides in bytes, cf. Strided_points.h
+  template <typename T>
+  void init_points_buffer(const T* data, std::size_t num_points, std::size_t dimension, std::ptrdiff_t stride0,
+                          std::ptrdiff_t stride1, double threshold) {
+    rips_complex_.emplace(strided_points(data, num_points, dimension, stride0, stride1), threshold,
+                          Gudhi::Euclidean_distance());
+  }
   void init_matrix(const std::vector<std::vector<double>>& matrix, double threshold) {
     rips_complex_.emplace(matrix, threshold);
   }
 
+  void init_csr_matrix(const std::vector<std::size_t>& offsets, const std::vector<int>& indices,
+                       const std::vector<double>& distances, double threshold) {
+    rips_complex_.emplace(offsets, indices, distances, threshold);
+  }
+
+  void init_weighted_matrix(const std::vector<std::vector<double>>& matrix, const std::vector<double>& weights,
+                            double threshold) {
+    weighted_rips_complex_.emplace(matrix, weights, threshold);
+  }
+
   void init_points_sparse(const std::vector<std::vector<double>>& points, double threshold, double epsilon) {
     sparse_rips_complex_.emplace(points, Gudhi::Euclidean_distance(), epsilon, -std::numeric_limits<double>::infinity(), threshold);
   }
+  template <typename T>
+  void init_points_sparse_buffer(const T* data, std::size_t num_points, std::size_t dimension,
+                                 std::ptrdiff_t stride0, std::ptrdiff_t stride1, double threshold, double epsilon) {
+    sparse_rips_complex_.emplace(strided_points(data, num_points, dimension, stride0, stride1),
+                                 Gudhi::Euclidean_distance(), epsilon, -std::numeric_limits<double>::infinity(),
+                                 threshold);
+  }
   void init_matrix_sparse(const std::vector<std::vector<double>>& matrix, double threshold, double epsilon) {
     sparse_rips_complex_.emplace(matrix, epsilon, -std::numeric_limits<double>::infinity(), threshold);
   }
@@ -51,6 +88,8 @@ class Rips_complex_interface {
   void create_simplex_tree(Simplex_tree_interface<>* simplex_tree, int dim_max) {
     if (rips_complex_)
       rips_complex_->create_complex(*simplex_tree, dim_max);
+    else if (weighted_rips_complex_)
+      weighted_rips_complex_->create_complex(*simplex_tree, dim_max);
     else
       sparse_rips_complex_->create_complex(*simplex_tree, dim_max);
   }
@@ -60,6 +99,177 @@ class Rips_complex_interface {
   // Anyway, storing a graph would make more sense. Or changing the interface completely so there is no such storage.
   boost::optional<Rips_complex<Simplex_tree_interface<>::Filtration_value>> rips_complex_;
   boost::optional<Sparse_rips_complex<Simplex_tree_interface<>::Filtration_value>> sparse_rips_complex_;
+  boost::optional<Weighted_rips_complex<Simplex_tree_interface<>::Filtration_value>> weighted_rips_complex_;
+};
+
+// Persistence of a Rips_persistence, sorted as in Persistent_cohomology_interface::get_persistence: by decreasing
+// dimension, then by decreasing length.
+template <typename RipsPersistence>
+std::vector<std::pair<int, std::pair<double, double>>> compute_rips_persistence(RipsPersistence& rips_persistence,
+                                                                               int homology_coeff_field,
+                                                                               double min_persistence) {
+  rips_persistence.init_coefficients(homology_coeff_field);
+  rips_persistence.compute_persistent_cohomology(min_persistence);
+  std::vector<std::pair<int, std::pair<double, double>>> persistence;
+  persistence.reserve(rips_persistence.get_persistent_pairs().size());
+  for (auto const& interval : rips_persistence.get_persistent_pairs())
+    persistence.emplace_back(std::get<0>(interval), std::make_pair(std::get<1>(interval), std::get<2>(interval)));
+  std::sort(persistence.begin(), persistence.end(), [](auto const& p1, auto const& p2) {
+    if (p1.first != p2.first) return p1.first > p2.first;
+    return p1.second.second - p1.second.first > p2.second.second - p2.second.first;
+  });
+  return persistence;
+}
+
+inline std::vector<std::pair<int, std::pair<double, double>>> rips_persistence_from_points(
+    const std::vector<std::vector<double>>& points, double threshold, int dim_max, int homology_coeff_field,
+    double min_persistence) {
+  Rips_persistence<double> rips_persistence(points, threshold, dim_max, Gudhi::Euclidean_distance());
+  return compute_rips_persistence(rips_persistence, homology_coeff_field, min_persistence);
+}
+
+template <typename T>
+std::vector<std::pair<int, std::pair<double, double>>> rips_persistence_from_points_buffer(
+    const T* data, std::size_t num_points, std::size_t dimension, std::ptrdiff_t stride0, std::ptrdiff_t stride1,
+    double threshold, int dim_max, int homology_coeff_field, double min_persistence) {
+  Rips_persistence<double> rips_persistence(strided_points(data, num_points, dimension, stride0, stride1), threshold,
+                                            dim_max, Gudhi::Euclidean_distance());
+  return compute_rips_persistence(rips_persistence, homology_coeff_field, min_persistence);
+}
+
+inline std::vector<std::pair<int, std::pair<double, double>>> rips_persistence_from_matrix(
+    const std::vector<std::vector<double>>& matrix, double threshold, int dim_max, int homology_coeff_field,
+    double min_persistence) {
+  Rips_persistence<double> rips_persistence(matrix, threshold, dim_max);
+  return compute_rips_persistence(rips_persistence, homology_coeff_field, min_persistence);
+}
+
+using Persistence = std::vector<std::pair<int, std::pair<double, double>>>;
+
+// Persistence of the Rips complex of num_vertices vertices and of the edges (u, v, length) of length at most the
+// threshold, whose flag complex is collapsed num_collapse_iterations times with Flag_complex_edge_collapser, and then
+// expanded in a simplex tree. Sorted as compute_rips_persistence.
+inline Persistence collapsed_rips_persistence(std::size_t num_vertices, std::vector<std::tuple<int, int, double>> edges,
+                                              int dim_max, int num_collapse_iterations, int homology_coeff_field,
+                                              double min_persistence) {
+  for (int k = 0; k < num_collapse_iterations; ++k) edges = collapse::flag_complex_collapse_edges(std::move(edges));
+  Simplex_tree_interface<> stree;
+  for (std::size_t v = 0; v < num_vertices; ++v) stree.insert({static_cast<int>(v)}, 0.);
+  for (auto const& [u, v, length] : edges) stree.insert({u, v}, length);
+  stree.expansion(dim_max);
+  Persistent_cohomology_interface<Simplex_tree_interface<>> pcoh(&stree);
+  pcoh.compute_persistence(homology_coeff_field, min_persistence);
+  return pcoh.get_persistence();
+}
+
+// Edges (i, j, distance(i, j)) for 0 <= j < i < num_vertices, of length at most the threshold.
+template <typename Distance>
+std::vector<std::tuple<int, int, double>> rips_edges(std::size_t num_vertices, Distance distance, double threshold) {
+  std::vector<std::tuple<int, int, double>> edges;
+  for (std::size_t i = 0; i < num_vertices; ++i)
+    for (std::size_t j = 0; j < i; ++j) {
+      double length = distance(i, j);
+      if (length <= threshold) edges.emplace_back(static_cast<int>(i), static_cast<int>(j), length);
+    }
+  return edges;
+}
+
+// Persistence of the Rips complexes of a batch of point clouds, stored one after the other in a 2d buffer with
+// strides in bytes, the points of the cloud i being the rows offsets[i] to offsets[i+1]. The clouds are processed in
+// parallel, on n_jobs threads of the shared pool (all if 0). Each one is computed with Rips_persistence or, if
+// num_collapse_iterations > 0, with collapsed_rips_persistence.
+template <typename T>
+std::vector<Persistence> rips_persistence_batch_from_points(const T* data, const std::vector<std::size_t>& offsets,
+                                                            std::size_t dimension, std::ptrdiff_t stride0,
+                                                            std::ptrdiff_t stride1, double threshold, int dim_max,
+                                                            int num_collapse_iterations, int homology_coeff_field,
+                                                            double min_persistence, int n_jobs) {
+  std::size_t n = offsets.empty() ? 0 : offsets.size() - 1;
+  std::vector<Persistence> diagrams(n);
+  const char* ptr = reinterpret_cast<const char*>(data);
+  thread_pool::parallel_for(n, n_jobs, [&](std::size_t k) {
+    auto points = strided_points(reinterpret_cast<const T*>(ptr + static_cast<std::ptrdiff_t>(offsets[k]) * stride0),
+                                 offsets[k + 1] - offsets[k], dimension, stride0, stride1);
+    if (num_collapse_iterations <= 0) {
+      Rips_persistence<double> rips_persistence(points, threshold, dim_max, Euclidean_distance());
+      diagrams[k] = compute_rips_persistence(rips_persistence, homology_coeff_field, min_persistence);
+    } else {
+      auto distance = [&](std::size_t i, std::size_t j) { return Euclidean_distance()(points[i], points[j]); };
+      diagrams[k] = collapsed_rips_persistence(points.size(), rips_edges(points.size(), distance, threshold), dim_max,
+                                               num_collapse_iterations, homology_coeff_field, min_persistence);
+    }
+  });
+  return diagrams;
+}
+
+// Persistence of the Rips complexes of a batch of full square distance matrices, stored one after the other in C
+// order, the matrix i having sizes[i] rows. Only the lower triangles are read. Parallel as
+// rips_persistence_batch_from_points.
+inline std::vector<Persistence> rips_persistence_batch_from_matrices(const double* data,
+                                                                     const std::vector<std::size_t>& sizes,
+                                                                     double threshold, int dim_max,
+                                                                     int num_collapse_iterations,
+                                                                     int homology_coeff_field,
+                                                                     double min_persistence, int n_jobs) {
+  std::vector<std::size_t> starts(sizes.size(), 0);
+  for (std::size_t k = 1; k < sizes.size(); ++k) starts[k] = starts[k - 1] + sizes[k - 1] * sizes[k - 1];
+  std::vector<Persistence> diagrams(sizes.size());
+  thread_pool::parallel_for(sizes.size(), n_jobs, [&](std::size_t k) {
+    const std::size_t num_vertices = sizes[k];
+    std::vector<const double*> rows(num_vertices);
+    for (std::size_t i = 0; i < num_vertices; ++i) rows[i] = data + starts[k] + i * num_vertices;
+    if (num_collapse_iterations <= 0) {
+      Rips_persistence<double> rips_persistence(rows, threshold, dim_max);
+      diagrams[k] = compute_rips_persistence(rips_persistence, homology_coeff_field, min_persistence);
+    } else {
+      auto distance = [&](std::size_t i, std::size_t j) { return rows[i][j]; };
+      diagrams[k] = collapsed_rips_persistence(num_vertices, rips_edges(num_vertices, distance, threshold), dim_max,
+                                               num_collapse_iterations, homology_coeff_field, min_persistence);
+    }
+  });
+  return diagrams;
+}
+
+// Writes the diagrams one after the other, from the row 0 of the int array of dimensions and of the double array of
+// (birth, death) with 2 columns, at the given addresses, as fill_persistence_batch.
+inline void fill_persistence_diagrams(const std::vector<Persistence>& diagrams, std::uintptr_t dimensions,
+                                      std::uintptr_t intervals) {
+  int* dimensions_out = (int*)dimensions;
+  double* intervals_out = (double*)intervals;
+  for (auto const& diagram : diagrams)
+    for (auto const& interval : diagram) {
+      *dimensions_out++ = interval.first;
+      *intervals_out++ = interval.second.first;
+      *intervals_out++ = interval.second.second;
+    }
+}
+
+// Rips complex of the last points of a stream, cf. Sliding_window_rips_complex, whose persistence can be computed
+// at each step. The memory of the persistence computation is reused from one step to the next.
+class Sliding_window_rips_interface {
+  using Stream_simplex_tree = Simplex_tree<Simplex_tree_options_fast_cofaces>;
+  using Window = Sliding_window_rips_complex<Stream_simplex_tree, std::vector<double>, Euclidean_distance>;
+
+ public:
+  Sliding_window_rips_interface(double threshold, int dim_max) : window_(threshold, dim_max) {}
+
+  void push_back(const std::vector<double>& point) { window_.push_back(point); }
+  void pop_front() { window_.pop_front(); }
+  std::size_t size() const { return window_.size(); }
+  std::size_t num_simplices() { return window_.complex().num_simplices(); }
+
+  Persistence persistence(int homology_coeff_field, double min_persistence) {
+    if (pcoh_)
+      pcoh_->reset(false);
+    else
+      pcoh_ = std::make_unique<Persistent_cohomology_interface<Stream_simplex_tree>>(&window_.complex());
+    pcoh_->compute_persistence(homology_coeff_field, min_persistence);
+    return pcoh_->get_persistence();
+  }
+
+ private:
+  Window window_;
+  std::unique_ptr<Persistent_cohomology_interface<Stream_simplex_tree>> pcoh_;
 };
 
 }  // namespace rips_complex
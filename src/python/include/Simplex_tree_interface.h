@@ -17,11 +17,20 @@
 #include <gudhi/Points_off_io.h>
 #include <gudhi/Flag_complex_edge_collapser.h>
 
+#include <boost/range/irange.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <boost/range/adaptor/transformed.hpp>
+
 #include <iostream>
 #include <vector>
+#include <algorithm>  // for std::reverse
+#include <cstddef>  // for std::size_t
+#include <cstdint>  // for std::int64_t, std::uintptr_t
 #include <utility>  // std::pair
 #include <tuple>
 #include <iterator>  // for std::distance
+#include <limits>  // for std::numeric_limits
+#include <stdexcept>  // for std::invalid_argument
 
 namespace Gudhi {
 
@@ -91,6 +100,23 @@ class Simplex_tree_interface : public Simplex_tree<SimplexTreeOptions> {
     this->set_dimension(1, false);
   }
 
+  // Inserts the n simplices of k vertices stored row by row in vertices, and their faces, cf. Simplex_tree::insert_batch
+  void insert_batch_array(const int* vertices, std::size_t n, std::size_t k, const double* filtrations) {
+    auto simplices = boost::irange<std::size_t>(0, n) | boost::adaptors::transformed([=](std::size_t i) {
+                       return boost::make_iterator_range(vertices + i * k, vertices + (i + 1) * k);
+                     });
+    Base::insert_batch(simplices, [=](std::size_t i) { return filtrations[i]; });
+    Base::clear_filtration();
+  }
+
+  // Inserts the n edges (rows[i], cols[i]) and their vertices, cf. Simplex_tree::insert_edges
+  void insert_edges_array(const int* rows, const int* cols, const double* filtrations, std::size_t n) {
+    std::vector<std::tuple<Vertex_handle, Vertex_handle, Filtration_value>> edges(n);
+    for (std::size_t i = 0; i < n; ++i) edges[i] = {rows[i], cols[i], filtrations[i]};
+    Base::insert_edges(std::move(edges));
+    Base::clear_filtration();
+  }
+
   // Do not interface this function, only used in alpha complex interface for complex creation
   bool insert_simplex(const Simplex& simplex, Filtration_value filtration = 0) {
     Insertion_result result = Base::insert_simplex(simplex, filtration);
@@ -119,43 +145,96 @@ class Simplex_tree_interface : public Simplex_tree<SimplexTreeOptions> {
     return Base::filtration(Base::find(simplex));
   }
 
+  // Sets the filtration value of each simplex to the maximum of values[v] over its vertices v, in one walk of the tree
+  // where each node takes the maximum of the value of its parent and of its own vertex. The filtration order, if it
+  // was already computed, is repaired instead of being sorted from scratch, see update_filtration_order.
+  void assign_lower_star_filtration(const double* values, std::size_t n) {
+    for (auto vertex : Base::complex_vertex_range())
+      if (vertex < 0 || static_cast<std::size_t>(vertex) >= n)
+        throw std::invalid_argument("There must be one value per vertex, and the vertices must be 0 to n-1");
+    rec_assign_lower_star_filtration(Base::root(), -std::numeric_limits<Filtration_value>::infinity(), values);
+    Base::update_filtration_order();
+  }
+
+  // Sets the filtration value of each vertex to 0 and of each other simplex to the largest distance between 2 of its
+  // vertices in the n x n matrix of distances, as in a Rips complex. Each node only reads the distances from its
+  // vertex to its ancestors. As for assign_lower_star_filtration, the filtration order is repaired.
+  void assign_flag_filtration(const double* distances, std::size_t n) {
+    for (auto vertex : Base::complex_vertex_range())
+      if (vertex < 0 || static_cast<std::size_t>(vertex) >= n)
+        throw std::invalid_argument("The distance matrix must have one row per vertex, and the vertices must be 0 to n-1");
+    std::vector<Vertex_handle> ancestors;
+    rec_assign_flag_filtration(Base::root(), 0, distances, n, ancestors);
+    Base::update_filtration_order();
+  }
+
+  // Writes the filtration values of the simplices, in the order of the filtration, in an array of doubles allocated by
+  // the caller with one entry per simplex.
+  void fill_filtration_values(std::uintptr_t filtrations) {
+    double* out = reinterpret_cast<double*>(filtrations);
+    for (auto sh : Base::filtration_simplex_range()) *out++ = Base::filtration(sh);
+  }
+
+  // Assigns values[i] to the i-th simplex of the filtration order, and then repairs this order once, as
+  // assign_lower_star_filtration.
+  void assign_filtration_values(const double* values, std::size_t n) {
+    auto const& simplices = Base::filtration_simplex_range();
+    if (n != simplices.size()) throw std::invalid_argument("There must be one value per simplex");
+    for (std::size_t i = 0; i < n; ++i) Base::assign_filtration(simplices[i], values[i]);
+    Base::update_filtration_order();
+  }
+
+  // The overload on a Simplex_handle is used by the C++ constructions, like Weighted_rips_complex::create_complex
+  using Base::remove_maximal_simplex;
+
   void remove_maximal_simplex(const Simplex& simplex) {
     Base::remove_maximal_simplex(Base::find(simplex));
     Base::clear_filtration();
   }
 
   Simplex_and_filtration get_simplex_and_filtration(Simplex_handle f_simplex) {
-    Simplex simplex;
-    for (auto vertex : Base::simplex_vertex_range(f_simplex)) {
-      simplex.insert(simplex.begin(), vertex);
-    }
+    auto vertices = Base::simplex_vertex_range(f_simplex);
+    Simplex simplex(vertices.begin(), vertices.end());
+    std::reverse(simplex.begin(), simplex.end());
     return std::make_pair(std::move(simplex), Base::filtration(f_simplex));
   }
 
   Filtered_simplices get_star(const Simplex& simplex) {
-    Filtered_simplices star;
-    for (auto f_simplex : Base::star_simplex_range(Base::find(simplex))) {
-      Simplex simplex_star;
-      for (auto vertex : Base::simplex_vertex_range(f_simplex)) {
-        simplex_star.insert(simplex_star.begin(), vertex);
-      }
-      star.push_back(std::make_pair(simplex_star, Base::filtration(f_simplex)));
-    }
-    return star;
+    return get_cofaces(simplex, 0);
   }
 
   Filtered_simplices get_cofaces(const Simplex& simplex, int dimension) {
     Filtered_simplices cofaces;
     for (auto f_simplex : Base::cofaces_simplex_range(Base::find(simplex), dimension)) {
-      Simplex simplex_coface;
-      for (auto vertex : Base::simplex_vertex_range(f_simplex)) {
-        simplex_coface.insert(simplex_coface.begin(), vertex);
-      }
-      cofaces.push_back(std::make_pair(simplex_coface, Base::filtration(f_simplex)));
+      cofaces.push_back(get_simplex_and_filtration(f_simplex));
     }
     return cofaces;
   }
 
+  // Simplices that are not in the complex get an empty list of cofaces
+  std::vector<Filtered_simplices> get_cofaces_batch(const std::vector<Simplex>& simplices, int dimension) {
+    std::vector<Simplex_handle> handles;
+    std::vector<std::size_t> queries;
+    for (std::size_t i = 0; i < simplices.size(); ++i) {
+      Simplex_handle sh = Base::find(simplices[i]);
+      if (sh != Base::null_simplex()) {
+        handles.push_back(sh);
+        queries.push_back(i);
+      }
+    }
+    std::vector<std::size_t> offsets;
+    std::vector<Simplex_handle> cofaces;
+    Base::cofaces_simplex_ranges(handles, dimension, offsets, cofaces);
+    std::vector<Filtered_simplices> result(simplices.size());
+    for (std::size_t q = 0; q < queries.size(); ++q) {
+      Filtered_simplices& filtered_cofaces = result[queries[q]];
+      filtered_cofaces.reserve(offsets[q + 1] - offsets[q]);
+      for (std::size_t c = offsets[q]; c < offsets[q + 1]; ++c)
+        filtered_cofaces.push_back(get_simplex_and_filtration(cofaces[c]));
+    }
+    return result;
+  }
+
   void compute_extended_filtration() {
     this->efd = this->extend_filtration();
     return;
@@ -236,6 +315,46 @@ class Simplex_tree_interface : public Simplex_tree<SimplexTreeOptions> {
     auto boundary_srange = Base::boundary_simplex_range(bd_sh);
     return std::make_pair(boundary_srange.begin(), boundary_srange.end());
   }
+
+  // Sizes of the arrays of fill_boundary_matrix: the number of simplices in the filtration and the number of nonzero
+  // entries of the boundary matrix.
+  std::pair<std::size_t, std::size_t> boundary_matrix_sizes() {
+    return {Base::filtration_simplex_range().size(), Base::num_boundary_entries()};
+  }
+
+  // Fills arrays allocated by the caller with the sizes of boundary_matrix_sizes, with the boundary matrix in
+  // compressed sparse column format (column_offsets and row_indices of int64), the dimensions (int) and the filtration
+  // values (double) of the simplices, in the order of the filtration.
+  void fill_boundary_matrix(std::uintptr_t column_offsets, std::uintptr_t row_indices, std::uintptr_t dimensions,
+                            std::uintptr_t filtrations) {
+    Base::fill_boundary_matrix(reinterpret_cast<std::int64_t*>(column_offsets),
+                               reinterpret_cast<std::int64_t*>(row_indices), reinterpret_cast<int*>(dimensions),
+                               reinterpret_cast<Filtration_value*>(filtrations));
+  }
+
+ private:
+  void rec_assign_lower_star_filtration(Siblings* sib, Filtration_value parent, const double* values) {
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
+      Filtration_value f = std::max(parent, static_cast<Filtration_value>(values[sh->first]));
+      Base::assign_filtration(sh, f);
+      if (Base::has_children(sh)) rec_assign_lower_star_filtration(sh->second.children(), f, values);
+    }
+  }
+
+  void rec_assign_flag_filtration(Siblings* sib, Filtration_value parent, const double* distances, std::size_t n,
+                                  std::vector<Vertex_handle>& ancestors) {
+    for (auto sh = sib->members().begin(); sh != sib->members().end(); ++sh) {
+      Filtration_value f = parent;
+      for (Vertex_handle u : ancestors)
+        f = std::max(f, static_cast<Filtration_value>(distances[static_cast<std::size_t>(u) * n + sh->first]));
+      Base::assign_filtration(sh, f);
+      if (Base::has_children(sh)) {
+        ancestors.push_back(sh->first);
+        rec_assign_flag_filtration(sh->second.children(), f, distances, n, ancestors);
+        ancestors.pop_back();
+      }
+    }
+  }
 };
 
 }  // namespace Gudhi
@@ -14,14 +14,23 @@
 
 #include "Simplex_tree_interface.h"
 #include "Simplex_tree_multi.h"
+#include "Simplex_tree_multi_scc.h"
+#include "Simplex_tree_multi_slicer.h"
+#include "Simplex_tree_multi_presentation.h"
+#include <gudhi/Flag_complex_multi_edge_collapser.h>
+#include <boost/range/iterator_range.hpp>
 #include "multi_filtrations/finitely_critical_filtrations.h"
+#include "multi_filtrations/mobius_inversion.h"
 
 #include <iostream>
 #include <vector>
+#include <algorithm>  // for std::copy
+#include <cstdint>  // for std::int64_t, std::uintptr_t
 #include <utility>  // std::pair
 #include <tuple>
 #include <iterator>  // for std::distance
-#include <span>
+#include <memory>  // for std::shared_ptr
+#include <stdexcept>
 
 namespace Gudhi::multiparameter {
 
@@ -116,29 +125,41 @@ class Simplex_tree_interface_multi : public Simplex_tree_interface<Simplex_tree_
   }
 
   Filtered_simplices get_star(const Simplex& simplex) {
-	Filtered_simplices star;
-	for (auto f_simplex : Base::star_simplex_range(Base::find(simplex))) {
-	  Simplex simplex_star;
-	  for (auto vertex : Base::simplex_vertex_range(f_simplex)) {
-		simplex_star.insert(simplex_star.begin(), vertex);
-	  }
-	  star.push_back(std::make_pair(simplex_star, &Base::filtration_mutable(f_simplex)[0]));
-	}
-	return star;
+	return get_cofaces(simplex, 0);
   }
 
   Filtered_simplices get_cofaces(const Simplex& simplex, int dimension) {
 	Filtered_simplices cofaces;
 	for (auto f_simplex : Base::cofaces_simplex_range(Base::find(simplex), dimension)) {
-	  Simplex simplex_coface;
-	  for (auto vertex : Base::simplex_vertex_range(f_simplex)) {
-		simplex_coface.insert(simplex_coface.begin(), vertex);
-	  }
-	  cofaces.push_back(std::make_pair(simplex_coface, &Base::filtration_mutable(f_simplex)[0]));
+	  cofaces.push_back(get_simplex_and_filtration(f_simplex));
 	}
 	return cofaces;
   }
 
+  // Simplices that are not in the complex get an empty list of cofaces
+  std::vector<Filtered_simplices> get_cofaces_batch(const std::vector<Simplex>& simplices, int dimension) {
+	std::vector<Simplex_handle> handles;
+	std::vector<std::size_t> queries;
+	for (std::size_t i = 0; i < simplices.size(); ++i) {
+	  Simplex_handle sh = Base::find(simplices[i]);
+	  if (sh != Base::null_simplex()) {
+		handles.push_back(sh);
+		queries.push_back(i);
+	  }
+	}
+	std::vector<std::size_t> offsets;
+	std::vector<Simplex_handle> cofaces;
+	Base::cofaces_simplex_ranges(handles, dimension, offsets, cofaces);
+	std::vector<Filtered_simplices> result(simplices.size());
+	for (std::size_t q = 0; q < queries.size(); ++q) {
+	  Filtered_simplices& filtered_cofaces = result[queries[q]];
+	  filtered_cofaces.reserve(offsets[q + 1] - offsets[q]);
+	  for (std::size_t c = offsets[q]; c < offsets[q + 1]; ++c)
+		filtered_cofaces.push_back(get_simplex_and_filtration(cofaces[c]));
+	}
+	return result;
+  }
+
   void compute_extended_filtration() {
 	throw std::logic_error("Incompatible with multipers");
   }
@@ -167,16 +188,16 @@ class Simplex_tree_interface_multi : public Simplex_tree_interface<Simplex_tree_
 
   // Fills a parameter with a lower-star filtration
   void fill_lowerstar(const std::vector<options_multi::value_type>& filtration, int axis){
-	using value_type=options_multi::value_type;
-	for (auto &SimplexHandle : Base::complex_simplex_range()){
-		std::vector<value_type>& current_birth = Base::filtration_mutable(SimplexHandle);
-		value_type to_assign = -1*std::numeric_limits<value_type>::infinity();
-		for (auto vertex : Base::simplex_vertex_range(SimplexHandle)){
-			to_assign = std::max(filtration[vertex], to_assign);
-		}
-		current_birth[axis] = to_assign;
-		// Base::assign_filtration(SimplexHandle, current_birth);
-	}
+	Gudhi::multiparameter::fill_lowerstar(static_cast<Base&>(*this), {filtration}, {axis});
+  }
+  // Fills the parameters axes[i] with the lower-star filtrations of filtrations[i] in a single (parallel) pass.
+  Lowerstar_timings fill_lowerstars(const std::vector<std::vector<options_multi::value_type>>& filtrations, const std::vector<int>& axes){
+	return Gudhi::multiparameter::fill_lowerstar(static_cast<Base&>(*this), filtrations, axes);
+  }
+
+  // Fills this empty simplextree with the function-Rips bifiltration of points, cf. Gudhi::multiparameter::function_rips.
+  void fill_function_rips(const std::vector<std::vector<options_multi::value_type>>& points, const std::vector<options_multi::value_type>& function, options_multi::value_type threshold, int max_dimension){
+	Gudhi::multiparameter::function_rips(static_cast<Base&>(*this), points, function, threshold, max_dimension);
   }
 
 
@@ -196,6 +217,83 @@ class Simplex_tree_interface_multi : public Simplex_tree_interface<Simplex_tree_
 /*	simplex_list.shrink_to_fit();*/
 	return simplex_list;
   }
+  // Inserts the n simplices vertex_array[:, i] and their faces, with the filtration values filtrations[i, :], where the
+  // arrays are row-major of shapes (k, n) and (n, num_parameters). Same as n calls to insert, cf. Base::insert_batch.
+  void insert_batch(uintptr_t vertex_array, std::size_t k, std::size_t n, uintptr_t filtrations){
+	const int* vertices = reinterpret_cast<const int*>(vertex_array);
+	const auto* values = reinterpret_cast<const typename SimplexTreeOptions::value_type*>(filtrations);
+	const std::size_t num_parameters = Base::get_number_of_parameters();
+	std::vector<int> transposed(k * n);
+	for (std::size_t j = 0; j < k; j++)
+		for (std::size_t i = 0; i < n; i++)
+			transposed[i * k + j] = vertices[j * n + i];
+	std::vector<boost::iterator_range<const int*>> simplices;
+	simplices.reserve(n);
+	for (std::size_t i = 0; i < n; i++)
+		simplices.emplace_back(transposed.data() + i * k, transposed.data() + (i + 1) * k);
+	Base::insert_batch(simplices, [values, num_parameters](std::size_t i){
+		Filtration_value filtration(num_parameters);
+		std::copy_n(values + i * num_parameters, num_parameters, filtration.begin());
+		return filtration;
+	});
+	Base::clear_filtration();
+  }
+  // Number of simplices of each dimension, up to max_dimension (all of them if negative).
+  std::vector<std::size_t> num_simplices_by_dimension(int max_dimension = -1){
+	if (max_dimension < 0) max_dimension = Base::upper_bound_dimension();
+	std::vector<std::size_t> out(max_dimension + 1, 0);
+	for (auto simplex_handle : Base::skeleton_simplex_range(max_dimension))
+		out[Base::dimension(simplex_handle)]++;
+	while (!out.empty() && out.back() == 0) out.pop_back();
+	return out;
+  }
+  // Writes the simplices of dimension at most vertices.size()-1 and their filtration values, in the order of
+  // get_skeleton, into row-major arrays allocated by the caller with the sizes of num_simplices_by_dimension :
+  // the i-th simplex of dimension d goes to vertices[d] + i*(d+1) and filtrations[d] + i*num_parameters.
+  void fill_simplices_and_filtrations(const std::vector<uintptr_t>& vertices, const std::vector<uintptr_t>& filtrations){
+	if (vertices.size() != filtrations.size())
+		throw std::invalid_argument("There should be one vertex array and one filtration array per dimension.");
+	if (vertices.empty()) return;
+	const std::size_t num_parameters = Base::get_number_of_parameters();
+	std::vector<std::size_t> counts(vertices.size(), 0);
+	for (auto simplex_handle : Base::skeleton_simplex_range(static_cast<int>(vertices.size()) - 1)){
+		const int dimension = Base::dimension(simplex_handle);
+		const std::size_t i = counts[dimension]++;
+		Vertex_handle* simplex = reinterpret_cast<Vertex_handle*>(vertices[dimension]) + i * (dimension + 1);
+		int position = dimension; // simplex_vertex_range is decreasing
+		for (Vertex_handle vertex : Base::simplex_vertex_range(simplex_handle))
+			simplex[position--] = vertex;
+		const auto& filtration = Base::filtration(simplex_handle);
+		if (filtration.size() != num_parameters)
+			throw std::invalid_argument("A filtration value does not have num_parameters coordinates.");
+		std::copy(filtration.begin(), filtration.end(),
+				reinterpret_cast<typename SimplexTreeOptions::value_type*>(filtrations[dimension]) + i * num_parameters);
+	}
+  }
+  // Same as Simplex_tree_interface::fill_boundary_matrix, with the filtration values written in a row-major array of
+  // shape (n, num_parameters), where n is the number of simplices in the filtration.
+  void fill_boundary_matrix(std::uintptr_t column_offsets, std::uintptr_t row_indices, std::uintptr_t dimensions,
+                            std::uintptr_t filtrations) {
+	using value_type = typename SimplexTreeOptions::value_type;
+	// Writes the i-th filtration value in the i-th row of the array
+	struct Row {
+		value_type* row;
+		std::size_t num_parameters;
+		void operator=(const Filtration_value& filtration) const {
+			if (filtration.size() != num_parameters)
+				throw std::invalid_argument("A filtration value does not have num_parameters coordinates.");
+			std::copy(filtration.begin(), filtration.end(), row);
+		}
+	};
+	struct Rows {
+		value_type* data;
+		std::size_t num_parameters;
+		Row operator[](std::size_t i) const { return {data + i * num_parameters, num_parameters}; }
+	};
+	Base::fill_boundary_matrix(reinterpret_cast<std::int64_t*>(column_offsets),
+	                           reinterpret_cast<std::int64_t*>(row_indices), reinterpret_cast<int*>(dimensions),
+	                           Rows{reinterpret_cast<value_type*>(filtrations), Base::get_number_of_parameters()});
+  }
   using edge_list = std::vector<std::pair<std::pair<int,int>, std::pair<double, double>>>;
   edge_list get_edge_list(){
 	edge_list simplex_list;
@@ -219,6 +317,150 @@ class Simplex_tree_interface_multi : public Simplex_tree_interface<Simplex_tree_
 		}
 	}
 
+	// Structure-of-arrays copy of the filtration values, cf. multi_filtrations/filtration_table.h.
+	// Built on demand; the columns are indexed by the simplex keys, which are reset by `build_filtration_table`.
+	// The table is shared with the numpy views on it, so that a new table, or clearing it, does not invalidate them.
+	using Filtration_table = multi_filtrations::Filtration_table<typename SimplexTreeOptions::value_type>;
+	std::shared_ptr<Filtration_table> filtration_table;
+
+	std::shared_ptr<Filtration_table> build_filtration_table(){
+		filtration_table = std::make_shared<Filtration_table>(make_filtration_table(*this));
+		return filtration_table;
+	}
+	Filtration_table& current_filtration_table(){
+		if (!filtration_table)
+			throw std::logic_error("There is no filtration table, it has to be built first.");
+		return *filtration_table;
+	}
+	// Writes the (possibly modified) table back into the simplextree.
+	void commit_filtration_table(){
+		assign_filtration_variant(current_filtration_table());
+	}
+	void clear_filtration_table(){
+		filtration_table.reset();
+	}
+	void fill_lowerstar_table(const std::vector<typename SimplexTreeOptions::value_type>& filtration, int axis){
+		fill_lowerstar_variant(current_filtration_table(), filtration, axis);
+	}
+	std::vector<multi_filtrations::Snapping_strategy> squeeze_filtration_table(const multi_filtration_grid& grid, bool coordinate_values){
+		return squeeze_filtration(current_filtration_table(), grid, coordinate_values);
+	}
+	// Filtration variants : tables owned by the caller, sharing the structure of this simplextree, cf.
+	// SimplexTreeMulti.filtration_variant. Only the table is duplicated, so each variant costs
+	// `num_parameters * num_simplices` values instead of a full copy of the tree.
+	Filtration_table* new_filtration_variant(){
+		return new Filtration_table(make_filtration_table(*this));
+	}
+	void fill_lowerstar_variant(Filtration_table& table, const std::vector<typename SimplexTreeOptions::value_type>& filtration, int axis){
+		assign_traversal_keys(*this);
+		Gudhi::multiparameter::fill_lowerstar(table, *this, filtration, axis);
+	}
+	std::vector<multi_filtrations::Snapping_strategy> squeeze_filtration_variant(Filtration_table& table, const multi_filtration_grid& grid, bool coordinate_values){
+		return squeeze_filtration(table, grid, coordinate_values);
+	}
+	// Writes a variant of a simplextree with the same structure, e.g. of a copy, into this one.
+	void assign_filtration_variant(const Filtration_table& table){
+		if (table.num_simplices() != Base::num_simplices())
+			throw std::invalid_argument("The filtration variant does not have the structure of this simplextree.");
+		assign_traversal_keys(*this);
+		assign_filtration_table(*this, table);
+		Base::clear_filtration();
+	}
+	void to_scc(const std::string& path, bool ignore_last_generators, bool strip_comments, bool reverse_block, bool rivet_compatible, bool binary){
+		Scc_writer_options options;
+		options.ignore_last_generators = ignore_last_generators;
+		options.strip_comments = strip_comments;
+		options.reverse_block = reverse_block;
+		options.rivet_compatible = rivet_compatible;
+		options.binary = binary;
+		write_scc(*this, path, options);
+	}
+	// Replaces this simplextree by the flag complex, up to max_dimension, of its (filtration-domination) collapsed 1-skeleton.
+	// Does num passes of strong collapses, or, if full, up to 100 strong passes followed by up to 100 non-strong ones.
+	void collapse_edges(int max_dimension, int num, bool strong, bool full){
+		using Filtered_edge = std::tuple<Vertex_handle, Vertex_handle, Python_filtration_type>;
+		std::vector<Filtered_edge> edges;
+		for (auto sh : Base::skeleton_simplex_range(1)){
+			if (Base::dimension(sh) != 1) continue;
+			auto it = Base::simplex_vertex_range(sh).begin();
+			const Vertex_handle v = *it;
+			const Vertex_handle u = *(++it);
+			const auto& f = Base::filtration(sh);
+			edges.emplace_back(u, v, Python_filtration_type(f.begin(), f.end()));
+		}
+		if (full){
+			edges = collapse::flag_complex_multi_collapse_edges(edges, true, 100);
+			edges = collapse::flag_complex_multi_collapse_edges(edges, false, 100);
+		} else {
+			edges = collapse::flag_complex_multi_collapse_edges(edges, strong, num);
+		}
+		Base collapsed;
+		collapsed.set_number_of_parameters(Base::get_number_of_parameters());
+		for (auto sh : Base::skeleton_simplex_range(0))
+			collapsed.insert_simplex({*Base::simplex_vertex_range(sh).begin()}, Base::filtration(sh));
+		for (const auto& [u, v, f] : edges)
+			collapsed.insert_simplex({u, v}, Filtration_value(f));
+		collapsed.expansion(max_dimension);
+		collapsed.make_filtration_non_decreasing(); // expansion takes one of the faces' value, not their join
+		Base::operator=(std::move(collapsed));
+		Base::clear_filtration();
+	}
+
+	// Barcodes along the lines basepoints[i] + t * directions[i] (diagonal if directions is empty), cf. Line_slicer.
+	using Sliced_barcodes = std::vector<std::vector<std::vector<std::pair<double, double>>>>;
+	// If vineyard is true, the lines are processed in order, and persistence is updated from one line to the next (Z/2Z coefficients).
+	Sliced_barcodes sliced_barcodes(const std::vector<Python_filtration_type>& basepoints, const std::vector<Python_filtration_type>& directions,
+			const std::vector<int>& degrees, int coefficient_field, double min_persistence, bool vineyard = false){
+		using Line = multi_filtrations::Line<typename SimplexTreeOptions::value_type>;
+		if (!directions.empty() && directions.size() != basepoints.size())
+			throw std::invalid_argument("There should be as many directions as basepoints.");
+		std::vector<Line> lines;
+		lines.reserve(basepoints.size());
+		for (std::size_t i = 0; i < basepoints.size(); i++){
+			if (directions.empty()) lines.emplace_back(basepoints[i]);
+			else lines.emplace_back(basepoints[i], directions[i]);
+		}
+		if (vineyard)
+			return Gudhi::multiparameter::vineyard_barcodes(static_cast<Base&>(*this), lines, degrees, min_persistence);
+		return Gudhi::multiparameter::sliced_barcodes(static_cast<Base&>(*this), lines, degrees, coefficient_field, min_persistence);
+	}
+
+	// Hilbert function of this simplextree, squeezed on a grid of shape grid_shape, as a row-major tensor of shape
+	// (degrees.size(), grid_shape...), cf. Line_slicer::hilbert_function.
+	std::vector<std::int32_t> hilbert_function(const std::vector<std::size_t>& grid_shape, const std::vector<int>& degrees){
+		return Gudhi::multiparameter::hilbert_function(static_cast<Base&>(*this), grid_shape, degrees);
+	}
+
+	// Signed measure of the Hilbert function, cf. hilbert_function : the coordinates of its points, with the index of
+	// the degree first, and their weights.
+	void hilbert_signed_measure(const std::vector<std::size_t>& grid_shape, const std::vector<int>& degrees, std::vector<std::int32_t>& coordinates, std::vector<std::int32_t>& weights){
+		auto tensor = hilbert_function(grid_shape, degrees);
+		std::vector<std::size_t> shape(1, degrees.size());
+		shape.insert(shape.end(), grid_shape.begin(), grid_shape.end());
+		Gudhi::multiparameter::multi_filtrations::signed_measure(tensor, shape, 1, coordinates, weights);
+	}
+
+	// Minimal presentation of the homology in degree degree, cf. Gudhi::multiparameter::minimal_presentation.
+	// The grades are flattened, two values per generator or relation.
+	void minimal_presentation(int degree, std::vector<typename SimplexTreeOptions::value_type>& generator_grades, std::vector<typename SimplexTreeOptions::value_type>& relation_grades, std::vector<std::vector<std::size_t>>& relations){
+		auto presentation = Gudhi::multiparameter::minimal_presentation(static_cast<Base&>(*this), degree);
+		for (const auto& grade : presentation.generator_grades) generator_grades.insert(generator_grades.end(), grade.begin(), grade.end());
+		for (const auto& grade : presentation.relation_grades) relation_grades.insert(relation_grades.end(), grade.begin(), grade.end());
+		relations = std::move(presentation.relations);
+	}
+
+	// Fills this (empty) simplextree from a file.
+	void from_scc(const std::string& path, bool reverse_block){
+		Scc_reader_options options;
+		options.reverse_block = reverse_block;
+		read_scc(*this, path, options);
+		Base::clear_filtration();
+	}
+	void from_rivet(const std::string& path){
+		read_rivet(*this, path);
+		Base::clear_filtration();
+	}
+
 	
 };
 
@@ -226,6 +468,53 @@ class Simplex_tree_interface_multi : public Simplex_tree_interface<Simplex_tree_
 using interface_std = Simplex_tree<Simplex_tree_options_full_featured>; // Interface not necessary (smaller so should do less segfaults)
 using interface_multi = Simplex_tree_interface_multi<Simplex_tree_options_multidimensional_filtration>;
 
+// Simplextree squeezed on a grid : filtration values are integer coordinates, and the grid is stored once.
+template<typename coordinate_type = std::int32_t>
+class Simplex_tree_interface_multi_squeezed : public Simplex_tree<options_multi_coordinates<coordinate_type>> {
+ public:
+  using Base = Simplex_tree<options_multi_coordinates<coordinate_type>>;
+  using Simplex = std::vector<typename Base::Vertex_handle>;
+
+  const multi_filtration_grid& get_filtration_grid() const {
+	return filtration_grid_;
+  }
+
+  // Replaces this simplextree by the squeeze of the simplextree multi at splxptr on the grid.
+  void squeeze_from_ptr(const uintptr_t splxptr, const multi_filtration_grid& grid){
+	auto &st_multi = get_simplextree_from_pointer<interface_multi>(splxptr);
+	squeeze_to_coordinates(st_multi, static_cast<Base&>(*this), grid);
+	filtration_grid_ = grid;
+  }
+  // Replaces the simplextree multi at splxptr by this simplextree, with the grid values of its coordinates.
+  void unsqueeze_to_ptr(const uintptr_t splxptr){
+	auto &st_multi = get_simplextree_from_pointer<interface_multi>(splxptr);
+	unsqueeze_from_coordinates(static_cast<Base&>(*this), st_multi, filtration_grid_);
+  }
+
+  bool find_simplex(const Simplex& simplex) {
+	return (Base::find(simplex) != Base::null_simplex());
+  }
+  // Pointer to the coordinates of a simplex (nullptr if the simplex is not in the complex)
+  coordinate_type* simplex_filtration(const Simplex& simplex) {
+	auto sh = Base::find(simplex);
+	if (sh == Base::null_simplex()) return nullptr;
+	return Base::filtration_mutable(sh).data();
+  }
+  // Filtration values, as grid coordinates, of all simplices of a given dimension (all if dimension < 0).
+  std::vector<std::vector<coordinate_type>> get_filtrations(int dimension = -1) {
+	std::vector<std::vector<coordinate_type>> out;
+	for (const auto &simplex_handle : Base::complex_simplex_range()){
+		if (dimension >= 0 && Base::dimension(simplex_handle) != dimension) continue;
+		const auto& coordinates = Base::filtration(simplex_handle);
+		out.emplace_back(coordinates.begin(), coordinates.end());
+	}
+	return out;
+  }
+
+ private:
+  multi_filtration_grid filtration_grid_;
+};
+
 // Wrappers of the functions in Simplex_tree_multi.h, to deal with the "pointer only" python interface
 void flatten_diag_from_ptr(const uintptr_t splxptr, const uintptr_t newsplxptr, const std::vector<interface_multi::Options::value_type> basepoint, int dimension){ // for python
 	auto &st = get_simplextree_from_pointer<interface_std>(newsplxptr);
@@ -248,6 +537,21 @@ void linear_projection_from_ptr(const uintptr_t ptr, const uintptr_t ptr_multi,
 	auto &st_multi = get_simplextree_from_pointer<interface_multi>(ptr_multi);
 	linear_projection(st, st_multi, args...);
 }
+void flatten_in_box_from_ptr(uintptr_t splxptr, uintptr_t newsplxptr, const multi_filtration_type& bottom, const multi_filtration_type& upper, const int dimension = 0){ // for python
+	auto &st = get_simplextree_from_pointer<interface_std>(newsplxptr);
+	auto &st_multi = get_simplextree_from_pointer<interface_multi>(splxptr);
+	flatten_in_box(st, st_multi, multi_filtrations::Box<interface_multi::Options::value_type>(bottom, upper), dimension);
+}
+void flatten_diag_in_box_from_ptr(uintptr_t splxptr, uintptr_t newsplxptr, const multi_filtration_type& bottom, const multi_filtration_type& upper, const std::vector<interface_multi::Options::value_type>& basepoint, int dimension){ // for python
+	auto &st = get_simplextree_from_pointer<interface_std>(newsplxptr);
+	auto &st_multi = get_simplextree_from_pointer<interface_multi>(splxptr);
+	flatten_diag_in_box(st, st_multi, multi_filtrations::Box<interface_multi::Options::value_type>(bottom, upper), basepoint, dimension);
+}
+void linear_projection_in_box_from_ptr(const uintptr_t ptr, const uintptr_t ptr_multi, const multi_filtration_type& bottom, const multi_filtration_type& upper, const std::vector<interface_multi::Options::value_type>& linear_form){ // for python
+	auto &st = get_simplextree_from_pointer<interface_std>(ptr);
+	auto &st_multi = get_simplextree_from_pointer<interface_multi>(ptr_multi);
+	linear_projection_in_box(st, st_multi, multi_filtrations::Box<interface_multi::Options::value_type>(bottom, upper), linear_form);
+}
 
 
 }  // namespace Gudhi
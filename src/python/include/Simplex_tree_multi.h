@@ -13,9 +13,26 @@
 #define SIMPLEX_TREE_MULTI_H_
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>  // for std::conditional_t
+#include <vector>
 #include <gudhi/Simplex_tree.h>
 #include "multi_filtrations/finitely_critical_filtrations.h"
+#include "multi_filtrations/multi_critical_filtrations.h"
 #include "multi_filtrations/line.h"
+#include "multi_filtrations/filtration_table.h"
+#include "multi_filtrations/grid_snapper.h"
+#include "multi_filtrations/grid_builder.h"
+#include "multi_filtrations/filtration_statistics.h"
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
 
 
 
@@ -45,7 +62,83 @@ public:
 
 
 
+/** Model of SimplexTreeOptions, with a number of parameters fixed at compile time.
+ *
+ * Filtration values are stored inline in the nodes of the simplex tree (no heap allocation per simplex),
+ * which divides by more than two the memory footprint for bifiltrations. */
+template<std::size_t num_parameters, typename value_type_ = float>
+struct Simplex_tree_options_multidimensional_filtration_fixed {
+public:
+	typedef linear_indexing_tag Indexing_tag;
+	typedef int Vertex_handle;
+	typedef value_type_ value_type;
+	using Filtration_value = multi_filtrations::Finitely_critical_multi_filtration_fixed<value_type, num_parameters>;
+	typedef std::uint32_t Simplex_key;
+	static const bool store_key = true;
+	static const bool store_filtration = true;
+	static const bool contiguous_vertices = false;
+	static const bool link_nodes_by_label = true;
+	static const bool stable_simplex_handles = false;
+	static const bool is_multi_parameter = true;
+};
+
+
+/** Model of SimplexTreeOptions, for filtrations squeezed on a grid.
+ *
+ * Filtration values are integer coordinates in a grid, which is stored once outside of the nodes
+ * (cf. squeeze_to_coordinates). Infinite coordinates are represented by the extremal values of the integer type.
+ * With a number of parameters fixed at compile time, the coordinates are stored inline in the nodes, as with
+ * options_multi_fixed : 2 coordinates of std::int16_t take 4 bytes in the node, instead of a vector and a heap buffer
+ * of floats. Otherwise (num_parameters = 0), as with options_multi, the coordinates of each simplex are stored in
+ * their own heap buffer, only narrower. */
+template<typename coordinate_type = std::int32_t, std::size_t num_parameters = 0>
+struct Simplex_tree_options_multidimensional_filtration_coordinates {
+public:
+	typedef linear_indexing_tag Indexing_tag;
+	typedef int Vertex_handle;
+	typedef coordinate_type value_type;
+	using Filtration_value = std::conditional_t<num_parameters == 0,
+		multi_filtrations::Finitely_critical_multi_filtration<value_type>,
+		multi_filtrations::Finitely_critical_multi_filtration_fixed<value_type, num_parameters>>;
+	typedef std::uint32_t Simplex_key;
+	static const bool store_key = true;
+	static const bool store_filtration = true;
+	static const bool contiguous_vertices = false;
+	static const bool link_nodes_by_label = true;
+	static const bool stable_simplex_handles = false;
+	static const bool is_multi_parameter = true;
+};
+
+
+/** Model of SimplexTreeOptions, for multi-critical filtrations.
+ *
+ * The filtration value of a simplex is a minimal antichain of grades (cf. Multi_critical_filtration) :
+ * inserting a simplex that already exists at an incomparable grade adds this grade to it,
+ * and make_filtration_non_decreasing intersects the grades of a simplex with the ones of its faces. */
+template<typename value_type_ = float>
+struct Simplex_tree_options_multidimensional_filtration_multi_critical {
+public:
+	typedef linear_indexing_tag Indexing_tag;
+	typedef int Vertex_handle;
+	typedef value_type_ value_type;
+	using Filtration_value = multi_filtrations::Multi_critical_filtration<value_type>;
+	typedef std::uint32_t Simplex_key;
+	static const bool store_key = true;
+	static const bool store_filtration = true;
+	static const bool contiguous_vertices = false;
+	static const bool link_nodes_by_label = true;
+	static const bool stable_simplex_handles = false;
+	static const bool is_multi_parameter = true;
+};
+
+
 using options_multi = Simplex_tree_options_multidimensional_filtration;
+template<std::size_t num_parameters>
+using options_multi_fixed = Simplex_tree_options_multidimensional_filtration_fixed<num_parameters>;
+template<typename coordinate_type = std::int32_t, std::size_t num_parameters = 0>
+using options_multi_coordinates = Simplex_tree_options_multidimensional_filtration_coordinates<coordinate_type, num_parameters>;
+template<typename value_type = float>
+using options_multi_critical = Simplex_tree_options_multidimensional_filtration_multi_critical<value_type>;
 using options_std = Simplex_tree_options_full_featured;
 using simplextree_std = Simplex_tree<options_std>;
 using simplextree_multi = Simplex_tree<options_multi>;
@@ -66,6 +159,18 @@ void multify(simplextree_std &st, simplextree_multi &st_multi, const int num_par
 	typename simplextree_multi::Options::Filtration_value f(num_parameters);
 	for (auto i = 0u; i<std::min(static_cast<unsigned int>(default_values.size()), static_cast<unsigned int>(num_parameters-1));i++)
 		f[i+1] = default_values[i];
+	if (st_multi.num_vertices() == 0){
+		// Same structure : the tree is copied node by node, and the filtration values are filled in parallel.
+		using simplextree_multi_base = Simplex_tree<typename simplextree_multi::Options>;
+		const auto number_of_parameters = st_multi.get_number_of_parameters();
+		static_cast<simplextree_multi_base&>(st_multi) = simplextree_multi_base(st, [&f, num_parameters](const auto& filtration){
+			auto out = f;
+			if (num_parameters > 0) out[0] = filtration;
+			return out;
+		});
+		st_multi.set_number_of_parameters(number_of_parameters);
+		return;
+	}
 	std::vector<int> simplex;
 	simplex.reserve(st.dimension()+1);
 	for (auto &simplex_handle : st.complex_simplex_range()){
@@ -82,12 +187,76 @@ void multify(simplextree_std &st, simplextree_multi &st_multi, const int num_par
 }
 
 
+// Fills the empty st_multi with the function-Rips bifiltration of a point cloud, up to dimension max_dimension : the
+// first parameter is the Rips filtration, i.e., the length of the longest edge, and the second one is the lower-star
+// filtration of vertex_values, i.e., their maximum on the vertices. Edges longer than threshold are not inserted.
+// The edges are computed in parallel, and both parameters are assigned during the (parallel) expansion, so that the
+// filtration is non-decreasing without any other pass.
+template<class simplextree_multi>
+void function_rips(simplextree_multi &st_multi, const std::vector<std::vector<typename simplextree_multi::Options::value_type>>& points,
+		const std::vector<typename simplextree_multi::Options::value_type>& vertex_values, typename simplextree_multi::Options::value_type threshold, int max_dimension){
+	using value_type = typename simplextree_multi::Options::value_type;
+	using Filtration_value = typename simplextree_multi::Options::Filtration_value;
+	const std::size_t num_points = points.size();
+	if (vertex_values.size() != num_points)
+		throw std::invalid_argument("There has to be one function value per point.");
+	for (const auto& point : points)
+		if (point.size() != points.front().size())
+			throw std::invalid_argument("The points have to be of the same dimension.");
+	if (max_dimension < 0)
+		throw std::invalid_argument("The maximal dimension has to be non-negative.");
+	if (st_multi.num_vertices() != 0)
+		throw std::invalid_argument("The simplextree has to be empty.");
+	auto distance = [&points](std::size_t i, std::size_t j){
+		double squared_distance = 0;
+		for (std::size_t k = 0; k < points[i].size(); k++){
+			const double d = static_cast<double>(points[i][k]) - static_cast<double>(points[j][k]);
+			squared_distance += d * d;
+		}
+		return static_cast<value_type>(std::sqrt(squared_distance));
+	};
+	// neighbors[i] : the points j < i closer than threshold
+	std::vector<std::vector<std::pair<int, value_type>>> neighbors(num_points);
+	auto compute_neighbors = [&](std::size_t i){
+		for (std::size_t j = 0; j < i; j++){
+			const value_type d = distance(i, j);
+			if (d <= threshold) neighbors[i].emplace_back(static_cast<int>(j), d);
+		}
+	};
+#ifdef GUDHI_USE_TBB
+	tbb::parallel_for(std::size_t(0), num_points, compute_neighbors);
+#else
+	for (std::size_t i = 0; i < num_points; i++) compute_neighbors(i);
+#endif
+	st_multi.set_number_of_parameters(2);
+	for (std::size_t i = 0; i < num_points; i++)
+		st_multi.insert_simplex({static_cast<int>(i)}, Filtration_value{value_type(0), vertex_values[i]});
+	if (max_dimension < 1) return;
+	for (std::size_t i = 0; i < num_points; i++)
+		for (const auto& [j, d] : neighbors[i])
+			st_multi.insert_simplex({j, static_cast<int>(i)}, Filtration_value{d, std::max(vertex_values[i], vertex_values[j])});
+	// Both parameters are flag filtrations, computed from the vertices of the new simplices, which is thread safe.
+	st_multi.expansion_with_monotone_blockers(max_dimension, [&](auto simplex_handle){
+		thread_local std::vector<int> vertices;
+		vertices.assign(st_multi.simplex_vertex_range(simplex_handle).begin(), st_multi.simplex_vertex_range(simplex_handle).end());
+		value_type diameter = 0, value = -std::numeric_limits<value_type>::infinity();
+		for (std::size_t a = 0; a < vertices.size(); a++){
+			value = std::max(value, vertex_values[vertices[a]]);
+			for (std::size_t b = 0; b < a; b++) diameter = std::max(diameter, distance(vertices[a], vertices[b]));
+		}
+		st_multi.assign_filtration(simplex_handle, Filtration_value{diameter, value});
+		return false;
+	});
+}
+
+
 
 // Turns a multi-parameter simplextree into a 1-parameter simplextree
 template<class simplextree_std, class simplextree_multi>
 void flatten(simplextree_std &st, simplextree_multi &st_multi, const int dimension = 0){
+	std::vector<int> simplex;
 	for (const auto &simplex_handle : st_multi.complex_simplex_range()){
-		std::vector<int> simplex;
+		simplex.clear();
 		for (auto vertex : st_multi.simplex_vertex_range(simplex_handle))
 			simplex.push_back(vertex);
 		typename simplextree_multi::Options::value_type f = dimension >= 0 ? st_multi.filtration(simplex_handle)[dimension] : 0;
@@ -112,21 +281,95 @@ void linear_projection(simplextree_std &st, simplextree_multi &st_multi, const s
 template<class simplextree_std, class simplextree_multi>
 void flatten_diag(simplextree_std &st, simplextree_multi &st_multi, const std::vector<typename simplextree_multi::Options::value_type> basepoint, int dimension){
 	multi_filtrations::Line<typename simplextree_multi::Options::value_type> l(basepoint);
+	if (dimension <0)	 dimension = 0;
+	std::vector<int> simplex;
 	for (const auto &simplex_handle : st_multi.complex_simplex_range()){
-		std::vector<int> simplex;
+		simplex.clear();
 		for (auto vertex : st_multi.simplex_vertex_range(simplex_handle))
 			simplex.push_back(vertex);
-		
-		std::vector<typename simplextree_multi::Options::value_type> f = st_multi.filtration(simplex_handle);
-		if (dimension <0)	 dimension = 0;
-		typename simplextree_multi::Options::value_type new_filtration = l.push_forward(f)[dimension];
+		typename simplextree_multi::Options::value_type new_filtration = l.push_forward_coordinate(st_multi.filtration(simplex_handle), dimension);
 		st.insert_simplex(simplex,new_filtration);
 	}
 }
 
 
 
+// Inserts in st the simplices of st_multi whose filtration value is in the box, i.e., smaller or equal to its upper
+// corner, with the 1-parameter filtration projection(f), where f is the filtration value clamped to the bottom corner.
+// The filtration of st_multi has to be non-decreasing : the cofaces of a simplex out of the box are then out of the
+// box, and as they are its descendants in the tree, they are skipped without being visited.
+template<class simplextree_std, class simplextree_multi, class Projection>
+void project_in_box(simplextree_std &st, simplextree_multi &st_multi, const multi_filtrations::Box<typename simplextree_multi::Options::value_type>& box, Projection&& projection){
+	using value_type = typename simplextree_multi::Options::value_type;
+	const auto& bottom = box.get_bottom_corner();
+	const auto& upper = box.get_upper_corner();
+	std::vector<value_type> f;
+	std::vector<int> simplex;
+	st_multi.for_each_simplex([&](auto simplex_handle, int){
+		const auto& filtration = st_multi.filtration(simplex_handle);
+		for (std::size_t i = 0; i < std::min(filtration.size(), upper.size()); i++)
+			if (filtration[i] > upper[i]) return true;
+		f.assign(filtration.begin(), filtration.end());
+		for (std::size_t i = 0; i < std::min(f.size(), bottom.size()); i++)
+			f[i] = std::max(f[i], bottom[i]);
+		simplex.clear();
+		for (auto vertex : st_multi.simplex_vertex_range(simplex_handle))
+			simplex.push_back(vertex);
+		st.insert_simplex(simplex, projection(f));
+		return false;
+	});
+}
+
+// Same as flatten, restricted to a box, cf. project_in_box.
+template<class simplextree_std, class simplextree_multi>
+void flatten_in_box(simplextree_std &st, simplextree_multi &st_multi, const multi_filtrations::Box<typename simplextree_multi::Options::value_type>& box, const int dimension = 0){
+	using value_type = typename simplextree_multi::Options::value_type;
+	project_in_box(st, st_multi, box, [dimension](const std::vector<value_type>& f){ return dimension >= 0 ? f[dimension] : 0; });
+}
+
+// Same as flatten_diag, restricted to a box, cf. project_in_box.
+template<class simplextree_std, class simplextree_multi>
+void flatten_diag_in_box(simplextree_std &st, simplextree_multi &st_multi, const multi_filtrations::Box<typename simplextree_multi::Options::value_type>& box, const std::vector<typename simplextree_multi::Options::value_type>& basepoint, int dimension){
+	using value_type = typename simplextree_multi::Options::value_type;
+	multi_filtrations::Line<value_type> l(basepoint);
+	if (dimension < 0) dimension = 0;
+	project_in_box(st, st_multi, box, [&](const std::vector<value_type>& f){ return l.push_forward_coordinate(f, dimension); });
+}
+
+// Same as linear_projection, restricted to a box, cf. project_in_box. st is filled, and does not need to be a copy of st_multi.
+template<class simplextree_std, class simplextree_multi>
+void linear_projection_in_box(simplextree_std &st, simplextree_multi &st_multi, const multi_filtrations::Box<typename simplextree_multi::Options::value_type>& box, const std::vector<typename simplextree_multi::Options::value_type>& linear_form){
+	using value_type = typename simplextree_multi::Options::value_type;
+	project_in_box(st, st_multi, box, [&](const std::vector<value_type>& f){
+		value_type out = 0;
+		for (std::size_t i = 0; i < std::min(f.size(), linear_form.size()); i++) out += linear_form[i] * f[i];
+		return out;
+	});
+}
+
+
+
+/// @brief turns a filtration value into its (closest) coordinate in a sorted 1d grid
+template<typename value_type, typename grid_type>
+inline value_type find_coordinate(const value_type to_project, const grid_type& filtration){
+	// linear scan; prefer multi_filtrations::Grid_snapper to project many values on the same grid.
+	if constexpr (std::numeric_limits<value_type>::has_infinity)
+		if (to_project == std::numeric_limits<value_type>::infinity())
+			return std::numeric_limits<value_type>::infinity();
+	if (to_project >= filtration.back())
+		return filtration.size()-1; // deals with infinite value at the end of the grid
 
+	unsigned int i = 0;
+	while (i<filtration.size() && to_project > filtration[i]) {
+		i++;
+	}
+	if (i==0)
+		return 0;
+	value_type d1,d2;
+	d1 = std::abs(filtration[i-1] - to_project);
+	d2 = std::abs(filtration[i] - to_project);
+	return d1<d2 ? i-1 : i;
+}
 
 /// @brief turns filtration value x into coordinates in the grid
 /// @tparam out_type 
@@ -135,56 +378,193 @@ void flatten_diag(simplextree_std &st, simplextree_multi &st_multi, const std::v
 /// @return 
 template<typename out_type=int, typename vector_like>
 inline void find_coordinates(vector_like& x, const multi_filtration_grid &grid){
-	// TODO: optimize with, e.g., dichotomy
-	
 	for (auto parameter = 0u; parameter < grid.size(); parameter++){
 		const auto& filtration = grid[parameter]; // assumes its sorted
-		const auto to_project = x[parameter];
-		if constexpr (std::numeric_limits<typename vector_like::value_type>::has_infinity)
-			if (to_project == std::numeric_limits<typename vector_like::value_type>::infinity()){
-				x[parameter] = std::numeric_limits<typename vector_like::value_type>::infinity();
-				continue;
-			}
-		if (to_project >= filtration.back()){
-			x[parameter] = filtration.size()-1;
-			continue;
-		} // deals with infinite value at the end of the grid
-
-		unsigned int i = 0;
-		while (to_project > filtration[i] && i<filtration.size()) {
-			i++;
-		}
-		if (i==0)
-			x[parameter] = 0;
-		else if (i < filtration.size()){
-			typename vector_like::value_type d1,d2;
-			d1 = std::abs(filtration[i-1] - to_project);
-			d2 = std::abs(filtration[i] - to_project);
-			x[parameter] = d1<d2 ? i-1 : i;
-		}
+		x[parameter] = find_coordinate<typename vector_like::value_type>(x[parameter], filtration);
+	}
+}
+
+
+// Analyses each parameter of the grid once, cf. multi_filtrations::Grid_snapper.
+template<typename value_type>
+std::vector<multi_filtrations::Grid_snapper<value_type>> make_grid_snappers(const multi_filtration_grid &grid){
+	std::vector<multi_filtrations::Grid_snapper<value_type>> snappers;
+	snappers.reserve(grid.size());
+	for (const auto& filtration : grid){
+		snappers.emplace_back(std::vector<value_type>(filtration.begin(), filtration.end()));
+#ifdef DEBUG_TRACES
+		std::clog << "Grid of size " << filtration.size() << " snapped with "
+			<< multi_filtrations::snapping_strategy_name(snappers.back().strategy()) << std::endl;
+#endif  // DEBUG_TRACES
 	}
+	return snappers;
 }
 
+template<typename value_type>
+std::vector<multi_filtrations::Snapping_strategy> snapping_strategies(const std::vector<multi_filtrations::Grid_snapper<value_type>>& snappers){
+	std::vector<multi_filtrations::Snapping_strategy> out;
+	out.reserve(snappers.size());
+	for (const auto& snapper : snappers) out.push_back(snapper.strategy());
+	return out;
+}
 
 // TODO integer filtrations, does this help with performance ?
 // projects filtrations values to the grid. If coordinate_values is set to true, the filtration values are the coordinates of this grid
-void squeeze_filtration(uintptr_t splxptr, const multi_filtration_grid &grid, bool coordinate_values=true){
-	
-	Simplex_tree<options_multi> &st_multi = *(Gudhi::Simplex_tree<options_multi>*)(splxptr);
-	auto num_parameters = static_cast<unsigned int>(st_multi.get_number_of_parameters());
-	if (grid.size() != num_parameters){
-		std::cerr << "Bad grid !" << std::endl;
-		throw;
-	}
-	for (const auto &simplex_handle : st_multi.complex_simplex_range()){
+// Returns the snapping strategy used for each parameter.
+template<class simplextree_multi>
+std::vector<multi_filtrations::Snapping_strategy> squeeze_filtration(simplextree_multi &st_multi, const multi_filtration_grid &grid, bool coordinate_values=true){
+	using value_type = typename simplextree_multi::Options::value_type;
+	const auto num_parameters = static_cast<unsigned int>(st_multi.get_number_of_parameters());
+	if (grid.size() != num_parameters)
+		throw std::invalid_argument("Bad grid !");
+	const auto snappers = make_grid_snappers<value_type>(grid);
+	auto squeeze = [&](typename simplextree_multi::Simplex_handle simplex_handle){
 		auto& simplex_filtration = st_multi.filtration_mutable(simplex_handle);
-		find_coordinates<options_multi::value_type>(simplex_filtration, grid); // turns the simplexfiltration into coords in the grid
-		if (!coordinate_values){
-			for (auto parameter = 0u; parameter < num_parameters; parameter++)
-				simplex_filtration[parameter] = grid[parameter][simplex_filtration[parameter]];
+		for (auto parameter = 0u; parameter < num_parameters; parameter++)
+			simplex_filtration[parameter] = coordinate_values ? snappers[parameter].coordinate(simplex_filtration[parameter]) : snappers[parameter].value(simplex_filtration[parameter]);
+	};
+#ifdef GUDHI_USE_TBB
+	std::vector<typename simplextree_multi::Simplex_handle> simplex_handles;
+	simplex_handles.reserve(st_multi.num_simplices());
+	for (const auto &simplex_handle : st_multi.complex_simplex_range())
+		simplex_handles.push_back(simplex_handle);
+	// each simplex owns its filtration value, so the updates are independent.
+	tbb::parallel_for(tbb::blocked_range<std::size_t>(0, simplex_handles.size()), [&](const tbb::blocked_range<std::size_t>& range){
+		for (auto i = range.begin(); i != range.end(); ++i) squeeze(simplex_handles[i]);
+	});
+#else
+	for (const auto &simplex_handle : st_multi.complex_simplex_range())
+		squeeze(simplex_handle);
+#endif
+	return snapping_strategies(snappers);
+}
+
+std::vector<multi_filtrations::Snapping_strategy> squeeze_filtration(uintptr_t splxptr, const multi_filtration_grid &grid, bool coordinate_values=true){
+	Simplex_tree<options_multi> &st_multi = *(Gudhi::Simplex_tree<options_multi>*)(splxptr);
+	return squeeze_filtration(st_multi, grid, coordinate_values);
+}
+
+// Replaces st_coordinates by a copy of st_multi, with the filtration values replaced by their (integer) coordinates in the grid.
+// The grid is not stored in the simplextree, the caller has to keep it to recover filtration values (cf. unsqueeze_from_coordinates).
+// The tree structure is copied node by node, and the coordinates are computed in parallel (cf. the translating copy
+// constructor of Simplex_tree).
+template<class simplextree_multi, class simplextree_coordinates>
+std::vector<multi_filtrations::Snapping_strategy> squeeze_to_coordinates(simplextree_multi &st_multi, simplextree_coordinates &st_coordinates, const multi_filtration_grid &grid){
+	using value_type = typename simplextree_multi::Options::value_type;
+	using coordinate_type = typename simplextree_coordinates::Options::value_type;
+	using simplextree_coordinates_base = Simplex_tree<typename simplextree_coordinates::Options>;
+	static_assert(std::is_integral_v<coordinate_type>, "Coordinates have to be integers.");
+	const auto num_parameters = static_cast<unsigned int>(st_multi.get_number_of_parameters());
+	if (grid.size() != num_parameters)
+		throw std::invalid_argument("Bad grid !");
+	for (const auto& filtration : grid)
+		if (filtration.size() >= static_cast<std::size_t>(std::numeric_limits<coordinate_type>::max()))
+			throw std::invalid_argument("Grid too large for this coordinate type.");
+	const auto snappers = make_grid_snappers<value_type>(grid);
+	static_cast<simplextree_coordinates_base&>(st_coordinates) = simplextree_coordinates_base(st_multi, [&](const auto& filtration){
+		typename simplextree_coordinates::Filtration_value coordinates(num_parameters);
+		for (auto parameter = 0u; parameter < num_parameters; parameter++){
+			const value_type coordinate = snappers[parameter].coordinate(filtration[parameter]);
+			coordinates[parameter] = coordinate == multi_filtrations::plus_infinity<value_type>()
+				? multi_filtrations::plus_infinity<coordinate_type>()
+				: static_cast<coordinate_type>(coordinate);
 		}
+		return coordinates;
+	});
+	st_coordinates.set_number_of_parameters(num_parameters);
+	return snapping_strategies(snappers);
+}
+
+// Inverse of squeeze_to_coordinates : replaces st_multi by a copy of st_coordinates, with the grid values of their coordinates.
+template<class simplextree_coordinates, class simplextree_multi>
+void unsqueeze_from_coordinates(simplextree_coordinates &st_coordinates, simplextree_multi &st_multi, const multi_filtration_grid &grid){
+	using value_type = typename simplextree_multi::Options::value_type;
+	using coordinate_type = typename simplextree_coordinates::Options::value_type;
+	using simplextree_multi_base = Simplex_tree<typename simplextree_multi::Options>;
+	const auto num_parameters = static_cast<unsigned int>(st_coordinates.get_number_of_parameters());
+	if (grid.size() != num_parameters)
+		throw std::invalid_argument("Bad grid !");
+	static_cast<simplextree_multi_base&>(st_multi) = simplextree_multi_base(st_coordinates, [&](const auto& coordinates){
+		typename simplextree_multi::Filtration_value filtration(num_parameters);
+		for (auto parameter = 0u; parameter < num_parameters; parameter++){
+			const coordinate_type coordinate = coordinates[parameter];
+			if (coordinate == multi_filtrations::plus_infinity<coordinate_type>())
+				filtration[parameter] = multi_filtrations::plus_infinity<value_type>();
+			else if (coordinate < 0 || grid[parameter].empty()) // unset coordinates
+				filtration[parameter] = multi_filtrations::minus_infinity<value_type>();
+			else
+				filtration[parameter] = grid[parameter][std::min(static_cast<std::size_t>(coordinate), grid[parameter].size()-1)];
+		}
+		return filtration;
+	});
+	st_multi.set_number_of_parameters(num_parameters);
+}
+
+// Counters of fill_lowerstar.
+struct Lowerstar_timings {
+	double seconds = 0;            // wall-clock time of the fill
+	std::size_t num_simplices = 0; // number of filled simplices
+	std::size_t num_axes = 0;      // number of filled parameters
+	std::size_t num_tasks = 0;     // number of independent subtrees (root vertices)
+};
+
+template<class simplextree_multi>
+std::size_t rec_fill_lowerstar_axes(simplextree_multi &st_multi, typename simplextree_multi::Siblings* sib, const typename simplextree_multi::Filtration_value* parent,
+		const std::vector<std::vector<typename simplextree_multi::Options::value_type>>& filtrations, const std::vector<int>& axes){
+	std::size_t count = 0;
+	for (auto simplex_handle = sib->members().begin(); simplex_handle != sib->members().end(); ++simplex_handle){
+		// the node label is the largest vertex of the simplex, its parent is the simplex without this vertex.
+		auto& filtration = st_multi.filtration_mutable(simplex_handle);
+		for (std::size_t i = 0; i < axes.size(); i++){
+			const auto value = filtrations[i][simplex_handle->first];
+			filtration[axes[i]] = parent == nullptr ? value : std::max((*parent)[axes[i]], value);
+		}
+		count++;
+		if (st_multi.has_children(simplex_handle))
+			count += rec_fill_lowerstar_axes(st_multi, simplex_handle->second.children(), &filtration, filtrations, axes);
 	}
-	return;
+	return count;
+}
+
+// Fills the parameters axes[i] with the lower-star filtrations induced by the vertex values filtrations[i], in one pass.
+// A simplex takes the maximum of its parent's value and of its last vertex, so this costs O(axes.size()) per simplex,
+// and the subtrees of the root vertices, which do not share nodes, are filled in parallel.
+template<class simplextree_multi>
+Lowerstar_timings fill_lowerstar(simplextree_multi &st_multi, const std::vector<std::vector<typename simplextree_multi::Options::value_type>>& filtrations,
+		const std::vector<int>& axes){
+	if (filtrations.size() != axes.size())
+		throw std::invalid_argument("There should be one filtration per axis.");
+	for (int axis : axes)
+		if (axis < 0 || axis >= st_multi.get_number_of_parameters())
+			throw std::invalid_argument("Bad axis !");
+	const auto start = std::chrono::steady_clock::now();
+	Lowerstar_timings timings;
+	auto& root = st_multi.root()->members();
+	timings.num_axes = axes.size();
+	timings.num_tasks = root.size();
+	auto fill = [&](std::size_t begin, std::size_t end){
+		std::size_t count = 0;
+		for (auto simplex_handle = root.begin() + begin; simplex_handle != root.begin() + end; ++simplex_handle){
+			auto& filtration = st_multi.filtration_mutable(simplex_handle);
+			for (std::size_t i = 0; i < axes.size(); i++)
+				filtration[axes[i]] = filtrations[i][simplex_handle->first];
+			count++;
+			if (st_multi.has_children(simplex_handle))
+				count += rec_fill_lowerstar_axes(st_multi, simplex_handle->second.children(), &filtration, filtrations, axes);
+		}
+		return count;
+	};
+#ifdef GUDHI_USE_TBB
+	std::atomic<std::size_t> count = 0;
+	tbb::parallel_for(tbb::blocked_range<std::size_t>(0, root.size()), [&](const tbb::blocked_range<std::size_t>& range){
+		count += fill(range.begin(), range.end());
+	});
+	timings.num_simplices = count;
+#else
+	timings.num_simplices = fill(0, root.size());
+#endif
+	timings.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return timings;
 }
 
 // retrieves the filtration values of a simplextree. Useful to generate a grid.
@@ -211,6 +591,231 @@ std::vector<multi_filtration_grid> get_filtration_values(const uintptr_t splxptr
 
 }
 
+// Statistics of the filtration values of the simplices of the given degrees (all of them if degrees is empty),
+// computed in a single pass over the simplex tree, in parallel with TBB.
+template<class simplextree_multi>
+multi_filtrations::Filtration_statistics<typename simplextree_multi::Options::value_type> compute_filtration_statistics(simplextree_multi &st_multi, const std::vector<int> &degrees){
+	using Statistics = multi_filtrations::Filtration_statistics<typename simplextree_multi::Options::value_type>;
+	const auto num_parameters = static_cast<std::size_t>(st_multi.get_number_of_parameters());
+	std::vector<bool> is_degree;
+	for (auto degree : degrees){
+		if (degree < 0) continue;
+		if (static_cast<std::size_t>(degree) >= is_degree.size()) is_degree.resize(degree + 1, false);
+		is_degree[degree] = true;
+	}
+	auto add = [&](Statistics& statistics, auto simplex_handle, int dimension){
+		if (!degrees.empty() && (static_cast<std::size_t>(dimension) >= is_degree.size() || !is_degree[dimension])) return;
+		statistics.add(st_multi.filtration(simplex_handle), dimension);
+	};
+#ifdef GUDHI_USE_TBB
+	tbb::enumerable_thread_specific<Statistics> local_statistics([num_parameters](){ return Statistics(num_parameters); });
+	st_multi.parallel_for_each_simplex([&](auto simplex_handle, int dimension){
+		add(local_statistics.local(), simplex_handle, dimension);
+	});
+	Statistics statistics(num_parameters);
+	for (const auto& local : local_statistics) statistics.merge(local);
+#else
+	Statistics statistics(num_parameters);
+	st_multi.for_each_simplex([&](auto simplex_handle, int dimension){ add(statistics, simplex_handle, dimension); });
+#endif
+	return statistics;
+}
+
+multi_filtrations::Filtration_statistics<options_multi::value_type> compute_filtration_statistics(const uintptr_t splxptr, const std::vector<int> &degrees){
+	Simplex_tree<options_multi> &st_multi = *(Gudhi::Simplex_tree<options_multi>*)(splxptr);
+	return compute_filtration_statistics(st_multi, degrees);
+}
+
+// Computes a grid of the filtration values of the simplices of the given degrees, with a strategy of
+// `multi_filtrations::grid_strategy_from_name`. The values are streamed in a flat buffer one parameter at a time,
+// so that the memory used is one value per simplex, instead of copying all the parameters in nested vectors.
+// The grid of each parameter is computed from its sorted distinct finite values, cf. `multi_filtrations::reduce_grid`.
+multi_filtration_grid compute_filtration_grid(const uintptr_t splxptr, const std::vector<int> &degrees, const std::string& strategy,
+		const std::vector<int>& resolutions, double drop_low=0, double drop_high=0){
+	using value_type = options_multi::value_type;
+	Simplex_tree<options_multi> &st_multi = *(Gudhi::Simplex_tree<options_multi>*)(splxptr);
+	const auto grid_strategy = multi_filtrations::grid_strategy_from_name(strategy);
+	const auto num_parameters = static_cast<std::size_t>(st_multi.get_number_of_parameters());
+	if (grid_strategy != multi_filtrations::Grid_strategy::exact && resolutions.size() != num_parameters)
+		throw std::invalid_argument("Resolutions must be provided for this strategy.");
+	std::vector<bool> is_degree;
+	for (auto degree : degrees){
+		if (degree < 0) continue;
+		if (static_cast<std::size_t>(degree) >= is_degree.size()) is_degree.resize(degree + 1, false);
+		is_degree[degree] = true;
+	}
+	multi_filtration_grid grid(num_parameters);
+	if (grid_strategy == multi_filtrations::Grid_strategy::regular && drop_low <= 0 && drop_high <= 0){
+		// only the bounds are needed
+		const auto statistics = compute_filtration_statistics(st_multi, degrees);
+		for (std::size_t parameter = 0; parameter < num_parameters; parameter++){
+			if (statistics.num_finite(parameter) == 0) continue;
+			const std::vector<value_type> bounds = {statistics.min(parameter), statistics.max(parameter)};
+			grid[parameter] = multi_filtrations::reduce_grid(bounds, grid_strategy, static_cast<std::size_t>(std::max(resolutions[parameter], 0)));
+		}
+		return grid;
+	}
+	std::vector<std::size_t> grid_resolutions(num_parameters, 0);
+	for (std::size_t parameter = 0; parameter < std::min(num_parameters, resolutions.size()); parameter++)
+		grid_resolutions[parameter] = static_cast<std::size_t>(std::max(resolutions[parameter], 0));
+	// The quantile grids of the parameters depend on each other, so their distinct values are kept
+	const bool is_quantile = grid_strategy == multi_filtrations::Grid_strategy::quantile;
+	std::vector<std::vector<value_type>> distinct_values(is_quantile ? num_parameters : 0);
+	std::vector<value_type> values;
+	values.reserve(st_multi.num_simplices());
+	for (std::size_t parameter = 0; parameter < num_parameters; parameter++){
+		values.clear();
+		st_multi.for_each_simplex([&](auto simplex_handle, int dimension){
+			if (static_cast<std::size_t>(dimension) >= is_degree.size() || !is_degree[dimension]) return;
+			const auto& filtration = st_multi.filtration(simplex_handle);
+			if (parameter < static_cast<std::size_t>(filtration.size())) values.push_back(filtration[parameter]);
+		});
+		multi_filtrations::sort_unique_finite(values);
+		multi_filtrations::drop_quantiles(values, drop_low, drop_high);
+		if (is_quantile)
+			distinct_values[parameter] = values;
+		else
+			grid[parameter] = multi_filtrations::reduce_grid(values, grid_strategy, grid_resolutions[parameter]);
+	}
+	if (is_quantile) return multi_filtrations::quantile_grids(distinct_values, grid_resolutions);
+	return grid;
+}
+
+
+
+// ######################## FILTRATION TABLE
+// Structure-of-arrays versions of the functions above, cf. multi_filtrations/filtration_table.h.
+// The keys of the simplices index the columns of the table.
+
+using filtration_table_type = multi_filtrations::Filtration_table<options_multi::value_type>;
+
+// Enumerates the simplices and copies their filtration values into a table.
+// Keys are assigned in the order of `for_each_simplex`, so that faces always have smaller keys than their cofaces.
+// WARNING : this overwrites the keys of the simplices.
+template<class simplextree_multi>
+multi_filtrations::Filtration_table<typename simplextree_multi::Options::value_type> make_filtration_table(simplextree_multi &st_multi){
+	const auto num_parameters = static_cast<std::size_t>(st_multi.get_number_of_parameters());
+	multi_filtrations::Filtration_table<typename simplextree_multi::Options::value_type> table(num_parameters, st_multi.num_simplices());
+	typename simplextree_multi::Simplex_key key = 0;
+	st_multi.for_each_simplex([&](auto simplex_handle, int dimension){
+		st_multi.assign_key(simplex_handle, key);
+		table.dimension(key) = dimension;
+		const auto& filtration = st_multi.filtration(simplex_handle);
+		const auto size = std::min(num_parameters, static_cast<std::size_t>(filtration.size()));
+		for (std::size_t parameter = 0; parameter < size; parameter++)
+			table(parameter, key) = filtration[parameter];
+		key++;
+	});
+	return table;
+}
+
+// Assigns to the simplices the keys of `make_filtration_table`, without copying their filtration values. These keys
+// only depend on the structure of the simplex tree, so a table remains valid for all the copies of this structure,
+// even if their keys have been overwritten since, e.g. by another table.
+template<class simplextree_multi>
+void assign_traversal_keys(simplextree_multi &st_multi){
+	typename simplextree_multi::Simplex_key key = 0;
+	st_multi.for_each_simplex([&](auto simplex_handle, int){
+		st_multi.assign_key(simplex_handle, key++);
+	});
+}
+
+// Writes back the values of a table, built with `make_filtration_table`, into the simplex tree.
+template<class simplextree_multi>
+void assign_filtration_table(simplextree_multi &st_multi, const multi_filtrations::Filtration_table<typename simplextree_multi::Options::value_type>& table){
+	const auto num_parameters = table.num_parameters();
+	for (const auto &simplex_handle : st_multi.complex_simplex_range()){
+		const auto key = st_multi.key(simplex_handle);
+		auto& filtration = st_multi.filtration_mutable(simplex_handle);
+		if (static_cast<std::size_t>(filtration.size()) != num_parameters)
+			filtration.resize(num_parameters);
+		for (std::size_t parameter = 0; parameter < num_parameters; parameter++)
+			filtration[parameter] = table(parameter, key);
+	}
+}
+
+template<class simplextree_multi, class value_type>
+void rec_fill_lowerstar(simplextree_multi &st_multi, typename simplextree_multi::Siblings* sib, value_type parent_value,
+		const std::vector<value_type>& filtration, value_type* out){
+	for (auto simplex_handle = sib->members().begin(); simplex_handle != sib->members().end(); ++simplex_handle){
+		// the node label is the largest vertex of the simplex, its parent is the simplex without this vertex.
+		const value_type value = std::max(parent_value, filtration[simplex_handle->first]);
+		out[st_multi.key(simplex_handle)] = value;
+		if (st_multi.has_children(simplex_handle))
+			rec_fill_lowerstar(st_multi, simplex_handle->second.children(), value, filtration, out);
+	}
+}
+
+// Fills a parameter of the table with the lower-star filtration induced by the vertex values `filtration`.
+// A simplex takes the maximum of its parent's value and of its last vertex, so this costs O(1) per simplex.
+template<class simplextree_multi>
+void fill_lowerstar(multi_filtrations::Filtration_table<typename simplextree_multi::Options::value_type>& table, simplextree_multi &st_multi,
+		const std::vector<typename simplextree_multi::Options::value_type>& filtration, int axis){
+	using value_type = typename simplextree_multi::Options::value_type;
+	if (axis < 0 || static_cast<std::size_t>(axis) >= table.num_parameters())
+		throw std::invalid_argument("Bad axis !");
+	rec_fill_lowerstar(st_multi, st_multi.root(), -std::numeric_limits<value_type>::infinity(), filtration, table.parameter(axis));
+}
+
+// projects the filtration values of a table on a grid, one contiguous parameter at a time.
+template<typename value_type>
+std::vector<multi_filtrations::Snapping_strategy> squeeze_filtration(multi_filtrations::Filtration_table<value_type>& table, const multi_filtration_grid &grid, bool coordinate_values=true){
+	if (grid.size() != table.num_parameters())
+		throw std::invalid_argument("Bad grid !");
+	const auto snappers = make_grid_snappers<value_type>(grid);
+	const auto num_simplices = table.num_simplices();
+	for (std::size_t parameter = 0; parameter < table.num_parameters(); parameter++){
+		value_type* values = table.parameter(parameter);
+		const auto& snapper = snappers[parameter];
+		auto squeeze = [&](std::size_t begin, std::size_t end){
+			if (coordinate_values)
+				for (std::size_t key = begin; key < end; key++) values[key] = snapper.coordinate(values[key]);
+			else
+				for (std::size_t key = begin; key < end; key++) values[key] = snapper.value(values[key]);
+		};
+#ifdef GUDHI_USE_TBB
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_simplices), [&](const tbb::blocked_range<std::size_t>& range){
+			squeeze(range.begin(), range.end());
+		});
+#else
+		squeeze(0, num_simplices);
+#endif
+	}
+	return snapping_strategies(snappers);
+}
+
+// scalar product of every filtration value of the table with a linear form, indexed by keys.
+template<typename value_type>
+std::vector<value_type> linear_projection(const multi_filtrations::Filtration_table<value_type>& table, const std::vector<value_type>& linear_form){
+	std::vector<value_type> out(table.num_simplices(), 0);
+	const auto size = std::min(linear_form.size(), table.num_parameters());
+	for (std::size_t parameter = 0; parameter < size; parameter++){
+		const value_type coefficient = linear_form[parameter];
+		const value_type* values = table.parameter(parameter);
+		for (std::size_t key = 0; key < out.size(); key++)
+			out[key] += coefficient * values[key];
+	}
+	return out;
+}
+
+// retrieves the filtration values of a table, in the same format as `get_filtration_values`.
+template<typename value_type>
+std::vector<multi_filtration_grid> get_filtration_values(const multi_filtrations::Filtration_table<value_type>& table, const std::vector<int> &degrees){
+	std::vector<multi_filtration_grid> out(degrees.size(), multi_filtration_grid(table.num_parameters()));
+	for (std::size_t i = 0; i < degrees.size(); i++){
+		const auto degree = degrees[i];
+		const auto count = static_cast<std::size_t>(std::count(table.dimensions().begin(), table.dimensions().end(), degree));
+		for (std::size_t parameter = 0; parameter < table.num_parameters(); parameter++){
+			auto& row = out[i][parameter];
+			row.reserve(count);
+			const value_type* values = table.parameter(parameter);
+			for (std::size_t key = 0; key < table.num_simplices(); key++)
+				if (table.dimension(key) == degree) row.push_back(values[key]);
+		}
+	}
+	return out;
+}
+
 }	// namespace Gudhi
 
 
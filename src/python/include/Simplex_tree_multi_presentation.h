@@ -0,0 +1,333 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file Simplex_tree_multi_presentation.h
+ * @brief Minimal presentations of the homology of 2-parameter filtrations.
+ */
+
+#ifndef SIMPLEX_TREE_MULTI_PRESENTATION_H_
+#define SIMPLEX_TREE_MULTI_PRESENTATION_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
+#endif
+
+namespace Gudhi::multiparameter {
+
+/**
+ * @brief Presentation of a 2-parameter persistence module with \f$\mathbb{Z}/2\mathbb{Z}\f$ coefficients : the
+ * module is the quotient of the free module on the generators by the submodule generated by the relations.
+ */
+template<typename value_type>
+struct Minimal_presentation {
+	using Grade = std::array<value_type, 2>;
+	std::vector<Grade> generator_grades;
+	std::vector<Grade> relation_grades;
+	// Indices of the generators of each relation, sorted.
+	std::vector<std::vector<std::size_t>> relations;
+};
+
+namespace presentation_detail {
+
+using Column = std::vector<std::size_t>;
+
+// Symmetric difference of two sorted columns, i.e., their sum with Z/2Z coefficients, in target.
+inline void add_column(Column& target, const Column& source, Column& buffer){
+	buffer.clear();
+	std::set_symmetric_difference(target.begin(), target.end(), source.begin(), source.end(), std::back_inserter(buffer));
+	target.swap(buffer);
+}
+
+// Boundary matrix of one dimension, whose columns are graded.
+template<typename value_type>
+struct Graded_matrix {
+	using Grade = std::array<value_type, 2>;
+	std::vector<Column> columns;  // sorted row indices
+	std::vector<Grade> grades;
+	std::size_t num_rows = 0;
+	// Columns sorted by increasing second parameter, then first parameter, then index (colexicographic order).
+	std::vector<std::size_t> order;
+	// Distinct values of the first parameter, increasing. The slice of x is made of the columns with a first parameter <= x.
+	std::vector<value_type> slices;
+
+	void sort(){
+		order.resize(columns.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b){
+			if (grades[a][1] != grades[b][1]) return grades[a][1] < grades[b][1];
+			if (grades[a][0] != grades[b][0]) return grades[a][0] < grades[b][0];
+			return a < b;
+		});
+		slices.clear();
+		for (const auto& grade : grades) slices.push_back(grade[0]);
+		std::sort(slices.begin(), slices.end());
+		slices.erase(std::unique(slices.begin(), slices.end()), slices.end());
+	}
+
+	/* Reduces the columns of the slice of x, in colexicographic order, and calls on_column(j, is_zero, v) for each
+	 * one, where v is the set of columns whose sum reduces column j to zero if is_zero and track_v. */
+	template<class F>
+	void reduce_slice(value_type x, bool track_v, F&& on_column) const {
+		std::vector<std::size_t> pivot_to_position(num_rows, std::numeric_limits<std::size_t>::max());
+		std::vector<Column> reduced;
+		std::vector<Column> v;
+		Column buffer;
+		for (std::size_t j : order){
+			if (grades[j][0] > x) continue;
+			Column column = columns[j];
+			Column v_column;
+			if (track_v) v_column.push_back(j);
+			while (!column.empty()){
+				const std::size_t position = pivot_to_position[column.back()];
+				if (position == std::numeric_limits<std::size_t>::max()) break;
+				add_column(column, reduced[position], buffer);
+				if (track_v) add_column(v_column, v[position], buffer);
+			}
+			const bool is_zero = column.empty();
+			on_column(j, is_zero, v_column);
+			if (!is_zero){
+				pivot_to_position[column.back()] = reduced.size();
+				reduced.push_back(std::move(column));
+				if (track_v) v.push_back(std::move(v_column));
+			}
+		}
+	}
+};
+
+// Calls f(i) for each slice index i, in parallel with TBB.
+template<class F>
+void for_each_slice(std::size_t num_slices, F&& f){
+#ifdef GUDHI_USE_TBB
+	tbb::parallel_for(std::size_t(0), num_slices, [&](std::size_t i){ f(i); });
+#else
+	for (std::size_t i = 0; i < num_slices; i++) f(i);
+#endif
+}
+
+/* Basis of the kernel of a graded matrix, which is a free module : the column j is a generator of grade (x, y_j) if it
+ * is reduced to zero in the slice of x but not in the previous one, and the generator is then the sum of the
+ * columns which reduce it in the slice of x. The slices are reduced in parallel, once to find when the columns become
+ * zero, and once more for the slices with new generators. */
+template<typename value_type>
+void kernel_basis(const Graded_matrix<value_type>& matrix, std::vector<std::array<value_type, 2>>& grades, std::vector<Column>& generators){
+	const std::size_t num_slices = matrix.slices.size();
+	std::vector<std::vector<bool>> is_zero(num_slices);
+	for_each_slice(num_slices, [&](std::size_t i){
+		is_zero[i].assign(matrix.columns.size(), false);
+		matrix.reduce_slice(matrix.slices[i], false, [&](std::size_t j, bool zero, const Column&){ is_zero[i][j] = zero; });
+	});
+	std::vector<std::vector<std::pair<std::size_t, Column>>> new_generators(num_slices);
+	for_each_slice(num_slices, [&](std::size_t i){
+		auto is_new = [&](std::size_t j){ return is_zero[i][j] && (i == 0 || !is_zero[i-1][j]); };
+		bool has_new = false;
+		for (std::size_t j = 0; j < matrix.columns.size() && !has_new; j++) has_new = is_new(j);
+		if (!has_new) return;
+		matrix.reduce_slice(matrix.slices[i], true, [&](std::size_t j, bool, const Column& v){
+			if (is_new(j)){
+				Column generator(v);
+				std::sort(generator.begin(), generator.end());
+				new_generators[i].emplace_back(j, std::move(generator));
+			}
+		});
+	});
+	for (std::size_t i = 0; i < num_slices; i++){
+		for (auto& [j, generator] : new_generators[i]){
+			grades.push_back({matrix.slices[i], matrix.grades[j][1]});
+			generators.push_back(std::move(generator));
+		}
+	}
+}
+
+/* Minimal generators of the image of a graded matrix : the columns which are not reduced to zero in the slice of
+ * their first parameter, i.e., which are not generated by the columns of smaller grades. */
+template<typename value_type>
+std::vector<std::size_t> image_minimal_generators(const Graded_matrix<value_type>& matrix){
+	const std::size_t num_slices = matrix.slices.size();
+	std::vector<std::vector<std::size_t>> selected(num_slices);
+	for_each_slice(num_slices, [&](std::size_t i){
+		const value_type x = matrix.slices[i];
+		matrix.reduce_slice(x, false, [&](std::size_t j, bool zero, const Column&){
+			if (!zero && matrix.grades[j][0] == x) selected[i].push_back(j);
+		});
+	});
+	std::vector<std::size_t> out;
+	for (const auto& s : selected) out.insert(out.end(), s.begin(), s.end());
+	std::sort(out.begin(), out.end());
+	return out;
+}
+
+/* Removes the pairs of a relation and a generator of the same grade appearing in it, which do not change the module,
+ * until there are none. The presentation is then minimal. */
+template<typename value_type>
+void minimize(Minimal_presentation<value_type>& presentation){
+	const std::size_t num_generators = presentation.generator_grades.size();
+	const std::size_t num_relations = presentation.relations.size();
+	std::vector<bool> removed_generator(num_generators, false);
+	std::vector<bool> removed_relation(num_relations, false);
+	Column buffer;
+	bool changed = true;
+	while (changed){
+		changed = false;
+		for (std::size_t c = 0; c < num_relations; c++){
+			if (removed_relation[c]) continue;
+			auto& relation = presentation.relations[c];
+			if (relation.empty()) { removed_relation[c] = true; continue; }
+			const auto it = std::find_if(relation.begin(), relation.end(), [&](std::size_t g){
+				return presentation.generator_grades[g] == presentation.relation_grades[c];
+			});
+			if (it == relation.end()) continue;
+			const std::size_t g = *it;
+			// The other relations containing g have a larger grade, so they can be reduced by c
+			for (std::size_t other = 0; other < num_relations; other++){
+				if (other == c || removed_relation[other]) continue;
+				auto& other_relation = presentation.relations[other];
+				if (std::binary_search(other_relation.begin(), other_relation.end(), g))
+					add_column(other_relation, relation, buffer);
+			}
+			removed_relation[c] = true;
+			removed_generator[g] = true;
+			changed = true;
+		}
+	}
+	Minimal_presentation<value_type> out;
+	std::vector<std::size_t> new_index(num_generators);
+	for (std::size_t g = 0; g < num_generators; g++){
+		if (removed_generator[g]) continue;
+		new_index[g] = out.generator_grades.size();
+		out.generator_grades.push_back(presentation.generator_grades[g]);
+	}
+	for (std::size_t c = 0; c < num_relations; c++){
+		if (removed_relation[c] || presentation.relations[c].empty()) continue;
+		Column relation;
+		for (std::size_t g : presentation.relations[c]) relation.push_back(new_index[g]);
+		out.relations.push_back(std::move(relation));
+		out.relation_grades.push_back(presentation.relation_grades[c]);
+	}
+	presentation = std::move(out);
+}
+
+}  // namespace presentation_detail
+
+/**
+ * @brief Minimal presentation of the homology in degree `degree` of a 2-parameter filtration, with
+ * \f$\mathbb{Z}/2\mathbb{Z}\f$ coefficients, computed in memory from the boundary matrices of the simplex tree.
+ *
+ * This follows M. Lesnick, M. Wright, <i>Computing minimal presentations and bigraded Betti numbers of 2-parameter
+ * persistent homology</i>, SIAM J. Appl. Algebra Geom. 2022 : a basis of the cycles is computed by reductions of the
+ * boundary matrix in degree `degree` restricted to the slices \f$\{x_j \leq x\}\f$, the minimal generators of the
+ * boundaries by reductions of the boundary matrix in degree `degree + 1`, the latter are written in the basis of the
+ * cycles, and the pairs of a generator and a relation of the same grade are removed. The slices are reduced in
+ * parallel with TBB. The filtration values do not have to be on a grid, but squeezing the filtration first reduces
+ * the number of slices. Simplices with a non-finite filtration value are ignored.
+ *
+ * WARNING : this overwrites the keys of the simplices.
+ */
+template<class simplextree_multi>
+Minimal_presentation<typename simplextree_multi::Options::value_type> minimal_presentation(simplextree_multi& st_multi, int degree){
+	using value_type = typename simplextree_multi::Options::value_type;
+	using Matrix = presentation_detail::Graded_matrix<value_type>;
+	using Column = presentation_detail::Column;
+	if (st_multi.get_number_of_parameters() != 2)
+		throw std::invalid_argument("Minimal presentations are only computed for 2-parameter filtrations.");
+	if (degree < 0) throw std::invalid_argument("The degree has to be non-negative.");
+
+	// Simplices of dimension degree - 1, degree and degree + 1, indexed by their keys in their dimension.
+	std::array<std::vector<typename simplextree_multi::Simplex_handle>, 3> simplices;
+	st_multi.for_each_simplex([&](auto sh, int dimension){
+		if (dimension < degree - 1 || dimension > degree + 1) return dimension > degree + 1;
+		const auto& filtration = st_multi.filtration(sh);
+		bool finite = filtration.size() >= 2;
+		for (std::size_t p = 0; p < 2 && finite; p++)
+			finite = filtration[p] > -std::numeric_limits<value_type>::infinity() && filtration[p] < std::numeric_limits<value_type>::infinity();
+		if (!finite) { st_multi.assign_key(sh, simplextree_multi::null_key()); return false; }
+		auto& s = simplices[dimension - degree + 1];
+		st_multi.assign_key(sh, s.size());
+		s.push_back(sh);
+		return false;
+	});
+	auto boundary_matrix = [&](std::size_t i){
+		Matrix matrix;
+		matrix.num_rows = i == 0 ? 0 : simplices[i-1].size();
+		for (auto sh : simplices[i]){
+			Column column;
+			if (i > 0)
+				for (auto face : st_multi.boundary_simplex_range(sh)) column.push_back(st_multi.key(face));
+			std::sort(column.begin(), column.end());
+			matrix.columns.push_back(std::move(column));
+			const auto& filtration = st_multi.filtration(sh);
+			matrix.grades.push_back({filtration[0], filtration[1]});
+		}
+		matrix.sort();
+		return matrix;
+	};
+	const Matrix cycles_matrix = boundary_matrix(1);
+	const Matrix boundaries_matrix = boundary_matrix(2);
+
+	Minimal_presentation<value_type> presentation;
+	std::vector<Column> generators;
+	std::vector<std::size_t> relation_columns;
+	auto compute_kernel = [&](){ presentation_detail::kernel_basis(cycles_matrix, presentation.generator_grades, generators); };
+	auto compute_image = [&](){ relation_columns = presentation_detail::image_minimal_generators(boundaries_matrix); };
+#ifdef GUDHI_USE_TBB
+	tbb::parallel_invoke(compute_kernel, compute_image);
+#else
+	compute_kernel();
+	compute_image();
+#endif
+
+	// The generators have distinct leading columns in the colexicographic order, so that a cycle is written in their
+	// basis by eliminating its leading column.
+	const std::size_t num_cycles = cycles_matrix.columns.size();
+	std::vector<std::size_t> position(num_cycles);
+	for (std::size_t i = 0; i < num_cycles; i++) position[cycles_matrix.order[i]] = i;
+	std::vector<Column> generator_positions(generators.size());
+	std::vector<std::size_t> leading_generator(num_cycles, std::numeric_limits<std::size_t>::max());
+	for (std::size_t g = 0; g < generators.size(); g++){
+		for (std::size_t j : generators[g]) generator_positions[g].push_back(position[j]);
+		std::sort(generator_positions[g].begin(), generator_positions[g].end());
+		leading_generator[generator_positions[g].back()] = g;
+	}
+	presentation.relations.resize(relation_columns.size());
+	presentation.relation_grades.resize(relation_columns.size());
+	presentation_detail::for_each_slice(relation_columns.size(), [&](std::size_t r){
+		const std::size_t c = relation_columns[r];
+		Column cycle, buffer, relation;
+		for (std::size_t j : boundaries_matrix.columns[c]) cycle.push_back(position[j]);
+		std::sort(cycle.begin(), cycle.end());
+		while (!cycle.empty()){
+			const std::size_t g = leading_generator[cycle.back()];
+			if (g == std::numeric_limits<std::size_t>::max())
+				throw std::logic_error("A boundary is not generated by the cycles.");
+			presentation_detail::add_column(cycle, generator_positions[g], buffer);
+			relation.push_back(g);
+		}
+		std::sort(relation.begin(), relation.end());
+		presentation.relations[r] = std::move(relation);
+		presentation.relation_grades[r] = boundaries_matrix.grades[c];
+	});
+	presentation_detail::minimize(presentation);
+	return presentation;
+}
+
+}	// namespace Gudhi::multiparameter
+
+#endif // SIMPLEX_TREE_MULTI_PRESENTATION_H_
@@ -0,0 +1,627 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file Simplex_tree_multi_scc.h
+ * @brief Export and import of multi-parameter simplex trees to the scc2020 (and firep) chain complex format,
+ * and import of Rivet bifiltration files.
+ *
+ * Format : https://bitbucket.org/mkerber/chain_complex_format/src/master/
+ */
+
+#ifndef SIMPLEX_TREE_MULTI_SCC_H_
+#define SIMPLEX_TREE_MULTI_SCC_H_
+
+#include <algorithm>
+#include <cctype>  // for std::isspace
+#include <charconv>
+#include <cstdio>  // for std::snprintf, when floating point std::to_chars is not available
+#include <cstdint>
+#include <cstdlib>  // for std::strtod, when floating point std::from_chars is not available
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "multi_filtrations/finitely_critical_filtrations.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GUDHI_SCC_USE_MMAP
+#endif
+
+namespace Gudhi::multiparameter {
+
+/** Options of write_scc, with the same meaning as the arguments of `SimplexTreeMulti.to_scc`. */
+struct Scc_writer_options {
+	bool ignore_last_generators = true;
+	bool strip_comments = false;
+	bool reverse_block = true;
+	bool rivet_compatible = false;  // writes the "firep" header instead, only for 2 parameters
+	bool binary = false;            // cf. write_scc
+};
+
+namespace internal {
+
+// Text output through a large buffer, numbers being formatted with std::to_chars (or snprintf for floating point
+// numbers, when the standard library does not support them). close() has to be called at the end, to check that
+// everything was written.
+class Scc_buffered_writer {
+public:
+	Scc_buffered_writer(const std::string& path, bool binary) : path_(path), file_(path, binary ? std::ios::out | std::ios::binary | std::ios::trunc : std::ios::out | std::ios::trunc){
+		if (!file_.is_open())
+			throw std::runtime_error("Could not open " + path);
+		buffer_.reserve(buffer_size);
+	}
+	~Scc_buffered_writer(){
+		// Only reached without close() when an exception was thrown, the file is incomplete anyway.
+		if (file_.is_open()) file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+	}
+
+	void write(const char* data, std::size_t size){
+		buffer_.insert(buffer_.end(), data, data + size);
+		if (buffer_.size() >= buffer_size) flush();
+	}
+	void write(const std::string& s){ write(s.data(), s.size()); }
+	void write(char c){ buffer_.push_back(c); }
+	template<typename T>
+	void write_number(T value){
+		char number[64];
+#if !(defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L)
+		if constexpr (std::is_floating_point_v<T>){
+			// Enough digits to read the same value back
+			const int size = std::snprintf(number, sizeof(number), "%.*g", std::numeric_limits<T>::max_digits10,
+			                               static_cast<double>(value));
+			write(number, static_cast<std::size_t>(size));
+			return;
+		}
+#endif
+		auto result = std::to_chars(number, number + sizeof(number), value);
+		write(number, static_cast<std::size_t>(result.ptr - number));
+	}
+	template<typename T>
+	void write_raw(const T& value){ write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+	void flush(){
+		file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+		buffer_.clear();
+		if (!file_.good())
+			throw std::runtime_error("Could not write " + path_);
+	}
+	void close(){
+		flush();
+		file_.close();
+		if (file_.fail())
+			throw std::runtime_error("Could not write " + path_);
+	}
+
+private:
+	static constexpr std::size_t buffer_size = 1 << 20;
+	std::string path_;
+	std::ofstream file_;
+	std::vector<char> buffer_;
+};
+
+}  // namespace internal
+
+/**
+ * @brief Writes the chain complex of a multi-parameter simplex tree in the scc2020 format, in one pass per dimension.
+ *
+ * The simplices of dimension d are written in the block of dimension d, and their boundaries are given
+ * as indices in the block of dimension d-1. Indices and block order are the same as `SimplexTreeMulti.to_scc`.
+ * A k-critical simplex (filtration of size k * num_parameters) is written on k lines.
+ *
+ * The binary variant stores the same content, in native endianness :
+ *  - the magic "SCCB" and a `std::uint32_t` version (1),
+ *  - `std::uint32_t` num_parameters and num_blocks, then the `num_blocks` block sizes as `std::uint64_t`
+ *    (highest dimension first, as in the text header),
+ *  - for each written block and each line : num_parameters filtration values (`value_type`),
+ *    the number of boundaries and the boundary indices (`std::uint32_t`).
+ *
+ * WARNING : this overwrites the keys of the simplices.
+ */
+template<class simplextree_multi>
+void write_scc(simplextree_multi &st_multi, const std::string& path, const Scc_writer_options& options = {}){
+	using Simplex_handle = typename simplextree_multi::Simplex_handle;
+	using value_type = typename simplextree_multi::Options::value_type;
+	const int num_parameters = st_multi.get_number_of_parameters();
+	if (options.rivet_compatible && num_parameters != 2)
+		throw std::invalid_argument("The firep format requires 2 parameters.");
+	if (num_parameters <= 0)
+		throw std::invalid_argument("Invalid number of parameters.");
+	const int dimension = st_multi.dimension();
+	const auto num_simplices = st_multi.num_simplices();
+
+	// Keys are assigned once; they index the position of the simplices in their blocks.
+	{
+		typename simplextree_multi::Simplex_key key = 0;
+		for (auto sh : st_multi.complex_simplex_range())
+			st_multi.assign_key(sh, key++);
+	}
+	constexpr std::uint32_t unassigned = std::numeric_limits<std::uint32_t>::max();
+	std::vector<std::uint32_t> index_in_block(num_simplices, unassigned);
+	std::vector<std::vector<Simplex_handle>> blocks(dimension + 1);
+
+	// Faces get their indices in the order they are met as boundaries, from the highest dimension
+	for (int dim = dimension; dim > 0; dim--){
+		for (auto sh : st_multi.skeleton_simplex_range(dim)){
+			if (st_multi.dimension(sh) != dim) continue;
+			for (auto face : st_multi.boundary_simplex_range(sh)){
+				auto& index = index_in_block[st_multi.key(face)];
+				if (index != unassigned) continue;
+				index = static_cast<std::uint32_t>(blocks[dim-1].size());
+				blocks[dim-1].push_back(face);
+			}
+		}
+	}
+	// then the simplices that are not boundaries.
+	for (auto sh : st_multi.complex_simplex_range()){
+		auto& index = index_in_block[st_multi.key(sh)];
+		if (index != unassigned) continue;
+		const int dim = st_multi.dimension(sh);
+		index = static_cast<std::uint32_t>(blocks[dim].size());
+		blocks[dim].push_back(sh);
+	}
+
+	// Block sizes count one generator per critical value.
+	std::vector<std::uint64_t> block_sizes;
+	for (int dim = dimension; dim >= 0; dim--){
+		std::uint64_t size = 0;
+		for (auto sh : blocks[dim])
+			size += st_multi.filtration(sh).size() / num_parameters;
+		block_sizes.push_back(size);
+	}
+
+	internal::Scc_buffered_writer out(path, options.binary);
+	const int last_block = options.ignore_last_generators ? 1 : 0;
+	std::vector<std::uint32_t> boundary;
+	if (options.binary){
+		out.write("SCCB", 4);
+		out.write_raw(static_cast<std::uint32_t>(1));
+		out.write_raw(static_cast<std::uint32_t>(num_parameters));
+		out.write_raw(static_cast<std::uint32_t>(block_sizes.size()));
+		for (auto size : block_sizes) out.write_raw(size);
+	} else {
+		out.write(options.rivet_compatible ? "firep\n" : "scc2020\n");
+		if (options.rivet_compatible){
+			out.write("Filtration 1\nFiltration 2\n");
+		} else {
+			if (!options.strip_comments) out.write("# Number of parameters\n");
+			out.write_number(num_parameters);
+			out.write('\n');
+		}
+		if (!options.strip_comments) out.write("# Sizes of generating sets\n");
+		for (std::size_t i = 0; i < block_sizes.size(); i++){
+			if (i > 0) out.write(' ');
+			out.write_number(block_sizes[i]);
+		}
+		out.write('\n');
+	}
+
+	for (int dim = dimension; dim >= last_block; dim--){
+		if (!options.binary && !options.strip_comments){
+			out.write("# Block of dimension ");
+			out.write_number(dim);
+			out.write('\n');
+		}
+		auto& block = blocks[dim];
+		if (options.reverse_block) std::reverse(block.begin(), block.end());
+		for (auto sh : block){
+			boundary.clear();
+			for (auto face : st_multi.boundary_simplex_range(sh))
+				boundary.push_back(index_in_block[st_multi.key(face)]);
+			const auto& filtration = st_multi.filtration(sh);
+			const std::size_t num_births = filtration.size() / num_parameters;
+			for (std::size_t birth = 0; birth < num_births; birth++){
+				if (options.binary){
+					for (int parameter = 0; parameter < num_parameters; parameter++)
+						out.write_raw(static_cast<value_type>(filtration[birth * num_parameters + parameter]));
+					out.write_raw(static_cast<std::uint32_t>(boundary.size()));
+					for (auto index : boundary) out.write_raw(index);
+				} else {
+					for (int parameter = 0; parameter < num_parameters; parameter++){
+						if (parameter > 0) out.write(' ');
+						out.write_number(filtration[birth * num_parameters + parameter]);
+					}
+					out.write(" ;");
+					for (auto index : boundary){
+						out.write(' ');
+						out.write_number(index);
+					}
+					out.write('\n');
+				}
+			}
+		}
+	}
+	out.close();
+}
+
+/** Options of read_scc. */
+struct Scc_reader_options {
+	// Has to match the `reverse_block` option of the writer, i.e., whether the rows of a block are written
+	// in the reverse order of the indices given by the boundaries of the next block.
+	bool reverse_block = true;
+};
+
+namespace internal {
+
+// Read-only view of a whole file, memory-mapped when possible.
+class Scc_mapped_file {
+public:
+	Scc_mapped_file(const std::string& path){
+#ifdef GUDHI_SCC_USE_MMAP
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			throw std::runtime_error("Could not open " + path);
+		struct stat status;
+		if (::fstat(fd, &status) != 0){
+			::close(fd);
+			throw std::runtime_error("Could not read " + path);
+		}
+		size_ = static_cast<std::size_t>(status.st_size);
+		if (size_ > 0){
+			void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapped == MAP_FAILED){
+				::close(fd);
+				throw std::runtime_error("Could not map " + path);
+			}
+			::madvise(mapped, size_, MADV_SEQUENTIAL);
+			data_ = static_cast<const char*>(mapped);
+		}
+		::close(fd);
+#else
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+			throw std::runtime_error("Could not open " + path);
+		content_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		data_ = content_.data();
+		size_ = content_.size();
+#endif
+	}
+	~Scc_mapped_file(){
+#ifdef GUDHI_SCC_USE_MMAP
+		if (data_ != nullptr) ::munmap(const_cast<char*>(data_), size_);
+#endif
+	}
+	Scc_mapped_file(const Scc_mapped_file&) = delete;
+	Scc_mapped_file& operator=(const Scc_mapped_file&) = delete;
+
+	std::string_view view() const { return std::string_view(data_ == nullptr ? "" : data_, size_); }
+
+private:
+	const char* data_ = nullptr;
+	std::size_t size_ = 0;
+#ifndef GUDHI_SCC_USE_MMAP
+	std::string content_;
+#endif
+};
+
+// Iterates over the non-empty lines of a file, skipping the comments.
+class Scc_line_reader {
+public:
+	Scc_line_reader(std::string_view content) : content_(content) {}
+
+	// Returns false at the end of the file.
+	bool next(std::string_view& line){
+		while (position_ < content_.size()){
+			auto end = content_.find('\n', position_);
+			if (end == std::string_view::npos) end = content_.size();
+			line = content_.substr(position_, end - position_);
+			position_ = end + 1;
+			line_number_++;
+			const auto first = line.find_first_not_of(" \t\r");
+			if (first == std::string_view::npos || line[first] == '#') continue;
+			line.remove_prefix(first);
+			const auto comment = line.find('#');
+			if (comment != std::string_view::npos) line = line.substr(0, comment);
+			line = line.substr(0, line.find_last_not_of(" \t\r") + 1);
+			return true;
+		}
+		return false;
+	}
+	std::size_t line_number() const { return line_number_; }
+	[[noreturn]] void error(const std::string& message) const {
+		throw std::invalid_argument("Line " + std::to_string(line_number_) + " : " + message);
+	}
+
+private:
+	std::string_view content_;
+	std::size_t position_ = 0;
+	std::size_t line_number_ = 0;
+};
+
+inline void skip_blanks(std::string_view& s){
+	std::size_t i = 0;
+	while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r')) i++;
+	s.remove_prefix(i);
+}
+
+// Parses a number at the beginning of s, and removes it from s. Returns false if there is none.
+// Floating point numbers are parsed with strtod when the standard library does not support std::from_chars for them.
+template<typename T>
+bool parse_number(std::string_view& s, T& value){
+	skip_blanks(s);
+	if (s.empty()) return false;
+	const char* begin = s.data();
+	const char* end = s.data() + s.size();
+	if constexpr (std::is_floating_point_v<T>){
+		if (*begin == '+') ++begin; // not accepted by from_chars
+#if !(defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L)
+		// The content is not null terminated (memory-mapped file), the number is copied first.
+		char number[64];
+		std::size_t size = 0;
+		while (begin + size != end && size < sizeof(number) - 1 && begin[size] != ' ' && begin[size] != '\t' &&
+		       begin[size] != '\r' && begin[size] != ';') {
+			number[size] = begin[size];
+			size++;
+		}
+		number[size] = '\0';
+		if (size == 0 || std::isspace(static_cast<unsigned char>(number[0]))) return false;
+		char* number_end;
+		const double x = std::strtod(number, &number_end);
+		if (number_end == number) return false;
+		value = static_cast<T>(x);
+		s.remove_prefix(static_cast<std::size_t>(begin + (number_end - number) - s.data()));
+		return true;
+#endif
+	}
+	auto result = std::from_chars(begin, end, value);
+	if (result.ec != std::errc()) return false;
+	s.remove_prefix(static_cast<std::size_t>(result.ptr - s.data()));
+	return true;
+}
+
+}  // namespace internal
+
+/**
+ * @brief Chain complex of a scc2020 (or firep) file, block by block.
+ *
+ * blocks[d] holds the rows of dimension d, in the order of the indices used by the boundaries of the block of
+ * dimension d+1, i.e., reordered as written by the writer when `reverse_block` is set.
+ */
+template<typename T>
+struct Scc_chain_complex {
+	struct Block {
+		std::vector<T> values;                      // num_parameters values per row
+		std::vector<std::uint32_t> boundaries;      // indices in the block of dimension d-1
+		std::vector<std::uint32_t> offsets{0};      // boundary of row i is boundaries[offsets[i] : offsets[i+1]]
+		std::size_t size() const { return offsets.size() - 1; }
+	};
+	int num_parameters = 0;
+	std::vector<Block> blocks;
+	// Dimension of the first block read, 1 if the block of dimension 0 was not written (`ignore_last_generators`),
+	// blocks.size() if the file is empty.
+	int lowest_dimension = 0;
+};
+
+/**
+ * @brief Reads the chain complex of a scc2020 (or firep) file, as written by write_scc, without any assumption on
+ * the cells, e.g., cubical complexes.
+ *
+ * @exception std::invalid_argument if the file is not a scc2020 file.
+ */
+template<typename T>
+Scc_chain_complex<T> read_scc_chain_complex(const std::string& path, const Scc_reader_options& options = {}){
+	using Block = typename Scc_chain_complex<T>::Block;
+	internal::Scc_mapped_file file(path);
+	internal::Scc_line_reader reader(file.view());
+	std::string_view line;
+	Scc_chain_complex<T> complex;
+
+	if (!reader.next(line)) reader.error("empty file");
+	int& num_parameters = complex.num_parameters;
+	if (line == "firep"){
+		num_parameters = 2;
+		for (int i = 0; i < 2; i++) // labels of the parameters
+			if (!reader.next(line)) reader.error("missing parameter label");
+	} else if (line == "scc2020"){
+		if (!reader.next(line) || !internal::parse_number(line, num_parameters) || num_parameters <= 0)
+			reader.error("invalid number of parameters");
+	} else {
+		reader.error("unknown header");
+	}
+	if (!reader.next(line)) return complex; // empty complex, as written by write_scc
+	std::vector<std::size_t> block_sizes;
+	for (std::size_t size; internal::parse_number(line, size);) block_sizes.push_back(size);
+	if (block_sizes.empty()) reader.error("missing block sizes");
+	const int num_blocks = static_cast<int>(block_sizes.size());
+
+	complex.blocks.resize(num_blocks);
+	complex.lowest_dimension = num_blocks;
+	for (int block_index = 0; block_index < num_blocks; block_index++){
+		const int dim = num_blocks - 1 - block_index;
+		Block& block = complex.blocks[dim];
+		bool ignored_block = false;
+		block.values.reserve(block_sizes[block_index] * num_parameters);
+		for (std::size_t row = 0; row < block_sizes[block_index]; row++){
+			if (!reader.next(line)){
+				if (row == 0 && dim == 0){ // ignored last generators
+					ignored_block = true;
+					break;
+				}
+				reader.error("unexpected end of file");
+			}
+			T value;
+			for (int parameter = 0; parameter < num_parameters; parameter++){
+				if (!internal::parse_number(line, value))
+					reader.error("invalid filtration value");
+				block.values.push_back(value);
+			}
+			internal::skip_blanks(line);
+			if (line.empty() || line.front() != ';') reader.error("expected ';'");
+			line.remove_prefix(1);
+			for (std::uint32_t index; internal::parse_number(line, index);) block.boundaries.push_back(index);
+			internal::skip_blanks(line);
+			if (!line.empty()) reader.error("invalid boundary index");
+			block.offsets.push_back(static_cast<std::uint32_t>(block.boundaries.size()));
+		}
+		if (!ignored_block) complex.lowest_dimension = dim;
+	}
+
+	if (options.reverse_block){
+		for (Block& block : complex.blocks){
+			Block reversed;
+			reversed.values.reserve(block.values.size());
+			reversed.boundaries.reserve(block.boundaries.size());
+			reversed.offsets.reserve(block.offsets.size());
+			for (std::size_t row = block.size(); row-- > 0;){
+				reversed.values.insert(reversed.values.end(), block.values.begin() + row * num_parameters,
+				                       block.values.begin() + (row + 1) * num_parameters);
+				reversed.boundaries.insert(reversed.boundaries.end(), block.boundaries.begin() + block.offsets[row],
+				                           block.boundaries.begin() + block.offsets[row + 1]);
+				reversed.offsets.push_back(static_cast<std::uint32_t>(reversed.boundaries.size()));
+			}
+			block = std::move(reversed);
+		}
+	}
+	return complex;
+}
+
+/**
+ * @brief Fills an empty multi-parameter simplex tree from a scc2020 (or firep) file, as written by write_scc.
+ *
+ * The vertices of a simplex are the union of the vertices of its boundary, the vertex of the row of index i of
+ * the block of dimension 0 being i. If this block is missing (`ignore_last_generators`), the vertices are the
+ * indices given by the edges, with the coordinate-wise minimum of the filtration values of their edges.
+ * Simplices are then inserted dimension by dimension, in lexicographic order.
+ * Each line is one simplex, i.e., multi-critical presentations are not recombined.
+ *
+ * @exception std::invalid_argument if the file is not a simplicial scc2020 file.
+ */
+template<class simplextree_multi>
+void read_scc(simplextree_multi &st_multi, const std::string& path, const Scc_reader_options& options = {}){
+	using value_type = typename simplextree_multi::Options::value_type;
+	using Filtration_value = typename simplextree_multi::Filtration_value;
+	const auto complex = read_scc_chain_complex<value_type>(path, options);
+	const int num_parameters = complex.num_parameters;
+	const int num_blocks = static_cast<int>(complex.blocks.size());
+	const int lowest_dimension = complex.lowest_dimension;
+	if (num_blocks == 0){ // empty complex
+		st_multi.set_number_of_parameters(num_parameters);
+		return;
+	}
+	for (int dim = 1; dim < num_blocks; dim++){
+		const auto& offsets = complex.blocks[dim].offsets;
+		for (std::size_t row = 0; row + 1 < offsets.size(); row++)
+			if (offsets[row + 1] - offsets[row] != static_cast<std::uint32_t>(dim + 1))
+				throw std::invalid_argument("Not a simplicial boundary.");
+	}
+
+	// Vertices of each row, by dimension, indexed by position (i.e., the index used by the boundaries).
+	std::vector<std::vector<int>> vertices(num_blocks); // (dim+1) vertices per position
+	const Filtration_value infinity_value(num_parameters, multi_filtrations::plus_infinity<value_type>());
+	std::vector<Filtration_value> vertex_values;
+	if (lowest_dimension == 0){
+		const std::size_t num_rows = complex.blocks[0].size();
+		vertices[0].resize(num_rows);
+		for (std::size_t position = 0; position < num_rows; position++) vertices[0][position] = static_cast<int>(position);
+	} else if (num_blocks > 1){
+		// The vertices are only known through the edges.
+		const auto& edges = complex.blocks[1];
+		for (std::size_t row = 0; row < edges.size(); row++)
+			for (auto k = edges.offsets[row]; k < edges.offsets[row+1]; k++){
+				const std::size_t vertex = edges.boundaries[k];
+				if (vertex >= vertex_values.size()) vertex_values.resize(vertex + 1, infinity_value);
+				for (int parameter = 0; parameter < num_parameters; parameter++)
+					vertex_values[vertex][parameter] = std::min(vertex_values[vertex][parameter], edges.values[row * num_parameters + parameter]);
+			}
+		vertices[0].resize(vertex_values.size());
+		for (std::size_t vertex = 0; vertex < vertex_values.size(); vertex++) vertices[0][vertex] = static_cast<int>(vertex);
+	}
+	std::vector<int> simplex;
+	for (int dim = 1; dim < num_blocks; dim++){
+		const auto& block = complex.blocks[dim];
+		vertices[dim].resize(block.size() * (dim + 1));
+		for (std::size_t position = 0; position < block.size(); position++){
+			simplex.clear();
+			for (auto k = block.offsets[position]; k < block.offsets[position+1]; k++){
+				const std::size_t face = block.boundaries[k];
+				if (dim == 1 && lowest_dimension > 0){
+					simplex.push_back(static_cast<int>(face));
+					continue;
+				}
+				if ((face + 1) * dim > vertices[dim-1].size()) throw std::invalid_argument("Boundary index out of range.");
+				simplex.insert(simplex.end(), vertices[dim-1].begin() + face * dim, vertices[dim-1].begin() + (face + 1) * dim);
+			}
+			std::sort(simplex.begin(), simplex.end());
+			simplex.erase(std::unique(simplex.begin(), simplex.end()), simplex.end());
+			if (static_cast<int>(simplex.size()) != dim + 1) throw std::invalid_argument("Not a simplicial complex.");
+			std::copy(simplex.begin(), simplex.end(), vertices[dim].begin() + position * (dim + 1));
+		}
+	}
+
+	// Sorted batch insertion, faces before cofaces.
+	st_multi.set_number_of_parameters(num_parameters);
+	for (std::size_t vertex = 0; vertex < vertex_values.size(); vertex++)
+		st_multi.insert_simplex(std::vector<int>{static_cast<int>(vertex)}, vertex_values[vertex]);
+	Filtration_value filtration(num_parameters);
+	for (int dim = lowest_dimension; dim < num_blocks; dim++){
+		const std::size_t num_rows = complex.blocks[dim].size();
+		std::vector<std::size_t> order(num_rows);
+		for (std::size_t position = 0; position < num_rows; position++) order[position] = position;
+		const auto& dim_vertices = vertices[dim];
+		const auto width = static_cast<std::size_t>(dim + 1);
+		std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b){
+			return std::lexicographical_compare(dim_vertices.begin() + a * width, dim_vertices.begin() + (a + 1) * width,
+			                                    dim_vertices.begin() + b * width, dim_vertices.begin() + (b + 1) * width);
+		});
+		for (auto position : order){
+			for (int parameter = 0; parameter < num_parameters; parameter++)
+				filtration[parameter] = complex.blocks[dim].values[position * num_parameters + parameter];
+			st_multi.insert_simplex(std::vector<int>(dim_vertices.begin() + position * width, dim_vertices.begin() + (position + 1) * width), filtration);
+		}
+	}
+}
+
+/**
+ * @brief Fills an empty simplex tree with 2 parameters from a Rivet bifiltration file, as written by
+ * `SimplexTreeMulti.to_rivet`, i.e., lines `v_0 ... v_d ; x_1 y_1 ... x_k y_k`.
+ *
+ * Option lines (starting with `-`) and comments are skipped. The filtration value of a simplex is the whole list of
+ * values (k-critical simplices keep their k points). Simplices are inserted by dimension, in lexicographic order.
+ */
+template<class simplextree_multi>
+void read_rivet(simplextree_multi &st_multi, const std::string& path){
+	using value_type = typename simplextree_multi::Options::value_type;
+	using Filtration_value = typename simplextree_multi::Filtration_value;
+	internal::Scc_mapped_file file(path);
+	internal::Scc_line_reader reader(file.view());
+	std::string_view line;
+	std::vector<std::pair<std::vector<int>, Filtration_value>> simplices;
+	while (reader.next(line)){
+		if (line.front() == '-') continue; // --datatype, --homology, -x, ...
+		std::vector<int> simplex;
+		for (int vertex; internal::parse_number(line, vertex);) simplex.push_back(vertex);
+		internal::skip_blanks(line);
+		if (simplex.empty() || line.empty() || line.front() != ';') reader.error("expected a simplex followed by ';'");
+		line.remove_prefix(1);
+		Filtration_value filtration;
+		for (value_type value; internal::parse_number(line, value);) filtration.push_back(value);
+		internal::skip_blanks(line);
+		if (!line.empty() || filtration.empty() || filtration.size() % 2 != 0) reader.error("invalid bifiltration value");
+		std::sort(simplex.begin(), simplex.end());
+		simplices.emplace_back(std::move(simplex), std::move(filtration));
+	}
+	std::sort(simplices.begin(), simplices.end(), [](const auto& a, const auto& b){
+		if (a.first.size() != b.first.size()) return a.first.size() < b.first.size();
+		return a.first < b.first;
+	});
+	st_multi.set_number_of_parameters(2);
+	for (const auto& [simplex, filtration] : simplices)
+		st_multi.insert_simplex(simplex, filtration);
+}
+
+}  // namespace Gudhi::multiparameter
+
+#endif  // SIMPLEX_TREE_MULTI_SCC_H_
@@ -0,0 +1,274 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file Simplex_tree_multi_slicer.h
+ * @brief Batched 1-parameter persistence of a multi-parameter simplex tree along many lines.
+ */
+
+#ifndef SIMPLEX_TREE_MULTI_SLICER_H_
+#define SIMPLEX_TREE_MULTI_SLICER_H_
+
+#include <gudhi/Simplex_tree.h>
+#include <gudhi/Persistent_cohomology.h>
+#include "Simplex_tree_multi_view.h"
+#include "Simplex_tree_multi_vineyard.h"
+#include "multi_filtrations/filtration_table.h"
+#include "multi_filtrations/line.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+namespace Gudhi::multiparameter {
+
+/**
+ * @brief Computes the barcodes of the restrictions of a (1-critical) multi-parameter filtration to many lines.
+ *
+ * The multi-parameter simplex tree is walked once at construction : its filtration values are stored parameter by
+ * parameter. Then, for every line, the filtration values are pushed forward on the line (a vectorizable pass over
+ * each parameter), assigned to a Simplex_tree_multi_view of the simplex tree, and persistence is computed. Lines are
+ * processed in parallel with TBB, each thread reusing its own view, so that the combinatorial structure is never
+ * copied.
+ *
+ * Barcodes are given in the parametrization of the lines, i.e., a value \f$t\f$ stands for the point
+ * `basepoint + t * direction` (the direction being \f$(1,\ldots,1)\f$ if it is empty). Directions have to be positive.
+ *
+ * WARNING : this overwrites the keys of the simplices, cf. Simplex_tree_multi_view.
+ */
+template<class simplextree_multi>
+class Line_slicer {
+public:
+	using value_type = typename simplextree_multi::Options::value_type;
+	using Line = multi_filtrations::Line<value_type>;
+	using View = Simplex_tree_multi_view<simplextree_multi>;
+	using Barcode = std::vector<std::pair<double, double>>;
+	using Field_Zp = persistent_cohomology::Field_Zp;
+	using Persistent_cohomology = persistent_cohomology::Persistent_cohomology<View, Field_Zp>;
+
+	Line_slicer(simplextree_multi& st_multi) : view_(st_multi) {
+		const std::size_t num_parameters = st_multi.get_number_of_parameters();
+		table_ = multi_filtrations::Filtration_table<value_type>(num_parameters, st_multi.num_simplices());
+		// The view indexes the simplices by their keys.
+		for (auto sh : st_multi.complex_simplex_range()){
+			const auto key = st_multi.key(sh);
+			const auto& filtration = st_multi.filtration(sh);
+			for (std::size_t parameter = 0; parameter < num_parameters && parameter < filtration.size(); parameter++)
+				table_(parameter, key) = filtration[parameter];
+			table_.dimension(key) = view_.dimension(sh);
+		}
+	}
+
+	std::size_t num_parameters() const { return table_.num_parameters(); }
+	std::size_t num_simplices() const { return table_.num_simplices(); }
+
+	// Line parameter of the push forward of the filtration values on l, indexed by keys.
+	void push_forward(const Line& l, std::vector<value_type>& out) const {
+		const std::size_t n = table_.num_simplices();
+		out.assign(n, -std::numeric_limits<value_type>::infinity());
+		const auto& basepoint = l.basepoint();
+		const auto& direction = l.direction();
+		const std::size_t size = std::min(table_.num_parameters(), basepoint.size());
+		for (std::size_t parameter = 0; parameter < size; parameter++){
+			const value_type b = basepoint[parameter];
+			const value_type d = direction.size() > parameter ? direction[parameter] : 1;
+			const value_type* values = table_.parameter(parameter);
+			value_type* t = out.data();
+			for (std::size_t key = 0; key < n; key++)
+				t[key] = std::max(t[key], (values[key] - b) / d);
+		}
+	}
+
+	/**
+	 * @brief Barcodes of the filtration restricted to each line, in the given homological degrees.
+	 * @return out[line][i] is the barcode in degree `degrees[i]` of the line `lines[line]`.
+	 */
+	std::vector<std::vector<Barcode>> barcodes(const std::vector<Line>& lines, const std::vector<int>& degrees,
+			int coefficient_field = 11, double min_persistence = 0) const {
+		std::vector<std::vector<Barcode>> out(lines.size());
+		const bool persistence_dim_max = !degrees.empty() && *std::max_element(degrees.begin(), degrees.end()) >= view_.dimension();
+		auto compute = [&](Worker& worker, std::size_t line){
+			push_forward(lines[line], worker.values);
+			worker.view.assign_filtration_values(worker.values);
+			Persistent_cohomology pcoh(worker.view, persistence_dim_max);
+			pcoh.init_coefficients(coefficient_field);
+			pcoh.compute_persistent_cohomology(static_cast<typename View::Filtration_value>(min_persistence));
+			out[line].reserve(degrees.size());
+			for (int degree : degrees){
+				const auto intervals = pcoh.intervals_in_dimension(degree);
+				out[line].emplace_back(intervals.begin(), intervals.end());
+			}
+		};
+#ifdef GUDHI_USE_TBB
+		tbb::enumerable_thread_specific<Worker> workers([&](){ return Worker(view_); });
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0, lines.size()), [&](const tbb::blocked_range<std::size_t>& range){
+			Worker& worker = workers.local();
+			for (std::size_t line = range.begin(); line < range.end(); line++)
+				compute(worker, line);
+		});
+#else
+		Worker worker(view_);
+		for (std::size_t line = 0; line < lines.size(); line++)
+			compute(worker, line);
+#endif
+		return out;
+	}
+
+	/**
+	 * @brief Same as barcodes, but the lines are processed in the given order by a single Vineyard, which is updated
+	 * from one line to the next by transpositions instead of recomputing persistence. This is faster when consecutive
+	 * lines are close, e.g. when sweeping lines through the filtration. Coefficients are in \f$\mathbb{Z}/2\mathbb{Z}\f$.
+	 */
+	std::vector<std::vector<Barcode>> vineyard_barcodes(const std::vector<Line>& lines, const std::vector<int>& degrees,
+			double min_persistence = 0) const {
+		std::vector<std::vector<Barcode>> out(lines.size());
+		if (lines.empty()) return out;
+		std::vector<value_type> values;
+		push_forward(lines[0], values);
+		Vineyard<value_type> vineyard(boundaries(), table_.dimensions(), values);
+		for (std::size_t line = 0; line < lines.size(); line++){
+			if (line > 0){
+				push_forward(lines[line], values);
+				vineyard.update(values);
+			}
+			out[line].reserve(degrees.size());
+			for (int degree : degrees){
+				const auto intervals = vineyard.barcode(degree, static_cast<value_type>(min_persistence));
+				out[line].emplace_back(intervals.begin(), intervals.end());
+			}
+		}
+		return out;
+	}
+
+	/**
+	 * @brief Hilbert function of a filtration squeezed on a grid, cf. `squeeze_filtration` : the dimension of the
+	 * homology, in each degree, of the subcomplex of the simplices whose coordinates are smaller or equal to each point
+	 * of the grid.
+	 *
+	 * The grid is cut in lines along the last parameter, on which the subcomplexes of the points with the same other
+	 * coordinates are filtered. Consecutive lines only differ by the simplices of one hyperplane of the grid, so the
+	 * lines are split in blocks processed in parallel with TBB, each block by a Vineyard updated from one line to the
+	 * next. Coefficients are in \f$\mathbb{Z}/2\mathbb{Z}\f$.
+	 *
+	 * @param[in] grid_shape Number of grid values of each parameter.
+	 * @return Row-major tensor of shape `(degrees.size(), grid_shape[0], ..., grid_shape.back())`.
+	 */
+	std::vector<std::int32_t> hilbert_function(const std::vector<std::size_t>& grid_shape, const std::vector<int>& degrees) const {
+		const std::size_t num_parameters = table_.num_parameters();
+		if (grid_shape.size() != num_parameters || num_parameters == 0)
+			throw std::invalid_argument("The grid should have one size per parameter.");
+		const std::size_t line_size = grid_shape.back();
+		std::size_t num_lines = 1;
+		for (std::size_t parameter = 0; parameter + 1 < num_parameters; parameter++) num_lines *= grid_shape[parameter];
+		std::vector<std::int32_t> out(degrees.size() * num_lines * line_size, 0);
+		if (table_.num_simplices() == 0 || num_lines == 0 || line_size == 0) return out;
+		const auto all_boundaries = boundaries();
+		const value_type* last_parameter = table_.parameter(num_parameters - 1);
+
+		// Coordinate along the last parameter of the simplices of the subcomplex of the line, +inf for the other ones
+		auto line_values = [&](std::size_t line, std::vector<value_type>& values){
+			std::vector<std::size_t> point(num_parameters - 1);
+			for (std::size_t parameter = num_parameters - 1; parameter-- > 0;){
+				point[parameter] = line % grid_shape[parameter];
+				line /= grid_shape[parameter];
+			}
+			values.assign(last_parameter, last_parameter + table_.num_simplices());
+			for (std::size_t parameter = 0; parameter + 1 < num_parameters; parameter++){
+				const value_type bound = static_cast<value_type>(point[parameter]);
+				const value_type* coordinates = table_.parameter(parameter);
+				for (std::size_t key = 0; key < values.size(); key++)
+					if (coordinates[key] > bound) values[key] = std::numeric_limits<value_type>::infinity();
+			}
+		};
+		auto process_block = [&](std::size_t begin, std::size_t end){
+			std::vector<value_type> values;
+			line_values(begin, values);
+			Vineyard<value_type> vineyard(all_boundaries, table_.dimensions(), values);
+			for (std::size_t line = begin; line < end; line++){
+				if (line > begin){
+					line_values(line, values);
+					vineyard.update(values);
+				}
+				for (std::size_t i = 0; i < degrees.size(); i++){
+					std::int32_t* hilbert = out.data() + (i * num_lines + line) * line_size;
+					for (const auto& [birth, death] : vineyard.barcode(degrees[i])){
+						if (!(birth < static_cast<value_type>(line_size))) continue;
+						const auto first = static_cast<std::size_t>(std::max<value_type>(std::ceil(birth), 0));
+						const auto last = death < static_cast<value_type>(line_size) ? static_cast<std::size_t>(std::ceil(death)) : line_size;
+						for (std::size_t j = first; j < last; j++) hilbert[j]++;
+					}
+				}
+			}
+		};
+#ifdef GUDHI_USE_TBB
+		tbb::parallel_for(tbb::blocked_range<std::size_t>(0, num_lines), [&](const tbb::blocked_range<std::size_t>& range){
+			process_block(range.begin(), range.end());
+		});
+#else
+		process_block(0, num_lines);
+#endif
+		return out;
+	}
+
+private:
+	// Boundaries of the simplices, as keys of their facets, for Vineyard.
+	std::vector<std::vector<std::size_t>> boundaries() const {
+		const auto& handles = view_.simplex_handles();
+		std::vector<std::vector<std::size_t>> out(handles.size());
+		for (std::size_t key = 0; key < handles.size(); key++)
+			for (auto sh : view_.boundary_simplex_range(handles[key]))
+				out[key].push_back(simplextree_multi::key(sh));
+		return out;
+	}
+
+	// Per-thread buffers.
+	struct Worker {
+		Worker(const View& view) : view(view) {}
+		View view;
+		std::vector<value_type> values;
+	};
+
+	View view_;
+	multi_filtrations::Filtration_table<value_type> table_;
+};
+
+/// @brief barcodes of st_multi along many lines, cf. Line_slicer.
+template<class simplextree_multi>
+auto sliced_barcodes(simplextree_multi& st_multi, const std::vector<multi_filtrations::Line<typename simplextree_multi::Options::value_type>>& lines,
+		const std::vector<int>& degrees, int coefficient_field = 11, double min_persistence = 0){
+	return Line_slicer<simplextree_multi>(st_multi).barcodes(lines, degrees, coefficient_field, min_persistence);
+}
+
+/// @brief Hilbert function of st_multi, squeezed on a grid of shape grid_shape, cf. Line_slicer::hilbert_function.
+template<class simplextree_multi>
+std::vector<std::int32_t> hilbert_function(simplextree_multi& st_multi, const std::vector<std::size_t>& grid_shape, const std::vector<int>& degrees){
+	return Line_slicer<simplextree_multi>(st_multi).hilbert_function(grid_shape, degrees);
+}
+
+/// @brief barcodes of st_multi along a sequence of lines, updated from one line to the next, cf. Line_slicer.
+template<class simplextree_multi>
+auto vineyard_barcodes(simplextree_multi& st_multi, const std::vector<multi_filtrations::Line<typename simplextree_multi::Options::value_type>>& lines,
+		const std::vector<int>& degrees, double min_persistence = 0){
+	return Line_slicer<simplextree_multi>(st_multi).vineyard_barcodes(lines, degrees, min_persistence);
+}
+
+}	// namespace Gudhi::multiparameter
+
+#endif // SIMPLEX_TREE_MULTI_SLICER_H_
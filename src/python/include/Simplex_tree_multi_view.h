@@ -0,0 +1,189 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file Simplex_tree_multi_view.h
+ * @brief 1-parameter filtrations of a multi-parameter simplex tree, sharing its combinatorial structure.
+ */
+
+#ifndef SIMPLEX_TREE_MULTI_VIEW_H_
+#define SIMPLEX_TREE_MULTI_VIEW_H_
+
+#include <gudhi/Simplex_tree.h>
+#include "multi_filtrations/line.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_sort.h>
+#endif
+
+namespace Gudhi::multiparameter {
+
+/**
+ * @brief 1-parameter filtration of a multi-parameter simplex tree, model of FilteredComplex.
+ *
+ * Instead of copying the simplex tree into a `Simplex_tree<options_std>` (cf. flatten, linear_projection,
+ * flatten_diag), the view keeps a pointer to the multi-parameter simplex tree and stores, for each simplex, one
+ * filtration value, one key for `Persistent_cohomology` and one handle for the filtration order.
+ *
+ * The keys of the multi-parameter simplex tree index the arrays of the view : they are assigned once by the first
+ * view, in the order of `for_each_simplex`, and must not be modified while views are in use. Copies of a view share
+ * this index, and do not write in the simplex tree, so that several copies can compute persistence in parallel.
+ *
+ * The projected filtration has to be non-decreasing, which is the case for the projections below if the
+ * multi-parameter filtration is non-decreasing (and the linear forms are non-negative).
+ * Ties are resolved with the order of `for_each_simplex`, which visits faces before cofaces.
+ */
+template<class simplextree_multi>
+class Simplex_tree_multi_view {
+public:
+	using Simplex_handle = typename simplextree_multi::Simplex_handle;
+	using Simplex_key = typename simplextree_multi::Simplex_key;
+	using Vertex_handle = typename simplextree_multi::Vertex_handle;
+	using value_type = typename simplextree_multi::Options::value_type;
+	using Filtration_value = value_type;
+	using Multi_filtration_value = typename simplextree_multi::Filtration_value;
+	using Filtration_simplex_range = std::vector<Simplex_handle>;
+	using Boundary_simplex_range = typename simplextree_multi::Boundary_simplex_range;
+
+	/** @brief Indexes the simplices of st_multi.
+	 *
+	 * WARNING : this overwrites the keys of the simplices. */
+	Simplex_tree_multi_view(simplextree_multi& st_multi) : st_(&st_multi) {
+		auto index = std::make_shared<Index>();
+		index->handles.reserve(st_multi.num_simplices());
+		index->dimensions.reserve(st_multi.num_simplices());
+		Simplex_key key = 0;
+		st_multi.for_each_simplex([&](Simplex_handle sh, int dimension){
+			st_multi.assign_key(sh, key++);
+			index->handles.push_back(sh);
+			index->dimensions.push_back(dimension);
+		});
+		index->dimension = st_multi.dimension();
+		index_ = std::move(index);
+		values_.resize(index_->handles.size());
+		keys_.resize(index_->handles.size(), null_key());
+	}
+
+	// ######################## Projections
+	// They all set the filtration values of the view, and sort the simplices accordingly.
+
+	/// @brief The filtration of the view is projection(multi-filtration value), for any callable projection.
+	template<class Projection>
+	void project(Projection&& projection) {
+		const auto& handles = index_->handles;
+		for (std::size_t key = 0; key < handles.size(); key++)
+			values_[key] = projection(st_->filtration(handles[key]));
+		initialize_filtration();
+	}
+
+	/// @brief Filtration values indexed by the keys of the multi-parameter simplex tree, e.g. from a Filtration_table.
+	void assign_filtration_values(const std::vector<value_type>& values) {
+		if (values.size() != values_.size())
+			throw std::invalid_argument("There should be one filtration value per simplex.");
+		std::copy(values.begin(), values.end(), values_.begin());
+		initialize_filtration();
+	}
+
+	/// @brief Same filtration as flatten : the coordinate `parameter` of the filtration values.
+	void flatten(int parameter = 0) {
+		project([parameter](const Multi_filtration_value& f) -> value_type {
+			return parameter >= 0 ? f[parameter] : 0;
+		});
+	}
+
+	/// @brief Same filtration as linear_projection : the scalar product with `linear_form`.
+	void linear_projection(const std::vector<value_type>& linear_form) {
+		project([&linear_form](const Multi_filtration_value& f) -> value_type {
+			return f.linear_projection(linear_form);
+		});
+	}
+
+	/// @brief Same filtration as flatten_diag : the coordinate `parameter` of the push forward on the line l.
+	void push_forward(const multi_filtrations::Line<value_type>& l, int parameter = 0) {
+		if (parameter < 0) parameter = 0;
+		const value_type b = l.basepoint()[parameter];
+		const value_type d = static_cast<std::size_t>(parameter) < l.direction().size() ? l.direction()[parameter] : 1;
+		const auto& basepoint = l.basepoint();
+		const auto& direction = l.direction();
+		project([&](const Multi_filtration_value& f) -> value_type {
+			value_type t = -std::numeric_limits<value_type>::infinity();
+			for (std::size_t i = 0; i < std::min<std::size_t>(f.size(), basepoint.size()); i++)
+				t = std::max(t, (f[i] - basepoint[i]) / (i < direction.size() ? direction[i] : 1));
+			return b + t * d;
+		});
+	}
+
+	// ######################## FilteredComplex
+	std::size_t num_simplices() const { return values_.size(); }
+	int dimension() const { return index_->dimension; }
+	int dimension(Simplex_handle sh) const { return index_->dimensions[index(sh)]; }
+
+	Filtration_value filtration(Simplex_handle sh) const {
+		if (sh == null_simplex()) return std::numeric_limits<Filtration_value>::infinity();
+		return values_[index(sh)];
+	}
+
+	Simplex_key key(Simplex_handle sh) const { return keys_[index(sh)]; }
+	void assign_key(Simplex_handle sh, Simplex_key key) { keys_[index(sh)] = key; }
+	static Simplex_key null_key() { return -1; }
+	static Simplex_handle null_simplex() { return simplextree_multi::null_simplex(); }
+
+	/// @brief Simplex of index idx in the filtration.
+	Simplex_handle simplex(Simplex_key idx) const { return filtration_vect_[idx]; }
+	const Filtration_simplex_range& filtration_simplex_range() const { return filtration_vect_; }
+
+	Boundary_simplex_range boundary_simplex_range(Simplex_handle sh) const { return st_->boundary_simplex_range(sh); }
+	std::pair<Simplex_handle, Simplex_handle> endpoints(Simplex_handle sh) const { return st_->endpoints(sh); }
+
+	const simplextree_multi& simplex_tree() const { return *st_; }
+	/// @brief Simplex handles of the multi-parameter simplex tree, indexed by their keys.
+	const std::vector<Simplex_handle>& simplex_handles() const { return index_->handles; }
+
+private:
+	// Shared by the copies of a view, read only.
+	struct Index {
+		std::vector<Simplex_handle> handles;
+		std::vector<int> dimensions;
+		int dimension = -1;
+	};
+
+	std::size_t index(Simplex_handle sh) const { return static_cast<std::size_t>(simplextree_multi::key(sh)); }
+
+	void initialize_filtration() {
+		filtration_vect_ = index_->handles;
+		auto is_before_in_filtration = [this](Simplex_handle sh1, Simplex_handle sh2){
+			const auto i1 = index(sh1), i2 = index(sh2);
+			if (values_[i1] != values_[i2]) return values_[i1] < values_[i2];
+			return i1 < i2;
+		};
+#ifdef GUDHI_USE_TBB
+		tbb::parallel_sort(filtration_vect_.begin(), filtration_vect_.end(), is_before_in_filtration);
+#else
+		std::sort(filtration_vect_.begin(), filtration_vect_.end(), is_before_in_filtration);
+#endif
+	}
+
+	simplextree_multi* st_;
+	std::shared_ptr<const Index> index_;
+	std::vector<Filtration_value> values_;
+	std::vector<Simplex_key> keys_;
+	Filtration_simplex_range filtration_vect_;
+};
+
+}	// namespace Gudhi::multiparameter
+
+#endif // SIMPLEX_TREE_MULTI_VIEW_H_
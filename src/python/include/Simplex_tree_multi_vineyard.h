@@ -0,0 +1,227 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file Simplex_tree_multi_vineyard.h
+ * @brief Persistence updated by transpositions, for families of close 1-parameter filtrations.
+ */
+
+#ifndef SIMPLEX_TREE_MULTI_VINEYARD_H_
+#define SIMPLEX_TREE_MULTI_VINEYARD_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Gudhi::multiparameter {
+
+/**
+ * @brief Vineyard : maintains a decomposition \f$R = DV\f$ of the boundary matrix \f$D\f$ of a filtered complex,
+ * with \f$R\f$ reduced and \f$V\f$ upper triangular, when the order of the simplices changes.
+ *
+ * Cf. D. Cohen-Steiner, H. Edelsbrunner, D. Morozov, <i>Vines and vineyards by updating persistence in linear
+ * time</i>, SoCG 2006. A transposition of two consecutive simplices costs at most two column additions, so that
+ * updating the barcode between two close filtrations (e.g. two neighboring lines of a multi-parameter filtration) is
+ * much cheaper than recomputing it.
+ *
+ * Simplices are identified by indices in [0, num_simplices), which stay the same when the order changes. Columns
+ * store these indices, sorted, and the pivot of a column is its entry of largest position in the current order.
+ * Coefficients are in \f$\mathbb{Z}/2\mathbb{Z}\f$.
+ */
+template<typename value_type>
+class Vineyard {
+public:
+	using index = std::size_t;
+	using Column = std::vector<index>;
+	using Barcode = std::vector<std::pair<value_type, value_type>>;
+
+	/**
+	 * @param[in] boundaries Boundary of each simplex, as indices of its facets.
+	 * @param[in] dimensions Dimension of each simplex.
+	 * @param[in] filtration Filtration value of each simplex. It has to be non-decreasing.
+	 */
+	Vineyard(std::vector<Column> boundaries, std::vector<int> dimensions, const std::vector<value_type>& filtration)
+			: R_(std::move(boundaries)), dimensions_(std::move(dimensions)), filtration_(filtration) {
+		const auto n = R_.size();
+		if (dimensions_.size() != n || filtration_.size() != n)
+			throw std::invalid_argument("There should be one dimension and one filtration value per simplex.");
+		for (auto& column : R_) std::sort(column.begin(), column.end());
+		order_.resize(n);
+		std::iota(order_.begin(), order_.end(), 0);
+		std::sort(order_.begin(), order_.end(), [this](index a, index b){ return is_before(a, b); });
+		position_.resize(n);
+		for (index i = 0; i < n; i++) position_[order_[i]] = i;
+		V_.resize(n);
+		for (index i = 0; i < n; i++) V_[i] = {i};
+		pivot_.assign(n, null());
+		pivot_column_.assign(n, null());
+		reduce();
+	}
+
+	std::size_t num_simplices() const { return order_.size(); }
+	// Number of transpositions done since the construction, cf. update.
+	std::size_t num_transpositions() const { return num_transpositions_; }
+
+	/**
+	 * @brief Replaces the filtration values and sorts the simplices accordingly, by transpositions of consecutive
+	 * simplices (insertion sort). The cost is linear in the number of inversions between the two orders.
+	 */
+	void update(const std::vector<value_type>& filtration) {
+		if (filtration.size() != filtration_.size())
+			throw std::invalid_argument("There should be one filtration value per simplex.");
+		filtration_ = filtration;
+		for (index i = 1; i < order_.size(); i++)
+			for (index j = i; j > 0 && is_before(order_[j], order_[j-1]); j--)
+				transpose(j-1);
+	}
+
+	/// @brief Swaps the simplices at positions i and i+1 of the order. They must not be a face and a coface.
+	void transpose(index i) {
+		const index a = order_[i], b = order_[i+1]; // a is before b, and will be after it
+		num_transpositions_++;
+		const bool a_positive = R_[a].empty(), b_positive = R_[b].empty();
+		const bool v_ab = contains(V_[b], a);
+		if (a_positive && b_positive) {
+			if (v_ab) add_V(a, b); // R_a = R_b = 0, so R is not modified
+			swap_positions(i);
+		} else if (!a_positive && !b_positive) {
+			if (v_ab) {
+				const bool pivot_a_lower = position_[pivot_[a]] < position_[pivot_[b]];
+				add(a, b);
+				swap_positions(i);
+				if (!pivot_a_lower) add(b, a); // the pairing switches
+			} else {
+				swap_positions(i);
+			}
+		} else if (!a_positive && b_positive) {
+			if (v_ab) {
+				// b becomes the negative one
+				add(a, b);
+				swap_positions(i);
+				add(b, a);
+			} else {
+				swap_positions(i);
+			}
+		} else {
+			if (v_ab) add_V(a, b); // R_a = 0
+			swap_positions(i);
+		}
+	}
+
+	/// @brief Barcode in degree `dimension`, bars of length smaller or equal to min_persistence are discarded.
+	Barcode barcode(int dimension, value_type min_persistence = 0) const {
+		Barcode out;
+		for (index sigma = 0; sigma < order_.size(); sigma++){
+			if (dimensions_[sigma] != dimension || !R_[sigma].empty()) continue;
+			const index killer = pivot_column_[sigma];
+			const value_type death = killer == null() ? std::numeric_limits<value_type>::infinity() : filtration_[killer];
+			if (death - filtration_[sigma] > min_persistence)
+				out.emplace_back(filtration_[sigma], death);
+		}
+		return out;
+	}
+
+private:
+	static index null() { return std::numeric_limits<index>::max(); }
+
+	// Strict total order, in which faces are before cofaces when the filtration is non-decreasing.
+	bool is_before(index a, index b) const {
+		if (filtration_[a] != filtration_[b]) return filtration_[a] < filtration_[b];
+		if (dimensions_[a] != dimensions_[b]) return dimensions_[a] < dimensions_[b];
+		return a < b;
+	}
+
+	static bool contains(const Column& column, index i) {
+		return std::binary_search(column.begin(), column.end(), i);
+	}
+
+	// Z/2Z sum of two sorted columns.
+	void add_to(const Column& source, Column& target) {
+		buffer_.clear();
+		std::set_symmetric_difference(target.begin(), target.end(), source.begin(), source.end(), std::back_inserter(buffer_));
+		target.swap(buffer_);
+	}
+
+	index compute_pivot(const Column& column) const {
+		index out = null();
+		for (index i : column)
+			if (out == null() || position_[i] > position_[out]) out = i;
+		return out;
+	}
+
+	void add_V(index source, index target) { add_to(V_[source], V_[target]); }
+
+	// Column operation target += source, on R and V, and update of the pivots.
+	void add(index source, index target) {
+		add_to(R_[source], R_[target]);
+		add_V(source, target);
+		set_pivot(target, compute_pivot(R_[target]));
+	}
+
+	void set_pivot(index column, index pivot) {
+		if (pivot_[column] != null() && pivot_column_[pivot_[column]] == column)
+			pivot_column_[pivot_[column]] = null();
+		pivot_[column] = pivot;
+		if (pivot != null()) pivot_column_[pivot] = column;
+	}
+
+	// Only the column whose pivot is b = order_[i+1] may have a new pivot once swapped : a = order_[i], if it contains
+	// it. If a is already the pivot of another column, which happens when both are positive, one column is added to
+	// the other.
+	void swap_positions(index i) {
+		const index a = order_[i], b = order_[i+1];
+		std::swap(order_[i], order_[i+1]);
+		position_[a] = i+1;
+		position_[b] = i;
+		const index l = pivot_column_[b];
+		if (l == null() || !contains(R_[l], a)) return;
+		const index k = pivot_column_[a];
+		if (k == null()) {
+			set_pivot(l, a);
+		} else if (position_[k] < position_[l]) {
+			add(k, l); // the pivot of l goes back to b
+		} else {
+			add(l, k); // the pairing switches
+			set_pivot(l, a);
+		}
+	}
+
+	// Standard column reduction, in the order of the filtration.
+	void reduce() {
+		for (index sigma : order_){
+			index pivot = compute_pivot(R_[sigma]);
+			while (pivot != null() && pivot_column_[pivot] != null()){
+				const index other = pivot_column_[pivot];
+				add_to(R_[other], R_[sigma]);
+				add_V(other, sigma);
+				pivot = compute_pivot(R_[sigma]);
+			}
+			set_pivot(sigma, pivot);
+		}
+	}
+
+	std::vector<Column> R_;
+	std::vector<Column> V_;
+	std::vector<int> dimensions_;
+	std::vector<value_type> filtration_;
+	std::vector<index> order_;         // position -> simplex
+	std::vector<index> position_;      // simplex -> position
+	std::vector<index> pivot_;         // column -> its pivot, for negative simplices
+	std::vector<index> pivot_column_;  // positive simplex -> the column whose pivot it is
+	Column buffer_;
+	std::size_t num_transpositions_ = 0;
+};
+
+}	// namespace Gudhi::multiparameter
+
+#endif // SIMPLEX_TREE_MULTI_VINEYARD_H_
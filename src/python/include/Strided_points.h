@@ -0,0 +1,79 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef INCLUDE_STRIDED_POINTS_H_
+#define INCLUDE_STRIDED_POINTS_H_
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace Gudhi {
+
+/* Point of a 2d buffer of coordinates (e.g. a numpy array of float32 or float64), read in place. The strides are in
+ * bytes, as given by numpy, so that any layout is accepted. Its coordinates are converted to double when they are
+ * read, so the distances are the same as with a copy of the points as std::vector<double>. */
+template <typename T>
+class Strided_point {
+ public:
+  class const_iterator : public boost::iterator_facade<const_iterator, double, boost::random_access_traversal_tag,
+                                                       double> {
+   public:
+    const_iterator() : ptr_(nullptr), index_(0), stride_(0) {}
+    const_iterator(const char* ptr, std::ptrdiff_t index, std::ptrdiff_t stride)
+        : ptr_(ptr), index_(index), stride_(stride) {}
+
+   private:
+    friend class boost::iterator_core_access;
+    // The position is an index rather than a pointer, for the broadcast arrays whose stride is 0
+    double dereference() const { return static_cast<double>(*reinterpret_cast<const T*>(ptr_ + index_ * stride_)); }
+    bool equal(const const_iterator& other) const { return index_ == other.index_; }
+    void increment() { ++index_; }
+    void decrement() { --index_; }
+    void advance(std::ptrdiff_t n) { index_ += n; }
+    std::ptrdiff_t distance_to(const const_iterator& other) const { return other.index_ - index_; }
+
+    const char* ptr_;
+    std::ptrdiff_t index_;
+    std::ptrdiff_t stride_;
+  };
+  using iterator = const_iterator;
+
+  Strided_point(const char* ptr, std::size_t dimension, std::ptrdiff_t stride)
+      : ptr_(ptr), dimension_(dimension), stride_(stride) {}
+
+  const_iterator begin() const { return const_iterator(ptr_, 0, stride_); }
+  const_iterator end() const { return const_iterator(ptr_, static_cast<std::ptrdiff_t>(dimension_), stride_); }
+  std::size_t size() const { return dimension_; }
+  double operator[](std::size_t i) const { return begin()[i]; }
+
+ private:
+  const char* ptr_;
+  std::size_t dimension_;
+  std::ptrdiff_t stride_;
+};
+
+/* The points of the buffer, as a random access range whose values are stored, as required by the algorithms taking
+ * the address of a point. Only these small views are allocated, the coordinates are not copied. */
+template <typename T>
+std::vector<Strided_point<T>> strided_points(const T* data, std::size_t num_points, std::size_t dimension,
+                                             std::ptrdiff_t stride0, std::ptrdiff_t stride1) {
+  std::vector<Strided_point<T>> points;
+  points.reserve(num_points);
+  const char* ptr = reinterpret_cast<const char*>(data);
+  for (std::size_t i = 0; i < num_points; i++)
+    points.emplace_back(ptr + static_cast<std::ptrdiff_t>(i) * stride0, dimension, stride1);
+  return points;
+}
+
+}  // namespace Gudhi
+
+#endif  // INCLUDE_STRIDED_POINTS_H_
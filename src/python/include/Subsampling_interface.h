@@ -16,6 +16,10 @@
 #include <gudhi/pick_n_random_points.h>
 #include <gudhi/Points_off_io.h>
 
+#include <boost/iterator/function_output_iterator.hpp>
+
+#include "Strided_points.h"
+
 // Default value is undefined
 #define _GUDHI_SUBSAMPLING_USE_CGAL 0
 
@@ -32,6 +36,7 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cstddef>  // for std::size_t, std::ptrdiff_t
 
 namespace Gudhi {
 
@@ -49,6 +54,24 @@ std::vector<std::vector<double>> subsampling_n_farthest_points(bool metric, cons
   return landmarks;
 }
 
+// Same with the points read in place from a 2d buffer of float or double, with strides in bytes, cf. Strided_points.h
+template <typename T>
+std::vector<std::vector<double>> subsampling_n_farthest_points_buffer(bool metric, const T* data, std::size_t num_points,
+                                                                      std::size_t dimension, std::ptrdiff_t stride0,
+                                                                      std::ptrdiff_t stride1, std::size_t nb_points,
+                                                                      std::size_t starting_point = random_starting_point) {
+  auto points = strided_points(data, num_points, dimension, stride0, stride1);
+  std::vector<std::vector<double>> landmarks;
+  auto output = boost::make_function_output_iterator(
+      [&landmarks](const Strided_point<T>& p) { landmarks.emplace_back(p.begin(), p.end()); });
+  if (metric)
+    choose_n_farthest_points_metric(Euclidean_distance(), points, nb_points, starting_point, output);
+  else
+    choose_n_farthest_points(Euclidean_distance(), points, nb_points, starting_point, output);
+
+  return landmarks;
+}
+
 std::vector<std::vector<double>> subsampling_n_farthest_points_from_file(bool metric, const std::string& off_file,
                                                                          std::size_t nb_points, std::size_t starting_point = random_starting_point) {
     Gudhi::Points_off_reader<std::vector<double>> off_reader(off_file);
@@ -65,6 +88,18 @@ std::vector<std::vector<double>> subsampling_n_random_points(const std::vector<s
   return landmarks;
 }
 
+template <typename T>
+std::vector<std::vector<double>> subsampling_n_random_points_buffer(const T* data, std::size_t num_points,
+                                                                    std::size_t dimension, std::ptrdiff_t stride0,
+                                                                    std::ptrdiff_t stride1, unsigned nb_points) {
+  auto points = strided_points(data, num_points, dimension, stride0, stride1);
+  std::vector<std::vector<double>> landmarks;
+  pick_n_random_points(points, nb_points, boost::make_function_output_iterator(
+      [&landmarks](const Strided_point<T>& p) { landmarks.emplace_back(p.begin(), p.end()); }));
+
+  return landmarks;
+}
+
 std::vector<std::vector<double>> subsampling_n_random_points_from_file(const std::string& off_file,
                                                                        unsigned nb_points) {
   Gudhi::Points_off_reader<std::vector<double>> off_reader(off_file);
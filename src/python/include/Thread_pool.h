@@ -0,0 +1,129 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef INCLUDE_THREAD_POOL_H_
+#define INCLUDE_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#ifdef GUDHI_USE_TBB
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <tbb/global_control.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+namespace Gudhi {
+
+/* The threads shared by the batch computations of the Python interface (vectorizations, distance matrices, cubical
+ * persistence of batches of images, ...), which run in it without the GIL. With TBB, this is the pool of worker
+ * threads of TBB, shared by all the compiled modules of the process, so that the calls made from several Python
+ * threads do not oversubscribe the machine, and no thread is started per call. Without TBB, the threads of a call are
+ * started by this call. */
+namespace thread_pool {
+
+inline int& max_threads_setting() {
+  static int max_threads = 0;
+  return max_threads;
+}
+
+/* Limits the number of threads of the pool to n, or removes the limit if n is 0. With TBB, the limit applies to the
+ * whole process, but it must always be set from the same compiled module, which owns it. */
+inline void set_max_threads(int n) {
+#ifdef GUDHI_USE_TBB
+  static std::unique_ptr<tbb::global_control> control;
+  control.reset();
+  if (n > 0) control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, n);
+#endif
+  max_threads_setting() = std::max(n, 0);
+}
+
+/* Number of threads of the pool. */
+inline int max_threads() {
+#ifdef GUDHI_USE_TBB
+  return static_cast<int>(tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism));
+#else
+  if (max_threads_setting() > 0) return max_threads_setting();
+  return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+#endif
+}
+
+#ifdef GUDHI_USE_TBB
+/* Arena of n_jobs threads of the pool, created at the first call for this number and then reused. */
+inline tbb::task_arena& arena(int n_jobs) {
+  static std::mutex mutex;
+  static std::map<int, std::unique_ptr<tbb::task_arena>> arenas;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& a = arenas[n_jobs];
+  if (!a) a = std::make_unique<tbb::task_arena>(n_jobs);
+  return *a;
+}
+#endif
+
+/* Calls run() so that the parallel algorithms of TBB it calls use at most n_jobs threads of the pool, all of them if
+ * n_jobs is 0. */
+template <class Run>
+void execute(int n_jobs, Run&& run) {
+#ifdef GUDHI_USE_TBB
+  if (n_jobs > 0 && n_jobs < max_threads()) {
+    arena(n_jobs).execute(run);
+    return;
+  }
+#else
+  (void)n_jobs;
+#endif
+  run();
+}
+
+/* Calls f(i) for 0 <= i < n on at most n_jobs threads of the pool, all of them if n_jobs is 0. The exception thrown
+ * by one of the calls, if any, is rethrown. */
+template <class F>
+void parallel_for(std::size_t n, int n_jobs, F&& f) {
+  if (n_jobs <= 0) n_jobs = max_threads();
+#ifdef GUDHI_USE_TBB
+  execute(n_jobs, [&] { tbb::parallel_for(std::size_t(0), n, f); });
+#else
+  std::size_t n_threads = std::min<std::size_t>(n_jobs, n);
+  if (n_threads <= 1) {
+    for (std::size_t i = 0; i < n; ++i) f(i);
+    return;
+  }
+  std::atomic<std::size_t> next(0);
+  std::exception_ptr error;
+  std::atomic<bool> failed(false);
+  auto work = [&]() {
+    try {
+      for (std::size_t i; !failed && (i = next++) < n;) f(i);
+    } catch (...) {
+      // Only the first thread to fail records its exception
+      if (!failed.exchange(true)) error = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < n_threads; ++t) threads.emplace_back(work);
+  work();
+  for (auto& t : threads) t.join();
+  if (error) std::rethrow_exception(error);
+#endif
+}
+
+}  // namespace thread_pool
+
+}  // namespace Gudhi
+
+#endif  // INCLUDE_THREAD_POOL_H_
@@ -23,6 +23,7 @@
 #include <cassert>
 
 #include "finitely_critical_filtrations.h"
+#include "filtration_statistics.h"
 
 
 
@@ -51,6 +52,7 @@ public:
 	point_type& get_upper_corner();
 	bool contains(const point_type& point) const;
 	void infer_from_filters(const std::vector<point_type> &Filters_list);
+	void infer_from_statistics(const Filtration_statistics<T> &statistics, double low_quantile = 0, double high_quantile = 0);
     bool is_trivial() const ;
 	std::pair<const point_type&,const point_type&> get_pair() const{
 		return {bottomCorner_,upperCorner_};
@@ -111,6 +113,19 @@ inline void Box<T>::infer_from_filters(const std::vector<point_type> &Filters_li
 	bottomCorner_.swap(lower);
 	upperCorner_.swap(upper);
 }
+// Box between the quantiles low_quantile and 1 - high_quantile of the finite values of each parameter.
+template<typename T>
+inline void Box<T>::infer_from_statistics(const Filtration_statistics<T> &statistics, double low_quantile, double high_quantile){
+	const std::size_t dimension = statistics.num_parameters();
+	point_type lower(dimension);
+	point_type upper(dimension);
+	for (std::size_t i = 0; i < dimension; i++){
+		lower[i] = statistics.quantile(i, low_quantile);
+		upper[i] = statistics.quantile(i, 1 - high_quantile);
+	}
+	bottomCorner_.swap(lower);
+	upperCorner_.swap(upper);
+}
 template<typename T>
 inline bool Box<T>::is_trivial() const {
     return bottomCorner_.empty() || upperCorner_.empty() || bottomCorner_.size() != upperCorner_.size();
@@ -0,0 +1,164 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file filtration_statistics.h
+ * @brief Statistics of the filtration values of a multi-parameter complex, computed in a single pass.
+ */
+
+#ifndef FILTRATION_STATISTICS_H_INCLUDED
+#define FILTRATION_STATISTICS_H_INCLUDED
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+namespace Gudhi::multiparameter::multi_filtrations{
+
+/**
+ * @brief Number of simplices per dimension, and for each parameter the bounds of the finite values, the number of
+ * infinite and NaN values, and an histogram of the finite values for approximate quantiles.
+ *
+ * Values are added one simplex at a time with `add`, and statistics computed on parts of a complex, e.g. by different
+ * threads, are combined with `merge`. The histogram has `num_bins` bins of an order-preserving encoding of the values
+ * as floats, whose width is about 3% of the values they contain (a few bins around 0), independently of the range of
+ * the values, so that it does not need to be known in advance. Quantiles are interpolated linearly in their bin, and
+ * the quantiles 0 and 1 are the exact bounds.
+ */
+template<typename T>
+class Filtration_statistics {
+public:
+	static constexpr int bin_bits = 14;
+	static constexpr std::size_t num_bins = std::size_t(1) << bin_bits;
+
+	Filtration_statistics() : Filtration_statistics(0) {}
+	Filtration_statistics(std::size_t num_parameters)
+		: min_(num_parameters, std::numeric_limits<T>::infinity()),
+		  max_(num_parameters, -std::numeric_limits<T>::infinity()),
+		  num_finite_(num_parameters, 0),
+		  num_plus_infinite_(num_parameters, 0),
+		  num_minus_infinite_(num_parameters, 0),
+		  num_nan_(num_parameters, 0),
+		  histograms_(num_parameters * num_bins, 0) {}
+
+	std::size_t num_parameters() const { return min_.size(); }
+	std::size_t num_simplices() const { return num_simplices_; }
+	// Number of simplices of each dimension, up to the largest one.
+	const std::vector<std::size_t>& num_simplices_per_dimension() const { return num_simplices_per_dimension_; }
+	// Bounds of the finite values of a parameter, (inf, -inf) if there are none.
+	T min(std::size_t parameter) const { return min_[parameter]; }
+	T max(std::size_t parameter) const { return max_[parameter]; }
+	std::size_t num_finite(std::size_t parameter) const { return num_finite_[parameter]; }
+	std::size_t num_plus_infinite(std::size_t parameter) const { return num_plus_infinite_[parameter]; }
+	std::size_t num_minus_infinite(std::size_t parameter) const { return num_minus_infinite_[parameter]; }
+	std::size_t num_nan(std::size_t parameter) const { return num_nan_[parameter]; }
+
+	// Adds the filtration value of a simplex. Missing parameters are not counted.
+	template<class Filtration>
+	void add(const Filtration& filtration, int dimension){
+		if (static_cast<std::size_t>(dimension) >= num_simplices_per_dimension_.size())
+			num_simplices_per_dimension_.resize(dimension + 1, 0);
+		num_simplices_per_dimension_[dimension]++;
+		num_simplices_++;
+		const auto size = std::min(num_parameters(), static_cast<std::size_t>(filtration.size()));
+		for (std::size_t parameter = 0; parameter < size; parameter++)
+			add_value(parameter, static_cast<T>(filtration[parameter]));
+	}
+
+	void merge(const Filtration_statistics& other){
+		if (other.num_simplices_per_dimension_.size() > num_simplices_per_dimension_.size())
+			num_simplices_per_dimension_.resize(other.num_simplices_per_dimension_.size(), 0);
+		for (std::size_t dimension = 0; dimension < other.num_simplices_per_dimension_.size(); dimension++)
+			num_simplices_per_dimension_[dimension] += other.num_simplices_per_dimension_[dimension];
+		num_simplices_ += other.num_simplices_;
+		for (std::size_t parameter = 0; parameter < num_parameters(); parameter++){
+			min_[parameter] = std::min(min_[parameter], other.min_[parameter]);
+			max_[parameter] = std::max(max_[parameter], other.max_[parameter]);
+			num_finite_[parameter] += other.num_finite_[parameter];
+			num_plus_infinite_[parameter] += other.num_plus_infinite_[parameter];
+			num_minus_infinite_[parameter] += other.num_minus_infinite_[parameter];
+			num_nan_[parameter] += other.num_nan_[parameter];
+		}
+		for (std::size_t bin = 0; bin < histograms_.size(); bin++) histograms_[bin] += other.histograms_[bin];
+	}
+
+	// Approximate quantile q in [0,1] of the finite values of a parameter, NaN if there are none.
+	T quantile(std::size_t parameter, double q) const {
+		const std::size_t n = num_finite_[parameter];
+		if (n == 0) return std::numeric_limits<T>::quiet_NaN();
+		if (!(q > 0)) return min_[parameter];
+		if (q >= 1) return max_[parameter];
+		const double rank = q * static_cast<double>(n - 1);
+		const std::uint64_t* histogram = histograms_.data() + parameter * num_bins;
+		std::size_t before = 0;
+		for (std::size_t bin = 0; bin < num_bins; bin++){
+			if (histogram[bin] == 0 || static_cast<double>(before + histogram[bin]) <= rank){
+				before += histogram[bin];
+				continue;
+			}
+			// fmax and fmin ignore the NaN bounds
+			const double low = std::fmax(bin_lower_bound(bin), min_[parameter]);
+			const double high = std::fmin(bin_lower_bound(bin + 1), max_[parameter]);
+			const double t = histogram[bin] == 1 ? 0.5 : (rank - static_cast<double>(before)) / static_cast<double>(histogram[bin] - 1);
+			return static_cast<T>(low + t * (high - low));
+		}
+		return max_[parameter];
+	}
+
+private:
+	std::size_t num_simplices_ = 0;
+	std::vector<std::size_t> num_simplices_per_dimension_;
+	std::vector<T> min_;
+	std::vector<T> max_;
+	std::vector<std::size_t> num_finite_;
+	std::vector<std::size_t> num_plus_infinite_;
+	std::vector<std::size_t> num_minus_infinite_;
+	std::vector<std::size_t> num_nan_;
+	// num_parameters x num_bins counts
+	std::vector<std::uint64_t> histograms_;
+
+	void add_value(std::size_t parameter, T x){
+		if (std::isnan(x)) { num_nan_[parameter]++; return; }
+		if (x == std::numeric_limits<T>::infinity()) { num_plus_infinite_[parameter]++; return; }
+		if (x == -std::numeric_limits<T>::infinity()) { num_minus_infinite_[parameter]++; return; }
+		num_finite_[parameter]++;
+		min_[parameter] = std::min(min_[parameter], x);
+		max_[parameter] = std::max(max_[parameter], x);
+		histograms_[parameter * num_bins + bin(x)]++;
+	}
+
+	// Encodes a float in an unsigned integer with the same order.
+	static std::uint32_t ordered_bits(float x){
+		std::uint32_t bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+
+	static std::size_t bin(T x){
+		return ordered_bits(static_cast<float>(x)) >> (32 - bin_bits);
+	}
+
+	// Smallest float of a bin, or NaN / infinity for the bins at the ends of the encoding.
+	static double bin_lower_bound(std::size_t bin){
+		if (bin >= num_bins) return std::numeric_limits<double>::infinity();
+		const std::uint32_t ordered = static_cast<std::uint32_t>(bin) << (32 - bin_bits);
+		const std::uint32_t bits = (ordered & 0x80000000u) ? (ordered & 0x7fffffffu) : ~ordered;
+		float x;
+		std::memcpy(&x, &bits, sizeof(x));
+		return x;
+	}
+};
+
+} // namespace Gudhi::multiparameter::multi_filtrations
+
+#endif // FILTRATION_STATISTICS_H_INCLUDED
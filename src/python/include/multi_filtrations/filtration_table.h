@@ -0,0 +1,80 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file filtration_table.h
+ * @brief Structure-of-arrays storage of multi-parameter filtration values.
+ */
+
+#ifndef FILTRATION_TABLE_H_INCLUDED
+#define FILTRATION_TABLE_H_INCLUDED
+
+#include <vector>
+#include <cstddef>
+#include <limits>
+
+namespace Gudhi::multiparameter::multi_filtrations{
+
+/**
+ * @brief Filtration values of a complex, stored parameter by parameter.
+ *
+ * The value of the parameter `p` of the simplex of key `k` is stored at `data()[p * num_simplices() + k]`,
+ * i.e., the table is parameter-major: a row-major `num_parameters x num_simplices` matrix. Every parameter is thus
+ * a contiguous array, which allows vectorized passes over one parameter and zero-copy views from Python.
+ * The dimension of each simplex is stored next to it, as most passes need it.
+ */
+template<typename T>
+class Filtration_table {
+public:
+	using value_type = T;
+
+	Filtration_table() : num_parameters_(0), num_simplices_(0) {}
+	Filtration_table(std::size_t num_parameters, std::size_t num_simplices)
+		: num_parameters_(num_parameters),
+		  num_simplices_(num_simplices),
+		  values_(num_parameters * num_simplices, -std::numeric_limits<T>::infinity()),
+		  dimensions_(num_simplices, 0) {}
+
+	std::size_t num_parameters() const { return num_parameters_; }
+	std::size_t num_simplices() const { return num_simplices_; }
+	bool empty() const { return num_simplices_ == 0; }
+
+	T* data() { return values_.data(); }
+	const T* data() const { return values_.data(); }
+
+	// Contiguous array of the values of one parameter, indexed by simplex key.
+	T* parameter(std::size_t p) { return values_.data() + p * num_simplices_; }
+	const T* parameter(std::size_t p) const { return values_.data() + p * num_simplices_; }
+
+	T& operator()(std::size_t p, std::size_t key) { return values_[p * num_simplices_ + key]; }
+	const T& operator()(std::size_t p, std::size_t key) const { return values_[p * num_simplices_ + key]; }
+
+	int& dimension(std::size_t key) { return dimensions_[key]; }
+	int dimension(std::size_t key) const { return dimensions_[key]; }
+	const std::vector<int>& dimensions() const { return dimensions_; }
+
+	void clear() {
+		num_parameters_ = 0;
+		num_simplices_ = 0;
+		values_.clear();
+		values_.shrink_to_fit();
+		dimensions_.clear();
+		dimensions_.shrink_to_fit();
+	}
+
+private:
+	std::size_t num_parameters_;
+	std::size_t num_simplices_;
+	std::vector<T> values_;
+	std::vector<int> dimensions_;
+};
+
+} // namespace Gudhi::multiparameter::multi_filtrations
+
+#endif // FILTRATION_TABLE_H_INCLUDED
@@ -4,15 +4,33 @@
 #include <iostream>
 #include <algorithm>
 #include <limits>
+#include <array>
+#include <cstring>
+#include <vector>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
 
 namespace Gudhi::multiparameter::multi_filtrations{
 
+// Infinite values of T. Types without infinity (e.g. integer grid coordinates) use their extremal values instead.
+template<typename T>
+constexpr T plus_infinity(){
+	if constexpr (std::numeric_limits<T>::has_infinity) return std::numeric_limits<T>::infinity();
+	else return std::numeric_limits<T>::max();
+}
+template<typename T>
+constexpr T minus_infinity(){
+	if constexpr (std::numeric_limits<T>::has_infinity) return -std::numeric_limits<T>::infinity();
+	else return std::numeric_limits<T>::lowest();
+}
+
 template<typename T=float>
 class Finitely_critical_multi_filtration : public std::vector<T> {
 	// Class to prevent doing illegal stuff with the standard library, e.g., compare two vectors
 public:
 	Finitely_critical_multi_filtration() : std::vector<T>() {};
-	Finitely_critical_multi_filtration(int n) : std::vector<T>(n, -std::numeric_limits<T>::infinity()) {}; // minus infinity by default
+	Finitely_critical_multi_filtration(int n) : std::vector<T>(n, minus_infinity<T>()) {}; // minus infinity by default
 	Finitely_critical_multi_filtration(int n, T value) : std::vector<T>(n,value) {};
 	Finitely_critical_multi_filtration(std::initializer_list<T> init) : std::vector<T>(init) {};
 	Finitely_critical_multi_filtration(const std::vector<T>& v) : std::vector<T>(v) {};
@@ -61,6 +79,8 @@ public:
 		return b<=a; 
 	}
 
+	// Declared with the assignment, the implicit copy constructor is deprecated
+	Finitely_critical_multi_filtration(const Finitely_critical_multi_filtration&) = default;
 	Finitely_critical_multi_filtration& operator=(const Finitely_critical_multi_filtration& a){
 		std::vector<T>::operator=(a);
 		return *this;
@@ -121,7 +141,7 @@ public:
 
 
 	// scalar product of a filtration value with x.
-	T linear_projection(const std::vector<T>& x){
+	T linear_projection(const std::vector<T>& x) const{
 		T projection=0;
 		unsigned int size = std::min(x.size(), this->size());
 		for (auto i =0u; i<size;i++)
@@ -140,11 +160,156 @@ public:
         return stream;
     }
 
+	// Serialization in a Simplex_tree buffer (cf. Simplex_tree::serialize) : the number of parameters, then the values.
+	friend std::size_t get_serialization_size_of(const Finitely_critical_multi_filtration& value){
+		return sizeof(std::size_t) + value.size() * sizeof(T);
+	}
+	friend char* serialize_value_to_char_buffer(const Finitely_critical_multi_filtration& value, char* start){
+		const std::size_t size = value.size();
+		std::memcpy(start, &size, sizeof(std::size_t));
+		std::memcpy(start + sizeof(std::size_t), value.data(), size * sizeof(T));
+		return start + sizeof(std::size_t) + size * sizeof(T);
+	}
+	friend const char* deserialize_value_from_char_buffer(Finitely_critical_multi_filtration& value, const char* start){
+		std::size_t size;
+		std::memcpy(&size, start, sizeof(std::size_t));
+		value.resize(size);
+		std::memcpy(value.data(), start + sizeof(std::size_t), size * sizeof(T));
+		return start + sizeof(std::size_t) + size * sizeof(T);
+	}
+
 
 
 
 };
 
 
+// Same as Finitely_critical_multi_filtration, but with a number of parameters known at compile time.
+// The values are stored inline (std::array), so a simplex tree node using it does not allocate.
+template<typename T=float, std::size_t N=2>
+class Finitely_critical_multi_filtration_fixed : public std::array<T,N> {
+	using Base = std::array<T,N>;
+public:
+	Finitely_critical_multi_filtration_fixed() { this->fill(minus_infinity<T>()); }; // minus infinity by default
+	Finitely_critical_multi_filtration_fixed(int n) : Finitely_critical_multi_filtration_fixed(n, minus_infinity<T>()) {};
+	Finitely_critical_multi_filtration_fixed(int n, T value) {
+		if (n > static_cast<int>(N)) throw std::logic_error("Too many parameters for a fixed size filtration");
+		this->fill(value);
+	};
+	Finitely_critical_multi_filtration_fixed(std::initializer_list<T> init) : Finitely_critical_multi_filtration_fixed(init.begin(), init.end()) {};
+	Finitely_critical_multi_filtration_fixed(const std::vector<T>& v) : Finitely_critical_multi_filtration_fixed(v.begin(), v.end()) {};
+	template<class InputIterator, class = std::enable_if_t<!std::is_arithmetic_v<InputIterator>>>
+	Finitely_critical_multi_filtration_fixed(InputIterator it_begin, InputIterator it_end) : Finitely_critical_multi_filtration_fixed() {
+		// Missing values stay at minus infinity, so that a shorter value behaves as a lower bound.
+		for (std::size_t i = 0; i < N && it_begin != it_end; ++i, ++it_begin)
+			(*this)[i] = *it_begin;
+	}
+
+	std::vector<T> get_vector() const{
+		return std::vector<T>(this->begin(), this->end());
+	}
+
+	static constexpr std::size_t num_parameters() { return N; }
+
+	friend bool operator<(const Finitely_critical_multi_filtration_fixed& a, const Finitely_critical_multi_filtration_fixed& b)
+	{
+		bool isSame = true;
+		for (std::size_t i = 0; i < N; ++i){
+			if (a[i] > b[i]) return false;
+			if (isSame && a[i] != b[i]) isSame = false;
+		}
+		return !isSame;
+	}
+	friend bool operator<=(const Finitely_critical_multi_filtration_fixed& a, const Finitely_critical_multi_filtration_fixed& b)
+	{
+		for (std::size_t i = 0; i < N; ++i){
+			if (a[i] > b[i]) return false;
+		}
+		return true;
+	}
+	friend bool operator>(const Finitely_critical_multi_filtration_fixed& a, const Finitely_critical_multi_filtration_fixed& b)
+	{
+		return b<a;
+	}
+	friend bool operator>=(const Finitely_critical_multi_filtration_fixed& a, const Finitely_critical_multi_filtration_fixed& b)
+	{
+		return b<=a;
+	}
+	friend bool operator==(const Finitely_critical_multi_filtration_fixed& a, const Finitely_critical_multi_filtration_fixed& b)
+	{
+		return static_cast<const Base&>(a) == static_cast<const Base&>(b);
+	}
+	friend bool operator!=(const Finitely_critical_multi_filtration_fixed& a, const Finitely_critical_multi_filtration_fixed& b)
+	{
+		return !(a == b);
+	}
+
+	friend Finitely_critical_multi_filtration_fixed& operator-=(Finitely_critical_multi_filtration_fixed &result, const Finitely_critical_multi_filtration_fixed &to_substract){
+		for (std::size_t i = 0; i < N; ++i) result[i] -= to_substract[i];
+		return result;
+	}
+	friend Finitely_critical_multi_filtration_fixed& operator+=(Finitely_critical_multi_filtration_fixed &result, const Finitely_critical_multi_filtration_fixed &to_add){
+		for (std::size_t i = 0; i < N; ++i) result[i] += to_add[i];
+		return result;
+	}
+	friend Finitely_critical_multi_filtration_fixed& operator-=(Finitely_critical_multi_filtration_fixed &result, const T &to_substract){
+		for (auto & truc : result) truc -= to_substract;
+		return result;
+	}
+	friend Finitely_critical_multi_filtration_fixed& operator+=(Finitely_critical_multi_filtration_fixed &result, const T &to_add){
+		for (auto & truc : result) truc += to_add;
+		return result;
+	}
+
+	void push_to(const Finitely_critical_multi_filtration_fixed& x){
+		for (std::size_t i = 0; i < N; i++)
+			(*this)[i] = (*this)[i] > x[i] ? (*this)[i] : x[i];
+	}
+
+	// Kept for API compatibility with the dynamic version; the size cannot change.
+	void resize(std::size_t n){
+		if (n != N) throw std::logic_error("Cannot resize a fixed size filtration");
+	}
+
+	// scalar product of a filtration value with x.
+	T linear_projection(const std::vector<T>& x) const{
+		T projection=0;
+		std::size_t size = std::min(x.size(), N);
+		for (std::size_t i = 0u; i<size; i++)
+			projection += x[i]*(*this)[i];
+		return projection;
+	}
+
+	friend std::ostream& operator<<(std::ostream& stream, const Finitely_critical_multi_filtration_fixed& truc){
+		stream << "[";
+		for (std::size_t i = 0; i < N; i++){
+			if (i) stream << ", ";
+			stream << truc[i];
+		}
+		stream << "]";
+		return stream;
+	}
+};
+
+
 } // namespace Gudhi
+
+namespace std {
+
+// Contrary to the dynamic version, a fixed size filtration has a well defined infinity (all coordinates infinite).
+template<typename T, std::size_t N>
+class numeric_limits<Gudhi::multiparameter::multi_filtrations::Finitely_critical_multi_filtration_fixed<T,N>>
+{
+public:
+	static constexpr bool has_infinity = std::numeric_limits<T>::has_infinity;
+	static Gudhi::multiparameter::multi_filtrations::Finitely_critical_multi_filtration_fixed<T,N> infinity() throw(){
+		return Gudhi::multiparameter::multi_filtrations::Finitely_critical_multi_filtration_fixed<T,N>(N, Gudhi::multiparameter::multi_filtrations::plus_infinity<T>());
+	};
+	static Gudhi::multiparameter::multi_filtrations::Finitely_critical_multi_filtration_fixed<T,N> quiet_NaN() throw(){
+		return Gudhi::multiparameter::multi_filtrations::Finitely_critical_multi_filtration_fixed<T,N>(N, std::numeric_limits<T>::quiet_NaN());
+	};
+};
+
+}  // namespace std
+
 #endif  // FINITELY_CRITICAL_FILTRATIONS_H_
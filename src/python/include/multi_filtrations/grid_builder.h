@@ -0,0 +1,161 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file grid_builder.h
+ * @brief Computation of a 1d grid from the filtration values of one parameter.
+ */
+
+#ifndef GRID_BUILDER_H_INCLUDED
+#define GRID_BUILDER_H_INCLUDED
+
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_sort.h>
+#endif
+
+namespace Gudhi::multiparameter::multi_filtrations{
+
+enum class Grid_strategy { exact, regular, regular_closest, quantile, partition };
+
+inline Grid_strategy grid_strategy_from_name(const std::string& name){
+	if (name == "exact") return Grid_strategy::exact;
+	if (name == "regular") return Grid_strategy::regular;
+	if (name == "regular_closest") return Grid_strategy::regular_closest;
+	if (name == "quantile") return Grid_strategy::quantile;
+	if (name == "partition") return Grid_strategy::partition;
+	throw std::invalid_argument("Invalid strategy. Pick either regular, regular_closest, partition, quantile, precomputed or exact.");
+}
+
+/**
+ * @brief Sorts the values, in parallel with TBB, and removes the duplicates and the non-finite values.
+ */
+template<typename T>
+void sort_unique_finite(std::vector<T>& values){
+	values.erase(std::remove_if(values.begin(), values.end(), [](T x){ return !std::isfinite(x); }), values.end());
+#ifdef GUDHI_USE_TBB
+	tbb::parallel_sort(values.begin(), values.end());
+#else
+	std::sort(values.begin(), values.end());
+#endif
+	values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+/**
+ * @brief Rank of the quantile `q` of `n` sorted values, as `np.quantile(..., method="closest_observation")`: the
+ * nearest even order statistic to `n * q - 0.5` (1-based).
+ */
+inline std::size_t closest_observation_rank(std::size_t n, double q){
+	const double index = static_cast<double>(n) * q - 1.5;
+	const double previous = std::floor(index);
+	const bool odd = std::fmod(previous, 2.) != 0;
+	const double rank = (index == previous && odd) ? previous : previous + 1;
+	return rank <= 0 ? 0 : std::min(static_cast<std::size_t>(rank), n - 1);
+}
+
+/**
+ * @brief `i`-th of `num` evenly spaced values between `start` and `stop`, as `np.linspace(start, stop, num)[i]`.
+ */
+inline double linspace(double start, double stop, std::size_t i, std::size_t num){
+	if (i + 1 == num && num > 1) return stop;
+	return num == 1 ? start : static_cast<double>(i) * ((stop - start) / static_cast<double>(num - 1)) + start;
+}
+
+/**
+ * @brief Keeps the values between the quantiles `low` and `1 - high` of sorted distinct values.
+ */
+template<typename T>
+void drop_quantiles(std::vector<T>& values, double low, double high){
+	if (values.empty() || (low <= 0 && high <= 0)) return;
+	const auto first_kept = closest_observation_rank(values.size(), std::clamp(low, 0., 1.));
+	const auto last_kept = closest_observation_rank(values.size(), 1 - std::clamp(high, 0., 1.));
+	if (first_kept > last_kept) { values.clear(); return; }
+	values.erase(values.begin() + last_kept + 1, values.end());
+	values.erase(values.begin(), values.begin() + first_kept);
+}
+
+/**
+ * @brief Grid of a parameter with the given strategy, from its sorted distinct finite values:
+ *  - exact : all the values;
+ *  - regular : `resolution` evenly spaced values between the smallest and the largest value;
+ *  - regular_closest : the distinct values closest to `resolution` evenly spaced values;
+ *  - quantile : the distinct values of `resolution * quantile_factor` evenly spaced quantiles, cf.
+ *    `closest_observation_rank` and `quantile_grids`;
+ *  - partition : the values of rank `i * (size / resolution)`, for `i < resolution`.
+ */
+template<typename T>
+std::vector<T> reduce_grid(const std::vector<T>& values, Grid_strategy strategy, std::size_t resolution, double quantile_factor = 1){
+	const std::size_t n = values.size();
+	if (strategy == Grid_strategy::exact || n == 0) return values;
+	std::vector<T> grid;
+	switch (strategy){
+		case Grid_strategy::regular: {
+			grid.reserve(resolution);
+			const double min = values.front(), max = values.back();
+			for (std::size_t i = 0; i < resolution; i++)
+				grid.push_back(static_cast<T>(linspace(min, max, i, resolution)));
+			return grid;
+		}
+		case Grid_strategy::regular_closest: {
+			const double min = values.front(), max = values.back();
+			for (std::size_t i = 0; i < resolution; i++){
+				const double x = linspace(min, max, i, resolution);
+				auto it = std::lower_bound(values.begin(), values.end(), x);
+				if (it == values.end() || (it != values.begin() && x - *(it-1) <= *it - x)) --it;
+				if (grid.empty() || grid.back() != *it) grid.push_back(*it);
+			}
+			return grid;
+		}
+		case Grid_strategy::quantile: {
+			const auto num = static_cast<std::size_t>(static_cast<double>(resolution) * quantile_factor);
+			// The ranks are non-decreasing
+			for (std::size_t i = 0; i < num; i++){
+				const T x = values[closest_observation_rank(n, linspace(0, 1, i, num))];
+				if (grid.empty() || grid.back() != x) grid.push_back(x);
+			}
+			return grid;
+		}
+		case Grid_strategy::partition: {
+			resolution = std::min(resolution, n);
+			if (resolution == 0) return grid;
+			const std::size_t k = n / resolution;
+			for (std::size_t i = 0; i < resolution; i++) grid.push_back(values[i * k]);
+			return grid;
+		}
+		default:
+			return values;
+	}
+}
+
+/**
+ * @brief Quantile grids of all the parameters, from their sorted distinct finite values. As long as every parameter
+ * has fewer than `min(resolution, size)` distinct values, the number of quantiles is increased by half.
+ */
+template<typename T>
+std::vector<std::vector<T>> quantile_grids(const std::vector<std::vector<T>>& values, const std::vector<std::size_t>& resolutions){
+	std::vector<std::vector<T>> grids(values.size());
+	for (double factor = 1;; factor *= 1.5){
+		bool too_small = true;
+		for (std::size_t parameter = 0; parameter < values.size(); parameter++){
+			grids[parameter] = reduce_grid(values[parameter], Grid_strategy::quantile, resolutions[parameter], factor);
+			too_small = too_small && grids[parameter].size() < std::min(resolutions[parameter], values[parameter].size());
+		}
+		if (!too_small || values.empty()) return grids;
+	}
+}
+
+} // namespace Gudhi::multiparameter::multi_filtrations
+
+#endif // GRID_BUILDER_H_INCLUDED
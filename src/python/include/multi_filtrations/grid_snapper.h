@@ -0,0 +1,166 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file grid_snapper.h
+ * @brief Projection of filtration values on a sorted 1d grid.
+ */
+
+#ifndef GRID_SNAPPER_H_INCLUDED
+#define GRID_SNAPPER_H_INCLUDED
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+namespace Gudhi::multiparameter::multi_filtrations{
+
+enum class Snapping_strategy { linear_scan, binary_search, bucket_table };
+
+inline const char* snapping_strategy_name(Snapping_strategy strategy){
+	switch (strategy){
+		case Snapping_strategy::linear_scan: return "linear_scan";
+		case Snapping_strategy::binary_search: return "binary_search";
+		case Snapping_strategy::bucket_table: return "bucket_table";
+	}
+	return "unknown";
+}
+
+/**
+ * @brief Finds the closest coordinate of a value in a 1d grid.
+ *
+ * The grid is analysed once at construction, and one of the following strategies is chosen:
+ *  - a linear scan, for small grids;
+ *  - a bucket table, when the grid values are evenly spread : the (finite) range of the grid is cut into
+ *    `grid.size()` buckets, each storing the first grid index of its bucket, so that a lookup is an O(1)
+ *    computation followed by a few comparisons;
+ *  - a branchless binary search otherwise.
+ *
+ * All strategies give the same result : the index of the closest grid value (the largest one on ties),
+ * 0 below the grid, the last index above it, and infinity for an infinite value.
+ * The grid must be sorted; duplicates are kept, so that coordinates are indices of the given grid.
+ *
+ * @exception std::invalid_argument If the grid is not sorted.
+ */
+template<typename T>
+class Grid_snapper {
+public:
+	static constexpr std::size_t linear_scan_threshold = 16;
+	static constexpr std::size_t max_bucket_size = 8;
+
+	Grid_snapper(const std::vector<T>& grid) : grid_(grid){
+		if (!std::is_sorted(grid_.begin(), grid_.end()))
+			throw std::invalid_argument("Grid_snapper - the grid must be sorted");
+		if (grid_.size() <= linear_scan_threshold)
+			strategy_ = Snapping_strategy::linear_scan;
+		else if (build_bucket_table())
+			strategy_ = Snapping_strategy::bucket_table;
+		else
+			strategy_ = Snapping_strategy::binary_search;
+	}
+
+	Snapping_strategy strategy() const { return strategy_; }
+	const std::vector<T>& grid() const { return grid_; }
+
+	// Coordinate of x in the grid, as a T (infinity for infinite values).
+	T coordinate(const T x) const {
+		if constexpr (std::numeric_limits<T>::has_infinity)
+			if (x == std::numeric_limits<T>::infinity())
+				return std::numeric_limits<T>::infinity();
+		if (grid_.empty()) return 0;
+		if (x >= grid_.back())
+			return static_cast<T>(grid_.size()-1); // deals with infinite value at the end of the grid
+		const std::size_t i = lower_bound(x);
+		if (i == 0)
+			return 0;
+		return std::abs(grid_[i-1] - x) < std::abs(grid_[i] - x) ? static_cast<T>(i-1) : static_cast<T>(i);
+	}
+
+	// Closest grid value of x.
+	T value(const T x) const {
+		const T c = coordinate(x);
+		if constexpr (std::numeric_limits<T>::has_infinity)
+			if (c == std::numeric_limits<T>::infinity())
+				return c;
+		return grid_.empty() ? x : grid_[static_cast<std::size_t>(c)];
+	}
+
+private:
+	std::vector<T> grid_;
+	Snapping_strategy strategy_;
+	std::vector<std::size_t> bucket_start_;
+	double bucket_origin_ = 0;
+	double bucket_scale_ = 0;
+
+	// Index of the first grid value >= x, for x < grid_.back().
+	std::size_t lower_bound(const T x) const {
+		switch (strategy_){
+			case Snapping_strategy::linear_scan: {
+				std::size_t i = 0;
+				while (i < grid_.size() && x > grid_[i]) i++;
+				return i;
+			}
+			case Snapping_strategy::bucket_table: {
+				if (!(x > grid_.front())) return 0; // also catches NaN and -inf
+				const std::size_t bucket = std::min(static_cast<std::size_t>((static_cast<double>(x) - bucket_origin_) * bucket_scale_), bucket_start_.size()-1);
+				std::size_t i = bucket_start_[bucket];
+				while (i > 0 && !(grid_[i-1] < x)) i--; // rounding errors
+				while (grid_[i] < x) i++;
+				return i;
+			}
+			case Snapping_strategy::binary_search: {
+				const T* base = grid_.data();
+				std::size_t length = grid_.size();
+				while (length > 1){
+					const std::size_t half = length / 2;
+					base += (base[half-1] < x) * half;
+					length -= half;
+				}
+				return static_cast<std::size_t>(base - grid_.data()) + (*base < x);
+			}
+		}
+		return 0;
+	}
+
+	// Returns false if the grid is too unevenly spread for buckets to help.
+	bool build_bucket_table(){
+		std::size_t last = grid_.size();
+		while (last > 0 && !std::isfinite(static_cast<double>(grid_[last-1]))) last--; // the end of the grid may be infinite
+		if (last < 2 || !std::isfinite(static_cast<double>(grid_.front())) || !(grid_[last-1] > grid_.front()))
+			return false;
+		const std::size_t num_buckets = last;
+		bucket_origin_ = static_cast<double>(grid_.front());
+		bucket_scale_ = static_cast<double>(num_buckets) / (static_cast<double>(grid_[last-1]) - bucket_origin_);
+		if (!std::isfinite(bucket_scale_))
+			return false;
+		bucket_start_.assign(num_buckets, 0);
+		std::size_t i = 0;
+		for (std::size_t bucket = 0; bucket < num_buckets; bucket++){
+			const double left = bucket_origin_ + static_cast<double>(bucket) / bucket_scale_;
+			while (i < last && static_cast<double>(grid_[i]) < left) i++;
+			bucket_start_[bucket] = i;
+			if (bucket > 0 && bucket_start_[bucket] - bucket_start_[bucket-1] > max_bucket_size){
+				bucket_start_.clear();
+				return false;
+			}
+		}
+		if (last - bucket_start_.back() > max_bucket_size){
+			bucket_start_.clear();
+			return false;
+		}
+		return true;
+	}
+};
+
+} // namespace Gudhi::multiparameter::multi_filtrations
+
+#endif // GRID_SNAPPER_H_INCLUDED
@@ -31,9 +31,14 @@ namespace Gudhi::multiparameter::multi_filtrations{
 		Line();
 		Line(point_type x);
 		Line(point_type x, point_type v);
-		point_type push_forward(point_type x) const;
-		point_type push_back(point_type x) const;
+		point_type push_forward(const point_type& x) const;
+		point_type push_back(const point_type& x) const;
+		// Coordinate i of push_forward(x), for any random access range x, without allocation.
+		template<class Point>
+		T push_forward_coordinate(const Point& x, std::size_t i) const;
 		int get_dim() const;
+		const point_type& basepoint() const { return basepoint_; }
+		const point_type& direction() const { return direction_; } // empty for the diagonal direction
 		std::pair<point_type, point_type> get_bounds(const Box<T> &box) const;
 
 
@@ -41,6 +46,13 @@ namespace Gudhi::multiparameter::multi_filtrations{
 		point_type basepoint_; // any point on the line
 		point_type direction_; // direction of the line
 
+		T direction(std::size_t i) const { return direction_.size() > i ? direction_[i] : 1; }
+		// Parameter t of the push forward (resp. push back) basepoint_ + t * direction_ of x on the line
+		template<class Point>
+		T push_forward_parameter(const Point& x) const;
+		template<class Point>
+		T push_back_parameter(const Point& x) const;
+
 	};
 	template<typename T>
 	Line<T>::Line(){}
@@ -56,29 +68,40 @@ namespace Gudhi::multiparameter::multi_filtrations{
 		this->direction_.swap(v);
 	}
 	template<typename T>
-	typename Line<T>::point_type Line<T>::push_forward(point_type x) const { //TODO remove copy
-		x -= basepoint_;
-		T t = - std::numeric_limits<T>::infinity();;
-		for (std::size_t i = 0; i<x.size(); i++){
-			T dir  = this->direction_.size() > i ? direction_[i] : 1;
-			t = std::max(t, x[i]/dir);
-		}
+	template<class Point>
+	T Line<T>::push_forward_parameter(const Point& x) const {
+		T t = - std::numeric_limits<T>::infinity();
+		for (std::size_t i = 0; i < static_cast<std::size_t>(x.size()); i++)
+			t = std::max(t, (x[i] - basepoint_[i]) / direction(i));
+		return t;
+	}
+	template<typename T>
+	template<class Point>
+	T Line<T>::push_back_parameter(const Point& x) const {
+		T t = std::numeric_limits<T>::infinity();
+		for (std::size_t i = 0; i < static_cast<std::size_t>(x.size()); i++)
+			t = std::min(t, (x[i] - basepoint_[i]) / direction(i));
+		return t;
+	}
+	template<typename T>
+	typename Line<T>::point_type Line<T>::push_forward(const point_type& x) const {
+		const T t = push_forward_parameter(x);
 		point_type out(basepoint_.size());
-		for (unsigned int i = 0; i < out.size(); i++)
-			out[i] = basepoint_[i] + t * (this->direction_.size() > i ? direction_[i] : 1) ;
+		for (std::size_t i = 0; i < out.size(); i++)
+			out[i] = basepoint_[i] + t * direction(i);
 		return out;
 	}
 	template<typename T>
-	typename Line<T>::point_type Line<T>::push_back(point_type x) const{
-		x -= basepoint_;
-		T t = std::numeric_limits<T>::infinity();
-		for (unsigned int i = 0; i<x.size(); i++){
-			T dir  = this->direction_.size() > i ? direction_[i] : 1;
-			t = std::min(t, x[i]/dir);
-		}
+	template<class Point>
+	T Line<T>::push_forward_coordinate(const Point& x, std::size_t i) const {
+		return basepoint_[i] + push_forward_parameter(x) * direction(i);
+	}
+	template<typename T>
+	typename Line<T>::point_type Line<T>::push_back(const point_type& x) const{
+		const T t = push_back_parameter(x);
 		point_type out(basepoint_.size());
-		for (unsigned int i = 0; i < out.size(); i++)
-			out[i] = basepoint_[i] + t * (this->direction_.size() > i ? direction_[i] : 1) ;
+		for (std::size_t i = 0; i < out.size(); i++)
+			out[i] = basepoint_[i] + t * direction(i);
 		return out;
 	}
 	template<typename T>
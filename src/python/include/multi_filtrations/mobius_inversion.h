@@ -0,0 +1,129 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+/**
+ * @file mobius_inversion.h
+ * @brief Möbius inversion of invariants on a grid, and their sparse signed measures.
+ */
+
+#ifndef MOBIUS_INVERSION_H_INCLUDED
+#define MOBIUS_INVERSION_H_INCLUDED
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/parallel_for.h>
+#endif
+
+namespace Gudhi::multiparameter::multi_filtrations{
+
+namespace mobius_detail{
+
+// Calls f(i) for i in [0, n), in parallel with TBB.
+template<class F>
+void for_each_index(std::size_t n, F&& f){
+#ifdef GUDHI_USE_TBB
+	tbb::parallel_for(std::size_t(0), n, [&](std::size_t i){ f(i); });
+#else
+	for (std::size_t i = 0; i < n; i++) f(i);
+#endif
+}
+
+inline std::size_t product(std::vector<std::size_t>::const_iterator begin, std::vector<std::size_t>::const_iterator end){
+	return std::accumulate(begin, end, std::size_t(1), std::multiplies<std::size_t>());
+}
+
+} // namespace mobius_detail
+
+/**
+ * @brief Möbius inversion, in place, of a row-major tensor of shape `shape` along its axes `first_axis, ...`, i.e.,
+ * \f$\mu(x) = \sum_{\varepsilon \in \{0,1\}^k} (-1)^{|\varepsilon|} f(x - \varepsilon)\f$, with \f$f\f$ zero out
+ * of the grid. The first axes, e.g. the homological degrees of a Hilbert function, are not inverted.
+ *
+ * This is a finite difference along each inverted axis, one after the other, so that no copy of the tensor is made.
+ * Each difference is computed in parallel on slabs of the tensor with TBB.
+ */
+template<typename T>
+void mobius_inversion(std::vector<T>& tensor, const std::vector<std::size_t>& shape, std::size_t first_axis = 0){
+	if (mobius_detail::product(shape.begin(), shape.end()) != tensor.size())
+		throw std::invalid_argument("The size of the tensor does not match its shape.");
+	constexpr std::size_t block = 256;
+	for (std::size_t axis = first_axis; axis < shape.size(); axis++){
+		const std::size_t n = shape[axis];
+		if (n < 2) continue;
+		const std::size_t outer = mobius_detail::product(shape.begin(), shape.begin() + axis);
+		const std::size_t inner = mobius_detail::product(shape.begin() + axis + 1, shape.end());
+		const std::size_t num_blocks = (inner + block - 1) / block;
+		// A slab is a block of consecutive inner indices of one outer index, and goes along the whole axis
+		mobius_detail::for_each_index(outer * num_blocks, [&](std::size_t slab){
+			const std::size_t o = slab / num_blocks;
+			const std::size_t begin = (slab % num_blocks) * block;
+			const std::size_t end = std::min(begin + block, inner);
+			T* t = tensor.data() + o * n * inner;
+			for (std::size_t i = n - 1; i > 0; i--)
+				for (std::size_t k = begin; k < end; k++)
+					t[i * inner + k] -= t[(i - 1) * inner + k];
+		});
+	}
+}
+
+/**
+ * @brief Non-zero entries of a row-major tensor of shape `shape` : their coordinates, `shape.size()` per entry in
+ * row-major order, are appended to `coordinates` and their values to `weights`. The tensor is scanned in parallel
+ * with TBB, and the entries are in row-major order.
+ */
+template<typename T, typename index_type>
+void sparsify(const std::vector<T>& tensor, const std::vector<std::size_t>& shape, std::vector<index_type>& coordinates, std::vector<T>& weights){
+	if (mobius_detail::product(shape.begin(), shape.end()) != tensor.size())
+		throw std::invalid_argument("The size of the tensor does not match its shape.");
+	if (tensor.empty()) return;
+	const std::size_t num_axes = shape.size();
+	constexpr std::size_t chunk = 1 << 14;
+	const std::size_t num_chunks = (tensor.size() + chunk - 1) / chunk;
+	std::vector<std::vector<index_type>> chunk_coordinates(num_chunks);
+	std::vector<std::vector<T>> chunk_weights(num_chunks);
+	mobius_detail::for_each_index(num_chunks, [&](std::size_t c){
+		const std::size_t end = std::min((c + 1) * chunk, tensor.size());
+		for (std::size_t i = c * chunk; i < end; i++){
+			if (tensor[i] == 0) continue;
+			const std::size_t first = chunk_coordinates[c].size();
+			chunk_coordinates[c].resize(first + num_axes);
+			std::size_t r = i;
+			for (std::size_t axis = num_axes; axis-- > 0;){
+				chunk_coordinates[c][first + axis] = static_cast<index_type>(r % shape[axis]);
+				r /= shape[axis];
+			}
+			chunk_weights[c].push_back(tensor[i]);
+		}
+	});
+	for (std::size_t c = 0; c < num_chunks; c++){
+		coordinates.insert(coordinates.end(), chunk_coordinates[c].begin(), chunk_coordinates[c].end());
+		weights.insert(weights.end(), chunk_weights[c].begin(), chunk_weights[c].end());
+	}
+}
+
+/**
+ * @brief Signed measure of an invariant on a grid, e.g. a Hilbert function : the sparse Möbius inversion of the tensor
+ * along its axes `first_axis, ...`, cf. `mobius_inversion` and `sparsify`. The tensor is overwritten.
+ */
+template<typename T, typename index_type>
+void signed_measure(std::vector<T>& tensor, const std::vector<std::size_t>& shape, std::size_t first_axis, std::vector<index_type>& coordinates, std::vector<T>& weights){
+	mobius_inversion(tensor, shape, first_axis);
+	sparsify(tensor, shape, coordinates, weights);
+}
+
+} // namespace Gudhi::multiparameter::multi_filtrations
+
+#endif // MOBIUS_INVERSION_H_INCLUDED
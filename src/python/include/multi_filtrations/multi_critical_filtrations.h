@@ -0,0 +1,237 @@
+/*    This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+ *    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+ *    Author(s):       David Loiseaux
+ *
+ *    Copyright (C) 2023 Inria
+ *
+ *    Modification(s):
+ *      - YYYY/MM Author: Description of the modification
+ */
+
+#ifndef MULTI_CRITICAL_FILTRATIONS_H_
+#define MULTI_CRITICAL_FILTRATIONS_H_
+
+#include "finitely_critical_filtrations.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Gudhi::multiparameter::multi_filtrations{
+
+/**
+ * Filtration value of a multi-critical filtration : a simplex appears at several incomparable grades, its generators.
+ *
+ * The generators are kept as a minimal antichain, i.e., a new generator above an existing one is discarded, and the
+ * existing generators above a new one are removed, so that the storage and the comparisons do not grow with redundant
+ * grades. They are stored contiguously in a single flat buffer, the generator i starting at the offset
+ * `i * num_parameters()`, and sorted lexicographically, so that equal values have the same representation.
+ *
+ * A value without generator never appears, it is the infinity of this type.
+ */
+template<typename T=float>
+class Multi_critical_filtration {
+public:
+	using value_type = T;
+	// Simplex_tree handles multi-critical filtrations when this is true, cf. simplex_tree::is_multi_critical.
+	static constexpr bool is_multi_critical = true;
+
+	Multi_critical_filtration() {}; // no generator : plus infinity
+	Multi_critical_filtration(int n) : Multi_critical_filtration(n, minus_infinity<T>()) {}; // minus infinity by default
+	Multi_critical_filtration(int n, T value) : values_(n, value), num_parameters_(n) {};
+	Multi_critical_filtration(std::initializer_list<T> init) : values_(init), num_parameters_(init.size()) {};
+	Multi_critical_filtration(const std::vector<T>& v) : values_(v), num_parameters_(v.size()) {}; // 1-critical
+	// Minimal antichain of the given grades.
+	Multi_critical_filtration(const std::vector<std::vector<T>>& generators) {
+		if (generators.empty()) return;
+		num_parameters_ = generators.front().size();
+		for (const auto& generator : generators) add_generator(generator);
+	}
+
+	std::size_t num_parameters() const { return num_parameters_; }
+	std::size_t num_generators() const { return num_parameters_ == 0 ? 0 : values_.size() / num_parameters_; }
+	bool empty() const { return values_.empty(); }
+	// Pointer to the num_parameters() coordinates of the generator i.
+	const T* generator(std::size_t i) const { return values_.data() + i * num_parameters_; }
+	std::vector<T> get_generator(std::size_t i) const { return std::vector<T>(generator(i), generator(i) + num_parameters_); }
+	std::vector<std::vector<T>> get_generators() const {
+		std::vector<std::vector<T>> out;
+		out.reserve(num_generators());
+		for (std::size_t i = 0; i < num_generators(); i++) out.push_back(get_generator(i));
+		return out;
+	}
+	// The flat buffer of the generators.
+	const std::vector<T>& values() const { return values_; }
+
+	/** Adds a grade at which the simplex appears.
+	 * @return false if the grade was already above a generator, in which case nothing changes. */
+	bool add_generator(const T* x) {
+		const std::size_t n = num_parameters_, k = num_generators();
+		for (std::size_t i = 0; i < k; i++)
+			if (is_below(generator(i), x, n)) return false;
+		// removes the generators above x, keeping the order of the others.
+		std::size_t kept = 0;
+		for (std::size_t i = 0; i < k; i++){
+			if (is_below(x, generator(i), n)) continue;
+			if (kept != i) std::copy_n(values_.begin() + i * n, n, values_.begin() + kept * n);
+			kept++;
+		}
+		values_.resize(kept * n);
+		std::size_t position = 0;
+		while (position < kept && std::lexicographical_compare(generator(position), generator(position) + n, x, x + n)) position++;
+		values_.insert(values_.begin() + position * n, x, x + n);
+		return true;
+	}
+	bool add_generator(const std::vector<T>& x) {
+		if (empty() && num_parameters_ == 0) num_parameters_ = x.size();
+		if (x.size() != num_parameters_) throw std::logic_error("Bad number of parameters");
+		return add_generator(x.data());
+	}
+
+	// Union of the grades of the two values, i.e., the simplex appears as soon as it appears in one of them.
+	void insert_new(const Multi_critical_filtration& x) {
+		if (x.empty()) return;
+		if (empty()) { *this = x; return; }
+		check_sizes(x);
+		for (std::size_t i = 0; i < x.num_generators(); i++) add_generator(x.generator(i));
+	}
+
+	// Pushes this value to x : the simplex appears when it appears in both of them, i.e., at the joins (coordinate-wise
+	// maximums) of their generators. This is the intersection of the two upsets of the grades.
+	void push_to(const Multi_critical_filtration& x) {
+		if (empty()) return;
+		if (x.empty()) { values_.clear(); return; }
+		check_sizes(x);
+		Multi_critical_filtration out;
+		out.num_parameters_ = num_parameters_;
+		std::vector<T> join(num_parameters_);
+		for (std::size_t i = 0; i < num_generators(); i++)
+			for (std::size_t j = 0; j < x.num_generators(); j++){
+				for (std::size_t p = 0; p < num_parameters_; p++)
+					join[p] = std::max(generator(i)[p], x.generator(j)[p]);
+				out.add_generator(join.data());
+			}
+		*this = std::move(out);
+	}
+
+	// a <= b if every grade of b is above a grade of a, i.e., a simplex with value b appears after one with value a.
+	friend bool operator<=(const Multi_critical_filtration& a, const Multi_critical_filtration& b)
+	{
+		const std::size_t n = std::min(a.num_parameters_, b.num_parameters_);
+		for (std::size_t j = 0; j < b.num_generators(); j++){
+			bool above = false;
+			for (std::size_t i = 0; i < a.num_generators() && !above; i++)
+				above = is_below(a.generator(i), b.generator(j), n);
+			if (!above) return false;
+		}
+		return true;
+	}
+	friend bool operator==(const Multi_critical_filtration& a, const Multi_critical_filtration& b)
+	{
+		return a.values_ == b.values_ && (a.empty() || a.num_parameters_ == b.num_parameters_);
+	}
+	friend bool operator!=(const Multi_critical_filtration& a, const Multi_critical_filtration& b)
+	{
+		return !(a == b);
+	}
+	friend bool operator<(const Multi_critical_filtration& a, const Multi_critical_filtration& b)
+	{
+		return a <= b && a != b;
+	}
+	friend bool operator>(const Multi_critical_filtration& a, const Multi_critical_filtration& b)
+	{
+		return b<a;
+	}
+	friend bool operator>=(const Multi_critical_filtration& a, const Multi_critical_filtration& b)
+	{
+		return b<=a;
+	}
+
+	// Smallest scalar product of a generator with x. Plus infinity without generator.
+	T linear_projection(const std::vector<T>& x) const{
+		T projection = plus_infinity<T>();
+		const std::size_t size = std::min(x.size(), num_parameters_);
+		for (std::size_t i = 0; i < num_generators(); i++){
+			T value = 0;
+			for (std::size_t p = 0; p < size; p++) value += x[p] * generator(i)[p];
+			projection = std::min(projection, value);
+		}
+		return projection;
+	}
+
+	friend std::ostream& operator<<(std::ostream& stream, const Multi_critical_filtration& truc){
+		stream << "{";
+		for (std::size_t i = 0; i < truc.num_generators(); i++){
+			if (i) stream << ", ";
+			stream << "[";
+			for (std::size_t p = 0; p < truc.num_parameters_; p++){
+				if (p) stream << ", ";
+				stream << truc.generator(i)[p];
+			}
+			stream << "]";
+		}
+		stream << "}";
+		return stream;
+	}
+
+	// Serialization in a Simplex_tree buffer (cf. Simplex_tree::serialize) : the number of parameters, the number of
+	// generators, then the flat buffer of the generators.
+	friend std::size_t get_serialization_size_of(const Multi_critical_filtration& value){
+		return 2 * sizeof(std::size_t) + value.values_.size() * sizeof(T);
+	}
+	friend char* serialize_value_to_char_buffer(const Multi_critical_filtration& value, char* start){
+		const std::size_t num_generators = value.num_generators();
+		std::memcpy(start, &value.num_parameters_, sizeof(std::size_t));
+		std::memcpy(start + sizeof(std::size_t), &num_generators, sizeof(std::size_t));
+		std::memcpy(start + 2 * sizeof(std::size_t), value.values_.data(), value.values_.size() * sizeof(T));
+		return start + get_serialization_size_of(value);
+	}
+	friend const char* deserialize_value_from_char_buffer(Multi_critical_filtration& value, const char* start){
+		std::size_t num_generators;
+		std::memcpy(&value.num_parameters_, start, sizeof(std::size_t));
+		std::memcpy(&num_generators, start + sizeof(std::size_t), sizeof(std::size_t));
+		value.values_.resize(num_generators * value.num_parameters_);
+		std::memcpy(value.values_.data(), start + 2 * sizeof(std::size_t), value.values_.size() * sizeof(T));
+		return start + get_serialization_size_of(value);
+	}
+
+private:
+	static bool is_below(const T* a, const T* b, std::size_t n) {
+		for (std::size_t p = 0; p < n; p++)
+			if (a[p] > b[p]) return false;
+		return true;
+	}
+	void check_sizes(const Multi_critical_filtration& x) const {
+		if (num_parameters_ != x.num_parameters_){
+			std::cerr << "Sizes " << num_parameters_ << " and " << x.num_parameters_ << " are different !" << std::endl;
+			throw std::logic_error("Bad sizes");
+		}
+	}
+
+	std::vector<T> values_; // generators, one after the other
+	std::size_t num_parameters_ = 0;
+};
+
+} // namespace Gudhi::multiparameter::multi_filtrations
+
+namespace std {
+
+template<typename T>
+class numeric_limits<Gudhi::multiparameter::multi_filtrations::Multi_critical_filtration<T>>
+{
+public:
+	static constexpr bool has_infinity = true;
+	// A simplex without generator never appears.
+	static Gudhi::multiparameter::multi_filtrations::Multi_critical_filtration<T> infinity() throw(){
+		return Gudhi::multiparameter::multi_filtrations::Multi_critical_filtration<T>();
+	};
+};
+
+}  // namespace std
+
+#endif  // MULTI_CRITICAL_FILTRATIONS_H_
@@ -14,6 +14,18 @@
 #include <boost/range/counting_range.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#ifdef GUDHI_USE_TBB
+#include <tbb/blocked_range2d.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include "Thread_pool.h"
+
 namespace py = pybind11;
 typedef py::array_t<double> Dgm;
 
@@ -40,3 +52,71 @@ inline auto numpy_to_range_of_pairs(py::array_t<double> dgm, BuildPoint build_po
   return boost::adaptors::transform(cnt, pairify);
   // Be careful that the returned range cannot contain references to dead temporaries.
 }
+
+typedef py::array_t<double, py::array::c_style | py::array::forcecast> Packed_coords;
+typedef py::array_t<std::int64_t, py::array::c_style | py::array::forcecast> Packed_offsets;
+
+// A list of diagrams packed in 2 arrays: the points of the diagram i are the rows offsets[i] to offsets[i+1] of coords,
+// of shape (n,2). Each diagram is converted once, with build_point as in numpy_to_range_of_pairs.
+template<class BuildPoint>
+inline auto unpack_diagrams(Packed_coords coords, Packed_offsets offsets, BuildPoint build_point) {
+  if((coords.ndim()!=2 || coords.shape(1)!=2) && (coords.ndim()!=1 || coords.shape(0)!=0))
+    throw std::runtime_error("Diagrams must be packed in an array of size n x 2");
+  if(offsets.ndim()!=1 || offsets.shape(0)==0)
+    throw std::runtime_error("Offsets must be a non-empty 1D array");
+  const double* p = coords.data();
+  const std::int64_t* off = offsets.data();
+  const py::ssize_t n = offsets.shape(0) - 1;
+  if(off[0] != 0 || off[n] != coords.shape(0))
+    throw std::runtime_error("Offsets do not match the number of points");
+  std::vector<std::vector<decltype(build_point(0., 0., py::ssize_t()))>> diagrams(n);
+  for(py::ssize_t i = 0; i < n; ++i){
+    if(off[i] > off[i+1])
+      throw std::runtime_error("Offsets must be non-decreasing");
+    diagrams[i].reserve(off[i+1] - off[i]);
+    for(std::int64_t j = off[i]; j < off[i+1]; ++j)
+      diagrams[i].push_back(build_point(p[2 * j], p[2 * j + 1], j - off[i]));
+  }
+  return diagrams;
+}
+
+// Matrix of distance(X[i], Y[j]), or of distance(X[i], X[j]) if Y is empty, in which case only the pairs i < j are
+// computed and the diagonal is 0. The pairs are scheduled by TBB on n_jobs threads of the shared pool (all if 0),
+// without the GIL.
+template<class Diagram, class Distance>
+py::array_t<double> diagram_distance_matrix(std::vector<Diagram> const& X, std::optional<std::vector<Diagram>> const& Y,
+                                            Distance distance, int n_jobs) {
+  const bool symmetric = !Y;
+  std::vector<Diagram> const& Z = symmetric ? X : *Y;
+  const std::size_t n = X.size(), m = Z.size();
+  py::array_t<double> ret({n, m});
+  double* out = ret.mutable_data();
+  {
+    py::gil_scoped_release release;
+    auto compute = [&](std::size_t i, std::size_t j){
+      if(!symmetric){
+        out[i * m + j] = distance(X[i], Z[j]);
+      } else if(i < j){
+        out[i * m + j] = out[j * m + i] = distance(X[i], Z[j]);
+      } else if(i == j){
+        out[i * m + j] = 0;
+      }
+    };
+#ifdef GUDHI_USE_TBB
+    auto run = [&]{
+      tbb::parallel_for(tbb::blocked_range2d<std::size_t>(0, n, 0, m), [&](tbb::blocked_range2d<std::size_t> const& r){
+        for(std::size_t i = r.rows().begin(); i < r.rows().end(); ++i)
+          for(std::size_t j = r.cols().begin(); j < r.cols().end(); ++j)
+            compute(i, j);
+      });
+    };
+    Gudhi::thread_pool::execute(n_jobs, run);
+#else
+    (void)n_jobs;
+    for(std::size_t i = 0; i < n; ++i)
+      for(std::size_t j = 0; j < m; ++j)
+        compute(i, j);
+#endif
+  }
+  return ret;
+}
@@ -322,3 +322,12 @@ def test_numpy_arrays():
                     [ 2.,  2.,  2.]])
     weights=np.array([4., 4., 4., 4., 1.])
     alpha = AlphaComplex(points=points, weights=weights)
+
+def test_points_buffer():
+    # float32 and float64 arrays, with any strides, are read in place and give the same complex as a list of lists
+    rng = np.random.default_rng(0)
+    points = rng.random((50, 3)).astype(np.float32)
+    expected = list(AlphaComplex(points=points.tolist()).create_simplex_tree().get_filtration())
+    for array in [points, np.asfortranarray(points), points.astype(np.float64), points.T.copy().T,
+                  np.repeat(points, 2, axis=1)[:, ::2]]:
+        assert list(AlphaComplex(points=array).create_simplex_tree().get_filtration()) == expected
@@ -0,0 +1,52 @@
+""" This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+    Author(s):       David Loiseaux
+
+    Copyright (C) 2023 Inria
+
+    Modification(s):
+      - YYYY/MM Author: Description of the modification
+"""
+
+import json
+
+from gudhi.benchmarks import main, measure, regressions, run_benchmarks
+
+
+def test_measure():
+    calls = []
+    assert measure(lambda: calls.append(0), 5, repeat=2) >= 0
+    assert len(calls) == 10
+
+
+def test_run_benchmarks():
+    results = run_benchmarks(sizes=[30], repeat=1)
+    names = {r["name"] for r in results}
+    for name in ["SimplexTree.insert", "SimplexTree.get_simplices", "SimplexTree.persistence_pairs"]:
+        assert name in names
+    for r in results:
+        assert r["size"] == 30
+        assert r["seconds"] >= 0 and r["seconds_per_item"] >= 0
+    get_simplices = next(r for r in results if r["name"] == "SimplexTree.get_simplices")
+    assert get_simplices["items"] >= 30
+
+
+def test_regressions():
+    baseline = [{"name": "a", "size": 10, "seconds_per_item": 1.0}, {"name": "b", "size": 10, "seconds_per_item": 1.0}]
+    results = [
+        {"name": "a", "size": 10, "seconds_per_item": 1.1},
+        {"name": "b", "size": 10, "seconds_per_item": 2.0},
+        {"name": "c", "size": 10, "seconds_per_item": 9.0},
+    ]
+    assert regressions(results, baseline, 1.2) == [("b", 10, 1.0, 2.0)]
+
+
+def test_main(tmp_path):
+    output = tmp_path / "results.json"
+    assert main(["--sizes", "20", "--repeat", "1", "--output", str(output)]) == 0
+    with open(output) as f:
+        results = json.load(f)
+    assert all(r["size"] == 20 for r in results)
+    # No regression compared to itself
+    args = ["--sizes", "20", "--repeat", "1", "--output", str(output), "--baseline", str(output), "--tolerance", "1e9"]
+    assert main(args) == 0
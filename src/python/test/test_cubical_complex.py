@@ -285,6 +285,15 @@ def test_cubical_persistence_intervals_in_dimension():
     assert np.array_equal(H0, np.array([[ 1., float("inf")]]))
     assert cub.persistence_intervals_in_dimension(1).shape == (0, 2)
 
+def test_cubical_persistence_intervals_by_dimension():
+    cub = CubicalComplex(top_dimensional_cells=np.random.default_rng(0).random((10, 12)))
+    cub.compute_persistence()
+    intervals = cub.persistence_intervals_by_dimension(dtype=np.float32)
+    assert len(intervals) == 2
+    for dim, array in enumerate(intervals):
+        assert array.dtype == np.float32
+        assert np.array_equal(array, cub.persistence_intervals_in_dimension(dim).astype(np.float32))
+
 def test_periodic_cubical_persistence_intervals_in_dimension():
     cub = PeriodicCubicalComplex(
         dimensions=[3, 3],
@@ -341,3 +350,42 @@ def test_array_access():
             ]
         ),
     )
+
+def test_3d_persistence_from_top_cells():
+    # persistence() uses a dedicated algorithm in 3d, compare it with compute_persistence()
+    rng = np.random.default_rng(42)
+    for cells in [rng.random((7, 5, 6)), rng.integers(0, 4, (6, 1, 8)).astype(float)]:
+        cub = CubicalComplex(top_dimensional_cells=cells)
+        diag = cub.persistence()
+        ref = CubicalComplex(top_dimensional_cells=cells)
+        ref.compute_persistence()
+        for dim in range(3):
+            intervals = sorted(pair for d, pair in diag if d == dim)
+            ref_intervals = sorted(tuple(pair) for pair in ref.persistence_intervals_in_dimension(dim))
+            assert intervals == ref_intervals
+        # The functions that need compute_persistence() still work after persistence()
+        assert cub.betti_numbers() == [1, 0, 0]
+        assert np.array_equal(cub.persistence_intervals_in_dimension(0), ref.persistence_intervals_in_dimension(0))
+
+
+def test_construction_from_small_dtypes():
+    data = np.array([[1, 2, 3], [4, 0, 5], [6, 7, 2]])
+    ref = CubicalComplex(top_dimensional_cells=data.astype(np.float64))
+    for dtype in (np.uint8, np.uint16, np.float32):
+        for cells in (data.astype(dtype), np.asfortranarray(data.astype(dtype))):
+            cplx = CubicalComplex(top_dimensional_cells=cells)
+            assert np.array_equal(cplx.all_cells(), ref.all_cells())
+            assert cplx.persistence() == ref.persistence()
+        cplx = CubicalComplex(vertices=data.astype(dtype))
+        assert np.array_equal(cplx.all_cells(), CubicalComplex(vertices=data.astype(np.float64)).all_cells())
+
+
+def test_persistence_max_intervals_per_dimension():
+    for shape in ((17, 13), (7, 6, 5)):
+        cplx = CubicalComplex(top_dimensional_cells=np.random.rand(*shape))
+        full = cplx.persistence()
+        for k in (0, 1, 3, 1000):
+            top = cplx.persistence(max_intervals_per_dimension=k)
+            for dim in range(len(shape)):
+                lengths = [d - b for (dm, (b, d)) in full if dm == dim][:k]
+                assert [d - b for (dm, (b, d)) in top if dm == dim] == lengths
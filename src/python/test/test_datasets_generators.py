@@ -37,3 +37,13 @@ def test_torus():
     assert points.ctorus(n_samples = 64, dim = 3, sample = 'random').all() == points.torus(n_samples = 64, dim = 3, sample = 'random').all()
     assert points.ctorus(n_samples = 64, dim = 3, sample = 'grid').all() == points.torus(n_samples = 64, dim = 3, sample = 'grid').all()
     assert points.ctorus(n_samples = 10, dim = 3, sample = 'grid').all() == points.torus(n_samples = 10, dim = 3, sample = 'grid').all()
+
+def test_seeded_generators():
+    import numpy as np
+    first = points.sphere(n_samples = 1000, ambient_dim = 3, radius = 2., seed = 5)
+    assert np.array_equal(first, points.sphere(n_samples = 1000, ambient_dim = 3, radius = 2., seed = 5))
+    assert not np.array_equal(first, points.sphere(n_samples = 1000, ambient_dim = 3, radius = 2., seed = 6))
+    np.testing.assert_allclose(np.linalg.norm(first, axis=1), 2.)
+    torus = points.ctorus(n_samples = 1000, dim = 2, seed = 5)
+    assert np.array_equal(torus, points.ctorus(n_samples = 1000, dim = 2, seed = 5))
+    np.testing.assert_allclose(np.linalg.norm(torus.reshape(-1, 2), axis=1), 1.)
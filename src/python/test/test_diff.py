@@ -15,6 +15,18 @@ def test_rips_diff():
     grads = tape.gradient(loss, [X])
     assert tf.norm(grads[0]-tf.constant([[-.5,-.5],[.5,.5]]),1) <= 1e-6
 
+def test_rips_reuse_complex():
+
+    rng = np.random.default_rng(0)
+    Xinit = rng.uniform(size=(20, 2)).astype(np.float32)
+    reuse = RipsLayer(maximum_edge_length=.5, homology_dimensions=[0, 1], reuse_complex=True)
+    fresh = RipsLayer(maximum_edge_length=.5, homology_dimensions=[0, 1])
+    for step in range(3):
+        X = tf.constant(Xinit + step * 1e-3)
+        for (f1, e1), (f2, e2) in zip(reuse.call(X), fresh.call(X)):
+            assert np.array_equal(f1.numpy(), f2.numpy())
+            assert np.array_equal(e1.numpy(), e2.numpy())
+
 def test_cubical_diff():
 
     Xinit = np.array([[0.,2.,2.],[2.,2.,2.],[2.,2.,1.]], dtype=np.float32)
@@ -39,6 +51,26 @@ def test_nonsquare_cubical_diff():
     grads = tape.gradient(loss, [X])
     assert tf.norm(grads[0]-tf.constant([[0.,0.5,-0.5],[0.,0.,0.]]),1) <= 1e-6
 
+def test_batched_cubical_diff():
+
+    Xinit = np.array([[[0.,2.,2.],[2.,2.,2.],[2.,2.,1.]], [[-1.,1.,0.],[1.,1.,1.],[1.,1.,1.]]], dtype=np.float32)
+    X = tf.Variable(initial_value=Xinit, trainable=True)
+    cl = CubicalLayer(homology_dimensions=[0, 1], batched=True)
+
+    with tf.GradientTape() as tape:
+        dgms = cl.call(X)
+        dgm = dgms[0][0]
+        loss = tf.math.reduce_sum(tf.square(.5*(dgm.values[:,1]-dgm.values[:,0])))
+    grads = tape.gradient(loss, [X])
+    assert tf.norm(grads[0]-tf.constant([[[0.,0.,0.],[0.,.5,0.],[0.,0.,-.5]], [[0.,0.5,-0.5],[0.,0.,0.],[0.,0.,0.]]]),1) <= 1e-6
+    # Each row is the diagram of one image
+    single = CubicalLayer(homology_dimensions=[0, 1])
+    for i in range(2):
+        expected = single.call(tf.constant(Xinit[i]))
+        for (finite, essential), (finite_i, essential_i) in zip(dgms, expected):
+            assert np.array_equal(np.sort(finite[i].numpy(), axis=0), np.sort(finite_i.numpy(), axis=0))
+            assert np.array_equal(essential[i].numpy(), essential_i.numpy())
+
 def test_st_diff():
 
     st = gd.SimplexTree()
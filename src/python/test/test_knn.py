@@ -151,3 +151,30 @@ def test_knn_k_limits():
             KNearestNeighbors(
                 k=nb_sample + 1, return_index=False, return_distance=True, sort_results=False, implementation=impl
             ).fit_transform(data)
+
+
+def test_knn_gudhi():
+    pytest.importorskip("gudhi.point_cloud._knn")
+    base = np.random.rand(500, 3)
+    query = np.random.rand(100, 3)
+    for n_jobs in [1, -1]:
+        r0 = (
+            KNearestNeighbors(5, implementation="ckdtree", return_index=True, return_distance=True)
+            .fit(base)
+            .transform(query)
+        )
+        r1 = (
+            KNearestNeighbors(5, implementation="gudhi", return_index=True, return_distance=True, n_jobs=n_jobs)
+            .fit(base)
+            .transform(query)
+        )
+        assert np.array_equal(r0[0], r1[0])
+        assert r1[1] == pytest.approx(r0[1])
+    # float32 inputs give float32 distances
+    r2 = (
+        KNearestNeighbors(5, implementation="gudhi", return_index=False, return_distance=True)
+        .fit(base.astype(np.float32))
+        .transform(query.astype(np.float32))
+    )
+    assert r2.dtype == np.float32
+    assert r2 == pytest.approx(r0[1], rel=1e-4)
@@ -0,0 +1,144 @@
+""" This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+    Author(s):       David Loiseaux
+
+    Copyright (C) 2023 Inria
+
+    Modification(s):
+      - YYYY/MM Author: Description of the modification
+"""
+
+import threading
+from concurrent.futures import CancelledError
+
+import numpy as np
+import pytest
+
+from gudhi import SimplexTree
+from gudhi.simplex_tree import persistence_batch, _CancellationFlag, _exchange_cancellation_flag
+from gudhi.parallel import get_num_threads, set_num_threads, _map, _native_n_jobs, _submit_cancellable
+from gudhi._pers_cub_low_dim import _persistence_on_rectangles_from_top_cells
+
+
+@pytest.fixture
+def two_threads():
+    set_num_threads(2)
+    yield
+    set_num_threads(None)
+
+
+def test_num_threads(two_threads):
+    assert get_num_threads() == 2
+    assert _native_n_jobs(None) == 1
+    assert _native_n_jobs(1) == 1
+    assert _native_n_jobs(8) == 2
+    assert _native_n_jobs(-1) == 2
+    assert _native_n_jobs(-2) == 1
+    with pytest.raises(ValueError):
+        set_num_threads(0)
+
+
+def test_default_num_threads():
+    set_num_threads(None)
+    assert get_num_threads() >= 1
+    assert _native_n_jobs(-1) == get_num_threads()
+
+
+def test_map_keeps_the_order(two_threads):
+    items = list(range(100))
+    assert _map(lambda x: x * x, items, -1) == [x * x for x in items]
+    assert _map(lambda x: x * x, items, None) == [x * x for x in items]
+    assert _map(lambda x: x, [], -1) == []
+
+
+def test_map_nested_calls(two_threads):
+    # The tasks of the pool that use it again do not wait for each other
+    assert _map(lambda x: sum(_map(lambda y: y, range(x), -1)), range(10), -1) == [x * (x - 1) // 2 for x in range(10)]
+
+
+def test_map_raises(two_threads):
+    def f(x):
+        if x == 7:
+            raise RuntimeError("seven")
+        return x
+
+    with pytest.raises(RuntimeError):
+        _map(f, range(20), -1)
+
+
+def _random_trees(n):
+    rng = np.random.default_rng(0)
+    trees = []
+    for _ in range(n):
+        st = SimplexTree()
+        for u, v in rng.integers(0, 20, (60, 2)):
+            if u != v:
+                st.insert([int(u), int(v)], filtration=rng.random())
+        st.expansion(2)
+        st.make_filtration_non_decreasing()
+        trees.append(st)
+    return trees
+
+
+def test_persistence_batch_with_one_thread():
+    expected = persistence_batch(_random_trees(8))
+    set_num_threads(1)
+    try:
+        got = persistence_batch(_random_trees(8))
+    finally:
+        set_num_threads(None)
+    for a, b in zip(expected, got):
+        np.testing.assert_array_equal(a, b)
+
+
+def test_images_on_the_pool(two_threads):
+    images = np.random.default_rng(1).random((10, 8, 9))
+    expected = _persistence_on_rectangles_from_top_cells(images, 0.0, 1)
+    for n_jobs in [0, 2, 8]:
+        got = _persistence_on_rectangles_from_top_cells(images, 0.0, n_jobs)
+        for a, b in zip(expected, got):
+            for da, db in zip(a, b):
+                np.testing.assert_array_equal(np.array(da), np.array(db))
+
+
+def test_persistence_async(two_threads):
+    trees = _random_trees(2)
+    expected = trees[0].persistence()
+    assert trees[1].persistence_async().result() == expected
+    assert trees[1].persistence_intervals_in_dimension(1).shape == trees[0].persistence_intervals_in_dimension(1).shape
+
+
+def test_cancel_running_expansion(two_threads):
+    st = SimplexTree()
+    for u in range(40):
+        for v in range(u):
+            st.insert([u, v])
+    num_simplices = st.num_simplices()
+    # The full expansion has 2^40 simplices
+    future = st.expansion_async(40)
+    while not future.running() and not future.done():
+        pass
+    assert not future.cancel()
+    with pytest.raises(CancelledError):
+        future.result(timeout=60)
+    # The expansion is rolled back
+    assert st.dimension() == 1
+    assert st.num_simplices() == num_simplices
+
+
+def test_cancel_pending_persistence():
+    set_num_threads(1)
+    try:
+        release = threading.Event()
+        blocker = _submit_cancellable(release.wait, _CancellationFlag(), _exchange_cancellation_flag)
+        st = _random_trees(1)[0]
+        future = st.persistence_async()
+        assert future.cancel()
+        release.set()
+        assert blocker.result() is True
+        with pytest.raises(CancelledError):
+            future.result()
+        # The tree is untouched
+        assert len(st.persistence()) > 0
+    finally:
+        set_num_threads(None)
@@ -124,3 +124,42 @@ def _non_existing_persistence_file(function):
 def test_non_existing_persistence_file():
     for function in [gd.plot_persistence_barcode, gd.plot_persistence_diagram, gd.plot_persistence_density]:
         _non_existing_persistence_file(function)
+
+
+def test_limit_to_max_intervals_array():
+    diags = np.array([[0.0, 1.0], [0.0, 3.0], [1.0, 2.0], [0.0, 3.0], [2.0, 2.5]])
+    with pytest.warns(UserWarning):
+        truncated_diags = gd.persistence_graphical_tools._limit_to_max_intervals(
+            diags, 3, key=lambda life_time: life_time[1] - life_time[0]
+        )
+    # ties on the life time keep the input order, as with a stable sort
+    np.testing.assert_array_equal(truncated_diags, diags[[1, 3, 0]])
+
+
+def test_plot_persistence_diagram_binned():
+    rng = np.random.default_rng(0)
+    births = rng.uniform(size=1000)
+    diags = [(i % 2, (b, b + d)) for i, (b, d) in enumerate(zip(births, rng.uniform(size=1000)))]
+    diags.append((0, (0.0, float("inf"))))
+    pplot = gd.plot_persistence_diagram(diags, max_scatter_points=100)
+    # one image per dimension instead of a scatter
+    assert len(pplot.images) == 2
+    assert len(pplot.collections) == 0
+    pplot = gd.plot_persistence_diagram(diags, max_scatter_points=0)
+    assert len(pplot.images) == 0
+
+
+def test_binned_kde():
+    from scipy.stats import gaussian_kde
+
+    rng = np.random.default_rng(0)
+    births = rng.normal(size=5000)
+    deaths = births + rng.exponential(size=5000)
+    k = gaussian_kde([births, deaths])
+    x_grid = np.linspace(births.min(), births.max(), 100)
+    y_grid = np.linspace(deaths.min(), deaths.max(), 100)
+    xi, yi = np.meshgrid(x_grid, y_grid, indexing="ij")
+    exact = k(np.vstack([xi.ravel(), yi.ravel()])).reshape(xi.shape)
+    binned = gd.persistence_graphical_tools._binned_kde(births, deaths, k.covariance, x_grid, y_grid)
+    assert binned.shape == exact.shape
+    assert np.abs(binned - exact).max() < 0.05 * exact.max()
@@ -53,6 +53,19 @@ def test_gaussian_perslay():
 
 test_gaussian_perslay()
 
+def test_gaussian_perslay_weighted_sum():
+
+    diagrams = tf.ragged.constant([[[0.,.4],[.1,.2],[.3,.8]], [[.6,.8]], []], ragged_rank=1, inner_shape=(2,))
+    phi = GaussianPerslayPhi((6, 4), ((-.5, 1.5), (-.5, 1.5)), .2)
+    weight = PowerPerslayWeight(2.,1.)
+    for perm_op in [tf.math.reduce_sum, tf.math.reduce_mean]:
+        fused = Perslay(phi=phi, weight=weight, perm_op=perm_op, rho=tf.identity)(diagrams)
+        # A lambda is not recognized, so the images of the points are computed
+        unfused = Perslay(phi=phi, weight=weight, perm_op=lambda x, axis: perm_op(x, axis=axis), rho=tf.identity)(diagrams)
+        assert fused.shape == unfused.shape
+        assert np.allclose(fused.numpy()[:2], unfused.numpy()[:2], atol=1e-6)
+    assert np.all(Perslay(phi=phi, weight=weight, perm_op=tf.math.reduce_sum, rho=tf.identity)(diagrams).numpy()[2] == 0)
+
 def test_tent_perslay():
 
     diagrams = [np.array([[0.,4.],[1.,2.],[3.,8.],[6.,8.]])]
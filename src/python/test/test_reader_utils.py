@@ -125,3 +125,29 @@ def test_read_persistence_intervals_with_dimension():
         1: [(9.6, 14.0), (3.0, float("Inf"))],
         3: [(34.2, 34.974)],
     }
+
+
+def test_read_persistence_intervals_from_binary_file():
+    # Dimension 0 in 2 blocks, and float32 values whose block is padded
+    def block(dim, intervals, dtype):
+        values = np.array(intervals, dtype=dtype).tobytes()
+        return np.array([dim], dtype="<i8").tobytes() + np.array([len(intervals)], dtype="<u8").tobytes() + \
+            values + bytes((-len(values)) % 8)
+    for dtype, value_size in [(np.float32, 4), (np.float64, 8)]:
+        with open("persistence_intervals_binary.pers", "wb") as test_file:
+            test_file.write(b"GUDHIDGM" + np.array([1, value_size], dtype="<u4").tobytes())
+            test_file.write(block(0, [(0.0, float("inf"))], dtype))
+            test_file.write(block(1, [(9.5, 14.0), (3.0, float("inf"))], dtype))
+            test_file.write(block(0, [(2.5, 3.75)], dtype))
+        for mmap in [True, False]:
+            persistence = gd.read_persistence_intervals_from_binary_file("persistence_intervals_binary.pers", mmap=mmap)
+            assert persistence.keys() == {0, 1}
+            assert persistence[1].dtype == dtype
+            np.testing.assert_array_equal(persistence[0], [(0.0, float("inf")), (2.5, 3.75)])
+            np.testing.assert_array_equal(persistence[1], [(9.5, 14.0), (3.0, float("inf"))])
+        # The text readers detect the binary format
+        assert gd.read_persistence_intervals_grouped_by_dimension(
+            persistence_file="persistence_intervals_binary.pers"
+        ) == {0: [(0.0, float("inf")), (2.5, 3.75)], 1: [(9.5, 14.0), (3.0, float("inf"))]}
+    with raises(ValueError):
+        gd.read_persistence_intervals_from_binary_file("persistence_intervals_with_dimension.pers")
@@ -73,6 +73,25 @@ def test_distance_transform_consistency():
         assert d4 == pytest.approx(d2, **tolerance)
 
 
+def test_distance_matrix_engine():
+    from gudhi.hera import wasserstein_distance
+    l1 = _n_diags(6) + [np.empty((0, 2)), np.array([[0.0, np.inf]])]
+    l2 = _n_diags(3) + [np.array([[1.0, np.inf]])]
+    d = pairwise_persistence_diagram_distances(l1, metric="wasserstein", order=2, n_jobs=-1)
+    expected = [[wasserstein_distance(a, b, order=2) for b in l1] for a in l1]
+    assert d == pytest.approx(np.array(expected))
+    d = pairwise_persistence_diagram_distances(l1, l2, metric="hera_wasserstein", n_jobs=2)
+    expected = [[wasserstein_distance(a, b) for b in l2] for a in l1]
+    assert d == pytest.approx(np.array(expected))
+    try:
+        from gudhi import bottleneck_distance
+    except ImportError:
+        return
+    d = pairwise_persistence_diagram_distances(l1, l2, metric="bottleneck", e=0, n_jobs=2)
+    expected = [[bottleneck_distance(a, b, e=0) for b in l2] for a in l1]
+    assert np.array_equal(d, expected)
+
+
 kernel_dict = {
     "sliced_wasserstein": (SlicedWassersteinKernel(num_directions=10, bandwidth=4., n_jobs=4),
                            dict(num_directions=10), dict(rel=1e-3)),
@@ -303,6 +322,74 @@ def test_landscape_nan_range():
     assert lds.sample_range_fixed_[0] == 2 and lds.sample_range_fixed_[1] == 6
     assert lds.new_resolution_ == 10
 
+def test_batched_vectorizations():
+    # Same values as the former numpy implementations, diagram by diagram, whatever the number of threads
+    rng = np.random.default_rng(0)
+    diags = []
+    for n in [0, 1, 3, 40]:
+        b = rng.uniform(0, 5, n)
+        diags.append(np.stack([b, b + rng.uniform(0, 3, n)], axis=1))
+    weight = lambda pt: pt[1] - pt[0]
+
+    lds = Landscape(num_landscapes=3, resolution=25).fit(diags)
+    slt = Silhouette(weight=weight, resolution=25).fit(diags)
+    x = lds.grid_
+    for n_jobs in [None, 2, -1]:
+        lds.set_params(n_jobs=n_jobs)
+        slt.set_params(n_jobs=n_jobs)
+        landscapes, silhouettes = lds.transform(diags), slt.transform(diags)
+        for i, diag in enumerate(diags):
+            tents = np.maximum((diag[:, 1] - diag[:, 0])[None, :] / 2 - np.abs(x[:, None] - (diag[:, 0] + diag[:, 1])[None, :] / 2), 0)
+            tents = np.concatenate([tents, np.zeros((len(x), 3))], axis=1)
+            expected = np.sqrt(2) * np.ravel(-np.sort(-tents, axis=1)[:, :3].T)
+            assert np.allclose(landscapes[i], expected)
+            if len(diag) > 0:
+                w = diag[:, 1] - diag[:, 0]
+                expected = np.sqrt(2) * np.sum(w[None, :] / np.sum(w) * tents[:, :len(diag)], axis=1)
+                assert np.allclose(silhouettes[i], expected)
+            else:
+                assert np.all(silhouettes[i] == 0)
+
+    pim = PersistenceImage(bandwidth=.5, weight=lambda pt: pt[1], resolution=[7, 5]).fit(diags)
+    xs = np.linspace(pim.im_range_fixed_[0], pim.im_range_fixed_[1], 7)
+    ys = np.linspace(pim.im_range_fixed_[2], pim.im_range_fixed_[3], 5)
+    for n_jobs in [None, 2]:
+        pim.set_params(n_jobs=n_jobs)
+        images = pim.transform(diags)
+        assert images.shape == (len(diags), 35)
+        for i, diag in enumerate(diags):
+            bp = BirthPersistenceTransform().fit_transform([diag])[0]
+            g = np.exp(-(np.square(bp[:, 0][:, None, None] - xs[None, None, :]) + np.square(bp[:, 1][:, None, None] - ys[None, :, None])) / (2 * .25)) / (2 * np.pi * .25)
+            expected = np.tensordot(bp[:, 1], g, 1).ravel()
+            assert np.allclose(images[i], expected)
+
+def test_binned_persistence_image():
+    rng = np.random.default_rng(1)
+    b = rng.uniform(0, 1, 300)
+    diags = [np.stack([b, b + rng.uniform(0, 1, 300)], axis=1), np.empty((0, 2))]
+    exact = PersistenceImage(bandwidth=.1, resolution=[200, 200], im_range=[0, 1, 0, 1]).fit_transform(diags)
+    binned = PersistenceImage(bandwidth=.1, resolution=[200, 200], im_range=[0, 1, 0, 1], binned=True, n_jobs=2).fit_transform(diags)
+    assert binned.shape == exact.shape
+    # Moving the points by at most half a pixel only changes the image a little
+    assert np.abs(binned - exact).max() < .05 * exact.max()
+    assert np.all(binned[1] == 0)
+
+def test_random_fourier_features_kernels():
+    rng = np.random.default_rng(2)
+    diags = []
+    for n in [20, 30, 0, 25]:
+        b = rng.uniform(0, 1, n)
+        diags.append(np.stack([b, b + rng.uniform(0, 1, n)], axis=1))
+    for exact, approx in [(PersistenceWeightedGaussianKernel(bandwidth=.5), PersistenceWeightedGaussianKernel(bandwidth=.5, num_random_features=50000, random_state=0)),
+                          (PersistenceScaleSpaceKernel(bandwidth=.5), PersistenceScaleSpaceKernel(bandwidth=.5, num_random_features=50000, random_state=0))]:
+        K = exact.fit(diags).transform(diags)
+        Ka = approx.fit(diags).transform(diags)
+        assert Ka.shape == K.shape
+        assert np.abs(Ka - K).max() < .05 * np.abs(K).max()
+        assert approx.random_features(diags).shape == (4, 50000)
+        assert approx(diags[0], diags[1]) == pytest.approx(Ka[0, 1])
+        assert np.all(Ka[2] == 0)
+
 def test_endpoints():
     diags = [ np.array([[2., 3.]]) ]
     for vec in [ Landscape(), Silhouette(), BettiCurve(), Entropy(mode="vector") ]:
@@ -318,3 +405,59 @@ def test_endpoints():
 def test_get_params():
     for vec in [ Landscape(), Silhouette(), BettiCurve(), Entropy(mode="vector") ]:
         vec.get_params()
+
+
+def test_topological_vector_largest_distances():
+    from scipy.spatial.distance import cdist
+    rng = np.random.default_rng(3)
+    births = rng.uniform(size=300)
+    diag = np.column_stack((births, births + rng.exponential(size=300)))
+    # Points far from the diagonal but close to each other, and duplicates
+    diag = np.concatenate((diag, [[0., 5. + 0.01 * i] for i in range(10)], [[0.5, 1.], [0.5, 1.]]))
+    # The full sorted matrix of the definition
+    pers = 0.5 * (diag[:,1] - diag[:,0])
+    full = np.flip(np.sort(np.triu(np.minimum(cdist(diag, diag, "chebyshev"), pers)), axis=None), 0)
+    for threshold in [1, 10, 1000, len(full) + 5]:
+        tpv = TopologicalVector(threshold=threshold)(diag)
+        dim = min(len(full), threshold)
+        np.testing.assert_array_equal(tpv[:dim], full[:dim])
+        assert not np.any(tpv[dim:])
+
+
+def test_batched_atol_and_betti_curves():
+    # Same values as the numpy contrasts and as counting the intervals, whatever the number of threads
+    rng = np.random.default_rng(1)
+    diags = []
+    for n in [0, 1, 5, 60]:
+        b = rng.uniform(0, 5, n)
+        diags.append(np.stack([b, b + rng.uniform(0, 3, n)], axis=1))
+    diags[2][0, 1] = np.inf
+    finite = [d[np.isfinite(d).all(axis=1)] for d in diags]
+
+    for contrast in ["gaussian", "laplacian", "indicator"]:
+        for weighting_method in ["cloud", "iidproba"]:
+            atol = Atol(KMeans(n_clusters=3, random_state=0, n_init=10), weighting_method=weighting_method,
+                        contrast=contrast).fit(finite)
+            for n_jobs in [None, 2]:
+                atol.set_params(n_jobs=n_jobs)
+                vectors = atol.transform(diags)
+                assert vectors.shape == (len(diags), 3)
+                for i, diag in enumerate(diags):
+                    weights = atol.get_weighting_method()(diag)
+                    expected = np.sum(weights * atol.get_contrast()(diag, atol.centers, atol.inertias.T).T, axis=1)
+                    assert np.allclose(vectors[i], expected)
+                    assert np.allclose(atol(diag), expected)
+
+    grid = np.array([-np.inf, 0., 1., 2.5, 4., 6., np.inf])
+    bc = BettiCurve(predefined_grid=grid)
+    exact = BettiCurve(resolution=None)
+    for n_jobs in [None, 2]:
+        bc.set_params(n_jobs=n_jobs)
+        curves = bc.fit_transform(diags)
+        for i, diag in enumerate(diags):
+            expected = [np.sum((diag[:, 0] <= x) & ~(diag[:, 1] <= x)) for x in grid]
+            np.testing.assert_array_equal(curves[i], expected)
+        curves = exact.fit_transform(diags)
+        for i, diag in enumerate(diags):
+            expected = [np.sum((diag[:, 0] <= x) & ~(diag[:, 1] <= x)) for x in exact.grid_]
+            np.testing.assert_array_equal(curves[i], expected)
@@ -8,8 +8,10 @@
       - YYYY/MM Author: Description of the modification
 """
 
-from gudhi import RipsComplex
+from gudhi import RipsComplex, SlidingWindowRipsPersistence, rips_persistence
 from math import sqrt
+import numpy as np
+import pytest
 
 __author__ = "Vincent Rouvreau"
 __copyright__ = "Copyright (C) 2016 Inria"
@@ -135,6 +137,27 @@ def test_filtered_rips_from_distance_matrix():
     assert simplex_tree.num_vertices() == 4
 
 
+def test_filtered_rips_from_sparse_distance_matrix():
+    coo_matrix = pytest.importorskip("scipy.sparse").coo_matrix
+
+    # Same distances as the lower triangular matrix above, each pair stored once, absent entries are not edges
+    row = [1, 0, 3, 2, 3]
+    col = [0, 2, 0, 3, 1]
+    data = [1.0, 1.0, sqrt(2), 1.0, 1.0]
+    distance_matrix = coo_matrix((data, (row, col)), shape=(4, 4))
+    filtered_rips = RipsComplex(distance_matrix=distance_matrix, max_edge_length=1.0)
+
+    simplex_tree = filtered_rips.create_simplex_tree(max_dimension=1)
+
+    assert simplex_tree.num_simplices() == 8
+    assert simplex_tree.num_vertices() == 4
+
+    # Without the edge [0, 3], there is no triangle even with an infinite threshold
+    distance_matrix = coo_matrix((data[:2] + data[3:], (row[:2] + row[3:], col[:2] + col[3:])), shape=(4, 4))
+    simplex_tree = RipsComplex(distance_matrix=distance_matrix).create_simplex_tree(max_dimension=2)
+    assert simplex_tree.num_simplices() == 8
+
+
 def test_sparse_with_multiplicity():
     points = [
         [3, 4],
@@ -154,3 +177,63 @@ def test_sparse_with_multiplicity():
     simplex_tree = rips.create_simplex_tree(max_dimension=2)
     assert simplex_tree.num_simplices() == 7
     diag = simplex_tree.persistence()
+
+
+def test_rips_persistence():
+    rng = np.random.default_rng(42)
+    points = rng.random((40, 3))
+    distances = [[np.linalg.norm(p - q) for q in points[:i]] for i, p in enumerate(points)]
+
+    def check(persistence, expected):
+        assert len(persistence) == len(expected)
+        for (dim, (birth, death)), (expected_dim, (expected_birth, expected_death)) in zip(persistence, expected):
+            assert dim == expected_dim
+            assert birth == pytest.approx(expected_birth)
+            assert death == pytest.approx(expected_death)
+
+    for max_dimension in [1, 2, 3]:
+        stree = RipsComplex(points=points, max_edge_length=0.6).create_simplex_tree(max_dimension=max_dimension)
+        expected = sorted(stree.persistence(homology_coeff_field=2))
+        check(sorted(rips_persistence(points=points, max_edge_length=0.6, max_dimension=max_dimension,
+                                      homology_coeff_field=2)), expected)
+        check(sorted(rips_persistence(distance_matrix=distances, max_edge_length=0.6, max_dimension=max_dimension,
+                                      homology_coeff_field=2)), expected)
+    assert rips_persistence() == []
+
+
+def test_rips_from_points_buffer():
+    # float32 and float64 arrays, with any strides, are read in place and give the same complex as a list of lists
+    rng = np.random.default_rng(0)
+    points = rng.random((60, 3)).astype(np.float32)
+    expected = list(RipsComplex(points=points.tolist(), max_edge_length=0.4).create_simplex_tree(2).get_filtration())
+    expected_persistence = rips_persistence(points=points.tolist(), max_edge_length=0.4, max_dimension=2)
+    for array in [points, np.asfortranarray(points), points.astype(np.float64), np.repeat(points, 2, axis=1)[:, ::2]]:
+        stree = RipsComplex(points=array, max_edge_length=0.4).create_simplex_tree(2)
+        assert list(stree.get_filtration()) == expected
+        assert rips_persistence(points=array, max_edge_length=0.4, max_dimension=2) == expected_persistence
+        stree = RipsComplex(points=array, max_edge_length=0.4, sparse=0.5).create_simplex_tree(2)
+        assert stree.num_vertices() == len(points)
+    # Broadcast arrays have a zero stride
+    stree = RipsComplex(points=np.broadcast_to(np.float32(1), (4, 3)), max_edge_length=0.1).create_simplex_tree(1)
+    assert stree.num_simplices() == 10
+
+
+def test_sliding_window_rips_persistence():
+    t = np.arange(60) * 0.4
+    points = np.stack([np.cos(t), np.sin(t)], axis=1) + np.random.default_rng(0).normal(scale=0.05, size=(60, 2))
+    window = SlidingWindowRipsPersistence(max_edge_length=0.8, max_dimension=2)
+    assert len(window) == 0
+    for i, point in enumerate(points):
+        window.append(point)
+        if len(window) > 15:
+            window.popleft()
+        start = i + 1 - len(window)
+        assert len(window) == min(i + 1, 15)
+        stree = RipsComplex(points=points[start : i + 1], max_edge_length=0.8).create_simplex_tree(max_dimension=2)
+        assert window.num_simplices() == stree.num_simplices()
+        assert sorted(window.persistence()) == sorted(stree.persistence())
+    while len(window) > 0:
+        window.popleft()
+    assert window.num_simplices() == 0
+    with pytest.raises(IndexError):
+        window.popleft()
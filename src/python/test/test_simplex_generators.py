@@ -53,6 +53,33 @@ def test_lower_star_generators():
     assert np.array_equal(g[1][1], [1])
 
 
+def test_lower_star_generators_after_update():
+    st = gudhi.SimplexTree()
+    st.insert([0, 1, 2], -10)
+    st.insert([0, 3], -10)
+    st.insert([1, 3], -10)
+    st.assign_lower_star_filtration(np.array([1., 2., -1., 0.]))
+    assert st.filtration([0, 1, 2]) == 2
+    assert st.filtration([0, 3]) == 1
+    st.persistence(min_persistence=-1)
+    g = st.lower_star_persistence_generators()
+    assert np.array_equal(g[0][0], [[0, 0], [3, 0], [1, 1]])
+    assert np.array_equal(g[1][0], [2])
+    # The order of the previous computation is repaired, the result is the same as from scratch
+    values = np.array([1., -2., -1., 0.5])
+    st.assign_lower_star_filtration(values)
+    st.persistence(min_persistence=-1)
+    st2 = gudhi.SimplexTree()
+    st2.insert([0, 1, 2])
+    st2.insert([0, 3])
+    st2.insert([1, 3])
+    st2.assign_lower_star_filtration(values)
+    st2.persistence(min_persistence=-1)
+    g, g2 = st.lower_star_persistence_generators(), st2.lower_star_persistence_generators()
+    assert all(np.array_equal(a, b) for a, b in zip(g[0] + g[1], g2[0] + g2[1]))
+    assert list(st.get_filtration()) == list(st2.get_filtration())
+
+
 def test_empty():
     st = gudhi.SimplexTree()
     st.persistence()
@@ -62,3 +89,16 @@ def test_empty():
     assert g[1] == []
     assert np.array_equal(g[2], [])
     assert g[3] == []
+
+
+def test_generators_dtype():
+    # The generators are written by the C++ code in preallocated contiguous arrays of int
+    pts = np.array([[0, 0], [0, 1.01], [1, 0], [1.02, 1.03]])
+    st = gudhi.RipsComplex(points=pts, max_edge_length=4).create_simplex_tree(max_dimension=2)
+    st.persistence()
+    g = st.flag_persistence_generators()
+    for a in [g[0], *g[1], g[2], *g[3]]:
+        assert a.dtype == np.intc and a.flags["C_CONTIGUOUS"]
+    g = st.lower_star_persistence_generators()
+    for a in [*g[0], *g[1]]:
+        assert a.dtype == np.intc and a.flags["C_CONTIGUOUS"]
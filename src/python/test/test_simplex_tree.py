@@ -8,7 +8,7 @@
       - YYYY/MM Author: Description of the modification
 """
 
-from gudhi import SimplexTree
+from gudhi import SimplexTree, persistence_batch
 import numpy as np
 import pytest
 
@@ -377,6 +377,21 @@ def test_collapse_edges():
         assert simplex[1] == 1.0
 
 
+def test_assign_flag_filtration():
+    st = SimplexTree()
+    st.insert([0, 1, 2])
+    st.insert([2, 3])
+    dist = np.array([[0., 1., 3., 5.], [1., 0., 2., 4.], [3., 2., 0., .5], [5., 4., .5, 0.]])
+    st.assign_flag_filtration(dist)
+    assert st.filtration([0]) == 0
+    assert st.filtration([1, 2]) == 2
+    assert st.filtration([0, 1, 2]) == 3
+    assert st.filtration([2, 3]) == .5
+    assert [f for _, f in st.get_filtration()] == [0, 0, 0, 0, .5, 1, 2, 3, 3]
+    with pytest.raises(ValueError):
+        st.assign_flag_filtration(dist[:3, :3])
+
+
 def test_reset_filtration():
     st = SimplexTree()
 
@@ -463,6 +478,31 @@ def test_persistence_intervals_in_dimension():
     assert st.persistence_intervals_in_dimension(3).shape == (0, 2)
 
 
+
+def test_persistence_intervals_by_dimension():
+    rng = np.random.default_rng(0)
+    st = SimplexTree()
+    for u, v in rng.integers(0, 30, (200, 2)):
+        if u != v:
+            st.insert([u, v], rng.random())
+    st.expansion(3)
+    st.make_filtration_non_decreasing()
+    st.compute_persistence()
+    intervals = st.persistence_intervals_by_dimension()
+    assert len(intervals) == 1 + max(dim for dim, _ in st.persistence())
+    for dim, array in enumerate(intervals):
+        assert array.dtype == np.float64
+        assert np.array_equal(array, st.persistence_intervals_in_dimension(dim))
+    for dim, array in enumerate(st.persistence_intervals_by_dimension(dtype=np.float32)):
+        assert array.dtype == np.float32
+        assert np.array_equal(array, intervals[dim].astype(np.float32))
+    with pytest.raises(ValueError):
+        st.persistence_intervals_by_dimension(dtype=np.int32)
+    # An empty complex has no interval
+    st = SimplexTree()
+    st.compute_persistence()
+    assert st.persistence_intervals_by_dimension() == []
+
 def test_equality_operator():
     st1 = SimplexTree()
     st2 = SimplexTree()
@@ -701,3 +741,230 @@ def test_prune_above_dimension():
     assert st.num_simplices() == 0
 
     assert st.prune_above_dimension(-200) == False
+
+
+def test_persistence_matrix_reduction():
+    rng = np.random.default_rng(0)
+    points = rng.random((30, 2))
+    st = SimplexTree()
+    for i in range(len(points)):
+        st.insert([i], 0.0)
+        for j in range(i):
+            d = np.linalg.norm(points[i] - points[j])
+            if d < 0.4:
+                st.insert([j, i], d)
+    st.expansion(3)
+    for coeff in [2, 11]:
+        for dim_max in [False, True]:
+            cohomology = st.persistence(homology_coeff_field=coeff, persistence_dim_max=dim_max)
+            betti = st.betti_numbers()
+            reduction = st.persistence(
+                homology_coeff_field=coeff, persistence_dim_max=dim_max, algorithm="matrix_reduction"
+            )
+            assert sorted(cohomology) == sorted(reduction)
+            assert st.betti_numbers() == betti
+    with pytest.raises(ValueError):
+        st.persistence(algorithm="unknown")
+
+
+def test_persistence_recomputed_after_modification():
+    st = SimplexTree()
+    for i in range(5):
+        st.insert([i, (i + 1) % 5], i)
+    assert st.persistence(persistence_dim_max=True) == [(1, (4.0, float("inf"))), (0, (0.0, float("inf")))]
+    # The same persistence object is reused for the new computation
+    st.insert([0, 1, 2], 5)
+    st.insert([0, 2, 3], 6)
+    st.insert([0, 3, 4], 7)
+    assert st.persistence() == [(1, (4.0, 7.0)), (0, (0.0, float("inf")))]
+    assert st.betti_numbers() == [1, 0]
+
+
+def test_persistence_truncated():
+    st = SimplexTree()
+    for i in range(5):
+        st.insert([i, (i + 1) % 5], i)
+    st.insert([0, 1, 2], 5)
+    st.insert([0, 2, 3], 6)
+    st.insert([0, 3, 4], 7)
+    assert st.persistence() == [(1, (4.0, 7.0)), (0, (0.0, float("inf")))]
+    assert st.persistence(max_filtration=6.5) == [(1, (4.0, float("inf"))), (0, (0.0, float("inf")))]
+    assert st.persistence(max_dimension=0) == [(0, (0.0, float("inf")))]
+    assert st.persistence(max_filtration=2.5) == [(0, (0.0, float("inf")))]
+    # The filtration of the complex is not truncated
+    assert len(list(st.get_filtration())) == 15
+    with pytest.raises(ValueError):
+        st.persistence(algorithm="matrix_reduction", max_filtration=6.5)
+
+
+def test_persistence_batch():
+    trees = []
+    for n in range(3, 8):
+        st = SimplexTree()
+        for i in range(n):
+            st.insert([i, (i + 1) % n], i)
+        trees.append(st)
+    trees[0].insert([0, 1, 2], 10)
+    offsets, dimensions, intervals = persistence_batch(trees, persistence_dim_max=True)
+    assert len(offsets) == len(trees) + 1
+    for i, st in enumerate(trees):
+        diagram = [(d, tuple(bd)) for d, bd in zip(dimensions[offsets[i]:offsets[i+1]], intervals[offsets[i]:offsets[i+1]])]
+        # Same as the persistence computed again on each tree, which is available after the batch
+        betti = st.betti_numbers()
+        assert diagram == st.persistence(persistence_dim_max=True)
+        assert betti == st.betti_numbers()
+    assert trees[0].betti_numbers() == [1, 0, 0]
+    with pytest.raises(ValueError):
+        persistence_batch([trees[0], trees[0]])
+
+
+def test_boundary_matrix():
+    st = SimplexTree()
+    st.insert([0, 1, 2], 2.0)
+    st.insert([0, 1], 1.0)
+    st.insert([2, 3], 3.0)
+    indptr, indices, dimensions, filtrations = st.boundary_matrix()
+    filtration = list(st.get_filtration())
+    n = len(filtration)
+    assert indptr.shape == (n + 1,)
+    assert indptr[0] == 0 and indptr[-1] == len(indices)
+    position = {tuple(simplex): i for i, (simplex, _) in enumerate(filtration)}
+    for i, (simplex, value) in enumerate(filtration):
+        assert dimensions[i] == len(simplex) - 1
+        assert filtrations[i] == value
+        expected = sorted(position[tuple(face)] for face, _ in st.get_boundaries(simplex)) if len(simplex) > 1 else []
+        assert list(indices[indptr[i]:indptr[i + 1]]) == expected
+
+
+def test_filtration_values():
+    st = SimplexTree()
+    st.insert([0, 1, 2], 2.0)
+    st.insert([0, 1], 1.0)
+    st.insert([2, 3], 3.0)
+    values = st.filtration_values()
+    assert list(values) == [value for _, value in st.get_filtration()]
+    # Move the edge [2, 3] and its vertex 3 before everything else
+    simplices = [simplex for simplex, _ in st.get_filtration()]
+    values[simplices.index([3])] = -2.0
+    values[simplices.index([2, 3])] = -1.0
+    values[simplices.index([2])] = -1.0
+    st.assign_filtration_values(values)
+    assert st.filtration([2, 3]) == -1.0
+    assert [simplex for simplex, _ in st.get_filtration()][:3] == [[3], [2], [2, 3]]
+    assert list(st.filtration_values()) == sorted(values)
+    assert st.persistence() == SimplexTree(st).persistence()
+    with pytest.raises(ValueError):
+        st.assign_filtration_values(values[1:])
+
+
+def test_get_cofaces_batch():
+    st = SimplexTree()
+    st.insert([0, 1, 2], 1.0)
+    st.insert([2, 3], 2.0)
+    queries = [[v] for v in range(4)] + [[1, 2], [0, 3], [2]]
+    for codimension in range(3):
+        batch = st.get_cofaces_batch(queries, codimension)
+        assert len(batch) == len(queries)
+        for simplex, cofaces in zip(queries, batch):
+            if st.find(simplex):
+                assert sorted(cofaces) == sorted(st.get_cofaces(simplex, codimension))
+            else:
+                assert cofaces == []
+    assert st.get_cofaces_batch([], 0) == []
+
+
+def test_float32_simplex_tree():
+    rng = np.random.default_rng(3)
+    edges = rng.integers(0, 30, (2, 200))
+    edges = edges[:, edges[0] != edges[1]]
+    values = rng.random(edges.shape[1]).astype(np.float32)
+    st64 = SimplexTree()
+    st32 = SimplexTree(dtype=np.float32)
+    assert st32.dtype == np.float32 and st64.dtype == np.float64
+    for st in (st64, st32):
+        st.insert_batch(edges, values)
+        st.expansion(3)
+        st.make_filtration_non_decreasing()
+    assert st32.num_simplices() == st64.num_simplices()
+    assert st32.dimension() == st64.dimension()
+    assert st32.find([int(edges[0, 0]), int(edges[1, 0])])
+    # The float32 values are exact in double
+    assert sorted(st32.get_simplices()) == sorted(st64.get_simplices())
+    assert list(st32.get_filtration()) == list(st64.get_filtration())
+    assert list(st32.get_skeleton(1)) == list(st64.get_skeleton(1))
+    np.testing.assert_array_equal(st32.filtration_values(), st64.filtration_values())
+    assert st32.memory_usage()["nodes"] < st64.memory_usage()["nodes"]
+
+    for algorithm in ["cohomology", "matrix_reduction"]:
+        assert st32.persistence(algorithm=algorithm) == st64.persistence(algorithm=algorithm)
+    assert st32.persistence(max_dimension=1) == st64.persistence(max_dimension=1)
+    assert st32.betti_numbers() == st64.betti_numbers()
+    assert st32.persistent_betti_numbers(0.5, 0.6) == st64.persistent_betti_numbers(0.5, 0.6)
+    assert st32.persistence_pairs() == st64.persistence_pairs()
+    np.testing.assert_array_equal(
+        st32.persistence_intervals_in_dimension(1), st64.persistence_intervals_in_dimension(1)
+    )
+    for a, b in zip(
+        st32.persistence_intervals_by_dimension(np.float32), st64.persistence_intervals_by_dimension(np.float32)
+    ):
+        np.testing.assert_array_equal(a, b)
+
+    # Copies keep the dtype
+    copy = st32.copy()
+    assert copy.dtype == np.float32 and copy == st32
+    assert SimplexTree(st32) == st32
+    assert not (st32 == st64)
+    with pytest.raises(ValueError):
+        SimplexTree(st32, dtype=np.float64)
+    with pytest.raises(ValueError):
+        SimplexTree(dtype=np.int32)
+
+    # A filtration value is rounded to float32
+    st32.assign_filtration([0], 0.1)
+    assert st32.filtration([0]) == np.float32(0.1)
+    assert st32.insert([0, 100], 0.3)
+    assert st32.filtration([0, 100]) == np.float32(0.3)
+    # The other methods are not available
+    with pytest.raises(TypeError):
+        st32.prune_above_filtration(0.5)
+    with pytest.raises(TypeError):
+        persistence_batch([st32])
+
+
+def test_persistence_cache(tmp_path):
+    rng = np.random.default_rng(5)
+    edges = rng.integers(0, 20, (2, 80))
+    edges = edges[:, edges[0] != edges[1]]
+    values = rng.random(edges.shape[1])
+    st = SimplexTree()
+    st.insert_batch(edges, values)
+    st.expansion(3)
+    st.make_filtration_non_decreasing()
+    # Same complex, inserted in another order
+    reversed_st = SimplexTree()
+    reversed_st.insert_batch(edges[:, ::-1], values[::-1])
+    reversed_st.expansion(3)
+    reversed_st.make_filtration_non_decreasing()
+    assert st.content_hash() == reversed_st.content_hash()
+    assert st._content_digest() == reversed_st._content_digest()
+
+    expected = st.persistence()
+    assert st.persistence(cache_dir=str(tmp_path)) == expected
+    assert len(list(tmp_path.iterdir())) == 1
+    # Read from the cache, the persistence is then computed by the accessors
+    assert reversed_st.persistence(cache_dir=str(tmp_path)) == expected
+    assert reversed_st.betti_numbers() == st.betti_numbers()
+    assert reversed_st.persistence_pairs() == st.persistence_pairs()
+    assert len(list(tmp_path.iterdir())) == 1
+    # The key is a digest of the whole content, not of the 64-bit content_hash
+    other = SimplexTree()
+    other.insert([0, 1], 1.0)
+    assert other._content_digest() != st._content_digest()
+    assert other.persistence(cache_dir=str(tmp_path)) == other.persistence()
+    assert len(list(tmp_path.iterdir())) == 2
+    # Other parameters, or another complex, are other entries
+    assert st.persistence(min_persistence=-1, cache_dir=str(tmp_path)) == st.persistence(min_persistence=-1)
+    st.assign_filtration([int(edges[0, 0]), int(edges[1, 0])], 0.)
+    st.make_filtration_non_decreasing()
+    assert st.persistence(cache_dir=str(tmp_path)) == st.persistence()
+    assert len(list(tmp_path.iterdir())) == 4
@@ -22,3 +22,15 @@ def test_pickle_simplex_tree():
         with open('stree.pkl','rb') as f:
             st_copy = pickle.load(f)
         assert st == st_copy
+
+def test_pickle_simplex_tree_multi():
+    from gudhi import SimplexTreeMulti
+    st = SimplexTreeMulti(SimplexTree.create_from_array(np.random.rand(10, 10)), num_parameters=3)
+    st.fill_lowerstar(np.random.rand(10), parameter=1)
+    st.expansion(3)
+    st_copy = pickle.loads(pickle.dumps(st))
+    assert st == st_copy
+    assert st_copy.num_parameters == 3
+    for (simplex, filtration), (simplex_copy, filtration_copy) in zip(st.get_simplices(), st_copy.get_simplices()):
+        assert simplex == simplex_copy
+        assert np.array_equal(filtration, filtration_copy)
@@ -9,8 +9,10 @@
 """
 
 from gudhi.sklearn.cubical_persistence import CubicalPersistence
+from gudhi._pers_cub_low_dim import _persistence_on_a_line, _persistence_on_lines
 import gudhi
 import numpy as np
+import pytest
 from sklearn import datasets
 
 CUBICAL_PERSISTENCE_H0_IMG0 = np.array([[0.0, 6.0], [0.0, 8.0], [0.0, np.inf]])
@@ -76,3 +78,54 @@ def test_compare_top_cells():
     cmp(np.array(a, order='F'))
     cmp(a[0:18])
     cmp(a[::2,::-1])
+
+def test_batch_of_images():
+    # A 3d array is processed as a batch in C++, a list of images one by one
+    images = np.random.rand(7, 12, 9)
+    images[3] = np.floor(images[3] * 4)
+    for n_jobs in (None, 2, -1):
+        cp = CubicalPersistence(homology_dimensions=[0, 1, 2], n_jobs=n_jobs)
+        batch = cp.fit_transform(images)
+        one_by_one = cp.fit_transform(list(images))
+        assert len(batch) == len(one_by_one) == 7
+        for b, o in zip(batch, one_by_one):
+            for db, do in zip(b, o):
+                np.testing.assert_array_equal(db.reshape(-1, 2), do.reshape(-1, 2))
+
+def test_batch_of_float32_images():
+    # The float32 images are read without a copy in double, with the same pairs
+    images = np.random.rand(5, 10, 11).astype(np.float32)
+    images[2] = np.floor(images[2] * 4)
+    cp = CubicalPersistence(homology_dimensions=[0, 1])
+    for single, double in [(cp.fit_transform(images), cp.fit_transform(images.astype(np.float64))),
+                           (cp.fit_transform(list(images)), cp.fit_transform(list(images.astype(np.float64))))]:
+        for s, d in zip(single, double):
+            for ds, dd in zip(s, d):
+                assert ds.dtype == np.float64
+                np.testing.assert_array_equal(ds, dd)
+
+def test_batch_of_signals():
+    # A 2d array is processed as a batch of 1d signals in C++, a list of signals one by one
+    signals = np.random.rand(50, 30)
+    signals[7] = np.floor(signals[7] * 4)
+    for min_persistence in (0.0, 0.1):
+        for n_jobs in (None, 2):
+            cp = CubicalPersistence(homology_dimensions=[0, 1], min_persistence=min_persistence, n_jobs=n_jobs)
+            batch = cp.fit_transform(signals)
+            one_by_one = cp.fit_transform(list(signals))
+            assert len(batch) == len(one_by_one) == 50
+            for b, o in zip(batch, one_by_one):
+                for db, do in zip(b, o):
+                    np.testing.assert_array_equal(db.reshape(-1, 2), do.reshape(-1, 2))
+    assert CubicalPersistence(0).fit_transform(signals.astype(np.float32))[0].dtype == np.float32
+
+def test_ragged_signals():
+    signals = [np.random.rand(n) for n in (5, 0, 1, 12, 3)]
+    offsets = np.cumsum([0] + [len(s) for s in signals])
+    pairs, row_offsets = _persistence_on_lines(np.concatenate(signals), offsets)
+    np.testing.assert_array_equal(row_offsets[[0, -1]], [0, len(pairs)])
+    for i, s in enumerate(signals):
+        expected = _persistence_on_a_line(s).reshape(-1, 2)
+        np.testing.assert_array_equal(pairs[row_offsets[i]:row_offsets[i + 1]], expected)
+    with pytest.raises(RuntimeError):
+        _persistence_on_lines(np.concatenate(signals), offsets[:-1])
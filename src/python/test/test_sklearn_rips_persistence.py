@@ -0,0 +1,70 @@
+""" This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+    Author(s):       David Loiseaux
+
+    Copyright (C) 2023 Inria
+
+    Modification(s):
+      - YYYY/MM Author: Description of the modification
+"""
+
+from gudhi.sklearn.rips_persistence import RipsPersistence
+from gudhi import RipsComplex
+import numpy as np
+import pytest
+
+
+def _sorted(diagram):
+    diagram = np.asarray(diagram).reshape(-1, 2)
+    return diagram[np.lexsort((diagram[:, 1], diagram[:, 0]))]
+
+
+def _expected(points, dimensions, threshold=float("inf")):
+    st = RipsComplex(points=points, max_edge_length=threshold).create_simplex_tree(max(dimensions) + 1)
+    st.compute_persistence()
+    return [st.persistence_intervals_in_dimension(dim) for dim in dimensions]
+
+
+def _clouds():
+    rng = np.random.default_rng(0)
+    return [rng.random((n, 3)) for n in (20, 0, 1, 15, 30)]
+
+
+@pytest.mark.parametrize("num_collapses", ["auto", 0, 2])
+def test_point_clouds(num_collapses):
+    clouds = _clouds()
+    rp = RipsPersistence(homology_dimensions=[0, 1, 2], threshold=0.7, num_collapses=num_collapses, n_jobs=-1)
+    diags = rp.fit_transform(clouds)
+    assert len(diags) == len(clouds)
+    for cloud, diag in zip(clouds, diags):
+        for got, expected in zip(diag, _expected(cloud, [0, 1, 2], 0.7)):
+            np.testing.assert_allclose(_sorted(got), _sorted(expected))
+
+
+def test_single_dimension_and_batch_array():
+    batch = np.random.default_rng(1).random((6, 25, 2)).astype(np.float32)
+    diags = RipsPersistence(homology_dimensions=1, n_jobs=2).fit_transform(batch)
+    assert len(diags) == 6
+    for cloud, diag in zip(batch, diags):
+        np.testing.assert_allclose(_sorted(diag), _sorted(_expected(cloud.astype(np.float64), [1])[0]), rtol=1e-6)
+
+
+def test_distance_matrices():
+    clouds = [c for c in _clouds() if len(c) > 0]
+    matrices = [np.linalg.norm(c[:, None, :] - c[None, :, :], axis=-1) for c in clouds]
+    from_points = RipsPersistence(homology_dimensions=[0, 1]).fit_transform(clouds)
+    for num_collapses in [0, 1]:
+        from_matrices = RipsPersistence(
+            homology_dimensions=[0, 1], input_type="full distance matrix", num_collapses=num_collapses
+        ).fit_transform(matrices)
+        for a, b in zip(from_points, from_matrices):
+            for da, db in zip(a, b):
+                np.testing.assert_allclose(_sorted(da), _sorted(db))
+
+
+def test_empty_batch_and_errors():
+    assert RipsPersistence(homology_dimensions=0).fit_transform([]) == []
+    with pytest.raises(ValueError):
+        RipsPersistence(homology_dimensions=0, input_type="lower distance matrix").fit_transform([[[0.0]]])
+    with pytest.raises(ValueError):
+        RipsPersistence(homology_dimensions=0, num_collapses=-1).fit_transform([[[0.0]]])
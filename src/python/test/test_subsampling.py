@@ -134,3 +134,18 @@ def test_simple_sparsify_points():
     else:
         with pytest.raises(NotImplementedError):
             gudhi.sparsify_point_set(points=point_set, min_squared_dist=0.0)
+
+
+def test_subsampling_points_buffer():
+    # float32 and float64 arrays, with any strides, are read in place and give the same subsample as a list of lists
+    rng = np.random.default_rng(0)
+    points = rng.random((100, 3)).astype(np.float32)
+    expected = gudhi.choose_n_farthest_points(points=points.tolist(), nb_points=10, starting_point=4)
+    for array in [points, np.asfortranarray(points), points.astype(np.float64)]:
+        for fast in [True, False]:
+            assert gudhi.choose_n_farthest_points(points=array, nb_points=10, starting_point=4, fast=fast) == expected
+        assert len(gudhi.choose_n_farthest_points(points=array, nb_points=10)) == 10
+        landmarks = gudhi.pick_n_random_points(points=array, nb_points=10)
+        assert len(landmarks) == 10
+        for landmark in landmarks:
+            assert landmark in points.tolist()
@@ -41,3 +41,35 @@ def test_normal():
     prep = TimeDelayEmbedding(dim=4)
     prep.fit([ts])
     assert (prep.transform([ts])[0] == [[0, 1, 2, 3], [2, 3, 4, 5], [4, 5, 6, 7], [6, 7, 8, 9]]).all()
+
+
+def test_views():
+    rng = np.random.default_rng(0)
+    for ts in [rng.random(50), rng.random((40, 2)), rng.random((40, 3))[:, :2], rng.random(100)[::3]]:
+        for delay, skip in [(1, 1), (2, 3), (1, 4), (3, 1)]:
+            dim = 4 if ts.ndim == 1 else 2 * ts.shape[1]
+            copies = TimeDelayEmbedding(dim=dim, delay=delay, skip=skip)(ts)
+            views = TimeDelayEmbedding(dim=dim, delay=delay, skip=skip, copy=False)(ts)
+            np.testing.assert_array_equal(copies, views)
+            assert not np.shares_memory(copies, ts)
+            if ts.ndim == 1 or (delay == 1 and ts.flags["C_CONTIGUOUS"]):
+                assert np.shares_memory(views, ts)
+                assert not views.flags["WRITEABLE"]
+
+
+def test_series_shorter_than_the_window():
+    ts = np.arange(3.0)
+    for copy in [True, False]:
+        assert TimeDelayEmbedding(dim=5, copy=copy)(ts).shape == (0, 5)
+        assert TimeDelayEmbedding(dim=3, delay=2, copy=copy)(ts).shape == (0, 3)
+
+
+def test_view_in_a_rips_complex():
+    from gudhi import RipsComplex
+
+    ts = np.sin(np.linspace(0, 20, 200))
+    copies = TimeDelayEmbedding(dim=3, delay=4, skip=2)(ts)
+    views = TimeDelayEmbedding(dim=3, delay=4, skip=2, copy=False)(ts)
+    st1 = RipsComplex(points=copies, max_edge_length=0.5).create_simplex_tree(2)
+    st2 = RipsComplex(points=views, max_edge_length=0.5).create_simplex_tree(2)
+    assert st1 == st2
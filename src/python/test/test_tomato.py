@@ -63,3 +63,45 @@ def test_tomato_1():
     assert t.diagram_.size == 0
     assert t.max_weight_per_cc_.size == 1
     t.plot_diagram()
+
+
+def test_tomato_csr_graph():
+    from gudhi.clustering._tomato import hierarchy, hierarchy_csr
+
+    rng = np.random.default_rng(42)
+    a = np.concatenate([rng.normal(0, 1, (200, 2)), rng.normal(6, 1, (200, 2))])
+    t = Tomato(k=8, n_clusters=2)
+    t.fit(a)
+    assert isinstance(t.neighbors_, np.ndarray)
+    # Same hierarchy from the lists of neighbors, with an ignored out-of-range neighbor
+    ngb = [list(line) + [len(a)] for line in t.neighbors_]
+    leaf_labels, children, diagram, max_weight = hierarchy(ngb, t.weights_)
+    assert np.array_equal(leaf_labels, t.leaf_labels_)
+    assert np.array_equal(children, t.children_)
+    assert np.array_equal(diagram, t.diagram_)
+    assert np.array_equal(max_weight, t.max_weight_per_cc_)
+    offsets = np.cumsum([0] + [len(line) for line in ngb])
+    r = hierarchy_csr(offsets, np.concatenate(ngb), t.weights_)
+    assert np.array_equal(r[0], t.leaf_labels_) and np.array_equal(r[1], t.children_)
+
+
+def test_tomato_labels_for():
+    rng = np.random.default_rng(0)
+    a = np.concatenate([rng.normal(0, 1, (100, 2)), rng.normal(5, 1, (100, 2)), rng.normal((0, 8), 1, (100, 2))])
+    t = Tomato(k=6)
+    t.fit(a)
+    counts = [1, 2, 3, t.n_leaves_]
+    labels = t.labels_for(n_clusters=counts)
+    assert labels.shape == (len(counts), len(a))
+    assert np.array_equal(labels[-1], t.leaf_labels_)
+    thresholds = [0.0, 0.5, np.inf]
+    labels_thr = t.labels_for(merge_thresholds=thresholds)
+    # Same labels as going through the setters
+    for n, l in zip(counts, labels):
+        t.n_clusters_ = n
+        assert np.array_equal(t.labels_, l)
+    for thr, l in zip(thresholds, labels_thr):
+        t.merge_threshold_ = thr
+        assert np.array_equal(t.labels_, l)
+    with pytest.raises(ValueError):
+        t.labels_for()
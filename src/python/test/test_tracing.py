@@ -0,0 +1,65 @@
+""" This file is part of the Gudhi Library - https://gudhi.inria.fr/ - which is released under MIT.
+    See file LICENSE or go to https://gudhi.inria.fr/licensing/ for full license details.
+    Author(s):       David Loiseaux
+
+    Copyright (C) 2023 Inria
+
+    Modification(s):
+      - YYYY/MM Author: Description of the modification
+"""
+
+import json
+
+import gudhi
+from gudhi import RipsComplex, SimplexTree
+from gudhi.tracing import trace, trace_events, trace_phase
+
+
+def _pipeline():
+    points = [[1, 1], [7, 0], [4, 6], [9, 6], [0, 14], [2, 19], [9, 17]]
+    st = RipsComplex(points=points, max_edge_length=12.0).create_simplex_tree()
+    st.collapse_edges()
+    st.expansion(3)
+    st.persistence()
+
+
+def test_no_trace_outside_of_the_context_manager():
+    with trace():
+        pass
+    _pipeline()
+    assert trace_events() == []
+
+
+def test_trace_of_a_pipeline(tmp_path):
+    path = tmp_path / "trace.json"
+    with trace(str(path)):
+        _pipeline()
+        with trace_phase("vectorization"):
+            pass
+    with open(path) as f:
+        events = json.load(f)["traceEvents"]
+    names = [event["name"] for event in events if event["ph"] == "B"]
+    for name in [
+        "Rips_complex::compute_proximity_graph",
+        "Rips_complex::create_complex",
+        "Simplex_tree::expansion",
+        "Persistent_cohomology::compute_persistent_cohomology",
+        "vectorization",
+    ]:
+        assert name in names
+    assert names.index("Rips_complex::create_complex") < names.index("vectorization")
+    assert [event["ts"] for event in events] == sorted(event["ts"] for event in events)
+    # Each phase begins and ends in its thread
+    depth = {}
+    for event in events:
+        depth[event["tid"]] = depth.get(event["tid"], 0) + (1 if event["ph"] == "B" else -1)
+        assert depth[event["tid"]] >= 0
+    assert all(d == 0 for d in depth.values())
+    assert events == trace_events()
+
+
+def test_trace_phase_without_trace():
+    with trace_phase("nothing"):
+        st = SimplexTree()
+        st.insert([0, 1])
+    assert all(event["name"] != "nothing" for event in gudhi.trace_events())
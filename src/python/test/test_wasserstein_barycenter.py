@@ -44,3 +44,16 @@ def test_lagrangian_barycenter():
     assert np.linalg.norm(lagrangian_barycenter(pdiagset=[dg8, dg4], init=np.array([[0.2, 0.6], [0.5, 0.7]]), verbose=False) - np.array([[1, 3], [5, 7]])) < eps
     assert lagrangian_barycenter(pdiagset = []) is None
 
+
+
+def test_lagrangian_barycenter_parallel():
+    rng = np.random.default_rng(0)
+    diags = []
+    for _ in range(20):
+        a = rng.uniform(0, 1, (10, 2))
+        diags.append(np.sort(a, axis=1))
+    Y, log = lagrangian_barycenter(pdiagset=diags, init=0, verbose=True)
+    Y2, log2 = lagrangian_barycenter(pdiagset=diags, init=0, verbose=True, n_jobs=4)
+    assert np.array_equal(Y, Y2)
+    assert log["nb_iter"] == log2["nb_iter"]
+    assert np.abs(log["energy"] - log2["energy"]) < 1e-12
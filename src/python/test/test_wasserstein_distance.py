@@ -203,6 +203,12 @@ def test_wasserstein_distance_pot():
     _basic_wasserstein(pot_wrap(enable_autodiff=True, keep_essential_parts=False), 1e-15, test_infinity=False, test_matching=False)
 
 
+def test_wasserstein_distance_pot_hera_backend():
+    _basic_wasserstein(pot_wrap(backend="hera", delta=1e-12), 1e-12, test_matching=True)
+    _basic_wasserstein(pot_wrap(backend="hera", delta=1e-12, enable_autodiff=True, keep_essential_parts=False), 1e-12,
+                       test_infinity=False, test_matching=False)
+
+
 def test_wasserstein_distance_hera():
     _basic_wasserstein(hera_wrap(delta=1e-12), 1e-12, test_matching=True)
     _basic_wasserstein(hera_wrap(delta=.1), .1, test_matching=True)
@@ -30,6 +30,12 @@ def test_wasserstein_distance_grad():
     dist45.backward()
     assert np.array_equal(diag4.grad, [[-1., -1.]])
     assert np.array_equal(diag5.grad, [[1., 1.], [-1., 1.]])
+    # Same matching from the auction algorithm, without a dense cost matrix
+    diag4.grad = None
+    diag5.grad = None
+    pot(diag4, diag5, internal_p=1, order=1, enable_autodiff=True, backend="hera", delta=1e-12).backward()
+    assert np.array_equal(diag4.grad, [[-1., -1.]])
+    assert np.array_equal(diag5.grad, [[1., 1.], [-1., 1.]])
     diag6 = torch.tensor([[5., 10.]], requires_grad=True)
     pot(diag6, diag6, internal_p=2, order=2, enable_autodiff=True).backward()
     # https://github.com/jonasrauber/eagerpy/issues/6